@@ -236,7 +236,70 @@ def _TTree__iter__( self ):
    if bytes_read == -1:
       raise RuntimeError( "TTree I/O error" )
 
-_root.CreateScopeProxy( "TTree" ).__iter__    = _TTree__iter__
+
+_TTree__numpy_types = { 'Bool_t' : 'bool',
+                        'Char_t' : 'int8',    'UChar_t' : 'uint8',
+                        'Short_t' : 'int16',  'UShort_t' : 'uint16',
+                        'Int_t' : 'int32',    'UInt_t' : 'uint32',
+                        'Long64_t' : 'int64', 'ULong64_t' : 'uint64',
+                        'Float_t' : 'float32', 'Double_t' : 'float64' }
+
+def _TTree__AsNumpy( self, branches = None, first = 0, last = None ):
+   """Return a dict of numpy arrays with the values of the given branches
+   (all the branches by default) for the entries first to last (excluded),
+   read in bulk in C++ (in parallel if implicit multi-threading is enabled).
+   Only the branches of a single leaf of a basic type are supported."""
+   import numpy
+   if branches is None:
+      branches = [ b.GetName() for b in self.GetListOfBranches() ]
+   elif type(branches) == str:
+      branches = [ branches ]
+   nentries = self.GetEntries()
+   if last is None or nentries < last:
+      last = nentries
+   n = max( last - first, 0 )
+
+   names = _root.std.vector( 'string' )()
+   addresses = _root.std.vector( 'ULong64_t' )()
+   arrays = {}
+   for name in branches:
+      branch = self.GetBranch( name )
+      if not branch or branch.GetBulkEntrySize() == 0:
+         raise TypeError( "branch %s can not be read in bulk" % name )
+      leaf = branch.GetListOfLeaves().At( 0 )
+      dtype = _TTree__numpy_types.get( leaf.GetTypeName() )
+      if dtype is None:
+         raise TypeError( "branch %s holds values of unsupported type %s" % (name, leaf.GetTypeName()) )
+      length = leaf.GetLenStatic()
+      arrays[ name ] = numpy.empty( length == 1 and (n,) or (n, length), dtype = dtype )
+      names.push_back( name )
+      addresses.push_back( arrays[ name ].ctypes.data )
+
+   if 0 < n and cppyy.gbl.ROOT.TreeUtils.ReadBranchesInBulk( self, names, first, n, addresses ) != n:
+      raise RuntimeError( "TTree I/O error" )
+   return arrays
+
+def _pythonize_TTree( klass, name ):
+   if name == 'TTree':
+      klass.__iter__ = _TTree__iter__
+      klass.AsNumpy  = _TTree__AsNumpy
+
+## creating the TTree proxy here would load libTree at import: install the
+## pythonizations when the class is first used instead
+if PYPY_CPPYY_COMPATIBILITY_FIXME:
+   _pythonize_TTree( _root.CreateScopeProxy( "TTree" ), 'TTree' )
+else:
+   cppyy.add_pythonization( _pythonize_TTree )
+
+## libraries of globals that can not be autoloaded (e.g. gRandom of libMathCore);
+## they are loaded at the first failed lookup rather than at startup
+_lazyLibraries = [ 'libMathCore' ]
+
+def _loadLazyLibraries():
+   loaded = bool( _lazyLibraries )
+   while _lazyLibraries:
+      _root.gSystem.Load( _lazyLibraries.pop( 0 ) )
+   return loaded
 
 
 ### RINT command emulation ------------------------------------------------------
@@ -440,6 +503,9 @@ class ModuleFacade( types.ModuleType ):
          if caller == self:
             caller = sys.modules[ sys._getframe( 2 ).f_globals[ '__name__' ] ]
 
+       # the lazy lookup hook does not know about the lazily loaded libraries
+         _loadLazyLibraries()
+
        # setup the pre-defined globals
          for name in self.module.__pseudo__all__:
             caller.__dict__[ name ] = getattr( _root, name )
@@ -450,21 +516,26 @@ class ModuleFacade( types.ModuleType ):
        # return empty list, to prevent further copying
          return self.module.__all__
 
-    # lookup into ROOT (which may cause python-side enum/class/global creation)
-      try:
-         if PYPY_CPPYY_COMPATIBILITY_FIXME:
-          # TODO: this fails descriptor setting, but may be okay on gbl
-            return getattr( _root, name )
-         else:
-            attr = _root.LookupCppEntity( name, PyConfig.ExposeCppMacros )
-         if type(attr) == _root.PropertyProxy:
-            setattr( self.__class__, name, attr )      # descriptor
-            return getattr( self, name )
-         else:
-            self.__dict__[ name ] = attr               # normal member
-            return attr
-      except AttributeError:
-         pass
+    # lookup into ROOT (which may cause python-side enum/class/global creation),
+    # retried once the libraries that can not be autoloaded are loaded
+      while True:
+         try:
+            if PYPY_CPPYY_COMPATIBILITY_FIXME:
+             # TODO: this fails descriptor setting, but may be okay on gbl
+               return getattr( _root, name )
+            else:
+               attr = _root.LookupCppEntity( name, PyConfig.ExposeCppMacros )
+            if type(attr) == _root.PropertyProxy:
+               setattr( self.__class__, name, attr )      # descriptor
+               return getattr( self, name )
+            else:
+               self.__dict__[ name ] = attr               # normal member
+               return attr
+         except AttributeError:
+            pass
+
+         if not _loadLazyLibraries():
+            break
 
     # reaching this point means failure ...
       raise AttributeError( name )
@@ -603,9 +674,6 @@ class ModuleFacade( types.ModuleType ):
     # set the display hook
       sys.displayhook = _displayhook
 
-    # manually load libMathCore, for example to obtain gRandom
-    # This can be removed once autoloading on selected variables is available
-      _root.gSystem.Load( "libMathCore" )
 
 sys.modules[ __name__ ] = ModuleFacade( sys.modules[ __name__ ] )
 del ModuleFacade
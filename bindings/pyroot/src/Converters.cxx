@@ -131,6 +131,17 @@ static inline Long_t PyROOT_PyLong_AsStrictLong( PyObject* pyobject )
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// python float to C++ double conversion, with a fast path for the exact
+/// python float type, the most common argument of the floating point overloads
+static inline Double_t PyROOT_PyFloat_AsDouble( PyObject* pyobject )
+{
+   if ( PyFloat_CheckExact( pyobject ) )
+      return PyFloat_AS_DOUBLE( pyobject );
+   return PyFloat_AsDouble( pyobject );
+}
+
+
 //- base converter implementation ---------------------------------------------
 PyObject* PyROOT::TConverter::FromMemory( void* )
 {
@@ -437,8 +448,8 @@ Bool_t PyROOT::TUIntConverter::ToMemory( PyObject* value, void* address )
 ////////////////////////////////////////////////////////////////////////////////
 /// floating point converters
 
-PYROOT_IMPLEMENT_BASIC_CONVERTER( Float,  Float_t,  Double_t, PyFloat_FromDouble, PyFloat_AsDouble, 'f' )
-PYROOT_IMPLEMENT_BASIC_CONVERTER( Double, Double_t, Double_t, PyFloat_FromDouble, PyFloat_AsDouble, 'd' )
+PYROOT_IMPLEMENT_BASIC_CONVERTER( Float,  Float_t,  Double_t, PyFloat_FromDouble, PyROOT_PyFloat_AsDouble, 'f' )
+PYROOT_IMPLEMENT_BASIC_CONVERTER( Double, Double_t, Double_t, PyFloat_FromDouble, PyROOT_PyFloat_AsDouble, 'd' )
 
 PYROOT_IMPLEMENT_BASIC_CONVERTER( LongDouble, LongDouble_t, LongDouble_t, PyFloat_FromDouble, PyFloat_AsDouble, 'D' )
 
@@ -467,8 +478,8 @@ Bool_t PyROOT::TDoubleRefConverter::SetArg(
 
 ////////////////////////////////////////////////////////////////////////////////
 
-PYROOT_IMPLEMENT_BASIC_CONST_REF_CONVERTER( Float,      Float_t,      PyFloat_AsDouble )
-PYROOT_IMPLEMENT_BASIC_CONST_REF_CONVERTER( Double,     Double_t,     PyFloat_AsDouble )
+PYROOT_IMPLEMENT_BASIC_CONST_REF_CONVERTER( Float,      Float_t,      PyROOT_PyFloat_AsDouble )
+PYROOT_IMPLEMENT_BASIC_CONST_REF_CONVERTER( Double,     Double_t,     PyROOT_PyFloat_AsDouble )
 PYROOT_IMPLEMENT_BASIC_CONST_REF_CONVERTER( LongDouble, LongDouble_t, PyFloat_AsDouble )
 
 ////////////////////////////////////////////////////////////////////////////////
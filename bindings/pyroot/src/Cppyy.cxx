@@ -59,6 +59,11 @@ static GlobalFuncs_t g_globalfuncs;
 typedef std::vector< TGlobal* > GlobalVars_t;
 static GlobalVars_t g_globalvars;
 
+// up-cast offsets between (derived, base), used on every method call; only the
+// offsets that do not depend on the object (no virtual base) are stored
+typedef std::map< std::pair< Cppyy::TCppType_t, Cppyy::TCppType_t >, ptrdiff_t > BaseOffsets_t;
+static BaseOffsets_t g_baseoffsets;
+
 // data ----------------------------------------------------------------------
 Cppyy::TCppScope_t Cppyy::gGlobalScope = GLOBAL_HANDLE;
 
@@ -101,6 +106,24 @@ TClassRef& type_from_handle( Cppyy::TCppScope_t scope )
    return g_classrefs[ (ClassRefs_t::size_type)scope ];
 }
 
+// test whether base is reached from derived through a virtual base, in which
+// case the offset between the two depends on the object
+static bool has_virtual_base_path( TClass* derived, TClass* base )
+{
+   TList* bases = derived->GetListOfBases();
+   if ( ! bases )
+      return false;
+   for ( TObject* obj : *bases ) {
+      TBaseClass* bc = (TBaseClass*)obj;
+      TClass* c = bc->GetClassPointer();
+      if ( ! c || ! ( c == base || c->InheritsFrom( base ) ) )
+         continue;
+      if ( ( bc->Property() & kIsVirtualBase ) || ( c != base && has_virtual_base_path( c, base ) ) )
+         return true;
+   }
+   return false;
+}
+
 // type_from_handle to go here
 static inline
 TFunction* type_get_method( Cppyy::TCppType_t klass, Cppyy::TCppIndex_t idx )
@@ -624,6 +647,10 @@ ptrdiff_t Cppyy::GetBaseOffset( TCppType_t derived, TCppType_t base,
    if ( derived == base || !(base && derived) )
       return (ptrdiff_t)0;
 
+   BaseOffsets_t::iterator icache = g_baseoffsets.find( std::make_pair( derived, base ) );
+   if ( icache != g_baseoffsets.end() )
+      return direction < 0 ? -icache->second : icache->second;
+
    TClassRef& cd = type_from_handle( derived );
    TClassRef& cb = type_from_handle( base );
 
@@ -651,6 +678,9 @@ ptrdiff_t Cppyy::GetBaseOffset( TCppType_t derived, TCppType_t base,
    if ( offset == -1 )  // Cling error, treat silently
       return rerror ? (ptrdiff_t)offset : 0;
 
+   if ( direction > 0 && ! has_virtual_base_path( cd.GetClass(), cb.GetClass() ) )
+      g_baseoffsets[ std::make_pair( derived, base ) ] = (ptrdiff_t)offset;
+
    return (ptrdiff_t)(direction < 0 ? -offset : offset);
 }
 
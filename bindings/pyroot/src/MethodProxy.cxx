@@ -601,15 +601,26 @@ namespace {
    // otherwise, handle overloading
       Long_t sighash = HashSignature( args );
 
-   // look for known signatures ...
-      MethodProxy::DispatchMap_t::iterator m = dispatchMap.find( sighash );
-      if ( m != dispatchMap.end() ) {
-         Int_t index = m->second;
+   // look for known signatures, starting with the one of the previous call (the
+   // common case of a loop calling the same method with the same argument types) ...
+      Int_t index = -1;
+      if ( pymeth->fMethodInfo->fLastIndex != -1 && pymeth->fMethodInfo->fLastHash == sighash ) {
+         index = pymeth->fMethodInfo->fLastIndex;
+      } else {
+         MethodProxy::DispatchMap_t::iterator m = dispatchMap.find( sighash );
+         if ( m != dispatchMap.end() )
+            index = m->second;
+      }
+
+      if ( index != -1 ) {
          PyObject* result = methods[ index ]->Call( pymeth->fSelf, args, kwds, &ctxt );
          result = HandleReturn( pymeth, oldSelf, result );
 
-         if ( result != 0 )
+         if ( result != 0 ) {
+            pymeth->fMethodInfo->fLastHash  = sighash;
+            pymeth->fMethodInfo->fLastIndex = index;
             return result;
+         }
 
       // fall through: python is dynamic, and so, the hashing isn't infallible
          ResetCallState( pymeth->fSelf, oldSelf, kTRUE );
@@ -628,6 +639,8 @@ namespace {
          if ( result != 0 ) {
          // success: update the dispatch map for subsequent calls
             dispatchMap[ sighash ] = i;
+            pymeth->fMethodInfo->fLastHash  = sighash;
+            pymeth->fMethodInfo->fLastIndex = i;
             std::for_each( errors.begin(), errors.end(), PyError_t::Clear );
             return HandleReturn( pymeth, oldSelf, result );
          }
@@ -919,6 +932,7 @@ void PyROOT::MethodProxy::AddMethod( PyCallable* pc )
 {
    fMethodInfo->fMethods.push_back( pc );
    fMethodInfo->fFlags &= ~TCallContext::kIsSorted;
+   ClearDispatch();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -928,6 +942,18 @@ void PyROOT::MethodProxy::AddMethod( MethodProxy* meth )
    fMethodInfo->fMethods.insert( fMethodInfo->fMethods.end(),
       meth->fMethodInfo->fMethods.begin(), meth->fMethodInfo->fMethods.end() );
    fMethodInfo->fFlags &= ~TCallContext::kIsSorted;
+   ClearDispatch();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the overloads selected by the previous calls: the indices are no
+/// longer valid once the overloads are re-sorted.
+
+void PyROOT::MethodProxy::ClearDispatch()
+{
+   fMethodInfo->fDispatchMap.clear();
+   fMethodInfo->fLastHash  = 0;
+   fMethodInfo->fLastIndex = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
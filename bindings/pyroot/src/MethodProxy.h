@@ -24,11 +24,13 @@ namespace PyROOT {
       typedef std::vector< PyCallable* > Methods_t;
 
       struct MethodInfo_t {
-         MethodInfo_t() : fFlags( TCallContext::kNone ) { fRefCount = new int(1); }
+         MethodInfo_t() : fLastHash( 0 ), fLastIndex( -1 ), fFlags( TCallContext::kNone ) { fRefCount = new int(1); }
          ~MethodInfo_t();
 
          std::string                 fName;
          MethodProxy::DispatchMap_t  fDispatchMap;
+         Long_t                      fLastHash;      // signature of the last successful call
+         Int_t                       fLastIndex;     // overload of the last successful call, -1 if none
          MethodProxy::Methods_t      fMethods;
          UInt_t                      fFlags;
 
@@ -45,6 +47,7 @@ namespace PyROOT {
       const std::string& GetName() const { return fMethodInfo->fName; }
       void AddMethod( PyCallable* pc );
       void AddMethod( MethodProxy* meth );
+      void ClearDispatch();
 
    public:               // public, as the python C-API works with C structs
       PyObject_HEAD
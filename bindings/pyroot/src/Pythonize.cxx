@@ -1045,6 +1045,65 @@ namespace {
       return Py_None;
    }
 
+//- NumPy views of vectors of numbers ------------------------------------------
+   std::string VectorNumpyTypeStr( const std::string& valueType )
+   {
+   // Determine the NumPy type string of the given vector value type; empty if the
+   // vector data can not be viewed (only types with a data() buffer are supported).
+      static const struct { const char* fName; char fKind; int fSize; } kTypes[] = {
+         { "short",          'i', sizeof(Short_t)  }, { "unsigned short", 'u', sizeof(UShort_t) },
+         { "int",            'i', sizeof(Int_t)    }, { "unsigned int",   'u', sizeof(UInt_t)   },
+         { "long",           'i', sizeof(Long_t)   }, { "unsigned long",  'u', sizeof(ULong_t)  },
+         { "float",          'f', sizeof(Float_t)  }, { "double",         'f', sizeof(Double_t) } };
+
+      for ( const auto& t : kTypes ) {
+         if ( valueType == t.fName ) {
+#ifdef R__BYTESWAP
+            std::string typestr = "<";
+#else
+            std::string typestr = ">";
+#endif
+            return typestr + t.fKind + std::to_string( t.fSize );
+         }
+      }
+      return "";
+   }
+
+   PyObject* VectorArrayInterface( ObjectProxy* self, void* )
+   {
+   // Implement the NumPy array interface for std::vector<>s of numbers, so that
+   // numpy.asarray() gives a view of the vector data rather than a copy.
+      std::string typestr;
+      PyObject* pyvalue_type = PyObject_GetAttrString( (PyObject*)Py_TYPE(self), "value_type" );
+      if ( pyvalue_type ) {
+         typestr = VectorNumpyTypeStr( PyROOT_PyUnicode_AsString( pyvalue_type ) );
+         Py_DECREF( pyvalue_type );
+      }
+
+      Py_ssize_t size = typestr.empty() ? 0 : PySequence_Size( (PyObject*)self );
+      void* data = 0;
+      if ( 0 < size ) {
+         PyObject* pydata = CallPyObjMethod( (PyObject*)self, "data" );
+         if ( ! pydata || Utility::GetBuffer( pydata, '*', 1, data, kFALSE ) == 0 )
+            data = 0;
+         Py_XDECREF( pydata );
+      }
+
+      if ( ! data ) {
+      // no view (e.g. empty vector): numpy falls back on the sequence protocol
+         PyErr_Clear();
+         PyErr_SetString( PyExc_AttributeError, "__array_interface__" );
+         return 0;
+      }
+
+      return Py_BuildValue( (char*)"{s:(n),s:s,s:(NO),s:i}",
+         "shape", size, "typestr", typestr.c_str(),
+         "data", PyLong_FromVoidPtr( data ), Py_False, "version", 3 );
+   }
+
+   PyGetSetDef gVectorArrayInterface = {
+      (char*)"__array_interface__", (getter)VectorArrayInterface, NULL, NULL, NULL };
+
 //- map behavior as primitives ------------------------------------------------
    PyObject* MapContains( PyObject* self, PyObject* obj )
    {
@@ -2452,6 +2511,15 @@ Bool_t PyROOT::Pythonize( PyObject* pyclass, const std::string& name )
          PyObject* pyvalue_type = PyROOT_PyUnicode_FromString( gInterpreter->TypedefInfo_TrueName( ti ) );
          PyObject_SetAttrString( pyclass, "value_type", pyvalue_type );
          Py_DECREF( pyvalue_type );
+
+      // zero-copy views with numpy.asarray() for vectors of numbers
+         if ( ! VectorNumpyTypeStr( gInterpreter->TypedefInfo_TrueName( ti ) ).empty() ) {
+            PyObject* descr = PyDescr_NewGetSet( (PyTypeObject*)pyclass, &gVectorArrayInterface );
+            if ( descr ) {
+               PyObject_SetAttrString( pyclass, "__array_interface__", descr );
+               Py_DECREF( descr );
+            }
+         }
       }
       gInterpreter->TypedefInfo_Delete( ti );
 
@@ -0,0 +1,66 @@
+import unittest
+import ROOT
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+cppcode = """
+void fill_numpy_views_tree(const char *filename)
+{
+   TFile f(filename, "RECREATE");
+   TTree t("t", "t");
+   Int_t i;
+   Double_t x;
+   Float_t a[3];
+   t.Branch("i", &i, "i/I");
+   t.Branch("x", &x, "x/D");
+   t.Branch("a", a, "a[3]/F");
+   for (i = 0; i < 1000; ++i) {
+      x = 0.5 * i;
+      for (int j = 0; j < 3; ++j) a[j] = i + j;
+      t.Fill();
+   }
+   t.Write();
+}
+"""
+
+@unittest.skipIf(numpy is None, "numpy is not available")
+class NumpyViews(unittest.TestCase):
+    filename = "numpy_views.root"
+
+    @classmethod
+    def setUpClass(cls):
+        ROOT.gInterpreter.Declare(cppcode)
+        ROOT.fill_numpy_views_tree(cls.filename)
+
+    def test_tree_as_numpy(self):
+        f = ROOT.TFile(self.filename)
+        t = f.Get("t")
+        arrays = t.AsNumpy(["i", "x", "a"], 10, 20)
+        self.assertEqual(arrays["i"].dtype, numpy.int32)
+        self.assertEqual(list(arrays["i"]), list(range(10, 20)))
+        self.assertEqual(list(arrays["x"]), [0.5 * i for i in range(10, 20)])
+        self.assertEqual(arrays["a"].shape, (10, 3))
+        self.assertEqual(list(arrays["a"][3]), [13., 14., 15.])
+
+    def test_tree_as_numpy_all_entries(self):
+        f = ROOT.TFile(self.filename)
+        t = f.Get("t")
+        arrays = t.AsNumpy()
+        self.assertEqual(sorted(arrays.keys()), ["a", "i", "x"])
+        self.assertEqual(len(arrays["x"]), 1000)
+        self.assertEqual(arrays["x"][-1], 499.5)
+
+    def test_vector_view(self):
+        v = ROOT.std.vector("double")()
+        for i in range(5):
+            v.push_back(i)
+        a = numpy.asarray(v)
+        self.assertEqual(list(a), [0., 1., 2., 3., 4.])
+        v[2] = 42.
+        self.assertEqual(a[2], 42.)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,36 @@
+# Find the Apache Arrow includes and library.
+#
+# This module defines
+# ARROW_INCLUDE_DIR, where to locate arrow/api.h
+# ARROW_LIBRARIES, the libraries to link against to use Arrow
+# ARROW_FOUND.  If false, you cannot build anything that requires Arrow.
+
+set(ARROW_FOUND 0)
+
+find_path(ARROW_INCLUDE_DIR NAMES arrow/api.h PATHS
+  $ENV{ARROW_HOME}/include
+  /usr/include
+  /usr/local/include
+  /opt/arrow/include
+  DOC "Specify the directory containing arrow/api.h"
+)
+
+find_library(ARROW_LIBRARY NAMES arrow PATHS
+  $ENV{ARROW_HOME}/lib
+  /usr/local/lib
+  /usr/lib
+  /opt/arrow/lib
+  DOC "Specify the arrow library here."
+)
+
+if(ARROW_INCLUDE_DIR AND ARROW_LIBRARY)
+  set(ARROW_FOUND 1)
+  if(NOT Arrow_FIND_QUIETLY)
+     message(STATUS "Found Arrow includes at ${ARROW_INCLUDE_DIR}")
+     message(STATUS "Found Arrow library at ${ARROW_LIBRARY}")
+  endif()
+endif()
+
+set(ARROW_LIBRARIES ${ARROW_LIBRARY})
+
+mark_as_advanced(ARROW_FOUND ARROW_LIBRARY ARROW_INCLUDE_DIR)
@@ -5,6 +5,7 @@
 # FFTW_LIBRARIES, the libraries to link against to use fftw3
 # FFTW_FOUND.  If false, you cannot build anything that requires fftw3.
 # FFTW_LIBRARY, where to find the libfftw3 library.
+# FFTW_THREADS_LIBRARY, where to find the libfftw3_threads library (optional).
 
 set(FFTW_FOUND 0)
 if(FFTW_LIBRARY AND FFTW_INCLUDE_DIR)
@@ -29,6 +30,15 @@ find_library(FFTW_LIBRARY NAMES fftw3 fftw3-3 PATHS
   DOC "Specify the fttw3 library here."
 )
 
+find_library(FFTW_THREADS_LIBRARY NAMES fftw3_threads PATHS
+  $ENV{FFTW_DIR}/lib
+  $ENV{FFTW3} $ENV{FFTW3}/lib $ENV{FFTW3}/threads/.libs
+  /usr/local/lib
+  /usr/lib
+  /opt/fftw3/lib
+  DOC "Specify the fttw3 threads library here."
+)
+
 if(FFTW_INCLUDE_DIR AND FFTW_LIBRARY)
   set(FFTW_FOUND 1 )
   if(NOT FFTW_FIND_QUIETLY)
@@ -38,5 +48,8 @@ if(FFTW_INCLUDE_DIR AND FFTW_LIBRARY)
 endif()
 
 set(FFTW_LIBRARIES ${FFTW_LIBRARY})
+if(FFTW_THREADS_LIBRARY)
+  set(FFTW_LIBRARIES ${FFTW_THREADS_LIBRARY} ${FFTW_LIBRARIES})
+endif()
 
-mark_as_advanced(FFTW_FOUND FFTW_LIBRARY FFTW_INCLUDE_DIR)
+mark_as_advanced(FFTW_FOUND FFTW_LIBRARY FFTW_THREADS_LIBRARY FFTW_INCLUDE_DIR)
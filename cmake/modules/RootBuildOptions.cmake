@@ -63,6 +63,7 @@ endfunction()
 ROOT_BUILD_OPTION(afdsmgrd OFF "Dataset manager for PROOF-based analysis facilities")
 ROOT_BUILD_OPTION(afs OFF "AFS support, requires AFS libs and objects")
 ROOT_BUILD_OPTION(alien OFF "AliEn support, requires libgapiUI from ALICE")
+ROOT_BUILD_OPTION(arrow OFF "Apache Arrow data source for TDataFrame, requires libarrow")
 ROOT_BUILD_OPTION(asimage ON "Image processing support, requires libAfterImage")
 ROOT_BUILD_OPTION(astiff ON "Include tiff support in image processing")
 ROOT_BUILD_OPTION(bonjour OFF "Bonjour support, requires libdns_sd and/or Avahi")
@@ -88,6 +89,7 @@ ROOT_BUILD_OPTION(builtin_vdt OFF "Build the VDT package internally")
 ROOT_BUILD_OPTION(builtin_veccore OFF "Build VecCore internally")
 ROOT_BUILD_OPTION(builtin_xrootd OFF "Build the XROOTD internally (downloading tarfile from the Web)")
 ROOT_BUILD_OPTION(builtin_zlib OFF "Build included libz, or use system libz")
+ROOT_BUILD_OPTION(builtin_zstd OFF "Build included libzstd, or use system libzstd")
 ROOT_BUILD_OPTION(castor ON "CASTOR support, requires libshift from CASTOR >= 1.5.2")
 if (CMAKE_SYSTEM_PROCESSOR STREQUAL "aarch64")
   ROOT_BUILD_OPTION(ccache ON "Enable ccache usage for speeding up builds")
@@ -124,6 +126,7 @@ ROOT_BUILD_OPTION(http ON "HTTP Server support")
 ROOT_BUILD_OPTION(imt ON "Implicit multi-threading support")
 ROOT_BUILD_OPTION(jemalloc OFF "Using the jemalloc allocator")
 ROOT_BUILD_OPTION(krb5 OFF "Kerberos5 support, requires Kerberos libs")
+ROOT_BUILD_OPTION(lapack OFF "Use an optimized BLAS and LAPACK (OpenBLAS, MKL) for the large matrices of libMatrix")
 ROOT_BUILD_OPTION(ldap OFF "LDAP support, requires (Open)LDAP libs")
 ROOT_BUILD_OPTION(libcxx OFF "Build using libc++, requires cxx11 option (MacOS X only, for the time being)")
 ROOT_BUILD_OPTION(macos_native OFF "Disable looking for libraries, includes and binaries in locations other than a native installation (MacOS only)")
@@ -204,6 +207,7 @@ endif()
 
 #--- The 'all' option swithes ON major options---------------------------------------------------
 if(all)
+ set(arrow_defvalue ON)
  set(bonjour_defvalue ON)
  set(chirp_defvalue ON)
  set(dcache_defvalue ON)
@@ -215,6 +219,7 @@ if(all)
  set(hdfs_defvalue ON)
  set(http_defvalue ON)
  set(krb5_defvalue ON)
+ set(lapack_defvalue ON)
  set(ldap_defvalue ON)
  set(memstat_defvalue ON)
  set(minuit2_defvalue ON)
@@ -477,6 +477,16 @@ if(veccore)
 else()
   set(hasveccore undef)
 endif()
+if(arrow)
+  set(hasarrow define)
+else()
+  set(hasarrow undef)
+endif()
+if(tmva AND imt AND NOT BLAS_FOUND)
+  set(dnncpunoblas define)
+else()
+  set(dnncpunoblas undef)
+endif()
 if(cxx11)
   set(cxxversion cxx11)
   set(usec++11 define)
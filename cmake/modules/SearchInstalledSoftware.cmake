@@ -293,6 +293,45 @@ if(builtin_lz4)
   set(LZ4_INCLUDE_DIR ${CMAKE_BINARY_DIR}/include)
 endif()
 
+#---Check for ZSTD-------------------------------------------------------------------
+if(NOT builtin_zstd)
+  message(STATUS "Looking for ZSTD")
+  find_package(ZSTD)
+  if(NOT ZSTD_FOUND)
+    message(STATUS "ZSTD not found. Switching on builtin_zstd option")
+    set(builtin_zstd ON CACHE BOOL "" FORCE)
+  endif()
+endif()
+# Note: the above if-statement may change the value of builtin_zstd to ON.
+if(builtin_zstd)
+  set(zstd_version 1.3.3)
+  message(STATUS "Building ZSTD version ${zstd_version} included in ROOT itself")
+  set(ZSTD_URL ${lcgpackages}/zstd-${zstd_version}.tar.gz)
+  set(ZSTD_LIBRARIES ${CMAKE_BINARY_DIR}/lib/${CMAKE_STATIC_LIBRARY_PREFIX}zstd${CMAKE_STATIC_LIBRARY_SUFFIX})
+  # The zstd CMake project lives in build/cmake; pass it explicitly to the configure step
+  # so that this also works with CMake versions lacking SOURCE_SUBDIR.
+  ExternalProject_Add(
+    ZSTD
+    URL ${ZSTD_URL}
+    INSTALL_DIR ${CMAKE_BINARY_DIR}
+    CONFIGURE_COMMAND ${CMAKE_COMMAND}
+              -DCMAKE_C_COMPILER=${CMAKE_C_COMPILER}
+              -DCMAKE_C_FLAGS=${CMAKE_C_FLAGS}
+              -DCMAKE_POSITION_INDEPENDENT_CODE=ON
+              -DCMAKE_OSX_SYSROOT=${CMAKE_OSX_SYSROOT}
+              -DCMAKE_OSX_DEPLOYMENT_TARGET=${CMAKE_OSX_DEPLOYMENT_TARGET}
+              -DZSTD_BUILD_SHARED=OFF
+              -DZSTD_BUILD_PROGRAMS=OFF
+              -DCMAKE_INSTALL_LIBDIR=lib
+              -G${CMAKE_GENERATOR}
+              <SOURCE_DIR>/build/cmake
+    BUILD_COMMAND ${CMAKE_COMMAND} --build .
+    INSTALL_COMMAND ${CMAKE_COMMAND} -DCMAKE_INSTALL_PREFIX=<INSTALL_DIR> -P cmake_install.cmake
+    LOG_DOWNLOAD 1 LOG_CONFIGURE 1 LOG_BUILD 1 LOG_INSTALL 1 BUILD_IN_SOURCE 1
+    BUILD_BYPRODUCTS ${ZSTD_LIBRARIES})
+  set(ZSTD_INCLUDE_DIR ${CMAKE_BINARY_DIR}/include)
+endif()
+
 
 #---Check for X11 which is mandatory lib on Unix--------------------------------------
 if(x11)
@@ -760,6 +799,20 @@ if(pgsql)
   endif()
 endif()
 
+#---Check for Apache Arrow-------------------------------------------------------------
+if(arrow)
+  message(STATUS "Looking for Apache Arrow")
+  find_package(Arrow)
+  if(NOT ARROW_FOUND)
+    if(fail-on-missing)
+      message(FATAL_ERROR "Apache Arrow libraries not found and they are required (arrow option enabled)")
+    else()
+      message(STATUS "Apache Arrow not found. Switching off arrow option")
+      set(arrow OFF CACHE BOOL "" FORCE)
+    endif()
+  endif()
+endif()
+
 #---Check for SQLite-------------------------------------------------------------------
 if(sqlite)
   message(STATUS "Looking for SQLite")
@@ -1528,6 +1581,21 @@ if (vecgeom)
   endif()
 endif()
 
+#---Check for BLAS and LAPACK for the matrix package----------------------------------
+if(lapack)
+  message(STATUS "Looking for BLAS and LAPACK")
+  find_package(LAPACK)
+  if(NOT LAPACK_FOUND)
+    if(fail-on-missing)
+      message(FATAL_ERROR "BLAS and LAPACK libraries not found and they are required (lapack option enabled)")
+    else()
+      message(STATUS "BLAS and LAPACK not found. Set BLA_VENDOR (for example to OpenBLAS or Intel10_64lp) to select the library")
+      message(STATUS "                 For the time being switching OFF 'lapack' option")
+      set(lapack OFF CACHE BOOL "" FORCE)
+    endif()
+  endif()
+endif()
+
 #---Check for CUDA and BLAS ---------------------------------------------------------
 if(tmva AND cuda)
   message(STATUS "Looking for CUDA for optional parts of TMVA")
@@ -0,0 +1,157 @@
+// @(#)root/base
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_ByteSwapArray
+#define ROOT_ByteSwapArray
+
+#include "ROOT/RConfig.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace ROOT {
+namespace Internal {
+
+// Byte swapping of whole arrays of basic types, as needed to convert the
+// big-endian representation of ROOT files from and to the machine one.
+//
+// Contrary to the R__bswap_* macros of Byteswap.h and to bswapcpy32(), which
+// swap one element at a time, these routines swap 16 bytes at a time with SSE2
+// (SSSE3 if available) and fall back to a scalar loop for the remaining
+// elements or on other architectures.  memcpy is used to load and store the
+// scalar elements, so the buffers need not be aligned.
+
+namespace ByteSwapDetail {
+
+template <std::size_t N> struct UInt;
+template <> struct UInt<2> { using Type = std::uint16_t; };
+template <> struct UInt<4> { using Type = std::uint32_t; };
+template <> struct UInt<8> { using Type = std::uint64_t; };
+
+inline std::uint16_t Swap(std::uint16_t x) { return (std::uint16_t)((x >> 8) | (x << 8)); }
+#if defined(__GNUC__) || defined(__clang__)
+inline std::uint32_t Swap(std::uint32_t x) { return __builtin_bswap32(x); }
+inline std::uint64_t Swap(std::uint64_t x) { return __builtin_bswap64(x); }
+#else
+inline std::uint32_t Swap(std::uint32_t x)
+{
+   return ((x & 0xff000000u) >> 24) | ((x & 0x00ff0000u) >> 8) | ((x & 0x0000ff00u) << 8) | ((x & 0x000000ffu) << 24);
+}
+inline std::uint64_t Swap(std::uint64_t x)
+{
+   return ((std::uint64_t)Swap((std::uint32_t)x) << 32) | Swap((std::uint32_t)(x >> 32));
+}
+#endif
+
+#if defined(__SSE2__)
+/// Swap the byte order of each of the N-byte elements of a 16-byte vector.
+template <std::size_t N>
+inline __m128i SwapVector(__m128i v)
+{
+#if defined(__SSSE3__)
+   const __m128i mask = N == 2 ? _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1)
+                      : N == 4 ? _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3)
+                               : _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+   return _mm_shuffle_epi8(v, mask);
+#else
+   // Swap the bytes of each 16-bit word, then the words of each element.
+   v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+   if (N == 4) {
+      v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+      v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+   } else if (N == 8) {
+      v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+      v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+   }
+   return v;
+#endif
+}
+#endif
+
+} // namespace ByteSwapDetail
+
+/// Copy `n` elements of `N` bytes from `from` to `to`, reversing the byte order of each element.
+/// `from` and `to` may be identical but must not otherwise overlap.
+template <std::size_t N>
+inline void ByteSwapCopy(void *to, const void *from, std::size_t n)
+{
+   using UInt_t = typename ByteSwapDetail::UInt<N>::Type;
+   const char *src = static_cast<const char *>(from);
+   char *dst = static_cast<char *>(to);
+   std::size_t i = 0;
+#if defined(__SSE2__)
+   constexpr std::size_t kPerVector = 16 / N;
+   for (; i + kPerVector <= n; i += kPerVector) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * N));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * N), ByteSwapDetail::SwapVector<N>(v));
+   }
+#endif
+   for (; i < n; ++i) {
+      UInt_t x;
+      std::memcpy(&x, src + i * N, N);
+      x = ByteSwapDetail::Swap(x);
+      std::memcpy(dst + i * N, &x, N);
+   }
+}
+
+template <>
+inline void ByteSwapCopy<1>(void *to, const void *from, std::size_t n)
+{
+   if (to != from)
+      std::memcpy(to, from, n);
+}
+
+/// Reverse, in place, the byte order of the `n` elements of `N` bytes in `buffer`.
+template <std::size_t N>
+inline void ByteSwapInPlace(void *buffer, std::size_t n)
+{
+   ByteSwapCopy<N>(buffer, buffer, n);
+}
+
+/// Copy `n` elements of `size` bytes from the big-endian (file) representation
+/// in `from` to the machine representation in `to`; `from` and `to` may be identical.
+/// Returns false if `size` is not 1, 2, 4 or 8.
+inline bool FromBigEndianArray(void *to, const void *from, std::size_t n, std::size_t size)
+{
+#ifdef R__BYTESWAP
+   switch (size) {
+   case 1: ByteSwapCopy<1>(to, from, n); return true;
+   case 2: ByteSwapCopy<2>(to, from, n); return true;
+   case 4: ByteSwapCopy<4>(to, from, n); return true;
+   case 8: ByteSwapCopy<8>(to, from, n); return true;
+   default: return false;
+   }
+#else
+   if (size != 1 && size != 2 && size != 4 && size != 8)
+      return false;
+   if (to != from)
+      std::memcpy(to, from, n * size);
+   return true;
+#endif
+}
+
+/// Same as FromBigEndianArray: the conversion is symmetric.
+inline bool ToBigEndianArray(void *to, const void *from, std::size_t n, std::size_t size)
+{
+   return FromBigEndianArray(to, from, n, size);
+}
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
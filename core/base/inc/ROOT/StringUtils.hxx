@@ -0,0 +1,57 @@
+// @(#)root/base
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_StringUtils
+#define ROOT_StringUtils
+
+#include "ROOT/RStringView.hxx"
+
+#include <cstring>
+#include <memory>
+
+namespace ROOT {
+namespace Internal {
+
+// Null terminated copy of a std::string_view, for passing it to the functions
+// taking a const char*. The names used for the lookups (of branches, keys,
+// classes, ...) are copied to a buffer on the stack; only the names longer
+// than the buffer are copied to the heap.
+
+class TNullTerminatedString {
+private:
+   enum { kBufferSize = 256 };
+   char fBuffer[kBufferSize];
+   std::unique_ptr<char[]> fLong;
+   const char *fData;
+
+   TNullTerminatedString(const TNullTerminatedString &) = delete;
+   TNullTerminatedString &operator=(const TNullTerminatedString &) = delete;
+
+public:
+   explicit TNullTerminatedString(std::string_view str)
+   {
+      char *data = fBuffer;
+      if (str.size() >= kBufferSize) {
+         fLong.reset(new char[str.size() + 1]);
+         data = fLong.get();
+      }
+      if (!str.empty())
+         memcpy(data, str.data(), str.size());
+      data[str.size()] = 0;
+      fData = data;
+   }
+
+   const char *c_str() const { return fData; }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -135,6 +135,9 @@ public:
    virtual TObject    *FindObjectAny(const char *name) const;
    virtual TObject    *FindObjectAnyFile(const char * /*name*/) const {return 0;}
    virtual TObject    *Get(const char *namecycle);
+   TObject            *Get(std::string_view namecycle);
+   TObject            *Get(const TString &namecycle) { return Get(namecycle.Data()); }
+   TObject            *Get(const std::string &namecycle) { return Get(namecycle.c_str()); }
    virtual TDirectory *GetDirectory(const char *namecycle, Bool_t printError = false, const char *funcname = "GetDirectory");
    template <class T> inline void GetObject(const char* namecycle, T*& ptr) // See TDirectory::Get for information
       {
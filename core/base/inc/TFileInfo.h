@@ -32,6 +32,8 @@
 
 #include "TList.h"
 
+#include <vector>
+
 class TFileInfoMeta;
 
 
@@ -42,6 +44,7 @@ private:
                                      //  in the fUrlList or 0, if the list end is reached
    TList           *fUrlList;        // list of file URLs
    Long64_t         fSize;           // file size
+   Long_t           fModTime;        // modification time of the file, 0 if unknown
    TUUID           *fUUID;           //-> uuid of the referenced file
    TMD5            *fMD5;            //-> md5 digest of the file
    TList           *fMetaDataList;   // generic list of file meta data object(s)
@@ -77,12 +80,14 @@ public:
    Bool_t          SetCurrentUrl(TUrl *url);
 
    Long64_t        GetSize() const         { return fSize; }
+   Long_t          GetModTime() const      { return fModTime; }
    TUUID          *GetUUID() const         { return fUUID; }
    TMD5           *GetMD5() const          { return fMD5; }
    TList          *GetMetaDataList() const { return fMetaDataList; }
    TFileInfoMeta  *GetMetaData(const char *meta = 0) const;
 
    void            SetSize(Long64_t size)  { fSize = size; }
+   void            SetModTime(Long_t t)    { fModTime = t; }
    void            SetUUID(const char *uuid);
 
    TUrl           *FindByUrl(const char *url, Bool_t withDeflt = kFALSE);
@@ -100,7 +105,7 @@ public:
 
    void            Print(Option_t *options="") const;
 
-   ClassDef(TFileInfo,4)   // Describes generic file info including meta data information
+   ClassDef(TFileInfo,5)   // Describes generic file info including meta data information
 };
 
 
@@ -113,6 +118,7 @@ private:
    Bool_t        fIsTree;     // true if type is a TTree (or TTree derived)
    Long64_t      fTotBytes;   // uncompressed size in bytes
    Long64_t      fZipBytes;   // compressed size in bytes
+   std::vector<Long64_t> fClusterStarts; // first entries of the clusters of the tree
 
    TFileInfoMeta& operator=(const TFileInfoMeta&);  // not implemented
 
@@ -142,16 +148,18 @@ public:
    Bool_t          IsTree() const          { return fIsTree; }
    Long64_t        GetTotBytes() const     { return fTotBytes; }
    Long64_t        GetZipBytes() const     { return fZipBytes; }
+   const std::vector<Long64_t> &GetClusterStarts() const { return fClusterStarts; }
 
    void            SetEntries(Long64_t entries) { fEntries = entries; }
    void            SetFirst(Long64_t first)     { fFirst = first; }
    void            SetLast(Long64_t last)       { fLast = last; }
    void            SetTotBytes(Long64_t tot)    { fTotBytes = tot; }
    void            SetZipBytes(Long64_t zip)    { fZipBytes = zip; }
+   void            SetClusterStarts(const std::vector<Long64_t> &starts) { fClusterStarts = starts; }
 
    void            Print(Option_t *options="") const;
 
-   ClassDef(TFileInfoMeta,2)   // Describes TFileInfo meta data
+   ClassDef(TFileInfoMeta,3)   // Describes TFileInfo meta data
 };
 
 #endif
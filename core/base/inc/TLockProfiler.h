@@ -0,0 +1,110 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TLockProfiler
+#define ROOT_TLockProfiler
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TLockProfiler                                                        //
+//                                                                      //
+// Opt-in statistics of the locks taken through TLockGuard,             //
+// ROOT::TReadLockGuard and ROOT::TWriteLockGuard, i.e. the             //
+// R__LOCKGUARD, R__READ_LOCKGUARD and R__WRITE_LOCKGUARD macros, per   //
+// lock and per call site: number of acquisitions, time spent waiting   //
+// for the lock and time it was held. Enable it with                    //
+// ROOT::TLockProfiler::Enable() or the resource Root.LockProfile.      //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+class TLockProfiler {
+public:
+   /// Statistics of a lock, or of one of its call sites.
+   struct TStats {
+      const void *fLock = nullptr;    ///< Address of the lock
+      std::string fName;              ///< Name given with SetLockName, or the address of the lock
+      std::string fFile;              ///< Call site; empty for the totals of the lock
+      Int_t fLine = 0;                ///< Line of the call site
+      ULong64_t fAcquisitions = 0;    ///< Number of acquisitions, shared and exclusive
+      ULong64_t fShared = 0;          ///< Number of shared (read) acquisitions
+      Double_t fWaitTime = 0;         ///< Total time waited for the lock, in seconds
+      Double_t fMaxWaitTime = 0;      ///< Longest wait, in seconds
+      Double_t fHoldTime = 0;         ///< Total time the lock was held, in seconds
+      Double_t fMaxHoldTime = 0;      ///< Longest holding, in seconds
+   };
+
+   /// Time measurement of one acquisition, as done by the lock guards.
+   class TAcquisition {
+   private:
+      const char *fFile;
+      Int_t fLine;
+      Long64_t fStart = 0;
+      Long64_t fAcquired = 0;
+
+   public:
+      TAcquisition(const char *file, Int_t line) : fFile(file), fLine(line) {}
+      /// Start measuring if the profiler is enabled; the lock is taken right after.
+      void Begin()
+      {
+         if (R__unlikely(IsEnabled()))
+            fStart = Now();
+      }
+      /// The lock has been taken.
+      void Acquired()
+      {
+         if (R__unlikely(fStart))
+            fAcquired = Now();
+      }
+      /// The lock is about to be released.
+      void End(const void *lock, Bool_t shared)
+      {
+         if (R__unlikely(fAcquired)) {
+            Record(lock, fFile, fLine, shared, fAcquired - fStart, Now() - fAcquired);
+            fStart = fAcquired = 0;
+         }
+      }
+   };
+
+private:
+   static std::atomic<Bool_t> fgEnabled;
+
+public:
+   static void Enable(Bool_t enable = kTRUE);
+   static Bool_t IsEnabled() { return fgEnabled.load(std::memory_order_relaxed); }
+   static void SetPrintAtExit(Bool_t print = kTRUE);
+
+   static void SetLockName(const void *lock, const char *name);
+   static std::vector<TStats> GetLockStats();
+   static std::vector<TStats> GetSiteStats(const void *lock = nullptr);
+   static void Print(Option_t *option = "");
+   static void Reset();
+
+   /// Steady clock, in nanoseconds.
+   static Long64_t Now()
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+   static void Record(const void *lock, const char *file, Int_t line, Bool_t shared, Long64_t wait, Long64_t hold);
+};
+
+} // namespace ROOT
+
+#endif
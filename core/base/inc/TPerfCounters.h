@@ -0,0 +1,100 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TPerfCounters
+#define ROOT_TPerfCounters
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TPerfCounters                                                        //
+//                                                                      //
+// Process-wide registry of throughput counters (bytes read, baskets    //
+// unzipped, cache hits, IMT tasks pending, TBufferMerger queue,        //
+// jitting time, ...). The subsystems update them through thread-local  //
+// slots, the reads sum the slots of all threads. The counters are      //
+// published by THttpServer, in the PerfCounters folder and as          //
+// Prometheus text at /metrics.                                         //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+class TPerfCounters {
+public:
+   enum EType {
+      kCounter, ///< Monotonic total, e.g. a number of bytes
+      kGauge    ///< Current level, e.g. the length of a queue
+   };
+
+   enum { kMaxCounters = 128 };
+
+   /// Handle of a registered counter, cheap to copy and to update.
+   class TCounter {
+   private:
+      Int_t fIndex = -1;
+
+   public:
+      TCounter() = default;
+      explicit TCounter(Int_t index) : fIndex(index) {}
+      Int_t GetIndex() const { return fIndex; }
+      /// Add v to the counter, in the slot of the calling thread.
+      void Add(Long64_t v = 1) const { TPerfCounters::Add(fIndex, v); }
+   };
+
+   /// Adds the time spent in its scope, in nanoseconds, to a counter.
+   class TScopedTimer {
+   private:
+      TCounter fCounter;
+      Long64_t fStart;
+
+   public:
+      explicit TScopedTimer(TCounter counter) : fCounter(counter), fStart(Now()) {}
+      ~TScopedTimer() { fCounter.Add(Now() - fStart); }
+   };
+
+   /// Value of a counter or of a probe at the time of the read.
+   struct TValue {
+      std::string fName;   ///< Name, following the Prometheus conventions
+      std::string fHelp;   ///< One line description
+      EType fType;         ///< Counter or gauge
+      Double_t fValue;     ///< Sum over the threads, multiplied by the scale
+   };
+
+   using Probe_t = std::function<Double_t()>;
+
+   static TCounter Register(const char *name, const char *help, EType type = kCounter, Double_t scale = 1.);
+   static void RegisterProbe(const char *name, const char *help, EType type, const Probe_t &probe);
+
+   static void Add(Int_t index, Long64_t v);
+   static Double_t GetValue(const char *name);
+   static std::vector<TValue> GetValues();
+   static std::string FormatPrometheus();
+   static void Print(Option_t *option = "");
+   static void Reset();
+
+   /// Steady clock, in nanoseconds.
+   static Long64_t Now()
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+};
+
+} // namespace ROOT
+
+#endif
@@ -62,6 +62,65 @@ namespace ROOT {
                return t;
             }
       };
+
+     /**
+      * \class ROOT::Internal::TReferencedObjects
+      * \brief Table of the objects referenced through a TProcessID, indexed by their uid.
+      *
+      * The table is made of chunks of 64, 128, 256, ... entries, allocated on demand
+      * and never moved: growing the table does not copy it, and the lookups and the
+      * stores do not take any lock. Only Clear must not run concurrently with them.
+      */
+      class TReferencedObjects {
+         public:
+            enum { kFirstChunkBits = 6, kNChunks = 19 }; // 64 * (2^19 - 1) entries cover the 24 bits of the uids
+
+         private:
+            using Chunk_t = std::atomic<TObject *>;
+            std::atomic<Chunk_t *> fChunks[kNChunks];
+
+            TReferencedObjects(const TReferencedObjects &) = delete;
+            TReferencedObjects &operator=(const TReferencedObjects &) = delete;
+
+            /// Return the chunk holding uid, and the position of uid in it.
+            static Int_t ChunkOf(UInt_t uid, UInt_t &offset)
+            {
+               const UInt_t q = (uid >> kFirstChunkBits) + 1;
+#if defined(__GNUC__)
+               const Int_t chunk = 31 - __builtin_clz(q);
+#else
+               Int_t chunk = 0;
+               while (q >> (chunk + 1))
+                  ++chunk;
+#endif
+               offset = uid - (((1u << chunk) - 1) << kFirstChunkBits);
+               return chunk;
+            }
+
+            static UInt_t ChunkSize(Int_t chunk) { return 1u << (chunk + kFirstChunkBits); }
+
+         public:
+            TReferencedObjects()
+            {
+               for (auto &chunk : fChunks)
+                  chunk = nullptr;
+            }
+            ~TReferencedObjects() { Clear(); }
+
+            /// Return the object stored for uid, or nullptr.
+            TObject *At(UInt_t uid) const
+            {
+               UInt_t offset;
+               const Int_t chunk = ChunkOf(uid & 0xffffff, offset);
+               const Chunk_t *entries = fChunks[chunk].load(std::memory_order_acquire);
+               return entries ? entries[offset].load(std::memory_order_acquire) : nullptr;
+            }
+
+            void   AddAt(TObject *obj, UInt_t uid);
+            void   Clear();
+            Int_t  GetEntries() const;
+            UInt_t GetSize() const;
+      };
    } // End of namespace Internal
 } // End of namespace ROOT
 
@@ -74,8 +133,9 @@ private:
 
 protected:
    std::atomic_int    fCount;                           //!Reference count to this object (from TFile)
-   ROOT::Internal::TAtomicPointer<TObjArray*> fObjects; //!Array pointing to the referenced objects
-   std::atomic_flag   fLock;                            //!Spin lock for initialization of fObjects
+   ROOT::Internal::TAtomicPointer<TObjArray*> fObjects; //!Copy of the table of the referenced objects, see GetObjects
+   std::atomic_flag   fLock;                            //!Spin lock for the update of fObjects
+   ROOT::Internal::TReferencedObjects fTable;           //!Table of the referenced objects, indexed by their uid
 
    static TProcessID *fgPID;      //Pointer to current session ProcessID
    static TObjArray  *fgPIDs;     //Table of ProcessIDs
@@ -90,7 +150,7 @@ public:
    Int_t            DecrementCount();
    Int_t            IncrementCount();
    Int_t            GetCount() const {return fCount;}
-   TObjArray       *GetObjects() const {return fObjects;}
+   TObjArray       *GetObjects() const;
    TObject         *GetObjectWithID(UInt_t uid);
    void             PutObjectWithID(TObject *obj, UInt_t uid=0);
    virtual void     RecursiveRemove(TObject *obj);
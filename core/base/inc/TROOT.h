@@ -30,6 +30,7 @@
 #include "RConfigure.h"
 
 #include <atomic>
+#include <vector>
 
 class TClass;
 class TCanvas;
@@ -92,9 +93,19 @@ namespace ROOT {
    /// \brief Enable ROOT's implicit multi-threading for all objects and methods that provide an internal
    /// parallelisation mechanism.
    void EnableImplicitMT(UInt_t numthreads = 0);
+   /// \brief Placement options of the threads of the implicit multi-threading, see EnableImplicitMT(UInt_t, UInt_t).
+   enum EIMTPlacement : UInt_t {
+      kIMTNumaArenas = BIT(0), ///< One task arena per NUMA node, its worker threads bound to the CPUs of the node
+      kIMTPinThreads = BIT(1)  ///< Each worker thread bound to one CPU
+   };
+   void EnableImplicitMT(UInt_t numthreads, UInt_t placement);
    void DisableImplicitMT();
    Bool_t IsImplicitMTEnabled();
    UInt_t GetImplicitMTPoolSize();
+   UInt_t GetImplicitMTNumaNodes();
+   UInt_t GetImplicitMTNodePoolSize(UInt_t node);
+   std::vector<Int_t> GetImplicitMTNodeCpus(UInt_t node);
+   Int_t GetImplicitMTCurrentNode();
 }
 
 class TROOT : public TDirectory {
@@ -0,0 +1,72 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TStartupTracer
+#define ROOT_TStartupTracer
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TStartupTracer                                                       //
+//                                                                      //
+// Records the wall time of the initialization steps of ROOT (TROOT,    //
+// TCling, PCH and PCM loading, rootmap parsing, library loading,       //
+// autoloading and autoparsing) and the file system accesses done by    //
+// TSystem within them, and writes them at the end of the process as a  //
+// Chrome trace (chrome://tracing, Perfetto). It is enabled by the      //
+// environment variable ROOT_STARTUP_TRACE, set to the name of the      //
+// trace file or to 1 for root_startup_trace_<pid>.json.                //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+#include <string>
+
+namespace ROOT {
+
+class TStartupTracer {
+public:
+   /// Traces a step from its construction to its destruction.
+   class TScope {
+   private:
+      const char *fCategory;
+      const char *fName;
+      std::string fArg;
+      Double_t fStart = -1;
+      Long64_t fFSAccesses = 0;
+
+      TScope(const TScope &) = delete;
+      TScope &operator=(const TScope &) = delete;
+
+   public:
+      /// Trace the step name of category, which must be string literals, with
+      /// the optional argument arg (e.g. a file or class name).
+      TScope(const char *category, const char *name, const char *arg = nullptr) : fCategory(category), fName(name)
+      {
+         if (R__unlikely(IsEnabled()))
+            Begin(arg);
+      }
+      ~TScope()
+      {
+         if (R__unlikely(fStart >= 0))
+            End();
+      }
+      void Begin(const char *arg);
+      void End();
+   };
+
+   static Bool_t IsEnabled();
+   static void Write();
+};
+
+} // namespace ROOT
+
+#endif
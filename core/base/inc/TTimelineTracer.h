@@ -0,0 +1,94 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTimelineTracer
+#define ROOT_TTimelineTracer
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TTimelineTracer                                                      //
+//                                                                      //
+// Opt-in timeline of what the threads of a process are doing: the      //
+// tasks of the implicit multi-threading pool (TTaskGroup,              //
+// TThreadExecutor), the file reads, the reading and unzipping of the   //
+// baskets, the TTreeCache fills and the TBufferMerger writes are       //
+// recorded as spans with their thread, and written as a Chrome trace   //
+// (chrome://tracing, Perfetto). Enable it with                         //
+// ROOT::TTimelineTracer::Enable() or the resource Root.TimelineTrace.  //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace ROOT {
+
+class TTimelineTracer {
+public:
+   /// Records a span from its construction to its destruction, if the tracer is enabled.
+   class TSpan {
+   private:
+      const char *fCategory;
+      const char *fName;
+      const char *fArgName;
+      Long64_t fArg;
+      Long64_t fStart = 0;
+
+      TSpan(const TSpan &) = delete;
+      TSpan &operator=(const TSpan &) = delete;
+
+   public:
+      /// Trace the span name of category, with the optional integer argument
+      /// argName (e.g. a number of bytes or an entry). The strings are not
+      /// copied: they must be string literals.
+      TSpan(const char *category, const char *name, const char *argName = nullptr, Long64_t arg = 0)
+         : fCategory(category), fName(name), fArgName(argName), fArg(arg)
+      {
+         if (R__unlikely(IsEnabled()))
+            fStart = Now();
+      }
+      ~TSpan()
+      {
+         if (R__unlikely(fStart))
+            Record(fCategory, fName, fArgName, fArg, fStart, Now());
+      }
+      /// Change the argument, e.g. once the number of bytes is known.
+      void SetArg(Long64_t arg) { fArg = arg; }
+   };
+
+private:
+   static std::atomic<Bool_t> fgEnabled;
+
+public:
+   static void Enable(const char *filename = nullptr);
+   static void Disable();
+   static Bool_t IsEnabled() { return fgEnabled.load(std::memory_order_relaxed); }
+
+   static void SetThreadName(const char *name);
+   static ULong64_t GetNSpans();
+   static Bool_t Write(const char *filename);
+   static void Reset();
+
+   /// Steady clock, in nanoseconds.
+   static Long64_t Now()
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+   static void Record(const char *category, const char *name, const char *argName, Long64_t arg, Long64_t start,
+                      Long64_t end);
+};
+
+} // namespace ROOT
+
+#endif
@@ -23,6 +23,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "TObject.h"
+#include "TLockProfiler.h"
 
 #include <memory>
 
@@ -70,20 +71,33 @@ class TLockGuard {
 
 private:
    TVirtualMutex *fMutex;
+   ROOT::TLockProfiler::TAcquisition fAcquisition; //! Measurement for ROOT::TLockProfiler
 
    TLockGuard(const TLockGuard&);             // not implemented
    TLockGuard& operator=(const TLockGuard&);  // not implemented
 
 public:
-   TLockGuard(TVirtualMutex *mutex)
-     : fMutex(mutex) { if (fMutex) fMutex->Lock(); }
+   TLockGuard(TVirtualMutex *mutex, const char *file = nullptr, Int_t line = 0)
+     : fMutex(mutex), fAcquisition(file, line) {
+      if (fMutex) {
+         fAcquisition.Begin();
+         fMutex->Lock();
+         fAcquisition.Acquired();
+      }
+   }
    Int_t UnLock() {
       if (!fMutex) return 0;
       auto tmp = fMutex;
       fMutex = 0;
+      fAcquisition.End(tmp, kFALSE);
       return tmp->UnLock();
    }
-   ~TLockGuard() { if (fMutex) fMutex->UnLock(); }
+   ~TLockGuard() {
+      if (fMutex) {
+         fAcquisition.End(fMutex, kFALSE);
+         fMutex->UnLock();
+      }
+   }
 
    ClassDefNV(TLockGuard,0)  // Exception safe locking/unlocking of mutex
 };
@@ -91,7 +105,7 @@ public:
 // Zero overhead macros in case not compiled with thread support
 #if defined (_REENTRANT) || defined (WIN32)
 
-#define R__LOCKGUARD(mutex) TLockGuard _R__UNIQUE_(R__guard)(mutex)
+#define R__LOCKGUARD(mutex) TLockGuard _R__UNIQUE_(R__guard)(mutex, __FILE__, __LINE__)
 #define R__LOCKGUARD2(mutex)                             \
    if (gGlobalMutex && !mutex) {                         \
       gGlobalMutex->Lock();                              \
@@ -100,7 +114,7 @@ public:
       gGlobalMutex->UnLock();                            \
    }                                                     \
    R__LOCKGUARD(mutex)
-#define R__LOCKGUARD_NAMED(name,mutex) TLockGuard _NAME2_(R__guard,name)(mutex)
+#define R__LOCKGUARD_NAMED(name,mutex) TLockGuard _NAME2_(R__guard,name)(mutex, __FILE__, __LINE__)
 #define R__LOCKGUARD_UNLOCK(name) _NAME2_(R__guard,name).UnLock()
 #else
 #define R__LOCKGUARD(mutex)  (void)mutex; { }
@@ -63,6 +63,20 @@ public:
 
    virtual void UnzipEvent(TObject *tree, Long64_t pos, Double_t start, Int_t complen, Int_t objlen) = 0;
 
+   // Called for each basket read, compressed or not; start is 0 if the basket was not decompressed here
+   virtual void BasketReadEvent(TObject * /*branch*/, Long64_t /*pos*/, Double_t /*start*/, Int_t /*complen*/,
+                                Int_t /*objlen*/) {}
+
+   // Called for each entry serialized by a branch into its basket, nbytes is the size of the entry
+   virtual void BranchFillEvent(TObject * /*branch*/, Double_t /*start*/, Int_t /*nbytes*/) {}
+
+   // Called for each basket written; ziptime is the time spent compressing, start the TimeStamp before the write
+   virtual void BasketWriteEvent(TObject * /*branch*/, Double_t /*ziptime*/, Double_t /*start*/, Int_t /*objlen*/,
+                                 Int_t /*complen*/) {}
+
+   // Called for each flush of the baskets of a tree, nbytes is the number of bytes written or -1 on error
+   virtual void FlushEvent(TObject * /*tree*/, Double_t /*start*/, Int_t /*nbytes*/) {}
+
    virtual void RateEvent(Double_t proctime, Double_t deltatime,
                           Long64_t eventsprocessed, Long64_t bytesRead) = 0;
 
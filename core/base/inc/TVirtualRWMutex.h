@@ -98,16 +98,27 @@ class TReadLockGuard {
 private:
    TVirtualRWMutex *const fMutex;
    TVirtualRWMutex::Hint_t *fHint;
+   TLockProfiler::TAcquisition fAcquisition; //! Measurement for ROOT::TLockProfiler
 
    TReadLockGuard(const TReadLockGuard&) = delete;
    TReadLockGuard& operator=(const TReadLockGuard&) = delete;
 
 public:
-   TReadLockGuard(TVirtualRWMutex *mutex) : fMutex(mutex), fHint(nullptr) {
-      if (fMutex) fHint = fMutex->ReadLock();
+   TReadLockGuard(TVirtualRWMutex *mutex, const char *file = nullptr, Int_t line = 0)
+      : fMutex(mutex), fHint(nullptr), fAcquisition(file, line) {
+      if (fMutex) {
+         fAcquisition.Begin();
+         fHint = fMutex->ReadLock();
+         fAcquisition.Acquired();
+      }
    }
 
-   ~TReadLockGuard() { if (fMutex) fMutex->ReadUnLock(fHint); }
+   ~TReadLockGuard() {
+      if (fMutex) {
+         fAcquisition.End(fMutex, kTRUE);
+         fMutex->ReadUnLock(fHint);
+      }
+   }
 
    ClassDefNV(TReadLockGuard,0)  // Exception safe read locking/unlocking of mutex
 };
@@ -117,16 +128,27 @@ class TWriteLockGuard {
 private:
    TVirtualRWMutex *const fMutex;
    TVirtualRWMutex::Hint_t *fHint;
+   TLockProfiler::TAcquisition fAcquisition; //! Measurement for ROOT::TLockProfiler
 
    TWriteLockGuard(const TWriteLockGuard&) = delete;
    TWriteLockGuard& operator=(const TWriteLockGuard&) = delete;
 
 public:
-   TWriteLockGuard(TVirtualRWMutex *mutex) : fMutex(mutex), fHint(nullptr) {
-      if (fMutex) fHint = fMutex->WriteLock();
+   TWriteLockGuard(TVirtualRWMutex *mutex, const char *file = nullptr, Int_t line = 0)
+      : fMutex(mutex), fHint(nullptr), fAcquisition(file, line) {
+      if (fMutex) {
+         fAcquisition.Begin();
+         fHint = fMutex->WriteLock();
+         fAcquisition.Acquired();
+      }
    }
 
-   ~TWriteLockGuard() { if (fMutex) fMutex->WriteUnLock(fHint); }
+   ~TWriteLockGuard() {
+      if (fMutex) {
+         fAcquisition.End(fMutex, kFALSE);
+         fMutex->WriteUnLock(fHint);
+      }
+   }
 
    ClassDefNV(TWriteLockGuard,0)  // Exception safe read locking/unlocking of mutex
 };
@@ -136,11 +158,11 @@ public:
 // Zero overhead macros in case not compiled with thread support
 #if defined (_REENTRANT) || defined (WIN32)
 
-#define R__READ_LOCKGUARD(mutex) ::ROOT::TReadLockGuard _R__UNIQUE_(R__readguard)(mutex)
-#define R__READ_LOCKGUARD_NAMED(name,mutex) ::ROOT::TReadLockGuard _NAME2_(R__readguard,name)(mutex)
+#define R__READ_LOCKGUARD(mutex) ::ROOT::TReadLockGuard _R__UNIQUE_(R__readguard)(mutex, __FILE__, __LINE__)
+#define R__READ_LOCKGUARD_NAMED(name,mutex) ::ROOT::TReadLockGuard _NAME2_(R__readguard,name)(mutex, __FILE__, __LINE__)
 
-#define R__WRITE_LOCKGUARD(mutex) ::ROOT::TWriteLockGuard _R__UNIQUE_(R__readguard)(mutex)
-#define R__WRITE_LOCKGUARD_NAMED(name,mutex) ::ROOT::TWriteLockGuard _NAME2_(R__readguard,name)(mutex)
+#define R__WRITE_LOCKGUARD(mutex) ::ROOT::TWriteLockGuard _R__UNIQUE_(R__readguard)(mutex, __FILE__, __LINE__)
+#define R__WRITE_LOCKGUARD_NAMED(name,mutex) ::ROOT::TWriteLockGuard _NAME2_(R__readguard,name)(mutex, __FILE__, __LINE__)
 
 #else
 
@@ -212,6 +212,12 @@ TApplication::TApplication(const char *appClassName, Int_t *argc, char **argv,
       }
    }
 
+   // activate the sampling heap profiler, which reports at the end of the process
+   if (Int_t interval = gEnv->GetValue("Root.TMemProfiler", 0)) {
+      const char *file = gEnv->GetValue("Root.TMemProfiler.file", "memprofile.txt");
+      gROOT->ProcessLine(Form("TMemProfiler::Start(%d,\"%s\");", interval, file));
+   }
+
    //Needs to be done last
    gApplication = this;
    gROOT->SetApplication(this);
@@ -0,0 +1,133 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TChromeTraceWriter
+#define ROOT_TChromeTraceWriter
+
+#include "Rtypes.h"
+
+#include <cstdio>
+#include <string>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writer of a trace in the Chrome trace event format, as read by
+/// chrome://tracing and Perfetto, for the tracers of libCore
+/// (TStartupTracer, TTimelineTracer). The times are in microseconds; all the
+/// events belong to the current process. An event is written with
+/// BeginEvent, optionally WriteArg, then EndEvent. The file is completed
+/// and closed by the destructor.
+
+class TChromeTraceWriter {
+private:
+   FILE *fFile;       ///< Null if the file could not be opened
+   int fPid;          ///< Process of the events
+   bool fFirstEvent;  ///< No event was written yet
+   bool fFirstArg;    ///< No argument of the current event was written yet
+
+   void WriteSeparator()
+   {
+      if (!fFirstEvent)
+         fputs(",\n", fFile);
+      fFirstEvent = false;
+      fFirstArg = true;
+   }
+
+   void WriteArgName(const char *name)
+   {
+      fputs(fFirstArg ? ",\"args\":{" : ",", fFile);
+      fFirstArg = false;
+      WriteString(name);
+      fputc(':', fFile);
+   }
+
+public:
+   explicit TChromeTraceWriter(const char *filename)
+      : fFile(fopen(filename, "w")), fPid(getpid()), fFirstEvent(true), fFirstArg(true)
+   {
+      if (fFile)
+         fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", fFile);
+   }
+
+   ~TChromeTraceWriter()
+   {
+      if (!fFile)
+         return;
+      fputs("\n]}\n", fFile);
+      fclose(fFile);
+   }
+
+   TChromeTraceWriter(const TChromeTraceWriter &) = delete;
+   TChromeTraceWriter &operator=(const TChromeTraceWriter &) = delete;
+
+   bool IsOpen() const { return fFile != nullptr; }
+
+   /// Write str as a JSON string.
+   void WriteString(const std::string &str)
+   {
+      fputc('"', fFile);
+      for (unsigned char c : str) {
+         if (c == '"' || c == '\\')
+            fprintf(fFile, "\\%c", c);
+         else if (c < 0x20)
+            fprintf(fFile, "\\u%04x", c);
+         else
+            fputc(c, fFile);
+      }
+      fputc('"', fFile);
+   }
+
+   /// Write the event naming the thread tid.
+   void WriteThreadName(Int_t tid, const std::string &name)
+   {
+      WriteSeparator();
+      fprintf(fFile, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":", fPid, tid);
+      WriteString(name);
+      fputs("}}", fFile);
+   }
+
+   /// Begin a complete event of thread tid, starting at ts and lasting dur.
+   void BeginEvent(Int_t tid, Double_t ts, Double_t dur, const std::string &category, const std::string &name)
+   {
+      WriteSeparator();
+      fprintf(fFile, "{\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"cat\":", fPid, tid, ts, dur);
+      WriteString(category);
+      fputs(",\"name\":", fFile);
+      WriteString(name);
+   }
+
+   void WriteArg(const char *name, const std::string &value)
+   {
+      WriteArgName(name);
+      WriteString(value);
+   }
+
+   void WriteArg(const char *name, Long64_t value)
+   {
+      WriteArgName(name);
+      fprintf(fFile, "%lld", value);
+   }
+
+   void EndEvent() { fputs(fFirstArg ? "}" : "}}", fFile); }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
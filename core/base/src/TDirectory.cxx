@@ -27,6 +27,7 @@
 #include "TMethod.h"
 
 #include "TSpinLockGuard.h"
+#include "ROOT/StringUtils.hxx"
 
 Bool_t TDirectory::fgAddDirectory = kTRUE;
 
@@ -841,6 +842,17 @@ TObject *TDirectory::Get(const char *namecycle)
    return idcur;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return pointer to object identified by namecycle, given as a string_view.
+/// The name is copied to a buffer on the stack to be passed to
+/// Get(const char*), without any allocation for the usual names.
+
+TObject *TDirectory::Get(std::string_view namecycle)
+{
+   ROOT::Internal::TNullTerminatedString cname(namecycle);
+   return Get(cname.c_str());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return pointer to object identified by namecycle.
 /// The returned object may or may not derive from TObject.
@@ -30,7 +30,7 @@ ClassImp(TFileInfoMeta);
 
 TFileInfo::TFileInfo(const char *in, Long64_t size, const char *uuid,
                      const char *md5, TObject *meta)
-   : fCurrentUrl(0), fUrlList(0), fSize(-1), fUUID(0), fMD5(0),
+   : fCurrentUrl(0), fUrlList(0), fSize(-1), fModTime(0), fUUID(0), fMD5(0),
      fMetaDataList(0), fIndex(-1)
 {
    // Get initializations form the input string: this will set at least the
@@ -72,7 +72,8 @@ TFileInfo::TFileInfo(const char *in, Long64_t size, const char *uuid,
 
 TFileInfo::TFileInfo(const TFileInfo &fi) : TNamed(fi.GetName(), fi.GetTitle()),
                                             fCurrentUrl(0), fUrlList(0),
-                                            fSize(fi.fSize), fUUID(0), fMD5(0),
+                                            fSize(fi.fSize), fModTime(fi.fModTime),
+                                            fUUID(0), fMD5(0),
                                             fMetaDataList(0), fIndex(fi.fIndex)
 {
    if (fi.fUrlList) {
@@ -570,6 +571,7 @@ TFileInfoMeta::TFileInfoMeta(const TFileInfoMeta &m)
    fIsTree = m.fIsTree;
    fTotBytes = m.fTotBytes;
    fZipBytes = m.fZipBytes;
+   fClusterStarts = m.fClusterStarts;
    ResetBit(TFileInfoMeta::kExternal);
    if (m.TestBit(TFileInfoMeta::kExternal)) SetBit(TFileInfoMeta::kExternal);
 }
@@ -0,0 +1,281 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class ROOT::TLockProfiler
+\ingroup Base
+
+Opt-in statistics of the locks taken through TLockGuard, ROOT::TReadLockGuard
+and ROOT::TWriteLockGuard, that is through the R__LOCKGUARD, R__LOCKGUARD2,
+R__READ_LOCKGUARD and R__WRITE_LOCKGUARD macros.
+
+For every lock and every call site, the profiler counts the acquisitions,
+the shared ones among them, and measures the time spent waiting for the lock
+and the time it was held. It is enabled with ROOT::TLockProfiler::Enable() or
+the resource (in .rootrc)
+
+    Root.LockProfile: 1
+
+where 2 also prints the statistics at the end of the process. They can be
+read at any time with GetLockStats() and GetSiteStats(), or printed with
+Print("sites"). ROOT::gCoreMutex, which is also gROOTMutex and
+gInterpreterMutex, and gGlobalMutex are named; the other locks are shown by
+address together with their busiest call site.
+
+Each thread accumulates its measurements in its own table, the reads merge
+them. When the profiler is disabled, the lock guards only test a flag.
+*/
+
+#include "TLockProfiler.h"
+#include "TThreadRegistry.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+std::atomic<Bool_t> ROOT::TLockProfiler::fgEnabled(kFALSE);
+
+namespace {
+
+struct TSiteKey {
+   const void *fLock;
+   const char *fFile;
+   Int_t fLine;
+   bool operator<(const TSiteKey &other) const
+   {
+      return std::tie(fLock, fFile, fLine) < std::tie(other.fLock, other.fFile, other.fLine);
+   }
+};
+
+struct TSiteCounts {
+   ULong64_t fAcquisitions = 0;
+   ULong64_t fShared = 0;
+   Long64_t fWait = 0;
+   Long64_t fMaxWait = 0;
+   Long64_t fHold = 0;
+   Long64_t fMaxHold = 0;
+   void Add(const TSiteCounts &other)
+   {
+      fAcquisitions += other.fAcquisitions;
+      fShared += other.fShared;
+      fWait += other.fWait;
+      fMaxWait = std::max(fMaxWait, other.fMaxWait);
+      fHold += other.fHold;
+      fMaxHold = std::max(fMaxHold, other.fMaxHold);
+   }
+};
+
+using SiteMap_t = std::map<TSiteKey, TSiteCounts>;
+
+// Measurements of one thread; its mutex is only contended while the statistics are read.
+struct TThreadTable {
+   std::mutex fMutex;
+   SiteMap_t fSites;
+};
+
+struct TProfilerState : ROOT::Internal::TThreadRegistry<TProfilerState, TThreadTable> {
+   std::map<const void *, std::string> fNames;
+   bool fPrintAtExitRegistered = false;
+};
+
+SiteMap_t MergeTables()
+{
+   SiteMap_t merged;
+   TProfilerState &state = TProfilerState::Get();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   for (auto &table : state.fThreads) {
+      std::lock_guard<std::mutex> tableLock(table->fMutex);
+      for (auto &site : table->fSites)
+         merged[site.first].Add(site.second);
+   }
+   return merged;
+}
+
+ROOT::TLockProfiler::TStats MakeStats(const void *lock, const TSiteCounts &counts)
+{
+   ROOT::TLockProfiler::TStats stats;
+   stats.fLock = lock;
+   {
+      TProfilerState &state = TProfilerState::Get();
+      std::lock_guard<std::mutex> guard(state.fMutex);
+      auto name = state.fNames.find(lock);
+      if (name != state.fNames.end()) {
+         stats.fName = name->second;
+      } else {
+         char address[32];
+         snprintf(address, sizeof(address), "%p", lock);
+         stats.fName = address;
+      }
+   }
+   stats.fAcquisitions = counts.fAcquisitions;
+   stats.fShared = counts.fShared;
+   stats.fWaitTime = counts.fWait * 1e-9;
+   stats.fMaxWaitTime = counts.fMaxWait * 1e-9;
+   stats.fHoldTime = counts.fHold * 1e-9;
+   stats.fMaxHoldTime = counts.fMaxHold * 1e-9;
+   return stats;
+}
+
+bool MoreWait(const ROOT::TLockProfiler::TStats &a, const ROOT::TLockProfiler::TStats &b)
+{
+   return a.fWaitTime > b.fWaitTime;
+}
+
+void PrintAtExit()
+{
+   ROOT::TLockProfiler::Print("sites");
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start or stop recording the acquisitions of the locks. The statistics
+/// gathered so far are kept, see Reset().
+
+void ROOT::TLockProfiler::Enable(Bool_t enable)
+{
+   fgEnabled = enable;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable the profiler and print its statistics at the end of the process.
+
+void ROOT::TLockProfiler::SetPrintAtExit(Bool_t print)
+{
+   if (!print)
+      return;
+   Enable();
+   TProfilerState &state = TProfilerState::Get();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   if (!state.fPrintAtExitRegistered) {
+      state.fPrintAtExitRegistered = true;
+      atexit(PrintAtExit);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Name the lock at address lock in the statistics.
+
+void ROOT::TLockProfiler::SetLockName(const void *lock, const char *name)
+{
+   TProfilerState &state = TProfilerState::Get();
+   std::lock_guard<std::mutex> guard(state.fMutex);
+   state.fNames[lock] = name ? name : "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record an acquisition of lock, at file:line, which waited for wait and
+/// held the lock for hold nanoseconds.
+
+void ROOT::TLockProfiler::Record(const void *lock, const char *file, Int_t line, Bool_t shared, Long64_t wait,
+                                 Long64_t hold)
+{
+   TThreadTable &table = TProfilerState::GetThreadData();
+   std::lock_guard<std::mutex> guard(table.fMutex);
+   TSiteCounts &counts = table.fSites[TSiteKey{lock, file, line}];
+   ++counts.fAcquisitions;
+   if (shared)
+      ++counts.fShared;
+   counts.fWait += wait;
+   counts.fMaxWait = std::max(counts.fMaxWait, wait);
+   counts.fHold += hold;
+   counts.fMaxHold = std::max(counts.fMaxHold, hold);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the statistics of each lock, all call sites together, the most
+/// waited for lock first.
+
+std::vector<ROOT::TLockProfiler::TStats> ROOT::TLockProfiler::GetLockStats()
+{
+   std::map<const void *, TSiteCounts> locks;
+   for (auto &site : MergeTables())
+      locks[site.first.fLock].Add(site.second);
+   std::vector<TStats> result;
+   for (auto &lock : locks)
+      result.push_back(MakeStats(lock.first, lock.second));
+   std::stable_sort(result.begin(), result.end(), MoreWait);
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the statistics of each call site of lock, or of all locks if lock
+/// is null, the most waiting one first.
+
+std::vector<ROOT::TLockProfiler::TStats> ROOT::TLockProfiler::GetSiteStats(const void *lock)
+{
+   // The same header can be seen under several __FILE__ pointers.
+   std::map<std::tuple<const void *, std::string, Int_t>, TSiteCounts> sites;
+   for (auto &site : MergeTables()) {
+      if (lock && site.first.fLock != lock)
+         continue;
+      sites[std::make_tuple(site.first.fLock, std::string(site.first.fFile ? site.first.fFile : "?"),
+                            site.first.fLine)]
+         .Add(site.second);
+   }
+   std::vector<TStats> result;
+   for (auto &site : sites) {
+      TStats stats = MakeStats(std::get<0>(site.first), site.second);
+      stats.fFile = std::get<1>(site.first);
+      stats.fLine = std::get<2>(site.first);
+      result.push_back(stats);
+   }
+   std::stable_sort(result.begin(), result.end(), MoreWait);
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the statistics of the locks. With the option "sites", also print
+/// those of their call sites.
+
+void ROOT::TLockProfiler::Print(Option_t *option)
+{
+   const Bool_t sites = option && strstr(option, "sites");
+   const std::vector<TStats> locks = GetLockStats();
+   const std::vector<TStats> allSites = GetSiteStats();
+   printf("Lock profile: %d lock(s)\n", (int)locks.size());
+   printf("%-44s %12s %12s %10s %12s %10s %12s\n", "Lock / call site", "Acquired", "Shared", "Wait [s]",
+          "MaxWait [ms]", "Held [s]", "MaxHeld [ms]");
+   for (auto &lock : locks) {
+      printf("%-44s %12llu %12llu %10.4f %12.3f %10.4f %12.3f\n", lock.fName.c_str(), lock.fAcquisitions,
+             lock.fShared, lock.fWaitTime, lock.fMaxWaitTime * 1e3, lock.fHoldTime, lock.fMaxHoldTime * 1e3);
+      for (auto &site : allSites) {
+         if (site.fLock != lock.fLock)
+            continue;
+         std::string where = site.fFile;
+         auto slash = where.find_last_of("/\\");
+         if (slash != std::string::npos)
+            where = where.substr(slash + 1);
+         where = "   " + where + ":" + std::to_string(site.fLine);
+         printf("%-44s %12llu %12llu %10.4f %12.3f %10.4f %12.3f\n", where.c_str(), site.fAcquisitions, site.fShared,
+                site.fWaitTime, site.fMaxWaitTime * 1e3, site.fHoldTime, site.fMaxHoldTime * 1e3);
+         // Without the option, only the site waited the most helps identifying an unnamed lock.
+         if (!sites)
+            break;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the statistics gathered so far.
+
+void ROOT::TLockProfiler::Reset()
+{
+   TProfilerState &state = TProfilerState::Get();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   for (auto &table : state.fThreads) {
+      std::lock_guard<std::mutex> tableLock(table->fMutex);
+      table->fSites.clear();
+   }
+}
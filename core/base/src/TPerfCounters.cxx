@@ -0,0 +1,263 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class ROOT::TPerfCounters
+\ingroup Base
+
+Process-wide registry of the throughput counters of ROOT.
+
+A subsystem registers its counters once, and keeps the returned handle:
+
+~~~ {.cpp}
+static auto unzipped = ROOT::TPerfCounters::Register("root_basket_unzipped_total", "Baskets unzipped");
+unzipped.Add();
+~~~
+
+Every thread has its own slot for every counter, which only this thread
+writes, so that an update is a relaxed load and store without any
+contention. The reads, GetValues() and FormatPrometheus(), sum the slots of
+all the threads, also of those that are gone. The slots of a thread are
+never released, they take 1 kB.
+
+A counter is monotonic (kCounter) or the current level of something
+(kGauge), a gauge can be increased on a thread and decreased on another one.
+The values are integers; a scale converts them in the published unit, e.g.
+nanoseconds in seconds. Values that are already maintained elsewhere are
+published through probes, functions called at the time of the read.
+
+The counters registered by ROOT are
+
+| Name                               | Type    | Updated by                            |
+|------------------------------------|---------|---------------------------------------|
+| root_file_read_bytes_total         | counter | all the TFile implementations (probe) |
+| root_file_read_calls_total         | counter | all the TFile implementations (probe) |
+| root_file_written_bytes_total      | counter | all the TFile implementations (probe) |
+| root_basket_unzipped_total         | counter | TBasket::ReadBasketBuffers            |
+| root_basket_unzipped_bytes_total   | counter | TBasket::ReadBasketBuffers            |
+| root_treecache_hits_total          | counter | TTreeCache::ReadBuffer                |
+| root_treecache_misses_total        | counter | TTreeCache::ReadBuffer                |
+| root_imt_tasks_pending             | gauge   | ROOT::Experimental::TTaskGroup        |
+| root_imt_tasks_running             | gauge   | ROOT::Experimental::TTaskGroup        |
+| root_tbuffermerger_queue_buffers   | gauge   | ROOT::Experimental::TBufferMerger     |
+| root_tbuffermerger_queue_bytes     | gauge   | ROOT::Experimental::TBufferMerger     |
+| root_jit_seconds_total             | counter | TDataFrame and TTreeFormula jitting   |
+| root_buffer_pool_acquired_total    | counter | ROOT::Internal::TBufferPool           |
+| root_buffer_pool_reused_total      | counter | ROOT::Internal::TBufferPool           |
+| root_buffer_pool_cached_bytes      | gauge   | ROOT::Internal::TBufferPool           |
+
+The hit rate of the tree caches is hits / (hits + misses), the one of the
+buffer pool is reused / acquired. A counter that belongs to a library not
+loaded yet is not listed.
+
+THttpServer publishes the values in the PerfCounters folder of its
+TRootSniffer and, in the Prometheus text format, at the address /metrics.
+*/
+
+#include "TPerfCounters.h"
+#include "TError.h"
+#include "TThreadRegistry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+// The counters of one thread; only this thread writes them.
+struct TThreadSlots {
+   std::atomic<Long64_t> fValues[ROOT::TPerfCounters::kMaxCounters];
+   TThreadSlots()
+   {
+      for (auto &value : fValues)
+         value.store(0, std::memory_order_relaxed);
+   }
+};
+
+struct TCounterInfo {
+   std::string fName;
+   std::string fHelp;
+   ROOT::TPerfCounters::EType fType;
+   Double_t fScale;
+   Long64_t fBaseline; // Value at the last Reset()
+};
+
+struct TProbeInfo {
+   std::string fName;
+   std::string fHelp;
+   ROOT::TPerfCounters::EType fType;
+   ROOT::TPerfCounters::Probe_t fProbe;
+};
+
+struct TCountersState : ROOT::Internal::TThreadRegistry<TCountersState, TThreadSlots> {
+   std::vector<TCounterInfo> fCounters;
+   std::vector<TProbeInfo> fProbes;
+};
+
+// Requires the lock of the state.
+Long64_t Sum(const TCountersState &state, Int_t index)
+{
+   Long64_t sum = 0;
+   for (auto &slots : state.fThreads)
+      sum += slots->fValues[index].load(std::memory_order_relaxed);
+   return sum;
+}
+
+const char *GetTypeName(ROOT::TPerfCounters::EType type)
+{
+   return type == ROOT::TPerfCounters::kGauge ? "gauge" : "counter";
+}
+
+std::string FormatValue(Double_t value)
+{
+   char text[32];
+   snprintf(text, sizeof(text), "%.15g", value);
+   return text;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register the counter name, described by help, and return its handle. The
+/// values added to it are multiplied by scale when read. Registering an
+/// existing name returns the handle of the existing counter. At most
+/// kMaxCounters counters can be registered, the handles returned beyond are
+/// ignored by Add().
+
+ROOT::TPerfCounters::TCounter ROOT::TPerfCounters::Register(const char *name, const char *help, EType type, Double_t scale)
+{
+   TCountersState &state = TCountersState::Get();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   for (size_t i = 0; i < state.fCounters.size(); ++i) {
+      if (state.fCounters[i].fName == name)
+         return TCounter(i);
+   }
+   if (state.fCounters.size() == kMaxCounters) {
+      ::Error("TPerfCounters::Register", "Too many counters, %s is ignored", name);
+      return TCounter();
+   }
+   state.fCounters.push_back({name, help ? help : "", type, scale, 0});
+   return TCounter(state.fCounters.size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register the value name, described by help, which is maintained outside of
+/// the registry: probe is called at every read. It must be callable from any
+/// thread, and stay callable until the end of the process.
+
+void ROOT::TPerfCounters::RegisterProbe(const char *name, const char *help, EType type, const Probe_t &probe)
+{
+   TCountersState &state = TCountersState::Get();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   for (auto &existing : state.fProbes) {
+      if (existing.fName == name)
+         return;
+   }
+   state.fProbes.push_back({name, help ? help : "", type, probe});
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add v to the counter index, in the slot of the calling thread.
+
+void ROOT::TPerfCounters::Add(Int_t index, Long64_t v)
+{
+   if (R__unlikely(index < 0 || index >= kMaxCounters))
+      return;
+   std::atomic<Long64_t> &slot = TCountersState::GetThreadData().fValues[index];
+   slot.store(slot.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the current value of the counter or probe name, 0 if it is not
+/// registered.
+
+Double_t ROOT::TPerfCounters::GetValue(const char *name)
+{
+   for (auto &value : GetValues()) {
+      if (value.fName == name)
+         return value.fValue;
+   }
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the current values of all the counters and probes, sorted by name.
+
+std::vector<ROOT::TPerfCounters::TValue> ROOT::TPerfCounters::GetValues()
+{
+   std::vector<TValue> values;
+   std::vector<TProbeInfo> probes;
+   {
+      TCountersState &state = TCountersState::Get();
+      std::lock_guard<std::mutex> lock(state.fMutex);
+      for (size_t i = 0; i < state.fCounters.size(); ++i) {
+         const TCounterInfo &info = state.fCounters[i];
+         values.push_back({info.fName, info.fHelp, info.fType, (Sum(state, i) - info.fBaseline) * info.fScale});
+      }
+      probes = state.fProbes;
+   }
+   // Outside of the lock, a probe may update a counter.
+   for (auto &probe : probes)
+      values.push_back({probe.fName, probe.fHelp, probe.fType, probe.fProbe()});
+   std::sort(values.begin(), values.end(), [](const TValue &a, const TValue &b) { return a.fName < b.fName; });
+   return values;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the current values in the Prometheus text exposition format.
+
+std::string ROOT::TPerfCounters::FormatPrometheus()
+{
+   std::string text;
+   for (auto &value : GetValues()) {
+      std::string help;
+      for (char c : value.fHelp) {
+         if (c == '\\')
+            help += "\\\\";
+         else if (c == '\n')
+            help += "\\n";
+         else
+            help += c;
+      }
+      text += "# HELP " + value.fName + " " + help + "\n";
+      text += "# TYPE " + value.fName + " " + GetTypeName(value.fType) + "\n";
+      text += value.fName + " " + FormatValue(value.fValue) + "\n";
+   }
+   return text;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the current values; option "help" adds their descriptions.
+
+void ROOT::TPerfCounters::Print(Option_t *option)
+{
+   const bool help = option && strstr(option, "help");
+   for (auto &value : GetValues()) {
+      printf("%-40s %-8s %20s\n", value.fName.c_str(), GetTypeName(value.fType), FormatValue(value.fValue).c_str());
+      if (help)
+         printf("   %s\n", value.fHelp.c_str());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Restart the counters from zero. The gauges and the probes are not
+/// affected.
+
+void ROOT::TPerfCounters::Reset()
+{
+   TCountersState &state = TCountersState::Get();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   for (size_t i = 0; i < state.fCounters.size(); ++i) {
+      if (state.fCounters[i].fType == kCounter)
+         state.fCounters[i].fBaseline = Sum(state, i);
+   }
+}
@@ -31,14 +31,17 @@ accessible via TProcessID::fgPIDs (for all files).
 When this object is deleted, it is removed from the table via the cleanup
 mechanism invoked by the TObject destructor.
 
-Each TProcessID has a table (TObjArray *fObjects) that keeps track
-of all referenced objects. If a referenced object has a fUniqueID set,
-a pointer to this unique object may be found via fObjects->At(fUniqueID).
-In the same way, when a TRef::GetObject is called, GetObject uses
-its own fUniqueID to find the pointer to the referenced object.
-See TProcessID::GetObjectWithID and PutObjectWithID.
-
-When a referenced object is deleted, its slot in fObjects is set to null.
+Each TProcessID has a table (ROOT::Internal::TReferencedObjects fTable)
+that keeps track of all referenced objects. If a referenced object has a
+fUniqueID set, a pointer to this unique object may be found via
+GetObjectWithID(fUniqueID). In the same way, when a TRef::GetObject is
+called, GetObject uses its own fUniqueID to find the pointer to the
+referenced object. See TProcessID::GetObjectWithID and PutObjectWithID.
+The table grows by chunks that are never moved, so that the lookups and
+the insertions do not take any lock and can be done from several threads
+reading references concurrently.
+
+When a referenced object is deleted, its slot in the table is set to null.
 //
 See also TProcessUUID: a specialized TProcessID to manage the single list
 of TUUIDs.
@@ -49,6 +52,7 @@ of TUUIDs.
 #include "TObjArray.h"
 #include "TExMap.h"
 #include "TVirtualMutex.h"
+#include "TVirtualRWMutex.h"
 #include "TError.h"
 
 TObjArray  *TProcessID::fgPIDs   = 0; //pointer to the list of TProcessID
@@ -57,6 +61,70 @@ UInt_t      TProcessID::fgNumber = 0; //Current referenced object instance count
 TExMap     *TProcessID::fgObjPIDs= 0; //Table (pointer,pids)
 ClassImp(TProcessID);
 
+////////////////////////////////////////////////////////////////////////////////
+/// Store obj at uid, allocating the chunk of uid if needed.
+
+void ROOT::Internal::TReferencedObjects::AddAt(TObject *obj, UInt_t uid)
+{
+   UInt_t offset;
+   const Int_t chunk = ChunkOf(uid & 0xffffff, offset);
+   Chunk_t *entries = fChunks[chunk].load(std::memory_order_acquire);
+   if (!entries) {
+      if (!obj)
+         return;
+      const UInt_t size = ChunkSize(chunk);
+      Chunk_t *newEntries = new Chunk_t[size];
+      for (UInt_t i = 0; i < size; ++i)
+         newEntries[i].store(nullptr, std::memory_order_relaxed);
+      if (fChunks[chunk].compare_exchange_strong(entries, newEntries, std::memory_order_acq_rel)) {
+         entries = newEntries;
+      } else {
+         // Another thread allocated the chunk in the meantime; entries is now its chunk.
+         delete[] newEntries;
+      }
+   }
+   entries[offset].store(obj, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release all the chunks.
+
+void ROOT::Internal::TReferencedObjects::Clear()
+{
+   for (auto &chunk : fChunks)
+      delete[] chunk.exchange(nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of objects in the table.
+
+Int_t ROOT::Internal::TReferencedObjects::GetEntries() const
+{
+   Int_t n = 0;
+   for (Int_t chunk = 0; chunk < kNChunks; ++chunk) {
+      const Chunk_t *entries = fChunks[chunk].load(std::memory_order_acquire);
+      if (!entries)
+         continue;
+      for (UInt_t i = 0, size = ChunkSize(chunk); i < size; ++i)
+         if (entries[i].load(std::memory_order_relaxed))
+            ++n;
+   }
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return one more than the largest uid that can be stored without allocating.
+
+UInt_t ROOT::Internal::TReferencedObjects::GetSize() const
+{
+   UInt_t size = 0;
+   for (Int_t chunk = 0; chunk < kNChunks; ++chunk) {
+      if (fChunks[chunk].load(std::memory_order_acquire))
+         size = (((1u << (chunk + 1)) - 1) << kFirstChunkBits);
+   }
+   return size;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return hash value for this object.
 
@@ -152,7 +220,7 @@ UInt_t TProcessID::AssignID(TObject *obj)
       fgNumber = 0;
       for(Int_t i = 0; i < fgPIDs->GetLast()+1; ++i) {
          TProcessID *pid = (TProcessID*)fgPIDs->At(i);
-         if (pid && pid->fObjects && pid->fObjects->GetEntries() == 0) {
+         if (pid && pid->fTable.GetSize() && pid->fTable.GetEntries() == 0) {
             pid->Clear();
          }
       }
@@ -201,17 +269,17 @@ void TProcessID::Cleanup()
 
 void TProcessID::Clear(Option_t *)
 {
-   if (GetUniqueID()>254 && fObjects && fgObjPIDs) {
+   if (GetUniqueID()>254 && fgObjPIDs) {
       // We might have many references registered in the map
-      for(Int_t i = 0; i < fObjects->GetSize(); ++i) {
-         TObject *obj = fObjects->UncheckedAt(i);
+      for (UInt_t i = 0, size = fTable.GetSize(); i < size; ++i) {
+         TObject *obj = fTable.At(i);
          if (obj) {
             ULong64_t hash = Void_Hash(obj);
             fgObjPIDs->Remove(hash,(Long64_t)obj);
-            (*fObjects)[i] = 0;
          }
       }
    }
+   fTable.Clear();
    delete fObjects; fObjects = 0;
 }
 
@@ -248,7 +316,7 @@ UInt_t TProcessID::GetNProcessIDs()
 
 TProcessID *TProcessID::GetProcessWithUID(UInt_t uid, const void *obj)
 {
-   R__LOCKGUARD(gROOTMutex);
+   R__READ_LOCKGUARD(ROOT::gCoreMutex);
 
    Int_t pid = (uid>>24)&0xff;
    if (pid==0xff) {
@@ -301,10 +369,28 @@ UInt_t TProcessID::GetObjectCount()
 
 TObject *TProcessID::GetObjectWithID(UInt_t uidd)
 {
-   Int_t uid = uidd & 0xffffff;  //take only the 24 lower bits
+   return fTable.At(uidd & 0xffffff);  //take only the 24 lower bits
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return an array of the referenced objects, indexed by their uid.
+/// The array is owned by the TProcessID and refreshed from its table
+/// at each call.
 
-   if (fObjects==0 || uid >= fObjects->GetSize()) return 0;
-   return fObjects->UncheckedAt(uid);
+TObjArray *TProcessID::GetObjects() const
+{
+   TProcessID *self = const_cast<TProcessID*>(this);
+   while (self->fLock.test_and_set(std::memory_order_acquire));  // acquire lock
+   if (!fObjects) self->fObjects = new TObjArray(100);
+   TObjArray *objects = fObjects;
+   objects->Clear();
+   const UInt_t size = fTable.GetSize();
+   if ((UInt_t)objects->GetSize() < size) objects->Expand(size);
+   for (UInt_t uid = 0; uid < size; ++uid) {
+      if (TObject *obj = fTable.At(uid)) objects->AddAt(obj, uid);
+   }
+   self->fLock.clear(std::memory_order_release);
+   return objects;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -329,7 +415,7 @@ TObjArray *TProcessID::GetPIDs()
 
 Bool_t TProcessID::IsValid(TProcessID *pid)
 {
-   R__LOCKGUARD(gROOTMutex);
+   R__READ_LOCKGUARD(ROOT::gCoreMutex);
 
    if (fgPIDs==0) return kFALSE;
    if (fgPIDs->IndexOf(pid) >= 0) return kTRUE;
@@ -343,15 +429,14 @@ Bool_t TProcessID::IsValid(TProcessID *pid)
 
 void TProcessID::PutObjectWithID(TObject *obj, UInt_t uid)
 {
-   R__LOCKGUARD_IMT2(gROOTMutex); // Lock for parallel TTree I/O
-
    if (uid == 0) uid = obj->GetUniqueID() & 0xffffff;
 
-   if (!fObjects) fObjects = new TObjArray(100);
-   fObjects->AddAtAndExpand(obj,uid);
+   fTable.AddAt(obj,uid);
 
    obj->SetBit(kMustCleanup);
    if ( (obj->GetUniqueID()&0xff000000)==0xff000000 ) {
+      R__LOCKGUARD_IMT2(gROOTMutex); // Lock for parallel TTree I/O
+
       // We have more than 255 pids we need to store this
       // pointer in the table(pointer,pid) since there is no
       // more space in fUniqueID
@@ -372,7 +457,6 @@ void TProcessID::PutObjectWithID(TObject *obj, UInt_t uid)
 
 void TProcessID::RecursiveRemove(TObject *obj)
 {
-   if (!fObjects) return;
    if (!obj->TestBit(kIsReferenced)) return;
    UInt_t uid = obj->GetUniqueID() & 0xffffff;
    if (obj == GetObjectWithID(uid)) {
@@ -380,7 +464,7 @@ void TProcessID::RecursiveRemove(TObject *obj)
          ULong64_t hash = Void_Hash(obj);
          fgObjPIDs->Remove(hash,(Long64_t)obj);
       }
-      (*fObjects)[uid] = 0; // Avoid recalculation of fLast (compared to ->RemoveAt(uid))
+      fTable.AddAt(0, uid);
    }
 }
 
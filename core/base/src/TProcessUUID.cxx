@@ -26,7 +26,7 @@ When a TUUID is removed from the list, the corresponding bit
 is reset in fActive.
 
 The object corresponding to a TUUID at slot I can be found
-via fObjects->At(I).
+via GetObjectWithID(I).
 
 One can use two mechanisms to find the object corresponding to a TUUID:
 
@@ -86,8 +86,7 @@ UInt_t TProcessUUID::AddUUID(TUUID &uuid, TObject *obj)
       objs->SetUniqueID(number);
       obj->SetUniqueID(number);
       obj->SetBit(kHasUUID);
-      if (number >= (UInt_t)fObjects->GetSize()) fObjects->AddAtAndExpand(obj,number);
-      if (fObjects->UncheckedAt(number) == 0) fObjects->AddAt(obj,number);
+      if (!fTable.At(number)) fTable.AddAt(obj,number);
       return number;
    }
 
@@ -99,7 +98,7 @@ UInt_t TProcessUUID::AddUUID(TUUID &uuid, TObject *obj)
    obj->SetUniqueID(number);
    obj->SetBit(kHasUUID);
    fActive->SetBitNumber(number);
-   fObjects->AddAtAndExpand(obj,number);
+   fTable.AddAt(obj,number);
    return number;
 }
 
@@ -141,7 +140,7 @@ TObjString *TProcessUUID::FindUUID(UInt_t number) const
 
 void TProcessUUID::RemoveUUID(UInt_t number)
 {
-   if (number > (UInt_t)fObjects->GetSize()) return;
+   if (!fActive->TestBitNumber(number)) return;
    TObjLink *lnk = fUUIDs->FirstLink();
    while (lnk) {
       TObject *obj = lnk->GetObject();
@@ -149,7 +148,7 @@ void TProcessUUID::RemoveUUID(UInt_t number)
          fUUIDs->Remove(lnk);
          delete obj;
          fActive->ResetBitNumber(number);
-         fObjects->AddAt(0,number);
+         fTable.AddAt(0,number);
          return;
       }
       lnk = lnk->Next();
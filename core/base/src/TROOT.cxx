@@ -146,6 +146,8 @@ FARPROC dlsym(void *library, const char *function_name)
 #include "TMap.h"
 #include "TObjString.h"
 #include "TVirtualMutex.h"
+#include "TStartupTracer.h"
+#include "TTimelineTracer.h"
 #include "TInterpreter.h"
 #include "TListOfTypes.h"
 #include "TListOfDataMembers.h"
@@ -556,16 +558,48 @@ namespace Internal {
    /// scenario allows it. For example, if ROOT is configured to use an external
    /// scheduler, setting a value for 'numthreads' might not have any effect.
    void EnableImplicitMT(UInt_t numthreads)
+   {
+      EnableImplicitMT(numthreads, 0);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// @param[in] numthreads Number of threads to use, see EnableImplicitMT(UInt_t).
+   /// @param[in] placement  Combination of EIMTPlacement options.
+   ///
+   /// Enables the implicit multi-threading, placing the threads on the CPUs
+   /// according to the topology of the machine:
+   ///
+   ///  - with kIMTNumaArenas, the threads are shared among one task arena per
+   ///    NUMA node, in proportion to the CPUs of the node, and bound to them.
+   ///    The parallel loops of TThreadExecutor, thus the clusters of
+   ///    TTreeProcessorMT and TDataFrame, are split in one contiguous part per
+   ///    node: the tasks reading neighbouring clusters, the baskets they
+   ///    decompress and the tasks they spawn stay on one node, whose memory
+   ///    the Linux kernel allocates them by default.
+   ///  - with kIMTPinThreads, each worker thread is bound to one CPU, of its
+   ///    node with kIMTNumaArenas.
+   ///
+   /// The resulting layout is returned by GetImplicitMTNumaNodes,
+   /// GetImplicitMTNodePoolSize and GetImplicitMTNodeCpus. The topology is
+   /// read from the Linux sysfs; on the other platforms, or if the machine has
+   /// a single node, the threads are not split in arenas.
+   ///
+   /// ~~~{.cpp}
+   /// ROOT::EnableImplicitMT(0, ROOT::kIMTNumaArenas | ROOT::kIMTPinThreads);
+   /// ~~~
+   void EnableImplicitMT(UInt_t numthreads, UInt_t placement)
    {
 #ifdef R__USE_IMT
       if (ROOT::Internal::IsImplicitMTEnabledImpl())
          return;
       EnableThreadSafety();
-      static void (*sym)(UInt_t) = (void(*)(UInt_t))Internal::GetSymInLibImt("ROOT_TImplicitMT_EnableImplicitMT");
+      static void (*sym)(UInt_t, UInt_t) =
+         (void (*)(UInt_t, UInt_t))Internal::GetSymInLibImt("ROOT_TImplicitMT_EnableImplicitMTPlacement");
       if (sym)
-         sym(numthreads);
+         sym(numthreads, placement);
       ROOT::Internal::IsImplicitMTEnabledImpl() = true;
 #else
+      (void)placement;
       ::Warning("EnableImplicitMT", "Cannot enable implicit multi-threading with %d threads, please build ROOT with -Dimt=ON", numthreads);
 #endif
    }
@@ -606,6 +640,75 @@ namespace Internal {
 #endif
    }
 
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Returns the number of NUMA nodes the threads of the implicit
+   /// multi-threading are split over, 1 if they are not split (see
+   /// EnableImplicitMT(UInt_t, UInt_t)) and 0 if it is not enabled.
+   UInt_t GetImplicitMTNumaNodes()
+   {
+#ifdef R__USE_IMT
+      static UInt_t (*sym)() = (UInt_t(*)())Internal::GetSymInLibImt("ROOT_TImplicitMT_GetImplicitMTNumaNodes");
+      if (sym)
+         return sym();
+      else
+         return 0;
+#else
+      return 0;
+#endif
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Returns the number of threads of the implicit multi-threading working on
+   /// a NUMA node.
+   UInt_t GetImplicitMTNodePoolSize(UInt_t node)
+   {
+#ifdef R__USE_IMT
+      static UInt_t (*sym)(UInt_t) =
+         (UInt_t(*)(UInt_t))Internal::GetSymInLibImt("ROOT_TImplicitMT_GetImplicitMTNodePoolSize");
+      if (sym)
+         return sym(node);
+      else
+         return 0;
+#else
+      (void)node;
+      return 0;
+#endif
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Returns the CPUs the threads of the implicit multi-threading working on a
+   /// NUMA node are bound to, empty if they are not bound.
+   std::vector<Int_t> GetImplicitMTNodeCpus(UInt_t node)
+   {
+      std::vector<Int_t> cpus;
+#ifdef R__USE_IMT
+      static void (*sym)(UInt_t, std::vector<Int_t> *) =
+         (void (*)(UInt_t, std::vector<Int_t> *))Internal::GetSymInLibImt("ROOT_TImplicitMT_GetImplicitMTNodeCpus");
+      if (sym)
+         sym(node, &cpus);
+#else
+      (void)node;
+#endif
+      return cpus;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Returns the NUMA node the calling thread is working on, -1 if it is not
+   /// running a task of the implicit multi-threading split over NUMA nodes.
+   /// Can be used to choose the memory pools of the objects of a task.
+   Int_t GetImplicitMTCurrentNode()
+   {
+#ifdef R__USE_IMT
+      static Int_t (*sym)() = (Int_t(*)())Internal::GetSymInLibImt("ROOT_TImplicitMT_GetImplicitMTCurrentNode");
+      if (sym)
+         return sym();
+      else
+         return -1;
+#else
+      return -1;
+#endif
+   }
+
 }
 
 TROOT *ROOT::Internal::gROOTLocal = ROOT::GetROOT();
@@ -673,6 +776,8 @@ TROOT::TROOT(const char *name, const char *title, VoidFuncPtr_t *initfunc)
       return;
    }
 
+   ROOT::TStartupTracer::TScope trace("startup", "TROOT::TROOT");
+
    R__LOCKGUARD(gROOTMutex);
 
    ROOT::Internal::gROOTLocal = this;
@@ -1964,6 +2069,18 @@ void TROOT::InitSystem()
 
       fgMemCheck = gEnv->GetValue("Root.MemCheck", 0);
 
+      Int_t lockProfile = gEnv->GetValue("Root.LockProfile", 0);
+      if (lockProfile > 1)
+         ROOT::TLockProfiler::SetPrintAtExit();
+      else if (lockProfile == 1)
+         ROOT::TLockProfiler::Enable();
+
+      const char *timelineTrace = gEnv->GetValue("Root.TimelineTrace", "");
+      if (timelineTrace && *timelineTrace) {
+         ROOT::TTimelineTracer::SetThreadName("main");
+         ROOT::TTimelineTracer::Enable(timelineTrace);
+      }
+
 #if defined(R__HAS_COCOA)
       // create and delete a dummy TUrl so that TObjectStat table does not contain
       // objects that are deleted after recording is turned-off (in next line),
@@ -1991,6 +2108,8 @@ void TROOT::InitThreads()
 
 void TROOT::InitInterpreter()
 {
+   ROOT::TStartupTracer::TScope trace("startup", "TROOT::InitInterpreter");
+
    // usedToIdentifyRootClingByDlSym is available when TROOT is part of
    // rootcling.
    if (!dlsym(RTLD_DEFAULT, "usedToIdentifyRootClingByDlSym")
@@ -2012,7 +2131,11 @@ void TROOT::InitInterpreter()
       }
 
       char *libRIO = gSystem->DynamicPathName("libRIO");
-      void *libRIOHandle = dlopen(libRIO, RTLD_NOW|RTLD_GLOBAL);
+      void *libRIOHandle;
+      {
+         ROOT::TStartupTracer::TScope traceLoad("library", "dlopen", libRIO);
+         libRIOHandle = dlopen(libRIO, RTLD_NOW|RTLD_GLOBAL);
+      }
       delete [] libRIO;
       if (!libRIOHandle) {
          TString err = dlerror();
@@ -2021,7 +2144,10 @@ void TROOT::InitInterpreter()
       }
 
       char *libcling = gSystem->DynamicPathName("libCling");
-      gInterpreterLib = dlopen(libcling, RTLD_LAZY|RTLD_LOCAL);
+      {
+         ROOT::TStartupTracer::TScope traceLoad("library", "dlopen", libcling);
+         gInterpreterLib = dlopen(libcling, RTLD_LAZY|RTLD_LOCAL);
+      }
       delete [] libcling;
 
       if (!gInterpreterLib) {
@@ -2061,6 +2187,7 @@ void TROOT::InitInterpreter()
       new TClassTable;
 
    // Initialize all registered dictionaries.
+   ROOT::TStartupTracer::TScope traceModules("dictionary", "RegisterModules");
    for (std::vector<ModuleHeaderInfo_t>::const_iterator
            li = GetModuleHeaderInfoBuffer().begin(),
            le = GetModuleHeaderInfoBuffer().end(); li != le; ++li) {
@@ -2077,8 +2204,12 @@ void TROOT::InitInterpreter()
                                    li->fHasCxxModule);
    }
    GetModuleHeaderInfoBuffer().clear();
+   traceModules.End();
 
-   fInterpreter->Initialize();
+   {
+      ROOT::TStartupTracer::TScope traceInitialize("startup", "TInterpreter::Initialize");
+      fInterpreter->Initialize();
+   }
 
    // Read the rules before enabling the auto loading to not inadvertently
    // load the libraries for the classes concerned even-though the user is
@@ -2086,6 +2217,7 @@ void TROOT::InitInterpreter()
    TClass::ReadRules(); // Read the default customization rules ...
 
    // Enable autoloading
+   ROOT::TStartupTracer::TScope traceAutoLoading("startup", "TInterpreter::EnableAutoLoading");
    fInterpreter->EnableAutoLoading();
 }
 
@@ -2307,6 +2439,7 @@ void  TROOT::Message(Int_t id, const TObject *obj)
 
 Long_t TROOT::ProcessLine(const char *line, Int_t *error)
 {
+   ROOT::TStartupTracer::TScope trace("interpreter", "TROOT::ProcessLine", line);
    TString sline = line;
    sline = sline.Strip(TString::kBoth);
 
@@ -0,0 +1,189 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class ROOT::TStartupTracer
+\ingroup Base
+
+Trace of the initialization of ROOT, written as a Chrome trace.
+
+When the environment variable ROOT_STARTUP_TRACE is set, to the name of the
+trace file or to 1 for root_startup_trace_<pid>.json in the working
+directory, the steps below are recorded with their wall time:
+
+  - the construction of TROOT and TROOT::InitInterpreter, including the
+    loading of libCling;
+  - the construction of TCling and of the cling interpreter, which loads the
+    PCH;
+  - the loading of the PCMs and the registration of the dictionaries;
+  - the reading of the rootmap files and the declaration of their forward
+    declarations;
+  - gSystem->Load and the loading of the libraries by the interpreter;
+  - the autoloading and autoparsing of classes;
+  - TROOT::ProcessLine.
+
+The file system accesses done through TSystem (stat, access, directory
+listing) are recorded as well, each with its path and duration, and each
+step counts those done within it, in its argument "fs". The trace is written
+at the end of the process, or by Write(); load it in chrome://tracing or
+https://ui.perfetto.dev.
+*/
+
+#include "TStartupTracer.h"
+
+#include "TChromeTraceWriter.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct TEvent {
+   const char *fCategory;
+   const char *fName;
+   std::string fArg;
+   Double_t fStart;    // Microseconds since the start of the trace
+   Double_t fDuration; // Microseconds
+   Int_t fThread;
+   Long64_t fFSAccesses;
+};
+
+struct TTracerState {
+   std::string fFileName;
+   std::chrono::steady_clock::time_point fOrigin = std::chrono::steady_clock::now();
+   std::mutex fMutex;
+   std::vector<TEvent> fEvents;
+   Int_t fNThreads = 0;
+};
+
+// A bound on the memory used by a process which keeps on autoloading.
+const size_t kMaxEvents = 1000000;
+
+void WriteAtExit()
+{
+   ROOT::TStartupTracer::Write();
+}
+
+// Never deleted: the scopes of the static destructors may still record.
+TTracerState *CreateState()
+{
+   const char *env = getenv("ROOT_STARTUP_TRACE");
+   if (!env || !*env || !strcmp(env, "0"))
+      return nullptr;
+   TTracerState *state = new TTracerState;
+   if (!strcmp(env, "1"))
+      state->fFileName = "root_startup_trace_" + std::to_string(getpid()) + ".json";
+   else
+      state->fFileName = env;
+   atexit(WriteAtExit);
+   return state;
+}
+
+TTracerState *GetState()
+{
+   static TTracerState *gState = CreateState();
+   return gState;
+}
+
+Double_t Now(const TTracerState &state)
+{
+   return std::chrono::duration<Double_t, std::micro>(std::chrono::steady_clock::now() - state.fOrigin).count();
+}
+
+Int_t GetThreadNumber(TTracerState &state)
+{
+   thread_local Int_t thread = -1;
+   if (thread < 0) {
+      std::lock_guard<std::mutex> lock(state.fMutex);
+      thread = state.fNThreads++;
+   }
+   return thread;
+}
+
+// Number of file system accesses of the thread so far.
+thread_local Long64_t gFSAccesses = 0;
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether the environment variable ROOT_STARTUP_TRACE enabled the
+/// tracer.
+
+Bool_t ROOT::TStartupTracer::IsEnabled()
+{
+   return GetState() != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start the measurement of the step.
+
+void ROOT::TStartupTracer::TScope::Begin(const char *arg)
+{
+   if (arg)
+      fArg = arg;
+   fFSAccesses = gFSAccesses;
+   fStart = Now(*GetState());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the step, if it is traced and was not already recorded.
+
+void ROOT::TStartupTracer::TScope::End()
+{
+   if (fStart < 0)
+      return;
+   TTracerState &state = *GetState();
+   const Double_t end = Now(state);
+   const Bool_t isFS = !strcmp(fCategory, "fs");
+   if (isFS)
+      ++gFSAccesses;
+   const Int_t thread = GetThreadNumber(state);
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   if (state.fEvents.size() < kMaxEvents)
+      state.fEvents.push_back(
+         TEvent{fCategory, fName, std::move(fArg), fStart, end - fStart, thread, gFSAccesses - fFSAccesses});
+   fStart = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the trace recorded so far to the file named by ROOT_STARTUP_TRACE;
+/// called at the end of the process.
+
+void ROOT::TStartupTracer::Write()
+{
+   TTracerState *state = GetState();
+   if (!state)
+      return;
+   std::lock_guard<std::mutex> lock(state->fMutex);
+   ROOT::Internal::TChromeTraceWriter writer(state->fFileName.c_str());
+   if (!writer.IsOpen()) {
+      fprintf(stderr, "Error in <TStartupTracer::Write>: cannot open %s\n", state->fFileName.c_str());
+      return;
+   }
+   for (const TEvent &event : state->fEvents) {
+      writer.BeginEvent(event.fThread, event.fStart, event.fDuration, event.fCategory, event.fName);
+      if (!event.fArg.empty())
+         writer.WriteArg("arg", event.fArg);
+      writer.WriteArg("fs", event.fFSAccesses);
+      writer.EndEvent();
+   }
+}
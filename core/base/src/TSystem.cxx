@@ -53,6 +53,7 @@ allows a simple partial implementation for new OS'es.
 #include "compiledata.h"
 #include "RConfigure.h"
 #include "THashList.h"
+#include "TStartupTracer.h"
 
 const char *gRootDir;
 const char *gProgName;
@@ -1828,6 +1829,8 @@ static bool R__MatchFilename(const char *left, const char *right)
 
 int TSystem::Load(const char *module, const char *entry, Bool_t system)
 {
+   ROOT::TStartupTracer::TScope trace("library", "TSystem::Load", module);
+
    // don't load libraries that have already been loaded
    TString libs( GetLibraries() );
    TString moduleBasename( BaseName(module) );
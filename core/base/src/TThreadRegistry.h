@@ -0,0 +1,62 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TThreadRegistry
+#define ROOT_TThreadRegistry
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process-wide state keeping one Data per thread, for the recorders of
+/// libCore (TLockProfiler, TPerfCounters, TTimelineTracer): a thread only
+/// records into its own Data, which the state merges when it is read.
+/// The state is a singleton deriving from TThreadRegistry<State, Data>.
+///
+/// The state is never deleted, since the static destructors may still
+/// record. The Data of a thread is owned by the state, so that it stays
+/// usable during the destruction of the thread and its records are kept
+/// once the thread is gone.
+
+template <typename State, typename Data>
+class TThreadRegistry {
+public:
+   std::mutex fMutex;                           ///< Protects fThreads and the members of State
+   std::vector<std::unique_ptr<Data>> fThreads; ///< In order of creation, also those of the threads that are gone
+
+   static State &Get()
+   {
+      static State *gState = new State;
+      return *gState;
+   }
+
+   /// Return the Data of the calling thread, registered at the first call.
+   static Data &GetThreadData()
+   {
+      thread_local Data *data = nullptr;
+      if (!data) {
+         std::unique_ptr<Data> newData(new Data);
+         data = newData.get();
+         State &state = Get();
+         std::lock_guard<std::mutex> lock(state.fMutex);
+         state.fThreads.emplace_back(std::move(newData));
+      }
+      return *data;
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
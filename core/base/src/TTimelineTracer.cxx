@@ -0,0 +1,212 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class ROOT::TTimelineTracer
+\ingroup Base
+
+Opt-in timeline of the threads of a process, written as a Chrome trace.
+
+To find out whether the threads of a TDataFrame or TTreeProcessorMT job wait
+for the I/O, the decompression or user code, the tracer records spans, with
+their begin, end and thread:
+
+  - category "imt": the tasks run by a TTaskGroup and its waits, the
+    iterations of TThreadExecutor::Foreach/Map (ParallelFor) and the stages
+    of TThreadExecutor::Pipeline;
+  - category "io": TFile::ReadBuffer and TFile::ReadBuffers, the reading and
+    the unzipping of the baskets (TBasket::ReadBasketBuffers), the
+    TTreeCache fills, the unzipping tasks of TTreeCacheUnzip and, for
+    TBufferMerger, the pushes of the buffers (which wait when the queue is
+    full) and the merges into the output file.
+
+It is enabled with ROOT::TTimelineTracer::Enable(filename) or the resource
+(in .rootrc)
+
+    Root.TimelineTrace: trace.json
+
+and the trace is written to the file at the end of the process, or at any
+time with Write(filename). Load it in chrome://tracing or
+https://ui.perfetto.dev. The time spent waiting on the ROOT locks is
+measured by ROOT::TLockProfiler.
+
+Each thread records its spans in its own buffer, at most 4 million of them.
+When the tracer is disabled, a span only tests a flag.
+*/
+
+#include "TTimelineTracer.h"
+
+#include "TChromeTraceWriter.h"
+#include "TError.h"
+#include "TThreadRegistry.h"
+
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+std::atomic<Bool_t> ROOT::TTimelineTracer::fgEnabled(kFALSE);
+
+namespace {
+
+struct TSpanRecord {
+   const char *fCategory;
+   const char *fName;
+   const char *fArgName;
+   Long64_t fArg;
+   Long64_t fStart; // Nanoseconds of the steady clock
+   Long64_t fEnd;
+};
+
+// Spans of one thread; its mutex is only contended while the trace is written.
+struct TThreadBuffer {
+   std::mutex fMutex;
+   std::string fName;
+   std::vector<TSpanRecord> fSpans;
+   ULong64_t fDropped = 0;
+};
+
+struct TTracerState : ROOT::Internal::TThreadRegistry<TTracerState, TThreadBuffer> {
+   Long64_t fOrigin = ROOT::TTimelineTracer::Now();
+   std::string fFileName; // Written at exit if not empty
+   bool fWriteAtExitRegistered = false;
+};
+
+// A bound on the memory used by a thread.
+const size_t kMaxSpans = 4 * 1024 * 1024;
+
+void WriteAtExit()
+{
+   TTracerState &state = TTracerState::Get();
+   std::string filename;
+   {
+      std::lock_guard<std::mutex> lock(state.fMutex);
+      filename = state.fFileName;
+   }
+   if (!filename.empty())
+      ROOT::TTimelineTracer::Write(filename.c_str());
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start recording the spans. If filename is given, the trace is written to
+/// it at the end of the process. The spans recorded so far are kept, see
+/// Reset().
+
+void ROOT::TTimelineTracer::Enable(const char *filename)
+{
+   if (filename && *filename) {
+      TTracerState &state = TTracerState::Get();
+      std::lock_guard<std::mutex> lock(state.fMutex);
+      state.fFileName = filename;
+      if (!state.fWriteAtExitRegistered) {
+         state.fWriteAtExitRegistered = true;
+         atexit(WriteAtExit);
+      }
+   }
+   fgEnabled = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop recording the spans; the spans in progress are still recorded.
+
+void ROOT::TTimelineTracer::Disable()
+{
+   fgEnabled = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Name the calling thread in the trace, e.g. "main" or "merger".
+
+void ROOT::TTimelineTracer::SetThreadName(const char *name)
+{
+   TThreadBuffer &buffer = TTracerState::GetThreadData();
+   std::lock_guard<std::mutex> lock(buffer.fMutex);
+   buffer.fName = name ? name : "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record a span of the calling thread, from start to end in nanoseconds of
+/// Now(). The strings must be string literals.
+
+void ROOT::TTimelineTracer::Record(const char *category, const char *name, const char *argName, Long64_t arg,
+                                   Long64_t start, Long64_t end)
+{
+   TThreadBuffer &buffer = TTracerState::GetThreadData();
+   std::lock_guard<std::mutex> lock(buffer.fMutex);
+   if (buffer.fSpans.size() < kMaxSpans)
+      buffer.fSpans.push_back(TSpanRecord{category, name, argName, arg, start, end});
+   else
+      ++buffer.fDropped;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of spans recorded so far, by all threads.
+
+ULong64_t ROOT::TTimelineTracer::GetNSpans()
+{
+   ULong64_t n = 0;
+   TTracerState &state = TTracerState::Get();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   for (auto &buffer : state.fThreads) {
+      std::lock_guard<std::mutex> bufferLock(buffer->fMutex);
+      n += buffer->fSpans.size();
+   }
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the spans recorded so far to filename, as Chrome trace JSON.
+/// Return kFALSE if the file cannot be written.
+
+Bool_t ROOT::TTimelineTracer::Write(const char *filename)
+{
+   ROOT::Internal::TChromeTraceWriter writer(filename);
+   if (!writer.IsOpen()) {
+      ::Error("TTimelineTracer::Write", "cannot open %s", filename);
+      return kFALSE;
+   }
+   TTracerState &state = TTracerState::Get();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   ULong64_t dropped = 0;
+   for (size_t thread = 0; thread < state.fThreads.size(); ++thread) {
+      const std::unique_ptr<TThreadBuffer> &buffer = state.fThreads[thread];
+      std::lock_guard<std::mutex> bufferLock(buffer->fMutex);
+      dropped += buffer->fDropped;
+      if (!buffer->fName.empty())
+         writer.WriteThreadName(Int_t(thread), buffer->fName);
+      for (auto &span : buffer->fSpans) {
+         writer.BeginEvent(Int_t(thread), (span.fStart - state.fOrigin) * 1e-3, (span.fEnd - span.fStart) * 1e-3,
+                           span.fCategory, span.fName);
+         if (span.fArgName)
+            writer.WriteArg(span.fArgName, span.fArg);
+         writer.EndEvent();
+      }
+   }
+   if (dropped)
+      ::Warning("TTimelineTracer::Write", "%llu spans were dropped, the threads reached the limit of %llu spans",
+                dropped, (ULong64_t)kMaxSpans);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the spans recorded so far; the thread names are kept.
+
+void ROOT::TTimelineTracer::Reset()
+{
+   TTracerState &state = TTracerState::Get();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   for (auto &buffer : state.fThreads) {
+      std::lock_guard<std::mutex> bufferLock(buffer->fMutex);
+      buffer->fSpans.clear();
+      buffer->fDropped = 0;
+   }
+}
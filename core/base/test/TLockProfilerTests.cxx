@@ -0,0 +1,103 @@
+#include "TLockProfiler.h"
+#include "TVirtualMutex.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+class TTestMutex : public TVirtualMutex {
+   std::recursive_mutex fMutex;
+
+public:
+   Int_t Lock() override
+   {
+      fMutex.lock();
+      return 0;
+   }
+   Int_t TryLock() override { return fMutex.try_lock() ? 0 : 1; }
+   Int_t UnLock() override
+   {
+      fMutex.unlock();
+      return 0;
+   }
+   Int_t CleanUp() override { return UnLock(); }
+   TVirtualMutex *Factory(Bool_t = kFALSE) override { return new TTestMutex; }
+};
+
+const ROOT::TLockProfiler::TStats *FindLock(const std::vector<ROOT::TLockProfiler::TStats> &stats, const void *lock)
+{
+   for (auto &s : stats)
+      if (s.fLock == lock)
+         return &s;
+   return nullptr;
+}
+} // anonymous namespace
+
+TEST(TLockProfiler, Disabled)
+{
+   ROOT::TLockProfiler::Enable(kFALSE);
+   ROOT::TLockProfiler::Reset();
+   TTestMutex mutex;
+   {
+      TLockGuard guard(&mutex, __FILE__, __LINE__);
+   }
+   EXPECT_EQ(FindLock(ROOT::TLockProfiler::GetLockStats(), &mutex), nullptr);
+}
+
+TEST(TLockProfiler, CountsAndSites)
+{
+   ROOT::TLockProfiler::Reset();
+   ROOT::TLockProfiler::Enable();
+   TTestMutex mutex;
+   ROOT::TLockProfiler::SetLockName(&mutex, "testMutex");
+
+   const Int_t nThreads = 4, nLocks = 100;
+   std::vector<std::thread> threads;
+   for (Int_t t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&mutex]() {
+         for (Int_t i = 0; i < nLocks; ++i) {
+            TLockGuard guard(&mutex, "first.cxx", 1);
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   {
+      TLockGuard guard(&mutex, "second.cxx", 2);
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+   }
+   {
+      TLockGuard guard(&mutex, "second.cxx", 2);
+      guard.UnLock();
+   }
+   ROOT::TLockProfiler::Enable(kFALSE);
+
+   const auto locks = ROOT::TLockProfiler::GetLockStats();
+   auto lock = FindLock(locks, &mutex);
+   ASSERT_NE(lock, nullptr);
+   EXPECT_EQ(lock->fName, "testMutex");
+   EXPECT_EQ(lock->fAcquisitions, ULong64_t(nThreads * nLocks + 2));
+   EXPECT_EQ(lock->fShared, 0u);
+   EXPECT_GE(lock->fHoldTime, 0.02);
+   EXPECT_GE(lock->fMaxHoldTime, 0.02);
+   EXPECT_GE(lock->fWaitTime, 0.);
+
+   auto sites = ROOT::TLockProfiler::GetSiteStats(&mutex);
+   ASSERT_EQ(sites.size(), 2u);
+   for (auto &site : sites) {
+      if (site.fFile == "first.cxx") {
+         EXPECT_EQ(site.fLine, 1);
+         EXPECT_EQ(site.fAcquisitions, ULong64_t(nThreads * nLocks));
+      } else {
+         EXPECT_EQ(site.fFile, "second.cxx");
+         EXPECT_EQ(site.fAcquisitions, 2u);
+      }
+   }
+
+   ROOT::TLockProfiler::Reset();
+   EXPECT_EQ(FindLock(ROOT::TLockProfiler::GetLockStats(), &mutex), nullptr);
+}
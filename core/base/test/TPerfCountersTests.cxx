@@ -0,0 +1,65 @@
+#include "TPerfCounters.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(TPerfCounters, Register)
+{
+   auto counter = ROOT::TPerfCounters::Register("test_register_total", "A test counter");
+   EXPECT_GE(counter.GetIndex(), 0);
+   EXPECT_EQ(counter.GetIndex(), ROOT::TPerfCounters::Register("test_register_total", "Again").GetIndex());
+   EXPECT_EQ(0., ROOT::TPerfCounters::GetValue("test_register_total"));
+   counter.Add(3);
+   counter.Add();
+   EXPECT_EQ(4., ROOT::TPerfCounters::GetValue("test_register_total"));
+   EXPECT_EQ(0., ROOT::TPerfCounters::GetValue("test_missing"));
+}
+
+TEST(TPerfCounters, Threads)
+{
+   auto counter = ROOT::TPerfCounters::Register("test_threads_total", "Added by several threads");
+   auto gauge = ROOT::TPerfCounters::Register("test_threads_level", "Raised and lowered by different threads",
+                                              ROOT::TPerfCounters::kGauge);
+   std::vector<std::thread> threads;
+   for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([counter, gauge]() {
+         for (int j = 0; j < 1000; ++j)
+            counter.Add();
+         gauge.Add(10);
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   // The slots of the threads that are gone are still counted.
+   EXPECT_EQ(4000., ROOT::TPerfCounters::GetValue("test_threads_total"));
+   gauge.Add(-15);
+   EXPECT_EQ(25., ROOT::TPerfCounters::GetValue("test_threads_level"));
+
+   // Only the counters are restarted.
+   ROOT::TPerfCounters::Reset();
+   EXPECT_EQ(0., ROOT::TPerfCounters::GetValue("test_threads_total"));
+   EXPECT_EQ(25., ROOT::TPerfCounters::GetValue("test_threads_level"));
+   counter.Add(2);
+   EXPECT_EQ(2., ROOT::TPerfCounters::GetValue("test_threads_total"));
+}
+
+TEST(TPerfCounters, Prometheus)
+{
+   auto time = ROOT::TPerfCounters::Register("test_prometheus_seconds_total", "Time in\nseconds",
+                                             ROOT::TPerfCounters::kCounter, 1e-9);
+   time.Add(1500000000);
+   static double level = 7;
+   ROOT::TPerfCounters::RegisterProbe("test_prometheus_probe", "Read at every call", ROOT::TPerfCounters::kGauge,
+                                      []() { return level; });
+   level = 8;
+
+   const std::string text = ROOT::TPerfCounters::FormatPrometheus();
+   EXPECT_NE(std::string::npos, text.find("# HELP test_prometheus_seconds_total Time in\\nseconds\n"
+                                          "# TYPE test_prometheus_seconds_total counter\n"
+                                          "test_prometheus_seconds_total 1.5\n"));
+   EXPECT_NE(std::string::npos, text.find("# TYPE test_prometheus_probe gauge\n"
+                                          "test_prometheus_probe 8\n"));
+}
@@ -0,0 +1,90 @@
+#include "TNamed.h"
+#include "TObjArray.h"
+#include "TProcessID.h"
+#include "TROOT.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(TReferencedObjects, AddAtChunkBoundaries)
+{
+   ROOT::Internal::TReferencedObjects table;
+   EXPECT_EQ(table.GetSize(), 0u);
+   EXPECT_EQ(table.At(12), nullptr);
+
+   TNamed a, b, c, d;
+   table.AddAt(&a, 0);
+   table.AddAt(&b, 63);
+   table.AddAt(&c, 64);
+   table.AddAt(&d, 100000);
+   EXPECT_EQ(table.At(0), &a);
+   EXPECT_EQ(table.At(63), &b);
+   EXPECT_EQ(table.At(64), &c);
+   EXPECT_EQ(table.At(100000), &d);
+   // Only the 24 lower bits are the uid.
+   EXPECT_EQ(table.At(0x01000040), &c);
+   EXPECT_EQ(table.At(65), nullptr);
+   EXPECT_EQ(table.GetEntries(), 4);
+   EXPECT_GT(table.GetSize(), 100000u);
+
+   table.AddAt(nullptr, 63);
+   EXPECT_EQ(table.At(63), nullptr);
+   EXPECT_EQ(table.GetEntries(), 3);
+
+   table.Clear();
+   EXPECT_EQ(table.At(0), nullptr);
+   EXPECT_EQ(table.GetSize(), 0u);
+}
+
+TEST(TReferencedObjects, ConcurrentReaders)
+{
+   ROOT::Internal::TReferencedObjects table;
+   const UInt_t n = 100000;
+   std::vector<std::unique_ptr<TNamed>> objects;
+   for (UInt_t i = 0; i < n; ++i)
+      objects.emplace_back(new TNamed);
+
+   std::vector<std::thread> readers;
+   std::vector<UInt_t> errors(4, 0);
+   for (size_t t = 0; t < errors.size(); ++t) {
+      readers.emplace_back([&, t]() {
+         // An object is either not there yet or there at its uid.
+         for (UInt_t i = 0; i < n; ++i) {
+            TObject *obj = table.At(i);
+            if (obj && obj != objects[i].get())
+               ++errors[t];
+         }
+      });
+   }
+   for (UInt_t i = 0; i < n; ++i)
+      table.AddAt(objects[i].get(), i);
+   for (auto &reader : readers)
+      reader.join();
+   for (UInt_t nerrors : errors)
+      EXPECT_EQ(nerrors, 0u);
+   EXPECT_EQ(table.GetEntries(), Int_t(n));
+}
+
+TEST(TProcessID, PutGetObjectWithID)
+{
+   // Create the session TProcessID first, so that pid is not the session one.
+   ROOT::GetROOT();
+   TNamed obj("obj", "");
+   TProcessID *pid = TProcessID::AddProcessID();
+   pid->PutObjectWithID(&obj, 1000);
+   EXPECT_EQ(pid->GetObjectWithID(1000), &obj);
+   EXPECT_EQ(pid->GetObjectWithID(999), nullptr);
+   EXPECT_TRUE(obj.TestBit(kMustCleanup));
+
+   TObjArray *objects = pid->GetObjects();
+   ASSERT_NE(objects, nullptr);
+   EXPECT_EQ(objects->At(1000), &obj);
+   EXPECT_EQ(objects->GetEntries(), 1);
+
+   pid->Clear();
+   EXPECT_EQ(pid->GetObjectWithID(1000), nullptr);
+   delete pid;
+}
@@ -0,0 +1,62 @@
+#include "TTimelineTracer.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(TTimelineTracer, Disabled)
+{
+   ROOT::TTimelineTracer::Disable();
+   ROOT::TTimelineTracer::Reset();
+   {
+      ROOT::TTimelineTracer::TSpan span("test", "disabled");
+   }
+   EXPECT_EQ(ROOT::TTimelineTracer::GetNSpans(), 0u);
+}
+
+TEST(TTimelineTracer, SpansAndThreads)
+{
+   ROOT::TTimelineTracer::Reset();
+   ROOT::TTimelineTracer::Enable();
+
+   const Int_t nThreads = 3, nSpans = 50;
+   std::vector<std::thread> threads;
+   for (Int_t t = 0; t < nThreads; ++t) {
+      threads.emplace_back([]() {
+         ROOT::TTimelineTracer::SetThreadName("test worker");
+         for (Int_t i = 0; i < nSpans; ++i) {
+            ROOT::TTimelineTracer::TSpan span("test", "task", "bytes", 0);
+            span.SetArg(42);
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   {
+      ROOT::TTimelineTracer::TSpan span("test", "main \"span\"");
+   }
+   ROOT::TTimelineTracer::Disable();
+   {
+      ROOT::TTimelineTracer::TSpan span("test", "after");
+   }
+   EXPECT_EQ(ROOT::TTimelineTracer::GetNSpans(), ULong64_t(nThreads * nSpans + 1));
+
+   const char *filename = "timeline_trace_test.json";
+   ASSERT_TRUE(ROOT::TTimelineTracer::Write(filename));
+   std::ifstream file(filename);
+   std::stringstream content;
+   content << file.rdbuf();
+   const std::string trace = content.str();
+   EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+   EXPECT_NE(trace.find("\"name\":\"thread_name\",\"args\":{\"name\":\"test worker\"}"), std::string::npos);
+   EXPECT_NE(trace.find("\"cat\":\"test\",\"name\":\"task\",\"args\":{\"bytes\":42}"), std::string::npos);
+   EXPECT_NE(trace.find("\"name\":\"main \\\"span\\\"\""), std::string::npos);
+   EXPECT_EQ(trace.find("\"after\""), std::string::npos);
+
+   ROOT::TTimelineTracer::Reset();
+   EXPECT_EQ(ROOT::TTimelineTracer::GetNSpans(), 0u);
+}
@@ -134,6 +134,8 @@ public:
    UInt_t  FirstSetBit(UInt_t startBit=0)   const;
    UInt_t  LastNullBit(UInt_t startBit=999999999) const;
    UInt_t  LastSetBit(UInt_t startBit=999999999)  const;
+   template <typename F>
+   void    ForEachSetBit(F &&f) const;     // call f(bitnumber) for each bit set to 1
    UInt_t  GetNbits()      const { return fNbits; }
    UInt_t  GetNbytes()     const { return fNbytes; }
 
@@ -234,6 +236,31 @@ inline void TBits::ResetBitNumber(UInt_t bitnumber)
    SetBitNumber(bitnumber,kFALSE);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Call f(bitnumber) for each bit set to 1, in increasing order. The null
+/// words of 64 bits are skipped at once.
+
+template <typename F>
+inline void TBits::ForEachSetBit(F &&f) const
+{
+   UInt_t i = 0;
+   for (; i + 8 <= fNbytes; i += 8) {
+      ULong64_t word;
+      memcpy(&word, fAllBits + i, sizeof(word));
+      if (!word) continue;
+      for (UInt_t j = i; j < i + 8; ++j) {
+         for (UInt_t val = fAllBits[j], bit = 8*j; val; val >>= 1, ++bit) {
+            if (val & 1) f(bit);
+         }
+      }
+   }
+   for (; i < fNbytes; ++i) {
+      for (UInt_t val = fAllBits[i], bit = 8*i; val; val >>= 1, ++bit) {
+         if (val & 1) f(bit);
+      }
+   }
+}
+
 inline Bool_t TBits::operator[](UInt_t bitnumber) const
 {
    return TestBitNumber(bitnumber);
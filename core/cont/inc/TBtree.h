@@ -72,6 +72,7 @@ public:
    virtual     ~TBtree();
    void        Clear(Option_t *option="");
    void        Delete(Option_t *option="");
+   using TCollection::FindObject;
    TObject    *FindObject(const char *name) const;
    TObject    *FindObject(const TObject *obj) const;
    TObject   **GetObjectRef(const TObject *) const { return 0; }
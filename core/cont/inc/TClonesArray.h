@@ -32,8 +32,17 @@ class TClass;
 class TClonesArray : public TObjArray {
 
 protected:
+   struct TArena;
+
    TClass       *fClass;       //!Pointer to the class of the elements
    TObjArray    *fKeep;        //!Saved copies of pointers to objects
+   TArena       *fArena;       //!Blocks of memory of the objects allocated in arena mode
+
+   static Bool_t fgDefaultArena; //Whether the new arrays are in arena mode
+
+   TObject         *AllocateObject();
+   TObject         *CreateObject();
+   void             ReleaseMemory(TObject *obj);
 
 public:
    enum EStatusBits {
@@ -69,6 +78,10 @@ public:
    TObject         *ConstructedAt(Int_t idx, Option_t *clear_options);
    void             SetClass(const char *classname,Int_t size=1000);
    void             SetClass(const TClass *cl,Int_t size=1000);
+   void             SetArena(Bool_t arena=kTRUE);
+   Bool_t           IsArena() const;
+   static void      SetDefaultArena(Bool_t arena=kTRUE) { fgDefaultArena = arena; }
+   static Bool_t    GetDefaultArena() { return fgDefaultArena; }
 
    void             AbsorbObjects(TClonesArray *tc);
    void             AbsorbObjects(TClonesArray *tc, Int_t idx1, Int_t idx2);
@@ -172,6 +172,9 @@ public:
    virtual void       Draw(Option_t *option="");
    virtual void       Dump() const ;
    virtual TObject   *FindObject(const char *name) const;
+   TObject           *FindObject(std::string_view name) const;
+   TObject           *FindObject(const TString &name) const { return FindObject(name.Data()); }
+   TObject           *FindObject(const std::string &name) const { return FindObject(name.c_str()); }
    TObject           *operator()(const char *name) const;
    virtual TObject   *FindObject(const TObject *obj) const;
    virtual Int_t      GetEntries() const { return GetSize(); }
@@ -22,6 +22,11 @@
 // pointers or any longs. The map uses an open addressing hashing       //
 // method (linear probing).                                             //
 //                                                                      //
+// Delete() keeps the table: the slots filled since the previous        //
+// Delete() are cleared one by one when they are few, so that a map     //
+// reused for each event, like the ones of TBufferFile, is reset at a   //
+// cost proportional to its use rather than to its capacity.            //
+//                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
 
@@ -47,11 +52,17 @@ private:
       void       Clear() { fHash = 0x0; }
    };
 
+   enum { kLogSize = 16 };
+
    Assoc_t    *fTable;
    Int_t       fSize;
    Int_t       fTally;
+   Int_t       fLog[kLogSize]; //! Slots filled since the last Delete()
+   Int_t       fLogged;        //! Number of slots in fLog, kLogSize+1 when they are not all logged
 
    Bool_t      HighWaterMark() { return (Bool_t) (fTally >= ((3*fSize)/4)); }
+   void        LogSlot(Int_t slot) { if (fLogged < kLogSize) fLog[fLogged] = slot; if (fLogged <= kLogSize) ++fLogged; }
+   void        StopLogging() { fLogged = kLogSize + 1; }
    Int_t       FindElement(ULong64_t hash, Long64_t key);
    void        FixCollisions(Int_t index);
 
@@ -68,6 +79,7 @@ public:
    void      Delete(Option_t *opt = "");
    Int_t     Capacity() const { return fSize; }
    void      Expand(Int_t newsize);
+   void      Reserve(Int_t nentries);
    Int_t     GetSize() const { return fTally; }
    Long64_t  GetValue(ULong64_t hash, Long64_t key);
    Long64_t  GetValue(Long64_t key) { return GetValue(key, key); }
@@ -48,6 +48,7 @@ public:
    void       Clear(Option_t *option="");
    void       Delete(Option_t *option="");
 
+   using TCollection::FindObject;
    TObject   *FindObject(const char *name) const;
    TObject   *FindObject(const TObject *obj) const;
 
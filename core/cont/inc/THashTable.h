@@ -22,6 +22,10 @@
 // Hash() function. Each class inheriting from TObject can override     //
 // Hash() as it sees fit.                                               //
 //                                                                      //
+// The table uses open addressing: each slot stores the hash value and  //
+// the object, and only the objects sharing a hash value are kept in a  //
+// TList.                                                               //
+//                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
 #include "TCollection.h"
@@ -37,17 +41,34 @@ class THashTable : public TCollection {
 friend class  THashTableIter;
 
 private:
-   TList     **fCont;          //Hash table (table of lists)
+   enum { kGroupWidth = 16, kSlotEmpty = 0x80, kSlotDeleted = 0xFE };
+
+   struct TSlot {
+      ULong_t     fHash;       //Hash() of the objects of the slot
+      TObject    *fObject;     //The object, if it is alone with this hash
+      TList      *fList;       //The objects with this hash, once there are several or GetListForObject() asked for it
+   };
+
+   UChar_t    *fCtrl;          //!Per slot: empty, deleted or 7 bits of the hash, for the probing
+   TSlot      *fSlots;         //!Table of slots, allocated by the first insertion
    Int_t       fEntries;       //Number of objects in table
-   Int_t       fUsedSlots;     //Number of used slots
-   Int_t       fRehashLevel;   //Average collision rate which triggers rehash
+   Int_t       fUsedSlots;     //Number of used slots, i.e. of different hash values
+   Int_t       fDeletedSlots;  //Number of slots emptied by a removal, still part of the probing
+   Int_t       fRehashLevel;   //Kept for backward compatibility, the table grows by itself
 
-   Int_t       GetCheckedHashValue(TObject *obj) const;
-   Int_t       GetHashValue(const TObject *obj) const;
-   Int_t       GetHashValue(TString &s) const { return s.Hash() % fSize; }
-   Int_t       GetHashValue(const char *str) const { return ::Hash(str) % fSize; }
+   static Bool_t IsFull(UChar_t ctrl) { return ctrl < kSlotEmpty; }
 
-   void        AddImpl(Int_t slot, TObject *object);
+   Int_t       FindSlot(ULong_t hash) const;
+   Int_t       FindFreeSlot(ULong_t hash) const;
+   void        SetCtrl(Int_t slot, UChar_t ctrl);
+   void        Allocate(Int_t nslots);
+   void        Grow(Int_t nentries);
+   void        FreeSlot(Int_t slot);
+   void        ResetSlots();
+   TList      *MakeList(Int_t slot) const;
+   const TList *GetListForHash(ULong_t hash) const;
+
+   void        AddImpl(ULong_t hash, TObject *obj, const TObject *before);
 
    THashTable(const THashTable&);             // not implemented
    THashTable& operator=(const THashTable&);  // not implemented
@@ -63,6 +84,7 @@ public:
    Int_t         Collisions(const char *name) const;
    Int_t         Collisions(TObject *obj) const;
    void          Delete(Option_t *option="");
+   using TCollection::FindObject;
    TObject      *FindObject(const char *name) const;
    TObject      *FindObject(const TObject *obj) const;
    const TList  *GetListForObject(const char *name) const;
@@ -89,18 +111,6 @@ inline Float_t THashTable::AverageCollisions() const
       return 0.0;
 }
 
-inline Int_t THashTable::GetCheckedHashValue(TObject *obj) const
-{
-   Int_t i = Int_t(obj->CheckedHash() % fSize); // need intermediary i for Linux g++
-   return i;
-}
-
-inline Int_t THashTable::GetHashValue(const TObject *obj) const
-{
-   Int_t i = Int_t(obj->Hash() % fSize);  // need intermediary i for Linux g++
-   return i;
-}
-
 
 //////////////////////////////////////////////////////////////////////////
 //                                                                      //
@@ -116,9 +126,10 @@ private:
    const THashTable *fTable;       //hash table being iterated
    Int_t             fCursor;      //current position in table
    TListIter        *fListCursor;  //current position in collision list
+   TObject          *fCurrent;     //current object
    Bool_t            fDirection;   //iteration direction
 
-   THashTableIter() : fTable(0), fCursor(0), fListCursor(0), fDirection(kIterForward) { }
+   THashTableIter() : fTable(0), fCursor(0), fListCursor(0), fCurrent(0), fDirection(kIterForward) { }
    Int_t             NextSlot();
 
 public:
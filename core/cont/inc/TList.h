@@ -80,6 +80,7 @@ public:
    virtual           ~TList();
    virtual void      Clear(Option_t *option="");
    virtual void      Delete(Option_t *option="");
+   using TCollection::FindObject;
    virtual TObject  *FindObject(const char *name) const;
    virtual TObject  *FindObject(const TObject *obj) const;
    virtual TIterator *MakeIterator(Bool_t dir = kIterForward) const;
@@ -230,6 +231,52 @@ public:
    ClassDef(TListIter,0)  //Linked list iterator
 };
 
+namespace ROOT {
+namespace Detail {
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TListRange                                                           //
+//                                                                      //
+// Range over the objects of a TList, or of a THashList, which follows  //
+// the links of the list instead of allocating a TListIter:             //
+//                                                                      //
+//    for (TObject *obj : ROOT::Detail::TListRange(list)) { ... }       //
+//                                                                      //
+// The current object may be removed from the list during the           //
+// iteration, the list must not be modified otherwise. Unlike TIter, it //
+// does not take the lock of the collections using a read-write lock.   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class TListRange {
+public:
+   class TLinkIterator : public std::iterator<std::forward_iterator_tag, TObject *> {
+   private:
+      TObjLink *fLink;
+      TObjLink *fNext;   // Read ahead, in case the current object is removed
+
+   public:
+      explicit TLinkIterator(TObjLink *link = nullptr) : fLink(link), fNext(link ? link->Next() : nullptr) { }
+      TObject       *operator*() const { return fLink->GetObject(); }
+      TLinkIterator &operator++() { fLink = fNext; fNext = fLink ? fLink->Next() : nullptr; return *this; }
+      bool           operator==(const TLinkIterator &other) const { return fLink == other.fLink; }
+      bool           operator!=(const TLinkIterator &other) const { return fLink != other.fLink; }
+   };
+
+private:
+   TObjLink *fFirst;
+
+public:
+   TListRange(const TList &list) : fFirst(list.FirstLink()) { }
+   TListRange(const TList *list) : fFirst(list ? list->FirstLink() : nullptr) { }
+   TLinkIterator begin() const { return TLinkIterator(fFirst); }
+   TLinkIterator end() const { return TLinkIterator(); }
+};
+
+} // namespace Detail
+} // namespace ROOT
+
 inline bool operator==(TObjOptLink *l, const std::shared_ptr<TObjLink> &r) {
    return l == r.get();
 }
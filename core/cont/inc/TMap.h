@@ -69,6 +69,7 @@ public:
    void              DeleteValues();
    void              DeleteAll();
    Bool_t            DeleteEntry(TObject *key);
+   using TCollection::FindObject;
    TObject          *FindObject(const char *keyname) const;
    TObject          *FindObject(const TObject *key) const;
    TObject         **GetObjectRef(const TObject *obj) const { return fTable->GetObjectRef(obj); }
@@ -78,6 +78,7 @@ public:
    virtual Int_t    AddAtFree(TObject *obj);
    virtual void     AddAfter(const TObject *after, TObject *obj);
    virtual void     AddBefore(const TObject *before, TObject *obj);
+   using TCollection::FindObject;
    virtual TObject *FindObject(const char *name) const;
    virtual TObject *FindObject(const TObject *obj) const;
    virtual TObject *RemoveAt(Int_t idx);
@@ -153,6 +154,59 @@ public:
 #pragma GCC diagnostic pop
 #endif
 
+namespace ROOT {
+namespace Detail {
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TObjArrayRange                                                       //
+//                                                                      //
+// Range over the non-null objects of a TObjArray which reads the slots //
+// of the array directly, instead of allocating a TObjArrayIter:        //
+//                                                                      //
+//    for (TObject *obj : ROOT::Detail::TObjArrayRange(array)) { ... }  //
+//                                                                      //
+// The slots are read again at each step, so that objects may be        //
+// removed or replaced during the iteration; the objects added past the //
+// last slot when the iteration started are not visited.                //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class TObjArrayRange {
+public:
+   class TSlotIterator : public std::iterator<std::forward_iterator_tag, TObject *> {
+   private:
+      const TObjArray *fArray;
+      Int_t            fIndex;
+      Int_t            fEnd;
+
+      void SkipEmpty() { while (fIndex < fEnd && !fArray->UncheckedAt(fIndex)) ++fIndex; }
+
+   public:
+      TSlotIterator(const TObjArray *array, Int_t index, Int_t end) : fArray(array), fIndex(index), fEnd(end) { SkipEmpty(); }
+      TObject       *operator*() const { return fArray->UncheckedAt(fIndex); }
+      TSlotIterator &operator++() { ++fIndex; SkipEmpty(); return *this; }
+      bool           operator==(const TSlotIterator &other) const { return fIndex == other.fIndex; }
+      bool           operator!=(const TSlotIterator &other) const { return fIndex != other.fIndex; }
+   };
+
+private:
+   const TObjArray *fArray;
+   Int_t            fBegin;
+   Int_t            fEnd;
+
+public:
+   TObjArrayRange(const TObjArray &array)
+      : fArray(&array), fBegin(array.LowerBound()), fEnd(array.LowerBound() + array.GetEntriesFast()) { }
+   TObjArrayRange(const TObjArray *array)
+      : fArray(array), fBegin(array ? array->LowerBound() : 0), fEnd(array ? array->LowerBound() + array->GetEntriesFast() : 0) { }
+   TSlotIterator begin() const { return TSlotIterator(fArray, fBegin, fEnd); }
+   TSlotIterator end() const { return TSlotIterator(fArray, fEnd, fEnd); }
+};
+
+} // namespace Detail
+} // namespace ROOT
+
 //---- inlines -----------------------------------------------------------------
 
 inline Bool_t TObjArray::BoundsOk(const char *where, Int_t at) const
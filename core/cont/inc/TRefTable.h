@@ -48,6 +48,8 @@ protected:
    TObject          *fOwner;      //Object owning this TRefTable
    std::vector<std::string> fProcessGUIDs; // UUIDs of TProcessIDs used in fParentIDs
    std::vector<Int_t> fMapPIDtoInternal;   //! cache of pid to index in fProcessGUIDs
+   std::vector<Int_t> fEntryParents;       //! indices in fParents of the parents of the current entry, see GetEntryParents
+   Bool_t             fEntryParentsValid;  //! whether fEntryParents is up to date
    static TRefTable *fgRefTable;  //Pointer to current TRefTable
 
    Int_t              AddInternalIdxForPID(TProcessID* procid);
@@ -76,6 +78,7 @@ public:
    Int_t              GetN(Int_t pid) const {return fN[GetInternalIdxForPID(pid)];}
    TObject           *GetOwner() const {return fOwner;}
    TObject           *GetParent(Int_t uid, TProcessID* context = 0) const;
+   const std::vector<Int_t> &GetEntryParents();
    TObjArray         *GetParents() const {return fParents;}
    UInt_t             GetUID() const {return fUID;}
    TProcessID        *GetUIDContext() const {return fUIDContext;}
@@ -16,6 +16,14 @@ The size of the container is automatically extended when a bit
 number is either set or tested.  To reduce the memory size of the
 container use the Compact function, this will discard the memory
 occupied by the upper bits that are 0.
+
+The bulk operations (`&=`, `|=`, `^=`, `~`, CountBits and the searches for
+the first and last set or null bit) process the bits 64 at a time, and
+ForEachSetBit calls a function for each of the bits set, skipping the
+null words:
+~~~ {.cpp}
+bits.ForEachSetBit([&](UInt_t i) { selected.push_back(i); });
+~~~
 */
 
 #include "TBits.h"
@@ -27,6 +35,127 @@ occupied by the upper bits that are 0.
 
 ClassImp(TBits);
 
+namespace {
+
+// The bits are kept in bytes, which is also their layout on file. The bulk
+// operations process them 8 bytes at a time: the raw words are enough for the
+// bitwise operations and the counting, the searches need the word whose bit
+// j is the bit j of the 8 bytes, i.e. the little endian value.
+
+inline ULong64_t LoadRawWord(const UChar_t *bytes)
+{
+   ULong64_t word;
+   memcpy(&word, bytes, sizeof(word));
+   return word;
+}
+
+inline void StoreRawWord(UChar_t *bytes, ULong64_t word)
+{
+   memcpy(bytes, &word, sizeof(word));
+}
+
+inline ULong64_t LoadWord(const UChar_t *bytes)
+{
+#ifdef R__BYTESWAP
+   return LoadRawWord(bytes);
+#else
+   ULong64_t word = 0;
+   for (Int_t i = 7; i >= 0; --i)
+      word = (word << 8) | bytes[i];
+   return word;
+#endif
+}
+
+inline UInt_t PopCount(ULong64_t word)
+{
+#if defined(__GNUC__)
+   return __builtin_popcountll(word);
+#else
+   word = word - ((word >> 1) & 0x5555555555555555ULL);
+   word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+   word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+   return (word * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+// Position of the lowest bit set in word, which is not null.
+inline UInt_t LowestBit(ULong64_t word)
+{
+#if defined(__GNUC__)
+   return __builtin_ctzll(word);
+#else
+   UInt_t n = 0;
+   for (; !(word & 1); word >>= 1)
+      ++n;
+   return n;
+#endif
+}
+
+// Position of the highest bit set in word, which is not null.
+inline UInt_t HighestBit(ULong64_t word)
+{
+#if defined(__GNUC__)
+   return 63 - __builtin_clzll(word);
+#else
+   UInt_t n = 0;
+   for (; word >>= 1;)
+      ++n;
+   return n;
+#endif
+}
+
+UInt_t CountBytes(const UChar_t *bytes, UInt_t nbytes)
+{
+   UInt_t count = 0;
+   UInt_t i = 0;
+   for (; i + 8 <= nbytes; i += 8)
+      count += PopCount(LoadRawWord(bytes + i));
+   for (; i < nbytes; ++i)
+      count += PopCount(bytes[i]);
+   return count;
+}
+
+// Return the position of the first bit at or after startBit which is set in
+// the bytes xor'ed with flip (0 or 0xff), or notFound.
+UInt_t FindForward(const UChar_t *bytes, UInt_t nbytes, UInt_t startBit, UChar_t flip, UInt_t notFound)
+{
+   UInt_t i = startBit / 8;
+   if (i >= nbytes) return notFound;
+   const UChar_t first = (bytes[i] ^ flip) & (UChar_t)(0xff << (startBit % 8));
+   if (first) return 8 * i + LowestBit(first);
+   const ULong64_t wordFlip = flip ? ~0ULL : 0ULL;
+   for (++i; i + 8 <= nbytes; i += 8) {
+      const ULong64_t word = LoadWord(bytes + i) ^ wordFlip;
+      if (word) return 8 * i + LowestBit(word);
+   }
+   for (; i < nbytes; ++i) {
+      const UChar_t byte = bytes[i] ^ flip;
+      if (byte) return 8 * i + LowestBit(byte);
+   }
+   return notFound;
+}
+
+// Return the position of the last bit at or before startBit which is set in
+// the bytes xor'ed with flip (0 or 0xff), or notFound.
+UInt_t FindBackward(const UChar_t *bytes, UInt_t startBit, UChar_t flip, UInt_t notFound)
+{
+   UInt_t i = startBit / 8;
+   const UChar_t last = (bytes[i] ^ flip) & (UChar_t)(0xff >> (7 - startBit % 8));
+   if (last) return 8 * i + HighestBit(last);
+   const ULong64_t wordFlip = flip ? ~0ULL : 0ULL;
+   for (; i >= 8; i -= 8) {
+      const ULong64_t word = LoadWord(bytes + i - 8) ^ wordFlip;
+      if (word) return 8 * (i - 8) + HighestBit(word);
+   }
+   for (; i > 0; --i) {
+      const UChar_t byte = bytes[i - 1] ^ flip;
+      if (byte) return 8 * (i - 1) + HighestBit(byte);
+   }
+   return notFound;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TBits constructor.  All bits set to 0
 
@@ -117,44 +246,11 @@ void TBits::Compact()
 
 UInt_t TBits::CountBits(UInt_t startBit) const
 {
-   static const Int_t nbits[256] = {
-             0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
-             1,2,2,3,2,3,3,4,2,3,3,4,3,4,4,5,
-             1,2,2,3,2,3,3,4,2,3,3,4,3,4,4,5,
-             2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,
-             1,2,2,3,2,3,3,4,2,3,3,4,3,4,4,5,
-             2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,
-             2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,
-             3,4,4,5,4,5,5,6,4,5,5,6,5,6,6,7,
-             1,2,2,3,2,3,3,4,2,3,3,4,3,4,4,5,
-             2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,
-             2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,
-             3,4,4,5,4,5,5,6,4,5,5,6,5,6,6,7,
-             2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,
-             3,4,4,5,4,5,5,6,4,5,5,6,5,6,6,7,
-             3,4,4,5,4,5,5,6,4,5,5,6,5,6,6,7,
-             4,5,5,6,5,6,6,7,5,6,6,7,6,7,7,8};
-
-   UInt_t i,count = 0;
-   if (startBit == 0) {
-      for(i=0; i<fNbytes; i++) {
-         count += nbits[fAllBits[i]];
-      }
-      return count;
-   }
-   if (startBit >= fNbits) return count;
-   UInt_t startByte = startBit/8;
-   UInt_t ibit = startBit%8;
-   if (ibit) {
-      for (i=ibit;i<8;i++) {
-         if (fAllBits[startByte] & (1<<ibit)) count++;
-      }
-      startByte++;
-   }
-   for(i=startByte; i<fNbytes; i++) {
-      count += nbits[fAllBits[i]];
-   }
-   return count;
+   if (startBit == 0) return CountBytes(fAllBits, fNbytes);
+   if (startBit >= fNbits) return 0;
+   const UInt_t startByte = startBit/8;
+   const UChar_t first = fAllBits[startByte] & (UChar_t)(0xff << (startBit%8));
+   return PopCount(first) + CountBytes(fAllBits + startByte + 1, fNbytes - startByte - 1);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -165,7 +261,11 @@ UInt_t TBits::CountBits(UInt_t startBit) const
 void TBits::DoAndEqual(const TBits& rhs)
 {
    UInt_t min = (fNbytes<rhs.fNbytes) ? fNbytes : rhs.fNbytes;
-   for(UInt_t i=0; i<min; ++i) {
+   UInt_t i = 0;
+   for(; i+8<=min; i+=8) {
+      StoreRawWord(fAllBits+i, LoadRawWord(fAllBits+i) & LoadRawWord(rhs.fAllBits+i));
+   }
+   for(; i<min; ++i) {
       fAllBits[i] &= rhs.fAllBits[i];
    }
    if (fNbytes>min) {
@@ -181,7 +281,11 @@ void TBits::DoAndEqual(const TBits& rhs)
 void TBits::DoOrEqual(const TBits& rhs)
 {
    UInt_t min = (fNbytes<rhs.fNbytes) ? fNbytes : rhs.fNbytes;
-   for(UInt_t i=0; i<min; ++i) {
+   UInt_t i = 0;
+   for(; i+8<=min; i+=8) {
+      StoreRawWord(fAllBits+i, LoadRawWord(fAllBits+i) | LoadRawWord(rhs.fAllBits+i));
+   }
+   for(; i<min; ++i) {
       fAllBits[i] |= rhs.fAllBits[i];
    }
 }
@@ -194,7 +298,11 @@ void TBits::DoOrEqual(const TBits& rhs)
 void TBits::DoXorEqual(const TBits& rhs)
 {
    UInt_t min = (fNbytes<rhs.fNbytes) ? fNbytes : rhs.fNbytes;
-   for(UInt_t i=0; i<min; ++i) {
+   UInt_t i = 0;
+   for(; i+8<=min; i+=8) {
+      StoreRawWord(fAllBits+i, LoadRawWord(fAllBits+i) ^ LoadRawWord(rhs.fAllBits+i));
+   }
+   for(; i<min; ++i) {
       fAllBits[i] ^= rhs.fAllBits[i];
    }
 }
@@ -204,7 +312,11 @@ void TBits::DoXorEqual(const TBits& rhs)
 
 void TBits::DoFlip()
 {
-   for(UInt_t i=0; i<fNbytes; ++i) {
+   UInt_t i = 0;
+   for(; i+8<=fNbytes; i+=8) {
+      StoreRawWord(fAllBits+i, ~LoadRawWord(fAllBits+i));
+   }
+   for(; i<fNbytes; ++i) {
       fAllBits[i] = ~fAllBits[i];
    }
    // NOTE: out-of-bounds bit were also flipped!
@@ -263,44 +375,8 @@ void TBits::DoRightShift(UInt_t shift)
 
 UInt_t TBits::FirstNullBit(UInt_t startBit) const
 {
-   static const Int_t fbits[256] = {
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,4,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,5,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,4,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,6,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,4,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,5,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,4,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,7,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,4,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,5,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,4,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,6,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,4,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,5,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,4,
-             0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,8};
-
-   UInt_t i;
-   if (startBit == 0) {
-      for(i=0; i<fNbytes; i++) {
-         if (fAllBits[i] != 255) return 8*i + fbits[fAllBits[i]];
-      }
-      return fNbits;
-   }
-   if (startBit >= fNbits) return fNbits;
-   UInt_t startByte = startBit/8;
-   UInt_t ibit = startBit%8;
-   if (ibit) {
-      for (i=ibit;i<8;i++) {
-         if ((fAllBits[startByte] & (1<<i)) == 0) return 8*startByte+i;
-      }
-      startByte++;
-   }
-   for(i=startByte; i<fNbytes; i++) {
-      if (fAllBits[i] != 255) return 8*i + fbits[fAllBits[i]];
-   }
-   return fNbits;
+   if (startBit && startBit >= fNbits) return fNbits;
+   return FindForward(fAllBits, fNbytes, startBit, 0xff, fNbits);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -308,38 +384,9 @@ UInt_t TBits::FirstNullBit(UInt_t startBit) const
 
 UInt_t TBits::LastNullBit(UInt_t startBit) const
 {
-   static const Int_t fbits[256] = {
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-             6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-             6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-             6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-             5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-             5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-             4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
-             3,3,3,3,3,3,3,3,2,2,2,2,1,1,0,8};
-
-   UInt_t i;
+   if (!fNbits) return fNbits;
    if (startBit>=fNbits) startBit = fNbits-1;
-   UInt_t startByte = startBit/8;
-   UInt_t ibit = startBit%8;
-   if (ibit<7) {
-      for (i=ibit+1;i>0;i--) {
-         if ((fAllBits[startByte] & (1<<(i-1))) == 0) return 8*startByte+i-1;
-      }
-      startByte--;
-   }
-   for(i=startByte+1; i>0; i--) {
-      if (fAllBits[i-1] != 255) return 8*(i-1) + fbits[fAllBits[i-1]];
-   }
-   return fNbits;
+   return FindBackward(fAllBits, startBit, 0xff, fNbits);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -347,44 +394,8 @@ UInt_t TBits::LastNullBit(UInt_t startBit) const
 
 UInt_t TBits::FirstSetBit(UInt_t startBit) const
 {
-   static const Int_t fbits[256] = {
-             8,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             4,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             5,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             4,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             6,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             4,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             5,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             4,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             7,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             4,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             5,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             4,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             6,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             4,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             5,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,
-             4,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0};
-
-   UInt_t i;
-   if (startBit == 0) {
-      for(i=0; i<fNbytes; i++) {
-         if (fAllBits[i] != 0) return 8*i + fbits[fAllBits[i]];
-      }
-      return fNbits;
-   }
-   if (startBit >= fNbits) return fNbits;
-   UInt_t startByte = startBit/8;
-   UInt_t ibit = startBit%8;
-   if (ibit) {
-      for (i=ibit;i<8;i++) {
-         if ((fAllBits[startByte] & (1<<i)) != 0) return 8*startByte+i;
-      }
-      startByte++;
-   }
-   for(i=startByte; i<fNbytes; i++) {
-      if (fAllBits[i] != 0) return 8*i + fbits[fAllBits[i]];
-   }
-   return fNbits;
+   if (startBit && startBit >= fNbits) return fNbits;
+   return FindForward(fAllBits, fNbytes, startBit, 0, fNbits);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -392,38 +403,9 @@ UInt_t TBits::FirstSetBit(UInt_t startBit) const
 
 UInt_t TBits::LastSetBit(UInt_t startBit) const
 {
-   static const Int_t fbits[256] = {
-             8,0,1,1,2,2,2,2,3,3,3,3,3,3,3,3,
-             4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
-             5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-             5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-             6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-             6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-             6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-             6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-             7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7};
-
-   UInt_t i;
+   if (!fNbits) return fNbits;
    if (startBit>=fNbits) startBit = fNbits-1;
-   UInt_t startByte = startBit/8;
-   UInt_t ibit = startBit%8;
-   if (ibit<7) {
-      for (i=ibit+1;i>0;i--) {
-         if ((fAllBits[startByte] & (1<<(i-1))) != 0) return 8*startByte+i-1;
-      }
-      startByte--;
-   }
-   for(i=startByte+1; i>0; i--) {
-      if (fAllBits[i-1] != 0) return 8*(i-1) + fbits[fAllBits[i-1]];
-   }
-   return fNbits;
+   return FindBackward(fAllBits, startBit, 0, fNbits);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -453,15 +435,7 @@ void TBits::Paint(Option_t *)
 
 void TBits::Print(Option_t *) const
 {
-   Int_t count = 0;
-   for(UInt_t i=0; i<fNbytes; ++i) {
-      UChar_t val = fAllBits[i];
-      for (UInt_t j=0; j<8; ++j) {
-         if (val & 1) printf(" bit:%4d = 1\n",count);
-         count++;
-         val = val >> 1;
-      }
-   }
+   ForEachSetBit([](UInt_t bit) { printf(" bit:%4d = 1\n", (Int_t)bit); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -121,6 +121,29 @@ When investigating misuse of TClonesArray, please make sure of the following:
      TClonesArrays are not destroyed and created on every event. They
      must only be constructed/destructed at the beginning/end of the
      run.
+
+### Arena mode
+
+By default each slot of a TClonesArray is allocated separately on the
+heap the first time it is used. In arena mode, enabled with SetArena() or
+for all the arrays created afterwards (including those created when
+reading a TTree or a file) with TClonesArray::SetDefaultArena(), the slots
+are cut from large blocks owned by the array instead:
+~~~ {.cpp}
+   TClonesArray *hits = new TClonesArray("THit", 1000);
+   hits->SetArena();
+~~~
+The blocks grow geometrically with the number of slots, so that an array
+whose content varies from event to event only allocates a handful of
+blocks for the whole job. The memory of the slots released when the
+array shrinks (e.g. by ExpandCreate() or Expand()) is kept for the next
+slots, and all the blocks are freed at once when the array is deleted.
+Nothing changes for the user classes, and Clear("C"), ConstructedAt()
+and the I/O, which reuse the constructed objects, work as before.
+
+The objects in an arena are not flagged as being on the heap (see
+TObject::IsOnHeap()), so that another collection owning them never
+deletes them.
 */
 
 #include "TClonesArray.h"
@@ -132,15 +155,129 @@ When investigating misuse of TClonesArray, please make sure of the following:
 #include "TObjectTable.h"
 
 #include <stdlib.h>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
 
 ClassImp(TClonesArray);
 
+Bool_t TClonesArray::fgDefaultArena = kFALSE;
+
+/// Memory of the slots of a TClonesArray in arena mode.
+struct TClonesArray::TArena {
+   struct TBlock {
+      char *fBegin;
+      char *fEnd;
+      TBlock(size_t size) : fBegin(static_cast<char *>(::operator new(size))), fEnd(fBegin + size)
+      {
+         // No leftover of TStorage::ObjectAlloc's pattern: the objects are not flagged as on the heap.
+         memset(fBegin, 0, size);
+      }
+      ~TBlock() { ::operator delete(fBegin); }
+   };
+
+   // Shared with the arrays which absorbed some of our objects.
+   std::vector<std::shared_ptr<TBlock>> fBlocks;
+   std::vector<void *> fFree; // Released slots
+   char *fNext = nullptr;     // Next never used slot of the last block
+   char *fEnd = nullptr;
+   size_t fSlotSize;
+   size_t fNSlots = 0;
+   Bool_t fActive = kTRUE; // Whether the new slots come from the arena
+
+   TArena(size_t size)
+   {
+      const size_t align = alignof(std::max_align_t);
+      fSlotSize = (std::max<size_t>(size, 1) + align - 1) / align * align;
+   }
+
+   void *Allocate()
+   {
+      if (!fFree.empty()) {
+         void *slot = fFree.back();
+         fFree.pop_back();
+         return slot;
+      }
+      if (fNext == fEnd) {
+         const size_t nslots = std::max<size_t>(16, fNSlots);
+         fBlocks.emplace_back(std::make_shared<TBlock>(nslots * fSlotSize));
+         fNext = fBlocks.back()->fBegin;
+         fEnd = fBlocks.back()->fEnd;
+         fNSlots += nslots;
+      }
+      void *slot = fNext;
+      fNext += fSlotSize;
+      return slot;
+   }
+
+   Bool_t Contains(const void *p) const
+   {
+      const char *c = static_cast<const char *>(p);
+      for (auto &block : fBlocks)
+         if (c >= block->fBegin && c < block->fEnd)
+            return kTRUE;
+      return kFALSE;
+   }
+
+   /// Keep the blocks of other alive, some of its slots are moved to us.
+   void Share(const TArena &other)
+   {
+      for (auto &block : other.fBlocks)
+         if (std::find(fBlocks.begin(), fBlocks.end(), block) == fBlocks.end())
+            fBlocks.push_back(block);
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the memory of a new slot, from the arena in arena mode. The object
+/// is not constructed, i.e. its kNotDeleted bit is not set.
+
+TObject *TClonesArray::AllocateObject()
+{
+   TObject *obj;
+   const size_t size = fClass->Size();
+   if (fArena && fArena->fActive && size <= fArena->fSlotSize)
+      obj = static_cast<TObject *>(fArena->Allocate());
+   else
+      obj = static_cast<TObject *>(TStorage::ObjectAlloc(size));
+   // Reset the bit so that:
+   //    obj = myClonesArray[i];
+   //    obj->TestBit(TObject::kNotDeleted)
+   // will behave correctly.
+   // TObject::kNotDeleted is one of the higher bit that is not settable via the public
+   // interface. But luckily we are its friend.
+   obj->fBits &= ~kNotDeleted;
+   return obj;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new object of the class of the array, constructed in the arena
+/// in arena mode.
+
+TObject *TClonesArray::CreateObject()
+{
+   if (fArena && fArena->fActive)
+      return static_cast<TObject *>(fClass->New(AllocateObject()));
+   return static_cast<TObject *>(fClass->New());
+}
+
+////////////////////////////////////////////////////////////////////////////////
 /// Internal Utility routine to correctly release the memory for an object
-static inline void R__ReleaseMemory(TClass *cl, TObject *obj)
+
+void TClonesArray::ReleaseMemory(TObject *obj)
 {
-   if (obj && obj->TestBit(TObject::kNotDeleted)) {
+   if (!obj)
+      return;
+   if (fArena && fArena->Contains(obj)) {
+      if (obj->TestBit(TObject::kNotDeleted))
+         fClass->Destructor(obj, kTRUE);
+      else if (TObject::GetObjectStat() && gObjectTable)
+         gObjectTable->RemoveQuietly(obj);
+      fArena->fFree.push_back(obj);
+   } else if (obj->TestBit(TObject::kNotDeleted)) {
       // -- The TObject destructor has not been called.
-      cl->Destructor(obj);
+      fClass->Destructor(obj);
    } else {
       // -- The TObject destructor was called, just free memory.
       //
@@ -160,6 +297,7 @@ TClonesArray::TClonesArray() : TObjArray()
 {
    fClass      = 0;
    fKeep       = 0;
+   fArena      = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -175,6 +313,7 @@ TClonesArray::TClonesArray() : TObjArray()
 TClonesArray::TClonesArray(const char *classname, Int_t s, Bool_t) : TObjArray(s)
 {
    fKeep = 0;
+   fArena = 0;
    SetClass(classname,s);
 }
 
@@ -191,6 +330,7 @@ TClonesArray::TClonesArray(const char *classname, Int_t s, Bool_t) : TObjArray(s
 TClonesArray::TClonesArray(const TClass *cl, Int_t s, Bool_t) : TObjArray(s)
 {
    fKeep = 0;
+   fArena = 0;
    SetClass(cl,s);
 }
 
@@ -201,6 +341,9 @@ TClonesArray::TClonesArray(const TClonesArray& tc): TObjArray(tc)
 {
    fKeep = new TObjArray(tc.fSize);
    fClass = tc.fClass;
+   fArena = 0;
+   if (tc.IsArena())
+      SetArena();
 
    BypassStreamer(kTRUE);
 
@@ -229,7 +372,7 @@ TClonesArray& TClonesArray::operator=(const TClonesArray& tc)
 
    for (i = 0; i < fSize; i++)
       if (fKeep->fCont[i]) {
-         R__ReleaseMemory(fClass,fKeep->fCont[i]);
+         ReleaseMemory(fKeep->fCont[i]);
          fKeep->fCont[i] = nullptr;
          fCont[i] = nullptr;
       }
@@ -253,11 +396,12 @@ TClonesArray::~TClonesArray()
 {
    if (fKeep) {
       for (Int_t i = 0; i < fKeep->fSize; i++) {
-         R__ReleaseMemory(fClass,fKeep->fCont[i]);
+         ReleaseMemory(fKeep->fCont[i]);
          fKeep->fCont[i] = nullptr;
       }
    }
    SafeDelete(fKeep);
+   delete fArena;
 
    // Protect against erroneously setting of owner bit
    SetOwner(kFALSE);
@@ -460,7 +604,7 @@ void TClonesArray::Expand(Int_t newSize)
       // Expand() will shrink correctly
       for (int i = newSize; i < fSize; i++)
          if (fKeep->fCont[i]) {
-            R__ReleaseMemory(fClass,fKeep->fCont[i]);
+            ReleaseMemory(fKeep->fCont[i]);
             fKeep->fCont[i] = nullptr;
          }
    }
@@ -489,7 +633,7 @@ void TClonesArray::ExpandCreate(Int_t n)
    Int_t i;
    for (i = 0; i < n; i++) {
       if (!fKeep->fCont[i]) {
-         fKeep->fCont[i] = (TObject*)fClass->New();
+         fKeep->fCont[i] = CreateObject();
       } else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
          // The object has been deleted (or never initialized)
          fClass->New(fKeep->fCont[i]);
@@ -499,7 +643,7 @@ void TClonesArray::ExpandCreate(Int_t n)
 
    for (i = n; i < fSize; i++)
       if (fKeep->fCont[i]) {
-         R__ReleaseMemory(fClass,fKeep->fCont[i]);
+         ReleaseMemory(fKeep->fCont[i]);
          fKeep->fCont[i] = nullptr;
          fCont[i] = nullptr;
       }
@@ -526,7 +670,7 @@ void TClonesArray::ExpandCreateFast(Int_t n)
    Int_t i;
    for (i = 0; i < n; i++) {
       if (i >= oldSize || !fKeep->fCont[i]) {
-         fKeep->fCont[i] = (TObject*)fClass->New();
+         fKeep->fCont[i] = CreateObject();
       } else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
          // The object has been deleted (or never initialized)
          fClass->New(fKeep->fCont[i]);
@@ -654,6 +798,8 @@ void TClonesArray::SetClass(const TClass *cl, Int_t s)
    delete [] name;
 
    fKeep = new TObjArray(s);
+   if (fgDefaultArena)
+      SetArena();
 
    BypassStreamer(kTRUE);
 }
@@ -666,6 +812,35 @@ void TClonesArray::SetClass(const char *classname, Int_t s)
    SetClass(TClass::GetClass(classname),s);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate the new slots of the array from blocks owned by the array (arena
+/// mode) or, when arena is false, separately on the heap. The objects
+/// already in the array are not moved. The array must be initialized with
+/// a class. See TClonesArray::SetDefaultArena() for the arrays created by
+/// the I/O.
+
+void TClonesArray::SetArena(Bool_t arena)
+{
+   if (!fClass) {
+      Error("SetArena", "invalid class specified in TClonesArray ctor");
+      return;
+   }
+   if (!fArena) {
+      if (!arena)
+         return;
+      fArena = new TArena(fClass->Size());
+   }
+   fArena->fActive = arena;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether the new slots of the array are allocated in its arena.
+
+Bool_t TClonesArray::IsArena() const
+{
+   return fArena && fArena->fActive;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// A TClonesArray is always the owner of the object it contains.
@@ -747,6 +922,8 @@ void TClonesArray::Streamer(TBuffer &b)
       if (fClass == 0 && fKeep == 0) {
          fClass = cl;
          fKeep  = new TObjArray(fSize);
+         if (fgDefaultArena)
+            SetArena();
          Expand(nobjects);
       }
       if (cl != fClass) {
@@ -770,7 +947,7 @@ void TClonesArray::Streamer(TBuffer &b)
       if (CanBypassStreamer() && !b.TestBit(TBuffer::kCannotHandleMemberWiseStreaming)) {
          for (Int_t i = 0; i < nobjects; i++) {
             if (!fKeep->fCont[i]) {
-               fKeep->fCont[i] = (TObject*)fClass->New();
+               fKeep->fCont[i] = CreateObject();
             } else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
                // The object has been deleted (or never initialized)
                fClass->New(fKeep->fCont[i]);
@@ -786,7 +963,7 @@ void TClonesArray::Streamer(TBuffer &b)
             b >> nch;
             if (nch) {
                if (!fKeep->fCont[i])
-                  fKeep->fCont[i] = (TObject*)fClass->New();
+                  fKeep->fCont[i] = CreateObject();
                else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
                   // The object has been deleted (or never initialized)
                   fClass->New(fKeep->fCont[i]);
@@ -870,14 +1047,7 @@ TObject *&TClonesArray::operator[](Int_t idx)
       Expand(TMath::Max(idx+1, GrowBy(fSize)));
 
    if (!fKeep->fCont[idx]) {
-      fKeep->fCont[idx] = (TObject*) TStorage::ObjectAlloc(fClass->Size());
-      // Reset the bit so that:
-      //    obj = myClonesArray[i];
-      //    obj->TestBit(TObject::kNotDeleted)
-      // will behave correctly.
-      // TObject::kNotDeleted is one of the higher bit that is not settable via the public
-      // interface. But luckily we are its friend.
-      fKeep->fCont[idx]->fBits &= ~kNotDeleted;
+      fKeep->fCont[idx] = AllocateObject();
    }
    fCont[idx] = fKeep->fCont[idx];
 
@@ -969,11 +1139,20 @@ void TClonesArray::AbsorbObjects(TClonesArray *tc, Int_t idx1, Int_t idx2)
    if(newSize > fSize)
       Expand(newSize);
 
+   // our objects may now live in the arena of tc
+   if (tc->fArena) {
+      if (!fArena) {
+         SetArena();
+         fArena->fActive = kFALSE;
+      }
+      fArena->Share(*tc->fArena);
+   }
+
    // move
    for (Int_t i = idx1; i <= idx2; i++) {
       Int_t newindex = oldSize+i -idx1;
       fCont[newindex] = tc->fCont[i];
-      R__ReleaseMemory(fClass,fKeep->fCont[newindex]);
+      ReleaseMemory(fKeep->fCont[newindex]);
       (*fKeep)[newindex] = (*(tc->fKeep))[i];
       tc->fCont[i] = 0;
       (*(tc->fKeep))[i] = 0;
@@ -43,6 +43,7 @@ In a later release the collections may become templatized.
 #include "TVirtualMutex.h"
 #include "TError.h"
 #include "TSystem.h"
+#include "ROOT/StringUtils.hxx"
 #include <sstream>
 
 #include "TSpinLockGuard.h"
@@ -317,6 +318,17 @@ TObject *TCollection::FindObject(const char *name) const
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find an object in this collection using its name, given as a string_view.
+/// The name is copied to a buffer on the stack to be passed to
+/// FindObject(const char*), without any allocation for the usual names.
+
+TObject *TCollection::FindObject(std::string_view name) const
+{
+   ROOT::Internal::TNullTerminatedString cname(name);
+   return FindObject(cname.c_str());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Find an object in this collection by name.
 
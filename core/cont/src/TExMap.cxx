@@ -15,6 +15,13 @@ This class stores a (key,value) pair using an external hash.
 The (key,value) are Long64_t's and therefore can contain object
 pointers or any longs. The map uses an open addressing hashing
 method (linear probing).
+
+Delete() does not free the table. When only a few slots were filled since
+the previous Delete(), they are cleared one by one instead of clearing the
+whole table, so that the maps reused for each event, like the object maps
+of TBufferFile, are reset at a cost proportional to their use rather than
+to their capacity. Reserve() sizes the table beforehand for a number of
+entries, for instance the one seen in a previous event.
 */
 
 #include "TExMap.h"
@@ -45,6 +52,7 @@ TExMap::TExMap(Int_t mapSize)
 
    memset(fTable,0,sizeof(Assoc_t)*fSize);
    fTally = 0;
+   fLogged = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -56,6 +64,8 @@ TExMap::TExMap(const TExMap &map) : TObject(map)
    fTally = map.fTally;
    fTable = new Assoc_t [fSize];
    memcpy(fTable, map.fTable, fSize*sizeof(Assoc_t));
+   fLogged = map.fLogged;
+   memcpy(fLog, map.fLog, sizeof(fLog));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -65,10 +75,13 @@ TExMap& TExMap::operator=(const TExMap &map)
 {
    if (this != &map) {
       TObject::operator=(map);
+      delete [] fTable;
       fSize  = map.fSize;
       fTally = map.fTally;
       fTable = new Assoc_t [fSize];
       memcpy(fTable, map.fTable, fSize*sizeof(Assoc_t));
+      fLogged = map.fLogged;
+      memcpy(fLog, map.fLog, sizeof(fLog));
    }
    return *this;
 }
@@ -94,6 +107,7 @@ void TExMap::Add(ULong64_t hash, Long64_t key, Long64_t value)
       fTable[slot].fKey = key;
       fTable[slot].fValue = value;
       fTally++;
+      LogSlot(slot);
       if (HighWaterMark())
          Expand(2 * fSize);
    } else
@@ -122,6 +136,7 @@ void TExMap::AddAt(UInt_t slot, ULong64_t hash, Long64_t key, Long64_t value)
       fTable[slot].fKey = key;
       fTable[slot].fValue = value;
       fTally++;
+      LogSlot(slot);
       if (HighWaterMark())
          Expand(2 * fSize);
    } else {
@@ -149,6 +164,7 @@ Long64_t &TExMap::operator()(ULong64_t hash, Long64_t key)
       fTable[slot].fKey = key;
       fTable[slot].fValue = 0;
       fTally++;
+      LogSlot(slot);
       if (HighWaterMark()) {
          Expand(2 * fSize);
          slot = FindElement(hash, key);
@@ -158,12 +174,18 @@ Long64_t &TExMap::operator()(ULong64_t hash, Long64_t key)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Delete all entries stored in the TExMap.
+/// Delete all entries stored in the TExMap. The table is kept.
 
 void TExMap::Delete(Option_t *)
 {
-   memset(fTable,0,sizeof(Assoc_t)*fSize);
+   if (fLogged <= kLogSize) {
+      for (Int_t i = 0; i < fLogged; ++i)
+         fTable[fLog[i]].Clear();
+   } else {
+      memset(fTable,0,sizeof(Assoc_t)*fSize);
+   }
    fTally = 0;
+   fLogged = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -227,6 +249,8 @@ void TExMap::Remove(ULong64_t hash, Long64_t key)
    fTable[i].Clear();
    FixCollisions(i);
    fTally--;
+   // The entries moved by FixCollisions are not logged.
+   StopLogging();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -282,10 +306,8 @@ void TExMap::Expand(Int_t newSize)
    Int_t oldsize = fSize;
    newSize = (Int_t)TMath::NextPrime(newSize);
    fTable  = new Assoc_t [newSize];
-
-   for (i = newSize; --i >= 0;) {
-      fTable[i].Clear();
-   }
+   memset(fTable, 0, sizeof(Assoc_t)*newSize);
+   StopLogging();
 
    fSize = newSize;
    for (i = 0; i < oldsize; i++)
@@ -299,6 +321,18 @@ void TExMap::Expand(Int_t newSize)
    delete [] oldTable;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Make room for nentries entries, so that adding them does not expand the
+/// table.
+
+void TExMap::Reserve(Int_t nentries)
+{
+   // Expand() when the table is 3/4 full.
+   Int_t needed = (4 * nentries) / 3 + 2;
+   if (needed > fSize)
+      Expand(needed);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Stream all objects in the collection to or from the I/O buffer.
 
@@ -19,6 +19,17 @@ Hash() as it sees fit.
 THashTable does not preserve the insertion order of the objects.
 If the insertion order is important AND fast retrieval is needed
 use THashList instead.
+
+The table uses open addressing. Each slot stores the hash value of its
+objects next to the object itself, so that adding an object does not
+allocate anything, and a lookup compares the hash values before calling
+any member of the objects. A separate array keeps 7 bits of the hash of
+each slot; the probing compares them 16 at a time (with SSE2 where
+available). The objects sharing a hash value, e.g. the cycles of a key
+in a TDirectory, are kept in a TList, in the order given by Add() and
+AddBefore(); this list is what GetListForObject() returns. The table
+grows by itself when 7/8 of its slots are used: the rehash level is
+kept for backward compatibility only.
 */
 
 #include "THashTable.h"
@@ -27,18 +38,96 @@ use THashList instead.
 #include "TError.h"
 #include "TROOT.h"
 
+#include <cstring>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 ClassImp(THashTable);
 
+namespace {
+
+// Spread the bits of the hash values, which are often small or aligned numbers.
+inline ULong64_t MixHash(ULong_t hash)
+{
+   ULong64_t mixed = (ULong64_t)hash * 0x9E3779B97F4A7C15ULL;
+   return mixed ^ (mixed >> 32);
+}
+
+inline UInt_t TrailingZeros(UInt_t mask)
+{
+#if defined(__GNUC__)
+   return __builtin_ctz(mask);
+#else
+   UInt_t n = 0;
+   for (; !(mask & 1); mask >>= 1)
+      ++n;
+   return n;
+#endif
+}
+
+inline UInt_t LeadingZeros16(UInt_t mask)
+{
+   UInt_t n = 0;
+   for (UInt_t bit = 1 << 15; bit && !(mask & bit); bit >>= 1)
+      ++n;
+   return n;
+}
+
+// The control bytes of 16 consecutive slots; each match returns a mask
+// with one bit per matching slot.
+class TGroup {
+#ifdef __SSE2__
+   __m128i fCtrl;
+
+public:
+   TGroup(const UChar_t *ctrl) : fCtrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+   UInt_t Match(UChar_t ctrl) const { return _mm_movemask_epi8(_mm_cmpeq_epi8(fCtrl, _mm_set1_epi8((char)ctrl))); }
+   // Empty and deleted slots have the high bit set.
+   UInt_t MatchFree() const { return _mm_movemask_epi8(fCtrl); }
+#else
+   const UChar_t *fCtrl;
+
+public:
+   TGroup(const UChar_t *ctrl) : fCtrl(ctrl) {}
+   UInt_t Match(UChar_t ctrl) const
+   {
+      UInt_t mask = 0;
+      for (Int_t i = 0; i < 16; ++i)
+         mask |= UInt_t(fCtrl[i] == ctrl) << i;
+      return mask;
+   }
+   UInt_t MatchFree() const
+   {
+      UInt_t mask = 0;
+      for (Int_t i = 0; i < 16; ++i)
+         mask |= UInt_t(fCtrl[i] >> 7) << i;
+      return mask;
+   }
+#endif
+};
+
+// Number of slots for nentries objects: a power of 2, filled at most to 7/8.
+Int_t SlotsFor(Int_t nentries)
+{
+   Int_t nslots = 16;
+   while (nslots / 8 * 7 < nentries)
+      nslots *= 2;
+   return nslots;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create a THashTable object. Capacity is the initial hashtable capacity
-/// (i.e. number of slots), by default kInitHashTableCapacity = 17, and
-/// rehashlevel is the value at which a rehash will be triggered. I.e. when
-/// the average size of the linked lists at a slot becomes longer than
-/// rehashlevel then the hashtable will be resized and refilled to reduce
-/// the collision rate to about 1. The higher the collision rate, i.e. the
-/// longer the linked lists, the longer lookup will take. If rehashlevel=0
-/// the table will NOT automatically be rehashed. Use Rehash() for manual
-/// rehashing.
+/// (i.e. number of objects it holds before growing), by default
+/// kInitHashTableCapacity = 17. The slots are allocated by the first
+/// insertion. The table grows by itself when needed: rehashlevel is only
+/// kept for backward compatibility and returned by GetRehashLevel(). Use
+/// Rehash() to resize the table or to recompute the hash values of the
+/// objects.
 
 THashTable::THashTable(Int_t capacity, Int_t rehashlevel)
 {
@@ -48,12 +137,13 @@ THashTable::THashTable(Int_t capacity, Int_t rehashlevel)
    } else if (capacity == 0)
       capacity = TCollection::kInitHashTableCapacity;
 
-   fSize = (Int_t)TMath::NextPrime(TMath::Max(capacity,(int)TCollection::kInitHashTableCapacity));
-   fCont = new TList* [fSize];
-   memset(fCont, 0, fSize*sizeof(TList*));
+   fSize  = SlotsFor(capacity);
+   fCtrl  = 0;
+   fSlots = 0;
 
-   fEntries   = 0;
-   fUsedSlots = 0;
+   fEntries      = 0;
+   fUsedSlots    = 0;
+   fDeletedSlots = 0;
    if (rehashlevel < 2) rehashlevel = 0;
    fRehashLevel = rehashlevel;
 }
@@ -64,24 +154,208 @@ THashTable::THashTable(Int_t capacity, Int_t rehashlevel)
 
 THashTable::~THashTable()
 {
-   if (fCont) Clear();
-   delete [] fCont;
-   fCont = 0;
-   fSize = 0;
+   if (fCtrl) Clear();
+   delete [] fCtrl;
+   delete [] fSlots;
+   fCtrl  = 0;
+   fSlots = 0;
+   fSize  = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Helper function doing the actual add to the table give a slot and object.
+/// Return the slot of the objects with this hash value, or -1.
 /// This does not take any lock.
 
+Int_t THashTable::FindSlot(ULong_t hash) const
+{
+   if (!fCtrl) return -1;
+
+   const ULong64_t mixed = MixHash(hash);
+   const UChar_t h2 = mixed & 0x7F;
+   const UInt_t mask = fSize - 1;
+   UInt_t pos = (mixed >> 7) & mask;
+   for (UInt_t step = kGroupWidth; ; pos = (pos + step) & mask, step += kGroupWidth) {
+      TGroup group(fCtrl + pos);
+      for (UInt_t match = group.Match(h2); match; match &= match - 1) {
+         const Int_t slot = (pos + TrailingZeros(match)) & mask;
+         if (fSlots[slot].fHash == hash) return slot;
+      }
+      if (group.Match(kSlotEmpty)) return -1;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the first empty or deleted slot of the probing sequence of hash.
+/// The table must have been allocated and must not contain hash.
+
+Int_t THashTable::FindFreeSlot(ULong_t hash) const
+{
+   const ULong64_t mixed = MixHash(hash);
+   const UInt_t mask = fSize - 1;
+   UInt_t pos = (mixed >> 7) & mask;
+   for (UInt_t step = kGroupWidth; ; pos = (pos + step) & mask, step += kGroupWidth) {
+      if (UInt_t match = TGroup(fCtrl + pos).MatchFree())
+         return (pos + TrailingZeros(match)) & mask;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the control byte of a slot. The bytes of the first slots are repeated
+/// after the last one, so that a group can be read from any position.
+
 inline
-void THashTable::AddImpl(Int_t slot, TObject *obj)
+void THashTable::SetCtrl(Int_t slot, UChar_t ctrl)
+{
+   fCtrl[slot] = ctrl;
+   if (slot < kGroupWidth)
+      fCtrl[fSize + slot] = ctrl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the slots, which must be empty, by nslots empty ones.
+
+void THashTable::Allocate(Int_t nslots)
+{
+   delete [] fCtrl;
+   delete [] fSlots;
+   fSize  = nslots;
+   fCtrl  = new UChar_t[fSize + kGroupWidth];
+   memset(fCtrl, kSlotEmpty, fSize + kGroupWidth);
+   fSlots = new TSlot[fSize];
+   fUsedSlots    = 0;
+   fDeletedSlots = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move the slots into a table sized for nentries hash values. The stored
+/// hash values are used, and the lists of the slots are kept.
+
+void THashTable::Grow(Int_t nentries)
+{
+   UChar_t *oldCtrl  = fCtrl;
+   TSlot   *oldSlots = fSlots;
+   const Int_t oldSize = fSize;
+   fCtrl  = 0;
+   fSlots = 0;
+   Allocate(SlotsFor(TMath::Max(nentries, fUsedSlots + 1)));
+
+   for (Int_t i = 0; i < oldSize; i++) {
+      if (!IsFull(oldCtrl[i])) continue;
+      const Int_t slot = FindFreeSlot(oldSlots[i].fHash);
+      SetCtrl(slot, MixHash(oldSlots[i].fHash) & 0x7F);
+      fSlots[slot] = oldSlots[i];
+      ++fUsedSlots;
+   }
+   delete [] oldCtrl;
+   delete [] oldSlots;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release a slot whose objects have been removed. The slot becomes empty
+/// if no probing sequence can have gone through it.
+
+void THashTable::FreeSlot(Int_t slot)
+{
+   delete fSlots[slot].fList;
+   fSlots[slot].fList   = 0;
+   fSlots[slot].fObject = 0;
+
+   const UInt_t mask = fSize - 1;
+   const UInt_t emptyAfter  = TGroup(fCtrl + slot).Match(kSlotEmpty);
+   const UInt_t emptyBefore = TGroup(fCtrl + ((slot - kGroupWidth) & mask)).Match(kSlotEmpty);
+   if (emptyAfter && emptyBefore && TrailingZeros(emptyAfter) + LeadingZeros16(emptyBefore) < kGroupWidth) {
+      SetCtrl(slot, kSlotEmpty);
+   } else {
+      SetCtrl(slot, kSlotDeleted);
+      ++fDeletedSlots;
+   }
+   --fUsedSlots;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Empty all the slots, without touching the objects.
+
+void THashTable::ResetSlots()
+{
+   if (fCtrl) {
+      for (Int_t i = 0; i < fSize; i++)
+         if (IsFull(fCtrl[i]))
+            delete fSlots[i].fList;
+      memset(fCtrl, kSlotEmpty, fSize + kGroupWidth);
+   }
+   fEntries      = 0;
+   fUsedSlots    = 0;
+   fDeletedSlots = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of the objects of a used slot, creating it if the slot
+/// holds a single object, or 0 if slot is -1. The caller holds the write lock.
+
+TList *THashTable::MakeList(Int_t slot) const
+{
+   if (slot < 0) return 0;
+
+   TSlot &s = fSlots[slot];
+   if (!s.fList) {
+      TList *list = new TList;
+      list->Add(s.fObject);
+      s.fObject = 0;
+      s.fList = list;
+   }
+   return s.fList;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of the objects with the given hash value, or 0 if there
+/// are none. The list is only created, under the write lock, if the slot
+/// still holds a single object; the read lock is released before, as it
+/// cannot be upgraded.
+
+const TList *THashTable::GetListForHash(ULong_t hash) const
+{
+   {
+      R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
+
+      const Int_t slot = FindSlot(hash);
+      if (slot < 0) return 0;
+      if (fSlots[slot].fList) return fSlots[slot].fList;
+   }
+
+   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+
+   // The table may have changed since the read lock was released.
+   return MakeList(FindSlot(hash));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Helper function doing the actual add to the table given the hash value
+/// of the object. If before has the same hash value, obj is added in front
+/// of it. This does not take any lock.
+
+void THashTable::AddImpl(ULong_t hash, TObject *obj, const TObject *before)
 {
-   if (!fCont[slot]) {
-      fCont[slot] = new TList;
+   Int_t slot = FindSlot(hash);
+   if (slot >= 0) {
+      TList *list = MakeList(slot);
+      if (before && before->Hash() == hash)
+         list->AddBefore(before, obj);
+      else
+         list->Add(obj);
+   } else {
+      if (!fCtrl)
+         Allocate(fSize);
+      else if (8 * (fUsedSlots + fDeletedSlots + 1) > 7 * fSize)
+         Grow(2 * (fUsedSlots + 1));
+      slot = FindFreeSlot(hash);
+      if (fCtrl[slot] == kSlotDeleted)
+         --fDeletedSlots;
+      SetCtrl(slot, MixHash(hash) & 0x7F);
+      fSlots[slot].fHash   = hash;
+      fSlots[slot].fObject = obj;
+      fSlots[slot].fList   = 0;
       ++fUsedSlots;
    }
-   fCont[slot]->Add(obj);
    ++fEntries;
 }
 
@@ -93,42 +367,28 @@ void THashTable::Add(TObject *obj)
 {
    if (IsArgNull("Add", obj)) return;
 
-   Int_t slot = GetCheckedHashValue(obj);
+   const ULong_t hash = obj->CheckedHash();
 
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   AddImpl(slot,obj);
-
-   if (fRehashLevel && AverageCollisions() > fRehashLevel)
-      Rehash(fEntries);
+   AddImpl(hash, obj, 0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Add object to the hash table. Its position in the table will be
 /// determined by the value returned by its Hash() function.
-/// If and only if 'before' is in the same bucket as obj, obj is added
-/// in front of 'before' within the bucket's list.
+/// If and only if 'before' has the same hash value as obj, obj is added
+/// in front of 'before' within the list of the objects with this hash.
 
 void THashTable::AddBefore(const TObject *before, TObject *obj)
 {
    if (IsArgNull("Add", obj)) return;
 
-   Int_t slot = GetCheckedHashValue(obj);
+   const ULong_t hash = obj->CheckedHash();
 
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
-   if (!fCont[slot]) {
-      fCont[slot] = new TList;
-      fUsedSlots++;
-   }
-   if (before && GetHashValue(before) == slot) {
-      fCont[slot]->AddBefore(before,obj);
-   } else {
-      fCont[slot]->Add(obj);
-   }
-   fEntries++;
 
-   if (fRehashLevel && AverageCollisions() > fRehashLevel)
-      Rehash(fEntries);
+   AddImpl(hash, obj, before);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -139,25 +399,17 @@ void THashTable::AddAll(const TCollection *col)
 {
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   // Hashing after AddAll can be much more expensive than
-   // hashing before, as we need to add more elements.
-   // We assume an ideal hash, i.e. fUsedSlots==fSize.
-   Int_t sumEntries=fEntries+col->GetEntries();
-   Bool_t rehashBefore=fRehashLevel && (sumEntries > fSize*fRehashLevel);
-   if (rehashBefore)
-      Rehash(sumEntries);
-
-   // prevent Add from Rehashing
-   Int_t saveRehashLevel=fRehashLevel;
-   fRehashLevel=0;
+   // Grow once for all the new objects, assuming that their hash values
+   // are all different.
+   const Int_t sumEntries = fUsedSlots + col->GetEntries();
+   if (sumEntries > fSize / 8 * 7) {
+      if (fCtrl)
+         Grow(sumEntries);
+      else
+         fSize = SlotsFor(sumEntries);
+   }
 
    TCollection::AddAll(col);
-
-   fRehashLevel=saveRehashLevel;
-   // If we didn't Rehash before, we might have to do it
-   // now, due to a non-perfect hash function.
-   if (!rehashBefore && fRehashLevel && AverageCollisions() > fRehashLevel)
-      Rehash(fEntries);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -168,50 +420,60 @@ void THashTable::Clear(Option_t *option)
 {
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   for (int i = 0; i < fSize; i++) {
-      // option "nodelete" is passed when Clear is called from
-      // THashList::Clear() or THashList::Delete() or Rehash().
-      if (fCont[i]) {
-         if (IsOwner())
-            fCont[i]->SetOwner();
-         fCont[i]->Clear(option);
-      }
-      SafeDelete(fCont[i]);
+   // option "nodelete" is passed when Clear is called from
+   // THashList::Clear() or THashList::Delete() or Rehash().
+   if ((option && !strcmp(option, "nodelete")) || !fEntries) {
+      ResetSlots();
+      return;
+   }
+
+   // The objects are given to a TList, which deletes those it has to, once
+   // the table is empty: they may remove themselves from it.
+   TList objects;
+   for (Int_t i = 0; i < fSize; i++) {
+      if (!IsFull(fCtrl[i])) continue;
+      if (fSlots[i].fList)
+         objects.AddAll(fSlots[i].fList);
+      else
+         objects.Add(fSlots[i].fObject);
    }
+   ResetSlots();
 
-   fEntries   = 0;
-   fUsedSlots = 0;
+   if (IsOwner())
+      objects.SetOwner();
+   objects.Clear(option);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of collisions for an object with a certain name
-/// (i.e. number of objects in same slot in the hash table, i.e. length
-/// of linked list).
+/// (i.e. number of objects with the same hash value).
 
 Int_t THashTable::Collisions(const char *name) const
 {
-   Int_t slot = GetHashValue(name);
+   const ULong_t hash = ::Hash(name);
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   if (fCont[slot]) return fCont[slot]->GetSize();
-   return 0;
+   const Int_t slot = FindSlot(hash);
+   if (slot < 0) return 0;
+   return fSlots[slot].fList ? fSlots[slot].fList->GetSize() : 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of collisions for an object (i.e. number of objects
-/// in same slot in the hash table, i.e. length of linked list).
+/// with the same hash value).
 
 Int_t THashTable::Collisions(TObject *obj) const
 {
    if (IsArgNull("Collisions", obj)) return 0;
 
-   Int_t slot = GetHashValue(obj);
+   const ULong_t hash = obj->Hash();
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   if (fCont[slot]) return fCont[slot]->GetSize();
-   return 0;
+   const Int_t slot = FindSlot(hash);
+   if (slot < 0) return 0;
+   return fSlots[slot].fList ? fSlots[slot].fList->GetSize() : 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -221,14 +483,22 @@ void THashTable::Delete(Option_t *)
 {
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   for (int i = 0; i < fSize; i++)
-      if (fCont[i]) {
-         fCont[i]->Delete();
-         SafeDelete(fCont[i]);
-      }
+   if (!fEntries) {
+      ResetSlots();
+      return;
+   }
 
-   fEntries   = 0;
-   fUsedSlots = 0;
+   TList objects;
+   for (Int_t i = 0; i < fSize; i++) {
+      if (!IsFull(fCtrl[i])) continue;
+      if (fSlots[i].fList)
+         objects.AddAll(fSlots[i].fList);
+      else
+         objects.Add(fSlots[i].fObject);
+   }
+   ResetSlots();
+
+   objects.Delete();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -237,11 +507,17 @@ void THashTable::Delete(Option_t *)
 
 TObject *THashTable::FindObject(const char *name) const
 {
-   Int_t slot = GetHashValue(name);
+   const ULong_t hash = ::Hash(name);
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   if (fCont[slot]) return fCont[slot]->FindObject(name);
+   const Int_t slot = FindSlot(hash);
+   if (slot < 0) return 0;
+   if (fSlots[slot].fList) return fSlots[slot].fList->FindObject(name);
+
+   TObject *obj = fSlots[slot].fObject;
+   const char *objname = obj->GetName();
+   if (objname && !strcmp(name, objname)) return obj;
    return 0;
 }
 
@@ -252,27 +528,28 @@ TObject *THashTable::FindObject(const TObject *obj) const
 {
    if (IsArgNull("FindObject", obj)) return 0;
 
-   Int_t slot = GetHashValue(obj);
-   if (fCont[slot]) return fCont[slot]->FindObject(obj);
+   const Int_t slot = FindSlot(obj->Hash());
+   if (slot < 0) return 0;
+   if (fSlots[slot].fList) return fSlots[slot].fList->FindObject(obj);
+
+   TObject *ob = fSlots[slot].fObject;
+   if (ob->IsEqual(obj)) return ob;
    return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Return the TList corresponding to object's name based hash value.
+/// Return the TList of the objects with the same hash value as name.
 /// One can iterate this list "manually" to find, e.g. objects with
-/// the same name.
+/// the same name. The list stays valid until all these objects are removed
+/// or the table is rehashed, cleared or deleted.
 
 const TList *THashTable::GetListForObject(const char *name) const
 {
-   Int_t slot = GetHashValue(name);
-
-   R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
-
-   return fCont[slot];
+   return GetListForHash(::Hash(name));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Return the TList corresponding to object's hash value.
+/// Return the TList of the objects with the same hash value as obj.
 /// One can iterate this list "manually" to find, e.g. identical
 /// objects.
 
@@ -280,11 +557,7 @@ const TList *THashTable::GetListForObject(const TObject *obj) const
 {
    if (IsArgNull("GetListForObject", obj)) return 0;
 
-   Int_t slot = GetHashValue(obj);
-
-   R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
-
-   return fCont[slot];
+   return GetListForHash(obj->Hash());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -294,11 +567,14 @@ TObject **THashTable::GetObjectRef(const TObject *obj) const
 {
    if (IsArgNull("GetObjectRef", obj)) return 0;
 
-   Int_t slot = GetHashValue(obj);
+   const ULong_t hash = obj->Hash();
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   if (fCont[slot]) return fCont[slot]->GetObjectRef(obj);
+   const Int_t slot = FindSlot(hash);
+   if (slot < 0) return 0;
+   if (fSlots[slot].fList) return fSlots[slot].fList->GetObjectRef(obj);
+   if (fSlots[slot].fObject->IsEqual(obj)) return &fSlots[slot].fObject;
    return 0;
 }
 
@@ -337,9 +613,14 @@ void THashTable::Print(Option_t *option, Int_t recurse) const
       for (Int_t cursor = 0; cursor < Capacity();
            cursor++) {
          printf("Slot #%d:\n",cursor);
-         if (fCont[cursor])
-            fCont[cursor]->Print();
-         else {
+         if (fCtrl && IsFull(fCtrl[cursor])) {
+            if (fSlots[cursor].fList)
+               fSlots[cursor].fList->Print();
+            else {
+               TROOT::IndentLevel();
+               fSlots[cursor].fObject->Print();
+            }
+         } else {
             TROOT::IndentLevel();
             printf("empty\n");
          }
@@ -350,36 +631,45 @@ void THashTable::Print(Option_t *option, Int_t recurse) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Rehash the hashtable. If the collision rate becomes too high (i.e.
-/// the average size of the linked lists become too long) then lookup
-/// efficiency decreases since relatively long lists have to be searched
-/// every time. To improve performance rehash the hashtable. This resizes
-/// the table to newCapacity slots and refills the table. Use
-/// AverageCollisions() to check if you need to rehash. Set checkObjValidity
+/// Rehash the hashtable. This resizes the table to hold newCapacity objects
+/// and refills it, recomputing the hash values of the objects, e.g. after
+/// some of them have been renamed. The table grows by itself when it fills
+/// up: there is no need to rehash it for efficiency. Set checkObjValidity
 /// to kFALSE if you know that all objects in the table are still valid
 /// (i.e. have not been deleted from the system in the meanwhile).
 
 void THashTable::Rehash(Int_t newCapacity, Bool_t checkObjValidity)
 {
-   THashTable *ht = new THashTable(newCapacity);
-
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   TIter next(this);
-   TObject *obj;
-
-   auto initialSize = GetEntries();
+   std::vector<TObject *> objects;
+   objects.reserve(fEntries);
+   for (Int_t i = 0; fCtrl && i < fSize; i++) {
+      if (!IsFull(fCtrl[i])) continue;
+      if (fSlots[i].fList) {
+         for (TObjLink *lnk = fSlots[i].fList->FirstLink(); lnk; lnk = lnk->Next())
+            objects.push_back(lnk->GetObject());
+      } else
+         objects.push_back(fSlots[i].fObject);
+   }
 
-   if (checkObjValidity && TObject::GetObjectStat() && gObjectTable) {
-      while ((obj = next()))
-         if (gObjectTable->PtrIsValid(obj))
-            ht->AddImpl(ht->GetHashValue(obj),obj);
-   } else {
-      while ((obj = next()))
-         ht->AddImpl(ht->GetHashValue(obj),obj);
+   ResetSlots();
+   delete [] fCtrl;
+   delete [] fSlots;
+   fCtrl  = 0;
+   fSlots = 0;
+   fSize  = SlotsFor(TMath::Max(newCapacity, (Int_t)objects.size()));
+
+   const Bool_t check = checkObjValidity && TObject::GetObjectStat() && gObjectTable;
+   Int_t nadded = 0;
+   for (TObject *obj : objects) {
+      if (check && !gObjectTable->PtrIsValid(obj))
+         continue;
+      AddImpl(obj->Hash(), obj, 0);
+      ++nadded;
    }
 
-   if (initialSize != GetEntries()) {
+   if (nadded != GetEntries()) {
       // Somehow in the process of copy the pointer from one hash to
       // other we ended up inducing the addition of more element to
       // the table.  Most likely those elements have not been copied ....
@@ -387,25 +677,9 @@ void THashTable::Rehash(Int_t newCapacity, Bool_t checkObjValidity)
 
       Fatal("Rehash",
             "During the rehash of %p one or more element was added or removed. The initalize size was %d and now it is %d",
-            this, initialSize, GetEntries());
+            this, nadded, GetEntries());
 
    }
-
-   Clear("nodelete");
-   delete [] fCont;
-   fCont = ht->fCont;
-   ht->fCont = 0;
-
-   fSize      = ht->fSize;     // idem
-   fEntries   = ht->fEntries;
-   fUsedSlots = ht->fUsedSlots;
-
-   // this should not happen, but it will prevent an endless loop
-   // in case of a very bad hash function
-   if (fRehashLevel && AverageCollisions() > fRehashLevel)
-      fRehashLevel = (int)AverageCollisions() + 1;
-
-   delete ht;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -413,24 +687,29 @@ void THashTable::Rehash(Int_t newCapacity, Bool_t checkObjValidity)
 
 TObject *THashTable::Remove(TObject *obj)
 {
-   Int_t slot = GetHashValue(obj);
+   if (!obj) return 0;
+
+   const ULong_t hash = obj->Hash();
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   if (fCont[slot]) {
-      R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   const Int_t slot = FindSlot(hash);
+   if (slot < 0) return 0;
 
-      TObject *ob = fCont[slot]->Remove(obj);
-      if (ob) {
-         fEntries--;
-         if (fCont[slot]->GetSize() == 0) {
-            SafeDelete(fCont[slot]);
-            fUsedSlots--;
-         }
-         return ob;
-      }
+   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+
+   TSlot &s = fSlots[slot];
+   TObject *ob = 0;
+   if (s.fList) {
+      ob = s.fList->Remove(obj);
+      if (ob && s.fList->GetSize() == 0)
+         FreeSlot(slot);
+   } else if (s.fObject->TestBit(kNotDeleted) && s.fObject->IsEqual(obj)) {
+      ob = s.fObject;
+      FreeSlot(slot);
    }
-   return 0;
+   if (ob) fEntries--;
+   return ob;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -441,17 +720,21 @@ TObject *THashTable::RemoveSlow(TObject *obj)
 
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   for (int i = 0; i < fSize; i++) {
-      if (fCont[i]) {
-         TObject *ob = fCont[i]->Remove(obj);
-         if (ob) {
-            fEntries--;
-            if (fCont[i]->GetSize() == 0) {
-               SafeDelete(fCont[i]);
-               fUsedSlots--;
-            }
-            return ob;
-         }
+   for (int i = 0; fCtrl && i < fSize; i++) {
+      if (!IsFull(fCtrl[i])) continue;
+      TSlot &s = fSlots[i];
+      TObject *ob = 0;
+      if (s.fList) {
+         ob = s.fList->Remove(obj);
+         if (ob && s.fList->GetSize() == 0)
+            FreeSlot(i);
+      } else if (s.fObject->TestBit(kNotDeleted) && s.fObject->IsEqual(obj)) {
+         ob = s.fObject;
+         FreeSlot(i);
+      }
+      if (ob) {
+         fEntries--;
+         return ob;
       }
    }
    return 0;
@@ -472,6 +755,7 @@ THashTableIter::THashTableIter(const THashTable *ht, Bool_t dir)
    fTable      = ht;
    fDirection  = dir;
    fListCursor = 0;
+   fCurrent    = 0;
    Reset();
 }
 
@@ -483,6 +767,7 @@ THashTableIter::THashTableIter(const THashTableIter &iter) : TIterator(iter)
    fTable      = iter.fTable;
    fDirection  = iter.fDirection;
    fCursor     = iter.fCursor;
+   fCurrent    = iter.fCurrent;
    fListCursor = 0;
    if (iter.fListCursor) {
       fListCursor = (TListIter *)iter.fListCursor->GetCollection()->MakeIterator();
@@ -501,6 +786,8 @@ TIterator &THashTableIter::operator=(const TIterator &rhs)
       fTable     = rhs1.fTable;
       fDirection = rhs1.fDirection;
       fCursor    = rhs1.fCursor;
+      fCurrent   = rhs1.fCurrent;
+      SafeDelete(fListCursor);
       if (rhs1.fListCursor) {
          // R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -521,6 +808,8 @@ THashTableIter &THashTableIter::operator=(const THashTableIter &rhs)
       fTable     = rhs.fTable;
       fDirection = rhs.fDirection;
       fCursor    = rhs.fCursor;
+      fCurrent   = rhs.fCurrent;
+      SafeDelete(fListCursor);
       if (rhs.fListCursor) {
          // R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -548,35 +837,40 @@ TObject *THashTableIter::Next()
    // R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
    while (kTRUE) {
-      if (!fListCursor) {
-         int slot = NextSlot();
-         if (slot == -1) return 0;
-         fListCursor = new TListIter(fTable->fCont[slot], fDirection);
+      if (fListCursor) {
+         fCurrent = fListCursor->Next();
+         if (fCurrent) return fCurrent;
+         SafeDelete(fListCursor);
       }
 
-      TObject *obj = fListCursor->Next();
-      if (obj) return obj;
+      int slot = NextSlot();
+      if (slot == -1) return fCurrent = 0;
 
-      SafeDelete(fListCursor);
+      // Only the objects sharing a hash value need a list iterator.
+      const THashTable::TSlot &s = fTable->fSlots[slot];
+      if (!s.fList) return fCurrent = s.fObject;
+      fListCursor = new TListIter(s.fList, fDirection);
    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Returns index of next slot in table containing list to be iterated.
+/// Returns index of next used slot in table.
 
 Int_t THashTableIter::NextSlot()
 {
    // R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
+   if (!fTable->fCtrl) return -1;
+
    if (fDirection == kIterForward) {
-      for ( ; fCursor < fTable->Capacity() && fTable->fCont[fCursor] == 0;
+      for ( ; fCursor < fTable->Capacity() && !THashTable::IsFull(fTable->fCtrl[fCursor]);
               fCursor++) { }
 
       if (fCursor < fTable->Capacity())
          return fCursor++;
 
    } else {
-      for ( ; fCursor >= 0 && fTable->fCont[fCursor] == 0;
+      for ( ; fCursor >= 0 && !THashTable::IsFull(fTable->fCtrl[fCursor]);
               fCursor--) { }
 
       if (fCursor >= 0)
@@ -596,6 +890,7 @@ void THashTableIter::Reset()
    else
       fCursor = fTable->Capacity() - 1;
    SafeDelete(fListCursor);
+   fCurrent = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -605,7 +900,7 @@ Bool_t THashTableIter::operator!=(const TIterator &aIter) const
 {
    if (aIter.IsA() == THashTableIter::Class()) {
       const THashTableIter &iter(dynamic_cast<const THashTableIter &>(aIter));
-      return (fListCursor != iter.fListCursor);
+      return (fCurrent != iter.fCurrent);
    }
    return false; // for base class we don't implement a comparison
 }
@@ -615,7 +910,7 @@ Bool_t THashTableIter::operator!=(const TIterator &aIter) const
 
 Bool_t THashTableIter::operator!=(const THashTableIter &aIter) const
 {
-   return (fListCursor != aIter.fListCursor);
+   return (fCurrent != aIter.fCurrent);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -623,5 +918,5 @@ Bool_t THashTableIter::operator!=(const THashTableIter &aIter) const
 
 TObject *THashTableIter::operator*() const
 {
-   return (fListCursor ? fListCursor->operator*() : nullptr);
+   return fCurrent;
 }
@@ -50,7 +50,8 @@ ClassImp(TRefTable);
 /// Default constructor for I/O.
 
 TRefTable::TRefTable() : fNumPIDs(0), fAllocSize(0), fN(0), fParentIDs(0), fParentID(-1),
-                         fDefaultSize(10), fUID(0), fUIDContext(0), fSize(0), fParents(0), fOwner(0)
+                         fDefaultSize(10), fUID(0), fUIDContext(0), fSize(0), fParents(0), fOwner(0),
+                         fEntryParentsValid(kFALSE)
 {
    fgRefTable   = this;
 }
@@ -60,7 +61,8 @@ TRefTable::TRefTable() : fNumPIDs(0), fAllocSize(0), fN(0), fParentIDs(0), fPare
 
 TRefTable::TRefTable(TObject *owner, Int_t size) :
      fNumPIDs(0), fAllocSize(0), fN(0), fParentIDs(0), fParentID(-1),
-     fDefaultSize(size<10 ? 10 : size), fUID(0), fUIDContext(0), fSize(0), fParents(new TObjArray(1)), fOwner(owner)
+     fDefaultSize(size<10 ? 10 : size), fUID(0), fUIDContext(0), fSize(0), fParents(new TObjArray(1)), fOwner(owner),
+     fEntryParentsValid(kFALSE)
 {
    fgRefTable   = this;
 }
@@ -109,6 +111,7 @@ Int_t TRefTable::Add(Int_t uid, TProcessID *context)
    }
    fParentIDs[iid][uid] = fParentID + 1;
    if (uid >= fN[iid]) fN[iid] = uid + 1;
+   fEntryParentsValid = kFALSE;
    return uid;
 }
 
@@ -149,6 +152,7 @@ void TRefTable::Clear(Option_t * /*option*/ )
    }
    memset(fN, 0, sizeof(Int_t) * fNumPIDs);
    fParentID = -1;
+   fEntryParentsValid = kFALSE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -262,6 +266,32 @@ TObject *TRefTable::GetParent(Int_t uid, TProcessID *context /* =0 */ ) const
    return fParents->UncheckedAt(pnumber);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the indices in GetParents() of the parents holding the objects
+/// referenced by the current entry, in increasing order. This allows to
+/// load all of them at once, see TBranchRef::SetReadAllParents.
+
+const std::vector<Int_t> &TRefTable::GetEntryParents()
+{
+   if (fEntryParentsValid) return fEntryParents;
+   fEntryParents.clear();
+   fEntryParentsValid = kTRUE;
+   Int_t nparents = fParents ? fParents->GetEntriesFast() : 0;
+   if (!nparents) return fEntryParents;
+   std::vector<char> used(nparents, 0);
+   for (Int_t iid = 0; iid < fNumPIDs; ++iid) {
+      const Int_t *ids = fParentIDs[iid];
+      for (Int_t uid = 0; uid < fN[iid]; ++uid) {
+         Int_t pnumber = ids[uid] - 1;
+         if (pnumber >= 0 && pnumber < nparents) used[pnumber] = 1;
+      }
+   }
+   for (Int_t pnumber = 0; pnumber < nparents; ++pnumber) {
+      if (used[pnumber]) fEntryParents.push_back(pnumber);
+   }
+   return fEntryParents;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get the index for fProcessIDs, fAllocSize, etc given a PID.
 /// Uses fMapPIDtoInternal and the pid's GUID / fProcessGUID
@@ -332,11 +362,15 @@ void TRefTable::ReadBuffer(TBuffer &b)
       Int_t newN = 0;
       if (firstInt < 0) b >> newN;
       else newN = firstInt;
-      if (newN > fAllocSize[iid])
+      if (newN > fAllocSize[iid]) {
+         // The previous content is overwritten: do not copy it.
+         ExpandForIID(iid, 0);
          ExpandForIID(iid, newN + newN / 2);
+      }
       fN[iid] = newN;
       b.ReadFastArray(fParentIDs[iid], fN[iid]);
    }
+   fEntryParentsValid = kFALSE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,92 @@
+#include "TBits.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+// Reference implementation, bit by bit.
+UInt_t CountSlow(const TBits &bits, UInt_t start)
+{
+   UInt_t count = 0;
+   for (UInt_t i = start; i < bits.GetNbits(); ++i)
+      count += bits.TestBitNumber(i);
+   return count;
+}
+
+TBits MakeBits(UInt_t nbits, UInt_t step, UInt_t offset)
+{
+   TBits bits(nbits);
+   for (UInt_t i = offset; i < nbits; i += step)
+      bits.SetBitNumber(i);
+   return bits;
+}
+} // anonymous namespace
+
+TEST(TBits, CountBits)
+{
+   TBits bits = MakeBits(1000, 7, 3);
+   for (UInt_t start : {0u, 1u, 3u, 4u, 63u, 64u, 65u, 500u, 999u, 1000u, 2000u})
+      EXPECT_EQ(bits.CountBits(start), CountSlow(bits, start)) << "start " << start;
+}
+
+TEST(TBits, FirstLastBits)
+{
+   TBits bits(1000);
+   EXPECT_EQ(bits.FirstSetBit(), 1000u);
+   EXPECT_EQ(bits.LastSetBit(), 1000u);
+   EXPECT_EQ(bits.FirstNullBit(), 0u);
+   EXPECT_EQ(bits.LastNullBit(), 999u);
+
+   bits.SetBitNumber(5);
+   bits.SetBitNumber(130);
+   bits.SetBitNumber(700);
+   EXPECT_EQ(bits.FirstSetBit(), 5u);
+   EXPECT_EQ(bits.FirstSetBit(6), 130u);
+   EXPECT_EQ(bits.FirstSetBit(130), 130u);
+   EXPECT_EQ(bits.FirstSetBit(131), 700u);
+   EXPECT_EQ(bits.FirstSetBit(701), 1000u);
+   EXPECT_EQ(bits.LastSetBit(), 700u);
+   EXPECT_EQ(bits.LastSetBit(699), 130u);
+   EXPECT_EQ(bits.LastSetBit(130), 130u);
+   EXPECT_EQ(bits.LastSetBit(129), 5u);
+   EXPECT_EQ(bits.LastSetBit(4), 1000u);
+
+   TBits full = ~bits;
+   EXPECT_EQ(full.FirstNullBit(), 5u);
+   EXPECT_EQ(full.FirstNullBit(6), 130u);
+   EXPECT_EQ(full.FirstNullBit(131), 700u);
+   EXPECT_EQ(full.LastNullBit(), 700u);
+   EXPECT_EQ(full.LastNullBit(699), 130u);
+   EXPECT_EQ(full.LastNullBit(129), 5u);
+}
+
+TEST(TBits, BitwiseOperations)
+{
+   const UInt_t n = 1003;
+   TBits a = MakeBits(n, 3, 0);
+   TBits b = MakeBits(n - 100, 5, 1);
+   TBits andBits(a), orBits(a), xorBits(a);
+   andBits &= b;
+   orBits |= b;
+   xorBits ^= b;
+   for (UInt_t i = 0; i < n; ++i) {
+      const Bool_t ai = a.TestBitNumber(i), bi = b.TestBitNumber(i);
+      ASSERT_EQ(andBits.TestBitNumber(i), ai && bi) << i;
+      ASSERT_EQ(orBits.TestBitNumber(i), ai || bi) << i;
+      ASSERT_EQ(xorBits.TestBitNumber(i), ai != bi) << i;
+   }
+}
+
+TEST(TBits, ForEachSetBit)
+{
+   TBits bits = MakeBits(1100, 11, 2);
+   bits.SetBitNumber(1099);
+   std::vector<UInt_t> expected;
+   for (UInt_t i = 0; i < bits.GetNbits(); ++i)
+      if (bits.TestBitNumber(i))
+         expected.push_back(i);
+   std::vector<UInt_t> found;
+   bits.ForEachSetBit([&found](UInt_t i) { found.push_back(i); });
+   EXPECT_EQ(found, expected);
+}
@@ -0,0 +1,72 @@
+#include "TClonesArray.h"
+#include "TNamed.h"
+
+#include "gtest/gtest.h"
+
+TEST(TClonesArray, ArenaConstruction)
+{
+   TClonesArray arr(TNamed::Class(), 10);
+   EXPECT_FALSE(arr.IsArena());
+   arr.SetArena();
+   EXPECT_TRUE(arr.IsArena());
+
+   const Int_t n = 1000;
+   for (Int_t i = 0; i < n; ++i)
+      new (arr[i]) TNamed(TString::Format("obj%d", i).Data(), "title");
+   ASSERT_EQ(arr.GetEntriesFast(), n);
+   for (Int_t i = 0; i < n; ++i) {
+      auto obj = static_cast<TNamed *>(arr.At(i));
+      EXPECT_STREQ(obj->GetName(), TString::Format("obj%d", i).Data());
+      EXPECT_FALSE(obj->IsOnHeap());
+   }
+
+   arr.Clear("C");
+   EXPECT_EQ(arr.GetEntriesFast(), 0);
+   for (Int_t i = 0; i < 10; ++i)
+      static_cast<TNamed *>(arr.ConstructedAt(i))->SetName("again");
+   EXPECT_STREQ(arr.At(9)->GetName(), "again");
+}
+
+TEST(TClonesArray, ArenaReusesSlots)
+{
+   TClonesArray arr(TNamed::Class(), 10);
+   arr.SetArena();
+   arr.ExpandCreate(100);
+   TObject *first = arr.At(50);
+   arr.ExpandCreate(10);
+   arr.ExpandCreate(100);
+   // The released slots are reused, no new block is needed.
+   Bool_t found = kFALSE;
+   for (Int_t i = 10; i < 100; ++i)
+      found |= arr.At(i) == first;
+   EXPECT_TRUE(found);
+}
+
+TEST(TClonesArray, ArenaAbsorb)
+{
+   TClonesArray arr(TNamed::Class(), 10);
+   {
+      TClonesArray other(TNamed::Class(), 10);
+      other.SetArena();
+      for (Int_t i = 0; i < 20; ++i)
+         new (other[i]) TNamed("absorbed", "");
+      arr.AbsorbObjects(&other);
+      EXPECT_EQ(other.GetEntriesFast(), 0);
+   }
+   ASSERT_EQ(arr.GetEntriesFast(), 20);
+   EXPECT_FALSE(arr.IsArena());
+   EXPECT_STREQ(arr.At(19)->GetName(), "absorbed");
+   new (arr[20]) TNamed("heap", "");
+   EXPECT_TRUE(arr.At(20)->IsOnHeap());
+}
+
+TEST(TClonesArray, DefaultArena)
+{
+   TClonesArray::SetDefaultArena();
+   TClonesArray arr("TNamed");
+   TClonesArray::SetDefaultArena(kFALSE);
+   EXPECT_TRUE(arr.IsArena());
+   TClonesArray copy(arr);
+   EXPECT_TRUE(copy.IsArena());
+   EXPECT_FALSE(TClonesArray("TNamed").IsArena());
+}
@@ -0,0 +1,84 @@
+#include "THashList.h"
+#include "TList.h"
+#include "TNamed.h"
+#include "TObjArray.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using ROOT::Detail::TListRange;
+using ROOT::Detail::TObjArrayRange;
+
+static std::vector<std::string> Names(TListRange range)
+{
+   std::vector<std::string> names;
+   for (TObject *obj : range)
+      names.push_back(obj->GetName());
+   return names;
+}
+
+TEST(TListRange, Iterate)
+{
+   TList list;
+   list.SetOwner();
+   EXPECT_TRUE(Names(list).empty());
+   EXPECT_TRUE(Names((TList *)nullptr).empty());
+
+   list.Add(new TNamed("a", ""));
+   list.Add(new TNamed("b", ""));
+   list.Add(new TNamed("c", ""));
+   EXPECT_EQ(Names(list), (std::vector<std::string>{"a", "b", "c"}));
+   EXPECT_EQ(Names(&list), (std::vector<std::string>{"a", "b", "c"}));
+
+   THashList hashList;
+   hashList.SetOwner();
+   hashList.Add(new TNamed("x", ""));
+   hashList.Add(new TNamed("y", ""));
+   EXPECT_EQ(Names(hashList), (std::vector<std::string>{"x", "y"}));
+   EXPECT_EQ(Names(hashList.GetListForObject("y")), (std::vector<std::string>{"y"}));
+}
+
+TEST(TListRange, RemoveCurrent)
+{
+   TList list;
+   list.SetOwner();
+   for (const char *name : {"a", "b", "c", "d"})
+      list.Add(new TNamed(name, ""));
+
+   std::vector<std::string> visited;
+   for (TObject *obj : TListRange(list)) {
+      visited.push_back(obj->GetName());
+      if (visited.size() % 2)
+         delete list.Remove(obj);
+   }
+   EXPECT_EQ(visited, (std::vector<std::string>{"a", "b", "c", "d"}));
+   EXPECT_EQ(Names(list), (std::vector<std::string>{"b", "d"}));
+}
+
+TEST(TObjArrayRange, Iterate)
+{
+   TObjArray array(10, -2);
+   array.SetOwner();
+   EXPECT_EQ(TObjArrayRange(array).begin(), TObjArrayRange(array).end());
+   EXPECT_EQ(TObjArrayRange((TObjArray *)nullptr).begin(), TObjArrayRange((TObjArray *)nullptr).end());
+
+   array.AddAt(new TNamed("a", ""), -1);
+   array.AddAt(new TNamed("b", ""), 1);
+   array.AddAt(new TNamed("c", ""), 4);
+
+   std::vector<std::string> names;
+   for (TObject *obj : TObjArrayRange(array))
+      names.push_back(obj->GetName());
+   EXPECT_EQ(names, (std::vector<std::string>{"a", "b", "c"}));
+
+   // Removing during the iteration leaves a null slot, which is skipped.
+   names.clear();
+   for (TObject *obj : TObjArrayRange(&array)) {
+      names.push_back(obj->GetName());
+      if (names.size() == 1)
+         delete array.RemoveAt(1);
+   }
+   EXPECT_EQ(names, (std::vector<std::string>{"a", "c"}));
+}
@@ -0,0 +1,79 @@
+#include "TExMap.h"
+
+#include "gtest/gtest.h"
+
+TEST(TExMap, AddGetRemove)
+{
+   TExMap map;
+   for (Long64_t i = 1; i <= 1000; ++i)
+      map.Add(i, 10 * i);
+   EXPECT_EQ(map.GetSize(), 1000);
+   for (Long64_t i = 1; i <= 1000; ++i)
+      ASSERT_EQ(map.GetValue(i), 10 * i);
+   EXPECT_EQ(map.GetValue(1001), 0);
+
+   for (Long64_t i = 1; i <= 1000; i += 2)
+      map.Remove(i);
+   EXPECT_EQ(map.GetSize(), 500);
+   for (Long64_t i = 1; i <= 1000; ++i)
+      ASSERT_EQ(map.GetValue(i), i % 2 ? 0 : 10 * i);
+}
+
+TEST(TExMap, DeleteKeepsCapacity)
+{
+   TExMap map;
+   for (Long64_t i = 1; i <= 1000; ++i)
+      map.Add(i, i);
+   const Int_t capacity = map.Capacity();
+   map.Delete();
+   EXPECT_EQ(map.GetSize(), 0);
+   EXPECT_EQ(map.Capacity(), capacity);
+   for (Long64_t i = 1; i <= 1000; ++i)
+      ASSERT_EQ(map.GetValue(i), 0);
+
+   // A few entries per "event", with the short reset.
+   for (Int_t event = 0; event < 100; ++event) {
+      for (Long64_t i = 0; i < 5; ++i) {
+         UInt_t slot;
+         const Long64_t key = 7 * event + 100 * i;
+         ASSERT_EQ(map.GetValue(key, key, slot), 0);
+         map.AddAt(slot, key, key, key + 1);
+      }
+      for (Long64_t i = 0; i < 5; ++i) {
+         const Long64_t key = 7 * event + 100 * i;
+         ASSERT_EQ(map.GetValue(key), key + 1);
+      }
+      map.Delete();
+      ASSERT_EQ(map.GetSize(), 0);
+      ASSERT_EQ(map.GetValue(7 * event), 0);
+   }
+   EXPECT_EQ(map.Capacity(), capacity);
+
+   // No entry survives a reset, even after removals and expansions.
+   map.Add(1, 1);
+   map.Add(2, 2);
+   map.Remove(1);
+   map.Delete();
+   EXPECT_EQ(map.GetValue(2), 0);
+   for (Int_t i = 0; i < 100; ++i) {
+      TExMap copy(map);
+      copy(i) = i;
+      EXPECT_EQ(copy.GetValue(i), i);
+   }
+   TExMapIter next(&map);
+   Long64_t key, value;
+   EXPECT_FALSE(next.Next(key, value));
+}
+
+TEST(TExMap, Reserve)
+{
+   TExMap map(5);
+   map.Reserve(1000);
+   const Int_t capacity = map.Capacity();
+   EXPECT_GT(capacity, 1000);
+   for (Long64_t i = 0; i < 1000; ++i)
+      map.Add(i, i);
+   EXPECT_EQ(map.Capacity(), capacity);
+   map.Reserve(10);
+   EXPECT_EQ(map.Capacity(), capacity);
+}
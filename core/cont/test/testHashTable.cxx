@@ -0,0 +1,159 @@
+#include "THashList.h"
+#include "THashTable.h"
+#include "TList.h"
+#include "TNamed.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(THashTable, AddFindRemove)
+{
+   const Int_t n = 5000;
+   std::vector<TNamed> objects;
+   objects.reserve(n);
+   for (Int_t i = 0; i < n; ++i)
+      objects.emplace_back(("obj" + std::to_string(i)).c_str(), "");
+
+   THashTable table;
+   for (auto &obj : objects)
+      table.Add(&obj);
+   EXPECT_EQ(table.GetSize(), n);
+   EXPECT_GE(table.Capacity(), n);
+
+   for (Int_t i = 0; i < n; ++i) {
+      ASSERT_EQ(table.FindObject(("obj" + std::to_string(i)).c_str()), &objects[i]);
+      ASSERT_EQ(table.FindObject(&objects[i]), &objects[i]);
+   }
+   EXPECT_EQ(table.FindObject("obj"), nullptr);
+
+   for (Int_t i = 0; i < n; i += 2)
+      ASSERT_EQ(table.Remove(&objects[i]), &objects[i]);
+   EXPECT_EQ(table.GetSize(), n / 2);
+   for (Int_t i = 0; i < n; ++i)
+      ASSERT_EQ(table.FindObject(objects[i].GetName()), i % 2 ? &objects[i] : nullptr);
+   EXPECT_EQ(table.Remove(&objects[0]), nullptr);
+   EXPECT_EQ(table.RemoveSlow(&objects[1]), &objects[1]);
+   EXPECT_EQ(table.FindObject("obj1"), nullptr);
+}
+
+TEST(THashTable, Iteration)
+{
+   std::vector<TNamed> objects;
+   for (Int_t i = 0; i < 100; ++i)
+      objects.emplace_back(("obj" + std::to_string(i % 60)).c_str(), "");
+
+   THashTable table;
+   for (auto &obj : objects)
+      table.Add(&obj);
+
+   for (Bool_t dir : {kIterForward, kIterBackward}) {
+      std::set<TObject *> seen;
+      TIter next(&table, dir);
+      while (TObject *obj = next())
+         seen.insert(obj);
+      EXPECT_EQ(seen.size(), objects.size());
+   }
+   Int_t count = 0;
+   for (auto obj : table) {
+      EXPECT_NE(obj, nullptr);
+      ++count;
+   }
+   EXPECT_EQ(count, 100);
+}
+
+TEST(THashTable, SameHash)
+{
+   // The cycles of the keys of a TDirectory: the newest first.
+   TNamed first("key", "1"), second("key", "2"), third("key", "3"), other("other", "");
+   THashTable table;
+   table.Add(&other);
+   table.Add(&first);
+   EXPECT_EQ(table.Collisions("key"), 1);
+   table.AddBefore(&first, &second);
+   table.AddBefore(&second, &third);
+   EXPECT_EQ(table.Collisions("key"), 3);
+   EXPECT_EQ(table.GetSize(), 4);
+
+   const TList *list = table.GetListForObject("key");
+   ASSERT_NE(list, nullptr);
+   ASSERT_EQ(list->GetSize(), 3);
+   EXPECT_EQ(list->At(0), &third);
+   EXPECT_EQ(list->At(1), &second);
+   EXPECT_EQ(list->At(2), &first);
+   EXPECT_EQ(table.FindObject("key"), &third);
+
+   list = table.GetListForObject(&other);
+   ASSERT_NE(list, nullptr);
+   EXPECT_EQ(list->GetSize(), 1);
+   EXPECT_EQ(list->First(), &other);
+   EXPECT_EQ(table.GetListForObject("none"), nullptr);
+
+   EXPECT_EQ(table.Remove(&second), &second);
+   EXPECT_EQ(table.Collisions("key"), 2);
+   EXPECT_EQ(table.FindObject(&first), &first);
+}
+
+TEST(THashTable, RehashAfterRename)
+{
+   TNamed a("a", ""), b("b", "");
+   THashTable table(2);
+   table.Add(&a);
+   table.Add(&b);
+   a.SetName("c");
+   EXPECT_EQ(table.FindObject("c"), nullptr);
+   table.Rehash(100);
+   EXPECT_EQ(table.FindObject("c"), &a);
+   EXPECT_EQ(table.FindObject("b"), &b);
+   EXPECT_EQ(table.GetSize(), 2);
+}
+
+TEST(THashTable, ClearOwner)
+{
+   THashTable table;
+   table.SetOwner();
+   for (Int_t i = 0; i < 50; ++i)
+      table.Add(new TNamed(("obj" + std::to_string(i % 10)).c_str(), ""));
+   table.Clear();
+   EXPECT_EQ(table.GetSize(), 0);
+   EXPECT_EQ(table.FindObject("obj1"), nullptr);
+   table.Add(new TNamed("obj", ""));
+   EXPECT_NE(table.FindObject("obj"), nullptr);
+}
+
+TEST(THashList, Order)
+{
+   THashList list;
+   list.SetOwner();
+   for (Int_t i = 0; i < 1000; ++i)
+      list.Add(new TNamed(("obj" + std::to_string(i)).c_str(), ""));
+   Int_t i = 0;
+   for (auto obj : list)
+      EXPECT_EQ(std::string(obj->GetName()), "obj" + std::to_string(i++));
+   EXPECT_EQ(std::string(list.FindObject("obj500")->GetName()), "obj500");
+   delete list.Remove(list.FindObject("obj500"));
+   EXPECT_EQ(list.FindObject("obj500"), nullptr);
+   EXPECT_EQ(list.GetSize(), 999);
+}
+
+TEST(THashList, FindObjectStringView)
+{
+   THashList list;
+   list.SetOwner();
+   list.Add(new TNamed("first", ""));
+   list.Add(new TNamed("second", ""));
+   const std::string longName(300, 'x');
+   list.Add(new TNamed(longName.c_str(), ""));
+
+   const char *names = "firstsecond";
+   EXPECT_EQ(list.FindObject(std::string_view(names, 5)), list.First());
+   EXPECT_EQ(list.FindObject(std::string_view(names + 5, 6)), list.At(1));
+   EXPECT_EQ(list.FindObject(std::string_view(names, 4)), nullptr);
+   EXPECT_EQ(list.FindObject(std::string_view(longName)), list.Last());
+   EXPECT_EQ(list.FindObject(std::string("second")), list.At(1));
+   EXPECT_EQ(list.FindObject(TString("second")), list.At(1));
+   TCollection *coll = &list;
+   EXPECT_EQ(coll->FindObject(std::string_view(names, 5)), list.First());
+}
@@ -16,8 +16,12 @@
 
 #include "ROOT/TTaskGroup.hxx"
 
-#include <type_traits>
+#include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
 
 // exclude in case ROOT does not have IMT support
 #ifndef R__USE_IMT
@@ -33,18 +37,58 @@ namespace ROOT {
 namespace Experimental {
 template <typename T>
 class TFuture;
+
+template <class Function, class... Args>
+TFuture<typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
+Async(Function &&f, Args &&... args);
 }
 
 namespace Detail {
+/// The continuations of a task started by Async, see TFuture::Then: they are
+/// run by the task when it is done, or at once if it already is.
+class TContinuations {
+   std::mutex fMutex;
+   bool fDone = false;
+   std::vector<std::function<void()>> fFuncs;
+
+public:
+   void Add(std::function<void()> &&func)
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         if (!fDone) {
+            fFuncs.emplace_back(std::move(func));
+            return;
+         }
+      }
+      func();
+   }
+   void Done()
+   {
+      std::vector<std::function<void()>> funcs;
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fDone = true;
+         funcs.swap(fFuncs);
+      }
+      for (auto &func : funcs)
+         func();
+   }
+};
+
 template <typename T>
 class TFutureImpl {
    template <typename V>
    friend class Experimental::TFuture;
+   template <typename V>
+   friend class TFutureImpl;
 
 protected:
    using TTaskGroup = Experimental::TTaskGroup;
    std::future<T> fStdFut;
    std::unique_ptr<TTaskGroup> fTg{nullptr};
+   std::shared_ptr<TContinuations> fContinuations; ///< Run by the task of Async when it is done
+   std::function<void()> fWaitBefore;              ///< Waits for the future a continuation is waiting for
 
    TFutureImpl(std::future<T> &&fut, std::unique_ptr<TTaskGroup> &&tg) : fStdFut(std::move(fut))
    {
@@ -54,11 +98,36 @@ protected:
 
    TFutureImpl(std::future<T> &&fut) : fStdFut(std::move(fut)) {}
 
-   TFutureImpl(TFutureImpl<T> &&other) : fStdFut(std::move(other.fStdFut)), fTg(std::move(other.fTg)) {}
+   TFutureImpl(TFutureImpl<T> &&other)
+      : fStdFut(std::move(other.fStdFut)), fTg(std::move(other.fTg)),
+        fContinuations(std::move(other.fContinuations)), fWaitBefore(std::move(other.fWaitBefore))
+   {
+      other.fWaitBefore = nullptr;
+   }
 
    TFutureImpl &operator=(std::future<T> &&other) { fStdFut = std::move(other); }
 
-   TFutureImpl<T> &operator=(TFutureImpl<T> &&other) = default;
+   TFutureImpl<T> &operator=(TFutureImpl<T> &&other)
+   {
+      // The task group of a continuation can only go once the future it waits for is ready.
+      if (fWaitBefore)
+         fWaitBefore();
+      fStdFut = std::move(other.fStdFut);
+      fTg = std::move(other.fTg);
+      fContinuations = std::move(other.fContinuations);
+      fWaitBefore = std::move(other.fWaitBefore);
+      other.fWaitBefore = nullptr;
+      return *this;
+   }
+
+   ~TFutureImpl()
+   {
+      if (fWaitBefore)
+         fWaitBefore();
+   }
+
+   template <typename R, typename C>
+   static Experimental::TFuture<R> Continue(const std::shared_ptr<Experimental::TFuture<T>> &prev, C &&call);
 
 public:
    TFutureImpl<T> &operator=(TFutureImpl<T> &other) = delete;
@@ -67,6 +136,8 @@ public:
 
    void wait()
    {
+      if (fWaitBefore)
+         fWaitBefore();
       if (fTg)
          fTg->Wait();
    }
@@ -85,6 +156,8 @@ class TFuture final : public ROOT::Detail::TFutureImpl<T> {
    friend TFuture<
       typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
    Async(Function &&f, Args &&... args);
+   template <typename V>
+   friend class ROOT::Detail::TFutureImpl;
 
 private:
    TFuture(std::future<T> &&fut, std::unique_ptr<TTaskGroup> &&tg)
@@ -98,6 +171,20 @@ public:
       this->wait();
       return this->fStdFut.get();
    }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Returns the future of f(get()), run in a new task as soon as this future
+   /// is ready, without blocking a thread until then. This future is moved into
+   /// the returned one and is no longer valid.
+   template <class F>
+   auto Then(F &&f) -> TFuture<typename std::result_of<typename std::decay<F>::type(T)>::type>
+   {
+      using Ret_t = typename std::result_of<typename std::decay<F>::type(T)>::type;
+      auto prev = std::make_shared<TFuture<T>>(std::move(*this));
+      typename std::decay<F>::type func(std::forward<F>(f));
+      return ROOT::Detail::TFutureImpl<T>::template Continue<Ret_t>(
+         prev, [prev, func]() mutable -> Ret_t { return func(prev->fStdFut.get()); });
+   }
 };
 /// \cond
 // Two specialisations, for void and T& as for std::future
@@ -107,6 +194,8 @@ class TFuture<void> final : public ROOT::Detail::TFutureImpl<void> {
    friend TFuture<
       typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
    Async(Function &&f, Args &&... args);
+   template <typename V>
+   friend class ROOT::Detail::TFutureImpl;
 
 private:
    TFuture(std::future<void> &&fut, std::unique_ptr<TTaskGroup> &&tg)
@@ -120,6 +209,18 @@ public:
       this->wait();
       fStdFut.get();
    }
+
+   template <class F>
+   auto Then(F &&f) -> TFuture<typename std::result_of<typename std::decay<F>::type()>::type>
+   {
+      using Ret_t = typename std::result_of<typename std::decay<F>::type()>::type;
+      auto prev = std::make_shared<TFuture<void>>(std::move(*this));
+      typename std::decay<F>::type func(std::forward<F>(f));
+      return ROOT::Detail::TFutureImpl<void>::Continue<Ret_t>(prev, [prev, func]() mutable -> Ret_t {
+         prev->fStdFut.get();
+         return func();
+      });
+   }
 };
 
 template <typename T>
@@ -128,6 +229,8 @@ class TFuture<T &> final : public ROOT::Detail::TFutureImpl<T &> {
    friend TFuture<
       typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
    Async(Function &&f, Args &&... args);
+   template <typename V>
+   friend class ROOT::Detail::TFutureImpl;
 
 private:
    TFuture(std::future<T &> &&fut, std::unique_ptr<TTaskGroup> &&tg)
@@ -141,6 +244,16 @@ public:
       this->wait();
       return this->fStdFut.get();
    }
+
+   template <class F>
+   auto Then(F &&f) -> TFuture<typename std::result_of<typename std::decay<F>::type(T &)>::type>
+   {
+      using Ret_t = typename std::result_of<typename std::decay<F>::type(T &)>::type;
+      auto prev = std::make_shared<TFuture<T &>>(std::move(*this));
+      typename std::decay<F>::type func(std::forward<F>(f));
+      return ROOT::Detail::TFutureImpl<T &>::template Continue<Ret_t>(
+         prev, [prev, func]() mutable -> Ret_t { return func(prev->fStdFut.get()); });
+   }
 };
 /// \endcond
 
@@ -158,10 +271,48 @@ Async(Function &&f, Args &&... args)
    using Ret_t = typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type;
 
    auto thisPt = std::make_shared<std::packaged_task<Ret_t()>>(std::bind(f, args...));
+   auto continuations = std::make_shared<ROOT::Detail::TContinuations>();
    std::unique_ptr<ROOT::Experimental::TTaskGroup> tg(new ROOT::Experimental::TTaskGroup());
-   tg->Run([thisPt]() { (*thisPt)(); });
+   tg->Run([thisPt, continuations]() {
+      (*thisPt)();
+      continuations->Done();
+   });
+
+   ROOT::Experimental::TFuture<Ret_t> fut(thisPt->get_future(), std::move(tg));
+   fut.fContinuations = continuations;
+   return fut;
+}
+}
 
-   return ROOT::Experimental::TFuture<Ret_t>(thisPt->get_future(), std::move(tg));
+namespace Detail {
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the future of call(), run in a new task of the scheduler once prev
+/// is ready: the task is spawned by the one of prev when it is done. The
+/// returned future waits for prev before its own task group, so that its
+/// owner thread works on both instead of blocking. A future which was not
+/// started by Async is waited for in the new task.
+template <typename T>
+template <typename R, typename C>
+Experimental::TFuture<R>
+TFutureImpl<T>::Continue(const std::shared_ptr<Experimental::TFuture<T>> &prev, C &&call)
+{
+   if (!prev->fContinuations)
+      return Experimental::Async(std::forward<C>(call));
+
+   auto task = std::make_shared<std::packaged_task<R()>>(std::forward<C>(call));
+   auto continuations = std::make_shared<TContinuations>();
+   std::unique_ptr<TTaskGroup> tg(new TTaskGroup());
+   TTaskGroup *tgPtr = tg.get();
+   Experimental::TFuture<R> next(task->get_future(), std::move(tg));
+   next.fContinuations = continuations;
+   next.fWaitBefore = [prev]() { prev->wait(); };
+   prev->fContinuations->Add([tgPtr, task, continuations]() {
+      tgPtr->Run([task, continuations]() {
+         (*task)();
+         continuations->Done();
+      });
+   });
+   return next;
 }
 }
 }
@@ -33,7 +33,9 @@
 # endif
 #else
 
-#include<memory>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace tbb {
    class task_scheduler_init;
@@ -52,26 +54,48 @@ namespace ROOT {
 
       class TPoolManager {
       public:
-         friend std::shared_ptr<TPoolManager> GetPoolManager(UInt_t nThreads);
+         friend std::shared_ptr<TPoolManager> GetPoolManager(UInt_t nThreads, UInt_t placement);
          /// Returns the number of threads running when the scheduler has been instantiated within ROOT.
          static UInt_t GetPoolSize();
+         /// Returns the index of the task arena the calling thread is working in, or -1 if it is not in one
+         /// of the NUMA arenas of the manager.
+         static Int_t GetCurrentArena();
+         /// Returns the number of task arenas, one per NUMA node with ROOT::kIMTNumaArenas, 1 otherwise.
+         UInt_t GetNArenas() const { return fArenas.empty() ? 1 : fArenas.size(); }
+         /// Returns the maximum number of threads working in an arena.
+         UInt_t GetArenaPoolSize(UInt_t arena) const;
+         /// Returns the CPUs the threads of an arena run on, empty if they are not bound to any.
+         const std::vector<Int_t> &GetArenaCpus(UInt_t arena) const;
+         /// Runs func(arena) in each task arena, concurrently, and waits for all of them to finish.
+         void RunInArenas(const std::function<void(UInt_t arena)> &func);
+         /// Returns the placement options the manager has been initialized with, see ROOT::EIMTPlacement.
+         UInt_t GetPlacement() const { return fPlacement; }
          /// Terminates the scheduler instantiated within ROOT.
          ~TPoolManager();
       private:
+         struct TArena;
          ///Initializes the scheduler within ROOT. If the scheduler has already been initialized by the
          /// user before invoking the constructor it won't change its behaviour and it won't terminate it,
          /// but it will still keep record of the number of threads passed as a parameter.
-         TPoolManager(UInt_t nThreads = 0);
+         TPoolManager(UInt_t nThreads = 0, UInt_t placement = 0);
          static UInt_t fgPoolSize;
          bool mustDelete = true;
          tbb::task_scheduler_init *fSched = nullptr;
+         UInt_t fPlacement = 0;
+         std::vector<std::unique_ptr<TArena>> fArenas; ///< One per NUMA node, empty without ROOT::kIMTNumaArenas
+         std::vector<Int_t> fAllCpus;                  ///< CPUs of the threads when not in NUMA arenas
+         std::unique_ptr<TArena> fGlobalPinning;       ///< Binds the worker threads of all arenas to one CPU each
       };
       /// Get a shared pointer to the manager. Initialize the manager with nThreads if not active. If active,
       /// the number of threads, even if specified otherwise, will remain the same.
       ///
       /// The number of threads will be able to change calling the factory function again after the last
       /// remaining shared_ptr owning the object is destroyed or reasigned, which will trigger the destructor of the manager.
-      std::shared_ptr<TPoolManager> GetPoolManager(UInt_t nThreads = 0);
+      ///
+      /// placement combines ROOT::EIMTPlacement options: with ROOT::kIMTNumaArenas the threads are split in one task
+      /// arena per NUMA node and bound to its CPUs, with ROOT::kIMTPinThreads each worker thread is bound to a CPU.
+      /// Like the number of threads, it is only used when the manager is initialized.
+      std::shared_ptr<TPoolManager> GetPoolManager(UInt_t nThreads = 0, UInt_t placement = 0);
    }
 }
 
@@ -31,6 +31,7 @@ private:
    using TaskContainerPtr_t = void *; /// Shield completely from implementation
    TaskContainerPtr_t fTaskContainer{nullptr};
    std::atomic<bool> fCanRun{true};
+   std::atomic<long long> fNPending{0}; /// Submitted tasks not started yet, see TPerfCounters
 
 public:
    TTaskGroup();
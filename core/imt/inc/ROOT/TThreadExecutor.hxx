@@ -23,15 +23,84 @@
 #else
 
 #include "ROOT/TExecutor.hxx"
+#include "ROOT/TFuture.hxx"
 #include "ROOT/TPoolManager.hxx"
 #include "TROOT.h"
 #include "TError.h"
 #include <functional>
 #include <memory>
 #include <numeric>
+#include <type_traits>
+#include <vector>
 
 namespace ROOT {
 
+   namespace Experimental {
+      /// How the items go through a stage of TThreadExecutor::Pipeline
+      enum class EPipelineMode {
+         kParallel,        ///< Several items at a time, in any order
+         kSerialInOrder,   ///< One item at a time, in the order of the source
+         kSerialOutOfOrder ///< One item at a time, in any order
+      };
+
+      /// A stage of TThreadExecutor::Pipeline, see ParallelStage and SerialStage
+      template<class F>
+      struct TPipelineStage {
+         F fFunc;
+         EPipelineMode fMode;
+      };
+
+      //////////////////////////////////////////////////////////////////////////
+      /// A stage of TThreadExecutor::Pipeline processing several items at a time.
+      template<class F>
+      TPipelineStage<F> ParallelStage(F func)
+      {
+         return TPipelineStage<F>{func, EPipelineMode::kParallel};
+      }
+
+      //////////////////////////////////////////////////////////////////////////
+      /// A stage of TThreadExecutor::Pipeline processing one item at a time, e.g.
+      /// to write them. If inOrder, the items come in the order of the source.
+      template<class F>
+      TPipelineStage<F> SerialStage(F func, bool inOrder = true)
+      {
+         return TPipelineStage<F>{func, inOrder ? EPipelineMode::kSerialInOrder : EPipelineMode::kSerialOutOfOrder};
+      }
+   } // namespace Experimental
+
+   namespace Internal {
+      /// A stage of TThreadExecutor::Pipeline once its types are erased: the function
+      /// takes the ownership of the input item and returns the output one, nullptr
+      /// for the last stage.
+      struct TPipelineFilter {
+         std::function<void *(void *)> fFunc;
+         Experimental::EPipelineMode fMode;
+      };
+
+      /// \cond
+      template<class In, class Out>
+      struct TPipelineFilterFunc {
+         template<class F>
+         static void *Call(F &func, void *item)
+         {
+            std::unique_ptr<In> in(static_cast<In *>(item));
+            return new Out(func(*in));
+         }
+      };
+
+      template<class In>
+      struct TPipelineFilterFunc<In, void> {
+         template<class F>
+         static void *Call(F &func, void *item)
+         {
+            std::unique_ptr<In> in(static_cast<In *>(item));
+            func(*in);
+            return nullptr;
+         }
+      };
+      /// \endcond
+   } // namespace Internal
+
    class TThreadExecutor: public TExecutor<TThreadExecutor> {
    public:
       explicit TThreadExecutor();
@@ -84,6 +153,62 @@ namespace ROOT {
       template<class T, class BINARYOP> auto Reduce(const std::vector<T> &objs, BINARYOP redfunc) -> decltype(redfunc(objs.front(), objs.front()));
       template<class T, class R> auto Reduce(const std::vector<T> &objs, R redfunc) -> decltype(redfunc(objs));
 
+      //////////////////////////////////////////////////////////////////////////
+      /// Run func(args...) in a new task of the scheduler and return the future
+      /// of its result, see ROOT::Experimental::TFuture. The arguments are copied.
+      /// The task keeps the pool of threads alive, even if this executor is
+      /// destroyed before it is done.
+      ///
+      /// It can be called from within another task, e.g. of the implicit
+      /// multi-threading: waiting for the future, or for a TFuture::Then
+      /// continuation of it, runs the pending tasks instead of blocking the
+      /// thread.
+      template<class F, class... Args>
+      auto Async(F func, Args... args) -> Experimental::TFuture<typename std::result_of<F(Args &...)>::type>
+      {
+         auto sched = fSched;
+         return Experimental::Async(std::bind([sched, func](Args &... a) mutable {
+            (void)sched;
+            return func(a...);
+         }, args...));
+      }
+
+      //////////////////////////////////////////////////////////////////////////
+      /// Run Map(func, args...) in a new task and return the future of its
+      /// result, e.g. to overlap it with another stage of the processing. The
+      /// arguments, e.g. the std::vector of the elements, are copied. See Async.
+      ///
+      /// ~~~{.cpp}
+      /// ROOT::TThreadExecutor pool;
+      /// auto squares = pool.MapAsync([](int a) { return a * a; }, ROOT::TSeq<int>(10));
+      /// auto sum = squares.Then([](std::vector<int> v) { return std::accumulate(v.begin(), v.end(), 0); });
+      /// ~~~
+      template<class F, class... Args>
+      auto MapAsync(F func, Args... args) -> Experimental::TFuture<decltype(this->Map(func, args...))>
+      {
+         auto sched = fSched;
+         return Experimental::Async(std::bind([sched, func](Args &... a) {
+            TThreadExecutor pool(sched);
+            return pool.Map(func, a...);
+         }, args...));
+      }
+
+      //////////////////////////////////////////////////////////////////////////
+      /// Run MapReduce(func, args...) in a new task and return the future of its
+      /// result. The arguments are copied. See Async.
+      template<class F, class... Args>
+      auto MapReduceAsync(F func, Args... args) -> Experimental::TFuture<decltype(this->MapReduce(func, args...))>
+      {
+         auto sched = fSched;
+         return Experimental::Async(std::bind([sched, func](Args &... a) {
+            TThreadExecutor pool(sched);
+            return pool.MapReduce(func, a...);
+         }, args...));
+      }
+
+      template<class F, class... Stages>
+      void Pipeline(unsigned maxInFlight, F source, Stages... stages);
+
    protected:
       template<class F, class R, class Cond = noReferenceCond<F>>
       auto Map(F func, unsigned nTimes, R redfunc, unsigned nChunks) -> std::vector<typename std::result_of<F()>::type>;
@@ -95,11 +220,22 @@ namespace ROOT {
       auto Map(F func, std::initializer_list<T> args, R redfunc, unsigned nChunks) -> std::vector<typename std::result_of<F(T)>::type>;
 
    private:
+      TThreadExecutor(const std::shared_ptr<ROOT::Internal::TPoolManager> &sched) : fSched(sched) {}
       void   ParallelFor(unsigned start, unsigned end, unsigned step, const std::function<void(unsigned int i)> &f);
       double ParallelReduce(const std::vector<double> &objs, const std::function<double(double a, double b)> &redfunc);
       float  ParallelReduce(const std::vector<float> &objs, const std::function<float(float a, float b)> &redfunc);
       template<class T, class R>
       auto SeqReduce(const std::vector<T> &objs, R redfunc) -> decltype(redfunc(objs));
+      void   RunPipeline(unsigned maxInFlight, const std::function<void *()> &source,
+                         const std::vector<Internal::TPipelineFilter> &filters);
+      template<class In>
+      static void AddPipelineFilters(std::vector<Internal::TPipelineFilter> &)
+      {
+         static_assert(std::is_void<In>::value, "The last stage of a pipeline must not return anything");
+      }
+      template<class In, class F, class... Stages>
+      static void AddPipelineFilters(std::vector<Internal::TPipelineFilter> &filters,
+                                     Experimental::TPipelineStage<F> stage, Stages... stages);
 
       std::shared_ptr<ROOT::Internal::TPoolManager> fSched = nullptr;
    };
@@ -383,6 +519,53 @@ namespace ROOT {
       return redfunc(objs);
    }
 
+   //////////////////////////////////////////////////////////////////////////
+   /// Run the items returned by source through the stages, the processing of
+   /// the stages of different items overlapping: e.g. read, process and
+   /// write, where the next items are read and processed while the previous
+   /// ones are written.
+   ///
+   /// source is called serially and returns the next item as a
+   /// std::unique_ptr<T>, nullptr when there are no more items. Each stage,
+   /// made with Experimental::ParallelStage or Experimental::SerialStage, is
+   /// called with a reference to the item returned by the previous one, and the
+   /// last stage must not return anything. A serial stage in order, e.g.
+   /// writing into a TBufferMergerFile, sees the items in the order of the source.
+   ///
+   /// At most maxInFlight items (by default twice the number of threads) are
+   /// processed at a time, which bounds the memory taken by the items between
+   /// the stages. The pipeline can be run from within a task, e.g. of a
+   /// TTreeProcessorMT, as the waiting thread takes part to the processing.
+   ///
+   /// ~~~{.cpp}
+   /// using namespace ROOT::Experimental;
+   /// ROOT::TThreadExecutor pool;
+   /// int n = 0;
+   /// pool.Pipeline(0, [&n]() { return n < 100 ? std::unique_ptr<int>(new int(n++)) : nullptr; },
+   ///               ParallelStage([](int &i) { return std::sqrt(i); }),
+   ///               SerialStage([](double &r) { std::cout << r << std::endl; }));
+   /// ~~~
+   template<class F, class... Stages>
+   void TThreadExecutor::Pipeline(unsigned maxInFlight, F source, Stages... stages)
+   {
+      using Item_t = typename std::result_of<F()>::type::element_type;
+      std::vector<Internal::TPipelineFilter> filters;
+      AddPipelineFilters<Item_t>(filters, stages...);
+      RunPipeline(maxInFlight, [&source]() -> void * { return source().release(); }, filters);
+   }
+
+   template<class In, class F, class... Stages>
+   void TThreadExecutor::AddPipelineFilters(std::vector<Internal::TPipelineFilter> &filters,
+                                            Experimental::TPipelineStage<F> stage, Stages... stages)
+   {
+      using Out_t = typename std::result_of<F(In &)>::type;
+      auto func = stage.fFunc;
+      filters.emplace_back(Internal::TPipelineFilter{
+         [func](void *item) mutable { return Internal::TPipelineFilterFunc<In, Out_t>::Call(func, item); },
+         stage.fMode});
+      AddPipelineFilters<Out_t>(filters, stages...);
+   }
+
 } // namespace ROOT
 
 #endif   // R__USE_IMT
@@ -47,19 +47,24 @@ static std::atomic_int &GetParTreeProcessingCount()
    return count;
 }
 
-extern "C" void ROOT_TImplicitMT_EnableImplicitMT(UInt_t numthreads)
+extern "C" void ROOT_TImplicitMT_EnableImplicitMTPlacement(UInt_t numthreads, UInt_t placement)
 {
    if (!GetImplicitMTFlag()) {
       if (ROOT::Internal::TPoolManager::GetPoolSize() == 0) {
          TThread::Initialize();
       }
-      R__GetPoolManagerMT() = ROOT::Internal::GetPoolManager(numthreads);
+      R__GetPoolManagerMT() = ROOT::Internal::GetPoolManager(numthreads, placement);
       GetImplicitMTFlag() = true;
    } else {
       ::Warning("ROOT_TImplicitMT_EnableImplicitMT", "Implicit multi-threading is already enabled");
    }
 };
 
+extern "C" void ROOT_TImplicitMT_EnableImplicitMT(UInt_t numthreads)
+{
+   ROOT_TImplicitMT_EnableImplicitMTPlacement(numthreads, 0);
+};
+
 extern "C" void ROOT_TImplicitMT_DisableImplicitMT()
 {
    if (GetImplicitMTFlag()) {
@@ -75,6 +80,28 @@ extern "C" UInt_t ROOT_TImplicitMT_GetImplicitMTPoolSize()
    return ROOT::Internal::TPoolManager::GetPoolSize();
 };
 
+extern "C" UInt_t ROOT_TImplicitMT_GetImplicitMTNumaNodes()
+{
+   return R__GetPoolManagerMT() ? R__GetPoolManagerMT()->GetNArenas() : 0;
+};
+
+extern "C" UInt_t ROOT_TImplicitMT_GetImplicitMTNodePoolSize(UInt_t node)
+{
+   auto &sched = R__GetPoolManagerMT();
+   return sched && node < sched->GetNArenas() ? sched->GetArenaPoolSize(node) : 0;
+};
+
+extern "C" void ROOT_TImplicitMT_GetImplicitMTNodeCpus(UInt_t node, std::vector<Int_t> *cpus)
+{
+   auto &sched = R__GetPoolManagerMT();
+   if (sched && node < sched->GetNArenas())
+      *cpus = sched->GetArenaCpus(node);
+};
+
+extern "C" Int_t ROOT_TImplicitMT_GetImplicitMTCurrentNode()
+{
+   return ROOT::Internal::TPoolManager::GetCurrentArena();
+};
 
 extern "C" void ROOT_TImplicitMT_EnableParBranchProcessing()
 {
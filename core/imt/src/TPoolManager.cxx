@@ -2,11 +2,144 @@
 #include "TError.h"
 #include "TROOT.h"
 #include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#define TBB_PREVIEW_LOCAL_OBSERVER 1
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
 #include "tbb/task_scheduler_init.h"
+#include "tbb/task_scheduler_observer.h"
+
+#ifdef R__LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+   // Index of the NUMA arena the thread is working in, -1 outside of them.
+   thread_local Int_t gCurrentArena = -1;
+
+   // Parse a list of CPUs or nodes of the Linux sysfs, e.g. "0-15,32-47".
+   std::vector<Int_t> ParseCpuList(const std::string &list)
+   {
+      std::vector<Int_t> cpus;
+      std::istringstream in(list);
+      std::string range;
+      while (std::getline(in, range, ',')) {
+         Int_t first = -1, last = -1;
+         char dash = 0;
+         std::istringstream r(range);
+         if (!(r >> first))
+            continue;
+         last = (r >> dash >> last && dash == '-') ? last : first;
+         for (Int_t cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+      }
+      return cpus;
+   }
+
+   std::string ReadSysFile(const std::string &path)
+   {
+      std::ifstream in(path);
+      std::string line;
+      std::getline(in, line);
+      return line;
+   }
+
+   // CPUs of the process, one vector per NUMA node, without the ones it is not allowed to run on.
+   std::vector<std::vector<Int_t>> GetNumaNodeCpus()
+   {
+      std::vector<std::vector<Int_t>> nodes;
+#ifdef R__LINUX
+      cpu_set_t allowed;
+      CPU_ZERO(&allowed);
+      if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+         return nodes;
+      std::vector<Int_t> nodeIds = ParseCpuList(ReadSysFile("/sys/devices/system/node/online"));
+      if (nodeIds.empty())
+         nodeIds.push_back(-1);
+      for (Int_t node : nodeIds) {
+         std::vector<Int_t> cpus;
+         if (node >= 0)
+            cpus = ParseCpuList(ReadSysFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+         else
+            // No NUMA information: all the CPUs are on one node.
+            for (Int_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+               cpus.push_back(cpu);
+         cpus.erase(std::remove_if(cpus.begin(), cpus.end(),
+                                   [&allowed](Int_t cpu) { return cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed); }),
+                    cpus.end());
+         if (!cpus.empty())
+            nodes.push_back(cpus);
+      }
+#endif
+      return nodes;
+   }
+
+   // Bind the calling thread to the given CPUs.
+   void SetThreadAffinity(const Int_t *cpus, size_t ncpus)
+   {
+#ifdef R__LINUX
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (size_t i = 0; i < ncpus; ++i)
+         CPU_SET(cpus[i], &set);
+      pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+      (void)cpus;
+      (void)ncpus;
+#endif
+   }
+
+   // Binds the worker threads entering an arena, or all arenas, to its CPUs, and keeps track of the
+   // arena the threads work in.
+   class TArenaObserver : public tbb::task_scheduler_observer {
+   public:
+      TArenaObserver(const std::vector<Int_t> &cpus, bool pinEach) : fCpus(cpus), fPinEach(pinEach) { observe(true); }
+      TArenaObserver(tbb::task_arena &arena, Int_t index, const std::vector<Int_t> &cpus, bool pinEach)
+         : tbb::task_scheduler_observer(arena), fIndex(index), fCpus(cpus), fPinEach(pinEach)
+      {
+         observe(true);
+      }
+      ~TArenaObserver() { observe(false); }
+      void on_scheduler_entry(bool isWorker) override
+      {
+         if (fIndex >= 0)
+            gCurrentArena = fIndex;
+         // The threads of the application are left where they are.
+         if (!isWorker || fCpus.empty())
+            return;
+         if (fPinEach)
+            SetThreadAffinity(&fCpus[fNext++ % fCpus.size()], 1);
+         else
+            SetThreadAffinity(fCpus.data(), fCpus.size());
+      }
+      void on_scheduler_exit(bool) override
+      {
+         if (fIndex >= 0)
+            gCurrentArena = -1;
+      }
+
+   private:
+      Int_t fIndex = -1;
+      std::vector<Int_t> fCpus;
+      bool fPinEach;
+      std::atomic<UInt_t> fNext{0};
+   };
+}
 
 namespace ROOT {
 
    namespace Internal {
+      struct TPoolManager::TArena {
+         UInt_t fPoolSize;
+         std::vector<Int_t> fCpus;
+         std::unique_ptr<tbb::task_arena> fArena;
+         std::unique_ptr<TArenaObserver> fObserver;
+      };
+
       //Returns the weak_ptr reflecting a shared_ptr to the only instance of the Pool Manager.
       //This will allow to check if the shared_ptr is still alive, solving the dangling pointer problem.
       std::weak_ptr<TPoolManager> &GetWP()
@@ -17,7 +150,8 @@ namespace ROOT {
 
       UInt_t TPoolManager::fgPoolSize = 0;
 
-      TPoolManager::TPoolManager(UInt_t nThreads): fSched(new tbb::task_scheduler_init(tbb::task_scheduler_init::deferred))
+      TPoolManager::TPoolManager(UInt_t nThreads, UInt_t placement)
+         : fSched(new tbb::task_scheduler_init(tbb::task_scheduler_init::deferred)), fPlacement(placement)
       {
          //Is it there another instance of the tbb scheduler running?
          if (fSched->is_active()) {
@@ -27,10 +161,60 @@ namespace ROOT {
          nThreads = nThreads != 0 ? nThreads : tbb::task_scheduler_init::default_num_threads();
          fSched ->initialize(nThreads);
          fgPoolSize = nThreads;
+
+         if (!placement)
+            return;
+         const bool pinEach = placement & ROOT::kIMTPinThreads;
+         std::vector<std::vector<Int_t>> nodes = GetNumaNodeCpus();
+         if (nodes.empty()) {
+            ::Warning("TPoolManager", "The NUMA topology is unknown on this platform, the threads are not placed");
+            fPlacement = 0;
+            return;
+         }
+
+         if ((placement & ROOT::kIMTNumaArenas) && nodes.size() > 1 && nThreads >= nodes.size()) {
+            // Share the threads among the nodes in proportion to their CPUs.
+            size_t nCpus = 0;
+            for (auto &cpus : nodes)
+               nCpus += cpus.size();
+            UInt_t nAssigned = 0;
+            size_t nCpusSeen = 0;
+            for (UInt_t i = 0; i < nodes.size(); ++i) {
+               nCpusSeen += nodes[i].size();
+               UInt_t upTo = std::max<UInt_t>(i + 1, (nThreads * nCpusSeen + nCpus / 2) / nCpus);
+               upTo = std::min<UInt_t>(upTo, nThreads - (nodes.size() - i - 1));
+               std::unique_ptr<TArena> arena(new TArena);
+               arena->fPoolSize = upTo - nAssigned;
+               arena->fCpus = nodes[i];
+               // One more slot for the thread waiting for the tasks of the arena, see RunInArenas.
+               arena->fArena.reset(new tbb::task_arena(arena->fPoolSize + 1, 1));
+               arena->fArena->initialize();
+               arena->fObserver.reset(new TArenaObserver(*arena->fArena, i, arena->fCpus, pinEach));
+               nAssigned = upTo;
+               fArenas.emplace_back(std::move(arena));
+            }
+            if (gDebug > 0) {
+               for (UInt_t i = 0; i < fArenas.size(); ++i)
+                  ::Info("TPoolManager", "NUMA arena %u: %u threads on %lu CPUs", i, fArenas[i]->fPoolSize,
+                         (unsigned long)fArenas[i]->fCpus.size());
+            }
+            return;
+         }
+
+         fPlacement &= ~ROOT::kIMTNumaArenas;
+         if (pinEach) {
+            for (auto &cpus : nodes)
+               fAllCpus.insert(fAllCpus.end(), cpus.begin(), cpus.end());
+            fGlobalPinning.reset(new TArena);
+            fGlobalPinning->fPoolSize = nThreads;
+            fGlobalPinning->fObserver.reset(new TArenaObserver(fAllCpus, true));
+         }
       };
 
       TPoolManager::~TPoolManager()
       {
+         fGlobalPinning.reset();
+         fArenas.clear();
          //Only terminate the tbb scheduler if there was not another instance already
          // running when the constructor was called.
          if (mustDelete) {
@@ -45,11 +229,41 @@ namespace ROOT {
          return fgPoolSize;
       }
 
+      Int_t TPoolManager::GetCurrentArena()
+      {
+         return gCurrentArena;
+      }
+
+      UInt_t TPoolManager::GetArenaPoolSize(UInt_t arena) const
+      {
+         return fArenas.empty() ? fgPoolSize : fArenas.at(arena)->fPoolSize;
+      }
+
+      const std::vector<Int_t> &TPoolManager::GetArenaCpus(UInt_t arena) const
+      {
+         return fArenas.empty() ? fAllCpus : fArenas.at(arena)->fCpus;
+      }
+
+      //Run a function in each arena: it is queued in a task group of every arena first, then the calling
+      //thread joins the arenas in turn to wait for them.
+      void TPoolManager::RunInArenas(const std::function<void(UInt_t arena)> &func)
+      {
+         if (fArenas.empty()) {
+            func(0);
+            return;
+         }
+         std::unique_ptr<tbb::task_group[]> groups(new tbb::task_group[fArenas.size()]);
+         for (UInt_t i = 0; i < fArenas.size(); ++i)
+            fArenas[i]->fArena->execute([&groups, &func, i]() { groups[i].run([&func, i]() { func(i); }); });
+         for (UInt_t i = 0; i < fArenas.size(); ++i)
+            fArenas[i]->fArena->execute([&groups, i]() { groups[i].wait(); });
+      }
+
       //Factory function returning a shared pointer to the only instance of the PoolManager.
-      std::shared_ptr<TPoolManager> GetPoolManager(UInt_t nThreads)
+      std::shared_ptr<TPoolManager> GetPoolManager(UInt_t nThreads, UInt_t placement)
       {
          if (GetWP().expired()) {
-            std::shared_ptr<TPoolManager> shared(new TPoolManager(nThreads));
+            std::shared_ptr<TPoolManager> shared(new TPoolManager(nThreads, placement));
             GetWP() = shared;
             return GetWP().lock();
          }
@@ -12,9 +12,12 @@
 #include "RConfigure.h"
 
 #include "ROOT/TTaskGroup.hxx"
+#include "TPerfCounters.h"
+#include "TTimelineTracer.h"
 
 #ifdef R__USE_IMT
 #include "TROOT.h"
+#include "ROOT/TPoolManager.hxx"
 #include "tbb/task_group.h"
 #endif
 
@@ -29,6 +32,38 @@ A TTaskGroup represents concurrent execution of a group of tasks. Tasks may be d
 executing.
 */
 
+#ifdef R__USE_IMT
+namespace {
+
+const ROOT::TPerfCounters::TCounter &GetPendingCounter()
+{
+   static const auto pending = ROOT::TPerfCounters::Register(
+      "root_imt_tasks_pending", "Tasks submitted to a TTaskGroup and not started yet", ROOT::TPerfCounters::kGauge);
+   return pending;
+}
+
+const ROOT::TPerfCounters::TCounter &GetRunningCounter()
+{
+   static const auto running = ROOT::TPerfCounters::Register("root_imt_tasks_running", "Tasks of a TTaskGroup running",
+                                                            ROOT::TPerfCounters::kGauge);
+   return running;
+}
+
+// Moves a task from the pending to the running ones for its lifetime.
+class TTaskAccounting {
+public:
+   TTaskAccounting(std::atomic<long long> &groupPending)
+   {
+      --groupPending;
+      GetPendingCounter().Add(-1);
+      GetRunningCounter().Add();
+   }
+   ~TTaskAccounting() { GetRunningCounter().Add(-1); }
+};
+
+} // anonymous namespace
+#endif
+
 namespace ROOT {
 
 namespace Experimental {
@@ -40,7 +75,8 @@ namespace Experimental {
 TTaskGroup::TTaskGroup()
 {
 #ifdef R__USE_IMT
-   if (!ROOT::IsImplicitMTEnabled()) {
+   // The scheduler is also initialized by a TThreadExecutor, e.g. for its asynchronous methods.
+   if (!ROOT::IsImplicitMTEnabled() && ROOT::Internal::TPoolManager::GetPoolSize() == 0) {
       throw std::runtime_error("Implicit parallelism not enabled. Cannot instantiate a TTaskGroup.");
    }
    fTaskContainer = ((TaskContainerPtr_t *)new tbb::task_group());
@@ -57,6 +93,7 @@ TTaskGroup &TTaskGroup::operator=(TTaskGroup &&other)
    fTaskContainer = other.fTaskContainer;
    other.fTaskContainer = nullptr;
    fCanRun.store(other.fCanRun);
+   fNPending.store(other.fNPending.exchange(0));
    return *this;
 }
 
@@ -95,7 +132,20 @@ void TTaskGroup::Run(const std::function<void(void)> &closure)
    while (!fCanRun)
       /* empty */;
 
-   ((tbb::task_group *)fTaskContainer)->run(closure);
+   ++fNPending;
+   GetPendingCounter().Add();
+   if (R__unlikely(ROOT::TTimelineTracer::IsEnabled())) {
+      ((tbb::task_group *)fTaskContainer)->run([this, closure]() {
+         TTaskAccounting accounting(fNPending);
+         ROOT::TTimelineTracer::TSpan span("imt", "TTaskGroup task");
+         closure();
+      });
+      return;
+   }
+   ((tbb::task_group *)fTaskContainer)->run([this, closure]() {
+      TTaskAccounting accounting(fNPending);
+      closure();
+   });
 #else
    closure();
 #endif
@@ -107,8 +157,12 @@ void TTaskGroup::Run(const std::function<void(void)> &closure)
 void TTaskGroup::Wait()
 {
 #ifdef R__USE_IMT
+   ROOT::TTimelineTracer::TSpan span("imt", "TTaskGroup::Wait");
    fCanRun = false;
    ((tbb::task_group *)fTaskContainer)->wait();
+   // The tasks cancelled before they started are no longer pending.
+   if (const long long cancelled = fNPending.exchange(0))
+      GetPendingCounter().Add(-cancelled);
    fCanRun = true;
 #endif
 }
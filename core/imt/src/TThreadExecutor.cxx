@@ -1,5 +1,7 @@
 #include "ROOT/TThreadExecutor.hxx"
+#include "TTimelineTracer.h"
 #include "tbb/tbb.h"
+#include <algorithm>
 
 //////////////////////////////////////////////////////////////////////////
 ///
@@ -67,6 +69,12 @@
 /// root[] ROOT::TThreadExecutor pool; auto hist = pool.MapReduce(CreateAndFillHists, 10, PoolUtils::ReduceObjects);
 /// ~~~
 ///
+/// ###ROOT::TThreadExecutor::Pipeline
+/// Runs a stream of items through a sequence of stages, e.g. read, process and
+/// write, the stages of different items running at the same time. The stages
+/// either process several items at a time or one at a time (e.g. a writer), and
+/// the number of items in flight is bounded.
+///
 //////////////////////////////////////////////////////////////////////////
 
 
@@ -86,9 +94,80 @@ namespace ROOT {
       fSched = ROOT::Internal::GetPoolManager(nThreads);
    }
 
-   void TThreadExecutor::ParallelFor(unsigned int start, unsigned int end, unsigned step, const std::function<void(unsigned int i)> &f)
+   //////////////////////////////////////////////////////////////////////////
+   /// With the NUMA arenas of ROOT::EnableImplicitMT(UInt_t, UInt_t), the range
+   /// is split in one contiguous part per arena, in proportion to its threads:
+   /// neighbouring iterations, e.g. the clusters of a TTreeProcessorMT, run on
+   /// the same node. A loop started from within an arena stays in it.
+   void TThreadExecutor::ParallelFor(unsigned int start, unsigned int end, unsigned step, const std::function<void(unsigned int i)> &func)
+   {
+      // With the timeline tracer, each iteration is a span.
+      std::function<void(unsigned int i)> traced;
+      if (R__unlikely(ROOT::TTimelineTracer::IsEnabled())) {
+         traced = [&func](unsigned int i) {
+            ROOT::TTimelineTracer::TSpan span("imt", "TThreadExecutor task", "index", i);
+            func(i);
+         };
+      }
+      const std::function<void(unsigned int i)> &f = traced ? traced : func;
+
+      const UInt_t nArenas = fSched->GetNArenas();
+      if (nArenas == 1 || ROOT::Internal::TPoolManager::GetCurrentArena() >= 0 || end <= start) {
+         tbb::parallel_for(start, end, step, f);
+         return;
+      }
+
+      const unsigned nIter = (end - start + step - 1) / step;
+      std::vector<unsigned> firstIter(nArenas + 1, 0);
+      ULong64_t threads = 0;
+      for (UInt_t i = 0; i < nArenas; ++i)
+         threads += fSched->GetArenaPoolSize(i);
+      ULong64_t threadsSeen = 0;
+      for (UInt_t i = 0; i < nArenas; ++i) {
+         threadsSeen += fSched->GetArenaPoolSize(i);
+         firstIter[i + 1] = nIter * threadsSeen / threads;
+      }
+      fSched->RunInArenas([&](UInt_t arena) {
+         if (firstIter[arena] < firstIter[arena + 1])
+            tbb::parallel_for(start + firstIter[arena] * step, std::min(end, start + firstIter[arena + 1] * step), step,
+                              f);
+      });
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// Run the type-erased pipeline of Pipeline with tbb::parallel_pipeline.
+   void TThreadExecutor::RunPipeline(unsigned maxInFlight, const std::function<void *()> &source,
+                                     const std::vector<Internal::TPipelineFilter> &filters)
    {
-      tbb::parallel_for(start, end, step, f);
+      if (maxInFlight == 0)
+         maxInFlight = 2 * std::max(1U, ROOT::Internal::TPoolManager::GetPoolSize());
+
+      auto tbbMode = [](Experimental::EPipelineMode mode) {
+         switch (mode) {
+         case Experimental::EPipelineMode::kSerialInOrder: return tbb::filter::serial_in_order;
+         case Experimental::EPipelineMode::kSerialOutOfOrder: return tbb::filter::serial_out_of_order;
+         default: return tbb::filter::parallel;
+         }
+      };
+
+      tbb::filter_t<void, void *> chain =
+         tbb::make_filter<void, void *>(tbb::filter::serial_in_order, [&source](tbb::flow_control &fc) -> void * {
+            void *item = source();
+            if (!item)
+               fc.stop();
+            return item;
+         });
+      Long64_t stage = 0;
+      for (auto &filter : filters) {
+         auto &func = filter.fFunc;
+         chain = chain & tbb::make_filter<void *, void *>(tbbMode(filter.fMode), [&func, stage](void *item) {
+                    ROOT::TTimelineTracer::TSpan span("imt", "TThreadExecutor pipeline stage", "stage", stage);
+                    return func(item);
+                 });
+         ++stage;
+      }
+      // The last stage returns nullptr
+      tbb::parallel_pipeline(maxInFlight, chain & tbb::make_filter<void *, void>(tbb::filter::parallel, [](void *) {}));
    }
 
    double TThreadExecutor::ParallelReduce(const std::vector<double> &objs, const std::function<double(double a, double b)> &redfunc)
@@ -0,0 +1,55 @@
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#ifdef R__USE_IMT
+
+using namespace ROOT::Experimental;
+
+TEST(TThreadExecutor, PipelineInOrder)
+{
+   ROOT::TThreadExecutor pool(4);
+   const int n = 1000;
+   int next = 0;
+   std::vector<int> written;
+   pool.Pipeline(8, [&next]() { return next < n ? std::unique_ptr<int>(new int(next++)) : nullptr; },
+                 ParallelStage([](int &i) { return 2. * i; }),
+                 ParallelStage([](double &d) { return static_cast<int>(d) + 1; }),
+                 SerialStage([&written](int &i) { written.push_back(i); }));
+   ASSERT_EQ(std::size_t(n), written.size());
+   for (int i = 0; i < n; ++i)
+      EXPECT_EQ(2 * i + 1, written[i]);
+}
+
+TEST(TThreadExecutor, PipelineBoundedInFlight)
+{
+   ROOT::TThreadExecutor pool(4);
+   const unsigned maxInFlight = 3;
+   std::atomic<int> inFlight(0);
+   std::atomic<int> maxSeen(0);
+   std::atomic<int> processed(0);
+   int next = 0;
+   pool.Pipeline(maxInFlight,
+                 [&]() {
+                    if (next == 200)
+                       return std::unique_ptr<int>();
+                    auto now = ++inFlight;
+                    for (auto seen = maxSeen.load(); now > seen && !maxSeen.compare_exchange_weak(seen, now);)
+                       ;
+                    return std::unique_ptr<int>(new int(next++));
+                 },
+                 ParallelStage([](int &i) { return i; }),
+                 SerialStage([&](int &) {
+                    ++processed;
+                    --inFlight;
+                 }, false));
+   EXPECT_EQ(200, processed);
+   EXPECT_LE(maxSeen.load(), int(maxInFlight));
+}
+
+#endif
@@ -1,7 +1,11 @@
 #include "TROOT.h"
 #include "ROOT/TFuture.hxx"
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
 
+#include <atomic>
 #include <future>
+#include <numeric>
 
 #include "gtest/gtest.h"
 
@@ -50,4 +54,68 @@ TEST(TFuture, BuildFromAsync_void)
    f.get();
 }
 
+TEST(TFuture, Then)
+{
+   auto f = Async([]() { return 2; }).Then([](int a) { return a * 3; }).Then([](int a) { return a + 1.5; });
+   ASSERT_EQ(7.5, f.get());
+
+   int a(0);
+   auto r = Async([&a]() -> int & { return a; }).Then([](int &b) -> int & { return ++b; });
+   ASSERT_EQ(&a, &(r.get()));
+   ASSERT_EQ(1, a);
+
+   std::atomic<int> calls(0);
+   auto v = Async([&calls]() { ++calls; }).Then([&calls]() { ++calls; });
+   v.get();
+   ASSERT_EQ(2, calls);
+}
+
+TEST(TFuture, ThenFromSTLFuture)
+{
+   TFuture<int> f = std::async([]() { return 1; });
+   ASSERT_EQ(2, f.Then([](int a) { return a + 1; }).get());
+}
+
+TEST(TFuture, ThenDestroyedBeforeReady)
+{
+   std::atomic<int> calls(0);
+   {
+      auto f = Async([]() { return 1; }).Then([&calls](int) { ++calls; });
+   }
+   ASSERT_EQ(1, calls);
+}
+
+TEST(TThreadExecutor, MapAsync)
+{
+   ROOT::TThreadExecutor pool;
+   auto squares = pool.MapAsync([](int a) { return a * a; }, ROOT::TSeq<int>(10));
+   auto total = pool.MapReduceAsync([]() { return 1; }, 10U, [](const std::vector<int> &v) {
+      return std::accumulate(v.begin(), v.end(), 0);
+   });
+   std::vector<int> args{1, 2, 3};
+   auto doubled = pool.MapAsync([](int a) { return 2 * a; }, args);
+   auto sum = pool.Async([](int a, int b) { return a + b; }, 1, 2);
+
+   auto squaresSum = squares.Then([](std::vector<int> v) { return std::accumulate(v.begin(), v.end(), 0); });
+   ASSERT_EQ(285, squaresSum.get());
+   ASSERT_EQ(10, total.get());
+   ASSERT_EQ((std::vector<int>{2, 4, 6}), doubled.get());
+   ASSERT_EQ(3, sum.get());
+}
+
+TEST(TThreadExecutor, MapAsyncNested)
+{
+   ROOT::TThreadExecutor pool;
+   // Tasks waiting for the asynchronous maps they start.
+   auto sums = pool.Map(
+      [&pool](int n) {
+         auto f = pool.MapAsync([](int a) { return a; }, ROOT::TSeq<int>(n));
+         auto v = f.get();
+         return std::accumulate(v.begin(), v.end(), 0);
+      },
+      ROOT::TSeq<int>(20));
+   for (int n = 0; n < 20; ++n)
+      ASSERT_EQ(n * (n - 1) / 2, sums[n]);
+}
+
 #endif
@@ -0,0 +1,48 @@
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#ifdef R__USE_IMT
+
+TEST(TPoolManager, NumaArenas)
+{
+   ROOT::EnableImplicitMT(4, ROOT::kIMTNumaArenas | ROOT::kIMTPinThreads);
+   const UInt_t nNodes = ROOT::GetImplicitMTNumaNodes();
+   ASSERT_GE(nNodes, 1u);
+   UInt_t nThreads = 0;
+   for (UInt_t node = 0; node < nNodes; ++node) {
+      EXPECT_GE(ROOT::GetImplicitMTNodePoolSize(node), 1u);
+      nThreads += ROOT::GetImplicitMTNodePoolSize(node);
+   }
+   if (nNodes > 1)
+      EXPECT_EQ(nThreads, 4u);
+   EXPECT_EQ(ROOT::GetImplicitMTCurrentNode(), -1);
+
+   // Each iteration runs once, and the iterations of a node are contiguous.
+   const unsigned nIter = 1000;
+   std::vector<std::atomic<int>> calls(nIter);
+   std::vector<Int_t> nodes(nIter, -2);
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(
+      [&](unsigned i) {
+         ++calls[i];
+         nodes[i] = ROOT::GetImplicitMTCurrentNode();
+      },
+      ROOT::TSeq<unsigned>(nIter));
+   for (unsigned i = 0; i < nIter; ++i) {
+      EXPECT_EQ(calls[i].load(), 1);
+      if (nNodes > 1) {
+         EXPECT_GE(nodes[i], 0);
+         if (i > 0)
+            EXPECT_GE(nodes[i], nodes[i - 1]);
+      }
+   }
+   ROOT::DisableImplicitMT();
+   EXPECT_EQ(ROOT::GetImplicitMTNumaNodes(), 0u);
+}
+
+#endif
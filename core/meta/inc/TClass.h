@@ -242,6 +242,8 @@ private:
    EState             fState;           //!Current 'state' of the class (Emulated,Interpreted,Loaded)
    mutable std::atomic<TVirtualStreamerInfo*>  fCurrentInfo;     //!cached current streamer info.
    mutable std::atomic<TVirtualStreamerInfo*>  fLastReadInfo;    //!cached streamer info used in the last read.
+   struct TBuiltInfos;
+   mutable std::atomic<const TBuiltInfos*>     fBuiltInfos;      //!immutable table of the compiled streamer infos, read without lock.
    TVirtualRefProxy  *fRefProxy;        //!Pointer to reference proxy if this class represents a reference
    ROOT::Detail::TSchemaRuleSet *fSchemaRules;  //! Schema evolution rules
 
@@ -326,6 +328,11 @@ private:
    TClass(const TClass& tc) = delete;
    TClass& operator=(const TClass&) = delete;
 
+   TVirtualStreamerInfo *FindBuiltInfo(Int_t version) const;
+   TVirtualStreamerInfo *FindBuiltInfoByCheckSum(UInt_t checksum) const;
+   void PublishBuiltInfo(TVirtualStreamerInfo *info, Int_t version) const;
+   void ClearBuiltInfos() const;
+
 protected:
    TVirtualStreamerInfo *FindStreamerInfo(TObjArray *arr, UInt_t checksum) const;
    void GetMissingDictionariesForBaseClasses(TCollection &result, TCollection &visited, bool recurse);
@@ -537,6 +544,9 @@ public:
    static void           RemoveClass(TClass *cl);
    static void           RemoveClassDeclId(TDictionary::DeclId_t id);
    static TClass        *GetClass(const char *name, Bool_t load = kTRUE, Bool_t silent = kFALSE);
+   static TClass        *GetClass(std::string_view name, Bool_t load = kTRUE, Bool_t silent = kFALSE);
+   static TClass        *GetClass(const TString &name, Bool_t load = kTRUE, Bool_t silent = kFALSE) { return GetClass(name.Data(), load, silent); }
+   static TClass        *GetClass(const std::string &name, Bool_t load = kTRUE, Bool_t silent = kFALSE) { return GetClass(name.c_str(), load, silent); }
    static TClass        *GetClass(const std::type_info &typeinfo, Bool_t load = kTRUE, Bool_t silent = kFALSE);
    static TClass        *GetClass(ClassInfo_t *info, Bool_t load = kTRUE, Bool_t silent = kFALSE);
    static Bool_t         GetClass(DeclId_t id, std::vector<TClass*> &classes);
@@ -65,6 +65,7 @@ public:
    virtual void Delete(Option_t *option="");
 
    using THashList::FindObject;
+   using TCollection::FindObject;
    virtual TObject   *FindObject(const char *name) const;
 
    TDictionary *Find(DeclId_t id) const;
@@ -46,6 +46,7 @@ public:
    void Delete(Option_t *option="") override;
 
    TObject   *FindObject(const TObject* obj) const override;
+   using TCollection::FindObject;
    TObject   *FindObject(const char *name) const override;
    TIterator *MakeIterator(Bool_t dir = kIterForward) const override;
 
@@ -58,6 +58,7 @@ public:
    virtual void Delete(Option_t *option="");
 
    virtual TObject   *FindObject(const TObject* obj) const;
+   using TCollection::FindObject;
    virtual TObject   *FindObject(const char *name) const;
    virtual TList     *GetListForObject(const char* name) const;
    virtual TList     *GetListForObject(const TObject* obj) const;
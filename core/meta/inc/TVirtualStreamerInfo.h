@@ -45,6 +45,7 @@ protected:
    static  Bool_t    fgCanDelete;        //True if ReadBuffer can delete object
    static  Bool_t    fgOptimize;         //True if optimization on
    static  Bool_t    fgStreamMemberWise; //True if the collections are to be stream "member-wise" (when possible).
+   static  Bool_t    fgJitStreamers;     //True if the object-wise streaming is done by just-in-time compiled functions
    static TVirtualStreamerInfo  *fgInfoFactory;
 
    TVirtualStreamerInfo(const TVirtualStreamerInfo& info);
@@ -175,6 +176,8 @@ public:
 
    static Bool_t       CanOptimize();
    static Bool_t       GetStreamMemberWise();
+   static Bool_t       GetJitStreamers();
+   static Bool_t       SetJitStreamers(Bool_t enable = kTRUE);
    static void         Optimize(Bool_t opt=kTRUE);
    static Bool_t       CanDelete();
    static void         SetCanDelete(Bool_t opt=kTRUE);
@@ -63,6 +63,7 @@ a 'using namespace std;' has been applied to and with:
 #include "TROOT.h"
 #include "TRealData.h"
 #include "TCheckHashRecursiveRemoveConsistency.h" // Private header
+#include "TClassLookupCache.h" // Private header
 #include "TStreamer.h"
 #include "TStreamerElement.h"
 #include "TVirtualStreamerInfo.h"
@@ -75,6 +76,7 @@ a 'using namespace std;' has been applied to and with:
 #include "TSchemaRuleSet.h"
 #include "TGenericClassInfo.h"
 #include "TIsAProxy.h"
+#include "ROOT/StringUtils.hxx"
 #include "TSchemaRule.h"
 #include "TSystem.h"
 #include "TThreadSlots.h"
@@ -131,6 +133,39 @@ namespace {
          fSave(ROOT::Internal::gMmallocDesc) { ROOT::Internal::gMmallocDesc = value; }
       ~TMmallocDescTemp() { ROOT::Internal::gMmallocDesc = fSave; }
    };
+
+   // Loaded classes, by the names given to TClass::GetClass and by type_info
+   // name, found without taking ROOT::gCoreMutex.
+   ROOT::Internal::TClassLookupCache &GetNameLookupCache()
+   {
+      static ROOT::Internal::TClassLookupCache *gCache = new ROOT::Internal::TClassLookupCache;
+      return *gCache;
+   }
+
+   ROOT::Internal::TClassLookupCache &GetTypeInfoLookupCache()
+   {
+      static ROOT::Internal::TClassLookupCache *gCache = new ROOT::Internal::TClassLookupCache;
+      return *gCache;
+   }
+
+   // Remember that key names cl if the class is loaded, and return cl.
+   // (kReservedLoading is set while the class is unloading.)
+   TClass *CacheLoadedClass(ROOT::Internal::TClassLookupCache &cache, const char *key, TClass *cl)
+   {
+      if (!cl || !cl->IsLoaded() || cl->TestBit(TClass::kReservedLoading))
+         return cl;
+      cache.Insert(key, cl);
+      // The class may have been unloaded meanwhile, after its entries were erased.
+      if (!cl->IsLoaded() || cl->TestBit(TClass::kReservedLoading))
+         cache.Erase(cl);
+      return cl;
+   }
+
+   void EraseFromLookupCaches(const TClass *cl)
+   {
+      GetNameLookupCache().Erase(cl);
+      GetTypeInfoLookupCache().Erase(cl);
+   }
 }
 
 std::atomic<Int_t> TClass::fgClassCount;
@@ -472,6 +507,7 @@ void TClass::RemoveClass(TClass *oldcl)
    if (!oldcl) return;
 
    R__LOCKGUARD(gInterpreterMutex);
+   EraseFromLookupCaches(oldcl);
    gROOT->GetListOfClasses()->Remove(oldcl);
    if (oldcl->GetTypeInfo()) {
       GetIdMap()->Remove(oldcl->GetTypeInfo()->name());
@@ -1028,7 +1064,7 @@ TClass::TClass() :
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
    fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(kNoInfo),
-   fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
+   fCurrentInfo(0), fLastReadInfo(0), fBuiltInfos(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
 
 {
@@ -1066,7 +1102,7 @@ TClass::TClass(const char *name, Bool_t silent) :
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
    fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(kNoInfo),
-   fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
+   fCurrentInfo(0), fLastReadInfo(0), fBuiltInfos(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
 {
    R__LOCKGUARD(gInterpreterMutex);
@@ -1113,7 +1149,7 @@ TClass::TClass(const char *name, Version_t cversion, Bool_t silent) :
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
    fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(kNoInfo),
-   fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
+   fCurrentInfo(0), fLastReadInfo(0), fBuiltInfos(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
 {
    R__LOCKGUARD(gInterpreterMutex);
@@ -1140,7 +1176,7 @@ TClass::TClass(const char *name, Version_t cversion, EState theState, Bool_t sil
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
    fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(theState),
-   fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
+   fCurrentInfo(0), fLastReadInfo(0), fBuiltInfos(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
 {
    R__LOCKGUARD(gInterpreterMutex);
@@ -1184,7 +1220,7 @@ TClass::TClass(ClassInfo_t *classInfo, Version_t cversion,
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
    fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(kNoInfo),
-   fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
+   fCurrentInfo(0), fLastReadInfo(0), fBuiltInfos(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
 {
    R__LOCKGUARD(gInterpreterMutex);
@@ -1234,7 +1270,7 @@ TClass::TClass(const char *name, Version_t cversion,
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
    fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(kNoInfo),
-   fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
+   fCurrentInfo(0), fLastReadInfo(0), fBuiltInfos(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
 {
    R__LOCKGUARD(gInterpreterMutex);
@@ -1265,7 +1301,7 @@ TClass::TClass(const char *name, Version_t cversion,
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
    fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(kHasTClassInit),
-   fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
+   fCurrentInfo(0), fLastReadInfo(0), fBuiltInfos(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
 {
    R__LOCKGUARD(gInterpreterMutex);
@@ -1293,6 +1329,7 @@ void TClass::ForceReload (TClass* oldcl)
       fStreamerInfo->AddAtAndExpand(info,info->GetClassVersion());
    }
    oldcl->fStreamerInfo->Clear();
+   oldcl->ClearBuiltInfos();
 
    oldcl->ReplaceWith(this);
    delete oldcl;
@@ -1368,6 +1405,7 @@ void TClass::Init(const char *name, Version_t cversion,
          fStreamerInfo->AddAtAndExpand(info,info->GetClassVersion());
       }
       oldcl->fStreamerInfo->Clear();
+      oldcl->ClearBuiltInfos();
       // The code diverges here from ForceReload.
 
       // Move the Schema Rules too.
@@ -1569,6 +1607,27 @@ void TClass::Init(const char *name, Version_t cversion,
    ResetBit(kLoading);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Table of the compiled streamer infos of a TClass. A table is never
+/// modified once published in fBuiltInfos: a new table replaces it, and the
+/// replaced ones are kept, through fPrevious, until the TClass is deleted,
+/// since a concurrent lookup may still be reading them.
+
+struct TClass::TBuiltInfos {
+   struct TEntry {
+      TVirtualStreamerInfo *fInfo;
+      Int_t                 fVersion;    // Version it was requested as, kNoVersion if found by checksum
+      UInt_t                fCheckSum;
+   };
+   enum { kNoVersion = -1000 };
+
+   std::vector<TEntry> fEntries;
+   const TBuiltInfos  *fPrevious;
+
+   TBuiltInfos(const TBuiltInfos *previous) : fPrevious(previous) {}
+   ~TBuiltInfos() { delete fPrevious; }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TClass dtor. Deletes all list that might have been created.
 
@@ -1576,6 +1635,8 @@ TClass::~TClass()
 {
    R__LOCKGUARD(gInterpreterMutex);
 
+   EraseFromLookupCaches(this);
+
    // Remove from the typedef hashtables.
    if (fgClassTypedefHash && TestBit (kHasNameMapNode)) {
       TString resolvedThis = TClassEdit::ResolveTypedef (GetName(), kTRUE);
@@ -1625,6 +1686,7 @@ TClass::~TClass()
    if (fStreamerInfo)
       fStreamerInfo->Delete();
    delete fStreamerInfo; fStreamerInfo = nullptr;
+   delete fBuiltInfos.load(); fBuiltInfos = nullptr;
 
    if (fDeclFileLine >= -1)
       TClass::RemoveClass(this);
@@ -2894,6 +2956,10 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 
    if (!gROOT->GetListOfClasses())  return 0;
 
+   // The classes already found under this name are returned without locking.
+   auto &lookupCache = GetNameLookupCache();
+   if (TClass *cached = lookupCache.Find(name)) return cached;
+
    // FindObject will take the read lock before actually getting the
    // TClass pointer so we will need not get a partially initialized
    // object.
@@ -2901,7 +2967,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 
    // Early return to release the lock without having to execute the
    // long-ish normalization.
-   if (cl && (cl->IsLoaded() || cl->TestBit(kUnloading))) return cl;
+   if (cl && (cl->IsLoaded() || cl->TestBit(kUnloading))) return CacheLoadedClass(lookupCache, name, cl);
 
    R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -2943,7 +3009,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
       TClass *loadedcl = (dict)();
       if (loadedcl) {
          loadedcl->PostLoadCheck();
-         return loadedcl;
+         return CacheLoadedClass(lookupCache, name, loadedcl);
       }
 
       // We should really not fall through to here, but if we do, let's just
@@ -2962,7 +3028,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
          cl = (TClass*)gROOT->GetListOfClasses()->FindObject(normalizedName.c_str());
 
          if (cl) {
-            if (cl->IsLoaded() || cl->TestBit(kUnloading)) return cl;
+            if (cl->IsLoaded() || cl->TestBit(kUnloading)) return CacheLoadedClass(lookupCache, name, cl);
 
             //we may pass here in case of a dummy class created by TVirtualStreamerInfo
             load = kTRUE;
@@ -3012,11 +3078,11 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
          }
       }
    }
-   if (loadedcl) return loadedcl;
+   if (loadedcl) return CacheLoadedClass(lookupCache, name, loadedcl);
 
    // See if the TClassGenerator can produce the TClass we need.
    loadedcl = LoadClassCustom(normalizedName.c_str(),silent);
-   if (loadedcl) return loadedcl;
+   if (loadedcl) return CacheLoadedClass(lookupCache, name, loadedcl);
 
    // We have not been able to find a loaded TClass, return the Emulated
    // TClass if we have one.
@@ -3099,6 +3165,17 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
    return nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return pointer to class with name, given as a string_view.
+/// The name is copied to a buffer on the stack to be passed to
+/// GetClass(const char*), without any allocation for the usual names.
+
+TClass *TClass::GetClass(std::string_view name, Bool_t load, Bool_t silent)
+{
+   ROOT::Internal::TNullTerminatedString cname(name);
+   return GetClass(cname.c_str(), load, silent);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return pointer to class with name.
 
@@ -3107,12 +3184,16 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    if (!gROOT->GetListOfClasses())
       return 0;
 
+   // The classes already found for this type are returned without locking.
+   auto &lookupCache = GetTypeInfoLookupCache();
+   if (TClass *cached = lookupCache.Find(typeinfo.name())) return cached;
+
    //protect access to TROOT::GetIdMap
    R__READ_LOCKGUARD(ROOT::gCoreMutex);
 
    TClass* cl = GetIdMap()->Find(typeinfo.name());
 
-   if (cl && cl->IsLoaded()) return cl;
+   if (cl && cl->IsLoaded()) return CacheLoadedClass(lookupCache, typeinfo.name(), cl);
 
    R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -3122,7 +3203,7 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    cl = GetIdMap()->Find(typeinfo.name());
 
    if (cl) {
-      if (cl->IsLoaded()) return cl;
+      if (cl->IsLoaded()) return CacheLoadedClass(lookupCache, typeinfo.name(), cl);
       //we may pass here in case of a dummy class created by TVirtualStreamerInfo
       load = kTRUE;
    } else {
@@ -3144,7 +3225,7 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    if (dict) {
       cl = (dict)();
       if (cl) cl->PostLoadCheck();
-      return cl;
+      return CacheLoadedClass(lookupCache, typeinfo.name(), cl);
    }
    if (cl) return cl;
 
@@ -4423,6 +4504,10 @@ TVirtualStreamerInfo* TClass::GetStreamerInfo(Int_t version /* = 0 */) const
    if (sinfo && sinfo->GetClassVersion() == version)
       return sinfo;
 
+   // The infos already built are found without taking the lock.
+   if ((sinfo = FindBuiltInfo(version)))
+      return sinfo;
+
    // Note that the access to fClassVersion above is technically not thread-safe with a low probably of problems.
    // fClassVersion is not an atomic and is modified TClass::SetClassVersion (called from RootClassVersion via
    // ROOT::ResetClassVersion) and is 'somewhat' protected by the atomic fVersionUsed.
@@ -4449,6 +4534,7 @@ TVirtualStreamerInfo* TClass::GetStreamerInfo(Int_t version /* = 0 */) const
    }
 
    sinfo = (TVirtualStreamerInfo *)fStreamerInfo->At(version);
+   const Bool_t requested = (sinfo != nullptr);
 
    if (!sinfo && (version != fClassVersion)) {
       // When the requested version does not exist we return
@@ -4487,12 +4573,78 @@ TVirtualStreamerInfo* TClass::GetStreamerInfo(Int_t version /* = 0 */) const
       fCurrentInfo = sinfo;
 
    // If the compilation succeeded, remember this StreamerInfo.
-   if (sinfo->IsCompiled())
+   if (sinfo->IsCompiled()) {
       fLastReadInfo = sinfo;
+      // Only publish it for the version it is stored at, not as the fallback of another one.
+      if (requested || version == fClassVersion)
+         PublishBuiltInfo(sinfo, version);
+   }
 
    return sinfo;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the compiled TVirtualStreamerInfo already returned by
+/// GetStreamerInfo(version), or 0. It does not take any lock.
+
+TVirtualStreamerInfo *TClass::FindBuiltInfo(Int_t version) const
+{
+   const TBuiltInfos *table = fBuiltInfos.load(std::memory_order_acquire);
+   if (!table)
+      return nullptr;
+   for (const auto &entry : table->fEntries)
+      if (entry.fVersion == version)
+         return entry.fInfo;
+   return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the compiled TVirtualStreamerInfo with this checksum already
+/// returned by GetStreamerInfo or FindStreamerInfo, or 0. It does not take
+/// any lock.
+
+TVirtualStreamerInfo *TClass::FindBuiltInfoByCheckSum(UInt_t checksum) const
+{
+   const TBuiltInfos *table = fBuiltInfos.load(std::memory_order_acquire);
+   if (!table)
+      return nullptr;
+   for (const auto &entry : table->fEntries)
+      if (entry.fCheckSum == checksum)
+         return entry.fInfo;
+   return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make the compiled info available to FindBuiltInfo(version), or only to
+/// FindBuiltInfoByCheckSum if version is TBuiltInfos::kNoVersion.
+/// Must be called with gInterpreterMutex held.
+
+void TClass::PublishBuiltInfo(TVirtualStreamerInfo *info, Int_t version) const
+{
+   const TBuiltInfos *old = fBuiltInfos.load(std::memory_order_relaxed);
+   if (old) {
+      for (const auto &entry : old->fEntries)
+         if (entry.fInfo == info && (entry.fVersion == version || version == TBuiltInfos::kNoVersion))
+            return;
+   }
+   TBuiltInfos *table = new TBuiltInfos(old);
+   if (old)
+      table->fEntries = old->fEntries;
+   table->fEntries.push_back(TBuiltInfos::TEntry{info, version, info->GetCheckSum()});
+   fBuiltInfos.store(table, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the published infos, when the list of streamer infos changes.
+/// Must be called with gInterpreterMutex held.
+
+void TClass::ClearBuiltInfos() const
+{
+   const TBuiltInfos *old = fBuiltInfos.load(std::memory_order_relaxed);
+   if (old && !old->fEntries.empty())
+      fBuiltInfos.store(new TBuiltInfos(old), std::memory_order_release);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// For the case where the requestor class is emulated and this class is abstract,
 /// returns a pointer to the TVirtualStreamerInfo object for version with an emulated
@@ -5986,6 +6138,7 @@ void TClass::SetUnloaded()
       return;
    }
    SetBit(kUnloading);
+   EraseFromLookupCaches(this);
 
    //R__ASSERT(fState == kLoaded);
    if (fState != kLoaded) {
@@ -6705,6 +6858,9 @@ TVirtualStreamerInfo *TClass::FindStreamerInfo(UInt_t checksum) const
    } else {
       if (fCheckSum == checksum) return GetStreamerInfo();
 
+      if ((guess = FindBuiltInfoByCheckSum(checksum)))
+         return guess;
+
       R__LOCKGUARD(gInterpreterMutex);
       Int_t ninfos = fStreamerInfo->GetEntriesFast()-1;
       for (Int_t i=-1;i<ninfos;++i) {
@@ -6714,7 +6870,10 @@ TVirtualStreamerInfo *TClass::FindStreamerInfo(UInt_t checksum) const
          if (info && info->GetCheckSum() == checksum) {
             // R__ASSERT(i==info->GetClassVersion() || (i==-1&&info->GetClassVersion()==1));
             info->BuildOld();
-            if (info->IsCompiled()) fLastReadInfo = info;
+            if (info->IsCompiled()) {
+               fLastReadInfo = info;
+               PublishBuiltInfo(info, TBuiltInfos::kNoVersion);
+            }
             return info;
          }
       }
@@ -6789,6 +6948,16 @@ TVirtualStreamerInfo *TClass::GetConversionStreamerInfo( const TClass* cl, Int_t
 
    R__LOCKGUARD(gInterpreterMutex);
 
+   // Another thread may have built it while we were waiting for the lock.
+   if (fConversionStreamerInfo.load()) {
+      auto it = (*fConversionStreamerInfo).find( cl->GetName() );
+      if( it != (*fConversionStreamerInfo).end() ) {
+         arr = it->second;
+         if( version > -1 && version < arr->GetSize() && arr->At( version ) )
+            return (TVirtualStreamerInfo*) arr->At( version );
+      }
+   }
+
    //----------------------------------------------------------------------------
    // We don't have the streamer info so find it in other class
    /////////////////////////////////////////////////////////////////////////////
@@ -6891,6 +7060,17 @@ TVirtualStreamerInfo *TClass::FindConversionStreamerInfo( const TClass* cl, UInt
 
    R__LOCKGUARD(gInterpreterMutex);
 
+   // Another thread may have built it while we were waiting for the lock.
+   if (fConversionStreamerInfo.load()) {
+      auto it = (*fConversionStreamerInfo).find( cl->GetName() );
+      if( it != (*fConversionStreamerInfo).end() ) {
+         arr = it->second;
+         info = FindStreamerInfo( arr, checksum );
+         if( info )
+            return info;
+      }
+   }
+
    //----------------------------------------------------------------------------
    // Get it from the foreign class
    /////////////////////////////////////////////////////////////////////////////
@@ -6950,6 +7130,11 @@ void TClass::RegisterStreamerInfo(TVirtualStreamerInfo *info)
                "Register StreamerInfo for %s on non-empty slot (%d).",
                GetName(),slot);
       }
+      if (fStreamerInfo->GetSize() > (slot-fStreamerInfo->LowerBound())
+          && fStreamerInfo->At(slot) != 0
+          && fStreamerInfo->At(slot) != info) {
+         ClearBuiltInfos();
+      }
       fStreamerInfo->AddAtAndExpand(info, slot);
       if (fState <= kForwardDeclared) {
          fState = kEmulated;
@@ -6968,6 +7153,7 @@ void TClass::RemoveStreamerInfo(Int_t slot)
       R__LOCKGUARD(gInterpreterMutex);
       TVirtualStreamerInfo *info = (TVirtualStreamerInfo*)fStreamerInfo->At(slot);
       fStreamerInfo->RemoveAt(fClassVersion);
+      ClearBuiltInfos();
       delete info;
       if (fState == kEmulated && fStreamerInfo->GetEntries() == 0) {
          fState = kForwardDeclared;
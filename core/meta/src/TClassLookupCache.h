@@ -0,0 +1,165 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TClassLookupCache
+#define ROOT_TClassLookupCache
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class TClass;
+
+namespace ROOT {
+namespace Internal {
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TClassLookupCache                                                    //
+//                                                                      //
+// Concurrent map from the names asked to TClass::GetClass, or the      //
+// type_info names, to the loaded TClass they resolved to. The lookups  //
+// do not take any lock: the table is an open addressing hash table     //
+// whose entries are published with atomic stores, and which is         //
+// replaced by a larger copy when it fills up. The replaced tables and  //
+// the keys are kept until the cache is destroyed, so that a concurrent //
+// lookup never reads freed memory. Insert and Erase are serialized by  //
+// a mutex of the cache.                                                //
+//                                                                      //
+// An erased entry keeps its key: the TClass pointer is reset, and is   //
+// set again if the same key is inserted later on.                      //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class TClassLookupCache {
+private:
+   struct TEntry {
+      std::atomic<size_t> fHash{0}; // 0 for an empty entry, stored last
+      std::atomic<const char *> fKey{nullptr};
+      std::atomic<TClass *> fClass{nullptr};
+   };
+
+   struct TTable {
+      size_t fMask;
+      size_t fUsed = 0;
+      std::unique_ptr<TEntry[]> fEntries;
+      TTable(size_t size) : fMask(size - 1), fEntries(new TEntry[size]) {}
+   };
+
+   std::atomic<TTable *> fTable{nullptr};
+   std::vector<std::unique_ptr<TTable>> fTables; // The current one and the replaced ones
+   std::vector<std::unique_ptr<char[]>> fKeys;
+   std::mutex fWriteMutex;
+
+   static size_t Hash(const char *key)
+   {
+      // FNV-1a
+      size_t hash = 14695981039346656037ULL & ~size_t(0);
+      for (; *key; ++key)
+         hash = (hash ^ (unsigned char)*key) * (size_t)1099511628211ULL;
+      return hash ? hash : 1;
+   }
+
+   // Return the entry of key, or the empty entry where it goes.
+   static TEntry &FindEntry(TTable &table, const char *key, size_t hash)
+   {
+      for (size_t i = hash & table.fMask;; i = (i + 1) & table.fMask) {
+         TEntry &entry = table.fEntries[i];
+         const size_t entryHash = entry.fHash.load(std::memory_order_acquire);
+         if (entryHash == 0 || (entryHash == hash && strcmp(entry.fKey.load(std::memory_order_relaxed), key) == 0))
+            return entry;
+      }
+   }
+
+   static void Publish(TEntry &entry, const char *key, size_t hash, TClass *cl)
+   {
+      entry.fKey.store(key, std::memory_order_relaxed);
+      entry.fClass.store(cl, std::memory_order_relaxed);
+      entry.fHash.store(hash, std::memory_order_release);
+   }
+
+   void Grow()
+   {
+      TTable *old = fTable.load(std::memory_order_relaxed);
+      std::unique_ptr<TTable> table(new TTable(old ? 2 * (old->fMask + 1) : 1024));
+      if (old) {
+         for (size_t i = 0; i <= old->fMask; ++i) {
+            TEntry &entry = old->fEntries[i];
+            const size_t hash = entry.fHash.load(std::memory_order_relaxed);
+            if (!hash)
+               continue;
+            const char *key = entry.fKey.load(std::memory_order_relaxed);
+            Publish(FindEntry(*table, key, hash), key, hash, entry.fClass.load(std::memory_order_relaxed));
+            ++table->fUsed;
+         }
+      }
+      fTable.store(table.get(), std::memory_order_release);
+      fTables.emplace_back(std::move(table));
+   }
+
+public:
+   /// Return the TClass cached for key, or nullptr.
+   TClass *Find(const char *key) const
+   {
+      TTable *table = fTable.load(std::memory_order_acquire);
+      if (!table)
+         return nullptr;
+      const size_t hash = Hash(key);
+      for (size_t i = hash & table->fMask;; i = (i + 1) & table->fMask) {
+         const TEntry &entry = table->fEntries[i];
+         const size_t entryHash = entry.fHash.load(std::memory_order_acquire);
+         if (entryHash == 0)
+            return nullptr;
+         if (entryHash == hash && strcmp(entry.fKey.load(std::memory_order_relaxed), key) == 0)
+            return entry.fClass.load(std::memory_order_acquire);
+      }
+   }
+
+   /// Map key to cl.
+   void Insert(const char *key, TClass *cl)
+   {
+      std::lock_guard<std::mutex> lock(fWriteMutex);
+      TTable *table = fTable.load(std::memory_order_relaxed);
+      if (!table || 2 * (table->fUsed + 1) > table->fMask + 1) {
+         Grow();
+         table = fTable.load(std::memory_order_relaxed);
+      }
+      const size_t hash = Hash(key);
+      TEntry &entry = FindEntry(*table, key, hash);
+      if (entry.fHash.load(std::memory_order_relaxed)) {
+         entry.fClass.store(cl, std::memory_order_release);
+         return;
+      }
+      const size_t len = strlen(key);
+      fKeys.emplace_back(new char[len + 1]);
+      memcpy(fKeys.back().get(), key, len + 1);
+      Publish(entry, fKeys.back().get(), hash, cl);
+      ++table->fUsed;
+   }
+
+   /// Remove all the keys mapped to cl.
+   void Erase(const TClass *cl)
+   {
+      std::lock_guard<std::mutex> lock(fWriteMutex);
+      TTable *table = fTable.load(std::memory_order_relaxed);
+      if (!table)
+         return;
+      for (size_t i = 0; i <= table->fMask; ++i) {
+         TEntry &entry = table->fEntries[i];
+         if (entry.fClass.load(std::memory_order_relaxed) == cl)
+            entry.fClass.store(nullptr, std::memory_order_release);
+      }
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -28,6 +28,7 @@ TVirtualStreamerInfo *TVirtualStreamerInfo::fgInfoFactory    = 0;
 Bool_t  TVirtualStreamerInfo::fgCanDelete        = kTRUE;
 Bool_t  TVirtualStreamerInfo::fgOptimize         = kTRUE;
 Bool_t  TVirtualStreamerInfo::fgStreamMemberWise = kTRUE;
+Bool_t  TVirtualStreamerInfo::fgJitStreamers     = kFALSE;
 
 ClassImp(TVirtualStreamerInfo);
 
@@ -157,6 +158,31 @@ Bool_t TVirtualStreamerInfo::GetStreamMemberWise()
    return fgStreamMemberWise;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether the objects are streamed by functions generated and
+/// compiled just in time for each StreamerInfo, see SetJitStreamers().
+
+Bool_t TVirtualStreamerInfo::GetJitStreamers()
+{
+   return fgJitStreamers;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set whether the objects are streamed by functions generated and compiled
+/// just in time for each StreamerInfo, instead of by running its sequence of
+/// streaming actions. The functions are generated by the interpreter when a
+/// StreamerInfo is first used to stream an object; they read and write the
+/// data members of basic types directly and call the streaming actions of the
+/// other data members. The default is not to use them.
+/// This function returns the previous value of fgJitStreamers.
+
+Bool_t TVirtualStreamerInfo::SetJitStreamers(Bool_t enable)
+{
+   Bool_t prev = fgJitStreamers;
+   fgJitStreamers = enable;
+   return prev;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///  This is a static function.
 ///  Set optimization option.
@@ -0,0 +1,87 @@
+#include "../src/TClassLookupCache.h"
+#include "TClass.h"
+#include "TNamed.h"
+
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using ROOT::Internal::TClassLookupCache;
+
+// Only the addresses are used by the cache.
+static TClass *FakeClass(size_t i)
+{
+   return reinterpret_cast<TClass *>(0x1000 + 16 * i);
+}
+
+TEST(TClassLookupCache, InsertFindErase)
+{
+   TClassLookupCache cache;
+   EXPECT_EQ(cache.Find("TNamed"), nullptr);
+
+   cache.Insert("TNamed", FakeClass(1));
+   cache.Insert("vector<int>", FakeClass(2));
+   cache.Insert("std::vector<int>", FakeClass(2));
+   EXPECT_EQ(cache.Find("TNamed"), FakeClass(1));
+   EXPECT_EQ(cache.Find("vector<int>"), FakeClass(2));
+   EXPECT_EQ(cache.Find("std::vector<int>"), FakeClass(2));
+   EXPECT_EQ(cache.Find("TObject"), nullptr);
+
+   cache.Erase(FakeClass(2));
+   EXPECT_EQ(cache.Find("vector<int>"), nullptr);
+   EXPECT_EQ(cache.Find("std::vector<int>"), nullptr);
+   EXPECT_EQ(cache.Find("TNamed"), FakeClass(1));
+
+   cache.Insert("vector<int>", FakeClass(3));
+   EXPECT_EQ(cache.Find("vector<int>"), FakeClass(3));
+}
+
+TEST(TClassLookupCache, Grow)
+{
+   TClassLookupCache cache;
+   const size_t n = 10000;
+   for (size_t i = 0; i < n; ++i)
+      cache.Insert(("Class" + std::to_string(i)).c_str(), FakeClass(i));
+   for (size_t i = 0; i < n; ++i)
+      ASSERT_EQ(cache.Find(("Class" + std::to_string(i)).c_str()), FakeClass(i));
+}
+
+TEST(TClassLookupCache, ConcurrentReaders)
+{
+   TClassLookupCache cache;
+   const size_t n = 5000;
+   std::vector<std::thread> readers;
+   std::vector<size_t> errors(4, 0);
+   for (size_t t = 0; t < errors.size(); ++t) {
+      readers.emplace_back([&cache, &errors, n, t]() {
+         // An entry is either not there yet or there with its class.
+         for (size_t i = 0; i < n; ++i) {
+            TClass *cl = cache.Find(("Class" + std::to_string(i)).c_str());
+            if (cl && cl != FakeClass(i))
+               ++errors[t];
+         }
+      });
+   }
+   for (size_t i = 0; i < n; ++i)
+      cache.Insert(("Class" + std::to_string(i)).c_str(), FakeClass(i));
+   for (auto &reader : readers)
+      reader.join();
+   for (size_t nerrors : errors)
+      EXPECT_EQ(nerrors, 0u);
+}
+
+TEST(TClassLookupCache, GetClass)
+{
+   TClass *cl = TNamed::Class();
+   // The second lookups are served by the caches.
+   for (int i = 0; i < 2; ++i) {
+      EXPECT_EQ(TClass::GetClass("TNamed"), cl);
+      EXPECT_EQ(TClass::GetClass("class TNamed"), cl);
+      EXPECT_EQ(TClass::GetClass(typeid(TNamed)), cl);
+   }
+   EXPECT_EQ(TClass::GetClass("vector<int>"), TClass::GetClass("std::vector<int>"));
+   EXPECT_EQ(TClass::GetClass("NoSuchClassForTheLookupCache"), nullptr);
+}
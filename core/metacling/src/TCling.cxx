@@ -51,8 +51,10 @@ clang/LLVM technology.
 #include "TVirtualPad.h"
 #include "TSystem.h"
 #include "TVirtualMutex.h"
+#include "TStartupTracer.h"
 #include "TError.h"
 #include "TEnv.h"
+#include "TMD5.h"
 #include "TEnum.h"
 #include "TEnumConstant.h"
 #include "THashTable.h"
@@ -122,6 +124,7 @@ clang/LLVM technology.
 #include <stdexcept>
 #include <stdint.h>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -1156,6 +1159,7 @@ TCling::TCling(const char *name, const char *title)
    fClingCallbacks(0), fAutoLoadCallBack(0),
    fTransactionCount(0), fHeaderParsingOnDemand(true), fIsAutoParsingSuspended(kFALSE)
 {
+   ROOT::TStartupTracer::TScope trace("startup", "TCling::TCling");
    const bool fromRootCling = IsFromRootCling();
 
    bool useCxxModules = false;
@@ -1263,9 +1267,13 @@ TCling::TCling(const char *name, const char *title)
       }
    }
 
-   fInterpreter = new cling::Interpreter(interpArgs.size(),
-                                         &(interpArgs[0]),
-                                         llvmResourceDir);
+   {
+      // Also loads the PCH.
+      ROOT::TStartupTracer::TScope traceInterpreter("startup", "cling::Interpreter");
+      fInterpreter = new cling::Interpreter(interpArgs.size(),
+                                            &(interpArgs[0]),
+                                            llvmResourceDir);
+   }
 
    if (!fromRootCling) {
       fInterpreter->installLazyFunctionCreator(llvmLazyFunctionCreator);
@@ -1438,6 +1446,7 @@ bool TCling::LoadPCM(TString pcmFileName,
                      const char** headers,
                      void (*triggerFunc)()) const {
    // pcmFileName is an intentional copy; updated by FindFile() below.
+   ROOT::TStartupTracer::TScope trace("dictionary", "TCling::LoadPCM", pcmFileName);
 
    TString searchPath;
 
@@ -1683,6 +1692,7 @@ void TCling::RegisterModule(const char* modulename,
                             Bool_t hasCxxModule /*=false*/)
 {
    const bool fromRootCling = IsFromRootCling();
+   ROOT::TStartupTracer::TScope trace("dictionary", "TCling::RegisterModule", modulename);
    // We need the dictionary initialization but we don't want to inject the
    // declarations into the interpreter, except for those we really need for
    // I/O; see rootcling.cxx after the call to TCling__GetInterpreter().
@@ -2684,6 +2694,9 @@ bool TCling::Declare(const char* code)
 {
    R__LOCKGUARD_CLING(gInterpreterMutex);
 
+   if (DeclareFromCache(code))
+      return true;
+
    int oldload = SetClassAutoloading(0);
    SuspendAutoParsing autoParseRaii(this);
 
@@ -2700,6 +2713,76 @@ bool TCling::Declare(const char* code)
    return ret;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Declare code from the persistent declaration cache, enabled by the
+/// resource (in .rootrc)
+///
+///     Interpreter.DeclareCache: /path/to/cache
+///
+/// The code blocks of at least Interpreter.DeclareCacheMinSize bytes (1024 by
+/// default) given to Declare() are compiled by ACLiC into a library of the
+/// cache directory, named after the hash of the code, of the ROOT version and
+/// of the include paths and compilation flags. The later processes load the
+/// library instead of parsing and generating the code of the block again.
+/// A block which cannot be compiled on its own, e.g. because it uses code
+/// declared in the interpreter only, is marked as such in the cache and
+/// declared as usual. Return true if the code was declared from the cache.
+
+bool TCling::DeclareFromCache(const char* code)
+{
+   if (fInDeclareCache || IsFromRootCling() || !gEnv)
+      return false;
+   const TString cacheDir = gEnv->GetValue("Interpreter.DeclareCache", "");
+   if (cacheDir.IsNull() || strlen(code) < (size_t)gEnv->GetValue("Interpreter.DeclareCacheMinSize", 1024))
+      return false;
+
+   const std::string key = std::string(gROOT->GetVersion()) + "\n" + GetIncludePath() + "\n" +
+                           gSystem->GetIncludePath() + "\n" + gSystem->GetFlagsOpt() + "\n" + code;
+   TMD5 md5;
+   md5.Update((const UChar_t *)key.data(), key.size());
+   md5.Final();
+   const std::string entry = std::string("declare_") + md5.AsString();
+   // A second Declare() of the same code behaves as without the cache.
+   if (fDeclareCacheLoaded.count(entry))
+      return false;
+   const std::string basePath = std::string(cacheDir.Data()) + "/" + entry;
+   const std::string failedPath = basePath + ".failed";
+   if (!gSystem->AccessPathName(failedPath.c_str()))
+      return false;
+
+   ROOT::TStartupTracer::TScope trace("interpreter", "TCling::DeclareFromCache", entry.c_str());
+   const std::string sourcePath = basePath + ".C";
+   if (gSystem->AccessPathName(sourcePath.c_str())) {
+      gSystem->mkdir(cacheDir, kTRUE);
+      // Write to a temporary file first: several processes might share the cache.
+      const std::string tmpPath = sourcePath + "." + std::to_string(gSystem->GetPid());
+      {
+         std::ofstream source(tmpPath);
+         source << "// Code declared through TInterpreter::Declare, cached by ROOT " << gROOT->GetVersion() << "\n"
+                << code << "\n";
+         if (!source) {
+            source.close();
+            gSystem->Unlink(tmpPath.c_str());
+            return false;
+         }
+      }
+      if (gSystem->Rename(tmpPath.c_str(), sourcePath.c_str())) {
+         gSystem->Unlink(tmpPath.c_str());
+         return false;
+      }
+   }
+
+   fInDeclareCache = true;
+   const int compiled = gSystem->CompileMacro(sourcePath.c_str(), "kOs");
+   fInDeclareCache = false;
+   if (!compiled) {
+      std::ofstream failed(failedPath);
+      return false;
+   }
+   fDeclareCacheLoaded.insert(entry);
+   return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Enable the automatic loading of shared libraries when a class
 /// is used that is stored in a not yet loaded library. Uses the
@@ -3000,6 +3083,7 @@ Int_t TCling::Load(const char* filename, Bool_t system)
 
    // Used to return 0 on success, 1 on duplicate, -1 on failure, -2 on "fatal".
    R__LOCKGUARD_CLING(gInterpreterMutex);
+   ROOT::TStartupTracer::TScope trace("library", "TCling::Load", filename);
    cling::DynamicLibraryManager* DLM = fInterpreter->getDynamicLibraryManager();
    std::string canonLib = DLM->lookupLibrary(filename);
    cling::DynamicLibraryManager::LoadLibResult res
@@ -4884,9 +4968,6 @@ const char* TCling::TypeName(const char* typeDesc)
 
 int TCling::ReadRootmapFile(const char *rootmapfile, TUniqueString *uniqueString)
 {
-   // For "class ", "namespace ", "typedef ", "header ", "enum ", "var " respectively
-   const std::map<char, unsigned int> keyLenMap = {{'c',6},{'n',10},{'t',8},{'h',7},{'e',5},{'v',4}};
-
    if (rootmapfile && *rootmapfile) {
       std::string rootmapfileNoBackslash(rootmapfile);
 #ifdef _MSC_VER
@@ -4896,93 +4977,106 @@ int TCling::ReadRootmapFile(const char *rootmapfile, TUniqueString *uniqueString
       if (fRootmapFiles->FindObject(rootmapfileNoBackslash.c_str()))
          return -1;
 
-      if (uniqueString)
-         uniqueString->Append(std::string("\n#line 1 \"Forward declarations from ") + rootmapfileNoBackslash + "\"\n");
-
       std::ifstream file(rootmapfileNoBackslash);
-      std::string line; line.reserve(200);
-      std::string lib_name; line.reserve(100);
-      bool newFormat=false;
-      while (getline(file, line, '\n')) {
-         if (!newFormat &&
-             (line.compare(0, 8, "Library.") == 0 || line.compare(0, 8, "Declare.") == 0)) {
-            file.close();
-            return -3; // old format
-         }
-         newFormat=true;
+      return ReadRootmapStream(file, rootmapfileNoBackslash, uniqueString);
+   }
 
-         if (line.compare(0, 9, "{ decls }") == 0) {
-            // forward declarations
+   return 0;
+}
 
-            while (getline(file, line, '\n')) {
-               if (line[0] == '[') break;
-               if (!uniqueString) {
-                  Error("ReadRootmapFile", "Cannot handle \"{ decls }\" sections in custom rootmap file %s",
-                        rootmapfileNoBackslash.c_str());
-                  return -4;
-               }
-               uniqueString->Append(line);
+////////////////////////////////////////////////////////////////////////////////
+/// Parse the content of the rootmap file rootmapfile, in its new format, from
+/// file. Return the same values as ReadRootmapFile().
+
+int TCling::ReadRootmapStream(std::istream &file, const std::string &rootmapfile, TUniqueString *uniqueString)
+{
+   // For "class ", "namespace ", "typedef ", "header ", "enum ", "var " respectively
+   const std::map<char, unsigned int> keyLenMap = {{'c',6},{'n',10},{'t',8},{'h',7},{'e',5},{'v',4}};
+   ROOT::TStartupTracer::TScope trace("rootmap", "TCling::ReadRootmapFile", rootmapfile.c_str());
+
+   if (uniqueString)
+      uniqueString->Append(std::string("\n#line 1 \"Forward declarations from ") + rootmapfile + "\"\n");
+
+   std::string line; line.reserve(200);
+   std::string lib_name; line.reserve(100);
+   bool newFormat=false;
+   while (getline(file, line, '\n')) {
+      if (!newFormat &&
+          (line.compare(0, 8, "Library.") == 0 || line.compare(0, 8, "Declare.") == 0)) {
+         return -3; // old format
+      }
+      newFormat=true;
+
+      if (line.compare(0, 9, "{ decls }") == 0) {
+         // forward declarations
+
+         while (getline(file, line, '\n')) {
+            if (line[0] == '[') break;
+            if (!uniqueString) {
+               Error("ReadRootmapFile", "Cannot handle \"{ decls }\" sections in custom rootmap file %s",
+                     rootmapfile.c_str());
+               return -4;
             }
+            uniqueString->Append(line);
          }
-         const char firstChar=line[0];
-         if (firstChar == '[') {
-            // new section (library)
-            auto brpos = line.find(']');
-            if (brpos == string::npos) continue;
-            lib_name = line.substr(1, brpos-1);
-            size_t nspaces = 0;
-            while( lib_name[nspaces] == ' ' ) ++nspaces;
-            if (nspaces) lib_name.replace(0, nspaces, "");
-            if (gDebug > 3) {
-               TString lib_nameTstr(lib_name.c_str());
-               TObjArray* tokens = lib_nameTstr.Tokenize(" ");
-               const char* lib = ((TObjString *)tokens->At(0))->GetName();
-               const char* wlib = gSystem->DynamicPathName(lib, kTRUE);
-               if (wlib) {
-                  Info("ReadRootmapFile", "new section for %s", lib_nameTstr.Data());
-               }
-               else {
-                  Info("ReadRootmapFile", "section for %s (library does not exist)", lib_nameTstr.Data());
-               }
-               delete[] wlib;
-               delete tokens;
+      }
+      const char firstChar=line[0];
+      if (firstChar == '[') {
+         // new section (library)
+         auto brpos = line.find(']');
+         if (brpos == string::npos) continue;
+         lib_name = line.substr(1, brpos-1);
+         size_t nspaces = 0;
+         while( lib_name[nspaces] == ' ' ) ++nspaces;
+         if (nspaces) lib_name.replace(0, nspaces, "");
+         if (gDebug > 3) {
+            TString lib_nameTstr(lib_name.c_str());
+            TObjArray* tokens = lib_nameTstr.Tokenize(" ");
+            const char* lib = ((TObjString *)tokens->At(0))->GetName();
+            const char* wlib = gSystem->DynamicPathName(lib, kTRUE);
+            if (wlib) {
+               Info("ReadRootmapFile", "new section for %s", lib_nameTstr.Data());
             }
+            else {
+               Info("ReadRootmapFile", "section for %s (library does not exist)", lib_nameTstr.Data());
+            }
+            delete[] wlib;
+            delete tokens;
          }
-         else {
-            auto keyLenIt = keyLenMap.find(firstChar);
-            if (keyLenIt == keyLenMap.end()) continue;
-            unsigned int keyLen = keyLenIt->second;
-            // Do not make a copy, just start after the key
-            const char *keyname = line.c_str()+keyLen;
-            if (gDebug > 6)
-               Info("ReadRootmapFile", "class %s in %s", keyname, lib_name.c_str());
-            TEnvRec* isThere = fMapfile->Lookup(keyname);
-            if (isThere){
-               if(lib_name != isThere->GetValue()){ // the same key for two different libs
-                  if (firstChar == 'n') {
-                     if (gDebug > 3)
-                        Info("ReadRootmapFile", "namespace %s found in %s is already in %s",
-                           keyname, lib_name.c_str(), isThere->GetValue());
-                  } else if (firstChar == 'h'){ // it is a header: add the libname to the list of libs to be loaded.
-                     lib_name+=" ";
-                     lib_name+=isThere->GetValue();
-                     fMapfile->SetValue(keyname, lib_name.c_str());
-                  }
-                  else if (!TClassEdit::IsSTLCont(keyname)) {
-                     Warning("ReadRootmapFile", "%s %s found in %s is already in %s", line.substr(0, keyLen).c_str(),
-                           keyname, lib_name.c_str(), isThere->GetValue());
-                  }
-               } else { // the same key for the same lib
+      }
+      else {
+         auto keyLenIt = keyLenMap.find(firstChar);
+         if (keyLenIt == keyLenMap.end()) continue;
+         unsigned int keyLen = keyLenIt->second;
+         // Do not make a copy, just start after the key
+         const char *keyname = line.c_str()+keyLen;
+         if (gDebug > 6)
+            Info("ReadRootmapFile", "class %s in %s", keyname, lib_name.c_str());
+         TEnvRec* isThere = fMapfile->Lookup(keyname);
+         if (isThere){
+            if(lib_name != isThere->GetValue()){ // the same key for two different libs
+               if (firstChar == 'n') {
                   if (gDebug > 3)
-                        Info("ReadRootmapFile","Key %s was already defined for %s", keyname, lib_name.c_str());
+                     Info("ReadRootmapFile", "namespace %s found in %s is already in %s",
+                        keyname, lib_name.c_str(), isThere->GetValue());
+               } else if (firstChar == 'h'){ // it is a header: add the libname to the list of libs to be loaded.
+                  lib_name+=" ";
+                  lib_name+=isThere->GetValue();
+                  fMapfile->SetValue(keyname, lib_name.c_str());
                }
-
-            } else {
-               fMapfile->SetValue(keyname, lib_name.c_str());
+               else if (!TClassEdit::IsSTLCont(keyname)) {
+                  Warning("ReadRootmapFile", "%s %s found in %s is already in %s", line.substr(0, keyLen).c_str(),
+                        keyname, lib_name.c_str(), isThere->GetValue());
+               }
+            } else { // the same key for the same lib
+               if (gDebug > 3)
+                     Info("ReadRootmapFile","Key %s was already defined for %s", keyname, lib_name.c_str());
             }
+
+         } else {
+            fMapfile->SetValue(keyname, lib_name.c_str());
          }
       }
-      file.close();
    }
 
    return 0;
@@ -5088,6 +5182,81 @@ namespace {
    };
 }
 
+namespace {
+   // The rootmap index of a directory is the concatenation of its rootmap
+   // files, each preceded by the line "@ <size> <mtime> <name>\n", after the
+   // line kRootmapIndexHeader. It lets LoadLibraryMap() read all the rootmap
+   // files of a directory with one file read.
+   const char *kRootmapIndexName = ".rootmapdb";
+   const char *kRootmapIndexHeader = "# ROOT rootmap index 1\n";
+
+   struct TRootmapIndex {
+      struct TEntry {
+         Long64_t fSize;
+         Long_t fMtime;
+         size_t fOffset;
+      };
+      std::string fContent;
+      std::map<std::string, TEntry> fEntries;
+
+      /// Read the index of dir; return false if there is none or if it is invalid.
+      bool Read(const char *dir)
+      {
+         std::string path = std::string(dir) + "/" + kRootmapIndexName;
+         std::ifstream file(path, std::ios::binary);
+         if (!file)
+            return false;
+         file.seekg(0, std::ios::end);
+         const std::streamoff size = file.tellg();
+         if (size <= 0)
+            return false;
+         fContent.resize(size);
+         file.seekg(0);
+         if (!file.read(&fContent[0], size))
+            return false;
+         size_t pos = strlen(kRootmapIndexHeader);
+         if (fContent.compare(0, pos, kRootmapIndexHeader) != 0)
+            return false;
+         while (pos < fContent.size()) {
+            const size_t eol = fContent.find('\n', pos);
+            if (eol == std::string::npos)
+               return false;
+            std::string line = fContent.substr(pos, eol - pos);
+            long long entrySize = 0;
+            long mtime = 0;
+            int nameStart = 0;
+            if (sscanf(line.c_str(), "@ %lld %ld %n", &entrySize, &mtime, &nameStart) != 2 || !nameStart ||
+                entrySize < 0 || eol + 1 + entrySize > fContent.size())
+               return false;
+            fEntries[line.substr(nameStart)] = TEntry{entrySize, mtime, eol + 1};
+            pos = eol + 1 + entrySize;
+         }
+         return true;
+      }
+
+      /// Return the entry of the rootmap file name at path, or nullptr if it is
+      /// not in the index or if it changed since the index was written.
+      const TEntry *Find(const char *name, const char *path) const
+      {
+         auto entry = fEntries.find(name);
+         if (entry == fEntries.end())
+            return nullptr;
+         FileStat_t stat;
+         if (gSystem->GetPathInfo(path, stat) || stat.fSize != entry->second.fSize ||
+             stat.fMtime != entry->second.fMtime)
+            return nullptr;
+         return &entry->second;
+      }
+   };
+
+   /// 0: ignore the rootmap indices, 1: use them, 2: also write those which
+   /// are missing or out of date, in the writable directories.
+   Int_t GetRootmapIndexMode()
+   {
+      return gEnv ? gEnv->GetValue("Root.RootmapIndex", 1) : 1;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Load map between class and library. If rootmapfile is specified a
 /// specific rootmap file can be added (typically used by ACLiC).
@@ -5098,6 +5267,7 @@ namespace {
 Int_t TCling::LoadLibraryMap(const char* rootmapfile)
 {
    R__LOCKGUARD(gInterpreterMutex);
+   ROOT::TStartupTracer::TScope trace("rootmap", "TCling::LoadLibraryMap", rootmapfile);
    // open the [system].rootmap files
    if (!fMapfile) {
       fMapfile = new TEnv();
@@ -5125,6 +5295,7 @@ Int_t TCling::LoadLibraryMap(const char* rootmapfile)
       TObjArray* paths = ldpath.Tokenize(":");
 #endif
       TString d;
+      const Int_t indexMode = GetRootmapIndexMode();
       for (Int_t i = 0; i < paths->GetEntriesFast(); i++) {
          d = ((TObjString *)paths->At(i))->GetString();
          // check if directory already scanned
@@ -5142,18 +5313,30 @@ Int_t TCling::LoadLibraryMap(const char* rootmapfile)
                if (gDebug > 3) {
                   Info("LoadLibraryMap", "%s", d.Data());
                }
+               TRootmapIndex index;
+               const bool indexed = indexMode > 0 && index.Read(d);
+               bool outOfDate = false; // some rootmap files of d are not in its index
                const char* f1;
                while ((f1 = gSystem->GetDirEntry(dirp))) {
                   TString f = f1;
                   if (f.EndsWith(".rootmap")) {
                      TString p;
                      p = d + "/" + f;
-                     if (!gSystem->AccessPathName(p, kReadPermission)) {
+                     const TRootmapIndex::TEntry *entry = indexed ? index.Find(f, p) : nullptr;
+                     if (!entry && f != ".rootmap")
+                        outOfDate = true;
+                     if (entry || !gSystem->AccessPathName(p, kReadPermission)) {
                         if (!fRootmapFiles->FindObject(f) && f != ".rootmap") {
                            if (gDebug > 4) {
-                              Info("LoadLibraryMap", "   rootmap file: %s", p.Data());
+                              Info("LoadLibraryMap", "   rootmap file: %s%s", p.Data(), entry ? " (indexed)" : "");
+                           }
+                           Int_t ret;
+                           if (entry) {
+                              std::istringstream stream(index.fContent.substr(entry->fOffset, entry->fSize));
+                              ret = ReadRootmapStream(stream, p.Data(), &uniqueString);
+                           } else {
+                              ret = ReadRootmapFile(p,&uniqueString);
                            }
-                           Int_t ret = ReadRootmapFile(p,&uniqueString);
                            if (ret == 0)
                               fRootmapFiles->Add(new TNamed(gSystem->BaseName(f), p.Data()));
                            if (ret == -3) {
@@ -5177,6 +5360,8 @@ Int_t TCling::LoadLibraryMap(const char* rootmapfile)
                      }
                   }
                }
+               if (outOfDate && indexMode > 1 && !gSystem->AccessPathName(d, kWritePermission))
+                  WriteRootmapIndex(d);
             }
             gSystem->FreeDirectory(dirp);
          }
@@ -5204,7 +5389,11 @@ Int_t TCling::LoadLibraryMap(const char* rootmapfile)
    TEnvRec* rec;
    TIter next(fMapfile->GetTable());
    while ((rec = (TEnvRec*) next())) {
-      TString cls = rec->GetName();
+      // Only the entries of the rootmap files in the old format are processed.
+      const char *recName = rec->GetName();
+      if (strncmp(recName, "Library.", 8) && strncmp(recName, "Declare.", 8))
+         continue;
+      TString cls = recName;
       if (!strncmp(cls.Data(), "Library.", 8) && cls.Length() > 8) {
          // get the first lib from the list of lib and dependent libs
          TString libs = rec->GetValue();
@@ -5253,7 +5442,9 @@ Int_t TCling::LoadLibraryMap(const char* rootmapfile)
 
    // Process the forward declarations collected
    cling::Transaction* T = nullptr;
+   ROOT::TStartupTracer::TScope traceDecls("rootmap", "Declare forward declarations");
    auto compRes= fInterpreter->declare(uniqueString.Data(), &T);
+   traceDecls.End();
    assert(cling::Interpreter::kSuccess == compRes && "A declaration in a rootmap could not be compiled");
 
    if (compRes!=cling::Interpreter::kSuccess){
@@ -5279,6 +5470,74 @@ Int_t TCling::LoadLibraryMap(const char* rootmapfile)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write the index of the rootmap files of the directory dir, i.e. the file
+/// dir/.rootmapdb that LoadLibraryMap() reads instead of all the rootmap files
+/// of dir, which is faster in large installations and on network file systems.
+/// A rootmap file which changed since the index was written is read from the
+/// file itself. The indices can be updated automatically, in the writable
+/// directories, with the resource (in .rootrc)
+///
+///     Root.RootmapIndex: 2
+///
+/// while 0 disables them. Return the number of rootmap files in the index, or
+/// -1 in case of error.
+
+Int_t TCling::WriteRootmapIndex(const char* dir)
+{
+   void* dirp = gSystem->OpenDirectory(dir);
+   if (!dirp) {
+      Error("WriteRootmapIndex", "cannot open directory %s", dir);
+      return -1;
+   }
+   std::vector<std::string> names;
+   const char* f1;
+   while ((f1 = gSystem->GetDirEntry(dirp))) {
+      TString f = f1;
+      if (f.EndsWith(".rootmap") && f != ".rootmap")
+         names.push_back(f1);
+   }
+   gSystem->FreeDirectory(dirp);
+   std::sort(names.begin(), names.end());
+
+   std::string content = kRootmapIndexHeader;
+   Int_t nfiles = 0;
+   for (auto &name : names) {
+      std::string path = std::string(dir) + "/" + name;
+      FileStat_t stat;
+      if (gSystem->GetPathInfo(path.c_str(), stat) || !R_ISREG(stat.fMode))
+         continue;
+      std::ifstream file(path, std::ios::binary);
+      std::string rootmap((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+      if (!file || (Long64_t)rootmap.size() != stat.fSize)
+         continue; // being written, it will be read from the file
+      content += TString::Format("@ %lld %ld %s\n", (long long)stat.fSize, (long)stat.fMtime, name.c_str()).Data();
+      content += rootmap;
+      ++nfiles;
+   }
+
+   // Write a temporary file and rename it, so that the readers never see a partial index.
+   std::string index = std::string(dir) + "/" + kRootmapIndexName;
+   std::string tmp = index + TString::Format(".%d", gSystem->GetPid()).Data();
+   {
+      std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+      if (!out.write(content.data(), content.size())) {
+         Error("WriteRootmapIndex", "cannot write %s", tmp.c_str());
+         out.close();
+         gSystem->Unlink(tmp.c_str());
+         return -1;
+      }
+   }
+   if (gSystem->Rename(tmp.c_str(), index.c_str())) {
+      Error("WriteRootmapIndex", "cannot rename %s to %s", tmp.c_str(), index.c_str());
+      gSystem->Unlink(tmp.c_str());
+      return -1;
+   }
+   if (gDebug > 3)
+      Info("WriteRootmapIndex", "%d rootmap files in %s", nfiles, index.c_str());
+   return nfiles;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Scan again along the dynamic path for library maps. Entries for the loaded
 /// shared libraries are unloaded first. This can be useful after reseting
@@ -5521,6 +5780,7 @@ Int_t TCling::AutoLoad(const std::type_info& typeinfo, Bool_t knowDictNotLoaded
 Int_t TCling::AutoLoad(const char *cls, Bool_t knowDictNotLoaded /* = kFALSE */)
 {
    R__LOCKGUARD(gInterpreterMutex);
+   ROOT::TStartupTracer::TScope trace("autoload", "TCling::AutoLoad", cls);
 
    if (!knowDictNotLoaded && gClassTable->GetDictNorm(cls)) {
       // The library is already loaded as the class's dictionary is known.
@@ -5800,6 +6060,7 @@ UInt_t TCling::AutoParseImplRecurse(const char *cls, bool topLevel)
 Int_t TCling::AutoParse(const char *cls)
 {
    R__LOCKGUARD(gInterpreterMutex);
+   ROOT::TStartupTracer::TScope trace("autoload", "TCling::AutoParse", cls);
 
    if (!fHeaderParsingOnDemand || fIsAutoParsingSuspended) {
       if (fClingCallbacks->IsAutoloadingEnabled()) {
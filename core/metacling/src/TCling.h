@@ -26,6 +26,7 @@
 
 #include "TInterpreter.h"
 
+#include <iosfwd>
 #include <set>
 #include <unordered_set>
 #include <unordered_map>
@@ -104,6 +105,8 @@ private: // Data Members
    std::map<size_t,std::vector<const char*>> fClassesHeadersMap; // Map of classes hashes and headers associated
    std::map<const cling::Transaction*,size_t> fTransactionHeadersMap; // Map which transaction contains which autoparse.
    std::set<size_t> fLookedUpClasses; // Set of classes for which headers were looked up already
+   std::set<std::string> fDeclareCacheLoaded; // Entries of the declaration cache loaded by Declare()
+   bool fInDeclareCache = false;      // Whether Declare() is compiling or loading a cache entry
    std::set<size_t> fPayloads; // Set of payloads
    std::set<const char*> fParsedPayloadsAddresses; // Set of payloads which were parsed
    std::hash<std::string> fStringHashFunction; // A simple hashing function
@@ -207,6 +210,7 @@ public: // Public Interface
    Int_t   ReloadAllSharedLibraryMaps();
    Int_t   UnloadAllSharedLibraryMaps();
    Int_t   UnloadLibraryMap(const char* library);
+   Int_t   WriteRootmapIndex(const char* dir);
    Long_t  ProcessLine(const char* line, EErrorCode* error = 0);
    Long_t  ProcessLineAsynch(const char* line, EErrorCode* error = 0);
    Long_t  ProcessLineSynch(const char* line, EErrorCode* error = 0);
@@ -562,6 +566,8 @@ private: // Private Utility Functions and Classes
                 void (*triggerFunc)()) const;
    void InitRootmapFile(const char *name);
    int  ReadRootmapFile(const char *rootmapfile, TUniqueString* uniqueString = nullptr);
+   int  ReadRootmapStream(std::istream &file, const std::string &rootmapfile, TUniqueString* uniqueString);
+   bool DeclareFromCache(const char* code);
    Bool_t HandleNewTransaction(const cling::Transaction &T);
    void UnloadClassMembers(TClass* cl, const clang::DeclContext* DC);
 
@@ -0,0 +1,40 @@
+#include "TInterpreter.h"
+#include "TSystem.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+static std::string ReadFile(const std::string &path)
+{
+   std::ifstream file(path);
+   std::stringstream content;
+   content << file.rdbuf();
+   return content.str();
+}
+
+TEST(TClingRootmapIndex, Write)
+{
+   std::string dir = std::string(gSystem->TempDirectory()) + "/TClingRootmapIndex" + std::to_string(gSystem->GetPid());
+   ASSERT_EQ(gSystem->mkdir(dir.c_str(), kTRUE), 0);
+   const std::string first = "[ libFirst.so ]\nclass FirstIndexedClass\n";
+   const std::string second = "{ decls }\nclass SecondIndexedClass;\n\n[ libSecond.so ]\nclass SecondIndexedClass\n";
+   std::ofstream(dir + "/first.rootmap") << first;
+   std::ofstream(dir + "/second.rootmap") << second;
+   std::ofstream(dir + "/notarootmap.txt") << "class NotIndexed\n";
+
+   EXPECT_EQ(gInterpreter->WriteRootmapIndex(dir.c_str()), 2);
+   const std::string index = ReadFile(dir + "/.rootmapdb");
+   EXPECT_EQ(index.find("# ROOT rootmap index 1\n"), 0u);
+   EXPECT_NE(index.find(" first.rootmap\n" + first), std::string::npos);
+   EXPECT_NE(index.find(" second.rootmap\n" + second), std::string::npos);
+   EXPECT_EQ(index.find("NotIndexed"), std::string::npos);
+
+   EXPECT_EQ(gInterpreter->WriteRootmapIndex((dir + "/nosuchdir").c_str()), -1);
+
+   for (auto name : {"/first.rootmap", "/second.rootmap", "/notarootmap.txt", "/.rootmapdb"})
+      gSystem->Unlink((dir + name).c_str());
+   gSystem->Unlink(dir.c_str());
+}
@@ -50,8 +50,13 @@ int MPSend(TSocket *s, unsigned code, T obj);
 template < class T, typename std::enable_if < std::is_pointer<T>::value  &&std::is_constructible<TObject *, T>::value >::type * = nullptr >
 int MPSend(TSocket *s, unsigned code, T obj);
 
+int MPSendBuf(TSocket *s, unsigned code, TBufferFile &objBuf);
+
 MPCodeBufPair MPRecv(TSocket *s);
 
+void MPSetShmThreshold(Long64_t bytes);
+Long64_t MPGetShmThreshold();
+
 
 //this version reads classes from the message
 template<class T, typename std::enable_if<std::is_class<T>::value>::type * = nullptr>
@@ -83,6 +88,7 @@ T ReadBuffer(TBufferFile *buf);
 /// cling can be sent using MPSend(). User-defined types can be made available to
 /// cling via a call like `gSystem->ProcessLine("#include \"header.h\"")`.
 /// Pointer types cannot be sent via MPSend() (with the exception of const char*).
+/// Large objects are passed through shared memory, see MPSendBuf().
 /// \param s a pointer to a valid TSocket. No validity checks are performed\n
 /// \param code the code to be sent
 /// \param obj the object to be sent
@@ -97,11 +103,7 @@ int MPSend(TSocket *s, unsigned code, T obj)
    }
    TBufferFile objBuf(TBuffer::kWrite);
    objBuf.WriteObjectAny(&obj, c);
-   TBufferFile wBuf(TBuffer::kWrite);
-   wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   return MPSendBuf(s, code, objBuf);
 }
 
 /// \cond
@@ -132,18 +134,10 @@ int MPSend(TSocket *s, unsigned code, T obj)
 template < class T, typename std::enable_if < std::is_pointer<T>::value && std::is_constructible<TObject *, T>::value >::type * >
 int MPSend(TSocket *s, unsigned code, T obj)
 {
-   //find out the size of the object
    TBufferFile objBuf(TBuffer::kWrite);
    if(obj != nullptr)
       objBuf.WriteObjectAny(obj, obj->IsA());
-
-   //write everything together in a buffer
-   TBufferFile wBuf(TBuffer::kWrite);
-   wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   if(objBuf.Length())
-      wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   return MPSendBuf(s, code, objBuf);
 }
 
 /// \endcond
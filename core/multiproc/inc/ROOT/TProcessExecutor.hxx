@@ -26,6 +26,7 @@
 #include "ROOT/TExecutor.hxx"
 #include "TMPWorkerExecutor.h"
 #include <algorithm> //std::generate
+#include <cstddef> //std::nullptr_t
 #include <numeric> //std::iota
 #include <string>
 #include <type_traits> //std::result_of, std::enable_if
@@ -64,7 +65,10 @@ public:
    template<class T, class R> T Reduce(const std::vector<T> &objs, R redfunc);
 
 private:
-   template<class T> void Collect(std::vector<T> &reslist);
+   template<class T> void Collect(std::vector<T> &reslist) { Collect(reslist, nullptr); }
+   template<class T, class R> void Collect(std::vector<T> &reslist, R redfunc);
+   template<class T> static void PartialReduce(std::vector<T> &, std::nullptr_t) {}
+   template<class T, class R> static void PartialReduce(std::vector<T> &reslist, R redfunc);
    template<class T> void HandlePoolCode(MPCodeBufPair &msg, TSocket *sender, std::vector<T> &reslist);
 
    void Reset();
@@ -223,8 +227,8 @@ auto TProcessExecutor::MapReduce(F func, unsigned nTimes, R redfunc) -> typename
    reslist.reserve(fNToProcess);
    fNProcessed = Broadcast(MPCode::kExecFunc, fNToProcess);
 
-   //collect results/give workers their next task
-   Collect(reslist);
+   //collect results/give workers their next task, reducing the results as they arrive
+   Collect(reslist, redfunc);
 
    //clean-up and return
    ReapWorkers();
@@ -267,8 +271,8 @@ auto TProcessExecutor::MapReduce(F func, std::vector<T> &args, R redfunc) -> typ
    std::iota(range.begin(), range.end(), 0);
    fNProcessed = Broadcast(MPCode::kExecFuncWithArg, range);
 
-   //collect results/give workers their next task
-   Collect(reslist);
+   //collect results/give workers their next task, reducing the results as they arrive
+   Collect(reslist, redfunc);
 
    ReapWorkers();
    fTaskType= ETask::kNoTask;
@@ -313,12 +317,28 @@ void TProcessExecutor::HandlePoolCode(MPCodeBufPair &msg, TSocket *s, std::vecto
    }
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// Replace the results received so far by their reduction with redfunc,
+/// so that merging proceeds while the other workers are still running.
+template<class T, class R>
+void TProcessExecutor::PartialReduce(std::vector<T> &reslist, R redfunc)
+{
+   if (reslist.size() < 2)
+      return;
+   using ORIGINAL = decltype(redfunc(reslist));
+   T reduced = ROOT::Internal::PoolUtils::ResultCaster<ORIGINAL, T>::CastIfNeeded(redfunc(reslist));
+   reslist.clear();
+   reslist.push_back(std::move(reduced));
+}
+
 //////////////////////////////////////////////////////////////////////////
 /// Listen for messages sent by the workers and call the appropriate handler function.
 /// TProcessExecutor::HandlePoolCode is called on messages with a code < 1000 and
 /// TMPClient::HandleMPCode is called on messages with a code >= 1000.
-template<class T>
-void TProcessExecutor::Collect(std::vector<T> &reslist)
+/// If redfunc is not null, the results are reduced as soon as two of them
+/// have been received, see PartialReduce.
+template<class T, class R>
+void TProcessExecutor::Collect(std::vector<T> &reslist, R redfunc)
 {
    TMonitor &mon = GetMonitor();
    mon.ActivateAll();
@@ -328,9 +348,10 @@ void TProcessExecutor::Collect(std::vector<T> &reslist)
       if (msg.first == MPCode::kRecvError) {
          Error("TProcessExecutor::Collect", "[E][C] Lost connection to a worker");
          Remove(s);
-      } else if (msg.first < 1000)
+      } else if (msg.first < 1000) {
          HandlePoolCode(msg, s, reslist);
-      else
+         PartialReduce(reslist, redfunc);
+      } else
          HandleMPCode(msg, s);
    }
 }
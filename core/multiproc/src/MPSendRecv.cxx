@@ -11,8 +11,97 @@
  
 #include "MPSendRecv.h"
 #include "TBufferFile.h"
+#include "TEnv.h"
+#include "TSystem.h"
 #include "MPCode.h"
+#include <atomic>
+#include <fcntl.h> //open
 #include <memory> //unique_ptr
+#include <string>
+#include <sys/mman.h> //mmap
+#include <sys/stat.h>
+#include <unistd.h> //write, unlink
+#include <vector>
+
+namespace {
+
+// Flag of the size field of the messages whose object is in a shared memory
+// segment rather than in the message. The message then contains the size of
+// the object and the path of the segment.
+const ULong_t kShmFlag = ~(ULong_t(-1) >> 1);
+
+// -2 until read from the resource MP.ShmThreshold
+std::atomic<Long64_t> gShmThreshold(-2);
+
+//////////////////////////////////////////////////////////////////////////
+/// Copy size bytes of buf to a new file of a memory-backed file system
+/// (/dev/shm if available, the temporary directory otherwise).
+/// Return its path, or an empty string in case of failure.
+std::string WriteShmSegment(const char *buf, ULong_t size)
+{
+   std::string dir = gSystem->AccessPathName("/dev/shm", kWritePermission) ? gSystem->TempDirectory() : "/dev/shm";
+   std::string path = dir + "/rootmp-" + std::to_string(gSystem->GetPid()) + "-XXXXXX";
+   std::vector<char> pathBuf(path.begin(), path.end());
+   pathBuf.push_back('\0');
+   int fd = mkstemp(pathBuf.data());
+   if (fd < 0)
+      return "";
+   ULong_t written = 0;
+   while (written < size) {
+      ssize_t n = write(fd, buf + written, size - written);
+      if (n <= 0)
+         break;
+      written += n;
+   }
+   close(fd);
+   if (written < size) {
+      unlink(pathBuf.data());
+      return "";
+   }
+   return pathBuf.data();
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// A TBufferFile reading a shared memory segment mapped in memory,
+/// unmapped when the buffer is deleted.
+class TMPShmBuffer : public TBufferFile {
+   void *fAddress;
+   size_t fSize;
+
+public:
+   TMPShmBuffer(void *address, size_t size)
+      : TBufferFile(TBuffer::kRead, size, address, false), fAddress(address), fSize(size)
+   {
+   }
+   ~TMPShmBuffer() { munmap(fAddress, fSize); }
+};
+
+//////////////////////////////////////////////////////////////////////////
+/// Map the shared memory segment described by handle; the file of the
+/// segment is removed, the memory is released with the returned buffer.
+TBufferFile *MapShmSegment(TBufferFile &handle)
+{
+   ULong_t size;
+   handle.ReadULong(size);
+   std::vector<char> path(handle.BufferSize());
+   handle.ReadString(path.data(), path.size());
+   int fd = open(path.data(), O_RDONLY);
+   unlink(path.data());
+   if (fd < 0) {
+      Error("MPRecv", "[E] Could not open the shared memory segment %s", path.data());
+      return nullptr;
+   }
+   // Private: the buffer may write in the pages it reads, it does not change the segment.
+   void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (address == MAP_FAILED) {
+      Error("MPRecv", "[E] Could not map the shared memory segment %s", path.data());
+      return nullptr;
+   }
+   return new TMPShmBuffer(address, size);
+}
+
+} // anonymous namespace
 
 //////////////////////////////////////////////////////////////////////////
 /// Send a message with the specified code on the specified socket.
@@ -38,6 +127,72 @@ int MPSend(TSocket *s, unsigned code)
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+/// Send a message with a code and the serialized object objBuf to socket s.
+/// An object of at least MPGetShmThreshold() bytes is copied to a shared
+/// memory segment, and only the handle of the segment is sent: the receiver
+/// maps the segment instead of reading the object from the socket. Otherwise
+/// the object is sent after the code, without copying it in another buffer.
+/// \param s a pointer to a valid TSocket. No validity checks are performed\n
+/// \param code the code to be sent
+/// \param objBuf the buffer containing the serialized object, possibly empty
+/// \return the number of bytes sent, as per TSocket::SendRaw
+int MPSendBuf(TSocket *s, unsigned code, TBufferFile &objBuf)
+{
+   const ULong_t size = objBuf.Length();
+   const Long64_t threshold = MPGetShmThreshold();
+   TBufferFile wBuf(TBuffer::kWrite);
+   wBuf.WriteUInt(code);
+
+   std::string path;
+   if (size > 0 && threshold >= 0 && size >= (ULong64_t)threshold)
+      path = WriteShmSegment(objBuf.Buffer(), size);
+   if (!path.empty()) {
+      TBufferFile handle(TBuffer::kWrite);
+      handle.WriteULong(size);
+      handle.WriteString(path.c_str());
+      wBuf.WriteULong(handle.Length() | kShmFlag);
+      wBuf.WriteBuf(handle.Buffer(), handle.Length());
+      int nBytes = s->SendRaw(wBuf.Buffer(), wBuf.Length());
+      if (nBytes <= 0)
+         unlink(path.c_str());
+      return nBytes;
+   }
+
+   wBuf.WriteULong(size);
+   int nBytes = s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   if (nBytes <= 0 || size == 0)
+      return nBytes;
+   int nObjBytes = s->SendRaw(objBuf.Buffer(), size);
+   return nObjBytes < 0 ? nObjBytes : nBytes + nObjBytes;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Set the size, in bytes, from which MPSendBuf() passes the objects through
+/// shared memory; -1 disables it. The default is given by the resource
+/// MP.ShmThreshold, 1 MB if unset.
+void MPSetShmThreshold(Long64_t bytes)
+{
+   gShmThreshold = bytes < 0 ? -1 : bytes;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Return the size, in bytes, from which MPSendBuf() passes the objects
+/// through shared memory, or -1 if it does not.
+Long64_t MPGetShmThreshold()
+{
+   Long64_t threshold = gShmThreshold;
+   if (threshold == -2) {
+      threshold = gEnv ? gEnv->GetValue("MP.ShmThreshold", 1048576) : 1048576;
+      MPSetShmThreshold(threshold);
+      threshold = gShmThreshold;
+   }
+   return threshold;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 /// Receive message from a socket.
 /// This standalone function can be used to read a message that
@@ -49,6 +204,8 @@ int MPSend(TSocket *s, unsigned code)
 /// * non-pointer built-in types: TBufferFile::operator>> must be used\n
 /// * c-strings: TBufferFile::ReadString must be used\n
 /// * class types: TBufferFile::ReadObjectAny must be used\n
+/// If the object was passed through shared memory (see MPSendBuf()), the
+/// returned TBufferFile reads it directly from the mapped segment.\n
 /// \param s a pointer to a valid TSocket. No validity checks are performed\n
 /// \return ::MPCodeBufPair, i.e. an std::pair containing message code and (possibly) object
 MPCodeBufPair MPRecv(TSocket *s)
@@ -76,7 +233,16 @@ MPCodeBufPair MPRecv(TSocket *s)
 
    //receive object if needed
    std::unique_ptr<TBufferFile> objBuf; //defaults to nullptr
-   if (classBufSize != 0) {
+   if (classBufSize & kShmFlag) {
+      //the message contains the handle of a shared memory segment
+      classBufSize &= ~kShmFlag;
+      char *handleBuf = new char[classBufSize];
+      s->RecvRaw(handleBuf, classBufSize);
+      TBufferFile handle(TBuffer::kRead, classBufSize, handleBuf, true);
+      objBuf.reset(MapShmSegment(handle));
+      if (!objBuf)
+         return std::make_pair(MPCode::kRecvError, nullptr);
+   } else if (classBufSize != 0) {
       char *classBuf = new char[classBufSize];
       s->RecvRaw(classBuf, classBufSize);
       objBuf.reset(new TBufferFile(TBuffer::kRead, classBufSize, classBuf, true)); //the buffer is deleted by TBuffer's dtor
@@ -26,6 +26,10 @@
 #include "ROOT/TSpinMutex.hxx"
 #include "TROOT.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TTaskGroup.hxx"
+#endif
+
 class TH1;
 
 namespace ROOT {
@@ -232,6 +236,11 @@ namespace ROOT {
       /// Merge all the thread private objects. Can be called once: it does not
       /// create any new object but destroys the present bookkeping collapsing
       /// all objects into the one at slot 0.
+      ///
+      /// If the implicit multi-threading is enabled, the objects are merged
+      /// pairwise along a binary tree, the merges of each level running in
+      /// parallel: mergeFunction is then called for pairs of objects, and
+      /// must be thread safe.
       std::shared_ptr<T> Merge(TThreadedObjectUtils::MergeFunctionType<T> mergeFunction = TThreadedObjectUtils::MergeTObjects<T>)
       {
          // We do not return if we already merged.
@@ -239,7 +248,15 @@ namespace ROOT {
             Warning("TThreadedObject::Merge", "This object was already merged. Returning the previous result.");
             return fObjPointers[0];
          }
-         mergeFunction(fObjPointers[0], fObjPointers);
+         auto objs = GetObjectsToMerge();
+         if (!fObjPointers[0] && !objs.empty())
+            fObjPointers[0] = objs[0];
+#ifdef R__USE_IMT
+         if (ROOT::IsImplicitMTEnabled())
+            TreeMerge(objs, mergeFunction, false);
+         else
+#endif
+            mergeFunction(fObjPointers[0], objs);
          fIsMerged = true;
          return fObjPointers[0];
       }
@@ -248,6 +265,9 @@ namespace ROOT {
       /// does create a new instance of class T to represent the "Sum" object.
       /// This method is not thread safe: correct or acceptable behaviours
       /// depend on the nature of T and of the merging function.
+      ///
+      /// If the implicit multi-threading is enabled, the objects are merged
+      /// in parallel like in Merge, into copies of half of them.
       std::unique_ptr<T> SnapshotMerge(TThreadedObjectUtils::MergeFunctionType<T> mergeFunction = TThreadedObjectUtils::MergeTObjects<T>)
       {
          if (fIsMerged) {
@@ -256,10 +276,51 @@ namespace ROOT {
          }
          auto targetPtr = Internal::TThreadedObjectUtils::Cloner<T>::Clone(fModel.get());
          std::shared_ptr<T> targetPtrShared(targetPtr, [](T *) {});
-         mergeFunction(targetPtrShared, fObjPointers);
+         auto objs = GetObjectsToMerge();
+         objs.insert(objs.begin(), targetPtrShared);
+#ifdef R__USE_IMT
+         if (ROOT::IsImplicitMTEnabled())
+            TreeMerge(objs, mergeFunction, true);
+         else
+#endif
+            mergeFunction(targetPtrShared, objs);
          return std::unique_ptr<T>(targetPtr);
       }
 
+      /// Declare that the object of slot i is complete, for an incremental
+      /// merge: it is taken out of the slot and merged right away with the
+      /// other objects declared complete, by the threads declaring them, while
+      /// the other slots are still being filled. Merge and SnapshotMerge only
+      /// have to merge the result with the remaining slots.
+      /// A new object is created if the slot is accessed again, e.g. because
+      /// its thread is given another task.
+      void FinishSlot(unsigned i, TThreadedObjectUtils::MergeFunctionType<T> mergeFunction = TThreadedObjectUtils::MergeTObjects<T>)
+      {
+         if (i >= fObjPointers.size())
+            return;
+         std::shared_ptr<T> obj;
+         obj.swap(fObjPointers[i]);
+         while (obj) {
+            std::shared_ptr<T> other;
+            {
+               std::lock_guard<std::mutex> lg(fFinishedMutex);
+               if (!fFinished) {
+                  fFinished = std::move(obj);
+                  return;
+               }
+               other = std::move(fFinished);
+            }
+            std::vector<std::shared_ptr<T>> pair{obj, other};
+            mergeFunction(obj, pair);
+         }
+      }
+
+      /// Declare that the object of the current slot is complete, see FinishSlot.
+      void Finish(TThreadedObjectUtils::MergeFunctionType<T> mergeFunction = TThreadedObjectUtils::MergeTObjects<T>)
+      {
+         FinishSlot(GetThisSlotNumber(), mergeFunction);
+      }
+
    private:
       std::unique_ptr<T> fModel;                         ///< Use to store a "model" of the object
       std::vector<std::shared_ptr<T>> fObjPointers;      ///< A pointer per thread is kept.
@@ -268,6 +329,52 @@ namespace ROOT {
       unsigned fCurrMaxSlotIndex = 0;                    ///< The maximum slot index
       bool fIsMerged = false;                            ///< Remember if the objects have been merged already
       ROOT::TSpinMutex fThrIDSlotMutex;                  ///< Mutex to protect the ID-slot map access
+      std::shared_ptr<T> fFinished;                      ///< The merged objects of the finished slots, see FinishSlot
+      std::mutex fFinishedMutex;                         ///< Mutex to protect fFinished
+
+      /// The objects of the slots and of the finished slots.
+      std::vector<std::shared_ptr<T>> GetObjectsToMerge()
+      {
+         std::vector<std::shared_ptr<T>> objs;
+         objs.reserve(fObjPointers.size() + 1);
+         for (auto &obj : fObjPointers) {
+            if (obj)
+               objs.emplace_back(obj);
+         }
+         std::lock_guard<std::mutex> lg(fFinishedMutex);
+         if (fFinished)
+            objs.emplace_back(fFinished);
+         return objs;
+      }
+
+#ifdef R__USE_IMT
+      /// Merge the objects pairwise along a binary tree, so that the first one
+      /// ends up with the sum. The merges of a level are independent tasks.
+      /// With copyTargets, the objects but the first are left untouched: the
+      /// lowest level merges into copies of the targets.
+      static void TreeMerge(std::vector<std::shared_ptr<T>> &objs,
+                            const TThreadedObjectUtils::MergeFunctionType<T> &mergeFunction, bool copyTargets)
+      {
+         const size_t nObjs = objs.size();
+         for (size_t stride = 1; stride < nObjs; stride *= 2) {
+            auto mergePair = [&objs, &mergeFunction, copyTargets, stride](size_t i) {
+               if (copyTargets && stride == 1 && i > 0)
+                  objs[i].reset(Internal::TThreadedObjectUtils::Cloner<T>::Clone(objs[i].get()));
+               std::vector<std::shared_ptr<T>> pair{objs[i], objs[i + stride]};
+               mergeFunction(objs[i], pair);
+            };
+            if (nObjs <= 3 * stride) {
+               // A single merge at this level
+               mergePair(0);
+               continue;
+            }
+            ROOT::Experimental::TTaskGroup tg;
+            for (size_t i = 0; i + stride < nObjs; i += 2 * stride)
+               tg.Run([&mergePair, i]() { mergePair(i); });
+            tg.Wait();
+         }
+      }
+#endif
 
       /// Get the slot number for this threadID.
       unsigned GetThisSlotNumber()
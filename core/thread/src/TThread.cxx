@@ -354,6 +354,8 @@ void TThread::Init()
      gInterpreterMutex = ROOT::gCoreMutex;
      gROOTMutex = gInterpreterMutex;
    }
+   ROOT::TLockProfiler::SetLockName(gGlobalMutex, "gGlobalMutex");
+   ROOT::TLockProfiler::SetLockName(ROOT::gCoreMutex, "ROOT::gCoreMutex (gROOTMutex, gInterpreterMutex)");
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -126,3 +126,53 @@ TEST(TThreadedObject, SnapshotMerge)
    IsSameHist(*hsum1, *hsum0);
    EXPECT_TRUE(hsum1 != hsum0);
 }
+
+// Slot i is filled i + 1 times in bin i, the sum has i + 1 entries in bin i.
+static void FillSlots(ROOT::TThreadedObject<TH1F> &tto, unsigned nSlots)
+{
+   for (unsigned i = 0; i < nSlots; ++i)
+      tto.GetAtSlot(i)->Fill(i, i + 1);
+}
+
+static void CheckSum(const TH1F &h, unsigned nSlots)
+{
+   for (unsigned i = 0; i < nSlots; ++i)
+      EXPECT_DOUBLE_EQ(h.GetBinContent(i + 1), i + 1) << "bin of slot " << i;
+   EXPECT_DOUBLE_EQ(h.GetSumOfWeights(), nSlots * (nSlots + 1) / 2);
+}
+
+TEST(TThreadedObject, FinishSlot)
+{
+   TH1::AddDirectory(false);
+   const unsigned nSlots = 9;
+   ROOT::TThreadedObject<TH1F> tto("h", "h", 16, 0, 16);
+   FillSlots(tto, nSlots);
+   for (unsigned i : {3, 1, 4, 0, 5})
+      tto.FinishSlot(i);
+   EXPECT_EQ(tto.GetAtSlotUnchecked(3), nullptr);
+   EXPECT_EQ(tto.GetAtSlotUnchecked(0), nullptr);
+   CheckSum(*tto.SnapshotMerge(), nSlots);
+   CheckSum(*tto.Merge(), nSlots);
+}
+
+#ifdef R__USE_IMT
+TEST(TThreadedObject, ParallelMerge)
+{
+   TH1::AddDirectory(false);
+   ROOT::EnableImplicitMT(4);
+   for (unsigned nSlots : {1, 2, 3, 7, 8, 33}) {
+      ROOT::TThreadedObject<TH1F> tto("h", "h", 64, 0, 64);
+      FillSlots(tto, nSlots);
+      auto snapshot = tto.SnapshotMerge();
+      CheckSum(*snapshot, nSlots);
+      // The snapshot leaves the slots untouched.
+      for (unsigned i = 0; i < nSlots; ++i)
+         EXPECT_DOUBLE_EQ(tto.GetAtSlot(i)->GetSumOfWeights(), i + 1);
+      tto.FinishSlot(nSlots - 1);
+      auto merged = tto.Merge();
+      EXPECT_EQ(merged, tto.GetAtSlotUnchecked(0));
+      CheckSum(*merged, nSlots);
+   }
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -36,6 +36,7 @@
 #include "Riostream.h"
 #include "TVirtualMutex.h"
 #include "TObjArray.h"
+#include "TStartupTracer.h"
 #include <map>
 #include <algorithm>
 #include <atomic>
@@ -1363,6 +1364,7 @@ void *TUnixSystem::OpenDirectory(const char *name)
    if (helper)
       return helper->OpenDirectory(name);
 
+   ROOT::TStartupTracer::TScope trace("fs", "opendir", name);
    return UnixOpendir(name);
 }
 
@@ -1544,6 +1546,7 @@ Bool_t TUnixSystem::AccessPathName(const char *path, EAccessMode mode)
    if (helper)
       return helper->AccessPathName(path, mode);
 
+   ROOT::TStartupTracer::TScope trace("fs", "access", path);
    if (::access(StripOffProto(path, "file:"), mode) == 0)
       return kFALSE;
    GetLastErrorString() = GetError();
@@ -1623,6 +1626,7 @@ int TUnixSystem::GetPathInfo(const char *path, FileStat_t &buf)
    if (helper)
       return helper->GetPathInfo(path, buf);
 
+   ROOT::TStartupTracer::TScope trace("fs", "stat", path);
    return UnixFilestat(path, buf);
 }
 
@@ -10,6 +10,8 @@
  *************************************************************************/
 #include "Compression.h"
 
+#include <stddef.h>
+
 /**
  * These are definitions of various free functions for the C-style compression routines in ROOT.
  */
@@ -33,6 +35,19 @@ extern "C" void R__unzip(int *srcsize, unsigned char *src, int *tgtsize, unsigne
 
 extern "C" int R__unzip_header(int *srcsize, unsigned char *src, int *tgtsize);
 
+/**
+ * Trained compression dictionaries, currently only supported by the ZSTD algorithm.  A dictionary is
+ * registered once and then referred to by its identifier; the buffers compressed with it can be
+ * uncompressed by R__unzip as long as it stays registered.
+ */
+extern "C" int R__zipTrainDictionary(char *dict, int dictcapacity, const char *samples, const size_t *samplesizes, unsigned nsamples);
+
+extern "C" unsigned R__zipRegisterDictionary(const char *dict, int dictsize);
+
+extern "C" void R__zipUnregisterDictionary(unsigned dictid);
+
+extern "C" void R__zipWithDictionary(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, unsigned dictid);
+
 enum { kMAXZIPBUF = 0xffffff };
 
 #endif
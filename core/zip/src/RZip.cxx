@@ -12,6 +12,7 @@
 #include "Bits.h"
 #include "ZipLZMA.h"
 #include "ZipLZ4.h"
+#include "ZipZSTD.h"
 
 #include "zlib.h"
 
@@ -37,6 +38,7 @@ static void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigne
    R__ZipMode = 1 : ZLIB compression algorithm is used (default)
    R__ZipMode = 2 : LZMA compression algorithm is used
    R__ZipMode = 4 : LZ4  compression algorithm is used
+   R__ZipMode = 5 : ZSTD compression algorithm is used
    R__ZipMode = 0 or 3 : a very old compression algorithm is used
    (the very old algorithm is supported for backward compatibility)
    The LZMA algorithm requires the external XZ package be installed when linking
@@ -46,6 +48,10 @@ static void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigne
   The LZ4 algorithm requires the external LZ4 package to be installed when linking
   is done.  LZ4 typically has the worst compression ratios, but much faster decompression
   speeds - sometimes by an order of magnitude.
+
+  The ZSTD algorithm requires the external zstd package to be installed when linking
+  is done.  ZSTD achieves compression ratios close to ZLIB at low levels and close to
+  LZMA at high levels, while decompressing several times faster than ZLIB.
 */
 enum ROOT::ECompressionAlgorithm R__ZipMode = ROOT::ECompressionAlgorithm::kZLIB;
 
@@ -68,6 +74,8 @@ unsigned long R__crc32(unsigned long crc, const unsigned char* buf, unsigned int
 /*                      1 = zlib */
 /*                      2 = lzma */
 /*                      3 = old */
+/*                      4 = lz4 */
+/*                      5 = zstd */
 void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, ROOT::ECompressionAlgorithm compressionAlgorithm)
      /* int cxlevel;                      compression level */
 {
@@ -93,6 +101,9 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
   } else if (compressionAlgorithm == ROOT::ECompressionAlgorithm::kLZ4) {
      R__zipLZ4(cxlevel, srcsize, src, tgtsize, tgt, irep);
      return;
+  } else if (compressionAlgorithm == ROOT::ECompressionAlgorithm::kZSTD) {
+     R__zipZSTD(cxlevel, srcsize, src, tgtsize, tgt, irep);
+     return;
   } else if (compressionAlgorithm == ROOT::ECompressionAlgorithm::kOldCompressionAlgo || compressionAlgorithm == ROOT::ECompressionAlgorithm::kUseGlobalCompressionSetting) {
      R__zipOld(cxlevel, srcsize, src, tgtsize, tgt, irep);
      return;
@@ -238,6 +249,38 @@ void R__zip(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *
                            ROOT::ECompressionAlgorithm::kUseGlobalCompressionSetting);
 }
 
+/**
+ * Trained dictionaries are only implemented by the ZSTD algorithm; the buffers compressed
+ * with R__zipWithDictionary always use it.
+ */
+int R__zipTrainDictionary(char *dict, int dictcapacity, const char *samples, const size_t *samplesizes, unsigned nsamples)
+{
+   return R__trainZSTDDict(dict, dictcapacity, samples, samplesizes, nsamples);
+}
+
+unsigned R__zipRegisterDictionary(const char *dict, int dictsize)
+{
+   return R__registerZSTDDict(dict, dictsize);
+}
+
+void R__zipUnregisterDictionary(unsigned dictid)
+{
+   R__unregisterZSTDDict(dictid);
+}
+
+void R__zipWithDictionary(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, unsigned dictid)
+{
+  if (*srcsize < 1 + HDRSIZE + 1 || cxlevel <= 0) {
+     *irep = 0;
+     return;
+  }
+  if (dictid == 0) {
+     R__zipMultipleAlgorithm(cxlevel, srcsize, src, tgtsize, tgt, irep, ROOT::ECompressionAlgorithm::kZSTD);
+     return;
+  }
+  R__zipZSTDDict(cxlevel, srcsize, src, tgtsize, tgt, irep, dictid);
+}
+
 /**
  * Below are the routines for unzipping (inflating) buffers.
  */
@@ -262,10 +305,15 @@ static int is_valid_header_lz4(unsigned char *src)
    return src[0] == 'L' && src[1] == '4';
 }
 
+static int is_valid_header_zstd(unsigned char *src)
+{
+   return src[0] == 'Z' && src[1] == 'S';
+}
+
 static int is_valid_header(unsigned char *src)
 {
    return is_valid_header_zlib(src) || is_valid_header_old(src) || is_valid_header_lzma(src) ||
-          is_valid_header_lz4(src);
+          is_valid_header_lz4(src) || is_valid_header_zstd(src);
 }
 
 int R__unzip_header(int *srcsize, uch *src, int *tgtsize)
@@ -357,6 +405,9 @@ void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
   } else if (is_valid_header_lz4(src)) {
      R__unzipLZ4(srcsize, src, tgtsize, tgt, irep);
      return;
+  } else if (is_valid_header_zstd(src)) {
+     R__unzipZSTD(srcsize, src, tgtsize, tgt, irep);
+     return;
   }
 
   /* Old zlib format */
@@ -0,0 +1,27 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// NOTE: the ROOT compression libraries aren't consistently written in C++; hence the
+// #ifdef's to avoid problems with C code.
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep);
+void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep);
+
+// Trained dictionaries: buffers compressed with R__zipZSTDDict record the dictionary
+// identifier in the zstd frame; R__unzipZSTD looks it up among the registered ones.
+int R__trainZSTDDict(char *dict, int dictcapacity, const char *samples, const size_t *samplesizes, unsigned nsamples);
+unsigned R__registerZSTDDict(const char *dict, int dictsize);
+void R__unregisterZSTDDict(unsigned dictid);
+void R__zipZSTDDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, unsigned dictid);
+#ifdef __cplusplus
+}
+#endif
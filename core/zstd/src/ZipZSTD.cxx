@@ -0,0 +1,291 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ZipZSTD.h"
+// For the frame parameters of zstd versions older than 1.4, see CompressFrame.
+#define ZSTD_STATIC_LINKING_ONLY
+#include "zstd.h"
+#include "zdict.h"
+#include <stdio.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <ROOT/RConfig.h>
+
+// Header consists of:
+// - 2 byte identifier "ZS"
+// - 1 byte ZSTD major version.
+// - 3 bytes of compressed size
+// - 3 bytes of uncompressed size
+// The payload is a regular zstd frame, including its content checksum.  When a
+// trained dictionary was used the frame also carries the dictionary identifier.
+static const int kHeaderSize = 9;
+
+// Map the ROOT compression levels (1-9) onto the zstd ones (1-19): the low levels
+// are the fast ones, the high levels approach the LZMA compression ratio.
+static const int kZSTDLevels[10] = {1, 1, 2, 3, 5, 7, 9, 12, 15, 19};
+
+namespace {
+struct CCtxDeleter {
+   void operator()(ZSTD_CCtx *ctx) const { ZSTD_freeCCtx(ctx); }
+};
+struct DCtxDeleter {
+   void operator()(ZSTD_DCtx *ctx) const { ZSTD_freeDCtx(ctx); }
+};
+
+// The contexts are expensive to create; keep one per thread as baskets may be
+// compressed and uncompressed concurrently by IMT tasks.
+ZSTD_CCtx *GetCompressionContext()
+{
+   thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> ctx(ZSTD_createCCtx());
+   return ctx.get();
+}
+
+ZSTD_DCtx *GetDecompressionContext()
+{
+   thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> ctx(ZSTD_createDCtx());
+   return ctx.get();
+}
+
+// A trained dictionary, with its digested forms.  The decompression one is built
+// on registration, the compression ones lazily for each level actually used.
+struct DictEntry {
+   std::vector<char> fContent;
+   ZSTD_DDict *fDDict = nullptr;
+   std::map<int, ZSTD_CDict *> fCDicts;
+   unsigned fRefCount = 0;
+
+   ~DictEntry()
+   {
+      ZSTD_freeDDict(fDDict);
+      for (auto &cdict : fCDicts)
+         ZSTD_freeCDict(cdict.second);
+   }
+};
+
+// Registered dictionaries, keyed by their zstd identifier.  Entries are only ever
+// removed when the last owner unregisters them, so the pointers handed out below
+// stay valid while the owning branch is alive.  The registry is never destroyed:
+// branches may still unregister during the static destruction at exit.
+struct DictRegistry {
+   std::mutex fMutex;
+   std::unordered_map<unsigned, std::unique_ptr<DictEntry>> fDicts;
+};
+
+DictRegistry &GetDictRegistry()
+{
+   static DictRegistry *registry = new DictRegistry;
+   return *registry;
+}
+
+const ZSTD_DDict *FindDDict(unsigned dictid)
+{
+   DictRegistry &registry = GetDictRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   auto iter = registry.fDicts.find(dictid);
+   return iter == registry.fDicts.end() ? nullptr : iter->second->fDDict;
+}
+
+const ZSTD_CDict *FindCDict(unsigned dictid, int level)
+{
+   DictRegistry &registry = GetDictRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   auto iter = registry.fDicts.find(dictid);
+   if (iter == registry.fDicts.end())
+      return nullptr;
+   DictEntry &entry = *iter->second;
+   ZSTD_CDict *&cdict = entry.fCDicts[level];
+   if (!cdict)
+      cdict = ZSTD_createCDict(entry.fContent.data(), entry.fContent.size(), level);
+   return cdict;
+}
+
+// Compress src into a single frame carrying the content size and checksum, and the
+// dictionary identifier if cdict is not null.
+size_t CompressFrame(ZSTD_CCtx *ctx, char *tgt, size_t tgtsize, const char *src, size_t srcsize, int level,
+                     const ZSTD_CDict *cdict)
+{
+#if ZSTD_VERSION_NUMBER >= 10400
+   ZSTD_CCtx_reset(ctx, ZSTD_reset_session_and_parameters);
+   ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, level);
+   ZSTD_CCtx_setParameter(ctx, ZSTD_c_checksumFlag, 1);
+   if (cdict)
+      ZSTD_CCtx_refCDict(ctx, cdict);
+   return ZSTD_compress2(ctx, tgt, tgtsize, src, srcsize);
+#else
+   // The frame parameters are only exposed by the experimental API.
+   ZSTD_frameParameters fParams = {1, 1, 0}; // content size, checksum, keep the dictionary identifier
+   if (cdict)
+      return ZSTD_compress_usingCDict_advanced(ctx, tgt, tgtsize, src, srcsize, cdict, fParams);
+   ZSTD_parameters params = ZSTD_getParams(level, srcsize, 0);
+   params.fParams = fParams;
+   return ZSTD_compress_advanced(ctx, tgt, tgtsize, src, srcsize, nullptr, 0, params);
+#endif
+}
+
+void ZipZSTDImpl(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, unsigned dictid)
+{
+   *irep = 0;
+
+   if (R__unlikely(*tgtsize <= kHeaderSize)) {
+      return;
+   }
+
+   // Refuse to compress more than 16MB at a time -- we are only allowed 3 bytes for size info.
+   if (R__unlikely(*srcsize > 0xffffff || *srcsize < 0)) {
+      return;
+   }
+
+   if (cxlevel > 9) {
+      cxlevel = 9;
+   }
+   if (cxlevel < 1) {
+      cxlevel = 1;
+   }
+
+   ZSTD_CCtx *ctx = GetCompressionContext();
+   if (R__unlikely(!ctx)) {
+      return;
+   }
+   const ZSTD_CDict *cdict = nullptr;
+   if (dictid) {
+      cdict = FindCDict(dictid, kZSTDLevels[cxlevel]);
+      if (R__unlikely(!cdict)) {
+         fprintf(stderr, "R__zipZSTDDict: dictionary %u is not registered.\n", dictid);
+         return;
+      }
+   }
+   size_t returnStatus =
+      CompressFrame(ctx, &tgt[kHeaderSize], *tgtsize - kHeaderSize, src, *srcsize, kZSTDLevels[cxlevel], cdict);
+
+   // Either an error or the target buffer is too small -- in which case the caller stores the buffer uncompressed.
+   if (R__unlikely(ZSTD_isError(returnStatus) || returnStatus > 0xffffff)) {
+      return;
+   }
+
+   uint64_t in_size = (unsigned)(*srcsize);
+   uint64_t out_size = returnStatus;
+
+   tgt[0] = 'Z';
+   tgt[1] = 'S';
+   tgt[2] = ZSTD_VERSION_MAJOR;
+
+   // NOTE: these next 6 bytes are required from the ROOT compressed buffer format;
+   // upper layers will assume they are laid out in a specific manner.
+   tgt[3] = (char)(out_size & 0xff);
+   tgt[4] = (char)((out_size >> 8) & 0xff);
+   tgt[5] = (char)((out_size >> 16) & 0xff);
+
+   tgt[6] = (char)(in_size & 0xff); /* decompressed size */
+   tgt[7] = (char)((in_size >> 8) & 0xff);
+   tgt[8] = (char)((in_size >> 16) & 0xff);
+
+   *irep = (int)returnStatus + kHeaderSize;
+}
+} // namespace
+
+void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+   ZipZSTDImpl(cxlevel, srcsize, src, tgtsize, tgt, irep, 0);
+}
+
+void R__zipZSTDDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, unsigned dictid)
+{
+   ZipZSTDImpl(cxlevel, srcsize, src, tgtsize, tgt, irep, dictid);
+}
+
+void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
+{
+   // NOTE: We don't check that srcsize / tgtsize is reasonable or within the ROOT-imposed limits.
+   // This is assumed to be handled by the upper layers.
+
+   *irep = 0;
+   if (R__unlikely(src[0] != 'Z' || src[1] != 'S')) {
+      fprintf(stderr, "R__unzipZSTD: algorithm run against buffer with incorrect header (got %d%d; expected %d%d).\n",
+              src[0], src[1], 'Z', 'S');
+      return;
+   }
+
+   ZSTD_DCtx *ctx = GetDecompressionContext();
+   if (R__unlikely(!ctx)) {
+      return;
+   }
+   size_t returnStatus;
+   unsigned dictid = ZSTD_getDictID_fromFrame(&src[kHeaderSize], *srcsize - kHeaderSize);
+   if (dictid) {
+      const ZSTD_DDict *ddict = FindDDict(dictid);
+      if (R__unlikely(!ddict)) {
+         fprintf(stderr, "R__unzipZSTD: buffer was compressed with dictionary %u which is not loaded.\n", dictid);
+         return;
+      }
+      returnStatus = ZSTD_decompress_usingDDict(ctx, tgt, *tgtsize, &src[kHeaderSize], *srcsize - kHeaderSize, ddict);
+   } else {
+      returnStatus = ZSTD_decompressDCtx(ctx, tgt, *tgtsize, &src[kHeaderSize], *srcsize - kHeaderSize);
+   }
+   if (R__unlikely(ZSTD_isError(returnStatus))) {
+      fprintf(stderr, "R__unzipZSTD: error in decompression: %s (maximum output size %d).\n",
+              ZSTD_getErrorName(returnStatus), *tgtsize);
+      return;
+   }
+
+   *irep = (int)returnStatus;
+}
+
+int R__trainZSTDDict(char *dict, int dictcapacity, const char *samples, const size_t *samplesizes, unsigned nsamples)
+{
+   if (dictcapacity <= 0 || nsamples == 0) {
+      return 0;
+   }
+   size_t returnStatus = ZDICT_trainFromBuffer(dict, dictcapacity, samples, samplesizes, nsamples);
+   if (ZDICT_isError(returnStatus)) {
+      fprintf(stderr, "R__trainZSTDDict: unable to train a dictionary from %u samples: %s.\n", nsamples,
+              ZDICT_getErrorName(returnStatus));
+      return 0;
+   }
+   return (int)returnStatus;
+}
+
+unsigned R__registerZSTDDict(const char *dict, int dictsize)
+{
+   if (!dict || dictsize <= 0) {
+      return 0;
+   }
+   // Only trained dictionaries carry an identifier; raw content cannot be recognized from the frames.
+   unsigned dictid = ZSTD_getDictID_fromDict(dict, dictsize);
+   if (!dictid) {
+      return 0;
+   }
+   DictRegistry &registry = GetDictRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   std::unique_ptr<DictEntry> &entry = registry.fDicts[dictid];
+   if (!entry) {
+      entry.reset(new DictEntry);
+      entry->fContent.assign(dict, dict + dictsize);
+      entry->fDDict = ZSTD_createDDict(entry->fContent.data(), entry->fContent.size());
+      if (!entry->fDDict) {
+         registry.fDicts.erase(dictid);
+         return 0;
+      }
+   }
+   ++entry->fRefCount;
+   return dictid;
+}
+
+void R__unregisterZSTDDict(unsigned dictid)
+{
+   DictRegistry &registry = GetDictRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   auto iter = registry.fDicts.find(dictid);
+   if (iter != registry.fDicts.end() && --iter->second->fRefCount == 0) {
+      registry.fDicts.erase(iter);
+   }
+}
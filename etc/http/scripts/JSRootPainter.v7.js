@@ -3300,6 +3300,39 @@
       });
    }
 
+   TPadPainter.prototype.RedrawPadDelta = function(items, call_back) {
+      // update only display items which were modified since last snapshot
+      // each entry contains index of item in the pad and item itself
+
+      var pthis = this;
+
+      function next_item(indx) {
+         while (++indx < items.length) {
+            var snap = items[indx].snap,
+                objpainter = pthis.FindSnap(snap.fObjectID);
+
+            if (!objpainter) continue;
+
+            if (snap.fKind === 4) { // specials like list of colors
+               pthis.CheckSpecial(snap.fSnapshot);
+               continue;
+            }
+
+            if (snap.fKind === 3) // subpad
+               return objpainter.RedrawPadSnap(snap, next_item.bind(null, indx));
+
+            if ((snap.fKind === 1) && objpainter.UpdateObject(snap.fSnapshot, snap.fOption))
+               objpainter.Redraw();
+            else if ((snap.fKind === 2) && objpainter.UpdateObject(snap.fSnapshot))
+               objpainter.Redraw();
+         }
+
+         JSROOT.CallBack(call_back, pthis);
+      }
+
+      next_item(-1);
+   }
+
    TPadPainter.prototype.CreateImage = function(format, call_back) {
       if (format=="svg") {
          JSROOT.CallBack(call_back, btoa(this.CreateSvg()));
@@ -3898,6 +3931,20 @@
          this.RedrawPadSnap(snap, function() {
             handle.Send("SNAPDONE:" + snapid); // send ready message back when drawing completed
          });
+      } else if (msg.substr(0,5)=='DIFF:') {
+         // only modified items, coded as "index:json" and separated by new line
+         msg = msg.substr(5);
+         var p1 = msg.indexOf(":"),
+             snapid = msg.substr(0,p1),
+             lines = msg.substr(p1+1).split("\n"),
+             items = [];
+         for (var n=0;n<lines.length;++n) {
+            var p2 = lines[n].indexOf(":");
+            if (p2 > 0) items.push({ indx: parseInt(lines[n].substr(0,p2)), snap: JSROOT.parse(lines[n].substr(p2+1)) });
+         }
+         this.RedrawPadDelta(items, function() {
+            handle.Send("SNAPDONE:" + snapid);
+         });
       } else if (msg.substr(0,4)=='JSON') {
          var obj = JSROOT.parse(msg.substr(4));
          // console.log("get JSON ", msg.length-4, obj._typename);
@@ -46,6 +46,11 @@ public:
 
    void                 SetState(Int_t level, Int_t startlevel, Int_t nmany, Bool_t ovlp, Double_t *point=0);
    Bool_t               GetState(Int_t &level, Int_t &nmany, Double_t *point) const;
+   Int_t                GetLevel() const {return fLevel;}
+   Int_t                GetNmany() const {return fNmany;}
+   TGeoNode            *GetNode() const {return fNodeBranch[fLevel-fStart];}
+   const TGeoHMatrix   *GetMatrix() const;
+   Bool_t               IsOverlapping() const {return fOverlapping;}
 
    ClassDef(TGeoCacheState, 0)       // class storing the cache state
 };
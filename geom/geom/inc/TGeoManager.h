@@ -12,6 +12,7 @@
 #ifndef ROOT_TGeoManager
 #define ROOT_TGeoManager
 
+#include <atomic>
 #include <mutex>
 #include <thread>
 
@@ -104,6 +105,8 @@ private :
    NavigatorsMap_t       fNavigators;       //! Map between thread id's and navigator arrays
    static ThreadsMap_t  *fgThreadId;        //! Thread id's map
    static Int_t          fgNumThreads;      //! Number of registered threads
+   static std::atomic<UInt_t> fgThreadsGeneration;    //! Incremented when the thread id's map is cleared
+   static std::atomic<UInt_t> fgNavigatorsGeneration; //! Incremented when the navigators of a thread change
    static Bool_t         fgLockNavigators;   //! Lock existing navigators
    TGeoNavigator        *fCurrentNavigator; //! current navigator
    TGeoVolume           *fCurrentVolume;    //! current volume
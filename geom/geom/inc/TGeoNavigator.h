@@ -43,6 +43,11 @@ protected:
    void                  SafetyOverlaps();
 
 private :
+   enum { kNLastStates = 4 };               // number of last located states kept by FindNode
+
+   void                  StoreLastState();
+   TGeoNode             *FindInLastStates(const Double_t *point);
+
    Double_t              fStep;             //! step to be done from current point and direction
    Double_t              fSafety;           //! safety radius from current point
    Double_t              fLastSafety;       //! last computed safety radius
@@ -79,6 +84,10 @@ private :
    TGeoNode             *fNextNode;         //! next node that will be crossed
    TGeoNode             *fForcedNode;       //! current point is supposed to be inside this node
    TGeoCacheState       *fBackupState;      //! backup state
+   TGeoCacheState       *fLastStates[kNLastStates]; //! states of the last nodes located by FindNode(x,y,z)
+   Int_t                 fNLastStates;      //! number of stored last states
+   Int_t                 fLastStateIndex;   //! index of the most recent last state
+   Bool_t                fUseLastStates;    //! check first the last located nodes in FindNode(x,y,z)
    TGeoHMatrix          *fCurrentMatrix;    //! current stored global matrix
    TGeoHMatrix          *fGlobalMatrix;     //! current pointer to cached global matrix
    TGeoHMatrix          *fDivMatrix;        //! current local matrix of the selected division cell
@@ -107,14 +116,18 @@ public :
    TGeoNode              *FindNextBoundary(Double_t stepmax=TGeoShape::Big(),const char *path="", Bool_t frombdr=kFALSE);
    TGeoNode              *FindNextDaughterBoundary(Double_t *point, Double_t *dir, Int_t &idaughter, Bool_t compmatrix=kFALSE);
    TGeoNode              *FindNextBoundaryAndStep(Double_t stepmax=TGeoShape::Big(), Bool_t compsafe=kFALSE);
+   void                   FindNextBoundary_v(Int_t ntracks, const Double_t *points, const Double_t *dirs,
+                                             const Double_t *stepmax, Double_t *steps, TGeoNode **next) const;
    TGeoNode              *FindNode(Bool_t safe_start=kTRUE);
    TGeoNode              *FindNode(Double_t x, Double_t y, Double_t z);
+   void                   FindNode_v(Int_t npoints, const Double_t *points, TGeoNode **nodes);
    Double_t              *FindNormal(Bool_t forward=kTRUE);
    Double_t              *FindNormalFast();
    TGeoNode              *InitTrack(const Double_t *point, const Double_t *dir);
    TGeoNode              *InitTrack(Double_t x, Double_t y, Double_t z, Double_t nx, Double_t ny, Double_t nz);
    void                   ResetState();
    void                   ResetAll();
+   void                   ResetLastStates() {fNLastStates = 0;}
    Double_t               Safety(Bool_t inside=kFALSE);
    TGeoNode              *SearchNode(Bool_t downwards=kFALSE, const TGeoNode *skipnode=0);
    TGeoNode              *Step(Bool_t is_geom=kTRUE, Bool_t cross=kTRUE);
@@ -133,6 +146,8 @@ public :
    Bool_t                 IsSamePoint(Double_t x, Double_t y, Double_t z) const;
    Bool_t                 IsStartSafe() const {return fStartSafe;}
    void                   SetStartSafe(Bool_t flag=kTRUE)   {fStartSafe=flag;}
+   Bool_t                 IsUsingLastStates() const {return fUseLastStates;}
+   void                   SetUseLastStates(Bool_t flag=kTRUE) {fUseLastStates=flag; fNLastStates=0;}
    void                   SetStep(Double_t step) {fStep=step;}
    Bool_t                 IsCheckingOverlaps() const   {return fSearchOverlaps;}
    Bool_t                 IsCurrentOverlapping() const {return fCurrentOverlapping;}
@@ -14,6 +14,8 @@
 
 #include "TObject.h"
 
+#include <vector>
+
 class TGeoVolume;
 struct TGeoStateInfo;
 
@@ -61,11 +63,20 @@ protected:
    UChar_t          *fIndcX;          //[fNx] array of slices bits on X
    UChar_t          *fIndcY;          //[fNy] array of slices bits on Y
    UChar_t          *fIndcZ;          //[fNz] array of slices bits on Z
+   std::vector<Double_t> fBVHBounds;  //! min X,Y,Z and max X,Y,Z of the box of each BVH node
+   std::vector<Int_t>    fBVHNodes;   //! children of each BVH node, or -1-(first item) and number of items for a leaf
+   std::vector<Int_t>    fBVHItems;   //! daughter indices, ordered by BVH leaf
+
+   static Int_t      fgBVHMinDaughters;       // minimum number of daughters to use a BVH
+   static Double_t   fgBVHMinSliceCandidates; // minimum average number of candidates per slice to use a BVH
 
    TGeoVoxelFinder(const TGeoVoxelFinder&);
    TGeoVoxelFinder& operator=(const TGeoVoxelFinder&);
 
+   Int_t               BuildBVHNode(Int_t first, Int_t last, const std::vector<Double_t> &centers);
    void                BuildVoxelLimits();
+   Int_t              *GetBVHCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td) const;
+   void                GetBVHCrossed(const Double_t *point, const Double_t *dir, TGeoStateInfo &td) const;
    Int_t              *GetExtraX(Int_t islice, Bool_t left, Int_t &nextra) const;
    Int_t              *GetExtraY(Int_t islice, Bool_t left, Int_t &nextra) const;
    Int_t              *GetExtraZ(Int_t islice, Bool_t left, Int_t &nextra) const;
@@ -94,18 +105,21 @@ public :
    TGeoVoxelFinder();
    TGeoVoxelFinder(TGeoVolume *vol);
    virtual ~TGeoVoxelFinder();
+   void                BuildBVH();
    void                DaughterToMother(Int_t id, const Double_t *local, Double_t *master) const;
    virtual Double_t    Efficiency();
    virtual Int_t      *GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td);
    Int_t              *GetCheckList(Int_t &nelem, TGeoStateInfo &td) const;
    virtual Int_t      *GetNextCandidates(const Double_t *point, Int_t &ncheck, TGeoStateInfo &td);
    virtual void        FindOverlaps(Int_t inode) const;
+   Bool_t              HasBVH() const {return !fBVHNodes.empty();}
    Bool_t              IsInvalid() const {return TObject::TestBit(kGeoInvalidVoxels);}
    Bool_t              NeedRebuild() const {return TObject::TestBit(kGeoRebuildVoxels);}
    Double_t           *GetBoxes() const {return fBoxes;}
    Bool_t              IsSafeVoxel(const Double_t *point, Int_t inode, Double_t minsafe) const;
    virtual void        Print(Option_t *option="") const;
    void                PrintVoxelLimits(const Double_t *point) const;
+   static void         SetBVHLimits(Int_t mindaughters, Double_t mincandidates=8.);
    void                SetInvalid(Bool_t flag=kTRUE) {TObject::SetBit(kGeoInvalidVoxels, flag);}
    void                SetNeedRebuild(Bool_t flag=kTRUE) {TObject::SetBit(kGeoRebuildVoxels, flag);}
    virtual Int_t      *GetNextVoxel(const Double_t *point, const Double_t *dir, Int_t &ncheck, TGeoStateInfo &td);
@@ -1068,9 +1068,23 @@ void TGeoBBox::ComputeNormal_v(const Double_t *points, const Double_t *dirs, Dou
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute distance from array of input points having directions specified by dirs. Store output in dists
 
-void TGeoBBox::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t* step) const
+void TGeoBBox::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t* /*step*/) const
 {
-   for (Int_t i=0; i<vecsize; i++) dists[i] = DistFromInside(&points[3*i], &dirs[3*i], 3, step[i]);
+   // Same algorithm as DistFromInside, without branches so that the loop is vectorized
+   const Double_t par[3] = {fDX, fDY, fDZ};
+   const Double_t big = TGeoShape::Big();
+   for (Int_t i=0; i<vecsize; i++) {
+      Double_t smin = big;
+      for (Int_t j=0; j<3; j++) {
+         Double_t pt = points[3*i+j] - fOrigin[j];
+         Double_t d = dirs[3*i+j];
+         Double_t dd = (d != 0) ? d : 1.;
+         Double_t s = (d > 0) ? (par[j]-pt)/dd : (-par[j]-pt)/dd;
+         s = (d != 0) ? s : big;
+         smin = (s < smin) ? s : smin;
+      }
+      dists[i] = (smin < 0) ? 0. : smin;
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1078,7 +1092,37 @@ void TGeoBBox::DistFromInside_v(const Double_t *points, const Double_t *dirs, Do
 
 void TGeoBBox::DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t* step) const
 {
-   for (Int_t i=0; i<vecsize; i++) dists[i] = DistFromOutside(&points[3*i], &dirs[3*i], 3, step[i]);
+   // Same algorithm as DistFromOutside, without branches so that the loop is vectorized
+   const Double_t par[3] = {fDX, fDY, fDZ};
+   const Double_t big = TGeoShape::Big();
+   for (Int_t i=0; i<vecsize; i++) {
+      Double_t pt[3], d[3], saf[3];
+      Bool_t far = kFALSE;
+      Bool_t in = kTRUE;
+      Int_t j;
+      for (j=0; j<3; j++) {
+         pt[j] = points[3*i+j] - fOrigin[j];
+         d[j] = dirs[3*i+j];
+         saf[j] = TMath::Abs(pt[j]) - par[j];
+         far |= (saf[j] >= step[i]);
+         in &= (saf[j] <= 0);
+      }
+      // Point inside: 0, unless exiting through the closest face
+      Int_t jmax = (saf[1] > saf[0]) ? 1 : 0;
+      jmax = (saf[2] > saf[jmax]) ? 2 : jmax;
+      Double_t distin = (pt[jmax]*d[jmax] > 0) ? big : 0.;
+      // Point outside: the first face, in the order of the axes, crossed inside the box
+      Double_t distout = big;
+      for (j=2; j>=0; j--) {
+         Bool_t cand = (saf[j] >= 0) && (pt[j]*d[j] < 0);
+         Double_t snxt = saf[j]/(cand ? TMath::Abs(d[j]) : 1.);
+         Int_t k1 = (j+1)%3;
+         Int_t k2 = (j+2)%3;
+         cand &= (TMath::Abs(pt[k1]+snxt*d[k1]) <= par[k1]) && (TMath::Abs(pt[k2]+snxt*d[k2]) <= par[k2]);
+         distout = cand ? snxt : distout;
+      }
+      dists[i] = far ? big : (in ? distin : distout);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -584,6 +584,17 @@ void TGeoCacheState::SetState(Int_t level, Int_t startlevel, Int_t nmany, Bool_t
    if (point) memcpy(fPoint, point, 3*sizeof(Double_t));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Global matrix of the last node of the stored branch.
+
+const TGeoHMatrix *TGeoCacheState::GetMatrix() const
+{
+   // the matrices shared by consecutive levels are stored only once
+   Int_t i = fLevel-fStart;
+   while (i>0 && fMatPtr[i]==fMatPtr[i-1]) i--;
+   return fMatrixBranch[i];
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Restore a modeler state.
 
@@ -283,6 +283,12 @@ in order to enhance rays.
 #include "TGeoParallelWorld.h"
 #include "TGeoRegion.h"
 
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 // statics and globals
 
 TGeoManager *gGeoManager = 0;
@@ -298,6 +304,13 @@ Int_t  TGeoManager::fgMaxDaughters = 1;
 Int_t  TGeoManager::fgMaxXtruVert = 1;
 Int_t  TGeoManager::fgNumThreads   = 0;
 TGeoManager::ThreadsMap_t *TGeoManager::fgThreadId = 0;
+std::atomic<UInt_t> TGeoManager::fgThreadsGeneration(0);
+std::atomic<UInt_t> TGeoManager::fgNavigatorsGeneration(0);
+
+namespace {
+// protects the thread id's map, separately from the navigators booking
+std::mutex gThreadIdMutex;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor.
@@ -832,25 +845,37 @@ TGeoNavigator *TGeoManager::AddNavigator()
    }
    TGeoNavigator *nav = array->AddNavigator();
    if (fClosed) nav->GetCache()->BuildInfoBranch();
+   fgNavigatorsGeneration++;
    if (fMultiThread) fgMutex.unlock();
    return nav;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Returns current navigator for the calling thread.
+/// Returns current navigator for the calling thread. The navigator is cached
+/// in thread local storage, so that the map of navigators is only looked up
+/// (under lock) after the navigators were changed.
 
 TGeoNavigator *TGeoManager::GetCurrentNavigator() const
 {
-   TTHREAD_TLS(TGeoNavigator*) tnav = 0;
+   struct NavigatorCache_t {
+      const TGeoManager *fManager;
+      TGeoNavigator *fNavigator;
+      UInt_t fGeneration;
+   };
+   TTHREAD_TLS(NavigatorCache_t) tcache = {0, 0, 0};
    if (!fMultiThread) return fCurrentNavigator;
-   TGeoNavigator *nav = tnav; // TTHREAD_TLS_GET(TGeoNavigator*,tnav);
-   if (nav) return nav;
+   UInt_t generation = fgNavigatorsGeneration.load(std::memory_order_acquire);
+   if (tcache.fNavigator && tcache.fManager == this && tcache.fGeneration == generation) return tcache.fNavigator;
    std::thread::id threadId = std::this_thread::get_id();
+   // Other threads may be adding or removing their navigators meanwhile
+   std::lock_guard<std::mutex> guard(fgMutex);
    NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
    if (it == fNavigators.end()) return 0;
    TGeoNavigatorArray *array = it->second;
-   nav = array->GetCurrentNavigator();
-   tnav = nav; // TTHREAD_TLS_SET(TGeoNavigator*,tnav,nav);
+   TGeoNavigator *nav = array->GetCurrentNavigator();
+   tcache.fManager = this;
+   tcache.fNavigator = nav;
+   tcache.fGeneration = generation;
    return nav;
 }
 
@@ -886,6 +911,7 @@ Bool_t TGeoManager::SetCurrentNavigator(Int_t index)
       return kFALSE;
    }
    if (!fMultiThread) fCurrentNavigator = nav;
+   fgNavigatorsGeneration++;
    return kTRUE;
 }
 
@@ -910,6 +936,7 @@ void TGeoManager::ClearNavigators()
       if (arr) delete arr;
    }
    fNavigators.clear();
+   fgNavigatorsGeneration++;
    if (fMultiThread) fgMutex.unlock();
 }
 
@@ -925,6 +952,7 @@ void TGeoManager::RemoveNavigator(const TGeoNavigator *nav)
          if ((TGeoNavigator*)arr->Remove((TObject*)nav)) {
             delete nav;
             if (!arr->GetEntries()) fNavigators.erase(it);
+            fgNavigatorsGeneration++;
             if (fMultiThread) fgMutex.unlock();
             return;
          }
@@ -996,32 +1024,42 @@ void TGeoManager::CreateThreadData() const
 void TGeoManager::ClearThreadsMap()
 {
    if (gGeoManager && !gGeoManager->IsMultiThread()) return;
-   fgMutex.lock();
+   std::lock_guard<std::mutex> guard(gThreadIdMutex);
    if (!fgThreadId->empty()) fgThreadId->clear();
    fgNumThreads = 0;
-   fgMutex.unlock();
+   fgThreadsGeneration++;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Translates the current thread id to an ordinal number. This can be used to
-/// manage data which is specific for a given thread.
+/// manage data which is specific for a given thread. The ordinal number is
+/// kept in thread local storage, so that the map of threads is only looked up
+/// (under lock) the first time and after ClearThreadsMap.
 
 Int_t TGeoManager::ThreadId()
 {
-   TTHREAD_TLS(Int_t) tid = -1;
-   Int_t ttid = tid; // TTHREAD_TLS_GET(Int_t,tid);
-   if (ttid > -1) return ttid;
+   struct ThreadIdCache_t {
+      Int_t fTid;
+      UInt_t fGeneration;
+   };
+   TTHREAD_TLS(ThreadIdCache_t) tcache = {-1, 0};
+   UInt_t generation = fgThreadsGeneration.load(std::memory_order_acquire);
+   if (tcache.fTid > -1 && tcache.fGeneration == generation) return tcache.fTid;
    if (gGeoManager && !gGeoManager->IsMultiThread()) return 0;
    std::thread::id threadId = std::this_thread::get_id();
+   std::lock_guard<std::mutex> guard(gThreadIdMutex);
+   Int_t tid;
    TGeoManager::ThreadsMapIt_t it = fgThreadId->find(threadId);
-   if (it != fgThreadId->end()) return it->second;
-   // Map needs to be updated.
-   fgMutex.lock();
-   (*fgThreadId)[threadId] = fgNumThreads;
-   tid = fgNumThreads; // TTHREAD_TLS_SET(Int_t,tid,fgNumThreads);
-   ttid = fgNumThreads++;
-   fgMutex.unlock();
-   return ttid;
+   if (it != fgThreadId->end()) {
+      tid = it->second;
+   } else {
+      // Map needs to be updated.
+      tid = fgNumThreads++;
+      (*fgThreadId)[threadId] = tid;
+   }
+   tcache.fTid = tid;
+   tcache.fGeneration = generation;
+   return tid;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2899,8 +2937,26 @@ void TGeoManager::RestoreMasterVolume()
    if (fMasterVolume) SetTopVolume(fMasterVolume);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if the volume can be voxelized concurrently with the others:
+/// the assemblies and the volumes containing assemblies are not, since their
+/// bounding boxes are recomputed when voxelizing.
+
+static Bool_t CanVoxelizeConcurrently(TGeoVolume *vol)
+{
+   if (vol->IsAssembly() || vol->GetFinder()) return kFALSE;
+   Int_t nd = vol->GetNdaughters();
+   if (!nd) return kFALSE;
+   for (Int_t i=0; i<nd; i++)
+      if (vol->GetNode(i)->GetVolume()->IsAssembly()) return kFALSE;
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Voxelize all non-divided volumes.
+/// With the implicit multi-threading enabled, the volumes are voxelized
+/// concurrently. If the voxels were read from the file (geometry exported with
+/// the "v" option) only the volumes without voxels are voxelized.
 
 void TGeoManager::Voxelize(Option_t *option)
 {
@@ -2908,14 +2964,32 @@ void TGeoManager::Voxelize(Option_t *option)
 //   TGeoVoxelFinder *vox = 0;
    if (!fStreamVoxels && fgVerboseLevel>0) Info("Voxelize","Voxelizing...");
 //   Int_t nentries = fVolumes->GetSize();
+   Bool_t concurrent = kFALSE;
+#ifdef R__USE_IMT
+   concurrent = ROOT::IsImplicitMTEnabled();
+#endif
+   std::vector<TGeoVolume*> tovoxelize;
    TIter next(fVolumes);
    while ((vol = (TGeoVolume*)next())) {
       if (!fIsGeomReading) vol->SortNodes();
-      if (!fStreamVoxels) {
-         vol->Voxelize(option);
+      if (!fStreamVoxels || !vol->GetVoxels()) {
+         if (concurrent && CanVoxelizeConcurrently(vol)) tovoxelize.push_back(vol);
+         else vol->Voxelize(option);
+      } else {
+         // the BVH is not streamed
+         vol->GetVoxels()->BuildBVH();
       }
-      if (!fIsGeomReading) vol->FindOverlaps();
    }
+#ifdef R__USE_IMT
+   if (!tovoxelize.empty()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&tovoxelize, option](UInt_t i) { tovoxelize[i]->Voxelize(option); },
+                   ROOT::TSeqU(tovoxelize.size()));
+   }
+#endif
+   if (fIsGeomReading) return;
+   next.Reset();
+   while ((vol = (TGeoVolume*)next())) vol->FindOverlaps();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +42,11 @@ gGeoManager->SetCurrentNavigator(0);
 #include "TMath.h"
 #include "TGeoParallelWorld.h"
 #include "TGeoPhysicalNode.h"
+#include "TGeoBBox.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 static Double_t gTolerance = TGeoShape::Tolerance();
 const char *kGeoOutsidePath = " ";
@@ -83,6 +88,9 @@ TGeoNavigator::TGeoNavigator()
                fNextNode(0),
                fForcedNode(0),
                fBackupState(0),
+               fNLastStates(0),
+               fLastStateIndex(0),
+               fUseLastStates(kTRUE),
                fCurrentMatrix(0),
                fGlobalMatrix(0),
                fDivMatrix(0),
@@ -90,6 +98,7 @@ TGeoNavigator::TGeoNavigator()
 
 {
 // dummy constructor
+   for (Int_t i=0; i<kNLastStates; i++) fLastStates[i] = 0;
    for (Int_t i=0; i<3; i++) {
       fNormal[i] = 0.;
       fCldir[i] = 0.;
@@ -134,6 +143,9 @@ TGeoNavigator::TGeoNavigator(TGeoManager* geom)
                fNextNode(0),
                fForcedNode(0),
                fBackupState(0),
+               fNLastStates(0),
+               fLastStateIndex(0),
+               fUseLastStates(kTRUE),
                fCurrentMatrix(0),
                fGlobalMatrix(0),
                fDivMatrix(0),
@@ -141,6 +153,7 @@ TGeoNavigator::TGeoNavigator(TGeoManager* geom)
 
 {
 // Default constructor.
+   for (Int_t i=0; i<kNLastStates; i++) fLastStates[i] = 0;
    fThreadId = TGeoManager::ThreadId();
    // printf("Navigator: threadId=%d\n", fThreadId);
    for (Int_t i=0; i<3; i++) {
@@ -194,11 +207,15 @@ TGeoNavigator::TGeoNavigator(const TGeoNavigator& gm)
                fNextNode(gm.fNextNode),
                fForcedNode(gm.fForcedNode),
                fBackupState(gm.fBackupState),
+               fNLastStates(0),
+               fLastStateIndex(0),
+               fUseLastStates(gm.fUseLastStates),
                fCurrentMatrix(gm.fCurrentMatrix),
                fGlobalMatrix(gm.fGlobalMatrix),
                fPath(gm.fPath)
 {
    fThreadId = TGeoManager::ThreadId();
+   for (Int_t i=0; i<kNLastStates; i++) fLastStates[i] = 0;
    for (Int_t i=0; i<3; i++) {
       fNormal[i] = gm.fNormal[i];
       fCldir[i] = gm.fCldir[i];
@@ -248,6 +265,13 @@ TGeoNavigator& TGeoNavigator::operator=(const TGeoNavigator& gm)
       fNextNode = gm.fNextNode;
       fForcedNode = gm.fForcedNode;
       fBackupState = gm.fBackupState;
+      for (Int_t i=0; i<kNLastStates; i++) {
+         delete fLastStates[i];
+         fLastStates[i] = 0;
+      }
+      fNLastStates = 0;
+      fLastStateIndex = 0;
+      fUseLastStates = gm.fUseLastStates;
       fCurrentMatrix = gm.fCurrentMatrix;
       fGlobalMatrix = gm.fGlobalMatrix;
       fPath = gm.fPath;
@@ -272,6 +296,7 @@ TGeoNavigator::~TGeoNavigator()
 {
    if (fCache) delete fCache;
    if (fBackupState) delete fBackupState;
+   for (Int_t i=0; i<kNLastStates; i++) delete fLastStates[i];
    if (fOverlapClusters) delete [] fOverlapClusters;
 }
 
@@ -1579,6 +1604,56 @@ TGeoNode *TGeoNavigator::FindNextBoundaryAndStep(Double_t stepmax, Bool_t compsa
    return CrossBoundaryAndLocate(kTRUE, current);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the distances to the next boundary of a basket of ntracks tracks
+/// located in the current volume. The points and directions are given in the
+/// master frame, as arrays of 3*ntracks coordinates. For each track, steps[i]
+/// is the distance to the next boundary, limited to stepmax[i], and next[i] the
+/// daughter node entered at this distance, or 0 if the track exits the current
+/// volume or the distance is limited by stepmax[i]. The state of the navigator
+/// is not changed.
+/// The tracks are processed together, one shape after the other, by the vectorized
+/// distance methods of the shapes, so all the daughters of the current volume are
+/// checked: this is suited for volumes with a moderate number of non-overlapping
+/// daughters.
+
+void TGeoNavigator::FindNextBoundary_v(Int_t ntracks, const Double_t *points, const Double_t *dirs,
+                                       const Double_t *stepmax, Double_t *steps, TGeoNode **next) const
+{
+   if (ntracks <= 0) return;
+   TGeoVolume *vol = fCurrentNode->GetVolume();
+   std::vector<Double_t> lpoints(3*ntracks), ldirs(3*ntracks);
+   std::vector<Double_t> dpoints(3*ntracks), ddirs(3*ntracks);
+   std::vector<Double_t> dists(ntracks);
+   Int_t i;
+   for (i=0; i<ntracks; i++) {
+      fGlobalMatrix->MasterToLocal(&points[3*i], &lpoints[3*i]);
+      fGlobalMatrix->MasterToLocalVect(&dirs[3*i], &ldirs[3*i]);
+      steps[i] = stepmax[i];
+      next[i] = 0;
+   }
+   // Distances to the boundary of the current volume
+   vol->GetShape()->DistFromInside_v(lpoints.data(), ldirs.data(), dists.data(), ntracks, steps);
+   for (i=0; i<ntracks; i++) if (dists[i] < steps[i]) steps[i] = dists[i];
+   // Distances to the daughters, in their local frames
+   Int_t nd = vol->GetNdaughters();
+   for (Int_t id=0; id<nd; id++) {
+      TGeoNode *node = vol->GetNode(id);
+      TGeoMatrix *mat = node->GetMatrix();
+      for (i=0; i<ntracks; i++) {
+         mat->MasterToLocal(&lpoints[3*i], &dpoints[3*i]);
+         mat->MasterToLocalVect(&ldirs[3*i], &ddirs[3*i]);
+      }
+      node->GetVolume()->GetShape()->DistFromOutside_v(dpoints.data(), ddirs.data(), dists.data(), ntracks, steps);
+      for (i=0; i<ntracks; i++) {
+         if (dists[i] < steps[i]) {
+            steps[i] = dists[i];
+            next[i] = node;
+         }
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns deepest node containing current point.
 
@@ -1602,7 +1677,10 @@ TGeoNode *TGeoNavigator::FindNode(Bool_t safe_start)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Returns deepest node containing current point.
+/// Returns deepest node containing the point (x,y,z). The last few leaf nodes
+/// (without daughters and overlaps) located by this method are checked first,
+/// before the search starting from the current node. This can be disabled with
+/// SetUseLastStates(kFALSE).
 
 TGeoNode *TGeoNavigator::FindNode(Double_t x, Double_t y, Double_t z)
 {
@@ -1617,15 +1695,114 @@ TGeoNode *TGeoNavigator::FindNode(Double_t x, Double_t y, Double_t z)
    fStartSafe = kTRUE;
    fIsSameLocation = kTRUE;
    TGeoNode *last = fCurrentNode;
-   TGeoNode *found = SearchNode();
+   Bool_t useLast = fUseLastStates && !fGeometry->IsParallelWorldNav() && !fGeometry->IsActivityEnabled() &&
+                    fGeometry->GetCache() == fCache;
+   TGeoNode *found = useLast ? FindInLastStates(fPoint) : 0;
+   if (found) {
+      fIsSameLocation = (found == last) ? kTRUE : kFALSE;
+      return found;
+   }
+   found = SearchNode();
    if (found != last) {
       fIsSameLocation = kFALSE;
+      if (useLast && found) StoreLastState();
    } else {
       if (last->IsOverlapping()) fIsSameLocation = kTRUE;
    }
    return found;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Checks if the point (master frame) is inside the last node of one of the
+/// stored states, starting from the most recent one. In this case the state
+/// is restored and the node is returned.
+
+TGeoNode *TGeoNavigator::FindInLastStates(const Double_t *point)
+{
+   Double_t local[3];
+   for (Int_t i=0; i<fNLastStates; i++) {
+      Int_t index = (fLastStateIndex - i + kNLastStates) % kNLastStates;
+      TGeoCacheState *state = fLastStates[index];
+      TGeoNode *node = state->GetNode();
+      // the current node is checked first by SearchNode anyway
+      if (node == fCurrentNode) continue;
+      state->GetMatrix()->MasterToLocal(point, local);
+      if (!node->GetVolume()->Contains(local)) continue;
+      fNextDaughterIndex = -2;
+      fCurrentOverlapping = fCache->RestoreState(fNmany, state);
+      fCurrentNode = fCache->GetNode();
+      fGlobalMatrix = fCache->GetCurrentMatrix();
+      fLevel = fCache->GetLevel();
+      return fCurrentNode;
+   }
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stores the current state among the last located ones if the current node
+/// is a leaf, not overlapping and not in an overlapping branch, so that the
+/// point being inside it is enough to locate it.
+
+void TGeoNavigator::StoreLastState()
+{
+   if (fNmany || fCurrentOverlapping || fCurrentNode->GetVolume()->GetNdaughters()) return;
+   // same capacity as the cache built by BuildCache
+   Int_t nlevel = fGeometry->GetMaxLevel();
+   if (nlevel<=0) nlevel = 100;
+   if (fLevel > nlevel) return;
+   fLastStateIndex = (fLastStateIndex + 1) % kNLastStates;
+   if (!fLastStates[fLastStateIndex]) fLastStates[fLastStateIndex] = new TGeoCacheState(nlevel+1);
+   fLastStates[fLastStateIndex]->SetState(fLevel, 0, fNmany, fCurrentOverlapping);
+   if (fNLastStates < kNLastStates) fNLastStates++;
+}
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Interleaves the lowest 21 bits of the three coordinates (Morton order).
+
+ULong64_t MortonKey(UInt_t ix, UInt_t iy, UInt_t iz)
+{
+   ULong64_t key = 0;
+   for (Int_t bit=20; bit>=0; bit--) {
+      key = (key << 3) | (((ix >> bit) & 1) << 2) | (((iy >> bit) & 1) << 1) | ((iz >> bit) & 1);
+   }
+   return key;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Finds the deepest nodes containing npoints points given in the master frame
+/// (x,y,z for each point). The points are located in Morton order of their
+/// position in the top volume, so that consecutive searches start from a
+/// nearby node and the last located nodes are reused. The navigator is left
+/// in the state of the last point located.
+
+void TGeoNavigator::FindNode_v(Int_t npoints, const Double_t *points, TGeoNode **nodes)
+{
+   if (npoints <= 0) return;
+   const TGeoBBox *box = (const TGeoBBox*)fGeometry->GetTopVolume()->GetShape();
+   const Double_t *origin = box->GetOrigin();
+   Double_t size[3] = {2.*box->GetDX(), 2.*box->GetDY(), 2.*box->GetDZ()};
+   const Double_t nbins = (1 << 21) - 1;
+   std::vector<std::pair<ULong64_t, Int_t> > order(npoints);
+   for (Int_t i=0; i<npoints; i++) {
+      UInt_t ibin[3];
+      for (Int_t j=0; j<3; j++) {
+         Double_t u = (size[j] > 0) ? (points[3*i+j] - origin[j]) / size[j] + 0.5 : 0.5;
+         u = TMath::Min(TMath::Max(u, 0.), 1.);
+         ibin[j] = (UInt_t)(u*nbins);
+      }
+      order[i] = std::make_pair(MortonKey(ibin[0], ibin[1], ibin[2]), i);
+   }
+   std::sort(order.begin(), order.end());
+   for (Int_t i=0; i<npoints; i++) {
+      Int_t ipoint = order[i].second;
+      nodes[ipoint] = FindNode(points[3*ipoint], points[3*ipoint+1], points[3*ipoint+2]);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Computes fast normal to next crossed boundary, assuming that the current point
 /// is close enough to the boundary. Works only after calling FindNextBoundary.
@@ -2654,6 +2831,11 @@ void TGeoNavigator::ResetAll()
       fCache = 0;
       BuildCache(dummy,nodeid);
    }
+   for (Int_t i=0; i<kNLastStates; i++) {
+      delete fLastStates[i];
+      fLastStates[i] = 0;
+   }
+   fNLastStates = 0;
 }
 
 ClassImp(TGeoNavigatorArray);
@@ -360,6 +360,12 @@ Bool_t TGeoPhysicalNode::Align(TGeoMatrix *newmat, TGeoShape *newshape, Bool_t c
    }
    // Clean current matrices from cache
    gGeoManager->CdTop();
+   // The last states located by the navigators hold the former matrices
+   TGeoNavigatorArray *navigators = gGeoManager->GetListOfNavigators();
+   if (navigators) {
+      for (Int_t inav=0; inav<navigators->GetEntriesFast(); inav++)
+         ((TGeoNavigator*)navigators->At(inav))->ResetLastStates();
+   }
    SetAligned(kTRUE);
    return kTRUE;
 }
@@ -1199,7 +1199,33 @@ void TGeoTube::ComputeNormal_v(const Double_t *points, const Double_t *dirs, Dou
 
 void TGeoTube::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t* step) const
 {
-   for (Int_t i=0; i<vecsize; i++) dists[i] = DistFromInside(&points[3*i], &dirs[3*i], 3, step[i]);
+   if (fRmin>0) {
+      for (Int_t i=0; i<vecsize; i++) dists[i] = DistFromInside(&points[3*i], &dirs[3*i], 3, step[i]);
+      return;
+   }
+   // Same algorithm as DistFromInsideS for a full cylinder, without branches so that
+   // the loop is vectorized
+   const Double_t big = TGeoShape::Big();
+   const Double_t tol = TGeoShape::Tolerance();
+   const Double_t rmaxsq = fRmax*fRmax;
+   for (Int_t i=0; i<vecsize; i++) {
+      const Double_t *pt = &points[3*i];
+      const Double_t *dir = &dirs[3*i];
+      Bool_t movez = (dir[2] != 0);
+      Double_t sz = movez ? (TMath::Sign(fDz, dir[2])-pt[2])/(movez ? dir[2] : 1.) : big;
+      Double_t nsq = dir[0]*dir[0]+dir[1]*dir[1];
+      Bool_t movexy = (TMath::Abs(nsq) >= tol);
+      Double_t rsq = pt[0]*pt[0]+pt[1]*pt[1];
+      Double_t rdotn = pt[0]*dir[0]+pt[1]*dir[1];
+      Double_t t1 = 1./(movexy ? nsq : 1.);
+      Double_t b = t1*rdotn;
+      Double_t delta = b*b-t1*(rsq-rmaxsq);
+      Double_t sr = -b+TMath::Sqrt((delta > 0) ? delta : 0.);
+      Double_t dist = (delta > 0 && sr > 0) ? TMath::Min(sz, sr) : 0.;
+      dist = (rsq >= rmaxsq-tol && rdotn >= 0) ? 0. : dist;
+      dist = movexy ? dist : sz;
+      dists[i] = (movez && sz <= 0) ? 0. : dist;
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -14,6 +14,14 @@
 
 Finder class handling voxels.
 
+For volumes with many daughters whose bounding boxes overlap the same
+slices, e.g. rotated daughters, a bounding volume hierarchy (BVH) of the
+daughter boxes is also built and used to find the candidates containing a
+point or crossed by a ray. It is used when a volume has at least
+TGeoVoxelFinder::SetBVHLimits(mindaughters, mincandidates) daughters (128 by
+default) and the slices hold on average at least mincandidates (8 by default)
+daughters on each sliced axis.
+
 Full description with examples and pictures
 
 \image html geom_t_finder.png
@@ -32,8 +40,18 @@ Full description with examples and pictures
 #include "TGeoManager.h"
 #include "TGeoStateInfo.h"
 
+#include <algorithm>
+
 ClassImp(TGeoVoxelFinder);
 
+Int_t    TGeoVoxelFinder::fgBVHMinDaughters = 128;
+Double_t TGeoVoxelFinder::fgBVHMinSliceCandidates = 8.;
+
+// Maximum number of daughters in the leaves of the BVH
+static const Int_t kBVHLeafSize = 4;
+// Size of the stack of BVH nodes to visit, larger than the depth of the balanced BVH
+static const Int_t kBVHStackSize = 64;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
 
@@ -1168,6 +1186,11 @@ void TGeoVoxelFinder::SortCrossedVoxels(const Double_t *point, const Double_t *d
       fVolume->FindOverlaps();
    }
    td.fVoxCurrent = 0;
+   if (HasBVH()) {
+      // all the candidates are given as the first voxel
+      GetBVHCrossed(point, dir, td);
+      return;
+   }
 //   printf("###Sort crossed voxels for %s\n", fVolume->GetName());
    td.fVoxNcandidates = 0;
    Int_t  loc = 1+((fVolume->GetNdaughters()-1)>>3);
@@ -1315,6 +1338,7 @@ Int_t *TGeoVoxelFinder::GetCheckList(const Double_t *point, Int_t &nelem, TGeoSt
       nelem = 1;
       return td.fVoxCheckList;
    }
+   if (HasBVH()) return GetBVHCheckList(point, nelem, td);
    Int_t nslices = 0;
    UChar_t *slice1 = 0;
    UChar_t *slice2 = 0;
@@ -1468,6 +1492,10 @@ Int_t *TGeoVoxelFinder::GetNextVoxel(const Double_t *point, const Double_t * /*d
       ncheck = td.fVoxNcandidates;
       return td.fVoxCheckList;
    }
+   if (HasBVH()) {
+      ncheck = 0;
+      return 0;
+   }
    td.fVoxCurrent++;
 //   printf(">>> voxel %i\n", td.fCurrentVoxel);
    // Get slices for next voxel
@@ -2321,8 +2349,198 @@ void TGeoVoxelFinder::Voxelize(Option_t * /*option*/)
    }
    BuildVoxelLimits();
    SortAll();
+   BuildBVH();
    SetNeedRebuild(kFALSE);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the conditions to use a BVH for the volumes voxelized afterwards: at least
+/// mindaughters daughters, and on average at least mincandidates daughters per
+/// slice on each sliced axis. A negative mindaughters disables the BVH.
+
+void TGeoVoxelFinder::SetBVHLimits(Int_t mindaughters, Double_t mincandidates)
+{
+   fgBVHMinDaughters = mindaughters;
+   fgBVHMinSliceCandidates = mincandidates;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the bounding volume hierarchy of the daughter boxes, if the number of
+/// daughters and the efficiency of the slices make it worth it.
+
+void TGeoVoxelFinder::BuildBVH()
+{
+   fBVHBounds.clear();
+   fBVHNodes.clear();
+   fBVHItems.clear();
+   Int_t nd = fVolume->GetNdaughters();
+   if (fgBVHMinDaughters < 0 || nd < fgBVHMinDaughters || nd < 2 || !fBoxes) return;
+   // Average number of candidates per slice on the best sliced axis
+   Double_t ncand = nd;
+   Int_t id;
+   if (fPriority[0]==2 && fIbx>1) {
+      Double_t sum = 0;
+      for (id=0; id<fIbx-1; id++) sum += fNsliceX[id];
+      ncand = TMath::Min(ncand, sum/(fIbx-1));
+   }
+   if (fPriority[1]==2 && fIby>1) {
+      Double_t sum = 0;
+      for (id=0; id<fIby-1; id++) sum += fNsliceY[id];
+      ncand = TMath::Min(ncand, sum/(fIby-1));
+   }
+   if (fPriority[2]==2 && fIbz>1) {
+      Double_t sum = 0;
+      for (id=0; id<fIbz-1; id++) sum += fNsliceZ[id];
+      ncand = TMath::Min(ncand, sum/(fIbz-1));
+   }
+   if (ncand < fgBVHMinSliceCandidates) return;
+   std::vector<Double_t> centers(3*nd);
+   fBVHItems.resize(nd);
+   for (id=0; id<nd; id++) {
+      fBVHItems[id] = id;
+      for (Int_t j=0; j<3; j++) centers[3*id+j] = fBoxes[6*id+3+j];
+   }
+   fBVHNodes.reserve(4*nd/kBVHLeafSize+2);
+   fBVHBounds.reserve(12*nd/kBVHLeafSize+6);
+   BuildBVHNode(0, nd, centers);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the BVH node of the items [first, last), splitting them at the median
+/// of their centers along the axis of largest extent. Returns the node index.
+
+Int_t TGeoVoxelFinder::BuildBVHNode(Int_t first, Int_t last, const std::vector<Double_t> &centers)
+{
+   Int_t inode = fBVHNodes.size()/2;
+   fBVHNodes.push_back(-1-first);
+   fBVHNodes.push_back(last-first);
+   Double_t bmin[3], bmax[3], cmin[3], cmax[3];
+   Int_t i,j;
+   for (j=0; j<3; j++) {
+      bmin[j] = cmin[j] = TGeoShape::Big();
+      bmax[j] = cmax[j] = -TGeoShape::Big();
+   }
+   for (i=first; i<last; i++) {
+      Int_t id = fBVHItems[i];
+      for (j=0; j<3; j++) {
+         bmin[j] = TMath::Min(bmin[j], fBoxes[6*id+3+j]-fBoxes[6*id+j]);
+         bmax[j] = TMath::Max(bmax[j], fBoxes[6*id+3+j]+fBoxes[6*id+j]);
+         cmin[j] = TMath::Min(cmin[j], centers[3*id+j]);
+         cmax[j] = TMath::Max(cmax[j], centers[3*id+j]);
+      }
+   }
+   for (j=0; j<3; j++) fBVHBounds.push_back(bmin[j]);
+   for (j=0; j<3; j++) fBVHBounds.push_back(bmax[j]);
+   if (last-first <= kBVHLeafSize) return inode;
+   Int_t axis = 0;
+   for (j=1; j<3; j++) if (cmax[j]-cmin[j] > cmax[axis]-cmin[axis]) axis = j;
+   if (cmax[axis] <= cmin[axis]) return inode;
+   Int_t mid = (first+last)/2;
+   std::nth_element(fBVHItems.begin()+first, fBVHItems.begin()+mid, fBVHItems.begin()+last,
+                    [&centers, axis](Int_t a, Int_t b) {return centers[3*a+axis] < centers[3*b+axis];});
+   Int_t left = BuildBVHNode(first, mid, centers);
+   Int_t right = BuildBVHNode(mid, last, centers);
+   fBVHNodes[2*inode] = left;
+   fBVHNodes[2*inode+1] = right;
+   return inode;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the list of daughters whose bounding box contains the point, from the BVH.
+
+Int_t *TGeoVoxelFinder::GetBVHCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td) const
+{
+   const Double_t tol = TGeoShape::Tolerance();
+   Int_t stack[kBVHStackSize];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   nelem = 0;
+   while (nstack) {
+      Int_t inode = stack[--nstack];
+      const Double_t *b = &fBVHBounds[6*inode];
+      if (point[0]<b[0]-tol || point[0]>b[3]+tol || point[1]<b[1]-tol || point[1]>b[4]+tol ||
+          point[2]<b[2]-tol || point[2]>b[5]+tol) continue;
+      Int_t child = fBVHNodes[2*inode];
+      if (child > 0) {
+         stack[nstack++] = child;
+         stack[nstack++] = fBVHNodes[2*inode+1];
+         continue;
+      }
+      Int_t first = -1-child;
+      Int_t last = first+fBVHNodes[2*inode+1];
+      for (Int_t i=first; i<last; i++) {
+         Int_t id = fBVHItems[i];
+         const Double_t *box = &fBoxes[6*id];
+         if (TMath::Abs(point[0]-box[3]) > box[0]+tol || TMath::Abs(point[1]-box[4]) > box[1]+tol ||
+             TMath::Abs(point[2]-box[5]) > box[2]+tol) continue;
+         td.fVoxCheckList[nelem++] = id;
+      }
+   }
+   // same order as the lists obtained from the slices
+   std::sort(td.fVoxCheckList, td.fVoxCheckList+nelem);
+   td.fVoxNcandidates = nelem;
+   return (nelem) ? td.fVoxCheckList : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if the ray from point along dir crosses the box [bmin, bmax]
+/// enlarged by the tolerance.
+
+static Bool_t BVHRayCrossesBox(const Double_t *point, const Double_t *dir, const Double_t *bmin, const Double_t *bmax)
+{
+   const Double_t tol = TGeoShape::Tolerance();
+   Double_t tmin = 0.;
+   Double_t tmax = TGeoShape::Big();
+   for (Int_t j=0; j<3; j++) {
+      Double_t lo = bmin[j]-tol;
+      Double_t hi = bmax[j]+tol;
+      if (dir[j] == 0) {
+         if (point[j] < lo || point[j] > hi) return kFALSE;
+         continue;
+      }
+      Double_t t1 = (lo-point[j])/dir[j];
+      Double_t t2 = (hi-point[j])/dir[j];
+      if (t1 > t2) std::swap(t1, t2);
+      tmin = TMath::Max(tmin, t1);
+      tmax = TMath::Min(tmax, t2);
+      if (tmin > tmax) return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store in the state the list of daughters whose bounding box is crossed by the
+/// ray from point along dir, from the BVH.
+
+void TGeoVoxelFinder::GetBVHCrossed(const Double_t *point, const Double_t *dir, TGeoStateInfo &td) const
+{
+   Int_t stack[kBVHStackSize];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   Int_t nelem = 0;
+   while (nstack) {
+      Int_t inode = stack[--nstack];
+      const Double_t *b = &fBVHBounds[6*inode];
+      if (!BVHRayCrossesBox(point, dir, b, b+3)) continue;
+      Int_t child = fBVHNodes[2*inode];
+      if (child > 0) {
+         stack[nstack++] = child;
+         stack[nstack++] = fBVHNodes[2*inode+1];
+         continue;
+      }
+      Int_t first = -1-child;
+      Int_t last = first+fBVHNodes[2*inode+1];
+      for (Int_t i=first; i<last; i++) {
+         Int_t id = fBVHItems[i];
+         const Double_t *box = &fBoxes[6*id];
+         Double_t bmin[3] = {box[3]-box[0], box[4]-box[1], box[5]-box[2]};
+         Double_t bmax[3] = {box[3]+box[0], box[4]+box[1], box[5]+box[2]};
+         if (BVHRayCrossesBox(point, dir, bmin, bmax)) td.fVoxCheckList[nelem++] = id;
+      }
+   }
+   std::sort(td.fVoxCheckList, td.fVoxCheckList+nelem);
+   td.fVoxNcandidates = nelem;
+}
 ////////////////////////////////////////////////////////////////////////////////
 /// Stream an object of class TGeoVoxelFinder.
 
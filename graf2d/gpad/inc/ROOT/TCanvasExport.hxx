@@ -0,0 +1,94 @@
+// @(#)root/gpad:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TCanvasExport
+#define ROOT_TCanvasExport
+
+#include "ROOT/TProcessExecutor.hxx"
+#include "TCanvas.h"
+#include "TError.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Draw and save nPlots canvases in batch mode, in nWorkers processes at a time
+/// (by default as many as the cores), so that the production of many plots
+/// scales with the cores despite the global graphics state (gPad, gVirtualX)
+/// of each process.
+///
+/// plot(i, filename) is called in a worker process for each i in [0, nPlots):
+/// it draws the plot i in a new canvas, sets filename to where the canvas is
+/// to be saved (any format of TPad::SaveAs) and returns the canvas, which is
+/// saved and deleted by the worker. A null canvas skips the plot. Each worker
+/// processes a contiguous range of plots. Return the number of files saved.
+///
+/// ~~~{.cpp}
+/// ROOT::Experimental::SaveAsInParallel(10000, [&](unsigned i, std::string &filename) {
+///    auto c = new TCanvas(Form("c%u", i));
+///    hists[i]->Draw();
+///    filename = Form("plot%u.png", i);
+///    return c;
+/// });
+/// ~~~
+///
+/// The function is run in processes forked from the caller, hence sees the
+/// objects created before the call, e.g. the histograms to draw.
+
+template <class F>
+unsigned SaveAsInParallel(unsigned nPlots, F plot, unsigned nWorkers = 0)
+{
+   if (nPlots == 0)
+      return 0;
+
+   ROOT::TProcessExecutor pool(nWorkers);
+   // A few ranges per worker balance the load without a message per plot
+   const unsigned nRanges = std::min(nPlots, 4 * std::max(1U, pool.GetNWorkers()));
+   auto saveRange = [&](unsigned range) {
+      gROOT->SetBatch(kTRUE);
+      unsigned nSaved = 0;
+      const unsigned first = ULong64_t(nPlots) * range / nRanges;
+      const unsigned last = ULong64_t(nPlots) * (range + 1) / nRanges;
+      for (unsigned i = first; i < last; ++i) {
+         std::string filename;
+         TCanvas *canvas = plot(i, filename);
+         if (!canvas)
+            continue;
+         if (filename.empty()) {
+            ::Error("SaveAsInParallel", "no file name given for plot %u", i);
+         } else {
+            canvas->SaveAs(filename.c_str());
+            ++nSaved;
+         }
+         delete canvas;
+      }
+      return nSaved;
+   };
+   auto sum = [](const std::vector<unsigned> &v) {
+      unsigned n = 0;
+      for (auto c : v)
+         n += c;
+      return n;
+   };
+   std::vector<unsigned> ranges(nRanges);
+   for (unsigned i = 0; i < nRanges; ++i)
+      ranges[i] = i;
+   return pool.MapReduce(saveRange, ranges, sum);
+}
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
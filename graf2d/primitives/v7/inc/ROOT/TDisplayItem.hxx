@@ -65,6 +65,7 @@ public:
    void SetFrame(const TFrame *f) { fFrame = f; }
    void Add(TDisplayItem *snap) { fPrimitives.push_back(snap); }
    TDisplayItem *Last() const { return fPrimitives[fPrimitives.size() - 1]; }
+   const std::vector<TDisplayItem *> &GetPrimitives() const { return fPrimitives; }
    void Clear();
 };
 
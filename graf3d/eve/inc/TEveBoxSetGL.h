@@ -15,6 +15,8 @@
 #include "TEveDigitSetGL.h"
 #include "TEveBoxSet.h"
 
+#include <vector>
+
 class TEveBoxSetGL : public TEveDigitSetGL
 {
    TEveBoxSetGL(const TEveBoxSetGL&);            // Not implemented
@@ -25,12 +27,27 @@ protected:
 
    mutable UInt_t  fBoxDL;   // Display-list id for a box atom.
 
+   mutable std::vector<Float_t> fVertexData;         // Corners and normals of the box faces, 24 vertices per box.
+   mutable std::vector<UInt_t>  fVertexColors;       // RGBA colors of the vertices.
+   mutable std::vector<UInt_t>  fBoxColors;          // RGBA colors of the boxes, as stored in fVertexColors.
+   mutable std::vector<Int_t>   fRunFirst;           // First vertex of each run of visible boxes.
+   mutable std::vector<Int_t>   fRunCount;           // Number of vertices of each run of visible boxes.
+   mutable Int_t                fVertexBoxType;      // Box-type of the vertex arrays.
+   mutable Bool_t               fVertexArraysValid;  // Vertex arrays match the boxes of the model.
+   mutable UInt_t               fVertexBuffer;       // Vertex-buffer object holding the vertex arrays.
+   mutable Bool_t               fVertexBufferValid;  // Geometry in the vertex buffer is up to date.
+   mutable Bool_t               fBufferColorsValid;  // Colors in the vertex buffer are up to date.
+
    Int_t  PrimitiveType() const;
    void   MakeOriginBox(Float_t p[8][3], Float_t dx, Float_t dy, Float_t dz) const;
    void   RenderBoxStdNorm(const Float_t p[8][3]) const;
    void   RenderBoxAutoNorm(const Float_t p[8][3]) const;
    void   MakeDisplayList() const;
 
+   Bool_t UseVertexArrays(TGLRnrCtx& rnrCtx, Int_t boxSkip) const;
+   void   FillVertexArrays() const;
+   void   RenderVertexArrays() const;
+
    void   RenderBoxes(TGLRnrCtx& rnrCtx) const;
 
 public:
@@ -38,6 +55,7 @@ public:
    virtual ~TEveBoxSetGL();
 
    virtual Bool_t ShouldDLCache(const TGLRnrCtx& rnrCtx) const;
+   virtual void   DLCacheClear();
    virtual void   DLCacheDrop();
    virtual void   DLCachePurge();
 
@@ -13,13 +13,25 @@
 #include "TEveBoxSet.h"
 
 #include "TGLIncludes.h"
+#include "TGLContext.h"
 #include "TGLRnrCtx.h"
 #include "TGLSelectRecord.h"
 #include "TGLQuadric.h"
+#include "TGLUtil.h"
+
+#include <algorithm>
 
 /** \class TEveBoxSetGL
 \ingroup TEve
 A GL rendering class for TEveBoxSet.
+
+Free boxes and axis-aligned boxes are, when possible, rendered in a
+single pass from vertex arrays holding the faces of all the boxes. The
+arrays are stored in a vertex-buffer object when the GL implementation
+supports it. The geometry is rebuilt only when the model changes, the
+colors are re-evaluated on each draw and only the changed ones are
+re-uploaded. Secondary selection, highlight, box-skipping, anti-flicker
+points and the line render-mode use the per-box rendering.
 */
 
 ClassImp(TEveBoxSetGL);
@@ -27,7 +39,10 @@ ClassImp(TEveBoxSetGL);
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor.
 
-TEveBoxSetGL::TEveBoxSetGL() : TEveDigitSetGL(), fM(0), fBoxDL(0)
+TEveBoxSetGL::TEveBoxSetGL() :
+   TEveDigitSetGL(), fM(0), fBoxDL(0),
+   fVertexBoxType(-1), fVertexArraysValid(kFALSE),
+   fVertexBuffer(0), fVertexBufferValid(kFALSE), fBufferColorsValid(kFALSE)
 {
    fDLCache = kFALSE; // Disable display list, used internally for boxes, cones.
    fMultiColor = kTRUE;
@@ -101,6 +116,12 @@ inline void TEveBoxSetGL::RenderBoxStdNorm(const Float_t p[8][3]) const
 
 namespace
 {
+   // Corners of the faces, in the order used by RenderBoxStdNorm().
+   const Int_t   kFaceCorners[6][4] = { {0, 1, 2, 3}, {7, 6, 5, 4}, {0, 4, 5, 1},
+                                        {3, 2, 6, 7}, {0, 3, 7, 4}, {1, 5, 6, 2} };
+   const Float_t kStdNormals[6][3]  = { {0, 0, -1}, {0, 0, 1}, {0, 1, 0},
+                                        {0, -1, 0}, {-1, 0, 0}, {1, 0, 0} };
+
    void subtract_and_normalize(const Float_t a[3], const Float_t b[3],
                                Float_t o[3])
    {
@@ -117,42 +138,73 @@ namespace
          o[2] *= d;
       }
    }
+
+   void make_auto_normals(const Float_t p[8][3], Float_t n[6][3])
+   {
+      // Calculate normals of the box faces from the box edges.
+      Float_t e[6][3];
+      subtract_and_normalize(p[1], p[0], e[0]);
+      subtract_and_normalize(p[3], p[0], e[1]);
+      subtract_and_normalize(p[4], p[0], e[2]);
+      subtract_and_normalize(p[5], p[6], e[3]);
+      subtract_and_normalize(p[7], p[6], e[4]);
+      subtract_and_normalize(p[2], p[6], e[5]);
+
+      TMath::Cross(e[0], e[1], n[0]);
+      TMath::Cross(e[3], e[4], n[1]);
+      TMath::Cross(e[2], e[0], n[2]);
+      TMath::Cross(e[4], e[5], n[3]);
+      TMath::Cross(e[1], e[2], n[4]);
+      TMath::Cross(e[5], e[3], n[5]);
+   }
+
+   void fill_box_vertices(Float_t* v, const Float_t p[8][3], const Float_t n[6][3],
+                          Float_t dx=0, Float_t dy=0, Float_t dz=0,
+                          Float_t sx=1, Float_t sy=1, Float_t sz=1)
+   {
+      // Store the corners of the box faces, scaled by (sx,sy,sz) and
+      // translated by (dx,dy,dz), each followed by the face normal.
+      for (Int_t f = 0; f < 6; ++f)
+      {
+         for (Int_t c = 0; c < 4; ++c, v += 6)
+         {
+            const Float_t* q = p[kFaceCorners[f][c]];
+            v[0] = dx + sx*q[0]; v[1] = dy + sy*q[1]; v[2] = dz + sz*q[2];
+            v[3] = n[f][0];      v[4] = n[f][1];      v[5] = n[f][2];
+         }
+      }
+   }
 }
 ////////////////////////////////////////////////////////////////////////////////
 /// Render box, calculate normals on the fly from first three points.
 
 void TEveBoxSetGL::RenderBoxAutoNorm(const Float_t p[8][3]) const
 {
-   Float_t e[6][3], n[3];
-   subtract_and_normalize(p[1], p[0], e[0]);
-   subtract_and_normalize(p[3], p[0], e[1]);
-   subtract_and_normalize(p[4], p[0], e[2]);
-   subtract_and_normalize(p[5], p[6], e[3]);
-   subtract_and_normalize(p[7], p[6], e[4]);
-   subtract_and_normalize(p[2], p[6], e[5]);
+   Float_t n[6][3];
+   make_auto_normals(p, n);
 
    // bottom: 0123
-   glNormal3fv(TMath::Cross(e[0], e[1], n));
+   glNormal3fv(n[0]);
    glVertex3fv(p[0]); glVertex3fv(p[1]);
    glVertex3fv(p[2]); glVertex3fv(p[3]);
    // top:    7654
-   glNormal3fv(TMath::Cross(e[3], e[4], n));
+   glNormal3fv(n[1]);
    glVertex3fv(p[7]); glVertex3fv(p[6]);
    glVertex3fv(p[5]); glVertex3fv(p[4]);
    // back:  0451
-   glNormal3fv(TMath::Cross(e[2], e[0], n));
+   glNormal3fv(n[2]);
    glVertex3fv(p[0]); glVertex3fv(p[4]);
    glVertex3fv(p[5]); glVertex3fv(p[1]);
    // front:   3267
-   glNormal3fv(TMath::Cross(e[4], e[5], n));
+   glNormal3fv(n[3]);
    glVertex3fv(p[3]); glVertex3fv(p[2]);
    glVertex3fv(p[6]); glVertex3fv(p[7]);
    // left:    0374
-   glNormal3fv(TMath::Cross(e[1], e[2], n));
+   glNormal3fv(n[4]);
    glVertex3fv(p[0]); glVertex3fv(p[3]);
    glVertex3fv(p[7]); glVertex3fv(p[4]);
    // right:   1562
-   glNormal3fv(TMath::Cross(e[5], e[3], n));
+   glNormal3fv(n[5]);
    glVertex3fv(p[1]); glVertex3fv(p[5]);
    glVertex3fv(p[6]); glVertex3fv(p[2]);
 }
@@ -216,6 +268,17 @@ Bool_t TEveBoxSetGL::ShouldDLCache(const TGLRnrCtx& rnrCtx) const
    return TEveDigitSetGL::ShouldDLCache(rnrCtx);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Called when the model has changed and the cached geometry needs to
+/// be rebuilt.
+/// Virtual from TGLLogicalShape.
+
+void TEveBoxSetGL::DLCacheClear()
+{
+   fVertexArraysValid = kFALSE;
+   TGLObject::DLCacheClear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Called when display lists have been destroyed externally and the
 /// internal display-list data needs to be cleare.
@@ -224,6 +287,8 @@ Bool_t TEveBoxSetGL::ShouldDLCache(const TGLRnrCtx& rnrCtx) const
 void TEveBoxSetGL::DLCacheDrop()
 {
    fBoxDL = 0;
+   fVertexBuffer = 0;
+   fVertexBufferValid = kFALSE;
    TGLObject::DLCacheDrop();
 }
 
@@ -238,6 +303,14 @@ void TEveBoxSetGL::DLCachePurge()
       PurgeDLRange(fBoxDL, 1);
       fBoxDL = 0;
    }
+   if (fVertexBuffer != 0)
+   {
+      // Buffer objects can only be deleted with a current context.
+      if (TGLContext::GetCurrent())
+         glDeleteBuffers(1, &fVertexBuffer);
+      fVertexBuffer = 0;
+      fVertexBufferValid = kFALSE;
+   }
    TGLObject::DLCachePurge();
 }
 
@@ -262,6 +335,192 @@ namespace
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Determine if the boxes can be rendered from the vertex arrays.
+
+Bool_t TEveBoxSetGL::UseVertexArrays(TGLRnrCtx& rnrCtx, Int_t boxSkip) const
+{
+   return fM->fBoxType <= TEveBoxSet::kBT_AABoxFixedDim &&
+          fM->fRenderMode != TEveDigitSet::kRM_Line &&
+          ! fM->fAntiFlick && boxSkip == 0 &&
+          ! rnrCtx.SecSelection() && ! (rnrCtx.Highlight() && fHighlightSet);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the vertex arrays with the faces of all the boxes.
+/// The colors are reset, they are set when the boxes are rendered.
+
+void TEveBoxSetGL::FillVertexArrays() const
+{
+   const Int_t nBoxes = fM->fPlex.Size();
+
+   fVertexData.resize(24 * 6 * nBoxes);
+   fVertexColors.assign(24 * nBoxes, 0);
+   fBoxColors.assign(nBoxes, 0);
+
+   Float_t p[8][3], n[6][3];
+   if (fM->fBoxType == TEveBoxSet::kBT_AABox)
+      MakeOriginBox(p, 1.0f, 1.0f, 1.0f);
+   else if (fM->fBoxType == TEveBoxSet::kBT_AABoxFixedDim)
+      MakeOriginBox(p, fM->fDefWidth, fM->fDefHeight, fM->fDefDepth);
+
+   TEveChunkManager::iterator bi(fM->fPlex);
+   while (bi.next())
+   {
+      Float_t* v = &fVertexData[24 * 6 * bi.index()];
+      switch (fM->fBoxType)
+      {
+         case TEveBoxSet::kBT_FreeBox:
+         {
+            TEveBoxSet::BFreeBox_t& b = * (TEveBoxSet::BFreeBox_t*) bi();
+            make_auto_normals(b.fVertices, n);
+            fill_box_vertices(v, b.fVertices, n);
+            break;
+         }
+         case TEveBoxSet::kBT_AABox:
+         {
+            TEveBoxSet::BAABox_t& b = * (TEveBoxSet::BAABox_t*) bi();
+            fill_box_vertices(v, p, kStdNormals, b.fA, b.fB, b.fC, b.fW, b.fH, b.fD);
+            break;
+         }
+         default:
+         {
+            TEveBoxSet::BAABoxFixedDim_t& b = * (TEveBoxSet::BAABoxFixedDim_t*) bi();
+            fill_box_vertices(v, p, kStdNormals, b.fA, b.fB, b.fC);
+            break;
+         }
+      }
+   }
+
+   fVertexBoxType     = fM->fBoxType;
+   fVertexArraysValid = kTRUE;
+   fVertexBufferValid = kFALSE;
+   fBufferColorsValid = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Render the visible boxes from the vertex arrays, with one draw call
+/// per run of consecutive visible boxes.
+
+void TEveBoxSetGL::RenderVertexArrays() const
+{
+   if (! fVertexArraysValid || fVertexBoxType != fM->fBoxType ||
+       (Int_t) fBoxColors.size() != fM->fPlex.Size())
+   {
+      FillVertexArrays();
+   }
+
+   const Bool_t useColors = ! fM->fSingleColor && ! TGLUtil::IsColorLocked();
+
+   // Palette colors only set RGB, the alpha comes from the current color.
+   Float_t current[4];
+   glGetFloatv(GL_CURRENT_COLOR, current);
+   const UChar_t alpha = (UChar_t) TMath::Nint(255 * current[3]);
+
+   Bool_t colorsChanged = kFALSE;
+   fRunFirst.clear();
+   fRunCount.clear();
+
+   TEveChunkManager::iterator bi(fM->fPlex);
+   while (bi.next())
+   {
+      const TEveDigitSet::DigitBase_t& d = * (TEveDigitSet::DigitBase_t*) bi();
+
+      UInt_t  color   = 0;
+      Bool_t  visible = kTRUE;
+      if (fM->fValueIsColor)
+      {
+         visible = (d.fValue != 0);
+         color   = (UInt_t) d.fValue;
+      }
+      else if (! fM->fSingleColor)
+      {
+         UChar_t* c = (UChar_t*) &color;
+         visible = fM->fPalette->ColorFromValue(d.fValue, fM->fDefaultValue, c);
+         c[3]    = alpha;
+      }
+      if (! visible) continue;
+
+      const Int_t i = bi.index();
+      if (useColors && fBoxColors[i] != color)
+      {
+         fBoxColors[i] = color;
+         std::fill(fVertexColors.begin() + 24 * i, fVertexColors.begin() + 24 * (i + 1), color);
+         colorsChanged = kTRUE;
+      }
+
+      if (! fRunFirst.empty() && fRunFirst.back() + fRunCount.back() == 24 * i)
+      {
+         fRunCount.back() += 24;
+      }
+      else
+      {
+         fRunFirst.push_back(24 * i);
+         fRunCount.push_back(24);
+      }
+   }
+
+   if (fRunFirst.empty()) return;
+
+   const Char_t* vertexBase = (const Char_t*) &fVertexData[0];
+   const Char_t* colorBase  = (const Char_t*) &fVertexColors[0];
+
+   const Bool_t useBuffer = GLEW_VERSION_1_5;
+   if (useBuffer)
+   {
+      const GLsizeiptr vertexBytes = fVertexData.size()   * sizeof(Float_t);
+      const GLsizeiptr colorBytes  = fVertexColors.size() * sizeof(UInt_t);
+
+      if (fVertexBuffer == 0)
+      {
+         glGenBuffers(1, &fVertexBuffer);
+         fVertexBufferValid = kFALSE;
+      }
+      glBindBuffer(GL_ARRAY_BUFFER, fVertexBuffer);
+      if (! fVertexBufferValid)
+      {
+         glBufferData(GL_ARRAY_BUFFER, vertexBytes + colorBytes, 0, GL_DYNAMIC_DRAW);
+         glBufferSubData(GL_ARRAY_BUFFER, 0, vertexBytes, &fVertexData[0]);
+         fVertexBufferValid = kTRUE;
+         fBufferColorsValid = kFALSE;
+      }
+      if (useColors && (colorsChanged || ! fBufferColorsValid))
+      {
+         glBufferSubData(GL_ARRAY_BUFFER, vertexBytes, colorBytes, &fVertexColors[0]);
+         fBufferColorsValid = kTRUE;
+      }
+      vertexBase = 0;
+      colorBase  = (const Char_t*) 0 + vertexBytes;
+   }
+
+   glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_NORMAL_ARRAY);
+   glVertexPointer(3, GL_FLOAT, 6 * sizeof(Float_t), vertexBase);
+   glNormalPointer(GL_FLOAT, 6 * sizeof(Float_t), vertexBase + 3 * sizeof(Float_t));
+   if (useColors)
+   {
+      glEnableClientState(GL_COLOR_ARRAY);
+      glColorPointer(4, GL_UNSIGNED_BYTE, 0, colorBase);
+   }
+
+   if (GLEW_VERSION_1_4)
+   {
+      glMultiDrawArrays(GL_QUADS, &fRunFirst[0], &fRunCount[0], fRunFirst.size());
+   }
+   else
+   {
+      for (UInt_t r = 0; r < fRunFirst.size(); ++r)
+         glDrawArrays(GL_QUADS, fRunFirst[r], fRunCount[r]);
+   }
+
+   glPopClientAttrib();
+   if (useBuffer) glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+   // The current color is undefined after drawing with a color array.
+   if (useColors) glColor4fv(current);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// GL rendering for all box-types.
 
@@ -278,6 +537,12 @@ void TEveBoxSetGL::RenderBoxes(TGLRnrCtx& rnrCtx) const
       boxSkip = TMath::Nint(TMath::Power(fM->fBoxSkip, 2.0 - 0.02*rnrCtx.CombiLOD()));
    }
 
+   if (UseVertexArrays(rnrCtx, boxSkip))
+   {
+      RenderVertexArrays();
+      return;
+   }
+
    TEveChunkManager::iterator bi(fM->fPlex);
    if (rnrCtx.Highlight() && fHighlightSet)
       bi.fSelection = fHighlightSet;
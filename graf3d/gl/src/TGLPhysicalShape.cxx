@@ -432,20 +432,26 @@ void TGLPhysicalShape::CalculateShapeLOD(TGLRnrCtx& rnrCtx, Float_t& pixSize, Sh
 {
    TGLLogicalShape::ELODAxes lodAxes = fLogicalShape->SupportedLODAxes();
 
+   std::vector <Double_t> boxViewportDiags;
+   const TGLBoundingBox & box        = BoundingBox();
+   const TGLCamera      & camera     = rnrCtx.RefCamera();
+
    if (lodAxes == TGLLogicalShape::kLODAxesNone)
    {  // Shape doesn't support LOD along any axes return special
       // unsupported LOD draw/cache flag.
-      // TODO: Still ... could check for kLODPixel when very small,
-      //    by using diagonal from bounding-box and some special camera foo.
+      // Shapes covering at most one pixel are still drawn as a point,
+      // skipping the full mesh. Empty bounding-boxes are not reliable
+      // (e.g. shapes not providing one) and are always drawn.
       pixSize  = 100; // Make up something / irrelevant.
       shapeLOD = TGLRnrCtx::kLODHigh;
+      if ( ! box.IsEmpty())
+      {
+         pixSize = camera.ViewportRect(box).Diagonal();
+         if (pixSize <= 1.0) shapeLOD = TGLRnrCtx::kLODPixel;
+      }
       return;
    }
 
-   std::vector <Double_t> boxViewportDiags;
-   const TGLBoundingBox & box        = BoundingBox();
-   const TGLCamera      & camera     = rnrCtx.RefCamera();
-
    if (lodAxes == TGLLogicalShape::kLODAxesAll) {
       // Shape supports LOD along all axes - basis LOD hint on diagonal of viewport
       // projection rect round whole bounding box
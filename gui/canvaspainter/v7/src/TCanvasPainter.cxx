@@ -171,6 +171,13 @@ private:
       WebConn() = default;
    };
 
+   struct SnapItem {
+      std::string fId{};     ///<! object id of display item
+      std::string fJSON{};   ///<! JSON of display item
+      uint64_t fVersion{0};  ///<! snapshot version when item was changed last time
+      SnapItem() = default;
+   };
+
    struct WebCommand {
       std::string fId{};            ///<! command identifier
       std::string fName{};          ///<! command name
@@ -195,6 +202,8 @@ private:
 
    typedef std::vector<ROOT::Experimental::Detail::TMenuItem> MenuItemsVector;
 
+   typedef std::vector<SnapItem> SnapItemsVector;
+
    /// The canvas we are painting. It might go out of existence while painting.
    const TCanvas &fCanvas; ///<!  Canvas
 
@@ -212,6 +221,8 @@ private:
    uint64_t fSnapshotVersion;   ///!< version of snapshot
    std::string fSnapshot;       ///!< last produced snapshot
    uint64_t fSnapshotDelivered; ///!< minimal version delivered to all connections
+   SnapItemsVector fSnapItems;  ///!< JSON of individual display items of last snapshot
+   uint64_t fLayoutVersion;     ///!< version when list of display items was changed last time
    WebUpdatesList fUpdatesLst;  ///!< list of callbacks for canvas update
 
    /// Disable copy construction.
@@ -230,6 +241,8 @@ private:
 
    std::string CreateSnapshot(const ROOT::Experimental::TCanvas &can);
 
+   bool CreateDelta(uint64_t ver, TString &buf) const;
+
    ROOT::Experimental::TDrawable *FindDrawable(const ROOT::Experimental::TCanvas &can, const std::string &id);
 
    void SaveCreatedFile(std::string &reply);
@@ -245,7 +258,8 @@ private:
 public:
    TCanvasPainter(const TCanvas &canv, bool batch_mode)
       : fCanvas(canv), fBatchMode(batch_mode), fWindow(), fWebConn(), fHadWebConn(false), fDisplayList(), fCmds(),
-        fCmdsCnt(0), fWaitingCmdId(), fSnapshotVersion(0), fSnapshot(), fSnapshotDelivered(0), fUpdatesLst()
+        fCmdsCnt(0), fWaitingCmdId(), fSnapshotVersion(0), fSnapshot(), fSnapshotDelivered(0), fSnapItems(), fLayoutVersion(0),
+        fUpdatesLst()
    {
    }
 
@@ -397,15 +411,16 @@ void ROOT::Experimental::TCanvasPainter::CheckDataToSend()
          }
 
          conn.fGetMenu = "";
-      } else if (conn.fSend != fSnapshotVersion) {
-         // buf = "JSON";
-         // buf  += TBufferJSON::ConvertToJSON(Canvas(), 3);
-
+      } else if ((conn.fSend != fSnapshotVersion) && (conn.fSend == conn.fDelivered)) {
+         // new version only send when previous one was confirmed by the client,
+         // than only display items modified since that version can be transferred
+         if (!conn.fSend || !CreateDelta(conn.fSend, buf)) {
+            buf = "SNAP:";
+            buf += TString::ULLtoa(fSnapshotVersion, 10);
+            buf += ":";
+            buf += fSnapshot;
+         }
          conn.fSend = fSnapshotVersion;
-         buf = "SNAP:";
-         buf += TString::ULLtoa(fSnapshotVersion, 10);
-         buf += ":";
-         buf += fSnapshot;
       }
 
       if (buf.Length() > 0) {
@@ -573,6 +588,7 @@ void ROOT::Experimental::TCanvasPainter::ProcessData(unsigned connid, const std:
       return;
    } else if (arg == "RELOAD") {
       conn->fSend = 0; // reset send version, causes new data sending
+      conn->fDelivered = 0;
    } else if (arg == "INTERRUPT") {
       gROOT->SetInterrupt();
    } else if (arg.find("REPLY:") == 0) {
@@ -699,7 +715,29 @@ std::string ROOT::Experimental::TCanvasPainter::CreateSnapshot(const ROOT::Exper
       // lst.Add(sub);
    }
 
-   TString res = TBufferJSON::ToJSON(&fDisplayList  /*, 23 */);
+   TString res = TBufferJSON::ToJSON(&fDisplayList, 23);
+
+   // keep JSON of every display item to be able send only modified items
+   // item with same position and id, but different JSON, gets new version
+   SnapItemsVector items;
+   auto &prims = fDisplayList.GetPrimitives();
+   bool layout_changed = (prims.size() != fSnapItems.size());
+   items.resize(prims.size());
+   for (unsigned n = 0; n < prims.size(); ++n) {
+      SnapItem &item = items[n];
+      item.fId = prims[n]->GetObjectID();
+      item.fJSON = TBufferJSON::ConvertToJSON(prims[n], TBuffer::GetClass(typeid(*prims[n])), 23).Data();
+      item.fVersion = fSnapshotVersion;
+      if ((n < fSnapItems.size()) && (fSnapItems[n].fId == item.fId)) {
+         if (fSnapItems[n].fJSON == item.fJSON)
+            item.fVersion = fSnapItems[n].fVersion;
+      } else {
+         layout_changed = true;
+      }
+   }
+   if (layout_changed)
+      fLayoutVersion = fSnapshotVersion;
+   fSnapItems.swap(items);
 
    // TBufferJSON::ExportToFile("canv.json", &fDisplayList, gROOT->GetClass("ROOT::Experimental::TPadDisplayItem"));
 
@@ -711,6 +749,44 @@ std::string ROOT::Experimental::TCanvasPainter::CreateSnapshot(const ROOT::Exper
    return std::string(res.Data());
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// Produce message with display items modified after version ver of the snapshot
+/// Every item coded as "index:json" and items separated by new line symbol
+/// Returns false if list of items was changed - complete snapshot has to be send
+
+bool ROOT::Experimental::TCanvasPainter::CreateDelta(uint64_t ver, TString &buf) const
+{
+   if ((ver < fLayoutVersion) || (ver > fSnapshotVersion))
+      return false;
+
+   // first item contains pad attributes, also same object can be drawn several times
+   // in both cases client is not able to update item individually
+   for (unsigned n = 0; n < fSnapItems.size(); ++n) {
+      if ((n == 0) && (fSnapItems[n].fVersion > ver))
+         return false;
+      for (unsigned k = 0; k < n; ++k)
+         if (fSnapItems[k].fId == fSnapItems[n].fId)
+            return false;
+   }
+
+   buf = "DIFF:";
+   buf += TString::ULLtoa(fSnapshotVersion, 10);
+   buf += ":";
+   bool first = true;
+   for (unsigned n = 0; n < fSnapItems.size(); ++n) {
+      if (fSnapItems[n].fVersion <= ver)
+         continue;
+      if (!first)
+         buf += "\n";
+      first = false;
+      buf += TString::UItoa(n, 10);
+      buf += ":";
+      buf += fSnapItems[n].fJSON;
+   }
+
+   return true;
+}
+
 ROOT::Experimental::TDrawable *
 ROOT::Experimental::TCanvasPainter::FindDrawable(const ROOT::Experimental::TCanvas &can, const std::string &id)
 {
@@ -0,0 +1,102 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THistParallel
+#define ROOT_THistParallel
+
+// Internal helpers splitting the loops of the histogram libraries between the
+// threads of the implicit multi-threading pool. Installed for the sources of
+// libSpectrum and libUnfold; not part of the interface of libHist.
+
+#include "Rtypes.h"
+
+#include <algorithm>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+namespace ROOT {
+namespace Internal {
+
+/// Minimal number of operations of a loop for it to be split between threads
+const Long64_t kHistMinParallelWork = 1 << 16;
+/// Number of ranges per thread of HistForEachRange, balancing ranges of
+/// different costs
+const Int_t kHistRangesPerThread = 4;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether a loop of work operations is split between threads: the
+/// implicit multi-threading is enabled and the work is large enough.
+
+inline Bool_t HistUseImplicitMT(Long64_t work)
+{
+#ifdef R__USE_IMT
+   return work >= kHistMinParallelWork && ROOT::IsImplicitMTEnabled();
+#else
+   (void)work;
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call f(chunk) for every chunk in [0, nChunks), workPerChunk being the
+/// number of operations of f. The chunks are split between the threads of the
+/// implicit multi-threading pool if HistUseImplicitMT() of the total work:
+/// f(chunk) must then only write the results of its chunk.
+
+template <typename F>
+void HistForEachChunk(Int_t nChunks, Long64_t workPerChunk, F f)
+{
+#ifdef R__USE_IMT
+   if (nChunks > 1 && HistUseImplicitMT(nChunks * workPerChunk)) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(f, ROOT::TSeq<Int_t>(0, nChunks));
+      return;
+   }
+#else
+   (void)workPerChunk;
+#endif
+   for (Int_t chunk = 0; chunk < nChunks; ++chunk)
+      f(chunk);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call f(first, last) on ranges covering [0, n), workPerElement being the
+/// number of operations per element. There are kHistRangesPerThread ranges
+/// per thread of the implicit multi-threading pool if the loop is split, a
+/// single range otherwise. f must only write the results of the elements of
+/// its range; computing every element as in the sequential loop makes the
+/// results independent of the number of threads.
+
+template <typename F>
+void HistForEachRange(Int_t n, Long64_t workPerElement, F f)
+{
+#ifdef R__USE_IMT
+   if (n > 1 && HistUseImplicitMT(n * workPerElement)) {
+      const Int_t nMaxRanges = kHistRangesPerThread * ROOT::GetImplicitMTPoolSize();
+      const Int_t rangeSize = (n + nMaxRanges - 1) / nMaxRanges;
+      const Int_t nRanges = (n + rangeSize - 1) / rangeSize;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Int_t range) { f(range * rangeSize, std::min(n, (range + 1) * rangeSize)); },
+                   ROOT::TSeq<Int_t>(0, nRanges));
+      return;
+   }
+#else
+   (void)workPerElement;
+#endif
+   f(0, n);
+}
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
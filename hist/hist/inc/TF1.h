@@ -38,6 +38,7 @@ class TF1;
 class TH1;
 class TAxis;
 class TMethodCall;
+class TRandom;
 
 namespace ROOT {
    namespace Fit {
@@ -417,6 +418,7 @@ public:
    //template <class T> T Eval(T x, T y = 0, T z = 0, T t = 0) const; 
    virtual Double_t EvalPar(const Double_t *x, const Double_t *params = 0);
    template <class T> T EvalPar(const T *x, const Double_t *params = 0);
+   void             EvalParN(Int_t n, const Double_t *x, Double_t *result, const Double_t *params = 0);
    virtual Double_t operator()(Double_t x, Double_t y = 0, Double_t z = 0, Double_t t = 0) const;
    template <class T> T operator()(const T *x, const Double_t *params = nullptr);
    virtual void     ExecuteEvent(Int_t event, Int_t px, Int_t py);
@@ -528,6 +530,7 @@ public:
    virtual Int_t    GetQuantiles(Int_t nprobSum, Double_t *q, const Double_t *probSum);
    virtual Double_t GetRandom();
    virtual Double_t GetRandom(Double_t xmin, Double_t xmax);
+   void GetRandom(Int_t n, Double_t *x, TRandom *rng = nullptr);
    virtual void     GetRange(Double_t &xmin, Double_t &xmax) const;
    virtual void     GetRange(Double_t &xmin, Double_t &ymin, Double_t &xmax, Double_t &ymax) const;
    virtual void     GetRange(Double_t &xmin, Double_t &ymin, Double_t &zmin, Double_t &xmax, Double_t &ymax, Double_t &zmax) const;
@@ -695,6 +698,9 @@ private:
    inline double EvalParVec(const Double_t *data, const Double_t *params);
 #endif
 
+   Bool_t ComputeRandomTable();
+   Double_t GetRandomInBin(Int_t bin, Double_t r) const;
+
    ClassDef(TF1, 10) // The Parametric 1-D function
 };
 
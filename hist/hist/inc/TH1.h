@@ -51,6 +51,8 @@ class TList;
 class TCollection;
 class TVirtualFFT;
 class TVirtualHistPainter;
+class TH1ConcurrentFill;
+class TRandom;
 
 
 class TH1 : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
@@ -80,7 +82,14 @@ public:
          kNeutral = 2,  ///< Adapt to the global flag
    };
 
+   /// Enumeration specifying how Fill can be called from several threads, see SetConcurrentFill
+   enum  EConcurrentFill {
+         kNoConcurrency = 0, ///< Fill must not be called concurrently
+         kAtomic = 1,        ///< Each Fill updates the histogram atomically, under striped locks
+   };
+
    friend class TH1Merger;
+   friend class TH1ConcurrentFill;
 
 protected:
     Int_t         fNcells;          ///< number of bins(1D), cells (2D) +U/Overflows
@@ -109,6 +118,7 @@ protected:
     TVirtualHistPainter *fPainter;  ///<!pointer to histogram painter
     EBinErrorOpt  fBinStatErrOpt;   ///< option for bin statistical errors
     EStatOverflows fStatOverflows;  ///< per object flag to use under/overflows in statistics
+    TH1ConcurrentFill *fConcurrentFill = nullptr; ///<!Locks used by Fill when filled concurrently
     static Int_t  fgBufferSize;     ///<!default buffer size for automatic histograms
     static Bool_t fgAddDirectory;   ///<!flag to add histograms to the directory
     static Bool_t fgStatOverflows;  ///<!flag to use under/overflows in statistics
@@ -120,6 +130,8 @@ public:
 private:
    Int_t   AxisChoice(Option_t *axis) const;
    void    Build();
+   Double_t GetRandomIntegral() const;
+   Double_t GetRandomInBin(Int_t ibin, Double_t r1) const;
 
    TH1(const TH1&);
    TH1& operator=(const TH1&); // Not implemented
@@ -228,6 +240,7 @@ public:
    virtual TFitResultPtr    Fit(TF1 *f1 ,Option_t *option="" ,Option_t *goption="", Double_t xmin=0, Double_t xmax=0);
    virtual void     FitPanel(); // *MENU*
    TH1             *GetAsymmetry(TH1* h2, Double_t c2=1, Double_t dc2=0);
+   EConcurrentFill  GetConcurrentFill() const { return fConcurrentFill ? kAtomic : kNoConcurrency; }
    Int_t            GetBufferLength() const {return fBuffer ? (Int_t)fBuffer[0] : 0;}
    Int_t            GetBufferSize  () const {return fBufferSize;}
    const   Double_t *GetBuffer() const {return fBuffer;}
@@ -300,6 +313,7 @@ public:
 
    virtual Int_t    GetQuantiles(Int_t nprobSum, Double_t *q, const Double_t *probSum=0);
    virtual Double_t GetRandom() const;
+   void             GetRandom(Int_t n, Double_t *x, TRandom *rng = nullptr) const;
    virtual void     GetStats(Double_t *stats) const;
    virtual Double_t GetStdDev(Int_t axis=1) const;
    virtual Double_t GetStdDevError(Int_t axis=1) const;
@@ -369,6 +383,7 @@ public:
    virtual void     SetBinErrorOption(EBinErrorOpt type) { fBinStatErrOpt = type; }
    virtual void     SetBuffer(Int_t buffersize, Option_t *option="");
    virtual UInt_t   SetCanExtend(UInt_t extendBitMask);
+   void             SetConcurrentFill(EConcurrentFill mode);
    virtual void     SetContent(const Double_t *content);
    virtual void     SetContour(Int_t nlevels, const Double_t *levels=0);
    virtual void     SetContourLevel(Int_t level, Double_t value);
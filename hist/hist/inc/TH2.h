@@ -59,6 +59,8 @@ protected:
 
 private:
 
+   friend class TH1ConcurrentFill;
+
    TH2(const TH2&);
    TH2& operator=(const TH2&); // Not implemented
 
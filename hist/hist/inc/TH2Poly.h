@@ -62,6 +62,7 @@ class TList;
 class TGraph;
 class TMultiGraph;
 class TPad;
+class TH2PolyBinIndex;
 
 class TH2Poly : public TH2 {
 
@@ -143,8 +144,10 @@ protected:
    Bool_t   fFloat;             //When set to kTRUE, allows the histogram to expand if a bin outside the limits is added.
    Bool_t   fNewBinAdded;       //!For the 3D Painter
    Bool_t   fBinContentChanged; //!For the 3D Painter
+   TH2PolyBinIndex *fBinIndex;  //!Index of the bins used by FindBin() and Fill(), built when needed
 
    void   AddBinToPartition(TH2PolyBin *bin);  // Adds the input bin into the partition matrix
+   TH2PolyBinIndex *GetBinIndex();             // Returns the index of the bins, up to date
    void   Initialize(Double_t xlow, Double_t xup, Double_t ylow, Double_t yup, Int_t n, Int_t m);
    Bool_t IsIntersecting(TH2PolyBin *bin, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
    Bool_t IsIntersectingPolygon(Int_t bn, Double_t *x, Double_t *y, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
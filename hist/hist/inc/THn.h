@@ -239,6 +239,22 @@ public:
    TNDArray& GetArray() { return fArray; }
 
 protected:
+   Bool_t AddSameBinning(const THnBase* h, Double_t c) {
+      // Add c times h if it has the same type and number of bins, see
+      // THnBase::Add(); return false if the bins have to be added one by one.
+      const THnT<T>* hn = dynamic_cast<const THnT<T>*>(h);
+      if (!hn || hn->GetNbins() != GetNbins()) return kFALSE;
+      if (GetCalculateErrors()) {
+         if (hn->GetCalculateErrors())
+            fSumw2.Add(hn->fSumw2, c * c);
+         else
+            for (Long64_t i = 0; i < GetNbins(); ++i)
+               fSumw2.At(i) += c * c * hn->fArray.AtAsDouble(i);
+      }
+      fArray.Add(hn->fArray, c);
+      return kTRUE;
+   }
+
    TNDArrayT<T> fArray; // bin content
    ClassDef(THnT, 1); // multi-dimensional histogram with templated storage
 };
@@ -98,6 +98,7 @@ private:
                        const TObjArray* axes, Bool_t keepTargetAxis) const;
    virtual void Reserve(Long64_t /*nbins*/) {}
    virtual void SetFilledBins(Long64_t /*nbins*/) {};
+   virtual Bool_t AddSameBinning(const THnBase* /*h*/, Double_t /*c*/) { return kFALSE; }
 
    Bool_t CheckConsistency(const THnBase *h, const char *tag) const;
    TH1* CreateHist(const char* name, const char* title,
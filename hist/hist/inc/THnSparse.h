@@ -21,7 +21,6 @@
 
 
 #include "THnBase.h"
-#include "TExMap.h"
 #include "THnSparse_Internal.h"
 
 // needed only for template instantiations of THnSparseT:
@@ -32,14 +31,14 @@
 #include "TArrayC.h"
 
 class THnSparseCompactBinCoord;
+class THnSparseBinIndex;
 
 class THnSparse: public THnBase {
  private:
    Int_t      fChunkSize;    // number of entries for each chunk
    Long64_t   fFilledBins;   // number of filled bins
    TObjArray  fBinContent;   // array of THnSparseArrayChunk
-   TExMap     fBins;         //! filled bins
-   TExMap     fBinsContinued;//! filled bins for non-unique hashes, containing pairs of (bin index 0, bin index 1)
+   THnSparseBinIndex *fBinIndex; //! linear index of the filled bins by hash
    THnSparseCompactBinCoord *fCompactCoord; //! compact coordinate
 
    THnSparse(const THnSparse&); // Not implemented
@@ -57,7 +56,8 @@ class THnSparse: public THnBase {
 
    THnSparseArrayChunk* AddChunk();
    void Reserve(Long64_t nbins);
-   void FillExMap();
+   void FillBinIndex(Long64_t nbins);
+   THnSparseBinIndex* GetBinIndex();
    virtual TArray* GenerateArray() const = 0;
    Long64_t GetBinIndexForCurrentBin(Bool_t allocate);
    void FillBin(Long64_t bin, Double_t w) {
@@ -68,6 +68,7 @@ class THnSparse: public THnBase {
       FillBinBase(w);
    }
    void InitStorage(Int_t* nbins, Int_t chunkSize);
+   Bool_t AddSameBinning(const THnBase* h, Double_t c);
 
  public:
    virtual ~THnSparse();
@@ -98,6 +99,8 @@ class THnSparse: public THnBase {
    Long64_t GetBin(const Double_t* x, Bool_t allocate = kTRUE);
    Long64_t GetBin(const char* name[], Bool_t allocate = kTRUE);
 
+   void FillN(Int_t nentries, const Double_t* x, const Double_t* w = 0);
+
    void SetBinContent(const Int_t* idx, Double_t v) {
       // Forwards to THnBase::SetBinContent().
       // Non-virtual, CINT-compatible replacement of a using declaration.
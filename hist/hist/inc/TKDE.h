@@ -94,6 +94,7 @@ public:
    void SetUseBinsNEvents(UInt_t nEvents);
    void SetTuneFactor(Double_t rho);
    void SetRange(Double_t xMin, Double_t xMax); // By default computed from the data
+   void SetUseFFT(Bool_t useFFT = kTRUE, UInt_t nPoints = 4096); // Evaluate on a grid computed by FFT convolution
 
    virtual void Draw(const Option_t* option = "");
 
@@ -164,6 +165,12 @@ private:
    Double_t fSumOfCounts; // Data sum of weights
    UInt_t fUseBinsNEvents; // If the algorithm is allowed to use binning this is the minimum number of events to do so
 
+   Bool_t fUseFFT;         // Evaluate the density on a grid computed by FFT convolution
+   UInt_t fNFFTPoints;     // Number of points of the grid for the FFT evaluation
+   std::vector<Double_t> fGrid; //! Density on the grid for the FFT evaluation, computed when first needed
+   Double_t fGridXMin;     //! Position of the first point of the grid
+   Double_t fGridDelta;    //! Distance between the points of the grid
+
    Double_t fMean;  // Data mean
    Double_t fSigma; // Data std deviation
    Double_t fSigmaRob; // Data std deviation (robust estimation)
@@ -215,6 +222,9 @@ private:
 
    UInt_t Index(Double_t x) const;
 
+   void ComputeGrid();
+   Double_t GetGridValue(Double_t x) const;
+
    void SetBinCentreData(Double_t xmin, Double_t xmax);
    void SetBinCountData();
    void CheckKernelValidity();
@@ -246,7 +256,7 @@ private:
    TF1* GetPDFUpperConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
    TF1* GetPDFLowerConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
 
-   ClassDef(TKDE, 2) // One dimensional semi-parametric Kernel Density Estimation
+   ClassDef(TKDE, 3) // One dimensional semi-parametric Kernel Density Estimation
 
 };
 
@@ -128,6 +128,7 @@ public:
    virtual ~TMultiDimFit();
 
    virtual void     AddRow(const Double_t *x, Double_t D, Double_t E=0);
+   virtual void     AddRows(Int_t nRows, const Double_t *x, const Double_t *D, const Double_t *E=0);
    virtual void     AddTestRow(const Double_t *x, Double_t D, Double_t E=0);
    virtual void     Browse(TBrowser* b);
    virtual void     Clear(Option_t *option=""); // *MENU*
@@ -190,6 +191,7 @@ public:
    virtual void     MakeCode(const char *functionName="MDF", Option_t *option=""); // *MENU*
    virtual void     MakeHistograms(Option_t* option="A"); // *MENU*
    virtual void     MakeMethod(const Char_t* className="MDF", Option_t* option=""); // *MENU*
+   virtual Long64_t Merge(TCollection *list);
    virtual void     Print(Option_t *option="ps") const; // *MENU*
 
    void             SetBinVarX(Int_t nbbinvarx) {fBinVarX = nbbinvarx;}
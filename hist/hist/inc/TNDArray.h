@@ -183,6 +183,17 @@ public:
       if (!fData) fData = new T[fNumData]();
       fData[linidx] += (T) value;
    }
+   void Add(const TNDArrayT<T>& other, Double_t c = 1.) {
+      // Add c times other, which must have the same number of bins, bin by bin.
+      if (!other.fData) return;
+      if (!fData) fData = new T[fNumData]();
+      T* data = fData;
+      const T* odata = other.fData;
+      if (c == 1.)
+         for (int i = 0; i < fNumData; ++i) data[i] += odata[i];
+      else
+         for (int i = 0; i < fNumData; ++i) data[i] += (T) (c * odata[i]);
+   }
 
 protected:
    int fNumData; // number of bins, product of fSizes
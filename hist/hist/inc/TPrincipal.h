@@ -44,6 +44,7 @@ protected:
    TPrincipal(const TPrincipal&);
    TPrincipal& operator=(const TPrincipal&);
 
+   void        AddMoments(Int_t n, const Double_t *mean, const Double_t *m2);
    void        MakeNormalised();
    void        MakeRealCode(const char *filename, const char *prefix, Option_t *option="");
 
@@ -53,6 +54,7 @@ public:
    TPrincipal(Int_t nVariables, Option_t *opt="ND");
 
    virtual void       AddRow(const Double_t *x);
+   virtual void       AddRows(Int_t nRows, const Double_t *x);
    virtual void       Browse(TBrowser *b);
    virtual void       Clear(Option_t *option="");
    const TMatrixD    *GetCovarianceMatrix() const {return &fCovarianceMatrix;}
@@ -68,6 +70,7 @@ public:
    virtual void       MakeHistograms(const char *name = "pca", Option_t *option="epsdx"); // *MENU*
    virtual void       MakeMethods(const char *classname = "PCA", Option_t *option=""); // *MENU*
    virtual void       MakePrincipals();            // *MENU*
+   virtual Long64_t   Merge(TCollection *list);
    virtual void       P2X(const Double_t *p, Double_t *x, Int_t nTest);
    virtual void       Print(Option_t *opt="MSE") const;         // *MENU*
    virtual void       SumOfSquareResiduals(const Double_t *x, Double_t *s);
@@ -0,0 +1,77 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TCumulativeIndex
+#define ROOT_TCumulativeIndex
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TCumulativeIndex                                                     //
+//                                                                      //
+// Guide table of a cumulative distribution normalized to 1, used to    //
+// invert it in constant expected time (indexed search of Chen and      //
+// Asau). The cell k of the guide holds the number of entries smaller   //
+// than k/n: the entry looked for lies between the guides of the cell   //
+// of r and of the next one. Find returns the same bin as               //
+// TMath::BinarySearch, so that the batch samplings of TF1 and TH1 give //
+// the same numbers as the calls of GetRandom one at a time.            //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+#include <algorithm>
+#include <vector>
+
+class TCumulativeIndex {
+
+private:
+   const Double_t *fArray;   // sorted cumulative distribution, not owned
+   Int_t fN;                 // number of entries of fArray searched
+   std::vector<Int_t> fGuide; // fGuide[k] is the number of entries smaller than k/fN
+
+public:
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Index the n first entries of array, sorted in increasing order.
+
+   TCumulativeIndex(Int_t n, const Double_t *array) : fArray(array), fN(n > 0 ? n : 0), fGuide(fN + 1)
+   {
+      Int_t j = 0;
+      for (Int_t k = 0; k <= fN && fN; ++k) {
+         const Double_t r = Double_t(k) / fN;
+         while (j < fN && fArray[j] < r)
+            ++j;
+         fGuide[k] = j;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Return TMath::BinarySearch(n, array, r): the index of the first entry equal
+   /// to r if any, else of the last entry smaller than r.
+
+   Int_t Find(Double_t r) const
+   {
+      if (!fN)
+         return -1;
+      const Double_t cell = r * fN;
+      const Int_t k = cell <= 0 ? 0 : (cell >= fN ? fN : Int_t(cell));
+      Int_t lo = fGuide[k];
+      Int_t hi = fGuide[k < fN ? k + 1 : fN];
+      // Widen the range for the rounding of k/fN and for r outside of [0,1].
+      while (lo > 0 && fArray[lo - 1] >= r)
+         --lo;
+      while (hi < fN && fArray[hi] < r)
+         ++hi;
+      const Int_t j = std::lower_bound(fArray + lo, fArray + hi, r) - fArray;
+      return (j < fN && fArray[j] == r) ? j : j - 1;
+   }
+};
+
+#endif
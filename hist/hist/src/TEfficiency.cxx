@@ -28,6 +28,7 @@
 
 //custom headers
 #include "TEfficiency.h"
+#include "ROOT/THistParallel.hxx"
 
 // file with extra class for FC method
 #include "TEfficiencyHelper.h"
@@ -1632,14 +1633,36 @@ void TEfficiency::FillGraph(TGraphAsymmErrors * graph, Option_t * opt) const
    double * eyl = graph->GetEYlow();
    double * eyh = graph->GetEYhigh();
    Int_t npoints = fTotalHistogram->GetNbinsX();
+   std::vector<Int_t> bins;
+   bins.reserve(npoints);
    for (Int_t i = 0; i < npoints; ++i) {
       if (!plot0Bins && fTotalHistogram->GetBinContent(i+1) == 0 )    continue;
-      x = fTotalHistogram->GetBinCenter(i+1);
-      y = GetEfficiency(i+1);
-      xlow = fTotalHistogram->GetBinCenter(i+1) - fTotalHistogram->GetBinLowEdge(i+1);
-      xup = fTotalHistogram->GetBinWidth(i+1) - xlow;
-      ylow = GetEfficiencyErrorLow(i+1);
-      yup = GetEfficiencyErrorUp(i+1);
+      bins.push_back(i+1);
+   }
+
+   // the intervals of the bins are independent: compute them first, possibly
+   // in parallel, the graph is then filled in the order of the bins.
+   // The frequentist intervals of weighted histograms switch the statistic
+   // option to the normal approximation, they are computed sequentially.
+   const Int_t nbins = bins.size();
+   std::vector<Double_t> eff(nbins), errLow(nbins), errUp(nbins);
+   const Bool_t switchOption = TestBit(kUseWeights) && !TestBit(kIsBayesian) && fStatisticOption != kFNormal;
+   ROOT::Internal::HistForEachRange(nbins, switchOption ? 0 : 1 << 10, [&](Int_t first, Int_t last) {
+      for (Int_t k = first; k < last; ++k) {
+         eff[k] = GetEfficiency(bins[k]);
+         errLow[k] = GetEfficiencyErrorLow(bins[k]);
+         errUp[k] = GetEfficiencyErrorUp(bins[k]);
+      }
+   });
+
+   for (Int_t k = 0; k < nbins; ++k) {
+      const Int_t bin = bins[k];
+      x = fTotalHistogram->GetBinCenter(bin);
+      y = eff[k];
+      xlow = fTotalHistogram->GetBinCenter(bin) - fTotalHistogram->GetBinLowEdge(bin);
+      xup = fTotalHistogram->GetBinWidth(bin) - xlow;
+      ylow = errLow[k];
+      yup = errUp[k];
       // in the case the graph already existed and extra points have been added
       if (j >= graph->GetN() ) {
          graph->SetPoint(j,x,y);
@@ -1735,14 +1758,20 @@ void TEfficiency::FillHistogram(TH2 * hist ) const
    if (xlabel) hist->GetXaxis()->SetTitle(xlabel);
    if (ylabel) hist->GetYaxis()->SetTitle(ylabel);
 
-   Int_t bin;
+   // the efficiencies of the rows of bins are computed in parallel if the
+   // implicit multi-threading is enabled, the histogram is filled afterwards
    Int_t nbinsx = hist->GetNbinsX();
    Int_t nbinsy = hist->GetNbinsY();
-   for(Int_t i = 0; i < nbinsx + 2; ++i) {
-      for(Int_t j = 0; j < nbinsy + 2; ++j) {
-         bin = GetGlobalBin(i,j);
-         hist->SetBinContent(bin,GetEfficiency(bin));
+   std::vector<Double_t> eff((nbinsx + 2) * (nbinsy + 2));
+   ROOT::Internal::HistForEachRange(nbinsx + 2, 32 * (nbinsy + 2), [&](Int_t first, Int_t last) {
+      for(Int_t i = first; i < last; ++i) {
+         for(Int_t j = 0; j < nbinsy + 2; ++j)
+            eff[i * (nbinsy + 2) + j] = GetEfficiency(GetGlobalBin(i,j));
       }
+   });
+   for(Int_t i = 0; i < nbinsx + 2; ++i) {
+      for(Int_t j = 0; j < nbinsy + 2; ++j)
+         hist->SetBinContent(GetGlobalBin(i,j),eff[i * (nbinsy + 2) + j]);
    }
 
    //copying style information
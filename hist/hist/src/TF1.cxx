@@ -9,6 +9,9 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include <algorithm>
+#include <mutex>
+
 #include "Riostream.h"
 #include "TROOT.h"
 #include "TMath.h"
@@ -45,16 +48,19 @@
 #include "Math/MinimizerOptions.h"
 #include "Math/Factory.h"
 #include "Math/ChebyshevPol.h"
+#include "Math/Error.h"
 #include "Fit/FitResult.h"
 // for I/O backward compatibility
 #include "v5/TF1Data.h"
 
 #include "AnalyticalIntegrals.h"
+#include "TCumulativeIndex.h"
 
 std::atomic<Bool_t> TF1::fgAbsValue(kFALSE);
 Bool_t TF1::fgRejectPoint = kFALSE;
 std::atomic<Bool_t> TF1::fgAddToGlobList(kTRUE);
 static Double_t gErrorTF1 = 0;
+static std::mutex gRandomTableMutex; // protects the tables of GetRandom
 
 ClassImp(TF1);
 
@@ -146,6 +152,84 @@ public:
    Double_t fX0;
 };
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Integral of a vectorized function between a and b with the algorithm of
+/// ROOT::Math::GaussIntegrator (8 and 16 point Gauss quadratures, bisecting the
+/// interval until they agree), evaluating the 24 points of each interval with a
+/// single call to TF1::EvalParN.
+
+Double_t GaussIntegralN(TF1 *f, Double_t a, Double_t b, Double_t epsrel, Double_t epsabs, Bool_t absValue,
+                        Double_t &error)
+{
+   if (epsrel <= 0 || epsabs <= 0) {
+      if (epsrel > 0) epsabs = epsrel;
+      else if (epsabs > 0) epsrel = epsabs;
+      else {
+         epsrel = ROOT::Math::IntegratorOneDimOptions::DefaultRelTolerance();
+         epsabs = ROOT::Math::IntegratorOneDimOptions::DefaultAbsTolerance();
+      }
+   }
+
+   const Double_t kHF = 0.5;
+   const Double_t kCST = 5. / 1000;
+
+   const Double_t x[12] = { 0.96028985649753623,  0.79666647741362674,
+                            0.52553240991632899,  0.18343464249564980,
+                            0.98940093499164993,  0.94457502307323258,
+                            0.86563120238783174,  0.75540440835500303,
+                            0.61787624440264375,  0.45801677765722739,
+                            0.28160355077925891,  0.09501250983763744};
+
+   const Double_t w[12] = { 0.10122853629037626,  0.22238103445337447,
+                            0.31370664587788729,  0.36268378337836198,
+                            0.02715245941175409,  0.06225352393864789,
+                            0.09515851168249278,  0.12462897125553387,
+                            0.14959598881657673,  0.16915651939500254,
+                            0.18260341504492359,  0.18945061045506850};
+
+   // the points c1 + c2 * x[i] and c1 - c2 * x[i] of an interval, and the function values there
+   Double_t xx[24], fx[24];
+   Double_t h = 0, c1 = 0, c2 = 0, s8 = 0, s16 = 0;
+   error = 0;
+   if (b == a) return h;
+   const Double_t aconst = kCST / std::abs(b - a);
+   Double_t bb = a;
+   do {
+      Double_t aa = bb;
+      bb = b;
+      while (true) {
+         c1 = kHF * (bb + aa);
+         c2 = kHF * (bb - aa);
+         for (Int_t i = 0; i < 12; i++) {
+            xx[2 * i] = c1 + c2 * x[i];
+            xx[2 * i + 1] = c1 - c2 * x[i];
+         }
+         f->EvalParN(24, xx, fx, 0);
+         if (absValue)
+            for (Int_t i = 0; i < 24; i++) fx[i] = std::abs(fx[i]);
+         s8 = 0;
+         for (Int_t i = 0; i < 4; i++) s8 += w[i] * (fx[2 * i] + fx[2 * i + 1]);
+         s16 = 0;
+         for (Int_t i = 4; i < 12; i++) s16 += w[i] * (fx[2 * i] + fx[2 * i + 1]);
+         s16 = c2 * s16;
+         error = std::abs(s16 - c2 * s8);
+         if (error <= epsabs || error <= epsrel * std::abs(s16)) break;
+         bb = c1;
+         if (1. + aconst * std::abs(c2) == 1) {
+            MATH_WARN_MSGVAL("ROOT::Math::GausIntegrator", "Failed to reach the desired tolerance ",
+                             std::max(epsrel, epsabs));
+            return s8; //this is a crude approximation (cernlib function returned 0 !)
+         }
+      }
+      h += s16;
+   } while (bb != b);
+   return h;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /** \class TF1
     \ingroup Hist
@@ -1425,6 +1509,47 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate function at the n points of array x with given parameters.
+///
+/// The values are stored in result[0], ..., result[n-1]. The coordinates of
+/// point i are x[i*ndim], ..., x[i*ndim+ndim-1], ndim being the number of
+/// dimensions of the function. If argument params is omitted or equal 0, the
+/// internal values of parameters will be used instead.
+///
+/// For a vectorized function (see IsVectorized()), the points are evaluated
+/// by vectors of ROOT::Double_v, otherwise one by one with EvalPar(); the
+/// warning of EvalPar() about interpreted functions applies here as well.
+
+void TF1::EvalParN(Int_t n, const Double_t *x, Double_t *result, const Double_t *params)
+{
+#ifdef R__HAS_VECCORE
+   if (IsVectorized()) {
+      const Int_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+      std::vector<ROOT::Double_v> xv(fNdim);
+      Int_t i = 0;
+      for (; i + vecSize <= n; i += vecSize) {
+         for (Int_t idim = 0; idim < fNdim; idim++)
+            for (Int_t j = 0; j < vecSize; j++)
+               vecCore::Set(xv[idim], j, x[(i + j) * fNdim + idim]);
+         ROOT::Double_v res = EvalPar(xv.data(), params);
+         for (Int_t j = 0; j < vecSize; j++)
+            result[i + j] = vecCore::Get(res, j);
+      }
+      // unlike EvalPar(const Double_t *, const Double_t *), the vectorized EvalPar does not normalize
+      if (fNormalized && fNormIntegral != 0) {
+         for (Int_t j = 0; j < i; j++)
+            result[j] /= fNormIntegral;
+      }
+      for (; i < n; i++)
+         result[i] = EvalPar(x + i * fNdim, params);
+      return;
+   }
+#endif
+   for (Int_t i = 0; i < n; i++)
+      result[i] = EvalPar(x + i * fNdim, params);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -1980,80 +2105,133 @@ Int_t TF1::GetQuantiles(Int_t nprobSum, Double_t *q, const Double_t *probSum)
 
 Double_t TF1::GetRandom()
 {
-   //  Check if integral array must be build
-   if (fIntegral.size() == 0) {
-      fIntegral.resize(fNpx + 1);
-      fAlpha.resize(fNpx + 1);
-      fBeta.resize(fNpx);
-      fGamma.resize(fNpx);
-      fIntegral[0] = 0;
-      fAlpha[fNpx] = 0;
-      Double_t integ;
-      Int_t intNegative = 0;
-      Int_t i;
-      Bool_t logbin = kFALSE;
-      Double_t dx;
-      Double_t xmin = fXmin;
-      Double_t xmax = fXmax;
-      if (xmin > 0 && xmax / xmin > fNpx) {
-         logbin =  kTRUE;
-         fAlpha[fNpx] = 1;
-         xmin = TMath::Log10(fXmin);
-         xmax = TMath::Log10(fXmax);
-      }
-      dx = (xmax - xmin) / fNpx;
-
-      Double_t *xx = new Double_t[fNpx + 1];
-      for (i = 0; i < fNpx; i++) {
-         xx[i] = xmin + i * dx;
-      }
-      xx[fNpx] = xmax;
-      for (i = 0; i < fNpx; i++) {
-         if (logbin) {
-            integ = Integral(TMath::Power(10, xx[i]), TMath::Power(10, xx[i + 1]));
-         } else {
-            integ = Integral(xx[i], xx[i + 1]);
-         }
-         if (integ < 0) {
-            intNegative++;
-            integ = -integ;
-         }
-         fIntegral[i + 1] = fIntegral[i] + integ;
-      }
-      if (intNegative > 0) {
-         Warning("GetRandom", "function:%s has %d negative values: abs assumed", GetName(), intNegative);
-      }
-      if (fIntegral[fNpx] == 0) {
-         delete [] xx;
-         Error("GetRandom", "Integral of function is zero");
+   {
+      std::lock_guard<std::mutex> lock(gRandomTableMutex);
+      if (fIntegral.empty() && !ComputeRandomTable())
          return 0;
-      }
-      Double_t total = fIntegral[fNpx];
-      for (i = 1; i <= fNpx; i++) { // normalize integral to 1
-         fIntegral[i] /= total;
-      }
-      //the integral r for each bin is approximated by a parabola
-      //  x = alpha + beta*r +gamma*r**2
-      // compute the coefficients alpha, beta, gamma for each bin
-      Double_t x0, r1, r2, r3;
-      for (i = 0; i < fNpx; i++) {
-         x0 = xx[i];
-         r2 = fIntegral[i + 1] - fIntegral[i];
-         if (logbin) r1 = Integral(TMath::Power(10, x0), TMath::Power(10, x0 + 0.5 * dx)) / total;
-         else        r1 = Integral(x0, x0 + 0.5 * dx) / total;
-         r3 = 2 * r2 - 4 * r1;
-         if (TMath::Abs(r3) > 1e-8) fGamma[i] = r3 / (dx * dx);
-         else           fGamma[i] = 0;
-         fBeta[i]  = r2 / dx - fGamma[i] * dx;
-         fAlpha[i] = x0;
-         fGamma[i] *= 2;
-      }
-      delete [] xx;
    }
 
    // return random number
    Double_t r  = gRandom->Rndm();
    Int_t bin  = TMath::BinarySearch(fNpx, fIntegral.data(), r);
+   return GetRandomInBin(bin, r);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill x with n random numbers following this function shape, generated
+/// with rng, or gRandom if rng is null.
+///
+/// The numbers are the ones n calls of GetRandom() would return for the same
+/// sequence of rng, but the bin of each number is found in constant time
+/// with a guide table of the tabulated integral, instead of a binary search.
+/// The table of the integral is computed once and shared by all the threads;
+/// several threads can sample the same function concurrently, each with its
+/// own generator.
+
+void TF1::GetRandom(Int_t n, Double_t *x, TRandom *rng)
+{
+   if (n <= 0)
+      return;
+   if (!rng)
+      rng = gRandom;
+   {
+      std::lock_guard<std::mutex> lock(gRandomTableMutex);
+      if (fIntegral.empty() && !ComputeRandomTable()) {
+         std::fill(x, x + n, 0.);
+         return;
+      }
+   }
+
+   const TCumulativeIndex index(fNpx, fIntegral.data());
+   for (Int_t i = 0; i < n; ++i) {
+      const Double_t r = rng->Rndm();
+      x[i] = GetRandomInBin(index.Find(r), r);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Tabulate the normalized integral of the function on fNpx bins and the
+/// parabolic approximation of its inverse in each bin, for GetRandom().
+/// Return kFALSE, leaving the tables empty, if the integral is zero.
+/// Must be called with gRandomTableMutex held.
+
+Bool_t TF1::ComputeRandomTable()
+{
+   fIntegral.resize(fNpx + 1);
+   fAlpha.resize(fNpx + 1);
+   fBeta.resize(fNpx);
+   fGamma.resize(fNpx);
+   fIntegral[0] = 0;
+   fAlpha[fNpx] = 0;
+   Double_t integ;
+   Int_t intNegative = 0;
+   Int_t i;
+   Bool_t logbin = kFALSE;
+   Double_t dx;
+   Double_t xmin = fXmin;
+   Double_t xmax = fXmax;
+   if (xmin > 0 && xmax / xmin > fNpx) {
+      logbin =  kTRUE;
+      fAlpha[fNpx] = 1;
+      xmin = TMath::Log10(fXmin);
+      xmax = TMath::Log10(fXmax);
+   }
+   dx = (xmax - xmin) / fNpx;
+
+   std::vector<Double_t> xx(fNpx + 1);
+   for (i = 0; i < fNpx; i++) {
+      xx[i] = xmin + i * dx;
+   }
+   xx[fNpx] = xmax;
+   for (i = 0; i < fNpx; i++) {
+      if (logbin) {
+         integ = Integral(TMath::Power(10, xx[i]), TMath::Power(10, xx[i + 1]));
+      } else {
+         integ = Integral(xx[i], xx[i + 1]);
+      }
+      if (integ < 0) {
+         intNegative++;
+         integ = -integ;
+      }
+      fIntegral[i + 1] = fIntegral[i] + integ;
+   }
+   if (intNegative > 0) {
+      Warning("GetRandom", "function:%s has %d negative values: abs assumed", GetName(), intNegative);
+   }
+   if (fIntegral[fNpx] == 0) {
+      fIntegral.clear();
+      Error("GetRandom", "Integral of function is zero");
+      return kFALSE;
+   }
+   Double_t total = fIntegral[fNpx];
+   for (i = 1; i <= fNpx; i++) { // normalize integral to 1
+      fIntegral[i] /= total;
+   }
+   //the integral r for each bin is approximated by a parabola
+   //  x = alpha + beta*r +gamma*r**2
+   // compute the coefficients alpha, beta, gamma for each bin
+   Double_t x0, r1, r2, r3;
+   for (i = 0; i < fNpx; i++) {
+      x0 = xx[i];
+      r2 = fIntegral[i + 1] - fIntegral[i];
+      if (logbin) r1 = Integral(TMath::Power(10, x0), TMath::Power(10, x0 + 0.5 * dx)) / total;
+      else        r1 = Integral(x0, x0 + 0.5 * dx) / total;
+      r3 = 2 * r2 - 4 * r1;
+      if (TMath::Abs(r3) > 1e-8) fGamma[i] = r3 / (dx * dx);
+      else           fGamma[i] = 0;
+      fBeta[i]  = r2 / dx - fGamma[i] * dx;
+      fAlpha[i] = x0;
+      fGamma[i] *= 2;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the x of the cumulative probability r, in the bin of the table of
+/// ComputeRandomTable() where it lies.
+
+Double_t TF1::GetRandomInBin(Int_t bin, Double_t r) const
+{
    Double_t rr = r - fIntegral[bin];
 
    Double_t yy;
@@ -2092,6 +2270,7 @@ Double_t TF1::GetRandom()
 
 Double_t TF1::GetRandom(Double_t xmin, Double_t xmax)
 {
+   std::unique_lock<std::mutex> lock(gRandomTableMutex);
    //  Check if integral array must be build
    if (fIntegral.size() == 0) {
       fIntegral.resize(fNpx + 1);
@@ -2139,6 +2318,8 @@ Double_t TF1::GetRandom(Double_t xmin, Double_t xmax)
       }
    }
 
+   lock.unlock();
+
    // return random number
    Double_t dx   = (fXmax - fXmin) / fNpx;
    Int_t nbinmin = (Int_t)((xmin - fXmin) / dx);
@@ -2502,7 +2683,11 @@ Double_t TF1::IntegralOneDim(Double_t a, Double_t b,  Double_t epsrel, Double_t
    TF1_EvalWrapper wf1(this, 0, fgAbsValue);
    Double_t result = 0;
    Int_t status = 0;
-   if (ROOT::Math::IntegratorOneDimOptions::DefaultIntegratorType() == ROOT::Math::IntegrationOneDim::kGAUSS) {
+   if (ROOT::Math::IntegratorOneDimOptions::DefaultIntegratorType() == ROOT::Math::IntegrationOneDim::kGAUSS &&
+       IsVectorized() && a != - TMath::Infinity() && b != TMath::Infinity()) {
+      // same algorithm as the GaussIntegrator below, evaluating the function on vectors of points
+      result = GaussIntegralN(this, a, b, epsrel, epsabs, fgAbsValue, error);
+   } else if (ROOT::Math::IntegratorOneDimOptions::DefaultIntegratorType() == ROOT::Math::IntegrationOneDim::kGAUSS) {
       ROOT::Math::GaussIntegrator iod(epsabs, epsrel);
       iod.SetFunction(wf1);
       if (a != - TMath::Infinity() && b != TMath::Infinity())
@@ -2654,10 +2839,26 @@ Double_t TF1::IntegralFast(Int_t num, Double_t * /* x */, Double_t * /* w */, Do
 {
    // Now x and w are not used!
 
+   ROOT::Math::GaussLegendreIntegrator gli(num, epsilon);
+   if (IsVectorized() && num > 0) {
+      // evaluate all the points at once, as GaussLegendreIntegrator::Integral does one by one
+      std::vector<Double_t> xi(num), wi(num), fi(num);
+      gli.GetWeightVectors(xi.data(), wi.data());
+      const Double_t a0 = (b + a) / 2;
+      const Double_t b0 = (b - a) / 2;
+      for (Int_t i = 0; i < num; i++)
+         xi[i] = a0 + b0 * xi[i];
+      if (params)
+         SetParameters(params);
+      EvalParN(num, xi.data(), fi.data(), 0);
+      Double_t result = 0.0;
+      for (Int_t i = 0; i < num; i++)
+         result += wi[i] * fi[i];
+      return result * b0;
+   }
    ROOT::Math::WrappedTF1 wf1(*this);
    if (params)
       wf1.SetParameters(params);
-   ROOT::Math::GaussLegendreIntegrator gli(num, epsilon);
    gli.SetFunction(wf1);
    return gli.Integral(a, b);
 
@@ -2994,10 +3195,19 @@ TH1   *TF1::DoCreateHistogram(Double_t xmin, Double_t  xmax, Bool_t recreate)
    histogram->GetYaxis()->SetTitle(ytitle.Data());
    Double_t *parameters = GetParameters();
 
-   InitArgs(xv, parameters);
-   for (i = 1; i <= fNpx; i++) {
-      xv[0] = histogram->GetBinCenter(i);
-      histogram->SetBinContent(i, EvalPar(xv, parameters));
+   if (IsVectorized()) {
+      std::vector<Double_t> xc(fNpx), yc(fNpx);
+      for (i = 0; i < fNpx; i++)
+         xc[i] = histogram->GetBinCenter(i + 1);
+      EvalParN(fNpx, xc.data(), yc.data(), parameters);
+      for (i = 0; i < fNpx; i++)
+         histogram->SetBinContent(i + 1, yc[i]);
+   } else {
+      InitArgs(xv, parameters);
+      for (i = 1; i <= fNpx; i++) {
+         xv[0] = histogram->GetBinCenter(i);
+         histogram->SetBinContent(i, EvalPar(xv, parameters));
+      }
    }
 
    // Copy Function attributes to histogram attributes.
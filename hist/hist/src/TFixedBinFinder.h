@@ -0,0 +1,79 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFixedBinFinder
+#define ROOT_TFixedBinFinder
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TFixedBinFinder                                                      //
+//                                                                      //
+// Bin numbers of a whole array of values on an axis with fixed bins    //
+// which cannot be extended, used by the FillN methods. The loop has no //
+// call and no branch, so that the compiler can vectorize it; the bins  //
+// are the ones TAxis::FindBin returns, underflows, overflows and NaN   //
+// included.                                                            //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TAxis.h"
+
+#include <algorithm>
+
+class TFixedBinFinder {
+
+private:
+   Double_t fXmin;
+   Double_t fXmax;
+   Int_t    fNbins;
+
+public:
+   enum { kChunkSize = 256 }; // Number of bins computed at once by the callers
+
+   /// Whether FindBins gives the same bins as TAxis::FindBin for this axis.
+   static Bool_t CanUse(TAxis &axis)
+   {
+      return !axis.GetXbins()->fN && !axis.CanExtend() && !axis.IsAlphanumeric();
+   }
+
+   TFixedBinFinder(const TAxis &axis) : fXmin(axis.GetXmin()), fXmax(axis.GetXmax()), fNbins(axis.GetNbins()) {}
+
+private:
+   template <Int_t kStride>
+   void FindBinsImpl(Int_t n, const Double_t *x, Int_t stride, Int_t *bins) const
+   {
+      const Double_t xmin = fXmin;
+      const Double_t xmax = fXmax;
+      const Int_t nbins = fNbins;
+      const Double_t top = nbins;
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t v = x[i * (kStride ? kStride : stride)];
+         // Same expression as TAxis::FindBin, clamped so that the conversion to
+         // Int_t stays defined for the underflows, overflows and NaN.
+         const Double_t pos = std::min(std::max(-1., nbins * (v - xmin) / (xmax - xmin)), top);
+         Int_t bin = 1 + Int_t(pos);
+         bin = (v < xmin) ? 0 : bin;
+         bins[i] = !(v < xmax) ? nbins + 1 : bin;
+      }
+   }
+
+public:
+   /// Set bins[i] to the bin of x[i*stride], for i in [0,n).
+   void FindBins(Int_t n, const Double_t *x, Int_t stride, Int_t *bins) const
+   {
+      // A known stride lets the compiler vectorize the loop.
+      if (stride == 1)
+         FindBinsImpl<1>(n, x, stride, bins);
+      else
+         FindBinsImpl<0>(n, x, stride, bins);
+   }
+};
+
+#endif
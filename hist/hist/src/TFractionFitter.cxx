@@ -152,6 +152,9 @@ Any serious inconsistency results in an error.
 #include "TFitResult.h"
 #include "Math/Functor.h"
 #include "TFractionFitter.h"
+#include "ROOT/THistParallel.hxx"
+
+#include <vector>
 
 ClassImp(TFractionFitter);
 
@@ -694,52 +697,69 @@ void TFractionFitter::ComputeFCN(Double_t& f, const Double_t* xx, Int_t flag)
       fPlot->Reset();
    }
    // likelihood computation
-   Double_t result = 0;
+   // The terms of the bins are independent: they are computed first, in
+   // parallel if the implicit multi-threading is enabled, and summed in the
+   // order of the bins, so that the likelihood does not depend on the number
+   // of threads. The histograms of the predictions are filled sequentially.
+   std::vector<Int_t> bins;
    for (z = minZ; z <= maxZ; ++z) {
       for (y = minY; y <= maxY; ++y) {
          for (x = minX; x <= maxX; ++x) {
             bin = fData->GetBin(x, y, z);
-            if (IsExcluded(bin)) continue;
-
-            // Solve for the "predictions"
-            int k0 = 0;
-            Double_t ti = 0.0; Double_t aki = 0.0;
-            FindPrediction(bin, ti, k0, aki);
-
-            Double_t prediction = 0;
-            for (mc = 0; mc < fNpar; ++mc) {
-               TH1 *h  = (TH1*)fMCs[mc];
-               TH1 *hw = (TH1*)fWeights[mc];
-               Double_t binPrediction;
-               Double_t binContent = h->GetBinContent(bin);
-               Double_t weight = hw ? hw->GetBinContent(bin) : 1;
-               if (k0 >= 0 && fFractions[mc] == fFractions[k0]) {
-                  binPrediction = aki;
-               } else {
-                  binPrediction = binContent > 0 ? binContent / (1+weight*fFractions[mc]*ti) : 0;
-               }
-
-               prediction += fFractions[mc]*weight*binPrediction;
-               result -= binPrediction;
-               if (binContent > 0 && binPrediction > 0)
-                  result += binContent*TMath::Log(binPrediction);
-
-               if (flag == 3) {
-                  ((TH1*)fAji.At(mc))->SetBinContent(bin, binPrediction);
-               }
+            if (!IsExcluded(bin)) bins.push_back(bin);
+         }
+      }
+   }
+   const Int_t nbins = bins.size();
+   std::vector<Double_t> binResults(nbins);
+   ROOT::Internal::HistForEachRange(nbins, flag == 3 ? 0 : 100 * fNpar, [&](Int_t first, Int_t last) {
+      for (Int_t k = first; k < last; ++k) {
+         const Int_t ibin = bins[k];
+         Double_t binResult = 0;
+
+         // Solve for the "predictions"
+         int k0 = 0;
+         Double_t ti = 0.0; Double_t aki = 0.0;
+         FindPrediction(ibin, ti, k0, aki);
+
+         Double_t prediction = 0;
+         for (Int_t imc = 0; imc < fNpar; ++imc) {
+            TH1 *h  = (TH1*)fMCs.At(imc);
+            TH1 *hw = (TH1*)fWeights.At(imc);
+            Double_t binPrediction;
+            Double_t binContent = h->GetBinContent(ibin);
+            Double_t weight = hw ? hw->GetBinContent(ibin) : 1;
+            if (k0 >= 0 && fFractions[imc] == fFractions[k0]) {
+               binPrediction = aki;
+            } else {
+               binPrediction = binContent > 0 ? binContent / (1+weight*fFractions[imc]*ti) : 0;
             }
 
+            prediction += fFractions[imc]*weight*binPrediction;
+            binResult -= binPrediction;
+            if (binContent > 0 && binPrediction > 0)
+               binResult += binContent*TMath::Log(binPrediction);
+
             if (flag == 3) {
-               fPlot->SetBinContent(bin, prediction);
+               ((TH1*)fAji.At(imc))->SetBinContent(ibin, binPrediction);
             }
+         }
 
-            result -= prediction;
-            Double_t found = fData->GetBinContent(bin);
-            if (found > 0 && prediction > 0)
-               result += found*TMath::Log(prediction);
+         if (flag == 3) {
+            fPlot->SetBinContent(ibin, prediction);
          }
+
+         binResult -= prediction;
+         Double_t found = fData->GetBinContent(ibin);
+         if (found > 0 && prediction > 0)
+            binResult += found*TMath::Log(prediction);
+         binResults[k] = binResult;
       }
-   }
+   });
+
+   Double_t result = 0;
+   for (Int_t k = 0; k < nbins; ++k)
+      result += binResults[k];
 
    f = -result;
 }
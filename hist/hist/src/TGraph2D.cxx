@@ -24,7 +24,9 @@
 #include "TClass.h"
 #include "TSystem.h"
 #include <stdlib.h>
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 #include "HFitInterface.h"
 #include "Fit/DataRange.h"
@@ -1053,7 +1055,13 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
    Bool_t empty = opt.Contains("empty");
    Bool_t oldInterp = opt.Contains("old");
 
+   // Triangles of the previous histogram, reused when it is rebuilt: the
+   // points did not change since, see SetPoint
+   TObject *cachedDelaunay = 0;
+
    if (fHistogram) {
+      if (fHistogram->GetEntries() == 0 && fDelaunay && !fUserHisto)
+         cachedDelaunay = fHistogram->GetListOfFunctions()->Remove(fDelaunay);
       if (!empty && fHistogram->GetEntries() == 0) {
          if (!fUserHisto) {
             delete fHistogram;
@@ -1124,7 +1132,11 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
    // Add a TGraphDelaunay in the list of the fHistogram's functions
 
    if (oldInterp) {
-      TGraphDelaunay *dt = new TGraphDelaunay(this);
+      TGraphDelaunay *dt = dynamic_cast<TGraphDelaunay*>(cachedDelaunay);
+      if (!dt) {
+         delete cachedDelaunay;
+         dt = new TGraphDelaunay(this);
+      }
       dt->SetMaxIter(fMaxIter);
       dt->SetMarginBinsContent(fZout);
       fDelaunay = dt;
@@ -1132,7 +1144,11 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
    }
    else {
       // new interpolation based on ROOT::Math::Delaunay
-      TGraphDelaunay2D *dt = new TGraphDelaunay2D(this);
+      TGraphDelaunay2D *dt = dynamic_cast<TGraphDelaunay2D*>(cachedDelaunay);
+      if (!dt) {
+         delete cachedDelaunay;
+         dt = new TGraphDelaunay2D(this);
+      }
       dt->SetMarginBinsContent(fZout);
       fDelaunay = dt;
       ResetBit(kOldInterpolation);
@@ -1169,18 +1185,28 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
 
    Double_t x, y, z;
 
-   for (Int_t ix = 1; ix <= fNpx; ix++) {
-      x  = hxmin + (ix - 0.5) * dx;
-      for (Int_t iy = 1; iy <= fNpy; iy++) {
-         y  = hymin + (iy - 0.5) * dy;
-         // do interpolation
-         if (oldInterp)
+   if (oldInterp) {
+      for (Int_t ix = 1; ix <= fNpx; ix++) {
+         x  = hxmin + (ix - 0.5) * dx;
+         for (Int_t iy = 1; iy <= fNpy; iy++) {
+            y  = hymin + (iy - 0.5) * dy;
+            // do interpolation
             z  = ((TGraphDelaunay*)fDelaunay)->ComputeZ(x, y);
-         else
-            z  = ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(x, y);
-
-         fHistogram->Fill(x, y, z);
+            fHistogram->Fill(x, y, z);
+         }
+      }
+   } else {
+      // interpolate all the bin centres at once
+      const Int_t n = fNpx * fNpy;
+      std::vector<Double_t> xc(n), yc(n), zc(n);
+      for (Int_t ix = 1; ix <= fNpx; ix++) {
+         for (Int_t iy = 1; iy <= fNpy; iy++) {
+            xc[(ix - 1) * fNpy + iy - 1] = hxmin + (ix - 0.5) * dx;
+            yc[(ix - 1) * fNpy + iy - 1] = hymin + (iy - 0.5) * dy;
+         }
       }
+      ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(n, xc.data(), yc.data(), zc.data());
+      for (Int_t i = 0; i < n; i++) fHistogram->Fill(xc[i], yc[i], zc[i]);
    }
 
 
@@ -1263,9 +1289,29 @@ Double_t TGraph2D::GetZmin() const
 
 Double_t TGraph2D::Interpolate(Double_t x, Double_t y)
 {
+   Double_t z;
+   Interpolate(1, &x, &y, &z);
+   return z;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Finds the z values z[i] at the n positions (x[i],y[i]) thanks to
+/// the Delaunay interpolation.
+///
+/// The triangles are found once and kept for the following calls and for
+/// the drawing of the graph, as long as its points do not change. With the
+/// default interpolation the points are located with a grid over the
+/// triangles, and interpolated in parallel when the implicit
+/// multi-threading is enabled (see ROOT::EnableImplicitMT).
+
+void TGraph2D::Interpolate(Int_t n, const Double_t *x, const Double_t *y, Double_t *z)
+{
+   if (n <= 0) return;
    if (fNpoints <= 0) {
       Error("Interpolate", "Empty TGraph2D");
-      return 0;
+      std::fill(z, z + n, 0.);
+      return;
    }
 
    if (!fHistogram) GetHistogram("empty");
@@ -1282,16 +1328,22 @@ Double_t TGraph2D::Interpolate(Double_t x, Double_t y)
       }
    }
 
-   if (!fDelaunay) return TMath::QuietNaN();
+   if (!fDelaunay) {
+      std::fill(z, z + n, TMath::QuietNaN());
+      return;
+   }
 
-   if (fDelaunay->IsA() == TGraphDelaunay2D::Class() )
-      return ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(x, y);
-   else if (fDelaunay->IsA() == TGraphDelaunay::Class() )
-      return ((TGraphDelaunay*)fDelaunay)->ComputeZ(x, y);
+   if (fDelaunay->IsA() == TGraphDelaunay2D::Class() ) {
+      ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(n, x, y, z);
+      return;
+   } else if (fDelaunay->IsA() == TGraphDelaunay::Class() ) {
+      for (Int_t i = 0; i < n; i++) z[i] = ((TGraphDelaunay*)fDelaunay)->ComputeZ(x[i], y[i]);
+      return;
+   }
 
    // cannot be here
    assert(false);
-   return TMath::QuietNaN();
+   std::fill(z, z + n, TMath::QuietNaN());
 }
 
 
@@ -1726,6 +1778,13 @@ void TGraph2D::SetPoint(Int_t n, Double_t x, Double_t y, Double_t z)
    fY[n]    = y;
    fZ[n]    = z;
    fNpoints = TMath::Max(fNpoints, n + 1);
+
+   // the histogram and the triangles of the previous points are obsolete
+   if (fHistogram && !fUserHisto) {
+      delete fHistogram;
+      fHistogram = 0;
+      fDelaunay  = nullptr;
+   }
 }
 
 
@@ -15,6 +15,7 @@
 #include <ctype.h>
 #include <sstream>
 #include <cmath>
+#include <mutex>
 
 #include "Riostream.h"
 #include "TROOT.h"
@@ -51,6 +52,9 @@
 #include "Math/QuantFuncMathCore.h"
 
 #include "TH1Merger.h"
+#include "TFixedBinFinder.h"
+#include "TH1ConcurrentFill.h"
+#include "TCumulativeIndex.h"
 
 /** \addtogroup Hist
 @{
@@ -528,6 +532,8 @@ Bool_t TH1::fgAddDirectory = kTRUE;
 Bool_t TH1::fgDefaultSumw2 = kFALSE;
 Bool_t TH1::fgStatOverflows= kFALSE;
 
+static std::mutex gRandomIntegralMutex; // protects the computation of the integral in GetRandom
+
 extern void H1InitGaus();
 extern void H1InitExpo();
 extern void H1InitPolynom();
@@ -584,6 +590,8 @@ TH1::~TH1()
    fIntegral = 0;
    delete[] fBuffer;
    fBuffer = 0;
+   delete fConcurrentFill;
+   fConcurrentFill = nullptr;
    if (fFunctions) {
       R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -3246,6 +3254,10 @@ Int_t TH1::Fill(Double_t x)
    if (fBuffer)  return BufferFill(x,1);
 
    Int_t bin;
+   if (fConcurrentFill) {
+      bin = fXaxis.FindBin(x);
+      return fConcurrentFill->Fill(*this, bin, bin > 0 && bin <= fXaxis.GetNbins(), 1, 1, x);
+   }
    fEntries++;
    bin =fXaxis.FindBin(x);
    if (bin <0) return -1;
@@ -3279,6 +3291,10 @@ Int_t TH1::Fill(Double_t x, Double_t w)
    if (fBuffer) return BufferFill(x,w);
 
    Int_t bin;
+   if (fConcurrentFill) {
+      bin = fXaxis.FindBin(x);
+      return fConcurrentFill->Fill(*this, bin, bin > 0 && bin <= fXaxis.GetNbins(), w, 1, x);
+   }
    fEntries++;
    bin =fXaxis.FindBin(x);
    if (bin <0) return -1;
@@ -3343,6 +3359,10 @@ Int_t TH1::Fill(const char *namex, Double_t w)
 /// weights is automatically triggered and the sum of the squares of weights is incremented
 /// by \f$ w^2 \f$ in the bin corresponding to x.
 /// if w is NULL each entry is assumed a weight=1
+///
+/// When the axis has fixed bins and cannot be extended, the bins of a chunk
+/// of entries are computed at once; the result is the same as calling Fill
+/// for each entry.
 
 void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
@@ -3362,6 +3382,12 @@ void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride
       }
       return;
    }
+   // the concurrent filling goes through the locks of Fill
+   if (fConcurrentFill) {
+      for (Int_t i = 0; i < ntimes * stride; i += stride)
+         Fill(x[i], w ? w[i] : 1.);
+      return;
+   }
    // call internal method
    DoFillN(ntimes, x, w, stride);
 }
@@ -3377,6 +3403,35 @@ void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stri
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
+   if (TFixedBinFinder::CanUse(fXaxis)) {
+      // The bins of a chunk are computed at once; the statistics are summed
+      // in the same order as below, in local variables.
+      const TFixedBinFinder finder(fXaxis);
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+      Int_t bins[TFixedBinFinder::kChunkSize];
+      for (Int_t first = 0; first < ntimes; first += TFixedBinFinder::kChunkSize) {
+         const Int_t n = TMath::Min(ntimes - first, (Int_t)TFixedBinFinder::kChunkSize);
+         const Double_t *xc = x + first * stride;
+         const Double_t *wc = w ? w + first * stride : nullptr;
+         finder.FindBins(n, xc, stride, bins);
+         for (Int_t j = 0; j < n; ++j) {
+            bin = bins[j];
+            if (wc) ww = wc[j * stride];
+            if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin, ww);
+            if (!statOverflows && (bin == 0 || bin > nbins)) continue;
+            const Double_t xx = xc[j * stride];
+            tsumw   += ww;
+            tsumw2  += ww*ww;
+            tsumwx  += ww*xx;
+            tsumwx2 += ww*xx*xx;
+         }
+      }
+      fTsumw = tsumw; fTsumw2 = tsumw2; fTsumwx = tsumwx; fTsumwx2 = tsumwx2;
+      return;
+   }
    ntimes *= stride;
    for (i=0;i<ntimes;i+=stride) {
       bin =fXaxis.FindBin(x[i]);
@@ -3450,9 +3505,10 @@ void TH1::FillRandom(const char *fname, Int_t ntimes)
    for (bin=1;bin<=nbinsx;bin++)  integral[bin] /= integral[nbinsx];
 
    //   --------------Start main loop ntimes
+   const TCumulativeIndex index(nbinsx, integral);
    for (loop=0;loop<ntimes;loop++) {
       r1 = gRandom->Rndm();
-      ibin = TMath::BinarySearch(nbinsx,&integral[0],r1);
+      ibin = index.Find(r1);
       //binx = 1 + ibin;
       //x    = xAxis->GetBinCenter(binx); //this is not OK when SetBuffer is used
       x    = xAxis->GetBinLowEdge(ibin+first)
@@ -3543,11 +3599,13 @@ void TH1::FillRandom(TH1 *h, Int_t ntimes)
    // case of different axis and not too large ntimes
 
    if (h->ComputeIntegral() ==0) return;
-   Int_t loop;
-   Double_t x;
-   for (loop=0;loop<ntimes;loop++) {
-      x = h->GetRandom();
-      Fill(x);
+   const Int_t kChunk = 1024;
+   Double_t x[kChunk];
+   for (Int_t loop = 0; loop < ntimes; loop += kChunk) {
+      const Int_t n = TMath::Min(kChunk, ntimes - loop);
+      h->GetRandom(n, x);
+      for (Int_t i = 0; i < n; ++i)
+         Fill(x[i]);
    }
 }
 
@@ -4716,20 +4774,71 @@ Double_t TH1::GetRandom() const
       return 0;
    }
    Int_t nbinsx = GetNbinsX();
-   Double_t integral = 0;
-   // compute integral checking that all bins have positive content (see ROOT-5894)
-   if (fIntegral) {
-      if (fIntegral[nbinsx+1] != fEntries) integral = ((TH1*)this)->ComputeIntegral(true);
-      else  integral = fIntegral[nbinsx];
-   } else {
-      integral = ((TH1*)this)->ComputeIntegral(true);
-   }
+   Double_t integral = GetRandomIntegral();
    if (integral == 0) return 0;
    // return a NaN in case some bins have negative content
    if (integral == TMath::QuietNaN() ) return TMath::QuietNaN();
 
    Double_t r1 = gRandom->Rndm();
    Int_t ibin = TMath::BinarySearch(nbinsx,fIntegral,r1);
+   return GetRandomInBin(ibin, r1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill x with n random numbers distributed according the histogram bin
+/// contents, generated with rng, or gRandom if rng is null.
+///
+/// The numbers are the ones n calls of GetRandom() would return for the same
+/// sequence of rng, but the bin of each number is found in constant time
+/// with a guide table of the integral, instead of a binary search.
+/// The integral is computed once and shared by all the threads: several
+/// threads can sample the same histogram concurrently, each with its own
+/// generator, as long as it is not filled meanwhile.
+/// NB Only valid for 1-d histograms.
+
+void TH1::GetRandom(Int_t n, Double_t *x, TRandom *rng) const
+{
+   if (n <= 0)
+      return;
+   if (fDimension > 1) {
+      Error("GetRandom","Function only valid for 1-d histograms");
+      std::fill(x, x + n, 0.);
+      return;
+   }
+   if (!rng)
+      rng = gRandom;
+   Double_t integral = GetRandomIntegral();
+   if (integral == 0 || std::isnan(integral)) {
+      std::fill(x, x + n, integral);
+      return;
+   }
+
+   const TCumulativeIndex index(GetNbinsX(), fIntegral);
+   for (Int_t i = 0; i < n; ++i) {
+      const Double_t r1 = rng->Rndm();
+      x[i] = GetRandomInBin(index.Find(r1), r1);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the integral used by GetRandom, computing fIntegral if it does not
+/// exist or if the number of entries changed since.
+
+Double_t TH1::GetRandomIntegral() const
+{
+   std::lock_guard<std::mutex> lock(gRandomIntegralMutex);
+   Int_t nbinsx = GetNbinsX();
+   // compute integral checking that all bins have positive content (see ROOT-5894)
+   if (fIntegral && fIntegral[nbinsx+1] == fEntries) return fIntegral[nbinsx];
+   return ((TH1*)this)->ComputeIntegral(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the x of the cumulative probability r1, in the bin ibin+1
+/// where it lies.
+
+Double_t TH1::GetRandomInBin(Int_t ibin, Double_t r1) const
+{
    Double_t x = GetBinLowEdge(ibin+1);
    if (r1 > fIntegral[ibin]) x +=
       GetBinWidth(ibin+1)*(r1-fIntegral[ibin])/(fIntegral[ibin+1] - fIntegral[ibin]);
@@ -6105,6 +6214,51 @@ Bool_t TH1::CanExtendAllAxes() const
    return canExtend;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Allow or forbid the filling of this histogram from several threads at once.
+///
+/// With mode = TH1::kAtomic, the numerical Fill and FillN methods of TH1, TH2
+/// and TH3 can be called concurrently on the same histogram: each of them
+/// updates the bin content and the sum of squares of weights under one of a
+/// set of striped locks, and accumulates the statistics (number of entries,
+/// sums of weights) in a slot of the calling thread. Many threads can then
+/// fill one histogram, where TThreadedObject would need a copy of it per
+/// thread; this pays when the histogram is large and the filling does not
+/// dominate the processing of the entries.
+///
+/// The bin contents are always up to date, the statistics are added to the
+/// histogram when it is written or when the mode is set back to
+/// TH1::kNoConcurrency, which must be done once all the threads are done
+/// filling and before reading the number of entries, the mean, etc.
+/// The filling by label, the other methods changing the histogram and the
+/// extension of the axes are not protected: the axes must not be extendable,
+/// and the buffer, if any, is emptied and deleted. The profiles, TH2Poly and
+/// TH1K, which have their own Fill, do not support this mode.
+
+void TH1::SetConcurrentFill(EConcurrentFill mode)
+{
+   if (mode == kNoConcurrency) {
+      if (fConcurrentFill) {
+         fConcurrentFill->Flush(*this);
+         delete fConcurrentFill;
+         fConcurrentFill = nullptr;
+      }
+      return;
+   }
+   if (fConcurrentFill) return;
+   if (InheritsFrom("TProfile") || InheritsFrom("TProfile2D") || InheritsFrom("TProfile3D") ||
+       InheritsFrom("TH2Poly") || InheritsFrom("TH1K")) {
+      Error("SetConcurrentFill", "%s does not support the concurrent filling", ClassName());
+      return;
+   }
+   if (fXaxis.CanExtend() || fYaxis.CanExtend() || fZaxis.CanExtend()) {
+      Error("SetConcurrentFill", "cannot fill concurrently histogram %s whose axes can be extended", GetName());
+      return;
+   }
+   if (fBuffer) BufferEmpty(1);
+   fConcurrentFill = new TH1ConcurrentFill;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Make the histogram axes extendable / not extendable according to the bit mask
 /// returns the previous bit mask specifying which axes are extendable
@@ -6447,6 +6601,7 @@ void TH1::Streamer(TBuffer &b)
       b.CheckByteCount(R__s, R__c, TH1::IsA());
 
    } else {
+      if (fConcurrentFill) fConcurrentFill->Flush(*this);
       b.WriteClassBuffer(TH1::Class(),this);
    }
 }
@@ -6585,6 +6740,7 @@ void TH1::Reset(Option_t *option)
    fTsumwx      = 0;
    fTsumwx2     = 0;
    fEntries     = 0;
+   if (fConcurrentFill) fConcurrentFill->Clear();
 
    if (opt == "ICES") return;
 
@@ -0,0 +1,198 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH1ConcurrentFill
+#define ROOT_TH1ConcurrentFill
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TH1ConcurrentFill                                                    //
+//                                                                      //
+// Locks of a histogram filled by several threads at once, see          //
+// TH1::SetConcurrentFill. The bins are protected by a set of striped   //
+// mutexes: neighbouring bins use different stripes, so that threads    //
+// filling the same region seldom wait for each other. The statistics   //
+// (entries and sums of weights) are accumulated in per thread slots,   //
+// hashed from the thread id, and added to the histogram by Flush.      //
+// The creation of the sum of squares of weights takes all the bin      //
+// stripes.                                                             //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TMath.h"
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class TH1ConcurrentFill {
+
+private:
+   enum {
+      kNBinStripes = 64, // Number of mutexes protecting the bins
+      kNStatSlots = 16,  // Number of slots accumulating the statistics
+      kNSums = 11        // Sums of a TH3, in the order of TH3::GetStats
+   };
+
+   // Padded to a cache line, so that the mutexes of different stripes do not share one.
+   struct TBinStripe {
+      std::mutex fMutex;
+      char fPad[64 - sizeof(std::mutex) % 64];
+   };
+
+   struct TStatSlot {
+      std::mutex fMutex;
+      Double_t fEntries = 0;
+      Double_t fSums[kNSums] = {0};
+      char fPad[64];
+   };
+
+   TBinStripe fBinStripes[kNBinStripes];
+   TStatSlot fStatSlots[kNStatSlots];
+
+   TStatSlot &ThreadSlot()
+   {
+      return fStatSlots[std::hash<std::thread::id>()(std::this_thread::get_id()) % kNStatSlots];
+   }
+
+   // Create the sum of squares of weights of h while no other thread touches its bins.
+   void CreateSumw2(TH1 &h)
+   {
+      for (auto &stripe : fBinStripes)
+         stripe.fMutex.lock();
+      if (!h.fSumw2.fN) {
+         Double_t entries = h.fEntries;
+         for (auto &slot : fStatSlots) {
+            std::lock_guard<std::mutex> lock(slot.fMutex);
+            entries += slot.fEntries;
+         }
+         h.fSumw2.Set(h.fNcells);
+         if (entries > 0)
+            for (Int_t i = 0; i < h.fNcells; ++i)
+               h.fSumw2.fArray[i] = TMath::Abs(h.RetrieveBinContent(i));
+      }
+      for (auto &stripe : fBinStripes)
+         stripe.fMutex.unlock();
+   }
+
+public:
+   /// Add w to bin of h, and to its sum of squares of weights as TH1::Fill does.
+   void AddBinContent(TH1 &h, Int_t bin, Double_t w)
+   {
+      std::unique_lock<std::mutex> lock(fBinStripes[bin % kNBinStripes].fMutex);
+      if (!h.fSumw2.fN && w != 1.0 && !h.TestBit(TH1::kIsNotW)) {
+         lock.unlock();
+         CreateSumw2(h);
+         lock.lock();
+      }
+      if (h.fSumw2.fN)
+         h.fSumw2.fArray[bin] += w * w;
+      h.AddBinContent(bin, w);
+   }
+
+   /// Count an entry which does not enter the statistics.
+   void AddEntry()
+   {
+      TStatSlot &slot = ThreadSlot();
+      std::lock_guard<std::mutex> lock(slot.fMutex);
+      slot.fEntries += 1;
+   }
+
+   /// Count an entry of weight w at x, y, z; ndim is the dimension of the histogram.
+   void AddEntry(Int_t ndim, Double_t w, Double_t x, Double_t y = 0, Double_t z = 0)
+   {
+      TStatSlot &slot = ThreadSlot();
+      std::lock_guard<std::mutex> lock(slot.fMutex);
+      Double_t *s = slot.fSums;
+      slot.fEntries += 1;
+      s[0] += w;
+      s[1] += w * w;
+      s[2] += w * x;
+      s[3] += w * x * x;
+      if (ndim < 2)
+         return;
+      s[4] += w * y;
+      s[5] += w * y * y;
+      s[6] += w * x * y;
+      if (ndim < 3)
+         return;
+      s[7] += w * z;
+      s[8] += w * z * z;
+      s[9] += w * x * z;
+      s[10] += w * y * z;
+   }
+
+   /// Fill bin of h with weight w for an entry at x, y, z as the Fill methods do;
+   /// inRange tells whether bin is neither an underflow nor an overflow.
+   /// Return bin, or -1 if the entry does not enter the statistics.
+   Int_t Fill(TH1 &h, Int_t bin, Bool_t inRange, Double_t w, Int_t ndim, Double_t x, Double_t y = 0, Double_t z = 0)
+   {
+      if (bin < 0) {
+         AddEntry();
+         return -1;
+      }
+      AddBinContent(h, bin, w);
+      if (!inRange && !h.GetStatOverflowsBehaviour()) {
+         AddEntry();
+         return -1;
+      }
+      AddEntry(ndim, w, x, y, z);
+      return bin;
+   }
+
+   /// Add the statistics accumulated so far to h, which must not be filled meanwhile.
+   void Flush(TH1 &h)
+   {
+      Double_t s[kNSums] = {0};
+      Double_t entries = 0;
+      for (auto &slot : fStatSlots) {
+         std::lock_guard<std::mutex> lock(slot.fMutex);
+         entries += slot.fEntries;
+         for (Int_t i = 0; i < kNSums; ++i)
+            s[i] += slot.fSums[i];
+         slot.fEntries = 0;
+         std::fill(slot.fSums, slot.fSums + kNSums, 0.);
+      }
+      h.fEntries += entries;
+      h.fTsumw += s[0];
+      h.fTsumw2 += s[1];
+      h.fTsumwx += s[2];
+      h.fTsumwx2 += s[3];
+      if (TH2 *h2 = dynamic_cast<TH2 *>(&h)) {
+         h2->fTsumwy += s[4];
+         h2->fTsumwy2 += s[5];
+         h2->fTsumwxy += s[6];
+      } else if (TH3 *h3 = dynamic_cast<TH3 *>(&h)) {
+         h3->fTsumwy += s[4];
+         h3->fTsumwy2 += s[5];
+         h3->fTsumwxy += s[6];
+         h3->fTsumwz += s[7];
+         h3->fTsumwz2 += s[8];
+         h3->fTsumwxz += s[9];
+         h3->fTsumwyz += s[10];
+      }
+   }
+
+   /// Forget the statistics accumulated so far.
+   void Clear()
+   {
+      for (auto &slot : fStatSlots) {
+         std::lock_guard<std::mutex> lock(slot.fMutex);
+         slot.fEntries = 0;
+         std::fill(slot.fSums, slot.fSums + kNSums, 0.);
+      }
+   }
+};
+
+#endif
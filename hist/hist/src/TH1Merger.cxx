@@ -8,6 +8,7 @@
 #include "TError.h"
 #include "THashList.h"
 #include "TClass.h"
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -16,6 +17,61 @@
    Printf(" base: %f %f %d, %s: %f %f %d", a->GetXmin(), a->GetXmax(), a->GetNbins(), bn, b->GetXmin(), b->GetXmax(), \
           b->GetNbins());
 
+namespace {
+
+// Sum of two bin contents as done by AddBinContent(bin, w) of the histogram
+// classes: the integer ones saturate.
+template <typename T>
+struct TBinSum {
+   static T Add(T a, T b) { return a + b; }
+};
+
+template <typename T, Long64_t MAX>
+struct TSaturatedBinSum {
+   static T Add(T a, T b)
+   {
+      const Long64_t sum = (Long64_t)a + b;
+      return sum > MAX ? MAX : (sum < -MAX ? -MAX : sum);
+   }
+};
+
+template <>
+struct TBinSum<Char_t> : TSaturatedBinSum<Char_t, 127> {};
+template <>
+struct TBinSum<Short_t> : TSaturatedBinSum<Short_t, 32767> {};
+template <>
+struct TBinSum<Int_t> : TSaturatedBinSum<Int_t, 2147483647> {};
+
+// Add the arrays src (and their sums of squares of weights srcSumw2, which
+// are the contents where null) to dst (and dstSumw2, if not null), all of
+// size n. The arrays are added block by block, so that a block of dst stays
+// in the cache while all the histograms are added to it.
+template <typename T>
+void AddArrays(T *dst, Double_t *dstSumw2, const std::vector<const T *> &src,
+               const std::vector<const Double_t *> &srcSumw2, Int_t n)
+{
+   const Int_t kBlockSize = 2048;
+   for (Int_t first = 0; first < n; first += kBlockSize) {
+      const Int_t last = std::min(n, first + kBlockSize);
+      for (size_t ih = 0; ih < src.size(); ++ih) {
+         const T *s = src[ih];
+         for (Int_t i = first; i < last; ++i)
+            dst[i] = TBinSum<T>::Add(dst[i], s[i]);
+         if (!dstSumw2)
+            continue;
+         if (const Double_t *w2 = srcSumw2[ih]) {
+            for (Int_t i = first; i < last; ++i)
+               dstSumw2[i] += w2[i];
+         } else {
+            for (Int_t i = first; i < last; ++i)
+               dstSumw2[i] += s[i];
+         }
+      }
+   }
+}
+
+} // anonymous namespace
+
 Bool_t TH1Merger::AxesHaveLimits(const TH1 * h) {
    Bool_t hasLimits = h->GetXaxis()->GetXmin() < h->GetXaxis()->GetXmax();
    if (h->GetDimension() > 1) hasLimits &=  h->GetYaxis()->GetXmin() < h->GetYaxis()->GetXmax();
@@ -747,6 +803,7 @@ Bool_t TH1Merger::SameAxesMerge() {
    fH0->GetStats(totstats);
    Double_t nentries = fH0->GetEntries();
    
+   std::vector<TH1 *> hists;
    TIter next(&fInputList); 
    while (TH1* hist=(TH1*)next()) {
       // process only if the histogram has limits; otherwise it was processed before
@@ -763,18 +820,22 @@ Bool_t TH1Merger::SameAxesMerge() {
       for (Int_t i=0; i<TH1::kNstat; i++)
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
+      hists.push_back(hist);
+   }
 
-         //Int_t nx = hist->GetXaxis()->GetNbins();
+   // add the bin contents
+   if (!SameClassMerge(hists)) {
+      for (TH1 *hist : hists) {
          // loop on bins of the histogram and do the merge
-      for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
-
-         Double_t cu = hist->RetrieveBinContent(ibin);
-         Double_t e1sq = TMath::Abs(cu);
-         if (fH0->fSumw2.fN) e1sq= hist->GetBinErrorSqUnchecked(ibin);
+         for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
 
-         fH0->AddBinContent(ibin,cu);
-         if (fH0->fSumw2.fN) fH0->fSumw2.fArray[ibin] += e1sq;
+            Double_t cu = hist->RetrieveBinContent(ibin);
+            Double_t e1sq = TMath::Abs(cu);
+            if (fH0->fSumw2.fN) e1sq= hist->GetBinErrorSqUnchecked(ibin);
 
+            fH0->AddBinContent(ibin,cu);
+            if (fH0->fSumw2.fN) fH0->fSumw2.fArray[ibin] += e1sq;
+         }
       }
    }
    //copy merged stats
@@ -784,6 +845,47 @@ Bool_t TH1Merger::SameAxesMerge() {
    return kTRUE;
 }
 
+/**
+   Add the bin contents of histograms with the same axes, if they all are of
+   the class of fH0 and fH0 is one of the TH1, TH2 or TH3 classes with a
+   single array of bin contents: their arrays are added directly, instead of
+   bin by bin through the virtual bin content accessors.
+   Return kFALSE if the histograms have to be added bin by bin.
+ */
+Bool_t TH1Merger::SameClassMerge(const std::vector<TH1 *> &hists) {
+
+   TClass *cl = fH0->IsA();
+   for (TH1 *hist : hists)
+      if (hist->IsA() != cl || hist->fNcells != fH0->fNcells) return kFALSE;
+
+   if (cl == TH1D::Class() || cl == TH2D::Class() || cl == TH3D::Class())
+      SameClassMerge<Double_t, TArrayD>(hists);
+   else if (cl == TH1F::Class() || cl == TH2F::Class() || cl == TH3F::Class())
+      SameClassMerge<Float_t, TArrayF>(hists);
+   else if (cl == TH1I::Class() || cl == TH2I::Class() || cl == TH3I::Class())
+      SameClassMerge<Int_t, TArrayI>(hists);
+   else if (cl == TH1S::Class() || cl == TH2S::Class() || cl == TH3S::Class())
+      SameClassMerge<Short_t, TArrayS>(hists);
+   else if (cl == TH1C::Class() || cl == TH2C::Class() || cl == TH3C::Class())
+      SameClassMerge<Char_t, TArrayC>(hists);
+   else
+      return kFALSE;
+   return kTRUE;
+}
+
+template <typename T, typename ARRAY>
+void TH1Merger::SameClassMerge(const std::vector<TH1 *> &hists) {
+
+   std::vector<const T *> src;
+   std::vector<const Double_t *> srcSumw2;
+   for (TH1 *hist : hists) {
+      src.push_back(dynamic_cast<ARRAY *>(hist)->fArray);
+      srcSumw2.push_back(hist->fSumw2.fN ? hist->fSumw2.fArray : nullptr);
+   }
+   AddArrays(dynamic_cast<ARRAY *>(fH0)->fArray, fH0->fSumw2.fN ? fH0->fSumw2.fArray : nullptr,
+             src, srcSumw2, fH0->fNcells);
+}
+
 
 /**
    Merged histogram when axis can be different. 
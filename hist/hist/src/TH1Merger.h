@@ -14,6 +14,8 @@
 #include "TH1.h"
 #include "TList.h"
 
+#include <vector>
+
 class TH1Merger {
 
 public:
@@ -83,6 +85,11 @@ private:
 
    Bool_t SameAxesMerge();
 
+   Bool_t SameClassMerge(const std::vector<TH1 *> &hists);
+
+   template <typename T, typename ARRAY>
+   void SameClassMerge(const std::vector<TH1 *> &hists);
+
    Bool_t DifferentAxesMerge();
 
    Bool_t LabelMerge();
@@ -24,6 +24,8 @@
 #include "TMath.h"
 #include "TObjString.h"
 #include "TVirtualHistPainter.h"
+#include "TFixedBinFinder.h"
+#include "TH1ConcurrentFill.h"
 
 
 ClassImp(TH2);
@@ -316,6 +318,13 @@ Int_t TH2::Fill(Double_t x,Double_t y)
    if (fBuffer) return BufferFill(x,y,1);
 
    Int_t binx, biny, bin;
+   if (fConcurrentFill) {
+      binx = fXaxis.FindBin(x);
+      biny = fYaxis.FindBin(y);
+      bin = (binx < 0 || biny < 0) ? -1 : biny*(fXaxis.GetNbins()+2) + binx;
+      Bool_t inRange = binx > 0 && binx <= fXaxis.GetNbins() && biny > 0 && biny <= fYaxis.GetNbins();
+      return fConcurrentFill->Fill(*this, bin, inRange, 1, 2, x, y);
+   }
    fEntries++;
    binx = fXaxis.FindBin(x);
    biny = fYaxis.FindBin(y);
@@ -360,6 +369,13 @@ Int_t TH2::Fill(Double_t x, Double_t y, Double_t w)
    if (fBuffer) return BufferFill(x,y,w);
 
    Int_t binx, biny, bin;
+   if (fConcurrentFill) {
+      binx = fXaxis.FindBin(x);
+      biny = fYaxis.FindBin(y);
+      bin = (binx < 0 || biny < 0) ? -1 : biny*(fXaxis.GetNbins()+2) + binx;
+      Bool_t inRange = binx > 0 && binx <= fXaxis.GetNbins() && biny > 0 && biny <= fYaxis.GetNbins();
+      return fConcurrentFill->Fill(*this, bin, inRange, w, 2, x, y);
+   }
    fEntries++;
    binx = fXaxis.FindBin(x);
    biny = fYaxis.FindBin(y);
@@ -551,7 +567,60 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
          return;
    }
 
+   // the concurrent filling goes through the locks of Fill
+   if (fConcurrentFill) {
+      for (i=ifirst;i<ntimes;i+=stride)
+         Fill(x[i], y[i], w ? w[i] : 1.);
+      return;
+   }
+
    Double_t ww = 1;
+   if (TFixedBinFinder::CanUse(fXaxis) && TFixedBinFinder::CanUse(fYaxis)) {
+      // The bins of a chunk are computed at once; the statistics are summed
+      // in the same order as below, in local variables.
+      const TFixedBinFinder finderx(fXaxis);
+      const TFixedBinFinder findery(fYaxis);
+      const Int_t nx = fXaxis.GetNbins();
+      const Int_t ny = fYaxis.GetNbins();
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+      Double_t tsumwy = fTsumwy, tsumwy2 = fTsumwy2, tsumwxy = fTsumwxy;
+      Int_t binsx[TFixedBinFinder::kChunkSize];
+      Int_t binsy[TFixedBinFinder::kChunkSize];
+      const Int_t nentries = (ntimes - ifirst + stride - 1) / stride;
+      for (Int_t first = 0; first < nentries; first += TFixedBinFinder::kChunkSize) {
+         const Int_t n = TMath::Min(nentries - first, (Int_t)TFixedBinFinder::kChunkSize);
+         const Int_t offset = ifirst + first * stride;
+         const Double_t *xc = x + offset;
+         const Double_t *yc = y + offset;
+         const Double_t *wc = w ? w + offset : nullptr;
+         finderx.FindBins(n, xc, stride, binsx);
+         findery.FindBins(n, yc, stride, binsy);
+         fEntries += n;
+         for (Int_t j = 0; j < n; ++j) {
+            binx = binsx[j];
+            biny = binsy[j];
+            bin  = biny*(nx+2) + binx;
+            if (wc) ww = wc[j * stride];
+            if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin,ww);
+            if (!statOverflows && (binx == 0 || binx > nx || biny == 0 || biny > ny)) continue;
+            const Double_t xx = xc[j * stride];
+            const Double_t yy = yc[j * stride];
+            tsumw   += ww;
+            tsumw2  += ww*ww;
+            tsumwx  += ww*xx;
+            tsumwx2 += ww*xx*xx;
+            tsumwy  += ww*yy;
+            tsumwy2 += ww*yy*yy;
+            tsumwxy += ww*xx*yy;
+         }
+      }
+      fTsumw = tsumw; fTsumw2 = tsumw2; fTsumwx = tsumwx; fTsumwx2 = tsumwx2;
+      fTsumwy = tsumwy; fTsumwy2 = tsumwy2; fTsumwxy = tsumwxy;
+      return;
+   }
    for (i=ifirst;i<ntimes;i+=stride) {
       fEntries++;
       binx = fXaxis.FindBin(x[i]);
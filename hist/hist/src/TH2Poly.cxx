@@ -11,12 +11,15 @@
  *************************************************************************/
 
 #include "TH2Poly.h"
+#include "TH2PolyBinIndex.h"
 #include "TMultiGraph.h"
 #include "TGraph.h"
 #include "TClass.h"
 #include "TList.h"
 #include "TMath.h"
 
+#include <algorithm>
+
 ClassImp(TH2Poly);
 
 /** \class TH2Poly
@@ -56,7 +59,8 @@ histogram limits is added. This is done when the default constructor (with no
 arguments) is used. It generates a histogram with no limits along the X and Y
 axis. Adding bins to it will extend it up to a proper size.
 
-`TH2Poly` implements a partitioning algorithm to speed up bins' filling.
+`TH2Poly` finds the bin containing a coordinate with an index of the bins,
+see below. It also implements a partitioning algorithm to speed up bins' filling.
 The partitioning algorithm divides the histogram into regions called cells.
 The bins that each cell intersects are recorded in an array of `TList`s.
 When a coordinate in the histogram is to be filled; the method (quickly) finds
@@ -134,6 +138,17 @@ filling, it also adds a constant time delay into the code. When `Fill()`
 is to be called many times, it is more efficient to divide the histogram into
 a large number cells. However, if the histogram is to be filled only a few
 times, it is better to divide into a small number of cells.
+
+## Index of the Bins
+With many irregular bins, e.g. the 10^5 cells of a detector map, a partition
+cell still holds many bins. `FindBin()` and `Fill()` therefore use a
+bounding volume hierarchy over the bins instead: a binary tree whose nodes
+hold the bounding box of the bins below them. Locating a coordinate descends
+only into the nodes whose box contains it, which takes a time logarithmic in
+the number of bins, and tests `IsInside()` only for the bins whose own
+bounding box contains the coordinate. The index is not stored; it is built
+at the first `FindBin()` or `Fill()` after bins have been added. The
+partition cells are still maintained, as part of the stored histogram.
 */
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -181,6 +196,7 @@ TH2Poly::~TH2Poly()
    delete[] fCells;
    delete[] fIsEmpty;
    delete[] fCompletelyInside;
+   delete fBinIndex;
    // delete at the end the bin List since it owns the objects
    delete fBins;
 }
@@ -571,28 +587,9 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
    else if (x > fXaxis.GetXmin()) overflow += -1;
    if (overflow != -5) return overflow;
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) return -5;
-
-   TH2PolyBin *bin;
-
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
-
-   // Search for the bin in the cell
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      if (bin->IsInside(x,y)) return bin->GetBinNumber();
-   }
+   // Search for the bin in the index
+   TH2PolyBin *bin = GetBinIndex()->FindFirst(x, y);
+   if (bin) return bin->GetBinNumber();
 
    // If the search has not returned a bin, the point must be on "the sea"
    return -5;
@@ -600,7 +597,7 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment the bin containing (x,y) by 1.
-/// Uses the partitioning algorithm.
+/// Uses the index of the bins.
 
 Int_t TH2Poly::Fill(Double_t x, Double_t y)
 {
@@ -609,7 +606,7 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment the bin containing (x,y) by w.
-/// Uses the partitioning algorithm.
+/// Uses the index of the bins.
 
 Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
 {
@@ -626,48 +623,23 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
       return overflow;
    }
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
+   TH2PolyBin *bin = GetBinIndex()->FindFirst(x, y);
+   if (bin) {
+      bin->Fill(w);
 
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) {
-      fOverflow[4]+= w;
-      if (fSumw2.fN) fSumw2.fArray[4] += w*w;
-      return -5;
-   }
-
-   TH2PolyBin *bin;
-   Int_t bi;
-
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
-
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
+      // Statistics
+      fTsumw   = fTsumw + w;
+      fTsumwx  = fTsumwx + w*x;
+      fTsumwx2 = fTsumwx2 + w*x*x;
+      fTsumwy  = fTsumwy + w*y;
+      fTsumwy2 = fTsumwy2 + w*y*y;
       // needs to account offset in array for overflow bins
-      bi = bin->GetBinNumber()-1+kNOverflow;
-      if (bin->IsInside(x,y)) {
-         bin->Fill(w);
-
-         // Statistics
-         fTsumw   = fTsumw + w;
-         fTsumwx  = fTsumwx + w*x;
-         fTsumwx2 = fTsumwx2 + w*x*x;
-         fTsumwy  = fTsumwy + w*y;
-         fTsumwy2 = fTsumwy2 + w*y*y;
-         if (fSumw2.fN) fSumw2.fArray[bi] += w*w;
-         fEntries++;
+      if (fSumw2.fN) fSumw2.fArray[bin->GetBinNumber()-1+kNOverflow] += w*w;
+      fEntries++;
 
-         SetBinContentChanged(kTRUE);
+      SetBinContentChanged(kTRUE);
 
-         return bin->GetBinNumber();
-      }
+      return bin->GetBinNumber();
    }
 
    fOverflow[4]+= w;
@@ -706,14 +678,17 @@ Int_t TH2Poly::Fill(const char* name, Double_t w)
 ///                      (array size must be ntimes*stride)
 /// \param [in] x:       array of x values to be histogrammed
 /// \param [in] y:       array of y values to be histogrammed
-/// \param [in] w:       array of weights
+/// \param [in] w:       array of weights, or 0 for weights 1
 /// \param [in] stride:  step size through arrays x, y and w
+///
+/// The index of the bins is built once for all the entries.
 
 void TH2Poly::FillN(Int_t ntimes, const Double_t* x, const Double_t* y,
                                const Double_t* w, Int_t stride)
 {
+   GetBinIndex();
    for (int i = 0; i < ntimes; i += stride) {
-      Fill(x[i], y[i], w[i]);
+      Fill(x[i], y[i], w ? w[i] : 1.);
    }
 }
 
@@ -960,6 +935,7 @@ void TH2Poly::Initialize(Double_t xlow, Double_t xup,
 
    fBins   = 0;
    fNcells = kNOverflow;
+   fBinIndex = 0;
 
    // Sets the boundaries of the histogram
    fXaxis.Set(100, xlow, xup);
@@ -1276,6 +1252,17 @@ Bool_t TH2Poly::IsInsideBin(Int_t binnr, Double_t x, Double_t y)
    return bin->IsInside(x,y);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the index of the bins, (re)built if bins have been added since
+/// it was last used.
+
+TH2PolyBinIndex *TH2Poly::GetBinIndex()
+{
+   if (!fBinIndex) fBinIndex = new TH2PolyBinIndex();
+   if (fBinIndex->GetSize() != GetNumberOfBins()) fBinIndex->Build(fBins);
+   return fBinIndex;
+}
+
 void TH2Poly::GetStats(Double_t *stats) const
 {
    stats[0] = fTsumw;
@@ -1287,6 +1274,87 @@ void TH2Poly::GetStats(Double_t *stats) const
    stats[6] = fTsumwxy;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Builds the index of the bins in the list bins (of TH2PolyBin).
+
+void TH2PolyBinIndex::Build(TList *bins)
+{
+   fEntries.clear();
+   fNodes.clear();
+   if (!bins) return;
+
+   TIter next(bins);
+   TObject *obj;
+   while ((obj = next())) {
+      TH2PolyBin *bin = (TH2PolyBin*) obj;
+      TEntry entry;
+      entry.fBox.fXmin = bin->GetXMin();
+      entry.fBox.fXmax = bin->GetXMax();
+      entry.fBox.fYmin = bin->GetYMin();
+      entry.fBox.fYmax = bin->GetYMax();
+      entry.fBin = bin;
+      entry.fNumber = bin->GetBinNumber();
+      fEntries.push_back(entry);
+   }
+   if (fEntries.empty()) return;
+
+   fNodes.reserve(2 * fEntries.size() / kLeafSize + 1);
+   fNodes.push_back(TNode());
+   BuildNode(0, 0, fEntries.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sets up node for the entries [first, last): a leaf if they are few,
+/// otherwise two children splitting them at the median of the centers of
+/// their boxes along the longer side.
+
+void TH2PolyBinIndex::BuildNode(Int_t node, Int_t first, Int_t last)
+{
+   TBox box = fEntries[first].fBox;
+   TBox centers = {TMath::Infinity(), -TMath::Infinity(), TMath::Infinity(), -TMath::Infinity()};
+   Int_t minNumber = fEntries[first].fNumber;
+   for (Int_t i = first; i < last; ++i) {
+      const TBox &b = fEntries[i].fBox;
+      box.fXmin = std::min(box.fXmin, b.fXmin);
+      box.fXmax = std::max(box.fXmax, b.fXmax);
+      box.fYmin = std::min(box.fYmin, b.fYmin);
+      box.fYmax = std::max(box.fYmax, b.fYmax);
+      const Double_t cx = 0.5 * (b.fXmin + b.fXmax);
+      const Double_t cy = 0.5 * (b.fYmin + b.fYmax);
+      centers.fXmin = std::min(centers.fXmin, cx);
+      centers.fXmax = std::max(centers.fXmax, cx);
+      centers.fYmin = std::min(centers.fYmin, cy);
+      centers.fYmax = std::max(centers.fYmax, cy);
+      minNumber = std::min(minNumber, fEntries[i].fNumber);
+   }
+   fNodes[node].fBox = box;
+   fNodes[node].fMinNumber = minNumber;
+
+   if (last - first <= kLeafSize) {
+      // FindFirst() stops at the first match of a leaf.
+      std::sort(fEntries.begin() + first, fEntries.begin() + last,
+                [](const TEntry &a, const TEntry &b) { return a.fNumber < b.fNumber; });
+      fNodes[node].fFirst = first;
+      fNodes[node].fCount = last - first;
+      return;
+   }
+
+   const Bool_t splitX = centers.fXmax - centers.fXmin >= centers.fYmax - centers.fYmin;
+   const Int_t mid = first + (last - first) / 2;
+   std::nth_element(fEntries.begin() + first, fEntries.begin() + mid, fEntries.begin() + last,
+                    [splitX](const TEntry &a, const TEntry &b) {
+                       return splitX ? a.fBox.fXmin + a.fBox.fXmax < b.fBox.fXmin + b.fBox.fXmax
+                                     : a.fBox.fYmin + a.fBox.fYmax < b.fBox.fYmin + b.fBox.fYmax;
+                    });
+   const Int_t left = fNodes.size();
+   fNodes.push_back(TNode());
+   fNodes.push_back(TNode());
+   fNodes[node].fFirst = left;
+   fNodes[node].fCount = 0;
+   BuildNode(left, first, mid);
+   BuildNode(left + 1, mid, last);
+}
+
 /** \class TH2PolyBin
     \ingroup Hist
 Helper class to represent a bin in the TH2Poly histogram
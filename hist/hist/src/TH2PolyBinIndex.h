@@ -0,0 +1,132 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH2PolyBinIndex
+#define ROOT_TH2PolyBinIndex
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TH2PolyBinIndex                                                      //
+//                                                                      //
+// Bounding volume hierarchy over the bins of a TH2Poly, used to find   //
+// the bins containing a point. The bins are grouped in leaves of a few //
+// bins, the nodes hold the bounding box of their bins and the smallest //
+// bin number below them; the tree is stored in one array, the children //
+// of an inner node following each other. Only the bins whose bounding  //
+// box contains the point are tested with TH2PolyBin::IsInside.         //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TH2Poly.h"
+
+#include <vector>
+
+class TList;
+
+class TH2PolyBinIndex {
+
+private:
+   enum { kLeafSize = 4, kMaxDepth = 64 };
+
+   struct TBox {
+      Double_t fXmin, fXmax, fYmin, fYmax;
+      Bool_t Contains(Double_t x, Double_t y) const { return x >= fXmin && x <= fXmax && y >= fYmin && y <= fYmax; }
+   };
+
+   struct TEntry {
+      TBox fBox;
+      TH2PolyBin *fBin;
+      Int_t fNumber; // bin number of fBin
+   };
+
+   struct TNode {
+      TBox fBox;
+      Int_t fMinNumber; // smallest bin number of the entries below this node
+      Int_t fFirst;     // first entry of a leaf, or first child of an inner node
+      Int_t fCount;     // number of entries of a leaf, 0 for an inner node
+   };
+
+   std::vector<TEntry> fEntries; // grouped by leaf, sorted by bin number within a leaf
+   std::vector<TNode> fNodes;    // fNodes[0] is the root
+
+   void BuildNode(Int_t node, Int_t first, Int_t last);
+
+public:
+   void Build(TList *bins);
+   Int_t GetSize() const { return fEntries.size(); }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Return the bin with the smallest number containing (x,y), or 0.
+
+   TH2PolyBin *FindFirst(Double_t x, Double_t y) const
+   {
+      if (fNodes.empty())
+         return 0;
+      TH2PolyBin *found = 0;
+      Int_t foundNumber = 0;
+      Int_t stack[kMaxDepth];
+      Int_t nstack = 0;
+      stack[nstack++] = 0;
+      while (nstack) {
+         const TNode &node = fNodes[stack[--nstack]];
+         if ((found && node.fMinNumber >= foundNumber) || !node.fBox.Contains(x, y))
+            continue;
+         if (!node.fCount) {
+            // Visit the child with the smaller bin numbers first.
+            const Int_t left = node.fFirst;
+            const Bool_t leftFirst = fNodes[left].fMinNumber < fNodes[left + 1].fMinNumber;
+            stack[nstack++] = leftFirst ? left + 1 : left;
+            stack[nstack++] = leftFirst ? left : left + 1;
+            continue;
+         }
+         for (Int_t i = node.fFirst; i < node.fFirst + node.fCount; ++i) {
+            const TEntry &entry = fEntries[i];
+            if (found && entry.fNumber >= foundNumber)
+               break;
+            if (entry.fBox.Contains(x, y) && entry.fBin->IsInside(x, y)) {
+               found = entry.fBin;
+               foundNumber = entry.fNumber;
+               break;
+            }
+         }
+      }
+      return found;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Call func(bin) for each bin containing (x,y), in no particular order.
+
+   template <class FUNC>
+   void ForEach(Double_t x, Double_t y, FUNC func) const
+   {
+      if (fNodes.empty())
+         return;
+      Int_t stack[kMaxDepth];
+      Int_t nstack = 0;
+      stack[nstack++] = 0;
+      while (nstack) {
+         const TNode &node = fNodes[stack[--nstack]];
+         if (!node.fBox.Contains(x, y))
+            continue;
+         if (!node.fCount) {
+            stack[nstack++] = node.fFirst;
+            stack[nstack++] = node.fFirst + 1;
+            continue;
+         }
+         for (Int_t i = node.fFirst; i < node.fFirst + node.fCount; ++i) {
+            const TEntry &entry = fEntries[i];
+            if (entry.fBox.Contains(x, y) && entry.fBin->IsInside(x, y))
+               func(entry.fBin);
+         }
+      }
+   }
+};
+
+#endif
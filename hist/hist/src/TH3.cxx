@@ -23,6 +23,8 @@
 #include "TError.h"
 #include "TMath.h"
 #include "TObjString.h"
+#include "TFixedBinFinder.h"
+#include "TH1ConcurrentFill.h"
 
 ClassImp(TH3);
 
@@ -301,6 +303,15 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z)
    if (fBuffer) return BufferFill(x,y,z,1);
 
    Int_t binx, biny, binz, bin;
+   if (fConcurrentFill) {
+      binx = fXaxis.FindBin(x);
+      biny = fYaxis.FindBin(y);
+      binz = fZaxis.FindBin(z);
+      bin = (binx < 0 || biny < 0 || binz < 0) ? -1 : binx + (fXaxis.GetNbins()+2)*(biny + (fYaxis.GetNbins()+2)*binz);
+      Bool_t inRange = binx > 0 && binx <= fXaxis.GetNbins() && biny > 0 && biny <= fYaxis.GetNbins() &&
+                       binz > 0 && binz <= fZaxis.GetNbins();
+      return fConcurrentFill->Fill(*this, bin, inRange, 1, 3, x, y, z);
+   }
    fEntries++;
    binx = fXaxis.FindBin(x);
    biny = fYaxis.FindBin(y);
@@ -349,6 +360,15 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
    if (fBuffer) return BufferFill(x,y,z,w);
 
    Int_t binx, biny, binz, bin;
+   if (fConcurrentFill) {
+      binx = fXaxis.FindBin(x);
+      biny = fYaxis.FindBin(y);
+      binz = fZaxis.FindBin(z);
+      bin = (binx < 0 || biny < 0 || binz < 0) ? -1 : binx + (fXaxis.GetNbins()+2)*(biny + (fYaxis.GetNbins()+2)*binz);
+      Bool_t inRange = binx > 0 && binx <= fXaxis.GetNbins() && biny > 0 && biny <= fYaxis.GetNbins() &&
+                       binz > 0 && binz <= fZaxis.GetNbins();
+      return fConcurrentFill->Fill(*this, bin, inRange, w, 3, x, y, z);
+   }
    fEntries++;
    binx = fXaxis.FindBin(x);
    biny = fYaxis.FindBin(y);
@@ -382,6 +402,108 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y, z and w (array size must be ntimes*stride)
+///  - x:       array of x values to be histogrammed
+///  - y:       array of y values to be histogrammed
+///  - z:       array of z values to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+/// It is equivalent to calling Fill(x[i],y[i],z[i],w[i]) for each entry; when
+/// the three axes have fixed bins and cannot be extended, the bins are
+/// computed a chunk of entries at a time.
+/// If w is NULL each entry is assumed a weight=1
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t binx, biny, binz, bin, i;
+   ntimes *= stride;
+   Int_t ifirst = 0;
+
+   //If a buffer is activated, fill buffer
+   if (fBuffer) {
+      for (i=0;i<ntimes;i+=stride) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         if (w) BufferFill(x[i],y[i],z[i],w[i]);
+         else BufferFill(x[i], y[i], z[i], 1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==0)
+         ifirst = i;
+      else
+         return;
+   }
+
+   // the concurrent filling goes through the locks of Fill
+   if (fConcurrentFill || !TFixedBinFinder::CanUse(fXaxis) || !TFixedBinFinder::CanUse(fYaxis) ||
+       !TFixedBinFinder::CanUse(fZaxis)) {
+      for (i=ifirst;i<ntimes;i+=stride)
+         Fill(x[i], y[i], z[i], w ? w[i] : 1.);
+      return;
+   }
+
+   // The statistics are summed in the same order as in Fill, in local variables.
+   const TFixedBinFinder finderx(fXaxis);
+   const TFixedBinFinder findery(fYaxis);
+   const TFixedBinFinder finderz(fZaxis);
+   const Int_t nx = fXaxis.GetNbins();
+   const Int_t ny = fYaxis.GetNbins();
+   const Int_t nz = fZaxis.GetNbins();
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+   Double_t tsumwy = fTsumwy, tsumwy2 = fTsumwy2, tsumwxy = fTsumwxy;
+   Double_t tsumwz = fTsumwz, tsumwz2 = fTsumwz2, tsumwxz = fTsumwxz, tsumwyz = fTsumwyz;
+   Int_t binsx[TFixedBinFinder::kChunkSize];
+   Int_t binsy[TFixedBinFinder::kChunkSize];
+   Int_t binsz[TFixedBinFinder::kChunkSize];
+   Double_t ww = 1;
+   const Int_t nentries = (ntimes - ifirst + stride - 1) / stride;
+   for (Int_t first = 0; first < nentries; first += TFixedBinFinder::kChunkSize) {
+      const Int_t n = TMath::Min(nentries - first, (Int_t)TFixedBinFinder::kChunkSize);
+      const Int_t offset = ifirst + first * stride;
+      const Double_t *xc = x + offset;
+      const Double_t *yc = y + offset;
+      const Double_t *zc = z + offset;
+      const Double_t *wc = w ? w + offset : nullptr;
+      finderx.FindBins(n, xc, stride, binsx);
+      findery.FindBins(n, yc, stride, binsy);
+      finderz.FindBins(n, zc, stride, binsz);
+      fEntries += n;
+      for (Int_t j = 0; j < n; ++j) {
+         binx = binsx[j];
+         biny = binsy[j];
+         binz = binsz[j];
+         bin  = binx + (nx+2)*(biny + (ny+2)*binz);
+         if (wc) ww = wc[j * stride];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (!statOverflows && (binx == 0 || binx > nx || biny == 0 || biny > ny || binz == 0 || binz > nz)) continue;
+         const Double_t xx = xc[j * stride];
+         const Double_t yy = yc[j * stride];
+         const Double_t zz = zc[j * stride];
+         tsumw   += ww;
+         tsumw2  += ww*ww;
+         tsumwx  += ww*xx;
+         tsumwx2 += ww*xx*xx;
+         tsumwy  += ww*yy;
+         tsumwy2 += ww*yy*yy;
+         tsumwxy += ww*xx*yy;
+         tsumwz  += ww*zz;
+         tsumwz2 += ww*zz*zz;
+         tsumwxz += ww*xx*zz;
+         tsumwyz += ww*yy*zz;
+      }
+   }
+   fTsumw = tsumw; fTsumw2 = tsumw2; fTsumwx = tsumwx; fTsumwx2 = tsumwx2;
+   fTsumwy = tsumwy; fTsumwy2 = tsumwy2; fTsumwxy = tsumwxy;
+   fTsumwz = tsumwz; fTsumwz2 = tsumwz2; fTsumwxz = tsumwxz; fTsumwyz = tsumwyz;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment cell defined by namex,namey,namez by a weight w
 ///
@@ -32,6 +32,10 @@
 #include "Math/MinimizerOptions.h"
 #include "Math/WrappedMultiTF1.h"
 
+#include "ROOT/THistParallel.hxx"
+
+#include <vector>
+
 
 /** \class THnBase
     \ingroup Hist
@@ -523,13 +527,13 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
    Int_t* bins  = new Int_t[ndim];
    Long64_t myLinBin = 0;
 
-   THnIter iter(this, kTRUE /*use axis range*/);
-
-   while ((myLinBin = iter.Next()) >= 0) {
-      Double_t v = GetBinContent(myLinBin);
+   // Add the bin linBin, whose coordinates along the axes dim are in coord,
+   // to the projection.
+   auto addBin = [&](Long64_t linBin, const Int_t* coord) {
+      Double_t v = GetBinContent(linBin);
 
       for (Int_t d = 0; d < ndim; ++d) {
-         bins[d] = iter.GetCoord(dim[d]);
+         bins[d] = coord[d];
          if (!keepTargetAxis && GetAxis(dim[d])->TestBit(TAxis::kAxisRange)) {
             Int_t binOffset = GetAxis(dim[d])->GetFirst();
             // Don't subtract even more if underflow is alreday included:
@@ -550,7 +554,7 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
       if (wantErrors) {
          Double_t err2 = 0.;
          if (haveErrors) {
-            err2 = GetBinError2(myLinBin);
+            err2 = GetBinError2(linBin);
          } else {
             err2 = v;
          }
@@ -567,6 +571,63 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
          hn->AddBinContent(targetLinBin, v);
       else
          hist->AddBinContent(targetLinBin, v);
+   };
+
+   Bool_t haveSkippedBin = kFALSE;
+   const Long64_t nFilledBins = GetNbins();
+   Bool_t done = kFALSE;
+#ifdef R__USE_IMT
+   // The coordinates of the filled bins of a THnSparse are decompressed, and
+   // checked against the axis ranges, by the threads of the implicit
+   // multi-threading pool: one task per chunk of bins of the THnSparse, a
+   // batch of chunks at a time to bound the memory used for the coordinates.
+   // The bins are then added to the projection in the order of the
+   // sequential iteration, so that the result is the same.
+   if (InheritsFrom(THnSparse::Class()) && ROOT::Internal::HistUseImplicitMT(nFilledBins * fNdimensions)) {
+      const THnSparse* hs = static_cast<const THnSparse*>(this);
+      const Long64_t chunkSize = hs->GetChunkSize();
+      const Long64_t nChunksPerBatch = TMath::Max(1LL, TMath::Min(Long64_t(ROOT::Internal::kHistRangesPerThread * ROOT::GetImplicitMTPoolSize()),
+                                                                  (1LL << 22) / chunkSize));
+      const Long64_t batchSize = chunkSize * nChunksPerBatch;
+      std::vector<Int_t> coords(ndim * TMath::Min(batchSize, nFilledBins));
+      std::vector<Char_t> inRange(TMath::Min(batchSize, nFilledBins));
+      // create the compact coordinates of the THnSparse outside of the threads
+      std::vector<Int_t> firstCoord(fNdimensions);
+      hs->GetBinContent(0, firstCoord.data());
+      for (Long64_t first = 0; first < nFilledBins; first += batchSize) {
+         const Long64_t last = TMath::Min(nFilledBins, first + batchSize);
+         const Int_t nChunks = (last - first + chunkSize - 1) / chunkSize;
+         ROOT::Internal::HistForEachChunk(nChunks, chunkSize * fNdimensions, [&](Int_t chunk) {
+            std::vector<Int_t> coord(fNdimensions);
+            const Long64_t end = TMath::Min(last, first + (chunk + 1) * chunkSize);
+            for (Long64_t i = first + chunk * chunkSize; i < end; ++i) {
+               hs->GetBinContent(i, coord.data());
+               inRange[i - first] = IsInRange(coord.data());
+               for (Int_t d = 0; d < ndim; ++d)
+                  coords[(i - first) * ndim + d] = coord[dim[d]];
+            }
+         });
+         for (Long64_t i = first; i < last; ++i) {
+            if (inRange[i - first])
+               addBin(i, &coords[(i - first) * ndim]);
+            else
+               haveSkippedBin = kTRUE;
+         }
+      }
+      done = kTRUE;
+   }
+#endif
+
+   if (!done) {
+      THnIter iter(this, kTRUE /*use axis range*/);
+      Int_t* coord = new Int_t[ndim];
+      while ((myLinBin = iter.Next()) >= 0) {
+         for (Int_t d = 0; d < ndim; ++d)
+            coord[d] = iter.GetCoord(dim[d]);
+         addBin(myLinBin, coord);
+      }
+      haveSkippedBin = iter.HaveSkippedBin();
+      delete [] coord;
    }
 
    delete [] bins;
@@ -574,7 +635,7 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
    if (wantNDim) {
       hn->SetEntries(fEntries);
    } else {
-      if (!iter.HaveSkippedBin()) {
+      if (!haveSkippedBin) {
          hist->SetEntries(fEntries);
       } else {
          // re-compute the entries
@@ -643,6 +704,12 @@ void THnBase::AddInternal(const THnBase* h, Double_t c, Bool_t rebinned)
       Sumw2();
    Bool_t haveErrors = GetCalculateErrors();
 
+   // Same storage and binning: let the derived class add the arrays.
+   if (!rebinned && AddSameBinning(h, c)) {
+      SetEntries(GetEntries() + c * h->GetEntries());
+      return;
+   }
+
    Double_t* x = 0;
    if (rebinned) {
       x = new Double_t[fNdimensions];
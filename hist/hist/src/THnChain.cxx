@@ -100,7 +100,7 @@ TObject* THnChain::ProjectionAny(Int_t ndim, const Int_t* dim, Option_t* option)
 
       // Add this histogram.
       if (h_merged) {
-         if (ndim < 3) {
+         if (ndim <= 3) {
             static_cast<TH1*>(h_merged)->Add(static_cast<TH1*>(h));
          } else {
             static_cast<THnBase*>(h_merged)->Add(static_cast<THnBase*>(h));
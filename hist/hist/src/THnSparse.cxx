@@ -17,6 +17,9 @@
 #include "TDataMember.h"
 #include "TDataType.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace {
 //______________________________________________________________________________
 //
@@ -410,6 +413,113 @@ THnSparseCompactBinCoord::~THnSparseCompactBinCoord()
    delete [] fCurrentBin;
 }
 
+/** \class THnSparseBinIndex
+THnSparseBinIndex is used by THnSparse internally to find the linear index
+of a filled bin from the hash of its compact coordinates. It is an open
+addressing hash table with linear probing. Each slot is a single 64 bit word:
+the lower kIndexBits bits hold the linear index + 1 (0 for an empty slot),
+the upper bits a fingerprint of the hash. The coordinates themselves are only
+stored in the chunks; a slot with the right fingerprint is confirmed by
+comparing the coordinates of its bin, which THnSparse passes as a functor.
+The table is kept at most half full, so that a lookup usually reads a single
+cache line.
+*/
+
+class THnSparseBinIndex {
+public:
+   enum { kIndexBits = 40 }; // at most 2^40 - 1 filled bins
+
+   THnSparseBinIndex(): fMask(0), fUsed(0) {}
+
+   Long64_t GetSize() const { return fUsed; }
+   Long64_t GetCapacity() const { return (Long64_t) fSlots.size(); }
+   Bool_t   CanHold(Long64_t nbins) const { return 2 * nbins <= GetCapacity(); }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Remove all bins and release the memory.
+
+   void Clear() {
+      std::vector<ULong64_t>().swap(fSlots);
+      fMask = 0;
+      fUsed = 0;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Remove all bins and make room for nbins bins.
+
+   void Init(Long64_t nbins) {
+      ULong64_t nslots = 64;
+      while ((Long64_t) nslots < 2 * nbins)
+         nslots *= 2;
+      fSlots.assign(nslots, 0);
+      fMask = nslots - 1;
+      fUsed = 0;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Return the linear index of the bin with the given hash for which
+   /// matches(linidx) is true, or -1 if there is none.
+
+   template <class MATCH>
+   Long64_t Find(ULong64_t hash, const MATCH& matches) const {
+      if (!fUsed) return -1;
+      const ULong64_t mixed = Mix(hash);
+      const ULong64_t fingerprint = mixed & ~kIndexMask;
+      for (ULong64_t pos = mixed & fMask; fSlots[pos]; pos = (pos + 1) & fMask) {
+         const ULong64_t slot = fSlots[pos];
+         if ((slot & ~kIndexMask) == fingerprint) {
+            const Long64_t linidx = (Long64_t) (slot & kIndexMask) - 1;
+            if (matches(linidx))
+               return linidx;
+         }
+      }
+      return -1;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Add the bin linidx with the given hash, which must not be in the table
+   /// yet; CanHold(GetSize() + 1) must be true.
+
+   void Insert(ULong64_t hash, Long64_t linidx) {
+      const ULong64_t mixed = Mix(hash);
+      ULong64_t pos = mixed & fMask;
+      while (fSlots[pos])
+         pos = (pos + 1) & fMask;
+      fSlots[pos] = (mixed & ~kIndexMask) | (ULong64_t) (linidx + 1);
+      ++fUsed;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Announce a lookup of hash, to load its slot into the cache meanwhile.
+
+   void Prefetch(ULong64_t hash) const {
+#if defined(__GNUC__) || defined(__clang__)
+      if (fUsed)
+         __builtin_prefetch(&fSlots[Mix(hash) & fMask]);
+#else
+      (void) hash;
+#endif
+   }
+
+private:
+   static const ULong64_t kIndexMask = (1ULL << kIndexBits) - 1;
+
+   // Spread the bits of the hash: the compact coordinates used as hash of
+   // small histograms have their entropy in the lowest bits.
+   static ULong64_t Mix(ULong64_t h) {
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+      return h;
+   }
+
+   std::vector<ULong64_t> fSlots; // fingerprint | (linear index + 1), 0 if empty
+   ULong64_t fMask;               // fSlots.size() - 1, a power of 2 minus 1
+   Long64_t  fUsed;               // number of filled slots
+};
+
 /** \class THnSparseArrayChunk
 THnSparseArrayChunk is used internally by THnSparse.
 THnSparse stores its (dynamic size) array of bin coordinates and their
@@ -571,14 +681,16 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+This hash is used to lookup the linear index in the internal class
+THnSparseBinIndex, an open addressing hash table that stores a single 64 bit
+word per slot - the linear index and a fingerprint of the hash - and keeps
+at most half of its slots used. Bins with the same fingerprint, which is
+unlikely, are told apart by comparing their coordinates stored in the chunks
+with the ones passed to GetBin(). The index is not streamed; it is rebuilt
+from the chunks when needed.
+
+Many entries can be filled at once with FillN(), which overlaps the lookups
+of consecutive entries.
 */
 
 
@@ -588,7 +700,7 @@ ClassImp(THnSparse);
 /// Construct an empty THnSparse.
 
 THnSparse::THnSparse():
-   fChunkSize(1024), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(1024), fFilledBins(0), fBinIndex(0), fCompactCoord(0)
 {
    fBinContent.SetOwner();
 }
@@ -605,7 +717,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
                      const Int_t* nbins, const Double_t* xmin, const Double_t* xmax,
                      Int_t chunksize):
    THnBase(name, title, dim, nbins, xmin, xmax),
-   fChunkSize(chunksize), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(chunksize), fFilledBins(0), fBinIndex(0), fCompactCoord(0)
 {
    fCompactCoord = new THnSparseCompactBinCoord(dim, nbins);
    fBinContent.SetOwner();
@@ -615,6 +727,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
 /// Destruct a THnSparse
 
 THnSparse::~THnSparse() {
+   delete fBinIndex;
    delete fCompactCoord;
 }
 
@@ -629,6 +742,43 @@ void THnSparse::AddBinContent(Long64_t bin, Double_t v)
    return chunk->fContent->SetAt(v, bin);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add c times h if it is a THnSparse with the same number of bins along each
+/// axis, see THnBase::Add(); return false if the bins have to be added one by
+/// one. The compact coordinates of the bins of h are then the ones of this:
+/// the chunks of h are read in order and their bins looked up directly by
+/// their compact coordinates, without decompressing and compressing them
+/// again. The bins are added in the same order, with the same result, as by
+/// THnBase::AddInternal().
+
+Bool_t THnSparse::AddSameBinning(const THnBase* h, Double_t c)
+{
+   const THnSparse* hs = dynamic_cast<const THnSparse*>(h);
+   if (!hs || hs->GetCompactCoord()->GetBufferSize() != GetCompactCoord()->GetBufferSize())
+      return kFALSE;
+
+   Reserve(GetNbins() + hs->GetNbins());
+   const Bool_t haveErrors = GetCalculateErrors();
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   // the chunks of h, if h is this, are not extended: all its bins exist
+   const Int_t nChunks = hs->GetNChunks();
+   for (Int_t iChunk = 0; iChunk < nChunks; ++iChunk) {
+      const THnSparseArrayChunk* chunk = hs->GetChunk(iChunk);
+      const Int_t nBinsChunk = chunk->GetEntries();
+      const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
+      for (Int_t i = 0; i < nBinsChunk; ++i) {
+         cc->SetBuffer(chunk->fCoordinates + i * singleCoordSize);
+         const Long64_t bin = GetBinIndexForCurrentBin(kTRUE);
+         const Double_t v = chunk->fContent->GetAt(i);
+         if (haveErrors)
+            AddBinError2(bin, (chunk->fSumw2 ? chunk->fSumw2->GetAt(i) : v) * c * c);
+         // only _after_ error calculation, or sqrt(v) is taken into account!
+         AddBinContent(bin, c * v);
+      }
+   }
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create a new chunk of bin content
 
@@ -651,49 +801,46 @@ void THnSparse::InitStorage(Int_t* nbins, Int_t chunkSize)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///We have been streamed; set up fBins
+/// Rebuild the bin index from the coordinates stored in the chunks, e.g.
+/// after streaming, with room for at least "nbins" bins.
 
-void THnSparse::FillExMap()
+void THnSparse::FillBinIndex(Long64_t nbins)
 {
+   if (!fBinIndex)
+      fBinIndex = new THnSparseBinIndex();
+   THnSparseBinIndex* index = fBinIndex;
+   const THnSparseCompactBinCoord* cc = GetCompactCoord();
+   index->Init(std::max(nbins, GetNbins()));
    TIter iChunk(&fBinContent);
    THnSparseArrayChunk* chunk = 0;
-   THnSparseCoordCompression compactCoord(*GetCompactCoord());
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
-      Char_t* buf = chunk->fCoordinates;
+      const Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         index->Insert(cc->GetHashFromBuffer(buf), idx);
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the filled bins, up to date with the chunks.
+
+THnSparseBinIndex* THnSparse::GetBinIndex()
+{
+   // Not streamed, hence empty after reading.
+   if (!fBinIndex || (GetNbins() && !fBinIndex->GetSize()))
+      FillBinIndex(GetNbins());
+   return fBinIndex;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize storage for nbins
 
 void THnSparse::Reserve(Long64_t nbins) {
-   if (!fBins.GetSize() && fBinContent.GetSize()) {
-      FillExMap();
-   }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
-   }
+   if (!GetBinIndex()->CanHold(nbins))
+      FillBinIndex(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -737,6 +884,39 @@ Long64_t THnSparse::GetBin(const Int_t* coord, Bool_t allocate /*= kTRUE*/)
    return GetBinIndexForCurrentBin(allocate);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill "nentries" entries at once: x holds the n dimensional tuple of each
+/// entry one after the other, w their weights, or is null for weights 1.
+/// Equivalent to calling Fill() for each entry, but faster for histograms
+/// with many filled bins: the bins of a batch of entries are looked up
+/// while the memory of the next lookups is already being fetched.
+
+void THnSparse::FillN(Int_t nentries, const Double_t* x, const Double_t* w /* = 0 */)
+{
+   enum { kBatchSize = 16 };
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   THnSparseBinIndex* index = GetBinIndex();
+   std::vector<Int_t> coords(kBatchSize * fNdimensions);
+   std::vector<Char_t> buf(std::max<size_t>(cc->GetBufferSize(), sizeof(ULong64_t)));
+
+   for (Int_t first = 0; first < nentries; first += kBatchSize) {
+      const Int_t n = std::min<Int_t>(kBatchSize, nentries - first);
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t* xi = x + (Long64_t)(first + i) * fNdimensions;
+         Int_t* coord = &coords[i * fNdimensions];
+         for (Int_t d = 0; d < fNdimensions; ++d)
+            coord[d] = GetAxis(d)->FindBin(xi[d]);
+         index->Prefetch(cc->SetBufferFromCoord(coord, &buf[0]));
+      }
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t wi = w ? w[first + i] : 1.;
+         UpdateXStat(x + (Long64_t)(first + i) * fNdimensions, wi);
+         cc->SetCoord(&coords[i * fNdimensions]);
+         FillBin(GetBinIndexForCurrentBin(kTRUE), wi);
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the content of the filled bin number "idx".
 /// If coord is non-null, it will contain the bin's coordinates for each axis
@@ -790,22 +970,16 @@ Double_t THnSparse::GetBinError2(Long64_t linidx) const {
 Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 {
    THnSparseCompactBinCoord* cc = GetCompactCoord();
-   ULong64_t hash = cc->GetHash();
-   if (fBinContent.GetSize() && !fBins.GetSize())
-      FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
-
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
-
-      linidx = nextlinidx;
-   }
-   if (!allocate) return -1;
+   THnSparseBinIndex* index = GetBinIndex();
+   const ULong64_t hash = cc->GetHash();
+   const Char_t* buf = cc->GetBuffer();
+   const Int_t coordSize = cc->GetBufferSize();
+   const Int_t chunkSize = fChunkSize;
+   Long64_t linidx = index->Find(hash, [this, buf, coordSize, chunkSize](Long64_t idx) {
+      const THnSparseArrayChunk* chunk = GetChunk(idx / chunkSize);
+      return !memcmp(chunk->fCoordinates + (idx % chunkSize) * coordSize, buf, coordSize);
+   });
+   if (linidx >= 0 || !allocate) return linidx;
 
    ++fFilledBins;
 
@@ -816,20 +990,14 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
       chunk = AddChunk();
       newidx = 0;
    }
-   chunk->AddBin(newidx, cc->GetBuffer());
+   chunk->AddBin(newidx, buf);
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   if (index->CanHold(GetNbins()))
+      index->Insert(hash, newidx);
+   else
+      FillBinIndex(2 * GetNbins()); // includes the new bin
    return newidx;
 }
 
@@ -881,7 +1049,8 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   if (fBinIndex)
+      size += sizeof(ULong64_t) * fBinIndex->GetCapacity();
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -963,8 +1132,8 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   if (fBinIndex)
+      fBinIndex->Clear();
    fBinContent.Delete();
    ResetBase(option);
 }
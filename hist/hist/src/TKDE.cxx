@@ -22,6 +22,14 @@
  
  The algorithm is briefly described in (4). A binned version is also implemented to address the 
  performance issue due to its data size dependance.
+
+ With SetUseFFT(), the density is computed once on a grid of points covering the range and
+ the data, by sharing the events between their nearest grid points and convolving the grid
+ with the kernel by FFT, and evaluated by linear interpolation on the grid. The convolution
+ uses FFTW through TVirtualFFT when it is available, and a radix 2 transform otherwise. The
+ adaptive bandwidths are computed from the density on the grid, and the adaptive estimate
+ interpolates between a few convolutions with geometrically spaced bandwidths. This makes
+ the cost independent of the number of events once the grid is computed.
  */
 
 
@@ -30,6 +38,7 @@
 #include <numeric>
 #include <limits>
 #include <cassert>
+#include <complex>
 
 #include "Math/Error.h"
 #include "TMath.h"
@@ -41,11 +50,99 @@
 #include "TF1.h"
 #include "TH1.h"
 #include "TCanvas.h"
+#include "TPluginManager.h"
+#include "TROOT.h"
+#include "TVirtualFFT.h"
 #include "TKDE.h"
 
 
 ClassImp(TKDE);
 
+namespace {
+
+// Returns whether TVirtualFFT can load the FFTW plugin
+Bool_t HasFFTW() {
+   static const Bool_t hasFFTW = []() {
+      TPluginHandler *h = gROOT->GetPluginManager()->FindHandler("TVirtualFFT", "fftwr2c");
+      return h && h->CheckPlugin() != -1;
+   }();
+   return hasFFTW;
+}
+
+// In place radix 2 transform of the complex array a, whose size is a power of two:
+// forward for sign -1, backward (not normalized) for sign +1
+void RadixTwoFFT(std::vector<std::complex<Double_t> > &a, Int_t sign) {
+   const UInt_t n = a.size();
+   for (UInt_t i = 1, j = 0; i < n; ++i) {
+      UInt_t bit = n >> 1;
+      for (; j & bit; bit >>= 1)
+         j ^= bit;
+      j ^= bit;
+      if (i < j) std::swap(a[i], a[j]);
+   }
+   std::vector<std::complex<Double_t> > twiddles(n / 2);
+   for (UInt_t k = 0; k < n / 2; ++k)
+      twiddles[k] = std::polar(1., sign * 2. * TMath::Pi() * k / n);
+   for (UInt_t len = 2; len <= n; len <<= 1) {
+      const UInt_t half = len / 2, step = n / len;
+      for (UInt_t i = 0; i < n; i += len) {
+         for (UInt_t k = 0; k < half; ++k) {
+            const std::complex<Double_t> u = a[i + k];
+            const std::complex<Double_t> v = a[i + k + half] * twiddles[k * step];
+            a[i + k] = u + v;
+            a[i + k + half] = u - v;
+         }
+      }
+   }
+}
+
+// Replaces a by its circular convolution with b, both real of the same power of two size
+void CircularConvolution(std::vector<Double_t> &a, const std::vector<Double_t> &b) {
+   Int_t n = a.size();
+   if (HasFFTW()) {
+      TVirtualFFT *fftA = TVirtualFFT::FFT(1, &n, "R2C ES K");
+      TVirtualFFT *fftB = TVirtualFFT::FFT(1, &n, "R2C ES K");
+      TVirtualFFT *fftInverse = TVirtualFFT::FFT(1, &n, "C2R ES K");
+      const Bool_t ok = fftA && fftB && fftInverse;
+      if (ok) {
+         fftA->SetPoints(a.data());
+         fftA->Transform();
+         fftB->SetPoints(b.data());
+         fftB->Transform();
+         Double_t reA, imA, reB, imB;
+         for (Int_t i = 0; i <= n / 2; ++i) {
+            fftA->GetPointComplex(i, reA, imA);
+            fftB->GetPointComplex(i, reB, imB);
+            fftInverse->SetPoint(i, reA * reB - imA * imB, reA * imB + imA * reB);
+         }
+         fftInverse->Transform();
+         for (Int_t i = 0; i < n; ++i)
+            a[i] = fftInverse->GetPointReal(i) / n;
+      }
+      delete fftA;
+      delete fftB;
+      delete fftInverse;
+      if (ok) return;
+   }
+   // Both real arrays are transformed at once as the real and imaginary parts of one
+   std::vector<std::complex<Double_t> > z(n);
+   for (Int_t i = 0; i < n; ++i)
+      z[i] = std::complex<Double_t>(a[i], b[i]);
+   RadixTwoFFT(z, -1);
+   std::vector<std::complex<Double_t> > product(n);
+   for (Int_t k = 0; k < n; ++k) {
+      const std::complex<Double_t> zk = z[k], zmk = std::conj(z[(n - k) % n]);
+      const std::complex<Double_t> ak = 0.5 * (zk + zmk);
+      const std::complex<Double_t> bk = std::complex<Double_t>(0., -0.5) * (zk - zmk);
+      product[k] = ak * bk;
+   }
+   RadixTwoFFT(product, +1);
+   for (Int_t i = 0; i < n; ++i)
+      a[i] = product[i].real() / n;
+}
+
+} // anonymous namespace
+
 class TKDE::TKernel {
    TKDE* fKDE;
    UInt_t fNWeights; // Number of kernel weights (bandwidth as vectorized for binning)
@@ -130,6 +227,10 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fNBins = events < 10000 ? 100 : events / 10;
    fNEvents = events;
    fUseBinsNEvents = 10000;
+   fUseFFT = false;
+   fNFFTPoints = 4096;
+   fGridXMin = 0.0;
+   fGridDelta = 0.0;
    fMean = 0.0;
    fSigma = 0.0;
    fXMin = xMin;
@@ -413,6 +514,20 @@ void TKDE::SetRange(Double_t xMin, Double_t xMax) {
    SetKernel();
 }
 
+void TKDE::SetUseFFT(Bool_t useFFT, UInt_t nPoints) {
+   // Sets User option for evaluating the density by interpolation on a grid of nPoints
+   // points, computed by FFT convolution of the data with the kernel. The grid covers the
+   // range and the (mirrored) data: its spacing should be small compared to the bandwidth.
+   // Outside of the grid, the density is computed from the data.
+   if (nPoints < 2) {
+      Warning("SetUseFFT", "The FFT grid needs at least 2 points - use default value !");
+      nPoints = 4096;
+   }
+   fUseFFT = useFFT;
+   fNFFTPoints = nPoints;
+   SetKernel();
+}
+
 // private methods
 
 void TKDE::SetUseBins() {
@@ -543,6 +658,7 @@ void TKDE::SetSigma(Double_t R) {
 
 void TKDE::SetKernel() {
    // Sets the kernel density estimator
+   fGrid.clear();
    UInt_t n = fData.size();
    if (n == 0) return;
    // Optimal bandwidth (Silverman's rule of thumb with assumed Gaussian density)
@@ -551,7 +667,10 @@ void TKDE::SetKernel() {
    if (fKernel) delete fKernel;
    fKernel = new TKernel(weight, this);
    if (fIteration == kAdaptive) {
+      // with the FFT evaluation, the pilot estimate is computed on the grid as well
+      if (fUseFFT) ComputeGrid();
       fKernel->ComputeAdaptiveWeights();
+      fGrid.clear();
    }
 }
 
@@ -671,6 +790,11 @@ Double_t TKDE::operator()(const Double_t* x, const Double_t*) const {
 Double_t TKDE::operator()(Double_t x) const {
    // The class's unary function: returns the kernel density estimate
    if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
+   if (fUseFFT) {
+      if (fGrid.empty()) (const_cast<TKDE*>(this))->ComputeGrid();
+      if (!fGrid.empty() && x >= fGridXMin && x <= fGridXMin + (fGrid.size() - 1) * fGridDelta)
+         return GetGridValue(x);
+   }
    return (*fKernel)(x);
 }
 
@@ -710,7 +834,7 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    for (unsigned int i = 0; i < n; ++i) { 
 //   for (; weight != weights.end(); ++weight, ++data, ++dataW) {
       if (useDataWeights && fKDE->fBinCount[i] <= 0) continue;  // skip negative or null weights
-      f = (*fKDE->fKernel)(fKDE->fData[i]);
+      f = fKDE->fGrid.empty() ? (*fKDE->fKernel)(fKDE->fData[i]) : fKDE->GetGridValue(fKDE->fData[i]);
       if (f <= 0)
          fKDE->Warning("ComputeAdativeWeights","function value is zero or negative for x = %f w = %f",
                        fKDE->fData[i],(useDataWeights) ? fKDE->fBinCount[i] : 1.);
@@ -959,6 +1083,115 @@ UInt_t TKDE::Index(Double_t x) const {
    return bin;
 }
 
+void TKDE::ComputeGrid() {
+   // Computes the density on the grid of fNFFTPoints points for the FFT evaluation.
+   // Each event is shared linearly between its two nearest grid points and, for adaptive
+   // bandwidths, between the two nearest of a few geometrically spaced bandwidths; the
+   // grid of each bandwidth is then convolved with the kernel sampled on the grid.
+   fGrid.clear();
+   UInt_t n = fData.size();
+   if (!fKernel || !fKernelFunction || n == 0) return;
+   const std::vector<Double_t> &weights = fKernel->GetAdaptiveWeights();
+   Bool_t useBins = (fBinCount.size() == n);
+   Double_t nSum = (useBins) ? fSumOfCounts : fNEvents;
+
+   // the events, and their reflections with opposite counts for the asymmetric mirroring
+   std::vector<Double_t> x, count, h;
+   for (UInt_t i = 0; i < n; ++i) {
+      Double_t binCount = (useBins) ? fBinCount[i] : 1.0;
+      if (binCount == 0) continue;
+      x.push_back(fData[i]); count.push_back(binCount); h.push_back(weights[i]);
+      if (fAsymLeft) {
+         x.push_back(2. * fXMin - fData[i]); count.push_back(-binCount); h.push_back(weights[i]);
+      }
+      if (fAsymRight) {
+         x.push_back(2. * fXMax - fData[i]); count.push_back(-binCount); h.push_back(weights[i]);
+      }
+   }
+   if (x.empty()) return;
+   Double_t lo = std::min(fXMin, *std::min_element(x.begin(), x.end()));
+   Double_t hi = std::max(fXMax, *std::max_element(x.begin(), x.end()));
+   if (!(hi > lo)) return;
+   const UInt_t m = fNFFTPoints;
+   const Double_t delta = (hi - lo) / (m - 1);
+
+   // bandwidths between which the adaptive ones are interpolated, at most 2% apart if possible
+   const UInt_t kMaxBandwidths = 64;
+   Double_t hMin = *std::min_element(h.begin(), h.end());
+   Double_t hMax = *std::max_element(h.begin(), h.end());
+   UInt_t nBandwidths = 1;
+   if (hMax > hMin * (1. + 1.E-9))
+      nBandwidths = std::min(kMaxBandwidths, UInt_t(std::ceil(std::log(hMax / hMin) / std::log(1.02)))) + 1;
+   Double_t logStep = (nBandwidths > 1) ? std::log(hMax / hMin) / (nBandwidths - 1) : 0.0;
+
+   std::vector<std::vector<Double_t> > counts(nBandwidths, std::vector<Double_t>(m, 0.0));
+   for (UInt_t i = 0; i < x.size(); ++i) {
+      UInt_t k = 0;
+      Double_t fk = 0.0;
+      if (nBandwidths > 1) {
+         Double_t u = std::log(h[i] / hMin) / logStep;
+         k = std::min(UInt_t(u), nBandwidths - 2);
+         fk = u - k;
+      }
+      Double_t t = (x[i] - lo) / delta;
+      UInt_t j = std::min(UInt_t(t), m - 2);
+      Double_t fj = t - j;
+      counts[k][j] += count[i] * (1. - fk) * (1. - fj);
+      counts[k][j + 1] += count[i] * (1. - fk) * fj;
+      if (fk > 0) {
+         counts[k + 1][j] += count[i] * fk * (1. - fj);
+         counts[k + 1][j + 1] += count[i] * fk * fj;
+      }
+   }
+
+   // support of the kernel, in units of bandwidth
+   Double_t radius = m;
+   switch (fKernelType) {
+      case kGaussian :
+         radius = 9.;
+         break;
+      case kEpanechnikov :
+      case kBiweight :
+      case kCosineArch :
+         radius = 1.;
+         break;
+      default :
+         break;
+   }
+
+   std::vector<Double_t> density(m, 0.0);
+   for (UInt_t k = 0; k < nBandwidths; ++k) {
+      Double_t bandwidth = hMin * std::exp(k * logStep);
+      UInt_t nKernel = UInt_t(std::min<Double_t>(m - 1, std::ceil(radius * bandwidth / delta)));
+      UInt_t size = 1;
+      while (size < m + nKernel) size <<= 1;
+      std::vector<Double_t> grid(size, 0.0), kernel(size, 0.0);
+      std::copy(counts[k].begin(), counts[k].end(), grid.begin());
+      kernel[0] = (*fKernelFunction)(0.) / bandwidth;
+      for (UInt_t d = 1; d <= nKernel; ++d) {
+         kernel[d] = (*fKernelFunction)(d * delta / bandwidth) / bandwidth;
+         kernel[size - d] = (*fKernelFunction)(-(d * delta / bandwidth)) / bandwidth;
+      }
+      CircularConvolution(grid, kernel);
+      for (UInt_t j = 0; j < m; ++j)
+         density[j] += grid[j];
+   }
+   for (UInt_t j = 0; j < m; ++j)
+      density[j] /= nSum;
+   fGrid.swap(density);
+   fGridXMin = lo;
+   fGridDelta = delta;
+}
+
+Double_t TKDE::GetGridValue(Double_t x) const {
+   // Returns the density at x interpolated on the grid of the FFT evaluation
+   Double_t t = (x - fGridXMin) / fGridDelta;
+   if (t <= 0) return fGrid.front();
+   UInt_t j = std::min(UInt_t(t), UInt_t(fGrid.size() - 2));
+   Double_t f = t - j;
+   return (1. - f) * fGrid[j] + f * fGrid[j + 1];
+}
+
 Double_t TKDE::UpperConfidenceInterval(const Double_t* x, const Double_t* p) const {
    // Returns the pointwise upper estimated density
    Double_t f = (*this)(x);
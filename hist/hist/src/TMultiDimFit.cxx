@@ -394,6 +394,7 @@
 #include "TROOT.h"
 #include "TBrowser.h"
 #include "TDecompChol.h"
+#include "ROOT/THistParallel.hxx"
 
 #define RADDEG (180. / TMath::Pi())
 #define DEGRAD (TMath::Pi() / 180.)
@@ -673,6 +674,69 @@ void TMultiDimFit::AddRow(const Double_t *x, Double_t D, Double_t E)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add nRows rows to the training sample, as nRows calls of AddRow: the
+/// independent variables of the rows are stored one after the other in x,
+/// which must be <TT>nRows * fNVariables</TT> long, the dependent quantities in
+/// D and optionally their square errors in E. The storage of the sample is
+/// grown once for all the rows.
+
+void TMultiDimFit::AddRows(Int_t nRows, const Double_t *x, const Double_t *D, const Double_t *E)
+{
+   if (!x || !D || nRows <= 0)
+      return;
+
+   Int_t needed = fSampleSize + nRows;
+   Int_t size = fQuantity.GetNrows();
+   if (needed > size) {
+      fQuantity.ResizeTo(TMath::Max(needed, size + size/2));
+      fSqError.ResizeTo(TMath::Max(needed, size + size/2));
+   }
+   needed *= fNVariables;
+   size = fVariables.GetNrows();
+   if (needed > size)
+      fVariables.ResizeTo(TMath::Max(needed, size + size/2));
+
+   for (Int_t row = 0; row < nRows; row++)
+      AddRow(x + Long64_t(row) * fNVariables, D[row], E ? E[row] : 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the training and test samples of the TMultiDimFit objects in list,
+/// for instance the ones filled by different threads, to the ones of this
+/// object, as if their rows were added with AddRow and AddTestRow. It must
+/// be called before FindParameterization().
+/// Returns the size of the training sample, or -1 in case of error.
+
+Long64_t TMultiDimFit::Merge(TCollection *list)
+{
+   if (!list)
+      return fSampleSize;
+
+   TIter next(list);
+   TObject *obj;
+   while ((obj = next())) {
+      TMultiDimFit *mdf = dynamic_cast<TMultiDimFit *>(obj);
+      if (!mdf) {
+         Error("Merge", "Attempt to merge object of class %s to a TMultiDimFit", obj->ClassName());
+         return -1;
+      }
+      if (mdf == this)
+         continue;
+      if (mdf->fNVariables != fNVariables) {
+         Error("Merge", "Cannot merge a TMultiDimFit of %d variables into one of %d variables",
+               mdf->fNVariables, fNVariables);
+         return -1;
+      }
+      AddRows(mdf->fSampleSize, mdf->fVariables.GetMatrixArray(), mdf->fQuantity.GetMatrixArray(),
+              mdf->fSqError.GetMatrixArray());
+      for (Int_t row = 0; row < mdf->fTestSampleSize; row++)
+         AddTestRow(mdf->fTestVariables.GetMatrixArray() + row * fNVariables, mdf->fTestQuantity(row),
+                    mdf->fTestSqError(row));
+   }
+   return fSampleSize;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add a row consisting of fNVariables independent variables, the
 /// known, dependent quantity, and optionally, the square error in
@@ -1387,12 +1451,13 @@ void TMultiDimFit::MakeCoefficients()
 
    // Compute the final residuals
    fResiduals.ResizeTo(fSampleSize);
-   for (i = 0; i < fSampleSize; i++)
-      fResiduals(i) = fQuantity(i);
-
-   for (i = 0; i < fNCoefficients; i++)
-      for (j = 0; j < fSampleSize; j++)
-         fResiduals(j) -= fCoefficients(i) * fFunctions(i,j);
+   ROOT::Internal::HistForEachRange(fSampleSize, fNCoefficients, [&](Int_t first, Int_t last) {
+      for (Int_t jj = first; jj < last; jj++) {
+         fResiduals(jj) = fQuantity(jj);
+         for (Int_t ii = 0; ii < fNCoefficients; ii++)
+            fResiduals(jj) -= fCoefficients(ii) * fFunctions(ii,jj);
+      }
+   });
 
    // Compute the max and minimum, and squared sum of the evaluated
    // residuals
@@ -1509,16 +1574,20 @@ Double_t TMultiDimFit::MakeGramSchmidt(Int_t function)
    Int_t j        = 0;
    Int_t k        = 0;
 
-   for (j = 0; j < fSampleSize; j++) {
-      fFunctions(fNCoefficients, j) = 1;
-      fOrthFunctions(fNCoefficients, j) = 0;
-      // First, however, we need to calculate f_fNCoefficients
-      for (k = 0; k < fNVariables; k++) {
-         Int_t    p   =  fPowers[function * fNVariables + k];
-         Double_t x   =  fVariables(j * fNVariables + k);
-         fFunctions(fNCoefficients, j) *= EvalFactor(p,x);
+   // First, however, we need to calculate f_fNCoefficients, the data points
+   // being split between the threads of the implicit multi-threading pool
+   ROOT::Internal::HistForEachRange(fSampleSize, fNVariables, [&](Int_t first, Int_t last) {
+      for (Int_t jj = first; jj < last; jj++) {
+         fFunctions(fNCoefficients, jj) = 1;
+         for (Int_t kk = 0; kk < fNVariables; kk++) {
+            Int_t    p   =  fPowers[function * fNVariables + kk];
+            Double_t x   =  fVariables(jj * fNVariables + kk);
+            fFunctions(fNCoefficients, jj) *= EvalFactor(p,x);
+         }
       }
+   });
 
+   for (j = 0; j < fSampleSize; j++) {
       // Calculate f dot f in f2
       f2 += fFunctions(fNCoefficients,j) *  fFunctions(fNCoefficients,j);
       // Assign to w_fNCoefficients f_fNCoefficients
@@ -220,9 +220,65 @@ Christian Holm August 2000, CERN
 #include "TROOT.h"
 #include "Riostream.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "ROOT/THistParallel.hxx"
 
 ClassImp(TPrincipal);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of data points, mean values and sums of the products of the
+/// deviations from the mean values of a block of rows. The sums are in the
+/// lower triangle of a nVariables x nVariables row-major array.
+
+struct TPrincipalMoments {
+   Int_t                 fN = 0;
+   std::vector<Double_t> fMean;
+   std::vector<Double_t> fM2;
+
+   void Fill(Int_t nVariables, Int_t nRows, const Double_t *x)
+   {
+      Int_t i, j, row;
+      fN = nRows;
+      fMean.assign(nVariables, 0.);
+      fM2.assign(nVariables * nVariables, 0.);
+      for (row = 0; row < nRows; row++)
+         for (i = 0; i < nVariables; i++)
+            fMean[i] += x[Long64_t(row) * nVariables + i];
+      for (i = 0; i < nVariables; i++)
+         fMean[i] /= nRows;
+
+      std::vector<Double_t> d(nVariables);
+      for (row = 0; row < nRows; row++) {
+         for (i = 0; i < nVariables; i++)
+            d[i] = x[Long64_t(row) * nVariables + i] - fMean[i];
+         for (i = 0; i < nVariables; i++) {
+            Double_t *m2 = &fM2[i * nVariables];
+            for (j = 0; j <= i; j++)
+               m2[j] += d[i] * d[j];
+         }
+      }
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store nRows rows of data after the first ones of data, growing it by at
+/// least half its size if needed.
+
+void AppendRows(TVectorD &data, Int_t first, Int_t nRows, Int_t nVariables, const Double_t *x)
+{
+   const Int_t size = data.GetNrows();
+   const Int_t needed = (first + nRows) * nVariables;
+   if (needed > size)
+      data.ResizeTo(TMath::Max(needed, size + size/2));
+   std::copy(x, x + nRows * nVariables, data.GetMatrixArray() + first * nVariables);
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Empty constructor. Do not use.
 
@@ -451,6 +507,122 @@ void TPrincipal::AddRow(const Double_t *p)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add nRows data points stored one after the other in x, which must be
+/// <TT>nRows * fNumberOfVariables</TT> long, and update the covariance matrix.
+///
+/// The mean values and the sums of the products of the deviations from them
+/// are computed in two passes over blocks of rows, in parallel if the
+/// implicit multi-threading is enabled, and merged in the order of the rows
+/// with the update formulae of T.F. Chan, G.H. Golub and R.J. LeVeque
+/// (Stanford CS report 79-773). The size of the blocks only depends on nRows,
+/// so that the result does not depend on the number of threads; it can differ
+/// from the one of AddRow in the last bits.
+
+void TPrincipal::AddRows(Int_t nRows, const Double_t *x)
+{
+   if (!x || nRows <= 0)
+      return;
+
+   const Int_t kMinBlockSize = 4096;
+   const Int_t kMaxBlocks    = 64;
+   const Int_t blockSize = TMath::Max(kMinBlockSize, (nRows + kMaxBlocks - 1) / kMaxBlocks);
+   const Int_t nBlocks   = (nRows + blockSize - 1) / blockSize;
+   std::vector<TPrincipalMoments> moments(nBlocks);
+   auto fillBlock = [&](Int_t block) {
+      const Int_t first = block * blockSize;
+      moments[block].Fill(fNumberOfVariables, TMath::Min(blockSize, nRows - first),
+                          x + Long64_t(first) * fNumberOfVariables);
+   };
+   ROOT::Internal::HistForEachChunk(nBlocks, Long64_t(blockSize) * fNumberOfVariables * fNumberOfVariables,
+                                    fillBlock);
+
+   const Int_t first = fNumberOfDataPoints;
+   for (auto &m : moments)
+      AddMoments(m.fN, m.fMean.data(), m.fM2.data());
+
+   if (fStoreData)
+      AppendRows(fUserData, first, nRows, fNumberOfVariables, x);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add n data points of mean values mean, and of sums of the products of the
+/// deviations from them m2 (lower triangle of a row-major array), to the mean
+/// values and the covariance matrix.
+
+void TPrincipal::AddMoments(Int_t n, const Double_t *mean, const Double_t *m2)
+{
+   if (n <= 0)
+      return;
+
+   Int_t i,j;
+   const Double_t n0 = fNumberOfDataPoints;
+   const Double_t nTot = n0 + n;
+   std::vector<Double_t> delta(fNumberOfVariables);
+   for (i = 0; i < fNumberOfVariables; i++)
+      delta[i] = mean[i] - fMeanValues(i);
+
+   // The covariance matrix is the sum of the products of the deviations
+   // divided by the number of data points
+   for (i = 0; i < fNumberOfVariables; i++) {
+      for (j = 0; j < i + 1; j++) {
+         fCovarianceMatrix(i,j) = (fCovarianceMatrix(i,j) * n0 + m2[i * fNumberOfVariables + j]
+                                   + delta[i] * delta[j] * n0 * n / nTot) / nTot;
+      }
+   }
+   for (i = 0; i < fNumberOfVariables; i++)
+      fMeanValues(i) = (n0 == 0) ? mean[i] : fMeanValues(i) + delta[i] * n / nTot;
+
+   fNumberOfDataPoints += n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the data points of the TPrincipal objects in list, for instance the
+/// ones filled by different threads, to this one. It must be called before
+/// MakePrincipals(). The data points are stored if this object stores them;
+/// the objects of the list must then store them as well.
+/// Returns the total number of data points, or -1 in case of error.
+
+Long64_t TPrincipal::Merge(TCollection *list)
+{
+   if (!list)
+      return fNumberOfDataPoints;
+
+   TIter next(list);
+   TObject *obj;
+   while ((obj = next())) {
+      TPrincipal *pr = dynamic_cast<TPrincipal *>(obj);
+      if (!pr) {
+         Error("Merge", "Attempt to merge object of class %s to a TPrincipal", obj->ClassName());
+         return -1;
+      }
+      if (pr == this || pr->fNumberOfDataPoints == 0)
+         continue;
+      if (pr->fNumberOfVariables != fNumberOfVariables) {
+         Error("Merge", "Cannot merge a TPrincipal of %d variables into one of %d variables",
+               pr->fNumberOfVariables, fNumberOfVariables);
+         return -1;
+      }
+      if (fStoreData && !pr->fStoreData) {
+         Error("Merge", "Cannot merge a TPrincipal not storing its data into one storing them");
+         return -1;
+      }
+
+      Int_t i,j;
+      std::vector<Double_t> m2(fNumberOfVariables * fNumberOfVariables);
+      for (i = 0; i < fNumberOfVariables; i++)
+         for (j = 0; j < i + 1; j++)
+            m2[i * fNumberOfVariables + j] = pr->fCovarianceMatrix(i,j) * pr->fNumberOfDataPoints;
+
+      const Int_t first = fNumberOfDataPoints;
+      AddMoments(pr->fNumberOfDataPoints, pr->fMeanValues.GetMatrixArray(), m2.data());
+      if (fStoreData)
+         AppendRows(fUserData, first, pr->fNumberOfDataPoints, fNumberOfVariables,
+                    pr->fUserData.GetMatrixArray());
+   }
+   return fNumberOfDataPoints;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Browse the TPrincipal object in the TBrowser.
 
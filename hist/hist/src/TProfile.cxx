@@ -20,6 +20,7 @@
 #include "TClass.h"
 
 #include "TProfileHelper.h"
+#include "TFixedBinFinder.h"
 
 Bool_t TProfile::fgApproximate = kFALSE;
 
@@ -770,6 +771,52 @@ void TProfile::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const D
          return;
    }
 
+   if (TFixedBinFinder::CanUse(fXaxis)) {
+      // The bins of a chunk are computed at once; the statistics are summed
+      // in the same order as below, in local variables.
+      const TFixedBinFinder finder(fXaxis);
+      const Int_t nx = fXaxis.GetNbins();
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      const Bool_t cutY = (fYmin != fYmax);
+      Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+      Double_t tsumwy = fTsumwy, tsumwy2 = fTsumwy2;
+      Int_t bins[TFixedBinFinder::kChunkSize];
+      const Int_t nentries = (ntimes - ifirst + stride - 1) / stride;
+      for (Int_t first = 0; first < nentries; first += TFixedBinFinder::kChunkSize) {
+         const Int_t n = TMath::Min(nentries - first, (Int_t)TFixedBinFinder::kChunkSize);
+         const Int_t offset = ifirst + first * stride;
+         const Double_t *xc = x + offset;
+         const Double_t *yc = y + offset;
+         const Double_t *wc = w ? w + offset : nullptr;
+         finder.FindBins(n, xc, stride, bins);
+         for (Int_t j = 0; j < n; ++j) {
+            const Double_t yy = yc[j * stride];
+            if (cutY) {
+               if (yy <fYmin || yy> fYmax || TMath::IsNaN(yy)) continue;
+            }
+            const Double_t u = wc ? wc[j * stride] : 1;
+            fEntries++;
+            bin = bins[j];
+            AddBinContent(bin, u*yy);
+            fSumw2.fArray[bin] += u*yy*yy;
+            if (!fBinSumw2.fN && u != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();  // must be called before accumulating the entries
+            if (fBinSumw2.fN)  fBinSumw2.fArray[bin] += u*u;
+            fBinEntries.fArray[bin] += u;
+            if (!statOverflows && (bin == 0 || bin > nx)) continue;
+            const Double_t xx = xc[j * stride];
+            tsumw   += u;
+            tsumw2  += u*u;
+            tsumwx  += u*xx;
+            tsumwx2 += u*xx*xx;
+            tsumwy  += u*yy;
+            tsumwy2 += u*yy*yy;
+         }
+      }
+      fTsumw = tsumw; fTsumw2 = tsumw2; fTsumwx = tsumwx; fTsumwx2 = tsumwx2;
+      fTsumwy = tsumwy; fTsumwy2 = tsumwy2;
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       if (fYmin != fYmax) {
          if (y[i] <fYmin || y[i]> fYmax || TMath::IsNaN(y[i])) continue;
@@ -11,6 +11,7 @@
 
 #include "TProfile2Poly.h"
 #include "TProfileHelper.h"
+#include "TH2PolyBinIndex.h"
 
 #include "TMultiGraph.h"
 #include "TGraph.h"
@@ -188,16 +189,6 @@ Int_t TProfile2Poly::Fill(Double_t xcoord, Double_t ycoord, Double_t value, Doub
       fOverflowBins[overflow_idx].SetContent(fOverflowBins[overflow_idx].fAverage );
    }
 
-   // Find the cell to which (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((xcoord - fXaxis.GetXmin()) / fStepX));
-   Int_t m = (Int_t)(floor((ycoord - fYaxis.GetXmin()) / fStepY));
-
-   // Make sure the array indices are correct.
-   if (n >= fCellX) n = fCellX - 1;
-   if (m >= fCellY) m = fCellY - 1;
-   if (n < 0) n = 0;
-   if (m < 0) m = 0;
-
    // ------------ Update global (per histo) statistics
    fTsumw += weight;
    fTsumw2 += weight * weight;
@@ -210,18 +201,13 @@ Int_t TProfile2Poly::Fill(Double_t xcoord, Double_t ycoord, Double_t value, Doub
    fTsumwz2 += weight * value * value;
 
    // ------------ Update local (per bin) statistics
-   TProfile2PolyBin *bin;
-   TIter next(&fCells[n + fCellX * m]);
-   TObject *obj;
-   while ((obj = next())) {
-      bin = (TProfile2PolyBin *)obj;
-      if (bin->IsInside(xcoord, ycoord)) {
-         fEntries++;
-         bin->Fill(value, weight);
-         bin->Update();
-         bin->SetContent(bin->fAverage);
-      }
-   }
+   GetBinIndex()->ForEach(xcoord, ycoord, [this, value, weight](TH2PolyBin *polyBin) {
+      TProfile2PolyBin *bin = (TProfile2PolyBin *)polyBin;
+      fEntries++;
+      bin->Fill(value, weight);
+      bin->Update();
+      bin->SetContent(bin->fAverage);
+   });
 
    return tmp;
 }
@@ -372,6 +372,22 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
             totstats[i] += stats[i];
          nentries += h->GetEntries();
 
+         if (allSameLimits) {
+            // same binning: add the arrays in (vectorizable) loops of their own
+            const Int_t n = h->fN;
+            Double_t *pw = p->fArray, *pw2 = p->fSumw2.fArray, *pb = p->fBinEntries.fArray;
+            const Double_t *hw = h->GetW(), *hw2 = h->GetW2(), *hb = h->GetB();
+            for (Int_t hbin = 0; hbin < n; ++hbin) pw[hbin] += hw[hbin];
+            for (Int_t hbin = 0; hbin < n; ++hbin) pw2[hbin] += hw2[hbin];
+            for (Int_t hbin = 0; hbin < n; ++hbin) pb[hbin] += hb[hbin];
+            if (p->fBinSumw2.fN) {
+               Double_t *pb2 = p->fBinSumw2.fArray;
+               const Double_t *hb2 = h->GetB2() ? h->GetB2() : hb;
+               for (Int_t hbin = 0; hbin < n; ++hbin) pb2[hbin] += hb2[hbin];
+            }
+            continue;
+         }
+
          for ( Int_t hbin = 0; hbin < h->fN; ++hbin ) {
             Int_t pbin = hbin;
             if (!allSameLimits) {
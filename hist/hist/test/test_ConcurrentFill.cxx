@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+
+#include "TH1D.h"
+#include "TH2F.h"
+#include "TH3D.h"
+#include "TProfile.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const Int_t kNThreads = 8;
+const Int_t kNPerThread = 20000;
+
+// Coordinate of entry i of thread t, under- and overflows included.
+Double_t Value(Int_t t, Int_t i)
+{
+   return -1.1 + 2.2 * ((i * 7919 + t * 104729) % 10007) / 10007.;
+}
+
+// Weight 2 for some entries of one of the threads, to trigger the sum of squares of weights meanwhile.
+Double_t Weight(Int_t t, Int_t i)
+{
+   return (t == 3 && i % 5 == 0) ? 2. : 1.;
+}
+
+template <typename FILL>
+void FillConcurrently(FILL fill)
+{
+   std::vector<std::thread> threads;
+   for (Int_t t = 0; t < kNThreads; ++t)
+      threads.emplace_back([t, &fill]() {
+         for (Int_t i = 0; i < kNPerThread; ++i)
+            fill(t, i);
+      });
+   for (auto &thread : threads)
+      thread.join();
+}
+
+void ExpectSameHistograms(const TH1 &h, const TH1 &ref)
+{
+   ASSERT_EQ(h.GetNcells(), ref.GetNcells());
+   for (Int_t bin = 0; bin < ref.GetNcells(); ++bin) {
+      EXPECT_EQ(h.GetBinContent(bin), ref.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(h.GetBinError(bin), ref.GetBinError(bin)) << "bin " << bin;
+   }
+   EXPECT_EQ(h.GetEntries(), ref.GetEntries());
+   Double_t stats[11] = {0}, refStats[11] = {0};
+   h.GetStats(stats);
+   ref.GetStats(refStats);
+   for (Int_t i = 0; i < 11; ++i)
+      EXPECT_NEAR(stats[i], refStats[i], 1e-9 * (1 + std::abs(refStats[i]))) << "stat " << i;
+}
+
+} // anonymous namespace
+
+TEST(ConcurrentFill, TH1D)
+{
+   TH1D h("h", "h", 100, -1, 1);
+   TH1D ref("ref", "ref", 100, -1, 1);
+   h.SetConcurrentFill(TH1::kAtomic);
+   EXPECT_EQ(h.GetConcurrentFill(), TH1::kAtomic);
+   FillConcurrently([&h](Int_t t, Int_t i) { h.Fill(Value(t, i), Weight(t, i)); });
+   h.SetConcurrentFill(TH1::kNoConcurrency);
+   EXPECT_EQ(h.GetConcurrentFill(), TH1::kNoConcurrency);
+
+   for (Int_t t = 0; t < kNThreads; ++t)
+      for (Int_t i = 0; i < kNPerThread; ++i)
+         ref.Fill(Value(t, i), Weight(t, i));
+   ExpectSameHistograms(h, ref);
+}
+
+TEST(ConcurrentFill, FillN)
+{
+   TH1D h("h", "h", 100, -1, 1);
+   TH1D ref("ref", "ref", 100, -1, 1);
+   h.SetConcurrentFill(TH1::kAtomic);
+   std::vector<std::thread> threads;
+   for (Int_t t = 0; t < kNThreads; ++t)
+      threads.emplace_back([t, &h]() {
+         std::vector<Double_t> x;
+         for (Int_t i = 0; i < kNPerThread; ++i)
+            x.push_back(Value(t, i));
+         h.FillN(kNPerThread, x.data(), nullptr);
+      });
+   for (auto &thread : threads)
+      thread.join();
+   h.SetConcurrentFill(TH1::kNoConcurrency);
+
+   for (Int_t t = 0; t < kNThreads; ++t)
+      for (Int_t i = 0; i < kNPerThread; ++i)
+         ref.Fill(Value(t, i));
+   ExpectSameHistograms(h, ref);
+}
+
+TEST(ConcurrentFill, TH2F)
+{
+   TH2F h("h", "h", 20, -1, 1, 30, -1, 1);
+   TH2F ref("ref", "ref", 20, -1, 1, 30, -1, 1);
+   h.SetConcurrentFill(TH1::kAtomic);
+   FillConcurrently([&h](Int_t t, Int_t i) { h.Fill(Value(t, i), Value(t, 3 * i), Weight(t, i)); });
+   h.SetConcurrentFill(TH1::kNoConcurrency);
+
+   for (Int_t t = 0; t < kNThreads; ++t)
+      for (Int_t i = 0; i < kNPerThread; ++i)
+         ref.Fill(Value(t, i), Value(t, 3 * i), Weight(t, i));
+   ExpectSameHistograms(h, ref);
+}
+
+TEST(ConcurrentFill, TH3D)
+{
+   TH3D h("h", "h", 10, -1, 1, 12, -1, 1, 14, -1, 1);
+   TH3D ref("ref", "ref", 10, -1, 1, 12, -1, 1, 14, -1, 1);
+   h.SetConcurrentFill(TH1::kAtomic);
+   FillConcurrently([&h](Int_t t, Int_t i) { h.Fill(Value(t, i), Value(t, 3 * i), Value(t, 5 * i)); });
+   h.SetConcurrentFill(TH1::kNoConcurrency);
+
+   for (Int_t t = 0; t < kNThreads; ++t)
+      for (Int_t i = 0; i < kNPerThread; ++i)
+         ref.Fill(Value(t, i), Value(t, 3 * i), Value(t, 5 * i));
+   ExpectSameHistograms(h, ref);
+}
+
+TEST(ConcurrentFill, Unsupported)
+{
+   TH1D extendable("extendable", "extendable", 10, 0, 1);
+   extendable.SetCanExtend(TH1::kAllAxes);
+   extendable.SetConcurrentFill(TH1::kAtomic);
+   EXPECT_EQ(extendable.GetConcurrentFill(), TH1::kNoConcurrency);
+
+   TProfile profile("profile", "profile", 10, 0, 1);
+   profile.SetConcurrentFill(TH1::kAtomic);
+   EXPECT_EQ(profile.GetConcurrentFill(), TH1::kNoConcurrency);
+}
@@ -0,0 +1,156 @@
+#include "gtest/gtest.h"
+
+#include "TH1D.h"
+#include "TH1F.h"
+#include "TH2F.h"
+#include "TH3D.h"
+#include "TProfile.h"
+#include "TRandom3.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Values inside and outside [-1,1), on the bin edges and NaN.
+std::vector<Double_t> MakeValues(Int_t n, UInt_t seed)
+{
+   TRandom3 rnd(seed);
+   std::vector<Double_t> values;
+   for (Int_t i = 0; i < n; ++i)
+      values.push_back(rnd.Uniform(-1.2, 1.2));
+   values[0] = -1;
+   values[1] = 1;
+   values[2] = 0.5;
+   values[3] = std::numeric_limits<Double_t>::quiet_NaN();
+   return values;
+}
+
+std::vector<Double_t> MakeWeights(Int_t n)
+{
+   std::vector<Double_t> weights(n, 1.);
+   // The sum of weights squares is triggered in the middle of the array.
+   for (Int_t i = n / 2; i < n; ++i)
+      weights[i] = 0.5 + (i % 3);
+   return weights;
+}
+
+void ExpectSameHistograms(const TH1 &expected, const TH1 &actual)
+{
+   ASSERT_EQ(expected.GetNcells(), actual.GetNcells());
+   for (Int_t bin = 0; bin < expected.GetNcells(); ++bin) {
+      EXPECT_EQ(expected.GetBinContent(bin), actual.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_EQ(expected.GetBinError(bin), actual.GetBinError(bin)) << "bin " << bin;
+   }
+   EXPECT_EQ(expected.GetEntries(), actual.GetEntries());
+   Double_t expectedStats[13] = {0}, actualStats[13] = {0};
+   expected.GetStats(expectedStats);
+   actual.GetStats(actualStats);
+   for (Int_t i = 0; i < 13; ++i)
+      EXPECT_EQ(expectedStats[i], actualStats[i]) << "stat " << i;
+}
+
+} // anonymous namespace
+
+TEST(FillN, TH1)
+{
+   const Int_t n = 1000;
+   auto x = MakeValues(n, 1);
+   auto w = MakeWeights(n);
+
+   for (Bool_t statOverflows : {kFALSE, kTRUE}) {
+      TH1D ref("ref", "", 40, -1, 1);
+      TH1F ref1("ref1", "", 40, -1, 1);
+      TH1D h("h", "", 40, -1, 1);
+      TH1F h1("h1", "", 40, -1, 1);
+      for (TH1 *hist : {(TH1 *)&ref, (TH1 *)&ref1, (TH1 *)&h, (TH1 *)&h1}) {
+         hist->SetDirectory(nullptr);
+         hist->SetStatOverflows(statOverflows ? TH1::kConsider : TH1::kIgnore);
+      }
+      for (Int_t i = 0; i < n; ++i) {
+         ref.Fill(x[i], w[i]);
+         if (i % 2 == 0)
+            ref1.Fill(x[i]);
+      }
+      h.FillN(n, x.data(), w.data());
+      h1.FillN(n / 2, x.data(), nullptr, 2);
+      ExpectSameHistograms(ref, h);
+      ExpectSameHistograms(ref1, h1);
+   }
+}
+
+TEST(FillN, VariableBinsAndExtension)
+{
+   const Int_t n = 500;
+   auto x = MakeValues(n, 2);
+   const Double_t edges[] = {-1, -0.5, 0, 0.1, 1};
+   TH1D ref("ref", "", 4, edges);
+   TH1D h("h", "", 4, edges);
+   ref.SetDirectory(nullptr);
+   h.SetDirectory(nullptr);
+   for (Int_t i = 0; i < n; ++i)
+      ref.Fill(x[i]);
+   h.FillN(n, x.data(), nullptr);
+   ExpectSameHistograms(ref, h);
+
+   // Extending the axis goes through TAxis::FindBin.
+   x[3] = 0;
+   TH1D ext("ext", "", 10, 0, 0.1);
+   ext.SetDirectory(nullptr);
+   ext.SetCanExtend(TH1::kAllAxes);
+   ext.FillN(n, x.data(), nullptr);
+   EXPECT_EQ(n, ext.GetEntries());
+   EXPECT_LE(ext.GetXaxis()->GetXmin(), -1.);
+}
+
+TEST(FillN, TH2)
+{
+   const Int_t n = 1000;
+   auto x = MakeValues(n, 3);
+   auto y = MakeValues(n, 4);
+   auto w = MakeWeights(n);
+   TH2F ref("ref", "", 20, -1, 1, 10, -1, 1);
+   TH2F h("h", "", 20, -1, 1, 10, -1, 1);
+   ref.SetDirectory(nullptr);
+   h.SetDirectory(nullptr);
+   for (Int_t i = 0; i < n; ++i)
+      ref.Fill(x[i], y[i], w[i]);
+   h.FillN(n, x.data(), y.data(), w.data());
+   ExpectSameHistograms(ref, h);
+}
+
+TEST(FillN, TH3)
+{
+   const Int_t n = 1000;
+   auto x = MakeValues(n, 5);
+   auto y = MakeValues(n, 6);
+   auto z = MakeValues(n, 7);
+   auto w = MakeWeights(n);
+   TH3D ref("ref", "", 10, -1, 1, 8, -1, 1, 6, -1, 1);
+   TH3D h("h", "", 10, -1, 1, 8, -1, 1, 6, -1, 1);
+   ref.SetDirectory(nullptr);
+   h.SetDirectory(nullptr);
+   for (Int_t i = 0; i < n; ++i)
+      ref.Fill(x[i], y[i], z[i], w[i]);
+   h.FillN(n, x.data(), y.data(), z.data(), w.data());
+   ExpectSameHistograms(ref, h);
+}
+
+TEST(FillN, TProfile)
+{
+   const Int_t n = 1000;
+   auto x = MakeValues(n, 8);
+   auto y = MakeValues(n, 9);
+   auto w = MakeWeights(n);
+   TProfile ref("ref", "", 20, -1, 1, -1, 1);
+   TProfile h("h", "", 20, -1, 1, -1, 1);
+   ref.SetDirectory(nullptr);
+   h.SetDirectory(nullptr);
+   for (Int_t i = 0; i < n; ++i)
+      ref.Fill(x[i], y[i], w[i]);
+   h.FillN(n, x.data(), y.data(), w.data());
+   ExpectSameHistograms(ref, h);
+   for (Int_t bin = 0; bin < ref.GetNcells(); ++bin)
+      EXPECT_EQ(ref.GetBinEntries(bin), h.GetBinEntries(bin));
+}
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include "TF1.h"
+#include "TH1D.h"
+#include "TRandom3.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// The batch sampling gives the numbers of the calls one at a time.
+TEST(GetRandom, TF1Batch)
+{
+   TF1 f("f", "exp(-x)*x*x + 0.1", 0., 10.);
+   const Int_t n = 10000;
+   std::vector<Double_t> batch(n);
+   TRandom3 rnd(17);
+   f.GetRandom(n, batch.data(), &rnd);
+
+   TRandom3 ref(17);
+   TRandom *saved = gRandom;
+   gRandom = &ref;
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_EQ(f.GetRandom(), batch[i]);
+   gRandom = saved;
+}
+
+TEST(GetRandom, TF1LogBinning)
+{
+   TF1 f("flog", "1/x", 1., 1.e6);
+   const Int_t n = 1000;
+   std::vector<Double_t> batch(n);
+   TRandom3 rnd(3), ref(3);
+   f.GetRandom(n, batch.data(), &rnd);
+   TRandom *saved = gRandom;
+   gRandom = &ref;
+   for (Int_t i = 0; i < n; ++i) {
+      EXPECT_EQ(f.GetRandom(), batch[i]);
+      EXPECT_GE(batch[i], 1.);
+      EXPECT_LE(batch[i], 1.e6);
+   }
+   gRandom = saved;
+}
+
+TEST(GetRandom, TH1Batch)
+{
+   TH1D h("h", "h", 200, -5., 5.);
+   TRandom3 fill(1);
+   for (Int_t i = 0; i < 100000; ++i)
+      h.Fill(fill.Gaus());
+   // Empty bins make ties in the integral.
+   h.SetBinContent(100, 0.);
+   h.SetBinContent(101, 0.);
+
+   const Int_t n = 10000;
+   std::vector<Double_t> batch(n);
+   TRandom3 rnd(5), ref(5);
+   h.GetRandom(n, batch.data(), &rnd);
+   TRandom *saved = gRandom;
+   gRandom = &ref;
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_EQ(h.GetRandom(), batch[i]);
+   gRandom = saved;
+}
+
+TEST(GetRandom, TH1Negative)
+{
+   TH1D h("hneg", "hneg", 10, 0., 1.);
+   h.SetBinContent(3, 1.);
+   h.SetBinContent(4, -1.);
+   Double_t x[4];
+   h.GetRandom(4, x);
+   for (auto xi : x)
+      EXPECT_TRUE(std::isnan(xi));
+}
+
+// Several threads sample the same function, each with its own generator.
+TEST(GetRandom, Threads)
+{
+   TF1 f("fthreads", "gaus", -5., 5.);
+   f.SetParameters(1., 0., 1.);
+   const Int_t nThreads = 4, n = 20000;
+   std::vector<std::vector<Double_t>> results(nThreads, std::vector<Double_t>(n));
+   std::vector<std::thread> threads;
+   for (Int_t t = 0; t < nThreads; ++t)
+      threads.emplace_back([&f, &results, t]() {
+         TRandom3 rnd(100 + t);
+         f.GetRandom(n, results[t].data(), &rnd);
+      });
+   for (auto &thread : threads)
+      thread.join();
+
+   for (Int_t t = 0; t < nThreads; ++t) {
+      std::vector<Double_t> expected(n);
+      TRandom3 rnd(100 + t);
+      f.GetRandom(n, expected.data(), &rnd);
+      EXPECT_EQ(expected, results[t]);
+   }
+}
@@ -0,0 +1,153 @@
+#include "gtest/gtest.h"
+
+#include "TH1F.h"
+#include "TH1I.h"
+#include "TH2D.h"
+#include "THn.h"
+#include "TList.h"
+#include "TProfile.h"
+#include "TRandom3.h"
+
+#include <memory>
+#include <vector>
+
+// Merging histograms of the same binning must give the histogram filled with
+// all their entries.
+TEST(Merge, SameBinningTH2)
+{
+   const Int_t nHists = 8, nEntries = 2000;
+   TH2D all("all", "all", 60, -3., 3., 70, -3., 3.);
+   TH2D merged("merged", "merged", 60, -3., 3., 70, -3., 3.);
+   all.Sumw2();
+   merged.Sumw2();
+   std::vector<std::unique_ptr<TH2D>> hists;
+   TList list;
+   TRandom3 rnd(7);
+   for (Int_t ih = 0; ih < nHists; ++ih) {
+      hists.emplace_back(new TH2D(TString::Format("h%d", ih), "", 60, -3., 3., 70, -3., 3.));
+      // Half of the histograms without sum of squares of weights.
+      if (ih % 2)
+         hists.back()->Sumw2(kFALSE);
+      for (Int_t i = 0; i < nEntries; ++i) {
+         const Double_t x = rnd.Gaus(), y = rnd.Gaus();
+         const Double_t w = (ih % 2) ? 1. : rnd.Uniform(0.5, 2.);
+         hists.back()->Fill(x, y, w);
+         all.Fill(x, y, w);
+      }
+      list.Add(hists.back().get());
+   }
+   merged.Merge(&list);
+
+   EXPECT_DOUBLE_EQ(all.GetEntries(), merged.GetEntries());
+   for (Int_t bin = 0; bin < all.GetNcells(); ++bin) {
+      EXPECT_NEAR(all.GetBinContent(bin), merged.GetBinContent(bin), 1e-9);
+      EXPECT_NEAR(all.GetBinError(bin), merged.GetBinError(bin), 1e-9);
+   }
+}
+
+TEST(Merge, SameBinningTH1F)
+{
+   TH1F all("all", "all", 100, 0., 1.);
+   TH1F merged("merged", "merged", 100, 0., 1.);
+   std::vector<std::unique_ptr<TH1F>> hists;
+   TList list;
+   TRandom3 rnd(3);
+   for (Int_t ih = 0; ih < 20; ++ih) {
+      hists.emplace_back(new TH1F(TString::Format("h%d", ih), "", 100, 0., 1.));
+      for (Int_t i = 0; i < 500; ++i) {
+         const Double_t x = rnd.Uniform(-0.1, 1.1);
+         hists.back()->Fill(x);
+         all.Fill(x);
+      }
+      list.Add(hists.back().get());
+   }
+   merged.Merge(&list);
+
+   EXPECT_DOUBLE_EQ(all.GetEntries(), merged.GetEntries());
+   EXPECT_NEAR(all.GetMean(), merged.GetMean(), 1e-12);
+   for (Int_t bin = 0; bin < all.GetNcells(); ++bin)
+      EXPECT_FLOAT_EQ(all.GetBinContent(bin), merged.GetBinContent(bin));
+}
+
+// The integer histograms saturate as in AddBinContent.
+TEST(Merge, SaturationTH1I)
+{
+   TH1I merged("merged", "merged", 2, 0., 2.);
+   TH1I h1("h1", "h1", 2, 0., 2.);
+   TH1I h2("h2", "h2", 2, 0., 2.);
+   merged.SetBinContent(1, 2000000000);
+   h1.SetBinContent(1, 2000000000);
+   h1.SetBinContent(2, -2000000000);
+   h2.SetBinContent(2, -2000000000);
+   TList list;
+   list.Add(&h1);
+   list.Add(&h2);
+   merged.Merge(&list);
+   EXPECT_EQ(2147483647, merged.GetBinContent(1));
+   EXPECT_EQ(-2147483647, merged.GetBinContent(2));
+}
+
+TEST(Merge, SameBinningTProfile)
+{
+   TProfile all("all", "all", 50, 0., 10.);
+   TProfile merged("merged", "merged", 50, 0., 10.);
+   all.Sumw2();
+   merged.Sumw2();
+   std::vector<std::unique_ptr<TProfile>> hists;
+   TList list;
+   TRandom3 rnd(11);
+   for (Int_t ih = 0; ih < 6; ++ih) {
+      hists.emplace_back(new TProfile(TString::Format("p%d", ih), "", 50, 0., 10.));
+      hists.back()->Sumw2();
+      for (Int_t i = 0; i < 1000; ++i) {
+         const Double_t x = rnd.Uniform(10.), y = rnd.Gaus(x, 1.), w = rnd.Uniform(0.5, 2.);
+         hists.back()->Fill(x, y, w);
+         all.Fill(x, y, w);
+      }
+      list.Add(hists.back().get());
+   }
+   merged.Merge(&list);
+
+   EXPECT_DOUBLE_EQ(all.GetEntries(), merged.GetEntries());
+   for (Int_t bin = 0; bin < all.GetNcells(); ++bin) {
+      EXPECT_NEAR(all.GetBinContent(bin), merged.GetBinContent(bin), 1e-9);
+      EXPECT_NEAR(all.GetBinError(bin), merged.GetBinError(bin), 1e-9);
+      EXPECT_NEAR(all.GetBinEntries(bin), merged.GetBinEntries(bin), 1e-9);
+   }
+}
+
+TEST(Merge, SameBinningTHn)
+{
+   Int_t bins[3] = {10, 12, 8};
+   Double_t xmin[3] = {0., 0., 0.};
+   Double_t xmax[3] = {1., 1., 1.};
+   THnD all("all", "all", 3, bins, xmin, xmax);
+   THnD merged("merged", "merged", 3, bins, xmin, xmax);
+   all.Sumw2();
+   std::vector<std::unique_ptr<THnD>> hists;
+   TList list;
+   TRandom3 rnd(5);
+   Double_t x[3];
+   for (Int_t ih = 0; ih < 4; ++ih) {
+      hists.emplace_back(new THnD(TString::Format("hn%d", ih), "", 3, bins, xmin, xmax));
+      const Bool_t weighted = ih != 3;
+      if (weighted)
+         hists.back()->Sumw2();
+      for (Int_t i = 0; i < 3000; ++i) {
+         for (Int_t d = 0; d < 3; ++d)
+            x[d] = rnd.Uniform(-0.1, 1.1);
+         const Double_t w = weighted ? rnd.Uniform(0.5, 2.) : 1.;
+         hists.back()->Fill(x, w);
+         all.Fill(x, w);
+      }
+      list.Add(hists.back().get());
+   }
+   merged.Merge(&list);
+
+   EXPECT_DOUBLE_EQ(all.GetEntries(), merged.GetEntries());
+   ASSERT_EQ(all.GetNbins(), merged.GetNbins());
+   for (Long64_t bin = 0; bin < all.GetNbins(); ++bin) {
+      EXPECT_NEAR(all.GetBinContent(bin), merged.GetBinContent(bin), 1e-9);
+      EXPECT_NEAR(all.GetBinError2(bin), merged.GetBinError2(bin), 1e-9);
+   }
+}
@@ -0,0 +1,58 @@
+#include "gtest/gtest.h"
+
+#include "TF1.h"
+#include "TF2.h"
+#include "Math/IntegratorOptions.h"
+
+#include <vector>
+
+namespace {
+// Values of f at n points, one by one with EvalPar and at once with EvalParN.
+void ExpectSameValues(TF1 &f, const std::vector<Double_t> &x, const Double_t *params = nullptr)
+{
+   const Int_t ndim = f.GetNdim();
+   const Int_t n = x.size() / ndim;
+   std::vector<Double_t> values(n);
+   f.EvalParN(n, x.data(), values.data(), params);
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_NEAR(f.EvalPar(&x[i * ndim], params), values[i], 1e-12 * (1 + std::abs(values[i])));
+}
+} // anonymous namespace
+
+TEST(TF1, EvalParN)
+{
+   for (const char *option : {"", "VEC"}) {
+      TF1 f("f", "[0]*exp(-0.5*((x-[1])/[2])^2) + [3]*x", -5, 5, option);
+      f.SetParameters(2., 0.5, 1.5, 0.1);
+      std::vector<Double_t> x(101);
+      for (Int_t i = 0; i < 101; ++i)
+         x[i] = -5 + 0.1 * i;
+      ExpectSameValues(f, x);
+      const Double_t params[4] = {1., -1., 0.5, 0.};
+      ExpectSameValues(f, x, params);
+   }
+}
+
+TEST(TF1, EvalParN2D)
+{
+   TF2 f("f2", "[0]*x*y + sin(x) - [1]*y*y", -1, 1, -1, 1);
+   f.SetParameters(1.5, 0.5);
+   std::vector<Double_t> xy;
+   for (Int_t i = 0; i < 13; ++i) {
+      xy.push_back(-1 + i / 6.);
+      xy.push_back(1 - i / 12.);
+   }
+   ExpectSameValues(f, xy);
+}
+
+TEST(TF1, VectorizedIntegral)
+{
+   ROOT::Math::IntegratorOneDimOptions::SetDefaultIntegrator("Gauss");
+   TF1 fs("fs", "x*x*exp(-x)", 0, 10);
+   TF1 fv("fv", "x*x*exp(-x)", 0, 10, "VEC");
+   // integral of x^2 exp(-x) in [0, 10]: 2 - 122 exp(-10)
+   const Double_t expected = 2 - 122 * std::exp(-10.);
+   EXPECT_NEAR(expected, fs.Integral(0, 10), 1e-9);
+   EXPECT_NEAR(expected, fv.Integral(0, 10), 1e-9);
+   EXPECT_NEAR(fs.IntegralFast(40, nullptr, nullptr, 0, 10), fv.IntegralFast(40, nullptr, nullptr, 0, 10), 1e-12);
+}
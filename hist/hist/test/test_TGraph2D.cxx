@@ -0,0 +1,65 @@
+#include "gtest/gtest.h"
+
+#include "TGraph2D.h"
+#include "TH2D.h"
+#include "TList.h"
+#include "TMath.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+namespace {
+void FillGraph(TGraph2D &g, Int_t n)
+{
+   TRandom3 rnd(12);
+   for (Int_t i = 0; i < n; ++i) {
+      const Double_t x = rnd.Uniform(-2., 2.), y = rnd.Uniform(-2., 2.);
+      g.SetPoint(i, x, y, TMath::Sin(x) * TMath::Cos(y));
+   }
+}
+} // anonymous namespace
+
+// The batch interpolation gives the values of the calls one at a time.
+TEST(TGraph2D, InterpolateBatch)
+{
+   TGraph2D g;
+   FillGraph(g, 20000);
+
+   const Int_t n = 10000;
+   std::vector<Double_t> x(n), y(n), z(n);
+   TRandom3 rnd(4);
+   for (Int_t i = 0; i < n; ++i) {
+      x[i] = rnd.Uniform(-2.5, 2.5);
+      y[i] = rnd.Uniform(-2.5, 2.5);
+   }
+   g.Interpolate(n, x.data(), y.data(), z.data());
+   for (Int_t i = 0; i < n; ++i) {
+      EXPECT_EQ(g.Interpolate(x[i], y[i]), z[i]);
+      if (TMath::Abs(x[i]) < 1.8 && TMath::Abs(y[i]) < 1.8)
+         EXPECT_NEAR(TMath::Sin(x[i]) * TMath::Cos(y[i]), z[i], 5e-3);
+   }
+}
+
+// The triangles found for Interpolate are kept when the graph is drawn,
+// and dropped when its points change.
+TEST(TGraph2D, TrianglesCache)
+{
+   TGraph2D g;
+   FillGraph(g, 500);
+   g.SetNpx(20);
+   g.SetNpy(20);
+   const Double_t z0 = g.Interpolate(0.1, 0.2);
+   TObject *delaunay = g.GetHistogram("empty")->GetListOfFunctions()->FindObject("TGraphDelaunay2D");
+   ASSERT_NE(nullptr, delaunay);
+
+   TH2D *h = g.GetHistogram();
+   EXPECT_EQ(delaunay, h->GetListOfFunctions()->FindObject("TGraphDelaunay2D"));
+   EXPECT_EQ(1, h->GetListOfFunctions()->GetSize());
+   EXPECT_EQ(z0, g.Interpolate(0.1, 0.2));
+   EXPECT_EQ(h->GetBinContent(h->FindBin(0., 0.)), g.Interpolate(h->GetXaxis()->GetBinCenter(h->GetXaxis()->FindBin(0.)),
+                                                                 h->GetYaxis()->GetBinCenter(h->GetYaxis()->FindBin(0.))));
+
+   // A point at (0.1,0.2) changes the interpolation there.
+   g.SetPoint(g.GetN(), 0.1, 0.2, 5.);
+   EXPECT_DOUBLE_EQ(5., g.Interpolate(0.1, 0.2));
+}
@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+
+#include "TH2Poly.h"
+#include "TList.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+namespace {
+// The bin with the smallest number containing (x,y), the sea (-5) if none.
+Int_t FindBinBruteForce(TH2Poly &h, Double_t x, Double_t y)
+{
+   TIter next(h.GetBins());
+   while (TH2PolyBin *bin = (TH2PolyBin *)next())
+      if (bin->IsInside(x, y))
+         return bin->GetBinNumber();
+   return -5;
+}
+} // anonymous namespace
+
+TEST(TH2Poly, FindBinHoneycomb)
+{
+   TH2Poly h("h", "h", 0., 100., 0., 100.);
+   h.Honeycomb(0., 0., 1., 50, 60);
+   ASSERT_EQ(2970, h.GetNumberOfBins());
+
+   TRandom3 rnd(7);
+   for (Int_t i = 0; i < 20000; ++i) {
+      const Double_t x = rnd.Uniform(0., 100.), y = rnd.Uniform(0., 100.);
+      ASSERT_EQ(FindBinBruteForce(h, x, y), h.FindBin(x, y));
+   }
+   EXPECT_EQ(-1, h.FindBin(-1., 101.));
+   EXPECT_EQ(-9, h.FindBin(101., -1.));
+}
+
+// The first of overlapping bins is filled.
+TEST(TH2Poly, OverlappingBins)
+{
+   TH2Poly h("h", "h", 0., 20., 0., 20.);
+   h.AddBin(2., 2., 8., 8.);
+   h.AddBin(0., 0., 10., 10.);
+   h.AddBin(4., 4., 6., 6.);
+   EXPECT_EQ(1, h.FindBin(5., 5.));
+   EXPECT_EQ(2, h.FindBin(1., 1.));
+   EXPECT_EQ(1, h.Fill(5., 5.));
+   EXPECT_EQ(2, h.Fill(1., 1., 2.));
+   EXPECT_DOUBLE_EQ(1., h.GetBinContent(1));
+   EXPECT_DOUBLE_EQ(2., h.GetBinContent(2));
+   EXPECT_DOUBLE_EQ(0., h.GetBinContent(3));
+
+   // Bins added after filling are found as well.
+   EXPECT_EQ(-5, h.FindBin(15., 15.));
+   h.AddBin(14., 14., 16., 16.);
+   EXPECT_EQ(4, h.FindBin(15., 15.));
+}
+
+TEST(TH2Poly, FillN)
+{
+   TH2Poly h("h", "h", 0., 100., 0., 100.);
+   TH2Poly hN("hN", "hN", 0., 100., 0., 100.);
+   h.Honeycomb(0., 0., 2., 25, 30);
+   hN.Honeycomb(0., 0., 2., 25, 30);
+
+   const Int_t n = 5000;
+   TRandom3 rnd(11);
+   std::vector<Double_t> x(n), y(n);
+   for (Int_t i = 0; i < n; ++i) {
+      x[i] = rnd.Uniform(-10., 110.);
+      y[i] = rnd.Uniform(-10., 110.);
+      h.Fill(x[i], y[i]);
+   }
+   hN.FillN(n, x.data(), y.data(), nullptr);
+
+   EXPECT_DOUBLE_EQ(h.GetEntries(), hN.GetEntries());
+   for (Int_t bin = -9; bin <= h.GetNumberOfBins(); ++bin)
+      EXPECT_DOUBLE_EQ(h.GetBinContent(bin), hN.GetBinContent(bin));
+}
@@ -0,0 +1,184 @@
+#include "gtest/gtest.h"
+
+#include "TAxis.h"
+#include "TH2D.h"
+#include "THnSparse.h"
+#include "TList.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace {
+// Fill hs with n random entries, integers in [0, range) on each axis, and
+// return the content of each bin by coordinates.
+std::map<std::vector<Int_t>, Double_t> FillRandom(THnSparse &hs, Int_t n, Int_t range)
+{
+   const Int_t ndim = hs.GetNdimensions();
+   std::map<std::vector<Int_t>, Double_t> contents;
+   TRandom3 rnd(42);
+   std::vector<Double_t> x(ndim);
+   std::vector<Int_t> coord(ndim);
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t d = 0; d < ndim; ++d) {
+         x[d] = (Int_t)rnd.Uniform(range) + 0.5;
+         coord[d] = hs.GetAxis(d)->FindBin(x[d]);
+      }
+      const Double_t w = 1 + i % 3;
+      hs.Fill(x.data(), w);
+      contents[coord] += w;
+   }
+   return contents;
+}
+
+void ExpectContents(const THnSparse &hs, const std::map<std::vector<Int_t>, Double_t> &contents)
+{
+   ASSERT_EQ(hs.GetNbins(), (Long64_t)contents.size());
+   for (auto &bin : contents) {
+      const Long64_t linidx = hs.GetBin(bin.first.data());
+      ASSERT_GE(linidx, 0);
+      std::vector<Int_t> coord(hs.GetNdimensions());
+      EXPECT_DOUBLE_EQ(bin.second, hs.GetBinContent(linidx, coord.data()));
+      EXPECT_EQ(bin.first, coord);
+   }
+}
+} // anonymous namespace
+
+// Compact coordinates that fit into 8 bytes, used as hash.
+TEST(THnSparse, SmallCoordinates)
+{
+   Int_t bins[3] = {100, 100, 100};
+   Double_t xmin[3] = {0., 0., 0.};
+   Double_t xmax[3] = {100., 100., 100.};
+   THnSparseD hs("hs", "hs", 3, bins, xmin, xmax, 512);
+   ExpectContents(hs, FillRandom(hs, 50000, 100));
+
+   Int_t unfilled[3] = {0, 0, 0};
+   EXPECT_EQ(-1, hs.GetBin(unfilled));
+}
+
+// Compact coordinates larger than 8 bytes, hashed.
+TEST(THnSparse, LargeCoordinates)
+{
+   const Int_t ndim = 12;
+   std::vector<Int_t> bins(ndim, 1000);
+   std::vector<Double_t> xmin(ndim, 0.), xmax(ndim, 1000.);
+   THnSparseF hs("hs", "hs", ndim, bins.data(), xmin.data(), xmax.data(), 512);
+   ExpectContents(hs, FillRandom(hs, 20000, 3));
+}
+
+TEST(THnSparse, FillN)
+{
+   Int_t bins[4] = {20, 20, 20, 20};
+   Double_t xmin[4] = {0., 0., 0., 0.};
+   Double_t xmax[4] = {20., 20., 20., 20.};
+   THnSparseD hs("hs", "hs", 4, bins, xmin, xmax);
+   THnSparseD hsN("hsN", "hsN", 4, bins, xmin, xmax);
+   hs.Sumw2();
+   hsN.Sumw2();
+
+   const Int_t n = 10007;
+   TRandom3 rnd(1);
+   std::vector<Double_t> x(4 * n), w(n);
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t d = 0; d < 4; ++d)
+         x[4 * i + d] = rnd.Gaus(10., 4.);
+      w[i] = rnd.Uniform(0.5, 2.);
+      hs.Fill(&x[4 * i], w[i]);
+   }
+   hsN.FillN(n, x.data(), w.data());
+
+   ASSERT_EQ(hs.GetNbins(), hsN.GetNbins());
+   EXPECT_DOUBLE_EQ(hs.GetEntries(), hsN.GetEntries());
+   EXPECT_DOUBLE_EQ(hs.GetWeightSum(), hsN.GetWeightSum());
+   Int_t coord[4];
+   for (Long64_t i = 0; i < hs.GetNbins(); ++i) {
+      const Double_t content = hs.GetBinContent(i, coord);
+      const Long64_t binN = hsN.GetBin(coord);
+      ASSERT_GE(binN, 0);
+      EXPECT_DOUBLE_EQ(content, hsN.GetBinContent(binN));
+      EXPECT_DOUBLE_EQ(hs.GetBinError2(i), hsN.GetBinError2(binN));
+   }
+}
+
+// The bin index is not streamed: it is rebuilt from the chunks.
+TEST(THnSparse, CloneAndReset)
+{
+   Int_t bins[5] = {50, 50, 50, 50, 50};
+   Double_t xmin[5] = {0., 0., 0., 0., 0.};
+   Double_t xmax[5] = {50., 50., 50., 50., 50.};
+   THnSparseI hs("hs", "hs", 5, bins, xmin, xmax, 100);
+   auto contents = FillRandom(hs, 5000, 50);
+
+   std::unique_ptr<THnSparse> clone(static_cast<THnSparse *>(hs.Clone("clone")));
+   ExpectContents(*clone, contents);
+
+   hs.Reset();
+   EXPECT_EQ(0, hs.GetNbins());
+   for (auto &bin : contents)
+      ASSERT_EQ(-1, hs.GetBin(bin.first.data()));
+   ExpectContents(hs, FillRandom(hs, 5000, 50));
+}
+
+// The chunks of a THnSparse with the same binning are added directly.
+TEST(THnSparse, AddSameBinning)
+{
+   Int_t bins[4] = {30, 30, 30, 30};
+   Double_t xmin[4] = {0., 0., 0., 0.};
+   Double_t xmax[4] = {30., 30., 30., 30.};
+   THnSparseD hs("hs", "hs", 4, bins, xmin, xmax, 256);
+   THnSparseF other("other", "other", 4, bins, xmin, xmax, 100);
+   other.Sumw2();
+   auto contents = FillRandom(hs, 4000, 30);
+   auto otherContents = FillRandom(other, 3000, 20);
+
+   TList list;
+   list.Add(&other);
+   hs.Merge(&list);
+   list.Clear("nodelete");
+   for (auto &bin : otherContents)
+      contents[bin.first] += bin.second;
+   ExpectContents(hs, contents);
+   EXPECT_TRUE(hs.GetCalculateErrors());
+   EXPECT_DOUBLE_EQ(7000., hs.GetEntries());
+
+   hs.Add(&hs, -1.);
+   for (Long64_t i = 0; i < hs.GetNbins(); ++i)
+      EXPECT_DOUBLE_EQ(0., hs.GetBinContent(i));
+}
+
+#ifdef R__USE_IMT
+// The projections computed in parallel are the sequential ones.
+TEST(THnSparse, ParallelProjection)
+{
+   Int_t bins[3] = {200, 200, 200};
+   Double_t xmin[3] = {0., 0., 0.};
+   Double_t xmax[3] = {200., 200., 200.};
+   THnSparseD hs("hs", "hs", 3, bins, xmin, xmax, 1000);
+   FillRandom(hs, 100000, 200);
+   hs.GetAxis(2)->SetRange(20, 150);
+
+   Int_t dims[2] = {0, 1};
+   std::unique_ptr<TH2D> sequential(hs.Projection(1, 0, "E"));
+   std::unique_ptr<THnSparse> sequentialN(hs.Projection(2, dims, "E"));
+   ROOT::EnableImplicitMT(4);
+   std::unique_ptr<TH2D> parallel(hs.Projection(1, 0, "E"));
+   std::unique_ptr<THnSparse> parallelN(hs.Projection(2, dims, "E"));
+   ROOT::DisableImplicitMT();
+
+   EXPECT_EQ(sequential->GetEntries(), parallel->GetEntries());
+   for (Int_t i = 0; i < sequential->GetNcells(); ++i) {
+      ASSERT_EQ(sequential->GetBinContent(i), parallel->GetBinContent(i));
+      ASSERT_EQ(sequential->GetBinError(i), parallel->GetBinError(i));
+   }
+   ASSERT_EQ(sequentialN->GetNbins(), parallelN->GetNbins());
+   Int_t coord[2], parallelCoord[2];
+   for (Long64_t i = 0; i < sequentialN->GetNbins(); ++i) {
+      EXPECT_EQ(sequentialN->GetBinContent(i, coord), parallelN->GetBinContent(i, parallelCoord));
+      EXPECT_EQ(coord[0], parallelCoord[0]);
+      EXPECT_EQ(coord[1], parallelCoord[1]);
+   }
+}
+#endif
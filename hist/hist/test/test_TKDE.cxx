@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+
+#include "TKDE.h"
+#include "TRandom3.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+// Largest difference between the exact and the FFT evaluation of a TKDE of the
+// data with the given options, relative to the largest density.
+Double_t MaxFFTDifference(const std::vector<Double_t> &data, const char *option)
+{
+   const Double_t xmin = *std::min_element(data.begin(), data.end());
+   const Double_t xmax = *std::max_element(data.begin(), data.end());
+   TKDE exact(data.size(), data.data(), xmin, xmax, option);
+   TKDE fft(data.size(), data.data(), xmin, xmax, option);
+   fft.SetUseFFT();
+   Double_t maxDiff = 0, maxValue = 0;
+   for (Int_t i = 0; i <= 200; ++i) {
+      const Double_t x = xmin + (xmax - xmin) * i / 200.;
+      const Double_t value = exact(x);
+      maxDiff = std::max(maxDiff, std::abs(value - fft(x)));
+      maxValue = std::max(maxValue, value);
+   }
+   return maxDiff / maxValue;
+}
+
+std::vector<Double_t> GausData(Int_t n)
+{
+   TRandom3 rnd(17);
+   std::vector<Double_t> data(n);
+   for (auto &x : data)
+      x = rnd.Gaus(1., 2.);
+   return data;
+}
+} // anonymous namespace
+
+TEST(TKDE, FFTFixed)
+{
+   auto data = GausData(20000);
+   EXPECT_LT(MaxFFTDifference(data, "KernelType:Gaussian;Iteration:Fixed;Binning:Unbinned"), 1e-4);
+   EXPECT_LT(MaxFFTDifference(data, "KernelType:Epanechnikov;Iteration:Fixed;Binning:Unbinned"), 1e-3);
+}
+
+TEST(TKDE, FFTAdaptive)
+{
+   auto data = GausData(3000);
+   EXPECT_LT(MaxFFTDifference(data, "KernelType:Gaussian;Iteration:Adaptive;Binning:Unbinned"), 1e-3);
+}
+
+TEST(TKDE, FFTBinnedMirrored)
+{
+   TRandom3 rnd(5);
+   std::vector<Double_t> data(50000);
+   for (auto &x : data)
+      x = rnd.Exp(1.);
+   EXPECT_LT(MaxFFTDifference(data, "KernelType:Gaussian;Iteration:Fixed;Mirror:MirrorLeft;Binning:ForcedBinning"),
+             1e-3);
+}
@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+
+#include "TList.h"
+#include "TMultiDimFit.h"
+#include "TPrincipal.h"
+#include "TRandom3.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const Int_t kNVariables = 4;
+
+// Correlated rows of kNVariables variables.
+std::vector<Double_t> MakeRows(Int_t nRows, UInt_t seed)
+{
+   TRandom3 rnd(seed);
+   std::vector<Double_t> rows(nRows * kNVariables);
+   for (Int_t row = 0; row < nRows; ++row) {
+      const Double_t common = rnd.Gaus();
+      for (Int_t i = 0; i < kNVariables; ++i)
+         rows[row * kNVariables + i] = 10. + i + (i + 1) * common + rnd.Gaus();
+   }
+   return rows;
+}
+
+void ExpectSamePrincipal(const TPrincipal &expected, const TPrincipal &actual)
+{
+   for (Int_t i = 0; i < kNVariables; ++i) {
+      EXPECT_NEAR((*expected.GetMeanValues())(i), (*actual.GetMeanValues())(i), 1e-12) << "variable " << i;
+      for (Int_t j = 0; j <= i; ++j)
+         EXPECT_NEAR((*expected.GetCovarianceMatrix())(i, j), (*actual.GetCovarianceMatrix())(i, j), 1e-12)
+            << "element " << i << ", " << j;
+   }
+}
+
+} // anonymous namespace
+
+TEST(TPrincipal, AddRows)
+{
+   const Int_t nRows = 50000;
+   auto rows = MakeRows(nRows, 1);
+   TPrincipal expected(kNVariables, "ND"), actual(kNVariables, "ND");
+   for (Int_t row = 0; row < nRows; ++row)
+      expected.AddRow(&rows[row * kNVariables]);
+   // a few rows one by one, then blocks of rows
+   for (Int_t row = 0; row < 3; ++row)
+      actual.AddRow(&rows[row * kNVariables]);
+   actual.AddRows(nRows - 3, &rows[3 * kNVariables]);
+
+   ExpectSamePrincipal(expected, actual);
+   for (Int_t row = 0; row < nRows; row += 997)
+      for (Int_t i = 0; i < kNVariables; ++i)
+         EXPECT_EQ(expected.GetRow(row)[i], actual.GetRow(row)[i]);
+}
+
+TEST(TPrincipal, Merge)
+{
+   const Int_t nRows = 9000;
+   auto rows = MakeRows(nRows, 2);
+   TPrincipal expected(kNVariables, "ND"), actual(kNVariables, "ND");
+   TPrincipal part1(kNVariables, "ND"), part2(kNVariables, "ND");
+   for (Int_t row = 0; row < nRows; ++row) {
+      expected.AddRow(&rows[row * kNVariables]);
+      if (row < 1000)
+         actual.AddRow(&rows[row * kNVariables]);
+      else if (row < 5000)
+         part1.AddRow(&rows[row * kNVariables]);
+      else
+         part2.AddRow(&rows[row * kNVariables]);
+   }
+   TList list;
+   list.Add(&part1);
+   list.Add(&part2);
+   EXPECT_EQ(nRows, actual.Merge(&list));
+
+   ExpectSamePrincipal(expected, actual);
+   for (Int_t row = 0; row < nRows; row += 97)
+      for (Int_t i = 0; i < kNVariables; ++i)
+         EXPECT_EQ(expected.GetRow(row)[i], actual.GetRow(row)[i]);
+}
+
+TEST(TMultiDimFit, AddRowsAndMerge)
+{
+   const Int_t nRows = 3000;
+   auto rows = MakeRows(nRows, 3);
+   std::vector<Double_t> d(nRows), e(nRows);
+   for (Int_t row = 0; row < nRows; ++row) {
+      d[row] = rows[row * kNVariables] * rows[row * kNVariables + 1];
+      e[row] = 0.1 * (row % 7);
+   }
+
+   TMultiDimFit expected(kNVariables), added(kNVariables), merged(kNVariables), part(kNVariables);
+   for (Int_t row = 0; row < nRows; ++row)
+      expected.AddRow(&rows[row * kNVariables], d[row], e[row]);
+   added.AddRows(nRows, rows.data(), d.data(), e.data());
+   merged.AddRows(1000, rows.data(), d.data(), e.data());
+   part.AddRows(nRows - 1000, &rows[1000 * kNVariables], &d[1000], &e[1000]);
+   TList list;
+   list.Add(&part);
+   EXPECT_EQ(nRows, merged.Merge(&list));
+
+   for (auto actual : {&added, &merged}) {
+      ASSERT_EQ(expected.GetSampleSize(), actual->GetSampleSize());
+      EXPECT_EQ(expected.GetMeanQuantity(), actual->GetMeanQuantity());
+      EXPECT_EQ(expected.GetSumSqQuantity(), actual->GetSumSqQuantity());
+      for (Int_t i = 0; i < kNVariables; ++i) {
+         EXPECT_EQ((*expected.GetMeanVariables())(i), (*actual->GetMeanVariables())(i));
+         EXPECT_EQ((*expected.GetMinVariables())(i), (*actual->GetMinVariables())(i));
+         EXPECT_EQ((*expected.GetMaxVariables())(i), (*actual->GetMaxVariables())(i));
+      }
+      for (Int_t row = 0; row < nRows; ++row) {
+         EXPECT_EQ((*expected.GetQuantity())(row), (*actual->GetQuantity())(row));
+         EXPECT_EQ((*expected.GetSqError())(row), (*actual->GetSqError())(row));
+         for (Int_t i = 0; i < kNVariables; ++i)
+            EXPECT_EQ((*expected.GetVariables())(row * kNVariables + i),
+                      (*actual->GetVariables())(row * kNVariables + i));
+      }
+   }
+}
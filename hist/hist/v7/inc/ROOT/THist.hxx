@@ -161,6 +161,9 @@ public:
 
    const_iterator end() const { return const_iterator(*fImpl, fImpl->GetNBins()); }
 
+   /// Create a histogram with the same title and axes, and no entries.
+   THist CloneEmpty() const { return HistFromImpl<DIMENSIONS, PRECISION, STAT...>(fImpl->CloneEmpty()); }
+
    /// Swap *this and other.
    ///
    /// Very efficient; swaps the `fImpl` pointers.
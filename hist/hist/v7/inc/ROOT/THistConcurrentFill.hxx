@@ -108,6 +108,105 @@ public:
    }
 };
 
+template <class HIST>
+class THistPartialFillManager;
+
+/**
+ \class THistPartialFiller
+ Fills a thread's own partial histogram, without any synchronization. The
+ partial histogram is added to the histogram of the THistPartialFillManager
+ when Merge() is called or when the filler is destroyed.
+ **/
+
+template <class HIST>
+class THistPartialFiller {
+public:
+   using CoordArray_t = typename HIST::CoordArray_t;
+   using Weight_t = typename HIST::Weight_t;
+
+private:
+   THistPartialFillManager<HIST> *fManager; ///< Manager holding the histogram to merge into; null once moved from
+   HIST fPartial;                           ///< Entries filled since the last merge
+
+public:
+   THistPartialFiller(THistPartialFillManager<HIST> &manager): fManager(&manager), fPartial(manager.MakePartial()) {}
+   THistPartialFiller(THistPartialFiller &&other): fManager(other.fManager), fPartial(std::move(other.fPartial))
+   {
+      other.fManager = nullptr;
+   }
+   ~THistPartialFiller() { Merge(); }
+
+   /// Thread-specific HIST::Fill().
+   void Fill(const CoordArray_t &x, Weight_t weight = 1.) { fPartial.Fill(x, weight); }
+
+   /// Thread-specific HIST::FillN().
+   void FillN(const std::array_view<CoordArray_t> xN, const std::array_view<Weight_t> weightN)
+   {
+      fPartial.FillN(xN, weightN);
+   }
+
+   /// Thread-specific HIST::FillN().
+   void FillN(const std::array_view<CoordArray_t> xN) { fPartial.FillN(xN); }
+
+   /// Add the entries filled so far to the manager's histogram.
+   void Merge()
+   {
+      if (!fManager || !fPartial.GetEntries())
+         return;
+      fManager->Merge(fPartial);
+      HIST empty = fManager->MakePartial();
+      fPartial.swap(empty);
+   }
+
+   static constexpr int GetNDim() { return HIST::GetNDim(); }
+};
+
+/**
+ \class THistPartialFillManager
+ Fills a histogram from several threads through per-thread partial histograms.
+
+ The THistPartialFiller objects handed out by MakeFiller() fill a histogram of
+ their own, with the title and axes of the managed one, and add it to the
+ managed histogram only when they are merged or destroyed. Contrary to
+ THistConcurrentFillManager, the threads do not synchronize while filling;
+ the price is one partial histogram per filler. The managed histogram must
+ not be read before the fillers are merged.
+ **/
+
+template <class HIST>
+class THistPartialFillManager {
+   friend class THistPartialFiller<HIST>;
+
+public:
+   using Hist_t = HIST;
+   using CoordArray_t = typename HIST::CoordArray_t;
+   using Weight_t = typename HIST::Weight_t;
+
+private:
+   HIST &fHist;
+   std::mutex fMergeMutex;
+
+   HIST MakePartial() const { return fHist.CloneEmpty(); }
+
+   /// Add partial to the managed histogram; its bins are the same unless the
+   /// axes of one of them have grown.
+   void Merge(const HIST &partial)
+   {
+      std::lock_guard<std::mutex> lockGuard(fMergeMutex);
+      auto toImpl = fHist.GetImpl();
+      auto fromImpl = partial.GetImpl();
+      if (toImpl->GetNBins() == fromImpl->GetNBins())
+         toImpl->GetStat().Add(fromImpl->GetStat());
+      else
+         Add(fHist, partial);
+   }
+
+public:
+   THistPartialFillManager(HIST &hist): fHist(hist) {}
+
+   THistPartialFiller<HIST> MakeFiller() { return THistPartialFiller<HIST>{*this}; }
+};
+
 } // namespace Experimental
 } // namespace ROOT
 
@@ -90,6 +90,15 @@ public:
       ++fEntries;
    }
 
+   /// Add the bin contents and the number of entries of `other`, which has the
+   /// same bins.
+   void Add(const THistStatContent &other)
+   {
+      for (size_t i = 0, n = fBinContent.size(); i < n; ++i)
+         fBinContent[i] += other.fBinContent[i];
+      fEntries += other.fEntries;
+   }
+
    /// Get the number of entries filled into the histogram - i.e. the number of
    /// calls to Fill().
    int64_t GetEntries() const { return fEntries; }
@@ -148,6 +157,9 @@ public:
    /// Add weight to the bin content at binidx.
    void Fill(const CoordArray_t & /*x*/, int, Weight_t weight = 1.) { fSumWeights += weight; }
 
+   /// Add the sum of weights of `other`.
+   void Add(const THistStatTotalSumOfWeights &other) { fSumWeights += other.fSumWeights; }
+
    /// Get the sum of weights.
    Weight_t GetSumOfWeights() const { return fSumWeights; }
 };
@@ -187,6 +199,9 @@ public:
    /// Add weight to the bin content at binidx.
    void Fill(const CoordArray_t & /*x*/, int /*binidx*/, Weight_t weight = 1.) { fSumWeights2 += weight * weight; }
 
+   /// Add the sum of squared weights of `other`.
+   void Add(const THistStatTotalSumOfSquaredWeights &other) { fSumWeights2 += other.fSumWeights2; }
+
    /// Get the sum of weights.
    Weight_t GetSumOfSquaredWeights() const { return fSumWeights2; }
 };
@@ -253,6 +268,13 @@ public:
       fSumWeightsSquared[binidx] += weight * weight;
    }
 
+   /// Add the sums of squared weights of `other`, which has the same bins.
+   void Add(const THistStatUncertainty &other)
+   {
+      for (size_t i = 0, n = fSumWeightsSquared.size(); i < n; ++i)
+         fSumWeightsSquared[i] += other.fSumWeightsSquared[i];
+   }
+
    /// Calculate a bin's (Poisson) uncertainty of the bin content as the
    /// square-root of the bin's sum of squared weights.
    double GetBinUncertaintyImpl(int binidx) const { return std::sqrt(fSumWeightsSquared[binidx]); }
@@ -311,6 +333,15 @@ public:
          fMomentX2W[idim] += x[idim] * xw;
       }
    }
+
+   /// Add the moments of `other`.
+   void Add(const THistDataMomentUncert &other)
+   {
+      for (int idim = 0; idim < DIMENSIONS; ++idim) {
+         fMomentXW[idim] += other.fMomentXW[idim];
+         fMomentX2W[idim] += other.fMomentX2W[idim];
+      }
+   }
 };
 
 /** \class THistStatRuntime
@@ -456,6 +487,14 @@ public:
       (void)trigger_base_fill{(STAT<DIMENSIONS, PRECISION, STORAGE>::Fill(x, binidx, weight), 0)...};
    }
 
+   /// Add the statistics of `other`, which has the same bins, by calling Add()
+   /// on all base classes; see Fill().
+   void Add(const THistData &other)
+   {
+      using trigger_base_add = int[];
+      (void)trigger_base_add{(STAT<DIMENSIONS, PRECISION, STORAGE>::Add(other), 0)...};
+   }
+
    /// Whether this provides storage for uncertainties, or whether uncertainties
    /// are determined as poisson uncertainty of the content.
    static constexpr bool HasBinUncertainty()
@@ -18,6 +18,7 @@
 
 #include <cctype>
 #include <functional>
+#include <memory>
 #include "ROOT/RArrayView.hxx"
 #include "ROOT/RTupleApply.hxx"
 
@@ -175,6 +176,9 @@ public:
    /// Retrieve the pointer to the overridden Fill(x, w) function.
    virtual FillFunc_t GetFillFunc() const = 0;
 
+   /// Create a histogram with the same title and axes, and no entries.
+   virtual std::unique_ptr<THistImplBase> CloneEmpty() const = 0;
+
    /// Apply a function (lambda) to all bins of the histogram. The function takes
    /// the bin reference.
    virtual void Apply(std::function<void(THistBinRef<const THistImplBase>)>) const = 0;
@@ -383,6 +387,15 @@ public:
    /// the virtual function call for high-frequency fills.
    FillFunc_t GetFillFunc() const final { return (FillFunc_t)&THistImpl::Fill; }
 
+   /// Create a histogram with the same title and axes, and no entries.
+   std::unique_ptr<ImplBase_t> CloneEmpty() const final
+   {
+      auto makeEmpty = [this](const AXISCONFIG &... axes) -> std::unique_ptr<ImplBase_t> {
+         return std::make_unique<THistImpl>(this->GetTitle(), axes...);
+      };
+      return std::apply(makeEmpty, fAxes);
+   }
+
    /// Apply a function (lambda) to all bins of the histogram. The function takes
    /// the bin reference.
    void Apply(std::function<void(THistBinRef<const ImplBase_t>)> op) const final
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/THist.hxx"
+#include "ROOT/THistConcurrentFill.hxx"
+
+#include <thread>
+#include <vector>
+
+using namespace ROOT::Experimental;
+
+namespace {
+
+const int kNThreads = 8;
+const int kNPerThread = 20000;
+
+// Coordinate of entry i of thread t, under- and overflows included.
+double Value(int t, int i)
+{
+   return -0.1 + 1.2 * ((i * 7919 + t * 104729) % 10007) / 10007.;
+}
+
+template <class MANAGER>
+void FillConcurrently(MANAGER &manager)
+{
+   std::vector<std::thread> threads;
+   for (int t = 0; t < kNThreads; ++t) {
+      threads.emplace_back(
+         [t](decltype(manager.MakeFiller()) filler) {
+            for (int i = 0; i < kNPerThread; ++i)
+               filler.Fill({Value(t, i), Value(t, 3 * i)}, (i % 5) ? 1. : 2.);
+         },
+         manager.MakeFiller());
+   }
+   for (auto &thread : threads)
+      thread.join();
+}
+
+TH2D MakeReference()
+{
+   TH2D ref({{20, 0., 1.}, {30, 0., 1.}});
+   for (int t = 0; t < kNThreads; ++t)
+      for (int i = 0; i < kNPerThread; ++i)
+         ref.Fill({Value(t, i), Value(t, 3 * i)}, (i % 5) ? 1. : 2.);
+   return ref;
+}
+
+void ExpectSameHistograms(const TH2D &hist, const TH2D &ref)
+{
+   EXPECT_EQ(hist.GetEntries(), ref.GetEntries());
+   const auto *impl = hist.GetImpl();
+   const auto *refImpl = ref.GetImpl();
+   ASSERT_EQ(impl->GetNBins(), refImpl->GetNBins());
+   for (int bin = 0; bin < refImpl->GetNBins(); ++bin) {
+      EXPECT_DOUBLE_EQ(impl->GetBinContentAsDouble(bin), refImpl->GetBinContentAsDouble(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(impl->GetBinUncertainty(bin), refImpl->GetBinUncertainty(bin)) << "bin " << bin;
+   }
+}
+
+} // anonymous namespace
+
+// Test the buffered filling, serialized by a mutex.
+TEST(HistConcurrentFillTest, Locked)
+{
+   TH2D hist({{20, 0., 1.}, {30, 0., 1.}});
+   {
+      THistConcurrentFillManager<TH2D> manager(hist);
+      FillConcurrently(manager);
+   }
+   ExpectSameHistograms(hist, MakeReference());
+}
+
+// Test the filling of per-thread partial histograms.
+TEST(HistConcurrentFillTest, Partial)
+{
+   TH2D hist({{20, 0., 1.}, {30, 0., 1.}});
+   {
+      THistPartialFillManager<TH2D> manager(hist);
+      FillConcurrently(manager);
+   }
+   ExpectSameHistograms(hist, MakeReference());
+}
+
+// Test that the partial histograms start empty and can be merged several times.
+TEST(HistConcurrentFillTest, PartialMerge)
+{
+   TH1D hist({10, 0., 1.});
+   hist.Fill({0.55}, 3.);
+   THistPartialFillManager<TH1D> manager(hist);
+   auto filler = manager.MakeFiller();
+   filler.Fill({0.55});
+   EXPECT_EQ(1, hist.GetEntries());
+   filler.Merge();
+   EXPECT_EQ(2, hist.GetEntries());
+   EXPECT_DOUBLE_EQ(4., hist.GetBinContent({0.55}));
+   filler.Fill({0.55}, 2.);
+   filler.Merge();
+   EXPECT_EQ(3, hist.GetEntries());
+   EXPECT_DOUBLE_EQ(6., hist.GetBinContent({0.55}));
+   EXPECT_DOUBLE_EQ(std::sqrt(14.), hist.GetBinUncertainty({0.55}));
+}
@@ -53,10 +53,12 @@ public:
    void           PaintStats(TGraph *theGraph, TF1 *fit);
    void           Smooth(TGraph *theGraph, Int_t npoints, Double_t *x, Double_t *y, Int_t drawtype);
    static void    SetMaxPointsPerLine(Int_t maxp=50);
+   static void    SetMaxPointsPerPixel(Int_t maxp=4);
 
 protected:
 
    static Int_t   fgMaxPointsPerLine;  //Number of points per chunks' line when drawing a graph.
+   static Int_t   fgMaxPointsPerPixel; //Number of points per pixel column above which a graph is decimated.
 
    ClassDef(TGraphPainter,0)  // TGraph painter
 };
@@ -35,6 +35,7 @@ class TGaxis;
 class TPainter3dAlgorithms;
 class TGraph2DPainter;
 class TPie;
+class TImage;
 const Int_t kMaxCuts = 16;
 
 struct THistRenderingRegion
@@ -63,6 +64,8 @@ protected:
    TList                *fStack;             //Pointer to stack of histograms (if any)
    Int_t                 fShowProjection;    //True if a projection must be drawn
    TString               fShowOption;        //Option to draw the projection
+   TImage               *fColorLevelsImage;  //!Cached image of the COL2 option
+   std::vector<Int_t>    fColorLevelsKey;    //!Sizes, bin ranges, palette and colors fColorLevelsImage was made of
 
 public:
    THistPainter();
@@ -32,8 +32,12 @@
 #include "TFrame.h"
 #include "TVirtualPadEditor.h"
 
+#include <unordered_set>
+#include <vector>
+
 Double_t *gxwork, *gywork, *gxworkl, *gyworkl;
 Int_t TGraphPainter::fgMaxPointsPerLine = 50;
+Int_t TGraphPainter::fgMaxPointsPerPixel = 4;
 
 ClassImp(TGraphPainter);
 
@@ -55,6 +59,7 @@ ClassImp(TGraphPainter);
 - [Colors automatically picked in palette](#GP05)
 - [Reverse graphs' axis](#GP06)
 - [Graphs in logarithmic scale](#GP07)
+- [Graphs with many points](#GP08)
 
 
 ### <a name="GP00"></a> Introduction
@@ -527,9 +532,71 @@ Begin_Macro(source)
 }
 
 End_Macro
+
+### <a name="GP08"></a> Graphs with many points
+
+When a graph drawn with lines (option `L`) or markers (options `P` and `*`) has
+more points than `TGraphPainter::SetMaxPointsPerPixel(n)` (4 by default) times
+the width of the pad in pixels, only the points making a difference at the
+resolution of the pad are painted:
+
+  - for the lines, each run of consecutive points falling in the same pixel
+    column is replaced by its first, lowest, highest and last points;
+  - for the markers, a single point is kept per pixel.
+
+The decimation is computed again at each painting, hence when zooming, and for
+the resolution of the output (e.g. the size of the canvas for a PDF file). The
+graph itself is not modified: fits and `TGraph::Eval` use all its points.
+`TGraphPainter::SetMaxPointsPerPixel(0)` disables the decimation.
 */
 
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace each run of consecutive points in the same pixel column of gPad by
+/// its first, lowest, highest and last points, which draw the same polyline.
+
+void DecimateLine(Int_t n, const Double_t *x, const Double_t *y, std::vector<Double_t> &xd, std::vector<Double_t> &yd)
+{
+   Int_t first = 0;
+   Int_t col = gPad->XtoAbsPixel(gPad->XtoPad(x[0]));
+   while (first < n) {
+      Int_t imin = first, imax = first, next = first + 1, nextcol = col;
+      for (; next < n; ++next) {
+         nextcol = gPad->XtoAbsPixel(gPad->XtoPad(x[next]));
+         if (nextcol != col) break;
+         if (y[next] < y[imin]) imin = next;
+         if (y[next] > y[imax]) imax = next;
+      }
+      const Int_t keep[4] = {first, TMath::Min(imin, imax), TMath::Max(imin, imax), next - 1};
+      for (Int_t k = 0; k < 4; ++k) {
+         if (k > 0 && keep[k] == keep[k-1]) continue;
+         xd.push_back(x[keep[k]]);
+         yd.push_back(y[keep[k]]);
+      }
+      first = next;
+      col = nextcol;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep the first point falling in each pixel of gPad.
+
+void DecimateMarkers(Int_t n, const Double_t *x, const Double_t *y, std::vector<Double_t> &xd, std::vector<Double_t> &yd)
+{
+   std::unordered_set<Long64_t> pixels;
+   for (Int_t i = 0; i < n; ++i) {
+      const Long64_t px = gPad->XtoAbsPixel(gPad->XtoPad(x[i]));
+      const Long64_t py = gPad->YtoAbsPixel(gPad->YtoPad(y[i]));
+      if (!pixels.insert((px << 32) ^ (py & 0xffffffff)).second) continue;
+      xd.push_back(x[i]);
+      yd.push_back(y[i]);
+   }
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
 
@@ -1209,6 +1276,24 @@ void TGraphPainter::PaintGraph(TGraph *theGraph, Int_t npoints, const Double_t *
    theGraph->TAttFill::Modify();
    theGraph->TAttMarker::Modify();
 
+   // Decimate the points of the graphs much denser than the pixels of the pad,
+   // see SetMaxPointsPerPixel. The lines and the markers are decimated apart.
+   std::vector<Double_t> xlined, ylined, xmarkd, ymarkd;
+   const Double_t *xline = x, *yline = y, *xmark = x, *ymark = y;
+   Int_t nline = npoints, nmark = npoints;
+   Int_t padwidth = TMath::Abs(gPad->XtoAbsPixel(gPad->GetX2()) - gPad->XtoAbsPixel(gPad->GetX1()));
+   if (fgMaxPointsPerPixel > 0 && npoints > fgMaxPointsPerPixel * TMath::Max(padwidth, 1) &&
+       !optionFill && !optionCurve && !optionBar && !optionR && !theGraph->InheritsFrom(TGraphPolar::Class())) {
+      if (optionLine && TMath::Abs(theGraph->GetLineWidth()) <= 99) {
+         DecimateLine(npoints, x, y, xlined, ylined);
+         xline = xlined.data(); yline = ylined.data(); nline = xlined.size();
+      }
+      if (optionMark || optionStar) {
+         DecimateMarkers(npoints, x, y, xmarkd, ymarkd);
+         xmark = xmarkd.data(); ymark = ymarkd.data(); nmark = xmarkd.size();
+      }
+   }
+
    // Draw the graph with a polyline or a fill area
    gxwork  = new Double_t[2*npoints+10];
    gywork  = new Double_t[2*npoints+10];
@@ -1216,18 +1301,18 @@ void TGraphPainter::PaintGraph(TGraph *theGraph, Int_t npoints, const Double_t *
    gyworkl = new Double_t[2*npoints+10];
 
    if (optionLine || optionFill) {
-      x1    = x[0];
-      xn    = x[npoints-1];
-      y1    = y[0];
-      yn    = y[npoints-1];
-      nloop = npoints;
+      x1    = xline[0];
+      xn    = xline[nline-1];
+      y1    = yline[0];
+      yn    = yline[nline-1];
+      nloop = nline;
       if (optionFill && (xn != x1 || yn != y1)) nloop++;
       npt = 0;
       for (i=1;i<=nloop;i++) {
-         if (i > npoints) {
+         if (i > nline) {
             gxwork[npt] = gxwork[0];  gywork[npt] = gywork[0];
          } else {
-            gxwork[npt] = x[i-1];      gywork[npt] = y[i-1];
+            gxwork[npt] = xline[i-1];  gywork[npt] = yline[i-1];
             npt++;
          }
          if (i == nloop) {
@@ -1328,10 +1413,10 @@ void TGraphPainter::PaintGraph(TGraph *theGraph, Int_t npoints, const Double_t *
    if (optionStar) {
       theGraph->SetMarkerStyle(3);
       npt = 0;
-      for (i=1;i<=npoints;i++) {
-         gxwork[npt] = x[i-1];      gywork[npt] = y[i-1];
+      for (i=1;i<=nmark;i++) {
+         gxwork[npt] = xmark[i-1];  gywork[npt] = ymark[i-1];
          npt++;
-         if (i == npoints) {
+         if (i == nmark) {
             ComputeLogs(npt, optionZ);
             if (optionR)  gPad->PaintPolyMarker(npt,gyworkl,gxworkl);
             else          gPad->PaintPolyMarker(npt,gxworkl,gyworkl);
@@ -1343,10 +1428,10 @@ void TGraphPainter::PaintGraph(TGraph *theGraph, Int_t npoints, const Double_t *
    // Draw the graph with the current polymarker on every points
    if (optionMark) {
       npt = 0;
-      for (i=1;i<=npoints;i++) {
-         gxwork[npt] = x[i-1];      gywork[npt] = y[i-1];
+      for (i=1;i<=nmark;i++) {
+         gxwork[npt] = xmark[i-1];  gywork[npt] = ymark[i-1];
          npt++;
-         if (i == npoints) {
+         if (i == nmark) {
             ComputeLogs(npt, optionZ);
             if (optionR) gPad->PaintPolyMarker(npt,gyworkl,gxworkl);
             else         gPad->PaintPolyMarker(npt,gxworkl,gyworkl);
@@ -4250,3 +4335,14 @@ void TGraphPainter::SetMaxPointsPerLine(Int_t maxp)
    fgMaxPointsPerLine = maxp;
    if (maxp < 50) fgMaxPointsPerLine = 50;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function to set `fgMaxPointsPerPixel` for graph painting. The graphs
+/// painted with lines or markers having more than `maxp` points per pixel column
+/// of the pad are decimated to the points visible at the resolution of the pad,
+/// see [Graphs with many points](#GP08). 0 disables the decimation.
+
+void TGraphPainter::SetMaxPointsPerPixel(Int_t maxp)
+{
+   fgMaxPointsPerPixel = TMath::Max(maxp, 0);
+}
@@ -46,6 +46,7 @@
 #include "TPie.h"
 #include "TGaxis.h"
 #include "TColor.h"
+#include "TVirtualPS.h"
 #include "TPainter3dAlgorithms.h"
 #include "TGraph2DPainter.h"
 #include "TGraphDelaunay2D.h"
@@ -65,6 +66,8 @@
 #include "TImage.h"
 #include "TCandle.h"
 
+#include <algorithm>
+
 /*! \class THistPainter
 \ingroup Histpainter
 \brief The histogram painter class. Implements all histograms' drawing's options.
@@ -1117,9 +1120,12 @@ For the most part, the COL2 and COLZ2 options are a drop in replacement to the C
 and COLZ options. There is one major difference and that concerns the treatment of
 bins with zero content. The COL2 and COLZ2 options color these bins the color of zero.
 
-COL2 option renders the histogram as a bitmap. Therefore it cannot be saved in vector
-graphics file format like PostScript or PDF (an empty image will be generated). It can
-be saved only in bitmap files like PNG format for instance.
+COL2 option renders the histogram as a bitmap, with the colors of the COL option. The
+bitmap is kept by the painter and made again only when the size of the frame, the range
+of bins shown, the palette or the colors of the bins change, so that repainting the pad
+(e.g. when moving another object) costs little. It is painted in the window, in the
+bitmap files, like PNG, also in batch mode, and in PostScript files as a cell array.
+The PDF and SVG files get the boxes of the COL option instead.
 
 
 ### <a name="HP140"></a> The CANDLE and VIOLIN options
@@ -3035,6 +3041,7 @@ THistPainter::THistPainter()
    fGraph2DPainter = 0;
    fShowProjection = 0;
    fShowOption = "";
+   fColorLevelsImage = 0;
    for (int i=0; i<kMaxCuts; i++) {
       fCuts[i] = 0;
       fCutsOpt[i] = 0;
@@ -3068,6 +3075,7 @@ THistPainter::THistPainter()
 
 THistPainter::~THistPainter()
 {
+   delete fColorLevelsImage;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -5193,6 +5201,12 @@ void THistPainter::PaintColorLevelsFast(Option_t*)
      return;
    }
 
+   // PDF and SVG files cannot hold the image yet
+   if (gVirtualPS && !gVirtualPS->InheritsFrom("TImageDump") && !gVirtualPS->InheritsFrom("TPostScript")) {
+      PaintColorLevels(nullptr);
+      return;
+   }
+
    Double_t z;
 
    // Use existing max or min values. If either is already set
@@ -5238,18 +5252,14 @@ void THistPainter::PaintColorLevelsFast(Option_t*)
       ndiv = gStyle->GetNumberContours();
       fH->SetContour(ndiv);
    }
-   std::vector<Double_t> colorBounds(ndiv);
-   std::vector<Double_t> contours(ndiv, 0);
+   std::vector<Double_t> contours(TMath::Abs(ndiv), 0);
    if (fH->TestBit(TH1::kUserContour) == 0) {
       fH->SetContour(ndiv);
-   } else {
-      fH->GetContour(contours.data());
    }
 
-   Double_t step = 1.0/ndiv;
-   for (Int_t i=0; i<ndiv; ++i) {
-      colorBounds[i] = step*i;
-   }
+   Int_t ndivz   = TMath::Abs(ndiv);
+   Int_t ncolors = gStyle->GetNumberOfColors();
+   Double_t scale = (dz != 0) ? ndivz/dz : 0;
 
    auto pFrame = gPad->GetFrame();
    Int_t px0 = gPad->XtoPixel(pFrame->GetX1());
@@ -5258,8 +5268,11 @@ void THistPainter::PaintColorLevelsFast(Option_t*)
    Int_t py1 = gPad->YtoPixel(pFrame->GetY2());
    Int_t nXPixels = px1-px0;
    Int_t nYPixels = py0-py1; // y=0 is at the top of the screen
-
-   std::vector<Double_t> buffer(nXPixels*nYPixels, 0);
+   if (nXPixels <= 0 || nYPixels <= 0) {
+      fH->SetMinimum(originalZMin);
+      fH->SetMaximum(originalZMax);
+      return;
+   }
 
    auto xRegions = ComputeRenderingRegions(fXaxis, nXPixels, Hoption.Logx);
    auto yRegions = ComputeRenderingRegions(fYaxis, nYPixels, Hoption.Logy);
@@ -5269,96 +5282,117 @@ void THistPainter::PaintColorLevelsFast(Option_t*)
       return;
    }
 
-   Bool_t minExists = kFALSE;
-   Bool_t maxExists = kFALSE;
-   Double_t minValue = 1.;
-   Double_t maxValue = 0.;
+   // Sample the content of each region
+   const Int_t nRegions = xRegions.size()*yRegions.size();
+   std::vector<Double_t> zRegion(nRegions);
+   Int_t k = 0;
    for (auto& yRegion : yRegions) {
-     for (auto& xRegion : xRegions ) {
-
-       const auto& xBinRange = xRegion.fBinRange;
-       const auto& yBinRange = yRegion.fBinRange;
-
-       // sample the range
-       z = fH->GetBinContent(xBinRange.second-1, yBinRange.second-1);
+      for (auto& xRegion : xRegions) {
+         z = fH->GetBinContent(xRegion.fBinRange.second-1, yRegion.fBinRange.second-1);
+         if (Hoption.Logz) {
+            if (z > 0) z = TMath::Log10(z);
+            else       z = zmin;
+         }
+         zRegion[k++] = z;
+      }
+   }
 
-       if (Hoption.Logz) {
-         if (z > 0) z = TMath::Log10(z);
-         else       z = zmin;
-       }
-
-       // obey the user's max and min values if they were set
-       if (z > zmax) z = zmax;
-       if (z < zmin) z = zmin;
-
-       if (fH->TestBit(TH1::kUserContour) == 1) {
-          // contours are absolute values
-          auto index  = TMath::BinarySearch(contours.size(), contours.data(), z);
-          z = colorBounds[index];
-       } else {
-          Int_t index = 0;
-          if (dz != 0) {
-             index = 0.001 + ((z - zmin)/dz)*ndiv;
-          }
-
-          if (index == static_cast<Int_t>(colorBounds.size())) {
-             index--;
-          }
-
-          // Do a little bookkeeping to use later for getting libAfterImage to produce
-          // the correct colors
-          if (index == 0) {
-             minExists = kTRUE;
-          } else if (index == static_cast<Int_t>(colorBounds.size()-1)) {
-             maxExists = kTRUE;
-          }
-
-          z = colorBounds[index];
-
-          if (z < minValue) {
-             minValue = z;
-          }
-          if (z > maxValue) {
-             maxValue = z;
-          }
-       }
-
-       // fill in the actual pixels
-       const auto& xPixelRange = xRegion.fPixelRange;
-       const auto& yPixelRange = yRegion.fPixelRange;
-       for (Int_t xPx = xPixelRange.first; xPx <= xPixelRange.second; ++xPx) {
-         for (Int_t yPx = yPixelRange.first; yPx <= yPixelRange.second; ++yPx) {
-           Int_t pixel = yPx*nXPixels + xPx;
-           buffer[pixel] = z;
-         }
-       }
-     } // end px loop
-   } // end py loop
-
-   // This is a bit of a hack to ensure that we span the entire color range and
-   // don't screw up the colors for a sparse histogram. No one will notice that I set a
-   // single pixel on the edge of the image to a different color. This is even more
-   // true because the chosen pixels will be covered by the axis.
-   if (minValue != maxValue) {
-      if ( !minExists) {
-         buffer.front() = 0;
-      }
-
-      if ( !maxExists) {
-         buffer[buffer.size()-nXPixels] = 0.95;
-      }
-   }
-
-   // Generate the TImage
-   TImagePalette* pPalette = TImagePalette::CreateCOLPalette(ndiv);
-   TImage* pImage = TImage::Create();
-   pImage->SetImageQuality(TAttImage::kImgBest);
-   pImage->SetImage(buffer.data(), nXPixels, nYPixels, pPalette);
-   delete pPalette;
-
-   Window_t wid = static_cast<Window_t>(gVirtualX->GetWindowID(gPad->GetPixmapID()));
-   pImage->PaintImage(wid, px0, py1, 0, 0, nXPixels, nYPixels);
-   delete pImage;
+   // Map the contents to the palette as the COL option, in a vectorizable loop
+   // when the levels are equidistant. The user's max and min values are obeyed.
+   std::vector<Int_t> colorRegion(nRegions);
+   if (fH->TestBit(TH1::kUserContour)) {
+      // contours are absolute values
+      for (Int_t i=0; i<ndivz; ++i) contours[i] = fH->GetContourLevelPad(i);
+      for (k=0; k<nRegions; ++k) {
+         colorRegion[k] = TMath::Max(0, (Int_t)TMath::BinarySearch(ndivz, contours.data(), zRegion[k]));
+      }
+   } else {
+      const Double_t *zr = zRegion.data();
+      Int_t *cr = colorRegion.data();
+      if (dz != 0) {
+         for (k=0; k<nRegions; ++k) {
+            Double_t zk = zr[k] > zmax ? zmax : (zr[k] < zmin ? zmin : zr[k]);
+            cr[k] = Int_t(0.01+(zk-zmin)*scale);
+         }
+      } else {
+         // empty or all-zero histogram: zmin = zmax = 0
+         std::fill(colorRegion.begin(), colorRegion.end(), 0);
+      }
+   }
+   for (auto &color : colorRegion) {
+      color = TMath::Max(0, TMath::Min(Int_t((color+0.99)*Float_t(ncolors)/Float_t(ndivz)), ncolors-1));
+   }
+
+   // The image is made again only if the frame, the shown bins, the palette or
+   // the colors of the regions changed since the previous painting.
+   std::vector<Int_t> key = {nXPixels, nYPixels, fXaxis->GetFirst(), fXaxis->GetLast(),
+                             fYaxis->GetFirst(), fYaxis->GetLast(), Hoption.Logx, Hoption.Logy, ncolors};
+   std::vector<UInt_t> argbPalette(ncolors);
+   for (Int_t i=0; i<ncolors; ++i) {
+      TColor *col = gROOT->GetColor(gStyle->GetColorPalette(i));
+      Float_t r = 1, g = 1, b = 1;
+      if (col) col->GetRGB(r, g, b);
+      argbPalette[i] = 0xff000000 | (UInt_t(r*255) << 16) | (UInt_t(g*255) << 8) | UInt_t(b*255);
+      key.push_back(argbPalette[i]);
+   }
+   key.insert(key.end(), colorRegion.begin(), colorRegion.end());
+
+   if (!fColorLevelsImage || key != fColorLevelsKey) {
+      std::vector<UInt_t> pixels(nXPixels*nYPixels, 0xffffffff);
+      k = 0;
+      for (auto& yRegion : yRegions) {
+         for (auto& xRegion : xRegions) {
+            const UInt_t argb = argbPalette[colorRegion[k++]];
+            const auto& xPixelRange = xRegion.fPixelRange;
+            const auto& yPixelRange = yRegion.fPixelRange;
+            for (Int_t yPx = yPixelRange.first; yPx <= yPixelRange.second; ++yPx) {
+               UInt_t *row = pixels.data() + yPx*nXPixels;
+               std::fill(row + xPixelRange.first, row + xPixelRange.second + 1, argb);
+            }
+         }
+      }
+      delete fColorLevelsImage;
+      fColorLevelsImage = TImage::Create();
+      if (!fColorLevelsImage) {
+         fH->SetMinimum(originalZMin);
+         fH->SetMaximum(originalZMax);
+         return;
+      }
+      std::vector<Double_t> blank(nXPixels*nYPixels, 0);
+      fColorLevelsImage->SetImage(blank.data(), nXPixels, nYPixels);
+      // DrawCellArray fills the image from its bottom row
+      std::vector<UInt_t> cells(pixels.size());
+      for (Int_t yPx = 0; yPx < nYPixels; ++yPx) {
+         std::copy(pixels.begin() + yPx*nXPixels, pixels.begin() + (yPx+1)*nXPixels,
+                   cells.begin() + (nYPixels-1-yPx)*nXPixels);
+      }
+      fColorLevelsImage->DrawCellArray(0, nYPixels, nXPixels, 0, nXPixels, nYPixels, cells.data());
+      fColorLevelsKey = std::move(key);
+   }
+
+   // Paint the image in the window and in the output file, if any
+   if (!gPad->IsBatch()) {
+      Window_t wid = static_cast<Window_t>(gVirtualX->GetWindowID(gPad->GetPixmapID()));
+      fColorLevelsImage->PaintImage(wid, px0, py1, 0, 0, nXPixels, nYPixels);
+   }
+   if (gVirtualPS && gVirtualPS->InheritsFrom("TImageDump")) {
+      TImage *dump = (TImage *)gVirtualPS->GetStream();
+      if (dump) dump->Merge(fColorLevelsImage, "alphablend", gPad->XtoAbsPixel(pFrame->GetX1()),
+                            gPad->YtoAbsPixel(pFrame->GetY2()));
+   } else if (gVirtualPS) {
+      // PostScript cell array, from the top left pixel
+      const UInt_t *argb = fColorLevelsImage->GetArgbArray();
+      if (argb) {
+         Double_t xc = (pFrame->GetX2()-pFrame->GetX1())/nXPixels;
+         Double_t yc = (pFrame->GetY2()-pFrame->GetY1())/nYPixels;
+         gVirtualPS->CellArrayBegin(nXPixels, nYPixels, pFrame->GetX1(), pFrame->GetX1()+xc,
+                                    pFrame->GetY2(), pFrame->GetY2()+yc);
+         for (Int_t i = 0; i < nXPixels*nYPixels; ++i) {
+            gVirtualPS->CellArrayFill((argb[i] >> 16) & 0xff, (argb[i] >> 8) & 0xff, argb[i] & 0xff);
+         }
+         gVirtualPS->CellArrayEnd();
+      }
+   }
 
    if (Hoption.Zscale) PaintPalette();
 
@@ -0,0 +1,27 @@
+#include "gtest/gtest.h"
+
+#include "TCanvas.h"
+#include "TH2F.h"
+#include "TImage.h"
+#include "TImageDump.h"
+#include "TROOT.h"
+
+// An empty TH2 has zmin = zmax = 0: COL2 maps all its regions to the first
+// color instead of computing indices from an infinite scale.
+TEST(THistPainter, EmptyCOL2InImageDump)
+{
+   gROOT->SetBatch(kTRUE);
+   TCanvas c("c", "c", 400, 300);
+   TH2F h("h", "h", 50, 0., 1., 40, 0., 1.);
+   h.SetDirectory(nullptr);
+   h.SetStats(kFALSE);
+   h.Draw("COL2");
+
+   // 114: the image is kept in memory, not written
+   TImageDump dump("empty_col2.png", 114);
+   dump.NewPage();
+   c.Paint();
+   TImage *image = static_cast<TImage *>(dump.GetStream());
+   ASSERT_NE(nullptr, image);
+   EXPECT_TRUE(image->IsValid());
+}
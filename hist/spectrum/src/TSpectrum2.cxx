@@ -44,6 +44,10 @@
 #include "TList.h"
 #include "TH1.h"
 #include "TMath.h"
+#include "TSpectrumRows.h"
+
+#include <vector>
+
 #define PEAK_WINDOW 1024
 
 Int_t TSpectrum2::fgIterations    = 3;
@@ -487,8 +491,7 @@ const char *TSpectrum2::Background(Double_t **spectrum,
                        Int_t direction,
                        Int_t filterType)
 {
-   Int_t i, x, y, sampling, r1, r2;
-   Double_t a, b, p1, p2, p3, p4, s1, s2, s3, s4;
+   Int_t i, j, x, y, sampling, r1, r2;
    if (ssizex <= 0 || ssizey <= 0)
       return "Wrong parameters";
    if (numberIterationsX < 1 || numberIterationsY < 1)
@@ -496,158 +499,75 @@ const char *TSpectrum2::Background(Double_t **spectrum,
    if (ssizex < 2 * numberIterationsX + 1
         || ssizey < 2 * numberIterationsY + 1)
       return ("Too Large Clipping Window");
+   if ((direction != kBackIncreasingWindow && direction != kBackDecreasingWindow)
+        || (filterType != kBackSuccessiveFiltering && filterType != kBackOneStepFiltering))
+      return 0;
    Double_t **working_space = new Double_t*[ssizex];
    for (i = 0; i < ssizex; i++)
       working_space[i] = new Double_t[ssizey];
    sampling =
        (Int_t) TMath::Max(numberIterationsX, numberIterationsY);
-   if (direction == kBackIncreasingWindow) {
-      if (filterType == kBackSuccessiveFiltering) {
-         for (i = 1; i <= sampling; i++) {
-            r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
-                (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  a = spectrum[x][y];
-                  p1 = spectrum[x - r1][y - r2];
-                  p2 = spectrum[x - r1][y + r2];
-                  p3 = spectrum[x + r1][y - r2];
-                  p4 = spectrum[x + r1][y + r2];
-                  s1 = spectrum[x][y - r2];
-                  s2 = spectrum[x - r1][y];
-                  s3 = spectrum[x + r1][y];
-                  s4 = spectrum[x][y + r2];
-                  b = (p1 + p2) / 2.0;
-                  if (b > s2)
-                     s2 = b;
-                  b = (p1 + p3) / 2.0;
-                  if (b > s1)
-                     s1 = b;
-                  b = (p2 + p4) / 2.0;
-                  if (b > s4)
-                     s4 = b;
-                  b = (p3 + p4) / 2.0;
-                  if (b > s3)
-                     s3 = b;
-                  s1 = s1 - (p1 + p3) / 2.0;
-                  s2 = s2 - (p1 + p2) / 2.0;
-                  s3 = s3 - (p3 + p4) / 2.0;
-                  s4 = s4 - (p2 + p4) / 2.0;
-                  b = (s1 + s4) / 2.0 + (s2 + s3) / 2.0 + (p1 + p2 +
-                                                            p3 +
-                                                            p4) / 4.0;
-                  if (b < a && b > 0)
-                     a = b;
-                  working_space[x][y] = a;
-               }
-            }
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  spectrum[x][y] = working_space[x][y];
-               }
-            }
-         }
-      }
-
-      else if (filterType == kBackOneStepFiltering) {
-         for (i = 1; i <= sampling; i++) {
-            r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
-                (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  a = spectrum[x][y];
-                  b = -(spectrum[x - r1][y - r2] +
-                         spectrum[x - r1][y + r2] + spectrum[x + r1][y -
-                                                                     r2]
-                         + spectrum[x + r1][y + r2]) / 4 +
-                      (spectrum[x][y - r2] + spectrum[x - r1][y] +
-                       spectrum[x + r1][y] + spectrum[x][y + r2]) / 2;
-                  if (b < a && b > 0)
-                     a = b;
-                  working_space[x][y] = a;
-               }
-            }
-            for (y = i; y < ssizey - i; y++) {
-               for (x = i; x < ssizex - i; x++) {
-                  spectrum[x][y] = working_space[x][y];
-               }
-            }
-         }
-      }
-   }
-
-   else if (direction == kBackDecreasingWindow) {
-      if (filterType == kBackSuccessiveFiltering) {
-         for (i = sampling; i >= 1; i--) {
-            r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
-                (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  a = spectrum[x][y];
-                  p1 = spectrum[x - r1][y - r2];
-                  p2 = spectrum[x - r1][y + r2];
-                  p3 = spectrum[x + r1][y - r2];
-                  p4 = spectrum[x + r1][y + r2];
-                  s1 = spectrum[x][y - r2];
-                  s2 = spectrum[x - r1][y];
-                  s3 = spectrum[x + r1][y];
-                  s4 = spectrum[x][y + r2];
-                  b = (p1 + p2) / 2.0;
-                  if (b > s2)
-                     s2 = b;
-                  b = (p1 + p3) / 2.0;
-                  if (b > s1)
-                     s1 = b;
-                  b = (p2 + p4) / 2.0;
-                  if (b > s4)
-                     s4 = b;
-                  b = (p3 + p4) / 2.0;
-                  if (b > s3)
-                     s3 = b;
-                  s1 = s1 - (p1 + p3) / 2.0;
-                  s2 = s2 - (p1 + p2) / 2.0;
-                  s3 = s3 - (p3 + p4) / 2.0;
-                  s4 = s4 - (p2 + p4) / 2.0;
-                  b = (s1 + s4) / 2.0 + (s2 + s3) / 2.0 + (p1 + p2 +
-                                                            p3 +
-                                                            p4) / 4.0;
-                  if (b < a && b > 0)
-                     a = b;
-                  working_space[x][y] = a;
-               }
-            }
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  spectrum[x][y] = working_space[x][y];
-               }
-            }
-         }
-      }
-
-      else if (filterType == kBackOneStepFiltering) {
-         for (i = sampling; i >= 1; i--) {
-            r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
-                (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  a = spectrum[x][y];
-                  b = -(spectrum[x - r1][y - r2] +
-                         spectrum[x - r1][y + r2] + spectrum[x + r1][y -
-                                                                     r2]
-                         + spectrum[x + r1][y + r2]) / 4 +
-                      (spectrum[x][y - r2] + spectrum[x - r1][y] +
-                       spectrum[x + r1][y] + spectrum[x][y + r2]) / 2;
-                  if (b < a && b > 0)
-                     a = b;
-                  working_space[x][y] = a;
-               }
+   for (j = 1; j <= sampling; j++) {
+      i = direction == kBackIncreasingWindow ? j : sampling + 1 - j;
+      r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
+          (Int_t) TMath::Min(i, numberIterationsY);
+      // The row x of working_space only depends on the rows x - r1, x and
+      // x + r1 of spectrum: the rows are filtered independently, along y
+      // which is contiguous in memory.
+      ROOT::Internal::SpectrumForEachRow(r1, ssizex - r1, ssizey, [&](Int_t xx) {
+         const Double_t *sl = spectrum[xx - r1], *sc = spectrum[xx], *sr = spectrum[xx + r1];
+         Double_t *w = working_space[xx];
+         Double_t a, b, p1, p2, p3, p4, s1, s2, s3, s4;
+         if (filterType == kBackSuccessiveFiltering) {
+            for (Int_t yy = r2; yy < ssizey - r2; yy++) {
+               a = sc[yy];
+               p1 = sl[yy - r2];
+               p2 = sl[yy + r2];
+               p3 = sr[yy - r2];
+               p4 = sr[yy + r2];
+               s1 = sc[yy - r2];
+               s2 = sl[yy];
+               s3 = sr[yy];
+               s4 = sc[yy + r2];
+               b = (p1 + p2) / 2.0;
+               if (b > s2)
+                  s2 = b;
+               b = (p1 + p3) / 2.0;
+               if (b > s1)
+                  s1 = b;
+               b = (p2 + p4) / 2.0;
+               if (b > s4)
+                  s4 = b;
+               b = (p3 + p4) / 2.0;
+               if (b > s3)
+                  s3 = b;
+               s1 = s1 - (p1 + p3) / 2.0;
+               s2 = s2 - (p1 + p2) / 2.0;
+               s3 = s3 - (p3 + p4) / 2.0;
+               s4 = s4 - (p2 + p4) / 2.0;
+               b = (s1 + s4) / 2.0 + (s2 + s3) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
+               if (b < a && b > 0)
+                  a = b;
+               w[yy] = a;
             }
-            for (y = i; y < ssizey - i; y++) {
-               for (x = i; x < ssizex - i; x++) {
-                  spectrum[x][y] = working_space[x][y];
-               }
+         } else {
+            for (Int_t yy = r2; yy < ssizey - r2; yy++) {
+               a = sc[yy];
+               b = -(sl[yy - r2] + sl[yy + r2] + sr[yy - r2] + sr[yy + r2]) / 4 +
+                   (sc[yy - r2] + sl[yy] + sr[yy] + sc[yy + r2]) / 2;
+               if (b < a && b > 0)
+                  a = b;
+               w[yy] = a;
             }
          }
+      });
+      // the one step filtering copies back the cells at least i away from
+      // the edges
+      if (filterType == kBackOneStepFiltering)
+         r1 = i, r2 = i;
+      for (x = r1; x < ssizex - r1; x++) {
+         for (y = r2; y < ssizey - r2; y++)
+            spectrum[x][y] = working_space[x][y];
       }
    }
    for (i = 0; i < ssizex; i++)
@@ -1599,7 +1519,6 @@ Int_t TSpectrum2::SearchHighRes(Double_t **source, Double_t **dest, Int_t ssizex
    Int_t ymin, ymax, i, j;
    Double_t a, b, ax, ay, maxch, plocha = 0;
    Double_t nom, nip, nim, sp, sm, spx, spy, smx, smy;
-   Double_t p1, p2, p3, p4, s1, s2, s3, s4;
    Int_t x, y;
    Int_t lhx, lhy, i1, i2, j1, j2, k1, k2, i1min, i1max, i2min, i2max, j1min, j1max, j2min, j2max, positx, posity;
    if (sigma < 1) {
@@ -1675,41 +1594,47 @@ Int_t TSpectrum2::SearchHighRes(Double_t **source, Double_t **dest, Int_t ssizex
    }
    if(backgroundRemove == true){
       for(i = 1; i <= number_of_iterations; i++){
-         for(y = i; y < ssizey_ext - i; y++){
-            for(x = i; x < ssizex_ext - i; x++){
-               a = working_space[x][y + ssizey_ext];
-               p1 = working_space[x - i][y + ssizey_ext - i];
-               p2 = working_space[x - i][y + ssizey_ext + i];
-               p3 = working_space[x + i][y + ssizey_ext - i];
-               p4 = working_space[x + i][y + ssizey_ext + i];
-               s1 = working_space[x][y + ssizey_ext - i];
-               s2 = working_space[x - i][y + ssizey_ext];
-               s3 = working_space[x + i][y + ssizey_ext];
-               s4 = working_space[x][y + ssizey_ext + i];
-               b = (p1 + p2) / 2.0;
-               if(b > s2)
-                  s2 = b;
-               b = (p1 + p3) / 2.0;
-               if(b > s1)
-                  s1 = b;
-               b = (p2 + p4) / 2.0;
-               if(b > s4)
-                  s4 = b;
-               b = (p3 + p4) / 2.0;
-               if(b > s3)
-                  s3 = b;
+         // the filtered rows go in the first ssizey_ext cells of the rows,
+         // which are not read by the filter
+         ROOT::Internal::SpectrumForEachRow(i, ssizex_ext - i, ssizey_ext, [&](Int_t xx) {
+            const Double_t *sl = working_space[xx - i] + ssizey_ext, *sc = working_space[xx] + ssizey_ext,
+                           *sr = working_space[xx + i] + ssizey_ext;
+            Double_t *w = working_space[xx];
+            Double_t aa, bb, p1, p2, p3, p4, s1, s2, s3, s4;
+            for(Int_t yy = i; yy < ssizey_ext - i; yy++){
+               aa = sc[yy];
+               p1 = sl[yy - i];
+               p2 = sl[yy + i];
+               p3 = sr[yy - i];
+               p4 = sr[yy + i];
+               s1 = sc[yy - i];
+               s2 = sl[yy];
+               s3 = sr[yy];
+               s4 = sc[yy + i];
+               bb = (p1 + p2) / 2.0;
+               if(bb > s2)
+                  s2 = bb;
+               bb = (p1 + p3) / 2.0;
+               if(bb > s1)
+                  s1 = bb;
+               bb = (p2 + p4) / 2.0;
+               if(bb > s4)
+                  s4 = bb;
+               bb = (p3 + p4) / 2.0;
+               if(bb > s3)
+                  s3 = bb;
                s1 = s1 - (p1 + p3) / 2.0;
                s2 = s2 - (p1 + p2) / 2.0;
                s3 = s3 - (p3 + p4) / 2.0;
                s4 = s4 - (p2 + p4) / 2.0;
-               b = (s1 + s4) / 2.0 + (s2 + s3) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
-               if(b < a)
-                  a = b;
-               working_space[x][y] = a;
+               bb = (s1 + s4) / 2.0 + (s2 + s3) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
+               if(bb < aa)
+                  aa = bb;
+               w[yy] = aa;
             }
-         }
-         for(y = i;y < ssizey_ext - i; y++){
-            for(x = i; x < ssizex_ext - i; x++){
+         });
+         for(x = i; x < ssizex_ext - i; x++){
+            for(y = i;y < ssizey_ext - i; y++){
                working_space[x][y + ssizey_ext] = working_space[x][y];
             }
          }
@@ -2059,54 +1984,42 @@ Int_t TSpectrum2::SearchHighRes(Double_t **source, Double_t **dest, Int_t ssizex
          working_space[i1][i2 + 2 * ssizey_ext] = 0;
       }
    }
+   //rows of the matrix b, indexed by j1 + lhx - 1
+   std::vector<const Double_t *> bRows(2 * lhx - 1);
+   for(j1 = 1 - lhx; j1 <= lhx - 1; j1++){
+      k = (j1 + ssizex_ext) / ssizex_ext;
+      bRows[j1 + lhx - 1] = working_space[(j1 + ssizex_ext) % ssizex_ext] + ssizey_ext + 10 * ssizey_ext + k * 2 * ssizey_ext;
+   }
    //START OF ITERATIONS
    for(lindex = 0; lindex < deconIterations; lindex++){
-      for(i2 = 0; i2 < ssizey_ext; i2++){
-         for(i1 = 0; i1 < ssizex_ext; i1++){
-            lda = working_space[i1][i2 + ssizey_ext];
-            ldc = working_space[i1][i2 + 14 * ssizey_ext];
-            if(lda > 0.000001 && ldc > 0.000001){
-               ldb=0;
-               j2min=i2;
-               if(j2min > lhy - 1)
-                  j2min = lhy - 1;
-
-               j2min = -j2min;
-               j2max = ssizey_ext - i2 - 1;
-               if(j2max > lhy - 1)
-                  j2max = lhy - 1;
-
-               j1min = i1;
-               if(j1min > lhx - 1)
-                  j1min = lhx - 1;
-
-               j1min = -j1min;
-               j1max = ssizex_ext - i1 - 1;
-               if(j1max > lhx - 1)
-                  j1max = lhx - 1;
-
-               for(j2 = j2min; j2 <= j2max; j2++){
-                  for(j1 = j1min; j1 <= j1max; j1++){
-                     k = (j1 + ssizex_ext) / ssizex_ext;
-                     ldc = working_space[(j1 + ssizex_ext) % ssizex_ext][j2 + ssizey_ext + 10 * ssizey_ext + k * 2 * ssizey_ext];
-                     lda = working_space[i1 + j1][i2 + j2 + ssizey_ext];
-                     ldb = ldb + lda * ldc;
-                  }
+      //the new x1 of the row i1 goes in its cells 2 * ssizey_ext, only the
+      //cells ssizey_ext of x1 are read
+      ROOT::Internal::SpectrumForEachRow(0, ssizex_ext, Long64_t(ssizey_ext) * lhx * lhy, [&](Int_t ii1) {
+         const Double_t *x1 = working_space[ii1] + ssizey_ext;
+         const Double_t *p = working_space[ii1] + 14 * ssizey_ext;
+         Double_t *x2 = working_space[ii1] + 2 * ssizey_ext;
+         const Int_t jj1min = -TMath::Min(ii1, lhx - 1);
+         const Int_t jj1max = TMath::Min(ssizex_ext - ii1 - 1, lhx - 1);
+         for(Int_t ii2 = 0; ii2 < ssizey_ext; ii2++){
+            Double_t xa = x1[ii2], pc = p[ii2];
+            if(xa > 0.000001 && pc > 0.000001){
+               const Int_t jj2min = -TMath::Min(ii2, lhy - 1);
+               const Int_t jj2max = TMath::Min(ssizey_ext - ii2 - 1, lhy - 1);
+               Double_t sum = 0;
+               for(Int_t jj2 = jj2min; jj2 <= jj2max; jj2++){
+                  for(Int_t jj1 = jj1min; jj1 <= jj1max; jj1++)
+                     sum = sum + working_space[ii1 + jj1][ii2 + jj2 + ssizey_ext] * bRows[jj1 + lhx - 1][jj2];
                }
-               lda = working_space[i1][i2 + ssizey_ext];
-               ldc = working_space[i1][i2 + 14 * ssizey_ext];
-               if(ldc * lda != 0 && ldb != 0){
-                  lda =lda * ldc / ldb;
-               }
-
+               if(pc * xa != 0 && sum != 0)
+                  xa = xa * pc / sum;
                else
-                  lda=0;
-               working_space[i1][i2 + 2 * ssizey_ext] = lda;
+                  xa = 0;
+               x2[ii2] = xa;
             }
          }
-      }
-      for(i2 = 0; i2 < ssizey_ext; i2++){
-         for(i1 = 0; i1 < ssizex_ext; i1++)
+      });
+      for(i1 = 0; i1 < ssizex_ext; i1++){
+         for(i2 = 0; i2 < ssizey_ext; i2++)
             working_space[i1][i2 + ssizey_ext] = working_space[i1][i2 + 2 * ssizey_ext];
       }
    }
@@ -48,10 +48,142 @@
 #include "TSpectrum3.h"
 #include "TH1.h"
 #include "TMath.h"
+#include "TSpectrumRows.h"
+
 #define PEAK_WINDOW 1024
 
 ClassImp(TSpectrum3);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Filter the cells z in [q3, ssizez - q3) of the line (x, y) of a cube with
+/// the SNIP algorithm, the first letter of the names of the lines of the
+/// neighbours being the position in x (l: x - q1, c: x, h: x + q1), the second
+/// one the position in y.
+
+void BackgroundLine(const Double_t *ll, const Double_t *lc, const Double_t *lh, const Double_t *cl, const Double_t *cc,
+                    const Double_t *ch, const Double_t *hl, const Double_t *hc, const Double_t *hh, Int_t ssizez,
+                    Int_t q3, Bool_t successive, Double_t *w)
+{
+   Double_t a, b, c, d, p1, p2, p3, p4, p5, p6, p7, p8, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, r1, r2, r3, r4, r5, r6;
+   for (Int_t z = q3; z < ssizez - q3; z++) {
+      a = cc[z];
+      p1 = hh[z - q3];
+      p2 = lh[z - q3];
+      p3 = hl[z - q3];
+      p4 = ll[z - q3];
+      p5 = hh[z + q3];
+      p6 = lh[z + q3];
+      p7 = hl[z + q3];
+      p8 = ll[z + q3];
+      s1 = hc[z - q3];
+      s2 = ch[z - q3];
+      s3 = lc[z - q3];
+      s4 = cl[z - q3];
+      s5 = hc[z + q3];
+      s6 = ch[z + q3];
+      s7 = lc[z + q3];
+      s8 = cl[z + q3];
+      s9 = lh[z];
+      s10 = ll[z];
+      s11 = hh[z];
+      s12 = hl[z];
+      r1 = cc[z - q3];
+      r2 = cc[z + q3];
+      r3 = lc[z];
+      r4 = hc[z];
+      r5 = ch[z];
+      r6 = cl[z];
+      if (successive) {
+         b = (p1 + p3) / 2.0;
+         if(b > s1)
+            s1 = b;
+         b = (p1 + p2) / 2.0;
+         if(b > s2)
+            s2 = b;
+         b = (p2 + p4) / 2.0;
+         if(b > s3)
+            s3 = b;
+         b = (p3 + p4) / 2.0;
+         if(b > s4)
+            s4 = b;
+         b = (p5 + p7) / 2.0;
+         if(b > s5)
+            s5 = b;
+         b = (p5 + p6) / 2.0;
+         if(b > s6)
+            s6 = b;
+         b = (p6 + p8) / 2.0;
+         if(b > s7)
+            s7 = b;
+         b = (p7 + p8) / 2.0;
+         if(b > s8)
+            s8 = b;
+         b = (p2 + p6) / 2.0;
+         if(b > s9)
+            s9 = b;
+         b = (p4 + p8) / 2.0;
+         if(b > s10)
+            s10 = b;
+         b = (p1 + p5) / 2.0;
+         if(b > s11)
+            s11 = b;
+         b = (p3 + p7) / 2.0;
+         if(b > s12)
+            s12 = b;
+         s1 = s1 - (p1 + p3) / 2.0;
+         s2 = s2 - (p1 + p2) / 2.0;
+         s3 = s3 - (p2 + p4) / 2.0;
+         s4 = s4 - (p3 + p4) / 2.0;
+         s5 = s5 - (p5 + p7) / 2.0;
+         s6 = s6 - (p5 + p6) / 2.0;
+         s7 = s7 - (p6 + p8) / 2.0;
+         s8 = s8 - (p7 + p8) / 2.0;
+         s9 = s9 - (p2 + p6) / 2.0;
+         s10 = s10 - (p4 + p8) / 2.0;
+         s11 = s11 - (p1 + p5) / 2.0;
+         s12 = s12 - (p3 + p7) / 2.0;
+         b = (s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
+         if(b > r1)
+            r1 = b;
+         b = (s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0;
+         if(b > r2)
+            r2 = b;
+         b = (s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0;
+         if(b > r3)
+            r3 = b;
+         b = (s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0;
+         if(b > r4)
+            r4 = b;
+         b = (s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0;
+         if(b > r5)
+            r5 = b;
+         b = (s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0;
+         if(b > r6)
+            r6 = b;
+         r1 = r1 - ((s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0);
+         r2 = r2 - ((s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0);
+         r3 = r3 - ((s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0);
+         r4 = r4 - ((s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0);
+         r5 = r5 - ((s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0);
+         r6 = r6 - ((s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0);
+         b = (r1 + r2) / 2.0 + (r3 + r4) / 2.0 + (r5 + r6) / 2.0 + (s1 + s3 + s5 + s7) / 4.0 + (s2 + s4 + s6 + s8) / 4.0 + (s9 + s10 + s11 + s12) / 4.0 + (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8.0;
+         if(b < a)
+            a = b;
+      } else {
+         b = (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 - (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
+         c = -(s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
+         d = -(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 + (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 12;
+         if(b < a && b >= 0 && c >=0 && d >= 0)
+            a = b;
+      }
+      w[z] = a;
+   }
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor.
 
@@ -390,13 +522,15 @@ const char *TSpectrum3::Background(Double_t***spectrum,
                        Int_t filterType)
 {
    Int_t i, j, x, y, z, sampling, q1, q2, q3;
-   Double_t a, b, c, d, p1, p2, p3, p4, p5, p6, p7, p8, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, r1, r2, r3, r4, r5, r6;
    if (ssizex <= 0 || ssizey <= 0 || ssizez <= 0)
       return "Wrong parameters";
    if (numberIterationsX < 1 || numberIterationsY < 1 || numberIterationsZ < 1)
       return "Width of Clipping Window Must Be Positive";
    if (ssizex < 2 * numberIterationsX + 1 || ssizey < 2 * numberIterationsY + 1 || ssizey < 2 * numberIterationsZ + 1)
       return ("Too Large Clipping Window");
+   if ((direction != kBackIncreasingWindow && direction != kBackDecreasingWindow)
+       || (filterType != kBackSuccessiveFiltering && filterType != kBackOneStepFiltering))
+      return 0;
    Double_t*** working_space=new Double_t**[ssizex];
    for(i=0;i<ssizex;i++){
       working_space[i] =new Double_t*[ssizey];
@@ -405,353 +539,22 @@ const char *TSpectrum3::Background(Double_t***spectrum,
    }
    sampling =(Int_t) TMath::Max(numberIterationsX, numberIterationsY);
    sampling =(Int_t) TMath::Max(sampling, numberIterationsZ);
-   if (direction == kBackIncreasingWindow) {
-      if (filterType == kBackSuccessiveFiltering) {
-         for (i = 1; i <= sampling; i++) {
-            q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     a = spectrum[x][y][z];
-                     p1 = spectrum[x + q1][y + q2][z - q3];
-                     p2 = spectrum[x - q1][y + q2][z - q3];
-                     p3 = spectrum[x + q1][y - q2][z - q3];
-                     p4 = spectrum[x - q1][y - q2][z - q3];
-                     p5 = spectrum[x + q1][y + q2][z + q3];
-                     p6 = spectrum[x - q1][y + q2][z + q3];
-                     p7 = spectrum[x + q1][y - q2][z + q3];
-                     p8 = spectrum[x - q1][y - q2][z + q3];
-                     s1 = spectrum[x + q1][y     ][z - q3];
-                     s2 = spectrum[x     ][y + q2][z - q3];
-                     s3 = spectrum[x - q1][y     ][z - q3];
-                     s4 = spectrum[x     ][y - q2][z - q3];
-                     s5 = spectrum[x + q1][y     ][z + q3];
-                     s6 = spectrum[x     ][y + q2][z + q3];
-                     s7 = spectrum[x - q1][y     ][z + q3];
-                     s8 = spectrum[x     ][y - q2][z + q3];
-                     s9 = spectrum[x - q1][y + q2][z     ];
-                     s10 = spectrum[x - q1][y - q2][z     ];
-                     s11 = spectrum[x + q1][y + q2][z     ];
-                     s12 = spectrum[x + q1][y - q2][z     ];
-                     r1 = spectrum[x     ][y     ][z - q3];
-                     r2 = spectrum[x     ][y     ][z + q3];
-                     r3 = spectrum[x - q1][y     ][z     ];
-                     r4 = spectrum[x + q1][y     ][z     ];
-                     r5 = spectrum[x     ][y + q2][z     ];
-                     r6 = spectrum[x     ][y - q2][z     ];
-                     b = (p1 + p3) / 2.0;
-                     if(b > s1)
-                        s1 = b;
-                     b = (p1 + p2) / 2.0;
-                     if(b > s2)
-                        s2 = b;
-                     b = (p2 + p4) / 2.0;
-                     if(b > s3)
-                        s3 = b;
-                     b = (p3 + p4) / 2.0;
-                     if(b > s4)
-                        s4 = b;
-                     b = (p5 + p7) / 2.0;
-                     if(b > s5)
-                        s5 = b;
-                     b = (p5 + p6) / 2.0;
-                     if(b > s6)
-                        s6 = b;
-                     b = (p6 + p8) / 2.0;
-                     if(b > s7)
-                        s7 = b;
-                     b = (p7 + p8) / 2.0;
-                     if(b > s8)
-                        s8 = b;
-                     b = (p2 + p6) / 2.0;
-                     if(b > s9)
-                        s9 = b;
-                     b = (p4 + p8) / 2.0;
-                     if(b > s10)
-                        s10 = b;
-                     b = (p1 + p5) / 2.0;
-                     if(b > s11)
-                        s11 = b;
-                     b = (p3 + p7) / 2.0;
-                     if(b > s12)
-                        s12 = b;
-                     s1 = s1 - (p1 + p3) / 2.0;
-                     s2 = s2 - (p1 + p2) / 2.0;
-                     s3 = s3 - (p2 + p4) / 2.0;
-                     s4 = s4 - (p3 + p4) / 2.0;
-                     s5 = s5 - (p5 + p7) / 2.0;
-                     s6 = s6 - (p5 + p6) / 2.0;
-                     s7 = s7 - (p6 + p8) / 2.0;
-                     s8 = s8 - (p7 + p8) / 2.0;
-                     s9 = s9 - (p2 + p6) / 2.0;
-                     s10 = s10 - (p4 + p8) / 2.0;
-                     s11 = s11 - (p1 + p5) / 2.0;
-                     s12 = s12 - (p3 + p7) / 2.0;
-                     b = (s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
-                     if(b > r1)
-                        r1 = b;
-                     b = (s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0;
-                     if(b > r2)
-                        r2 = b;
-                     b = (s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0;
-                     if(b > r3)
-                        r3 = b;
-                     b = (s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0;
-                     if(b > r4)
-                        r4 = b;
-                     b = (s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0;
-                     if(b > r5)
-                        r5 = b;
-                     b = (s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0;
-                     if(b > r6)
-                        r6 = b;
-                     r1 = r1 - ((s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0);
-                     r2 = r2 - ((s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0);
-                     r3 = r3 - ((s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0);
-                     r4 = r4 - ((s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0);
-                     r5 = r5 - ((s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0);
-                     r6 = r6 - ((s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0);
-                     b = (r1 + r2) / 2.0 + (r3 + r4) / 2.0 + (r5 + r6) / 2.0 + (s1 + s3 + s5 + s7) / 4.0 + (s2 + s4 + s6 + s8) / 4.0 + (s9 + s10 + s11 + s12) / 4.0 + (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8.0;
-                     if(b < a)
-                        a = b;
-                     working_space[x][y][z] = a;
-                  }
-               }
-            }
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     spectrum[x][y][z] = working_space[x][y][z];
-                  }
-               }
-            }
-         }
-      }
-
-      else if (filterType == kBackOneStepFiltering) {
-         for (i = 1; i <= sampling; i++) {
-            q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     a = spectrum[x][y][z];
-                     p1 = spectrum[x + q1][y + q2][z - q3];
-                     p2 = spectrum[x - q1][y + q2][z - q3];
-                     p3 = spectrum[x + q1][y - q2][z - q3];
-                     p4 = spectrum[x - q1][y - q2][z - q3];
-                     p5 = spectrum[x + q1][y + q2][z + q3];
-                     p6 = spectrum[x - q1][y + q2][z + q3];
-                     p7 = spectrum[x + q1][y - q2][z + q3];
-                     p8 = spectrum[x - q1][y - q2][z + q3];
-                     s1 = spectrum[x + q1][y     ][z - q3];
-                     s2 = spectrum[x     ][y + q2][z - q3];
-                     s3 = spectrum[x - q1][y     ][z - q3];
-                     s4 = spectrum[x     ][y - q2][z - q3];
-                     s5 = spectrum[x + q1][y     ][z + q3];
-                     s6 = spectrum[x     ][y + q2][z + q3];
-                     s7 = spectrum[x - q1][y     ][z + q3];
-                     s8 = spectrum[x     ][y - q2][z + q3];
-                     s9 = spectrum[x - q1][y + q2][z     ];
-                     s10 = spectrum[x - q1][y - q2][z     ];
-                     s11 = spectrum[x + q1][y + q2][z     ];
-                     s12 = spectrum[x + q1][y - q2][z     ];
-                     r1 = spectrum[x     ][y     ][z - q3];
-                     r2 = spectrum[x     ][y     ][z + q3];
-                     r3 = spectrum[x - q1][y     ][z     ];
-                     r4 = spectrum[x + q1][y     ][z     ];
-                     r5 = spectrum[x     ][y + q2][z     ];
-                     r6 = spectrum[x     ][y - q2][z     ];
-                     b=(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 - (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
-                     c = -(s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
-                     d = -(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 + (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 12;
-                     if(b < a && b >= 0 && c >=0 && d >= 0)
-                        a = b;
-                     working_space[x][y][z] = a;
-                  }
-               }
-            }
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     spectrum[x][y][z] = working_space[x][y][z];
-                  }
-               }
-            }
-         }
-      }
-   }
-
-   else if (direction == kBackDecreasingWindow) {
-      if (filterType == kBackSuccessiveFiltering) {
-         for (i = sampling; i >= 1; i--) {
-            q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     a = spectrum[x][y][z];
-                     p1 = spectrum[x + q1][y + q2][z - q3];
-                     p2 = spectrum[x - q1][y + q2][z - q3];
-                     p3 = spectrum[x + q1][y - q2][z - q3];
-                     p4 = spectrum[x - q1][y - q2][z - q3];
-                     p5 = spectrum[x + q1][y + q2][z + q3];
-                     p6 = spectrum[x - q1][y + q2][z + q3];
-                     p7 = spectrum[x + q1][y - q2][z + q3];
-                     p8 = spectrum[x - q1][y - q2][z + q3];
-                     s1 = spectrum[x + q1][y     ][z - q3];
-                     s2 = spectrum[x     ][y + q2][z - q3];
-                     s3 = spectrum[x - q1][y     ][z - q3];
-                     s4 = spectrum[x     ][y - q2][z - q3];
-                     s5 = spectrum[x + q1][y     ][z + q3];
-                     s6 = spectrum[x     ][y + q2][z + q3];
-                     s7 = spectrum[x - q1][y     ][z + q3];
-                     s8 = spectrum[x     ][y - q2][z + q3];
-                     s9 = spectrum[x - q1][y + q2][z     ];
-                     s10 = spectrum[x - q1][y - q2][z     ];
-                     s11 = spectrum[x + q1][y + q2][z     ];
-                     s12 = spectrum[x + q1][y - q2][z     ];
-                     r1 = spectrum[x     ][y     ][z - q3];
-                     r2 = spectrum[x     ][y     ][z + q3];
-                     r3 = spectrum[x - q1][y     ][z     ];
-                     r4 = spectrum[x + q1][y     ][z     ];
-                     r5 = spectrum[x     ][y + q2][z     ];
-                     r6 = spectrum[x     ][y - q2][z     ];
-                     b = (p1 + p3) / 2.0;
-                     if(b > s1)
-                        s1 = b;
-                     b = (p1 + p2) / 2.0;
-                     if(b > s2)
-                        s2 = b;
-                     b = (p2 + p4) / 2.0;
-                     if(b > s3)
-                        s3 = b;
-                     b = (p3 + p4) / 2.0;
-                     if(b > s4)
-                        s4 = b;
-                     b = (p5 + p7) / 2.0;
-                     if(b > s5)
-                        s5 = b;
-                     b = (p5 + p6) / 2.0;
-                     if(b > s6)
-                        s6 = b;
-                     b = (p6 + p8) / 2.0;
-                     if(b > s7)
-                        s7 = b;
-                     b = (p7 + p8) / 2.0;
-                     if(b > s8)
-                        s8 = b;
-                     b = (p2 + p6) / 2.0;
-                     if(b > s9)
-                        s9 = b;
-                     b = (p4 + p8) / 2.0;
-                     if(b > s10)
-                        s10 = b;
-                     b = (p1 + p5) / 2.0;
-                     if(b > s11)
-                        s11 = b;
-                     b = (p3 + p7) / 2.0;
-                     if(b > s12)
-                        s12 = b;
-                     s1 = s1 - (p1 + p3) / 2.0;
-                     s2 = s2 - (p1 + p2) / 2.0;
-                     s3 = s3 - (p2 + p4) / 2.0;
-                     s4 = s4 - (p3 + p4) / 2.0;
-                     s5 = s5 - (p5 + p7) / 2.0;
-                     s6 = s6 - (p5 + p6) / 2.0;
-                     s7 = s7 - (p6 + p8) / 2.0;
-                     s8 = s8 - (p7 + p8) / 2.0;
-                     s9 = s9 - (p2 + p6) / 2.0;
-                     s10 = s10 - (p4 + p8) / 2.0;
-                     s11 = s11 - (p1 + p5) / 2.0;
-                     s12 = s12 - (p3 + p7) / 2.0;
-                     b = (s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
-                     if(b > r1)
-                        r1 = b;
-                     b = (s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0;
-                     if(b > r2)
-                        r2 = b;
-                     b = (s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0;
-                     if(b > r3)
-                        r3 = b;
-                     b = (s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0;
-                     if(b > r4)
-                        r4 = b;
-                     b = (s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0;
-                     if(b > r5)
-                        r5 = b;
-                     b = (s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0;
-                     if(b > r6)
-                        r6 = b;
-                     r1 = r1 - ((s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0);
-                     r2 = r2 - ((s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0);
-                     r3 = r3 - ((s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0);
-                     r4 = r4 - ((s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0);
-                     r5 = r5 - ((s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0);
-                     r6 = r6 - ((s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0);
-                     b = (r1 + r2) / 2.0 + (r3 + r4) / 2.0 + (r5 + r6) / 2.0 + (s1 + s3 + s5 + s7) / 4.0 + (s2 + s4 + s6 + s8) / 4.0 + (s9 + s10 + s11 + s12) / 4.0 + (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8.0;
-                     if(b < a)
-                        a = b;
-                     working_space[x][y][z] = a;
-                  }
-               }
-            }
+   for (j = 1; j <= sampling; j++) {
+      i = direction == kBackIncreasingWindow ? j : sampling + 1 - j;
+      q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
+      // The plane x of working_space only depends on the planes x - q1, x and
+      // x + q1 of spectrum: the planes are filtered independently, line by
+      // line along z which is contiguous in memory.
+      ROOT::Internal::SpectrumForEachRow(q1, ssizex - q1, Long64_t(ssizey) * ssizez, [&](Int_t xx) {
+         Double_t **l = spectrum[xx - q1], **c = spectrum[xx], **h = spectrum[xx + q1];
+         for (Int_t yy = q2; yy < ssizey - q2; yy++)
+            BackgroundLine(l[yy - q2], l[yy], l[yy + q2], c[yy - q2], c[yy], c[yy + q2], h[yy - q2], h[yy], h[yy + q2],
+                           ssizez, q3, filterType == kBackSuccessiveFiltering, working_space[xx][yy]);
+      });
+      for (x = q1; x < ssizex - q1; x++) {
+         for (y = q2; y < ssizey - q2; y++) {
             for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     spectrum[x][y][z] = working_space[x][y][z];
-                  }
-               }
-            }
-         }
-      }
-
-      else if (filterType == kBackOneStepFiltering) {
-         for (i = sampling; i >= 1; i--) {
-            q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     a = spectrum[x][y][z];
-                     p1 = spectrum[x + q1][y + q2][z - q3];
-                     p2 = spectrum[x - q1][y + q2][z - q3];
-                     p3 = spectrum[x + q1][y - q2][z - q3];
-                     p4 = spectrum[x - q1][y - q2][z - q3];
-                     p5 = spectrum[x + q1][y + q2][z + q3];
-                     p6 = spectrum[x - q1][y + q2][z + q3];
-                     p7 = spectrum[x + q1][y - q2][z + q3];
-                     p8 = spectrum[x - q1][y - q2][z + q3];
-                     s1 = spectrum[x + q1][y     ][z - q3];
-                     s2 = spectrum[x     ][y + q2][z - q3];
-                     s3 = spectrum[x - q1][y     ][z - q3];
-                     s4 = spectrum[x     ][y - q2][z - q3];
-                     s5 = spectrum[x + q1][y     ][z + q3];
-                     s6 = spectrum[x     ][y + q2][z + q3];
-                     s7 = spectrum[x - q1][y     ][z + q3];
-                     s8 = spectrum[x     ][y - q2][z + q3];
-                     s9 = spectrum[x - q1][y + q2][z     ];
-                     s10 = spectrum[x - q1][y - q2][z     ];
-                     s11 = spectrum[x + q1][y + q2][z     ];
-                     s12 = spectrum[x + q1][y - q2][z     ];
-                     r1 = spectrum[x     ][y     ][z - q3];
-                     r2 = spectrum[x     ][y     ][z + q3];
-                     r3 = spectrum[x - q1][y     ][z     ];
-                     r4 = spectrum[x + q1][y     ][z     ];
-                     r5 = spectrum[x     ][y + q2][z     ];
-                     r6 = spectrum[x     ][y - q2][z     ];
-                     b = (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 - (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
-                     c = -(s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4+(r1 + r2 + r3 + r4 + r5 + r6) / 2;
-                     d = -(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8)/8 + (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 12;
-                     if(b < a && b >= 0 && c >=0 && d >= 0)
-                        a = b;
-                     working_space[x][y][z] = a;
-                  }
-               }
-            }
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     spectrum[x][y][z] = working_space[x][y][z];
-                  }
-               }
+               spectrum[x][y][z] = working_space[x][y][z];
             }
          }
       }
@@ -0,0 +1,41 @@
+// @(#)root/spectrum:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TSpectrumRows
+#define ROOT_TSpectrumRows
+
+#include "ROOT/THistParallel.hxx"
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call f(x) for every row x in [first, last) of the working spaces of
+/// TSpectrum2 and TSpectrum3, costPerRow being an estimate of the number of
+/// operations of f(x). The rows are split between threads as by
+/// HistForEachRange: f(x) must then only write the row x. Since every row is
+/// computed as in the sequential loop, the results do not depend on the
+/// number of threads.
+
+template <typename F>
+void SpectrumForEachRow(Int_t first, Int_t last, Long64_t costPerRow, F f)
+{
+   if (last <= first)
+      return;
+   HistForEachRange(last - first, costPerRow, [&](Int_t begin, Int_t end) {
+      for (Int_t x = first + begin; x < first + end; x++)
+         f(x);
+   });
+}
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
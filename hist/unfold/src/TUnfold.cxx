@@ -119,8 +119,11 @@ along with TUnfold.  If not, see <http://www.gnu.org/licenses/>.
 #include <TMatrixDSymEigen.h>
 #include <TMath.h>
 #include "TUnfold.h"
+#include "ROOT/THistParallel.hxx"
 
+#include <algorithm>
 #include <map>
+#include <mutex>
 #include <vector>
 
 //#define DEBUG
@@ -129,6 +132,134 @@ along with TUnfold.  If not, see <http://www.gnu.org/licenses/>.
 
 ClassImp(TUnfold);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// One row of a sparse matrix product being summed: only the columns which
+/// are touched are visited, so that the cost of a row does not depend on the
+/// number of columns.
+
+class TSparseRowSum {
+   std::vector<Double_t> fSum;
+   std::vector<char> fUsed;
+   std::vector<Int_t> fCols;
+
+public:
+   explicit TSparseRowSum(Int_t ncol) : fSum(ncol, 0.0), fUsed(ncol, 0) {}
+   void Add(Int_t col, Double_t x)
+   {
+      if (!fUsed[col]) {
+         fUsed[col] = 1;
+         fCols.push_back(col);
+      }
+      fSum[col] += x;
+   }
+   // append the non-zero elements to cols and data, sorted by column, and
+   // clear the row; returns the number of elements appended
+   Int_t Flush(std::vector<Int_t> &cols, std::vector<Double_t> &data)
+   {
+      std::sort(fCols.begin(), fCols.end());
+      Int_t n = 0;
+      for (Int_t col : fCols) {
+         if (fSum[col] != 0.0) {
+            cols.push_back(col);
+            data.push_back(fSum[col]);
+            n++;
+         }
+         fSum[col] = 0.0;
+         fUsed[col] = 0;
+      }
+      fCols.clear();
+      return n;
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new sparse matrix nrow*ncol, whose row i is computed by
+/// row(i,sum) adding its terms to sum. work is an estimate of the number of
+/// multiplications, used to decide whether the rows are computed in parallel.
+/// The matrix is filled directly in its compressed row format.
+
+template <typename F>
+TMatrixDSparse *ComputeSparseRows(Int_t nrow, Int_t ncol, Long64_t work, F row)
+{
+   TMatrixDSparse *r = new TMatrixDSparse(nrow, ncol);
+   if (nrow <= 0 || ncol <= 0)
+      return r;
+   struct TRange {
+      Int_t fFirst = 0;
+      std::vector<Int_t> fCols;
+      std::vector<Double_t> fData;
+   };
+   std::vector<Int_t> rowSize(nrow);
+   std::vector<TRange> ranges;
+   std::mutex rangesMutex;
+   ROOT::Internal::HistForEachRange(nrow, work / nrow, [&](Int_t first, Int_t last) {
+      TRange range;
+      range.fFirst = first;
+      TSparseRowSum sum(ncol);
+      for (Int_t irow = first; irow < last; irow++) {
+         row(irow, sum);
+         rowSize[irow] = sum.Flush(range.fCols, range.fData);
+      }
+      std::lock_guard<std::mutex> lock(rangesMutex);
+      ranges.push_back(std::move(range));
+   });
+   std::sort(ranges.begin(), ranges.end(), [](const TRange &a, const TRange &b) { return a.fFirst < b.fFirst; });
+   Int_t n = 0;
+   for (const TRange &range : ranges)
+      n += range.fData.size();
+   if (n > 0) {
+      r->SetSparseIndex(n);
+      Int_t *r_rows = r->GetRowIndexArray();
+      Int_t *r_cols = r->GetColIndexArray();
+      Double_t *r_data = r->GetMatrixArray();
+      r_rows[0] = 0;
+      for (Int_t irow = 0; irow < nrow; irow++)
+         r_rows[irow + 1] = r_rows[irow] + rowSize[irow];
+      for (const TRange &range : ranges) {
+         const Int_t offset = r_rows[range.fFirst];
+         std::copy(range.fCols.begin(), range.fCols.end(), r_cols + offset);
+         std::copy(range.fData.begin(), range.fData.end(), r_data + offset);
+      }
+   }
+   return r;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Transposed of a sparse matrix, in compressed row format. The elements of
+/// each row are sorted by column.
+
+struct TSparseTransposed {
+   std::vector<Int_t> fRows;
+   std::vector<Int_t> fCols;
+   std::vector<Double_t> fData;
+
+   explicit TSparseTransposed(const TMatrixDSparse *a) : fRows(a->GetNcols() + 1, 0)
+   {
+      const Int_t *a_rows = a->GetRowIndexArray();
+      const Int_t *a_cols = a->GetColIndexArray();
+      const Double_t *a_data = a->GetMatrixArray();
+      const Int_t n = a_rows[a->GetNrows()];
+      fCols.resize(n);
+      fData.resize(n);
+      for (Int_t i = 0; i < n; i++)
+         fRows[a_cols[i] + 1]++;
+      for (Int_t icol = 0; icol < a->GetNcols(); icol++)
+         fRows[icol + 1] += fRows[icol];
+      std::vector<Int_t> next(fRows.begin(), fRows.end() - 1);
+      for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
+         for (Int_t i = a_rows[irow]; i < a_rows[irow + 1]; i++) {
+            const Int_t k = next[a_cols[i]]++;
+            fCols[k] = irow;
+            fData[k] = a_data[i];
+         }
+      }
+   }
+};
+
+} // anonymous namespace
+
 TUnfold::~TUnfold(void)
 {
    // delete all data members
@@ -623,58 +754,31 @@ TMatrixDSparse *TUnfold::MultiplyMSparseMSparse(const TMatrixDSparse *a,
             a->GetNcols(),b->GetNrows());
    }
 
-   TMatrixDSparse *r=new TMatrixDSparse(a->GetNrows(),b->GetNcols());
    const Int_t *a_rows=a->GetRowIndexArray();
    const Int_t *a_cols=a->GetColIndexArray();
    const Double_t *a_data=a->GetMatrixArray();
    const Int_t *b_rows=b->GetRowIndexArray();
    const Int_t *b_cols=b->GetColIndexArray();
    const Double_t *b_data=b->GetMatrixArray();
-   // maximum size of the output matrix
-   int nMax=0;
-   for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
-      if(a_rows[irow+1]>a_rows[irow]) nMax += b->GetNcols();
-   }
-   if((nMax>0)&&(a_cols)&&(b_cols)) {
-      Int_t *r_rows=new Int_t[nMax];
-      Int_t *r_cols=new Int_t[nMax];
-      Double_t *r_data=new Double_t[nMax];
-      Double_t *row_data=new Double_t[b->GetNcols()];
-      Int_t n=0;
-      for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
-         if(a_rows[irow+1]<=a_rows[irow]) continue;
-         // clear row data
-         for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            row_data[icol]=0.0;
-         }
-         // loop over a-columns in this a-row
-         for(Int_t ia=a_rows[irow];ia<a_rows[irow+1];ia++) {
-            Int_t k=a_cols[ia];
-            // loop over b-columns in b-row k
-            for(Int_t ib=b_rows[k];ib<b_rows[k+1];ib++) {
-               row_data[b_cols[ib]] += a_data[ia]*b_data[ib];
-            }
-         }
-         // store nonzero elements
-         for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            if(row_data[icol] != 0.0) {
-               r_rows[n]=irow;
-               r_cols[n]=icol;
-               r_data[n]=row_data[icol];
-               n++;
-            }
+   if(!a_cols || !b_cols) {
+      return new TMatrixDSparse(a->GetNrows(),b->GetNcols());
+   }
+   // number of multiplications
+   Long64_t work=0;
+   for(Int_t ia=0;ia<a_rows[a->GetNrows()];ia++) {
+      work += b_rows[a_cols[ia]+1]-b_rows[a_cols[ia]];
+   }
+   return ComputeSparseRows(a->GetNrows(),b->GetNcols(),work,
+                            [&](Int_t irow,TSparseRowSum &row) {
+      // loop over a-columns in this a-row
+      for(Int_t ia=a_rows[irow];ia<a_rows[irow+1];ia++) {
+         Int_t k=a_cols[ia];
+         // loop over b-columns in b-row k
+         for(Int_t ib=b_rows[k];ib<b_rows[k+1];ib++) {
+            row.Add(b_cols[ib],a_data[ia]*b_data[ib]);
          }
       }
-      if(n>0) {
-         r->SetMatrixArray(n,r_rows,r_cols,r_data);
-      }
-      delete[] r_rows;
-      delete[] r_cols;
-      delete[] r_data;
-      delete[] row_data;
-   }
-
-   return r;
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -698,65 +802,28 @@ TMatrixDSparse *TUnfold::MultiplyMSparseTranspMSparse
             a->GetNrows(),b->GetNrows());
    }
 
-   TMatrixDSparse *r=new TMatrixDSparse(a->GetNcols(),b->GetNcols());
    const Int_t *a_rows=a->GetRowIndexArray();
-   const Int_t *a_cols=a->GetColIndexArray();
-   const Double_t *a_data=a->GetMatrixArray();
    const Int_t *b_rows=b->GetRowIndexArray();
    const Int_t *b_cols=b->GetColIndexArray();
    const Double_t *b_data=b->GetMatrixArray();
-   // maximum size of the output matrix
-
-   // matrix multiplication
-   typedef std::map<Int_t,Double_t> MMatrixRow_t;
-   typedef std::map<Int_t, MMatrixRow_t > MMatrix_t;
-   MMatrix_t matrix;
-
+   // number of multiplications
+   Long64_t work=0;
    for(Int_t iRowAB=0;iRowAB<a->GetNrows();iRowAB++) {
-      for(Int_t ia=a_rows[iRowAB];ia<a_rows[iRowAB+1];ia++) {
+      work += Long64_t(a_rows[iRowAB+1]-a_rows[iRowAB])*
+         (b_rows[iRowAB+1]-b_rows[iRowAB]);
+   }
+   // the rows of a# are the columns of a, the terms of each element of the
+   // product are summed in the order of the rows of a
+   TSparseTransposed at(a);
+   return ComputeSparseRows(a->GetNcols(),b->GetNcols(),work,
+                            [&](Int_t irow,TSparseRowSum &row) {
+      for(Int_t ia=at.fRows[irow];ia<at.fRows[irow+1];ia++) {
+         Int_t iRowAB=at.fCols[ia];
          for(Int_t ib=b_rows[iRowAB];ib<b_rows[iRowAB+1];ib++) {
-            // this creates a new row if necessary
-            MMatrixRow_t &row=matrix[a_cols[ia]];
-            MMatrixRow_t::iterator icol=row.find(b_cols[ib]);
-            if(icol!=row.end()) {
-               // update existing row
-               (*icol).second += a_data[ia]*b_data[ib];
-            } else {
-               // create new row
-               row[b_cols[ib]] = a_data[ia]*b_data[ib];
-            }
+            row.Add(b_cols[ib],at.fData[ia]*b_data[ib]);
          }
       }
-   }
-
-   Int_t n=0;
-   for (MMatrix_t::const_iterator irow = matrix.begin(); irow != matrix.end(); ++irow) {
-      n += (*irow).second.size();
-   }
-   if(n>0) {
-      // pack matrix into arrays
-      Int_t *r_rows=new Int_t[n];
-      Int_t *r_cols=new Int_t[n];
-      Double_t *r_data=new Double_t[n];
-      n=0;
-      for (MMatrix_t::const_iterator irow = matrix.begin(); irow != matrix.end(); ++irow) {
-         for (MMatrixRow_t::const_iterator icol = (*irow).second.begin(); icol != (*irow).second.end(); ++icol) {
-            r_rows[n]=(*irow).first;
-            r_cols[n]=(*icol).first;
-            r_data[n]=(*icol).second;
-            n++;
-         }
-      }
-      // pack arrays into TMatrixDSparse
-      if(n>0) {
-         r->SetMatrixArray(n,r_rows,r_cols,r_data);
-      }
-      delete[] r_rows;
-      delete[] r_cols;
-      delete[] r_data;
-   }
-
-   return r;
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -778,43 +845,23 @@ TMatrixDSparse *TUnfold::MultiplyMSparseM(const TMatrixDSparse *a,
             a->GetNcols(),b->GetNrows());
    }
 
-   TMatrixDSparse *r=new TMatrixDSparse(a->GetNrows(),b->GetNcols());
    const Int_t *a_rows=a->GetRowIndexArray();
    const Int_t *a_cols=a->GetColIndexArray();
    const Double_t *a_data=a->GetMatrixArray();
-   // maximum size of the output matrix
-   int nMax=0;
-   for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
-      if(a_rows[irow+1]-a_rows[irow]>0) nMax += b->GetNcols();
-   }
-   if(nMax>0) {
-      Int_t *r_rows=new Int_t[nMax];
-      Int_t *r_cols=new Int_t[nMax];
-      Double_t *r_data=new Double_t[nMax];
-
-      Int_t n=0;
-      // fill matrix r
-      for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
-         if(a_rows[irow+1]-a_rows[irow]<=0) continue;
-         for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            r_rows[n]=irow;
-            r_cols[n]=icol;
-            r_data[n]=0.0;
-            for(Int_t i=a_rows[irow];i<a_rows[irow+1];i++) {
-               Int_t j=a_cols[i];
-               r_data[n] += a_data[i]*(*b)(j,icol);
-            }
-            if(r_data[n]!=0.0) n++;
+   const Int_t b_ncols=b->GetNcols();
+   const Double_t *b_data=b->GetMatrixArray();
+   return ComputeSparseRows(a->GetNrows(),b_ncols,
+                            Long64_t(a_rows[a->GetNrows()])*b_ncols,
+                            [&](Int_t irow,TSparseRowSum &row) {
+      for(Int_t icol=0;icol<b_ncols;icol++) {
+         Double_t r=0.0;
+         for(Int_t i=a_rows[irow];i<a_rows[irow+1];i++) {
+            Int_t j=a_cols[i];
+            r += a_data[i]*b_data[j*b_ncols+icol];
          }
+         row.Add(icol,r);
       }
-      if(n>0) {
-         r->SetMatrixArray(n,r_rows,r_cols,r_data);
-      }
-      delete[] r_rows;
-      delete[] r_cols;
-      delete[] r_data;
-   }
-   return r;
+   });
 }
 
 
@@ -847,17 +894,6 @@ TMatrixDSparse *TUnfold::MultiplyMSparseMSparseTranspVector
    const Int_t *rows_m1=m1->GetRowIndexArray();
    const Int_t *cols_m1=m1->GetColIndexArray();
    const Double_t *data_m1=m1->GetMatrixArray();
-   Int_t num_m1=0;
-   for(Int_t i=0;i<m1->GetNrows();i++) {
-      if(rows_m1[i]<rows_m1[i+1]) num_m1++;
-   }
-   const Int_t *rows_m2=m2->GetRowIndexArray();
-   const Int_t *cols_m2=m2->GetColIndexArray();
-   const Double_t *data_m2=m2->GetMatrixArray();
-   Int_t num_m2=0;
-   for(Int_t j=0;j<m2->GetNrows();j++) {
-      if(rows_m2[j]<rows_m2[j+1]) num_m2++;
-   }
    const TMatrixDSparse *v_sparse=dynamic_cast<const TMatrixDSparse *>(v);
    const Int_t *v_rows=0;
    const Double_t *v_data=0;
@@ -865,53 +901,35 @@ TMatrixDSparse *TUnfold::MultiplyMSparseMSparseTranspVector
       v_rows=v_sparse->GetRowIndexArray();
       v_data=v_sparse->GetMatrixArray();
    }
-   Int_t num_r=num_m1*num_m2+1;
-   Int_t *row_r=new Int_t[num_r];
-   Int_t *col_r=new Int_t[num_r];
-   Double_t *data_r=new Double_t[num_r];
-   num_r=0;
-   for(Int_t i=0;i<m1->GetNrows();i++) {
-      for(Int_t j=0;j<m2->GetNrows();j++) {
-         data_r[num_r]=0.0;
-         Int_t index_m1=rows_m1[i];
-         Int_t index_m2=rows_m2[j];
-         while((index_m1<rows_m1[i+1])&&(index_m2<rows_m2[j+1])) {
-            Int_t k1=cols_m1[index_m1];
-            Int_t k2=cols_m2[index_m2];
-            if(k1<k2) {
-               index_m1++;
-            } else if(k1>k2) {
-               index_m2++;
+   // the rows of m2# are the columns of m2: the terms of each element of
+   // the product are summed in the order of the columns k
+   TSparseTransposed m2t(m2);
+   // number of multiplications
+   Long64_t work=0;
+   for(Int_t index_m1=0;index_m1<rows_m1[m1->GetNrows()];index_m1++) {
+      Int_t k=cols_m1[index_m1];
+      work += m2t.fRows[k+1]-m2t.fRows[k];
+   }
+   return ComputeSparseRows(m1->GetNrows(),m2->GetNrows(),work,
+                            [&](Int_t i,TSparseRowSum &row) {
+      for(Int_t index_m1=rows_m1[i];index_m1<rows_m1[i+1];index_m1++) {
+         Int_t k=cols_m1[index_m1];
+         if(v_sparse && (v_rows[k]>=v_rows[k+1])) continue;
+         for(Int_t index_m2=m2t.fRows[k];index_m2<m2t.fRows[k+1];
+             index_m2++) {
+            if(v_sparse) {
+               row.Add(m2t.fCols[index_m2],data_m1[index_m1]*
+                       m2t.fData[index_m2]*v_data[v_rows[k]]);
+            } else if(v) {
+               row.Add(m2t.fCols[index_m2],data_m1[index_m1]*
+                       m2t.fData[index_m2]*(*v)(k,0));
             } else {
-               if(v_sparse) {
-                  Int_t v_index=v_rows[k1];
-                  if(v_index<v_rows[k1+1]) {
-                     data_r[num_r] += data_m1[index_m1] * data_m2[index_m2]
-                        * v_data[v_index];
-                  }
-               } else if(v) {
-                  data_r[num_r] += data_m1[index_m1] * data_m2[index_m2]
-                     * (*v)(k1,0);
-               } else {
-                  data_r[num_r] += data_m1[index_m1] * data_m2[index_m2];
-               }
-               index_m1++;
-               index_m2++;
+               row.Add(m2t.fCols[index_m2],data_m1[index_m1]*
+                       m2t.fData[index_m2]);
             }
          }
-         if(data_r[num_r] !=0.0) {
-            row_r[num_r]=i;
-            col_r[num_r]=j;
-            num_r++;
-         }
       }
-   }
-   TMatrixDSparse *r=CreateSparseMatrix(m1->GetNrows(),m2->GetNrows(),
-                                        num_r,row_r,col_r,data_r);
-   delete[] row_r;
-   delete[] col_r;
-   delete[] data_r;
-   return r;
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -942,7 +960,8 @@ void TUnfold::AddMSparse(TMatrixDSparse *dest,Double_t f,
       Fatal("AddMSparse","inconsistent matrix rows %d!=%d OR cols %d!=%d",
             src->GetNrows(),dest->GetNrows(),src->GetNcols(),dest->GetNcols());
    }
-   Int_t nmax=dest->GetNrows()*dest->GetNcols();
+   // the result has at most the elements of dest and src
+   Int_t nmax=TMath::Max(1,dest_rows[dest->GetNrows()]+src_rows[src->GetNrows()]);
    Double_t *result_data=new Double_t[nmax];
    Int_t *result_rows=new Int_t[nmax];
    Int_t *result_cols=new Int_t[nmax];
@@ -1202,9 +1221,10 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
    //      *rankPtr=rank(D1)+nrow(D2)+nrow(C)
    //      return Ainv as defined above
 
-   Double_t *rEl_data=new Double_t[A->GetNrows()*A->GetNrows()];
-   Int_t *rEl_col=new Int_t[A->GetNrows()*A->GetNrows()];
-   Int_t *rEl_row=new Int_t[A->GetNrows()*A->GetNrows()];
+   // elements of the result, grown as the parts are inverted
+   std::vector<Double_t> rEl_data;
+   std::vector<Int_t> rEl_col;
+   std::vector<Int_t> rEl_row;
    Int_t rNumEl=0;
 
    //====================================================
@@ -1213,9 +1233,9 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
    for(Int_t i=0;i<iDiagonal;++i) {
       Int_t iA=swap[i];
       if(aII(iA)>0.0) {
-         rEl_col[rNumEl]=iA;
-         rEl_row[rNumEl]=iA;
-         rEl_data[rNumEl]=1./aII(iA);
+         rEl_col.push_back(iA);
+         rEl_row.push_back(iA);
+         rEl_data.push_back(1./aII(iA));
          ++rankD1;
          ++rNumEl;
       }
@@ -1269,14 +1289,19 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
    TMatrixDSparse *minusBD2inv=0;
    if((rNumEl>=0)&&(nF>0)&&((nD2==0)||D2inv)) {
       // construct matrices F and B
-      Int_t nFmax=nF*nF;
+      // both have at most the elements of the rows of A in the F part
+      Int_t nFmax=1;
+      for(Int_t i=0;i<nF;i++) {
+         Int_t iA=swap[i+iBlock];
+         nFmax += a_rows[iA+1]-a_rows[iA];
+      }
       Double_t epsilonF2=fEpsMatrix;
       Double_t *F_data=new Double_t[nFmax];
       Int_t *F_col=new Int_t[nFmax];
       Int_t *F_row=new Int_t[nFmax];
       Int_t FnumEl=0;
 
-      Int_t nBmax=nF*(nD2+1);
+      Int_t nBmax=nFmax;
       Double_t *B_data=new Double_t[nBmax];
       Int_t *B_col=new Int_t[nBmax];
       Int_t *B_row=new Int_t[nBmax];
@@ -1343,6 +1368,7 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
          const Double_t *f_data=F->GetMatrixArray();
          // cholesky-type decomposition of F
          TMatrixD c(nF,nF);
+         Double_t *c_data=c.GetMatrixArray();
          Int_t nErrorF=0;
          for(Int_t i=0;i<nF;i++) {
             for(Int_t indexF=f_rows[i];indexF<f_rows[i+1];indexF++) {
@@ -1360,14 +1386,19 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
             }
        c_ii=TMath::Sqrt(c_ii);
        c(i,i)=c_ii;
-            // off-diagonal elements
-            for(Int_t j=i+1;j<nF;j++) {
-               Double_t c_ji=c(j,i);
-               for(Int_t k=0;k<i;k++) {
-                  c_ji -= c(i,k)*c(j,k);
+            // off-diagonal elements, the rows j are independent
+            const Double_t *c_i=c_data+i*nF;
+            ROOT::Internal::HistForEachRange(nF-i-1,i,
+                            [&](Int_t first,Int_t last) {
+               for(Int_t j=i+1+first;j<i+1+last;j++) {
+                  Double_t *c_j=c_data+j*nF;
+                  Double_t c_ji=c_j[i];
+                  for(Int_t k=0;k<i;k++) {
+                     c_ji -= c_i[k]*c_j[k];
+                  }
+                  c_j[i] = c_ji/c_ii;
                }
-               c(j,i) = c_ji/c_ii;
-            }
+            });
          }
          // check condition of dInv
          if(!nErrorF) {
@@ -1386,19 +1417,27 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
             // here: F = c c#
             // construct inverse of c
             TMatrixD cinv(nF,nF);
+            Double_t *cinv_data=cinv.GetMatrixArray();
             for(Int_t i=0;i<nF;i++) {
                cinv(i,i)=1./c(i,i);
             }
-            for(Int_t i=0;i<nF;i++) {
-               for(Int_t j=i+1;j<nF;j++) {
-                  Double_t tmp=-c(j,i)*cinv(i,i);
-                  for(Int_t k=i+1;k<j;k++) {
-                     tmp -= cinv(k,i)*c(j,k);
+            // the columns i of cinv are independent
+            ROOT::Internal::HistForEachRange(nF,Long64_t(nF)*nF/6,
+                            [&](Int_t first,Int_t last) {
+               for(Int_t i=first;i<last;i++) {
+                  for(Int_t j=i+1;j<nF;j++) {
+                     const Double_t *c_j=c_data+j*nF;
+                     Double_t tmp=-c_j[i]*cinv_data[i*nF+i];
+                     for(Int_t k=i+1;k<j;k++) {
+                        tmp -= cinv_data[k*nF+i]*c_j[k];
+                     }
+                     cinv_data[j*nF+i]=tmp*cinv_data[j*nF+j];
                   }
-                  cinv(j,i)=tmp*cinv(j,j);
                }
-            }
+            });
+            c.Clear();
             TMatrixDSparse cInvSparse(cinv);
+            cinv.Clear();
             Finv=MultiplyMSparseTranspMSparse
                (&cInvSparse,&cInvSparse);
          }
@@ -1448,9 +1487,9 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
                for(Int_t indexE=e_rows[iE];indexE<e_rows[iE+1];++indexE) {
                   Int_t jE=e_cols[indexE];
                   Int_t jA=swap[jE+iDiagonal];
-                  rEl_col[rNumEl]=iA;
-                  rEl_row[rNumEl]=jA;
-                  rEl_data[rNumEl]=e_data[indexE];
+                  rEl_col.push_back(iA);
+                  rEl_row.push_back(jA);
+                  rEl_data.push_back(e_data[indexE]);
                   ++rNumEl;
                }
             }
@@ -1467,14 +1506,14 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
                   Int_t jG=g_cols[indexG];
                   Int_t jA=swap[jG+iDiagonal];
                   // G
-                  rEl_col[rNumEl]=iA;
-                  rEl_row[rNumEl]=jA;
-                  rEl_data[rNumEl]=g_data[indexG];
+                  rEl_col.push_back(iA);
+                  rEl_row.push_back(jA);
+                  rEl_data.push_back(g_data[indexG]);
                   ++rNumEl;
                   // G#
-                  rEl_col[rNumEl]=jA;
-                  rEl_row[rNumEl]=iA;
-                  rEl_data[rNumEl]=g_data[indexG];
+                  rEl_col.push_back(jA);
+                  rEl_row.push_back(iA);
+                  rEl_data.push_back(g_data[indexG]);
                   ++rNumEl;
                }
             }
@@ -1490,9 +1529,9 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
                for(Int_t indexF=finv_rows[iF];indexF<finv_rows[iF+1];++indexF) {
                   Int_t jF=finv_cols[indexF];
                   Int_t jA=swap[jF+iBlock];
-                  rEl_col[rNumEl]=iA;
-                  rEl_row[rNumEl]=jA;
-                  rEl_data[rNumEl]=finv_data[indexF];
+                  rEl_col.push_back(iA);
+                  rEl_row.push_back(jA);
+                  rEl_data.push_back(finv_data[indexF]);
                   ++rNumEl;
                }
             }
@@ -1589,9 +1628,9 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
                 indexVDVt<vdvt_rows[iVDVt+1];++indexVDVt) {
                Int_t jVDVt=vdvt_cols[indexVDVt];
                Int_t jA=swap[jVDVt+iDiagonal];
-               rEl_col[rNumEl]=iA;
-               rEl_row[rNumEl]=jA;
-               rEl_data[rNumEl]=vdvt_data[indexVDVt];
+               rEl_col.push_back(iA);
+               rEl_row.push_back(jA);
+               rEl_data.push_back(vdvt_data[indexVDVt]);
                ++rNumEl;
             }
          }
@@ -1614,10 +1653,7 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
 
    TMatrixDSparse *r=(rNumEl>=0) ?
       CreateSparseMatrix(A->GetNrows(),A->GetNrows(),rNumEl,
-                         rEl_row,rEl_col,rEl_data) : 0;
-   delete [] rEl_data;
-   delete [] rEl_col;
-   delete [] rEl_row;
+                         rEl_row.data(),rEl_col.data(),rEl_data.data()) : 0;
 
 #ifdef DEBUG_DETAIL
    // sanity test
@@ -2312,9 +2348,10 @@ Int_t TUnfold::SetInput(const TH1 *input, Double_t scaleBias,
   // construct error matrix and inverted error matrix of measured quantities
   // from errors of input histogram or use error matrix
 
-  Int_t *rowVyyN=new Int_t[GetNy()*GetNy()+1];
-  Int_t *colVyyN=new Int_t[GetNy()*GetNy()+1];
-  Double_t *dataVyyN=new Double_t[GetNy()*GetNy()+1];
+  // the elements are stored as they are found, only the non-zero ones
+  std::vector<Int_t> rowVyyN;
+  std::vector<Int_t> colVyyN;
+  std::vector<Double_t> dataVyyN;
 
   Int_t *rowVyy1=new Int_t[GetNy()];
   Int_t *colVyy1=new Int_t[GetNy()];
@@ -2345,13 +2382,14 @@ Int_t TUnfold::SetInput(const TH1 *input, Double_t scaleBias,
            nVarianceZero++;
         }
      }
-     rowVyyN[nVyyN] = iy;
-     colVyyN[nVyyN] = iy;
      rowVyy1[nVyy1] = iy;
      colVyy1[nVyy1] = 0;
      dataVyyDiag[iy] = dy2;
      if(dy2>0.0) {
-        dataVyyN[nVyyN++] = dy2;
+        rowVyyN.push_back(iy);
+        colVyyN.push_back(iy);
+        dataVyyN.push_back(dy2);
+        nVyyN++;
         dataVyy1[nVyy1++] = dy2;
      }
   }
@@ -2374,34 +2412,34 @@ Int_t TUnfold::SetInput(const TH1 *input, Double_t scaleBias,
            // ignore columns where the diagonal is zero
            if(dataVyyDiag[jy]<=0.0) continue;
 
-           rowVyyN[nVyyN] = iy;
-           colVyyN[nVyyN] = jy;
-           dataVyyN[nVyyN]= hist_vyy->GetBinContent(iy+1,jy+1);
-           if(dataVyyN[nVyyN] == 0.0) continue;
+           Double_t vyy=hist_vyy->GetBinContent(iy+1,jy+1);
+           if(vyy == 0.0) continue;
+           rowVyyN.push_back(iy);
+           colVyyN.push_back(jy);
+           dataVyyN.push_back(vyy);
            nVyyN ++;
         }
      }
      if(hist_vyy_inv) {
         Warning("SetInput",
                 "inverse of input covariance is taken from user input");
-        Int_t *rowVyyInv=new Int_t[GetNy()*GetNy()+1];
-        Int_t *colVyyInv=new Int_t[GetNy()*GetNy()+1];
-        Double_t *dataVyyInv=new Double_t[GetNy()*GetNy()+1];
+        std::vector<Int_t> rowVyyInv;
+        std::vector<Int_t> colVyyInv;
+        std::vector<Double_t> dataVyyInv;
         Int_t nVyyInv=0;
         for (Int_t iy = 0; iy < GetNy(); iy++) {
            for (Int_t jy = 0; jy < GetNy(); jy++) {
-              rowVyyInv[nVyyInv] = iy;
-              colVyyInv[nVyyInv] = jy;
-              dataVyyInv[nVyyInv]= hist_vyy_inv->GetBinContent(iy+1,jy+1);
-              if(dataVyyInv[nVyyInv] == 0.0) continue;
+              Double_t vyyInv=hist_vyy_inv->GetBinContent(iy+1,jy+1);
+              if(vyyInv == 0.0) continue;
+              rowVyyInv.push_back(iy);
+              colVyyInv.push_back(jy);
+              dataVyyInv.push_back(vyyInv);
               nVyyInv ++;
            }
         }
         fVyyInv=CreateSparseMatrix
-           (GetNy(),GetNy(),nVyyInv,rowVyyInv,colVyyInv,dataVyyInv);
-        delete [] rowVyyInv;
-        delete [] colVyyInv;
-        delete [] dataVyyInv;
+           (GetNy(),GetNy(),nVyyInv,rowVyyInv.data(),colVyyInv.data(),
+            dataVyyInv.data());
      } else {
         if(nOffDiagNonzero) {
            Error("SetInput",
@@ -2411,11 +2449,7 @@ Int_t TUnfold::SetInput(const TH1 *input, Double_t scaleBias,
   }
   DeleteMatrix(&fVyy);
   fVyy = CreateSparseMatrix
-     (GetNy(),GetNy(),nVyyN,rowVyyN,colVyyN,dataVyyN);
-
-  delete[] rowVyyN;
-  delete[] colVyyN;
-  delete[] dataVyyN;
+     (GetNy(),GetNy(),nVyyN,rowVyyN.data(),colVyyN.data(),dataVyyN.data());
 
   TMatrixDSparse *vecV=CreateSparseMatrix
      (GetNy(),1,nVyy1,rowVyy1,colVyy1, dataVyy1);
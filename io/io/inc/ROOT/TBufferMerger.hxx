@@ -14,12 +14,15 @@
 
 #include "TMemFile.h"
 
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <utility>
+#include <vector>
 
 class TBufferFile;
 class TFile;
@@ -40,6 +43,12 @@ class TBufferMergerFile;
  * socket, TBufferMerger uses threads that each write to a
  * TBufferMergerFile, which in turn push data into a queue
  * managed by the TBufferMerger.
+ *
+ * The baskets are compressed by the threads writing to the
+ * TBufferMergerFiles: the output thread copies them into the
+ * output file without recompressing them. The queue can be
+ * bounded with SetMaxQueueSize(), to keep the writers from
+ * outpacing the output thread.
  */
 
 class TBufferMerger {
@@ -74,10 +83,34 @@ public:
    /** Returns the number of buffers currently in the queue. */
    size_t GetQueueSize() const;
 
+   /** Returns the maximum number of buffers in the queue (0, the default, if unbounded). */
+   size_t GetMaxQueueSize() const;
+
+   /** Bound the merging queue to @param size buffers (0 means unbounded).
+    *  When the queue is full, TBufferMergerFile::Write() blocks until the
+    *  output thread has taken a buffer out of it, which bounds the memory
+    *  used by the buffers waiting to be merged.
+    */
+   void SetMaxQueueSize(size_t size);
+
+   /** Returns the largest number of buffers seen in the queue. */
+   size_t GetPeakQueueSize() const;
+
+   /** Returns the number of buffers merged into the output file so far. */
+   size_t GetNMergedBuffers() const;
+
+   /** Returns the mean time, in seconds, between the push of a buffer and the end of its merge into the output. */
+   double GetMeanMergeLatency() const;
+
+   /** Returns the longest time, in seconds, between the push of a buffer and the end of its merge into the output. */
+   double GetMaxMergeLatency() const;
+
    /** Register a user callback function to be called after a buffer has been
     *  removed from the merging queue and finished being processed. This
     *  function can be useful to allow asynchronous launching of new tasks to
     *  push more data into the queue once its size satisfies user requirements.
+    *  With a bounded queue, it is an alternative to blocking in Write(): the
+    *  callback can check GetQueueSize() before launching more writers.
     */
    void RegisterCallback(const std::function<void(void)> &f);
 
@@ -108,14 +141,23 @@ private:
 
    void Init(std::unique_ptr<TFile>);
 
+   using Clock_t = std::chrono::steady_clock;
+
    void Push(TBufferFile *buffer);
    void WriteOutputFile();
+   void RecordMerged(std::vector<Clock_t::time_point> &pushTimes);
 
    TFile* fFile;                                                 //< Output file.
    size_t fAutoSave;                                             //< AutoSave only every fAutoSave bytes
-   std::mutex fQueueMutex;                                       //< Mutex used to lock fQueue
+   size_t fMaxQueueSize;                                         //< Maximum number of buffers in fQueue, 0 if unbounded
+   size_t fPeakQueueSize;                                        //< Largest number of buffers seen in fQueue
+   size_t fNMerged;                                              //< Number of buffers merged into the output
+   double fTotalLatency;                                         //< Sum of the merge latencies, in seconds
+   double fMaxLatency;                                           //< Longest merge latency, in seconds
+   mutable std::mutex fQueueMutex;                               //< Mutex used to lock fQueue and the counters
    std::condition_variable fDataAvailable;                       //< Condition variable used to wait for data
-   std::queue<TBufferFile *> fQueue;                             //< Queue to which data is pushed and merged
+   std::condition_variable fSpaceAvailable;                      //< Condition variable used to wait for room in fQueue
+   std::queue<std::pair<TBufferFile *, Clock_t::time_point>> fQueue; //< Queue to which data is pushed and merged
    std::unique_ptr<std::thread> fMergingThread;                  //< Worker thread that writes to disk
    std::vector<std::weak_ptr<TBufferMergerFile>> fAttachedFiles; //< Attached files
    std::function<void(void)> fCallback;                          //< Callback for when data is removed from queue
@@ -0,0 +1,69 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBufferPool
+#define ROOT_TBufferPool
+
+#include "TBuffer.h"
+
+#include <cstddef>
+
+class TBufferFile;
+
+namespace ROOT {
+namespace Internal {
+
+/**
+ * \class TBufferPool TBufferPool.hxx
+ * \ingroup IO
+ *
+ * Pool of the memory of the I/O buffers, the baskets read and written,
+ * the blocks unzipped by TTreeCacheUnzip and the buffers queued in
+ * TBufferMerger, so that the buffers freed when a cluster is done are
+ * reused for the next one instead of going through the allocator.
+ *
+ * The buffers are sorted in power of two size classes, from 4 kB to
+ * 128 MB; larger ones are not pooled. Each thread keeps a few free buffers
+ * of every class, taken and given back without any lock. The buffers a
+ * thread has too many of, e.g. those unzipped by the IMT tasks and released
+ * by the reader, go to a shared depot, where the threads which miss some
+ * take them from; the depot holds at most GetMaxCachedBytes() bytes.
+ */
+
+class TBufferPool {
+public:
+   /// Gives back memory acquired from the pool, for std::unique_ptr<char[], TDeleter>.
+   struct TDeleter {
+      void operator()(char *buffer) const { Release(buffer); }
+   };
+
+   static char *Acquire(std::size_t size);
+   static void Release(char *buffer);
+   static std::size_t GetCapacity(const char *buffer);
+
+   /// Reallocation function of the TBuffers whose memory comes from the pool.
+   static char *ReAllocChar(char *buffer, std::size_t newsize, std::size_t oldsize);
+
+   static TBufferFile *NewBuffer(TBuffer::EMode mode, Int_t size);
+   static TBufferFile *NewBuffer(TBuffer::EMode mode, char *buffer, Int_t size);
+   static void ReleaseMemory(TBuffer &buffer);
+
+   /// Whether the memory of buffer comes from the pool.
+   static Bool_t IsPooled(const TBuffer &buffer) { return buffer.GetReAllocFunc() == &ReAllocChar; }
+
+   static void SetMaxCachedBytes(Long64_t bytes);
+   static Long64_t GetMaxCachedBytes();
+   static void Clear();
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
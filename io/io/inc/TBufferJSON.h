@@ -16,6 +16,7 @@
 #include "TString.h"
 
 #include <deque>
+#include <functional>
 
 class TVirtualStreamerInfo;
 class TStreamerInfo;
@@ -27,6 +28,9 @@ class TJSONStackObj;
 class TBufferJSON : public TBufferText {
 
 public:
+   /// Receives the successive chunks of the JSON code produced by StreamToJSON()
+   using Sink_t = std::function<void(const char *chunk, Int_t len)>;
+
    TBufferJSON(TBuffer::EMode mode = TBuffer::kWrite);
    virtual ~TBufferJSON();
 
@@ -37,6 +41,10 @@ public:
    ConvertToJSON(const void *obj, const TClass *cl, Int_t compact = 0, const char *member_name = nullptr);
    static TString ConvertToJSON(const void *obj, TDataMember *member, Int_t compact = 0, Int_t arraylen = -1);
 
+   static Long64_t StreamToJSON(const TObject *obj, const Sink_t &sink, Int_t compact = 0, Int_t chunksize = 65536);
+   static Long64_t
+   StreamToJSON(const void *obj, const TClass *cl, const Sink_t &sink, Int_t compact = 0, Int_t chunksize = 65536);
+
    static Int_t ExportToFile(const char *filename, const TObject *obj, const char *option = nullptr);
    static Int_t ExportToFile(const char *filename, const void *obj, const TClass *cl, const char *option = nullptr);
 
@@ -259,11 +267,16 @@ protected:
 
    void AppendOutput(const char *line0, const char *line1 = nullptr);
 
+   void FlushSink();
+
    void JsonPushValue();
 
    template <typename T>
    R__ALWAYS_INLINE void JsonWriteArrayCompress(const T *vname, Int_t arrsize, const char *typname);
 
+   template <typename T>
+   void JsonWriteArrayBase64(const T *vname, Int_t arrsize, const char *typname);
+
    template <typename T>
    R__ALWAYS_INLINE void JsonReadBasic(T &value);
 
@@ -286,6 +299,9 @@ protected:
    TString fSemicolon; ///<!  depending from compression level, " : " or ":"
    TString fArraySepar;    ///<!  depending from compression level, ", " or ","
    TString fNumericLocale; ///<!  stored value of setlocale(LC_NUMERIC), which should be recovered at the end
+   Sink_t fSink;           ///<!  receives the main output buffer by chunks, when streaming
+   Int_t fChunkSize;       ///<!  size of the main output buffer above which it is passed to fSink
+   Long64_t fSinkBytes;    ///<!  number of bytes passed to fSink
 
    ClassDef(TBufferJSON, 1) // a specialized TBuffer to only write objects into JSON format
 };
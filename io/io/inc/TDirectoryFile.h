@@ -46,6 +46,7 @@ protected:
 
    virtual void         CleanTargets();
    void Init(TClass *cl = 0);
+   TKey *FindKeyCycle(const char *name, Short_t cycle) const;
 
 private:
    TDirectoryFile(const TDirectoryFile &directory);  //Directories cannot be copied
@@ -73,6 +74,7 @@ public:
    virtual TKey       *FindKeyAny(const char *keyname) const;
    virtual TObject    *FindObjectAny(const char *name) const;
    virtual TObject    *FindObjectAnyFile(const char *name) const;
+   using TDirectory::Get;
    virtual TObject    *Get(const char *namecycle);
    virtual TDirectory *GetDirectory(const char *apath, Bool_t printError = false, const char *funcname = "GetDirectory");
    template <class T> inline void GetObject(const char* namecycle, T*& ptr) // See TDirectory::Get for information
@@ -87,6 +87,8 @@ protected:
    TArrayC         *fClassIndex;     ///<!Index of TStreamerInfo classes written to this file
    TObjArray       *fProcessIDs;     ///<!Array of pointers to TProcessIDs
    Long64_t         fOffset;         ///<!Seek offset cache
+   const char      *fMapBegin;       ///<!Start of the memory mapping of the file (if any)
+   Long64_t         fMapSize;        ///<!Size of the memory mapping of the file
    TArchiveFile    *fArchive;        ///<!Archive file from which we read this file
    TFileCacheRead  *fCacheRead;      ///<!Pointer to the read cache (if any)
    TMap            *fCacheReadMap;   ///<!Pointer to the read cache (if any)
@@ -128,6 +130,9 @@ protected:
    virtual void  Init(Bool_t create);
    Bool_t        FlushWriteCache();
    Int_t         ReadBufferViaCache(char *buf, Int_t len);
+   Bool_t        ReadMappedBuffer(char *buf, Int_t len, Double_t start);
+   Bool_t        MapFile();
+   void          UnmapFile();
    Int_t         WriteBufferViaCache(const char *buf, Int_t len);
 
    // Creating projects
@@ -153,6 +158,7 @@ private:
    TFile(const TFile &);            //Files cannot be copied
    void operator=(const TFile &);
 
+   void          CountMappedRead(Int_t len, Double_t start);
    static void   CpProgress(Long64_t bytesread, Long64_t size, TStopwatch &watch);
    static TFile *OpenFromCache(const char *name, Option_t * = "",
                                const char *ftitle = "", Int_t compress = 1,
@@ -203,6 +209,7 @@ public:
    virtual Int_t       GetErrno() const;
    virtual void        ResetErrno() const;
    Int_t               GetFd() const { return fD; }
+   const char         *GetMappedBuffer(Long64_t pos, Int_t len);
    virtual const TUrl *GetEndpointUrl() const { return &fUrl; }
    TObjArray          *GetListOfProcessIDs() const {return fProcessIDs;}
    TList              *GetListOfFree() const { return fFree; }
@@ -228,6 +235,7 @@ public:
    virtual void        IncrementProcessIDs() { fNProcessIDs++; }
    virtual Bool_t      IsArchive() const { return fIsArchive; }
            Bool_t      IsBinary() const { return TestBit(kBinaryFile); }
+           Bool_t      IsMapped() const { return fMapBegin != 0; }
            Bool_t      IsRaw() const { return !fIsRootFile; }
    virtual Bool_t      IsOpen() const;
    virtual void        ls(Option_t *option="") const;
@@ -70,6 +70,19 @@ protected:
    Bool_t         fBIsSorted;
    Bool_t         fBIsTransferred;
 
+   Bool_t         fAdaptive;         ///<! Adapt the size of the prefetched window to the measured latency and bandwidth
+   Int_t          fAdaptiveMinSize;  ///<! Smallest prefetched window in adaptive mode
+   Int_t          fAdaptiveMaxSize;  ///<! Memory cap of the prefetched window in adaptive mode
+   Int_t          fMaxChunkSize;     ///<! Largest read of merged consecutive blocks
+   Double_t       fFitW;             ///<! Weighted sums of the fit of the transfer times ...
+   Double_t       fFitX;             ///<! ... to the transfer sizes, see AdaptBufferSize
+   Double_t       fFitY;             ///<!
+   Double_t       fFitXX;            ///<!
+   Double_t       fFitXY;            ///<!
+   Double_t       fRoundTripTime;    ///<! Estimated latency of a transfer in seconds, -1 if unknown
+   Double_t       fBandwidth;        ///<! Estimated bandwidth in bytes per second, -1 if unknown
+
+   void AdaptBufferSize(Int_t nbytes, Double_t dtime);
    void SetEnablePrefetchingImpl(Bool_t setPrefetching = kFALSE); // Can not be virtual as it is called from the constructor.
 
 private:
@@ -96,8 +109,12 @@ public:
    virtual Int_t       GetNoCacheReadCalls() const { return fNoCacheReadCalls; }
    virtual Int_t       GetUnzipBuffer(char ** /*buf*/, Long64_t /*pos*/, Int_t /*len*/, Bool_t * /*free*/) { return -1; }
            Long64_t    GetPrefetchedBlocks() const { return fPrefetchedBlocks; }
+           Double_t    GetBandwidth() const { return fBandwidth; }         // Estimated transfer rate in bytes/s, -1 if unknown.
+           Double_t    GetRoundTripTime() const { return fRoundTripTime; } // Estimated latency in seconds, -1 if unknown.
+           Bool_t      IsAdaptive() const { return fAdaptive; }
    virtual Bool_t      IsAsyncReading() const { return fAsyncReading; };
    virtual void        SetEnablePrefetching(Bool_t setPrefetching = kFALSE);
+           void        SetAdaptive(Bool_t adaptive = kTRUE, Int_t maxsize = 0);
    virtual Bool_t      IsEnablePrefetching() const { return fEnablePrefetching; };
    virtual Bool_t      IsLearning() const {return kFALSE;}
    virtual void        Prefetch(Long64_t pos, Int_t len);
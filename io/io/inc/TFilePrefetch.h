@@ -44,8 +44,15 @@ private:
    TStopwatch  fWaitTime;          // time wating to prefetch a buffer (in usec)
    Bool_t      fThreadJoined;      // mark if async thread was joined
    std::atomic<Bool_t> fPrefetchFinished;  // true if prefetching is over
+   Long64_t    fCacheSizeLimit;    // maximum size of the cache directory in bytes (0 for no limit)
+   Long64_t    fCacheSize;         // estimated size of the cache directory in bytes (-1 if unknown)
+   Long64_t    fCacheWritten;      // bytes written in the cache since the last scan of the directory
+   std::atomic<Long64_t> fCacheHits;      // number of blocks read from the cache
+   std::atomic<Long64_t> fCacheMisses;    // number of blocks not found in the cache
+   std::atomic<Long64_t> fCacheBytesRead; // number of bytes read from the cache
 
    static TThread::VoidRtnFunc_t ThreadProc(void*);  //create a joinable worker thread
+   TString   GetBlockCachePath(TFPBlock*, Bool_t);
 
 public:
    TFilePrefetch(TFile*);
@@ -69,6 +76,14 @@ public:
    Bool_t    CheckBlockInCache(char*&, TFPBlock*);
    char     *GetBlockFromCache(const char*, Int_t);
    void      SaveBlockInCache(TFPBlock*);
+   Long64_t  EvictFromCache();
+
+   void      SetCacheSizeLimit(Long64_t limit);
+   Long64_t  GetCacheSizeLimit() const { return fCacheSizeLimit; }
+   Long64_t  GetCacheHits() const { return fCacheHits; }
+   Long64_t  GetCacheMisses() const { return fCacheMisses; }
+   Long64_t  GetCacheBytesRead() const { return fCacheBytesRead; }
+   const char *GetCacheDir() const { return fPathCache; }
 
    Int_t     SumHex(const char*);
    Bool_t    BinarySearchReadList(TFPBlock*, Long64_t, Int_t, Int_t*);
@@ -25,6 +25,9 @@ protected:
    void WriteMap(int nElements, TBuffer &b);
    void WriteObjects(int nElements, TBuffer &b);
    void WritePrimitives(int nElements, TBuffer &b);
+   TGenCollectionStreamer *GetNestedVectorStreamer() const;
+   void ReadNestedVectors(int nElements, TBuffer &b, char *first, TGenCollectionStreamer *inner);
+   void WriteNestedVectors(int nElements, TBuffer &b, char *first, TGenCollectionStreamer *inner);
 
 //   typedef void (TGenCollectionStreamer::*ReadBufferConv_t)(TBuffer &b, void *obj, const TClass *onFileClass);
 //   ReadBufferConv_t fReadBufferConvFunc;
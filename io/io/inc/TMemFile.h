@@ -14,7 +14,12 @@
 
 #include "TFile.h"
 
+#include <utility>
+
 class TMemFile : public TFile {
+public:
+   /// A range of memory, used as the content of a TMemFile without being copied
+   using ZeroCopyView_t = std::pair<const char *, std::size_t>;
 
 private:
    struct TMemBlock {
@@ -38,6 +43,9 @@ private:
    Long64_t     fSysOffset;   ///< Seek offset in file
    TMemBlock   *fBlockSeek;   ///< Pointer to the block we seeked to.
    Long64_t     fBlockOffset; ///< Seek offset within the block
+   Bool_t       fIsOwned;     ///< Whether the memory of fBlockList was allocated by this TMemFile
+   void        *fShmBegin;    ///<! Mapping of the shared memory segment the content is read from, if any
+   Long64_t     fShmSize;     ///<! Size of the mapping of the shared memory segment
 
    static Long64_t fgDefaultBlockSize;
 
@@ -61,9 +69,14 @@ private:
 public:
    TMemFile(const char *name, Option_t *option="", const char *ftitle="", Int_t compress=1);
    TMemFile(const char *name, char *buffer, Long64_t size, Option_t *option="", const char *ftitle="", Int_t compress=1);
+   TMemFile(const char *name, const ZeroCopyView_t &datarange, Option_t *option="", const char *ftitle="", Int_t compress=1);
    TMemFile(const TMemFile &orig);
    virtual ~TMemFile();
 
+   static TMemFile *OpenShm(const char *shmName, const char *name = 0);
+   static Int_t     UnlinkShm(const char *shmName);
+   Long64_t         WriteToShm(const char *shmName) const;
+
    virtual Long64_t CopyTo(void *to, Long64_t maxsize) const;
    virtual void     CopyTo(TBuffer &tobuf) const;
    virtual Long64_t GetSize() const;
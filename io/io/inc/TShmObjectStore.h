@@ -0,0 +1,72 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TShmObjectStore
+#define ROOT_TShmObjectStore
+
+#include "TObject.h"
+#include "TString.h"
+
+#include <map>
+#include <string>
+#include <utility>
+
+class TBufferFile;
+
+class TShmObjectStore : public TObject {
+public:
+   /// A range of the shared memory holding the streamed object, see GetView()
+   using ZeroCopyView_t = std::pair<const char *, std::size_t>;
+
+   enum { kDefaultSize = 0x800000, kDefaultMaxObjects = 256 }; // default size of the segment is 8 MB
+
+private:
+   TString      fName;         ///< Name of the shared memory segment
+   char        *fBase;         ///< Address of the mapping of the segment in this process
+   Long64_t     fSize;         ///< Size of the mapping
+   Bool_t       fWritable;     ///< Whether objects can be added and updated
+   TBufferFile *fBuffer;       ///< Buffer of the writer, reused by all the updates
+   std::map<std::string, const TObject *> fObjects; ///< Objects added by this writer, by name
+
+   TShmObjectStore(const char *name, char *base, Long64_t size, Bool_t writable);
+   TShmObjectStore(const TShmObjectStore &);            // Not implemented
+   TShmObjectStore &operator=(const TShmObjectStore &); // Not implemented
+
+   Int_t  FindRecord(const char *name) const;
+   Bool_t Write(const char *name, const TObject *obj);
+
+public:
+   virtual ~TShmObjectStore();
+
+   static TShmObjectStore *Create(const char *shmName, Long64_t size = kDefaultSize,
+                                  Int_t maxobjects = kDefaultMaxObjects);
+   static TShmObjectStore *Open(const char *shmName, Bool_t writable = kFALSE);
+   static Int_t            Unlink(const char *shmName);
+
+   Bool_t         Add(const TObject *obj, const char *name = "");
+   Int_t          Update(const TObject *obj = 0);
+   Bool_t         Remove(const char *name);
+   TObject       *Get(const char *name, TObject *retObj = 0) const;
+   Bool_t         GetView(const char *name, ZeroCopyView_t &view, TString *classname = 0) const;
+   ULong64_t      GetVersion(const char *name) const;
+   ULong64_t      GetGeneration() const;
+   Int_t          GetEntries() const;
+   const char    *GetName() const { return fName; }
+   Bool_t         IsWritable() const { return fWritable; }
+
+   void           LockRead() const;
+   void           UnlockRead() const;
+
+   virtual void   Print(Option_t *option = "") const;
+
+   ClassDef(TShmObjectStore, 0) // Objects shared between processes through a POSIX shared memory segment
+};
+
+#endif
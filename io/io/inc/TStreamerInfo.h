@@ -13,6 +13,7 @@
 #define ROOT_TStreamerInfo
 
 #include <atomic>
+#include <map>
 
 #include "TVirtualStreamerInfo.h"
 
@@ -27,6 +28,7 @@ Describe Streamer information for one class version
 */
 
 class TFile;
+class TBufferFile;
 class TClass;
 class TClonesArray;
 class TDataMember;
@@ -69,6 +71,9 @@ public:
    // make the opaque pointer public.
    typedef TCompInfo TCompInfo_t;
 
+   /// Just-in-time compiled function streaming an object, see TVirtualStreamerInfo::SetJitStreamers
+   typedef void (*JitStreamerFunc_t)(TBufferFile &b, char *pointer);
+
 protected:
    //---------------------------------------------------------------------------
    // Adapter class used to handle streaming collection of pointers
@@ -114,6 +119,12 @@ private:
    TStreamerInfoActions::TActionSequence *fWriteMemberWise;       ///<! List of write action resulting from the compilation for use in member wise streaming.
    TStreamerInfoActions::TActionSequence *fWriteMemberWiseVecPtr; ///<! List of write action resulting from the compilation for use in member wise streaming.
    TStreamerInfoActions::TActionSequence *fWriteText;             ///<! List of text write action resulting for the compilation, used for JSON.
+   TStreamerInfoActions::TActionSequence *fJitReadActions;        ///<! Read actions called by fJitReadFunc, for the members it does not read itself.
+   TStreamerInfoActions::TActionSequence *fJitWriteActions;       ///<! Write actions called by fJitWriteFunc, for the members it does not write itself.
+   std::map<const TClass*, TStreamerInfoActions::TActionSequence*> *fReadMemberWiseInCollection; ///<! Member wise read actions for the base classes and embedded objects of the content of a collection, per collection class.
+   JitStreamerFunc_t  fJitReadFunc;      ///<! Just-in-time compiled replacement of fReadObjectWise, if any.
+   JitStreamerFunc_t  fJitWriteFunc;     ///<! Just-in-time compiled replacement of fWriteObjectWise, if any.
+   std::atomic<Int_t> fJitState;         ///<! 0: functions not generated yet, 1: generated, -1: not generated.
 
    static std::atomic<Int_t>             fgCount;     ///<Number of TStreamerInfo instances
 
@@ -124,6 +135,7 @@ private:
    void              GenerateDeclaration(FILE *fp, FILE *sfp, const TList *subClasses, Bool_t top = kTRUE);
    void              InsertArtificialElements(std::vector<const ROOT::TSchemaRule*> &rules);
    void              DestructorImpl(void* p, Bool_t dtorOnly);
+   void              JitStreamerFunctions();
 
 private:
    TStreamerInfo(const TStreamerInfo&);            // TStreamerInfo are copiable.  Not Implemented.
@@ -211,11 +223,16 @@ public:
    TStreamerElement   *GetElement(Int_t id) const {return (TStreamerElement*)fElements->At(id);} // Return the element for the complete list of elements (max GetElements()->GetEntries())
    Int_t               GetElementOffset(Int_t id) const {return fCompFull[id]->fOffset;}
    TStreamerInfoActions::TActionSequence *GetReadMemberWiseActions(Bool_t forCollection) { return forCollection ? fReadMemberWiseVecPtr : fReadMemberWise; }
+   TStreamerInfoActions::TActionSequence *GetReadMemberWiseActions(TVirtualCollectionProxy &proxy);
    TStreamerInfoActions::TActionSequence *GetReadObjectWiseActions() { return fReadObjectWise; }
    TStreamerInfoActions::TActionSequence *GetReadTextActions() { return fReadText; }
    TStreamerInfoActions::TActionSequence *GetWriteMemberWiseActions(Bool_t forCollection) { return forCollection ? fWriteMemberWiseVecPtr : fWriteMemberWise; }
    TStreamerInfoActions::TActionSequence *GetWriteObjectWiseActions() { return fWriteObjectWise; }
    TStreamerInfoActions::TActionSequence *GetWriteTextActions() { return fWriteText; }
+   /// Return the just-in-time compiled function reading an object, generated on first use, or 0.
+   JitStreamerFunc_t   GetJitReadFunc() { if (!fgJitStreamers) return 0; if (fJitState == 0) JitStreamerFunctions(); return fJitReadFunc; }
+   /// Return the just-in-time compiled function writing an object, generated on first use, or 0.
+   JitStreamerFunc_t   GetJitWriteFunc() { if (!fgJitStreamers) return 0; if (fJitState == 0) JitStreamerFunctions(); return fJitWriteFunc; }
    Int_t               GetNdata()   const {return fNdata;}
    Int_t               GetNelement() const { return fElements->GetEntries(); }
    Int_t               GetNumber()  const {return fNumber;}
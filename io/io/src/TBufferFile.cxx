@@ -39,15 +39,7 @@ The concrete implementation of TBuffer for writing/reading to/from a ROOT file o
 #include "TVirtualMutex.h"
 #include "TArrayC.h"
 #include "TROOT.h"
-
-#if (defined(__linux) || defined(__APPLE__)) && defined(__i386__) && \
-     defined(__GNUC__)
-#define USE_BSWAPCPY
-#endif
-
-#ifdef USE_BSWAPCPY
-#include "Bswapcpy.h"
-#endif
+#include "ROOT/ByteSwapArray.hxx"
 
 
 const UInt_t kNullTag           = 0;
@@ -830,13 +822,8 @@ Int_t TBufferFile::ReadArray(Short_t *&h)
    if (!h) h = new Short_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy<sizeof(h[0])>(h, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
 #else
    memcpy(h, fBufCur, l);
    fBufCur += l;
@@ -863,13 +850,8 @@ Int_t TBufferFile::ReadArray(Int_t *&ii)
    if (!ii) ii = new Int_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy<sizeof(ii[0])>(ii, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
 #else
    memcpy(ii, fBufCur, l);
    fBufCur += l;
@@ -922,8 +904,8 @@ Int_t TBufferFile::ReadArray(Long64_t *&ll)
    if (!ll) ll = new Long64_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy<sizeof(ll[0])>(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -950,13 +932,8 @@ Int_t TBufferFile::ReadArray(Float_t *&f)
    if (!f) f = new Float_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy<sizeof(f[0])>(f, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
 #else
    memcpy(f, fBufCur, l);
    fBufCur += l;
@@ -983,8 +960,8 @@ Int_t TBufferFile::ReadArray(Double_t *&d)
    if (!d) d = new Double_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy<sizeof(d[0])>(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1103,13 +1080,8 @@ Int_t TBufferFile::ReadStaticArray(Short_t *h)
    if (!h) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy<sizeof(h[0])>(h, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
 #else
    memcpy(h, fBufCur, l);
    fBufCur += l;
@@ -1135,13 +1107,8 @@ Int_t TBufferFile::ReadStaticArray(Int_t *ii)
    if (!ii) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
-   fBufCur += sizeof(Int_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy<sizeof(ii[0])>(ii, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ii, fBufCur, l);
    fBufCur += l;
@@ -1192,8 +1159,8 @@ Int_t TBufferFile::ReadStaticArray(Long64_t *ll)
    if (!ll) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy<sizeof(ll[0])>(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1219,13 +1186,8 @@ Int_t TBufferFile::ReadStaticArray(Float_t *f)
    if (!f) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
-   fBufCur += sizeof(Float_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy<sizeof(f[0])>(f, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(f, fBufCur, l);
    fBufCur += l;
@@ -1251,8 +1213,8 @@ Int_t TBufferFile::ReadStaticArray(Double_t *d)
    if (!d) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy<sizeof(d[0])>(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1369,13 +1331,8 @@ void TBufferFile::ReadFastArray(Short_t *h, Int_t n)
    if (n <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
-   fBufCur += sizeof(Short_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy<sizeof(h[0])>(h, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(h, fBufCur, l);
    fBufCur += l;
@@ -1391,13 +1348,8 @@ void TBufferFile::ReadFastArray(Int_t *ii, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
-   fBufCur += sizeof(Int_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy<sizeof(ii[0])>(ii, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ii, fBufCur, l);
    fBufCur += l;
@@ -1429,8 +1381,8 @@ void TBufferFile::ReadFastArray(Long64_t *ll, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy<sizeof(ll[0])>(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1446,13 +1398,8 @@ void TBufferFile::ReadFastArray(Float_t *f, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
-   fBufCur += sizeof(Float_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy<sizeof(f[0])>(f, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(f, fBufCur, l);
    fBufCur += l;
@@ -1468,14 +1415,131 @@ void TBufferFile::ReadFastArray(Double_t *d, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy<sizeof(d[0])>(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
 #endif
 }
 
+namespace {
+
+// Number of values converted at once by the Float16_t and Double32_t array conversions
+const Int_t kConvertChunk = 256;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert n Float16_t or Double32_t values, stored as integers normalised to a
+/// range, from the buffer. The integers are byte swapped in bulk.
+
+template <typename T>
+void ReadArrayWithFactor(const char *src, T *ptr, Int_t n, Double_t factor, Double_t minvalue)
+{
+   UInt_t aint[kConvertChunk];
+   for (Int_t first = 0; first < n; first += kConvertChunk) {
+      const Int_t m = n - first < kConvertChunk ? n - first : kConvertChunk;
+      ROOT::Internal::FromBigEndianArray(aint, src + sizeof(UInt_t) * first, m, sizeof(UInt_t));
+      for (Int_t j = 0; j < m; ++j)
+         ptr[first + j] = (T)(aint[j] / factor + minvalue);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert n Float16_t or Double32_t values, stored as an exponent and a mantissa
+/// truncated to nbits (see TBufferFile::WriteFloat16), from the buffer.
+
+template <typename T>
+void ReadArrayWithNbits(const char *src, T *ptr, Int_t n, Int_t nbits)
+{
+   const Int_t manMask = (1 << (nbits + 1)) - 1;
+   const Int_t signBit = 1 << (nbits + 1);
+   for (Int_t i = 0; i < n; ++i, src += 3) {
+      const UChar_t theExp = (UChar_t)src[0];
+      const UShort_t theMan = (UShort_t)(((UChar_t)src[1] << 8) | (UChar_t)src[2]);
+      const Int_t intValue = ((Int_t)theExp << 23) | ((theMan & manMask) << (23 - nbits));
+      Float_t floatValue;
+      memcpy(&floatValue, &intValue, sizeof(Float_t));
+      if (theMan & signBit)
+         floatValue = -floatValue;
+      ptr[i] = (T)floatValue;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert n doubles stored as floats from the buffer.
+
+void ReadArrayAsFloat(const char *src, Double_t *ptr, Int_t n)
+{
+   Float_t afloat[kConvertChunk];
+   for (Int_t first = 0; first < n; first += kConvertChunk) {
+      const Int_t m = n - first < kConvertChunk ? n - first : kConvertChunk;
+      ROOT::Internal::FromBigEndianArray(afloat, src + sizeof(Float_t) * first, m, sizeof(Float_t));
+      for (Int_t j = 0; j < m; ++j)
+         ptr[first + j] = afloat[j];
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store n Float16_t or Double32_t values as integers normalised to the range
+/// [xmin, xmax] into the buffer. The integers are byte swapped in bulk.
+
+template <typename T>
+void WriteArrayWithFactor(char *dst, const T *ptr, Int_t n, Double_t factor, Double_t xmin, Double_t xmax)
+{
+   UInt_t aint[kConvertChunk];
+   for (Int_t first = 0; first < n; first += kConvertChunk) {
+      const Int_t m = n - first < kConvertChunk ? n - first : kConvertChunk;
+      for (Int_t j = 0; j < m; ++j) {
+         T x = ptr[first + j];
+         if (x < xmin) x = xmin;
+         if (x > xmax) x = xmax;
+         aint[j] = UInt_t(0.5 + factor * (x - xmin));
+      }
+      ROOT::Internal::ToBigEndianArray(dst + sizeof(UInt_t) * first, aint, m, sizeof(UInt_t));
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store n Float16_t or Double32_t values as an exponent and a mantissa truncated
+/// to nbits (see TBufferFile::WriteFloat16) into the buffer.
+
+template <typename T>
+void WriteArrayWithNbits(char *dst, const T *ptr, Int_t n, Int_t nbits)
+{
+   for (Int_t i = 0; i < n; ++i, dst += 3) {
+      const Float_t floatValue = (Float_t)ptr[i];
+      Int_t intValue;
+      memcpy(&intValue, &floatValue, sizeof(Float_t));
+      const UChar_t theExp = (UChar_t)(0x000000ff & ((intValue << 1) >> 24));
+      UShort_t theMan = ((1 << (nbits + 1)) - 1) & (intValue >> (23 - nbits - 1));
+      theMan++;
+      theMan = theMan >> 1;
+      if (theMan & 1 << nbits)
+         theMan = (1 << nbits) - 1;
+      if (floatValue < 0)
+         theMan |= 1 << (nbits + 1);
+      dst[0] = (char)theExp;
+      dst[1] = (char)(theMan >> 8);
+      dst[2] = (char)(theMan & 0xff);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store n doubles as floats into the buffer.
+
+void WriteArrayAsFloat(char *dst, const Double_t *ptr, Int_t n)
+{
+   Float_t afloat[kConvertChunk];
+   for (Int_t first = 0; first < n; first += kConvertChunk) {
+      const Int_t m = n - first < kConvertChunk ? n - first : kConvertChunk;
+      for (Int_t j = 0; j < m; ++j)
+         afloat[j] = (Float_t)ptr[first + j];
+      ROOT::Internal::ToBigEndianArray(dst + sizeof(Float_t) * first, afloat, m, sizeof(Float_t));
+   }
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read array of n floats (written as truncated float) from the I/O buffer.
 /// see comments about Float16_t encoding at TBufferFile::WriteFloat16
@@ -1486,33 +1550,9 @@ void TBufferFile::ReadFastArrayFloat16(Float_t *f, Int_t n, TStreamerElement *el
 
    if (ele && ele->GetFactor() != 0) {
       //a range was specified. We read an integer and convert it back to a float
-      Double_t xmin = ele->GetXmin();
-      Double_t factor = ele->GetFactor();
-      for (int j=0;j < n; j++) {
-         UInt_t aint; *this >> aint; f[j] = (Float_t)(aint/factor + xmin);
-      }
+      TBufferFile::ReadFastArrayWithFactor(f, n, ele->GetFactor(), ele->GetXmin());
    } else {
-      Int_t i;
-      Int_t nbits = 0;
-      if (ele) nbits = (Int_t)ele->GetXmin();
-      if (!nbits) nbits = 12;
-      //we read the exponent and the truncated mantissa of the float
-      //and rebuild the new float.
-      union {
-         Float_t fFloatValue;
-         Int_t   fIntValue;
-      };
-      UChar_t  theExp;
-      UShort_t theMan;
-      for (i = 0; i < n; i++) {
-         *this >> theExp;
-         *this >> theMan;
-         fIntValue = theExp;
-         fIntValue <<= 23;
-         fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-         if(1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-         f[i] = fFloatValue;
-      }
+      TBufferFile::ReadFastArrayWithNbits(f, n, ele ? (Int_t)ele->GetXmin() : 0);
    }
 }
 
@@ -1525,9 +1565,8 @@ void TBufferFile::ReadFastArrayWithFactor(Float_t *ptr, Int_t n, Double_t factor
    if (n <= 0 || 3*n > fBufSize) return;
 
    //a range was specified. We read an integer and convert it back to a float
-   for (int j=0;j < n; j++) {
-      UInt_t aint; *this >> aint; ptr[j] = (Float_t)(aint/factor + minvalue);
-   }
+   ReadArrayWithFactor(fBufCur, ptr, n, factor, minvalue);
+   fBufCur += sizeof(UInt_t)*n;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1541,21 +1580,8 @@ void TBufferFile::ReadFastArrayWithNbits(Float_t *ptr, Int_t n, Int_t nbits)
    if (!nbits) nbits = 12;
    //we read the exponent and the truncated mantissa of the float
    //and rebuild the new float.
-   union {
-      Float_t fFloatValue;
-      Int_t   fIntValue;
-   };
-   UChar_t  theExp;
-   UShort_t theMan;
-   for (Int_t i = 0; i < n; i++) {
-      *this >> theExp;
-      *this >> theMan;
-      fIntValue = theExp;
-      fIntValue <<= 23;
-      fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-      if(1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-      ptr[i] = fFloatValue;
-   }
+   ReadArrayWithNbits(fBufCur, ptr, n, nbits);
+   fBufCur += 3*n;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1568,41 +1594,9 @@ void TBufferFile::ReadFastArrayDouble32(Double_t *d, Int_t n, TStreamerElement *
 
    if (ele && ele->GetFactor() != 0) {
       //a range was specified. We read an integer and convert it back to a double.
-      Double_t xmin = ele->GetXmin();
-      Double_t factor = ele->GetFactor();
-      for (int j=0;j < n; j++) {
-         UInt_t aint; *this >> aint; d[j] = (Double_t)(aint/factor + xmin);
-      }
+      TBufferFile::ReadFastArrayWithFactor(d, n, ele->GetFactor(), ele->GetXmin());
    } else {
-      Int_t i;
-      Int_t nbits = 0;
-      if (ele) nbits = (Int_t)ele->GetXmin();
-      if (!nbits) {
-         //we read a float and convert it to double
-         Float_t afloat;
-         for (i = 0; i < n; i++) {
-            *this >> afloat;
-            d[i] = (Double_t)afloat;
-         }
-      } else {
-         //we read the exponent and the truncated mantissa of the float
-         //and rebuild the double.
-         union {
-            Float_t fFloatValue;
-            Int_t   fIntValue;
-         };
-         UChar_t  theExp;
-         UShort_t theMan;
-         for (i = 0; i < n; i++) {
-            *this >> theExp;
-            *this >> theMan;
-            fIntValue = theExp;
-            fIntValue <<= 23;
-            fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-            if (1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-            d[i] = (Double_t)fFloatValue;
-         }
-      }
+      TBufferFile::ReadFastArrayWithNbits(d, n, ele ? (Int_t)ele->GetXmin() : 0);
    }
 }
 
@@ -1615,9 +1609,8 @@ void TBufferFile::ReadFastArrayWithFactor(Double_t *d, Int_t n, Double_t factor,
    if (n <= 0 || 3*n > fBufSize) return;
 
    //a range was specified. We read an integer and convert it back to a double.
-   for (int j=0;j < n; j++) {
-      UInt_t aint; *this >> aint; d[j] = (Double_t)(aint/factor + minvalue);
-   }
+   ReadArrayWithFactor(fBufCur, d, n, factor, minvalue);
+   fBufCur += sizeof(UInt_t)*n;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1630,29 +1623,13 @@ void TBufferFile::ReadFastArrayWithNbits(Double_t *d, Int_t n, Int_t nbits)
 
    if (!nbits) {
       //we read a float and convert it to double
-      Float_t afloat;
-      for (Int_t i = 0; i < n; i++) {
-         *this >> afloat;
-         d[i] = (Double_t)afloat;
-      }
+      ReadArrayAsFloat(fBufCur, d, n);
+      fBufCur += sizeof(Float_t)*n;
    } else {
       //we read the exponent and the truncated mantissa of the float
       //and rebuild the double.
-      union {
-         Float_t fFloatValue;
-         Int_t   fIntValue;
-      };
-      UChar_t  theExp;
-      UShort_t theMan;
-      for (Int_t i = 0; i < n; i++) {
-         *this >> theExp;
-         *this >> theMan;
-         fIntValue = theExp;
-         fIntValue <<= 23;
-         fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-         if (1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-         d[i] = (Double_t)fFloatValue;
-      }
+      ReadArrayWithNbits(fBufCur, d, n, nbits);
+      fBufCur += 3*n;
    }
 }
 
@@ -1802,13 +1779,8 @@ void TBufferFile::WriteArray(const Short_t *h, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(fBufCur, h, n);
+   ROOT::Internal::ByteSwapCopy<sizeof(h[0])>(fBufCur, h, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
-# endif
 #else
    memcpy(fBufCur, h, l);
    fBufCur += l;
@@ -1832,13 +1804,8 @@ void TBufferFile::WriteArray(const Int_t *ii, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, ii, n);
+   ROOT::Internal::ByteSwapCopy<sizeof(ii[0])>(fBufCur, ii, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
-# endif
 #else
    memcpy(fBufCur, ii, l);
    fBufCur += l;
@@ -1900,8 +1867,8 @@ void TBufferFile::WriteArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ROOT::Internal::ByteSwapCopy<sizeof(ll[0])>(fBufCur, ll, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -1925,13 +1892,8 @@ void TBufferFile::WriteArray(const Float_t *f, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, f, n);
+   ROOT::Internal::ByteSwapCopy<sizeof(f[0])>(fBufCur, f, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
-# endif
 #else
    memcpy(fBufCur, f, l);
    fBufCur += l;
@@ -1955,8 +1917,8 @@ void TBufferFile::WriteArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ROOT::Internal::ByteSwapCopy<sizeof(d[0])>(fBufCur, d, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -2068,13 +2030,8 @@ void TBufferFile::WriteFastArray(const Short_t *h, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(fBufCur, h, n);
+   ROOT::Internal::ByteSwapCopy<sizeof(h[0])>(fBufCur, h, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
-# endif
 #else
    memcpy(fBufCur, h, l);
    fBufCur += l;
@@ -2092,13 +2049,8 @@ void TBufferFile::WriteFastArray(const Int_t *ii, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, ii, n);
+   ROOT::Internal::ByteSwapCopy<sizeof(ii[0])>(fBufCur, ii, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
-# endif
 #else
    memcpy(fBufCur, ii, l);
    fBufCur += l;
@@ -2144,8 +2096,8 @@ void TBufferFile::WriteFastArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ROOT::Internal::ByteSwapCopy<sizeof(ll[0])>(fBufCur, ll, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -2163,13 +2115,8 @@ void TBufferFile::WriteFastArray(const Float_t *f, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, f, n);
+   ROOT::Internal::ByteSwapCopy<sizeof(f[0])>(fBufCur, f, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
-# endif
 #else
    memcpy(fBufCur, f, l);
    fBufCur += l;
@@ -2187,8 +2134,8 @@ void TBufferFile::WriteFastArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ROOT::Internal::ByteSwapCopy<sizeof(d[0])>(fBufCur, d, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -2210,39 +2157,18 @@ void TBufferFile::WriteFastArrayFloat16(const Float_t *f, Int_t n, TStreamerElem
       //A range is specified. We normalize the float to the range and
       //convert it to an integer using a scaling factor that is a function of nbits.
       //see TStreamerElement::GetRange.
-      Double_t factor = ele->GetFactor();
-      Double_t xmin = ele->GetXmin();
-      Double_t xmax = ele->GetXmax();
-      for (int j = 0; j < n; j++) {
-         Float_t x = f[j];
-         if (x < xmin) x = xmin;
-         if (x > xmax) x = xmax;
-         UInt_t aint = UInt_t(0.5+factor*(x-xmin)); *this << aint;
-      }
+      WriteArrayWithFactor(fBufCur, f, n, ele->GetFactor(), ele->GetXmin(), ele->GetXmax());
+      fBufCur += sizeof(UInt_t)*n;
    } else {
       Int_t nbits = 0;
       //number of bits stored in fXmin (see TStreamerElement::GetRange)
       if (ele) nbits = (Int_t)ele->GetXmin();
       if (!nbits) nbits = 12;
-      Int_t i;
       //a range is not specified, but nbits is.
       //In this case we truncate the mantissa to nbits and we stream
       //the exponent as a UChar_t and the mantissa as a UShort_t.
-      union {
-         Float_t fFloatValue;
-         Int_t   fIntValue;
-      };
-      for (i = 0; i < n; i++) {
-         fFloatValue = f[i];
-         UChar_t  theExp = (UChar_t)(0x000000ff & ((fIntValue<<1)>>24));
-         UShort_t theMan = ((1<<(nbits+1))-1) & (fIntValue>>(23-nbits-1));
-         theMan++;
-         theMan = theMan>>1;
-         if (theMan&1<<nbits) theMan = (1<<nbits) - 1;
-         if (fFloatValue < 0) theMan |= 1<<(nbits+1);
-         *this << theExp;
-         *this << theMan;
-      }
+      WriteArrayWithNbits(fBufCur, f, n, nbits);
+      fBufCur += 3*n;
    }
 }
 
@@ -2261,45 +2187,22 @@ void TBufferFile::WriteFastArrayDouble32(const Double_t *d, Int_t n, TStreamerEl
       //A range is specified. We normalize the double to the range and
       //convert it to an integer using a scaling factor that is a function of nbits.
       //see TStreamerElement::GetRange.
-      Double_t factor = ele->GetFactor();
-      Double_t xmin = ele->GetXmin();
-      Double_t xmax = ele->GetXmax();
-      for (int j = 0; j < n; j++) {
-         Double_t x = d[j];
-         if (x < xmin) x = xmin;
-         if (x > xmax) x = xmax;
-         UInt_t aint = UInt_t(0.5+factor*(x-xmin)); *this << aint;
-      }
+      WriteArrayWithFactor(fBufCur, d, n, ele->GetFactor(), ele->GetXmin(), ele->GetXmax());
+      fBufCur += sizeof(UInt_t)*n;
    } else {
       Int_t nbits = 0;
       //number of bits stored in fXmin (see TStreamerElement::GetRange)
       if (ele) nbits = (Int_t)ele->GetXmin();
-      Int_t i;
       if (!nbits) {
          //if no range and no bits specified, we convert from double to float
-         for (i = 0; i < n; i++) {
-            Float_t afloat = (Float_t)d[i];
-            *this << afloat;
-         }
+         WriteArrayAsFloat(fBufCur, d, n);
+         fBufCur += sizeof(Float_t)*n;
       } else {
          //a range is not specified, but nbits is.
          //In this case we truncate the mantissa to nbits and we stream
          //the exponent as a UChar_t and the mantissa as a UShort_t.
-         union {
-            Float_t fFloatValue;
-            Int_t   fIntValue;
-         };
-         for (i = 0; i < n; i++) {
-            fFloatValue = (Float_t)d[i];
-            UChar_t  theExp = (UChar_t)(0x000000ff & ((fIntValue<<1)>>24));
-            UShort_t theMan = ((1<<(nbits+1))-1) & (fIntValue>>(23-nbits-1));
-            theMan++;
-            theMan = theMan>>1;
-            if(theMan&1<<nbits) theMan = (1<<nbits) - 1;
-            if (fFloatValue < 0) theMan |= 1<<(nbits+1);
-            *this << theExp;
-            *this << theMan;
-         }
+         WriteArrayWithNbits(fBufCur, d, n, nbits);
+         fBufCur += 3*n;
       }
    }
 }
@@ -3429,16 +3332,19 @@ void TBufferFile::MapObject(const void *obj, const TClass* cl, UInt_t offset)
 /// small objects the map does not need to be resized too often
 /// (the system is always dynamic, even with the default everything
 /// will work, only the initial resizing will cost some time).
-/// This method can only be called directly after the creation of
-/// the TBuffer, before any reading is done. Globally this option
-/// can be changed using SetGlobalReadParam().
+/// If the map already exists, for instance when the buffer is reused for
+/// the next event, it is enlarged to mapsize instead; the maps keep their
+/// size when they are reset, so mapsize is typically the size needed by a
+/// previous event. Globally this option can be changed using
+/// SetGlobalReadParam().
 
 void TBufferFile::SetReadParam(Int_t mapsize)
 {
    R__ASSERT(IsReading());
-   R__ASSERT(fMap == 0);
 
    fMapSize = mapsize;
+   if (fMap && fMap->Capacity() < mapsize) fMap->Expand(mapsize);
+   if (fClassMap && fClassMap->Capacity() < mapsize) fClassMap->Expand(mapsize);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3449,16 +3355,16 @@ void TBufferFile::SetReadParam(Int_t mapsize)
 /// (the system is always dynamic, even with the default everything
 /// will work, only a large number of collisions will cost performance).
 /// For optimal performance hashsize should always be a prime.
-/// This method can only be called directly after the creation of
-/// the TBuffer, before any writing is done. Globally this option
-/// can be changed using SetGlobalWriteParam().
+/// If the map already exists, it is enlarged to mapsize instead, see
+/// SetReadParam(). Globally this option can be changed using
+/// SetGlobalWriteParam().
 
 void TBufferFile::SetWriteParam(Int_t mapsize)
 {
    R__ASSERT(IsWriting());
-   R__ASSERT(fMap == 0);
 
    fMapSize = mapsize;
+   if (fMap && fMap->Capacity() < mapsize) fMap->Expand(mapsize);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3491,7 +3397,9 @@ void TBufferFile::InitMap()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Delete existing fMap and reset map counter.
+/// Empty the existing fMap and reset map counter. The maps keep their size,
+/// and emptying them costs in proportion to the number of objects mapped
+/// since the previous reset when it is small, see TExMap::Delete().
 
 void TBufferFile::ResetMap()
 {
@@ -3805,7 +3713,11 @@ Int_t TBufferFile::ReadClassBuffer(const TClass *cl, void *pointer, Int_t versio
    }
 
    // Deserialize the object.
-   ApplySequence(*(sinfo->GetReadObjectWiseActions()), (char*)pointer);
+   TStreamerInfo::JitStreamerFunc_t jitRead = gDebug ? 0 : sinfo->GetJitReadFunc();
+   if (jitRead)
+      jitRead(*this, (char*)pointer);
+   else
+      ApplySequence(*(sinfo->GetReadObjectWiseActions()), (char*)pointer);
    if (sinfo->IsRecovered()) count=0;
 
    // Check that the buffer position corresponds to the byte count.
@@ -3946,7 +3858,11 @@ Int_t TBufferFile::ReadClassBuffer(const TClass *cl, void *pointer, const TClass
    }
 
    //deserialize the object
-   ApplySequence(*(sinfo->GetReadObjectWiseActions()), (char*)pointer );
+   TStreamerInfo::JitStreamerFunc_t jitRead = gDebug ? 0 : sinfo->GetJitReadFunc();
+   if (jitRead)
+      jitRead(*this, (char*)pointer);
+   else
+      ApplySequence(*(sinfo->GetReadObjectWiseActions()), (char*)pointer );
    if (sinfo->TStreamerInfo::IsRecovered()) R__c=0; // 'TStreamerInfo::' avoids going via a virtual function.
 
    // Check that the buffer position corresponds to the byte count.
@@ -3994,7 +3910,11 @@ Int_t TBufferFile::WriteClassBuffer(const TClass *cl, void *pointer)
 
    //NOTE: In the future Philippe wants this to happen via a custom action
    TagStreamerInfo(sinfo);
-   ApplySequence(*(sinfo->GetWriteObjectWiseActions()), (char*)pointer);
+   TStreamerInfo::JitStreamerFunc_t jitWrite = gDebug ? 0 : sinfo->GetJitWriteFunc();
+   if (jitWrite)
+      jitWrite(*this, (char*)pointer);
+   else
+      ApplySequence(*(sinfo->GetWriteObjectWiseActions()), (char*)pointer);
 
 
    //write the byte count at the start of the buffer
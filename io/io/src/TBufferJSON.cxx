@@ -36,6 +36,15 @@ To reconstruct object from the JSON string, one should do:
    TBufferJSON::FromJSON(hnew, json);
    if (hnew) hnew->Draw("hist");
 ~~~
+Large objects, e.g. the histograms served by THttpServer, can be converted
+without building the whole JSON code in memory: TBufferJSON::StreamToJSON
+passes the JSON code by chunks to a sink function, and the compact value 30
+writes the numeric arrays as their binary representation encoded in base64:
+~~~{.cpp}
+   std::ofstream out("h2.json");
+   TBufferJSON::StreamToJSON(h2, [&out](const char *chunk, Int_t len) { out.write(chunk, len); }, 33);
+~~~
+
 JSON data does not include stored class version, therefore schema evolution
 (reading of older class versions) is not supported. JSON should not be used as
 persistent storage for object data - only for live applications.
@@ -44,6 +53,7 @@ persistent storage for object data - only for live applications.
 
 #include "TBufferJSON.h"
 
+#include <algorithm>
 #include <typeinfo>
 #include <string>
 #include <string.h>
@@ -72,6 +82,7 @@ persistent storage for object data - only for live applications.
 #include "TClonesArray.h"
 #include "TVirtualMutex.h"
 #include "TInterpreter.h"
+#include "TBase64.h"
 
 #include "json.hpp"
 
@@ -366,7 +377,7 @@ public:
 
 TBufferJSON::TBufferJSON(TBuffer::EMode mode)
    : TBufferText(mode), fOutBuffer(), fOutput(nullptr), fValue(), fJsonrCnt(0), fStack(), fCompact(0),
-     fSemicolon(" : "), fArraySepar(", "), fNumericLocale()
+     fSemicolon(" : "), fArraySepar(", "), fNumericLocale(), fSink(), fChunkSize(0), fSinkBytes(0)
 {
    fOutBuffer.Capacity(10000);
    fValue.Capacity(1000);
@@ -406,6 +417,7 @@ TBufferJSON::~TBufferJSON()
 ///  - 0 - no compression, standard JSON array
 ///  - 1 - exclude leading, trailing zeros, required JSROOT v5
 ///  - 2 - check values repetition and empty gaps, required JSROOT v5
+///  - 3 - binary representation of the numeric arrays, encoded in base64
 ///
 /// Maximal compression achieved when compact parameter equal to 23
 /// When member_name specified, converts only this data member
@@ -438,6 +450,7 @@ TString TBufferJSON::ConvertToJSON(const TObject *obj, Int_t compact, const char
 //  - 0 - no compression, standard JSON array
 //  - 1 - exclude leading, trailing zeros, required JSROOT v5
 //  - 2 - check values repetition and empty gaps, required JSROOT v5
+//  - 3 - binary representation of the numeric arrays, encoded in base64
 
 void TBufferJSON::SetCompact(int level)
 {
@@ -459,6 +472,7 @@ void TBufferJSON::SetCompact(int level)
 ///  - 0 - no compression, standard JSON array
 ///  - 1 - exclude leading, trailing zeros, required JSROOT v5
 ///  - 2 - check values repetition and empty gaps, required JSROOT v5
+///  - 3 - binary representation of the numeric arrays, encoded in base64
 ///
 /// Maximal compression achieved when compact parameter equal to 23
 /// When member_name specified, converts only this data member
@@ -520,6 +534,85 @@ TString TBufferJSON::ConvertToJSON(const void *obj, const TClass *cl, Int_t comp
    return buf.fOutBuffer.Length() ? buf.fOutBuffer : buf.fValue;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Converts object, inherited from TObject class, to JSON and passes the JSON
+/// code to the sink function by chunks of about chunksize bytes, instead of
+/// returning it as a single string. See StreamToJSON(const void *, const TClass *, ...)
+
+Long64_t TBufferJSON::StreamToJSON(const TObject *obj, const Sink_t &sink, Int_t compact, Int_t chunksize)
+{
+   TClass *clActual = nullptr;
+   void *ptr = (void *)obj;
+
+   if (obj) {
+      clActual = TObject::Class()->GetActualClass(obj);
+      if (!clActual)
+         clActual = TObject::Class();
+      else if (clActual != TObject::Class())
+         ptr = (void *)((Long_t)obj - clActual->GetBaseClassOffset(TObject::Class()));
+   }
+
+   return StreamToJSON(ptr, clActual, sink, compact, chunksize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Converts any type of object to JSON and passes the JSON code to the sink
+/// function by chunks, as soon as the output exceeds chunksize bytes.
+/// The concatenation of the chunks is the string returned by ConvertToJSON().
+/// Only the JSON code of the single largest member, e.g. the array of bin
+/// contents of a histogram, is kept in memory at once.
+/// The compact parameter has the same meaning as in ConvertToJSON().
+/// Returns the total number of bytes passed to the sink.
+
+Long64_t TBufferJSON::StreamToJSON(const void *obj, const TClass *cl, const Sink_t &sink, Int_t compact,
+                                   Int_t chunksize)
+{
+   if (!sink)
+      return 0;
+
+   TClass *clActual = obj ? cl->GetActualClass(obj) : nullptr;
+   const void *actualStart = obj;
+   if (clActual && (clActual != cl)) {
+      actualStart = (char *)obj - clActual->GetBaseClassOffset(cl);
+   } else {
+      clActual = const_cast<TClass *>(cl);
+   }
+
+   TBufferJSON buf;
+
+   buf.SetCompact(compact);
+   buf.fSink = sink;
+   buf.fChunkSize = chunksize > 0 ? chunksize : 1;
+
+   buf.InitMap();
+
+   buf.PushStack(0); // dummy stack entry to avoid extra checks in the beginning
+
+   buf.JsonWriteObject(actualStart, clActual);
+
+   buf.PopStack();
+
+   if ((buf.fSinkBytes == 0) && (buf.fOutBuffer.Length() == 0) && (buf.fValue.Length() > 0)) {
+      sink(buf.fValue.Data(), buf.fValue.Length());
+      buf.fSinkBytes = buf.fValue.Length();
+   }
+   buf.FlushSink();
+
+   return buf.fSinkBytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Pass the content of the main output buffer to the sink function, if any
+
+void TBufferJSON::FlushSink()
+{
+   if (!fSink || (fOutBuffer.Length() == 0))
+      return;
+   fSink(fOutBuffer.Data(), fOutBuffer.Length());
+   fSinkBytes += fOutBuffer.Length();
+   fOutBuffer.Clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Converts selected data member into json
 /// Parameter ptr specifies address in memory, where data member is located
@@ -960,6 +1053,9 @@ void TBufferJSON::AppendOutput(const char *line0, const char *line1)
          fOutput->Append(line1);
       }
    }
+
+   if (fSink && (fOutput == &fOutBuffer) && (fOutBuffer.Length() >= fChunkSize))
+      FlushSink();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2437,6 +2533,20 @@ R__ALWAYS_INLINE void TBufferJSON::JsonReadFastArray(T *arr, Int_t arrsize, bool
          Error("ReadFastArray", "Mismatch compressed array size %d %d", arrsize, json->at("len").get<int>());
       for (int cnt = 0; cnt < arrsize; ++cnt)
          arr[cnt] = 0;
+      if (json->count("b") == 1) {
+         // binary representation, encoded in base64
+         int p = (json->count("p") == 1) ? json->at("p").get<int>() : 0;
+         TString data = TBase64::Decode(json->at("b").get<std::string>().c_str());
+         int n = std::min(arrsize - p, (int)(data.Length() / sizeof(T)));
+         if (n < 0)
+            n = 0;
+         memcpy((char *)(arr + p), data.Data(), n * sizeof(T));
+#ifndef R__BYTESWAP
+         for (int cnt = p; cnt < p + n; ++cnt)
+            std::reverse((char *)(arr + cnt), (char *)(arr + cnt) + sizeof(T));
+#endif
+         return;
+      }
       int p = 0, id = 0;
       std::string idname = "", pname, vname, nname;
       while (p < arrsize) {
@@ -2669,10 +2779,47 @@ void TBufferJSON::ReadFastArray(void **start, const TClass *cl, Int_t n, Bool_t
    stack->fNode = topnode;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write array as its little-endian binary representation, encoded in base64,
+/// skipping the leading and trailing zeros, like
+/// `{"$arr":"Float64","len":100,"p":10,"b":"..."}`
+
+template <typename T>
+void TBufferJSON::JsonWriteArrayBase64(const T *vname, Int_t arrsize, const char *typname)
+{
+   fValue.Append("{");
+   fValue.Append(TString::Format("\"$arr\":\"%s\"%s\"len\":%d", typname, fArraySepar.Data(), arrsize));
+   Int_t aindx(0), bindx(arrsize);
+   while ((aindx < arrsize) && (vname[aindx] == 0))
+      aindx++;
+   while ((aindx < bindx) && (vname[bindx - 1] == 0))
+      bindx--;
+   if (aindx < bindx) {
+      if (aindx > 0)
+         fValue.Append(TString::Format("%s\"p\":%d", fArraySepar.Data(), aindx));
+      const char *data = (const char *)(vname + aindx);
+      Int_t len = (bindx - aindx) * sizeof(T);
+#ifndef R__BYTESWAP
+      // big-endian host, the encoded representation is little-endian
+      std::string swapped(data, len);
+      for (Int_t k = 0; k < len; k += sizeof(T))
+         std::reverse(&swapped[k], &swapped[k] + sizeof(T));
+      data = swapped.data();
+#endif
+      fValue.Append(fArraySepar);
+      fValue.Append("\"b\":\"");
+      fValue.Append(TBase64::Encode(data, len));
+      fValue.Append("\"");
+   }
+   fValue.Append("}");
+}
+
 template <typename T>
 R__ALWAYS_INLINE void TBufferJSON::JsonWriteArrayCompress(const T *vname, Int_t arrsize, const char *typname)
 {
-   if ((fCompact < 10) || (arrsize < 6)) {
+   if ((fCompact >= 30) && (fCompact < 40) && (arrsize >= 6)) {
+      JsonWriteArrayBase64(vname, arrsize, typname);
+   } else if ((fCompact < 10) || (arrsize < 6)) {
       fValue.Append("[");
       for (Int_t indx = 0; indx < arrsize; indx++) {
          if (indx > 0)
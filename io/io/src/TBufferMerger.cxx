@@ -14,9 +14,28 @@
 #include "TBufferFile.h"
 #include "TError.h"
 #include "TFileMerger.h"
+#include "TPerfCounters.h"
 #include "TROOT.h"
+#include "TTimelineTracer.h"
 #include "TVirtualMutex.h"
 
+#include <algorithm>
+
+namespace {
+
+// Buffers pushed and not yet taken by a merging thread, and their bytes.
+void AddToQueueCounters(Long64_t buffers, Long64_t bytes)
+{
+   static const auto queueBuffers = ROOT::TPerfCounters::Register(
+      "root_tbuffermerger_queue_buffers", "Buffers waiting in the queues of the TBufferMergers", ROOT::TPerfCounters::kGauge);
+   static const auto queueBytes = ROOT::TPerfCounters::Register(
+      "root_tbuffermerger_queue_bytes", "Bytes waiting in the queues of the TBufferMergers", ROOT::TPerfCounters::kGauge);
+   queueBuffers.Add(buffers);
+   queueBytes.Add(bytes);
+}
+
+} // anonymous namespace
+
 namespace ROOT {
 namespace Experimental {
 
@@ -40,6 +59,11 @@ void TBufferMerger::Init(std::unique_ptr<TFile> output)
 {
    fFile = output.release();
    fAutoSave = 0;
+   fMaxQueueSize = 0;
+   fPeakQueueSize = 0;
+   fNMerged = 0;
+   fTotalLatency = 0.;
+   fMaxLatency = 0.;
    fMergingThread.reset(new std::thread([&]() { this->WriteOutputFile(); }));
 }
 
@@ -63,9 +87,49 @@ std::shared_ptr<TBufferMergerFile> TBufferMerger::GetFile()
 
 size_t TBufferMerger::GetQueueSize() const
 {
+   std::lock_guard<std::mutex> lock(fQueueMutex);
    return fQueue.size();
 }
 
+size_t TBufferMerger::GetMaxQueueSize() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fMaxQueueSize;
+}
+
+void TBufferMerger::SetMaxQueueSize(size_t size)
+{
+   {
+      std::lock_guard<std::mutex> lock(fQueueMutex);
+      fMaxQueueSize = size;
+   }
+   fSpaceAvailable.notify_all();
+}
+
+size_t TBufferMerger::GetPeakQueueSize() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fPeakQueueSize;
+}
+
+size_t TBufferMerger::GetNMergedBuffers() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fNMerged;
+}
+
+double TBufferMerger::GetMeanMergeLatency() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fNMerged ? fTotalLatency / fNMerged : 0.;
+}
+
+double TBufferMerger::GetMaxMergeLatency() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fMaxLatency;
+}
+
 void TBufferMerger::RegisterCallback(const std::function<void(void)> &f)
 {
    fCallback = f;
@@ -73,13 +137,35 @@ void TBufferMerger::RegisterCallback(const std::function<void(void)> &f)
 
 void TBufferMerger::Push(TBufferFile *buffer)
 {
+   // Includes the wait for space in the queue.
+   ROOT::TTimelineTracer::TSpan span("io", "TBufferMerger::Push", "bytes", buffer ? buffer->Length() : 0);
    {
-      std::lock_guard<std::mutex> lock(fQueueMutex);
-      fQueue.push(buffer);
+      std::unique_lock<std::mutex> lock(fQueueMutex);
+      // The end of input marker (nullptr) is never held back.
+      if (buffer)
+         fSpaceAvailable.wait(lock, [this]() { return !fMaxQueueSize || fQueue.size() < fMaxQueueSize; });
+      // Counted before the merging thread can take it.
+      if (buffer)
+         AddToQueueCounters(1, buffer->Length());
+      fQueue.emplace(buffer, Clock_t::now());
+      fPeakQueueSize = std::max(fPeakQueueSize, fQueue.size());
    }
    fDataAvailable.notify_one();
 }
 
+void TBufferMerger::RecordMerged(std::vector<Clock_t::time_point> &pushTimes)
+{
+   const auto now = Clock_t::now();
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   for (const auto &pushTime : pushTimes) {
+      const double latency = std::chrono::duration<double>(now - pushTime).count();
+      fTotalLatency += latency;
+      fMaxLatency = std::max(fMaxLatency, latency);
+   }
+   fNMerged += pushTimes.size();
+   pushTimes.clear();
+}
+
 size_t TBufferMerger::GetAutoSave() const
 {
    return fAutoSave;
@@ -96,8 +182,12 @@ void TBufferMerger::WriteOutputFile()
    TFileMerger merger;
    std::unique_ptr<TBufferFile> buffer;
    std::vector<std::unique_ptr<TMemFile>> memfiles;
+   std::vector<Clock_t::time_point> pushTimes;
+   // The baskets were compressed by the writing threads, copy them as they are.
+   const Int_t mergeType = TFileMerger::kAllIncremental | TFileMerger::kKeepCompression;
 
    merger.ResetBit(kMustCleanup);
+   ROOT::TTimelineTracer::SetThreadName("TBufferMerger");
 
    {
       R__LOCKGUARD(gROOTMutex);
@@ -108,12 +198,16 @@ void TBufferMerger::WriteOutputFile()
       std::unique_lock<std::mutex> lock(fQueueMutex);
       fDataAvailable.wait(lock, [this]() { return !this->fQueue.empty(); });
 
-      buffer.reset(fQueue.front());
+      buffer.reset(fQueue.front().first);
+      if (buffer)
+         pushTimes.push_back(fQueue.front().second);
       fQueue.pop();
       lock.unlock();
+      fSpaceAvailable.notify_one();
 
       if (!buffer)
          break;
+      AddToQueueCounters(-1, -buffer->Length());
 
       Long64_t length;
       buffer->SetReadMode();
@@ -125,10 +219,12 @@ void TBufferMerger::WriteOutputFile()
       merger.AddFile(memfiles.back().get(), false);
 
       if (buffered > fAutoSave) {
+         ROOT::TTimelineTracer::TSpan span("io", "TBufferMerger merge", "files", memfiles.size());
          buffered = 0;
-         merger.PartialMerge();
+         merger.PartialMerge(mergeType);
          merger.Reset();
          memfiles.clear();
+         RecordMerged(pushTimes);
       }
 
       if (fCallback)
@@ -136,8 +232,10 @@ void TBufferMerger::WriteOutputFile()
    }
 
    R__LOCKGUARD(gROOTMutex);
-   merger.PartialMerge();
+   ROOT::TTimelineTracer::TSpan span("io", "TBufferMerger merge", "files", memfiles.size());
+   merger.PartialMerge(mergeType);
    merger.Reset();
+   RecordMerged(pushTimes);
 }
 
 } // namespace Experimental
@@ -10,6 +10,7 @@
  *************************************************************************/
 
 #include "ROOT/TBufferMerger.hxx"
+#include "ROOT/TBufferPool.hxx"
 
 #include "TArrayC.h"
 #include "TBufferFile.h"
@@ -31,7 +32,8 @@ Int_t TBufferMergerFile::Write(const char *name, Int_t opt, Int_t bufsize)
    Int_t nbytes = TMemFile::Write(name, opt, bufsize);
 
    if (nbytes) {
-      TBufferFile *fBuffer = new TBufferFile(TBuffer::kWrite);
+      // Sized for the whole file, so that it is not expanded while copied
+      TBufferFile *fBuffer = ROOT::Internal::TBufferPool::NewBuffer(TBuffer::kWrite, GetEND() + sizeof(Long64_t));
 
       fBuffer->WriteLong64(GetEND());
       CopyTo(*fBuffer);
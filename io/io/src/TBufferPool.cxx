@@ -0,0 +1,364 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TBufferPool.hxx"
+
+#include "TBufferFile.h"
+#include "TPerfCounters.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using ROOT::Internal::TBufferPool;
+
+namespace {
+
+const Int_t kMinClassBits = 12;                // The smallest class holds 4 kB
+const Int_t kNClasses = 16;                    // The largest class holds 128 MB
+const Int_t kUnpooled = -1;                    // Class of the buffers too large for the pool
+const std::size_t kLocalBytes = 8 * 1024 * 1024; // Bytes of a class kept by a thread
+const std::size_t kMaxLocalBuffers = 16;         // Buffers of a class kept by a thread
+// In write mode, TBuffer keeps a few bytes at the end of its memory.
+const Int_t kWriteExtraSpace = 16;
+
+// Stored in front of every buffer; its size keeps the buffers aligned as the
+// ones returned by new char[].
+struct THeader {
+   Int_t fClass;
+   std::size_t fCapacity;
+};
+const std::size_t kHeaderSize = 16;
+static_assert(sizeof(THeader) <= kHeaderSize, "the header of the buffers does not fit");
+
+THeader &GetHeader(char *buffer)
+{
+   return *reinterpret_cast<THeader *>(buffer - kHeaderSize);
+}
+
+std::size_t ClassSize(Int_t cls)
+{
+   return std::size_t(1) << (cls + kMinClassBits);
+}
+
+Int_t ClassOf(std::size_t size)
+{
+   for (Int_t cls = 0; cls < kNClasses; ++cls) {
+      if (ClassSize(cls) >= size)
+         return cls;
+   }
+   return kUnpooled;
+}
+
+std::size_t LocalLimit(Int_t cls)
+{
+   return std::max<std::size_t>(1, std::min(kMaxLocalBuffers, kLocalBytes / ClassSize(cls)));
+}
+
+struct TCounters {
+   ROOT::TPerfCounters::TCounter fAcquired =
+      ROOT::TPerfCounters::Register("root_buffer_pool_acquired_total", "I/O buffers acquired from the pool");
+   ROOT::TPerfCounters::TCounter fReused =
+      ROOT::TPerfCounters::Register("root_buffer_pool_reused_total", "I/O buffers acquired from the pool and reused");
+   ROOT::TPerfCounters::TCounter fCachedBytes = ROOT::TPerfCounters::Register(
+      "root_buffer_pool_cached_bytes", "Bytes of the free I/O buffers kept by the pool", ROOT::TPerfCounters::kGauge);
+};
+
+const TCounters &GetCounters()
+{
+   static const TCounters counters;
+   return counters;
+}
+
+// The free buffers shared by the threads.
+struct TDepot {
+   std::mutex fMutex;
+   std::vector<char *> fFree[kNClasses];
+   Long64_t fBytes = 0;
+   Long64_t fMaxBytes = 64 * 1024 * 1024;
+};
+
+// Never deleted: the thread caches are flushed into it until the end of the process.
+TDepot &GetDepot()
+{
+   static TDepot *gDepot = new TDepot;
+   return *gDepot;
+}
+
+void FreeBlocks(const std::vector<char *> &blocks)
+{
+   for (char *block : blocks) {
+      GetCounters().fCachedBytes.Add(-Long64_t(ClassSize(GetHeader(block + kHeaderSize).fClass)));
+      delete[] block;
+   }
+}
+
+// Move the last n buffers of from into the depot, or free them if it is full.
+void GiveToDepot(Int_t cls, std::vector<char *> &from, std::size_t n)
+{
+   std::vector<char *> excess;
+   {
+      TDepot &depot = GetDepot();
+      std::lock_guard<std::mutex> lock(depot.fMutex);
+      for (std::size_t i = 0; i < n; ++i) {
+         char *block = from.back();
+         from.pop_back();
+         if (depot.fBytes + Long64_t(ClassSize(cls)) <= depot.fMaxBytes) {
+            depot.fFree[cls].push_back(block);
+            depot.fBytes += ClassSize(cls);
+         } else {
+            excess.push_back(block);
+         }
+      }
+   }
+   FreeBlocks(excess);
+}
+
+// The free buffers of one thread, only used by this thread.
+struct TThreadCache {
+   std::vector<char *> fFree[kNClasses];
+};
+
+thread_local TThreadCache *tCache = nullptr;
+thread_local bool tCacheGone = false;
+
+// Gives the buffers of the thread to the others when it ends.
+struct TThreadCacheFinalizer {
+   ~TThreadCacheFinalizer()
+   {
+      if (tCache) {
+         for (Int_t cls = 0; cls < kNClasses; ++cls)
+            GiveToDepot(cls, tCache->fFree[cls], tCache->fFree[cls].size());
+         delete tCache;
+         tCache = nullptr;
+      }
+      tCacheGone = true;
+   }
+};
+
+// Returns nullptr during the destruction of the thread.
+TThreadCache *GetThreadCache()
+{
+   if (R__unlikely(!tCache)) {
+      if (tCacheGone)
+         return nullptr;
+      thread_local TThreadCacheFinalizer finalizer;
+      (void)finalizer;
+      tCache = new TThreadCache;
+   }
+   return tCache;
+}
+
+// Take a buffer of the class from the depot, and a few more for the cache.
+char *TakeFromDepot(Int_t cls, TThreadCache *cache)
+{
+   TDepot &depot = GetDepot();
+   std::lock_guard<std::mutex> lock(depot.fMutex);
+   std::vector<char *> &free = depot.fFree[cls];
+   if (free.empty())
+      return nullptr;
+   char *block = free.back();
+   free.pop_back();
+   depot.fBytes -= ClassSize(cls);
+   if (cache) {
+      const std::size_t n = std::min(free.size(), LocalLimit(cls) / 2);
+      for (std::size_t i = 0; i < n; ++i) {
+         cache->fFree[cls].push_back(free.back());
+         free.pop_back();
+      }
+      depot.fBytes -= n * ClassSize(cls);
+   }
+   return block;
+}
+
+// A TBufferFile which gives its memory back to the pool when deleted.
+class TPooledBufferFile : public TBufferFile {
+public:
+   TPooledBufferFile(TBuffer::EMode mode, Int_t capacity, char *buffer)
+      : TBufferFile(mode, capacity, buffer, kFALSE, &TBufferPool::ReAllocChar)
+   {
+   }
+   ~TPooledBufferFile() { TBufferPool::ReleaseMemory(*this); }
+};
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a buffer of at least size bytes, to be given back with Release().
+
+char *TBufferPool::Acquire(std::size_t size)
+{
+   const TCounters &counters = GetCounters();
+   counters.fAcquired.Add();
+   const Int_t cls = ClassOf(std::max<std::size_t>(size, 1));
+   if (cls != kUnpooled) {
+      TThreadCache *cache = GetThreadCache();
+      char *block = nullptr;
+      if (cache && !cache->fFree[cls].empty()) {
+         block = cache->fFree[cls].back();
+         cache->fFree[cls].pop_back();
+      } else {
+         block = TakeFromDepot(cls, cache);
+      }
+      if (block) {
+         counters.fReused.Add();
+         counters.fCachedBytes.Add(-Long64_t(ClassSize(cls)));
+         return block + kHeaderSize;
+      }
+   }
+   const std::size_t capacity = cls == kUnpooled ? size : ClassSize(cls);
+   char *block = new char[kHeaderSize + capacity];
+   char *buffer = block + kHeaderSize;
+   GetHeader(buffer) = {cls, capacity};
+   return buffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give back a buffer returned by Acquire(), nothing is done for nullptr.
+
+void TBufferPool::Release(char *buffer)
+{
+   if (!buffer)
+      return;
+   const Int_t cls = GetHeader(buffer).fClass;
+   char *block = buffer - kHeaderSize;
+   if (cls == kUnpooled) {
+      delete[] block;
+      return;
+   }
+   GetCounters().fCachedBytes.Add(ClassSize(cls));
+   TThreadCache *cache = GetThreadCache();
+   if (!cache) {
+      std::vector<char *> single{block};
+      GiveToDepot(cls, single, 1);
+      return;
+   }
+   std::vector<char *> &free = cache->fFree[cls];
+   free.push_back(block);
+   if (free.size() > LocalLimit(cls))
+      GiveToDepot(cls, free, free.size() / 2 + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes usable in a buffer returned by Acquire().
+
+std::size_t TBufferPool::GetCapacity(const char *buffer)
+{
+   return GetHeader(const_cast<char *>(buffer)).fCapacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a buffer of at least newsize bytes holding the first oldsize bytes
+/// of buffer, which is released if it is not returned.
+
+char *TBufferPool::ReAllocChar(char *buffer, std::size_t newsize, std::size_t oldsize)
+{
+   if (buffer && newsize <= GetCapacity(buffer))
+      return buffer;
+   char *newbuffer = Acquire(newsize);
+   if (buffer) {
+      if (oldsize)
+         memcpy(newbuffer, buffer, std::min(oldsize, newsize));
+      Release(buffer);
+   }
+   return newbuffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new TBufferFile of at least size bytes whose memory comes from
+/// the pool, and goes back to it when the TBufferFile is deleted.
+
+TBufferFile *TBufferPool::NewBuffer(TBuffer::EMode mode, Int_t size)
+{
+   if (size < TBuffer::kMinimalSize)
+      size = TBuffer::kMinimalSize;
+   char *buffer = Acquire(size + kWriteExtraSpace);
+   return new TPooledBufferFile(mode, GetCapacity(buffer), buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new TBufferFile of size bytes which adopts buffer, returned by
+/// Acquire(); it goes back to the pool when the TBufferFile is deleted.
+
+TBufferFile *TBufferPool::NewBuffer(TBuffer::EMode mode, char *buffer, Int_t size)
+{
+   return new TPooledBufferFile(mode, size, buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give the memory of buffer back to the pool, if it comes from it, before
+/// the buffer is given another memory or deleted.
+
+void TBufferPool::ReleaseMemory(TBuffer &buffer)
+{
+   if (!IsPooled(buffer))
+      return;
+   Release(buffer.Buffer());
+   buffer.DetachBuffer();
+   buffer.SetReAllocFunc();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of bytes of the free buffers shared by the threads (64 MB
+/// by default). Each thread also keeps up to 8 MB of each size class.
+
+void TBufferPool::SetMaxCachedBytes(Long64_t bytes)
+{
+   std::vector<char *> excess;
+   {
+      TDepot &depot = GetDepot();
+      std::lock_guard<std::mutex> lock(depot.fMutex);
+      depot.fMaxBytes = bytes;
+      for (Int_t cls = kNClasses - 1; cls >= 0 && depot.fBytes > depot.fMaxBytes; --cls) {
+         std::vector<char *> &free = depot.fFree[cls];
+         while (!free.empty() && depot.fBytes > depot.fMaxBytes) {
+            excess.push_back(free.back());
+            free.pop_back();
+            depot.fBytes -= ClassSize(cls);
+         }
+      }
+   }
+   FreeBlocks(excess);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes of the free buffers shared by the threads.
+
+Long64_t TBufferPool::GetMaxCachedBytes()
+{
+   TDepot &depot = GetDepot();
+   std::lock_guard<std::mutex> lock(depot.fMutex);
+   return depot.fMaxBytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Free the buffers kept by the calling thread and shared by the threads.
+
+void TBufferPool::Clear()
+{
+   std::vector<char *> blocks;
+   if (TThreadCache *cache = GetThreadCache()) {
+      for (auto &free : cache->fFree) {
+         blocks.insert(blocks.end(), free.begin(), free.end());
+         free.clear();
+      }
+   }
+   {
+      TDepot &depot = GetDepot();
+      std::lock_guard<std::mutex> lock(depot.fMutex);
+      for (auto &free : depot.fFree) {
+         blocks.insert(blocks.end(), free.begin(), free.end());
+         free.clear();
+      }
+      depot.fBytes = 0;
+   }
+   FreeBlocks(blocks);
+}
@@ -44,6 +44,32 @@ const char *TBufferText::fgDoubleFmt = "%.14e";
 Int_t TBufferText::fgMapSize = kMapSize;
 const UInt_t kNullTag = 0;
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print an integral floating point value, of absolute value below 1e18,
+/// like snprintf(buf, len, "%1.0f", value) but without going through printf
+
+void ConvertIntegral(Double_t value, char *buf, unsigned len)
+{
+   char digits[24];
+   char *p = digits + sizeof(digits);
+   ULong64_t u = (ULong64_t)std::abs(value);
+   do {
+      *--p = '0' + u % 10;
+      u /= 10;
+   } while (u);
+   if (std::signbit(value))
+      *--p = '-';
+   unsigned n = digits + sizeof(digits) - p;
+   if (n >= len)
+      n = len - 1;
+   memcpy(buf, p, n);
+   buf[n] = 0;
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
 
@@ -1057,7 +1083,7 @@ const char *TBufferText::ConvertFloat(Float_t value, char *buf, unsigned len, Bo
    if (not_optimize) {
       snprintf(buf, len, fgFloatFmt, value);
    } else if ((value == std::nearbyint(value)) && (std::abs(value) < 1e15)) {
-      snprintf(buf, len, "%1.0f", value);
+      ConvertIntegral(value, buf, len);
    } else {
       snprintf(buf, len, fgFloatFmt, value);
       CompactFloatString(buf, len);
@@ -1072,6 +1098,8 @@ const char *TBufferText::ConvertDouble(Double_t value, char *buf, unsigned len,
 {
    if (not_optimize) {
       snprintf(buf, len, fgFloatFmt, value);
+   } else if ((value == std::nearbyint(value)) && (std::abs(value) < 1e18)) {
+      ConvertIntegral(value, buf, len);
    } else if ((value == std::nearbyint(value)) && (std::abs(value) < 1e25)) {
       snprintf(buf, len, "%1.0f", value);
    } else {
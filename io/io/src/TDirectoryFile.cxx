@@ -784,17 +784,13 @@ TKey *TDirectoryFile::FindKeyAny(const char *keyname) const
 
    DecodeNameCycle(keyname, name, cycle, kMaxLen);
 
-   TIter next(GetListOfKeys());
-   TKey *key;
-   while ((key = (TKey *) next())) {
-      if (!strcmp(name, key->GetName()))
-         if ((cycle == 9999) || (cycle >= key->GetCycle()))  {
-            ((TDirectory*)this)->cd(); // may be we should not make cd ???
-            return key;
-         }
+   TKey *key = GetKey(name, cycle);
+   if (key) {
+      ((TDirectory*)this)->cd(); // may be we should not make cd ???
+      return key;
    }
    //try with subdirectories
-   next.Reset();
+   TIter next(GetListOfKeys());
    while ((key = (TKey *) next())) {
       //if (!strcmp(key->GetClassName(),"TDirectory")) {
       if (strstr(key->GetClassName(),"TDirectory")) {
@@ -943,16 +939,10 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
-   TKey *key;
-   TIter nextkey(GetListOfKeys());
-   while ((key = (TKey *) nextkey())) {
-      if (strcmp(namobj,key->GetName()) == 0) {
-         if ((cycle == 9999) || (cycle == key->GetCycle())) {
-            TDirectory::TContext ctxt(this);
-            idcur = key->ReadObj();
-            break;
-         }
-      }
+   TKey *key = FindKeyCycle(namobj, cycle);
+   if (key) {
+      TDirectory::TContext ctxt(this);
+      idcur = key->ReadObj();
    }
 
    return idcur;
@@ -1057,16 +1047,10 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 //*-*---------------------Case of Key---------------------
 //                        ===========
    void *idcur = 0;
-   TKey *key;
-   TIter nextkey(GetListOfKeys());
-   while ((key = (TKey *) nextkey())) {
-      if (strcmp(namobj,key->GetName()) == 0) {
-         if ((cycle == 9999) || (cycle == key->GetCycle())) {
-            TDirectory::TContext ctxt(this);
-            idcur = key->ReadObjectAny(expectedClass);
-            break;
-         }
-      }
+   TKey *key = FindKeyCycle(namobj, cycle);
+   if (key) {
+      TDirectory::TContext ctxt(this);
+      idcur = key->ReadObjectAny(expectedClass);
    }
 
    return idcur;
@@ -1094,11 +1078,9 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
 {
    if (!fKeys) return nullptr;
 
-   // TIter::TIter() already checks for null pointers
-   TIter next( ((THashList *)(GetListOfKeys()))->GetListForObject(name) );
-
-   TKey *key;
-   while (( key = (TKey *)next() )) {
+   // TListRange accepts the null list of an empty bucket
+   for (TObject *obj : ROOT::Detail::TListRange(((THashList *)(GetListOfKeys()))->GetListForObject(name))) {
+      TKey *key = (TKey *)obj;
       if (!strcmp(name, key->GetName())) {
          if ((cycle == 9999) || (cycle >= key->GetCycle()))
             return key;
@@ -1108,6 +1090,28 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return pointer to key with name and exactly this cycle
+///
+///  if cycle = 9999 returns highest cycle
+///  Only the keys in the hash bucket of name are looked at; the cycles of
+///  a name are kept in decreasing order in the list of keys.
+
+TKey *TDirectoryFile::FindKeyCycle(const char *name, Short_t cycle) const
+{
+   if (!fKeys) return nullptr;
+
+   for (TObject *obj : ROOT::Detail::TListRange(((THashList *)(GetListOfKeys()))->GetListForObject(name))) {
+      TKey *key = (TKey *)obj;
+      if (!strcmp(name, key->GetName())) {
+         if ((cycle == 9999) || (cycle == key->GetCycle()))
+            return key;
+      }
+   }
+
+   return nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// List Directory contents
 ///
@@ -1367,6 +1371,10 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 
       TKey *key;
       frombuf(buffer, &nkeys);
+      // Size the hash table once for all the keys, instead of rehashing it
+      // repeatedly as they are added.
+      if (nkeys > 0 && fKeys->InheritsFrom(THashList::Class()))
+         static_cast<THashList *>(fKeys)->Rehash(fKeys->GetSize() + nkeys);
       for (Int_t i = 0; i < nkeys; i++) {
          key = new TKey(this);
          key->ReadKeyBuffer(buffer);
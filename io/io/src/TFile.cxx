@@ -84,6 +84,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include <sys/stat.h>
 #ifndef WIN32
 #   include <unistd.h>
+#   include <sys/mman.h>
 #else
 #   define ssize_t int
 #   include <io.h>
@@ -108,6 +109,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TInterpreter.h"
 #include "TKey.h"
 #include "TMakeProject.h"
+#include "TPerfCounters.h"
 #include "TPluginManager.h"
 #include "TProcessUUID.h"
 #include "TRegexp.h"
@@ -117,6 +119,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TStreamerElement.h"
 #include "TSystem.h"
 #include "TTimeStamp.h"
+#include "TTimelineTracer.h"
 #include "TVirtualPerfStats.h"
 #include "TArchiveFile.h"
 #include "TEnv.h"
@@ -167,6 +170,18 @@ AddPseudoGlobals() {
                                  (TGlobalMappedFunction::GlobalFunc_t)&TFile::CurrentFile));
 }
 } gAddPseudoGlobals;
+
+// Publishes the global I/O statistics, which all the TFile implementations update.
+static struct AddPerfProbes {
+AddPerfProbes() {
+   ROOT::TPerfCounters::RegisterProbe("root_file_read_bytes_total", "Bytes read by all the TFiles",
+                                      ROOT::TPerfCounters::kCounter, []() { return (Double_t)TFile::GetFileBytesRead(); });
+   ROOT::TPerfCounters::RegisterProbe("root_file_read_calls_total", "Read calls of all the TFiles",
+                                      ROOT::TPerfCounters::kCounter, []() { return (Double_t)TFile::GetFileReadCalls(); });
+   ROOT::TPerfCounters::RegisterProbe("root_file_written_bytes_total", "Bytes written by all the TFiles",
+                                      ROOT::TPerfCounters::kCounter, []() { return (Double_t)TFile::GetFileBytesWritten(); });
+}
+} gAddPerfProbes;
 }
 ////////////////////////////////////////////////////////////////////////////////
 /// File default Constructor.
@@ -183,6 +198,8 @@ TFile::TFile() : TDirectoryFile(), fInfoCache(0)
    fProcessIDs      = 0;
    fNProcessIDs     = 0;
    fOffset          = 0;
+   fMapBegin        = 0;
+   fMapSize         = 0;
    fArchive         = 0;
    fCacheRead       = 0;
    fCacheReadMap    = new TMap();
@@ -263,6 +280,12 @@ TFile::TFile() : TDirectoryFile(), fInfoCache(0)
 ///
 /// This is convenient because the many remote file access plugins allow
 /// easy access to/from the many different mass storage systems.
+/// A local file opened in read mode can be mapped in memory with:
+///
+///     file.root?mmap
+///
+/// in which case the reads do not issue system calls and the baskets of
+/// the trees are decompressed straight from the mapping, see MapFile().
 /// The title of the file (ftitle) will be shown by the ROOT browsers.
 /// A ROOT file (like a Unix file system) may contain objects and
 /// directories. There are no restrictions for the number of levels
@@ -298,6 +321,8 @@ TFile::TFile() : TDirectoryFile(), fInfoCache(0)
 /// will build an integer which will set the compression to use
 /// the LZMA algorithm and compression level 1.  These are defined
 /// in the header file <em>Compression.h</em>.
+/// For example, `compress = 505` selects ROOT::kZSTD at level 5; the ZSTD
+/// levels 1 to 9 are mapped onto the Zstandard levels 1 to 19.
 /// Note that the compression settings may be changed at any time.
 /// The new compression settings will only apply to branches created
 /// or attached after the setting is changed and other objects written
@@ -379,6 +404,8 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
    fProcessIDs   = 0;
    fNProcessIDs  = 0;
    fOffset       = 0;
+   fMapBegin     = 0;
+   fMapSize      = 0;
    fCacheRead    = 0;
    fCacheReadMap = new TMap();
    fCacheWrite   = 0;
@@ -515,6 +542,9 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
          goto zombie;
       }
       fWritable = kFALSE;
+      // if option contains mmap then read the file from a memory mapping
+      if (strstr(fUrl.GetOptions(), "mmap"))
+         MapFile();
    }
 
    Init(create);
@@ -922,6 +952,7 @@ void TFile::Close(Option_t *option)
 
    if (fIsArchive || !fIsRootFile) {
       FlushWriteCache();
+      UnmapFile();
       SysClose(fD);
       fD = -1;
 
@@ -977,6 +1008,7 @@ void TFile::Close(Option_t *option)
    }
 
    if (IsOpen()) {
+      UnmapFile();
       SysClose(fD);
       fD = -1;
    }
@@ -1596,6 +1628,7 @@ void TFile::Print(Option_t *option) const
 Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
    if (IsOpen()) {
+      ROOT::TTimelineTracer::TSpan span("io", "TFile::ReadBuffer", "bytes", len);
 
       SetOffset(pos);
 
@@ -1609,6 +1642,9 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
          return kFALSE;
       }
 
+      if (fMapBegin)
+         return ReadMappedBuffer(buf, len, start);
+
       Seek(pos);
       ssize_t siz;
 
@@ -1659,6 +1695,9 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
 
       if (gPerfStats != 0) start = TTimeStamp();
 
+      if (fMapBegin)
+         return ReadMappedBuffer(buf, len, start);
+
       while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
          ResetErrno();
 
@@ -1706,6 +1745,22 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       return kFALSE;
    }
 
+   ROOT::TTimelineTracer::TSpan span("io", "TFile::ReadBuffers", "blocks", nbuf);
+
+   // the blocks of a mapped file are copied one by one, there is nothing to gain from reading ahead
+   if (fMapBegin) {
+      Int_t k = 0;
+      for (Int_t j = 0; j < nbuf; j++) {
+         Double_t start = 0;
+         if (gPerfStats != 0) start = TTimeStamp();
+         SetOffset(pos[j]);
+         if (ReadMappedBuffer(&buf[k], len[j], start))
+            return kTRUE;
+         k += len[j];
+      }
+      return kFALSE;
+   }
+
    Int_t k = 0;
    Bool_t result = kTRUE;
    TFileCacheRead *old = fCacheRead;
@@ -1756,6 +1811,112 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Map the whole file in memory, for a local file opened in read mode.
+///
+/// Once mapped, the reads copy the bytes from the mapping instead of
+/// issuing system calls, and GetMappedBuffer() gives access to the bytes
+/// of the file without any copy. This is enabled with the `mmap` option
+/// of the file URL, e.g. `TFile::Open("data.root?mmap")`.
+/// Returns kTRUE in case of failure, in which case the file keeps being
+/// read with system calls.
+
+Bool_t TFile::MapFile()
+{
+#ifndef WIN32
+   if (fMapBegin)
+      return kFALSE;
+   struct stat st;
+   if (fD < 0 || fstat(fD, &st) != 0 || st.st_size <= 0)
+      return kTRUE;
+   void *addr = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fD, 0);
+   if (addr == MAP_FAILED) {
+      SysError("MapFile", "cannot map file %s in memory, reading it with system calls", GetName());
+      return kTRUE;
+   }
+   fMapBegin = static_cast<const char *>(addr);
+   fMapSize = st.st_size;
+   return kFALSE;
+#else
+   Warning("MapFile", "memory mapped files are not supported on this platform, reading %s with system calls",
+           GetName());
+   return kTRUE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the memory mapping of the file, if any.
+
+void TFile::UnmapFile()
+{
+   if (!fMapBegin)
+      return;
+#ifndef WIN32
+   munmap(const_cast<char *>(fMapBegin), fMapSize);
+#endif
+   fMapBegin = 0;
+   fMapSize = 0;
+   // the reads did not move the file descriptor, resynchronize it with the offset
+   if (fD >= 0)
+      SysSeek(fD, fOffset, SEEK_SET);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Update the read statistics after len bytes were taken from the mapping.
+
+void TFile::CountMappedRead(Int_t len, Double_t start)
+{
+   fBytesRead  += len;
+   fgBytesRead += len;
+   fReadCalls++;
+   fgReadCalls++;
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+   if (gPerfStats != 0) {
+      gPerfStats->FileReadEvent(this, len, start);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy len bytes at the current offset of a mapped file and move the offset.
+/// Returns kTRUE in case of failure.
+
+Bool_t TFile::ReadMappedBuffer(char *buf, Int_t len, Double_t start)
+{
+   if (len < 0 || fOffset < 0 || fOffset + len > fMapSize) {
+      Error("ReadBuffer", "error reading all requested bytes from file %s, got %ld of %d", GetName(),
+            (Long_t)TMath::Max(fMapSize - fOffset, 0LL), len);
+      return kTRUE;
+   }
+   memcpy(buf, fMapBegin + fOffset, len);
+   fOffset += len;
+   CountMappedRead(len, start);
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the len bytes at the offset 'pos' of a memory mapped
+/// file, see MapFile().
+///
+/// The bytes are not copied: the pointer stays valid until the file is
+/// closed. The read is accounted for in the read statistics of the file.
+/// Returns 0 if the file is not mapped or if the bytes are beyond its end,
+/// in which case the bytes must be read with ReadBuffer().
+
+const char *TFile::GetMappedBuffer(Long64_t pos, Int_t len)
+{
+   if (!fMapBegin)
+      return 0;
+   const Long64_t offset = pos + fArchiveOffset;
+   if (len < 0 || offset < 0 || offset + len > fMapSize)
+      return 0;
+   Double_t start = 0;
+   if (gPerfStats != 0) start = TTimeStamp();
+   CountMappedRead(len, start);
+   return fMapBegin + offset;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read buffer via cache.
 ///
@@ -2095,6 +2256,7 @@ Int_t TFile::ReOpen(Option_t *mode)
 
       // close readonly file
       if (IsOpen()) {
+         UnmapFile();
          SysClose(fD);
          fD = -1;
       }
@@ -2164,6 +2326,11 @@ void TFile::Seek(Long64_t offset, ERelativeTo pos)
             Error("Seek", "seeking from end in archive is not (yet) supported");
          break;
    }
+   if (fMapBegin) {
+      // the reads of a mapped file do not move the file descriptor, only the cached offset
+      fOffset = (pos == kCur ? fOffset : (pos == kEnd ? fMapSize : 0)) + offset;
+      return;
+   }
    Long64_t retpos;
    if ((retpos = SysSeek(fD, offset, whence)) < 0)
       SysError("Seek", "cannot seek to position %lld in file %s, retpos=%lld",
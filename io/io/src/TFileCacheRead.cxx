@@ -23,6 +23,14 @@
  TXNetFile and TWebFile (via TFile::ReadBuffers()).
  When processing TTree, TChain, a specialized class TTreeCache that
  derives from this class is automatically created.
+
+ In adaptive mode (SetAdaptive, or TFile.AdaptiveCache in the rootrc),
+ the duration of each vectored read of the prefetched blocks is measured
+ to estimate the latency and the bandwidth of the transport. The size of
+ the window of blocks to prefetch and the size of the chunks of merged
+ consecutive blocks are then adjusted to the bandwidth-delay product,
+ within a memory cap, so that the same cache size fits a local disk and
+ a remote server far away.
 */
 
 #include "TEnv.h"
@@ -31,9 +39,17 @@
 #include "TFileCacheWrite.h"
 #include "TFilePrefetch.h"
 #include "TMath.h"
+#include "TTimeStamp.h"
 
 ClassImp(TFileCacheRead);
 
+namespace {
+const Int_t kAdaptiveMinSize = 1000000;   // Smallest adaptive window, unless the cache is even smaller
+const Int_t kMinChunkSize = 1000000;      // Smallest adaptive chunk of merged blocks
+const Int_t kMaxChunkSize = 16000000;     // Largest chunk of merged blocks, see Sort
+const Double_t kAdaptiveBDPFactor = 4.;   // Window in bandwidth-delay products: the latency costs at most 20%
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default Constructor.
 
@@ -84,6 +100,14 @@ TFileCacheRead::TFileCacheRead() : TObject()
    fEnablePrefetching = kFALSE;
    fPrefetch        = 0;
    fPrefetchedBlocks= 0;
+
+   fAdaptive        = kFALSE;
+   fAdaptiveMinSize = 0;
+   fAdaptiveMaxSize = 0;
+   fMaxChunkSize    = kMaxChunkSize;
+   fFitW = fFitX = fFitY = fFitXX = fFitXY = 0;
+   fRoundTripTime   = -1;
+   fBandwidth       = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -150,6 +174,16 @@ TFileCacheRead::TFileCacheRead(TFile *file, Int_t buffersize, TObject *tree)
    fBIsSorted      = kFALSE;
    fBIsTransferred = kFALSE;
 
+   fAdaptive        = kFALSE;
+   fAdaptiveMinSize = 0;
+   fAdaptiveMaxSize = 0;
+   fMaxChunkSize    = kMaxChunkSize;
+   fFitW = fFitX = fFitY = fFitXX = fFitXY = 0;
+   fRoundTripTime   = -1;
+   fBandwidth       = -1;
+   if (gEnv->GetValue("TFile.AdaptiveCache", 0))
+      SetAdaptive(kTRUE);
+
    if (file) file->SetCacheRead(this, tree);
 }
 
@@ -334,9 +368,15 @@ void TFileCacheRead::Print(Option_t *option) const
    else
       printf("Average transaction................: No read calls yet\n");
    printf("Number of blocks in current cache..: %d, total size: %d\n",fNseek,fNtot);
+   if (fAdaptive)
+      printf("Adaptive window....................: %d bytes, latency = %g s, bandwidth = %g MBytes/s\n",
+             fBufferSizeMin, fRoundTripTime, fBandwidth > 0 ? 1e-6*fBandwidth : fBandwidth);
    if (fPrefetch){
      printf("Prefetching .......................: %lli blocks\n", fPrefetchedBlocks);
      printf("Prefetching Wait Time..............: %f seconds\n", fPrefetch->GetWaitTime() / 1e+6);
+     if (strlen(fPrefetch->GetCacheDir()))
+        printf("Local cache........................: %lld hits, %lld misses, %lld bytes read\n",
+               fPrefetch->GetCacheHits(), fPrefetch->GetCacheMisses(), fPrefetch->GetCacheBytesRead());
    }
 
    if (!opt.Contains("a")) return;
@@ -459,9 +499,16 @@ Int_t TFileCacheRead::ReadBufferExtNormal(char *buf, Long64_t pos, Int_t len, In
       // If ReadBufferAsync is not supported by this implementation...
       if (!fAsyncReading) {
          // Then we use the vectored read to read everything now
+         Double_t start = fAdaptive ? Double_t(TTimeStamp()) : 0;
          if (fFile->ReadBuffers(fBuffer,fPos,fLen,fNb)) {
             return -1;
          }
+         if (fAdaptive) {
+            Int_t nbytes = 0;
+            for (Int_t i = 0; i < fNb; ++i)
+               nbytes += fLen[i];
+            AdaptBufferSize(nbytes, Double_t(TTimeStamp()) - start);
+         }
          fIsTransferred = kTRUE;
       } else {
          // In any case, we'll start to request the chunks.
@@ -590,7 +637,9 @@ void TFileCacheRead::Sort()
       ++effectiveNseek;
    }
    fNseek = effectiveNseek;
-   if (fNtot > fBufferSizeMin) {
+   // In adaptive mode, the window may have grown beyond the buffer, or shrunk well below it.
+   if (fNtot > fBufferSizeMin ||
+       (fAdaptive && (fNtot > fBufferSize || fBufferSize > 2 * TMath::Max(fNtot, fBufferSizeMin)))) {
       fBufferSize = fNtot + 100;
       delete [] fBuffer;
       fBuffer = 0;
@@ -608,7 +657,7 @@ void TFileCacheRead::Sort()
       //increasing this number must be done with care, as it may increase
       //the job real time (mismatch with OS buffers)
       if ((fSeekSort[i] != fSeekSort[i-1]+fSeekSortLen[i-1]) ||
-          (fLen[nb] > 16000000)) {
+          (fLen[nb] > fMaxChunkSize)) {
          nb++;
          fPos[nb] = fSeekSort[i];
          fLen[nb] = fSeekSortLen[i];
@@ -666,7 +715,7 @@ void TFileCacheRead::SecondSort()
       //increasing this number must be done with care, as it may increase
       //the job real time (mismatch with OS buffers)
       if ((fBSeekSort[i] != fBSeekSort[i-1]+fBSeekSortLen[i-1]) ||
-         (fBLen[nb] > 16000000)) {
+         (fBLen[nb] > fMaxChunkSize)) {
          nb++;
          fBPos[nb] = fBSeekSort[i];
          fBLen[nb] = fBSeekSortLen[i];
@@ -749,6 +798,11 @@ Int_t TFileCacheRead::SetBufferSize(Int_t buffersize)
    fBuffer = np;
    fBufferSizeMin = buffersize;
    fBufferSize = buffersize;
+   if (fAdaptive) {
+      // The adaptation restarts from the new size.
+      fAdaptiveMinSize = TMath::Min(buffersize, kAdaptiveMinSize);
+      fAdaptiveMaxSize = TMath::Max(buffersize, fAdaptiveMaxSize);
+   }
 
    if (inval) {
       return 1;
@@ -758,6 +812,90 @@ Int_t TFileCacheRead::SetBufferSize(Int_t buffersize)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the adaptive mode.
+///
+/// In adaptive mode, the size of the window of blocks to prefetch, set by
+/// SetBufferSize, is the starting point only: it is then adjusted after each
+/// vectored read to the measured latency and bandwidth, see AdaptBufferSize,
+/// between 1 MByte (or the starting size, if smaller) and maxsize bytes. If
+/// maxsize is not positive, the rootrc variable TFile.AdaptiveCacheMaxSize
+/// is used, 256 MBytes by default. The adaptive mode applies to the
+/// synchronous vectored reads, not to the asynchronous prefetching.
+
+void TFileCacheRead::SetAdaptive(Bool_t adaptive, Int_t maxsize)
+{
+   fAdaptive = adaptive;
+   if (maxsize <= 0)
+      maxsize = gEnv->GetValue("TFile.AdaptiveCacheMaxSize", 256000000);
+   fAdaptiveMinSize = TMath::Min(fBufferSizeMin, kAdaptiveMinSize);
+   fAdaptiveMaxSize = TMath::Max(maxsize, fBufferSizeMin);
+   fMaxChunkSize = kMaxChunkSize;
+   fFitW = fFitX = fFitY = fFitXX = fFitXY = 0;
+   fRoundTripTime = -1;
+   fBandwidth = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Adapt the prefetched window to a vectored read of nbytes which took dtime seconds.
+///
+/// The durations of the reads are fitted to latency + nbytes / bandwidth by
+/// least squares, with exponentially decreasing weights so that the estimates
+/// follow the changes of the transport. The window is then set to 4
+/// bandwidth-delay products, so that the latency costs at most 20% of a read,
+/// changing by at most a factor 2 per read; the chunks of merged consecutive
+/// blocks are limited to one bandwidth-delay product, between 1 and 16 MBytes.
+/// As long as the latency cannot be told from the bandwidth, e.g. because all
+/// the reads had the same size, the window is doubled. If the duration does
+/// not grow with the size, the window is set to the memory cap.
+
+void TFileCacheRead::AdaptBufferSize(Int_t nbytes, Double_t dtime)
+{
+   if (nbytes <= 0 || dtime <= 0) return;
+
+   const Double_t decay = 0.8;
+   const Double_t x = nbytes;
+   fFitW  = decay * fFitW + 1;
+   fFitX  = decay * fFitX + x;
+   fFitY  = decay * fFitY + dtime;
+   fFitXX = decay * fFitXX + x * x;
+   fFitXY = decay * fFitXY + x * dtime;
+   const Double_t meanx = fFitX / fFitW;
+   const Double_t meany = fFitY / fFitW;
+   const Double_t varx  = fFitXX / fFitW - meanx * meanx;
+   const Double_t covxy = fFitXY / fFitW - meanx * meany;
+   if (fFitW > 1.5 && varx > 0.01 * meanx * meanx) {
+      if (covxy > 0) {
+         fBandwidth = varx / covxy;
+         fRoundTripTime = TMath::Max(meany - meanx / fBandwidth, 0.);
+      } else {
+         fBandwidth = -1;
+         fRoundTripTime = meany;
+      }
+   }
+
+   Double_t target;
+   if (fRoundTripTime < 0)
+      target = 2. * fBufferSizeMin;
+   else if (fBandwidth < 0)
+      target = fAdaptiveMaxSize;
+   else
+      target = kAdaptiveBDPFactor * fBandwidth * fRoundTripTime;
+   target = TMath::Min(TMath::Max(target, 0.5 * fBufferSizeMin), 2. * fBufferSizeMin);
+   target = TMath::Min(TMath::Max(target, Double_t(fAdaptiveMinSize)), Double_t(fAdaptiveMaxSize));
+   fBufferSizeMin = Int_t(target);
+
+   if (fBandwidth > 0)
+      fMaxChunkSize = Int_t(TMath::Min(TMath::Max(fBandwidth * fRoundTripTime, Double_t(kMinChunkSize)),
+                                       Double_t(kMaxChunkSize)));
+   else
+      fMaxChunkSize = kMaxChunkSize;
+
+   if (gDebug > 0)
+      Info("AdaptBufferSize", "read of %d bytes in %g s: latency = %g s, bandwidth = %g bytes/s, window = %d bytes",
+           nbytes, dtime, fRoundTripTime, fBandwidth, fBufferSizeMin);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the prefetching mode of this file.
 ///
@@ -788,6 +926,7 @@ void TFileCacheRead::SetEnablePrefetchingImpl(Bool_t setPrefetching)
       if (strcmp(cacheDir, ""))
         if (!fPrefetch->SetCache((char*) cacheDir))
            fprintf(stderr, "Error while trying to set the cache directory: %s.\n", cacheDir);
+      fPrefetch->SetCacheSizeLimit(Long64_t(gEnv->GetValue("Cache.MaxSize", 0.)*1024*1024));
       if (fPrefetch->ThreadStart()){
          fprintf(stderr,"Error stating prefetching thread. Disabling prefetching.\n");
          fEnablePrefetching = 0;
@@ -40,6 +40,11 @@ to be merged, like the standalone hadd program.
 #include "TROOT.h"
 #include "TMemFile.h"
 #include "TVirtualMutex.h"
+#include "ROOT/TTaskGroup.hxx"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 #ifdef WIN32
 // For _getmaxstdio
@@ -57,6 +62,56 @@ TClassRef R__TTree_Class("TTree");
 
 static const Int_t kCpProgress = BIT(14);
 static const Int_t kCintFileNumber = 100;
+static const Int_t kMinReduceGroupSize = 4;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the objects of inputs into obj, as a two level reduction when the
+/// implicit multi-threading is enabled: the inputs are split in groups which
+/// are merged concurrently into their first object, the first objects of the
+/// groups are then merged into obj. The groups only depend on the number of
+/// inputs and of threads, so the result does not depend on the scheduling.
+
+static Long64_t R__ReduceMerge(ROOT::MergeFunc_t func, TObject *obj, TList &inputs, TFileMergeInfo &info)
+{
+   const Int_t ninputs = inputs.GetSize();
+   const Int_t ngroups =
+      ROOT::IsImplicitMTEnabled() ? std::min<Int_t>(ROOT::GetImplicitMTPoolSize(), ninputs / kMinReduceGroupSize) : 0;
+   if (ngroups < 2)
+      return func(obj, &inputs, &info);
+
+   const Int_t groupSize = (ninputs + ngroups - 1) / ngroups;
+   TList heads;
+   std::vector<std::unique_ptr<TList>> tails;
+   TIter next(&inputs);
+   TObject *input;
+   for (Int_t i = 0; (input = next()); ++i) {
+      if (i % groupSize == 0) {
+         heads.Add(input);
+         tails.emplace_back(new TList);
+      } else {
+         tails.back()->Add(input);
+      }
+   }
+
+   std::vector<Long64_t> results(tails.size(), 0);
+   ROOT::Experimental::TTaskGroup tasks;
+   for (UInt_t g = 0; g < tails.size(); ++g) {
+      if (tails[g]->IsEmpty())
+         continue;
+      tasks.Run([&, g]() {
+         TFileMergeInfo groupInfo(info.fOutputDirectory);
+         groupInfo.fOptions = info.fOptions;
+         groupInfo.fIOFeatures = info.fIOFeatures;
+         results[g] = func(heads.At(g), tails[g].get(), &groupInfo);
+      });
+   }
+   tasks.Wait();
+   for (auto result : results) {
+      if (result < 0)
+         return result;
+   }
+   return func(obj, &heads, &info);
+}
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the maximum number of allowed opened files minus some wiggle room
 /// for CINT or at least of the standard library (stdio).
@@ -593,7 +648,10 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                   // Merge the list, if still to be done
                   if (oneGo || info.fIsFirst) {
                      ROOT::MergeFunc_t func = cl->GetMerge();
-                     func(obj, &inputs, &info);
+                     if (oneGo)
+                        R__ReduceMerge(func, obj, inputs, info);
+                     else
+                        func(obj, &inputs, &info);
                      info.fIsFirst = kFALSE;
                      inputs.Delete();
                   }
@@ -13,13 +13,22 @@
 #include "TTimeStamp.h"
 #include "TVirtualPerfStats.h"
 #include "TVirtualMonitoring.h"
+#include "TSystem.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <cstdio>
 #include <cstdlib>
 #include <cctype>
+#include <vector>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
 
 static const int kMAX_READ_SIZE    = 2;   //maximum size of the read list of blocks
 
@@ -42,6 +51,20 @@ processing considerably decreases. Besides the prefetching
 mechanisms there is also a local caching option which can be
 enabled by the user. Both capabilities are disabled by default
 and must be explicitly enabled by the user.
+
+The local cache, set with the `Cache.Directory` resource or SetCache(),
+keeps the blocks read from the remote files in a local directory,
+typically on a node-local disk, where they are found again by the next
+passes over the same files. The cache can be shared by concurrent jobs
+on the node: a block is written to a temporary file and renamed when
+complete, so that the other jobs never see a partially written block,
+and the eviction is serialised by a lock on the `.lock` file of the
+cache directory. The size of the cache directory is bounded by
+SetCacheSizeLimit() or the `Cache.MaxSize` resource (in MB): when it is
+exceeded, the least recently used blocks are removed, the modification
+time of a block being updated each time it is read from the cache.
+The number of blocks found or not in the cache is returned by
+GetCacheHits() and GetCacheMisses(), and printed by TTreeCache::Print.
 */
 
 
@@ -52,7 +75,13 @@ TFilePrefetch::TFilePrefetch(TFile* file) :
   fFile(file),
   fConsumer(0),
   fThreadJoined(kTRUE),
-  fPrefetchFinished(kFALSE)
+  fPrefetchFinished(kFALSE),
+  fCacheSizeLimit(0),
+  fCacheSize(-1),
+  fCacheWritten(0),
+  fCacheHits(0),
+  fCacheMisses(0),
+  fCacheBytesRead(0)
 {
    fPendingBlocks    = new TList();
    fReadBlocks       = new TList();
@@ -103,9 +132,12 @@ void TFilePrefetch::WaitFinishPrefetch()
 void TFilePrefetch::ReadAsync(TFPBlock* block, Bool_t &inCache)
 {
    char* path = 0;
+   char* buffer = 0;
 
-   if (CheckBlockInCache(path, block)){
-      block->SetBuffer(GetBlockFromCache(path, block->GetDataSize()));
+   if (CheckBlockInCache(path, block) && (buffer = GetBlockFromCache(path, block->GetDataSize()))) {
+      // Keep the buffer of the block, whose capacity may be larger than its data.
+      memcpy(block->GetBuffer(), buffer, block->GetDataSize());
+      free(buffer);
       inCache = kTRUE;
    }
    else{
@@ -381,54 +413,104 @@ Int_t TFilePrefetch::SumHex(const char *hex)
    return result;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-/// Test if the block is in cache.
+namespace {
 
-Bool_t TFilePrefetch::CheckBlockInCache(char*& path, TFPBlock* block)
-{
-   if (fPathCache == "")
-      return false;
+/// Exclusive lock of a cache directory, shared by the processes using it.
 
-   Bool_t found = false;
-   TString fullPath(fPathCache); // path of the cached files.
+class TCacheDirLock {
+private:
+   int fFd;
+public:
+   TCacheDirLock(const char *dir) : fFd(-1)
+   {
+#ifndef WIN32
+      TString lockPath = TString(dir) + "/.lock";
+      fFd = open(lockPath, O_RDWR | O_CREAT, 0666);
+      if (fFd >= 0 && flock(fFd, LOCK_EX) != 0) {
+         close(fFd);
+         fFd = -1;
+      }
+#else
+      (void)dir;
+#endif
+   }
+   ~TCacheDirLock()
+   {
+#ifndef WIN32
+      if (fFd >= 0)
+         close(fFd); // releases the lock
+#endif
+   }
+};
 
-   Int_t value = 0;
+struct TCachedBlockFile {
+   Long_t   fMtime;
+   Long64_t fSize;
+   TString  fPath;
+};
 
-   if (!gSystem->OpenDirectory(fullPath))
-      gSystem->mkdir(fullPath);
+} // anonymous namespace
 
-   //dir is SHA1 value modulo 16; filename is the value of the SHA1(offset+len)
-   TMD5* md = new TMD5();
+////////////////////////////////////////////////////////////////////////////////
+/// Return the path of a block in the cache, creating its directory if
+/// requested.
+///
+/// The file name is the MD5 of the name of the file and of the offsets and
+/// lengths of the block, the directory the sum of its hex digits modulo 16.
 
-   TString concatStr;
+TString TFilePrefetch::GetBlockCachePath(TFPBlock* block, Bool_t create)
+{
+   TMD5 md;
+   TString concatStr = fFile ? fFile->GetName() : "";
+   md.Update((UChar_t*)concatStr.Data(), concatStr.Length());
    for (Int_t i=0; i < block->GetNoElem(); i++){
-      concatStr.Form("%lld", block->GetPos(i));
-      md->Update((UChar_t*)concatStr.Data(), concatStr.Length());
+      concatStr.Form("%lld+%d", block->GetPos(i), block->GetLen(i));
+      md.Update((UChar_t*)concatStr.Data(), concatStr.Length());
    }
+   md.Final();
 
-   md->Final();
-   TString fileName( md->AsString() );
-   value = SumHex(fileName);
-   value = value % 16;
-   TString dirName;
-   dirName.Form("%i", value);
+   TString fileName( md.AsString() );
+   Int_t value = SumHex(fileName) % 16;
 
-   fullPath += "/" + dirName + "/" + fileName;
+   TString fullPath( fPathCache );
+   fullPath += TString::Format("/%i", value);
+   if (create && gSystem->AccessPathName(fullPath))
+      gSystem->mkdir(fullPath, kTRUE);
+
+   fullPath += ("/" + fileName);
+   return fullPath;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Test if the block is in cache.
+///
+/// A cached file whose size differs from the one of the block, e.g. left
+/// by a crashed job, is ignored.
+
+Bool_t TFilePrefetch::CheckBlockInCache(char*& path, TFPBlock* block)
+{
+   if (fPathCache == "")
+      return false;
+
+   TString fullPath = GetBlockCachePath(block, kFALSE);
 
    FileStat_t stat;
-   if (gSystem->GetPathInfo(fullPath, stat) == 0) {
+   if (gSystem->GetPathInfo(fullPath, stat) == 0 && stat.fSize == block->GetDataSize()) {
       path = new char[fullPath.Length() + 1];
       strlcpy(path, fullPath,fullPath.Length() + 1);
-      found = true;
-   } else
-      found = false;
-
-   delete md;
-   return found;
+      ++fCacheHits;
+      return true;
+   }
+   ++fCacheMisses;
+   return false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Return a buffer from cache.
+/// Return a buffer from cache, or 0 if the block could not be read, e.g.
+/// because it was evicted by another job in the meantime.
+///
+/// The modification time of the cached file is updated, for the least
+/// recently used blocks to be evicted first.
 
 char* TFilePrefetch::GetBlockFromCache(const char* path, Int_t length)
 {
@@ -437,17 +519,31 @@ char* TFilePrefetch::GetBlockFromCache(const char* path, Int_t length)
 
    strPath += "?filetype=raw";
    TFile* file = new TFile(strPath);
+   if (file->IsZombie()) {
+      delete file;
+      --fCacheHits;
+      ++fCacheMisses;
+      return 0;
+   }
 
    Double_t start = 0;
    if (gPerfStats != 0) start = TTimeStamp();
 
    buffer = (char*) calloc(length, sizeof(char));
-   file->ReadBuffer(buffer, 0, length);
+   if (file->ReadBuffer(buffer, 0, length)) {
+      free(buffer);
+      file->Close();
+      delete file;
+      --fCacheHits;
+      ++fCacheMisses;
+      return 0;
+   }
 
    fFile->fBytesRead  += length;
    fFile->fgBytesRead += length;
    fFile->SetReadCalls(fFile->GetReadCalls() + 1);
    fFile->fgReadCalls++;
+   fCacheBytesRead += length;
 
    if (gMonitoringWriter)
       gMonitoringWriter->SendFileReadProgress(fFile);
@@ -457,58 +553,103 @@ char* TFilePrefetch::GetBlockFromCache(const char* path, Int_t length)
 
    file->Close();
    delete file;
+
+   Long_t now = (Long_t)TTimeStamp().GetSec();
+   gSystem->Utime(path, now, now);
    return buffer;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Save the block content in cache.
+///
+/// The block is written in a temporary file, renamed once complete, and the
+/// least recently used blocks are evicted if the size limit of the cache is
+/// exceeded.
 
 void TFilePrefetch::SaveBlockInCache(TFPBlock* block)
 {
    if (fPathCache == "")
       return;
 
-   //dir is SHA1 value modulo 16; filename is the value of the SHA1
-   TMD5* md = new TMD5();
+   TString fullPath = GetBlockCachePath(block, kTRUE);
+   TString tmpPath = TString::Format("%s.%d.%lx.tmp", fullPath.Data(), gSystem->GetPid(), (ULong_t)this);
 
-   TString concatStr;
-   for(Int_t i=0; i< block->GetNoElem(); i++){
-      concatStr.Form("%lld", block->GetPos(i));
-      md->Update((UChar_t*)concatStr.Data(), concatStr.Length());
-   }
-   md->Final();
+   TFile* file = TFile::Open(tmpPath + "?filetype=raw", "recreate");
+   if (!file)
+      return;
 
-   TString fileName( md->AsString() );
-   Int_t value = SumHex(fileName);
-   value = value % 16;
+   Bool_t failed = file->WriteBuffer(block->GetBuffer(), block->GetDataSize());
+   file->Close();
+   delete file;
 
-   TString fullPath( fPathCache );
-   TString dirName;
-   dirName.Form("%i", value);
-   fullPath += ("/" + dirName);
+   if (failed || gSystem->Rename(tmpPath, fullPath)) {
+      gSystem->Unlink(tmpPath);
+      return;
+   }
 
-   if (!gSystem->OpenDirectory(fullPath))
-      gSystem->mkdir(fullPath);
+   if (fCacheSizeLimit <= 0)
+      return;
+   fCacheWritten += block->GetDataSize();
+   // Rescan the directory when our estimate exceeds the limit, or once in a
+   // while to account for the blocks written by the other jobs.
+   if (fCacheSize < 0 || fCacheSize + fCacheWritten > fCacheSizeLimit || fCacheWritten > fCacheSizeLimit / 8)
+      EvictFromCache();
+}
 
-   TFile* file = 0;
-   fullPath += ("/" + fileName);
-   FileStat_t stat;
-   if (gSystem->GetPathInfo(fullPath, stat) == 0) {
-      fullPath += "?filetype=raw";
-      file = TFile::Open(fullPath, "update");
-   } else{
-      fullPath += "?filetype=raw";
-      file = TFile::Open(fullPath, "new");
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the least recently used blocks from the cache directory until its
+/// size is below 90% of the size limit, and return the resulting size of
+/// the cache directory in bytes.
+///
+/// Without size limit nothing is removed. The eviction is serialised
+/// across the processes sharing the cache directory.
+
+Long64_t TFilePrefetch::EvictFromCache()
+{
+   if (fPathCache == "")
+      return 0;
+
+   TCacheDirLock lock(fPathCache);
+
+   std::vector<TCachedBlockFile> blocks;
+   Long64_t total = 0;
+   for (Int_t i = 0; i < 16; i++) {
+      TString dirName = TString::Format("%s/%i", fPathCache.Data(), i);
+      void *dir = gSystem->OpenDirectory(dirName);
+      if (!dir)
+         continue;
+      while (const char *entry = gSystem->GetDirEntry(dir)) {
+         TString name(entry);
+         if (name == "." || name == ".." || name.EndsWith(".tmp"))
+            continue;
+         TCachedBlockFile blockFile;
+         blockFile.fPath = dirName + "/" + name;
+         FileStat_t stat;
+         if (gSystem->GetPathInfo(blockFile.fPath, stat) != 0 || R_ISDIR(stat.fMode))
+            continue;
+         blockFile.fMtime = stat.fMtime;
+         blockFile.fSize = stat.fSize;
+         total += stat.fSize;
+         blocks.push_back(blockFile);
+      }
+      gSystem->FreeDirectory(dir);
    }
 
-   if (file) {
-      // coverity[unchecked_value] We do not print error message, have not error
-      // return code and close the file anyway, not need to check the return value.
-      file->WriteBuffer(block->GetBuffer(), block->GetDataSize());
-      file->Close();
-      delete file;
+   if (fCacheSizeLimit > 0 && total > fCacheSizeLimit) {
+      std::sort(blocks.begin(), blocks.end(),
+                [](const TCachedBlockFile &a, const TCachedBlockFile &b) { return a.fMtime < b.fMtime; });
+      const Long64_t target = fCacheSizeLimit - fCacheSizeLimit / 10;
+      for (auto &blockFile : blocks) {
+         if (total <= target)
+            break;
+         if (gSystem->Unlink(blockFile.fPath) == 0)
+            total -= blockFile.fSize;
+      }
    }
-   delete md;
+
+   fCacheSize = total;
+   fCacheWritten = 0;
+   return total;
 }
 
 
@@ -518,12 +659,24 @@ void TFilePrefetch::SaveBlockInCache(TFPBlock* block)
 Bool_t TFilePrefetch::SetCache(const char* path)
 {
   fPathCache = path;
+  fCacheSize = -1;
 
-  if (!gSystem->OpenDirectory(path)){
-    return (!gSystem->mkdir(path) ? true : false);
+  if (gSystem->AccessPathName(path)){
+    return (!gSystem->mkdir(path, kTRUE) ? true : false);
   }
 
   // Directory already exists
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the maximum size in bytes of the cache directory, 0 for no limit.
+///
+/// The limit applies to the whole directory, including the blocks saved
+/// by the other processes sharing it.
+
+void TFilePrefetch::SetCacheSizeLimit(Long64_t limit)
+{
+   fCacheSizeLimit = limit > 0 ? limit : 0;
+   fCacheSize = -1;
+}
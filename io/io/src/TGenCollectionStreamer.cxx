@@ -361,6 +361,117 @@ void TGenCollectionStreamer::ReadPrimitives(int nElements, TBuffer &b, const TCl
    }
 }
 
+namespace {
+   // Read n values of type kind at start, as written by WritePrimitives.
+   void ReadFundamentals(TBuffer &b, void *start, int n, int kind)
+   {
+      switch (kind) {
+         case kChar_t:     b.ReadFastArray((Char_t*)start, n); break;
+         case kShort_t:    b.ReadFastArray((Short_t*)start, n); break;
+         case kInt_t:      b.ReadFastArray((Int_t*)start, n); break;
+         case kLong_t:     b.ReadFastArray((Long_t*)start, n); break;
+         case kLong64_t:   b.ReadFastArray((Long64_t*)start, n); break;
+         case kFloat_t:    b.ReadFastArray((Float_t*)start, n); break;
+         case kFloat16_t:  b.ReadFastArrayFloat16((Float_t*)start, n); break;
+         case kDouble_t:   b.ReadFastArray((Double_t*)start, n); break;
+         case kDouble32_t: b.ReadFastArrayDouble32((Double_t*)start, n); break;
+         case kUChar_t:    b.ReadFastArray((UChar_t*)start, n); break;
+         case kUShort_t:   b.ReadFastArray((UShort_t*)start, n); break;
+         case kUInt_t:     b.ReadFastArray((UInt_t*)start, n); break;
+         case kULong_t:    b.ReadFastArray((ULong_t*)start, n); break;
+         case kULong64_t:  b.ReadFastArray((ULong64_t*)start, n); break;
+      }
+   }
+
+   // Write n values of type kind from start, as WritePrimitives does.
+   void WriteFundamentals(TBuffer &b, void *start, int n, int kind)
+   {
+      switch (kind) {
+         case kChar_t:     b.WriteFastArray((Char_t*)start, n); break;
+         case kShort_t:    b.WriteFastArray((Short_t*)start, n); break;
+         case kInt_t:      b.WriteFastArray((Int_t*)start, n); break;
+         case kLong_t:     b.WriteFastArray((Long_t*)start, n); break;
+         case kLong64_t:   b.WriteFastArray((Long64_t*)start, n); break;
+         case kFloat_t:    b.WriteFastArray((Float_t*)start, n); break;
+         case kFloat16_t:  b.WriteFastArrayFloat16((Float_t*)start, n); break;
+         case kDouble_t:   b.WriteFastArray((Double_t*)start, n); break;
+         case kDouble32_t: b.WriteFastArrayDouble32((Double_t*)start, n); break;
+         case kUChar_t:    b.WriteFastArray((UChar_t*)start, n); break;
+         case kUShort_t:   b.WriteFastArray((UShort_t*)start, n); break;
+         case kUInt_t:     b.WriteFastArray((UInt_t*)start, n); break;
+         case kULong_t:    b.WriteFastArray((ULong_t*)start, n); break;
+         case kULong64_t:  b.WriteFastArray((ULong64_t*)start, n); break;
+      }
+   }
+}
+
+TGenCollectionStreamer *TGenCollectionStreamer::GetNestedVectorStreamer() const
+{
+   // If this is a vector of vectors of a basic type other than bool, return
+   // the streamer of the inner vectors, which are streamed as a count followed
+   // by the values. Return 0 otherwise.
+
+   if (fSTL_type != ROOT::kSTLvector || fVal->fCase != kIsClass || !fVal->fType)
+      return 0;
+   // The inner vectors must be streamed by their collection streamer, which
+   // GetStreamer returns for the current thread.
+   TCollectionClassStreamer *middleman = dynamic_cast<TCollectionClassStreamer*>(fVal->fType->GetStreamer());
+   if (!middleman)
+      return 0;
+   TGenCollectionStreamer *inner = dynamic_cast<TGenCollectionStreamer*>(middleman->GetXYZ());
+   if (!inner || (inner->GetProperties() & kIsEmulated) || !inner->fResize)
+      return 0;
+   if (inner->GetCollectionType() != ROOT::kSTLvector || inner->GetValueClass() || inner->HasPointers())
+      return 0;
+   switch (inner->GetType()) {
+      case kChar_t: case kShort_t: case kInt_t: case kLong_t: case kLong64_t:
+      case kFloat_t: case kFloat16_t: case kDouble_t: case kDouble32_t:
+      case kUChar_t: case kUShort_t: case kUInt_t: case kULong_t: case kULong64_t:
+         // Set up the creation of the iterators.
+         inner->GetFunctionCreateIterators(kTRUE);
+         return inner;
+      default:
+         return 0;
+   }
+}
+
+void TGenCollectionStreamer::ReadNestedVectors(int nElements, TBuffer &b, char *first, TGenCollectionStreamer *inner)
+{
+   // Read the nElements inner vectors starting at first, each with one resize
+   // and one bulk read of its values; see GetNestedVectorStreamer.
+
+   const Int_t kind = inner->fVal->fKind;
+   for (int idx = 0; idx < nElements; ++idx) {
+      void *obj = first + fValDiff * idx;
+      int n = 0;
+      b >> n;
+      inner->fResize(obj, n);
+      if (n > 0) {
+         TVirtualVectorIterators iterators(inner->fFunctionCreateIterators);
+         iterators.CreateIterators(obj);
+         ReadFundamentals(b, iterators.fBegin, n, kind);
+      }
+   }
+}
+
+void TGenCollectionStreamer::WriteNestedVectors(int nElements, TBuffer &b, char *first, TGenCollectionStreamer *inner)
+{
+   // Write the nElements inner vectors starting at first, each as its size
+   // followed by one bulk write of its values; see GetNestedVectorStreamer.
+
+   const Int_t kind = inner->fVal->fKind;
+   const size_t valueSize = inner->fValDiff;
+   for (int idx = 0; idx < nElements; ++idx) {
+      void *obj = first + fValDiff * idx;
+      TVirtualVectorIterators iterators(inner->fFunctionCreateIterators);
+      iterators.CreateIterators(obj);
+      int n = (int)(((char*)iterators.fEnd - (char*)iterators.fBegin) / valueSize);
+      b << n;
+      if (n > 0)
+         WriteFundamentals(b, iterators.fBegin, n, kind);
+   }
+}
+
 void TGenCollectionStreamer::ReadObjects(int nElements, TBuffer &b, const TClass *onFileClass)
 {
    // Object input streamer.
@@ -386,6 +497,12 @@ void TGenCollectionStreamer::ReadObjects(int nElements, TBuffer &b, const TClass
             itm = (StreamHelper*)iterators.fBegin;
          }
          fEnv->fStart = itm;
+         if (!onFileValClass) {
+            if (TGenCollectionStreamer *inner = GetNestedVectorStreamer()) {
+               ReadNestedVectors(nElements, b, (char*)itm, inner);
+               break;
+            }
+         }
          switch (fVal->fCase) {
             case kIsClass:
                DOLOOP(b.StreamObject(i, fVal->fType, onFileValClass ));
@@ -973,6 +1090,10 @@ void TGenCollectionStreamer::WriteObjects(int nElements, TBuffer &b)
       case ROOT::kSTLvector:
 #define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)(((char*)itm) + fValDiff*idx); { x ;} ++idx;} break;}
          itm = (StreamHelper*)fFirst.invoke(fEnv);
+         if (TGenCollectionStreamer *inner = GetNestedVectorStreamer()) {
+            WriteNestedVectors(nElements, b, (char*)itm, inner);
+            break;
+         }
          switch (fVal->fCase) {
             case kIsClass:
                DOLOOP(b.StreamObject(i, fVal->fType));
@@ -15,6 +15,25 @@
 
 A TMemFile is like a normal TFile except that it reads and writes
 only from memory.
+
+The content of a TMemFile can be handed over to other processes of the
+same node through a named POSIX shared memory segment: the producer
+writes its TMemFile into the segment with WriteToShm(), the consumers
+open it read-only with OpenShm(), which reads the objects directly from
+the mapping of the segment, without copying it:
+~~~{.cpp}
+// producer
+TMemFile out("events.root", "RECREATE");
+...
+out.Write();
+out.WriteToShm("/events");
+
+// consumer
+std::unique_ptr<TMemFile> in(TMemFile::OpenShm("/events"));
+TTree *tree = nullptr;
+in->GetObject("events", tree);
+~~~
+The segment stays available until it is removed with UnlinkShm().
 */
 
 #include "TMemFile.h"
@@ -28,6 +47,11 @@ only from memory.
 #include <errno.h>
 #include <stdio.h>
 #include <sys/stat.h>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 // The following snippet is used for developer-level debugging
 #define TMemFile_TRACE
@@ -82,7 +106,8 @@ void TMemFile::TMemBlock::CreateNext(Long64_t size)
 TMemFile::TMemFile(const char *path, Option_t *option,
                    const char *ftitle, Int_t compress) :
    TFile(path, "WEB", ftitle, compress),
-   fSize(-1), fSysOffset(0), fBlockSeek(&fBlockList), fBlockOffset(0)
+   fSize(-1), fSysOffset(0), fBlockSeek(&fBlockList), fBlockOffset(0),
+   fIsOwned(kTRUE), fShmBegin(0), fShmSize(0)
 {
    fOption = option;
    fOption.ToUpper();
@@ -135,7 +160,8 @@ zombie:
 TMemFile::TMemFile(const char *path, char *buffer, Long64_t size, Option_t *option,
                    const char *ftitle, Int_t compress):
    TFile(path, "WEB", ftitle, compress), fBlockList(size),
-   fSize(size), fSysOffset(0), fBlockSeek(&(fBlockList)), fBlockOffset(0)
+   fSize(size), fSysOffset(0), fBlockSeek(&(fBlockList)), fBlockOffset(0),
+   fIsOwned(kTRUE), fShmBegin(0), fShmSize(0)
 {
    fOption = option;
    fOption.ToUpper();
@@ -180,13 +206,52 @@ zombie:
    gDirectory = gROOT;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor reading the file from the memory range 'datarange' without
+/// copying it. The memory is not owned by the TMemFile and must outlive it.
+/// Only the read mode is supported.
+
+TMemFile::TMemFile(const char *path, const ZeroCopyView_t &datarange, Option_t *option,
+                   const char *ftitle, Int_t compress):
+   TFile(path, "WEB", ftitle, compress),
+   fSize(datarange.second), fSysOffset(0), fBlockSeek(&(fBlockList)), fBlockOffset(0),
+   fIsOwned(kFALSE), fShmBegin(0), fShmSize(0)
+{
+   fBlockList.fBuffer = (UChar_t *)datarange.first;
+   fBlockList.fSize = datarange.second;
+
+   fOption = option;
+   fOption.ToUpper();
+   if (fOption.IsNull()) fOption = "READ";
+   if (fOption != "READ") {
+      Error("TMemFile", "A TMemFile reading from a memory range can only be opened in read mode");
+      goto zombie;
+   }
+   if (!datarange.first || datarange.second == 0) {
+      Error("TMemFile", "The memory range of %s is empty", path);
+      goto zombie;
+   }
+
+   fD = SysOpen(path, O_RDONLY, 0644);
+   fWritable = kFALSE;
+
+   Init(kFALSE);
+   return;
+
+zombie:
+   // Error in opening file; make this a zombie
+   MakeZombie();
+   gDirectory = gROOT;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copying the content of the TMemFile into another TMemFile.
 
 TMemFile::TMemFile(const TMemFile &orig) :
    TFile(orig.GetEndpointUrl()->GetUrl(), "WEB", orig.GetTitle(),
          orig.GetCompressionSettings() ), fBlockList(orig.GetEND()),
-   fSize(orig.GetEND()), fSysOffset(0), fBlockSeek(&(fBlockList)), fBlockOffset(0)
+   fSize(orig.GetEND()), fSysOffset(0), fBlockSeek(&(fBlockList)), fBlockOffset(0),
+   fIsOwned(kTRUE), fShmBegin(0), fShmSize(0)
 {
    fOption = orig.fOption;
 
@@ -217,9 +282,104 @@ TMemFile::~TMemFile()
    // Need to call close, now as it will need both our virtual table
    // and the content of the list of blocks
    Close();
+   if (!fIsOwned) {
+      // The memory belongs to the caller or to the shared memory mapping.
+      fBlockList.fBuffer = 0;
+   }
+#ifndef WIN32
+   if (fShmBegin)
+      munmap(fShmBegin, fShmSize);
+#endif
    TRACE("destroy")
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Open read-only the TMemFile written into the POSIX shared memory segment
+/// 'shmName' by WriteToShm(), possibly by another process. The objects are
+/// read directly from the mapping of the segment, which stays valid until
+/// the returned TMemFile is deleted, even if the segment is unlinked.
+/// Return 0 if the segment cannot be opened.
+
+TMemFile *TMemFile::OpenShm(const char *shmName, const char *name)
+{
+#ifndef WIN32
+   Int_t fd = shm_open(shmName, O_RDONLY, 0);
+   if (fd == -1) {
+      ::SysError("TMemFile::OpenShm", "cannot open shared memory segment %s", shmName);
+      return 0;
+   }
+   struct stat sbuf;
+   if (fstat(fd, &sbuf) == -1 || sbuf.st_size == 0) {
+      ::Error("TMemFile::OpenShm", "shared memory segment %s is empty", shmName);
+      close(fd);
+      return 0;
+   }
+   void *addr = mmap(0, sbuf.st_size, PROT_READ, MAP_SHARED, fd, 0);
+   close(fd);
+   if (addr == MAP_FAILED) {
+      ::SysError("TMemFile::OpenShm", "cannot map shared memory segment %s", shmName);
+      return 0;
+   }
+   TMemFile *file = new TMemFile(name ? name : shmName, ZeroCopyView_t((const char *)addr, sbuf.st_size), "READ");
+   file->fShmBegin = addr;
+   file->fShmSize = sbuf.st_size;
+   return file;
+#else
+   ::Error("TMemFile::OpenShm", "shared memory segments are not supported on this platform (%s)", shmName);
+   return 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the POSIX shared memory segment 'shmName'. The processes which
+/// already opened it keep their mapping. Return 0 on success, -1 otherwise.
+
+Int_t TMemFile::UnlinkShm(const char *shmName)
+{
+#ifndef WIN32
+   return shm_unlink(shmName);
+#else
+   ::Error("TMemFile::UnlinkShm", "shared memory segments are not supported on this platform (%s)", shmName);
+   return -1;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the binary representation of the TMemFile into the POSIX shared
+/// memory segment 'shmName', created or replaced, so that other processes of
+/// the node can open it with OpenShm(). The content written so far, up to
+/// GetEND(), is published: call Write() before. Return the number of bytes
+/// written, or -1 on failure.
+
+Long64_t TMemFile::WriteToShm(const char *shmName) const
+{
+#ifndef WIN32
+   const Long64_t len = GetEND();
+   Int_t fd = shm_open(shmName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+   if (fd == -1) {
+      SysError("WriteToShm", "cannot create shared memory segment %s", shmName);
+      return -1;
+   }
+   if (ftruncate(fd, len) == -1) {
+      SysError("WriteToShm", "cannot resize shared memory segment %s to %lld bytes", shmName, len);
+      close(fd);
+      return -1;
+   }
+   void *addr = mmap(0, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+   if (addr == MAP_FAILED) {
+      SysError("WriteToShm", "cannot map shared memory segment %s", shmName);
+      return -1;
+   }
+   Long64_t written = CopyTo(addr, len);
+   munmap(addr, len);
+   return written;
+#else
+   Error("WriteToShm", "shared memory segments are not supported on this platform (%s)", shmName);
+   return -1;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy the binary representation of the TMemFile into
 /// the memory area starting at 'to' and of length at most 'maxsize'
@@ -0,0 +1,528 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/**
+\class TShmObjectStore TShmObjectStore.cxx
+\ingroup IO
+
+Objects shared between the processes of a node through a named POSIX
+shared memory segment, e.g. the histograms of an online monitoring.
+
+It replaces TMapFile for this use case: the segment contains no pointer,
+only offsets, so that the processes can map it at any address; a
+process-shared reader-writer lock lets several readers access it
+concurrently; an update of an object whose streamed size is unchanged, such
+as a histogram filled further, overwrites its record in place; readers
+stream the objects directly from the mapping, without copying it, and can
+check their version to skip the ones which did not change:
+~~~{.cpp}
+// producer
+TShmObjectStore *store = TShmObjectStore::Create("/monitoring");
+TH1F h("h", "h", 100, 0, 10);
+store->Add(&h);
+while (...) {
+   h.Fill(...);
+   store->Update(); // or store->Update(&h)
+}
+
+// consumer
+TShmObjectStore *store = TShmObjectStore::Open("/monitoring");
+TH1F *h = (TH1F *)store->Get("h");
+~~~
+The objects are streamed outside of the lock, into a buffer of the writer
+reused by all the updates, and the lock is held only to copy them into the
+segment. GetView() gives access to the streamed bytes of an object, which
+stay unchanged as long as the reader holds the lock with LockRead().
+
+The segment is created with a fixed size and a fixed number of records: an
+object growing beyond the room reserved for it (a quarter more than its
+first size) moves to a new region, and the regions of the removed objects
+are reused by the objects added later. The segment stays available until it
+is removed with Unlink(). The processes opening it need write access, for
+the lock.
+*/
+
+#include "TShmObjectStore.h"
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TError.h"
+
+#include <string.h>
+#include <sys/stat.h>
+#ifndef WIN32
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+ClassImp(TShmObjectStore);
+
+namespace {
+
+const UInt_t kShmStoreMagic = 0x524f4f54; // "ROOT"
+const UInt_t kShmStoreLayout = 1;         // version of the layout of the segment
+const Int_t kShmStoreNameLength = 128;
+
+/// Description of an object of the segment
+struct TShmStoreRecord {
+   char fName[kShmStoreNameLength];      ///< Name of the object
+   char fClassName[kShmStoreNameLength]; ///< Class of the object
+   Long64_t fOffset;                     ///< Offset of the streamed object from the start of the segment
+   Long64_t fLength;                     ///< Length of the streamed object
+   Long64_t fCapacity;                   ///< Size of the region reserved for the object
+   ULong64_t fVersion;                   ///< Number of times the object was written
+   Int_t fUsed;                          ///< Whether the record holds an object, else its region can be reused
+};
+
+/// Start of the segment, followed by the records and the regions of the objects
+struct TShmStoreHeader {
+   UInt_t fMagic;          ///< kShmStoreMagic, set once the segment is initialized
+   UInt_t fLayout;         ///< kShmStoreLayout
+#ifndef WIN32
+   pthread_rwlock_t fLock; ///< Process-shared reader-writer lock
+#endif
+   Long64_t fSize;         ///< Size of the segment
+   Long64_t fFree;         ///< Offset of the first byte not reserved for an object
+   ULong64_t fGeneration;  ///< Number of modifications of the segment
+   Int_t fMaxRecords;      ///< Number of records
+   Int_t fNRecords;        ///< Number of records used so far
+};
+
+const Long64_t kShmStoreRecordsOffset = (sizeof(TShmStoreHeader) + 63) & ~63;
+
+inline TShmStoreHeader *GetHeader(char *base)
+{
+   return (TShmStoreHeader *)base;
+}
+
+inline TShmStoreRecord *GetRecords(char *base)
+{
+   return (TShmStoreRecord *)(base + kShmStoreRecordsOffset);
+}
+
+void WriteLock(char *base)
+{
+#ifndef WIN32
+   pthread_rwlock_wrlock(&GetHeader(base)->fLock);
+#else
+   (void)base;
+#endif
+}
+
+void ReadLock(char *base)
+{
+#ifndef WIN32
+   pthread_rwlock_rdlock(&GetHeader(base)->fLock);
+#else
+   (void)base;
+#endif
+}
+
+void Unlock(char *base)
+{
+#ifndef WIN32
+   pthread_rwlock_unlock(&GetHeader(base)->fLock);
+#else
+   (void)base;
+#endif
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor, used by Create() and Open(), taking ownership of the mapping.
+
+TShmObjectStore::TShmObjectStore(const char *name, char *base, Long64_t size, Bool_t writable)
+   : fName(name), fBase(base), fSize(size), fWritable(writable), fBuffer(0)
+{
+   if (fWritable)
+      fBuffer = new TBufferFile(TBuffer::kWrite);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor, unmaps the segment. The segment stays available to the other
+/// processes, until it is removed with Unlink().
+
+TShmObjectStore::~TShmObjectStore()
+{
+   delete fBuffer;
+#ifndef WIN32
+   if (fBase)
+      munmap(fBase, fSize);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create, or replace, the POSIX shared memory segment 'shmName' of 'size'
+/// bytes, holding at most 'maxobjects' objects, and open it for writing.
+/// Return 0 if the segment cannot be created.
+
+TShmObjectStore *TShmObjectStore::Create(const char *shmName, Long64_t size, Int_t maxobjects)
+{
+#ifndef WIN32
+   const Long64_t dataStart = kShmStoreRecordsOffset + maxobjects * (Long64_t)sizeof(TShmStoreRecord);
+   if (maxobjects <= 0 || size <= dataStart) {
+      ::Error("TShmObjectStore::Create", "size %lld too small for %d objects", size, maxobjects);
+      return 0;
+   }
+   Int_t fd = shm_open(shmName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+   if (fd == -1) {
+      ::SysError("TShmObjectStore::Create", "cannot create shared memory segment %s", shmName);
+      return 0;
+   }
+   if (ftruncate(fd, size) == -1) {
+      ::SysError("TShmObjectStore::Create", "cannot resize shared memory segment %s to %lld bytes", shmName, size);
+      close(fd);
+      return 0;
+   }
+   void *addr = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+   if (addr == MAP_FAILED) {
+      ::SysError("TShmObjectStore::Create", "cannot map shared memory segment %s", shmName);
+      return 0;
+   }
+
+   char *base = (char *)addr;
+   memset(base, 0, dataStart);
+   TShmStoreHeader *header = GetHeader(base);
+   pthread_rwlockattr_t attr;
+   pthread_rwlockattr_init(&attr);
+   pthread_rwlockattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+   pthread_rwlock_init(&header->fLock, &attr);
+   pthread_rwlockattr_destroy(&attr);
+   header->fLayout = kShmStoreLayout;
+   header->fSize = size;
+   header->fFree = dataStart;
+   header->fMaxRecords = maxobjects;
+   __atomic_store_n(&header->fMagic, kShmStoreMagic, __ATOMIC_RELEASE);
+
+   return new TShmObjectStore(shmName, base, size, kTRUE);
+#else
+   (void)size;
+   (void)maxobjects;
+   ::Error("TShmObjectStore::Create", "shared memory segments are not supported on this platform (%s)", shmName);
+   return 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open the segment 'shmName' created by Create(), possibly by another
+/// process. With 'writable', objects can be added and updated, but a single
+/// process should write them. Return 0 if the segment cannot be opened.
+
+TShmObjectStore *TShmObjectStore::Open(const char *shmName, Bool_t writable)
+{
+#ifndef WIN32
+   Int_t fd = shm_open(shmName, O_RDWR, 0);
+   if (fd == -1) {
+      ::SysError("TShmObjectStore::Open", "cannot open shared memory segment %s", shmName);
+      return 0;
+   }
+   struct stat sbuf;
+   if (fstat(fd, &sbuf) == -1 || sbuf.st_size < (Long64_t)sizeof(TShmStoreHeader)) {
+      ::Error("TShmObjectStore::Open", "shared memory segment %s is not an object store", shmName);
+      close(fd);
+      return 0;
+   }
+   // the lock is modified by the readers too
+   void *addr = mmap(0, sbuf.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+   if (addr == MAP_FAILED) {
+      ::SysError("TShmObjectStore::Open", "cannot map shared memory segment %s", shmName);
+      return 0;
+   }
+   TShmStoreHeader *header = GetHeader((char *)addr);
+   if (__atomic_load_n(&header->fMagic, __ATOMIC_ACQUIRE) != kShmStoreMagic || header->fLayout != kShmStoreLayout ||
+       header->fSize != sbuf.st_size) {
+      ::Error("TShmObjectStore::Open", "shared memory segment %s is not an object store", shmName);
+      munmap(addr, sbuf.st_size);
+      return 0;
+   }
+   return new TShmObjectStore(shmName, (char *)addr, sbuf.st_size, writable);
+#else
+   (void)writable;
+   ::Error("TShmObjectStore::Open", "shared memory segments are not supported on this platform (%s)", shmName);
+   return 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the POSIX shared memory segment 'shmName'. The processes which
+/// already opened it keep their mapping. Return 0 on success, -1 otherwise.
+
+Int_t TShmObjectStore::Unlink(const char *shmName)
+{
+#ifndef WIN32
+   return shm_unlink(shmName);
+#else
+   ::Error("TShmObjectStore::Unlink", "shared memory segments are not supported on this platform (%s)", shmName);
+   return -1;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the record of the object 'name', or -1.
+/// The lock must be held.
+
+Int_t TShmObjectStore::FindRecord(const char *name) const
+{
+   const TShmStoreHeader *header = GetHeader(fBase);
+   const TShmStoreRecord *records = GetRecords(fBase);
+   for (Int_t i = 0; i < header->fNRecords; ++i)
+      if (records[i].fUsed && !strcmp(records[i].fName, name))
+         return i;
+   return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stream the object and copy it into its record, reusing the region of the
+/// record when it is large enough.
+
+Bool_t TShmObjectStore::Write(const char *name, const TObject *obj)
+{
+   fBuffer->Reset();
+   fBuffer->MapObject(obj); // register obj in map to handle self reference
+   const_cast<TObject *>(obj)->Streamer(*fBuffer);
+   const Long64_t len = fBuffer->Length();
+
+   WriteLock(fBase);
+   TShmStoreHeader *header = GetHeader(fBase);
+   TShmStoreRecord *records = GetRecords(fBase);
+   Int_t idx = FindRecord(name);
+   const Bool_t added = idx < 0;
+   if (added) {
+      // reuse preferably a removed record whose region is large enough
+      for (Int_t i = 0; i < header->fNRecords; ++i) {
+         if (records[i].fUsed)
+            continue;
+         if (idx < 0 || records[i].fCapacity >= len)
+            idx = i;
+         if (records[i].fCapacity >= len)
+            break;
+      }
+      if (idx < 0 && header->fNRecords < header->fMaxRecords)
+         idx = header->fNRecords++;
+      if (idx < 0) {
+         Unlock(fBase);
+         Error("Write", "no more room for object %s in %s, already %d objects", name, GetName(), header->fMaxRecords);
+         return kFALSE;
+      }
+      strlcpy(records[idx].fName, name, kShmStoreNameLength);
+      records[idx].fUsed = 1;
+   }
+
+   TShmStoreRecord &rec = records[idx];
+   if (rec.fCapacity < len) {
+      const Long64_t capacity = ((len + len / 4) + 7) & ~7;
+      if (header->fFree + capacity > header->fSize) {
+         if (added)
+            rec.fUsed = 0;
+         Unlock(fBase);
+         Error("Write", "no more room for object %s of %lld bytes in %s", name, len, GetName());
+         return kFALSE;
+      }
+      rec.fOffset = header->fFree;
+      rec.fCapacity = capacity;
+      header->fFree += capacity;
+   }
+   memcpy(fBase + rec.fOffset, fBuffer->Buffer(), len);
+   strlcpy(rec.fClassName, obj->ClassName(), kShmStoreNameLength);
+   rec.fLength = len;
+   rec.fVersion++;
+   header->fGeneration++;
+   Unlock(fBase);
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add an object to the segment, under its name or under 'name'. It replaces
+/// the object of the same name, if any. The object is written immediately,
+/// and again at each Update(). Return kFALSE if it does not fit.
+
+Bool_t TShmObjectStore::Add(const TObject *obj, const char *name)
+{
+   if (!fWritable || !obj)
+      return kFALSE;
+
+   const char *n = (name && *name) ? name : obj->GetName();
+   if (strlen(n) >= (size_t)kShmStoreNameLength || strlen(obj->ClassName()) >= (size_t)kShmStoreNameLength) {
+      Error("Add", "name %s or class %s of object too long", n, obj->ClassName());
+      return kFALSE;
+   }
+   if (!Write(n, obj))
+      return kFALSE;
+   fObjects[n] = obj;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write again into the segment an object (or all objects, if obj == 0) added
+/// by this process. Return the number of objects written.
+
+Int_t TShmObjectStore::Update(const TObject *obj)
+{
+   if (!fWritable)
+      return 0;
+
+   Int_t nwritten = 0;
+   for (auto &entry : fObjects) {
+      if (obj && entry.second != obj)
+         continue;
+      if (Write(entry.first.c_str(), entry.second))
+         nwritten++;
+   }
+   return nwritten;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the object 'name' from the segment. Its region is reused by the
+/// objects added later. Return kFALSE if there is no such object.
+
+Bool_t TShmObjectStore::Remove(const char *name)
+{
+   if (!fWritable || !name)
+      return kFALSE;
+
+   fObjects.erase(name);
+
+   WriteLock(fBase);
+   Int_t idx = FindRecord(name);
+   if (idx >= 0) {
+      GetRecords(fBase)[idx].fUsed = 0;
+      GetHeader(fBase)->fGeneration++;
+   }
+   Unlock(fBase);
+
+   return idx >= 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the object 'name' from the segment; it is streamed directly from the
+/// shared memory. The object is owned by the caller. 'retObj', typically the
+/// object returned by a previous call, is deleted.
+/// Return 0 if there is no such object.
+
+TObject *TShmObjectStore::Get(const char *name, TObject *retObj) const
+{
+   delete retObj;
+
+   TObject *obj = 0;
+   ReadLock(fBase);
+   Int_t idx = FindRecord(name);
+   if (idx >= 0) {
+      const TShmStoreRecord &rec = GetRecords(fBase)[idx];
+      TClass *cl = TClass::GetClass(rec.fClassName);
+      if (!cl) {
+         Error("Get", "unknown class %s", rec.fClassName);
+      } else if (!(obj = (TObject *)cl->New())) {
+         Error("Get", "cannot create new object of class %s", rec.fClassName);
+      } else {
+         TBufferFile b(TBuffer::kRead, rec.fLength, fBase + rec.fOffset, kFALSE);
+         b.MapObject(obj); // register obj in map to handle self reference
+         obj->Streamer(b);
+      }
+   }
+   Unlock(fBase);
+
+   return obj;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give access to the bytes of the object 'name' streamed in the segment,
+/// e.g. to read them with a TBufferFile, and its class name. The caller must
+/// hold the lock with LockRead() as long as it uses the view.
+/// Return kFALSE if there is no such object.
+
+Bool_t TShmObjectStore::GetView(const char *name, ZeroCopyView_t &view, TString *classname) const
+{
+   Int_t idx = FindRecord(name);
+   if (idx < 0)
+      return kFALSE;
+   const TShmStoreRecord &rec = GetRecords(fBase)[idx];
+   view = ZeroCopyView_t(fBase + rec.fOffset, rec.fLength);
+   if (classname)
+      *classname = rec.fClassName;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of times the object 'name' was written, or 0 if there
+/// is no such object. Readers can skip the objects whose version did not change.
+
+ULong64_t TShmObjectStore::GetVersion(const char *name) const
+{
+   ReadLock(fBase);
+   Int_t idx = FindRecord(name);
+   ULong64_t version = idx >= 0 ? GetRecords(fBase)[idx].fVersion : 0;
+   Unlock(fBase);
+   return version;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of modifications of the segment, incremented at each
+/// write or removal of an object.
+
+ULong64_t TShmObjectStore::GetGeneration() const
+{
+   ReadLock(fBase);
+   ULong64_t generation = GetHeader(fBase)->fGeneration;
+   Unlock(fBase);
+   return generation;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of objects in the segment.
+
+Int_t TShmObjectStore::GetEntries() const
+{
+   ReadLock(fBase);
+   const TShmStoreRecord *records = GetRecords(fBase);
+   Int_t n = 0;
+   for (Int_t i = 0; i < GetHeader(fBase)->fNRecords; ++i)
+      if (records[i].fUsed)
+         n++;
+   Unlock(fBase);
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Acquire the lock for reading, shared with the other readers, to use the
+/// views given by GetView().
+
+void TShmObjectStore::LockRead() const
+{
+   ReadLock(fBase);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the lock acquired with LockRead().
+
+void TShmObjectStore::UnlockRead() const
+{
+   Unlock(fBase);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the objects of the segment and their size.
+
+void TShmObjectStore::Print(Option_t *) const
+{
+   ReadLock(fBase);
+   const TShmStoreHeader *header = GetHeader(fBase);
+   const TShmStoreRecord *records = GetRecords(fBase);
+   Printf("Shared memory object store: %s, %lld bytes, %lld used", GetName(), header->fSize, header->fFree);
+   for (Int_t i = 0; i < header->fNRecords; ++i)
+      if (records[i].fUsed)
+         Printf("   %-20s %-20s %10lld bytes, version %llu", records[i].fName, records[i].fClassName,
+                records[i].fLength, records[i].fVersion);
+   Unlock(fBase);
+}
@@ -168,6 +168,12 @@ TStreamerInfo::TStreamerInfo()
    fWriteMemberWise = 0;
    fWriteMemberWiseVecPtr = 0;
    fWriteText = 0;
+   fJitReadActions = 0;
+   fJitWriteActions = 0;
+   fReadMemberWiseInCollection = 0;
+   fJitReadFunc = 0;
+   fJitWriteFunc = 0;
+   fJitState = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -203,6 +209,12 @@ TStreamerInfo::TStreamerInfo(TClass *cl)
    fWriteMemberWise = 0;
    fWriteMemberWiseVecPtr = 0;
    fWriteText = 0;
+   fJitReadActions = 0;
+   fJitWriteActions = 0;
+   fReadMemberWiseInCollection = 0;
+   fJitReadFunc = 0;
+   fJitWriteFunc = 0;
+   fJitState = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -223,6 +235,13 @@ TStreamerInfo::~TStreamerInfo()
    delete fWriteMemberWise;
    delete fWriteMemberWiseVecPtr;
    delete fWriteText;
+   delete fJitReadActions;
+   delete fJitWriteActions;
+   if (fReadMemberWiseInCollection) {
+      for (auto &entry : *fReadMemberWiseInCollection)
+         delete entry.second;
+      delete fReadMemberWiseInCollection;
+   }
 
    if (!fElements) return;
    fElements->Delete();
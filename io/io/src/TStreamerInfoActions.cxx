@@ -228,6 +228,55 @@ namespace TStreamerInfoActions
       return 0;
    }
 
+   // Fixed size arrays of basic types and runs of consecutive data members of the same
+   // basic type (regrouped by TStreamerInfo::Compile) are streamed with a single call to
+   // Read/WriteFastArray, which byte swaps the whole array at once, instead of going
+   // through the element type dispatch of TStreamerInfo::ReadBuffer.
+
+   template <typename T>
+   INLINE_TEMPLATE_ARGS Int_t ReadBasicTypeArray(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      T *x = (T *)(((char *)addr) + config->fOffset);
+      buf.ReadFastArray(x, config->fCompInfo->fLength);
+      return 0;
+   }
+
+   INLINE_TEMPLATE_ARGS Int_t ReadFloat16Array(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      Float_t *x = (Float_t *)(((char *)addr) + config->fOffset);
+      buf.ReadFastArrayFloat16(x, config->fCompInfo->fLength, config->fCompInfo->fElem);
+      return 0;
+   }
+
+   INLINE_TEMPLATE_ARGS Int_t ReadDouble32Array(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      Double_t *x = (Double_t *)(((char *)addr) + config->fOffset);
+      buf.ReadFastArrayDouble32(x, config->fCompInfo->fLength, config->fCompInfo->fElem);
+      return 0;
+   }
+
+   template <typename T>
+   INLINE_TEMPLATE_ARGS Int_t WriteBasicTypeArray(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      T *x = (T *)(((char *)addr) + config->fOffset);
+      buf.WriteFastArray(x, config->fCompInfo->fLength);
+      return 0;
+   }
+
+   INLINE_TEMPLATE_ARGS Int_t WriteFloat16Array(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      Float_t *x = (Float_t *)(((char *)addr) + config->fOffset);
+      buf.WriteFastArrayFloat16(x, config->fCompInfo->fLength, config->fCompInfo->fElem);
+      return 0;
+   }
+
+   INLINE_TEMPLATE_ARGS Int_t WriteDouble32Array(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      Double_t *x = (Double_t *)(((char *)addr) + config->fOffset);
+      buf.WriteFastArrayDouble32(x, config->fCompInfo->fLength, config->fCompInfo->fElem);
+      return 0;
+   }
+
    INLINE_TEMPLATE_ARGS Int_t WriteTextTNamed(TBuffer &buf, void *addr, const TConfiguration *config)
    {
       void *x = (void *)(((char *)addr) + config->fOffset);
@@ -1440,6 +1489,27 @@ namespace TStreamerInfoActions
       }
    };
 
+   template <typename From, typename To>
+   struct ConvertBasicTypeArray {
+      static INLINE_TEMPLATE_ARGS Int_t Action(TBuffer &buf, void *addr, const TConfiguration *config)
+      {
+         // Conversion from a fixed size array of 'From' on disk to an array of 'To' in memory,
+         // read by blocks into a buffer on the stack.
+         const Int_t kBlockSize = 64;
+         From temp[kBlockSize];
+         To *x = (To*)( ((char*)addr) + config->fOffset );
+         const Int_t len = config->fCompInfo->fLength;
+         for (Int_t done = 0; done < len; done += kBlockSize) {
+            const Int_t n = (len - done < kBlockSize) ? len - done : kBlockSize;
+            buf.ReadFastArray(temp, n);
+            for (Int_t j = 0; j < n; ++j) {
+               x[done + j] = (To)temp[j];
+            }
+         }
+         return 0;
+      }
+   };
+
    class TConfigurationUseCache : public TConfiguration {
       // Configuration object for the UseCache case.
    public:
@@ -2938,6 +3008,22 @@ void TStreamerInfo::Compile()
    if (fWriteText) fWriteText->fActions.clear();
    else fWriteText = new TStreamerInfoActions::TActionSequence(this,ndata);
 
+   // The just-in-time compiled functions are generated again on first use.
+   fJitState = 0;
+   fJitReadFunc = 0;
+   fJitWriteFunc = 0;
+   delete fJitReadActions;
+   fJitReadActions = 0;
+   delete fJitWriteActions;
+   fJitWriteActions = 0;
+
+   // So are the member wise actions for the collections.
+   if (fReadMemberWiseInCollection) {
+      for (auto &entry : *fReadMemberWiseInCollection)
+         delete entry.second;
+      fReadMemberWiseInCollection->clear();
+   }
+
    if (!ndata) {
       // This may be the case for empty classes (e.g., TAtt3D).
       // We still need to properly set the size of emulated classes (i.e. add the virtual table)
@@ -3122,6 +3208,43 @@ void TStreamerInfo::Compile()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the member wise read actions of this class as the content of a
+/// collection of the same type as proxy, for the branches of the base classes
+/// and embedded objects of a split collection. The actions are created once
+/// per collection class and reused by the branches of all the trees (for
+/// example the files of a chain) stored with this layout.
+/// Return 0 for the collections which are not iterated as vectors: their
+/// actions refer to proxy itself, see TActionSequence::CreateReadMemberWiseActions.
+
+TStreamerInfoActions::TActionSequence *TStreamerInfo::GetReadMemberWiseActions(TVirtualCollectionProxy &proxy)
+{
+   switch (proxy.GetCollectionType()) {
+      case ROOT::kSTLvector:
+      case ROOT::kSTLset:
+      case ROOT::kSTLunorderedset:
+      case ROOT::kSTLmultiset:
+      case ROOT::kSTLunorderedmultiset:
+      case ROOT::kSTLmap:
+      case ROOT::kSTLmultimap:
+      case ROOT::kSTLunorderedmap:
+      case ROOT::kSTLunorderedmultimap:
+         break;
+      default:
+         if (!(proxy.GetProperties() & TVirtualCollectionProxy::kIsEmulated))
+            return 0;
+   }
+
+   R__LOCKGUARD(gInterpreterMutex);
+
+   if (!fReadMemberWiseInCollection)
+      fReadMemberWiseInCollection = new std::map<const TClass*, TStreamerInfoActions::TActionSequence*>();
+   TStreamerInfoActions::TActionSequence *&actions = (*fReadMemberWiseInCollection)[proxy.GetCollectionClass()];
+   if (!actions)
+      actions = TStreamerInfoActions::TActionSequence::CreateReadMemberWiseActions(this, proxy);
+   return actions;
+}
+
 template <typename From>
 static void AddReadConvertAction(TStreamerInfoActions::TActionSequence *sequence, Int_t newtype, TConfiguration *conf)
 {
@@ -3145,6 +3268,33 @@ static void AddReadConvertAction(TStreamerInfoActions::TActionSequence *sequence
    }
 }
 
+template <typename From>
+static void AddReadConvertArrayAction(TStreamerInfoActions::TActionSequence *sequence, Int_t newtype, TConfiguration *conf)
+{
+   switch (newtype) {
+      case TStreamerInfo::kBool:    sequence->AddAction( ConvertBasicTypeArray<From,bool>::Action,  conf ); break;
+      case TStreamerInfo::kChar:    sequence->AddAction( ConvertBasicTypeArray<From,char>::Action,  conf ); break;
+      case TStreamerInfo::kShort:   sequence->AddAction( ConvertBasicTypeArray<From,short>::Action, conf );  break;
+      case TStreamerInfo::kInt:     sequence->AddAction( ConvertBasicTypeArray<From,Int_t>::Action, conf ); break;
+      case TStreamerInfo::kLong:    sequence->AddAction( ConvertBasicTypeArray<From,Long_t>::Action,conf ); break;
+      case TStreamerInfo::kLong64:  sequence->AddAction( ConvertBasicTypeArray<From,Long64_t>::Action, conf ); break;
+      case TStreamerInfo::kFloat:   sequence->AddAction( ConvertBasicTypeArray<From,float>::Action,    conf ); break;
+      case TStreamerInfo::kFloat16: sequence->AddAction( ConvertBasicTypeArray<From,float>::Action,    conf ); break;
+      case TStreamerInfo::kDouble:  sequence->AddAction( ConvertBasicTypeArray<From,double>::Action,   conf ); break;
+      case TStreamerInfo::kDouble32:sequence->AddAction( ConvertBasicTypeArray<From,double>::Action,   conf ); break;
+      case TStreamerInfo::kUChar:   sequence->AddAction( ConvertBasicTypeArray<From,UChar_t>::Action,  conf ); break;
+      case TStreamerInfo::kUShort:  sequence->AddAction( ConvertBasicTypeArray<From,UShort_t>::Action, conf ); break;
+      case TStreamerInfo::kUInt:    sequence->AddAction( ConvertBasicTypeArray<From,UInt_t>::Action,   conf ); break;
+      case TStreamerInfo::kULong:   sequence->AddAction( ConvertBasicTypeArray<From,ULong_t>::Action,  conf ); break;
+      case TStreamerInfo::kULong64: sequence->AddAction( ConvertBasicTypeArray<From,ULong64_t>::Action,conf );  break;
+      default:
+         // Not a basic type, let the legacy code handle (or complain about) it.
+         sequence->AddAction( GenericReadAction, new TGenericConfiguration(conf->fInfo,conf->fElemId,conf->fCompInfo) );
+         delete conf;
+         break;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add a read action for the given element.
 
@@ -3193,6 +3343,22 @@ void TStreamerInfo::AddReadAction(TStreamerInfoActions::TActionSequence *readSeq
          }
          break;
       }
+      // read fixed size arrays and regrouped data members of basic types
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kBool: readSequence->AddAction( ReadBasicTypeArray<Bool_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kChar: readSequence->AddAction( ReadBasicTypeArray<Char_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kShort: readSequence->AddAction( ReadBasicTypeArray<Short_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kInt: readSequence->AddAction( ReadBasicTypeArray<Int_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong: readSequence->AddAction( ReadBasicTypeArray<Long_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong64: readSequence->AddAction( ReadBasicTypeArray<Long64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kFloat: readSequence->AddAction( ReadBasicTypeArray<Float_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kDouble: readSequence->AddAction( ReadBasicTypeArray<Double_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUChar: readSequence->AddAction( ReadBasicTypeArray<UChar_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUShort: readSequence->AddAction( ReadBasicTypeArray<UShort_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUInt: readSequence->AddAction( ReadBasicTypeArray<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong: readSequence->AddAction( ReadBasicTypeArray<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong64: readSequence->AddAction( ReadBasicTypeArray<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kFloat16: readSequence->AddAction( ReadFloat16Array, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kDouble32: readSequence->AddAction( ReadDouble32Array, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
       case TStreamerInfo::kTNamed:  readSequence->AddAction( ReadTNamed, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
          // Idea: We should calculate the CanIgnoreTObjectStreamer here and avoid calling the
          // Streamer alltogether.
@@ -3366,6 +3532,54 @@ void TStreamerInfo::AddReadAction(TStreamerInfoActions::TActionSequence *readSeq
          }
          break;
       }
+      // convert fixed size arrays of basic types
+      case TStreamerInfo::kConvL + TStreamerInfo::kBool:
+         AddReadConvertArrayAction<Bool_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
+      case TStreamerInfo::kConvL + TStreamerInfo::kChar:
+         AddReadConvertArrayAction<Char_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
+      case TStreamerInfo::kConvL + TStreamerInfo::kShort:
+         AddReadConvertArrayAction<Short_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
+      case TStreamerInfo::kConvL + TStreamerInfo::kInt:
+         AddReadConvertArrayAction<Int_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
+      case TStreamerInfo::kConvL + TStreamerInfo::kLong:
+         if (compinfo->fNewType % 20 == TStreamerInfo::kLong64 || compinfo->fNewType % 20 == TStreamerInfo::kULong64) {
+            AddReadConvertArrayAction<Long64_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         } else {
+            AddReadConvertArrayAction<Long_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         }
+         break;
+      case TStreamerInfo::kConvL + TStreamerInfo::kLong64:
+         AddReadConvertArrayAction<Long64_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
+      case TStreamerInfo::kConvL + TStreamerInfo::kFloat:
+         AddReadConvertArrayAction<Float_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
+      case TStreamerInfo::kConvL + TStreamerInfo::kDouble:
+         AddReadConvertArrayAction<Double_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
+      case TStreamerInfo::kConvL + TStreamerInfo::kUChar:
+         AddReadConvertArrayAction<UChar_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
+      case TStreamerInfo::kConvL + TStreamerInfo::kUShort:
+         AddReadConvertArrayAction<UShort_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
+      case TStreamerInfo::kConvL + TStreamerInfo::kUInt:
+         AddReadConvertArrayAction<UInt_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
+      case TStreamerInfo::kConvL + TStreamerInfo::kULong:
+         if (compinfo->fNewType % 20 == TStreamerInfo::kLong64 || compinfo->fNewType % 20 == TStreamerInfo::kULong64) {
+            AddReadConvertArrayAction<ULong64_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         } else {
+            AddReadConvertArrayAction<ULong_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         }
+         break;
+      case TStreamerInfo::kConvL + TStreamerInfo::kULong64:
+         AddReadConvertArrayAction<ULong64_t>(readSequence, compinfo->fNewType % 20, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
       default:
          readSequence->AddAction( GenericReadAction, new TGenericConfiguration(this,i,compinfo) );
          break;
@@ -3489,6 +3703,22 @@ void TStreamerInfo::AddWriteAction(TStreamerInfoActions::TActionSequence *writeS
       case TStreamerInfo::kUInt:    writeSequence->AddAction( WriteBasicType<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
       case TStreamerInfo::kULong:   writeSequence->AddAction( WriteBasicType<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
       case TStreamerInfo::kULong64: writeSequence->AddAction( WriteBasicType<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      // write fixed size arrays and regrouped data members of basic types
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kBool: writeSequence->AddAction( WriteBasicTypeArray<Bool_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kChar: writeSequence->AddAction( WriteBasicTypeArray<Char_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kShort: writeSequence->AddAction( WriteBasicTypeArray<Short_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kInt: writeSequence->AddAction( WriteBasicTypeArray<Int_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong: writeSequence->AddAction( WriteBasicTypeArray<Long_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong64: writeSequence->AddAction( WriteBasicTypeArray<Long64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kFloat: writeSequence->AddAction( WriteBasicTypeArray<Float_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kDouble: writeSequence->AddAction( WriteBasicTypeArray<Double_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUChar: writeSequence->AddAction( WriteBasicTypeArray<UChar_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUShort: writeSequence->AddAction( WriteBasicTypeArray<UShort_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUInt: writeSequence->AddAction( WriteBasicTypeArray<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong: writeSequence->AddAction( WriteBasicTypeArray<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong64: writeSequence->AddAction( WriteBasicTypeArray<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kFloat16: writeSequence->AddAction( WriteFloat16Array, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kDouble32: writeSequence->AddAction( WriteDouble32Array, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
        // case TStreamerInfo::kBits:    writeSequence->AddAction( WriteBasicType<BitsMarker>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
      /*case TStreamerInfo::kFloat16: {
          if (element->GetFactor() != 0) {
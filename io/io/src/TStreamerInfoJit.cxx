@@ -0,0 +1,175 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// Generation of the just-in-time compiled functions streaming the objects
+// described by a TStreamerInfo, see TVirtualStreamerInfo::SetJitStreamers.
+
+#include "TStreamerInfo.h"
+#include "TStreamerInfoActions.h"
+#include "TStreamerElement.h"
+#include "TInterpreter.h"
+#include "TVirtualMutex.h"
+#include "TError.h"
+#include "TClass.h"
+
+#include <atomic>
+#include <string>
+
+namespace {
+
+/// Return the type name and the suffix of the TBufferFile read and write
+/// functions of a basic type, or false if the type is not handled.
+bool GetJitBasicType(Int_t type, const char *&typeName, const char *&suffix)
+{
+   switch (type) {
+   case TStreamerInfo::kBool: typeName = "Bool_t"; suffix = "Bool"; return true;
+   case TStreamerInfo::kChar: typeName = "Char_t"; suffix = "Char"; return true;
+   case TStreamerInfo::kShort: typeName = "Short_t"; suffix = "Short"; return true;
+   case TStreamerInfo::kInt: typeName = "Int_t"; suffix = "Int"; return true;
+   case TStreamerInfo::kLong: typeName = "Long_t"; suffix = "Long"; return true;
+   case TStreamerInfo::kLong64: typeName = "Long64_t"; suffix = "Long64"; return true;
+   case TStreamerInfo::kFloat: typeName = "Float_t"; suffix = "Float"; return true;
+   case TStreamerInfo::kDouble: typeName = "Double_t"; suffix = "Double"; return true;
+   case TStreamerInfo::kUChar: typeName = "UChar_t"; suffix = "UChar"; return true;
+   case TStreamerInfo::kUShort: typeName = "UShort_t"; suffix = "UShort"; return true;
+   case TStreamerInfo::kUInt: typeName = "UInt_t"; suffix = "UInt"; return true;
+   case TStreamerInfo::kULong: typeName = "ULong_t"; suffix = "ULong"; return true;
+   case TStreamerInfo::kULong64: typeName = "ULong64_t"; suffix = "ULong64"; return true;
+   default: return false;
+   }
+}
+
+std::atomic<Int_t> gJitStreamerCount(0);
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate and compile the functions reading and writing an object of this
+/// StreamerInfo, which replace the object-wise sequences of actions.
+///
+/// The data members of basic types, and the fixed size arrays of them, are
+/// read and written by direct, non-virtual calls to the TBufferFile
+/// functions, with their offsets as constants. The other data members, e.g.
+/// the collections, the objects or the members converted by schema evolution,
+/// are streamed by calling their own action. Nothing is generated if the
+/// StreamerInfo has no data member of basic type: the functions would not be
+/// faster than the sequence of actions.
+
+void TStreamerInfo::JitStreamerFunctions()
+{
+   if (!TVirtualStreamerInfo::GetJitStreamers() || !IsCompiled() || !gInterpreter)
+      return;
+
+   R__LOCKGUARD(gInterpreterMutex);
+   if (fJitState != 0)
+      return;
+
+   const Int_t id = ++gJitStreamerCount;
+   const std::string readName = "R__JitRead" + std::to_string(id);
+   const std::string writeName = "R__JitWrite" + std::to_string(id);
+
+   auto readActions = new TStreamerInfoActions::TActionSequence(this, fNdata);
+   auto writeActions = new TStreamerInfoActions::TActionSequence(this, fNdata);
+   std::string readCode, writeCode;
+   Int_t nInlined = 0;
+   char line[512];
+
+   for (Int_t i = 0; i < fNdata; ++i) {
+      TCompInfo *compinfo = fCompOpt[i];
+      TStreamerElement *element = compinfo->fElem;
+      if (!element || element->GetType() < 0)
+         continue;
+
+      const char *typeName = nullptr, *suffix = nullptr;
+      const Bool_t plain = (compinfo->fType == compinfo->fNewType) && !element->TestBit(TStreamerElement::kCache) &&
+                           !element->TestBit(TStreamerElement::kWrite);
+      if (plain && GetJitBasicType(compinfo->fType, typeName, suffix)) {
+         snprintf(line, sizeof(line), "   b.TBufferFile::Read%s(*(%s *)(obj + %d));\n", suffix, typeName,
+                  compinfo->fOffset);
+         readCode += line;
+         snprintf(line, sizeof(line), "   b.TBufferFile::Write%s(*(%s *)(obj + %d));\n", suffix, typeName,
+                  compinfo->fOffset);
+         writeCode += line;
+         ++nInlined;
+      } else if (plain && compinfo->fLength > 0 &&
+                 GetJitBasicType(compinfo->fType - TStreamerInfo::kOffsetL, typeName, suffix)) {
+         snprintf(line, sizeof(line), "   b.TBufferFile::ReadFastArray((%s *)(obj + %d), %d);\n", typeName,
+                  compinfo->fOffset, compinfo->fLength);
+         readCode += line;
+         snprintf(line, sizeof(line), "   b.TBufferFile::WriteFastArray((const %s *)(obj + %d), %d);\n", typeName,
+                  compinfo->fOffset, compinfo->fLength);
+         writeCode += line;
+         ++nInlined;
+      } else {
+         // Let the usual action of this member do the work.
+         size_t nread = readActions->fActions.size();
+         AddReadAction(readActions, i, compinfo);
+         for (; nread < readActions->fActions.size(); ++nread) {
+            snprintf(line, sizeof(line), "   readActions[%d](b, obj);\n", (int)nread);
+            readCode += line;
+         }
+         size_t nwrite = writeActions->fActions.size();
+         AddWriteAction(writeActions, i, compinfo);
+         for (; nwrite < writeActions->fActions.size(); ++nwrite) {
+            snprintf(line, sizeof(line), "   writeActions[%d](b, obj);\n", (int)nwrite);
+            writeCode += line;
+         }
+      }
+   }
+
+   if (nInlined == 0) {
+      delete readActions;
+      delete writeActions;
+      fJitState = -1;
+      return;
+   }
+
+   std::string code = "#include \"TBufferFile.h\"\n#include \"TStreamerInfoActions.h\"\n"
+                      "namespace ROOT {\nnamespace Internal {\nnamespace JitStreamer {\n";
+   code += "// " + std::string(GetName()) + ", version " + std::to_string(fClassVersion) + "\n";
+   snprintf(line, sizeof(line),
+            "void %s(TBufferFile &b, char *obj)\n{\n"
+            "   const TStreamerInfoActions::ActionContainer_t &readActions = "
+            "((TStreamerInfoActions::TActionSequence *)%p)->fActions;\n"
+            "   (void)readActions;\n",
+            readName.c_str(), (void *)readActions);
+   code += line;
+   code += readCode + "}\n";
+   snprintf(line, sizeof(line),
+            "void %s(TBufferFile &b, char *obj)\n{\n"
+            "   const TStreamerInfoActions::ActionContainer_t &writeActions = "
+            "((TStreamerInfoActions::TActionSequence *)%p)->fActions;\n"
+            "   (void)writeActions;\n",
+            writeName.c_str(), (void *)writeActions);
+   code += line;
+   code += writeCode + "}\n} // namespace JitStreamer\n} // namespace Internal\n} // namespace ROOT\n";
+
+   if (gDebug > 1)
+      Info("JitStreamerFunctions", "Generated code:\n%s", code.c_str());
+
+   JitStreamerFunc_t readFunc = nullptr, writeFunc = nullptr;
+   if (gInterpreter->Declare(code.c_str())) {
+      const std::string prefix = "(Long_t)&ROOT::Internal::JitStreamer::";
+      readFunc = (JitStreamerFunc_t)gInterpreter->Calc((prefix + readName).c_str());
+      writeFunc = (JitStreamerFunc_t)gInterpreter->Calc((prefix + writeName).c_str());
+   }
+   if (!readFunc || !writeFunc) {
+      Warning("JitStreamerFunctions", "Could not compile the streaming functions of %s, version %d", GetName(),
+              fClassVersion);
+      delete readActions;
+      delete writeActions;
+      fJitState = -1;
+      return;
+   }
+
+   fJitReadActions = readActions;
+   fJitWriteActions = writeActions;
+   fJitReadFunc = readFunc;
+   fJitWriteFunc = writeFunc;
+   fJitState = 1;
+}
@@ -0,0 +1,99 @@
+#include "TBufferFile.h"
+#include "TStreamerElement.h"
+#include "TVirtualStreamerInfo.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// An odd number of elements, so that both the vectorized and the scalar parts of the byte swap are used
+static const Int_t kN = 37;
+
+template <typename T>
+static void CheckRoundTrip()
+{
+   std::vector<T> in(kN), out(kN);
+   for (Int_t i = 0; i < kN; ++i)
+      in[i] = T(i * 3 - 50);
+   TBufferFile w(TBuffer::kWrite);
+   w.WriteFastArray(in.data(), kN);
+   EXPECT_EQ(Int_t(sizeof(T) * kN), w.Length());
+
+   TBufferFile r(TBuffer::kRead, w.Length(), w.Buffer(), kFALSE);
+   r.ReadFastArray(out.data(), kN);
+   EXPECT_EQ(in, out);
+   EXPECT_EQ(w.Length(), r.Length());
+}
+
+TEST(TBufferFile, FastArrayRoundTrip)
+{
+   CheckRoundTrip<Short_t>();
+   CheckRoundTrip<Int_t>();
+   CheckRoundTrip<Long64_t>();
+   CheckRoundTrip<Float_t>();
+   CheckRoundTrip<Double_t>();
+}
+
+TEST(TBufferFile, FastArrayBigEndian)
+{
+   const Int_t ii[] = {0x01020304, 0x05060708, 0x090a0b0c, 0x0d0e0f10, 0x11121314};
+   TBufferFile w(TBuffer::kWrite);
+   w.WriteFastArray(ii, 5);
+   const auto bytes = reinterpret_cast<const unsigned char *>(w.Buffer());
+   for (Int_t i = 0; i < 20; ++i)
+      EXPECT_EQ(i + 1, bytes[i]);
+}
+
+// The array conversions must produce the same bytes and values as the element-wise ones
+static void CheckPacking(const char *title, const char *typeName, Int_t type)
+{
+   TStreamerElement ele("x", title, 0, type, typeName);
+   std::vector<Double_t> d(kN);
+   std::vector<Float_t> f(kN);
+   for (Int_t i = 0; i < kN; ++i) {
+      d[i] = -20. + 3.37 * i;
+      f[i] = Float_t(d[i]);
+   }
+
+   TBufferFile wArray(TBuffer::kWrite), wElem(TBuffer::kWrite);
+   if (type == TVirtualStreamerInfo::kDouble32) {
+      wArray.WriteFastArrayDouble32(d.data(), kN, &ele);
+      for (auto &x : d)
+         wElem.WriteDouble32(&x, &ele);
+   } else {
+      wArray.WriteFastArrayFloat16(f.data(), kN, &ele);
+      for (auto &x : f)
+         wElem.WriteFloat16(&x, &ele);
+   }
+   ASSERT_EQ(wElem.Length(), wArray.Length());
+   for (Int_t i = 0; i < wElem.Length(); ++i)
+      EXPECT_EQ(wElem.Buffer()[i], wArray.Buffer()[i]) << title << " byte " << i;
+
+   TBufferFile rArray(TBuffer::kRead, wArray.Length(), wArray.Buffer(), kFALSE);
+   TBufferFile rElem(TBuffer::kRead, wElem.Length(), wElem.Buffer(), kFALSE);
+   if (type == TVirtualStreamerInfo::kDouble32) {
+      std::vector<Double_t> outArray(kN), outElem(kN);
+      rArray.ReadFastArrayDouble32(outArray.data(), kN, &ele);
+      for (auto &x : outElem)
+         rElem.ReadDouble32(&x, &ele);
+      EXPECT_EQ(outElem, outArray) << title;
+   } else {
+      std::vector<Float_t> outArray(kN), outElem(kN);
+      rArray.ReadFastArrayFloat16(outArray.data(), kN, &ele);
+      for (auto &x : outElem)
+         rElem.ReadFloat16(&x, &ele);
+      EXPECT_EQ(outElem, outArray) << title;
+   }
+   EXPECT_EQ(rElem.Length(), rArray.Length());
+}
+
+TEST(TBufferFile, PackedArrays)
+{
+   CheckPacking("", "Double32_t", TVirtualStreamerInfo::kDouble32);
+   CheckPacking("[-30,150,20]", "Double32_t", TVirtualStreamerInfo::kDouble32);
+   CheckPacking("[0,0,10]", "Double32_t", TVirtualStreamerInfo::kDouble32);
+   CheckPacking("", "Float16_t", TVirtualStreamerInfo::kFloat16);
+   CheckPacking("[-30,150,14]", "Float16_t", TVirtualStreamerInfo::kFloat16);
+   CheckPacking("[0,0,8]", "Float16_t", TVirtualStreamerInfo::kFloat16);
+}
@@ -0,0 +1,52 @@
+#include "TBufferJSON.h"
+#include "TH2D.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+static std::unique_ptr<TH2D> MakeHistogram()
+{
+   std::unique_ptr<TH2D> h(new TH2D("h2", "h2", 50, 0, 50, 40, 0, 40));
+   h->SetDirectory(nullptr);
+   for (int i = 0; i < 5000; ++i)
+      h->Fill(i % 50 + 0.5, (i * 7) % 30 + 0.5, 0.25 + i % 3);
+   return h;
+}
+
+TEST(TBufferJSON, StreamChunks)
+{
+   auto h = MakeHistogram();
+   for (Int_t compact : {0, 3, 23}) {
+      TString json = TBufferJSON::ConvertToJSON(h.get(), compact);
+      std::string streamed;
+      int nchunks = 0;
+      Long64_t nbytes = TBufferJSON::StreamToJSON(h.get(), [&](const char *chunk, Int_t len) {
+         streamed.append(chunk, len);
+         ++nchunks;
+      }, compact, 1024);
+      EXPECT_EQ(json.Length(), nbytes);
+      EXPECT_EQ(std::string(json.Data()), streamed);
+      EXPECT_LT(1, nchunks);
+   }
+}
+
+TEST(TBufferJSON, Base64Arrays)
+{
+   auto h = MakeHistogram();
+   TString text = TBufferJSON::ConvertToJSON(h.get(), 3);
+   TString json = TBufferJSON::ConvertToJSON(h.get(), 33);
+   EXPECT_NE(kNPOS, json.Index("\"b\":\""));
+   EXPECT_LT(json.Length(), text.Length());
+
+   TH2D *read = nullptr;
+   ASSERT_TRUE(TBufferJSON::FromJSON(read, json.Data()));
+   std::unique_ptr<TH2D> guard(read);
+   ASSERT_EQ(h->GetNcells(), read->GetNcells());
+   for (Int_t bin = 0; bin < h->GetNcells(); ++bin) {
+      EXPECT_EQ(h->GetBinContent(bin), read->GetBinContent(bin));
+      EXPECT_EQ(h->GetBinError(bin), read->GetBinError(bin));
+   }
+   EXPECT_EQ(h->GetEntries(), read->GetEntries());
+}
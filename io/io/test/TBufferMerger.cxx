@@ -168,6 +168,56 @@ TEST(TBufferMerger, AutoSave)
    remove("tbuffermerger_autosave.root");
 }
 
+TEST(TBufferMerger, BoundedQueue)
+{
+   int nthreads = 4;
+   int nwrites = 8;
+   int nevents = 128;
+
+   ROOT::EnableThreadSafety();
+
+   {
+      TBufferMerger merger("tbuffermerger_bounded.root");
+      merger.SetMaxQueueSize(2);
+      EXPECT_EQ(2u, merger.GetMaxQueueSize());
+
+      std::vector<std::thread> threads;
+      for (int i = 0; i < nthreads; ++i) {
+         threads.emplace_back([=, &merger]() {
+            auto myfile = merger.GetFile();
+            auto mytree = new TTree("mytree", "mytree");
+            mytree->ResetBit(kMustCleanup);
+            int n = 0;
+            mytree->Branch("n", &n, "n/I");
+            for (int w = 0; w < nwrites; ++w) {
+               for (int e = 0; e < nevents; ++e) {
+                  n = (i * nwrites + w) * nevents + e;
+                  mytree->Fill();
+               }
+               myfile->Write();
+            }
+            mytree->ResetBranchAddresses();
+         });
+      }
+
+      for (auto &&t : threads)
+         t.join();
+
+      EXPECT_LE(merger.GetPeakQueueSize(), 2u);
+      EXPECT_LE(0., merger.GetMeanMergeLatency());
+      EXPECT_LE(merger.GetMeanMergeLatency(), merger.GetMaxMergeLatency());
+   }
+
+   {
+      TFile f("tbuffermerger_bounded.root");
+      auto t = (TTree *)f.Get("mytree");
+      ASSERT_TRUE(t != nullptr);
+      EXPECT_EQ(nthreads * nwrites * nevents, t->GetEntries());
+   }
+
+   remove("tbuffermerger_bounded.root");
+}
+
 TEST(TBufferMerger, CheckTreeFillResults)
 {
    int sum_s, sum_p;
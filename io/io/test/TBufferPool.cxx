@@ -0,0 +1,76 @@
+#include "ROOT/TBufferPool.hxx"
+#include "TBufferFile.h"
+
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using ROOT::Internal::TBufferPool;
+
+TEST(TBufferPool, AcquireRelease)
+{
+   TBufferPool::Clear();
+   char *buffer = TBufferPool::Acquire(5000);
+   ASSERT_NE(nullptr, buffer);
+   EXPECT_EQ(8192u, TBufferPool::GetCapacity(buffer));
+   memset(buffer, 1, TBufferPool::GetCapacity(buffer));
+   TBufferPool::Release(buffer);
+
+   // the same size class gives back the same memory
+   char *again = TBufferPool::Acquire(8000);
+   EXPECT_EQ(buffer, again);
+   TBufferPool::Release(again);
+   TBufferPool::Release(nullptr);
+}
+
+TEST(TBufferPool, ReAllocChar)
+{
+   char *buffer = TBufferPool::Acquire(100);
+   strcpy(buffer, "pooled");
+   EXPECT_EQ(buffer, TBufferPool::ReAllocChar(buffer, 4000, 7));
+   char *larger = TBufferPool::ReAllocChar(buffer, 100000, 7);
+   EXPECT_LE(100000u, TBufferPool::GetCapacity(larger));
+   EXPECT_STREQ("pooled", larger);
+   TBufferPool::Release(larger);
+}
+
+TEST(TBufferPool, NewBuffer)
+{
+   std::unique_ptr<TBufferFile> buffer(TBufferPool::NewBuffer(TBuffer::kWrite, 1000));
+   EXPECT_TRUE(TBufferPool::IsPooled(*buffer));
+   EXPECT_LE(1000, buffer->BufferSize());
+   for (Int_t i = 0; i < 100000; ++i)
+      buffer->WriteInt(i);
+   EXPECT_TRUE(TBufferPool::IsPooled(*buffer));
+
+   buffer->SetReadMode();
+   buffer->SetBufferOffset(0);
+   Int_t value = -1;
+   for (Int_t i = 0; i < 100000; ++i) {
+      buffer->ReadInt(value);
+      ASSERT_EQ(i, value);
+   }
+
+   TBufferPool::ReleaseMemory(*buffer);
+   EXPECT_FALSE(TBufferPool::IsPooled(*buffer));
+   EXPECT_EQ(nullptr, buffer->Buffer());
+}
+
+TEST(TBufferPool, OtherThread)
+{
+   TBufferPool::Clear();
+   char *buffer = TBufferPool::Acquire(70000);
+   // released by a thread which then ends, its buffers go to the depot
+   std::thread([buffer]() { TBufferPool::Release(buffer); }).join();
+   char *again = TBufferPool::Acquire(70000);
+   EXPECT_EQ(buffer, again);
+   TBufferPool::Release(again);
+
+   TBufferPool::SetMaxCachedBytes(0);
+   std::thread([]() { TBufferPool::Release(TBufferPool::Acquire(70000)); }).join();
+   TBufferPool::SetMaxCachedBytes(64 * 1024 * 1024);
+   EXPECT_EQ(64 * 1024 * 1024, TBufferPool::GetMaxCachedBytes());
+   TBufferPool::Clear();
+}
@@ -0,0 +1,45 @@
+#include "TClass.h"
+#include "TH1D.h"
+#include "TNamed.h"
+#include "TVirtualStreamerInfo.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(TClassStreamerInfoLookup, VersionAndCheckSum)
+{
+   TClass *cl = TNamed::Class();
+   TVirtualStreamerInfo *info = cl->GetStreamerInfo();
+   ASSERT_NE(nullptr, info);
+   EXPECT_TRUE(info->IsCompiled());
+   EXPECT_EQ(info, cl->GetStreamerInfo(cl->GetClassVersion()));
+   EXPECT_EQ(info, cl->FindStreamerInfo(info->GetCheckSum()));
+   EXPECT_EQ(nullptr, cl->FindStreamerInfo(info->GetCheckSum() + 1));
+}
+
+TEST(TClassStreamerInfoLookup, ConcurrentLookups)
+{
+   TClass *classes[] = {TNamed::Class(), TH1::Class(), TH1D::Class(), TAttLine::Class()};
+   std::vector<TVirtualStreamerInfo *> expected;
+   for (TClass *cl : classes)
+      expected.push_back(cl->GetStreamerInfo());
+
+   std::atomic<int> errors(0);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([&]() {
+         for (int i = 0; i < 10000; ++i) {
+            const int c = i % 4;
+            TVirtualStreamerInfo *info = classes[c]->GetStreamerInfo(classes[c]->GetClassVersion());
+            if (info != expected[c] || classes[c]->FindStreamerInfo(info->GetCheckSum()) != info)
+               ++errors;
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   EXPECT_EQ(0, errors.load());
+}
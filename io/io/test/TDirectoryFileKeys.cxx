@@ -0,0 +1,58 @@
+#include "TFile.h"
+#include "TKey.h"
+#include "TNamed.h"
+#include "TSystem.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+TEST(TDirectoryFileKeys, ManyKeysAndCycles)
+{
+   const char *fname = "TDirectoryFileKeys.root";
+   const int nkeys = 5000;
+   {
+      TFile f(fname, "RECREATE");
+      for (int i = 0; i < nkeys; ++i) {
+         const std::string name = "obj" + std::to_string(i);
+         TNamed obj(name.c_str(), "cycle 1");
+         obj.Write();
+         if (i % 100 == 0) {
+            obj.SetTitle("cycle 2");
+            obj.Write();
+            obj.SetTitle("cycle 3");
+            obj.Write();
+         }
+      }
+   }
+
+   std::unique_ptr<TFile> f(TFile::Open(fname));
+   ASSERT_TRUE(f && !f->IsZombie());
+   EXPECT_EQ(nkeys + 2 * nkeys / 100, f->GetListOfKeys()->GetSize());
+
+   for (int i = 0; i < nkeys; i += 7) {
+      const std::string name = "obj" + std::to_string(i);
+      TNamed *obj = nullptr;
+      f->GetObject(name.c_str(), obj);
+      ASSERT_NE(nullptr, obj);
+      EXPECT_STREQ(i % 100 == 0 ? "cycle 3" : "cycle 1", obj->GetTitle());
+      delete obj;
+   }
+
+   std::unique_ptr<TObject> second(f->Get("obj200;2"));
+   ASSERT_NE(nullptr, second);
+   EXPECT_STREQ("cycle 2", second->GetTitle());
+   EXPECT_EQ(nullptr, f->Get("obj201;2"));
+   EXPECT_EQ(nullptr, f->Get("missing"));
+
+   TKey *key = f->GetKey("obj300", 2);
+   ASSERT_NE(nullptr, key);
+   EXPECT_EQ(2, key->GetCycle());
+   key = f->FindKeyAny("obj300");
+   ASSERT_NE(nullptr, key);
+   EXPECT_EQ(3, key->GetCycle());
+
+   f.reset();
+   gSystem->Unlink(fname);
+}
@@ -0,0 +1,54 @@
+#include "TFileCacheRead.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+// A cache without file, fed with the durations of reads over a link of known latency and bandwidth.
+class TSimulatedCacheRead : public TFileCacheRead {
+public:
+   TSimulatedCacheRead(Int_t buffersize, Int_t maxsize) : TFileCacheRead(nullptr, buffersize)
+   {
+      SetAdaptive(kTRUE, maxsize);
+   }
+   Int_t GetWindow() const { return fBufferSizeMin; }
+   Int_t GetMaxChunkSize() const { return fMaxChunkSize; }
+   void Transfer(Double_t latency, Double_t bandwidth, Int_t ntransfers)
+   {
+      for (Int_t i = 0; i < ntransfers; ++i)
+         AdaptBufferSize(fBufferSizeMin, latency + fBufferSizeMin / bandwidth);
+   }
+};
+} // anonymous namespace
+
+TEST(TFileCacheRead, AdaptiveRemote)
+{
+   TSimulatedCacheRead cache(10000000, 64000000);
+   EXPECT_TRUE(cache.IsAdaptive());
+   EXPECT_LT(cache.GetRoundTripTime(), 0.);
+   // 100 ms and 10 MBytes/s: the bandwidth-delay product is 1 MByte.
+   cache.Transfer(0.1, 1e7, 20);
+   EXPECT_NEAR(cache.GetRoundTripTime(), 0.1, 1e-6);
+   EXPECT_NEAR(cache.GetBandwidth(), 1e7, 1.);
+   EXPECT_NEAR(cache.GetWindow(), 4000000, 10);
+   EXPECT_NEAR(cache.GetMaxChunkSize(), 1000000, 10);
+}
+
+TEST(TFileCacheRead, AdaptiveLocal)
+{
+   TSimulatedCacheRead cache(10000000, 64000000);
+   cache.Transfer(1e-4, 1e9, 20);
+   EXPECT_EQ(cache.GetWindow(), 1000000);
+   EXPECT_EQ(cache.GetMaxChunkSize(), 1000000);
+}
+
+TEST(TFileCacheRead, AdaptiveCap)
+{
+   TSimulatedCacheRead cache(10000000, 64000000);
+   // 1 s and 100 MBytes/s would need 400 MBytes.
+   cache.Transfer(1., 1e8, 20);
+   EXPECT_EQ(cache.GetWindow(), 64000000);
+   EXPECT_EQ(cache.GetMaxChunkSize(), 16000000);
+
+   cache.SetAdaptive(kFALSE);
+   EXPECT_FALSE(cache.IsAdaptive());
+}
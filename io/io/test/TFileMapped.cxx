@@ -0,0 +1,85 @@
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+static void WriteFile(const char *name, int compress)
+{
+   TFile f(name, "RECREATE", "", compress);
+   TTree t("t", "t");
+   int n = 0;
+   double x = 0.;
+   t.Branch("n", &n, "n/I");
+   t.Branch("x", &x, "x/D");
+   for (int i = 0; i < 10000; ++i) {
+      n = i;
+      x = i * 0.5;
+      t.Fill();
+   }
+   t.Write();
+}
+
+static void CheckFile(const char *name)
+{
+   std::unique_ptr<TFile> f(TFile::Open((std::string(name) + "?mmap").c_str()));
+   ASSERT_TRUE(f && !f->IsZombie());
+#ifndef R__WIN32
+   EXPECT_TRUE(f->IsMapped());
+#endif
+   TTree *t = nullptr;
+   f->GetObject("t", t);
+   ASSERT_NE(nullptr, t);
+   int n = -1;
+   double x = -1.;
+   t->SetBranchAddress("n", &n);
+   t->SetBranchAddress("x", &x);
+   ASSERT_EQ(10000, t->GetEntries());
+   for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+      t->GetEntry(i);
+      EXPECT_EQ(i, n);
+      EXPECT_DOUBLE_EQ(i * 0.5, x);
+   }
+   EXPECT_LT(0, f->GetBytesRead());
+}
+
+TEST(TFileMapped, ReadCompressedTree)
+{
+   const char *name = "TFileMapped_compressed.root";
+   WriteFile(name, 1);
+   CheckFile(name);
+   gSystem->Unlink(name);
+}
+
+TEST(TFileMapped, ReadUncompressedTree)
+{
+   const char *name = "TFileMapped_uncompressed.root";
+   WriteFile(name, 0);
+   CheckFile(name);
+   gSystem->Unlink(name);
+}
+
+TEST(TFileMapped, MappedBuffer)
+{
+   const char *name = "TFileMapped_buffer.root";
+   WriteFile(name, 1);
+   std::unique_ptr<TFile> f(TFile::Open((std::string(name) + "?mmap").c_str()));
+   ASSERT_TRUE(f && !f->IsZombie());
+   if (!f->IsMapped())
+      return;
+   // the header starts with the "root" magic
+   const char *header = f->GetMappedBuffer(0, 4);
+   ASSERT_NE(nullptr, header);
+   EXPECT_EQ(0, memcmp(header, "root", 4));
+   char copy[4];
+   EXPECT_FALSE(f->ReadBuffer(copy, 0, 4));
+   EXPECT_EQ(0, memcmp(copy, "root", 4));
+   EXPECT_EQ(nullptr, f->GetMappedBuffer(f->GetSize(), 1));
+   f->Close();
+   EXPECT_FALSE(f->IsMapped());
+   gSystem->Unlink(name);
+}
@@ -1,8 +1,14 @@
 #include "TFileMerger.h"
 
+#include "TH1D.h"
 #include "TMemFile.h"
+#include "TROOT.h"
 #include "TTree.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 namespace {
@@ -96,3 +102,37 @@ TEST(TFileMerger, CreateWithUnwritableTFilePointer)
    output->SetWritable(false);
    EXPECT_ROOT_ERROR(merger.OutputFile(std::move(output)), "Error in .* output file output.root is not writable\n");
 }
+
+TEST(TFileMerger, MergeManyHistograms)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   const int nFiles = 24;
+   std::vector<std::unique_ptr<TMemFile>> inputs;
+   for (int i = 0; i < nFiles; ++i) {
+      inputs.emplace_back(new TMemFile(("histos" + std::to_string(i) + ".root").c_str(), "RECREATE"));
+      TH1D h("h", "h", 10, 0, 10);
+      h.SetDirectory(inputs.back().get());
+      for (int j = 0; j <= i; ++j)
+         h.Fill(i % 10);
+      h.Write();
+      h.SetDirectory(nullptr);
+   }
+
+   TFileMerger merger;
+   merger.OutputFile(std::unique_ptr<TMemFile>(new TMemFile("histos_output.root", "CREATE")));
+   for (auto &input : inputs)
+      merger.AddFile(input.get(), false);
+   merger.PartialMerge();
+
+   auto h = static_cast<TH1D *>(merger.GetOutputFile()->Get("h"));
+   ASSERT_TRUE(h != nullptr);
+   EXPECT_EQ(nFiles * (nFiles + 1) / 2, h->GetEntries());
+   for (int bin = 0; bin < 10; ++bin) {
+      double expected = 0;
+      for (int i = bin; i < nFiles; i += 10)
+         expected += i + 1;
+      EXPECT_EQ(expected, h->GetBinContent(bin + 1));
+   }
+}
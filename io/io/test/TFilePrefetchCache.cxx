@@ -0,0 +1,71 @@
+#include "TFile.h"
+#include "TFilePrefetch.h"
+#include "TFPBlock.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+void RemoveCacheDir(TFilePrefetch &prefetch, const char *dir)
+{
+   prefetch.SetCacheSizeLimit(1);
+   prefetch.EvictFromCache();
+   for (int i = 0; i < 16; ++i)
+      gSystem->Unlink(TString::Format("%s/%d", dir, i));
+   gSystem->Unlink(TString::Format("%s/.lock", dir));
+   gSystem->Unlink(dir);
+}
+} // anonymous namespace
+
+TEST(TFilePrefetch, LocalCache)
+{
+   const char *fileName = "TFilePrefetchCache.root";
+   const char *cacheDir = "TFilePrefetchCacheDir";
+   {
+      TFile f(fileName, "RECREATE");
+      std::vector<char> data(64 * 1024, 'x');
+      f.WriteObjectAny(&data, "std::vector<char>", "data");
+   }
+   std::unique_ptr<TFile> file(TFile::Open(fileName));
+   ASSERT_TRUE(file && !file->IsZombie());
+
+   TFilePrefetch prefetch(file.get());
+   ASSERT_TRUE(prefetch.SetCache(cacheDir));
+
+   Long64_t pos[2] = {0, 1000};
+   Int_t len[2] = {100, 2000};
+   Bool_t inCache = kTRUE;
+
+   std::unique_ptr<TFPBlock> first(prefetch.CreateBlockObj(pos, len, 2));
+   prefetch.ReadAsync(first.get(), inCache);
+   EXPECT_FALSE(inCache);
+   prefetch.SaveBlockInCache(first.get());
+   EXPECT_EQ(0, prefetch.GetCacheHits());
+   EXPECT_EQ(1, prefetch.GetCacheMisses());
+
+   std::unique_ptr<TFPBlock> second(prefetch.CreateBlockObj(pos, len, 2));
+   prefetch.ReadAsync(second.get(), inCache);
+   EXPECT_TRUE(inCache);
+   EXPECT_EQ(1, prefetch.GetCacheHits());
+   EXPECT_EQ(2100, prefetch.GetCacheBytesRead());
+   EXPECT_EQ(0, memcmp(first->GetBuffer(), second->GetBuffer(), first->GetDataSize()));
+
+   // Blocks of 2100 bytes beyond a limit of 10000 bytes evict the oldest ones.
+   prefetch.SetCacheSizeLimit(10000);
+   for (Long64_t offset = 2000; offset < 20000; offset += 2000) {
+      pos[0] = offset;
+      pos[1] = offset + 1000;
+      std::unique_ptr<TFPBlock> block(prefetch.CreateBlockObj(pos, len, 2));
+      prefetch.ReadAsync(block.get(), inCache);
+      EXPECT_FALSE(inCache);
+      prefetch.SaveBlockInCache(block.get());
+   }
+   EXPECT_LE(prefetch.EvictFromCache(), 10000);
+
+   RemoveCacheDir(prefetch, cacheDir);
+   file.reset();
+   gSystem->Unlink(fileName);
+}
@@ -0,0 +1,43 @@
+#include "TBufferFile.h"
+#include "TClass.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// The inner vectors are streamed as their size followed by their values
+static TBufferFile *MakeExpected(const std::vector<std::vector<Float_t>> &vv)
+{
+   TBufferFile *b = new TBufferFile(TBuffer::kWrite);
+   *b << Int_t(vv.size());
+   for (auto &v : vv) {
+      *b << Int_t(v.size());
+      b->WriteFastArray(v.data(), v.size());
+   }
+   return b;
+}
+
+TEST(TGenCollectionStreamer, NestedVectors)
+{
+   TClass *cl = TClass::GetClass("vector<vector<float> >");
+   ASSERT_NE(cl, nullptr);
+
+   std::vector<std::vector<Float_t>> in(5);
+   for (size_t i = 0; i < in.size(); ++i)
+      for (size_t j = 0; j < 3 * i; ++j)
+         in[i].push_back(Float_t(i * 100 + j) + 0.5f);
+
+   TBufferFile w(TBuffer::kWrite);
+   cl->Streamer(&in, w);
+   std::unique_ptr<TBufferFile> expected(MakeExpected(in));
+   ASSERT_EQ(expected->Length(), w.Length());
+   EXPECT_EQ(0, memcmp(expected->Buffer(), w.Buffer(), w.Length()));
+
+   std::vector<std::vector<Float_t>> out(2, std::vector<Float_t>(7, -1.f));
+   TBufferFile r(TBuffer::kRead, w.Length(), w.Buffer(), kFALSE);
+   cl->Streamer(&out, r);
+   EXPECT_EQ(in, out);
+   EXPECT_EQ(w.Length(), r.Length());
+}
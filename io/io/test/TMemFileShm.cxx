@@ -0,0 +1,61 @@
+#include "TH1D.h"
+#include "TMemFile.h"
+
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+static void FillFile(TMemFile &f)
+{
+   TH1D h("h", "h", 100, 0, 100);
+   for (int i = 0; i < 1000; ++i)
+      h.Fill(i % 100);
+   f.WriteTObject(&h);
+}
+
+TEST(TMemFile, ZeroCopyView)
+{
+   TMemFile out("TMemFile_view.root", "RECREATE");
+   FillFile(out);
+   out.Write();
+   std::string buffer(out.GetEND(), '\0');
+   out.CopyTo(&buffer[0], buffer.size());
+
+   TMemFile in("TMemFile_view.root", TMemFile::ZeroCopyView_t(buffer.data(), buffer.size()));
+   ASSERT_FALSE(in.IsZombie());
+   TH1D *h = nullptr;
+   in.GetObject("h", h);
+   ASSERT_NE(nullptr, h);
+   EXPECT_EQ(1000, h->GetEntries());
+
+   TMemFile update("TMemFile_view.root", TMemFile::ZeroCopyView_t(buffer.data(), buffer.size()), "UPDATE");
+   EXPECT_TRUE(update.IsZombie());
+}
+
+#ifndef R__WIN32
+TEST(TMemFile, SharedMemory)
+{
+   const std::string shmName = "/TMemFileShm_" + std::to_string(getpid());
+   {
+      TMemFile out("TMemFileShm.root", "RECREATE");
+      FillFile(out);
+      out.Write();
+      ASSERT_EQ(out.GetEND(), out.WriteToShm(shmName.c_str()));
+   }
+
+   std::unique_ptr<TMemFile> in(TMemFile::OpenShm(shmName.c_str()));
+   ASSERT_TRUE(in && !in->IsZombie());
+   // The mapping stays valid after the segment is removed.
+   EXPECT_EQ(0, TMemFile::UnlinkShm(shmName.c_str()));
+   TH1D *h = nullptr;
+   in->GetObject("h", h);
+   ASSERT_NE(nullptr, h);
+   EXPECT_EQ(1000, h->GetEntries());
+   EXPECT_EQ(10, h->GetBinContent(1));
+
+   std::unique_ptr<TMemFile> missing(TMemFile::OpenShm(shmName.c_str()));
+   EXPECT_EQ(nullptr, missing);
+}
+#endif
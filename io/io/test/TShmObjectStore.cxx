@@ -0,0 +1,81 @@
+#include "TH1D.h"
+#include "TShmObjectStore.h"
+
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+#ifndef R__WIN32
+TEST(TShmObjectStore, UpdateInPlace)
+{
+   const std::string shmName = "/TShmObjectStore_" + std::to_string(getpid());
+   std::unique_ptr<TShmObjectStore> writer(TShmObjectStore::Create(shmName.c_str(), 1 << 20, 16));
+   ASSERT_NE(nullptr, writer);
+   TH1D h("h", "h", 100, 0, 100);
+   ASSERT_TRUE(writer->Add(&h));
+
+   std::unique_ptr<TShmObjectStore> reader(TShmObjectStore::Open(shmName.c_str()));
+   EXPECT_EQ(0, TShmObjectStore::Unlink(shmName.c_str()));
+   ASSERT_NE(nullptr, reader);
+   EXPECT_FALSE(reader->Add(&h));
+   EXPECT_EQ(1, reader->GetEntries());
+   EXPECT_EQ(1u, reader->GetVersion("h"));
+
+   TShmObjectStore::ZeroCopyView_t before;
+   reader->LockRead();
+   ASSERT_TRUE(reader->GetView("h", before));
+   reader->UnlockRead();
+
+   for (int i = 0; i < 1000; ++i)
+      h.Fill(i % 100);
+   EXPECT_EQ(1, writer->Update());
+   EXPECT_EQ(2u, reader->GetVersion("h"));
+
+   // the histogram keeps its bins, it is updated where it was written
+   TShmObjectStore::ZeroCopyView_t after;
+   TString classname;
+   reader->LockRead();
+   ASSERT_TRUE(reader->GetView("h", after, &classname));
+   reader->UnlockRead();
+   EXPECT_EQ(before, after);
+   EXPECT_EQ("TH1D", classname);
+
+   std::unique_ptr<TH1D> copy((TH1D *)reader->Get("h"));
+   ASSERT_NE(nullptr, copy);
+   EXPECT_EQ(1000, copy->GetEntries());
+   EXPECT_EQ(10, copy->GetBinContent(1));
+
+   EXPECT_TRUE(writer->Remove("h"));
+   EXPECT_EQ(nullptr, reader->Get("h"));
+   EXPECT_EQ(0u, reader->GetVersion("h"));
+}
+
+TEST(TShmObjectStore, ReuseRegions)
+{
+   const std::string shmName = "/TShmObjectStore_reuse_" + std::to_string(getpid());
+   std::unique_ptr<TShmObjectStore> store(TShmObjectStore::Create(shmName.c_str(), 1 << 16, 2));
+   ASSERT_NE(nullptr, store);
+   TShmObjectStore::Unlink(shmName.c_str());
+
+   TH1D a("a", "a", 10, 0, 10), b("b", "b", 10, 0, 10), c("c", "c", 10, 0, 10);
+   ASSERT_TRUE(store->Add(&a));
+   ASSERT_TRUE(store->Add(&b));
+   // only two records
+   EXPECT_FALSE(store->Add(&c));
+   TShmObjectStore::ZeroCopyView_t viewA;
+   ASSERT_TRUE(store->GetView("a", viewA));
+   EXPECT_TRUE(store->Remove("a"));
+   ASSERT_TRUE(store->Add(&c));
+   TShmObjectStore::ZeroCopyView_t viewC;
+   ASSERT_TRUE(store->GetView("c", viewC));
+   EXPECT_EQ(viewA.first, viewC.first);
+
+   // a larger object does not fit in the segment
+   EXPECT_TRUE(store->Remove("b"));
+   TH1D large("large", "large", 100000, 0, 1);
+   EXPECT_FALSE(store->Add(&large));
+   EXPECT_EQ(1, store->GetEntries());
+}
+#endif
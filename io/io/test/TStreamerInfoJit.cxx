@@ -0,0 +1,50 @@
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TH1D.h"
+#include "TStreamerInfo.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+TEST(TStreamerInfoJit, RoundTripHistogram)
+{
+   TH1D h("jit", "jit", 20, 0, 20);
+   h.SetDirectory(nullptr);
+   h.Sumw2();
+   for (int i = 0; i < 100; ++i)
+      h.Fill(i % 20, 0.5 + i % 3);
+
+   const Bool_t prev = TVirtualStreamerInfo::SetJitStreamers(kTRUE);
+
+   TBufferFile wbuf(TBuffer::kWrite);
+   wbuf.WriteObject(&h);
+
+   auto info = static_cast<TStreamerInfo *>(TH1::Class()->GetStreamerInfo());
+   ASSERT_NE(nullptr, info);
+   EXPECT_NE(nullptr, info->GetJitReadFunc());
+   EXPECT_NE(nullptr, info->GetJitWriteFunc());
+
+   TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+   std::unique_ptr<TH1D> read(static_cast<TH1D *>(rbuf.ReadObject(TH1D::Class())));
+   TVirtualStreamerInfo::SetJitStreamers(prev);
+
+   ASSERT_NE(nullptr, read);
+   read->SetDirectory(nullptr);
+   EXPECT_STREQ("jit", read->GetName());
+   EXPECT_EQ(h.GetNbinsX(), read->GetNbinsX());
+   EXPECT_EQ(h.GetEntries(), read->GetEntries());
+   EXPECT_EQ(h.GetSumOfWeights(), read->GetSumOfWeights());
+   for (int bin = 0; bin <= h.GetNbinsX() + 1; ++bin) {
+      EXPECT_EQ(h.GetBinContent(bin), read->GetBinContent(bin));
+      EXPECT_EQ(h.GetBinError(bin), read->GetBinError(bin));
+   }
+}
+
+TEST(TStreamerInfoJit, DisabledByDefault)
+{
+   auto info = static_cast<TStreamerInfo *>(TH1::Class()->GetStreamerInfo());
+   ASSERT_NE(nullptr, info);
+   EXPECT_FALSE(TVirtualStreamerInfo::GetJitStreamers());
+   EXPECT_EQ(nullptr, info->GetJitReadFunc());
+}
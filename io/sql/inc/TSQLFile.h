@@ -165,6 +165,7 @@ protected:
 
    Bool_t fIdsTableExists; ///<! indicate if IdsTable exists
    Int_t fStmtCounter;     ///<! count numbers of active statements
+   Int_t fMaxInsertRows;   ///<! maximum number of rows inserted by a single INSERT statement
 
 private:
    // let the compiler do the job. gcc complains when the following line is activated
@@ -192,6 +193,8 @@ public:
    Int_t GetUseTransactions() const { return fUseTransactions; }
    void SetUseIndexes(Int_t use_type = kIndexesBasic);
    Int_t GetUseIndexes() const { return fUseIndexes; }
+   void SetMaxInsertRows(Int_t nrows = 1000) { fMaxInsertRows = nrows; }
+   Int_t GetMaxInsertRows() const { return fMaxInsertRows; }
    Int_t GetQuerisCounter() const { return fQuerisCounter; }
    Int_t GetIOVersion() const { return fSQLIOversion; }
 
@@ -228,6 +231,8 @@ public:
    virtual Bool_t IsOpen() const;
    Bool_t IsOracle() const;
    Bool_t IsODBC() const;
+   Bool_t IsPostgreSQL() const;
+   Bool_t IsSQLite() const;
 
    virtual void MakeFree(Long64_t, Long64_t) {}
    virtual void MakeProject(const char *, const char * = "*", Option_t * = "new") {} // *MENU*
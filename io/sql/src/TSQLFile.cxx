@@ -95,6 +95,9 @@ any problems, ROLLBACK command will be used to restore
 previous state of data base. If transactions not supported by SQL server,
 they can be disabled by SetUseTransactions(kTransactionsOff). Or user
 can take responsibility to use transactions function himself.
+With MySQL, PostgreSQL and SQLite the rows of a table are inserted with
+multi-row INSERT statements, at most SetMaxInsertRows() rows (default 1000)
+per statement; with Oracle and ODBC prepared statements are used.
 By default only indexes for basic tables are created.
 In most cases usage of indexes increase performance to data reading,
 but it also can increase time of writing data to database.
@@ -274,7 +277,8 @@ const char *oracle_OtherTypes[13] = {
 TSQLFile::TSQLFile()
    : TFile(), fSQL(0), fSQLClassInfos(0), fUseSuffixes(kTRUE), fSQLIOversion(1), fArrayLimit(21),
      fCanChangeConfig(kFALSE), fTablesType(), fUseTransactions(0), fUseIndexes(0), fModifyCounter(0), fQuerisCounter(0),
-     fBasicTypes(0), fOtherTypes(0), fUserName(), fLogFile(0), fIdsTableExists(kFALSE), fStmtCounter(0)
+     fBasicTypes(0), fOtherTypes(0), fUserName(), fLogFile(0), fIdsTableExists(kFALSE), fStmtCounter(0),
+     fMaxInsertRows(1000)
 {
    SetBit(kBinaryFile, kFALSE);
 }
@@ -301,7 +305,7 @@ TSQLFile::TSQLFile(const char *dbname, Option_t *option, const char *user, const
    : TFile(), fSQL(0), fSQLClassInfos(0), fUseSuffixes(kTRUE), fSQLIOversion(1), fArrayLimit(21),
      fCanChangeConfig(kFALSE), fTablesType(), fUseTransactions(0), fUseIndexes(0), fModifyCounter(0), fQuerisCounter(0),
      fBasicTypes(mysql_BasicTypes), fOtherTypes(mysql_OtherTypes), fUserName(user), fLogFile(0),
-     fIdsTableExists(kFALSE), fStmtCounter(0)
+     fIdsTableExists(kFALSE), fStmtCounter(0), fMaxInsertRows(1000)
 {
    if (!gROOT)
       ::Fatal("TFile::TFile", "ROOT system not initialized");
@@ -495,6 +499,26 @@ Bool_t TSQLFile::IsODBC() const
    return strcmp(fSQL->ClassName(), "TODBCServer") == 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// checks, if PostgreSQL database
+
+Bool_t TSQLFile::IsPostgreSQL() const
+{
+   if (fSQL == 0)
+      return kFALSE;
+   return strcmp(fSQL->ClassName(), "TPgSQLServer") == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// checks, if SQLite database
+
+Bool_t TSQLFile::IsSQLite() const
+{
+   if (fSQL == 0)
+      return kFALSE;
+   return strcmp(fSQL->ClassName(), "TSQLiteServer") == 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// enable/disable uasge of suffixes in columns names
 /// can be changed before first object is saved into file
@@ -897,13 +897,18 @@ public:
    void ConvertSqlValues(TObjArray &values, const char *tablename)
    {
       // this function transforms array of values for one table
-      // to SQL command. For MySQL one INSERT query can
-      // contain data for more than one row
+      // to SQL command. For MySQL, PostgreSQL and SQLite one INSERT query can
+      // contain data for more than one row, at most fFile->GetMaxInsertRows()
 
       if ((values.GetLast() < 0) || (tablename == 0))
          return;
 
-      Bool_t canbelong = fFile->IsMySQL();
+      Bool_t canbelong = fFile->IsMySQL() || fFile->IsPostgreSQL() || fFile->IsSQLite();
+      Int_t maxrows = fFile->GetMaxInsertRows();
+      // older SQLite versions limit the number of terms of a compound VALUES
+      if (fFile->IsSQLite() && maxrows > 500)
+         maxrows = 500;
+      Int_t nrows = 0;
 
       Int_t maxsize = 50000;
       TString sqlcmd(maxsize), value, onecmd, cmdmask;
@@ -921,10 +926,12 @@ public:
             sqlcmd += cmd->GetName();
             sqlcmd += ")";
          }
+         nrows++;
 
-         if (!canbelong || (sqlcmd.Length() > maxsize * 0.9)) {
+         if (!canbelong || (sqlcmd.Length() > maxsize * 0.9) || (nrows >= maxrows)) {
             AddSqlCmd(sqlcmd.Data());
             sqlcmd = "";
+            nrows = 0;
          }
       }
 
@@ -38,8 +38,8 @@ public:
    virtual void DeleteBuffer() {}
    virtual void FillBuffer(char *&) {}
    virtual char *GetBuffer() const { return 0; }
-   virtual Long64_t GetSeekKey() const { return fKeyNode ? 1024 : 0; }
-   virtual Long64_t GetSeekPdir() const { return fKeyNode ? 1024 : 0; }
+   virtual Long64_t GetSeekKey() const { return (fKeyNode || fNodeLen > 0) ? 1024 : 0; }
+   virtual Long64_t GetSeekPdir() const { return (fKeyNode || fNodeLen > 0) ? 1024 : 0; }
    // virtual ULong_t   Hash() const { return 0; }
    virtual void Keep() {}
    // virtual void      ls(Option_t* ="") const;
@@ -63,6 +63,9 @@ public:
    void SetSubir() { fSubdir = kTRUE; }
    void UpdateObject(TObject *obj);
    void UpdateAttributes();
+   void SetNodePosition(Long64_t pos, Long64_t len);
+   Bool_t IsLazy() const { return !fKeyNode && fNodeLen > 0; }
+   Bool_t LoadKeyNode(Bool_t keep = kFALSE);
 
 protected:
    virtual Int_t Read(const char *name) { return TKey::Read(name); }
@@ -75,6 +78,8 @@ protected:
    XMLNodePointer_t fKeyNode; //! node with stored object
    Long64_t fKeyId;           //! unique identifier of key for search methods
    Bool_t fSubdir;            //! indicates that key contains subdirectory
+   Long64_t fNodePos;         //! position of the key node in the file, when it is read lazily
+   Long64_t fNodeLen;         //! length of the key node in the file, when it is read lazily
 
    ClassDef(TKeyXML, 1) // a special TKey for XML files
 };
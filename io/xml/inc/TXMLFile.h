@@ -109,6 +109,11 @@ public:
 
    TXMLEngine *XML() { return fXML; }
 
+   XMLNodePointer_t ReadFileNode(Long64_t pos, Long64_t len);
+
+   static void SetLazyReading(Bool_t on = kTRUE);
+   static Bool_t IsLazyReading();
+
 protected:
    // functions to store streamer infos
 
@@ -116,6 +121,8 @@ protected:
    void ReadStreamerElement(XMLNodePointer_t node, TStreamerInfo *info);
 
    Bool_t ReadFromFile();
+   Bool_t ReadFromFileLazy();
+   Bool_t ReadRootNode();
    Int_t ReadKeysList(TDirectory *dir, XMLNodePointer_t topnode);
    TKeyXML *FindDirKey(TDirectory *dir);
    TDirectory *FindKeyDir(TDirectory *mother, Long64_t keyid);
@@ -135,6 +142,8 @@ protected:
 
    Long64_t fKeyCounter; //! counter of created keys, used for keys id
 
+   static Bool_t fgLazyReading; //! parse the keys of the files opened for reading only when they are read
+
    ClassDef(TXMLFile, 3) // ROOT file in XML format
 };
 
@@ -29,7 +29,7 @@ ClassImp(TKeyXML);
 ////////////////////////////////////////////////////////////////////////////////
 /// default constructor
 
-TKeyXML::TKeyXML() : TKey(), fKeyNode(nullptr), fKeyId(0), fSubdir(kFALSE)
+TKeyXML::TKeyXML() : TKey(), fKeyNode(nullptr), fKeyId(0), fSubdir(kFALSE), fNodePos(0), fNodeLen(0)
 {
 }
 
@@ -37,7 +37,7 @@ TKeyXML::TKeyXML() : TKey(), fKeyNode(nullptr), fKeyId(0), fSubdir(kFALSE)
 /// Creates TKeyXML and convert object data to xml structures
 
 TKeyXML::TKeyXML(TDirectory *mother, Long64_t keyid, const TObject *obj, const char *name, const char *title)
-   : TKey(mother), fKeyNode(nullptr), fKeyId(keyid), fSubdir(kFALSE)
+   : TKey(mother), fKeyNode(nullptr), fKeyId(keyid), fSubdir(kFALSE), fNodePos(0), fNodeLen(0)
 {
    if (name) {
       SetName(name);
@@ -66,7 +66,7 @@ TKeyXML::TKeyXML(TDirectory *mother, Long64_t keyid, const TObject *obj, const c
 
 TKeyXML::TKeyXML(TDirectory *mother, Long64_t keyid, const void *obj, const TClass *cl, const char *name,
                  const char *title)
-   : TKey(mother), fKeyNode(nullptr), fKeyId(keyid), fSubdir(kFALSE)
+   : TKey(mother), fKeyNode(nullptr), fKeyId(keyid), fSubdir(kFALSE), fNodePos(0), fNodeLen(0)
 {
    if (name && *name)
       SetName(name);
@@ -91,7 +91,7 @@ TKeyXML::TKeyXML(TDirectory *mother, Long64_t keyid, const void *obj, const TCla
 /// Creates TKeyXML and takes ownership over xml node, from which object can be restored
 
 TKeyXML::TKeyXML(TDirectory *mother, Long64_t keyid, XMLNodePointer_t keynode)
-   : TKey(mother), fKeyNode(keynode), fKeyId(keyid), fSubdir(kFALSE)
+   : TKey(mother), fKeyNode(keynode), fKeyId(keyid), fSubdir(kFALSE), fNodePos(0), fNodeLen(0)
 {
    TXMLEngine *xml = XMLEngine();
 
@@ -113,6 +113,43 @@ TKeyXML::TKeyXML(TDirectory *mother, Long64_t keyid, XMLNodePointer_t keynode)
    fClassName = xml->GetAttr(objnode, xmlio::ObjClass);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the position in the file of the key node, which is then parsed only when
+/// the object is read. The node given to the constructor, which only has the
+/// key attributes, is released.
+
+void TKeyXML::SetNodePosition(Long64_t pos, Long64_t len)
+{
+   fNodePos = pos;
+   fNodeLen = len;
+   if (fKeyNode) {
+      TXMLEngine *xml = XMLEngine();
+      if (xml)
+         xml->FreeNode(fKeyNode);
+      fKeyNode = nullptr;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parse the key node of a key read lazily from the file.
+/// If keep is kTRUE, the node stays in memory as for the keys read entirely.
+
+Bool_t TKeyXML::LoadKeyNode(Bool_t keep)
+{
+   if (fKeyNode)
+      return kTRUE;
+
+   TXMLFile *f = (TXMLFile *)GetFile();
+   if (!f || (fNodeLen <= 0))
+      return kFALSE;
+
+   fKeyNode = f->ReadFileNode(fNodePos, fNodeLen);
+   if (fKeyNode && keep)
+      fNodeLen = 0;
+
+   return fKeyNode != nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TKeyXML destructor
 
@@ -338,8 +375,15 @@ void *TKeyXML::ReadObjectAny(const TClass *expectedClass)
 
 void *TKeyXML::XmlReadAny(void *obj, const TClass *expectedClass)
 {
-   if (!fKeyNode)
-      return obj;
+   if (!fKeyNode) {
+      // key read lazily, its node is parsed only for the time of reading
+      if (!LoadKeyNode())
+         return obj;
+      void *res = XmlReadAny(obj, expectedClass);
+      XMLEngine()->FreeNode(fKeyNode);
+      fKeyNode = nullptr;
+      return res;
+   }
 
    TXMLFile *f = (TXMLFile *)GetFile();
    TXMLEngine *xml = XMLEngine();
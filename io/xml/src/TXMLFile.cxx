@@ -63,6 +63,14 @@
 // ======================================
 // The XML package is enabled by default
 //
+// Lazy reading
+// ============
+// With TXMLFile::SetLazyReading(kTRUE), files opened for reading are not
+// parsed entirely when they are opened: a fast scan of the document only
+// records where the top-level keys are, and the xml of a key is parsed when
+// its object is read (Get). This reduces the memory footprint and the time
+// to open large files of which only a few objects are used.
+//
 // documentation
 // =============
 // See also classes TBufferXML, TKeyXML, TXMLEngine, TXMLSetup and TXMLPlayer.
@@ -88,8 +96,174 @@
 #include "TClass.h"
 #include "TVirtualMutex.h"
 
+#include <fstream>
+#include <string>
+#include <vector>
+
 ClassImp(TXMLFile);
 
+Bool_t TXMLFile::fgLazyReading = kFALSE;
+
+namespace {
+
+/// Position in the file of a child of the root node, found by ScanXmlFile.
+struct TXMLTopNode {
+   std::string fName;     ///< node name
+   std::string fStartTag; ///< text of the start tag
+   std::string fChildTag; ///< text of the start tag of the first child, if any
+   Long64_t fBegin = 0;   ///< position of the start tag
+   Long64_t fEnd = 0;     ///< position after the end tag
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Tokenize a xml file without building its nodes: returns the text before the
+/// root node (declaration, comments, style sheets), the start tag of the root
+/// node and the positions of its children. Comments, CDATA sections and
+/// processing instructions are skipped, quoted attribute values may contain
+/// any character.
+
+Bool_t ScanXmlFile(const char *filename, std::string &prolog, std::string &roottag, std::vector<TXMLTopNode> &nodes)
+{
+   std::ifstream inp(filename, std::ios::binary);
+   if (!inp)
+      return kFALSE;
+   std::streambuf *sb = inp.rdbuf();
+   Long64_t pos = 0;
+   auto get = [&]() {
+      ++pos;
+      return sb->sbumpc();
+   };
+   // skip until the terminator, appending the skipped text to out if not null
+   auto skipUntil = [&](const char *term, std::string *out) {
+      const int len = strlen(term);
+      int matched = 0;
+      while (matched < len) {
+         int c = get();
+         if (c == EOF)
+            return kFALSE;
+         if (out)
+            out->push_back(c);
+         matched = (c == term[matched]) ? matched + 1 : (c == term[0] ? 1 : 0);
+      }
+      return kTRUE;
+   };
+
+   Int_t depth = 0;
+   Bool_t rootDone = kFALSE;
+   while (!rootDone) {
+      int c = get();
+      if (c == EOF)
+         break;
+      if (c != '<') {
+         if (roottag.empty())
+            prolog.push_back(c);
+         continue;
+      }
+      const Long64_t tagBegin = pos - 1;
+      std::string *out = roottag.empty() ? &prolog : nullptr;
+      if (out)
+         out->push_back('<');
+      c = get();
+      if (c == EOF)
+         return kFALSE;
+      if (out)
+         out->push_back(c);
+      if (c == '?') {
+         if (!skipUntil("?>", out))
+            return kFALSE;
+      } else if (c == '!') {
+         int c2 = get();
+         if (out)
+            out->push_back(c2);
+         if (c2 == '-') {
+            if (!skipUntil("-->", out))
+               return kFALSE;
+         } else if (c2 == '[') {
+            if (!skipUntil("]]>", out))
+               return kFALSE;
+         } else {
+            // declaration like DOCTYPE, possibly with an internal subset
+            int brackets = 0;
+            while ((c2 = get()) != EOF) {
+               if (out)
+                  out->push_back(c2);
+               if (c2 == '[')
+                  brackets++;
+               else if (c2 == ']')
+                  brackets--;
+               else if (c2 == '>' && brackets <= 0)
+                  break;
+            }
+            if (c2 == EOF)
+               return kFALSE;
+         }
+      } else if (c == '/') {
+         if (!skipUntil(">", nullptr))
+            return kFALSE;
+         depth--;
+         if (depth == 1 && !nodes.empty())
+            nodes.back().fEnd = pos;
+         if (depth == 0)
+            rootDone = kTRUE;
+      } else {
+         // start tag
+         std::string tag("<");
+         tag.push_back(c);
+         char quote = 0;
+         while ((c = get()) != EOF) {
+            tag.push_back(c);
+            if (quote) {
+               if (c == quote)
+                  quote = 0;
+            } else if (c == '"' || c == '\'') {
+               quote = c;
+            } else if (c == '>') {
+               break;
+            }
+         }
+         if (c == EOF)
+            return kFALSE;
+         const Bool_t empty = tag[tag.length() - 2] == '/';
+         if (depth == 0) {
+            if (out)
+               prolog.erase(prolog.length() - 2);
+            roottag = tag;
+            if (empty)
+               rootDone = kTRUE;
+         } else if (depth == 1) {
+            nodes.emplace_back();
+            TXMLTopNode &node = nodes.back();
+            node.fName = tag.substr(1, tag.find_first_of(" \t\r\n/>") - 1);
+            node.fStartTag = tag;
+            node.fBegin = tagBegin;
+            if (empty)
+               node.fEnd = pos;
+         } else if (depth == 2 && nodes.back().fChildTag.empty()) {
+            nodes.back().fChildTag = tag;
+         }
+         if (!empty)
+            depth++;
+      }
+   }
+   return !roottag.empty() && rootDone;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the bytes [begin, end) of a file
+
+Bool_t ReadFileRange(const char *filename, Long64_t begin, Long64_t end, std::string &res)
+{
+   std::ifstream inp(filename, std::ios::binary);
+   if (!inp || end < begin)
+      return kFALSE;
+   inp.seekg(begin);
+   res.resize(end - begin);
+   inp.read(&res[0], end - begin);
+   return inp.gcount() == end - begin;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// default TXMLFile constructor
 
@@ -416,6 +590,17 @@ Int_t TXMLFile::ReOpen(Option_t *mode)
       SetWritable(kFALSE);
 
    } else {
+      // the keys read lazily are needed in memory to save the file
+      TIter next(GetListOfKeys());
+      TObject *obj = nullptr;
+      while ((obj = next()) != nullptr) {
+         TKeyXML *key = dynamic_cast<TKeyXML *>(obj);
+         if (key && key->IsLazy() && !key->LoadKeyNode(kTRUE)) {
+            Error("ReOpen", "cannot read the key %s, file %s stays in READ mode", key->GetName(), GetName());
+            return 1;
+         }
+      }
+
       fOption = opt;
 
       SetWritable(kTRUE);
@@ -563,18 +748,160 @@ void TXMLFile::CombineNodesTree(TDirectory *dir, XMLNodePointer_t topnode, Bool_
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the lazy reading of the files opened afterwards for
+/// reading: only the positions of the keys are found when the file is opened,
+/// the xml of each key is parsed when its object is read. Files using a DTD
+/// are always read entirely.
+
+void TXMLFile::SetLazyReading(Bool_t on)
+{
+   fgLazyReading = on;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the files opened for reading are read lazily.
+
+Bool_t TXMLFile::IsLazyReading()
+{
+   return fgLazyReading;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parse the xml of the node stored in bytes [pos, pos+len) of the file.
+/// The returned node is owned by the caller.
+
+XMLNodePointer_t TXMLFile::ReadFileNode(Long64_t pos, Long64_t len)
+{
+   std::string text;
+   if (!ReadFileRange(fRealName, pos, pos + len, text)) {
+      Error("ReadFileNode", "cannot read %lld bytes at %lld from %s", len, pos, fRealName.Data());
+      return nullptr;
+   }
+   XMLDocPointer_t doc = fXML->ParseString(text.c_str());
+   if (!doc)
+      return nullptr;
+   XMLNodePointer_t node = fXML->DocGetRootElement(doc);
+   fXML->UnlinkNode(node);
+   fXML->FreeDoc(doc);
+   return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open the document for lazy reading: parse only the prolog, the root node
+/// attributes and the streamer infos, then create the keys from their start tag.
+/// Returns kFALSE if the document cannot be scanned or needs to be read entirely.
+
+Bool_t TXMLFile::ReadFromFileLazy()
+{
+   std::string prolog, roottag;
+   std::vector<TXMLTopNode> nodes;
+   if (!ScanXmlFile(fRealName, prolog, roottag, nodes))
+      return kFALSE;
+
+   std::string text = prolog + roottag;
+   if (text.back() != '>' || text[text.length() - 2] == '/')
+      return kFALSE;
+   for (auto &node : nodes) {
+      if (node.fName == xmlio::SInfos) {
+         std::string infos;
+         if (!ReadFileRange(fRealName, node.fBegin, node.fEnd, infos))
+            return kFALSE;
+         text += infos;
+      }
+   }
+   text += "</";
+   text += roottag.substr(1, roottag.find_first_of(" \t\r\n>") - 1);
+   text += ">";
+
+   fDoc = fXML->ParseString(text.c_str());
+   if (!fDoc)
+      return kFALSE;
+   ReadRootNode();
+   if (!fDoc)
+      return kFALSE;
+   if (IsUseDtd()) {
+      // validation needs the whole document
+      fXML->FreeDoc(fDoc);
+      fDoc = nullptr;
+      if (fStreamerInfoNode) {
+         fXML->FreeNode(fStreamerInfoNode);
+         fStreamerInfoNode = nullptr;
+      }
+      return kFALSE;
+   }
+
+   for (auto &node : nodes) {
+      if (node.fName != xmlio::Xmlkey)
+         continue;
+      // the key attributes and the class of its object are in the start tags
+      std::string header = node.fStartTag;
+      if (header[header.length() - 2] != '/') {
+         std::string child = node.fChildTag;
+         if (!child.empty() && child[child.length() - 2] != '/')
+            child.insert(child.length() - 1, "/");
+         header += child + "</" + xmlio::Xmlkey + ">";
+      }
+      XMLDocPointer_t doc = fXML->ParseString(header.c_str());
+      XMLNodePointer_t keynode = doc ? fXML->DocGetRootElement(doc) : nullptr;
+      if (!keynode) {
+         Error("ReadFromFileLazy", "cannot parse the key at position %lld", node.fBegin);
+         if (doc)
+            fXML->FreeDoc(doc);
+         continue;
+      }
+      fXML->UnlinkNode(keynode);
+      fXML->FreeDoc(doc);
+      TKeyXML *key = new TKeyXML(this, ++fKeyCounter, keynode);
+      key->SetNodePosition(node.fBegin, node.fEnd - node.fBegin);
+      AppendKey(key);
+   }
+
+   fXML->CleanNode(fXML->DocGetRootElement(fDoc));
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// read document from file
 /// Now full content of document reads into the memory
 /// Then document decomposed to separate keys and streamer info structures
 /// All irrelevant data will be cleaned
+/// With lazy reading (see SetLazyReading) only the positions of the keys are
+/// read, see ReadFromFileLazy.
 
 Bool_t TXMLFile::ReadFromFile()
 {
+   if (fgLazyReading && fOption == "READ" && ReadFromFileLazy())
+      return kTRUE;
+
    fDoc = fXML->ParseFile(fRealName);
    if (!fDoc)
       return kFALSE;
 
+   if (!ReadRootNode())
+      return kFALSE;
+
+   if (IsUseDtd())
+      if (!fXML->ValidateDocument(fDoc, gDebug > 0)) {
+         fXML->FreeDoc(fDoc);
+         fDoc = nullptr;
+         return kFALSE;
+      }
+
+   XMLNodePointer_t fRootNode = fXML->DocGetRootElement(fDoc);
+
+   ReadKeysList(this, fRootNode);
+
+   fXML->CleanNode(fRootNode);
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the attributes of the root node of the document and the streamer infos
+
+Bool_t TXMLFile::ReadRootNode()
+{
    XMLNodePointer_t fRootNode = fXML->DocGetRootElement(fDoc);
 
    if (!fRootNode || !fXML->ValidateVersion(fDoc)) {
@@ -623,17 +950,6 @@ Bool_t TXMLFile::ReadFromFile()
    if (fStreamerInfoNode)
       ReadStreamerInfo();
 
-   if (IsUseDtd())
-      if (!fXML->ValidateDocument(fDoc, gDebug > 0)) {
-         fXML->FreeDoc(fDoc);
-         fDoc = nullptr;
-         return kFALSE;
-      }
-
-   ReadKeysList(this, fRootNode);
-
-   fXML->CleanNode(fRootNode);
-
    return kTRUE;
 }
 
@@ -1083,6 +1399,9 @@ Int_t TXMLFile::DirReadKeys(TDirectory *dir)
    if (!key)
       return 0;
 
+   if (!key->KeyNode() && !key->LoadKeyNode(kTRUE))
+      return 0;
+
    return ReadKeysList(dir, key->KeyNode());
 }
 
@@ -51,6 +51,13 @@
   If the option -cachesize is used, hadd will resize (or disable if 0) the
   prefetching cache use to speed up I/O operations.
 
+  If the option -j is used, the inputs are merged by parallel processes into
+  partial files, which are then merged by groups, also in parallel, until few
+  enough of them remain to be merged into the target file.
+  If the option -maxrss is used, each merging process flushes what it has merged
+  so far into its output as soon as its resident memory exceeds its share of
+  the given size, releasing the inputs it holds open.
+
   For options that takes a size as argument, a decimal number of bytes is expected.
   If the number ends with a ``k'', ``m'', ``g'', etc., the number is multiplied
   by 1000 (1K), 1000000 (1MB), 1000000000 (1G), etc.
@@ -83,6 +90,7 @@
 #include "TUUID.h"
 #include "ROOT/StringConv.hxx"
 #include <stdlib.h>
+#include <algorithm>
 #include <climits>
 #include <sstream>
 
@@ -97,7 +105,7 @@ int main( int argc, char **argv )
 {
    if ( argc < 3 || "-h" == std::string(argv[1]) || "--help" == std::string(argv[1]) ) {
       std::cout << "Usage: " << argv[0] << " [-f[fk][0-9]] [-k] [-T] [-O] [-a] \n"
-      "            [-n maxopenedfiles] [-cachesize size] [-j ncpus] [-v [verbosity]] \n"
+      "            [-n maxopenedfiles] [-cachesize size] [-j ncpus] [-maxrss size] [-v [verbosity]] \n"
       "            targetfile source1 [source2 source3 ...]\n" << std::endl;
       std::cout << "This program will add histograms from a list of root files and write them" << std::endl;
       std::cout << "   to a target root file. The target file is newly created and must not" << std::endl;
@@ -110,7 +118,11 @@ int main( int argc, char **argv )
       std::cout << "If the option -O is used, when merging TTree, the basket size is re-optimized" <<std::endl;
       std::cout << "If the option -v is used, explicitly set the verbosity level;\n"\
                    "   0 request no output, 99 is the default" <<std::endl;
-      std::cout << "If the option -j is used, the execution will be parallelized in multiple processes\n" << std::endl;
+      std::cout << "If the option -j is used, the execution will be parallelized in multiple processes:\n"
+                   "   the partial files they produce are themselves merged by groups, in parallel,\n"
+                   "   until at most 'maxopenedfiles' (8 by default) of them remain\n" << std::endl;
+      std::cout << "If the option -maxrss is used, each merging process writes out what it merged so far\n"
+                   "   and closes its inputs whenever its resident memory exceeds its share of 'size'." << std::endl;
       std::cout << "If the option -dbg is used, the execution will be parallelized in multiple processes in debug mode."
                    " This will not delete the partial files stored in the working directory\n"
                 << std::endl;
@@ -134,6 +146,8 @@ int main( int argc, char **argv )
       std::cout << "If \"-f0\" is specified, the target file will not be compressed." <<std::endl;
       std::cout << "If \"-f6\" is specified, the compression level 6 will be used.  \n"
                    "   See TFile::SetCompressionSettings for the support range of value." <<std::endl;
+      std::cout << "If \"-f505\" is specified, the target file will be compressed with ZSTD at level 5;\n"
+                   "   the hundreds digit selects the algorithm (1 ZLIB, 2 LZMA, 4 LZ4, 5 ZSTD)." <<std::endl;
       std::cout << "If Target and source files have different compression settings a slower method\n"
                    "   is used.\n"<<std::endl;
       std::cout << "For options that takes a size as argument, a decimal number of bytes is expected.\n"
@@ -158,6 +172,7 @@ int main( int argc, char **argv )
    Bool_t multiproc = kFALSE;
    Bool_t debug = kFALSE;
    Int_t maxopenedfiles = 0;
+   Long64_t maxRSS = 0;
    Int_t verbosity = 99;
    TString cacheSize;
    SysInfo_t s;
@@ -304,6 +319,21 @@ int main( int argc, char **argv )
             }
          }
          ++ffirst;
+      } else if ( strcmp(argv[a],"-maxrss") == 0 ) {
+         if (a+1 >= argc) {
+            std::cerr << "Error: no memory size was provided after -maxrss.\n";
+         } else {
+            Long64_t size;
+            auto parseResult = ROOT::FromHumanReadableSize(argv[a+1],size);
+            if (parseResult == ROOT::EFromHumanReadableSize::kSuccess) {
+               maxRSS = size;
+               ++a;
+               ++ffirst;
+            } else {
+               std::cerr << "Error: could not parse the memory size passed after -maxrss: " << argv[a+1] << ". The memory will not be limited.\n";
+            }
+         }
+         ++ffirst;
       } else if ( strcmp(argv[a],"-v") == 0 ) {
          if (a+1 == argc || argv[a+1][0] == '-') {
             // Verbosity level was not specified use the default:
@@ -356,7 +386,7 @@ int main( int argc, char **argv )
             }
          }
          char ft[7];
-         for (int alg = 0; !useFirstInputCompression && alg <= 4; ++alg) {
+         for (int alg = 0; !useFirstInputCompression && alg <= 5; ++alg) {
             for( int j=0; j<=9; ++j ) {
                const int comp = (alg*100)+j;
                snprintf(ft,7,"-f%s%d",prefix,comp);
@@ -451,18 +481,32 @@ int main( int argc, char **argv )
       std::cout << " Setting the number of processes to: " << nProcesses << std::endl;
    }
    std::vector<std::string> partialFiles;
+   const TString partialTail = TUUID().AsString();
+   auto partialName = [&](int round, int i) {
+      std::stringstream buffer;
+      buffer << workingDir << "/partial" << i;
+      if (round > 0)
+         buffer << "_r" << round;
+      buffer << "_" << partialTail << ".root";
+      return buffer.str();
+   };
 
    if (multiproc) {
-      auto uuid = TUUID();
-      auto partialTail = uuid.AsString();
       for (auto i = 0; (i * step) < filesToProcess; i++) {
-         std::stringstream buffer;
-         buffer << workingDir << "/partial" << i << "_" << partialTail << ".root";
-         partialFiles.emplace_back(buffer.str());
+         partialFiles.emplace_back(partialName(0, i));
       }
    }
 
-   auto mergeFiles = [&](TFileMerger &merger) {
+   // The resident memory of this process, in bytes.
+   auto residentMemory = []() {
+      ProcInfo_t info;
+      gSystem->GetProcInfo(&info);
+      return 1024 * (Long64_t)info.fMemResident;
+   };
+   const Long64_t rssBudget = multiproc ? maxRSS / nProcesses : maxRSS;
+
+   // Once a merger has flushed its inputs into its output, the rest must be merged incrementally.
+   auto mergeFiles = [&](TFileMerger &merger, Bool_t flushed) {
       if (reoptimize) {
          merger.SetFastMethod(kFALSE);
       } else {
@@ -476,14 +520,33 @@ int main( int argc, char **argv )
       merger.SetMergeOptions(cacheSize);
       merger.SetIOFeatures(features);
       Bool_t status;
-      if (append)
+      if (append || flushed)
          status = merger.PartialMerge(TFileMerger::kIncremental | TFileMerger::kAll);
       else
          status = merger.Merge();
       return status;
    };
 
+   // Add a file to a merger, flushing the files added so far into the output
+   // if the memory budget is exceeded.
+   auto addFile = [&](TFileMerger &merger, const char *name, Int_t &pending, Bool_t &flushed) {
+      if (!merger.AddFile(name))
+         return kFALSE;
+      if (rssBudget > 0 && ++pending > 1 && residentMemory() > rssBudget) {
+         if (verbosity > 1) {
+            std::cout << "hadd memory budget exceeded, writing out the merge of the last " << pending << " files\n";
+         }
+         if (!merger.PartialMerge(TFileMerger::kIncremental | TFileMerger::kAll))
+            return kFALSE;
+         pending = 0;
+         flushed = kTRUE;
+      }
+      return kTRUE;
+   };
+
    auto sequentialMerge = [&](TFileMerger &merger, int start, int nFiles) {
+      Int_t pending = 0;
+      Bool_t flushed = kFALSE;
 
       for (auto i = start; i < (start + nFiles) && i < argc; i++) {
          if (argv[i] && argv[i][0] == '@') {
@@ -494,11 +557,12 @@ int main( int argc, char **argv )
             }
             while (indirect_file) {
                std::string line;
-               if (std::getline(indirect_file, line) && line.length() && !merger.AddFile(line.c_str())) {
+               if (std::getline(indirect_file, line) && line.length() &&
+                   !addFile(merger, line.c_str(), pending, flushed)) {
                   return kFALSE;
                }
             }
-         } else if (!merger.AddFile(argv[i])) {
+         } else if (!addFile(merger, argv[i], pending, flushed)) {
             if (skip_errors) {
                std::cerr << "hadd skipping file with error: " << argv[i] << std::endl;
             } else {
@@ -507,7 +571,7 @@ int main( int argc, char **argv )
             return kFALSE;
          }
       }
-      return mergeFiles(merger);
+      return mergeFiles(merger, flushed);
    };
 
    auto parallelMerge = [&](int start) {
@@ -524,11 +588,33 @@ int main( int argc, char **argv )
       return sequentialMerge(mergerP, start, step);
    };
 
+   // Merge the partial files by groups of fanIn files, in parallel, until at most fanIn of them remain.
+   const UInt_t fanIn = std::max(2, maxopenedfiles > 0 ? maxopenedfiles : 8);
+   auto reduceRound = [&](const std::vector<std::string> &inputs, const std::vector<std::string> &outputs, UInt_t g) {
+      TFileMerger mergerR(kFALSE, kFALSE);
+      mergerR.SetMsgPrefix("hadd");
+      mergerR.SetPrintLevel(verbosity - 1);
+      if (!mergerR.OutputFile(outputs[g].c_str(), newcomp)) {
+         std::cerr << "hadd error opening target partial file" << std::endl;
+         exit(1);
+      }
+      Int_t pending = 0;
+      Bool_t flushed = kFALSE;
+      for (auto i = g * fanIn; i < (g + 1) * fanIn && i < inputs.size(); ++i) {
+         if (!addFile(mergerR, inputs[i].c_str(), pending, flushed))
+            return kFALSE;
+      }
+      return mergeFiles(mergerR, flushed);
+   };
+
    auto reductionFunc = [&]() {
+      Int_t pending = 0;
+      Bool_t flushed = kFALSE;
       for (auto pf : partialFiles) {
-         fileMerger.AddFile(pf.c_str());
+         if (!addFile(fileMerger, pf.c_str(), pending, flushed))
+            return kFALSE;
       }
-      return mergeFiles(fileMerger);
+      return mergeFiles(fileMerger, flushed);
    };
 
    Bool_t status;
@@ -538,6 +624,21 @@ int main( int argc, char **argv )
       ROOT::TProcessExecutor p(nProcesses);
       auto res = p.Map(parallelMerge, ROOT::TSeqI(ffirst, argc, step));
       status = std::accumulate(res.begin(), res.end(), 0U) == partialFiles.size();
+      for (int round = 1; status && partialFiles.size() > fanIn; ++round) {
+         std::vector<std::string> nextFiles;
+         for (UInt_t g = 0; g * fanIn < partialFiles.size(); ++g) {
+            nextFiles.emplace_back(partialName(round, g));
+         }
+         auto resR = p.Map([&](UInt_t g) { return reduceRound(partialFiles, nextFiles, g); },
+                           ROOT::TSeqU(nextFiles.size()));
+         status = std::accumulate(resR.begin(), resR.end(), 0U) == nextFiles.size();
+         if (!debug) {
+            for (auto pf : partialFiles) {
+               gSystem->Unlink(pf.c_str());
+            }
+         }
+         partialFiles = nextFiles;
+      }
       if (status) {
          status = reductionFunc();
       } else {
@@ -0,0 +1,56 @@
+// @(#)root/fft:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFFTPlanCache
+#define ROOT_TFFTPlanCache
+
+//////////////////////////////////////////////////////////////////////////
+//
+// TFFTPlanCache
+// Process-wide cache of the FFTW plans used by TFFTComplex, TFFTComplexReal,
+// TFFTRealComplex and TFFTReal, and global settings of FFTW.
+//
+// A plan is computed once for each type, size, sign (or kinds), flags,
+// in-place option and number of threads of the transform: Init() of the
+// following objects with the same settings gets the cached plan, without
+// planning again (and without overwriting the arrays), and the transform is
+// computed on the arrays of each object with the new-array execute
+// functions of FFTW. The plans are owned by the cache.
+//
+// The wisdom of FFTW (the result of the "M", "P" and "EX" measures) can be
+// saved to a file and imported by another process with ExportWisdom() and
+// ImportWisdom().
+//
+// With SetNThreads(), the new plans use several threads (when ROOT is built
+// with the threaded FFTW library), for example as many as the IMT pool.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+#include <functional>
+
+class TFFTPlanCache {
+
+public:
+   static void   *GetPlan(const char *type, Int_t ndim, const Int_t *n, UInt_t flags, Bool_t inPlace,
+                          const std::function<void *()> &create);
+   static void    Clear();
+   static Int_t   GetNPlans();
+
+   static Bool_t  ExportWisdom(const char *filename);
+   static Bool_t  ImportWisdom(const char *filename);
+   static void    ForgetWisdom();
+
+   static void    SetNThreads(Int_t nthreads);
+   static Int_t   GetNThreads();
+};
+
+#endif
@@ -39,6 +39,7 @@
 #include "TFFTComplex.h"
 #include "fftw3.h"
 #include "TComplex.h"
+#include "TFFTPlanCache.h"
 
 
 ClassImp(TFFTComplex);
@@ -99,13 +100,11 @@ TFFTComplex::TFFTComplex(Int_t ndim, Int_t *n, Bool_t inPlace)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///Destroys the data arrays and the plan. However, some plan information stays around
-///until the root session is over, and is reused if other plans of the same size are
-///created
+///Destroys the data arrays. The plan is kept in the TFFTPlanCache, and reused if
+///other transforms of the same size, sign and flags are created
 
 TFFTComplex::~TFFTComplex()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = 0;
    fftw_free((fftw_complex*)fIn);
    if (fOut)
@@ -130,21 +129,19 @@ TFFTComplex::~TFFTComplex()
 ///"EX" (from "exhaustive") - the most optimal way is found
 ///This option should be chosen depending on how many transforms of the same size and
 ///type are going to be done. Planning is only done once, for the first transform of this
-///size and type.
+///size and type: the plan is then taken from the TFFTPlanCache, and the arrays are not
+///overwritten.
 
 void TFFTComplex::Init( Option_t *flags, Int_t sign,const Int_t* /*kind*/)
 {
    fSign = sign;
    fFlags = flags;
 
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
-   fPlan = 0;
-
-   if (fOut)
-      fPlan = (void*)fftw_plan_dft(fNdim, fN, (fftw_complex*)fIn, (fftw_complex*)fOut, sign,MapFlag(flags));
-   else
-      fPlan = (void*)fftw_plan_dft(fNdim, fN, (fftw_complex*)fIn, (fftw_complex*)fIn, sign, MapFlag(flags));
+   const UInt_t flag = MapFlag(flags);
+   fftw_complex *out = fOut ? (fftw_complex*)fOut : (fftw_complex*)fIn;
+   fPlan = TFFTPlanCache::GetPlan(TString::Format("C2C %d", sign), fNdim, fN, flag, !fOut, [&]() {
+      return (void*)fftw_plan_dft(fNdim, fN, (fftw_complex*)fIn, out, sign, flag);
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -153,7 +150,7 @@ void TFFTComplex::Init( Option_t *flags, Int_t sign,const Int_t* /*kind*/)
 void TFFTComplex::Transform()
 {
    if (fPlan)
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_dft((fftw_plan)fPlan, (fftw_complex*)fIn, fOut ? (fftw_complex*)fOut : (fftw_complex*)fIn);
    else {
       Error("Transform", "transform not initialised");
       return;
@@ -43,6 +43,7 @@
 
 #include "TFFTComplexReal.h"
 #include "fftw3.h"
+#include "TFFTPlanCache.h"
 #include "TComplex.h"
 
 
@@ -108,13 +109,11 @@ TFFTComplexReal::TFFTComplexReal(Int_t ndim, Int_t *n, Bool_t inPlace)
 
 
 ////////////////////////////////////////////////////////////////////////////////
-///Destroys the data arrays and the plan. However, some plan information stays around
-///until the root session is over, and is reused if other plans of the same size are
-///created
+///Destroys the data arrays. The plan is kept in the TFFTPlanCache, and reused if
+///other transforms of the same size and flags are created
 
 TFFTComplexReal::~TFFTComplexReal()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = 0;
    fftw_free((fftw_complex*)fIn);
    if (fOut)
@@ -141,20 +140,18 @@ TFFTComplexReal::~TFFTComplexReal()
 ///"EX" (from "exhaustive") - the most optimal way is found
 ///This option should be chosen depending on how many transforms of the same size and
 ///type are going to be done. Planning is only done once, for the first transform of this
-///size and type.
+///size and type: the plan is then taken from the TFFTPlanCache, and the arrays are not
+///overwritten.
 
 void TFFTComplexReal::Init( Option_t *flags, Int_t /*sign*/,const Int_t* /*kind*/)
 {
    fFlags = flags;
 
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
-   fPlan = 0;
-
-   if (fOut)
-      fPlan = (void*)fftw_plan_dft_c2r(fNdim, fN,(fftw_complex*)fIn,(Double_t*)fOut, MapFlag(flags));
-   else
-      fPlan = (void*)fftw_plan_dft_c2r(fNdim, fN, (fftw_complex*)fIn, (Double_t*)fIn, MapFlag(flags));
+   const UInt_t flag = MapFlag(flags);
+   Double_t *out = fOut ? (Double_t*)fOut : (Double_t*)fIn;
+   fPlan = TFFTPlanCache::GetPlan("C2R", fNdim, fN, flag, !fOut, [&]() {
+      return (void*)fftw_plan_dft_c2r(fNdim, fN, (fftw_complex*)fIn, out, flag);
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -163,7 +160,7 @@ void TFFTComplexReal::Init( Option_t *flags, Int_t /*sign*/,const Int_t* /*kind*
 void TFFTComplexReal::Transform()
 {
    if (fPlan)
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_dft_c2r((fftw_plan)fPlan, (fftw_complex*)fIn, fOut ? (Double_t*)fOut : (Double_t*)fIn);
    else {
       Error("Transform", "transform was not initialized");
       return;
@@ -0,0 +1,204 @@
+// @(#)root/fft:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TFFTPlanCache
+Process-wide cache of the FFTW plans used by TFFTComplex, TFFTComplexReal,
+TFFTRealComplex and TFFTReal, and global settings of FFTW (wisdom and threads).
+
+A plan is computed once for each type, size, sign (or kinds), flags, in-place
+option and number of threads of the transform. The following calls of Init()
+with the same settings, for example by the objects created for each
+convolution of the same size, get the cached plan without planning again.
+The plans are owned by the cache and executed on the arrays of each object.
+
+The planning of FFTW is not thread safe: the cache serializes it, while the
+transforms can be computed concurrently by different objects.
+*/
+
+#include "TFFTPlanCache.h"
+#include "TError.h"
+#include "TString.h"
+#include "fftw3.h"
+
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#endif
+
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace {
+
+struct PlanCache {
+   std::mutex fMutex;
+   std::map<std::string, void *> fPlans;
+   Int_t fNThreads = 1;
+   Bool_t fThreadsInit = kFALSE;
+};
+
+PlanCache &GetCache()
+{
+   static PlanCache cache;
+   return cache;
+}
+
+} // end anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the plan of the transform of the given type (including its sign or
+/// kinds), dimensions n[0] ... n[ndim-1], FFTW flags and in-place option,
+/// computed by create() if it is not yet in the cache. Used by the Init()
+/// functions of the transform classes.
+
+void *TFFTPlanCache::GetPlan(const char *type, Int_t ndim, const Int_t *n, UInt_t flags, Bool_t inPlace,
+                             const std::function<void *()> &create)
+{
+   PlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+
+   std::string key = TString::Format("%s f%u i%d t%d n", type, flags, inPlace, cache.fNThreads).Data();
+   for (Int_t i = 0; i < ndim; i++)
+      key += TString::Format(" %d", n[i]).Data();
+
+   auto it = cache.fPlans.find(key);
+   if (it != cache.fPlans.end())
+      return it->second;
+
+#ifdef R__HAS_FFTW_THREADS
+   if (cache.fThreadsInit)
+      fftw_plan_with_nthreads(cache.fNThreads);
+#endif
+   void *plan = create();
+   if (plan)
+      cache.fPlans[key] = plan;
+   return plan;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destroy all the cached plans. None of the transform objects using them can
+/// be used afterwards, before calling again their Init() function.
+
+void TFFTPlanCache::Clear()
+{
+   PlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   for (auto &plan : cache.fPlans)
+      fftw_destroy_plan((fftw_plan)plan.second);
+   cache.fPlans.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of cached plans
+
+Int_t TFFTPlanCache::GetNPlans()
+{
+   PlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   return cache.fPlans.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Save the accumulated wisdom of FFTW (the result of the measures of the
+/// plans) in the file, to be imported by ImportWisdom in another session.
+
+Bool_t TFFTPlanCache::ExportWisdom(const char *filename)
+{
+   PlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   FILE *file = fopen(filename, "w");
+   if (!file) {
+      ::Error("TFFTPlanCache::ExportWisdom", "cannot open the file %s", filename);
+      return kFALSE;
+   }
+   fftw_export_wisdom_to_file(file);
+   fclose(file);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the wisdom of FFTW saved in the file by ExportWisdom: the new plans with
+/// the "M", "P" or "EX" flags of the same transforms are then created without
+/// measuring them again.
+
+Bool_t TFFTPlanCache::ImportWisdom(const char *filename)
+{
+   PlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   FILE *file = fopen(filename, "r");
+   if (!file) {
+      ::Error("TFFTPlanCache::ImportWisdom", "cannot open the file %s", filename);
+      return kFALSE;
+   }
+   const int ok = fftw_import_wisdom_from_file(file);
+   fclose(file);
+   if (!ok)
+      ::Error("TFFTPlanCache::ImportWisdom", "invalid wisdom in the file %s", filename);
+   return ok != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the accumulated wisdom of FFTW (the cached plans are kept).
+
+void TFFTPlanCache::ForgetWisdom()
+{
+   PlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   fftw_forget_wisdom();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of threads of the plans created afterwards. With nthreads = 0,
+/// use the size of the pool of the implicit multithreading if it is enabled,
+/// one thread otherwise. Several threads require ROOT built with the threaded
+/// FFTW library (fftw3_threads).
+
+void TFFTPlanCache::SetNThreads(Int_t nthreads)
+{
+   if (nthreads == 0) {
+      nthreads = 1;
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled())
+         nthreads = ROOT::GetImplicitMTPoolSize();
+#endif
+   }
+   if (nthreads < 1)
+      nthreads = 1;
+
+   PlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+#ifdef R__HAS_FFTW_THREADS
+   if (nthreads > 1 && !cache.fThreadsInit) {
+      if (!fftw_init_threads()) {
+         ::Error("TFFTPlanCache::SetNThreads", "the threads of FFTW cannot be initialized");
+         return;
+      }
+      cache.fThreadsInit = kTRUE;
+   }
+#else
+   if (nthreads > 1) {
+      ::Warning("TFFTPlanCache::SetNThreads", "FFTW is not built with threads: using one thread");
+      nthreads = 1;
+   }
+#endif
+   cache.fNThreads = nthreads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of threads of the new plans
+
+Int_t TFFTPlanCache::GetNThreads()
+{
+   PlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   return cache.fNThreads;
+}
@@ -58,6 +58,7 @@
 
 #include "TFFTReal.h"
 #include "fftw3.h"
+#include "TFFTPlanCache.h"
 
 ClassImp(TFFTReal);
 
@@ -117,11 +118,10 @@ TFFTReal::TFFTReal(Int_t ndim, Int_t *n, Bool_t inPlace)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///clean-up
+///clean-up (the plan is kept in the TFFTPlanCache)
 
 TFFTReal::~TFFTReal()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = 0;
    fftw_free(fIn);
    fIn = 0;
@@ -152,7 +152,8 @@ TFFTReal::~TFFTReal()
 ///  "EX" (from "exhaustive") - the most optimal way is found
 ///  This option should be chosen depending on how many transforms of the same size and
 ///  type are going to be done. Planning is only done once, for the first transform of this
-///  size and type.
+///  size and type: the plan is then taken from the TFFTPlanCache, and the arrays are not
+///  overwritten.
 ///2nd parameter is dummy and doesn't need to be specified
 ///3rd parameter- transform kind for each dimension
 ///     4 different kinds of sine and cosine transforms are available
@@ -167,18 +168,20 @@ TFFTReal::~TFFTReal()
 
 void TFFTReal::Init( Option_t* flags,Int_t /*sign*/, const Int_t *kind)
 {
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = 0;
 
    if (!fKind)
       fKind = (fftw_r2r_kind*)fftw_malloc(sizeof(fftw_r2r_kind)*fNdim);
 
    if (MapOptions(kind)){
-      if (fOut)
-         fPlan = (void*)fftw_plan_r2r(fNdim, fN, (Double_t*)fIn, (Double_t*)fOut, (fftw_r2r_kind*)fKind, MapFlag(flags));
-      else
-         fPlan = (void*)fftw_plan_r2r(fNdim, fN, (Double_t*)fIn, (Double_t*)fIn, (fftw_r2r_kind*)fKind, MapFlag(flags));
+      TString type = "R2R";
+      for (Int_t i=0; i<fNdim; i++)
+         type += TString::Format(" %d", ((fftw_r2r_kind*)fKind)[i]);
+      const UInt_t flag = MapFlag(flags);
+      Double_t *out = fOut ? (Double_t*)fOut : (Double_t*)fIn;
+      fPlan = TFFTPlanCache::GetPlan(type, fNdim, fN, flag, !fOut, [&]() {
+         return (void*)fftw_plan_r2r(fNdim, fN, (Double_t*)fIn, out, (fftw_r2r_kind*)fKind, flag);
+      });
       fFlags = flags;
    }
 }
@@ -189,7 +192,7 @@ void TFFTReal::Init( Option_t* flags,Int_t /*sign*/, const Int_t *kind)
 void TFFTReal::Transform()
 {
    if (fPlan)
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_r2r((fftw_plan)fPlan, (Double_t*)fIn, fOut ? (Double_t*)fOut : (Double_t*)fIn);
    else {
       Error("Transform", "transform hasn't been initialised");
       return;
@@ -108,6 +108,7 @@ public:
    virtual void     GetMCwt(Double_t &);     // Provides generated MC weight
    virtual Double_t GetMCwt();               // Provides generates MC weight
    virtual Double_t MCgenerate(Double_t *MCvect);// All three above function in one
+   virtual Double_t MCgenerate(Double_t *MCvect, TRandom *rnd) const;// Same with a given r.n. generator, thread-safe
    // Finalization
    virtual void GetIntegMC(Double_t&, Double_t&);// Provides Integrand and abs. error from MC run
    virtual void GetIntNorm(Double_t&, Double_t&);// Provides normalization Inegrand
@@ -147,6 +148,8 @@ public:
    // Inline
 private:
    Double_t Sqr(Double_t x) const { return x*x;}      // Square function
+   void EvalBatch(Long_t, Double_t *, Double_t *);    // Evaluates the distribution at several points
+   TFoamCell *FindCell(Double_t) const;               // Active cell of a given cumulative primary integral
    //////////////////////////////////////////////////////////////////////////////////////////////
    ClassDef(TFoam,1);   // General purpose self-adapting Monte Carlo event generator
 };
@@ -16,6 +16,8 @@ public:
    TFoamIntegrand() { };
    virtual ~TFoamIntegrand() { };
    virtual Double_t Density(Int_t ndim, Double_t *) = 0;
+   virtual void Densities(Int_t ndim, Long_t npoints, Double_t *x, Double_t *rho);
+   virtual Bool_t IsThreadSafe() const { return kFALSE; } // Density can be called concurrently
 
    ClassDef(TFoamIntegrand,1); //n-dimensional real positive integrand of FOAM
 };
@@ -124,6 +124,8 @@
 #include "TMath.h"
 #include "TInterpreter.h"
 
+#include <vector>
+
 ClassImp(TFoam);
 
 //FFFFFF  BoX-FORMATs for nice and flexible outputs
@@ -569,8 +571,6 @@ void TFoam::Explore(TFoamCell *cell)
 
    TFoamCell  *parent;
 
-   Double_t *xRand = new Double_t[fDim];
-
    Double_t *volPart=0;
 
    cell->CalcVolume();
@@ -591,36 +591,53 @@ void TFoam::Explore(TFoamCell *cell)
    for(i=0;i<fDim;i++) ((TH1D *)(*fHistEdg)[i])->Reset(); // Reset histograms
    fHistWt->Reset();
    //
+   // The events are generated and evaluated by batches. The number of effective
+   // events cannot exceed the number of events, hence all the events of a batch
+   // but the last one are below the exit condition of the MC loop: the random
+   // numbers drawn and the results are the ones of the event by event loop.
+   const Long_t nevEffMax = Long_t(fNBin)*fEvPerBin;
+   std::vector<Double_t> alpha, xRand, rho;
    // ||||||||||||||||||||||||||BEGIN MC LOOP|||||||||||||||||||||||||||||
    Double_t nevEff=0.;
-   for(iev=0;iev<fNSampl;iev++){
-      MakeAlpha();               // generate uniformly vector inside hypercube
-
-      if(fDim>0){
-      for(j=0; j<fDim; j++)
-         xRand[j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
+   for(iev=0;iev<fNSampl;){
+      Long_t nBatch = TMath::Min(fNSampl-iev, TMath::Max(nevEffMax-iev, 1L));
+      alpha.resize(nBatch*fDim);
+      xRand.resize(nBatch*fDim);
+      rho.resize(nBatch);
+      for(Long_t b=0; b<nBatch; b++){
+         MakeAlpha();               // generate uniformly vector inside hypercube
+         for(j=0; j<fDim; j++){
+            alpha[b*fDim+j]= fAlpha[j];
+            xRand[b*fDim+j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
+         }
       }
-
-      wt=dx*Eval(xRand);
-
-      nProj = 0;
-      if(fDim>0) {
-         for(k=0; k<fDim; k++) {
-            xproj =fAlpha[k];
-            ((TH1D *)(*fHistEdg)[nProj])->Fill(xproj,wt);
-            nProj++;
+      EvalBatch(nBatch, xRand.data(), rho.data());
+
+      Bool_t stop = kFALSE;
+      for(Long_t b=0; b<nBatch && !stop; b++){
+         wt=dx*rho[b];
+
+         nProj = 0;
+         if(fDim>0) {
+            for(k=0; k<fDim; k++) {
+               xproj =alpha[b*fDim+k];
+               ((TH1D *)(*fHistEdg)[nProj])->Fill(xproj,wt);
+               nProj++;
+            }
          }
+         //
+         fNCalls++;
+         ceSum[0] += wt;    // sum of weights
+         ceSum[1] += wt*wt; // sum of weights squared
+         ceSum[2]++;        // sum of 1
+         if (ceSum[3]>wt) ceSum[3]=wt;  // minimum weight;
+         if (ceSum[4]<wt) ceSum[4]=wt;  // maximum weight
+         // test MC loop exit condition
+         nevEff = ceSum[0]*ceSum[0]/ceSum[1];
+         if( nevEff >= fNBin*fEvPerBin) stop = kTRUE;
       }
-      //
-      fNCalls++;
-      ceSum[0] += wt;    // sum of weights
-      ceSum[1] += wt*wt; // sum of weights squared
-      ceSum[2]++;        // sum of 1
-      if (ceSum[3]>wt) ceSum[3]=wt;  // minimum weight;
-      if (ceSum[4]<wt) ceSum[4]=wt;  // maximum weight
-      // test MC loop exit condition
-      nevEff = ceSum[0]*ceSum[0]/ceSum[1];
-      if( nevEff >= fNBin*fEvPerBin) break;
+      if (stop) break;
+      iev += nBatch;
    }   // ||||||||||||||||||||||||||END MC LOOP|||||||||||||||||||||||||||||
    //------------------------------------------------------------------
    //---  predefine logics of searching for the best division edge ---
@@ -692,7 +709,6 @@ void TFoam::Explore(TFoamCell *cell)
       parent->SetDriv( parDriv   +intDriv -driOld );
    }
    delete [] volPart;
-   delete [] xRand;
    //cell->Print();
 } // TFoam::Explore
 
@@ -1106,18 +1122,41 @@ Double_t TFoam::Eval(Double_t *xRand)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Internal subprogram used by Explore.
+/// Evaluates the distribution at the n points stored one after the other in
+/// x, in the results rho. A compiled distribution is evaluated at all the
+/// points at once with TFoamIntegrand::Densities, which can be vectorised or
+/// run in parallel.
+
+void TFoam::EvalBatch(Long_t n, Double_t *x, Double_t *rho)
+{
+   if(!fRho) {   //interactive mode
+      for(Long_t i=0; i<n; i++) rho[i]=Eval(x+i*fDim);
+   } else {       //compiled mode
+      fRho->Densities(fDim,n,x,rho);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Internal subprogram.
 /// Return randomly chosen active cell with probability equal to its
 /// contribution into total driver integral using interpolation search.
 
 void TFoam::GenerCel2(TFoamCell *&pCell)
+{
+   pCell = FindCell(fPseRan->Rndm());
+}       // TFoam::GenerCel2
+
+////////////////////////////////////////////////////////////////////////////////
+/// Internal subprogram used by GenerCel2 and MCgenerate.
+/// Return the active cell corresponding to the value random of the cumulative
+/// primary integral, using interpolation search.
+
+TFoamCell *TFoam::FindCell(Double_t random) const
 {
    Long_t  lo, hi, hit;
    Double_t fhit, flo, fhi;
-   Double_t random;
-
-   random=fPseRan->Rndm();
    lo  = 0;              hi =fNoAct-1;
    flo = fPrimAcu[lo];  fhi=fPrimAcu[hi];
    while(lo+1<hi) {
@@ -1136,10 +1175,9 @@ void TFoam::GenerCel2(TFoamCell *&pCell)
       }
    }
    if (fPrimAcu[lo]>random)
-      pCell = (TFoamCell *) fCellsAct->At(lo);
-   else
-      pCell = (TFoamCell *) fCellsAct->At(hi);
-}       // TFoam::GenerCel2
+      return (TFoamCell *) fCellsAct->At(lo);
+   return (TFoamCell *) fCellsAct->At(hi);
+}       // TFoam::FindCell
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1229,6 +1267,53 @@ Double_t TFoam::MCgenerate(Double_t *MCvect)
    return(fMCwt);
 }//MCgenerate
 
+////////////////////////////////////////////////////////////////////////////////
+/// User subprogram which generates MC event with the random number generator
+/// rnd and returns MC weight, drawing the same random numbers as MakeEvent.
+/// The FOAM object is not modified: the MC statistics used by GetIntegMC,
+/// GetWtParams and Finalize are not accumulated. After Initialize(), several
+/// threads may thus generate events concurrently, each one with its own
+/// generator, provided the distribution is a compiled TFoamIntegrand whose
+/// Density can be called concurrently:
+/// ~~~ {.cpp}
+///   // in every thread
+///   TRandom3 rnd(seedOfTheThread);
+///   std::vector<Double_t> x(foam->GetTotDim());
+///   for(Long_t loop=0; loop<nEvents; loop++){
+///     Double_t wt = foam->MCgenerate(x.data(), &rnd);
+///     ...
+///   }
+/// ~~~
+
+Double_t TFoam::MCgenerate(Double_t *MCvect, TRandom *rnd) const
+{
+   if(!fRho) {
+      Error("MCgenerate", "Generation with a given random number generator needs a compiled distribution \n");
+      return 0.;
+   }
+   Int_t      j;
+   Double_t   wt,mcwt;
+   TFoamCell *rCell;
+   TFoamVect  cellPosi(fDim); TFoamVect  cellSize(fDim);
+   //********************** MC LOOP STARS HERE **********************
+   for(;;) {
+      rCell = FindCell(rnd->Rndm());   // choose randomly one cell
+      if(fDim>0) rnd->RndmArray(fDim,MCvect);
+
+      rCell->GetHcub(cellPosi,cellSize);
+      for(j=0; j<fDim; j++)
+         MCvect[j]= cellPosi[j] +MCvect[j]*cellSize[j];
+      wt=rCell->GetVolume()*fRho->Density(fDim,MCvect);
+
+      mcwt = wt / rCell->GetPrim();  // PRIMARY controls normalization
+      //*******  Optional rejection ******
+      if(fOptRej != 1) return mcwt;
+      if( fMaxWtRej*rnd->Rndm() > mcwt) continue;  // Wt=1 events, internal rejection
+      return (mcwt<fMaxWtRej) ? 1.0 : mcwt/fMaxWtRej;
+   }
+   //********************** MC LOOP ENDS HERE **********************
+}//MCgenerate
+
 ////////////////////////////////////////////////////////////////////////////////
 /// User subprogram.
 /// It provides the value of the integral calculated from the averages of the MC run
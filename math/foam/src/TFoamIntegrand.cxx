@@ -3,9 +3,43 @@
 
 #include "TFoamIntegrand.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TMath.h"
+#include "TROOT.h"
+#endif
+
 ClassImp(TFoamIntegrand);
 
 //_________________________________________
 // Class TFoamIntegrand
 // =====================
 // Abstract class representing n-dimensional real positive integrand function
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluates the density at the npoints points of dimension ndim stored one
+/// after the other in x, in rho[0..npoints-1]. TFoam explores its cells with
+/// this method. The default implementation calls Density for every point, with
+/// the threads of the implicit multi-threading pool if it is enabled and
+/// IsThreadSafe() returns true. It can be overridden for a vectorised evaluation.
+
+void TFoamIntegrand::Densities(Int_t ndim, Long_t npoints, Double_t *x, Double_t *rho)
+{
+#ifdef R__USE_IMT
+   if (npoints > 1 && IsThreadSafe() && ROOT::IsImplicitMTEnabled()) {
+      const Long_t nChunks = TMath::Min(npoints, Long_t(4 * ROOT::GetImplicitMTPoolSize()));
+      const Long_t chunkSize = (npoints + nChunks - 1) / nChunks;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(
+         [&](Long_t chunk) {
+            const Long_t end = TMath::Min(npoints, (chunk + 1) * chunkSize);
+            for (Long_t i = chunk * chunkSize; i < end; i++)
+               rho[i] = Density(ndim, x + i * ndim);
+         },
+         ROOT::TSeq<Long_t>(0, nChunks));
+      return;
+   }
+#endif
+   for (Long_t i = 0; i < npoints; i++)
+      rho[i] = Density(ndim, x + i * ndim);
+}
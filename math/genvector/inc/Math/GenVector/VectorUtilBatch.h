@@ -0,0 +1,242 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2018 , LCG ROOT MathLib Team                         *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Header file for the Vector Utility functions working on arrays
+//
+#ifndef ROOT_Math_GenVector_VectorUtilBatch
+#define ROOT_Math_GenVector_VectorUtilBatch  1
+
+#include "Math/Math.h"
+#include "Math/Types.h"
+#include "Math/GenVector/GenVector_exception.h"
+
+#include <cmath>
+#include <cstddef>
+
+namespace ROOT {
+
+   namespace Math {
+
+      /**
+         Functions of the VectorUtil namespace working on arrays of vectors stored
+         by components (structure of arrays), for example the pt, eta, phi and m
+         of the objects of an event. They give the same results as the functions of
+         the vector classes applied to each element, but the elements are
+         processed by groups of ROOT::Double_v when ROOT is built with VecCore, with
+         the vectorized versions of the mathematical functions. The input and
+         output arrays can be the same.
+
+         @ingroup GenVector
+      */
+
+      namespace VectorUtil {
+
+         namespace GenVector_detail {
+
+            // the operations used by the kernels, for double and ROOT::Double_v
+
+            inline void Load(double & x, const double * p) { x = *p; }
+            inline void Store(double x, double * p) { *p = x; }
+            inline double Select(bool mask, double a, double b) { return mask ? a : b; }
+            inline double Sqrt(double x) { return std::sqrt(x); }
+            inline double Sin(double x) { return std::sin(x); }
+            inline double Cos(double x) { return std::cos(x); }
+            inline double Sinh(double x) { return std::sinh(x); }
+            inline double Cosh(double x) { return std::cosh(x); }
+
+            inline constexpr std::size_t Lanes() {
+#ifdef R__HAS_VECCORE
+               return vecCore::VectorSize<ROOT::Double_v>();
+#else
+               return 1;
+#endif
+            }
+
+#ifdef R__HAS_VECCORE
+            template <class V>
+            inline void Load(V & x, const double * p) { vecCore::Load(x, p); }
+            template <class V>
+            inline void Store(const V & x, double * p) { vecCore::Store(x, p); }
+            template <class M, class V>
+            inline V Select(const M & mask, const V & a, const V & b) { return vecCore::Blend(mask, a, b); }
+            template <class V>
+            inline V Sqrt(const V & x) { return vecCore::math::Sqrt(x); }
+            template <class V>
+            inline V Sin(const V & x) { return vecCore::math::Sin(x); }
+            template <class V>
+            inline V Cos(const V & x) { return vecCore::math::Cos(x); }
+            // VecCore has no hyperbolic functions: they are computed from the exponential,
+            // with their series at small argument for sinh, to keep the relative precision
+            template <class V>
+            inline V Sinh(const V & x) {
+               const V ex = vecCore::math::Exp(x);
+               const V x2 = x * x;
+               const V series = x * (1. + x2 / 6. * (1. + x2 / 20. * (1. + x2 / 42. * (1. + x2 / 72.))));
+               return Select(vecCore::math::Abs(x) < 0.1, series, 0.5 * (ex - 1. / ex));
+            }
+            template <class V>
+            inline V Cosh(const V & x) {
+               const V ex = vecCore::math::Exp(x);
+               return 0.5 * (ex + 1. / ex);
+            }
+#endif
+
+            /// fill the components px, py, pz, e of the element i from its pt, eta, phi, m
+            template <class V>
+            inline void ToPxPyPzE(std::size_t i, const double * pt, const double * eta, const double * phi,
+                                  const double * m, V & x, V & y, V & z, V & e) {
+               V vpt, veta, vphi, vm;
+               Load(vpt, pt + i);
+               Load(veta, eta + i);
+               Load(vphi, phi + i);
+               Load(vm, m + i);
+               x = vpt * Cos(vphi);
+               y = vpt * Sin(vphi);
+               z = vpt * Sinh(veta);
+               const V p = vpt * Cosh(veta);
+               // as PtEtaPhiM4D, negative masses give a negative mass squared
+               const V e2 = p * p + Select(vm >= 0., vm * vm, -vm * vm);
+               e = Sqrt(Select(e2 > 0., e2, V(0.)));
+            }
+
+            template <class V>
+            inline void InvariantMass(std::size_t i, const double * pt1, const double * eta1, const double * phi1,
+                                      const double * m1, const double * pt2, const double * eta2,
+                                      const double * phi2, const double * m2, double * mass) {
+               V x1, y1, z1, e1, x2, y2, z2, e2;
+               ToPxPyPzE(i, pt1, eta1, phi1, m1, x1, y1, z1, e1);
+               ToPxPyPzE(i, pt2, eta2, phi2, m2, x2, y2, z2, e2);
+               const V ee = e1 + e2;
+               const V xx = x1 + x2;
+               const V yy = y1 + y2;
+               const V zz = z1 + z2;
+               const V mm2 = ee * ee - xx * xx - yy * yy - zz * zz;
+               Store(Select(mm2 < 0., -Sqrt(-mm2), Sqrt(mm2)), mass + i);
+            }
+
+            template <class V>
+            inline void DeltaR(std::size_t i, const double * eta1, const double * phi1, const double * eta2,
+                               const double * phi2, double * dr) {
+               V veta1, vphi1, veta2, vphi2;
+               Load(veta1, eta1 + i);
+               Load(vphi1, phi1 + i);
+               Load(veta2, eta2 + i);
+               Load(vphi2, phi2 + i);
+               V dphi = vphi2 - vphi1;
+               dphi = Select(dphi > M_PI, dphi - 2.0 * M_PI, Select(dphi <= -M_PI, dphi + 2.0 * M_PI, dphi));
+               const V deta = veta2 - veta1;
+               Store(Sqrt(dphi * dphi + deta * deta), dr + i);
+            }
+
+            template <class V>
+            inline void Boost(std::size_t i, double * px, double * py, double * pz, double * e, const double * bx,
+                              const double * by, const double * bz) {
+               V x, y, z, t, vbx, vby, vbz;
+               Load(x, px + i);
+               Load(y, py + i);
+               Load(z, pz + i);
+               Load(t, e + i);
+               Load(vbx, bx + i);
+               Load(vby, by + i);
+               Load(vbz, bz + i);
+               const V b2 = vbx * vbx + vby * vby + vbz * vbz;
+               // the vectors with beta >= 1 are set to zero, as by boost
+               const auto valid = b2 < 1.;
+               const V gamma = Select(valid, 1.0 / Sqrt(Select(valid, 1.0 - b2, V(1.))), V(0.));
+               const V bp = vbx * x + vby * y + vbz * z;
+               const V gamma2 = Select(b2 > 0., (gamma - 1.0) / Select(b2 > 0., b2, V(1.)), V(0.));
+               const V zero(0.);
+               Store(Select(valid, x + gamma2 * bp * vbx + gamma * vbx * t, zero), px + i);
+               Store(Select(valid, y + gamma2 * bp * vby + gamma * vby * t, zero), py + i);
+               Store(Select(valid, z + gamma2 * bp * vbz + gamma * vbz * t, zero), pz + i);
+               Store(Select(valid, gamma * (t + bp), zero), e + i);
+            }
+
+            template <class V>
+            inline void PtEtaPhiMToPxPyPzE(std::size_t i, const double * pt, const double * eta, const double * phi,
+                                           const double * m, double * px, double * py, double * pz, double * e) {
+               V x, y, z, t;
+               ToPxPyPzE(i, pt, eta, phi, m, x, y, z, t);
+               Store(x, px + i);
+               Store(y, py + i);
+               Store(z, pz + i);
+               Store(t, e + i);
+            }
+
+         } // end namespace GenVector_detail
+
+         /**
+            Invariant masses of the n pairs of vectors given by their arrays of pt, eta,
+            phi and mass (1 for the first vector of each pair, 2 for the second),
+            the same as InvariantMass of two LorentzVector<PtEtaPhiM4D<double> >
+            (for pt > 0), stored in the array mass
+         */
+         inline void InvariantMass(std::size_t n, const double * pt1, const double * eta1, const double * phi1,
+                                   const double * m1, const double * pt2, const double * eta2, const double * phi2,
+                                   const double * m2, double * mass) {
+            std::size_t i = 0;
+            for (; i + GenVector_detail::Lanes() <= n; i += GenVector_detail::Lanes())
+               GenVector_detail::InvariantMass<ROOT::Double_v>(i, pt1, eta1, phi1, m1, pt2, eta2, phi2, m2, mass);
+            for (; i < n; ++i)
+               GenVector_detail::InvariantMass<double>(i, pt1, eta1, phi1, m1, pt2, eta2, phi2, m2, mass);
+         }
+
+         /**
+            Distances in (eta, phi) of the n pairs of vectors given by their arrays of eta and
+            phi, the same as DeltaR of the vectors, stored in the array dr
+         */
+         inline void DeltaR(std::size_t n, const double * eta1, const double * phi1, const double * eta2,
+                            const double * phi2, double * dr) {
+            std::size_t i = 0;
+            for (; i + GenVector_detail::Lanes() <= n; i += GenVector_detail::Lanes())
+               GenVector_detail::DeltaR<ROOT::Double_v>(i, eta1, phi1, eta2, phi2, dr);
+            for (; i < n; ++i)
+               GenVector_detail::DeltaR<double>(i, eta1, phi1, eta2, phi2, dr);
+         }
+
+         /**
+            Cartesian components px, py, pz and e of the n vectors given by their arrays of
+            pt, eta, phi and mass (pt > 0), as given by LorentzVector<PtEtaPhiM4D<double> >
+         */
+         inline void PtEtaPhiMToPxPyPzE(std::size_t n, const double * pt, const double * eta, const double * phi,
+                                        const double * m, double * px, double * py, double * pz, double * e) {
+            std::size_t i = 0;
+            for (; i + GenVector_detail::Lanes() <= n; i += GenVector_detail::Lanes())
+               GenVector_detail::PtEtaPhiMToPxPyPzE<ROOT::Double_v>(i, pt, eta, phi, m, px, py, pz, e);
+            for (; i < n; ++i)
+               GenVector_detail::PtEtaPhiMToPxPyPzE<double>(i, pt, eta, phi, m, px, py, pz, e);
+         }
+
+         /**
+            Boost the n Lorentz vectors given by their arrays of px, py, pz and e, replaced by
+            the boosted ones, each with its beta vector (bx, by, bz), as done by boost.
+            The beta of the boosts must be < 1: the other vectors are set to zero.
+          */
+         inline void boost(std::size_t n, double * px, double * py, double * pz, double * e, const double * bx,
+                           const double * by, const double * bz) {
+            for (std::size_t i = 0; i < n; ++i) {
+               if (bx[i] * bx[i] + by[i] * by[i] + bz[i] * bz[i] >= 1) {
+                  GenVector::Throw("Beta Vector supplied to set Boost represents speed >= c");
+                  break;
+               }
+            }
+            std::size_t i = 0;
+            for (; i + GenVector_detail::Lanes() <= n; i += GenVector_detail::Lanes())
+               GenVector_detail::Boost<ROOT::Double_v>(i, px, py, pz, e, bx, by, bz);
+            for (; i < n; ++i)
+               GenVector_detail::Boost<double>(i, px, py, pz, e, bx, by, bz);
+         }
+
+      } // end namespace VectorUtil
+
+   } // end namespace Math
+
+} // end namespace ROOT
+
+#endif /* ROOT_Math_GenVector_VectorUtilBatch */
@@ -0,0 +1,10 @@
+// @(#)root/mathcore:$Id$
+
+#ifndef ROOT_Math_VectorUtilBatch
+#define ROOT_Math_VectorUtilBatch
+
+
+#include "Math/GenVector/VectorUtilBatch.h"
+
+
+#endif
@@ -0,0 +1,124 @@
+// compare the functions of Math/VectorUtilBatch.h on arrays of pt, eta, phi, m
+// with the ones of VectorUtil applied to each LorentzVector, and time them
+#include "Math/VectorUtil.h"
+#include "Math/VectorUtilBatch.h"
+#include "Math/Vector4D.h"
+#include "Math/Vector3D.h"
+
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include <vector>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+using namespace ROOT::Math;
+
+const int n = 1000003;
+
+int iret = 0;
+
+void Compare(const char *name, const std::vector<double> &v1, const std::vector<double> &v2,
+             const std::vector<double> &scale)
+{
+   double d = 0;
+   for (unsigned int i = 0; i < v1.size(); ++i)
+      d = std::max(d, std::abs(v1[i] - v2[i]) / scale[i]);
+   std::cout << name << " max relative difference = " << d << std::endl;
+   if (d > 1.E-13) {
+      std::cout << name << " test failed" << std::endl;
+      iret = 1;
+   }
+}
+
+int main()
+{
+   TRandom3 r(4357);
+   std::vector<double> pt1(n), eta1(n), phi1(n), m1(n), pt2(n), eta2(n), phi2(n), m2(n);
+   for (int i = 0; i < n; ++i) {
+      pt1[i] = r.Exp(30.) + 1.;
+      eta1[i] = r.Uniform(-5, 5);
+      phi1[i] = r.Uniform(-M_PI, M_PI);
+      m1[i] = (i % 3) ? r.Uniform(0, 10) : 0.;
+      pt2[i] = r.Exp(30.) + 1.;
+      eta2[i] = (i % 5) ? r.Uniform(-5, 5) : r.Uniform(-0.1, 0.1);
+      phi2[i] = r.Uniform(-M_PI, M_PI);
+      m2[i] = r.Uniform(0, 10);
+   }
+
+   std::vector<PtEtaPhiMVector> v1(n), v2(n);
+   for (int i = 0; i < n; ++i) {
+      v1[i] = PtEtaPhiMVector(pt1[i], eta1[i], phi1[i], m1[i]);
+      v2[i] = PtEtaPhiMVector(pt2[i], eta2[i], phi2[i], m2[i]);
+   }
+
+   TStopwatch w;
+   std::vector<double> mass1(n), mass2(n), scale(n);
+   w.Start();
+   for (int i = 0; i < n; ++i)
+      mass1[i] = VectorUtil::InvariantMass(v1[i], v2[i]);
+   w.Stop();
+   std::cout << "InvariantMass of the vectors: " << w.RealTime() << " s" << std::endl;
+   w.Start();
+   VectorUtil::InvariantMass(n, pt1.data(), eta1.data(), phi1.data(), m1.data(), pt2.data(), eta2.data(),
+                             phi2.data(), m2.data(), mass2.data());
+   w.Stop();
+   std::cout << "InvariantMass of the arrays:  " << w.RealTime() << " s" << std::endl;
+   // the rounding errors are relative to the energy
+   for (int i = 0; i < n; ++i)
+      scale[i] = v1[i].E() + v2[i].E();
+   Compare("InvariantMass", mass1, mass2, scale);
+
+   std::vector<double> dr1(n), dr2(n);
+   for (int i = 0; i < n; ++i)
+      dr1[i] = VectorUtil::DeltaR(v1[i], v2[i]);
+   VectorUtil::DeltaR(n, eta1.data(), phi1.data(), eta2.data(), phi2.data(), dr2.data());
+   std::fill(scale.begin(), scale.end(), 1.);
+   Compare("DeltaR", dr1, dr2, scale);
+
+   std::vector<double> px(n), py(n), pz(n), e(n), bx(n), by(n), bz(n);
+   VectorUtil::PtEtaPhiMToPxPyPzE(n, pt1.data(), eta1.data(), phi1.data(), m1.data(), px.data(), py.data(),
+                                  pz.data(), e.data());
+   std::vector<double> ref(4 * n), res(4 * n);
+   for (int i = 0; i < n; ++i) {
+      ref[4 * i] = v1[i].Px();
+      ref[4 * i + 1] = v1[i].Py();
+      ref[4 * i + 2] = v1[i].Pz();
+      ref[4 * i + 3] = v1[i].E();
+      res[4 * i] = px[i];
+      res[4 * i + 1] = py[i];
+      res[4 * i + 2] = pz[i];
+      res[4 * i + 3] = e[i];
+   }
+   scale.resize(4 * n);
+   for (int i = 0; i < 4 * n; ++i)
+      scale[i] = v1[i / 4].E();
+   Compare("PtEtaPhiMToPxPyPzE", ref, res, scale);
+
+   // boost to the rest frame of the pairs
+   for (int i = 0; i < n; ++i) {
+      XYZVector b = (v1[i] + v2[i]).BoostToCM();
+      bx[i] = b.X();
+      by[i] = b.Y();
+      bz[i] = b.Z();
+   }
+   VectorUtil::boost(n, px.data(), py.data(), pz.data(), e.data(), bx.data(), by.data(), bz.data());
+   for (int i = 0; i < n; ++i) {
+      PxPyPzEVector vb = VectorUtil::boost(PxPyPzEVector(v1[i]), XYZVector(bx[i], by[i], bz[i]));
+      ref[4 * i] = vb.Px();
+      ref[4 * i + 1] = vb.Py();
+      ref[4 * i + 2] = vb.Pz();
+      ref[4 * i + 3] = vb.E();
+      res[4 * i] = px[i];
+      res[4 * i + 1] = py[i];
+      res[4 * i + 2] = pz[i];
+      res[4 * i + 3] = e[i];
+      scale[4 * i] = scale[4 * i + 1] = scale[4 * i + 2] = scale[4 * i + 3] = v1[i].E() + vb.E();
+   }
+   Compare("boost", ref, res, scale);
+
+   if (iret)
+      std::cerr << "testVectorUtilBatch: FAILED" << std::endl;
+   return iret;
+}
@@ -32,6 +32,9 @@
 #include "TError.h"
 #include "TSystem.h"
 
+#include <algorithm>
+#include <vector>
+
 // using parameter cache is not thread safe but needed for normalizing the functions
 #define USE_PARAMCACHE
 
@@ -368,6 +371,55 @@ namespace FitUtil {
 
    unsigned setAutomaticChunking(unsigned nEvents);
 
+   /**
+       Sum the contributions to a gradient of npar components of the points [begin, end).
+       pointGradient(i, gradFunc, contribution) sets the contribution of the point i, zeroed
+       before the call, using gradFunc as work space. The points are added up one after the
+       other, in the order of the points, without storing the contribution of each point.
+   */
+   template <class T, class F>
+   std::vector<T> SumPointGradients(unsigned int begin, unsigned int end, unsigned int npar, const F &pointGradient)
+   {
+      std::vector<T> gradFunc(npar);
+      std::vector<T> contribution(npar);
+      std::vector<T> sum(npar);
+      for (unsigned int i = begin; i < end; ++i) {
+         std::fill(contribution.begin(), contribution.end(), T(0));
+         pointGradient(i, gradFunc, contribution);
+         for (unsigned int ipar = 0; ipar < npar; ++ipar)
+            sum[ipar] += contribution[ipar];
+      }
+      return sum;
+   }
+
+#ifdef R__USE_IMT
+   /**
+       Sum the contributions to a gradient of the points [0, n) as SumPointGradients, in parallel:
+       the points are split in nChunks blocks of consecutive points summed by different tasks.
+   */
+   template <class T, class F>
+   std::vector<T> SumPointGradientsParallel(unsigned int n, unsigned int npar, const F &pointGradient, unsigned nChunks)
+   {
+      if (n == 0)
+         return std::vector<T>(npar);
+      const unsigned int nBlocks = std::max(1u, std::min(nChunks, n));
+      const unsigned int blockSize = (n + nBlocks - 1) / nBlocks;
+      auto mapFunction = [&](const unsigned int block) {
+         return SumPointGradients<T>(block * blockSize, std::min(n, (block + 1) * blockSize), npar, pointGradient);
+      };
+      auto redFunction = [&](const std::vector<std::vector<T>> &blockSums) {
+         std::vector<T> result(npar);
+         for (auto const &blockSum : blockSums) {
+            for (unsigned int ipar = 0; ipar < npar; ++ipar)
+               result[ipar] += blockSum[ipar];
+         }
+         return result;
+      };
+      ROOT::TThreadExecutor pool;
+      return pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, (n + blockSize - 1) / blockSize), redFunction);
+   }
+#endif
+
    template<class T>
    struct Evaluate {
 #ifdef R__HAS_VECCORE
@@ -944,11 +996,7 @@ namespace FitUtil {
          // numVectors + 1 because of the padded data (call to mapFunction with i = numVectors after the main loop)
          std::vector<vecCore::Mask<T>> validPointsMasks(numVectors + 1);
 
-         auto mapFunction = [&](const unsigned int i) {
-            // set all vector values to zero
-            std::vector<T> gradFunc(npar);
-            std::vector<T> pointContributionVec(npar);
-
+         auto mapFunction = [&](const unsigned int i, std::vector<T> &gradFunc, std::vector<T> &pointContributionVec) {
             T x1, y, invError;
 
             vecCore::Load<T>(x1, data.GetCoordComponent(i * vecSize, 0));
@@ -993,7 +1041,7 @@ namespace FitUtil {
             validPointsMasks[i] = CheckInfNaNValues(fval);
             if (vecCore::MaskEmpty(validPointsMasks[i])) {
                // Return a zero contribution to all partial derivatives on behalf of the current points
-               return pointContributionVec;
+               return;
             }
 
             // loop on the parameters
@@ -1010,20 +1058,6 @@ namespace FitUtil {
                vecCore::MaskedAssign(pointContributionVec[ipar], validPointsMasks[i],
                                      -2.0 * (y - fval) * invError * invError * gradFunc[ipar]);
             }
-
-            return pointContributionVec;
-         };
-
-         // Reduce the set of vectors by summing its equally-indexed components
-         auto redFunction = [&](const std::vector<std::vector<T>> &partialResults) {
-            std::vector<T> result(npar);
-
-            for (auto const &pointContributionVec : partialResults) {
-               for (unsigned int parameterIndex = 0; parameterIndex < npar; parameterIndex++)
-                  result[parameterIndex] += pointContributionVec[parameterIndex];
-            }
-
-            return result;
          };
 
          std::vector<T> gVec(npar);
@@ -1043,18 +1077,12 @@ namespace FitUtil {
 #endif
 
          if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
-            std::vector<std::vector<T>> allGradients(numVectors);
-            for (unsigned int i = 0; i < numVectors; ++i) {
-               allGradients[i] = mapFunction(i);
-            }
-
-            gVec = redFunction(allGradients);
+            gVec = SumPointGradients<T>(0, numVectors, npar, mapFunction);
          }
 #ifdef R__USE_IMT
          else if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
             auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(numVectors);
-            ROOT::TThreadExecutor pool;
-            gVec = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, numVectors), redFunction, chunks);
+            gVec = SumPointGradientsParallel<T>(numVectors, npar, mapFunction, chunks);
          }
 #endif
          // else if(executionPolicy == ROOT::Fit::kMultiprocess){
@@ -1070,7 +1098,7 @@ namespace FitUtil {
          // Compute the contribution from the remaining points
          unsigned int remainingPoints = initialNPoints % vecSize;
          if (remainingPoints > 0) {
-            auto remainingPointsContribution = mapFunction(numVectors);
+            auto remainingPointsContribution = SumPointGradients<T>(numVectors, numVectors + 1, npar, mapFunction);
             // Add the contribution from the valid remaining points and store the result in the output variable
             auto remainingMask = vecCore::Int2Mask<T>(remainingPoints);
             for (unsigned int param = 0; param < npar; param++) {
@@ -1144,11 +1172,7 @@ namespace FitUtil {
          unsigned initialNPoints = data.Size();
          unsigned numVectors = initialNPoints / vecSize;
 
-         auto mapFunction = [&](const unsigned int i) {
-            // set all vector values to zero
-            std::vector<T> gradFunc(npar);
-            std::vector<T> pointContributionVec(npar);
-
+         auto mapFunction = [&](const unsigned int i, std::vector<T> &gradFunc, std::vector<T> &pointContributionVec) {
             T x1, y;
 
             vecCore::Load<T>(x1, data.GetCoordComponent(i * vecSize, 0));
@@ -1202,20 +1226,6 @@ namespace FitUtil {
          }
       }
 #endif
-
-            return pointContributionVec;
-         };
-
-         // Vertically reduce the set of vectors by summing its equally-indexed components
-         auto redFunction = [&](const std::vector<std::vector<T>> &partialResults) {
-            std::vector<T> result(npar);
-
-            for (auto const &pointContributionVec : partialResults) {
-               for (unsigned int parameterIndex = 0; parameterIndex < npar; parameterIndex++)
-                  result[parameterIndex] += pointContributionVec[parameterIndex];
-            }
-
-            return result;
          };
 
          std::vector<T> gVec(npar);
@@ -1234,18 +1244,12 @@ namespace FitUtil {
 #endif
 
          if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
-            std::vector<std::vector<T>> allGradients(numVectors);
-            for (unsigned int i = 0; i < numVectors; ++i) {
-               allGradients[i] = mapFunction(i);
-            }
-
-            gVec = redFunction(allGradients);
+            gVec = SumPointGradients<T>(0, numVectors, npar, mapFunction);
          }
 #ifdef R__USE_IMT
          else if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
             auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(numVectors);
-            ROOT::TThreadExecutor pool;
-            gVec = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, numVectors), redFunction, chunks);
+            gVec = SumPointGradientsParallel<T>(numVectors, npar, mapFunction, chunks);
          }
 #endif
          // else if(executionPolicy == ROOT::Fit::ExecutionPolicy::kMultiprocess){
@@ -1262,7 +1266,7 @@ namespace FitUtil {
          // Compute the contribution from the remaining points
          unsigned int remainingPoints = initialNPoints % vecSize;
          if (remainingPoints > 0) {
-            auto remainingPointsContribution = mapFunction(numVectors);
+            auto remainingPointsContribution = SumPointGradients<T>(numVectors, numVectors + 1, npar, mapFunction);
             // Add the contribution from the valid remaining points and store the result in the output variable
             auto remainingMask = vecCore::Int2Mask<T>(remainingPoints);
             for (unsigned int param = 0; param < npar; param++) {
@@ -1312,10 +1316,7 @@ namespace FitUtil {
          const T kdmax1 = vecCore::math::Sqrt(vecCore::NumericLimits<T>::Max());
          const T kdmax2 = vecCore::NumericLimits<T>::Max() / (4 * initialNPoints);
 
-         auto mapFunction = [&](const unsigned int i) {
-            std::vector<T> gradFunc(npar);
-            std::vector<T> pointContributionVec(npar);
-
+         auto mapFunction = [&](const unsigned int i, std::vector<T> &gradFunc, std::vector<T> &pointContributionVec) {
             T x1;
             vecCore::Load<T>(x1, data.GetCoordComponent(i * vecSize, 0));
 
@@ -1359,20 +1360,6 @@ namespace FitUtil {
                }
                // if func derivative is zero term is also zero so do not add in g[kpar]
             }
-
-            return pointContributionVec;
-         };
-
-         // Vertically reduce the set of vectors by summing its equally-indexed components
-         auto redFunction = [&](const std::vector<std::vector<T>> &pointContributions) {
-            std::vector<T> result(npar);
-
-            for (auto const &pointContributionVec : pointContributions) {
-               for (unsigned int parameterIndex = 0; parameterIndex < npar; parameterIndex++)
-                  result[parameterIndex] += pointContributionVec[parameterIndex];
-            }
-
-            return result;
          };
 
          std::vector<T> gVec(npar);
@@ -1392,17 +1379,12 @@ namespace FitUtil {
 #endif
 
          if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
-            std::vector<std::vector<T>> allGradients(numVectors);
-            for (unsigned int i = 0; i < numVectors; ++i) {
-               allGradients[i] = mapFunction(i);
-            }
-            gVec = redFunction(allGradients);
+            gVec = SumPointGradients<T>(0, numVectors, npar, mapFunction);
          }
 #ifdef R__USE_IMT
          else if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
             auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(numVectors);
-            ROOT::TThreadExecutor pool;
-            gVec = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, numVectors), redFunction, chunks);
+            gVec = SumPointGradientsParallel<T>(numVectors, npar, mapFunction, chunks);
          }
 #endif
          // else if(executionPolicy == ROOT::Fit::ExecutionPolicy::kMultiprocess){
@@ -1418,7 +1400,7 @@ namespace FitUtil {
          // Compute the contribution from the remaining points
          unsigned int remainingPoints = initialNPoints % vecSize;
          if (remainingPoints > 0) {
-            auto remainingPointsContribution = mapFunction(numVectors);
+            auto remainingPointsContribution = SumPointGradients<T>(numVectors, numVectors + 1, npar, mapFunction);
             // Add the contribution from the valid remaining points and store the result in the output variable
             auto remainingMask = vecCore::Int2Mask<T>(initialNPoints % vecSize);
             for (unsigned int param = 0; param < npar; param++) {
@@ -41,6 +41,7 @@
 #pragma link C++ class ROOT::Math::TRandomEngine+;
 #pragma link C++ class ROOT::Math::LCGEngine+;
 #pragma link C++ class ROOT::Math::MersenneTwisterEngine+;
+#pragma link C++ class ROOT::Math::PhiloxEngine+;
 #pragma link C++ class ROOT::Math::MixMaxEngine<240,0>+;
 #pragma link C++ class ROOT::Math::MixMaxEngine<256,2>+;
 #pragma link C++ class ROOT::Math::MixMaxEngine<17,1>+;
@@ -65,11 +66,13 @@
 #pragma link C++ class TRandomGen<ROOT::Math::MixMaxEngine<17,1>>+;
 #pragma link C++ class TRandomGen<ROOT::Math::StdEngine<std::mt19937_64>>+;
 #pragma link C++ class TRandomGen<ROOT::Math::StdEngine<std::ranlux48>>+;
+#pragma link C++ class TRandomGen<ROOT::Math::PhiloxEngine>+;
 
 
 #pragma link C++ class ROOT::Math::StdRandomEngine+;
 #pragma link C++ class ROOT::Math::Random<ROOT::Math::LCGEngine>+;
 #pragma link C++ class ROOT::Math::Random<ROOT::Math::MersenneTwisterEngine>+;
+#pragma link C++ class ROOT::Math::Random<ROOT::Math::PhiloxEngine>+;
 #pragma link C++ class ROOT::Math::Random<ROOT::Math::MixMaxEngine<240,0>>+;
 #pragma link C++ class ROOT::Math::Random<ROOT::Math::MixMaxEngine<256,0>>+;
 #pragma link C++ class ROOT::Math::Random<ROOT::Math::MixMaxEngine<256,2>>+;
@@ -18,6 +18,8 @@
 
 #include "Math/VirtualIntegrator.h"
 
+#include "Fit/FitExecutionPolicy.h"
+
 namespace ROOT {
 namespace Math {
 
@@ -172,6 +174,15 @@ public:
    ///  get the option used for the integration
    ROOT::Math::IntegratorMultiDimOptions Options() const;
 
+   /// set the execution policy: with ROOT::Fit::ExecutionPolicy::kMultithread (requires IMT),
+   /// the function is evaluated concurrently at the nodes of the rule of a region, together with
+   /// the ones of the other half when a region is divided. The function must then be thread safe.
+   /// The result, error and number of evaluations are the same for all the policies.
+   void SetExecutionPolicy(ROOT::Fit::ExecutionPolicy policy) { fExecPolicy = policy; }
+
+   /// return the execution policy
+   ROOT::Fit::ExecutionPolicy ExecutionPolicy() const { return fExecPolicy; }
+
 protected:
 
    // internal function to compute the integral (if absVal is true compute abs value of function integral
@@ -193,6 +204,7 @@ protected:
    int fStatus;           // status of algorithm (error if not zero)
 
    const IMultiGenFunction* fFun;   // pointer to integrand function
+   ROOT::Fit::ExecutionPolicy fExecPolicy; // serial or multithread evaluation of the function
 
 };
 
@@ -95,6 +95,10 @@ public:
    /// Return the Interpolated z value corresponding to the (x,y) point
    double  Interpolate(double x, double y);
 
+   /// Interpolate the z values of n points (x[i],y[i]) into z, in parallel when
+   /// the implicit multi-threading is enabled
+   void  Interpolate(int n, const double *x, const double *y, double *z);
+
    /// Find all triangles 
    void      FindAllTriangles();
 
@@ -133,6 +137,9 @@ private:
    /// use Triangle or CGAL if flag is set 
    void DoFindTriangles();
 
+   /// internal method to compute the interpolation, once the triangles are found
+   double  DoInterpolate(double x, double y);
+
    /// internal method to compute the interpolation
    double  DoInterpolateNormalized(double x, double y);
 
@@ -264,12 +271,19 @@ protected:
    /* To speed up localisation of points a grid is layed over normalized space
     *
     * A reference to triangle ABC is added to _all_ grid cells that include ABC's bounding box
+    *
+    * The number of cells grows with the number of triangles, so that a cell holds a few
+    * triangles. The triangles of cell c are fCellTriangles[fCellStart[c]] up to
+    * fCellTriangles[fCellStart[c+1]], in increasing order.
     */
 
-   static const int fNCells = 25; //! number of cells to divide the normalized space
+   static const int fMinNCells = 25;   //! minimum number of cells to divide the normalized space
+   static const int fMaxNCells = 1024; //! maximum number of cells to divide the normalized space
+   int fNCells; //! number of cells to divide the normalized space
    double fXCellStep; //! inverse denominator to calculate X cell = fNCells / (fXNmax - fXNmin)
    double fYCellStep; //! inverse denominator to calculate X cell = fNCells / (fYNmax - fYNmin)
-   std::set<UInt_t> fCells[(fNCells+1)*(fNCells+1)]; //! grid cells with containing triangles
+   std::vector<UInt_t> fCellStart;     //! first entry of each grid cell in fCellTriangles
+   std::vector<UInt_t> fCellTriangles; //! triangles of the grid cells, cell after cell
 
    inline unsigned int Cell(UInt_t x, UInt_t y) const {
 	   return x*(fNCells+1) + y;
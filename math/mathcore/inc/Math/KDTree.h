@@ -20,6 +20,7 @@
 #include <cmath>
 
 // ROOT include(s)
+#include "RConfigure.h"
 #include "Rtypes.h"
 
 namespace ROOT
@@ -331,6 +332,7 @@ namespace ROOT
         ~KDTree();
 
         //public member functions
+        void            Build(const std::vector<const point_type*>& vPoints,eSplitOption opt = kEffective);
         void            EmptyBins();
         iterator        End();
         const iterator  End() const;
@@ -340,11 +342,13 @@ namespace ROOT
         void            Freeze();
         Double_t        GetBucketSize() const {return fBucketSize;}
         void            GetClosestPoints(const point_type& rRef,UInt_t nPoints,std::vector<std::pair<const _DataPoint*,Double_t> >& vFoundPoints) const;
+        void            GetClosestPoints(const std::vector<point_type>& vRefs,UInt_t nPoints,std::vector<std::vector<std::pair<const _DataPoint*,Double_t> > >& vFoundPoints) const;
         Double_t         GetEffectiveEntries() const;
         KDTree<_DataPoint>* GetFrozenCopy();
         UInt_t          GetNBins() const;
         UInt_t          GetEntries() const;
         void            GetPointsWithinDist(const point_type& rRef,value_type fDist,std::vector<const point_type*>& vFoundPoints) const;
+        void            GetPointsWithinDist(const std::vector<point_type>& vRefs,value_type fDist,std::vector<std::vector<const point_type*> >& vFoundPoints) const;
         Double_t        GetTotalSumw() const;
         Double_t        GetTotalSumw2() const;
         Bool_t          Insert(const point_type& rData) {return fHead->Parent()->Insert(rData);}
@@ -361,6 +365,11 @@ namespace ROOT
         KDTree(const KDTree<point_type>& ) {}
         KDTree<point_type>& operator=(const KDTree<point_type>& ) {return *this;}
 
+        typedef typename TerminalNode::data_it data_it;
+        BaseNode*       BuildNode(data_it first,data_it end,UInt_t iAxis,eSplitOption opt,UInt_t nTasks) const;
+        template<class _Query>
+        void            ForEachQuery(UInt_t nQueries,const _Query& query) const;
+
         BaseNode*  fHead;
         Double_t   fBucketSize;
         Bool_t     fIsFrozen;
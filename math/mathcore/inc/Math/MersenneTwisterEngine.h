@@ -70,6 +70,12 @@ namespace ROOT {
          }
          inline double operator() () { return Rndm_impl(); }
 
+         /// generate an array of random numbers in ]0,1]
+         void RndmArray(int n, double * array) {
+            for (int i = 0; i < n; ++i)
+               array[i] = Rndm_impl();
+         }
+
          uint32_t IntRndm() {
             return IntRndm_impl();
          }
@@ -0,0 +1,207 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2018  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// counter-based random engine
+
+#ifndef ROOT_Math_PhiloxEngine
+#define ROOT_Math_PhiloxEngine
+
+#include "Math/TRandomEngine.h"
+
+#include <cstdint>
+#include <vector>
+#include <string>
+
+namespace ROOT {
+
+   namespace Math {
+
+      /**
+         Counter-based random number generator Philox4x32-10 from
+         J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+         *Parallel random numbers: as easy as 1, 2, 3*,
+         Proceedings of SC11, http://dx.doi.org/10.1145/2063384.2063405
+
+         The n-th number of a stream is a bijective function (10 rounds of
+         multiplications and xors) of the counter n, the stream number and the
+         key given by the seed: there is no state to iterate. Each stream
+         has 2^64 numbers of 64 bits, and the engine can jump in constant time to
+         any stream (SetStream) and any position in it (Skip). Reproducible
+         parallel streams are obtained by using the same seed and a different
+         stream number (for example the index of the task) for each engine.
+
+         The generator passes the BigCrush tests of TestU01. The returned
+         double numbers have 53 random bits.
+
+         @ingroup Random
+      */
+
+      class PhiloxEngine : public TRandomEngine {
+
+
+      public:
+
+         typedef  TRandomEngine BaseType;
+         typedef  uint64_t Result_t;
+         typedef  uint32_t StateInt_t;
+
+         PhiloxEngine(uint64_t seed = 1, uint64_t stream = 0) : fPosition(0)
+         {
+            fKey[0] = uint32_t(seed);
+            fKey[1] = uint32_t(seed >> 32);
+            SetStream(stream);
+         }
+
+         virtual ~PhiloxEngine() {}
+
+         /// set the seed (the key of the generator) and restart the current stream
+         void SetSeed(uint64_t seed)
+         {
+            fKey[0] = uint32_t(seed);
+            fKey[1] = uint32_t(seed >> 32);
+            fPosition = 0;
+         }
+
+         /// go to the beginning of the given stream
+         void SetStream(uint64_t stream)
+         {
+            fStream = stream;
+            fPosition = 0;
+         }
+
+         /// skip the next n numbers of the stream
+         void Skip(uint64_t n)
+         {
+            fPosition += n;
+            // the current block is needed for the second number of a block
+            if (fPosition & 1)
+               Generate(fPosition >> 1, fBuffer);
+         }
+
+         /// current stream
+         uint64_t Stream() const { return fStream; }
+
+         /// number of numbers generated (or skipped) since the beginning of the stream
+         uint64_t Position() const { return fPosition; }
+
+         virtual double Rndm() { return Rndm_impl(); }
+
+         inline double operator()() { return Rndm_impl(); }
+
+         /// generate a 64 bit integer number
+         Result_t IntRndm()
+         {
+            if (!(fPosition & 1))
+               Generate(fPosition >> 1, fBuffer);
+            const unsigned int i = 2 * (fPosition++ & 1);
+            return fBuffer[i] | (uint64_t(fBuffer[i + 1]) << 32);
+         }
+
+         /// generate an array of random numbers in ]0,1], the same as n calls to Rndm
+         void RndmArray(int n, double *array)
+         {
+            int i = 0;
+            if ((fPosition & 1) && n > 0)
+               array[i++] = Rndm_impl();
+            // full blocks, which are independent from each other
+            const uint64_t block = fPosition >> 1;
+            const int nblocks = (n - i) / 2;
+            for (int k = 0; k < nblocks; ++k) {
+               uint32_t out[4];
+               Generate(block + k, out);
+               array[i + 2 * k] = ToDouble(out[0] | (uint64_t(out[1]) << 32));
+               array[i + 2 * k + 1] = ToDouble(out[2] | (uint64_t(out[3]) << 32));
+            }
+            fPosition += 2 * uint64_t(nblocks);
+            for (i += 2 * nblocks; i < n; ++i)
+               array[i] = Rndm_impl();
+         }
+
+         /// the Philox4x32-10 function of the 128 bit counter ctr with the 64 bit key
+         static void Philox4x32(const uint32_t *ctr, const uint32_t *key, uint32_t *out)
+         {
+            uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+            uint32_t k0 = key[0], k1 = key[1];
+            for (int round = 0; round < 10; ++round) {
+               const uint64_t p0 = uint64_t(0xD2511F53) * c0;
+               const uint64_t p1 = uint64_t(0xCD9E8D57) * c2;
+               c0 = uint32_t(p1 >> 32) ^ c1 ^ k0;
+               c1 = uint32_t(p1);
+               c2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+               c3 = uint32_t(p0);
+               k0 += 0x9E3779B9;
+               k1 += 0xBB67AE85;
+            }
+            out[0] = c0;
+            out[1] = c1;
+            out[2] = c2;
+            out[3] = c3;
+         }
+
+         /// minimum integer that can be generated
+         static uint64_t MinInt() { return 0; }
+         /// maximum integer that can be generated
+         static uint64_t MaxInt() { return 0xffffffffffffffffULL; } // 2^64 -1
+         /// Size of the generator state (key, stream and position)
+         static int Size() { return 6; }
+         /// Name of the generator
+         static std::string Name() { return "PhiloxEngine"; }
+
+      protected:
+         // functions used for testing
+
+         void SetState(const std::vector<uint32_t> &state)
+         {
+            fKey[0] = state[0];
+            fKey[1] = state[1];
+            fStream = state[2] | (uint64_t(state[3]) << 32);
+            fPosition = 0;
+            Skip(state[4] | (uint64_t(state[5]) << 32));
+         }
+
+         void GetState(std::vector<uint32_t> &state) const
+         {
+            state.resize(6);
+            state[0] = fKey[0];
+            state[1] = fKey[1];
+            state[2] = uint32_t(fStream);
+            state[3] = uint32_t(fStream >> 32);
+            state[4] = uint32_t(fPosition);
+            state[5] = uint32_t(fPosition >> 32);
+         }
+
+         int Counter() const { return fPosition & 1; }
+
+      private:
+
+         /// the two numbers of the given block of the current stream
+         void Generate(uint64_t block, uint32_t *out) const
+         {
+            const uint32_t ctr[4] = {uint32_t(block), uint32_t(block >> 32), uint32_t(fStream), uint32_t(fStream >> 32)};
+            Philox4x32(ctr, fKey, out);
+         }
+
+         /// the 53 upper bits of x as a double in ]0,1]
+         static double ToDouble(uint64_t x) { return ((x >> 11) + 1) * 1.1102230246251565e-16; } // * 2^-53
+
+         double Rndm_impl() { return ToDouble(IntRndm()); }
+
+         uint32_t fKey[2];     // key of the generator, given by the seed
+         uint64_t fStream;     // stream number, the upper half of the counter
+         uint64_t fPosition;   // position in the stream (two numbers per value of the counter)
+         uint32_t fBuffer[4];  // output of the current block
+      };
+
+
+   } // end namespace Math
+
+} // end namespace ROOT
+
+
+#endif /* ROOT_Math_PhiloxEngine */
@@ -65,7 +65,7 @@ namespace Math {
          Function to preserve ROOT Trandom compatibility
       */
       void RndmArray(int n, double * array) {
-         fEngine.RandomArray(array, array+n);
+         fEngine.RndmArray(n, array);
       }
 
       /**
@@ -108,6 +108,16 @@ namespace Math {
          return fFunctions.Gaus(mean,sigma);
       }
 
+      /// Array of n exponential numbers, transformed from uniform numbers generated at once
+      void ExpArray(int n, double * array, double tau) {
+         fFunctions.ExpArray(n, array, tau);
+      }
+
+      /// Array of n Gaussian numbers (Box-Muller), transformed from uniform numbers generated at once
+      void GausArray(int n, double * array, double mean = 0, double sigma = 1) {
+         fFunctions.GausArray(n, array, mean, sigma);
+      }
+
       /// Gamma distribution
       double Gamma(double a, double b) {
          return fFunctions.Gamma(a,b);
@@ -186,6 +196,11 @@ namespace Math {
          return fFunctions.Poisson(mu);
       }
 
+      ///   Array of n Poisson numbers, by inversion of the tabulated distribution for mu < 25
+      void PoissonArray(int n, unsigned int * array, double mu)  {
+         fFunctions.PoissonArray(n, array, mu);
+      }
+
       /// Negative Binomial distribution
       ///  First parameter is n, second is probability
       ///  To be consistent with Random::Binomial
@@ -233,6 +248,7 @@ namespace Math {
 
 #include "Math/MixMaxEngine.h"
 #include "Math/MersenneTwisterEngine.h"
+#include "Math/PhiloxEngine.h"
 #include "Math/StdEngine.h"
 
 namespace ROOT {
@@ -242,6 +258,7 @@ namespace Math {
 
    typedef   Random<ROOT::Math::MixMaxEngine<240,0>>            RandomMixMax;
    typedef   Random<ROOT::Math::MersenneTwisterEngine>   RandomMT19937;
+   typedef   Random<ROOT::Math::PhiloxEngine>            RandomPhilox;
    typedef   Random<ROOT::Math::StdEngine<std::mt19937_64>> RandomMT64;
    typedef   Random<ROOT::Math::StdEngine<std::ranlux48>> RandomRanlux48;
 
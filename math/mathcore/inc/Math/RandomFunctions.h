@@ -20,6 +20,8 @@
 
 #include <type_traits>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include "Rtypes.h"
 #include "TMath.h"
 #include <cassert>
@@ -228,6 +230,64 @@ namespace Math {
          return fImpl.GausACR(mean,sigma);
       }
 
+      /// generate an array of n random numbers in ]0,1] in one call of the engine
+      void RndmArray(int n, double * array) {
+         fEngine->RndmArray(n, array);
+      }
+
+      /// generate an array of n Gaussian numbers with the Box-Muller method, from
+      /// the uniform numbers generated at once by the engine
+      void GausArray(int n, double * array, double mean, double sigma) {
+         const int npairs = n / 2;
+         fEngine->RndmArray(2 * npairs, array);
+         for (int i = 0; i < npairs; ++i) {
+            const double radius = sigma * std::sqrt(-2 * std::log(array[2 * i]));
+            const double phi = 6.28318530717958623 * array[2 * i + 1];
+            array[2 * i] = mean + radius * std::cos(phi);
+            array[2 * i + 1] = mean + radius * std::sin(phi);
+         }
+         if (n % 2) {
+            const double radius = sigma * std::sqrt(-2 * std::log(Rndm_impl()));
+            array[n - 1] = mean + radius * std::cos(6.28318530717958623 * Rndm_impl());
+         }
+      }
+
+      /// generate an array of n exponential deviates exp( -t/tau ), from the uniform
+      /// numbers generated at once by the engine
+      void ExpArray(int n, double * array, double tau) {
+         fEngine->RndmArray(n, array);
+         for (int i = 0; i < n; ++i)
+            array[i] = -tau * std::log(array[i]);
+      }
+
+      /// generate an array of n Poisson numbers. Below a mean of 25, the cumulative
+      /// distribution is tabulated once and inverted on uniform numbers generated by
+      /// blocks (the probability of the tail not tabulated is below 1.E-15)
+      void PoissonArray(int n, unsigned int * array, double mean) {
+         if (mean <= 0 || mean >= 25) {
+            for (int i = 0; i < n; ++i)
+               array[i] = fImpl.Poisson(mean);
+            return;
+         }
+         std::vector<double> cdf;
+         double prob = std::exp(-mean);
+         cdf.push_back(prob);
+         while (cdf.back() < 1. - 1.E-15 && prob > 0) {
+            prob *= mean / cdf.size();
+            cdf.push_back(cdf.back() + prob);
+         }
+         const int kBlock = 256;
+         double u[kBlock];
+         for (int i = 0; i < n; i += kBlock) {
+            const int nblock = std::min(kBlock, n - i);
+            fEngine->RndmArray(nblock, u);
+            for (int j = 0; j < nblock; ++j) {
+               const unsigned int k = std::lower_bound(cdf.begin(), cdf.end(), u[j]) - cdf.begin();
+               array[i + j] = std::min<unsigned int>(k, cdf.size() - 1);
+            }
+         }
+      }
+
 
       // /// re-implement Gaussian 
       // double GausBM2(double mean, double sigma) {
@@ -34,6 +34,7 @@
 //   * TRandomMixMax for the MixMaxEngine<240,0>  (MIXMAX with state N=240)
 //   * TRandomMixMax17 for the MixMaxEngine<17,0>  (MIXMAX with state N=17)
 //   * TRandomMixMax256 for the MixMaxEngine<256,2> (MIXMAX with state N=256 )
+//   * TRandomPhilox for the PhiloxEngine (counter-based Philox4x32-10)
 //   * TRandomMT64 for the  StdEngine<std::mt19937_64> ( MersenneTwister 64 bits)
 //   * TRandomRanlux48 for the  StdEngine<std::ranlux48> (Ranlux 48 bits)
 //       
@@ -62,7 +63,7 @@ public:
       for (int i = 0; i < n; ++i) array[i] = fEngine(); 
    }
    virtual  void     RndmArray(Int_t n, Double_t *array) {
-            for (int i = 0; i < n; ++i) array[i] = fEngine(); 
+      fEngine.RndmArray(n, array);
    }
    virtual  void     SetSeed(ULong_t seed=0) {
       fEngine.SetSeed(seed);
@@ -74,6 +75,7 @@ public:
 // some useful typedef
 #include "Math/StdEngine.h"
 #include "Math/MixMaxEngine.h"
+#include "Math/PhiloxEngine.h"
 
 // not working wight now for this classes
 //#define  DEFINE_TEMPL_INSTANCE
@@ -123,6 +125,17 @@ typedef TRandomGen<ROOT::Math::MixMaxEngine<17,0>> TRandomMixMax17;
   
  */
 typedef TRandomGen<ROOT::Math::MixMaxEngine<256,2>> TRandomMixMax256;
+/**
+  @ingroup Random
+  Counter-based generator Philox4x32-10, with 53 random bits per number.
+  The generators with the same seed and different streams (see
+  ROOT::Math::PhiloxEngine::SetStream) give independent and reproducible
+  sequences, for example one per thread.
+
+   J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw, *Parallel random numbers: as easy as 1, 2, 3*,
+  Proceedings of SC11, http://dx.doi.org/10.1145/2063384.2063405
+ */
+typedef TRandomGen<ROOT::Math::PhiloxEngine> TRandomPhilox;
 /**
   @ingroup Random
   Generator based on a the Mersenne-Twister generator with 64 bits, 
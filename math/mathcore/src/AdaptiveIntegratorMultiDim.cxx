@@ -1,6 +1,8 @@
 // Implementation file for class
 // AdaptiveIntegratorMultiDim
 //
+#include "RConfigure.h"
+
 #include "Math/IFunction.h"
 #include "Math/AdaptiveIntegratorMultiDim.h"
 #include "Math/IntegratorOptions.h"
@@ -8,10 +10,83 @@
 
 #include <cmath>
 #include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
 
 namespace ROOT {
 namespace Math {
 
+namespace {
+
+// fill the n coordinates of the 2^n + 2n(n+1) + 1 nodes of the degree seven rule for the
+// region of center ctr and half widths wth, in the order of the sums of DoIntegral
+void GetRuleNodes(unsigned int n, const double *ctr, const double *wth, double *nodes)
+{
+   static const double xl2 = 0.358568582800318073;//lambda_2
+   static const double xl4 = 0.948683298050513796;//lambda_4
+   static const double xl5 = 0.688247201611685289;//lambda_5
+
+   double z[15], wthl[15];
+   unsigned int j, j1, k, l, m;
+   auto addNode = [&]() {
+      std::copy(z, z + n, nodes);
+      nodes += n;
+   };
+
+   for (j=0; j<n; j++) z[j] = ctr[j];
+   addNode();
+
+   //loop over coordinates
+   for (j=0; j<n; j++) {
+      z[j]    = ctr[j] - xl2*wth[j];
+      addNode();
+      z[j]    = ctr[j] + xl2*wth[j];
+      addNode();
+      wthl[j] = xl4*wth[j];
+      z[j]    = ctr[j] - wthl[j];
+      addNode();
+      z[j]    = ctr[j] + wthl[j];
+      addNode();
+      z[j]    = ctr[j];
+   }
+
+   for (j=1;j<n;j++) {
+      j1 = j-1;
+      for (k=j;k<n;k++) {
+         for (l=0;l<2;l++) {
+            wthl[j1] = -wthl[j1];
+            z[j1]    = ctr[j1] + wthl[j1];
+            for (m=0;m<2;m++) {
+               wthl[k] = -wthl[k];
+               z[k]    = ctr[k] + wthl[k];
+               addNode();
+            }
+         }
+         z[k] = ctr[k];
+      }
+      z[j1] = ctr[j1];
+   }
+
+   for (j=0;j<n;j++) {
+      wthl[j] = -xl5*wth[j];
+      z[j] = ctr[j] + wthl[j];
+   }
+L90: //sum over end nodes ~gray codes
+   addNode();
+   for (j=0;j<n;j++) {
+      wthl[j] = -wthl[j];
+      z[j] = ctr[j] + wthl[j];
+      if (wthl[j] > 0) goto L90;
+   }
+}
+
+} // end anonymous namespace
+
 
 
 AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double relTol, unsigned int maxpts, unsigned int size):
@@ -25,7 +100,8 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double rel
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
-   fFun(0)
+   fFun(0),
+   fExecPolicy(ROOT::Fit::ExecutionPolicy::kSerial)
 {
    // constructor - without passing a function
    if (fAbsTol < 0) fAbsTol = ROOT::Math::IntegratorMultiDimOptions::DefaultAbsTolerance();
@@ -45,7 +121,8 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim( const IMultiGenFunction
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
-   fFun(&f)
+   fFun(&f),
+   fExecPolicy(ROOT::Fit::ExecutionPolicy::kSerial)
 {
    // constructur passing a multi-dimensional function interface
    // constructor - without passing a function
@@ -96,11 +173,8 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
    double relerr; //an estimation of the relative accuracy of the result
 
 
-   double ctr[15], wth[15], wthl[15], z[15];
+   double ctr[15], wth[15];
 
-   static const double xl2 = 0.358568582800318073;//lambda_2
-   static const double xl4 = 0.948683298050513796;//lambda_4
-   static const double xl5 = 0.688247201611685289;//lambda_5
    static const double w2  = 980./6561; //weights/2^n
    static const double w4  = 200./19683;
    static const double wp2 = 245./486;//error weights/2^n
@@ -180,37 +254,87 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
    double rgnvol, sum1, sum2, sum3, sum4, sum5, difmax, f2, f3, dif, aresult;
    double rgncmp=0, rgnval, rgnerr;
 
-   unsigned int j1, k, l, m, idvaxn=0, idvax0=0, isbtmp, isbtpp;
+   unsigned int k, l, m, idvaxn=0, idvax0=0, isbtmp, isbtpp;
 
    //InitArgs(z,fParams);
 
+   ROOT::Fit::ExecutionPolicy execPolicy = fExecPolicy;
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::TThreadExecutor> pool;
+   if (execPolicy == ROOT::Fit::ExecutionPolicy::kMultithread)
+      pool.reset(new ROOT::TThreadExecutor());
+#else
+   if (execPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
+      MATH_WARN_MSG("AdaptiveIntegratorMultiDim::Integral",
+                    "Multithread execution policy requires IMT, which is disabled. Using the serial one");
+      execPolicy = ROOT::Fit::ExecutionPolicy::kSerial;
+   }
+#endif
+
+   // evaluate the function at the npts nodes x, concurrently in chunks of nodes with
+   // the multithread policy. The function values are summed afterwards in the same
+   // order for all the policies, so that the results do not depend on it
+   auto EvalNodes = [&](unsigned int npts, const double *x, double *f, bool absVal) {
+      auto evalRange = [&](unsigned int first, unsigned int last) {
+         for (unsigned int i = first; i < last; ++i) {
+            f[i] = (*fFun)(x + i*n);
+            if (absVal) f[i] = std::abs(f[i]);
+         }
+      };
+      if (execPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
+         evalRange(0, npts);
+         return;
+      }
+#ifdef R__USE_IMT
+      const unsigned int nChunks = std::min(npts, 4 * ROOT::GetImplicitMTPoolSize());
+      pool->Foreach([&](unsigned int ichunk) { evalRange((ichunk * npts) / nChunks, ((ichunk + 1) * npts) / nChunks); },
+                    ROOT::TSeq<unsigned int>(0, nChunks));
+#endif
+   };
+
+   // nodes of the rule and function values for the current region and, when a
+   // region is divided, for its second half, evaluated together with the first one
+   std::vector<double> nodes(2*irlcls*n);
+   std::vector<double> fval(2*irlcls);
+   bool nextDone = false;
+   const double * fv = fval.data();
+
 L20:
    rgnvol = twondm;//=2^n
    for (j=0; j<n; j++) {
       rgnvol *= wth[j]; //region volume
-      z[j]    = ctr[j]; //temporary node
    }
-   sum1 = (*fFun)((const double*)z);//EvalPar(z,fParams); //evaluate function
 
+   if (nextDone) {
+      // values of the second half computed with the first one
+      fv = fval.data() + irlcls;
+      nextDone = false;
+   }
+   else {
+      GetRuleNodes(n, ctr, wth, nodes.data());
+      unsigned int npts = irlcls;
+      if (ldv) {
+         const double ctr0 = ctr[idvax0-1];
+         ctr[idvax0-1] += 2*wth[idvax0-1];
+         GetRuleNodes(n, ctr, wth, nodes.data() + irlcls*n);
+         ctr[idvax0-1] = ctr0;
+         npts = 2*irlcls;
+         nextDone = true;
+      }
+      EvalNodes(npts, nodes.data(), fval.data(), absValue);
+      fv = fval.data();
+   }
+
+   //sums of the function values with the different weights, in the order of the nodes
+   sum1 = fv[0];
    difmax = 0;
    sum2   = 0;
    sum3   = 0;
-
-   //loop over coordinates
+   l = 1;
    for (j=0; j<n; j++) {
-      z[j]    = ctr[j] - xl2*wth[j];
-      if (absValue) f2 = std::abs((*fFun)(z));
-      else          f2 = (*fFun)(z);
-      z[j]    = ctr[j] + xl2*wth[j];
-      if (absValue) f2 += std::abs((*fFun)(z));
-      else          f2 += (*fFun)(z);
-      wthl[j] = xl4*wth[j];
-      z[j]    = ctr[j] - wthl[j];
-      if (absValue) f3 = std::abs((*fFun)(z));
-      else          f3 = (*fFun)(z);
-      z[j]    = ctr[j] + wthl[j];
-      if (absValue) f3 += std::abs((*fFun)(z));
-      else          f3 += (*fFun)(z);
+      f2 = fv[l] + fv[l+1];
+      f3 = fv[l+2] + fv[l+3];
+      l += 4;
       sum2   += f2;//sum func eval with different weights separately
       sum3   += f3;//for a given region
       dif     = std::abs(7*f2-f3-12*sum1);
@@ -219,42 +343,13 @@ L20:
          difmax=dif;
          idvaxn=j+1;
       }
-      z[j]    = ctr[j];
    }
-
    sum4 = 0;
-   for (j=1;j<n;j++) {
-      j1 = j-1;
-      for (k=j;k<n;k++) {
-         for (l=0;l<2;l++) {
-            wthl[j1] = -wthl[j1];
-            z[j1]    = ctr[j1] + wthl[j1];
-            for (m=0;m<2;m++) {
-               wthl[k] = -wthl[k];
-               z[k]    = ctr[k] + wthl[k];
-               if (absValue) sum4 += std::abs((*fFun)(z));
-               else            sum4 += (*fFun)(z);
-            }
-         }
-         z[k] = ctr[k];
-      }
-      z[j1] = ctr[j1];
-   }
-
+   for (m = 0; m < 2*n*(n-1); m++)
+      sum4 += fv[l++];
    sum5 = 0;
-
-   for (j=0;j<n;j++) {
-      wthl[j] = -xl5*wth[j];
-      z[j] = ctr[j] + wthl[j];
-   }
-L90: //sum over end nodes ~gray codes
-   if (absValue) sum5 += std::abs((*fFun)(z));
-   else          sum5 += (*fFun)(z);
-   for (j=0;j<n;j++) {
-      wthl[j] = -wthl[j];
-      z[j] = ctr[j] + wthl[j];
-      if (wthl[j] > 0) goto L90;
-   }
+   for (; l < irlcls; l++)
+      sum5 += fv[l];
 
    rgncmp  = rgnvol*(wpn1[n-2]*sum1+wp2*sum2+wpn3[n-2]*sum3+wp4*sum4);
    rgnval  = wn1[n-2]*sum1+w2*sum2+wn3[n-2]*sum3+w4*sum4+wn5[n-2]*sum5;
@@ -385,7 +480,7 @@ L160: //to divide or not
 double AdaptiveIntegratorMultiDim::Integral(const IMultiGenFunction &f, const double* xmin, const double * xmax)
 {
    // calculate integral passing a function object
-   fFun = &f;
+   SetFunction(f);
    return Integral(xmin, xmax);
 
 }
@@ -23,8 +23,14 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
 #include <stdlib.h>
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
 namespace ROOT {
    
    namespace Math {
@@ -95,6 +101,7 @@ void Delaunay2D::SetInputPoints(int n, const double * x, const double * y, const
 
 
 #ifndef HAS_CGAL
+   fNCells       = fMinNCells;
    fXCellStep    = 0.;
    fYCellStep    = 0.;
 #endif
@@ -111,6 +118,41 @@ double Delaunay2D::Interpolate(double x, double y)
    // needed in this function.
    FindAllTriangles();
 
+   return DoInterpolate(x, y);
+}
+
+//______________________________________________________________________________
+void Delaunay2D::Interpolate(int n, const double *x, const double *y, double *z)
+{
+   // Compute the z values of the n points (x[i],y[i]) as Interpolate(x[i],y[i])
+   // would do. The triangles are found first, then the points are interpolated
+   // in chunks on the implicit multi-threading pool when it is enabled: the
+   // interpolation only reads the triangulation.
+
+   if (n <= 0) return;
+   FindAllTriangles();
+
+   auto interpolateRange = [&](int first, int last) {
+      for (int i = first; i < last; ++i)
+         z[i] = DoInterpolate(x[i], y[i]);
+   };
+
+#if defined(R__USE_IMT) && !defined(HAS_CGAL)
+   const int chunkSize = 4096;
+   if (n > chunkSize && ROOT::IsImplicitMTEnabled()) {
+      const int nChunks = (n + chunkSize - 1) / chunkSize;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](int chunk) { interpolateRange(chunk * chunkSize, std::min(n, (chunk + 1) * chunkSize)); },
+                   ROOT::TSeq<int>(0, nChunks));
+      return;
+   }
+#endif
+   interpolateRange(0, n);
+}
+
+//______________________________________________________________________________
+double Delaunay2D::DoInterpolate(double x, double y)
+{
    // Find the z value corresponding to the point (x,y).
    double xx, yy;
    xx = Linear_transform(x, fOffsetX, fScaleFactorX); //xx = xTransformer(x);
@@ -242,14 +284,12 @@ double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
 
 /// Triangle implementation for normalizing the points
 void Delaunay2D::DoNormalizePoints() {
+   fXN.clear();
+   fYN.clear();
    for (Int_t n = 0; n < fNpoints; n++) {
       fXN.push_back(Linear_transform(fX[n], fOffsetX, fScaleFactorX));
       fYN.push_back(Linear_transform(fY[n], fOffsetY, fScaleFactorY));
    }
-
-   //also initialize fXCellStep and FYCellStep
-   fXCellStep = fNCells / (fXNmax - fXNmin);
-   fYCellStep = fNCells / (fYNmax - fYNmin);
 }
 
 /// Triangle implementation for finding all the triangles 
@@ -324,6 +364,17 @@ void Delaunay2D::DoFindTriangles() {
    triangulate((char *) "zQN", &in, &out, nullptr);
 
    fTriangles.resize(out.numberoftriangles);
+
+   // size the grid for a few triangles per cell, and initialize fXCellStep and fYCellStep
+   int nCells = std::sqrt(0.5 * out.numberoftriangles);
+   fNCells = nCells < fMinNCells ? fMinNCells : (nCells > fMaxNCells ? fMaxNCells : nCells);
+   fXCellStep = fNCells / (fXNmax - fXNmin);
+   fYCellStep = fNCells / (fYNmax - fYNmin);
+
+   // grid cells covered by the bounding box of each triangle
+   std::vector<unsigned int> cellBox(4 * out.numberoftriangles);
+   auto clampCell = [&](int c) -> unsigned int { return c < 0 ? 0 : (c > fNCells ? fNCells : c); };
+
    for(int t = 0; t < out.numberoftriangles; ++t){
       Triangle tri;
 
@@ -331,16 +382,9 @@ void Delaunay2D::DoFindTriangles() {
          //each triangle as numberofcorners vertices ( = 3)
          tri.idx[v] = out.trianglelist[t*out.numberofcorners + v];
 
-         //printf("triangle %u vertex %u: point %u/%i\n", t, v, tri.idx[v], out.numberofpoints);
-
          //pointlist is [x0 y0 x1 y1 ...]
          tri.x[v] = in.pointlist[tri.idx[v] * 2 + 0];
-
-         //printf("\t x: %f\n", tri.x[v]);
-
          tri.y[v] = in.pointlist[tri.idx[v] * 2 + 1];
-
-         //printf("\t y: %f\n", tri.y[v]);
       };
 
       transform(0);
@@ -355,20 +399,28 @@ void Delaunay2D::DoFindTriangles() {
       auto bx = std::minmax({tri.x[0], tri.x[1], tri.x[2]});
       auto by = std::minmax({tri.y[0], tri.y[1], tri.y[2]});
 
-      unsigned int cellXmin = CellX(bx.first);
-      unsigned int cellXmax = CellX(bx.second);
-
-      unsigned int cellYmin = CellY(by.first);
-      unsigned int cellYmax = CellY(by.second);
-
-      for(unsigned int i = cellXmin; i <= cellXmax; ++i) {
-         for(unsigned int j = cellYmin; j <= cellYmax; ++j) {
-            //printf("(%u,%u) = %u\n", i, j, Cell(i,j));
-            fCells[Cell(i,j)].insert(t);
-         }
-      }
+      cellBox[4 * t + 0] = clampCell(CellX(bx.first));
+      cellBox[4 * t + 1] = clampCell(CellX(bx.second));
+      cellBox[4 * t + 2] = clampCell(CellY(by.first));
+      cellBox[4 * t + 3] = clampCell(CellY(by.second));
    }
 
+   // count the triangles of each cell, then store them cell after cell in increasing order
+   const unsigned int nGridCells = (fNCells + 1) * (fNCells + 1);
+   fCellStart.assign(nGridCells + 1, 0);
+   for (int t = 0; t < out.numberoftriangles; ++t)
+      for (unsigned int i = cellBox[4 * t + 0]; i <= cellBox[4 * t + 1]; ++i)
+         for (unsigned int j = cellBox[4 * t + 2]; j <= cellBox[4 * t + 3]; ++j)
+            ++fCellStart[Cell(i, j) + 1];
+   for (unsigned int c = 0; c < nGridCells; ++c)
+      fCellStart[c + 1] += fCellStart[c];
+   fCellTriangles.resize(fCellStart[nGridCells]);
+   std::vector<UInt_t> next(fCellStart.begin(), fCellStart.end() - 1);
+   for (int t = 0; t < out.numberoftriangles; ++t)
+      for (unsigned int i = cellBox[4 * t + 0]; i <= cellBox[4 * t + 1]; ++i)
+         for (unsigned int j = cellBox[4 * t + 2]; j <= cellBox[4 * t + 3]; ++j)
+            fCellTriangles[next[Cell(i, j)]++] = t;
+
    freeStruct(in); freeStruct(out);
 }
 
@@ -402,7 +454,9 @@ double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
    if(cX < 0 || cX > fNCells || cY < 0 || cY > fNCells)
       return fZout; //TODO some more fancy interpolation here
 
-    for(unsigned int t : fCells[Cell(cX, cY)]){
+    const unsigned int cell = Cell(cX, cY);
+    for(unsigned int k = fCellStart[cell]; k < fCellStart[cell + 1]; ++k){
+       const unsigned int t = fCellTriangles[k];
        auto coords = bayCoords(t);
 
        if(inTriangle(coords)){
@@ -425,14 +479,14 @@ double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
           //brute force found a triangle -> grid not
           printf("Found triangle %u for (%f,%f) -> (%u,%u)\n", t, xx,yy, cX, cY);
           printf("Triangles in grid cell: ");
-          for(unsigned int x : fCells[Cell(cX, cY)])
-             printf("%u ", x);
+          for(unsigned int k = fCellStart[Cell(cX, cY)]; k < fCellStart[Cell(cX, cY) + 1]; ++k)
+             printf("%u ", fCellTriangles[k]);
           printf("\n");
 
           printf("Triangle %u is in cells: ", t);
           for(unsigned int i = 0; i <= fNCells; ++i)
              for(unsigned int j = 0; j <= fNCells; ++j)
-                if(fCells[Cell(i,j)].count(t))
+                if(std::count(&fCellTriangles[fCellStart[Cell(i,j)]], &fCellTriangles[fCellStart[Cell(i,j)+1]], t))
                    printf("(%u,%u) ", i, j);
           printf("\n");
           for(unsigned int i = 0; i < 3; ++i)
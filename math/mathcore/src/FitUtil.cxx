@@ -674,13 +674,10 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction &f, const BinData &data,
    unsigned int npar = func.NPar();
    unsigned initialNPoints = data.Size();
 
-   std::vector<bool> isPointRejected(initialNPoints);
-
-   auto mapFunction = [&](const unsigned int i) {
-      // set all vector values to zero
-      std::vector<double> gradFunc(npar);
-      std::vector<double> pointContribution(npar);
+   // one flag per byte: the points may be evaluated concurrently, and the bits of a std::vector<bool> are not
+   std::vector<char> isPointRejected(initialNPoints);
 
+   auto mapFunction = [&](const unsigned int i, std::vector<double> &gradFunc, std::vector<double> &pointContribution) {
       const auto x1 = data.GetCoordComponent(i, 0);
       const auto y = data.Value(i);
       auto invError = data.Error(i);
@@ -740,7 +737,7 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction &f, const BinData &data,
       if (!CheckInfNaNValue(fval)) {
          isPointRejected[i] = true;
          // Return a zero contribution to all partial derivatives on behalf of the current point
-         return pointContribution;
+         return;
       }
 
       // loop on the parameters
@@ -766,20 +763,6 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction &f, const BinData &data,
          // case loop was broken for an overflow in the gradient calculation
          isPointRejected[i] = true;
       }
-
-      return pointContribution;
-   };
-
-   // Vertically reduce the set of vectors by summing its equally-indexed components
-   auto redFunction = [&](const std::vector<std::vector<double>> &pointContributions) {
-      std::vector<double> result(npar);
-
-      for (auto const &pointContribution : pointContributions) {
-         for (unsigned int parameterIndex = 0; parameterIndex < npar; parameterIndex++)
-            result[parameterIndex] += pointContribution[parameterIndex];
-      }
-
-      return result;
    };
 
    std::vector<double> g(npar);
@@ -794,17 +777,12 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction &f, const BinData &data,
 #endif
 
    if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
-      std::vector<std::vector<double>> allGradients(initialNPoints);
-      for (unsigned int i = 0; i < initialNPoints; ++i) {
-         allGradients[i] = mapFunction(i);
-      }
-      g = redFunction(allGradients);
+      g = SumPointGradients<double>(0, initialNPoints, npar, mapFunction);
    }
 #ifdef R__USE_IMT
    else if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
       auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(initialNPoints);
-      ROOT::TThreadExecutor pool;
-      g = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, initialNPoints), redFunction, chunks);
+      g = SumPointGradientsParallel<double>(initialNPoints, npar, mapFunction, chunks);
    }
 #endif
    // else if(executionPolicy == ROOT::Fit::kMultiprocess){
@@ -824,7 +802,7 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction &f, const BinData &data,
    // correct the number of points
    nPoints = initialNPoints;
 
-   if (std::any_of(isPointRejected.begin(), isPointRejected.end(), [](bool point) { return point; })) {
+   if (std::any_of(isPointRejected.begin(), isPointRejected.end(), [](char point) { return point != 0; })) {
       unsigned nRejected = std::accumulate(isPointRejected.begin(), isPointRejected.end(), 0);
       assert(nRejected <= initialNPoints);
       nPoints = initialNPoints - nRejected;
@@ -1148,10 +1126,7 @@ void FitUtil::EvaluateLogLGradient(const IModelFunction &f, const UnBinData &dat
    const double kdmax1 = std::sqrt(std::numeric_limits<double>::max());
    const double kdmax2 = std::numeric_limits<double>::max() / (4 * initialNPoints);
 
-   auto mapFunction = [&](const unsigned int i) {
-      std::vector<double> gradFunc(npar);
-      std::vector<double> pointContribution(npar);
-
+   auto mapFunction = [&](const unsigned int i, std::vector<double> &gradFunc, std::vector<double> &pointContribution) {
 
       const double * x = nullptr;
       std::vector<double> xc;
@@ -1191,20 +1166,6 @@ void FitUtil::EvaluateLogLGradient(const IModelFunction &f, const UnBinData &dat
          }
          // if func derivative is zero term is also zero so do not add in g[kpar]
       }
-
-      return pointContribution;
-   };
-
-   // Vertically reduce the set of vectors by summing its equally-indexed components
-   auto redFunction = [&](const std::vector<std::vector<double>> &pointContributions) {
-      std::vector<double> result(npar);
-
-      for (auto const &pointContribution : pointContributions) {
-         for (unsigned int parameterIndex = 0; parameterIndex < npar; parameterIndex++)
-            result[parameterIndex] += pointContribution[parameterIndex];
-      }
-
-      return result;
    };
 
    std::vector<double> g(npar);
@@ -1219,17 +1180,12 @@ void FitUtil::EvaluateLogLGradient(const IModelFunction &f, const UnBinData &dat
 #endif
 
    if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
-      std::vector<std::vector<double>> allGradients(initialNPoints);
-      for (unsigned int i = 0; i < initialNPoints; ++i) {
-         allGradients[i] = mapFunction(i);
-      }
-      g = redFunction(allGradients);
+      g = SumPointGradients<double>(0, initialNPoints, npar, mapFunction);
    }
 #ifdef R__USE_IMT
    else if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
       auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(initialNPoints);
-      ROOT::TThreadExecutor pool;
-      g = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, initialNPoints), redFunction, chunks);
+      g = SumPointGradientsParallel<double>(initialNPoints, npar, mapFunction, chunks);
    }
 #endif
 
@@ -1596,11 +1552,7 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction &f, const BinData
    unsigned int npar = func.NPar();
    unsigned initialNPoints = data.Size();
 
-   auto mapFunction = [&](const unsigned int i) {
-      // set all vector values to zero
-      std::vector<double> gradFunc(npar);
-      std::vector<double> pointContribution(npar);
-
+   auto mapFunction = [&](const unsigned int i, std::vector<double> &gradFunc, std::vector<double> &pointContribution) {
       const auto x1 = data.GetCoordComponent(i, 0);
       const auto y = data.Value(i);
       auto invError = data.Error(i);
@@ -1683,21 +1635,6 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction &f, const BinData
             pointContribution[ipar] = -gg;
          }
       }
-
-
-      return pointContribution;
-   };
-
-   // Vertically reduce the set of vectors by summing its equally-indexed components
-   auto redFunction = [&](const std::vector<std::vector<double>> &pointContributions) {
-      std::vector<double> result(npar);
-
-      for (auto const &pointContribution : pointContributions) {
-         for (unsigned int parameterIndex = 0; parameterIndex < npar; parameterIndex++)
-            result[parameterIndex] += pointContribution[parameterIndex];
-      }
-
-      return result;
    };
 
    std::vector<double> g(npar);
@@ -1713,17 +1650,12 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction &f, const BinData
 #endif
 
    if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
-      std::vector<std::vector<double>> allGradients(initialNPoints);
-      for (unsigned int i = 0; i < initialNPoints; ++i) {
-         allGradients[i] = mapFunction(i);
-      }
-      g = redFunction(allGradients);
+      g = SumPointGradients<double>(0, initialNPoints, npar, mapFunction);
    }
 #ifdef R__USE_IMT
    else if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
       auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(initialNPoints);
-      ROOT::TThreadExecutor pool;
-      g = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, initialNPoints), redFunction, chunks);
+      g = SumPointGradientsParallel<double>(initialNPoints, npar, mapFunction, chunks);
    }
 #endif
 
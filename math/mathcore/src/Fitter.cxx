@@ -368,14 +368,14 @@ bool Fitter::DoLeastSquareFit(const ROOT::Fit::ExecutionPolicy &executionPolicy)
          if (fFunc_v) {
             std::shared_ptr<IGradModelFunction_v> gradFun = std::dynamic_pointer_cast<IGradModelFunction_v>(fFunc_v);
             if (gradFun) {
-               Chi2FCN<BaseGradFunc, IModelFunction_v> chi2(data, gradFun);
+               Chi2FCN<BaseGradFunc, IModelFunction_v> chi2(data, gradFun, executionPolicy);
                fFitType = chi2.Type();
                return DoMinimization(chi2);
             }
          } else {
             std::shared_ptr<IGradModelFunction> gradFun = std::dynamic_pointer_cast<IGradModelFunction>(fFunc);
             if (gradFun) {
-               Chi2FCN<BaseGradFunc> chi2(data, gradFun);
+               Chi2FCN<BaseGradFunc> chi2(data, gradFun, executionPolicy);
                fFitType = chi2.Type();
                return DoMinimization(chi2);
             }
@@ -560,7 +560,7 @@ bool Fitter::DoUnbinnedLikelihoodFit(bool extended, const ROOT::Fit::ExecutionPo
                MATH_WARN_MSG("Fitter::DoUnbinnedLikelihoodFit",
                              "Extended unbinned fit with gradient not yet supported - do a not-extended fit");
             }
-            LogLikelihoodFCN<BaseGradFunc, IModelFunction_v> logl(data, gradFun, useWeight, extended);
+            LogLikelihoodFCN<BaseGradFunc, IModelFunction_v> logl(data, gradFun, useWeight, extended, executionPolicy);
             fFitType = logl.Type();
             if (!DoMinimization(logl))
                return false;
@@ -582,7 +582,7 @@ bool Fitter::DoUnbinnedLikelihoodFit(bool extended, const ROOT::Fit::ExecutionPo
                MATH_WARN_MSG("Fitter::DoUnbinnedLikelihoodFit",
                              "Extended unbinned fit with gradient not yet supported - do a not-extended fit");
             }
-            LogLikelihoodFCN<BaseGradFunc> logl(data, gradFun, useWeight, extended);
+            LogLikelihoodFCN<BaseGradFunc> logl(data, gradFun, useWeight, extended, executionPolicy);
             fFitType = logl.Type();
             if (!DoMinimization(logl))
                return false;
@@ -61,6 +61,7 @@ namespace ROOT {
       int Counter() { return -1; }
       void SetCounter(int) {}
       void Iterate() {} 
+      void IterateAndFill(double *) {}
    };
 
 
@@ -106,6 +107,13 @@ public:
    void Iterate() {
       iterate(fRngState); 
    }
+   // iterate and return the N-1 new numbers, as N-1 calls to Rndm
+   // (iterate_and_fill_array does not apply the special term to them)
+   void IterateAndFill(double * array) {
+      iterate(fRngState);
+      for (int i = 1; i < ROOT_MM_N; ++i)
+         array[i-1] = (int64_t)fRngState->V[i] * (double)(INV_MERSBASE);
+   }
    int Counter() const {
       return fRngState->counter; 
    }
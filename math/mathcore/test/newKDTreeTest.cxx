@@ -296,6 +296,52 @@ bool CheckNearestNeighborSearches(const ROOT::Math::KDTree<_DataPoint>* pTree,co
    return true;
 }
 
+template<class _DataPoint>
+bool CheckBatchedQueries(const ROOT::Math::KDTree<_DataPoint>* pTree)
+{
+   const unsigned int nRefs = 100;
+   std::vector<_DataPoint> vRefs(nRefs);
+   for(unsigned int i = 0; i < nRefs; ++i)
+      for(unsigned int k = 0; k < _DataPoint::Dimension(); ++k)
+      vRefs[i].SetCoordinate(k,rand() % 1000);
+
+   const double fDist = rand() % 500;
+   const unsigned int nNeighbors = rand() % 100 + 1;
+   std::cout << "  --> " << nRefs << " reference points, distance " << fDist << ", " << nNeighbors << " nearest neighbors" << std::endl;
+
+   std::vector<std::vector<const _DataPoint*> > vFoundPoints;
+   std::vector<std::vector<std::pair<const _DataPoint*,double> > > vFoundNeighbors;
+   pTree->GetPointsWithinDist(vRefs,fDist,vFoundPoints);
+   pTree->GetClosestPoints(vRefs,nNeighbors,vFoundNeighbors);
+   if((vFoundPoints.size() != nRefs) || (vFoundNeighbors.size() != nRefs))
+   {
+      std::cout << "  --> wrong number of results of the batched queries" << std::endl;
+      return false;
+   }
+
+   // the batched queries give the same results as the single ones
+   for(unsigned int i = 0; i < nRefs; ++i)
+   {
+      std::vector<const _DataPoint*> vPoints;
+      pTree->GetPointsWithinDist(vRefs[i],fDist,vPoints);
+      if(vPoints != vFoundPoints[i])
+      {
+         std::cout << "  --> GetPointsWithinDist gives a different result for the reference point " << i << std::endl;
+         return false;
+      }
+
+      std::vector<std::pair<const _DataPoint*,double> > vNeighbors;
+      pTree->GetClosestPoints(vRefs[i],nNeighbors,vNeighbors);
+      if(vNeighbors != vFoundNeighbors[i] || vNeighbors.size() != nNeighbors)
+      {
+         std::cout << "  --> GetClosestPoints gives a different result for the reference point " << i << std::endl;
+         return false;
+      }
+   }
+
+   return true;
+}
+
 template<class _DataPoint>
 bool CheckTreeClear(ROOT::Math::KDTree<_DataPoint>* pTree,const std::vector<const _DataPoint*>& vDataPoints)
 {
@@ -382,6 +428,24 @@ int main()
    else
    std::cerr << "check nearest neighbor searches...FAILED" << std::endl;
 
+   if(CheckBatchedQueries(pTree))
+   std::cerr << "check batched queries...DONE" << std::endl;
+   else
+   std::cerr << "check batched queries...FAILED" << std::endl;
+
+   // same checks for the tree built at once
+   ROOT::Math::KDTree<DP>* pBuiltTree = new ROOT::Math::KDTree<DP>(BUCKETSIZE);
+   pBuiltTree->Build(vDataPoints);
+
+   if(CheckBasicTreeProperties(pBuiltTree,vDataPoints) && CheckBinBoundaries(pBuiltTree) &&
+      CheckEffectiveBinEntries(pBuiltTree) && CheckFindBin(pBuiltTree) &&
+      CheckNearestNeighborSearches(pBuiltTree,vDataPoints) && CheckBatchedQueries(pBuiltTree))
+   std::cerr << "check KDTree::Build...DONE" << std::endl;
+   else
+   std::cerr << "check KDTree::Build...FAILED" << std::endl;
+
+   delete pBuiltTree;
+
    if(CheckTreeClear(pTree,vDataPoints))
    std::cerr << "check KDTree::Clear...DONE" << std::endl;
    else
@@ -29,9 +29,11 @@
 #include "TPaveLabel.h"
 #include "TLegend.h"
 #include "TH1.h"
+#include "TROOT.h"
 
 bool showGraphics = false;
 bool verbose = false;
+int status = 0;
 
 using namespace std;
 
@@ -89,6 +91,33 @@ double integral_num(unsigned int dim, double* a, double* b, double* p)
   return timer.RealTime();
 }
 
+  // the multithread execution policy must give the same result, error and
+  // number of function evaluations as the serial one
+void integral_num_mt(unsigned int dim, double* a, double* b, double* p)
+{
+#ifdef R__USE_IMT
+  ROOT::Math::WrappedParamFunction<> funptr1(&SimpleFun, dim, p, p+1);
+  unsigned int nmax = (unsigned int) 1.E6;
+  ROOT::Math::AdaptiveIntegratorMultiDim ig1(funptr1, 1.E-5, 1.E-5, nmax);
+  ig1.Integral(a, b);
+  ROOT::Math::AdaptiveIntegratorMultiDim ig2(funptr1, 1.E-5, 1.E-5, nmax);
+  ig2.SetExecutionPolicy(ROOT::Fit::ExecutionPolicy::kMultithread);
+  TStopwatch timer;
+  timer.Start();
+  ig2.Integral(a, b);
+  timer.Stop();
+  if (verbose)
+     std::cout << "Time using IntegratorMultiDim multithread: \t" << timer.RealTime() << std::endl;
+  if (ig1.Result() != ig2.Result() || ig1.Error() != ig2.Error() || ig1.NEval() != ig2.NEval()) {
+     std::cerr << "Error: the multithread integration differs from the serial one : " << ig2.Result() << " +/- "
+               << ig2.Error() << " instead of " << ig1.Result() << " +/- " << ig1.Error() << std::endl;
+     status = 1;
+  }
+#else
+  (void)dim; (void)a; (void)b; (void)p;
+#endif
+}
+
   // ################################################################
   //
   //      testing TF1::IntegralMultiple class
@@ -169,6 +198,7 @@ void performance()
          b[i] = 1;//TMath::Pi();
       }
       num_performance->SetBinContent(N-1, integral_num(N, a, b, p));
+      integral_num_mt(N, a, b, p);
       TF1_performance->SetBinContent(N-1,integral_TF1(N, a, b, p));
    }
 
@@ -223,6 +253,10 @@ int main(int argc, char **argv)
      }
    }
 
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT();
+#endif
+
    TApplication* theApp = 0;
    if ( showGraphics )
       theApp = new TApplication("App",&argc,argv);
@@ -236,6 +270,6 @@ int main(int argc, char **argv)
       theApp = 0;
    }
 
-   return 0;
+   return status;
 
 }
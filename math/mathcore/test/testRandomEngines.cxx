@@ -0,0 +1,130 @@
+// tests of the counter-based PhiloxEngine and of the generation of arrays
+// of random numbers by the engines of ROOT::Math::Random
+#include "Math/PhiloxEngine.h"
+#include "Math/MixMaxEngine.h"
+#include "Math/Random.h"
+#include "TRandomGen.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace ROOT::Math;
+
+TEST(PhiloxEngine, KnownAnswer)
+{
+   // known answer tests of the Random123 distribution
+   const uint32_t zero[4] = {0, 0, 0, 0};
+   uint32_t out[4];
+   PhiloxEngine::Philox4x32(zero, zero, out);
+   EXPECT_EQ(0x6627e8d5u, out[0]);
+   EXPECT_EQ(0xe169c58du, out[1]);
+   EXPECT_EQ(0xbc57ac4cu, out[2]);
+   EXPECT_EQ(0x9b00dbd8u, out[3]);
+
+   const uint32_t ctr[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+   const uint32_t key[2] = {0xa4093822, 0x299f31d0};
+   PhiloxEngine::Philox4x32(ctr, key, out);
+   EXPECT_EQ(0xd16cfe09u, out[0]);
+   EXPECT_EQ(0x94fdccebu, out[1]);
+   EXPECT_EQ(0x5001e420u, out[2]);
+   EXPECT_EQ(0x24126ea1u, out[3]);
+}
+
+TEST(PhiloxEngine, StreamsAndSkip)
+{
+   PhiloxEngine r1(12345, 7);
+   std::vector<double> x(101);
+   for (auto &v : x) {
+      v = r1();
+      EXPECT_GT(v, 0.);
+      EXPECT_LE(v, 1.);
+   }
+   EXPECT_EQ(101u, r1.Position());
+
+   // jump to any position of the stream
+   for (unsigned int n : {0u, 1u, 2u, 50u, 99u}) {
+      PhiloxEngine r2(12345);
+      r2.SetStream(7);
+      r2.Skip(n);
+      EXPECT_EQ(x[n], r2());
+   }
+
+   // the streams and the seeds give different sequences
+   PhiloxEngine r3(12345, 8), r4(12346, 7);
+   EXPECT_NE(x[0], r3());
+   EXPECT_NE(x[0], r4());
+}
+
+template <class Engine>
+void CheckArray(Engine &r1, Engine &r2, int n)
+{
+   std::vector<double> x(n);
+   for (unsigned int offset : {0u, 1u, 3u}) {
+      for (unsigned int i = 0; i < offset; ++i)
+         EXPECT_EQ(r1(), r2());
+      r1.RndmArray(n, x.data());
+      for (int i = 0; i < n; ++i)
+         EXPECT_EQ(r2(), x[i]);
+   }
+   EXPECT_EQ(r1(), r2());
+}
+
+TEST(RandomEngines, RndmArray)
+{
+   PhiloxEngine p1(3, 1), p2(3, 1);
+   CheckArray(p1, p2, 1001);
+   MixMaxEngine<240, 0> m1(3), m2(3);
+   CheckArray(m1, m2, 1001);
+   MixMaxEngine<256, 2> n1(3), n2(3);
+   CheckArray(n1, n2, 1001);
+   MixMaxEngine<17, 1> l1(3), l2(3);
+   CheckArray(l1, l2, 100);
+}
+
+TEST(RandomEngines, Arrays)
+{
+   const int n = 100001;
+   std::vector<double> x(n);
+   RandomPhilox r(5);
+
+   r.GausArray(n, x.data(), 1., 2.);
+   double sum = 0, sum2 = 0;
+   for (double v : x) {
+      sum += v;
+      sum2 += v * v;
+   }
+   EXPECT_NEAR(1., sum / n, 0.05);
+   EXPECT_NEAR(4., sum2 / n - (sum / n) * (sum / n), 0.1);
+
+   r.ExpArray(n, x.data(), 3.);
+   sum = 0;
+   for (double v : x) {
+      EXPECT_GE(v, 0.);
+      sum += v;
+   }
+   EXPECT_NEAR(3., sum / n, 0.05);
+
+   std::vector<unsigned int> k(n);
+   for (double mu : {0.5, 7., 40.}) {
+      r.PoissonArray(n, k.data(), mu);
+      sum = 0, sum2 = 0;
+      for (unsigned int v : k) {
+         sum += v;
+         sum2 += double(v) * v;
+      }
+      EXPECT_NEAR(mu, sum / n, 5 * std::sqrt(mu / n));
+      EXPECT_NEAR(mu, sum2 / n - (sum / n) * (sum / n), 0.05 * mu);
+   }
+}
+
+TEST(RandomEngines, TRandomPhilox)
+{
+   TRandomPhilox r1(11);
+   PhiloxEngine r2(11);
+   std::vector<double> x(10);
+   r1.RndmArray(10, x.data());
+   for (double v : x)
+      EXPECT_EQ(r2(), v);
+}
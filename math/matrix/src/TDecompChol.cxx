@@ -27,6 +27,10 @@
 #include "TDecompChol.h"
 #include "TMath.h"
 
+#ifdef MATRIX_LAPACK
+#include "TMatrixTLapack.h"
+#endif
+
 ClassImp(TDecompChol);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -115,6 +119,18 @@ Bool_t TDecompChol::Decompose()
    Int_t i,j,icol,irow;
    const Int_t     n  = fU.GetNrows();
          Double_t *pU = fU.GetMatrixArray();
+
+#ifdef MATRIX_LAPACK
+   if (n >= TMatrixTLapack::kMinSize) {
+      if (!TMatrixTLapack::DecomposeChol(pU,n)) {
+         Error("Decompose()","matrix not positive definite");
+         return kFALSE;
+      }
+      SetBit(kDecomposed);
+      return kTRUE;
+   }
+#endif
+
    for (icol = 0; icol < n; icol++) {
       const Int_t rowOff = icol*n;
 
@@ -345,6 +361,23 @@ Bool_t TDecompChol::Invert(TMatrixDSym &inv)
       return kFALSE;
    }
 
+#ifdef MATRIX_LAPACK
+   if (GetNrows() >= TMatrixTLapack::kMinSize) {
+      if (TestBit(kSingular)) {
+         Error("Invert(TMatrixDSym &","Matrix is singular");
+         return kFALSE;
+      }
+      if ( !TestBit(kDecomposed) ) {
+         if (!Decompose()) {
+            Error("Invert(TMatrixDSym &","Decomposition failed");
+            return kFALSE;
+         }
+      }
+      inv.SetMatrixArray(fU.GetMatrixArray());
+      return TMatrixTLapack::InvertChol(inv.GetMatrixArray(),GetNrows());
+   }
+#endif
+
    inv.UnitMatrix();
 
    const Int_t colLwb = inv.GetColLwb();
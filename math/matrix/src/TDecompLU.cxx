@@ -12,6 +12,11 @@
 #include "TDecompLU.h"
 #include "TMath.h"
 
+#ifdef MATRIX_LAPACK
+#include "TMatrixTLapack.h"
+#include <vector>
+#endif
+
 ClassImp(TDecompLU);
 
 /** \class TDecompLU
@@ -602,6 +607,17 @@ Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
    const Int_t     n     = lu.GetNcols();
    Double_t *pLU   = lu.GetMatrixArray();
 
+#ifdef MATRIX_LAPACK
+   // same pivots and factors from LAPACK, on the matrix with normalized rows
+   if (n >= TMatrixTLapack::kMinSize) {
+      if (!TMatrixTLapack::DecomposeLU(pLU,n,index,sign,tol,nrZeros,kTRUE)) {
+         ::Error("TDecompLU::DecomposeLUCrout","matrix is singular");
+         return kFALSE;
+      }
+      return kTRUE;
+   }
+#endif
+
    Double_t work[kWorkMax];
    Bool_t isAllocated = kFALSE;
    Double_t *scale = work;
@@ -711,6 +727,16 @@ Bool_t TDecompLU::DecomposeLUGauss(TMatrixD &lu,Int_t *index,Double_t &sign,
    const Int_t     n   = lu.GetNcols();
    Double_t *pLU = lu.GetMatrixArray();
 
+#ifdef MATRIX_LAPACK
+   if (n >= TMatrixTLapack::kMinSize) {
+      if (!TMatrixTLapack::DecomposeLU(pLU,n,index,sign,tol,nrZeros,kFALSE)) {
+         ::Error("TDecompLU::DecomposeLUGauss","matrix is singular");
+         return kFALSE;
+      }
+      return kTRUE;
+   }
+#endif
+
    sign    = 1.0;
    nrZeros = 0;
 
@@ -785,6 +811,47 @@ Bool_t TDecompLU::InvertLU(TMatrixD &lu,Double_t tol,Double_t *det)
    const Int_t     n   = lu.GetNcols();
    Double_t *pLU = lu.GetMatrixArray();
 
+#ifdef MATRIX_LAPACK
+   // decomposition as DecomposeLUCrout and inversion by LAPACK, on the matrix by columns
+   if (n >= TMatrixTLapack::kMinSize) {
+      std::vector<Double_t> work(Long64_t(n)*n);
+      std::vector<Int_t> ipiv(n);
+      for (Int_t i = 0; i < n; i++)
+         for (Int_t j = 0; j < n; j++)
+            work[j*n+i] = pLU[i*n+j];
+      const Int_t info = TMatrixTLapack::FactorLU(work.data(),n,ipiv.data(),kTRUE);
+      Int_t nrZeros = 0;
+      Double_t sign = 1.0;
+      TVectorD diagv(n);
+      for (Int_t j = 0; j < n && info == 0; j++) {
+         if (ipiv[j] != j)
+            sign = -sign;
+         diagv(j) = work[j*n+j];
+         if (TMath::Abs(diagv(j)) < tol)
+            nrZeros++;
+      }
+      if (info != 0 || nrZeros > 0) {
+         ::Error("TDecompLU::InvertLU","matrix is singular, %d diag elements < tolerance of %.4e",nrZeros,tol);
+         return kFALSE;
+      }
+      if (det) {
+         Double_t d1;
+         Double_t d2;
+         DiagProd(diagv,tol,d1,d2);
+         d1 *= sign;
+         *det = d1*TMath::Power(2.0,d2);
+      }
+      if (!TMatrixTLapack::InvertLU(work.data(),n,ipiv.data())) {
+         ::Error("TDecompLU::InvertLU","matrix is singular");
+         return kFALSE;
+      }
+      for (Int_t i = 0; i < n; i++)
+         for (Int_t j = 0; j < n; j++)
+            pLU[i*n+j] = work[j*n+i];
+      return kTRUE;
+   }
+#endif
+
    Int_t worki[kWorkMax];
    Bool_t isAllocatedI = kFALSE;
    Int_t *index = worki;
@@ -26,6 +26,10 @@
 #include "TMatrixDSymEigen.h"
 #include "TMath.h"
 
+#ifdef MATRIX_LAPACK
+#include "TMatrixTLapack.h"
+#endif
+
 ClassImp(TMatrixDSymEigen);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -43,6 +47,13 @@ TMatrixDSymEigen::TMatrixDSymEigen(const TMatrixDSym &a)
 
    fEigenVectors = a;
 
+#ifdef MATRIX_LAPACK
+   // the eigenvectors may differ in sign from the ones of the Householder/QL algorithm
+   if (nRows >= TMatrixTLapack::kMinSize &&
+       TMatrixTLapack::SymEigen(fEigenVectors.GetMatrixArray(),fEigenValues.GetMatrixArray(),nRows))
+      return;
+#endif
+
    TVectorD offDiag;
    Double_t work[kWorkMax];
    if (nRows > kWorkMax) offDiag.ResizeTo(nRows);
@@ -18,7 +18,6 @@
 */
 
 #include <iostream>
-#include <typeinfo>
 
 #include "TMatrixT.h"
 #include "TBuffer.h"
@@ -28,6 +27,10 @@
 #include "TDecompLU.h"
 #include "TMatrixDEigen.h"
 #include "TClass.h"
+
+#ifdef MATRIX_LAPACK
+#include "TMatrixTLapack.h"
+#endif
 #include "TMath.h"
 
 templateClassImp(TMatrixT);
@@ -664,19 +667,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixT<Element>
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -686,7 +676,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixT<Element>
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -715,19 +704,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixT<Elemen
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -738,7 +714,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixT<Elemen
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
 
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -767,19 +742,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixTSym<Elemen
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasRight,CblasUpper,fNrows,fNcols,1.0,
-                   bp,b.GetNcols(),ap,a.GetNcols(),0.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasRight,CblasUpper,fNrows,fNcols,1.0,
-                   bp,b.GetNcols(),ap,a.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -789,7 +751,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixTSym<Elemen
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -819,19 +780,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixTSym<Ele
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -841,7 +789,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixTSym<Ele
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -870,19 +817,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixT<Element>
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasTrans,CblasNoTrans,this->fNrows,this->fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("TMult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
    const Int_t ncolsb = b.GetNcols();
@@ -891,7 +825,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixT<Element>
          Element *       cp = this->GetMatrixArray();
 
    AtMultB(ap,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -920,19 +853,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixTSym<Eleme
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("TMult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
    const Int_t ncolsb = b.GetNcols();
@@ -941,7 +861,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixTSym<Eleme
          Element *       cp = this->GetMatrixArray();
 
    AtMultB(ap,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -970,19 +889,6 @@ void TMatrixT<Element>::MultT(const TMatrixT<Element> &a,const TMatrixT<Element>
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("MultT","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -992,7 +898,6 @@ void TMatrixT<Element>::MultT(const TMatrixT<Element> &a,const TMatrixT<Element>
          Element *       cp = this->GetMatrixArray();
 
    AMultBt(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1021,19 +926,6 @@ void TMatrixT<Element>::MultT(const TMatrixTSym<Element> &a,const TMatrixT<Eleme
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasTrans,this->fNrows,this->fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("MultT","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -1043,7 +935,6 @@ void TMatrixT<Element>::MultT(const TMatrixTSym<Element> &a,const TMatrixT<Eleme
          Element *       cp = this->GetMatrixArray();
 
    AMultBt(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3077,6 +2968,12 @@ template<class Element>
 void AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
             const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+#ifdef MATRIX_LAPACK
+   if (ncolsa > 0 && TMatrixTLapack::UseGemm(na/ncolsa,ncolsb,ncolsa)) {
+      TMatrixTLapack::AMultB(ap,na/ncolsa,ncolsa,bp,ncolsb,cp);
+      return;
+   }
+#endif
    const Element *arp0 = ap;                     // Pointer to  A[i,0];
    while (arp0 < ap+na) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3100,6 +2997,12 @@ template<class Element>
 void AtMultB(const Element * const ap,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+#ifdef MATRIX_LAPACK
+   if (ncolsb > 0 && TMatrixTLapack::UseGemm(ncolsa,ncolsb,nb/ncolsb)) {
+      TMatrixTLapack::AtMultB(ap,ncolsa,nb/ncolsb,bp,ncolsb,cp);
+      return;
+   }
+#endif
    const Element *acp0 = ap;           // Pointer to  A[i,0];
    while (acp0 < ap+ncolsa) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3124,6 +3027,12 @@ template<class Element>
 void AMultBt(const Element * const ap,Int_t na,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+#ifdef MATRIX_LAPACK
+   if (ncolsa > 0 && TMatrixTLapack::UseGemm(na/ncolsa,nb/ncolsb,ncolsa)) {
+      TMatrixTLapack::AMultBt(ap,na/ncolsa,ncolsa,bp,nb/ncolsb,cp);
+      return;
+   }
+#endif
    const Element *arp0 = ap;                    // Pointer to  A[i,0];
    while (arp0 < ap+na) {
       const Element *brp0 = bp;                  // Pointer to  B[j,0];
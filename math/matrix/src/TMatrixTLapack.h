@@ -0,0 +1,270 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMatrixTLapack
+#define ROOT_TMatrixTLapack
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMatrixTLapack                                                       //
+//                                                                      //
+// Calls of an optimized BLAS and LAPACK library (OpenBLAS, MKL, ...)   //
+// for the operations of the large matrices, used when the matrix       //
+// library is built with the lapack option (MATRIX_LAPACK defined).     //
+// These libraries are multithreaded by themselves (see for example     //
+// OPENBLAS_NUM_THREADS or MKL_NUM_THREADS).                            //
+// The matrices of ROOT are stored by rows and the ones of LAPACK by    //
+// columns: the array of a matrix A is seen by LAPACK as A^T. A product //
+// C = A*B is therefore computed as C^T = B^T*A^T, and the symmetric    //
+// problems need no transposition.                                      //
+// The matrices smaller than kMinSize keep the hand-written loops.      //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include "TMath.h"
+
+#include <utility>
+#include <vector>
+
+extern "C" {
+void dgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const double *alpha,
+            const double *a, const int *lda, const double *b, const int *ldb, const double *beta, double *c,
+            const int *ldc);
+void sgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const float *alpha,
+            const float *a, const int *lda, const float *b, const int *ldb, const float *beta, float *c,
+            const int *ldc);
+void dgetrf_(const int *m, const int *n, double *a, const int *lda, int *ipiv, int *info);
+void dgetri_(const int *n, double *a, const int *lda, const int *ipiv, double *work, const int *lwork, int *info);
+void dpotrf_(const char *uplo, const int *n, double *a, const int *lda, int *info);
+void dpotri_(const char *uplo, const int *n, double *a, const int *lda, int *info);
+void dsyevd_(const char *jobz, const char *uplo, const int *n, double *a, const int *lda, double *w, double *work,
+             const int *lwork, int *iwork, const int *liwork, int *info);
+}
+
+namespace TMatrixTLapack {
+
+enum { kMinSize = 32 }; // smallest dimension of the matrices given to LAPACK
+
+////////////////////////////////////////////////////////////////////////////////
+/// Whether the product of a (m x k) and a (k x n) matrix is done by BLAS.
+
+inline Bool_t UseGemm(Int_t m, Int_t n, Int_t k)
+{
+   return Double_t(m) * n * k >= Double_t(kMinSize) * kMinSize * kMinSize;
+}
+
+inline void Gemm(char transa, char transb, int m, int n, int k, const Double_t *a, int lda, const Double_t *b, int ldb,
+                 Double_t *c, int ldc)
+{
+   const Double_t alpha = 1.0, beta = 0.0;
+   dgemm_(&transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc);
+}
+
+inline void Gemm(char transa, char transb, int m, int n, int k, const Float_t *a, int lda, const Float_t *b, int ldb,
+                 Float_t *c, int ldc)
+{
+   const Float_t alpha = 1.0, beta = 0.0;
+   sgemm_(&transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// C = A*B, with A (m x k), B (k x n) and C (m x n) stored by rows.
+
+template <class Element>
+void AMultB(const Element *ap, Int_t m, Int_t k, const Element *bp, Int_t n, Element *cp)
+{
+   Gemm('N', 'N', n, m, k, bp, n, ap, k, cp, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// C = A^T*B, with A (k x m), B (k x n) and C (m x n) stored by rows.
+
+template <class Element>
+void AtMultB(const Element *ap, Int_t m, Int_t k, const Element *bp, Int_t n, Element *cp)
+{
+   Gemm('N', 'T', n, m, k, bp, n, ap, m, cp, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// C = A*B^T, with A (m x k), B (n x k) and C (m x n) stored by rows.
+
+template <class Element>
+void AMultBt(const Element *ap, Int_t m, Int_t k, const Element *bp, Int_t n, Element *cp)
+{
+   Gemm('T', 'N', n, m, k, bp, k, ap, k, cp, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// LU decomposition P A = L U with partial pivoting of the n x n matrix A,
+/// stored by columns in lu and replaced by L (unit diagonal not stored) and U.
+/// ipiv[j] (from 0) is the row swapped with the row j at the step j.
+/// With implicit, the pivot is chosen as in the Crout algorithm of TDecompLU,
+/// relative to the largest element of its row: the decomposition is done on
+/// the matrix with normalized rows, and its factors scaled back.
+/// Return 0 on success, j+1 if the pivot j is zero, -1 if a row is zero.
+
+inline Int_t FactorLU(Double_t *lu, Int_t n, Int_t *ipiv, Bool_t implicit)
+{
+   std::vector<Double_t> scale;
+   if (implicit) {
+      scale.assign(n, 0.0);
+      for (Int_t j = 0; j < n; j++)
+         for (Int_t i = 0; i < n; i++)
+            scale[i] = TMath::Max(scale[i], TMath::Abs(lu[j * n + i]));
+      for (Int_t i = 0; i < n; i++) {
+         if (scale[i] == 0.0)
+            return -1;
+         scale[i] = 1.0 / scale[i];
+      }
+      for (Int_t j = 0; j < n; j++)
+         for (Int_t i = 0; i < n; i++)
+            lu[j * n + i] *= scale[i];
+   }
+
+   int info = 0;
+   dgetrf_(&n, &n, lu, &n, ipiv, &info);
+   for (Int_t j = 0; j < n; j++)
+      ipiv[j]--;
+
+   if (implicit) {
+      // P D A = L U gives P A = (D'^-1 L D') (D'^-1 U) with D' = P D P^T
+      for (Int_t j = 0; j < n; j++)
+         std::swap(scale[j], scale[ipiv[j]]);
+      for (Int_t j = 0; j < n; j++)
+         for (Int_t i = 0; i < n; i++)
+            lu[j * n + i] *= (i > j ? scale[j] / scale[i] : 1.0 / scale[i]);
+   }
+   return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// LU decomposition of the n x n matrix stored by rows in pLU, in the format of
+/// TDecompLU::DecomposeLUGauss (implicit = kFALSE) or DecomposeLUCrout (kTRUE).
+/// Return kFALSE if the matrix is singular.
+
+inline Bool_t DecomposeLU(Double_t *pLU, Int_t n, Int_t *index, Double_t &sign, Double_t tol, Int_t &nrZeros,
+                          Bool_t implicit)
+{
+   std::vector<Double_t> lu(Long64_t(n) * n);
+   for (Int_t i = 0; i < n; i++)
+      for (Int_t j = 0; j < n; j++)
+         lu[j * n + i] = pLU[i * n + j];
+
+   const Int_t info = FactorLU(lu.data(), n, index, implicit);
+   // DecomposeLUGauss does not test the last pivot
+   if (info < 0 || (info > 0 && (implicit || info < n)))
+      return kFALSE;
+
+   sign = 1.0;
+   nrZeros = 0;
+   for (Int_t j = 0; j < n; j++) {
+      if (index[j] != j)
+         sign = -sign;
+      const Double_t ujj = lu[j * n + j];
+      if (ujj != 0.0 && TMath::Abs(ujj) < tol)
+         nrZeros++;
+   }
+
+   for (Int_t i = 0; i < n; i++)
+      for (Int_t j = 0; j < n; j++)
+         pLU[i * n + j] = lu[j * n + i];
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Inverse of the LU decomposition lu (stored by columns, as given by FactorLU).
+
+inline Bool_t InvertLU(Double_t *lu, Int_t n, const Int_t *ipiv)
+{
+   std::vector<int> piv(ipiv, ipiv + n);
+   for (Int_t j = 0; j < n; j++)
+      piv[j]++;
+   int info = 0;
+   int lwork = -1;
+   Double_t wsize = 0;
+   dgetri_(&n, lu, &n, piv.data(), &wsize, &lwork, &info);
+   lwork = TMath::Max(Int_t(wsize), n);
+   std::vector<Double_t> work(lwork);
+   dgetri_(&n, lu, &n, piv.data(), work.data(), &lwork, &info);
+   return info == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cholesky decomposition A = U^T U of the symmetric n x n matrix stored by rows
+/// in pU, replaced by U (the lower triangle is set to zero).
+/// Return kFALSE if the matrix is not positive definite.
+
+inline Bool_t DecomposeChol(Double_t *pU, Int_t n)
+{
+   // the lower triangle of the matrix by columns is the upper one by rows
+   const char uplo = 'L';
+   int info = 0;
+   dpotrf_(&uplo, &n, pU, &n, &info);
+   if (info != 0)
+      return kFALSE;
+   for (Int_t i = 0; i < n; i++)
+      for (Int_t j = 0; j < i; j++)
+         pU[i * n + j] = 0.0;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Inverse of the symmetric matrix whose Cholesky factor U (stored by rows)
+/// is in pInv, replaced by the full inverse.
+
+inline Bool_t InvertChol(Double_t *pInv, Int_t n)
+{
+   const char uplo = 'L';
+   int info = 0;
+   dpotri_(&uplo, &n, pInv, &n, &info);
+   if (info != 0)
+      return kFALSE;
+   for (Int_t i = 0; i < n; i++)
+      for (Int_t j = 0; j < i; j++)
+         pInv[i * n + j] = pInv[j * n + i];
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Eigenvalues and eigenvectors of the symmetric n x n matrix pV, replaced by
+/// the eigenvectors (in columns) as in TMatrixDSymEigen: the eigenvalues pD
+/// are sorted in decreasing order.
+
+inline Bool_t SymEigen(Double_t *pV, Double_t *pD, Int_t n)
+{
+   std::vector<Double_t> z(pV, pV + Long64_t(n) * n);
+   std::vector<Double_t> w(n);
+   const char jobz = 'V', uplo = 'L';
+   int info = 0;
+   int lwork = -1, liwork = -1;
+   Double_t wsize = 0;
+   int iwsize = 0;
+   dsyevd_(&jobz, &uplo, &n, z.data(), &n, w.data(), &wsize, &lwork, &iwsize, &liwork, &info);
+   lwork = Int_t(wsize);
+   liwork = iwsize;
+   std::vector<Double_t> work(lwork);
+   std::vector<int> iwork(liwork);
+   dsyevd_(&jobz, &uplo, &n, z.data(), &n, w.data(), work.data(), &lwork, iwork.data(), &liwork, &info);
+   if (info != 0)
+      return kFALSE;
+
+   // LAPACK sorts the eigenvalues in increasing order, with the eigenvectors in columns
+   for (Int_t k = 0; k < n; k++) {
+      pD[n - 1 - k] = w[k];
+      for (Int_t i = 0; i < n; i++)
+         pV[i * n + n - 1 - k] = z[k * n + i];
+   }
+   return kTRUE;
+}
+
+} // namespace TMatrixTLapack
+
+#endif
@@ -40,6 +40,7 @@
 #pragma link C++ class ROOT::Minuit2::MnUserParameterState;
 #pragma link C++ class ROOT::Minuit2::MnUserParameters;
 #pragma link C++ class ROOT::Minuit2::MnStrategy;
+#pragma link C++ enum ROOT::Minuit2::MnExecutionPolicy;
 #pragma link C++ class ROOT::Minuit2::FunctionMinimizer;
 #pragma link C++ class ROOT::Minuit2::ModularFunctionMinimizer;
 #pragma link C++ class ROOT::Minuit2::VariableMetricMinimizer;
@@ -16,6 +16,7 @@
 #include "Math/Minimizer.h"
 
 #include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnExecutionPolicy.h"
 
 #include "Math/IFunctionfwd.h"
 
@@ -303,6 +304,9 @@ protected:
    /// examine the minimum result
    bool ExamineMinimum(const ROOT::Minuit2::FunctionMinimum & min);
 
+   /// execution policy given by the "ExecutionPolicy" option of Minuit2
+   ROOT::Minuit2::MnExecutionPolicy ExecutionPolicy() const;
+
 private:
 
    unsigned int fDim;       // dimension of the function to be minimized
@@ -0,0 +1,33 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2018 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_MnExecutionPolicy
+#define ROOT_Minuit2_MnExecutionPolicy
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+/**
+   How Minuit2 runs its independent function evaluations: the numerical
+   derivatives of the parameters (gradient and Hessian), the points of MnScan,
+   the Minos errors of several parameters.
+   kMultithread uses the ROOT thread pool (TThreadExecutor), when the implicit
+   multithreading is enabled, and requires a thread safe FCN.
+   kMultiprocess uses forked worker processes (TProcessExecutor) for the
+   derivatives and the scans, and runs the Minos errors serially.
+   Without ROOT, or without the corresponding ROOT library, all policies are serial.
+ */
+
+enum class MnExecutionPolicy { kSerial, kMultithread, kMultiprocess };
+
+  }  // namespace Minuit2
+
+}  // namespace ROOT
+
+#endif  // ROOT_Minuit2_MnExecutionPolicy
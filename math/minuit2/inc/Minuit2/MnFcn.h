@@ -13,6 +13,7 @@
 #include "Minuit2/MnConfig.h"
 #include "Minuit2/MnMatrix.h"
 
+#include <atomic>
 #include <vector>
 
 namespace ROOT {
@@ -37,10 +38,14 @@ public:
    /// constructor of
    explicit MnFcn(const FCNBase& fcn, int ncall = 0) : fFCN(fcn), fNumCall(ncall) {}
 
+   MnFcn(const MnFcn& fcn) : fFCN(fcn.fFCN), fNumCall(fcn.fNumCall.load()) {}
+
   virtual ~MnFcn();
 
   virtual double operator()(const MnAlgebraicVector&) const;
   unsigned int NumOfCalls() const {return fNumCall;}
+  /// count ncall calls done by copies of this object in other processes
+  void AddNumOfCalls(int ncall) const {fNumCall += ncall;}
 
   //
   //forward interface
@@ -56,7 +61,8 @@ private:
 
 protected:
 
-  mutable int fNumCall;
+  // atomic, since the derivatives may be computed by several threads at once
+  mutable std::atomic<int> fNumCall;
 };
 
   }  // namespace Minuit2
@@ -12,6 +12,7 @@
 
 #include "Minuit2/MnConfig.h"
 #include "Minuit2/MnUserParameters.h"
+#include "Minuit2/MnExecutionPolicy.h"
 
 #include <vector>
 #include <utility>
@@ -43,11 +44,15 @@ public:
   const MnUserParameters& Parameters() const {return fParameters;}
   double Fval() const {return fAmin;}
 
+  // evaluate the points of a scan on threads or processes (see MnExecutionPolicy)
+  void SetExecutionPolicy(MnExecutionPolicy policy) {fExecutionPolicy = policy;}
+
 private:
 
   const FCNBase& fFCN;
   MnUserParameters fParameters;
   double fAmin;
+  MnExecutionPolicy fExecutionPolicy;
 };
 
   }  // namespace Minuit2
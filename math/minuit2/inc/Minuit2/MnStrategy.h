@@ -10,6 +10,8 @@
 #ifndef ROOT_Minuit2_MnStrategy
 #define ROOT_Minuit2_MnStrategy
 
+#include "Minuit2/MnExecutionPolicy.h"
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -49,6 +51,8 @@ public:
 
    int StorageLevel() const { return fStoreLevel; }
 
+   MnExecutionPolicy ExecutionPolicy() const { return fExecutionPolicy; }
+
    bool IsLow() const {return fStrategy == 0;}
    bool IsMedium() const {return fStrategy == 1;}
    bool IsHigh() const {return fStrategy >= 2;}
@@ -69,6 +73,11 @@ public:
    // set storage level of iteration quantities
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
+
+   // run the independent function evaluations (derivatives of the different parameters, scan points,
+   // Minos errors of several parameters) on threads or processes, see MnExecutionPolicy.
+   // The results do not depend on the policy.
+   void SetExecutionPolicy(MnExecutionPolicy policy) { fExecutionPolicy = policy; }
 private:
 
    unsigned int fStrategy;
@@ -81,6 +90,7 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel;
+   MnExecutionPolicy fExecutionPolicy;
 };
 
   }  // namespace Minuit2
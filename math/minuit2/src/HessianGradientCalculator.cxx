@@ -25,6 +25,7 @@
 #endif
 
 #include "Minuit2/MPIProcess.h"
+#include "MnExecutor.h"
 
 namespace ROOT {
 
@@ -70,7 +71,6 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
    // calculate gradient for Hessian
    assert(par.IsValid());
 
-   MnAlgebraicVector x = par.Vec();
    MnAlgebraicVector grd = Gradient.Grad();
    const MnAlgebraicVector& g2 = Gradient.G2();
    //const MnAlgebraicVector& gstep = Gradient.Gstep();
@@ -82,7 +82,7 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
 
    double dfmin = 4.*Precision().Eps2()*(fabs(fcnmin)+Fcn().Up());
 
-   unsigned int n = x.size();
+   unsigned int n = par.Vec().size();
    MnAlgebraicVector dgrd(n);
 
    MPIProcess mpiproc(n,0);
@@ -90,7 +90,10 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
    unsigned int startElementIndex = mpiproc.StartElementIndex();
    unsigned int endElementIndex = mpiproc.EndElementIndex();
 
-   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
+   // each parameter uses its own copy of x, so that the parameters can be done in parallel;
+   // return (grd, gstep, dgrd) of i
+   auto computeDerivative = [&](unsigned int i) {
+      MnAlgebraicVector x = par.Vec();
       double xtf = x(i);
       double dmin = 4.*Precision().Eps2()*(xtf + Precision().Eps2());
       double epspri = Precision().Eps2() + fabs(grd(i)*Precision().Eps2());
@@ -134,7 +137,15 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
 #ifdef DEBUG
       std::cout << "HGC Param : " << i << "\t new g1 = " << grd(i) << " gstep = " << d << " dgrd = " << dgrd(i) << std::endl;
 #endif
-
+      return std::vector<double>{grd(i), gstep(i), dgrd(i)};
+   };
+
+   std::vector<std::vector<double> > derivatives =
+      MnExecutorMap(Strategy().ExecutionPolicy(), startElementIndex, endElementIndex, computeDerivative, &Fcn());
+   for (unsigned int k = 0; k < derivatives.size(); ++k) {
+      grd(startElementIndex + k) = derivatives[k][0];
+      gstep(startElementIndex + k) = derivatives[k][1];
+      dgrd(startElementIndex + k) = derivatives[k][2];
    }
 
    mpiproc.SyncVector(grd);
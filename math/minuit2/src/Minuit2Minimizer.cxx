@@ -475,6 +475,8 @@ bool Minuit2Minimizer::Minimize() {
 
    }
 
+   strategy.SetExecutionPolicy(ExecutionPolicy());
+
    // set a minimizer tracer object (default for printlevel=10, from gROOT for printLevel=11)
    // use some special print levels
    MnTraceObject * traceObj = 0;
@@ -811,7 +813,9 @@ bool Minuit2Minimizer::GetMinosError(unsigned int i, double & errLow, double & e
    if (Precision() > 0) fState.SetPrecision(Precision());
 
 
-   ROOT::Minuit2::MnMinos minos( *fMinuitFCN, *fMinimum);
+   ROOT::Minuit2::MnStrategy minosStrategy(1);
+   minosStrategy.SetExecutionPolicy(ExecutionPolicy());
+   ROOT::Minuit2::MnMinos minos( *fMinuitFCN, *fMinimum, minosStrategy);
 
    // run MnCross
    MnCross low;
@@ -937,6 +941,7 @@ bool Minuit2Minimizer::Scan(unsigned int ipar, unsigned int & nstep, double * x,
    if (Precision() > 0) fState.SetPrecision(Precision());
 
    MnParameterScan scan( *fMinuitFCN, fState.Parameters() );
+   scan.SetExecutionPolicy(ExecutionPolicy());
    double amin = scan.Fval(); // fcn value of the function before scan
 
    // first value is param value
@@ -1002,7 +1007,9 @@ bool Minuit2Minimizer::Contour(unsigned int ipar, unsigned int jpar, unsigned in
    if (Precision() > 0) fState.SetPrecision(Precision());
 
    // eventually one should specify tolerance in contours
-   MnContours contour(*fMinuitFCN, *fMinimum, Strategy() );
+   ROOT::Minuit2::MnStrategy contourStrategy(Strategy());
+   contourStrategy.SetExecutionPolicy(ExecutionPolicy());
+   MnContours contour(*fMinuitFCN, *fMinimum, contourStrategy );
 
    if (prev_level > -2) RestoreGlobalPrintLevel(prev_level);
 
@@ -1048,7 +1055,10 @@ bool Minuit2Minimizer::Hesse( ) {
    // set the precision if needed
    if (Precision() > 0) fState.SetPrecision(Precision());
 
-   ROOT::Minuit2::MnHesse hesse( strategy );
+   ROOT::Minuit2::MnStrategy hesseStrategy(strategy);
+   hesseStrategy.SetExecutionPolicy(ExecutionPolicy());
+
+   ROOT::Minuit2::MnHesse hesse( hesseStrategy );
 
 
    // case when function minimum exists
@@ -1139,6 +1149,21 @@ void Minuit2Minimizer::SetTraceObject(MnTraceObject & obj) {
    fMinimizer->Builder().SetTraceObject(obj);
 }
 
+ROOT::Minuit2::MnExecutionPolicy Minuit2Minimizer::ExecutionPolicy() const {
+   // execution policy from the "ExecutionPolicy" option of Minuit2:
+   // "Serial" (default), "Multithread" or "Multiprocess"
+   ROOT::Math::IOptions * minuit2Opt = ROOT::Math::MinimizerOptions::FindDefault("Minuit2");
+   std::string policy;
+   if (!minuit2Opt || !minuit2Opt->GetValue("ExecutionPolicy",policy) || policy == "Serial")
+      return ROOT::Minuit2::MnExecutionPolicy::kSerial;
+   if (policy == "Multithread")
+      return ROOT::Minuit2::MnExecutionPolicy::kMultithread;
+   if (policy == "Multiprocess")
+      return ROOT::Minuit2::MnExecutionPolicy::kMultiprocess;
+   MN_ERROR_MSG2("Minuit2Minimizer::ExecutionPolicy","invalid ExecutionPolicy option - use Serial");
+   return ROOT::Minuit2::MnExecutionPolicy::kSerial;
+}
+
 void Minuit2Minimizer::SetStorageLevel(int level) {
    // set storage level
    if (!fMinimizer) return;
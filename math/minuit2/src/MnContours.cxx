@@ -57,7 +57,12 @@ ContoursError MnContours::Contour(unsigned int px, unsigned int py, unsigned int
    double valx = fMinimum.UserState().Value(px);
    double valy = fMinimum.UserState().Value(py);
 
-   MinosError mex = minos.Minos(px);
+   // the Minos errors of the two parameters are independent
+   std::vector<unsigned int> pxy(1, px);
+   pxy.push_back(py);
+   std::vector<MinosError> mexy = minos.Minos(pxy);
+
+   MinosError mex = mexy[0];
    nfcn += mex.NFcn();
    if(!mex.IsValid()) {
       MN_ERROR_MSG("MnContours is unable to find first two points.");
@@ -65,7 +70,7 @@ ContoursError MnContours::Contour(unsigned int px, unsigned int py, unsigned int
    }
    std::pair<double,double> ex = mex();
 
-   MinosError mey = minos.Minos(py);
+   MinosError mey = mexy[1];
    nfcn += mey.NFcn();
    if(!mey.IsValid()) {
       MN_ERROR_MSG("MnContours is unable to find second two points.");
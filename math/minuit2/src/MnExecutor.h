@@ -0,0 +1,114 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2018 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_MnExecutor
+#define ROOT_Minuit2_MnExecutor
+
+#include "Minuit2/MnExecutionPolicy.h"
+#include "Minuit2/MnFcn.h"
+
+#include <vector>
+
+// inside ROOT, R__USE_IMT tells whether the ROOT thread pool is available
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
+#endif
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#ifdef MINUIT2_MULTIPROC
+#include "ROOT/TProcessExecutor.hxx"
+#endif
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+/**
+   Return func(i) for i in [begin, end) in this order, each result being a
+   std::vector<double>, evaluated according to policy (see MnExecutionPolicy).
+   With kMultiprocess the results are sent back by the worker processes, which
+   do not share the memory of the caller: func must communicate only through
+   its result. The calls of fcn made by the workers are added to the calls of fcn.
+   The results do not depend on the policy nor on the number of workers.
+ */
+template <class Func>
+std::vector<std::vector<double> > MnExecutorMap(MnExecutionPolicy policy, unsigned int begin, unsigned int end, const Func &func,
+                                                const MnFcn *fcn = 0)
+{
+   std::vector<std::vector<double> > results(end > begin ? end - begin : 0);
+   if (results.size() > 1) {
+#ifdef R__USE_IMT
+      if (policy == MnExecutionPolicy::kMultithread && ROOT::IsImplicitMTEnabled()) {
+         ROOT::TThreadExecutor pool;
+         pool.Foreach([&](unsigned int k) { results[k] = func(begin + k); }, ROOT::TSeq<unsigned int>(0, results.size()));
+         return results;
+      }
+#endif
+#ifdef MINUIT2_MULTIPROC
+      if (policy == MnExecutionPolicy::kMultiprocess) {
+         // the workers return their results in any order: append the index to find it back,
+         // and the number of calls of fcn
+         ROOT::TProcessExecutor pool;
+         auto indexed = pool.Map([&](unsigned int k) {
+            const int ncall = fcn ? fcn->NumOfCalls() : 0;
+            std::vector<double> result = func(begin + k);
+            result.push_back(fcn ? fcn->NumOfCalls() - ncall : 0);
+            result.push_back(k);
+            return result;
+         }, ROOT::TSeq<unsigned int>(0, results.size()));
+         std::vector<bool> done(results.size());
+         for (auto &result : indexed) {
+            unsigned int k = result.back();
+            result.pop_back();
+            if (fcn) fcn->AddNumOfCalls(int(result.back()));
+            result.pop_back();
+            results[k].swap(result);
+            done[k] = true;
+         }
+         // compute here what a failing worker did not return
+         for (unsigned int k = 0; k < results.size(); ++k)
+            if (!done[k]) results[k] = func(begin + k);
+         return results;
+      }
+#endif
+   }
+   (void)policy;
+   for (unsigned int k = 0; k < results.size(); ++k)
+      results[k] = func(begin + k);
+   return results;
+}
+
+/**
+   Call func(i) for i in [begin, end), on the ROOT thread pool if the policy is
+   kMultithread and the implicit multithreading is enabled, else serially: func
+   may then store its results in the memory of the caller.
+ */
+template <class Func>
+void MnExecutorForeach(MnExecutionPolicy policy, unsigned int begin, unsigned int end, const Func &func)
+{
+#ifdef R__USE_IMT
+   if (policy == MnExecutionPolicy::kMultithread && end > begin + 1 && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned int k) { func(begin + k); }, ROOT::TSeq<unsigned int>(0, end - begin));
+      return;
+   }
+#endif
+   (void)policy;
+   for (unsigned int i = begin; i < end; ++i)
+      func(i);
+}
+
+  }  // namespace Minuit2
+
+}  // namespace ROOT
+
+#endif  // ROOT_Minuit2_MnExecutor
@@ -29,6 +29,7 @@
 #endif
 
 #include "Minuit2/MPIProcess.h"
+#include "MnExecutor.h"
 
 namespace ROOT {
 
@@ -249,31 +250,63 @@ L30:
    unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
    unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
 
-   unsigned int offsetVect = 0;
-   for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
-      if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
+   if (fStrategy.ExecutionPolicy() != MnExecutionPolicy::kSerial) {
+      // compute each element from its own copy of the parameters, so that the elements
+      // can be done in parallel; the element in is (i,j), j > i, numbered by rows
+      auto rowCol = [n](unsigned int in, unsigned int &i, unsigned int &j) {
+         i = 0;
+         unsigned int rowStart = 0;
+         while (in >= rowStart + n - 1 - i) {
+            rowStart += n - 1 - i;
+            ++i;
+         }
+         j = i + 1 + in - rowStart;
+      };
+      auto computeElement = [&](unsigned int in) {
+         unsigned int i, j;
+         rowCol(in, i, j);
+
+         MnAlgebraicVector xij = x;
+         xij(i) += dirin(i);
+         xij(j) += dirin(j);
+
+         double fs1 = mfcn(xij);
+         return std::vector<double>(1, (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j)));
+      };
+      std::vector<std::vector<double> > elements =
+         MnExecutorMap(fStrategy.ExecutionPolicy(), startParIndexOffDiagonal, endParIndexOffDiagonal, computeElement, &mfcn);
+      for (unsigned int k = 0; k < elements.size(); ++k) {
+         unsigned int i, j;
+         rowCol(startParIndexOffDiagonal + k, i, j);
+         vhmat(i,j) = elements[k][0];
+      }
+   } else {
+      unsigned int offsetVect = 0;
+      for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
+         if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
 
-   for (unsigned int in = startParIndexOffDiagonal;
-        in<endParIndexOffDiagonal; in++) {
+      for (unsigned int in = startParIndexOffDiagonal;
+           in<endParIndexOffDiagonal; in++) {
 
-      int i = (in+offsetVect)/(n-1);
-      if ((in+offsetVect)%(n-1)==0) offsetVect += i;
-      int j = (in+offsetVect)%(n-1)+1;
+         int i = (in+offsetVect)/(n-1);
+         if ((in+offsetVect)%(n-1)==0) offsetVect += i;
+         int j = (in+offsetVect)%(n-1)+1;
 
-      if ((i+1)==j || in==startParIndexOffDiagonal)
-         x(i) += dirin(i);
+         if ((i+1)==j || in==startParIndexOffDiagonal)
+            x(i) += dirin(i);
 
-      x(j) += dirin(j);
+         x(j) += dirin(j);
 
-      double fs1 = mfcn(x);
-      double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
-      vhmat(i,j) = elem;
+         double fs1 = mfcn(x);
+         double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+         vhmat(i,j) = elem;
 
-      x(j) -= dirin(j);
+         x(j) -= dirin(j);
 
-      if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
-         x(i) -= dirin(i);
+         if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
+            x(i) -= dirin(i);
 
+      }
    }
 
    mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
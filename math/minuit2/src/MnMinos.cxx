@@ -13,6 +13,7 @@
 #include "Minuit2/MnFunctionCross.h"
 #include "Minuit2/MnCross.h"
 #include "Minuit2/MinosError.h"
+#include "MnExecutor.h"
 
 //#define DEBUG
 
@@ -105,6 +106,31 @@ MinosError MnMinos::Minos(unsigned int par, unsigned int maxcalls, double toler)
    return MinosError(par, fMinimum.UserState().Value(par), lo, up);
 }
 
+std::vector<MinosError> MnMinos::Minos(const std::vector<unsigned int>& pars, unsigned int maxcalls, double toler) const {
+   // do full minos error analysis for the parameters pars; the upper and lower crossings of all
+   // parameters are independent, and are found concurrently with the Multithread policy.
+   // The MinosError objects cannot be sent back by other processes: with the Multiprocess policy
+   // the crossings are found one after the other (the derivatives use the processes).
+   assert(fMinimum.IsValid());
+
+   unsigned int n = pars.size();
+   std::vector<MnCross> up(n);
+   std::vector<MnCross> lo(n);
+   MnExecutorForeach(fStrategy.ExecutionPolicy(), 0, 2*n, [&](unsigned int k) {
+      // upper before lower, as in Minos(par)
+      if (k % 2 == 0)
+         up[k/2] = Upval(pars[k/2], maxcalls, toler);
+      else
+         lo[k/2] = Loval(pars[k/2], maxcalls, toler);
+   });
+
+   std::vector<MinosError> result;
+   result.reserve(n);
+   for (unsigned int i = 0; i < n; i++)
+      result.push_back(MinosError(pars[i], fMinimum.UserState().Value(pars[i]), lo[i], up[i]));
+   return result;
+}
+
 
 MnCross MnMinos::FindCrossValue(int direction, unsigned int par, unsigned int maxcalls, double toler) const {
    // get crossing value in the parameter direction :
@@ -9,15 +9,16 @@
 
 #include "Minuit2/MnParameterScan.h"
 #include "Minuit2/FCNBase.h"
+#include "MnExecutor.h"
 
 namespace ROOT {
 
    namespace Minuit2 {
 
 
-MnParameterScan::MnParameterScan(const FCNBase& fcn, const MnUserParameters& par) : fFCN(fcn), fParameters(par), fAmin(fcn(par.Params())) {}
+MnParameterScan::MnParameterScan(const FCNBase& fcn, const MnUserParameters& par) : fFCN(fcn), fParameters(par), fAmin(fcn(par.Params())), fExecutionPolicy(MnExecutionPolicy::kSerial) {}
 
-MnParameterScan::MnParameterScan(const FCNBase& fcn, const MnUserParameters& par, double fval) : fFCN(fcn), fParameters(par), fAmin(fval) {}
+MnParameterScan::MnParameterScan(const FCNBase& fcn, const MnUserParameters& par, double fval) : fFCN(fcn), fParameters(par), fAmin(fval), fExecutionPolicy(MnExecutionPolicy::kSerial) {}
 
 std::vector<std::pair<double, double> > MnParameterScan::operator()(unsigned int par, unsigned int maxsteps, double low, double high) {
    // do the scan for parameter par between low and high values
@@ -51,9 +52,16 @@ std::vector<std::pair<double, double> > MnParameterScan::operator()(unsigned int
 
    double x0 = low;
    double stp = (high - low)/double(maxsteps - 1);
+   // the points do not depend on each other: evaluate them according to the execution policy,
+   // then retain the best one in order
+   std::vector<std::vector<double> > fvals = MnExecutorMap(fExecutionPolicy, 0, maxsteps, [&](unsigned int i) {
+      std::vector<double> xpar = params;
+      xpar[par] = x0 + double(i)*stp;
+      return std::vector<double>(1, fFCN(xpar));
+   });
    for(unsigned int i = 0; i < maxsteps; i++) {
       params[par] = x0 + double(i)*stp;
-      double fval = fFCN(params);
+      double fval = fvals[i][0];
       if(fval < fAmin) {
          fParameters.SetValue(par, params[par]);
          fAmin = fval;
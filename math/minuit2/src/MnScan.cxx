@@ -18,6 +18,7 @@ namespace ROOT {
 std::vector<std::pair<double, double> > MnScan::Scan(unsigned int par, unsigned int maxsteps, double low, double high) {
    // perform a scan of the function in the parameter par
    MnParameterScan scan(fFCN, fState.Parameters());
+   scan.SetExecutionPolicy(Strategy().ExecutionPolicy());
    double amin = scan.Fval();
 
    std::vector<std::pair<double, double> > result = scan(par, maxsteps, low, high);
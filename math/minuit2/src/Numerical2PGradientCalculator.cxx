@@ -15,6 +15,7 @@
 #include "Minuit2/MinimumParameters.h"
 #include "Minuit2/FunctionGradient.h"
 #include "Minuit2/MnStrategy.h"
+#include "MnExecutor.h"
 
 
 //#define DEBUG
@@ -100,10 +101,6 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    MnAlgebraicVector g2 = Gradient.G2();
    MnAlgebraicVector gstep = Gradient.Gstep();
 
-#ifndef _OPENMP
-   MPIProcess mpiproc(n,0);
-#endif
-
 #ifdef DEBUG
    std::cout << "Calculating Gradient at x =   " << par.Vec() << std::endl;
    int pr = std::cout.precision(13);
@@ -111,36 +108,17 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    std::cout.precision(pr);
 #endif
 
-#ifndef _OPENMP
-   // for serial execution this can be outside the loop
-   MnAlgebraicVector x = par.Vec();
-
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
-
-#else
-
- // parallelize this loop using OpenMP
-//#define N_PARALLEL_PAR 5
-#pragma omp parallel
-#pragma omp for
-//#pragma omp for schedule (static, N_PARALLEL_PAR)
-
-   for(int i = 0; i < int(n); i++) {
-
-#endif
+   // compute the derivative along the parameter i, with its own copy of the parameters, and return
+   // (grd, g2, gstep) of i: the derivatives do not depend on each other, nor on the order in which
+   // they are computed
+   auto computeDerivative = [&](unsigned int i) {
 
 #ifdef DEBUG_MP
       int ith = omp_get_thread_num();
       //std::cout << "Thread number " << ith << "  " << i << std::endl;
 #endif
 
-#ifdef _OPENMP
-       // create in loop since each thread will use its own copy
       MnAlgebraicVector x = par.Vec();
-#endif
 
       double xtf = x(i);
       double epspri = eps2 + fabs(grd(i)*eps2);
@@ -217,8 +195,35 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
       std::cout << "Parameter " << Trafo().Name(iext) << " Gradient =   " << grd(i) << " g2 = " << g2(i) << " step " << gstep(i) << std::endl;
       std::cout.precision(pr);
 #endif
+      return std::vector<double>{grd(i), g2(i), gstep(i)};
+   };
+
+#ifndef _OPENMP
+   MPIProcess mpiproc(n,0);
+
+   // the parameters of this process are split on the threads or the processes of the execution policy
+   unsigned int startElementIndex = mpiproc.StartElementIndex();
+   std::vector<std::vector<double> > derivatives =
+      MnExecutorMap(Strategy().ExecutionPolicy(), startElementIndex, mpiproc.EndElementIndex(), computeDerivative, &Fcn());
+   for (unsigned int k = 0; k < derivatives.size(); ++k) {
+      grd(startElementIndex + k) = derivatives[k][0];
+      g2(startElementIndex + k) = derivatives[k][1];
+      gstep(startElementIndex + k) = derivatives[k][2];
    }
 
+#else
+
+ // parallelize this loop using OpenMP
+//#define N_PARALLEL_PAR 5
+#pragma omp parallel
+#pragma omp for
+//#pragma omp for schedule (static, N_PARALLEL_PAR)
+
+   for(int i = 0; i < int(n); i++)
+      computeDerivative(i);
+
+#endif
+
 #ifndef _OPENMP
    mpiproc.SyncVector(grd);
    mpiproc.SyncVector(g2);
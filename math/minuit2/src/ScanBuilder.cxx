@@ -13,18 +13,20 @@
 #include "Minuit2/MinimumSeed.h"
 #include "Minuit2/MinimumState.h"
 #include "Minuit2/MnFcn.h"
+#include "Minuit2/MnStrategy.h"
 
 namespace ROOT {
 
    namespace Minuit2 {
 
 
-FunctionMinimum ScanBuilder::Minimum(const MnFcn& mfcn, const GradientCalculator&, const MinimumSeed& seed, const MnStrategy&, unsigned int, double) const {
+FunctionMinimum ScanBuilder::Minimum(const MnFcn& mfcn, const GradientCalculator&, const MinimumSeed& seed, const MnStrategy& strategy, unsigned int, double) const {
    // find the function minimum performing a parameter scan (using MnParameterScan class)
    // function gradient is not used
    MnAlgebraicVector x = seed.Parameters().Vec();
    MnUserParameterState upst(seed.State(), mfcn.Up(), seed.Trafo());
    MnParameterScan scan(mfcn.Fcn(), upst.Parameters(), seed.Fval());
+   scan.SetExecutionPolicy(strategy.ExecutionPolicy());
    double amin = scan.Fval();
    unsigned int n = seed.Trafo().VariableParameters();
    MnAlgebraicVector dirin(n);
@@ -12,6 +12,8 @@
 
 #include "TLorentzVector.h"
 
+class TRandom;
+
 class TGenPhaseSpace : public TObject {
 private:
    Int_t        fNt;             // number of decay particles
@@ -21,7 +23,7 @@ private:
    Double_t     fWtMax;          // maximum weigth
    TLorentzVector  fDecPro[18];  //kinematics of the generated particles
 
-   Double_t PDK(Double_t a, Double_t b, Double_t c);
+   Double_t PDK(Double_t a, Double_t b, Double_t c) const;
 
 public:
    TGenPhaseSpace(): fNt(0), fMass(), fBeta(), fTeCmTm(0.), fWtMax(0.) {}
@@ -31,6 +33,9 @@ public:
 
    Bool_t          SetDecay(TLorentzVector &P, Int_t nt, const Double_t *mass, Option_t *opt="");
    Double_t        Generate();
+   Double_t        Generate(TRandom &rnd, TLorentzVector *decay) const;
+   void            Generate(TRandom &rnd, Int_t n, Double_t *wt, Double_t *px, Double_t *py, Double_t *pz,
+                            Double_t *e) const;
    TLorentzVector *GetDecay(Int_t n);
 
    Int_t    GetNt()      const { return fNt;}
@@ -24,6 +24,8 @@ Note that Momentum, Energy units are Gev/C, GeV
 #include "TRandom.h"
 #include "TMath.h"
 
+#include <algorithm>
+
 const Int_t kMAXP = 18;
 
 ClassImp(TGenPhaseSpace);
@@ -31,7 +33,7 @@ ClassImp(TGenPhaseSpace);
 ////////////////////////////////////////////////////////////////////////////////
 /// The PDK function.
 
-Double_t TGenPhaseSpace::PDK(Double_t a, Double_t b, Double_t c)
+Double_t TGenPhaseSpace::PDK(Double_t a, Double_t b, Double_t c) const
 {
    Double_t x = (a-b-c)*(a+b+c)*(a-b+c)*(a+b-c);
    x = TMath::Sqrt(x)/(2*a);
@@ -96,12 +98,32 @@ TGenPhaseSpace& TGenPhaseSpace::operator=(const TGenPhaseSpace &gen)
 /// Note that Momentum, Energy units are Gev/C, GeV
 
 Double_t TGenPhaseSpace::Generate()
+{
+   return Generate(*gRandom, fDecPro);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///  Generate a random final state with the random number generator rnd.
+///  The function returns the weight of the event and stores the decay
+///  products in decay[0..GetNt()-1]. It draws the same random numbers as
+///  Generate() and does not modify the generator: several threads can
+///  generate events concurrently, each one with its own TRandom.
+///  For example, with a TDataFrame and a TRandom3 per slot:
+/// ~~~ {.cpp}
+///   std::vector<TRandom3> rnds(ROOT::GetImplicitMTPoolSize());
+///   tdf.DefineSlot("wt", [&](unsigned int slot, ULong64_t) {
+///      TLorentzVector decay[3];
+///      return gen.Generate(rnds[slot], decay);
+///   }, {"tdfentry_"});
+/// ~~~
+
+Double_t TGenPhaseSpace::Generate(TRandom &rnd, TLorentzVector *decay) const
 {
    Double_t rno[kMAXP];
    rno[0] = 0;
    Int_t n;
    if (fNt>2) {
-      for (n=1; n<fNt-1; n++)  rno[n]=gRandom->Rndm();   // fNt-2 random numbers
+      for (n=1; n<fNt-1; n++)  rno[n]=rnd.Rndm();   // fNt-2 random numbers
       qsort(rno+1 ,fNt-2 ,sizeof(Double_t) ,DoubleMax);  // sort them
    }
    rno[fNt-1] = 1;
@@ -125,20 +147,20 @@ Double_t TGenPhaseSpace::Generate()
    //
    //-----> complete specification of event (Raubold-Lynch method)
    //
-   fDecPro[0].SetPxPyPzE(0, pd[0], 0 , TMath::Sqrt(pd[0]*pd[0]+fMass[0]*fMass[0]) );
+   decay[0].SetPxPyPzE(0, pd[0], 0 , TMath::Sqrt(pd[0]*pd[0]+fMass[0]*fMass[0]) );
 
    Int_t i=1;
    Int_t j;
    while (1) {
-      fDecPro[i].SetPxPyPzE(0, -pd[i-1], 0 , TMath::Sqrt(pd[i-1]*pd[i-1]+fMass[i]*fMass[i]) );
+      decay[i].SetPxPyPzE(0, -pd[i-1], 0 , TMath::Sqrt(pd[i-1]*pd[i-1]+fMass[i]*fMass[i]) );
 
-      Double_t cZ   = 2*gRandom->Rndm() - 1;
+      Double_t cZ   = 2*rnd.Rndm() - 1;
       Double_t sZ   = TMath::Sqrt(1-cZ*cZ);
-      Double_t angY = 2*TMath::Pi() * gRandom->Rndm();
+      Double_t angY = 2*TMath::Pi() * rnd.Rndm();
       Double_t cY   = TMath::Cos(angY);
       Double_t sY   = TMath::Sin(angY);
       for (j=0; j<=i; j++) {
-         TLorentzVector *v = fDecPro+j;
+         TLorentzVector *v = decay+j;
          Double_t x = v->Px();
          Double_t y = v->Py();
          v->SetPx( cZ*x - sZ*y );
@@ -152,14 +174,14 @@ Double_t TGenPhaseSpace::Generate()
       if (i == (fNt-1)) break;
 
       Double_t beta = pd[i] / sqrt(pd[i]*pd[i] + invMas[i]*invMas[i]);
-      for (j=0; j<=i; j++) fDecPro[j].Boost(0,beta,0);
+      for (j=0; j<=i; j++) decay[j].Boost(0,beta,0);
       i++;
    }
 
    //
    //---> final boost of all particles
    //
-   for (n=0;n<fNt;n++) fDecPro[n].Boost(fBeta[0],fBeta[1],fBeta[2]);
+   for (n=0;n<fNt;n++) decay[n].Boost(fBeta[0],fBeta[1],fBeta[2]);
 
    //
    //---> return the weight of event
@@ -167,6 +189,138 @@ Double_t TGenPhaseSpace::Generate()
    return wt;
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Boost the four-vector (x,y,z,t) with the same operations as
+/// TLorentzVector::Boost.
+
+inline void BoostXYZT(Double_t bx, Double_t by, Double_t bz, Double_t &x, Double_t &y, Double_t &z, Double_t &t)
+{
+   Double_t b2 = bx*bx + by*by + bz*bz;
+   Double_t gamma = 1.0 / TMath::Sqrt(1.0 - b2);
+   Double_t bp = bx*x + by*y + bz*z;
+   Double_t gamma2 = b2 > 0 ? (gamma - 1.0)/b2 : 0.0;
+
+   x = x + gamma2*bp*bx + gamma*bx*t;
+   y = y + gamma2*bp*by + gamma*by*t;
+   z = z + gamma2*bp*bz + gamma*bz*t;
+   t = gamma*(t + bp);
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+///  Generate n random final states with the random number generator rnd.
+///  The weight of the event k is stored in wt[k] and the four-momentum of its
+///  decay product i in px, py, pz and e at the index i*n+k: the arrays must
+///  have n*GetNt() elements.
+///
+///  The events and their weights are the ones of n calls of
+///  Generate(rnd, decay), which draw the same random numbers, but the events
+///  are computed by blocks, each step of the Raubold-Lynch method being done
+///  for all the events of a block in a loop that the compiler can vectorise.
+///  As Generate(rnd, decay), it does not modify the generator and can be called
+///  concurrently with different random number generators.
+
+void TGenPhaseSpace::Generate(TRandom &rnd, Int_t n, Double_t *wt, Double_t *px, Double_t *py, Double_t *pz,
+                              Double_t *e) const
+{
+   const Int_t kBlock = 64;              // events computed together
+   const Int_t nRndm = 3*fNt - 4;        // random numbers drawn per event
+   Double_t rndm[kBlock][3*kMAXP];
+   Double_t invMas[kMAXP][kBlock], pd[kMAXP][kBlock];
+   Double_t cZ[kBlock], sZ[kBlock], cY[kBlock], sY[kBlock], beta[kBlock];
+   Double_t sum[kMAXP];
+   Int_t i, j, k;
+
+   if (fNt<2) return;                    // no decay set
+   sum[0] = fMass[0];
+   for (i=1; i<fNt; i++) sum[i] = sum[i-1] + fMass[i];
+
+   for (Int_t first=0; first<n; first+=kBlock) {
+      const Int_t m = TMath::Min(kBlock, n-first);
+
+      // the random numbers of every event, in the order of Generate
+      for (k=0; k<m; k++) {
+         for (j=0; j<nRndm; j++) rndm[k][j] = rnd.Rndm();
+         std::sort(rndm[k], rndm[k]+fNt-2);
+      }
+
+      for (k=0; k<m; k++) invMas[0][k] = 0*fTeCmTm + sum[0];
+      for (i=1; i<fNt-1; i++)
+         for (k=0; k<m; k++) invMas[i][k] = rndm[k][i-1]*fTeCmTm + sum[i];
+      for (k=0; k<m; k++) invMas[fNt-1][k] = 1*fTeCmTm + sum[fNt-1];
+
+      //
+      //-----> compute the weight of the events
+      //
+      for (k=0; k<m; k++) wt[first+k] = fWtMax;
+      for (i=0; i<fNt-1; i++) {
+         for (k=0; k<m; k++) {
+            pd[i][k] = PDK(invMas[i+1][k],invMas[i][k],fMass[i+1]);
+            wt[first+k] *= pd[i][k];
+         }
+      }
+
+      //
+      //-----> complete specification of events (Raubold-Lynch method)
+      //
+      for (i=0; i<fNt; i++) {
+         const Long64_t off = i*Long64_t(n) + first;
+         const Double_t mass2 = fMass[i]*fMass[i];
+         const Double_t *p = pd[i == 0 ? 0 : i-1];
+         const Double_t sign = i == 0 ? 1 : -1;
+         for (k=0; k<m; k++) {
+            px[off+k] = 0;
+            py[off+k] = sign*p[k];
+            pz[off+k] = 0;
+            e[off+k]  = TMath::Sqrt(p[k]*p[k]+mass2);
+         }
+      }
+      for (i=1; i<fNt; i++) {
+         for (k=0; k<m; k++) {
+            cZ[k] = 2*rndm[k][fNt-2+2*(i-1)] - 1;
+            sZ[k] = TMath::Sqrt(1-cZ[k]*cZ[k]);
+            Double_t angY = 2*TMath::Pi() * rndm[k][fNt-1+2*(i-1)];
+            cY[k] = TMath::Cos(angY);
+            sY[k] = TMath::Sin(angY);
+         }
+         for (j=0; j<=i; j++) {
+            Double_t *vx = px + j*Long64_t(n) + first;
+            Double_t *vy = py + j*Long64_t(n) + first;
+            Double_t *vz = pz + j*Long64_t(n) + first;
+            for (k=0; k<m; k++) {
+               Double_t x = vx[k];
+               Double_t y = vy[k];
+               vx[k] = cZ[k]*x - sZ[k]*y;
+               vy[k] = sZ[k]*x + cZ[k]*y;   // rotation around Z
+               x = vx[k];
+               Double_t z = vz[k];
+               vx[k] = cY[k]*x - sY[k]*z;
+               vz[k] = sY[k]*x + cY[k]*z;   // rotation around Y
+            }
+         }
+
+         if (i == (fNt-1)) break;
+
+         for (k=0; k<m; k++) beta[k] = pd[i][k] / sqrt(pd[i][k]*pd[i][k] + invMas[i][k]*invMas[i][k]);
+         for (j=0; j<=i; j++) {
+            const Long64_t off = j*Long64_t(n) + first;
+            for (k=0; k<m; k++) BoostXYZT(0,beta[k],0,px[off+k],py[off+k],pz[off+k],e[off+k]);
+         }
+      }
+
+      //
+      //---> final boost of all particles
+      //
+      for (i=0; i<fNt; i++) {
+         const Long64_t off = i*Long64_t(n) + first;
+         for (k=0; k<m; k++) BoostXYZT(fBeta[0],fBeta[1],fBeta[2],px[off+k],py[off+k],pz[off+k],e[off+k]);
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return Lorentz vector corresponding to decay n
 
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+
+#include "TGenPhaseSpace.h"
+#include "TLorentzVector.h"
+#include "TRandom.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+namespace {
+
+const UInt_t kSeed = 4357;
+// More than one block of events of the batched Generate.
+const Int_t kNEvents = 150;
+
+// The events of Generate(), Generate(rnd, decay) and the batched Generate
+// with the same seed are bit-identical.
+void ExpectSameEvents(Int_t nt, const Double_t *masses, Option_t *opt)
+{
+   TLorentzVector parent(0.3, -0.2, 1.5, 6.);
+   TGenPhaseSpace gen;
+   ASSERT_TRUE(gen.SetDecay(parent, nt, masses, opt));
+
+   std::vector<Double_t> wt(kNEvents), px(nt * kNEvents), py(nt * kNEvents), pz(nt * kNEvents), e(nt * kNEvents);
+   TRandom3 rndBatch(kSeed);
+   gen.Generate(rndBatch, kNEvents, wt.data(), px.data(), py.data(), pz.data(), e.data());
+
+   TRandom3 rndGlobal(kSeed);
+   TRandom3 rnd(kSeed);
+   TRandom *savedRandom = gRandom;
+   gRandom = &rndGlobal;
+   for (Int_t k = 0; k < kNEvents; ++k) {
+      Double_t weight = gen.Generate();
+      TLorentzVector decay[18];
+      EXPECT_EQ(weight, gen.Generate(rnd, decay));
+      EXPECT_EQ(weight, wt[k]);
+      for (Int_t i = 0; i < nt; ++i) {
+         const TLorentzVector &expected = *gen.GetDecay(i);
+         EXPECT_EQ(expected.Px(), decay[i].Px());
+         EXPECT_EQ(expected.Py(), decay[i].Py());
+         EXPECT_EQ(expected.Pz(), decay[i].Pz());
+         EXPECT_EQ(expected.E(), decay[i].E());
+         EXPECT_EQ(expected.Px(), px[i * kNEvents + k]);
+         EXPECT_EQ(expected.Py(), py[i * kNEvents + k]);
+         EXPECT_EQ(expected.Pz(), pz[i * kNEvents + k]);
+         EXPECT_EQ(expected.E(), e[i * kNEvents + k]);
+      }
+   }
+   gRandom = savedRandom;
+}
+
+} // anonymous namespace
+
+TEST(TGenPhaseSpace, TwoBodies)
+{
+   const Double_t masses[2] = {0.13957, 0.13957};
+   ExpectSameEvents(2, masses, "");
+}
+
+TEST(TGenPhaseSpace, TwoBodiesFermi)
+{
+   const Double_t masses[2] = {0.13957, 0.13957};
+   ExpectSameEvents(2, masses, "Fermi");
+}
+
+TEST(TGenPhaseSpace, FiveBodies)
+{
+   const Double_t masses[5] = {0.938272, 0.13957, 0.13957, 0.493677, 0.000511};
+   ExpectSameEvents(5, masses, "");
+}
+
+TEST(TGenPhaseSpace, FiveBodiesFermi)
+{
+   const Double_t masses[5] = {0.938272, 0.13957, 0.13957, 0.493677, 0.000511};
+   ExpectSameEvents(5, masses, "Fermi");
+}
@@ -39,6 +39,8 @@
 
 #include "Math/MatrixRepresentationsStatic.h"
 
+#include "Math/SMatrixSIMD.h"
+
 // #ifndef ROOT_Math_QRDecomposition
 // #include "Math/QRDecomposition.h"
 // #endif
@@ -51,6 +53,10 @@ namespace ROOT {
 
 
 
+// Cramer inversion, used also by Inverter for the matrices of SIMD types
+template <unsigned int idim, unsigned int n = idim>
+class FastInverter;
+
 /**
     Matrix Inverter class
     Class to specialize calls to Dinv. Dinv computes the inverse of a square
@@ -59,6 +65,11 @@ namespace ROOT {
     destroyed. Invert specializes Dinv by the matrix order. E.g. if the order
     of the matrix is two, the routine Inverter<2> is called which implements
     Cramers rule.
+    For the matrices of SIMD types (see Math/SMatrixSIMD.h) the LU and Bunch-Kaufman
+    pivoting, which differs from a lane to the other, is not available: the
+    matrices up to 5x5 are inverted with the Cramer rule of FastInverter, the larger
+    symmetric ones with the Cholesky decomposition and the larger general ones
+    are a compilation error.
 
     @author T. Glebe
 */
@@ -73,22 +84,8 @@ public:
   /// implementation is in file Math/MatrixInversion.icc
   template <class MatrixRep>
   static bool Dinv(MatrixRep& rhs) {
-
-
-      /* Initialized data */
-     unsigned int work[n+1] = {0};
-
-     typename MatrixRep::value_type det(0.0);
-
-     if (DfactMatrix(rhs,det,work) != 0) {
-        Error("Inverter::Dinv","Dfact_matrix failed!!");
-        return false;
-     }
-
-     int ifail =  DfinvMatrix(rhs,work);
-     if (ifail == 0) return true;
-     return false;
-  } // Dinv
+     return DinvLU(rhs, SIMD::IsVector<typename MatrixRep::value_type>());
+  }
 
 
   ///  symmetric matrix inversion using
@@ -96,10 +93,7 @@ public:
   ///   implementation in Math/MatrixInversion.icc
   template <class T>
   static bool Dinv(MatRepSym<T,idim> & rhs) {
-    int ifail = 0;
-    InvertBunchKaufman(rhs,ifail);
-    if (ifail == 0) return true;
-    return false;
+    return DinvSym(rhs, std::integral_constant<int, !SIMD::IsVector<T>::value ? 0 : (idim <= 5 ? 1 : 2)>());
   }
 
 
@@ -123,6 +117,53 @@ public:
   static void InvertBunchKaufman(MatRepSym<T,idim> & rhs, int &ifail);
 
 
+private:
+
+  template <class MatrixRep>
+  static bool DinvLU(MatrixRep& rhs, std::false_type) {
+
+      /* Initialized data */
+     unsigned int work[n+1] = {0};
+
+     typename MatrixRep::value_type det(0.0);
+
+     if (DfactMatrix(rhs,det,work) != 0) {
+        Error("Inverter::Dinv","Dfact_matrix failed!!");
+        return false;
+     }
+
+     int ifail =  DfinvMatrix(rhs,work);
+     if (ifail == 0) return true;
+     return false;
+  } // DinvLU
+
+  // matrices of SIMD types: Cramer rule
+  template <class MatrixRep>
+  static bool DinvLU(MatrixRep& rhs, std::true_type) {
+     static_assert(idim <= 5, "general SMatrix of SIMD types larger than 5x5 cannot be inverted");
+     return FastInverter<idim,n>::Dinv(rhs);
+  }
+
+  template <class T>
+  static bool DinvSym(MatRepSym<T,idim> & rhs, std::integral_constant<int, 0>) {
+    int ifail = 0;
+    InvertBunchKaufman(rhs,ifail);
+    if (ifail == 0) return true;
+    return false;
+  }
+
+  // matrices of SIMD types up to 5x5: Cramer rule
+  template <class T>
+  static bool DinvSym(MatRepSym<T,idim> & rhs, std::integral_constant<int, 1>) {
+    return FastInverter<idim,n>::Dinv(rhs);
+  }
+
+  // larger matrices of SIMD types: Cholesky decomposition
+  template <class T>
+  static bool DinvSym(MatRepSym<T,idim> & rhs, std::integral_constant<int, 2>) {
+    CholeskyDecomp<T, idim> decomp(rhs);
+    return decomp.Invert(rhs);
+  }
 
 }; // class Inverter
 
@@ -140,7 +181,7 @@ public:
 
     @author L. Moneta
 */
-template <unsigned int idim, unsigned int n = idim>
+template <unsigned int idim, unsigned int n>
 class FastInverter {
 public:
   ///
@@ -187,7 +228,7 @@ public:
   template <class MatrixRep>
   static bool Dinv(MatrixRep& rhs) {
 
-    if (rhs[0] == 0.) {
+    if (SIMD::AnyZero(rhs[0])) {
       return false;
     }
     rhs[0] = 1. / rhs[0];
@@ -215,7 +256,7 @@ public:
     typedef typename MatrixRep::value_type T;
     T det = rhs[0] * rhs[3] - rhs[2] * rhs[1];
 
-    if (det == T(0.) ) { return false; }
+    if (SIMD::AnyZero(det)) { return false; }
 
     T s = T(1.0) / det;
 
@@ -240,7 +281,7 @@ public:
     T det = rhs[0] * rhs[2] - rhs[1] * rhs[1];
 
 
-    if (det == T(0.)) { return false; }
+    if (SIMD::AnyZero(det)) { return false; }
 
     T s = T(1.0) / det;
     T c11 = s * rhs[2];
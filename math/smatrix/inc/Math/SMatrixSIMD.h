@@ -0,0 +1,137 @@
+// @(#)root/smatrix:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2018 , LCG ROOT MathLib Team                         *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Math_SMatrixSIMD
+#define ROOT_Math_SMatrixSIMD
+
+// Helpers for SMatrix and SVector of SIMD types (like ROOT::Double_v), where
+// one object holds as many matrices as the type has lanes, one per lane.
+// The operations of the matrices are performed on all lanes at the same time;
+// the checks of the inversions (singular or not positive definite matrix)
+// fail when any lane fails.
+// Without VecCore the types are the scalar ones and the helpers are trivial.
+
+#include "RConfigure.h"
+
+#include <cmath>
+#include <type_traits>
+
+#ifdef R__HAS_VECCORE
+#include <VecCore/VecCore>
+#endif
+
+namespace ROOT {
+
+  namespace Math {
+
+    namespace SIMD {
+
+#ifdef R__HAS_VECCORE
+
+/// true_type for the SIMD types of VecCore with more than one lane
+template <class T>
+struct IsVector : std::integral_constant<bool, !std::is_same<vecCore::Scalar<T>, T>::value> {};
+
+/// number of lanes of T
+template <class T>
+constexpr unsigned int Size() { return vecCore::VectorSize<T>(); }
+
+/// lane i of x
+template <class T>
+inline vecCore::Scalar<T> Get(const T &x, unsigned int i) { return vecCore::Get(x, i); }
+
+/// set the lane i of x
+template <class T>
+inline void Set(T &x, unsigned int i, vecCore::Scalar<T> value) { vecCore::Set(x, i, value); }
+
+/// true if any lane of x is zero
+template <class T>
+inline bool AnyZero(const T &x) { return !vecCore::MaskEmpty(x == T(0.)); }
+
+/// true if any lane of x is zero or negative
+template <class T>
+inline bool AnyNotPositive(const T &x) { return !vecCore::MaskEmpty(x <= T(0.)); }
+
+/// a in the lanes where mask is true, b elsewhere
+template <class M, class T>
+inline T Select(const M &mask, const T &a, const T &b) { return vecCore::Blend(mask, a, b); }
+
+template <class T>
+inline T Abs(const T &x) { return vecCore::math::Abs(x); }
+
+template <class T>
+inline T Sqrt(const T &x) { return vecCore::math::Sqrt(x); }
+
+#else
+
+template <class T>
+struct IsVector : std::false_type {};
+
+template <class T>
+constexpr unsigned int Size() { return 1; }
+
+template <class T>
+inline T Get(const T &x, unsigned int) { return x; }
+
+template <class T, class S>
+inline void Set(T &x, unsigned int, S value) { x = value; }
+
+template <class T>
+inline bool AnyZero(const T &x) { return x == T(0.); }
+
+template <class T>
+inline bool AnyNotPositive(const T &x) { return x <= T(0.); }
+
+template <class T>
+inline T Select(bool mask, const T &a, const T &b) { return mask ? a : b; }
+
+template <class T>
+inline T Abs(const T &x) { return std::abs(x); }
+
+template <class T>
+inline T Sqrt(const T &x) { return std::sqrt(x); }
+
+#endif
+
+/**
+   Pack n scalar matrices (or vectors) in into the lanes of the SIMD matrix (or
+   vector) out, of the same dimensions and representation: in[i] goes to the lane i.
+   The lanes from n on, if any, are filled with in[0], so that they can be
+   inverted when in[0] can be. By default all the lanes are filled.
+ */
+template <class VObj, class SObj>
+void Pack(const SObj *in, VObj &out, unsigned int n = Size<typename VObj::value_type>())
+{
+   const unsigned int lanes = Size<typename VObj::value_type>();
+   const unsigned int size = out.end() - out.begin();
+   for (unsigned int k = 0; k < size; ++k)
+      for (unsigned int i = 0; i < lanes; ++i)
+         Set(out.begin()[k], i, in[i < n ? i : 0].begin()[k]);
+}
+
+/**
+   Unpack the n first lanes of the SIMD matrix (or vector) in into the scalar
+   matrices (or vectors) out[0] ... out[n-1]. By default all the lanes are unpacked.
+ */
+template <class SObj, class VObj>
+void Unpack(const VObj &in, SObj *out, unsigned int n = Size<typename VObj::value_type>())
+{
+   const unsigned int size = in.end() - in.begin();
+   for (unsigned int i = 0; i < n; ++i)
+      for (unsigned int k = 0; k < size; ++k)
+         out[i].begin()[k] = Get(in.begin()[k], i);
+}
+
+    }  // namespace SIMD
+
+  }  // namespace Math
+
+}  // namespace ROOT
+
+#endif  /* ROOT_Math_SMatrixSIMD */
@@ -0,0 +1,176 @@
+// compare the operations on many small matrices done one at a time with
+// the ones done on matrices of SIMD types (ROOT::Double_v), each holding one
+// matrix per lane (see Math/SMatrixSIMD.h)
+#include "Math/SMatrix.h"
+#include "Math/Types.h"
+
+#include "TRandom3.h"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cmath>
+
+#include "TestTimer.h"
+
+// matrix size
+#ifndef N
+#define N 5
+#endif
+
+// number of matrices
+#ifndef NMAT
+#define NMAT 100000
+#endif
+
+// number of repetitions
+#ifndef NLOOP
+#define NLOOP 20
+#endif
+
+using namespace ROOT::Math;
+
+typedef ROOT::Double_v Vec_t;
+
+typedef SMatrix<double, N, N, MatRepSym<double, N> > SymMatrix;
+typedef SMatrix<double, 2, N> ProjMatrix;
+typedef SMatrix<double, 2, 2, MatRepSym<double, 2> > SymMatrix2;
+
+typedef SMatrix<Vec_t, N, N, MatRepSym<Vec_t, N> > SymMatrixV;
+typedef SMatrix<Vec_t, 2, N> ProjMatrixV;
+typedef SMatrix<Vec_t, 2, 2, MatRepSym<Vec_t, 2> > SymMatrix2V;
+
+const unsigned int kLanes = SIMD::Size<Vec_t>();
+
+// random positive definite matrix
+void FillMatrix(TRandom &r, SymMatrix &m)
+{
+   SMatrix<double, N, N> a;
+   for (unsigned int i = 0; i < N; ++i)
+      for (unsigned int j = 0; j < N; ++j)
+         a(i, j) = r.Rndm();
+   SMatrix<double, N, N> b = a * Transpose(a);
+   for (unsigned int i = 0; i < N; ++i)
+      for (unsigned int j = 0; j <= i; ++j)
+         m(i, j) = b(i, j) + (i == j ? 1. : 0.);
+}
+
+template <class M>
+double MaxDiff(const std::vector<M> &m1, const std::vector<M> &m2)
+{
+   double d = 0;
+   for (unsigned int k = 0; k < m1.size(); ++k)
+      for (unsigned int i = 0; i < M::rep_type::kSize; ++i)
+         d = std::max(d, std::abs(m1[k].Array()[i] - m2[k].Array()[i]));
+   return d;
+}
+
+// invert (method 0), invert fast (1) or invert with Cholesky (2) one matrix at a time
+void InvertScalar(std::vector<SymMatrix> &m, int method)
+{
+   for (unsigned int k = 0; k < m.size(); ++k) {
+      if (method == 0)
+         m[k].Invert();
+      else if (method == 1)
+         m[k].InvertFast();
+      else
+         m[k].InvertChol();
+   }
+}
+
+// same with the matrices packed by kLanes: without pivoting for the SIMD types,
+// Invert uses the Cramer rule up to 5x5 and Cholesky above
+void InvertSIMD(std::vector<SymMatrix> &m, int method)
+{
+   SymMatrixV mv;
+   for (unsigned int k = 0; k < m.size(); k += kLanes) {
+      const unsigned int n = std::min<unsigned int>(kLanes, m.size() - k);
+      SIMD::Pack(&m[k], mv, n);
+      if (method == 0)
+         mv.Invert();
+      else if (method == 1)
+         mv.InvertFast();
+      else
+         mv.InvertChol();
+      SIMD::Unpack(mv, &m[k], n);
+   }
+}
+
+void SimilarityScalar(const ProjMatrix &h, const std::vector<SymMatrix> &m, std::vector<SymMatrix2> &r)
+{
+   for (unsigned int k = 0; k < m.size(); ++k)
+      r[k] = Similarity(h, m[k]);
+}
+
+void SimilaritySIMD(const ProjMatrix &h, const std::vector<SymMatrix> &m, std::vector<SymMatrix2> &r)
+{
+   ProjMatrixV hv;
+   for (unsigned int i = 0; i < 2; ++i)
+      for (unsigned int j = 0; j < N; ++j)
+         hv(i, j) = Vec_t(h(i, j));
+   SymMatrixV mv;
+   SymMatrix2V rv;
+   for (unsigned int k = 0; k < m.size(); k += kLanes) {
+      const unsigned int n = std::min<unsigned int>(kLanes, m.size() - k);
+      SIMD::Pack(&m[k], mv, n);
+      rv = Similarity(hv, mv);
+      SIMD::Unpack(rv, &r[k], n);
+   }
+}
+
+int main()
+{
+   std::cout << "Operations on " << NMAT << " matrices " << N << "x" << N << ", " << kLanes << " lanes" << std::endl;
+
+   TRandom3 r(111);
+   std::vector<SymMatrix> m(NMAT);
+   for (unsigned int k = 0; k < m.size(); ++k)
+      FillMatrix(r, m[k]);
+   ProjMatrix h;
+   for (unsigned int i = 0; i < 2; ++i)
+      for (unsigned int j = 0; j < N; ++j)
+         h(i, j) = r.Rndm();
+
+   int iret = 0;
+   const char *names[3] = {"Invert", "InvertFast", "InvertChol"};
+   for (int method = 0; method < 3; ++method) {
+      std::vector<SymMatrix> m1, m2;
+      {
+         ROOT::Math::test::Timer t(std::string(names[method]) + " scalar");
+         for (int l = 0; l < NLOOP; ++l) {
+            m1 = m;
+            InvertScalar(m1, method);
+         }
+      }
+      {
+         ROOT::Math::test::Timer t(std::string(names[method]) + " SIMD  ");
+         for (int l = 0; l < NLOOP; ++l) {
+            m2 = m;
+            InvertSIMD(m2, method);
+         }
+      }
+      const double d = MaxDiff(m1, m2);
+      std::cout << names[method] << " max difference = " << d << std::endl;
+      if (d > 1.E-10)
+         iret = 1;
+   }
+
+   std::vector<SymMatrix2> r1(NMAT), r2(NMAT);
+   {
+      ROOT::Math::test::Timer t("Similarity scalar");
+      for (int l = 0; l < NLOOP; ++l)
+         SimilarityScalar(h, m, r1);
+   }
+   {
+      ROOT::Math::test::Timer t("Similarity SIMD  ");
+      for (int l = 0; l < NLOOP; ++l)
+         SimilaritySIMD(h, m, r2);
+   }
+   const double d = MaxDiff(r1, r2);
+   std::cout << "Similarity max difference = " << d << std::endl;
+   if (d > 1.E-10)
+      iret = 1;
+
+   if (iret)
+      std::cerr << "testSIMD: FAILED" << std::endl;
+   return iret;
+}
@@ -0,0 +1,43 @@
+// @(#)root/memstat:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMemProfiler
+#define ROOT_TMemProfiler
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMemProfiler                                                         //
+//                                                                      //
+// Sampling heap profiler: instead of recording every call to malloc    //
+// and free like TMemStat, it records the backtrace of one allocation   //
+// every N bytes on average, which keeps the overhead small enough to   //
+// profile production jobs. The report attributes the live memory to    //
+// the class of the objects deriving from TObject, to the branches for  //
+// the basket buffers and to the allocation sites otherwise.            //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+class TMemProfiler {
+public:
+   enum { kDefaultInterval = 512 * 1024 }; // Mean number of bytes between two samples
+
+   static Bool_t    Start(Long64_t interval = kDefaultInterval, const char *filename = 0);
+   static void      Stop();
+   static Bool_t    IsActive();
+   static Long64_t  GetInterval();
+   static ULong64_t GetNSamples();
+   static Long64_t  GetLiveBytes();
+   static void      Reset();
+   static Bool_t    Report(const char *filename = 0, Int_t nentries = 20, Option_t *option = "");
+};
+
+#endif
@@ -34,11 +34,14 @@ public:
    //
    typedef void*(*MallocHookFunc_t)(size_t size, const void *caller);
    typedef void (*FreeHookFunc_t)(void *ptr, const void *caller);
+   typedef void*(*ReallocHookFunc_t)(void *ptr, size_t size, const void *caller);
 
    static MallocHookFunc_t GetMallocHook();         // malloc function getter
    static FreeHookFunc_t   GetFreeHook();           // free function getter
+   static ReallocHookFunc_t GetReallocHook();       // realloc function getter
    static void SetMallocHook(MallocHookFunc_t p);   // malloc function setter
    static void SetFreeHook(FreeHookFunc_t p);       // free function setter
+   static void SetReallocHook(ReallocHookFunc_t p); // realloc function setter
 #else
    //
    // Public methods for Mac OS X
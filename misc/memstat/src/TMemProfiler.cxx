@@ -0,0 +1,697 @@
+// @(#)root/memstat:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TMemProfiler
+\ingroup memstat
+
+Sampling heap profiler.
+
+TMemStat records every call to malloc and free, which makes a job several
+times slower and produces very large files. TMemProfiler instead samples the
+allocations: on average one allocation every `interval` bytes (512 kB by
+default) is recorded, with its raw backtrace, so that the job runs at nearly
+full speed and the hooks cost a counter decrement per malloc and a table
+lookup per free. Each sample stands for the bytes of the allocations that
+were not sampled, which gives an unbiased estimate of the heap.
+
+    TMemProfiler::Start();            // or Start(interval, "memprofile.txt")
+    ... run the job ...
+    TMemProfiler::Report();           // live heap, by class, branch or site
+    TMemProfiler::Report(0, 20, "alloc bt");
+
+or, for any ROOT application, in .rootrc:
+
+    Root.TMemProfiler:       524288
+    Root.TMemProfiler.file:  memprofile.txt
+
+The backtraces are only symbolized when the report is made. The report
+attributes the live memory
+
+  - to the class of the objects deriving from TObject (allocated through
+    TObject::operator new), from the dynamic type of the object;
+  - to the branch owning them, for the baskets and their buffers of the trees
+    in memory (in the files of gROOT->GetListOfFiles() and in gROOT);
+  - to the first frame of the backtrace outside of the allocators and the
+    standard library otherwise.
+
+With the option "alloc", the report gives instead the bytes allocated by each
+site since the start, including those already freed. The option "bt" adds the
+heaviest backtrace of each entry.
+
+The report reads the samples of the live objects: it should be made while the
+other threads are not deleting objects. When Stop() is called, the live
+samples are forgotten, since the frees are no longer seen. The profiler relies
+on the glibc allocation hooks and is only available on Linux.
+*/
+
+#include "TMemProfiler.h"
+#include "TMemStatHook.h"
+
+#include "TBasket.h"
+#include "TBranch.h"
+#include "TBuffer.h"
+#include "TCollection.h"
+#include "TDirectory.h"
+#include "TError.h"
+#include "TObjArray.h"
+#include "TROOT.h"
+#include "TString.h"
+#include "TTree.h"
+#include "TVirtualMutex.h"
+#include <ROOT/RConfig.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(R__GNU) && defined(R__LINUX)
+#define SUPPORTS_MEMPROFILER
+#endif
+
+#if defined(SUPPORTS_MEMPROFILER)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void __libc_free(void *ptr);
+void *__libc_realloc(void *ptr, size_t size);
+}
+
+// Variables of the hooks: they must not be allocated lazily, by malloc.
+#define R__MEMPROFILER_TLS static thread_local __attribute__((tls_model("initial-exec")))
+#endif
+
+namespace {
+
+#if defined(SUPPORTS_MEMPROFILER)
+R__MEMPROFILER_TLS bool tInProfiler = false;         // The thread runs the profiler: its allocations are not sampled
+R__MEMPROFILER_TLS bool tCountdownStarted = false;
+R__MEMPROFILER_TLS Long64_t tBytesUntilSample = 0;
+R__MEMPROFILER_TLS ULong64_t tRandom = 0;
+#endif
+
+std::atomic<Bool_t> gActive(kFALSE);
+std::atomic<Long64_t> gInterval((Long64_t)TMemProfiler::kDefaultInterval);
+
+// Counting filter of the addresses of the live samples: a free only looks
+// the address up in the table of the samples if its slot is not zero.
+const int kFilterBits = 16;
+std::atomic<UInt_t> gFilter[1 << kFilterBits];
+
+inline UInt_t FilterSlot(const void *ptr)
+{
+   return (UInt_t)((((ULong64_t)(size_t)ptr >> 4) * 0x9E3779B97F4A7C15ULL) >> (64 - kFilterBits));
+}
+
+const int kMaxDepth = 40; // Frames of a backtrace, including those of the profiler and of malloc
+
+struct TStackRecord {
+   std::vector<void *> fFrames;
+   ULong64_t fNSamples = 0; // All the samples of this backtrace, including those freed
+   Long64_t fBytes = 0;     // Estimated bytes allocated by this backtrace since the start
+   Int_t fObjectAlloc = -1; // 1 if allocated by TStorage::ObjectAlloc, 0 if not, -1 if not known yet
+};
+
+struct TLiveSample {
+   UInt_t fStack;
+   Long64_t fWeight; // Estimated bytes this sample stands for
+};
+
+struct TProfilerState {
+   std::mutex fMutex;
+   std::vector<TStackRecord> fStacks;
+   std::map<std::vector<void *>, UInt_t> fStackIds;
+   std::unordered_map<void *, TLiveSample> fLive;
+   Long64_t fLiveBytes = 0;
+   ULong64_t fNSamples = 0;
+   std::string fFileName; // Report written at exit if not empty
+   bool fReportAtExitRegistered = false;
+#if defined(SUPPORTS_MEMPROFILER)
+   TMemStatHook::MallocHookFunc_t fPreviousMallocHook = 0;
+   TMemStatHook::FreeHookFunc_t fPreviousFreeHook = 0;
+   TMemStatHook::ReallocHookFunc_t fPreviousReallocHook = 0;
+#endif
+};
+
+#if defined(SUPPORTS_MEMPROFILER)
+
+// Marks the thread as running the profiler, whose own allocations are neither
+// sampled nor looked up when freed; it must be set before taking the mutex.
+struct TProfilerGuard {
+   bool fWasInProfiler;
+   TProfilerGuard() : fWasInProfiler(tInProfiler) { tInProfiler = true; }
+   ~TProfilerGuard() { tInProfiler = fWasInProfiler; }
+};
+
+TProfilerState *CreateState()
+{
+   TProfilerGuard guard;
+   return new TProfilerState;
+}
+
+// Never deleted: the hooks may still run during the static destructors.
+TProfilerState &GetState()
+{
+   static TProfilerState *gState = CreateState();
+   return *gState;
+}
+
+// Bytes until the next sample: exponentially distributed, with a mean of the interval.
+Long64_t NextSampleDistance()
+{
+   if (!tRandom)
+      tRandom = ((ULong64_t)(size_t)&tRandom * 0x9E3779B97F4A7C15ULL) | 1;
+   tRandom ^= tRandom >> 12;
+   tRandom ^= tRandom << 25;
+   tRandom ^= tRandom >> 27;
+   const double u = ((tRandom * 0x2545F4914F6CDD1DULL) >> 11) * (1. / 9007199254740992.);
+   return (Long64_t)(-std::log(1. - u) * gInterval.load(std::memory_order_relaxed)) + 1;
+}
+
+void __attribute__((noinline)) RecordSample(void *ptr, size_t size)
+{
+   TProfilerGuard guard;
+   if (!tCountdownStarted) {
+      tCountdownStarted = true;
+      tBytesUntilSample = NextSampleDistance();
+      return;
+   }
+   tBytesUntilSample = NextSampleDistance();
+   if (!gActive)
+      return;
+
+   void *frames[kMaxDepth];
+   const int depth = backtrace(frames, kMaxDepth);
+   std::vector<void *> stack(frames, frames + std::max(depth, 0));
+
+   // An allocation of size bytes is sampled with the probability p = 1 - exp(-size / interval).
+   const double interval = gInterval.load(std::memory_order_relaxed);
+   const double probability = 1. - std::exp(-(double)size / interval);
+   const Long64_t weight = probability > 0 ? (Long64_t)(size / probability) : (Long64_t)interval;
+
+   TProfilerState &state = GetState();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   auto id = state.fStackIds.emplace(std::move(stack), (UInt_t)state.fStacks.size());
+   if (id.second) {
+      state.fStacks.emplace_back();
+      state.fStacks.back().fFrames = id.first->first;
+   }
+   TStackRecord &record = state.fStacks[id.first->second];
+   ++record.fNSamples;
+   record.fBytes += weight;
+   auto live = state.fLive.emplace(ptr, TLiveSample{id.first->second, weight});
+   if (live.second) {
+      ++gFilter[FilterSlot(ptr)];
+   } else {
+      // The block was freed by a path that is not hooked.
+      state.fLiveBytes -= live.first->second.fWeight;
+      live.first->second = TLiveSample{id.first->second, weight};
+   }
+   state.fLiveBytes += weight;
+   ++state.fNSamples;
+}
+
+inline void MaybeSample(void *ptr, size_t size)
+{
+   tBytesUntilSample -= size;
+   if (R__unlikely(tBytesUntilSample <= 0))
+      RecordSample(ptr, size);
+}
+
+void RemoveSample(void *ptr)
+{
+   TProfilerGuard guard;
+   TProfilerState &state = GetState();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   auto live = state.fLive.find(ptr);
+   if (live == state.fLive.end())
+      return;
+   state.fLiveBytes -= live->second.fWeight;
+   state.fLive.erase(live);
+   --gFilter[FilterSlot(ptr)];
+}
+
+inline void MaybeRemoveSample(void *ptr)
+{
+   if (ptr && !tInProfiler && R__unlikely(gFilter[FilterSlot(ptr)].load(std::memory_order_relaxed)))
+      RemoveSample(ptr);
+}
+
+void *MallocHook(size_t size, const void * /*caller*/)
+{
+   void *ptr = __libc_malloc(size);
+   if (ptr && !tInProfiler)
+      MaybeSample(ptr, size);
+   return ptr;
+}
+
+void FreeHook(void *ptr, const void * /*caller*/)
+{
+   MaybeRemoveSample(ptr);
+   __libc_free(ptr);
+}
+
+void *ReallocHook(void *ptr, size_t size, const void * /*caller*/)
+{
+   MaybeRemoveSample(ptr);
+   void *newptr = __libc_realloc(ptr, size);
+   if (newptr && !tInProfiler)
+      MaybeSample(newptr, size);
+   return newptr;
+}
+
+// Forget the live samples; called with the mutex held.
+void ClearLiveSamples(TProfilerState &state)
+{
+   state.fLive.clear();
+   state.fLiveBytes = 0;
+   for (auto &slot : gFilter)
+      slot = 0;
+}
+
+void ReportAtExit()
+{
+   std::string filename;
+   {
+      TProfilerGuard guard;
+      TProfilerState &state = GetState();
+      std::lock_guard<std::mutex> lock(state.fMutex);
+      filename = state.fFileName;
+   }
+   if (!filename.empty() && TMemProfiler::IsActive())
+      TMemProfiler::Report(filename.c_str());
+}
+
+std::string Demangle(const char *mangled)
+{
+   int status = 0;
+   char *demangled = abi::__cxa_demangle(mangled, 0, 0, &status);
+   std::string name(status == 0 && demangled ? demangled : mangled);
+   free(demangled);
+   return name;
+}
+
+const char *BaseName(const char *path)
+{
+   const char *slash = path ? strrchr(path, '/') : 0;
+   return slash ? slash + 1 : (path ? path : "");
+}
+
+// The frames of the profiler, of malloc, of the operators new, of TStorage
+// and of the standard library do not tell where the memory is used.
+bool IsAllocatorFrame(const Dl_info &info)
+{
+   static Dl_info self;
+   static bool selfFound = dladdr(reinterpret_cast<void *>(&TMemProfiler::Start), &self) != 0;
+   if (selfFound && info.dli_fbase == self.dli_fbase)
+      return true;
+   if (info.dli_fname && strstr(BaseName(info.dli_fname), "libc."))
+      return true;
+   if (!info.dli_sname)
+      return false;
+   static const char *const prefixes[] = {"_Znw", "_Zna", "_ZN8TStorage", "_ZNSt", "_ZNKSt",
+                                          "_ZN9__gnu_cxx", "_ZSt", "malloc", "calloc", "realloc", "__libc_"};
+   for (const char *prefix : prefixes)
+      if (!strncmp(info.dli_sname, prefix, strlen(prefix)))
+         return true;
+   return false;
+}
+
+std::string FrameName(void *frame)
+{
+   // A return address: the call is just before it.
+   void *pc = static_cast<char *>(frame) - 1;
+   Dl_info info;
+   if (!dladdr(pc, &info))
+      return Form("%p", frame);
+   if (info.dli_sname)
+      return Demangle(info.dli_sname) + " (" + BaseName(info.dli_fname) + ")";
+   return Form("%s+0x%lx", BaseName(info.dli_fname), (ULong_t)((char *)pc - (char *)info.dli_fbase));
+}
+
+std::string SiteName(const std::vector<void *> &frames)
+{
+   for (void *frame : frames) {
+      Dl_info info;
+      if (dladdr(static_cast<char *>(frame) - 1, &info) && IsAllocatorFrame(info))
+         continue;
+      return FrameName(frame);
+   }
+   return "(allocator)";
+}
+
+bool IsObjectAlloc(const std::vector<void *> &frames)
+{
+   for (void *frame : frames) {
+      Dl_info info;
+      if (dladdr(static_cast<char *>(frame) - 1, &info) && info.dli_sname &&
+          !strncmp(info.dli_sname, "_ZN8TStorage11ObjectAllocE", 26))
+         return true;
+   }
+   return false;
+}
+
+// The baskets of the branches in memory and their buffers.
+void CollectBranchBuffers(TBranch *branch, std::unordered_map<const void *, std::string> &buffers)
+{
+   const std::string name = std::string(branch->GetTree()->GetName()) + "." + branch->GetName();
+   TIter nextBasket(branch->GetListOfBaskets());
+   while (TBasket *basket = (TBasket *)nextBasket()) {
+      buffers.emplace(basket, name);
+      if (TBuffer *buffer = basket->GetBufferRef()) {
+         buffers.emplace(buffer, name);
+         buffers.emplace(buffer->Buffer(), name);
+      }
+      if (basket->GetDisplacement())
+         buffers.emplace(basket->GetDisplacement(), name);
+   }
+   TIter nextBranch(branch->GetListOfBranches());
+   while (TBranch *sub = (TBranch *)nextBranch())
+      CollectBranchBuffers(sub, buffers);
+}
+
+void CollectBranchBuffers(TDirectory *dir, std::unordered_map<const void *, std::string> &buffers)
+{
+   TIter next(dir->GetList());
+   while (TObject *obj = next()) {
+      if (obj->InheritsFrom(TTree::Class())) {
+         TIter nextBranch(static_cast<TTree *>(obj)->GetListOfBranches());
+         while (TBranch *branch = (TBranch *)nextBranch())
+            CollectBranchBuffers(branch, buffers);
+      } else if (obj->InheritsFrom(TDirectory::Class())) {
+         CollectBranchBuffers(static_cast<TDirectory *>(obj), buffers);
+      }
+   }
+}
+
+struct TReportEntry {
+   const char *fKind = "";
+   Long64_t fBytes = 0;
+   ULong64_t fNSamples = 0;
+   UInt_t fStack = 0;        // The heaviest backtrace of the entry
+   Long64_t fStackBytes = 0;
+
+   void Add(UInt_t stack, Long64_t bytes, ULong64_t nsamples)
+   {
+      fBytes += bytes;
+      fNSamples += nsamples;
+      if (bytes > fStackBytes) {
+         fStack = stack;
+         fStackBytes = bytes;
+      }
+   }
+};
+
+#endif // SUPPORTS_MEMPROFILER
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start sampling the allocations, one every interval bytes on average. If
+/// filename is given, the report of the live heap is written to it at the end
+/// of the process. The backtraces sampled so far are kept, see Reset().
+/// Return kFALSE if the profiler is not available on this platform.
+
+Bool_t TMemProfiler::Start(Long64_t interval, const char *filename)
+{
+#if defined(SUPPORTS_MEMPROFILER)
+   if (interval <= 0) {
+      ::Error("TMemProfiler::Start", "the sampling interval must be positive, not %lld", interval);
+      return kFALSE;
+   }
+   TProfilerGuard guard;
+   TProfilerState &state = GetState();
+   // The first backtrace loads the unwinder, which allocates.
+   void *frame;
+   backtrace(&frame, 1);
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   gInterval = interval;
+   if (filename && *filename) {
+      state.fFileName = filename;
+      if (!state.fReportAtExitRegistered) {
+         state.fReportAtExitRegistered = true;
+         atexit(ReportAtExit);
+      }
+   }
+   if (!gActive) {
+      state.fPreviousMallocHook = TMemStatHook::GetMallocHook();
+      state.fPreviousFreeHook = TMemStatHook::GetFreeHook();
+      state.fPreviousReallocHook = TMemStatHook::GetReallocHook();
+      TMemStatHook::SetMallocHook(MallocHook);
+      TMemStatHook::SetFreeHook(FreeHook);
+      TMemStatHook::SetReallocHook(ReallocHook);
+      gActive = kTRUE;
+   }
+   return kTRUE;
+#else
+   (void)interval;
+   (void)filename;
+   ::Error("TMemProfiler::Start", "the sampling heap profiler is not available on this platform");
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop sampling the allocations. The backtraces are kept for the "alloc"
+/// report, but the live samples are forgotten since the frees are no longer
+/// seen.
+
+void TMemProfiler::Stop()
+{
+#if defined(SUPPORTS_MEMPROFILER)
+   TProfilerGuard guard;
+   TProfilerState &state = GetState();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   if (!gActive)
+      return;
+   gActive = kFALSE;
+   TMemStatHook::SetMallocHook(state.fPreviousMallocHook);
+   TMemStatHook::SetFreeHook(state.fPreviousFreeHook);
+   TMemStatHook::SetReallocHook(state.fPreviousReallocHook);
+   ClearLiveSamples(state);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether the allocations are being sampled.
+
+Bool_t TMemProfiler::IsActive()
+{
+   return gActive;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the mean number of bytes between two samples.
+
+Long64_t TMemProfiler::GetInterval()
+{
+   return gInterval;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of allocations sampled since the start or the last Reset().
+
+ULong64_t TMemProfiler::GetNSamples()
+{
+#if defined(SUPPORTS_MEMPROFILER)
+   TProfilerGuard guard;
+   TProfilerState &state = GetState();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   return state.fNSamples;
+#else
+   return 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the estimated number of bytes allocated since the start, or the last
+/// Reset(), and not freed yet.
+
+Long64_t TMemProfiler::GetLiveBytes()
+{
+#if defined(SUPPORTS_MEMPROFILER)
+   TProfilerGuard guard;
+   TProfilerState &state = GetState();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   return state.fLiveBytes;
+#else
+   return 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget all the samples; the profiler keeps sampling if it is active.
+
+void TMemProfiler::Reset()
+{
+#if defined(SUPPORTS_MEMPROFILER)
+   TProfilerGuard guard;
+   TProfilerState &state = GetState();
+   std::lock_guard<std::mutex> lock(state.fMutex);
+   ClearLiveSamples(state);
+   state.fStacks.clear();
+   state.fStackIds.clear();
+   state.fNSamples = 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the nentries largest consumers of the heap to filename, or to the
+/// standard output if filename is null. Options:
+///   - "alloc": the bytes allocated since the start by each site, including
+///     those freed, instead of the live heap by class, branch and site;
+///   - "bt": print also the heaviest backtrace of each entry.
+/// Return kFALSE if the file cannot be written.
+
+Bool_t TMemProfiler::Report(const char *filename, Int_t nentries, Option_t *option)
+{
+#if defined(SUPPORTS_MEMPROFILER)
+   TString opt(option);
+   opt.ToLower();
+   const Bool_t allocated = opt.Contains("alloc");
+   const Bool_t backtraces = opt.Contains("bt");
+
+   // The names of the branches of the baskets and buffers in memory, collected
+   // before locking the profiler: the frees of the other threads take its mutex.
+   std::unordered_map<const void *, std::string> ioBuffers;
+   if (!allocated && ROOT::Internal::gROOTLocal) {
+      R__LOCKGUARD(gROOTMutex);
+      TIter next(gROOT->GetListOfFiles());
+      while (TObject *obj = next())
+         if (obj->InheritsFrom(TDirectory::Class()))
+            CollectBranchBuffers(static_cast<TDirectory *>(obj), ioBuffers);
+      CollectBranchBuffers(gROOT, ioBuffers);
+   }
+
+   TProfilerGuard guard;
+   TProfilerState &state = GetState();
+
+   // Find the backtraces going through TObject::operator new; dladdr is not
+   // called with the mutex held since it takes the lock of the dynamic loader.
+   std::vector<std::pair<UInt_t, std::vector<void *>>> unknown;
+   {
+      std::lock_guard<std::mutex> lock(state.fMutex);
+      for (UInt_t i = 0; i < state.fStacks.size(); ++i)
+         if (state.fStacks[i].fObjectAlloc < 0)
+            unknown.emplace_back(i, state.fStacks[i].fFrames);
+   }
+   std::vector<Int_t> objectAlloc;
+   for (auto &stack : unknown)
+      objectAlloc.push_back(IsObjectAlloc(stack.second));
+
+   std::vector<std::vector<void *>> frames;
+   std::map<std::string, TReportEntry> entries; // By class or branch
+   std::map<UInt_t, TReportEntry> sites;        // By backtrace, merged by site below
+   Long64_t total = 0;
+   ULong64_t nsamples = 0;
+   {
+      std::lock_guard<std::mutex> lock(state.fMutex);
+      for (UInt_t i = 0; i < unknown.size(); ++i)
+         if (unknown[i].first < state.fStacks.size() && state.fStacks[unknown[i].first].fFrames == unknown[i].second)
+            state.fStacks[unknown[i].first].fObjectAlloc = objectAlloc[i];
+      for (auto &stack : state.fStacks)
+         frames.push_back(stack.fFrames);
+
+      if (allocated) {
+         for (UInt_t i = 0; i < state.fStacks.size(); ++i) {
+            sites[i].Add(i, state.fStacks[i].fBytes, state.fStacks[i].fNSamples);
+            total += state.fStacks[i].fBytes;
+         }
+         nsamples = state.fNSamples;
+      } else {
+         std::map<const std::type_info *, std::string> classNames;
+         for (auto &live : state.fLive) {
+            const TLiveSample &sample = live.second;
+            total += sample.fWeight;
+            ++nsamples;
+            auto buffer = ioBuffers.find(live.first);
+            if (buffer != ioBuffers.end()) {
+               TReportEntry &entry = entries["branch " + buffer->second];
+               entry.fKind = "branch";
+               entry.Add(sample.fStack, sample.fWeight, 1);
+               continue;
+            }
+            // The vtable pointer is still the pattern of TStorage::ObjectAlloc
+            // while the object is being constructed.
+            if (state.fStacks[sample.fStack].fObjectAlloc > 0 &&
+                *static_cast<const ULong64_t *>(live.first) != 0x9999999999999999ULL) {
+               // Whatever the position of TObject among the bases, the type
+               // information of the vtables is the one of the complete object.
+               const std::type_info &type = typeid(*static_cast<const TObject *>(live.first));
+               std::string &className = classNames[&type];
+               if (className.empty())
+                  className = Demangle(type.name());
+               TReportEntry &entry = entries["class " + className];
+               entry.fKind = "class";
+               entry.Add(sample.fStack, sample.fWeight, 1);
+               continue;
+            }
+            sites[sample.fStack].Add(sample.fStack, sample.fWeight, 1);
+         }
+      }
+   }
+
+   for (auto &site : sites) {
+      const std::string name = SiteName(frames[site.first]);
+      TReportEntry &entry = entries["site " + name];
+      entry.fKind = "site";
+      entry.Add(site.second.fStack, site.second.fBytes, site.second.fNSamples);
+   }
+
+   std::vector<std::pair<std::string, TReportEntry>> sorted(entries.begin(), entries.end());
+   std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, TReportEntry> &a,
+                                              const std::pair<std::string, TReportEntry> &b) {
+      return a.second.fBytes > b.second.fBytes;
+   });
+
+   FILE *out = filename ? fopen(filename, "w") : stdout;
+   if (!out) {
+      ::Error("TMemProfiler::Report", "cannot open %s", filename);
+      return kFALSE;
+   }
+   fprintf(out, "TMemProfiler: %s %.3f MB, estimated from %llu samples (one every %lld bytes on average)\n",
+           allocated ? "allocated since the start" : "live heap of", total / 1048576., nsamples,
+           (Long64_t)gInterval);
+   fprintf(out, "%12s %6s %8s  %-6s %s\n", "MB", "%", "samples", "kind", "attribution");
+   Int_t n = 0;
+   for (auto &entry : sorted) {
+      if (nentries > 0 && n++ >= nentries)
+         break;
+      const TReportEntry &e = entry.second;
+      fprintf(out, "%12.3f %6.1f %8llu  %-6s %s\n", e.fBytes / 1048576., total ? 100. * e.fBytes / total : 0.,
+              e.fNSamples, e.fKind, entry.first.c_str() + strlen(e.fKind) + 1);
+      if (backtraces) {
+         for (void *frame : frames[e.fStack])
+            fprintf(out, "%28s %s\n", "", FrameName(frame).c_str());
+      }
+   }
+   if (filename)
+      fclose(out);
+   return kTRUE;
+#else
+   (void)filename;
+   (void)nentries;
+   (void)option;
+   ::Error("TMemProfiler::Report", "the sampling heap profiler is not available on this platform");
+   return kFALSE;
+#endif
+}
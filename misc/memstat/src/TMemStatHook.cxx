@@ -67,6 +67,19 @@ TMemStatHook::FreeHookFunc_t TMemStatHook::GetFreeHook()
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// GetReallocHook - a static function
+/// realloc function getter
+
+TMemStatHook::ReallocHookFunc_t TMemStatHook::GetReallocHook()
+{
+#if defined(SUPPORTS_MEMSTAT)
+   return __realloc_hook;
+#else
+   return 0;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// SetMallocHook - a static function
 /// Set pointer to function replacing alloc function
@@ -88,6 +101,17 @@ void TMemStatHook::SetFreeHook(FreeHookFunc_t p)
    __free_hook = p;
 #endif
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// SetReallocHook - a static function
+/// Set pointer to function replacing realloc function
+
+void TMemStatHook::SetReallocHook(ReallocHookFunc_t p)
+{
+#if defined(SUPPORTS_MEMSTAT)
+   __realloc_hook = p;
+#endif
+}
 #endif // !defined(__APPLE__)
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -51,6 +51,8 @@
 #include <sstream>
 #include <string>
 #include <cstring>
+#include <thread>
+#include <vector>
 
 
 static const std::string VERSION = "0.2.0";
@@ -295,6 +297,52 @@ void TDavixFileInternal::Close()
             davixErr->getErrMsg().c_str(), davixErr->getStatus());
       DavixError::clearError(&davixErr);
    }
+
+   TLockGuard l(&readFdsLock);
+   for (size_t i = 0; i < allReadFds.size(); ++i) {
+      davixPosix->close(allReadFds[i], &davixErr);
+      DavixError::clearError(&davixErr);
+   }
+   allReadFds.clear();
+   readFds.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return an extra descriptor of the file, opened for reading, to issue range
+/// requests concurrently with the ones of the main descriptor; NULL if the
+/// file is open for writing or cannot be opened again.
+
+Davix_fd *TDavixFileInternal::acquireReadFd()
+{
+   if (oflags & (O_WRONLY | O_RDWR))
+      return NULL;
+   {
+      TLockGuard l(&readFdsLock);
+      if (!readFds.empty()) {
+         Davix_fd *fd = readFds.back();
+         readFds.pop_back();
+         return fd;
+      }
+   }
+   DavixError *davixErr = NULL;
+   Davix_fd *fd = davixPosix->open(davixParam, fUrl.GetUrl(), O_RDONLY, &davixErr);
+   if (fd == NULL) {
+      DavixError::clearError(&davixErr);
+      return NULL;
+   }
+   davixPosix->fadvise(fd, 0, 300, Davix::AdviseRandom);
+   TLockGuard l(&readFdsLock);
+   allReadFds.push_back(fd);
+   return fd;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give back a descriptor returned by acquireReadFd().
+
+void TDavixFileInternal::releaseReadFd(Davix_fd *fd)
+{
+   TLockGuard l(&readFdsLock);
+   readFds.push_back(fd);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -440,6 +488,10 @@ void TDavixFileInternal::parseConfig()
    env_var = gEnv->GetValue("Davix.GSI.GridMode", (const char *)"y");
    if (!isno(env_var))
       enableGridMode();
+
+   // vector reads
+   readvGap = gEnv->GetValue("Davix.ReadV.GapSize", 16 * 1024);
+   readvParallel = gEnv->GetValue("Davix.ReadV.Parallel", 4);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -845,27 +897,117 @@ Long64_t TDavixFile::DavixPReadBuffer(Davix_fd *fd, char *buf, Long64_t pos, Int
 
 Long64_t TDavixFile::DavixReadBuffers(Davix_fd *fd, char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 {
-   DavixError *davixErr = NULL;
    Double_t start_time = eventStart();
-   DavIOVecInput in[nbuf];
-   DavIOVecOuput out[nbuf];
 
-   int lastPos = 0;
+   // Coalesce the buffers separated by at most readvGap bytes in one range,
+   // read in a scratch buffer if it holds several of them
+   struct ReadRange {
+      Long64_t fPos;
+      Long64_t fLen;
+      Int_t fFirst;   // first buffer of the range
+      Int_t fLast;    // last buffer of the range
+      char *fBuffer;  // where the range is read
+   };
+   std::vector<ReadRange> ranges;
+   std::vector<Long64_t> bufOffset(nbuf);
+   Long64_t total = 0, scratchSize = 0;
    for (Int_t i = 0; i < nbuf; ++i) {
-      in[i].diov_buffer = &buf[lastPos];
-      in[i].diov_offset = pos[i];
-      in[i].diov_size = len[i];
-      lastPos += len[i];
+      bufOffset[i] = total;
+      total += len[i];
+      if (!ranges.empty()) {
+         ReadRange &last = ranges.back();
+         Long64_t end = last.fPos + last.fLen;
+         if (pos[i] >= end && pos[i] - end <= d_ptr->readvGap) {
+            if (last.fFirst == last.fLast)
+               scratchSize += last.fLen;
+            scratchSize += pos[i] + len[i] - end;
+            last.fLen = pos[i] + len[i] - last.fPos;
+            last.fLast = i;
+            continue;
+         }
+      }
+      ranges.push_back({pos[i], len[i], i, i, nullptr});
+   }
+   std::vector<char> scratch(scratchSize);
+   Long64_t scratchOffset = 0;
+   for (auto &range : ranges) {
+      if (range.fFirst == range.fLast) {
+         range.fBuffer = buf + bufOffset[range.fFirst];
+      } else {
+         range.fBuffer = scratch.data() + scratchOffset;
+         scratchOffset += range.fLen;
+      }
    }
 
-   Long64_t ret = d_ptr->davixPosix->preadVec(fd, in, out, nbuf, &davixErr);
-   if (ret < 0) {
-      Error("DavixReadBuffers", "can not read data with davix: %s (%d)",
-            davixErr->getErrMsg().c_str(), davixErr->getStatus());
-      DavixError::clearError(&davixErr);
-   } else {
-      eventStop(start_time, ret);
+   // Split the ranges in groups of similar sizes, read concurrently by
+   // several descriptors of the file, each group being one multi-range request
+   const Long64_t minGroupSize = 256 * 1024;
+   Int_t nGroups = std::max(1, std::min(d_ptr->readvParallel, (Int_t)(total / minGroupSize)));
+   nGroups = std::min(nGroups, (Int_t)ranges.size());
+   std::vector<size_t> groupBegin(1, 0);
+   Long64_t groupBytes = 0;
+   for (size_t r = 0; r < ranges.size() && (Int_t)groupBegin.size() < nGroups; ++r) {
+      groupBytes += ranges[r].fLen;
+      if (groupBytes >= total / nGroups && r + 1 < ranges.size()) {
+         groupBegin.push_back(r + 1);
+         groupBytes = 0;
+      }
+   }
+   groupBegin.push_back(ranges.size());
+   nGroups = groupBegin.size() - 1;
+
+   std::vector<Long64_t> results(nGroups, -1);
+   std::vector<std::string> errors(nGroups);
+   auto readGroup = [&](Davix_fd *groupFd, Int_t g) {
+      const size_t n = groupBegin[g + 1] - groupBegin[g];
+      std::vector<DavIOVecInput> in(n);
+      std::vector<DavIOVecOuput> out(n);
+      for (size_t k = 0; k < n; ++k) {
+         const ReadRange &range = ranges[groupBegin[g] + k];
+         in[k].diov_buffer = range.fBuffer;
+         in[k].diov_offset = range.fPos;
+         in[k].diov_size = range.fLen;
+      }
+      DavixError *davixErr = NULL;
+      results[g] = d_ptr->davixPosix->preadVec(groupFd, in.data(), out.data(), n, &davixErr);
+      if (results[g] < 0) {
+         errors[g] = davixErr ? davixErr->getErrMsg() : "unknown error";
+         DavixError::clearError(&davixErr);
+      }
+   };
+
+   std::vector<Davix_fd *> fds(nGroups, fd);
+   std::vector<std::thread> threads;
+   for (Int_t g = 1; g < nGroups; ++g) {
+      fds[g] = d_ptr->acquireReadFd();
+      if (fds[g])
+         threads.emplace_back(readGroup, fds[g], g);
+   }
+   readGroup(fd, 0);
+   for (auto &thread : threads)
+      thread.join();
+   for (Int_t g = 1; g < nGroups; ++g) {
+      if (fds[g])
+         d_ptr->releaseReadFd(fds[g]);
+      else
+         readGroup(fd, g); // no extra descriptor: read it sequentially
    }
 
-   return ret;
+   for (Int_t g = 0; g < nGroups; ++g) {
+      if (results[g] < 0) {
+         Error("DavixReadBuffers", "can not read data with davix: %s", errors[g].c_str());
+         return -1;
+      }
+   }
+
+   // Copy the coalesced buffers to their place
+   for (const auto &range : ranges) {
+      if (range.fFirst == range.fLast)
+         continue;
+      for (Int_t i = range.fFirst; i <= range.fLast; ++i)
+         memcpy(buf + bufOffset[i], range.fBuffer + (pos[i] - range.fPos), len[i]);
+   }
+
+   eventStop(start_time, total);
+   return total;
 }
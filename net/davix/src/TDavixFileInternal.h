@@ -65,7 +65,9 @@ private:
       fUrl(mUrl),
       opt(mopt),
       oflags(0),
-      dirdVec() { }
+      dirdVec(),
+      readvGap(16 * 1024),
+      readvParallel(4) { }
 
    TDavixFileInternal(const char* url, Option_t* mopt) :
       positionLock(),
@@ -77,7 +79,9 @@ private:
       fUrl(url),
       opt(mopt),
       oflags(0),
-      dirdVec() { }
+      dirdVec(),
+      readvGap(16 * 1024),
+      readvParallel(4) { }
 
    ~TDavixFileInternal();
 
@@ -95,6 +99,10 @@ private:
 
    Davix_fd * Open();
 
+   Davix_fd *acquireReadFd();
+
+   void releaseReadFd(Davix_fd *fd);
+
    void Close();
 
    void enableGridMode();
@@ -138,6 +146,13 @@ private:
    int oflags;
    std::vector<void*> dirdVec;
 
+   // parallel vector reads
+   TMutex readFdsLock;
+   std::vector<Davix_fd*> readFds; // idle extra descriptors of the file
+   std::vector<Davix_fd*> allReadFds;
+   long long readvGap;             // max distance in bytes of coalesced ranges
+   int readvParallel;              // max number of concurrent range requests
+
 public:
    Int_t DavixStat(const char *url, struct stat *st);
 
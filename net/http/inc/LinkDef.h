@@ -7,6 +7,7 @@
 #pragma link C++ class THttpEngine;
 #pragma link C++ class THttpWSEngine;
 #pragma link C++ class THttpWSHandler;
+#pragma link C++ class THttpHistWSHandler;
 #pragma link C++ class TFastCgi;
 #pragma link C++ class TCivetweb;
 #pragma link C++ class THttpLongPollEngine;
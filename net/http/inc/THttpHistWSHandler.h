@@ -0,0 +1,72 @@
+// $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THttpHistWSHandler
+#define ROOT_THttpHistWSHandler
+
+#include "THttpWSHandler.h"
+
+#include <string>
+#include <vector>
+
+class TH1;
+class TTimer;
+
+class THttpHistWSHandler : public THttpWSHandler {
+
+protected:
+   /** State of the histogram known by one client */
+   struct TClientState {
+      UInt_t fWSId{0};                 ///<! websocket id of the client
+      std::vector<Double_t> fContents; ///<! bin contents last sent
+      std::vector<Double_t> fErrors;   ///<! bin errors last sent
+      std::vector<Double_t> fStats;    ///<! statistics last sent
+      Bool_t fFull{kTRUE};             ///<! next update must contain all bins
+   };
+
+   TH1 *fHist{nullptr};                ///<! monitored histogram
+   Long_t fInterval{1000};             ///<! minimal interval between two updates, in ms
+   TTimer *fTimer{nullptr};            ///<! timer sending the updates in the main thread
+   std::vector<TClientState> fClients; ///<! connected clients
+   ULong64_t fNUpdates{0};             ///<! number of updates sent
+   ULong64_t fBytesSent{0};            ///<! number of bytes sent
+
+   void SendUpdate(TClientState &client);
+
+public:
+   THttpHistWSHandler(const char *name, TH1 *hist, Long_t interval = 1000);
+   virtual ~THttpHistWSHandler();
+
+   /** returns monitored histogram */
+   TH1 *GetHist() const { return fHist; }
+
+   void SetInterval(Long_t milliSec);
+
+   /** returns minimal interval between two updates, in ms */
+   Long_t GetInterval() const { return fInterval; }
+
+   /** returns number of updates sent to the clients */
+   ULong64_t GetNUpdates() const { return fNUpdates; }
+
+   /** returns number of bytes sent to the clients */
+   ULong64_t GetBytesSent() const { return fBytesSent; }
+
+   void SendUpdates();
+
+   virtual Bool_t ProcessWS(THttpCallArg *arg);
+
+   virtual Bool_t HandleTimer(TTimer *timer);
+
+   virtual void RecursiveRemove(TObject *obj);
+
+   ClassDef(THttpHistWSHandler, 0) // websocket handler sending the changed bins of a histogram
+};
+
+#endif
@@ -20,7 +20,9 @@
 
 #include "THttpCallArg.h"
 
+#include <map>
 #include <mutex>
+#include <string>
 
 class THttpEngine;
 class THttpTimer;
@@ -50,9 +52,29 @@ protected:
    std::mutex fMutex; ///<! mutex to protect list with arguments
    TList fCallArgs;   ///<! submitted arguments
 
+   /** Reply to a read-only request, kept to serve identical requests */
+   struct TSnapshot {
+      TString fContentType; ///<! content type of the reply
+      TString fHeader;      ///<! header of the reply
+      TString fContent;     ///<! text content of the reply
+      std::string fBinData; ///<! binary content of the reply
+      Int_t fZipping{0};    ///<! zipping kind of the reply
+      Long64_t fTime{0};    ///<! time when the reply was produced, in ms
+   };
+
+   Long_t fSnapshotTime{0};                      ///<! validity of the snapshots in ms, 0 - disabled
+   std::mutex fSnapshotMutex;                    ///<! mutex to protect the snapshots
+   std::map<std::string, TSnapshot> fSnapshots;  ///<! snapshots of the replies, per request
+
    /** Function called for every processed request */
    virtual void ProcessRequest(THttpCallArg *arg);
 
+   std::string GetSnapshotKey(THttpCallArg *arg) const;
+
+   Bool_t ReplyFromSnapshot(THttpCallArg *arg);
+
+   void StoreSnapshot(THttpCallArg *arg);
+
    static Bool_t VerifyFilePath(const char *fname);
 
 public:
@@ -104,6 +126,13 @@ public:
 
    void SetTimer(Long_t milliSec = 100, Bool_t mode = kTRUE);
 
+   void SetSnapshotTime(Long_t milliSec);
+
+   /** returns validity of the snapshots of the replies in ms, 0 when disabled */
+   Long_t GetSnapshotTime() const { return fSnapshotTime; }
+
+   void ClearSnapshots();
+
    /** Check if file is requested, thread safe */
    Bool_t IsFileRequested(const char *uri, TString &res) const;
 
@@ -121,6 +121,7 @@ protected:
    TList *fSinfo;        ///<! last produced streamer info
    Bool_t fReadOnly; ///<! indicate if sniffer allowed to change ROOT structures - for instance, read objects from files
    Bool_t fScanGlobalDir;          ///<! when enabled (default), scan gROOT for histograms, canvases, open files
+   Bool_t fScanPerfCounters;       ///<! when enabled (default), show the ROOT::TPerfCounters in the PerfCounters folder
    THttpCallArg *fCurrentArg;      ///<! current http arguments (if any)
    Int_t fCurrentRestrict;         ///<! current restriction for last-found object
    TString fCurrentAllowedMethods; ///<! list of allowed methods, extracted when analyzed object restrictions
@@ -178,6 +179,9 @@ public:
    /** When enabled (default), sniffer scans gROOT for files, canvases, histograms */
    void SetScanGlobalDir(Bool_t on = kTRUE) { fScanGlobalDir = on; }
 
+   /** When enabled (default), sniffer shows the ROOT::TPerfCounters values in the PerfCounters folder */
+   void SetScanPerfCounters(Bool_t on = kTRUE) { fScanPerfCounters = on; }
+
    void SetAutoLoad(const char *scripts = "");
 
    const char *GetAutoLoad() const;
@@ -185,6 +189,9 @@ public:
    /** Returns true when sniffer allowed to scan global directories */
    Bool_t IsScanGlobalDir() const { return fScanGlobalDir; }
 
+   /** Returns true when sniffer shows the ROOT::TPerfCounters values */
+   Bool_t IsScanPerfCounters() const { return fScanPerfCounters; }
+
    Bool_t RegisterObject(const char *subfolder, TObject *obj);
 
    Bool_t UnregisterObject(TObject *obj);
@@ -0,0 +1,235 @@
+// $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "THttpHistWSHandler.h"
+
+#include "THttpCallArg.h"
+#include "TH1.h"
+#include "TROOT.h"
+#include "TTimer.h"
+#include "Bytes.h"
+
+#include <cstring>
+
+/////////////////////////////////////////////////////////////////////////
+///
+/// THttpHistWSHandler
+///
+/// Websocket handler sending to its clients the changes of a histogram
+/// (TH1, TH2, TH3 or profile), instead of the complete object.
+/// Register it to running THttpServer:
+///
+///        THttpServer *server = new THttpServer("http:8090");
+///        server->Register("/monitor", new THttpHistWSHandler("hpxpy_ws", hpxpy, 500));
+///
+/// and connect from JavaScript with
+///
+///        var ws = new WebSocket("ws://hostname:8090/monitor/hpxpy_ws/root.websocket")
+///
+/// At most every interval ms (default 1000), in the main ROOT thread, each client
+/// receives a binary message with the bins which changed since the previous message
+/// sent to it, if any. First message, and each one for which it is shorter, contains
+/// all bins. All values are in network byte order (big endian):
+///
+///     UChar_t  kind         0 - all bins, 1 - changed bins only
+///     UChar_t  witherrors   1 if bin errors are sent
+///     UShort_t nstats       number of statistics values
+///     UInt_t   ncells       number of cells of the histogram, including under/overflows
+///     UInt_t   nbins        number of bins in the message
+///     Double_t entries
+///     Double_t stats[nstats]    as filled by TH1::GetStats()
+///     for kind 0: Double_t contents[ncells], and Double_t errors[ncells] if witherrors
+///     for kind 1: nbins times UInt_t bin, Double_t content, and Double_t error if witherrors
+///
+/// The client can send the text "full" to request all bins in the next message.
+///
+///////////////////////////////////////////////////////////////////////////
+
+ClassImp(THttpHistWSHandler);
+
+////////////////////////////////////////////////////////////////////////////////
+/// constructor
+/// Histogram must exist as long as the handler is used, or be deleted
+/// with the handler still registered in the list of cleanups
+
+THttpHistWSHandler::THttpHistWSHandler(const char *name, TH1 *hist, Long_t interval)
+   : THttpWSHandler(name, hist ? hist->GetTitle() : ""), fHist(hist), fInterval(interval > 0 ? interval : 1)
+{
+   if (fHist)
+      fHist->SetBit(kMustCleanup);
+   gROOT->GetListOfCleanups()->Add(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// destructor
+
+THttpHistWSHandler::~THttpHistWSHandler()
+{
+   delete fTimer;
+   gROOT->GetListOfCleanups()->Remove(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set minimal interval between two updates sent to a client
+
+void THttpHistWSHandler::SetInterval(Long_t milliSec)
+{
+   fInterval = milliSec > 0 ? milliSec : 1;
+   if (fTimer)
+      fTimer->SetTime(fInterval);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process websocket requests: register and unregister the clients
+
+Bool_t THttpHistWSHandler::ProcessWS(THttpCallArg *arg)
+{
+   if (arg->IsMethod("WS_CONNECT"))
+      return fHist != nullptr;
+
+   if (arg->IsMethod("WS_READY")) {
+      TClientState client;
+      client.fWSId = arg->GetWSId();
+      fClients.push_back(client);
+      SendUpdate(fClients.back());
+      if (!fTimer) {
+         fTimer = new TTimer(this, fInterval, kTRUE);
+         fTimer->TurnOn();
+      }
+      return kTRUE;
+   }
+
+   if (arg->IsMethod("WS_CLOSE")) {
+      for (auto iter = fClients.begin(); iter != fClients.end(); ++iter)
+         if (iter->fWSId == arg->GetWSId()) {
+            fClients.erase(iter);
+            break;
+         }
+      if (fClients.empty() && fTimer)
+         fTimer->TurnOff();
+      return kTRUE;
+   }
+
+   if (arg->IsMethod("WS_DATA")) {
+      if (arg->GetPostDataAsString() == "full")
+         for (auto &client : fClients)
+            if (client.fWSId == arg->GetWSId())
+               client.fFull = kTRUE;
+      return kTRUE;
+   }
+
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Send the changes of the histogram to all clients
+
+void THttpHistWSHandler::SendUpdates()
+{
+   // forget clients whose connection was closed
+   for (auto iter = fClients.begin(); iter != fClients.end();)
+      if (HasWS(iter->fWSId))
+         ++iter;
+      else
+         iter = fClients.erase(iter);
+
+   for (auto &client : fClients)
+      SendUpdate(client);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Send the changes of the histogram since the previous update to one client
+
+void THttpHistWSHandler::SendUpdate(TClientState &client)
+{
+   if (!fHist || !HasWS(client.fWSId))
+      return;
+
+   const Int_t ncells = fHist->GetNcells();
+   const Bool_t witherrors = fHist->GetSumw2N() > 0;
+   std::vector<Double_t> stats(TH1::kNstat, 0.);
+   fHist->GetStats(stats.data());
+   const Double_t entries = fHist->GetEntries();
+
+   if ((Int_t)client.fContents.size() != ncells || (witherrors != !client.fErrors.empty()))
+      client.fFull = kTRUE;
+
+   std::vector<UInt_t> changed;
+   if (!client.fFull) {
+      for (Int_t bin = 0; bin < ncells; ++bin)
+         if ((fHist->GetBinContent(bin) != client.fContents[bin]) ||
+             (witherrors && (fHist->GetBinError(bin) != client.fErrors[bin])))
+            changed.push_back(bin);
+      if (changed.empty() && (stats == client.fStats))
+         return;
+      // list of changed bins should not be longer than all bins
+      if (changed.size() * (sizeof(UInt_t) + sizeof(Double_t)) > ncells * sizeof(Double_t))
+         client.fFull = kTRUE;
+   }
+
+   const UInt_t nbins = client.fFull ? ncells : changed.size();
+   const Int_t valsize = (witherrors ? 2 : 1) * sizeof(Double_t);
+   std::string msg(2 * sizeof(UChar_t) + sizeof(UShort_t) + 2 * sizeof(UInt_t) + (1 + stats.size()) * sizeof(Double_t) +
+                      nbins * (valsize + (client.fFull ? 0 : sizeof(UInt_t))),
+                   '\0');
+   char *buf = &msg[0];
+   tobuf(buf, (UChar_t)(client.fFull ? 0 : 1));
+   tobuf(buf, (UChar_t)(witherrors ? 1 : 0));
+   tobuf(buf, (UShort_t)stats.size());
+   tobuf(buf, (UInt_t)ncells);
+   tobuf(buf, nbins);
+   tobuf(buf, entries);
+   for (auto stat : stats)
+      tobuf(buf, stat);
+
+   client.fContents.resize(ncells);
+   client.fErrors.resize(witherrors ? ncells : 0);
+   if (client.fFull) {
+      for (Int_t bin = 0; bin < ncells; ++bin)
+         tobuf(buf, client.fContents[bin] = fHist->GetBinContent(bin));
+      if (witherrors)
+         for (Int_t bin = 0; bin < ncells; ++bin)
+            tobuf(buf, client.fErrors[bin] = fHist->GetBinError(bin));
+   } else {
+      for (auto bin : changed) {
+         tobuf(buf, bin);
+         tobuf(buf, client.fContents[bin] = fHist->GetBinContent(bin));
+         if (witherrors)
+            tobuf(buf, client.fErrors[bin] = fHist->GetBinError(bin));
+      }
+   }
+   client.fStats = stats;
+   client.fFull = kFALSE;
+
+   SendWS(client.fWSId, msg.data(), msg.length());
+   fNUpdates++;
+   fBytesSent += msg.length();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Timer handler, sends the updates to the clients
+
+Bool_t THttpHistWSHandler::HandleTimer(TTimer *)
+{
+   SendUpdates();
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the histogram when it is deleted
+
+void THttpHistWSHandler::RecursiveRemove(TObject *obj)
+{
+   if (obj && (obj == fHist)) {
+      fHist = nullptr;
+      if (fTimer)
+         fTimer->TurnOff();
+   }
+}
@@ -20,6 +20,7 @@
 #include "TClass.h"
 #include "TCanvas.h"
 #include "TFolder.h"
+#include "TPerfCounters.h"
 #include "RVersion.h"
 #include "RConfigure.h"
 #include "TRegexp.h"
@@ -31,6 +32,7 @@
 #include "TRootSniffer.h"
 #include "TRootSnifferStore.h"
 
+#include <chrono>
 #include <string>
 #include <cstdlib>
 #include <stdlib.h>
@@ -99,6 +101,16 @@ public:
 // enable monitoring flag in the browser - than objects view            //
 // will be regularly updated.                                           //
 //                                                                      //
+// When many clients monitor the same objects, the replies to read-only //
+// requests can be kept for some time with SetSnapshotTime(): identical //
+// requests are then served by the http threads from the snapshot,      //
+// without waiting for the main thread and without producing the reply  //
+// again.                                                               //
+//                                                                      //
+// The throughput counters of ROOT::TPerfCounters are shown in the      //
+// PerfCounters folder, and given in the Prometheus text format at the  //
+// address "http://localhost:8080/metrics".                             //
+//                                                                      //
 // More information: https://root.cern/root/htmldoc/guides/HttpServer/HttpServer.html  //
 //                                                                      //
 //////////////////////////////////////////////////////////////////////////
@@ -127,6 +139,7 @@ ClassImp(THttpServer);
 ///     noglobal       - disable scan of global lists
 ///     cors           - enable CORS header with origin="*"
 ///     cors=domain    - enable CORS header with origin="domain"
+///     snapshot=ms    - keep the replies to read-only requests during ms milliseconds, see SetSnapshotTime()
 ///
 /// For example, create http server, which allows cors headers and disable scan of global lists,
 /// one should provide "http:8080;cors;noglobal" as parameter
@@ -194,6 +207,8 @@ THttpServer::THttpServer(const char *engine)
             SetCors(opt + 5);
          } else if (strcmp(opt, "cors") == 0) {
             SetCors("*");
+         } else if (strncmp(opt, "snapshot=", 9) == 0) {
+            SetSnapshotTime(TString(opt + 9).Atoi());
          } else
             CreateEngine(opt);
       }
@@ -506,6 +521,10 @@ Bool_t THttpServer::ExecuteHttp(THttpCallArg *arg)
    if (fTerminated)
       return kFALSE;
 
+   // replies available in snapshot do not need the main thread
+   if (ReplyFromSnapshot(arg))
+      return kTRUE;
+
    if ((fMainThrdId != 0) && (fMainThrdId == TThread::SelfId())) {
       // should not happen, but one could process requests directly without any signaling
 
@@ -543,6 +562,12 @@ Bool_t THttpServer::SubmitHttp(THttpCallArg *arg, Bool_t can_run_immediately, Bo
       return kFALSE;
    }
 
+   if (can_run_immediately && ReplyFromSnapshot(arg)) {
+      if (ownership)
+         delete arg;
+      return kTRUE;
+   }
+
    if (can_run_immediately && (fMainThrdId != 0) && (fMainThrdId == TThread::SelfId())) {
       ProcessRequest(arg);
       if (ownership)
@@ -592,7 +617,9 @@ void THttpServer::ProcessRequests()
       fSniffer->SetCurrentCallArg(arg);
 
       try {
-         ProcessRequest(arg);
+         // identical request may be processed while this one was waiting
+         if (!ReplyFromSnapshot(arg))
+            ProcessRequest(arg);
          fSniffer->SetCurrentCallArg(nullptr);
       } catch (...) {
          fSniffer->SetCurrentCallArg(nullptr);
@@ -807,6 +834,10 @@ void THttpServer::ProcessRequest(THttpCallArg *arg)
          topname = arg->fTopName.Data();
       fSniffer->ScanHierarchy(topname, arg->fPathName.Data(), &store);
       arg->SetJson();
+   } else if ((filename == "metrics") && arg->fPathName.IsNull()) {
+      // ROOT::TPerfCounters in the Prometheus text format, never taken from a snapshot
+      arg->fContent = ROOT::TPerfCounters::FormatPrometheus().c_str();
+      arg->SetContentType("text/plain; version=0.0.4");
    } else if (filename == "root.websocket") {
       // handling of web socket
 
@@ -924,6 +955,135 @@ void THttpServer::ProcessRequest(THttpCallArg *arg)
    // potentially add cors header
    if (IsCors())
       arg->AddHeader("Access-Control-Allow-Origin", GetCors());
+
+   StoreSnapshot(arg);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns key of the snapshot for the request, empty if request is not read-only
+///
+/// Only requests producing representation of objects or of objects hierarchy
+/// (like root.json, root.bin, root.png or h.json) without posted data can be kept.
+/// Includes user name, since access to objects may be restricted per user.
+
+std::string THttpServer::GetSnapshotKey(THttpCallArg *arg) const
+{
+   if (arg->fPostData || (!arg->fMethod.IsNull() && (arg->fMethod != "GET")))
+      return std::string();
+
+   TString filename = arg->fFileName;
+   if (filename.EndsWith(".gz"))
+      filename.Resize(filename.Length() - 3);
+
+   static const char *readonly[] = {"root.json", "root.bin", "root.xml", "root.png", "root.gif", "root.jpeg",
+                                    "h.json",    "h.xml",    "get.xml",  nullptr};
+   Bool_t found = kFALSE;
+   for (const char **name = readonly; *name && !found; ++name)
+      found = (filename == *name);
+   if (!found)
+      return std::string();
+
+   std::string key = arg->fTopName.Data();
+   key.append("\n").append(arg->fUserName.Data());
+   key.append("\n").append(arg->fPathName.Data());
+   key.append("\n").append(arg->fFileName.Data());
+   key.append("\n").append(arg->fQuery.Data());
+   return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill reply of the request from the snapshot, produced less than
+/// fSnapshotTime ms ago. Method can be called from any thread.
+/// Returns kTRUE when reply was found
+
+Bool_t THttpServer::ReplyFromSnapshot(THttpCallArg *arg)
+{
+   if (fSnapshotTime <= 0)
+      return kFALSE;
+
+   std::string key = GetSnapshotKey(arg);
+   if (key.empty())
+      return kFALSE;
+
+   Long64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now().time_since_epoch()).count();
+
+   std::lock_guard<std::mutex> grd(fSnapshotMutex);
+   auto iter = fSnapshots.find(key);
+   if (iter == fSnapshots.end())
+      return kFALSE;
+   const TSnapshot &snap = iter->second;
+   if (now - snap.fTime > fSnapshotTime) {
+      fSnapshots.erase(iter);
+      return kFALSE;
+   }
+
+   arg->fContentType = snap.fContentType;
+   arg->fHeader = snap.fHeader;
+   arg->fZipping = snap.fZipping;
+   if (!snap.fBinData.empty()) {
+      void *bindata = malloc(snap.fBinData.size());
+      memcpy(bindata, snap.fBinData.data(), snap.fBinData.size());
+      arg->SetBinData(bindata, snap.fBinData.size());
+   } else {
+      arg->fContent = snap.fContent;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep reply of the read-only request to serve identical requests
+
+void THttpServer::StoreSnapshot(THttpCallArg *arg)
+{
+   if ((fSnapshotTime <= 0) || arg->Is404() || arg->IsFile() || arg->IsPostponed())
+      return;
+
+   std::string key = GetSnapshotKey(arg);
+   if (key.empty())
+      return;
+
+   TSnapshot snap;
+   snap.fContentType = arg->fContentType;
+   snap.fHeader = arg->fHeader;
+   snap.fZipping = arg->fZipping;
+   if (arg->IsBinData())
+      snap.fBinData.assign((const char *)arg->fBinData, arg->fBinDataLength);
+   else
+      snap.fContent = arg->fContent;
+   snap.fTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+
+   std::lock_guard<std::mutex> grd(fSnapshotMutex);
+   fSnapshots[key] = std::move(snap);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep the replies to read-only requests during specified time
+///
+/// When many clients request the same objects, for instance histograms monitored
+/// in the browser, the replies of the read-only requests (root.json, root.bin,
+/// root.png, h.json and similar) are kept and identical requests received less
+/// than milliSec ms later are served directly in the http threads, without
+/// waiting for the main thread and without producing the reply again.
+/// The clients then see the objects as they were up to milliSec ms ago.
+/// The application can call ClearSnapshots() when it updates the objects.
+/// 0 (default) disables the snapshots.
+
+void THttpServer::SetSnapshotTime(Long_t milliSec)
+{
+   fSnapshotTime = milliSec > 0 ? milliSec : 0;
+   if (fSnapshotTime == 0)
+      ClearSnapshots();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all snapshots of the replies, next requests will be processed again
+
+void THttpServer::ClearSnapshots()
+{
+   std::lock_guard<std::mutex> grd(fSnapshotMutex);
+   fSnapshots.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
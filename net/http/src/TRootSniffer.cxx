@@ -39,6 +39,7 @@
 #include "TDataType.h"
 #include "TBaseClass.h"
 #include "TObjString.h"
+#include "TPerfCounters.h"
 #include "TUrl.h"
 #include "TImage.h"
 #include "RZip.h"
@@ -401,7 +402,8 @@ ClassImp(TRootSniffer);
 
    TRootSniffer::TRootSniffer(const char *name, const char *objpath)
    : TNamed(name, "sniffer of root objects"), fObjectsPath(objpath), fMemFile(0), fSinfo(0), fReadOnly(kTRUE),
-     fScanGlobalDir(kTRUE), fCurrentArg(0), fCurrentRestrict(0), fCurrentAllowedMethods(0), fRestrictions(), fAutoLoad()
+     fScanGlobalDir(kTRUE), fScanPerfCounters(kTRUE), fCurrentArg(0), fCurrentRestrict(0), fCurrentAllowedMethods(0),
+     fRestrictions(), fAutoLoad()
 {
    fRestrictions.SetOwner(kTRUE);
 }
@@ -897,6 +899,21 @@ void TRootSniffer::ScanRoot(TRootSnifferScanRec &rec)
       }
    }
 
+   if (IsScanPerfCounters()) {
+      TRootSnifferScanRec chld;
+      if (chld.GoInside(rec, 0, "PerfCounters", this)) {
+         chld.SetField(item_prop_title, "Throughput counters of ROOT, also at /metrics");
+         for (auto &value : ROOT::TPerfCounters::GetValues()) {
+            TRootSnifferScanRec item;
+            if (!item.GoInside(chld, 0, value.fName.c_str(), this))
+               continue;
+            item.SetField(item_prop_kind, "Text");
+            item.SetField(item_prop_title, value.fHelp.c_str());
+            item.SetField("value", TString::Format("%.15g", value.fValue));
+         }
+      }
+   }
+
    if (IsScanGlobalDir()) {
       ScanCollection(rec, gROOT->GetList());
 
@@ -47,6 +47,7 @@ private:
    char    *fBufCompCur;  //Current position in compressed buffer
    char    *fCompPos;     //Position of fBufCur when message was compressed
    Bool_t   fEvolution;   //True if support for schema evolution required
+   Int_t    fBufCapacity; //Allocated size of the buffer of a received message
 
    static Bool_t fgEvolution;  //True if global support for schema evolution required
 
@@ -60,6 +61,8 @@ private:
 protected:
    TMessage(void *buf, Int_t bufsize);   // only called by T(P)Socket::Recv()
    void SetLength() const;               // only called by T(P)Socket::Send()
+   char *ReuseForRead(Int_t bufsize);    // only called by TSocket::RecvInto()
+   void InitRead();                      // decode header of a received message
 
 public:
    TMessage(UInt_t what = kMESS_ANY, Int_t bufsiz = TBuffer::kInitialSize);
@@ -26,6 +26,8 @@
 #include "TUrl.h"
 #include "TSystem.h"
 
+#include <vector>
+
 class TSocket;
 class TWebSocket;
 
@@ -36,11 +38,12 @@ friend class TWebSocket;
 friend class TWebSystem;
 
 private:
-   TWebFile() : fSocket(0) { }
+   TWebFile() : fSocket(0), fSocketClean(kFALSE) { }
 
 protected:
    mutable Long64_t  fSize;             // file size
    TSocket          *fSocket;           // socket for HTTP/1.1 (stays alive between calls)
+   Bool_t            fSocketClean;      //! no response pending on fSocket, it can be reused by another request
    TUrl              fProxy;            // proxy URL
    Bool_t            fHasModRoot;       // true if server has mod_root installed
    Bool_t            fHTTP11;           // true if server support HTTP/1.1
@@ -67,8 +70,13 @@ protected:
    virtual Int_t       GetFromWeb(char *buf, Int_t len, const TString &msg);
    virtual Int_t       GetFromWeb10(char *buf, Int_t len, const TString &msg, Int_t nseg = 0, Long64_t *seg_pos = 0, Int_t *seg_len = 0);
    virtual Int_t       GetFromCache(char *buf, Int_t len, Int_t nseg, Long64_t *seg_pos, Int_t *seg_len);
+   Int_t               GetFromWeb10Parallel(char *buf, Int_t len, Long64_t *seg_pos, Int_t *seg_len,
+                                            const std::vector<Int_t> &reqFirst);
+   Int_t               GetRangesFromSocket(TSocket *s, char *buf, const TString &msg, Int_t nseg,
+                                           const Long64_t *seg_pos, const Int_t *seg_len, Bool_t &keepAlive);
    virtual Bool_t      ReadBuffer10(char *buf, Int_t len);
    virtual Bool_t      ReadBuffers10(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
+   TString             GetRangesMsg10(const Long64_t *pos, const Int_t *len, Int_t nbuf) const;
    virtual void        SetMsgReadBuffer10(const char *redirectLocation = 0, Bool_t tempRedirect = kFALSE);
    virtual void        ProcessHttpHeader(const TString& headerLine);
 
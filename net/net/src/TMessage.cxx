@@ -60,6 +60,7 @@ TMessage::TMessage(UInt_t what, Int_t bufsiz) :
    fCompPos    = 0;
    fInfos      = 0;
    fEvolution  = kFALSE;
+   fBufCapacity = 0;
 
    SetBit(kCannotHandleMemberWiseStreaming);
 }
@@ -70,24 +71,67 @@ TMessage::TMessage(UInt_t what, Int_t bufsiz) :
 
 TMessage::TMessage(void *buf, Int_t bufsize) : TBufferFile(TBuffer::kRead, bufsize, buf)
 {
-   // skip space at the beginning of the message reserved for the message length
-   fBufCur += sizeof(UInt_t);
+   fCompress    = 0;
+   fBufComp     = 0;
+   fBufCompCur  = 0;
+   fCompPos     = 0;
+   fInfos       = 0;
+   fEvolution   = kFALSE;
+   fBufCapacity = bufsize;
+
+   InitRead();
+}
 
-   *this >> fWhat;
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare a received message to be reused for receiving a message of
+/// bufsize bytes, length word included. The buffer is kept if large enough.
+/// Returns where the message must be received, after the length word,
+/// or 0 if the message was not created for reading.
+/// This method is only called by TSocket::RecvInto().
 
-   fCompress   = 0;
+char *TMessage::ReuseForRead(Int_t bufsize)
+{
+   if (!IsReading() || !TestBit(kIsOwner))
+      return 0;
+
+   delete [] fBufComp;
    fBufComp    = 0;
    fBufCompCur = 0;
    fCompPos    = 0;
+   delete fInfos;
    fInfos      = 0;
-   fEvolution  = kFALSE;
+   fBitsPIDs.ResetAllBits();
+   ResetMap();
+
+   if (!fBuffer || bufsize > fBufCapacity) {
+      SetBuffer(new char[bufsize], bufsize, kTRUE);
+      fBufCapacity = bufsize;
+   }
+   fBufSize = bufsize;
+   fBufMax  = fBuffer + fBufSize;
+   fBufCur  = fBuffer;
+
+   return fBuffer + sizeof(UInt_t);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decode the header of a message received in the buffer, and uncompress
+/// it if needed.
+
+void TMessage::InitRead()
+{
+   // skip space at the beginning of the message reserved for the message length
+   fBufCur = fBuffer + sizeof(UInt_t);
+
+   *this >> fWhat;
 
    if (fWhat & kMESS_ZIP) {
       // if buffer has kMESS_ZIP set, move it to fBufComp and uncompress
       fBufComp    = fBuffer;
-      fBufCompCur = fBuffer + bufsize;
+      fBufCompCur = fBuffer + fBufSize;
       fBuffer     = 0;
       Uncompress();
+      fBufCapacity = fBufSize;
    }
 
    if (fWhat == kMESS_OBJECT) {
@@ -414,7 +458,19 @@ Int_t TMessage::Uncompress()
    }
 
    fWhat &= ~kMESS_ZIP;
-   fCompress = 1;
+
+   // keep the algorithm of the sender, e.g. to forward or answer the message
+   Int_t algorithm = 0;
+   const char *alg = (const char *)(fBufComp + 3*sizeof(UInt_t));
+   if (alg[0] == 'Z' && alg[1] == 'L')
+      algorithm = ROOT::kZLIB;
+   else if (alg[0] == 'X' && alg[1] == 'Z')
+      algorithm = ROOT::kLZMA;
+   else if (alg[0] == 'L' && alg[1] == '4')
+      algorithm = ROOT::kLZ4;
+   else if (alg[0] == 'Z' && alg[1] == 'S')
+      algorithm = ROOT::kZSTD;
+   fCompress = 100 * algorithm + 1;
 
    return 0;
 }
@@ -820,10 +820,25 @@ Int_t TSocket::Recv(Int_t &status, Int_t &kind)
 /// or reset by peer (EPIPE || ECONNRESET). In those case mess == 0.
 
 Int_t TSocket::Recv(TMessage *&mess)
+{
+   mess = 0;
+   return RecvInto(mess);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Receive a TMessage object, like Recv(TMessage *&), but reusing the
+/// message mess, if not 0, which must have been returned by a previous
+/// call of Recv() or RecvInto(): its buffer is kept for the new message
+/// if large enough, which avoids allocating a new buffer for each of a
+/// series of large messages. The user must delete the TMessage object.
+/// In case of error mess is deleted and set to 0.
+
+Int_t TSocket::RecvInto(TMessage *&mess)
 {
    TSystem::ResetErrno();
 
    if (!IsValid()) {
+      delete mess;
       mess = 0;
       return -1;
    }
@@ -837,19 +852,30 @@ oncemore:
          // Connection closed, reset or broken
          MarkBrokenConnection();
       }
+      delete mess;
       mess = 0;
       return n;
    }
    len = net2host(len);  //from network to host byte order
 
+   char *buf = 0, *content = 0;
+   if (mess && !(content = mess->ReuseForRead(len+sizeof(UInt_t)))) {
+      delete mess;
+      mess = 0;
+   }
+   if (!mess) {
+      buf = new char[len+sizeof(UInt_t)];
+      content = buf+sizeof(UInt_t);
+   }
+
    ResetBit(TSocket::kBrokenConn);
-   char *buf = new char[len+sizeof(UInt_t)];
-   if ((n = gSystem->RecvRaw(fSocket, buf+sizeof(UInt_t), len, 0)) <= 0) {
+   if ((n = gSystem->RecvRaw(fSocket, content, len, 0)) <= 0) {
       if (n == 0 || n == -5) {
          // Connection closed, reset or broken
          MarkBrokenConnection();
       }
       delete [] buf;
+      delete mess;
       mess = 0;
       return n;
    }
@@ -857,15 +883,22 @@ oncemore:
    fBytesRecv  += n + sizeof(UInt_t);
    fgBytesRecv += n + sizeof(UInt_t);
 
-   mess = new TMessage(buf, len+sizeof(UInt_t));
+   if (buf)
+      mess = new TMessage(buf, len+sizeof(UInt_t));
+   else
+      mess->InitRead();
 
-   // receive any streamer infos
-   if (RecvStreamerInfos(mess))
+   // receive any streamer infos (the message is deleted if consumed)
+   if (RecvStreamerInfos(mess)) {
+      mess = 0;
       goto oncemore;
+   }
 
-   // receive any process ids
-   if (RecvProcessIDs(mess))
+   // receive any process ids (the message is deleted if consumed)
+   if (RecvProcessIDs(mess)) {
+      mess = 0;
       goto oncemore;
+   }
 
    if (mess->What() & kMESS_ACK) {
       ResetBit(TSocket::kBrokenConn);
@@ -26,6 +26,8 @@
 #include "TSystem.h"
 #include "TBase64.h"
 #include "TVirtualPerfStats.h"
+#include "TTimeStamp.h"
+#include "TEnv.h"
 #ifdef R__SSL
 #include "TSSLSocket.h"
 #endif
@@ -33,6 +35,15 @@
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
 
 #ifdef WIN32
 # ifndef EADDRINUSE
@@ -49,6 +60,157 @@ TUrl TWebFile::fgProxy;
 
 Long64_t TWebFile::fgMaxFullCacheSize = 500000000;
 
+// Minimum number of bytes of the requests of a ReadBuffers call sent in
+// parallel
+static const Int_t kMinParallelRequestSize = 256 * 1024;
+
+
+// Internal class keeping the idle HTTP/1.1 connections of all the TWebFiles,
+// per server, so that the next requests to the same server, e.g. by the
+// next file opened, do not need a new connection
+class TWebConnectionPool {
+private:
+   std::mutex                                  fMutex;  // protect the pool
+   std::map<std::string, std::list<TSocket *>> fIdle;   // idle connections, per server
+   std::set<std::string>                       fHTTP11; // servers known to support HTTP/1.1
+
+   static std::string GetKey(const TUrl &connurl);
+public:
+   static TWebConnectionPool &Instance();
+   static TSocket *Connect(const TUrl &connurl, const char *host);
+
+   TSocket *Acquire(const TUrl &connurl);
+   void     Release(const TUrl &connurl, TSocket *s);
+   void     SetHTTP11(const TUrl &connurl);
+   Bool_t   IsHTTP11(const TUrl &connurl);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the pool of connections. The pool is never deleted: the sockets
+/// are closed by TROOT at exit.
+
+TWebConnectionPool &TWebConnectionPool::Instance()
+{
+   static TWebConnectionPool *pool = new TWebConnectionPool;
+   return *pool;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The key of the server the connections of connurl go to.
+
+std::string TWebConnectionPool::GetKey(const TUrl &connurl)
+{
+   std::string key = connurl.GetProtocol();
+   key += "://";
+   key += connurl.GetHost();
+   key += ":";
+   key += std::to_string(connurl.GetPort());
+   return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open a new connection to the server of connurl, retrying if the local
+/// address is temporarily unavailable. Returns 0 in case of failure.
+
+TSocket *TWebConnectionPool::Connect(const TUrl &connurl, const char *host)
+{
+   for (Int_t i = 0; i < 5; i++) {
+      TSocket *s = 0;
+      if (strcmp(connurl.GetProtocol(), "https") == 0) {
+#ifdef R__SSL
+         s = new TSSLSocket(connurl.GetHost(), connurl.GetPort());
+#else
+         ::Error("TWebSocket::ReOpen", "library compiled without SSL, https not supported");
+         return 0;
+#endif
+      } else
+         s = new TSocket(connurl.GetHost(), connurl.GetPort());
+
+      if (!s || !s->IsValid()) {
+         delete s;
+         if (gSystem->GetErrno() == EADDRINUSE || gSystem->GetErrno() == EISCONN) {
+            gSystem->Sleep(i*10);
+         } else {
+            ::Error("TWebSocket::ReOpen", "cannot connect to host %s (errno=%d)",
+                    host, gSystem->GetErrno());
+            return 0;
+         }
+      } else
+         return s;
+   }
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Take an idle connection to the server of connurl out of the pool, or
+/// return 0 if there is none. The connections idle for more than
+/// WebFile.KeepAliveTimeout seconds (default 5), which the server has likely
+/// closed, are dropped.
+
+TSocket *TWebConnectionPool::Acquire(const TUrl &connurl)
+{
+   const Double_t timeout = gEnv->GetValue("WebFile.KeepAliveTimeout", 5.);
+   const Double_t now = TTimeStamp().AsDouble();
+   std::list<TSocket *> stale;
+   TSocket *s = 0;
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      std::list<TSocket *> &idle = fIdle[GetKey(connurl)];
+      while (!idle.empty() && !s) {
+         // The most recently used first
+         TSocket *candidate = idle.back();
+         idle.pop_back();
+         if (candidate->IsValid() && now - candidate->GetLastUsage().AsDouble() < timeout)
+            s = candidate;
+         else
+            stale.push_back(candidate);
+      }
+   }
+   for (auto sock : stale)
+      delete sock;
+   return s;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give back a connection with no response pending, for the next requests
+/// to the server of connurl. At most WebFile.MaxIdleConnections (default 4)
+/// are kept per server, the others are closed.
+
+void TWebConnectionPool::Release(const TUrl &connurl, TSocket *s)
+{
+   if (!s)
+      return;
+   const Int_t maxIdle = gEnv->GetValue("WebFile.MaxIdleConnections", 4);
+   if (s->IsValid()) {
+      std::lock_guard<std::mutex> lock(fMutex);
+      std::list<TSocket *> &idle = fIdle[GetKey(connurl)];
+      if ((Int_t)idle.size() < maxIdle) {
+         idle.push_back(s);
+         return;
+      }
+   }
+   delete s;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remember that the server of connurl supports HTTP/1.1: the next files
+/// opened on it use persistent connections from the start.
+
+void TWebConnectionPool::SetHTTP11(const TUrl &connurl)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   fHTTP11.insert(GetKey(connurl));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Whether the server of connurl is known to support HTTP/1.1.
+
+Bool_t TWebConnectionPool::IsHTTP11(const TUrl &connurl)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fHTTP11.count(GetKey(connurl)) ? kTRUE : kFALSE;
+}
+
 
 // Internal class used to manage the socket that may stay open between
 // calls when HTTP/1.1 protocol is used
@@ -98,30 +260,13 @@ void TWebSocket::ReOpen()
    else
       connurl = fWebFile->fUrl;
 
-   for (Int_t i = 0; i < 5; i++) {
-      if (strcmp(connurl.GetProtocol(), "https") == 0) {
-#ifdef R__SSL
-         fWebFile->fSocket = new TSSLSocket(connurl.GetHost(), connurl.GetPort());
-#else
-         ::Error("TWebSocket::ReOpen", "library compiled without SSL, https not supported");
-         return;
-#endif
-      } else
-         fWebFile->fSocket = new TSocket(connurl.GetHost(), connurl.GetPort());
+   // Reuse an idle persistent connection to the same server, if any
+   fWebFile->fSocketClean = kFALSE;
+   if (fWebFile->fHTTP11 &&
+       (fWebFile->fSocket = TWebConnectionPool::Instance().Acquire(connurl)))
+      return;
 
-      if (!fWebFile->fSocket || !fWebFile->fSocket->IsValid()) {
-         delete fWebFile->fSocket;
-         fWebFile->fSocket = 0;
-         if (gSystem->GetErrno() == EADDRINUSE || gSystem->GetErrno() == EISCONN) {
-            gSystem->Sleep(i*10);
-         } else {
-            ::Error("TWebSocket::ReOpen", "cannot connect to host %s (errno=%d)",
-                    fWebFile->fUrl.GetHost(), gSystem->GetErrno());
-            return;
-         }
-      } else
-         return;
-   }
+   fWebFile->fSocket = TWebConnectionPool::Connect(connurl, fWebFile->fUrl.GetHost());
 }
 
 
@@ -143,7 +288,7 @@ ClassImp(TWebFile);
 /// to see if the file is accessible. The preferred interface to this
 /// constructor is via TFile::Open().
 
-TWebFile::TWebFile(const char *url, Option_t *opt) : TFile(url, "WEB"), fSocket(0)
+TWebFile::TWebFile(const char *url, Option_t *opt) : TFile(url, "WEB"), fSocket(0), fSocketClean(kFALSE)
 {
    TString option = opt;
    fNoProxy = kFALSE;
@@ -176,7 +321,7 @@ TWebFile::TWebFile(const char *url, Option_t *opt) : TFile(url, "WEB"), fSocket(
 /// the kZombie bit will be set in the TWebFile object. Use IsZombie()
 /// to see if the file is accessible.
 
-TWebFile::TWebFile(TUrl url, Option_t *opt) : TFile(url.GetUrl(), "WEB"), fSocket(0)
+TWebFile::TWebFile(TUrl url, Option_t *opt) : TFile(url.GetUrl(), "WEB"), fSocket(0), fSocketClean(kFALSE)
 {
    TString option = opt;
    fNoProxy = kFALSE;
@@ -192,11 +337,15 @@ TWebFile::TWebFile(TUrl url, Option_t *opt) : TFile(url.GetUrl(), "WEB"), fSocke
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Cleanup.
+/// Cleanup. A persistent connection with no response pending is kept for
+/// the next TWebFile opened on the same server.
 
 TWebFile::~TWebFile()
 {
-   delete fSocket;
+   if (fSocket && fHTTP11 && fSocketClean)
+      TWebConnectionPool::Instance().Release(fProxy.IsValid() ? fProxy : fUrl, fSocket);
+   else
+      delete fSocket;
    if (fFullCache) {
       free(fFullCache);
       fFullCache = 0;
@@ -213,11 +362,13 @@ void TWebFile::Init(Bool_t readHeadOnly)
    int  err;
 
    fSocket     = 0;
+   fSocketClean = kFALSE;
    fSize       = -1;
    fHasModRoot = kFALSE;
-   fHTTP11     = kFALSE;
    fFullCache  = 0;
    fFullCacheSize = 0;
+   // Talk HTTP/1.1 from the start to the servers known to support it
+   fHTTP11     = TWebConnectionPool::Instance().IsHTTP11(fProxy.IsValid() ? fProxy : fUrl);
    SetMsgReadBuffer10();
 
    if ((err = GetHead()) < 0) {
@@ -510,6 +661,7 @@ Bool_t TWebFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
    }
    TString msg = fMsgReadBuffer;
 
+   const Int_t maxRanges = gEnv->GetValue("WebFile.MaxRanges", 200);
    Int_t k = 0, n = 0, cnt = 0;
    for (Int_t i = 0; i < nbuf; i++) {
       if (n) msg += ",";
@@ -518,7 +670,7 @@ Bool_t TWebFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       msg += len[i];
       n   += len[i];
       cnt++;
-      if ((msg.Length() > 8000) || (cnt >= 200)) {
+      if ((msg.Length() > 8000) || (cnt >= maxRanges)) {
          msg += "\r\n";
          if (GetFromWeb(&buf[k], n, msg) == -1)
             return kTRUE;
@@ -544,34 +696,341 @@ Bool_t TWebFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 /// Note that for nbuf=1, this call is equivalent to TFile::ReafBuffer
 /// This function is overloaded by TNetFile, TWebFile, etc.
 /// Returns kTRUE in case of failure.
+///
+/// The blocks separated by at most WebFile.RangeGap bytes (default 1024)
+/// are merged in a single range, and the ranges are split in requests of at
+/// most WebFile.MaxRanges ranges (default 200). With a HTTP/1.1 server, the
+/// requests of a large read, e.g. a TTreeCache fill, are sent in parallel
+/// over up to WebFile.ParallelRequests connections (default 4).
 
 Bool_t TWebFile::ReadBuffers10(char *buf,  Long64_t *pos, Int_t *len, Int_t nbuf)
 {
    SetMsgReadBuffer10();
 
-   TString msg = fMsgReadBuffer10;
+   // Merge the close blocks, they are then read in a scratch buffer
+   const Long64_t gap = gEnv->GetValue("WebFile.RangeGap", 1024);
+   std::vector<Long64_t> mpos;
+   std::vector<Int_t> mlen;
+   std::vector<Long64_t> moff(nbuf);   // offset of each block in the merged ranges
+   Long64_t total = 0;
+   for (Int_t i = 0; i < nbuf; i++) {
+      if (!mpos.empty()) {
+         const Long64_t end = mpos.back() + mlen.back();
+         if (pos[i] >= end && pos[i] - end <= gap && pos[i] + len[i] - mpos.back() <= kMaxInt) {
+            moff[i] = total + pos[i] - end;
+            mlen.back() = Int_t(pos[i] + len[i] - mpos.back());
+            total += pos[i] + len[i] - end;
+            continue;
+         }
+      }
+      moff[i] = total;
+      mpos.push_back(pos[i]);
+      mlen.push_back(len[i]);
+      total += len[i];
+   }
+   const Bool_t merged = (Int_t)mpos.size() < nbuf;
+   std::unique_ptr<char[]> scratch;
+   char *rbuf = buf;
+   if (merged) {
+      scratch.reset(new char[total]);
+      rbuf = scratch.get();
+      if (gDebug > 0)
+         Info("ReadBuffers10", "%d blocks merged in %d ranges, %lld bytes", nbuf, (Int_t)mpos.size(), total);
+   }
+   const Int_t nseg = mpos.size();
+
+   // Split the ranges in requests, in more of them if they can be sent in
+   // parallel
+   const Int_t maxRanges = gEnv->GetValue("WebFile.MaxRanges", 200);
+   const Int_t nParallel = gEnv->GetValue("WebFile.ParallelRequests", 4);
+   Long64_t reqBytesMax = total;
+   if (fHTTP11 && !fFullCache && nParallel > 1 && total >= 2 * kMinParallelRequestSize)
+      reqBytesMax = std::max<Long64_t>(total / nParallel + 1, kMinParallelRequestSize);
+   auto ndigits = [](Long64_t v) { Int_t d = 1; while (v >= 10) { v /= 10; d++; } return d; };
+   std::vector<Int_t> reqFirst(1, 0);
+   Int_t cnt = 0, msgLength = fMsgReadBuffer10.Length();
+   Long64_t bytes = 0;
+   for (Int_t i = 0; i < nseg; i++) {
+      // the length of the request with the range "first-last,"
+      msgLength += ndigits(mpos[i] + fArchiveOffset) + ndigits(mpos[i] + fArchiveOffset + mlen[i] - 1) + 2;
+      bytes += mlen[i];
+      cnt++;
+      if ((msgLength > 8000) || (cnt >= maxRanges) || (bytes >= reqBytesMax) || (i+1 == nseg)) {
+         reqFirst.push_back(i+1);
+         cnt = 0;
+         bytes = 0;
+         msgLength = fMsgReadBuffer10.Length();
+      }
+   }
+
+   Bool_t done = kFALSE;
+   if (reqFirst.size() > 2 && reqBytesMax < total)
+      done = (GetFromWeb10Parallel(rbuf, total, mpos.data(), mlen.data(), reqFirst) == 0);
+
+   Long64_t k = 0;
+   for (size_t r = 0; !done && r + 1 < reqFirst.size(); r++) {
+      const Int_t first = reqFirst[r], n = reqFirst[r+1] - first;
+      Int_t reqLen = 0;
+      for (Int_t i = first; i < first + n; i++)
+         reqLen += mlen[i];
+      if (fMsgReadBuffer10 == "")
+         SetMsgReadBuffer10();   // reset when the server turned out to support HTTP/1.1
+      TString msg = GetRangesMsg10(&mpos[first], &mlen[first], n);
+      if (GetFromWeb10(&rbuf[k], reqLen, msg, n, &mpos[first], &mlen[first]) == -1)
+         return kTRUE;
+      k += reqLen;
+   }
+
+   if (merged) {
+      for (Int_t i = 0, off = 0; i < nbuf; off += len[i], i++)
+         memcpy(&buf[off], &rbuf[moff[i]], len[i]);
+   }
+
+   return kFALSE;
+}
 
-   Int_t k = 0, n = 0, r, cnt = 0;
+////////////////////////////////////////////////////////////////////////////////
+/// Return the GET request of the nbuf byte ranges described by pos and len.
+
+TString TWebFile::GetRangesMsg10(const Long64_t *pos, const Int_t *len, Int_t nbuf) const
+{
+   TString msg = fMsgReadBuffer10;
    for (Int_t i = 0; i < nbuf; i++) {
-      if (n) msg += ",";
+      if (i) msg += ",";
       msg += pos[i] + fArchiveOffset;
       msg += "-";
       msg += pos[i] + fArchiveOffset + len[i] - 1;
-      n   += len[i];
-      cnt++;
-      if ((msg.Length() > 8000) || (cnt >= 200) || (i+1 == nbuf)) {
-         msg += "\r\n\r\n";
-         r = GetFromWeb10(&buf[k], n, msg, cnt, pos + (i+1-cnt), len + (i+1-cnt));
-         if (r == -1)
+   }
+   msg += "\r\n\r\n";
+   return msg;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the byte ranges of several requests, sent in parallel over up to
+/// WebFile.ParallelRequests persistent connections to a HTTP/1.1 server. The
+/// request r gets the segments reqFirst[r] to reqFirst[r+1]-1, which are
+/// stored one after the other in buf. Only simple responses, with the
+/// requested ranges, are handled: in case of a redirection, an error, or of
+/// any other response, -1 is returned and the caller sends the requests
+/// again with GetFromWeb10(). Returns 0 in case of success.
+
+Int_t TWebFile::GetFromWeb10Parallel(char *buf, Int_t len, Long64_t *seg_pos, Int_t *seg_len,
+                                     const std::vector<Int_t> &reqFirst)
+{
+   const Int_t nreq = reqFirst.size() - 1;
+   const Int_t nParallel = std::min(gEnv->GetValue("WebFile.ParallelRequests", 4), nreq);
+
+   Double_t start = 0;
+   if (gPerfStats) start = TTimeStamp();
+
+   // The connections are opened and given back here, the threads only send
+   // and receive
+   TWebConnectionPool &pool = TWebConnectionPool::Instance();
+   const TUrl connurl = fProxy.IsValid() ? fProxy : fUrl;
+   std::vector<TSocket *> sockets;
+   for (Int_t t = 0; t < nParallel; t++) {
+      TSocket *s = 0;
+      if (t == 0 && fSocket && fSocketClean) {
+         s = fSocket;
+         fSocket = 0;
+      } else if (!(s = pool.Acquire(connurl)))
+         s = TWebConnectionPool::Connect(connurl, fUrl.GetHost());
+      if (!s)
+         break;
+      sockets.push_back(s);
+   }
+   if (sockets.empty())
+      return -1;
+
+   std::vector<TString> msgs(nreq);
+   std::vector<Long64_t> reqOffset(nreq + 1, 0);
+   for (Int_t r = 0; r < nreq; r++) {
+      msgs[r] = GetRangesMsg10(&seg_pos[reqFirst[r]], &seg_len[reqFirst[r]], reqFirst[r+1] - reqFirst[r]);
+      reqOffset[r+1] = reqOffset[r];
+      for (Int_t i = reqFirst[r]; i < reqFirst[r+1]; i++)
+         reqOffset[r+1] += seg_len[i];
+   }
+
+   std::atomic<Int_t> next(0);
+   std::atomic<Bool_t> failed(kFALSE);
+   std::vector<char> keepAlive(sockets.size(), 0);
+   auto work = [&](size_t t) {
+      Bool_t alive = kTRUE;
+      Int_t r;
+      while (alive && !failed && (r = next++) < nreq) {
+         if (GetRangesFromSocket(sockets[t], &buf[reqOffset[r]], msgs[r], reqFirst[r+1] - reqFirst[r],
+                                 &seg_pos[reqFirst[r]], &seg_len[reqFirst[r]], alive) != 0) {
+            failed = kTRUE;
+            alive = kFALSE;
+         }
+      }
+      keepAlive[t] = alive && !failed;
+   };
+   std::vector<std::thread> threads;
+   for (size_t t = 1; t < sockets.size(); t++)
+      threads.emplace_back(work, t);
+   work(0);
+   for (auto &thread : threads)
+      thread.join();
+
+   for (size_t t = 0; t < sockets.size(); t++) {
+      if (!keepAlive[t]) {
+         delete sockets[t];
+      } else if (!fSocket) {
+         fSocket = sockets[t];
+         fSocketClean = kTRUE;
+      } else
+         pool.Release(connurl, sockets[t]);
+   }
+   if (failed || next < nreq) {
+      if (gDebug > 0)
+         Info("GetFromWeb10Parallel", "parallel requests failed, sending them again one by one");
+      return -1;
+   }
+
+   if (gDebug > 0)
+      Info("GetFromWeb10Parallel", "read %d bytes with %d requests over %d connections", len, nreq,
+           (Int_t)sockets.size());
+
+   // collect statistics
+   fBytesRead += len;
+   fReadCalls++;
+#ifdef R__WIN32
+   SetFileBytesRead(GetFileBytesRead() + len);
+   SetFileReadCalls(GetFileReadCalls() + 1);
+#else
+   fgBytesRead += len;
+   fgReadCalls++;
+#endif
+
+   if (gPerfStats)
+      gPerfStats->FileReadEvent(this, len, start);
+
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Send a request of nseg byte ranges on the connection s and receive its
+/// 206 response, single or multipart, in buf, where the segments are stored
+/// one after the other. keepAlive tells if the connection can be used for
+/// other requests afterwards. This is called by the threads of
+/// GetFromWeb10Parallel(): it only uses s and the arguments. Returns -1 in
+/// case of error or of any other response, 0 in case of success.
+
+Int_t TWebFile::GetRangesFromSocket(TSocket *s, char *buf, const TString &msg, Int_t nseg,
+                                    const Long64_t *seg_pos, const Int_t *seg_len, Bool_t &keepAlive)
+{
+   keepAlive = kFALSE;
+   if (s->SendRaw(msg.Data(), msg.Length()) == -1)
+      return -1;
+
+   std::vector<Long64_t> segOffset(nseg + 1, 0);
+   for (Int_t i = 0; i < nseg; i++)
+      segOffset[i+1] = segOffset[i] + seg_len[i];
+   Long64_t received = 0;
+
+   // Store the range [first, last] of the file, read from the socket, in the
+   // segments it covers
+   std::vector<char> part;
+   auto readPart = [&](Long64_t first, Long64_t last) {
+      const Long64_t partLen = last - first + 1;
+      if (partLen <= 0 || partLen > kMaxInt)
+         return kFALSE;
+      for (Int_t i = 0; i < nseg; i++) {
+         if (fArchiveOffset + seg_pos[i] == first && seg_len[i] == partLen) {
+            // The usual case: the part is one of the segments
+            if (s->RecvRaw(&buf[segOffset[i]], partLen) != partLen)
+               return kFALSE;
+            received += partLen;
             return kTRUE;
-         msg = fMsgReadBuffer10;
-         k += n;
-         n = 0;
-         cnt = 0;
+         }
+      }
+      // The server coalesced some ranges
+      part.resize(partLen);
+      if (s->RecvRaw(part.data(), partLen) != partLen)
+         return kFALSE;
+      for (Int_t i = 0; i < nseg; i++) {
+         const Long64_t segFirst = fArchiveOffset + seg_pos[i];
+         const Long64_t from = std::max(first, segFirst);
+         const Long64_t to = std::min(last + 1, segFirst + seg_len[i]);
+         if (from < to) {
+            memcpy(&buf[segOffset[i] + from - segFirst], &part[from - first], to - from);
+            received += to - from;
+         }
+      }
+      return kTRUE;
+   };
+
+   // Parse "bytes first-last/total" of a Content-Range header
+   auto parseRange = [](const char *value, Long64_t &first, Long64_t &last) {
+      Long64_t tot;
+#ifdef R__WIN32
+      return sscanf(value, " bytes %I64d-%I64d/%I64d", &first, &last, &tot) >= 2;
+#else
+      return sscanf(value, " bytes %lld-%lld/%lld", &first, &last, &tot) >= 2;
+#endif
+   };
+
+   char line[8192];
+   Int_t n, code = 0;
+   Bool_t http11 = kFALSE, connClose = kFALSE;
+   TString boundary, boundaryEnd;
+   Long64_t first = -1, last = -1;
+
+   // Status line and headers
+   while ((n = GetLine(s, line, sizeof(line))) > 0) {
+      TString res = line;
+      if (res.BeginsWith("HTTP/1.")) {
+         http11 = res.BeginsWith("HTTP/1.1");
+         code = TString(res(9, 3)).Atoi();
+      } else if (res.BeginsWith("Content-Type: multipart", TString::kIgnoreCase)) {
+         boundary = res(res.Index("boundary=")+9, 1000);
+         if (boundary[0]=='"' && boundary[boundary.Length()-1]=='"') {
+            boundary = boundary(1,boundary.Length()-2);
+         }
+         boundary = "--" + boundary;
+         boundaryEnd = boundary + "--";
+      } else if (res.BeginsWith("Content-Range:", TString::kIgnoreCase)) {
+         if (!parseRange(line + 14, first, last))
+            return -1;
+      } else if (res.BeginsWith("Connection:", TString::kIgnoreCase) &&
+                 res.Contains("close", TString::kIgnoreCase)) {
+         connClose = kTRUE;
       }
    }
+   if (n < 0 || code != 206)
+      return -1;
 
-   return kFALSE;
+   if (boundary == "") {
+      // Single range
+      if (first < 0 || !readPart(first, last))
+         return -1;
+   } else {
+      while (1) {
+         // Skip the new lines before the boundary
+         while ((n = GetLine(s, line, sizeof(line))) == 0) { }
+         if (n < 0)
+            return -1;
+         if (boundaryEnd == line)
+            break;
+         if (boundary != line)
+            return -1;
+         first = -1;
+         while ((n = GetLine(s, line, sizeof(line))) > 0) {
+            if (TString(line).BeginsWith("Content-Range:", TString::kIgnoreCase) &&
+                !parseRange(line + 14, first, last))
+               return -1;
+         }
+         if (n < 0 || first < 0 || !readPart(first, last))
+            return -1;
+      }
+   }
+
+   if (received != segOffset[nseg])
+      return -1;
+
+   keepAlive = http11 && !connClose;
+   return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -693,6 +1152,7 @@ Int_t TWebFile::GetFromWeb10(char *buf, Int_t len, const TString &msg, Int_t nse
    if (gDebug > 0)
       Info("GetFromWeb10", "sending HTTP request:\n%s", msg.Data());
 
+   fSocketClean = kFALSE;
    if (fSocket->SendRaw(msg.Data(), msg.Length()) == -1) {
       Error("GetFromWeb10", "error sending command to host %s", fUrl.GetHost());
       return -1;
@@ -700,6 +1160,7 @@ Int_t TWebFile::GetFromWeb10(char *buf, Int_t len, const TString &msg, Int_t nse
 
    char line[8192];
    Int_t n, ret = 0, nranges = 0, ltot = 0, redirect = 0;
+   Bool_t connClose = kFALSE;
    TString boundary, boundaryEnd;
    Long64_t first = -1, last = -1, tot, fullsize = 0;
    TString redir;
@@ -766,6 +1227,7 @@ Int_t TWebFile::GetFromWeb10(char *buf, Int_t len, const TString &msg, Int_t nse
                      return -1;
                   }
                   fFullCacheSize = fullsize;
+                  fSocketClean = !connClose;
                   return GetFromCache(buf, len, nseg, seg_pos, seg_len);
                }
                // when cache allocation failed, try without cache
@@ -850,6 +1312,7 @@ Int_t TWebFile::GetFromWeb10(char *buf, Int_t len, const TString &msg, Int_t nse
             if (!fHTTP11)
                fMsgReadBuffer10  = "";
             fHTTP11 = kTRUE;
+            TWebConnectionPool::Instance().SetHTTP11(fProxy.IsValid() ? fProxy : fUrl);
          }
          TString scode = res(9, 3);
          Int_t code = scode.Atoi();
@@ -918,6 +1381,9 @@ Int_t TWebFile::GetFromWeb10(char *buf, Int_t len, const TString &msg, Int_t nse
 #else
          sscanf(res.Data(), "Content-Length: %lld", &fullsize);
 #endif
+      } else if (res.BeginsWith("Connection:", TString::kIgnoreCase) &&
+                 res.Contains("close", TString::kIgnoreCase)) {
+         connClose = kTRUE;
       } else if (res.BeginsWith("Location:") && redirect) {
          redir = res(10, 1000);
          if (redirect == 2)   // temp redirect
@@ -948,6 +1414,7 @@ Int_t TWebFile::GetFromWeb10(char *buf, Int_t len, const TString &msg, Int_t nse
             ltot, len, fUrl.GetHost());
       return -1;
    }
+   fSocketClean = !connClose;
 
    // collect statistics
    fBytesRead += len;
@@ -1053,8 +1520,11 @@ Int_t TWebFile::GetHead()
    else
       connurl = fUrl;
 
-   TSocket *s = 0;
-   for (Int_t i = 0; i < 5; i++) {
+   // A HTTP/1.1 request can use, and then give back, a persistent connection
+   Bool_t keepAlive = fHTTP11 && msg.Contains(" HTTP/1.1\r\n");
+   TSocket *s = keepAlive ? TWebConnectionPool::Instance().Acquire(connurl) : 0;
+   Bool_t pooled = s ? kTRUE : kFALSE;
+   for (Int_t i = 0; i < 5 && !s; i++) {
       if (strcmp(connurl.GetProtocol(), "https") == 0) {
 #ifdef R__SSL
          s = new TSSLSocket(connurl.GetHost(), connurl.GetPort());
@@ -1087,20 +1557,29 @@ Int_t TWebFile::GetHead()
    }
 
    if (s->SendRaw(msg.Data(), msg.Length()) == -1) {
-      Error("GetHead", "error sending command to host %s", fUrl.GetHost());
       delete s;
+      if (pooled)
+         return GetHead();
+      Error("GetHead", "error sending command to host %s", fUrl.GetHost());
       return -1;
    }
 
    char line[8192];
-   Int_t n, ret = 0, redirect = 0;
+   Int_t n, ret = 0, redirect = 0, nlines = 0;
    TString redir;
 
    while ((n = GetLine(s, line, sizeof(line))) >= 0) {
       if (n == 0) {
          if (gDebug > 0)
             Info("GetHead", "got all headers");
-         delete s;
+         if (keepAlive && !redirect && !fSocket) {
+            // Keep the connection for the next requests of this file
+            fSocket = s;
+            fSocketClean = kTRUE;
+         } else if (keepAlive) {
+            TWebConnectionPool::Instance().Release(connurl, s);
+         } else
+            delete s;
          if (fBasicUrlOrg != "" && !redirect) {
             // set back to original url in case of temp redirect
             SetMsgReadBuffer10();
@@ -1121,6 +1600,7 @@ Int_t TWebFile::GetHead()
 
       if (gDebug > 0)
          Info("GetHead", "header: %s", line);
+      nlines++;
 
       TString res = line;
       ProcessHttpHeader(res);
@@ -1131,7 +1611,9 @@ Int_t TWebFile::GetHead()
                fMsgReadBuffer10 = "";
             }
             fHTTP11 = kTRUE;
-         }
+            TWebConnectionPool::Instance().SetHTTP11(connurl);
+         } else
+            keepAlive = kFALSE;
          TString scode = res(9, 3);
          Int_t code = scode.Atoi();
          if (code >= 500) {
@@ -1170,6 +1652,9 @@ Int_t TWebFile::GetHead()
       } else if (res.BeginsWith("Content-Length:")) {
          TString slen = res(16, 1000);
          fSize = slen.Atoll();
+      } else if (res.BeginsWith("Connection:", TString::kIgnoreCase) &&
+                 res.Contains("close", TString::kIgnoreCase)) {
+         keepAlive = kFALSE;
       } else if (res.BeginsWith("Location:") && redirect) {
          redir = res(10, 1000);
          if (redirect == 2)   // temp redirect
@@ -1182,6 +1667,11 @@ Int_t TWebFile::GetHead()
 
    delete s;
 
+   // An idle connection closed by the server in the meantime: retry with
+   // another one
+   if (pooled && nlines == 0)
+      return GetHead();
+
    return ret;
 }
 
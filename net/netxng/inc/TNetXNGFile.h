@@ -23,6 +23,7 @@
 
 #include "TFile.h"
 #include "TSemaphore.h"
+#include <vector>
 #ifndef __CLING__
 #include <XrdCl/XrdClFileSystem.hh>
 #endif
@@ -30,6 +31,7 @@
 namespace XrdCl {
    class File;
    class URL;
+   struct ChunkInfo;
 }
 class XrdSysCondVar;
 
@@ -50,13 +52,24 @@ private:
    // if requested
    Int_t                   fReadvIorMax; // Max size of a single readv chunk
    Int_t                   fReadvIovMax; // Max number of readv chunks
+   Int_t                   fReadvParallel; // Max number of vector reads in flight
    Int_t                   fQueryReadVParams;
    TString                 fNewUrl;
+   TString                 fReplicaHosts;  // Hosts of the replicas given with the URL option "replicas"
+   std::vector<XrdCl::File*> fReplicas;    // Replicas the slow vector reads are re-sent to
+   std::vector<Double_t>   fReadvDurations; // Durations of the last vector reads
+   UInt_t                  fReadvDurationsNext; // Oldest duration, replaced by the next one
+   Double_t                fHedgePercentile;    // Percentile of the durations after which a read is hedged
+   Double_t                fHedgeMinDelay;      // Shortest delay before a read is hedged, in seconds
+   Double_t                fHedgeInitialDelay;  // Delay before enough durations are known, in seconds
+   Long64_t                fHedgesSent;    // Number of vector reads re-sent to a replica
+   Long64_t                fHedgesWon;     // Number of them answered by the replica first
 
 public:
    TNetXNGFile() : TFile(),
       fFile(0), fUrl(0), fMode(XrdCl::OpenFlags::None), fInitCondVar(0),
-      fReadvIorMax(0), fReadvIovMax(0) {}
+      fReadvIorMax(0), fReadvIovMax(0), fReadvParallel(1), fReadvDurationsNext(0),
+      fHedgePercentile(95), fHedgeMinDelay(0.05), fHedgeInitialDelay(1), fHedgesSent(0), fHedgesWon(0) {}
    TNetXNGFile(const char *url, Option_t *mode = "", const char *title = "",
                Int_t compress = 1, Int_t netopt = 0, Bool_t parallelopen = kFALSE);
    virtual ~TNetXNGFile();
@@ -75,11 +88,18 @@ public:
    virtual Bool_t   ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
                                 Int_t nbuffs);
    virtual TString  GetNewUrl() { return fNewUrl; }
+   Bool_t           AddReplica(const char *url);
+   Int_t            GetNReplicas() const { return fReplicas.size(); }
+   Long64_t         GetHedgesSent() const { return fHedgesSent; }
+   Long64_t         GetHedgesWon() const { return fHedgesWon; }
 
 private:
    virtual Bool_t IsUseable() const;
    virtual Bool_t GetVectorReadLimits();
    virtual void   SetEnv();
+   void           SetupReplicas();
+   Double_t       GetHedgeDelay() const;
+   Bool_t         HedgedVectorRead(std::vector<std::vector<XrdCl::ChunkInfo> > &chunkLists);
    Int_t ParseOpenMode(Option_t *in, TString &modestr,
                        XrdCl::OpenFlags::Flags &mode, Bool_t assumeRead);
 
@@ -31,11 +31,13 @@ class TNetXNGFileStager: public TFileStager {
 
 private:
    TNetXNGSystem *fSystem; // Used to access filesystem interface
+   TString        fPrefix; // Entry-point server of fSystem, e.g. root://host/
 
 public:
    TNetXNGFileStager(const char *url = "");
    virtual ~TNetXNGFileStager();
 
+   TList *GetStaged(TCollection *pathlist);
    Bool_t IsStaged(const char *path);
    Int_t  Locate(const char *path, TString &endpath);
    Int_t  LocateCollection(TFileCollection *fc, Bool_t addDummyUrl = kFALSE);
@@ -26,6 +26,8 @@
 #include "TMutex.h"
 #include "THashList.h"
 #include <set>
+#include <string>
+#include <vector>
 
 namespace XrdCl {
    class FileSystem;
@@ -44,6 +46,7 @@ private:
    XrdCl::URL        *fUrl;        // URL of this TSystem
    XrdCl::FileSystem *fFileSystem; // Cached for convenience
 
+   static TString GetEndpointUrl(const char *path, const std::string &address);
 #endif
 
 public:
@@ -63,6 +66,11 @@ public:
    virtual Int_t       Stage(const char *path, UChar_t priority);
    virtual Int_t       Stage(TCollection *files, UChar_t priority);
 
+   // Bulk queries, sent asynchronously and in parallel
+   Int_t               GetPathInfo(const std::vector<TString> &paths, std::vector<FileStat_t> &bufs,
+                                   std::vector<Int_t> &rets);
+   Int_t               Locate(const std::vector<TString> &paths, std::vector<TString> &endurls);
+
    ClassDef(TNetXNGSystem, 0)  // ROOT class definition
 };
 
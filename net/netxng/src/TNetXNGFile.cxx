@@ -29,7 +29,13 @@
 #include <XrdCl/XrdClXRootDResponses.hh>
 #include <XrdCl/XrdClDefaultEnv.hh>
 #include <XrdVersion.hh>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <mutex>
 
 //------------------------------------------------------------------------------
 // Open handler for async open requests
@@ -109,9 +115,126 @@ class TAsyncReadvHandler: public XrdCl::ResponseHandler
       TSemaphore                        *fSemaphore;   // Synchronize the responses
 };
 
+//------------------------------------------------------------------------------
+// Open handler of the replicas, which are used once they are open
+////////////////////////////////////////////////////////////////////////////////
+
+class TReplicaOpenHandler: public XrdCl::ResponseHandler
+{
+   public:
+      virtual void HandleResponse(XrdCl::XRootDStatus *status,
+                                  XrdCl::AnyObject    *response)
+      {
+         delete response;
+         delete status;
+         delete this;
+      }
+};
+
+//------------------------------------------------------------------------------
+// State of the vector reads of a hedged ReadBuffers, shared with the handlers
+// of their responses, which may arrive after ReadBuffers returned
+////////////////////////////////////////////////////////////////////////////////
+
+struct THedgedReadvBatch
+{
+   struct TRequest {
+      Int_t       fPending = 0;       // Requests in flight
+      Int_t       fNextReplica = 0;   // Next replica to send the request to
+      Bool_t      fDone = kFALSE;     // A response was copied to the destination
+      Bool_t      fFailed = kFALSE;   // All the requests sent so far failed
+      Bool_t      fWonByReplica = kFALSE;
+      Double_t    fSent = 0;          // Time the last request was sent
+      std::string fError;
+   };
+
+   std::mutex                           fMutex;
+   std::condition_variable              fCond;
+   Bool_t                               fAbandoned = kFALSE; // ReadBuffers returned
+   std::vector<XrdCl::ChunkList>        fChunkLists;         // Destination of the responses
+   std::vector<TRequest>                fLists;
+   std::vector<Double_t>                fDurations;          // Of the successful requests
+};
+
+//------------------------------------------------------------------------------
+// Handler of one request of a hedged vector read: the response is read in a
+// buffer of its own and copied to the destination if it is the first to
+// arrive
+////////////////////////////////////////////////////////////////////////////////
+
+class THedgedReadvHandler: public XrdCl::ResponseHandler
+{
+   public:
+      THedgedReadvHandler(const std::shared_ptr<THedgedReadvBatch> &batch,
+                          size_t index, Bool_t replica, Double_t start):
+         fBatch(batch), fIndex(index), fReplica(replica), fStart(start)
+      {
+         size_t size = 0;
+         for (const auto &chunk : batch->fChunkLists[index])
+            size += chunk.length;
+         fBuffer.reset(new char[size]);
+         char *cursor = fBuffer.get();
+         for (const auto &chunk : batch->fChunkLists[index]) {
+            fChunks.push_back(XrdCl::ChunkInfo(chunk.offset, chunk.length, cursor));
+            cursor += chunk.length;
+         }
+      }
+
+      const XrdCl::ChunkList &GetChunks() const { return fChunks; }
+
+      virtual void HandleResponse(XrdCl::XRootDStatus *status,
+                                  XrdCl::AnyObject    *response)
+      {
+         Double_t now = TTimeStamp();
+         {
+            std::lock_guard<std::mutex> lock(fBatch->fMutex);
+            THedgedReadvBatch::TRequest &list = fBatch->fLists[fIndex];
+            --list.fPending;
+            if (status->IsOK())
+               fBatch->fDurations.push_back(now - fStart);
+            if (!list.fDone && !fBatch->fAbandoned) {
+               if (status->IsOK()) {
+                  const char *cursor = fBuffer.get();
+                  for (auto &chunk : fBatch->fChunkLists[fIndex]) {
+                     memcpy(chunk.buffer, cursor, chunk.length);
+                     cursor += chunk.length;
+                  }
+                  list.fDone = kTRUE;
+                  list.fWonByReplica = fReplica;
+               } else {
+                  list.fError = status->ToStr();
+                  if (list.fPending == 0)
+                     list.fFailed = kTRUE;
+               }
+               fBatch->fCond.notify_all();
+            }
+         }
+         delete response;
+         delete status;
+         delete this;
+      }
+
+   private:
+      std::shared_ptr<THedgedReadvBatch> fBatch;   // Shared with ReadBuffers
+      size_t                             fIndex;   // Index of the vector read
+      Bool_t                             fReplica; // Sent to a replica
+      Double_t                           fStart;   // Time the request was sent
+      std::unique_ptr<char[]>            fBuffer;
+      XrdCl::ChunkList                   fChunks;  // The chunks, read in fBuffer
+};
+
 
 ClassImp(TNetXNGFile);
 
+// Minimum number of bytes of a vector read, when splitting a request
+static const Int_t kReadvMinListSize = 256 * 1024;
+
+// Number of durations of vector reads the hedging delay is computed from
+static const UInt_t kHedgeDurations = 200;
+
+// Number of durations needed before they give the hedging delay
+static const UInt_t kHedgeMinDurations = 20;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor
 ///
@@ -121,6 +244,9 @@ ClassImp(TNetXNGFile);
 /// param compress:     compression level and algorithm
 /// param netopt:       TCP window size in bytes (unused)
 /// param parallelopen: open asynchronously
+///
+/// The URL option "replicas", e.g. "?replicas=host1:1094,host2", gives the
+/// hosts of replicas of the file at the same path, see AddReplica.
 
 TNetXNGFile::TNetXNGFile(const char *url,
                          Option_t   *mode,
@@ -141,12 +267,25 @@ TNetXNGFile::TNetXNGFile(const char *url,
      fUrl = new URL(std::string(urlnoanchor.GetUrl()));
    }
 
+   // The replicas are ours, not the server's
+   URL::ParamsMap params = fUrl->GetParams();
+   URL::ParamsMap::iterator itReplicas = params.find("replicas");
+   if (itReplicas != params.end()) {
+      fReplicaHosts = itReplicas->second.c_str();
+      params.erase(itReplicas);
+      fUrl->SetParams(params);
+   }
+   fReadvDurationsNext = 0;
+   fHedgesSent = 0;
+   fHedgesWon  = 0;
+
    fFile        = new File();
    fInitCondVar = new XrdSysCondVar();
    fUrl->SetProtocol(std::string("root"));
    fQueryReadVParams = 1;
    fReadvIorMax = 2097136;
    fReadvIovMax = 1024;
+   fReadvParallel = 4;
 
    if (ParseOpenMode(mode, fOption, fMode, kTRUE)<0) {
       Error("Open", "could not parse open mode %s", mode);
@@ -206,6 +345,8 @@ TNetXNGFile::TNetXNGFile(const char *url,
 
    // Get the vector read limits
    GetVectorReadLimits();
+
+   SetupReplicas();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -215,6 +356,11 @@ TNetXNGFile::~TNetXNGFile()
 {
    if (IsOpen())
       Close();
+   for (XrdCl::File *replica : fReplicas) {
+      if (replica->IsOpen())
+         replica->Close();
+      delete replica;
+   }
    delete fFile;
    delete fUrl;
    delete fInitCondVar;
@@ -253,6 +399,8 @@ void TNetXNGFile::Init(Bool_t create)
 
    // Get the vector read limits
    GetVectorReadLimits();
+
+   SetupReplicas();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -312,6 +460,104 @@ void TNetXNGFile::Close(const Option_t */*option*/)
       Error("Close", "%s", status.ToStr().c_str());
       MakeZombie();
    }
+   for (XrdCl::File *replica : fReplicas) {
+      if (replica->IsOpen())
+         replica->Close();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a replica of the file, to which the vector reads are re-sent when
+/// they are slow to answer: see ReadBuffers. The replica is opened
+/// asynchronously, in read mode, and used once it is open.
+///
+/// param url: URL of the replica
+/// returns:   kFALSE if the replica could not be opened
+
+Bool_t TNetXNGFile::AddReplica(const char *url)
+{
+   using namespace XrdCl;
+
+   if (fMode != OpenFlags::Read) {
+      Error("AddReplica", "replicas can only be used by files opened in read mode");
+      return kFALSE;
+   }
+
+   File *replica = new File();
+   XRootDStatus status = replica->Open(std::string(url), OpenFlags::Read, Access::None,
+                                       new TReplicaOpenHandler());
+   if (!status.IsOK()) {
+      Error("AddReplica", "%s: %s", url, status.ToStr().c_str());
+      delete replica;
+      return kFALSE;
+   }
+   fReplicas.push_back(replica);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the replicas given with the URL option "replicas" and, if
+/// NetXNG.HedgeLocate is set, the other data servers of the file known to
+/// the redirector it was opened from.
+
+void TNetXNGFile::SetupReplicas()
+{
+   using namespace XrdCl;
+
+   if (!IsUseable() || fMode != OpenFlags::Read)
+      return;
+
+   std::vector<std::string> hosts;
+   TString host;
+   Ssiz_t from = 0;
+   while (fReplicaHosts.Tokenize(host, from, ","))
+      hosts.push_back(host.Data());
+
+#if XrdVNUMBER >= 40000
+   if (gEnv->GetValue("NetXNG.HedgeLocate", 0)) {
+      std::string dataServer;
+      fFile->GetProperty("DataServer", dataServer);
+      FileSystem fs(*fUrl);
+      LocationInfo *info = 0;
+      if (fs.DeepLocate(fUrl->GetPath(), OpenFlags::None, info).IsOK() && info) {
+         for (LocationInfo::Iterator it = info->Begin(); it != info->End(); ++it) {
+            if (dataServer.find(it->GetAddress()) == std::string::npos)
+               hosts.push_back(it->GetAddress());
+         }
+      }
+      delete info;
+   }
+#endif
+
+   for (const std::string &hostPort : hosts) {
+      URL replicaUrl(*fUrl);
+      size_t colon = hostPort.rfind(':');
+      if (colon != std::string::npos && hostPort.find(']', colon) == std::string::npos) {
+         replicaUrl.SetHostName(hostPort.substr(0, colon));
+         replicaUrl.SetPort(atoi(hostPort.c_str() + colon + 1));
+      } else {
+         replicaUrl.SetHostName(hostPort);
+      }
+      AddReplica(replicaUrl.GetURL().c_str());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the time, in seconds, after which a vector read is re-sent to a
+/// replica: the NetXNG.HedgePercentile percentile of the durations of the
+/// last vector reads, at least NetXNG.HedgeMinDelay, or
+/// NetXNG.HedgeInitialDelay as long as too few reads were done.
+
+Double_t TNetXNGFile::GetHedgeDelay() const
+{
+   if (fReadvDurations.size() < kHedgeMinDurations)
+      return fHedgeInitialDelay;
+   std::vector<Double_t> durations(fReadvDurations);
+   size_t rank = size_t(0.01 * fHedgePercentile * (durations.size() - 1) + 0.5);
+   if (rank >= durations.size())
+      rank = durations.size() - 1;
+   std::nth_element(durations.begin(), durations.begin() + rank, durations.end());
+   return std::max(durations[rank], fHedgeMinDelay);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -446,6 +692,16 @@ Bool_t TNetXNGFile::ReadBuffer(char *buffer, Long64_t position, Int_t length)
 ///                 position[i]
 /// param nbuffs:   number of chunks
 /// returns:        kTRUE in case of failure
+///
+/// The chunks are sent in up to NetXNG.ParallelReadV vector reads in flight
+/// at the same time, so that a large request, e.g. a TTreeCache fill, costs
+/// about one round trip at high latency instead of one per vector read.
+///
+/// If the file has replicas, see AddReplica, a vector read which did not
+/// answer within the hedging delay (see GetHedgeDelay) is re-sent to the
+/// next open replica, and so on, and the first answer is taken. A vector
+/// read which failed is likewise re-sent to the next replica. The answers
+/// are then read in buffers of their own and copied.
 
 Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
       Int_t nbuffs)
@@ -458,8 +714,7 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
 
    std::vector<ChunkList>      chunkLists;
    ChunkList                   chunks;
-   std::vector<XRootDStatus*> *statuses;
-   TSemaphore                 *semaphore;
+   Int_t                       chunksBytes = 0;
    Int_t                       totalBytes = 0;
    Long64_t                    offset     = 0;
    char                       *cursor     = buffer;
@@ -471,40 +726,35 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
       for (Int_t i = 0; i < nbuffs; i++)
          position[i] += fArchiveOffset;
 
-   // Build a list of chunks. Put the buffers in the ChunkInfo's
-   for (Int_t i = 0; i < nbuffs; ++i) {
+   for (Int_t i = 0; i < nbuffs; ++i)
       totalBytes += length[i];
 
+   // Size above which a chunk list is closed, for the request to be spread
+   // over fReadvParallel vector reads processed concurrently by the server
+   // and the streams of the channel, without making the vector reads tiny
+   Int_t listBytesMax = totalBytes / (fReadvParallel > 0 ? fReadvParallel : 1) + 1;
+   if (listBytesMax < kReadvMinListSize)
+      listBytesMax = kReadvMinListSize;
+
+   // Build a list of chunks. Put the buffers in the ChunkInfo's
+   for (Int_t i = 0; i < nbuffs; ++i) {
       // If the length is bigger than max readv size, split into smaller chunks
-      if (length[i] > fReadvIorMax) {
-         Int_t nsplit = length[i] / fReadvIorMax;
-         Int_t rem    = length[i] % fReadvIorMax;
-         Int_t j;
-
-         // Add as many max-size chunks as are divisible
-         for (j = 0; j < nsplit; ++j) {
-            offset = position[i] + (j * fReadvIorMax);
-            chunks.push_back(ChunkInfo(offset, fReadvIorMax, cursor));
-            cursor += fReadvIorMax;
+      for (Int_t done = 0; done < length[i]; ) {
+         Int_t size = length[i] - done;
+         if (size > fReadvIorMax)
+            size = fReadvIorMax;
+         offset = position[i] + done;
+         chunks.push_back(ChunkInfo(offset, size, cursor));
+         cursor      += size;
+         done        += size;
+         chunksBytes += size;
+
+         // If there are max chunks or enough bytes, make another chunk list
+         if ((Int_t) chunks.size() >= fReadvIovMax || chunksBytes >= listBytesMax) {
+            chunkLists.push_back(chunks);
+            chunks      = ChunkList();
+            chunksBytes = 0;
          }
-
-         // Add the remainder
-         offset = position[i] + (j * fReadvIorMax);
-         chunks.push_back(ChunkInfo(offset, rem, cursor));
-         cursor += rem;
-      } else {
-         chunks.push_back(ChunkInfo(position[i], length[i], cursor));
-         cursor += length[i];
-      }
-
-      // If there are more than or equal to max chunks, make another chunk list
-      if ((Int_t) chunks.size() == fReadvIovMax) {
-         chunkLists.push_back(chunks);
-         chunks = ChunkList();
-      } else if ((Int_t) chunks.size() > fReadvIovMax) {
-         chunkLists.push_back(ChunkList(chunks.begin(),
-                                        chunks.begin() + fReadvIovMax));
-         chunks = ChunkList(chunks.begin() + fReadvIovMax, chunks.end());
       }
    }
 
@@ -512,48 +762,50 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
    if( !chunks.empty() )
       chunkLists.push_back(chunks);
 
+   // With replicas, the vector reads are hedged instead
+   const Bool_t hedged = !fReplicas.empty();
+   Bool_t failed = hedged && HedgedVectorRead(chunkLists);
+
    TAsyncReadvHandler *handler;
    XRootDStatus        status;
-   semaphore = new TSemaphore(0);
-   statuses  = new std::vector<XRootDStatus*>(chunkLists.size());
-
-   // Read asynchronously but wait for all responses
-   std::vector<ChunkList>::iterator it;
-   for (it = chunkLists.begin(); it != chunkLists.end(); ++it)
-   {
-      handler = new TAsyncReadvHandler(statuses, it - chunkLists.begin(),
-                                       semaphore);
-      status = fFile->VectorRead(*it, 0, handler);
-
-      if (!status.IsOK()) {
-         Error("ReadBuffers", "%s", status.ToStr().c_str());
-         return kTRUE;
+   TSemaphore          semaphore(0);
+   std::vector<XRootDStatus*> statuses(hedged ? 0 : chunkLists.size(), nullptr);
+
+   // Keep up to fReadvParallel vector reads in flight: send a new one each
+   // time a response arrives, and wait for all of them
+   const size_t nInFlightMax = fReadvParallel > 0 ? fReadvParallel : 1;
+   size_t nSent = 0, nDone = 0;
+   while (!hedged && nDone < chunkLists.size()) {
+      while (!failed && nSent < chunkLists.size() && nSent - nDone < nInFlightMax) {
+         handler = new TAsyncReadvHandler(&statuses, nSent, &semaphore);
+         status = fFile->VectorRead(chunkLists[nSent], 0, handler);
+         if (!status.IsOK()) {
+            delete handler;
+            Error("ReadBuffers", "%s", status.ToStr().c_str());
+            failed = kTRUE;
+            break;
+         }
+         ++nSent;
       }
-   }
-
-   // Wait for all responses
-   for (it = chunkLists.begin(); it != chunkLists.end(); ++it) {
-      semaphore->Wait();
+      // Responses, possibly of the failed requests, could still write in the
+      // buffer: always wait for the requests sent
+      if (nDone == nSent)
+         break;
+      semaphore.Wait();
+      ++nDone;
    }
 
    // Check for errors
-   for (it = chunkLists.begin(); it != chunkLists.end(); ++it) {
-      XRootDStatus *st = statuses->at(it - chunkLists.begin());
-
-      if (!st->IsOK()) {
+   for (size_t i = 0; i < nSent; ++i) {
+      XRootDStatus *st = statuses[i];
+      if (!failed && !st->IsOK()) {
          Error("ReadBuffers", "%s", st->ToStr().c_str());
-         for( ; it != chunkLists.end(); ++it )
-         {
-            st = statuses->at( it - chunkLists.begin() );
-            delete st;
-         }
-         delete statuses;
-         delete semaphore;
-
-         return kTRUE;
+         failed = kTRUE;
       }
       delete st;
    }
+   if (failed)
+      return kTRUE;
 
    // Bump the globals
    fBytesRead  += totalBytes;
@@ -569,11 +821,137 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
    if (gMonitoringWriter)
       gMonitoringWriter->SendFileReadProgress(this);
 
-   delete statuses;
-   delete semaphore;
    return kFALSE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Send the vector reads of ReadBuffers, up to NetXNG.ParallelReadV at the
+/// same time, re-sending to the replicas those slower than the hedging delay
+/// or failed, and wait until each of them got an answer.
+///
+/// param chunkLists: the vector reads
+/// returns:          kTRUE in case of failure
+
+Bool_t TNetXNGFile::HedgedVectorRead(std::vector<XrdCl::ChunkList> &chunkLists)
+{
+   using namespace XrdCl;
+
+   std::shared_ptr<THedgedReadvBatch> batch = std::make_shared<THedgedReadvBatch>();
+   batch->fChunkLists = chunkLists;
+   batch->fLists.resize(chunkLists.size());
+   const Double_t delay = GetHedgeDelay();
+   const size_t nInFlightMax = fReadvParallel > 0 ? fReadvParallel : 1;
+
+   std::unique_lock<std::mutex> lock(batch->fMutex);
+
+   // Send the vector read to the file, or to its next open replica
+   auto send = [&](size_t index, Bool_t toReplica) -> Bool_t {
+      THedgedReadvBatch::TRequest &list = batch->fLists[index];
+      File *file = fFile;
+      if (toReplica) {
+         file = 0;
+         while (!file && list.fNextReplica < (Int_t)fReplicas.size()) {
+            if (fReplicas[list.fNextReplica]->IsOpen())
+               file = fReplicas[list.fNextReplica];
+            ++list.fNextReplica;
+         }
+         if (!file)
+            return kFALSE;
+      }
+      Double_t now = TTimeStamp();
+      THedgedReadvHandler *handler = new THedgedReadvHandler(batch, index, toReplica, now);
+      ++list.fPending;
+      list.fFailed = kFALSE;
+      list.fSent = now;
+      // The response may be handled before VectorRead returns
+      lock.unlock();
+      XRootDStatus status = file->VectorRead(handler->GetChunks(), 0, handler);
+      lock.lock();
+      if (!status.IsOK()) {
+         delete handler;
+         --list.fPending;
+         list.fError = status.ToStr();
+         if (list.fPending == 0 && !list.fDone)
+            list.fFailed = kTRUE;
+         return kFALSE;
+      }
+      if (toReplica)
+         ++fHedgesSent;
+      return kTRUE;
+   };
+
+   size_t nSent = 0;
+   Bool_t failed = kFALSE;
+   while (!failed) {
+      size_t nDone = 0, nInFlight = 0;
+      Double_t now = TTimeStamp();
+      Double_t wait = -1;
+      for (size_t i = 0; i < nSent; ++i) {
+         THedgedReadvBatch::TRequest &list = batch->fLists[i];
+         if (list.fDone) {
+            ++nDone;
+            continue;
+         }
+         if (list.fFailed) {
+            // Try the next replica, if any
+            if (!send(i, kTRUE) && list.fFailed) {
+               Error("ReadBuffers", "%s", list.fError.c_str());
+               failed = kTRUE;
+               break;
+            }
+            ++nInFlight;
+            continue;
+         }
+         ++nInFlight;
+         Double_t late = now - list.fSent;
+         if (late >= delay && send(i, kTRUE))
+            late = 0;
+         // Wait until the next hedge, if any replica is left
+         if (list.fNextReplica < (Int_t)fReplicas.size() && (wait < 0 || delay - late < wait))
+            wait = delay - late;
+      }
+      if (failed || nDone == chunkLists.size())
+         break;
+      Bool_t sentNew = kFALSE;
+      while (nSent < chunkLists.size() && nInFlight < nInFlightMax) {
+         if (!send(nSent, kFALSE) && !send(nSent, kTRUE)) {
+            Error("ReadBuffers", "%s", batch->fLists[nSent].fError.c_str());
+            failed = kTRUE;
+            break;
+         }
+         ++nSent;
+         ++nInFlight;
+         sentNew = kTRUE;
+      }
+      if (failed)
+         break;
+      if (sentNew)
+         continue;
+      if (wait < 0)
+         batch->fCond.wait(lock);
+      else
+         batch->fCond.wait_for(lock, std::chrono::duration<Double_t>(wait));
+   }
+
+   // The responses still in flight will be dropped
+   batch->fAbandoned = kTRUE;
+   for (const auto &list : batch->fLists) {
+      if (list.fDone && list.fWonByReplica)
+         ++fHedgesWon;
+   }
+   for (Double_t duration : batch->fDurations) {
+      if (fReadvDurations.size() < kHedgeDurations) {
+         fReadvDurations.push_back(duration);
+      } else {
+         fReadvDurations[fReadvDurationsNext] = duration;
+         fReadvDurationsNext = (fReadvDurationsNext + 1) % kHedgeDurations;
+      }
+   }
+   batch->fDurations.clear();
+
+   return failed;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write a data chunk
 ///
@@ -846,6 +1224,10 @@ void TNetXNGFile::SetEnv()
       env->PutString("ClientMonitorParam", val.Data());
 
    fQueryReadVParams = gEnv->GetValue("NetXNG.QueryReadVParams", 1);
+   fReadvParallel    = gEnv->GetValue("NetXNG.ParallelReadV", 4);
+   fHedgePercentile  = gEnv->GetValue("NetXNG.HedgePercentile", 95.);
+   fHedgeMinDelay    = gEnv->GetValue("NetXNG.HedgeMinDelay", 0.05);
+   fHedgeInitialDelay = gEnv->GetValue("NetXNG.HedgeInitialDelay", 1.);
    env->PutInt( "MultiProtocol", gEnv->GetValue("TFile.CrossProtocolRedirects", 1));
 
    // Old style netrc file
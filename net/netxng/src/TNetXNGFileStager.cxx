@@ -23,10 +23,28 @@
 #include "THashList.h"
 #include "TFileInfo.h"
 #include "TFileCollection.h"
+#include "TObjString.h"
 #include <XrdCl/XrdClFileSystem.hh>
+#include <vector>
 
 ClassImp( TNetXNGFileStager);
 
+namespace {
+   // The entry-point server of a URL, e.g. root://user@host:port/
+   TString GetPrefix(const char *url)
+   {
+      TUrl u(url);
+      TString pfx = Form("%s://", u.GetProtocol());
+      if (strlen(u.GetUser()) > 0)
+         pfx += Form("%s@", u.GetUser());
+      pfx += u.GetHost();
+      if (u.GetPort() != TUrl("root://host").GetPort())
+         pfx += Form(":%d", u.GetPort());
+      pfx += "/";
+      return pfx;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor
 ///
@@ -36,6 +54,8 @@ TNetXNGFileStager::TNetXNGFileStager(const char *url) :
       TFileStager("xrd")
 {
    fSystem = new TNetXNGSystem(url);
+   if (url && strlen(url) > 0)
+      fPrefix = GetPrefix(url);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -46,6 +66,50 @@ TNetXNGFileStager::~TNetXNGFileStager()
    delete fSystem;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Get the list of the staged files, checked with parallel asynchronous stat
+/// requests
+///
+/// param pathlist: list of the paths of the files, as TUrl, TObjString or
+///                 TFileInfo
+/// returns:        the list of the paths of the files staged, as TObjString,
+///                 to be deleted by the caller
+
+TList *TNetXNGFileStager::GetStaged(TCollection *pathlist)
+{
+   if (!pathlist) {
+      Error("GetStaged", "list of pathnames was not specified!");
+      return 0;
+   }
+
+   std::vector<TString> paths;
+   TIter it(pathlist);
+   TObject *object = 0;
+   while ((object = it.Next())) {
+      TString path = TFileStager::GetPathName(object);
+      if (path == "")
+         Warning("GetStaged", "object is of unexpected type %s - ignoring", object->ClassName());
+      else
+         paths.push_back(path);
+   }
+
+   std::vector<FileStat_t> st;
+   std::vector<Int_t> rets;
+   fSystem->GetPathInfo(paths, st, rets);
+
+   TList *stagedlist = new TList();
+   stagedlist->SetOwner(kTRUE);
+   for (size_t i = 0; i < paths.size(); ++i) {
+      if (rets[i] == 0 && !R_ISOFF(st[i].fMode))
+         stagedlist->Add(new TObjString(paths[i]));
+      else if (gDebug > 0)
+         Info("GetStaged", "path '%s' is %s", paths[i].Data(), rets[i] ? "not found" : "offline");
+   }
+
+   Info("GetStaged", "%d files staged", stagedlist->GetSize());
+   return stagedlist;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Check if a file is staged
 ///
@@ -82,7 +146,8 @@ Int_t TNetXNGFileStager::Locate(const char *path, TString &url)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Bulk locate request for a collection of files
+/// Bulk locate request for a collection of files, sent as parallel
+/// asynchronous requests
 ///
 /// param fc:          collection of files to be located
 /// param addDummyUrl: append a dummy noop URL if the file is not staged or
@@ -98,16 +163,25 @@ Int_t TNetXNGFileStager::LocateCollection(TFileCollection *fc,
       return -1;
    }
 
-   int numFiles = 0;
+   // Send the locate requests of all the files, in parallel
+   std::vector<TFileInfo *> infos;
+   std::vector<TString> startUrls, endUrls;
    TFileInfo *info;
    TIter it(fc->GetList());
-   TString startUrl, endUrl;
-
    while ((info = dynamic_cast<TFileInfo *>(it.Next())) != NULL) {
-      startUrl = info->GetCurrentUrl()->GetUrl();
+      infos.push_back(info);
+      startUrls.push_back(info->GetCurrentUrl()->GetUrl());
+   }
+   fSystem->Locate(startUrls, endUrls);
+
+   int numFiles = 0;
+   for (size_t i = 0; i < infos.size(); ++i) {
+      info = infos[i];
+      const TString &startUrl = startUrls[i];
+      const TString &endUrl = endUrls[i];
 
       // File not staged
-      if (fSystem->Locate(startUrl.Data(), endUrl)) {
+      if (endUrl.IsNull()) {
          info->ResetBit(TFileInfo::kStaged);
 
          if (addDummyUrl)
@@ -139,12 +213,17 @@ Int_t TNetXNGFileStager::LocateCollection(TFileCollection *fc,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Returns kTRUE if stager 's' is compatible with current stager. Avoids
-/// multiple instantiations of the potentially the same TNetXNGFileStager.
+/// Returns kTRUE if stager 's' is compatible with current stager, i.e. if the
+/// URL 's' is served by the same entry-point server. Avoids multiple
+/// instantiations of the potentially the same TNetXNGFileStager.
 
 Bool_t TNetXNGFileStager::Matches(const char *s)
 {
-   return ((s && (fName == s)) ? kTRUE : kFALSE);
+   if (!s)
+      return kFALSE;
+   if (fName == s)
+      return kTRUE;
+   return ((!fPrefix.IsNull() && fPrefix == GetPrefix(s)) ? kTRUE : kFALSE);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -25,6 +25,8 @@
 #include "TList.h"
 #include "TUrl.h"
 #include "TVirtualMutex.h"
+#include "TSemaphore.h"
+#include "TEnv.h"
 #include <XrdCl/XrdClFileSystem.hh>
 #include <XrdCl/XrdClXRootDResponses.hh>
 #include <XrdSys/XrdSysDNS.hh>
@@ -58,6 +60,111 @@ namespace
         delete fDirList;
       }
    };
+
+   //---------------------------------------------------------------------------
+   // Response handler of one of the requests of a bulk query: stores the
+   // status and the response at the index of the request and wakes up the
+   // caller
+   /////////////////////////////////////////////////////////////////////////////
+
+   class TBulkQueryHandler: public XrdCl::ResponseHandler {
+   public:
+      TBulkQueryHandler(std::vector<XrdCl::XRootDStatus *> *statuses,
+                        std::vector<XrdCl::AnyObject *>    *responses,
+                        size_t index, TSemaphore *semaphore) :
+         fStatuses(statuses), fResponses(responses), fIndex(index),
+         fSemaphore(semaphore) {}
+
+      virtual void HandleResponse(XrdCl::XRootDStatus *status,
+                                  XrdCl::AnyObject    *response)
+      {
+         fStatuses->at(fIndex)  = status;
+         fResponses->at(fIndex) = response;
+         fSemaphore->Post();
+         delete this;
+      }
+
+   private:
+      std::vector<XrdCl::XRootDStatus *> *fStatuses;  // Statuses of the requests
+      std::vector<XrdCl::AnyObject *>    *fResponses; // Responses of the requests
+      size_t                              fIndex;     // Index of this request
+      TSemaphore                         *fSemaphore; // Synchronize the responses
+   };
+
+   //---------------------------------------------------------------------------
+   // Send 'n' asynchronous requests with 'submit', keeping up to
+   // NetXNG.ParallelQueries of them in flight, and wait for all of them. The
+   // statuses and the responses, to be deleted by the caller, are stored at
+   // the index of their request; a request which could not be sent gets the
+   // status of the submission and no response.
+   /////////////////////////////////////////////////////////////////////////////
+
+   template <typename Submit_t>
+   void RunBulkQuery(size_t n, Submit_t submit,
+                     std::vector<XrdCl::XRootDStatus *> &statuses,
+                     std::vector<XrdCl::AnyObject *>    &responses)
+   {
+      using namespace XrdCl;
+      statuses.assign(n, nullptr);
+      responses.assign(n, nullptr);
+
+      const Int_t parallel = gEnv->GetValue("NetXNG.ParallelQueries", 64);
+      const size_t nInFlightMax = parallel > 0 ? parallel : 1;
+      TSemaphore semaphore(0);
+      size_t nSent = 0, nInFlight = 0;
+      while (nSent < n || nInFlight > 0) {
+         while (nSent < n && nInFlight < nInFlightMax) {
+            TBulkQueryHandler *handler =
+               new TBulkQueryHandler(&statuses, &responses, nSent, &semaphore);
+            XRootDStatus st = submit(nSent, handler);
+            if (st.IsOK()) {
+               ++nInFlight;
+            } else {
+               delete handler;
+               statuses[nSent] = new XRootDStatus(st);
+            }
+            ++nSent;
+         }
+         if (nInFlight == 0)
+            break;
+         semaphore.Wait();
+         --nInFlight;
+      }
+   }
+
+   //---------------------------------------------------------------------------
+   // Fill a FileStat_t from the stat information of the client
+   /////////////////////////////////////////////////////////////////////////////
+
+   void FillFileStat(const XrdCl::StatInfo *info, FileStat_t &buf)
+   {
+      using namespace XrdCl;
+
+      // Flag offline files
+      if (info->TestFlags(StatInfo::Offline)) {
+         buf.fMode = kS_IFOFF;
+      } else {
+         std::stringstream sstr(info->GetId());
+         Long64_t id;
+         sstr >> id;
+
+         buf.fDev    = (id >> 32);
+         buf.fIno    = (id & 0x00000000FFFFFFFF);
+         buf.fUid    = -1;  // not available
+         buf.fGid    = -1;  // not available
+         buf.fIsLink = 0;   // not available
+         buf.fSize   = info->GetSize();
+         buf.fMtime  = info->GetModTime();
+
+         if (info->TestFlags(StatInfo::XBitSet))
+            buf.fMode = (kS_IFREG | kS_IXUSR | kS_IXGRP | kS_IXOTH);
+         if (info->GetFlags() == 0)                 buf.fMode = kS_IFREG;
+         if (info->TestFlags(StatInfo::IsDir))      buf.fMode = kS_IFDIR;
+         if (info->TestFlags(StatInfo::Other))      buf.fMode = kS_IFSOCK;
+         if (info->TestFlags(StatInfo::IsReadable)) buf.fMode |= kS_IRUSR;
+         if (info->TestFlags(StatInfo::IsWritable)) buf.fMode |= kS_IWUSR;
+      }
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -199,39 +306,55 @@ Int_t TNetXNGSystem::GetPathInfo(const char *path, FileStat_t &buf)
       }
       delete info;
       return 1;
-
-   } else {
-
-      // Flag offline files
-      if (info->TestFlags(StatInfo::Offline)) {
-         buf.fMode = kS_IFOFF;
-      } else {
-         std::stringstream sstr(info->GetId());
-         Long64_t id;
-         sstr >> id;
-
-         buf.fDev    = (id >> 32);
-         buf.fIno    = (id & 0x00000000FFFFFFFF);
-         buf.fUid    = -1;  // not available
-         buf.fGid    = -1;  // not available
-         buf.fIsLink = 0;   // not available
-         buf.fSize   = info->GetSize();
-         buf.fMtime  = info->GetModTime();
-
-         if (info->TestFlags(StatInfo::XBitSet))
-            buf.fMode = (kS_IFREG | kS_IXUSR | kS_IXGRP | kS_IXOTH);
-         if (info->GetFlags() == 0)                 buf.fMode = kS_IFREG;
-         if (info->TestFlags(StatInfo::IsDir))      buf.fMode = kS_IFDIR;
-         if (info->TestFlags(StatInfo::Other))      buf.fMode = kS_IFSOCK;
-         if (info->TestFlags(StatInfo::IsReadable)) buf.fMode |= kS_IRUSR;
-         if (info->TestFlags(StatInfo::IsWritable)) buf.fMode |= kS_IWUSR;
-      }
    }
 
+   FillFileStat(info, buf);
    delete info;
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Get info about several files, with parallel asynchronous stat requests
+///
+/// param paths: the paths of the files to stat (in)
+/// param bufs:  the stat info of each file (out)
+/// param rets:  0 for each file stat'ed, 1 if it could not be stat'ed (out)
+/// returns:     the number of files stat'ed
+
+Int_t TNetXNGSystem::GetPathInfo(const std::vector<TString> &paths,
+                                 std::vector<FileStat_t> &bufs,
+                                 std::vector<Int_t> &rets)
+{
+   using namespace XrdCl;
+   std::vector<XRootDStatus *> statuses;
+   std::vector<AnyObject *>    responses;
+   RunBulkQuery(paths.size(),
+                [this, &paths](size_t i, ResponseHandler *handler) {
+                   return fFileSystem->Stat(URL(paths[i].Data()).GetPath(), handler);
+                },
+                statuses, responses);
+
+   bufs.assign(paths.size(), FileStat_t());
+   rets.assign(paths.size(), 1);
+   Int_t nStat = 0;
+   for (size_t i = 0; i < paths.size(); ++i) {
+      StatInfo *info = 0;
+      if (statuses[i]->IsOK() && responses[i])
+         responses[i]->Get(info);
+      if (info) {
+         FillFileStat(info, bufs[i]);
+         rets[i] = 0;
+         ++nStat;
+      } else if (gDebug > 1) {
+         Info("GetPathInfo", "Stat error for %s: %s", paths[i].Data(),
+              statuses[i]->GetErrorMessage().c_str());
+      }
+      delete statuses[i];
+      delete responses[i];
+   }
+   return nStat;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Check consistency of this helper with the one required by 'path' or
 /// 'dirptr'
@@ -339,10 +462,66 @@ Int_t TNetXNGSystem::Locate(const char *path, TString &endurl)
    }
 
    // Use the first endpoint address returned by the client
-   URL locUrl(info->Begin()->GetAddress());
-   TString loc = locUrl.GetHostName();
+   endurl = GetEndpointUrl(path, info->Begin()->GetAddress());
    delete info;
-   info = 0;
+
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the endpoint URLs of several files, with parallel asynchronous locate
+/// requests
+///
+/// param paths:   the entry-point URLs of the files (in)
+/// param endurls: the endpoint URL of each file, empty if the file could not
+///                be located (out)
+/// returns:       the number of files located
+
+Int_t TNetXNGSystem::Locate(const std::vector<TString> &paths,
+                            std::vector<TString> &endurls)
+{
+   using namespace XrdCl;
+   std::vector<XRootDStatus *> statuses;
+   std::vector<AnyObject *>    responses;
+   RunBulkQuery(paths.size(),
+                [this, &paths](size_t i, ResponseHandler *handler) {
+                   return fFileSystem->Locate(URL(paths[i].Data()).GetPath(),
+                                              OpenFlags::None, handler);
+                },
+                statuses, responses);
+
+   endurls.assign(paths.size(), TString());
+   Int_t nLocated = 0;
+   for (size_t i = 0; i < paths.size(); ++i) {
+      LocationInfo *info = 0;
+      if (statuses[i]->IsOK() && responses[i])
+         responses[i]->Get(info);
+      if (info && info->GetSize() > 0) {
+         endurls[i] = GetEndpointUrl(paths[i], info->Begin()->GetAddress());
+         ++nLocated;
+      } else if (gDebug > 1) {
+         Info("Locate", "%s: %s", paths[i].Data(),
+              statuses[i]->GetErrorMessage().c_str());
+      }
+      delete statuses[i];
+      delete responses[i];
+   }
+   return nLocated;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the endpoint URL of a file from the address of the server returned
+/// by a locate request
+///
+/// param path:    the entry-point URL of the file
+/// param address: the numeric address of the server holding the file
+/// returns:       the URL of the file on that server, with its host name
+
+TString TNetXNGSystem::GetEndpointUrl(const char *path, const std::string &address)
+{
+   using namespace XrdCl;
+   URL locUrl(address);
+   TString loc = locUrl.GetHostName();
 
    R__LOCKGUARD(&fgAddrMutex);
 
@@ -363,15 +542,13 @@ Int_t TNetXNGSystem::Locate(const char *path, TString &endurl)
       free(addr[0]);
       free(name[0]);
       if (gDebug > 0)
-         Info("Locate","caching host name: %s", hn->GetTitle());
+         ::Info("TNetXNGSystem::Locate","caching host name: %s", hn->GetTitle());
    }
 
    TUrl res(path);
    res.SetHost(hn->GetTitle());
    res.SetPort(locUrl.GetPort());
-   endurl = res.GetUrl();
-
-   return 0;
+   return res.GetUrl();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -57,6 +57,7 @@ public:
    virtual void         Draw(Option_t *opt) { Draw(opt, "", "", TTree::kMaxEntries, 0); }
    virtual TBranch     *FindBranch(const char *name);
    virtual TLeaf       *FindLeaf(const char *name);
+   using TChain::GetBranch;
    virtual TBranch     *GetBranch(const char *name);
    virtual Bool_t       GetBranchStatus(const char *branchname) const;
    virtual Long64_t     GetEntries() const;
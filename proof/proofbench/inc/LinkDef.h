@@ -16,6 +16,8 @@
 
 #pragma link C++ class TProofBench+;
 #pragma link C++ class TProofBenchDataSet+;
+#pragma link C++ class TProofBenchEngines+;
+#pragma link C++ class TProofBenchEnginesSel+;
 #pragma link C++ class TProofBenchRun+;
 #pragma link C++ class TProofBenchRunCPU+;
 #pragma link C++ class TProofBenchRunDataRead+;
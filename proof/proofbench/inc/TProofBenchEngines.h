@@ -0,0 +1,125 @@
+// @(#)root/proof:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TProofBenchEngines
+#define ROOT_TProofBenchEngines
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TProofBenchEngines                                                   //
+//                                                                      //
+// Runs the same CPU-bound and I/O-bound workloads through the          //
+// parallel processing engines (TTreeProcessorMT, TTreeProcessorMP,     //
+// TDataFrame and PROOF-Lite) to compare their scaling.                 //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+#include "TSelector.h"
+#include "TString.h"
+
+#include <string>
+#include <vector>
+
+class TFile;
+class TH1D;
+class TProof;
+class TTree;
+
+class TProofBenchEngines : public TObject {
+
+public:
+   enum EEngine {
+      kTreeProcessorMT = 0x1,
+      kTreeProcessorMP = 0x2,
+      kDataFrame = 0x4,
+      kProofLite = 0x8,
+      kAllEngines = 0xf
+   };
+   enum EWorkload {
+      kCPUWorkload = 0x1,         // few values read, many computations per entry
+      kIOWorkload = 0x2           // all the values read, few computations per entry
+   };
+   static const Int_t kNValues = 8;   // Number of values per entry of the benchmark tree
+
+private:
+   TString  fOutFileName;         // Name of the output file
+   TString  fTreeName;            // Name of the benchmark tree
+   std::vector<std::string> fFiles; // Files of the benchmark tree
+   Int_t    fStart;               // Minimum number of workers
+   Int_t    fStop;                // Maximum number of workers
+   Int_t    fStep;                // Step in the number of workers
+   Int_t    fNTries;              // Number of times a measurement is repeated
+   Int_t    fCPULoad;             // Number of iterations per entry of the CPU workload
+   std::vector<Double_t> fCacheFactors; // Factors of the tree cache size (TTreeCache.Size)
+   TProof  *fProof;               // The PROOF-Lite session, opened at the first PROOF run
+   Bool_t   fDebug;               // Debug switch
+
+   TProofBenchEngines(const TProofBenchEngines &);             // Not implemented
+   TProofBenchEngines &operator=(const TProofBenchEngines &);  // Not implemented
+
+   Double_t RunTreeProcessorMT(Int_t workload, Int_t nworkers);
+   Double_t RunTreeProcessorMP(Int_t workload, Int_t nworkers);
+   Double_t RunDataFrame(Int_t workload, Int_t nworkers);
+   Double_t RunProofLite(Int_t workload, Int_t nworkers, Double_t cachefactor);
+   Long64_t GetZipBytes(Int_t workload, Long64_t &entries) const;
+
+public:
+   TProofBenchEngines(const char *outfile = "proofbench_engines.root");
+   virtual ~TProofBenchEngines();
+
+   Int_t MakeData(const char *dir = ".", Int_t nfiles = 4, Long64_t nentries = 1000000);
+   void  SetData(const std::vector<std::string> &files) { fFiles = files; }
+   void  SetWorkers(Int_t start, Int_t stop = -1, Int_t step = 1);
+   void  SetNTries(Int_t nt) { if (nt > 0) fNTries = nt; }
+   void  SetCPULoad(Int_t load) { if (load > 0) fCPULoad = load; }
+   void  SetCacheFactors(const std::vector<Double_t> &factors) { fCacheFactors = factors; }
+   void  SetDebug(Bool_t debug = kTRUE) { fDebug = debug; }
+
+   Int_t Run(Int_t engines = kAllEngines, Int_t workloads = kCPUWorkload | kIOWorkload);
+
+   static const char *GetEngineName(Int_t engine);
+   static Double_t ProcessValues(const Float_t *values, Int_t workload, Int_t cpuload);
+
+   virtual void Print(Option_t *option = "") const;
+
+   ClassDef(TProofBenchEngines, 0) // Benchmark of the parallel processing engines
+};
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TProofBenchEnginesSel                                                //
+//                                                                      //
+// Selector running the workloads of TProofBenchEngines with PROOF.     //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class TProofBenchEnginesSel : public TSelector {
+
+private:
+   TTree   *fTree;                                     //! The tree being processed
+   Float_t  fValues[TProofBenchEngines::kNValues];    //! Values of the current entry
+   Int_t    fWorkload;                                 //! Type of workload
+   Int_t    fCPULoad;                                  //! Number of iterations of the CPU workload
+   TH1D    *fHist;                                     //! Histogram of the results
+
+public:
+   TProofBenchEnginesSel() : fTree(0), fWorkload(TProofBenchEngines::kCPUWorkload), fCPULoad(1), fHist(0) {}
+   virtual ~TProofBenchEnginesSel() {}
+
+   virtual Int_t   Version() const { return 2; }
+   virtual void    Init(TTree *tree);
+   virtual void    SlaveBegin(TTree *tree);
+   virtual Bool_t  Process(Long64_t entry);
+
+   ClassDef(TProofBenchEnginesSel, 1) // Selector of the PROOF-Lite runs of TProofBenchEngines
+};
+
+#endif
@@ -0,0 +1,506 @@
+// @(#)root/proof:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TProofBenchEngines
+\ingroup proofbench
+
+Benchmark of the parallel processing engines. The same workloads run through
+TTreeProcessorMT (with the implicit multi-threading), TTreeProcessorMP,
+TDataFrame (multi-threaded with the implicit multi-threading) and PROOF-Lite,
+for a range of numbers of workers and of tree cache sizes:
+
+  - the CPU-bound workload reads one value per entry and iterates on it
+    (SetCPULoad sets the number of iterations);
+  - the I/O-bound workload reads all the values of the entry and sums them.
+
+The benchmark tree is created with MakeData. The results are stored in the
+tree "engines" of the output file, with one entry per measurement:
+engine, workload, workers, cachefactor, run, entries, realtime, evtrate
+(entries per second) and mbrate (compressed MB per second of the branches
+read). The scaling curves are then drawn from the tree, e.g.
+
+~~~{.cpp}
+   TProofBenchEngines eb;
+   eb.MakeData("/data/bench", 8, 2000000);
+   eb.SetWorkers(1, 16);
+   eb.SetCacheFactors({0., 1.});
+   eb.Run();
+
+   TFile f("proofbench_engines.root");
+   TTree *t = (TTree *) f.Get("engines");
+   t->Draw("evtrate:workers", "workload==2 && cachefactor==1 && engine==1", "prof");
+~~~
+
+The cache size factor is the one of TTree::GetCacheAutoSize (TTreeCache.Size):
+0 disables the tree cache, 1 corresponds to the default cache.
+*/
+
+#include "RConfigure.h"
+
+#include "TProofBenchEngines.h"
+#include "TDSet.h"
+#include "TEnv.h"
+#include "TFile.h"
+#include "TH1D.h"
+#include "TMath.h"
+#include "TParameter.h"
+#include "TProof.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+#include "TStopwatch.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+#include "ROOT/TDataFrame.hxx"
+#include "ROOT/TTreeProcessorMP.hxx"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadedObject.hxx"
+#include "ROOT/TTreeProcessorMT.hxx"
+#endif
+
+#include <memory>
+
+ClassImp(TProofBenchEngines);
+
+namespace {
+
+const char *kBenchTreeName = "bench";
+const Int_t kNBins = 100;
+const Double_t kHistMin = -4.;
+const Double_t kHistMax = 4.;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of values read by the workload.
+
+Int_t GetNValuesRead(Int_t workload)
+{
+   return (workload == TProofBenchEngines::kCPUWorkload) ? 1 : TProofBenchEngines::kNValues;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Runs the workload on the entries of the reader, filling the histogram.
+
+void ProcessReader(TTreeReader &reader, Int_t workload, Int_t cpuload, TH1D *hist)
+{
+   std::vector<std::unique_ptr<TTreeReaderValue<Float_t>>> readers;
+   for (Int_t i = 0; i < GetNValuesRead(workload); i++)
+      readers.emplace_back(new TTreeReaderValue<Float_t>(reader, TString::Format("x%d", i)));
+   Float_t values[TProofBenchEngines::kNValues] = {0};
+   while (reader.Next()) {
+      for (UInt_t i = 0; i < readers.size(); i++)
+         values[i] = **readers[i];
+      hist->Fill(TProofBenchEngines::ProcessValues(values, workload, cpuload));
+   }
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor: the results are written in outfile.
+
+TProofBenchEngines::TProofBenchEngines(const char *outfile)
+                   : fOutFileName(outfile), fTreeName(kBenchTreeName), fStart(1), fStop(-1), fStep(1),
+                     fNTries(3), fCPULoad(100), fProof(0), fDebug(kFALSE)
+{
+   SysInfo_t si;
+   gSystem->GetSysInfo(&si);
+   fStop = (si.fCpus > 0) ? si.fCpus : 1;
+   fCacheFactors.push_back(1.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+TProofBenchEngines::~TProofBenchEngines()
+{
+   SafeDelete(fProof);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Name of the engine.
+
+const char *TProofBenchEngines::GetEngineName(Int_t engine)
+{
+   switch (engine) {
+      case kTreeProcessorMT: return "TTreeProcessorMT";
+      case kTreeProcessorMP: return "TTreeProcessorMP";
+      case kDataFrame: return "TDataFrame";
+      case kProofLite: return "PROOF-Lite";
+      default: return "unknown";
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The computation done for each entry: the CPU-bound workload iterates
+/// cpuload times on the first value, the I/O-bound one averages all the values.
+
+Double_t TProofBenchEngines::ProcessValues(const Float_t *values, Int_t workload, Int_t cpuload)
+{
+   if (workload == kCPUWorkload) {
+      Double_t v = values[0];
+      for (Int_t i = 0; i < cpuload; i++)
+         v = TMath::Sin(v) * TMath::Cos(v) + values[0];
+      return v;
+   }
+   Double_t sum = 0;
+   for (Int_t i = 0; i < kNValues; i++)
+      sum += values[i];
+   return sum / kNValues;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Creates nfiles files with nentries entries each of the benchmark tree in
+/// directory dir, and uses them for the next runs. Returns 0 on success.
+
+Int_t TProofBenchEngines::MakeData(const char *dir, Int_t nfiles, Long64_t nentries)
+{
+   if (gSystem->AccessPathName(dir) && gSystem->mkdir(dir, kTRUE) != 0) {
+      Error("MakeData", "could not create directory '%s'", dir);
+      return -1;
+   }
+   fFiles.clear();
+   TRandom3 rnd(4357);
+   for (Int_t ifile = 0; ifile < nfiles; ifile++) {
+      TString fn = TString::Format("%s/bench_engines_%d.root", dir, ifile);
+      TFile f(fn, "RECREATE");
+      if (f.IsZombie()) {
+         Error("MakeData", "could not create file '%s'", fn.Data());
+         return -1;
+      }
+      // owned by the file
+      TTree *tree = new TTree(fTreeName, "Tree of the TProofBenchEngines benchmark");
+      Float_t values[kNValues];
+      for (Int_t i = 0; i < kNValues; i++)
+         tree->Branch(TString::Format("x%d", i), &values[i], TString::Format("x%d/F", i));
+      for (Long64_t entry = 0; entry < nentries; entry++) {
+         for (Int_t i = 0; i < kNValues; i++)
+            values[i] = rnd.Gaus(0., 1.);
+         tree->Fill();
+      }
+      tree->Write();
+      f.Close();
+      fFiles.push_back(fn.Data());
+      if (fDebug) Info("MakeData", "created file '%s'", fn.Data());
+   }
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sets the range of numbers of workers. A negative stop means the number
+/// of cores.
+
+void TProofBenchEngines::SetWorkers(Int_t start, Int_t stop, Int_t step)
+{
+   fStart = (start > 0) ? start : 1;
+   if (stop > 0) {
+      fStop = stop;
+   } else {
+      SysInfo_t si;
+      gSystem->GetSysInfo(&si);
+      fStop = (si.fCpus > 0) ? si.fCpus : 1;
+   }
+   if (fStop < fStart) fStop = fStart;
+   fStep = (step > 0) ? step : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compressed size of the branches read by the workload, and number of
+/// entries of the benchmark tree.
+
+Long64_t TProofBenchEngines::GetZipBytes(Int_t workload, Long64_t &entries) const
+{
+   Long64_t bytes = 0;
+   entries = 0;
+   for (const auto &fn : fFiles) {
+      std::unique_ptr<TFile> f(TFile::Open(fn.c_str()));
+      TTree *tree = f ? dynamic_cast<TTree *>(f->Get(fTreeName)) : 0;
+      if (!tree) continue;
+      entries += tree->GetEntries();
+      for (Int_t i = 0; i < GetNValuesRead(workload); i++) {
+         TBranch *br = tree->GetBranch(TString::Format("x%d", i));
+         if (br) bytes += br->GetZipBytes();
+      }
+   }
+   return bytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// TTreeProcessorMT run; returns the real time, or -1 if not available.
+
+Double_t TProofBenchEngines::RunTreeProcessorMT(Int_t workload, Int_t nworkers)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(nworkers);
+   TStopwatch timer;
+   {
+      ROOT::TThreadedObject<TH1D> hist("hbench", "", kNBins, kHistMin, kHistMax);
+      std::vector<std::string_view> files(fFiles.begin(), fFiles.end());
+      ROOT::TTreeProcessorMT tp(files, fTreeName.Data());
+      Int_t cpuload = fCPULoad;
+      tp.Process([&hist, workload, cpuload](TTreeReader &reader) {
+         ProcessReader(reader, workload, cpuload, hist.Get().get());
+      });
+      hist.Merge();
+   }
+   Double_t realtime = timer.RealTime();
+   ROOT::DisableImplicitMT();
+   return realtime;
+#else
+   (void)workload;
+   (void)nworkers;
+   return -1.;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// TTreeProcessorMP run; returns the real time.
+
+Double_t TProofBenchEngines::RunTreeProcessorMP(Int_t workload, Int_t nworkers)
+{
+   TStopwatch timer;
+   ROOT::TTreeProcessorMP pool(nworkers);
+   Int_t cpuload = fCPULoad;
+   TH1D *hist = pool.Process(fFiles, [workload, cpuload](TTreeReader &reader) {
+      TH1D *h = new TH1D("hbench", "", kNBins, kHistMin, kHistMax);
+      h->SetDirectory(0);
+      ProcessReader(reader, workload, cpuload, h);
+      return h;
+   }, fTreeName.Data());
+   Double_t realtime = timer.RealTime();
+   delete hist;
+   return realtime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// TDataFrame run; returns the real time, or -1 if not available (several
+/// workers without the implicit multi-threading).
+
+Double_t TProofBenchEngines::RunDataFrame(Int_t workload, Int_t nworkers)
+{
+#ifdef R__USE_IMT
+   if (nworkers > 1) ROOT::EnableImplicitMT(nworkers);
+#else
+   if (nworkers > 1) return -1.;
+#endif
+   TStopwatch timer;
+   {
+      ROOT::Experimental::TDataFrame df(fTreeName.Data(), fFiles);
+      ROOT::Experimental::TDF::TH1DModel model("hbench", "", kNBins, kHistMin, kHistMax);
+      Int_t cpuload = fCPULoad;
+      if (workload == kCPUWorkload) {
+         auto h = df.Define("v", [cpuload](Float_t x0) { return ProcessValues(&x0, kCPUWorkload, cpuload); }, {"x0"})
+                     .Histo1D<Double_t>(model, "v");
+         h->GetEntries();
+      } else {
+         auto h = df.Define("v",
+                            [](Float_t x0, Float_t x1, Float_t x2, Float_t x3, Float_t x4, Float_t x5, Float_t x6,
+                               Float_t x7) {
+                               Float_t values[kNValues] = {x0, x1, x2, x3, x4, x5, x6, x7};
+                               return ProcessValues(values, kIOWorkload, 0);
+                            },
+                            {"x0", "x1", "x2", "x3", "x4", "x5", "x6", "x7"})
+                     .Histo1D<Double_t>(model, "v");
+         h->GetEntries();
+      }
+   }
+   Double_t realtime = timer.RealTime();
+#ifdef R__USE_IMT
+   if (nworkers > 1) ROOT::DisableImplicitMT();
+#endif
+   return realtime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// PROOF-Lite run; returns the real time, or -1 on failure. The session is
+/// started with the maximum number of workers at the first call.
+
+Double_t TProofBenchEngines::RunProofLite(Int_t workload, Int_t nworkers, Double_t cachefactor)
+{
+   if (!fProof) {
+      fProof = TProof::Open("lite://", TString::Format("workers=%d", fStop));
+      if (!fProof || !fProof->IsValid()) {
+         Error("RunProofLite", "could not start PROOF-Lite");
+         SafeDelete(fProof);
+         return -1.;
+      }
+      fProof->Exec("gSystem->Load(\"libProofBench\")");
+   }
+   fProof->SetParallel(nworkers);
+   fProof->SetParameter("PROOF_BenchEnginesWorkload", workload);
+   fProof->SetParameter("PROOF_BenchEnginesCPULoad", fCPULoad);
+   // the workers do not share our environment: pass the cache size in bytes
+   Long64_t cachesize = 0;
+   if (cachefactor > 0 && !fFiles.empty()) {
+      std::unique_ptr<TFile> f(TFile::Open(fFiles[0].c_str()));
+      TTree *tree = f ? dynamic_cast<TTree *>(f->Get(fTreeName)) : 0;
+      // a negative size means the automatic size, i.e. the one given by TTreeCache.Size
+      if (tree && tree->SetCacheSize(-1) == 0) cachesize = tree->GetCacheSize();
+   }
+   fProof->SetParameter("PROOF_UseTreeCache", (Int_t)(cachesize > 0 ? 1 : 0));
+   if (cachesize > 0) fProof->SetParameter("PROOF_CacheSize", cachesize);
+   else fProof->DeleteParameters("PROOF_CacheSize");
+
+   TDSet dset("TTree", fTreeName);
+   for (const auto &fn : fFiles)
+      dset.Add(fn.c_str());
+   TProofBenchEnginesSel sel;
+   TStopwatch timer;
+   Long64_t rc = fProof->Process(&dset, &sel);
+   Double_t realtime = timer.RealTime();
+   fProof->DeleteParameters("PROOF_BenchEngines*");
+   return (rc < 0) ? -1. : realtime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Runs the benchmark for the bit masks of engines (EEngine) and workloads
+/// (EWorkload), for all the numbers of workers and cache factors, fNTries
+/// times each. The measurements are appended to the tree "engines" of the
+/// output file. Returns 0 on success.
+
+Int_t TProofBenchEngines::Run(Int_t engines, Int_t workloads)
+{
+   if (fFiles.empty()) {
+      Error("Run", "no data: call MakeData first");
+      return -1;
+   }
+   std::unique_ptr<TFile> outfile(TFile::Open(fOutFileName, "UPDATE"));
+   if (!outfile || outfile->IsZombie()) {
+      Error("Run", "could not open the output file '%s'", fOutFileName.Data());
+      return -1;
+   }
+   TTree *results = dynamic_cast<TTree *>(outfile->Get("engines"));
+   Int_t engine = 0, workload = 0, workers = 0, run = 0;
+   Double_t cachefactor = 0, realtime = 0, evtrate = 0, mbrate = 0;
+   Long64_t entries = 0;
+   if (results) {
+      results->SetBranchAddress("engine", &engine);
+      results->SetBranchAddress("workload", &workload);
+      results->SetBranchAddress("workers", &workers);
+      results->SetBranchAddress("cachefactor", &cachefactor);
+      results->SetBranchAddress("run", &run);
+      results->SetBranchAddress("entries", &entries);
+      results->SetBranchAddress("realtime", &realtime);
+      results->SetBranchAddress("evtrate", &evtrate);
+      results->SetBranchAddress("mbrate", &mbrate);
+   } else {
+      results = new TTree("engines", "Scaling of the parallel processing engines");
+      results->Branch("engine", &engine, "engine/I");
+      results->Branch("workload", &workload, "workload/I");
+      results->Branch("workers", &workers, "workers/I");
+      results->Branch("cachefactor", &cachefactor, "cachefactor/D");
+      results->Branch("run", &run, "run/I");
+      results->Branch("entries", &entries, "entries/L");
+      results->Branch("realtime", &realtime, "realtime/D");
+      results->Branch("evtrate", &evtrate, "evtrate/D");
+      results->Branch("mbrate", &mbrate, "mbrate/D");
+   }
+
+   Double_t oldfactor = gEnv->GetValue("TTreeCache.Size", 1.0);
+   for (Int_t iwl = kCPUWorkload; iwl <= kIOWorkload; iwl <<= 1) {
+      if (!(workloads & iwl)) continue;
+      workload = iwl;
+      Long64_t zipbytes = GetZipBytes(workload, entries);
+      for (auto factor : fCacheFactors) {
+         cachefactor = factor;
+         // the engines running in this process or in forked ones size their cache from it
+         gEnv->SetValue("TTreeCache.Size", factor);
+         for (Int_t ieng = kTreeProcessorMT; ieng <= kProofLite; ieng <<= 1) {
+            if (!(engines & ieng)) continue;
+            engine = ieng;
+            for (workers = fStart; workers <= fStop; workers += fStep) {
+               for (run = 0; run < fNTries; run++) {
+                  switch (engine) {
+                     case kTreeProcessorMT: realtime = RunTreeProcessorMT(workload, workers); break;
+                     case kTreeProcessorMP: realtime = RunTreeProcessorMP(workload, workers); break;
+                     case kDataFrame: realtime = RunDataFrame(workload, workers); break;
+                     default: realtime = RunProofLite(workload, workers, factor); break;
+                  }
+                  if (realtime < 0) break;
+                  evtrate = (realtime > 0) ? entries / realtime : 0.;
+                  mbrate = (realtime > 0) ? zipbytes / realtime / (1024. * 1024.) : 0.;
+                  if (fDebug)
+                     Info("Run", "%s, workload %d, %d workers, cache factor %g: %.2f s, %.0f events/s, %.1f MB/s",
+                          GetEngineName(engine), workload, workers, cachefactor, realtime, evtrate, mbrate);
+                  results->Fill();
+               }
+               if (realtime < 0) {
+                  Warning("Run", "%s not available with %d workers", GetEngineName(engine), workers);
+                  break;
+               }
+            }
+         }
+      }
+   }
+   gEnv->SetValue("TTreeCache.Size", oldfactor);
+
+   outfile->cd();
+   results->Write(0, TObject::kOverwrite);
+   outfile->Close();
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prints the settings.
+
+void TProofBenchEngines::Print(Option_t *) const
+{
+   Printf("+++ TProofBenchEngines +++++++++++++++++++++++++++++++++++++++++++++");
+   Printf(" Output file: %s", fOutFileName.Data());
+   Printf(" Data: %lu files of tree '%s'", (ULong_t)fFiles.size(), fTreeName.Data());
+   Printf(" Workers: %d to %d in steps of %d, %d tries", fStart, fStop, fStep, fNTries);
+   Printf(" CPU load: %d iterations per entry", fCPULoad);
+   TString factors;
+   for (auto factor : fCacheFactors)
+      factors += TString::Format(" %g", factor);
+   Printf(" Cache factors:%s", factors.Data());
+   Printf("+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++");
+}
+
+ClassImp(TProofBenchEnginesSel);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Activates and connects the branches read by the workload.
+
+void TProofBenchEnginesSel::Init(TTree *tree)
+{
+   fTree = tree;
+   if (!fTree) return;
+   fTree->SetBranchStatus("*", 0);
+   Int_t nread = (fWorkload == TProofBenchEngines::kCPUWorkload) ? 1 : TProofBenchEngines::kNValues;
+   for (Int_t i = 0; i < nread; i++) {
+      TString name = TString::Format("x%d", i);
+      fTree->SetBranchStatus(name, 1);
+      fTree->SetBranchAddress(name, &fValues[i]);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads the workload from the input list and books the histogram.
+
+void TProofBenchEnginesSel::SlaveBegin(TTree *)
+{
+   TParameter<Int_t> *par = dynamic_cast<TParameter<Int_t> *>(fInput->FindObject("PROOF_BenchEnginesWorkload"));
+   if (par) fWorkload = par->GetVal();
+   par = dynamic_cast<TParameter<Int_t> *>(fInput->FindObject("PROOF_BenchEnginesCPULoad"));
+   if (par) fCPULoad = par->GetVal();
+   fHist = new TH1D("hbench", "", kNBins, kHistMin, kHistMax);
+   fOutput->Add(fHist);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Runs the workload on an entry.
+
+Bool_t TProofBenchEnginesSel::Process(Long64_t entry)
+{
+   fTree->GetEntry(entry);
+   fHist->Fill(TProofBenchEngines::ProcessValues(fValues, fWorkload, fCPULoad));
+   return kTRUE;
+}
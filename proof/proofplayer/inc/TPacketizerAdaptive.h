@@ -63,6 +63,7 @@ private:
 
    Bool_t         fCachePacketSync; // control synchronization of cache and packet sizes
    Double_t       fMaxEntriesRatio; // max file entries to avg allowed ratio for cache-to-packet sync
+   Bool_t         fPredictive;      // predict the packet time from the read throughput and CPU rate
 
    Float_t        fFractionOfRemoteFiles; // fraction of TDSetElements that are on non-workers
    Long64_t       fNEventsOnRemLoc;       // number of events in currently
@@ -25,6 +25,12 @@ Two main improvements in the load-balancing strategy:
      packetizer prevents the situation where the query can't finish
      because of one slow node.
 
+With Packetizer.Predictive (or PROOF_PacketizerPredictive in the input
+list) set to 1, the processing time of a packet is predicted from the
+CPU rate and from the local and remote read throughputs measured on
+each worker, and the packets are shortened to a fraction of the time
+left to the end of the query with all the workers busy.
+
 The data structures: TFileStat, TFileNode and TSlaveStat are
 enriched + changed and TFileNode::Compare method is changed.
 
@@ -341,6 +347,10 @@ private:
    Long64_t       fCurProcessed; // events processed in the current file
    Float_t        fCurProcTime;  // proc time spent on the current file
    TList         *fDSubSet;      // packets processed by this worker
+   Double_t       fCPUTime;      // CPU time spent on the packets with a CPU time measurement
+   Long64_t       fCPUEntries;   // entries processed in fCPUTime
+   Double_t       fIOTime[2];    // time not spent in CPU processing the local [0] and remote [1] packets
+   Long64_t       fIOBytes[2];   // bytes read processing the local [0] and remote [1] packets
 
 public:
    TSlaveStat(TSlave *slave);
@@ -356,6 +366,7 @@ public:
       return (fCurProcTime?fCurProcessed/fCurProcTime:0); }
    Int_t       GetLocalEventsLeft() {
       return fFileNode?(fFileNode->GetEventsLeftPerSlave()):0; }
+   Float_t     GetPredictedRate(Bool_t local, Float_t bevt);
    TList      *GetProcessedSubSet() { return fDSubSet; }
    TProofProgressStatus *GetProgressStatus() { return fStatus; }
    TProofProgressStatus *AddProcessed(TProofProgressStatus *st = 0);
@@ -366,8 +377,10 @@ public:
 
 TPacketizerAdaptive::TSlaveStat::TSlaveStat(TSlave *slave)
    : fFileNode(0), fCurFile(0), fCurElem(0),
-     fCurProcessed(0), fCurProcTime(0)
+     fCurProcessed(0), fCurProcTime(0), fCPUTime(0), fCPUEntries(0)
 {
+   fIOTime[0] = fIOTime[1] = 0;
+   fIOBytes[0] = fIOBytes[1] = 0;
    fDSubSet = new TList();
    fDSubSet->SetOwner();
    fSlave = slave;
@@ -410,12 +423,43 @@ void TPacketizerAdaptive::TSlaveStat::UpdateRates(TProofProgressStatus *st)
       fCurProcTime += st->GetProcTime() - GetProcTime();
       fCurProcessed += st->GetEntries() - GetEntriesProcessed();
    }
+   // Split the time of the last packet in the CPU time and the time spent waiting for
+   // the data, attributed to the local or remote reads
+   Long64_t dent = st->GetEntries() - GetEntriesProcessed();
+   Double_t dcpu = st->GetCPUTime() - fStatus->GetCPUTime();
+   Double_t dio = (st->GetProcTime() - GetProcTime()) - dcpu;
+   Long64_t dbytes = st->GetBytesRead() - fStatus->GetBytesRead();
+   if (dent > 0 && dcpu > 0) {
+      fCPUTime += dcpu;
+      fCPUEntries += dent;
+   }
+   if (dbytes > 0 && dio > 0) {
+      Int_t loc = (fCurFile->GetNode() == fFileNode) ? 0 : 1;
+      fIOTime[loc] += dio;
+      fIOBytes[loc] += dbytes;
+   }
    fCurFile->GetNode()->IncProcessed(st->GetEntries() - GetEntriesProcessed());
    st->SetLastEntries(st->GetEntries() - fStatus->GetEntries());
    SafeDelete(fStatus);
    fStatus = st;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Predict the processing rate of a packet read locally or remotely, with 'bevt'
+/// bytes per event, from the CPU rate and the read throughput measured so far.
+/// Return 0 if the worker has no CPU time measurement yet.
+
+Float_t TPacketizerAdaptive::TSlaveStat::GetPredictedRate(Bool_t local, Float_t bevt)
+{
+   if (fCPUTime <= 0 || fCPUEntries <= 0) return 0.;
+   Double_t tevt = fCPUTime / fCPUEntries;
+   // Without reads of this kind so far, use the throughput of the other kind
+   Int_t loc = local ? 0 : 1;
+   if (fIOBytes[loc] <= 0) loc = 1 - loc;
+   if (bevt > 0. && fIOBytes[loc] > 0) tevt += bevt * fIOTime[loc] / fIOBytes[loc];
+   return (Float_t)(1. / tevt);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add the current element to the fDSubSet (subset processed by this worker)
 /// and if the status arg is given, then change the size of the packet.
@@ -458,6 +502,7 @@ TPacketizerAdaptive::TPacketizerAdaptive(TDSet *dset, TList *slaves,
    fMaxPerfIdx = 1;
    fCachePacketSync = kTRUE;
    fMaxEntriesRatio = 2.;
+   fPredictive = kFALSE;
 
    fMaxSlaveCnt = -1;
    fPacketAsAFraction = 4;
@@ -485,6 +530,18 @@ TPacketizerAdaptive::TPacketizerAdaptive(TDSet *dset, TList *slaves,
       fMaxEntriesRatio = gEnv->GetValue("Packetizer.MaxEntriesRatio", 2.);
    }
 
+   // Predict the packet processing time from the CPU rate and the local and remote read
+   // throughputs of each worker, and shrink the packets as the end of the query nears
+   Int_t predictive = -1;
+   if (TProof::GetParameter(input, "PROOF_PacketizerPredictive", predictive) != 0) {
+      // Check if there is a global setting
+      predictive = gEnv->GetValue("Packetizer.Predictive", 0);
+   }
+   if (predictive > 0) {
+      fPredictive = kTRUE;
+      Info("TPacketizerAdaptive", "predicting the packet times from the read throughputs and CPU rates");
+   }
+
    // The possibility to change packetizer strategy to the basic TPacketizer's
    // one (in which workers always process their local data first).
    Int_t strategy = -1;
@@ -572,6 +629,7 @@ TPacketizerAdaptive::TPacketizerAdaptive(TDSet *dset, TList *slaves,
    // in the outputlist and therefore in the relevant TQueryResult
    fConfigParams->Add(new TParameter<Int_t>("PROOF_PacketizerCachePacketSync", (Int_t)fCachePacketSync));
    fConfigParams->Add(new TParameter<Double_t>("PROOF_PacketizerMaxEntriesRatio", fMaxEntriesRatio));
+   fConfigParams->Add(new TParameter<Int_t>("PROOF_PacketizerPredictive", (Int_t)fPredictive));
    fConfigParams->Add(new TParameter<Int_t>("PROOF_PacketizerStrategy", fStrategy));
    fConfigParams->Add(new TParameter<Int_t>("PROOF_MaxWorkersPerNode", (Int_t)fMaxSlaveCnt));
    fConfigParams->Add(new TParameter<Int_t>("PROOF_ForceLocal", (Int_t)fForceLocal));
@@ -1496,15 +1554,21 @@ Int_t TPacketizerAdaptive::CalculatePacketSize(TObject *slStatPtr, Long64_t cach
       Float_t rate = slstat->GetCurRate();
       if (!rate)
          rate = slstat->GetAvgRate();
+
+      // Bytes-to-Event conversion
+      Float_t bevt = (GetEntriesProcessed() > 0) ? GetBytesRead() / GetEntriesProcessed() : -1.;
+
+      // The rate predicted for the file of the packet, depending on whether it is read locally
+      if (rate && fPredictive && slstat->fCurFile) {
+         Float_t prate = slstat->GetPredictedRate(slstat->fCurFile->GetNode() == slstat->GetFileNode(), bevt);
+         if (prate > 0.) rate = prate;
+      }
       if (rate) {
 
          // Global average rate
          Float_t avgProcRate = (GetEntriesProcessed()/(GetCumProcTime() / fSlaveStats->GetSize()));
          Float_t packetTime = ((fTotalEntries - GetEntriesProcessed())/avgProcRate)/fPacketAsAFraction;
 
-         // Bytes-to-Event conversion
-         Float_t bevt = (GetEntriesProcessed() > 0) ? GetBytesRead() / GetEntriesProcessed() : -1.;
-
          // Make sure it is not smaller then the cache, if the info is available and the size
          // synchronization is required. But apply the cache-packet size synchronization only if there
          // are enough left files to process and the files are all of similar sizes. Otherwise we risk
@@ -1534,6 +1598,20 @@ Int_t TPacketizerAdaptive::CalculatePacketSize(TObject *slStatPtr, Long64_t cach
                packetTime = cachesz / bevt / rate;
          }
 
+         // Near the end of the query, the packets must not last longer than a fraction of the
+         // time left with all the workers busy, otherwise the last packets make a long tail
+         if (fPredictive) {
+            Float_t totRate = 0.;
+            TIter nxw(fSlaveStats);
+            TObject *key = 0;
+            while ((key = nxw()))
+               totRate += ((TSlaveStat *) fSlaveStats->GetValue(key))->GetAvgRate();
+            if (totRate > 0.) {
+               Float_t timeLeft = (fTotalEntries - GetEntriesProcessed()) / totRate;
+               if (packetTime > timeLeft / fPacketAsAFraction) packetTime = timeLeft / fPacketAsAFraction;
+            }
+         }
+
          // Apply min-max again, if required
          if (fMaxPacketTime > 0. && packetTime > fMaxPacketTime) packetTime = fMaxPacketTime;
          if (fMinPacketTime > 0. && packetTime < fMinPacketTime) packetTime = fMinPacketTime;
@@ -26,6 +26,7 @@
 #pragma link C++ class RooStats::HistFactory::RooBarlowBeestonLL+ ;  
 #pragma link C++ class RooStats::HistFactory::HistFactorySimultaneous+ ;  
 #pragma link C++ class RooStats::HistFactory::HistFactoryNavigation+ ;  
+#pragma link C++ class RooStats::HistFactory::CompiledLikelihood+ ;
 
 #pragma link C++ class RooStats::HistFactory::ConfigParser+ ;
 #pragma link C++ class RooStats::HistFactory::Measurement+ ;
@@ -0,0 +1,82 @@
+// @(#)root/roostats:$Id$
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOSTATS_COMPILEDLIKELIHOOD
+#define ROOSTATS_COMPILEDLIKELIHOOD
+
+#include "RooAbsReal.h"
+#include "RooListProxy.h"
+#include "RooSetProxy.h"
+#include "TString.h"
+#include <vector>
+
+class RooAbsPdf;
+class RooAbsData;
+
+namespace RooStats{
+namespace HistFactory{
+
+class CompiledLikelihood : public RooAbsReal {
+public:
+
+  CompiledLikelihood() ;
+  CompiledLikelihood(const char *name, const char *title, RooAbsPdf& pdf, RooAbsData& data,
+                     const RooArgSet* globalObservables=0, const char* fileName=0) ;
+  CompiledLikelihood(const CompiledLikelihood& other, const char* name=0) ;
+  virtual TObject* clone(const char* newname) const { return new CompiledLikelihood(*this,newname); }
+  virtual ~CompiledLikelihood() ;
+
+  // The code of the generated function, empty if the model is not supported
+  const TString& code() const { return _code ; }
+  const char* functionName() const { return _funcName.Data() ; }
+  Bool_t isValid() const { return _code.Length()>0 ; }
+
+  // The parameters, in the order of the array passed to the generated function
+  const RooArgList& parameters() const { return _params ; }
+  const RooArgList& constraints() const { return _constraints ; }
+
+  Bool_t compile() const ;
+
+  virtual Double_t defaultErrorLevel() const { return 0.5 ; }
+
+  // Gradient computed by the generated code, plus the derivatives of the constraint terms
+  virtual Bool_t hasGradient() const { return _gradient ; }
+  virtual Bool_t gradient(const RooArgList& vars, Double_t* grad) const ;
+
+  static Bool_t GenerateCode(RooAbsPdf& pdf, RooAbsData& data, RooArgList& params, const char* funcName,
+                             TString& code, Bool_t* gradient=0) ;
+
+protected:
+
+  RooListProxy _params ;        // Parameters of the generated function
+  RooListProxy _constraints ;   // Constraint terms of the parameters
+  RooSetProxy _constrNormSet ;  // Normalization set of the constraint terms
+  TString _code ;               // Code of the generated function
+  TString _funcName ;           // Name of the generated function
+  TString _fileName ;           // File in which the code is compiled by ACLiC, or empty for cling
+  Bool_t _gradient ;            // Is the function of the gradient generated?
+
+  typedef Double_t (*Function)(const Double_t*) ;
+  typedef Double_t (*GradFunction)(const Double_t*, Double_t*) ;
+  mutable Function _func ;                //! compiled function
+  mutable GradFunction _gradFunc ;        //! compiled function of the gradient
+  mutable std::vector<Double_t> _values ; //! values of the parameters
+  mutable std::vector<Double_t> _grad ;   //! gradient of the generated function
+
+  void setValues() const ;
+
+  Double_t evaluate() const ;
+
+  ClassDef(RooStats::HistFactory::CompiledLikelihood,2) // Negative log-likelihood of a HistFactory model, evaluated by generated code
+};
+
+}
+}
+
+#endif
@@ -39,6 +39,7 @@ public:
 
   //  void printMetaArgs(std::ostream& os) const ;
 
+  const RooAbsReal& nominalHist() const { return _nominal.arg() ; }
   const RooArgList& lowList() const { return _lowSet ; }
   const RooArgList& highList() const { return _highSet ; }
   const RooArgList& paramList() const { return _paramSet ; }
@@ -50,10 +51,12 @@ public:
   Double_t analyticalIntegralWN(Int_t code, const RooArgSet* normSet, const char* rangeName=0) const ;
 
   void setPositiveDefinite(bool flag=true){_positiveDefinite=flag;}
+  Bool_t positiveDefinite() const { return _positiveDefinite ; }
 
   void setInterpCode(RooAbsReal& param, int code);
   void setAllInterpCodes(int code);
   void printAllInterpCodes();
+  const std::vector<int>& interpolationCodes() const { return _interpCode ; }
 
   virtual std::list<Double_t>* binBoundaries(RooAbsRealLValue& /*obs*/, Double_t /*xlo*/, Double_t /*xhi*/) const ;
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& obs, Double_t xlo, Double_t xhi) const ; 
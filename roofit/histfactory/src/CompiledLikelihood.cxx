@@ -0,0 +1,1092 @@
+// @(#)root/roostats:$Id$
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class RooStats::HistFactory::CompiledLikelihood
+ * \ingroup HistFactory
+Negative log-likelihood of a HistFactory model on a binned data set, evaluated
+by a C++ function generated for the model and compiled by cling or ACLiC.
+
+The generic evaluation of the tree of the model (RooRealSumPdf of products of
+PiecewiseInterpolation, FlexibleInterpVar, ParamHistFunc, RooHistFunc and
+parameters) is replaced by one function which loops over the bins of each
+channel with all the nodes flattened in local variables: the histograms are
+stored in constant arrays, the nodes which do not depend on the bin are
+computed once per channel and the interpolations are inlined. The function
+takes the array of the values of the parameters, and the object can be
+minimized by RooMinimizer as the likelihood of RooAbsPdf::createNLL, with
+the same parameters:
+~~~{.cpp}
+RooStats::ModelConfig* mc = (RooStats::ModelConfig*) w->obj("ModelConfig");
+RooAbsData* data = w->data("obsData");
+RooStats::HistFactory::CompiledLikelihood nll("nll", "nll", *mc->GetPdf(), *data, mc->GetGlobalObservables());
+RooMinimizer m(nll);
+m.migrad();
+~~~
+The likelihood is extended when the model can be extended, as in createNLL.
+The constraint terms of the parameters are found as in createNLL and are
+evaluated by their p.d.f.s, normalized over the global observables if they
+are given, or over the parameters otherwise.
+
+The gradient of the likelihood is generated too, in the function
+`<name>_grad`, which propagates the derivatives from the likelihood of each
+bin back to the parameters (reverse-mode differentiation). RooMinimizer then
+passes it to the minimizer (see RooAbsReal::hasGradient()), which does not
+need to compute numerical derivatives by evaluating the function for each
+parameter. The derivatives of the constraint terms are computed by finite
+differences. The gradient is not generated when the variations of a
+PiecewiseInterpolation depend on the parameters.
+
+The data and the histograms of the model are part of the generated code: the
+object has to be created again when they change. The normalization of each
+channel is the sum over the bins of the values times the widths of the bins,
+the integral computed by the bin integrator used by HistFactory. With
+interpolation codes other than 0 of the PiecewiseInterpolation, it can differ
+from the analytical integral of PiecewiseInterpolation, which interpolates the
+integrals of the variations.
+
+Only one-dimensional channels made of the classes above, RooProduct,
+RooAddition and nodes which do not depend on the parameters are supported:
+for other models isValid() is false and an error is printed. The code is kept
+in the object: after reading it from a file, the function is compiled again at
+the first evaluation.
+*/
+
+#include "RooFit.h"
+
+#include "RooStats/HistFactory/CompiledLikelihood.h"
+#include "RooStats/HistFactory/FlexibleInterpVar.h"
+#include "RooStats/HistFactory/ParamHistFunc.h"
+#include "RooStats/HistFactory/PiecewiseInterpolation.h"
+
+#include "RooAbsPdf.h"
+#include "RooAbsData.h"
+#include "RooAbsBinning.h"
+#include "RooAbsRealLValue.h"
+#include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooCatType.h"
+#include "RooProduct.h"
+#include "RooAddition.h"
+#include "RooProdPdf.h"
+#include "RooRealSumPdf.h"
+#include "RooSimultaneous.h"
+#include "RooMsgService.h"
+
+#include "TInterpreter.h"
+#include "TSystem.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <string>
+
+using namespace std;
+
+ClassImp(RooStats::HistFactory::CompiledLikelihood);
+
+using namespace RooStats;
+using namespace HistFactory;
+
+namespace {
+
+// Placeholder of the name of the function in the generated code, replaced by a
+// name depending on the code
+const char* const kNameToken = "HISTFACTORY_COMPILED_FUNCTION" ;
+
+// The interpolations of the generated code, the same computations as
+// PiecewiseInterpolation::evaluate() and FlexibleInterpVar::evaluate()
+const char* const kHelperCode = R"CODE(
+inline double PiecewiseTerm(int code, double sum, double x, double nominal, double low, double high)
+{
+   switch (code) {
+   case 0: return sum + (x > 0 ? x * (high - nominal) : x * (nominal - low));
+   case 1: return sum * (x >= 0 ? std::pow(high / nominal, x) : std::pow(low / nominal, -x));
+   case 2:
+   case 3: {
+      const double a = 0.5 * (high + low) - nominal;
+      const double b = 0.5 * (high - low);
+      if (x > 1) return sum + (2 * a + b) * (x - 1) + high - nominal;
+      if (x < -1) return sum - (2 * a - b) * (x + 1) + low - nominal;
+      return sum + a * x * x + b * x;
+   }
+   case 4: {
+      if (x > 1) return sum + x * (high - nominal);
+      if (x < -1) return sum + x * (nominal - low);
+      const double epsPlus = high - nominal;
+      const double epsMinus = nominal - low;
+      const double S = 0.5 * (epsPlus + epsMinus);
+      const double A = 0.0625 * (epsPlus - epsMinus);
+      double val = nominal + x * (S + x * A * (15 + x * x * (-10 + x * x * 3)));
+      if (val < 0) val = 0;
+      return sum + val - nominal;
+   }
+   case 5: {
+      if (x > 1 || x < -1) return sum + (x > 0 ? x * (high - nominal) : x * (nominal - low));
+      if (nominal == 0) return sum;
+      const double epsPlus = high - nominal;
+      const double epsMinus = nominal - low;
+      const double S = 0.5 * (epsPlus + epsMinus);
+      const double A = 0.5 * (epsPlus - epsMinus);
+      double val = nominal + S * x + 1.5 * A * x * x - 0.5 * A * x * x * x * x;
+      if (val < 0) val = 0;
+      return sum + val - nominal;
+   }
+   }
+   return sum;
+}
+
+inline double FlexibleTerm(int code, double total, double x, double nominal, double low, double high,
+                           double boundary, const double *c)
+{
+   switch (code) {
+   case 0: return total + (x > 0 ? x * (high - nominal) : x * (nominal - low));
+   case 1: return total * (x >= 0 ? std::pow(high / nominal, x) : std::pow(low / nominal, -x));
+   case 2:
+   case 3: {
+      const double a = 0.5 * (high + low) - nominal;
+      const double b = 0.5 * (high - low);
+      if (x > 1) return total + (2 * a + b) * (x - 1) + high - nominal;
+      if (x < -1) return total - (2 * a - b) * (x + 1) + low - nominal;
+      return total + a * x * x + b * x;
+   }
+   case 4: {
+      if (x >= boundary) return total * std::pow(high / nominal, x);
+      if (x <= -boundary) return total * std::pow(low / nominal, -x);
+      if (x != 0) return total * (1. + x * (c[0] + x * (c[1] + x * (c[2] + x * (c[3] + x * (c[4] + x * c[5]))))));
+      return total;
+   }
+   }
+   return total;
+}
+
+// Derivatives of the terms with respect to the sum of the previous terms and to
+// the parameter of the term
+inline void PiecewiseTermGrad(int code, double sum, double x, double nominal, double low, double high,
+                              double &dsum, double &dx)
+{
+   dsum = 1;
+   dx = 0;
+   switch (code) {
+   case 0: dx = x > 0 ? high - nominal : nominal - low; return;
+   case 1: {
+      const double r = x >= 0 ? high / nominal : low / nominal;
+      dsum = std::pow(r, x >= 0 ? x : -x);
+      dx = sum * dsum * (x >= 0 ? std::log(r) : -std::log(r));
+      return;
+   }
+   case 2:
+   case 3: {
+      const double a = 0.5 * (high + low) - nominal;
+      const double b = 0.5 * (high - low);
+      if (x > 1) dx = 2 * a + b;
+      else if (x < -1) dx = b - 2 * a;
+      else dx = 2 * a * x + b;
+      return;
+   }
+   case 4: {
+      if (x > 1) { dx = high - nominal; return; }
+      if (x < -1) { dx = nominal - low; return; }
+      const double epsPlus = high - nominal;
+      const double epsMinus = nominal - low;
+      const double S = 0.5 * (epsPlus + epsMinus);
+      const double A = 0.0625 * (epsPlus - epsMinus);
+      const double val = nominal + x * (S + x * A * (15 + x * x * (-10 + x * x * 3)));
+      if (val >= 0) dx = S + A * x * (30 + x * x * (-40 + 18 * x * x));
+      return;
+   }
+   case 5: {
+      if (x > 1 || x < -1) { dx = x > 0 ? high - nominal : nominal - low; return; }
+      if (nominal == 0) return;
+      const double epsPlus = high - nominal;
+      const double epsMinus = nominal - low;
+      const double S = 0.5 * (epsPlus + epsMinus);
+      const double A = 0.5 * (epsPlus - epsMinus);
+      const double val = nominal + S * x + 1.5 * A * x * x - 0.5 * A * x * x * x * x;
+      if (val >= 0) dx = S + 3 * A * x - 2 * A * x * x * x;
+      return;
+   }
+   }
+}
+
+inline void FlexibleTermGrad(int code, double total, double x, double nominal, double low, double high,
+                             double boundary, const double *c, double &dsum, double &dx)
+{
+   if (code != 4) {
+      PiecewiseTermGrad(code, total, x, nominal, low, high, dsum, dx);
+      return;
+   }
+   if (x >= boundary) {
+      dsum = std::pow(high / nominal, x);
+      dx = total * dsum * std::log(high / nominal);
+   } else if (x <= -boundary) {
+      dsum = std::pow(low / nominal, -x);
+      dx = -total * dsum * std::log(low / nominal);
+   } else {
+      dsum = 1. + x * (c[0] + x * (c[1] + x * (c[2] + x * (c[3] + x * (c[4] + x * c[5])))));
+      dx = total * (c[0] + x * (2 * c[1] + x * (3 * c[2] + x * (4 * c[3] + x * (5 * c[4] + x * 6 * c[5])))));
+   }
+}
+)CODE" ;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Coefficients of the polynomial of the interpolation code 4 of FlexibleInterpVar,
+/// as computed by FlexibleInterpVar::PolyInterpValue()
+
+void FlexiblePolyCoefficients(double nominal, double low, double high, double x0, double* coeff)
+{
+  double pow_up       =  std::pow(high/nominal, x0);
+  double pow_down     =  std::pow(low/nominal,  x0);
+  double logHi        =  std::log(high) ;
+  double logLo        =  std::log(low );
+  double pow_up_log   = high <= 0.0 ? 0.0 : pow_up      * logHi;
+  double pow_down_log = low <= 0.0 ? 0.0 : -pow_down    * logLo;
+  double pow_up_log2  = high <= 0.0 ? 0.0 : pow_up_log  * logHi;
+  double pow_down_log2= low <= 0.0 ? 0.0 : -pow_down_log* logLo;
+
+  double S0 = (pow_up+pow_down)/2;
+  double A0 = (pow_up-pow_down)/2;
+  double S1 = (pow_up_log+pow_down_log)/2;
+  double A1 = (pow_up_log-pow_down_log)/2;
+  double S2 = (pow_up_log2+pow_down_log2)/2;
+  double A2 = (pow_up_log2-pow_down_log2)/2;
+
+  coeff[0] = 1./(8*x0)        *(      15*A0 -  7*x0*S1 + x0*x0*A2);
+  coeff[1] = 1./(8*x0*x0)     *(-24 + 24*S0 -  9*x0*A1 + x0*x0*S2);
+  coeff[2] = 1./(4*pow(x0, 3))*(    -  5*A0 +  5*x0*S1 - x0*x0*A2);
+  coeff[3] = 1./(4*pow(x0, 4))*( 12 - 12*S0 +  7*x0*A1 - x0*x0*S2);
+  coeff[4] = 1./(8*pow(x0, 5))*(    +  3*A0 -  3*x0*S1 + x0*x0*A2);
+  coeff[5] = 1./(8*pow(x0, 6))*( -8 +  8*S0 -  5*x0*A1 + x0*x0*S2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// C++ literal of the value
+
+TString Literal(Double_t value)
+{
+  if (std::isnan(value)) return "std::numeric_limits<double>::quiet_NaN()" ;
+  if (std::isinf(value)) {
+    return value>0 ? "std::numeric_limits<double>::infinity()" : "-std::numeric_limits<double>::infinity()" ;
+  }
+  return TString::Format("%.17g",value) ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The functions compiled in this session, by name
+
+std::map<std::string,Long_t>& CompiledFunctions()
+{
+  static std::map<std::string,Long_t> functions ;
+  return functions ;
+}
+
+// A channel of the model: the sum of the samples, its observable and the sum of
+// the weights of the data in each bin
+struct ChannelInfo {
+  TString label ;
+  RooRealSumPdf* sumPdf ;
+  RooRealVar* obs ;
+  std::vector<Double_t> sumW ;
+} ;
+
+// An operation of the generated code, which defines the variable 'name' from the
+// expressions of its arguments
+struct Operation {
+  enum Kind { kProduct, kSum, kPiecewise, kFlexible } ;
+  Kind kind ;
+  TString name ;
+  std::vector<TString> args ;   // Factors, terms or parameters of the interpolation
+  std::vector<Int_t> codes ;    // Interpolation codes
+  std::vector<TString> lows ;   // Low variations
+  std::vector<TString> highs ;  // High variations
+  std::vector<TString> coeffs ; // Polynomial coefficients of the code 4 of FlexibleInterpVar
+  TString nominal ;             // Nominal value of the interpolation
+  TString boundary ;            // Boundary of the code 4 of FlexibleInterpVar
+  Bool_t clip ;                 // Positive definite PiecewiseInterpolation
+} ;
+
+// Generation of the code of the channels. The nodes are defined once in a local
+// variable of the channel, before the loop over the bins when they do not depend
+// on the observable, and the parameters are the elements of the array x. The
+// operations are recorded, to generate both the function and its gradient, in
+// which the derivatives are propagated back from the likelihood of each bin to
+// the parameters (reverse mode).
+class CodeGenerator {
+public:
+  CodeGenerator(const RooArgSet& paramSet, RooArgList& params) :
+    _paramSet(paramSet), _params(params), _count(0), _gradient(kTRUE) {}
+
+  Bool_t addChannel(const ChannelInfo& ch, Bool_t extended) ;
+
+  const TString& arrays() const { return _arrays ; }
+  const TString& body() const { return _body ; }
+  const TString& gradientBody() const { return _gradBody ; }
+  Bool_t hasGradient() const { return _gradient ; }
+  const TString& error() const { return _error ; }
+
+private:
+  TString expr(const RooAbsReal& node) ;
+  TString table(const RooAbsReal& node) ;
+  TString array(const char* prefix, const std::vector<Double_t>& values, const char* type="double") ;
+  TString add(const RooAbsReal& node, Operation& op) ;
+  TString forward(const std::vector<Operation>& ops, const char* indent) const ;
+  TString backward(const std::vector<Operation>& ops, const char* indent) const ;
+  TString declareAdjoints(const std::vector<Operation>& ops, const char* indent) const ;
+  static TString adjoint(const TString& e) ;
+
+  const RooArgSet& _paramSet ;        // Candidate parameters
+  RooArgList& _params ;               // Parameters used, in the order of x
+  Int_t _count ;                      // Counter of the names of the variables
+  Bool_t _gradient ;                  // Can the gradient be generated?
+  TString _arrays ;                   // Constant arrays of all the channels
+  TString _body ;                     // Code of the function for all the channels
+  TString _gradBody ;                 // Code of the gradient for all the channels
+  TString _error ;                    // First error
+
+  RooRealVar* _obs ;                  // Observable of the current channel
+  std::vector<Double_t> _centers ;    // Bin centers of the current channel
+  std::map<const RooAbsArg*,TString> _names ; // Expressions of the nodes of the current channel
+  std::vector<Operation> _pre ;       // Operations before the loop over the bins
+  std::vector<Operation> _loop ;      // Operations in the loop over the bins
+} ;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the code of the negative log-likelihood of the channel, with the extended
+/// term if requested, and of its gradient
+
+Bool_t CodeGenerator::addChannel(const ChannelInfo& ch, Bool_t extended)
+{
+  _obs = ch.obs ;
+  _names.clear() ;
+  _pre.clear() ;
+  _loop.clear() ;
+
+  const RooAbsBinning& binning = _obs->getBinning() ;
+  const Int_t nBins = binning.numBins() ;
+  _centers.resize(nBins) ;
+  std::vector<Double_t> widths(nBins) ;
+  for (Int_t b=0 ; b<nBins ; b++) {
+    _centers[b] = binning.binCenter(b) ;
+    widths[b] = binning.binWidth(b) ;
+  }
+
+  // Value of the sum of the samples, as RooRealSumPdf::evaluate(), and its
+  // derivatives with respect to the coefficients and functions
+  const RooArgList& funcs = ch.sumPdf->funcList() ;
+  const RooArgList& coefs = ch.sumPdf->coefList() ;
+  const Bool_t haveLastCoef = coefs.getSize()<funcs.getSize() ;
+  const TString lastFunc = haveLastCoef ? expr(static_cast<const RooAbsReal&>(*funcs.at(funcs.getSize()-1))) : TString() ;
+  TString sum ;
+  TString sumAdjoint ;
+  TString lastCoef("1") ;
+  for (Int_t i=0 ; i<coefs.getSize() ; i++) {
+    const TString coef = expr(static_cast<const RooAbsReal&>(*coefs.at(i))) ;
+    const TString func = expr(static_cast<const RooAbsReal&>(*funcs.at(i))) ;
+    sum += TString::Format("%s%s * %s",i ? " + " : "",coef.Data(),func.Data()) ;
+    lastCoef += " - " + coef ;
+    if (adjoint(coef).Length()>0) {
+      sumAdjoint += TString::Format("         %s += a_s * %s;\n",adjoint(coef).Data(),
+				    haveLastCoef ? TString::Format("(%s - %s)",func.Data(),lastFunc.Data()).Data() : func.Data()) ;
+    }
+    if (adjoint(func).Length()>0) {
+      sumAdjoint += TString::Format("         %s += a_s * %s;\n",adjoint(func).Data(),coef.Data()) ;
+    }
+  }
+  if (haveLastCoef) {
+    sum += TString::Format("%s(%s) * %s",coefs.getSize() ? " + " : "",lastCoef.Data(),lastFunc.Data()) ;
+    if (adjoint(lastFunc).Length()>0) {
+      sumAdjoint += TString::Format("         %s += a_s * (%s);\n",adjoint(lastFunc).Data(),lastCoef.Data()) ;
+    }
+  }
+  if (_error.Length()>0) return kFALSE ;
+
+  Double_t sumW(0) ;
+  for (Int_t b=0 ; b<nBins ; b++) {
+    sumW += ch.sumW[b] ;
+  }
+  const TString data = array("data",ch.sumW) ;
+  const TString width = array("width",widths) ;
+
+  const Bool_t floor = ch.sumPdf->getFloor() || RooRealSumPdf::getFloorGlobal() ;
+  const TString sumCode = TString::Format("         const double sRaw = %s;\n         const double s = %s;\n",
+					  sum.Data(),floor ? "sRaw < 0 ? 0 : sRaw" : "sRaw") ;
+  const TString loopHead = TString::Format("      for (int b = 0; b < %d; ++b) {\n",nBins) ;
+  const TString logCode = TString::Format("         if (%s[b] != 0) logSum += %s[b] * std::log(s);\n",data.Data(),data.Data()) ;
+  const TString normCode = TString::Format("         norm += %s[b] * s;\n",width.Data()) ;
+  const TString nllCode = extended ? TString("      nll += norm - logSum;\n") :
+    TString::Format("      nll += %s * std::log(norm) - logSum;\n",Literal(sumW).Data()) ;
+  const TString head = TString::Format("   {\n      // channel %s: %s of %s with %d bins\n",
+				       ch.label.Data(),ch.sumPdf->GetName(),_obs->GetName(),nBins) ;
+
+  // Function
+  _body += head ;
+  _body += forward(_pre,"      ") ;
+  _body += "      double logSum = 0;\n      double norm = 0;\n" ;
+  _body += loopHead + forward(_loop,"         ") + sumCode + normCode + logCode + "      }\n" ;
+  _body += nllCode + "   }\n" ;
+
+  // Gradient: the derivative of the likelihood with respect to the value of each
+  // bin is propagated back through the operations of the bin, then through the
+  // operations before the loop. Without the extended term, the normalization is
+  // needed in the derivatives and is computed first.
+  _gradBody += head ;
+  _gradBody += forward(_pre,"      ") ;
+  _gradBody += declareAdjoints(_pre,"      ") ;
+  _gradBody += "      double logSum = 0;\n      double norm = 0;\n" ;
+  if (!extended) {
+    _gradBody += loopHead + forward(_loop,"         ") + sumCode + normCode + "      }\n" ;
+  }
+  _gradBody += loopHead + forward(_loop,"         ") + sumCode ;
+  if (extended) {
+    _gradBody += normCode ;
+  }
+  _gradBody += logCode ;
+  _gradBody += TString::Format("         const double aLog = %s[b] != 0 ? %s[b] / s : 0;\n",data.Data(),data.Data()) ;
+  if (extended) {
+    _gradBody += TString::Format("         const double a_s0 = %s[b] - aLog;\n",width.Data()) ;
+  } else {
+    _gradBody += TString::Format("         const double a_s0 = %s * %s[b] / norm - aLog;\n",Literal(sumW).Data(),width.Data()) ;
+  }
+  _gradBody += TString::Format("         const double a_s = %s;\n",floor ? "sRaw < 0 ? 0 : a_s0" : "a_s0") ;
+  _gradBody += declareAdjoints(_loop,"         ") ;
+  _gradBody += sumAdjoint ;
+  _gradBody += backward(_loop,"         ") ;
+  _gradBody += "      }\n" ;
+  _gradBody += backward(_pre,"      ") ;
+  _gradBody += nllCode + "   }\n" ;
+
+  return kTRUE ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Expression of the value of the node in the current bin of the channel
+
+TString CodeGenerator::expr(const RooAbsReal& node)
+{
+  std::map<const RooAbsArg*,TString>::iterator it = _names.find(&node) ;
+  if (it!=_names.end()) return it->second ;
+
+  TString ret ;
+  if (_paramSet.containsInstance(node)) {
+
+    // parameter of the function
+    Int_t idx = _params.index(&node) ;
+    if (idx<0) {
+      _params.add(node) ;
+      idx = _params.getSize()-1 ;
+    }
+    ret = TString::Format("x[%d]",idx) ;
+
+  } else if (!node.dependsOn(_paramSet)) {
+
+    // histogram or constant
+    ret = node.dependsOn(*_obs) ? table(node) : Literal(node.getVal()) ;
+
+  } else if (node.IsA()==RooProduct::Class()) {
+
+    Operation op ;
+    op.kind = Operation::kProduct ;
+    RooArgList comps = const_cast<RooProduct&>(static_cast<const RooProduct&>(node)).components() ;
+    for (Int_t i=0 ; i<comps.getSize() ; i++) {
+      RooAbsReal* comp = dynamic_cast<RooAbsReal*>(comps.at(i)) ;
+      if (!comp) {
+	_error = TString::Format("the category %s of the product %s is not supported",comps.at(i)->GetName(),node.GetName()) ;
+	return "0" ;
+      }
+      op.args.push_back(expr(*comp)) ;
+    }
+    ret = add(node,op) ;
+
+  } else if (node.IsA()==RooAddition::Class()) {
+
+    Operation op ;
+    op.kind = Operation::kSum ;
+    const RooArgList& comps = static_cast<const RooAddition&>(node).list() ;
+    for (Int_t i=0 ; i<comps.getSize() ; i++) {
+      op.args.push_back(expr(static_cast<const RooAbsReal&>(*comps.at(i)))) ;
+    }
+    ret = add(node,op) ;
+
+  } else if (node.IsA()==PiecewiseInterpolation::Class()) {
+
+    const PiecewiseInterpolation& pwi = static_cast<const PiecewiseInterpolation&>(node) ;
+    Operation op ;
+    op.kind = Operation::kPiecewise ;
+    op.nominal = expr(pwi.nominalHist()) ;
+    op.clip = pwi.positiveDefinite() ;
+    for (Int_t i=0 ; i<pwi.paramList().getSize() ; i++) {
+      const Int_t code = pwi.interpolationCodes()[i] ;
+      if (code<0 || code>5) {
+	_error = TString::Format("the interpolation code %d of %s is not supported",code,node.GetName()) ;
+	return "0" ;
+      }
+      op.codes.push_back(code) ;
+      op.args.push_back(expr(static_cast<const RooAbsReal&>(*pwi.paramList().at(i)))) ;
+      op.lows.push_back(expr(static_cast<const RooAbsReal&>(*pwi.lowList().at(i)))) ;
+      op.highs.push_back(expr(static_cast<const RooAbsReal&>(*pwi.highList().at(i)))) ;
+      // the derivatives are only propagated to the interpolation parameters
+      if (adjoint(op.lows.back()).Length()>0 || adjoint(op.highs.back()).Length()>0) _gradient = kFALSE ;
+    }
+    if (adjoint(op.nominal).Length()>0) _gradient = kFALSE ;
+    ret = add(node,op) ;
+
+  } else if (node.IsA()==FlexibleInterpVar::Class()) {
+
+    const FlexibleInterpVar& fiv = static_cast<const FlexibleInterpVar&>(node) ;
+    Operation op ;
+    op.kind = Operation::kFlexible ;
+    op.nominal = Literal(fiv.nominal()) ;
+    op.boundary = Literal(fiv.globalBoundary()) ;
+    for (Int_t i=0 ; i<fiv.variables().getSize() ; i++) {
+      const Int_t code = fiv.interpolationCodes()[i] ;
+      if (code<0 || code>4) {
+	_error = TString::Format("the interpolation code %d of %s is not supported",code,node.GetName()) ;
+	return "0" ;
+      }
+      op.codes.push_back(code) ;
+      op.args.push_back(expr(static_cast<const RooAbsReal&>(*fiv.variables().at(i)))) ;
+      op.lows.push_back(Literal(fiv.low()[i])) ;
+      op.highs.push_back(Literal(fiv.high()[i])) ;
+      if (code==4) {
+	std::vector<Double_t> c(6) ;
+	FlexiblePolyCoefficients(fiv.nominal(),fiv.low()[i],fiv.high()[i],fiv.globalBoundary(),&c[0]) ;
+	op.coeffs.push_back(array("coeff",c)) ;
+      } else {
+	op.coeffs.push_back("0") ;
+      }
+    }
+    ret = add(node,op) ;
+
+  } else if (node.IsA()==ParamHistFunc::Class()) {
+
+    // index of the parameter of each bin
+    const ParamHistFunc& phf = static_cast<const ParamHistFunc&>(node) ;
+    const Double_t oldVal = _obs->getVal() ;
+    std::vector<Double_t> index(_centers.size()) ;
+    for (UInt_t b=0 ; b<_centers.size() ; b++) {
+      _obs->setVal(_centers[b]) ;
+      RooRealVar& param = phf.getParameter() ;
+      if (!_paramSet.containsInstance(param)) {
+	_error = TString::Format("the parameter %s of %s is not a parameter of the model",param.GetName(),node.GetName()) ;
+	break ;
+      }
+      expr(param) ;
+      index[b] = _params.index(&param) ;
+    }
+    _obs->setVal(oldVal) ;
+    if (_error.Length()>0) return "0" ;
+    ret = TString::Format("x[%s[b]]",array("index",index,"int").Data()) ;
+
+  } else {
+    _error = TString::Format("the class %s of %s is not supported",node.IsA()->GetName(),node.GetName()) ;
+    return "0" ;
+  }
+
+  _names[&node] = ret ;
+  return ret ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Array of the values of the node, which depends only on the observable, at the
+/// centers of the bins
+
+TString CodeGenerator::table(const RooAbsReal& node)
+{
+  const Double_t oldVal = _obs->getVal() ;
+  std::vector<Double_t> values(_centers.size()) ;
+  for (UInt_t b=0 ; b<_centers.size() ; b++) {
+    _obs->setVal(_centers[b]) ;
+    values[b] = node.getVal() ;
+  }
+  _obs->setVal(oldVal) ;
+  return array("hist",values) + "[b]" ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Define a constant array of the values, of the given type, and return its name
+
+TString CodeGenerator::array(const char* prefix, const std::vector<Double_t>& values, const char* type)
+{
+  const TString name = TString::Format("%s_%d",prefix,_count++) ;
+  _arrays += TString::Format("const %s %s[%d] = {",type,name.Data(),Int_t(values.size())) ;
+  for (UInt_t i=0 ; i<values.size() ; i++) {
+    _arrays += TString::Format("%s%s",(i%4) ? ", " : (i ? ",\n   " : ""),Literal(values[i]).Data()) ;
+  }
+  _arrays += "};\n" ;
+  return name ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the operation computing the node, before the loop over the bins or in
+/// it, and return the name of its variable
+
+TString CodeGenerator::add(const RooAbsReal& node, Operation& op)
+{
+  op.name = TString::Format("v_%d",_count++) ;
+  (node.dependsOn(*_obs) ? _loop : _pre).push_back(op) ;
+  return op.name ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Variable of the derivative of the likelihood with respect to the expression,
+/// empty if the expression does not depend on the parameters
+
+TString CodeGenerator::adjoint(const TString& e)
+{
+  if (e.BeginsWith("v_")) return "a_" + e ;
+  if (e.BeginsWith("x[")) return "g" + e(1,e.Length()-1) ;
+  return "" ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Code of the operations. The interpolations define a variable for the value
+/// after each of their terms, used by the gradient.
+
+TString CodeGenerator::forward(const std::vector<Operation>& ops, const char* indent) const
+{
+  TString code ;
+  for (UInt_t k=0 ; k<ops.size() ; k++) {
+    const Operation& op = ops[k] ;
+    const char* name = op.name.Data() ;
+    if (op.kind==Operation::kProduct || op.kind==Operation::kSum) {
+      TString value ;
+      for (UInt_t i=0 ; i<op.args.size() ; i++) {
+	value += TString::Format("%s%s",i ? (op.kind==Operation::kProduct ? " * " : " + ") : "",op.args[i].Data()) ;
+      }
+      if (op.args.empty()) value = op.kind==Operation::kProduct ? "1" : "0" ;
+      code += TString::Format("%sconst double %s = %s;\n",indent,name,value.Data()) ;
+      continue ;
+    }
+    const Bool_t pwi = op.kind==Operation::kPiecewise ;
+    code += TString::Format("%sconst double %s_0 = %s;\n",indent,name,op.nominal.Data()) ;
+    for (UInt_t i=0 ; i<op.args.size() ; i++) {
+      if (pwi) {
+	code += TString::Format("%sconst double %s_%d = PiecewiseTerm(%d, %s_%d, %s, %s, %s, %s);\n",indent,name,i+1,
+				op.codes[i],name,i,op.args[i].Data(),op.nominal.Data(),op.lows[i].Data(),op.highs[i].Data()) ;
+      } else {
+	code += TString::Format("%sconst double %s_%d = FlexibleTerm(%d, %s_%d, %s, %s, %s, %s, %s, %s);\n",indent,name,i+1,
+				op.codes[i],name,i,op.args[i].Data(),op.nominal.Data(),op.lows[i].Data(),op.highs[i].Data(),
+				op.boundary.Data(),op.coeffs[i].Data()) ;
+      }
+    }
+    const Int_t n = op.args.size() ;
+    if (pwi) {
+      code += op.clip ? TString::Format("%sconst double %s = %s_%d < 0 ? 0 : %s_%d;\n",indent,name,name,n,name,n) :
+	TString::Format("%sconst double %s = %s_%d;\n",indent,name,name,n) ;
+    } else {
+      code += TString::Format("%sconst double %s = %s_%d <= 0 ? std::numeric_limits<double>::min() : %s_%d;\n",
+			      indent,name,name,n,name,n) ;
+    }
+  }
+  return code ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declaration of the derivatives of the likelihood with respect to the variables
+/// of the operations
+
+TString CodeGenerator::declareAdjoints(const std::vector<Operation>& ops, const char* indent) const
+{
+  TString code ;
+  for (UInt_t k=0 ; k<ops.size() ; k++) {
+    code += TString::Format("%sdouble a_%s = 0;\n",indent,ops[k].name.Data()) ;
+  }
+  return code ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Code propagating the derivatives with respect to the variables of the
+/// operations to their arguments, in the reverse order of the operations
+
+TString CodeGenerator::backward(const std::vector<Operation>& ops, const char* indent) const
+{
+  TString code ;
+  for (Int_t k=ops.size()-1 ; k>=0 ; k--) {
+    const Operation& op = ops[k] ;
+    const char* name = op.name.Data() ;
+    if (op.kind==Operation::kProduct || op.kind==Operation::kSum) {
+      for (UInt_t i=0 ; i<op.args.size() ; i++) {
+	const TString adj = adjoint(op.args[i]) ;
+	if (adj.Length()==0) continue ;
+	TString factor ;
+	if (op.kind==Operation::kProduct) {
+	  for (UInt_t j=0 ; j<op.args.size() ; j++) {
+	    if (j!=i) factor += " * " + op.args[j] ;
+	  }
+	}
+	code += TString::Format("%s%s += a_%s%s;\n",indent,adj.Data(),name,factor.Data()) ;
+      }
+      continue ;
+    }
+    const Bool_t pwi = op.kind==Operation::kPiecewise ;
+    const Int_t n = op.args.size() ;
+    code += TString::Format("%s{\n",indent) ;
+    if (pwi && !op.clip) {
+      code += TString::Format("%s   double a = a_%s;\n",indent,name) ;
+    } else {
+      code += TString::Format("%s   double a = %s_%d %s 0 ? 0 : a_%s;\n",indent,name,n,pwi ? "<" : "<=",name) ;
+    }
+    code += TString::Format("%s   double dsum, dx;\n",indent) ;
+    for (Int_t i=n-1 ; i>=0 ; i--) {
+      if (pwi) {
+	code += TString::Format("%s   PiecewiseTermGrad(%d, %s_%d, %s, %s, %s, %s, dsum, dx);\n",indent,op.codes[i],name,i,
+				op.args[i].Data(),op.nominal.Data(),op.lows[i].Data(),op.highs[i].Data()) ;
+      } else {
+	code += TString::Format("%s   FlexibleTermGrad(%d, %s_%d, %s, %s, %s, %s, %s, %s, dsum, dx);\n",indent,op.codes[i],name,i,
+				op.args[i].Data(),op.nominal.Data(),op.lows[i].Data(),op.highs[i].Data(),
+				op.boundary.Data(),op.coeffs[i].Data()) ;
+      }
+      const TString adj = adjoint(op.args[i]) ;
+      if (adj.Length()>0) code += TString::Format("%s   %s += a * dx;\n",indent,adj.Data()) ;
+      if (i>0) code += TString::Format("%s   a *= dsum;\n",indent) ;
+    }
+    code += TString::Format("%s}\n",indent) ;
+  }
+  return code ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The term of the channel pdf which depends on the observables, if it is a RooRealSumPdf
+
+RooRealSumPdf* FindSumPdf(RooAbsPdf& pdf, const RooArgSet& observables)
+{
+  if (pdf.IsA()==RooRealSumPdf::Class()) return static_cast<RooRealSumPdf*>(&pdf) ;
+  if (pdf.IsA()!=RooProdPdf::Class()) return 0 ;
+
+  RooRealSumPdf* ret(0) ;
+  RooFIter iter = static_cast<RooProdPdf&>(pdf).pdfList().fwdIterator() ;
+  RooAbsArg* term ;
+  while((term=iter.next())) {
+    if (!term->dependsOn(observables)) continue ;
+    if (ret || term->IsA()!=RooRealSumPdf::Class()) return 0 ;
+    ret = static_cast<RooRealSumPdf*>(term) ;
+  }
+  return ret ;
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor
+
+CompiledLikelihood::CompiledLikelihood() :
+  _gradient(kFALSE),
+  _func(0),
+  _gradFunc(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code of the negative log-likelihood of the model pdf on the data,
+/// and compile it. The constraint terms are normalized over the global observables
+/// if given, over the parameters otherwise. If a file name is given, the code is
+/// written in it and compiled by ACLiC, otherwise it is compiled by cling.
+
+CompiledLikelihood::CompiledLikelihood(const char *name, const char *title, RooAbsPdf& pdf, RooAbsData& data,
+				       const RooArgSet* globalObservables, const char* fileName) :
+  RooAbsReal(name,title),
+  _params("params","Parameters of the generated function",this),
+  _constraints("constraints","Constraint terms",this),
+  _constrNormSet("constrNormSet","Normalization set of the constraint terms",this),
+  _fileName(fileName),
+  _gradient(kFALSE),
+  _func(0),
+  _gradFunc(0)
+{
+  RooArgList params ;
+  TString code ;
+  if (!GenerateCode(pdf,data,params,kNameToken,code,&_gradient)) {
+    return ;
+  }
+
+  // The name depends on the code, as the functions cannot be redefined
+  _funcName = TString::Format("%s_nll_%x",pdf.GetName(),code.Hash()) ;
+  for (Int_t i=0 ; i<_funcName.Length() ; i++) {
+    if (!isalnum(_funcName[i])) _funcName[i] = '_' ;
+  }
+  code.ReplaceAll(kNameToken,_funcName) ;
+  _code = code ;
+  _params.add(params) ;
+
+  // Constraint terms, as found by RooAbsPdf::createNLL
+  RooArgSet* cPars = pdf.getParameters(data) ;
+  RooArgSet* constr = pdf.getAllConstraints(*data.get(),*cPars,kTRUE) ;
+  if (constr->getSize()>0) {
+    _constraints.add(*constr) ;
+    _constrNormSet.add(globalObservables ? *globalObservables : *cPars) ;
+  }
+  delete constr ;
+  delete cPars ;
+
+  compile() ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor: the compiled function is shared
+
+CompiledLikelihood::CompiledLikelihood(const CompiledLikelihood& other, const char* name) :
+  RooAbsReal(other,name),
+  _params("params",this,other._params),
+  _constraints("constraints",this,other._constraints),
+  _constrNormSet("constrNormSet",this,other._constrNormSet),
+  _code(other._code),
+  _funcName(other._funcName),
+  _fileName(other._fileName),
+  _gradient(other._gradient),
+  _func(other._func),
+  _gradFunc(other._gradFunc)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+CompiledLikelihood::~CompiledLikelihood()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code of the function 'funcName' of the negative log-likelihood
+/// of the channels of the model pdf on the data, without the constraint terms.
+/// The function takes the array of the values of the parameters, which are
+/// added to 'params' in this order. If the derivatives of all the nodes are
+/// known, the function 'funcName_grad', which also fills the array of the
+/// derivatives with respect to the parameters, is generated too and 'gradient'
+/// (if given) is set to true. Return false, with an error message, if the model
+/// is not supported.
+
+Bool_t CompiledLikelihood::GenerateCode(RooAbsPdf& pdf, RooAbsData& data, RooArgList& params, const char* funcName,
+					TString& code, Bool_t* gradient)
+{
+  if (gradient) *gradient = kFALSE ;
+
+  // Channels
+  std::vector<ChannelInfo> channels ;
+  RooSimultaneous* sim = dynamic_cast<RooSimultaneous*>(&pdf) ;
+  if (sim) {
+    TIterator* iter = sim->indexCat().typeIterator() ;
+    RooCatType* type ;
+    while((type=(RooCatType*)iter->Next())) {
+      RooAbsPdf* chPdf = sim->getPdf(type->GetName()) ;
+      if (!chPdf) continue ;
+      ChannelInfo ch ;
+      ch.label = type->GetName() ;
+      ch.sumPdf = FindSumPdf(*chPdf,*data.get()) ;
+      channels.push_back(ch) ;
+    }
+    delete iter ;
+  } else {
+    ChannelInfo ch ;
+    ch.label = pdf.GetName() ;
+    ch.sumPdf = FindSumPdf(pdf,*data.get()) ;
+    channels.push_back(ch) ;
+  }
+
+  for (UInt_t i=0 ; i<channels.size() ; i++) {
+    ChannelInfo& ch = channels[i] ;
+    if (!ch.sumPdf) {
+      oocoutE(&pdf,InputArguments) << "CompiledLikelihood::GenerateCode(" << pdf.GetName() << ") ERROR: the channel "
+				   << ch.label << " is not a RooRealSumPdf, possibly multiplied by constraint terms" << endl ;
+      return kFALSE ;
+    }
+    RooArgSet* obs = ch.sumPdf->getObservables(data) ;
+    ch.obs = obs->getSize()==1 ? dynamic_cast<RooRealVar*>(obs->first()) : 0 ;
+    delete obs ;
+    if (!ch.obs || !ch.sumPdf->isBinnedDistribution(*ch.obs)) {
+      oocoutE(&pdf,InputArguments) << "CompiledLikelihood::GenerateCode(" << pdf.GetName() << ") ERROR: the channel "
+				   << ch.label << " is not a binned distribution of one observable" << endl ;
+      return kFALSE ;
+    }
+    ch.sumW.assign(ch.obs->getBinning().numBins(),0.) ;
+  }
+
+  // Sum of the weights of the data in each bin
+  for (Int_t i=0 ; i<data.numEntries() ; i++) {
+    const RooArgSet* row = data.get(i) ;
+    const Double_t w = data.weight() ;
+    if (w==0) continue ;
+    ChannelInfo* ch(0) ;
+    if (sim) {
+      const char* label = row->getCatLabel(sim->indexCat().GetName()) ;
+      for (UInt_t k=0 ; k<channels.size() ; k++) {
+	if (channels[k].label==label) ch = &channels[k] ;
+      }
+      if (!ch) continue ;
+    } else {
+      ch = &channels[0] ;
+    }
+    ch->sumW[ch->obs->getBinning().binNumber(row->getRealValue(ch->obs->GetName()))] += w ;
+  }
+
+  RooArgSet* paramSet = pdf.getParameters(data) ;
+  CodeGenerator gen(*paramSet,params) ;
+  const Bool_t extended = pdf.extendMode()!=RooAbsPdf::CanNotBeExtended ;
+  for (UInt_t i=0 ; i<channels.size() ; i++) {
+    if (!gen.addChannel(channels[i],extended)) {
+      oocoutE(&pdf,InputArguments) << "CompiledLikelihood::GenerateCode(" << pdf.GetName() << ") ERROR: in the channel "
+				   << channels[i].label << ", " << gen.error() << endl ;
+      delete paramSet ;
+      return kFALSE ;
+    }
+  }
+  delete paramSet ;
+
+  code = TString::Format("// Negative log-likelihood of the model %s on the data %s, generated by\n"
+			 "// RooStats::HistFactory::CompiledLikelihood. The parameters are:\n",pdf.GetName(),data.GetName()) ;
+  for (Int_t i=0 ; i<params.getSize() ; i++) {
+    code += TString::Format("//  x[%d] %s\n",i,params.at(i)->GetName()) ;
+  }
+  code += "\n#include <cmath>\n#include <limits>\n\n" ;
+  code += TString::Format("namespace %s_impl {\n%s\n%s}\n\n",funcName,kHelperCode,gen.arrays().Data()) ;
+  code += TString::Format("double %s(const double *x)\n{\n   using namespace %s_impl;\n   double nll = 0;\n",funcName,funcName) ;
+  code += gen.body() ;
+  code += "   return nll;\n}\n" ;
+
+  if (gen.hasGradient()) {
+    code += TString::Format("\ndouble %s_grad(const double *x, double *g)\n{\n   using namespace %s_impl;\n"
+			    "   for (int i = 0; i < %d; ++i) g[i] = 0;\n   double nll = 0;\n",
+			    funcName,funcName,params.getSize()) ;
+    code += gen.gradientBody() ;
+    code += "   return nll;\n}\n" ;
+    if (gradient) *gradient = kTRUE ;
+  }
+
+  return kTRUE ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the generated code, if it is not yet done. Return false if the
+/// compilation fails.
+
+Bool_t CompiledLikelihood::compile() const
+{
+  if (_func) return kTRUE ;
+  if (!isValid()) {
+    coutE(InputArguments) << "CompiledLikelihood::compile(" << GetName() << ") ERROR: no generated code" << endl ;
+    return kFALSE ;
+  }
+
+  const TString gradName = _funcName + "_grad" ;
+  std::map<std::string,Long_t>& functions = CompiledFunctions() ;
+  if (functions.find(_funcName.Data())==functions.end()) {
+    if (_fileName.Length()>0) {
+      std::ofstream file(_fileName.Data()) ;
+      file << _code ;
+      file.close() ;
+      if (!file || !gSystem->CompileMacro(_fileName,"kO")) {
+	coutE(InputArguments) << "CompiledLikelihood::compile(" << GetName() << ") ERROR: the compilation of "
+			      << _fileName << " by ACLiC failed" << endl ;
+	return kFALSE ;
+      }
+    } else if (!gInterpreter->Declare(TString("#pragma cling optimize(2)\n") + _code)) {
+      coutE(InputArguments) << "CompiledLikelihood::compile(" << GetName() << ") ERROR: the compilation by cling failed" << endl ;
+      return kFALSE ;
+    }
+    const Long_t address = gInterpreter->Calc(TString::Format("(long)&%s",_funcName.Data())) ;
+    if (!address) {
+      coutE(InputArguments) << "CompiledLikelihood::compile(" << GetName() << ") ERROR: the function "
+			    << _funcName << " is not found" << endl ;
+      return kFALSE ;
+    }
+    functions[_funcName.Data()] = address ;
+    if (_gradient) {
+      functions[gradName.Data()] = gInterpreter->Calc(TString::Format("(long)&%s",gradName.Data())) ;
+    }
+  }
+
+  _func = reinterpret_cast<Function>(functions[_funcName.Data()]) ;
+  if (_gradient) {
+    _gradFunc = reinterpret_cast<GradFunction>(functions[gradName.Data()]) ;
+  }
+  return kTRUE ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Value of the generated function for the current values of the parameters,
+/// plus the constraint terms
+
+Double_t CompiledLikelihood::evaluate() const
+{
+  if (!_func && !compile()) {
+    return std::numeric_limits<Double_t>::quiet_NaN() ;
+  }
+
+  setValues() ;
+  Double_t ret = _func(_values.empty() ? 0 : &_values[0]) ;
+
+  RooFIter citer = _constraints.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=citer.next())) {
+    ret -= static_cast<RooAbsPdf*>(arg)->getLogVal(&_constrNormSet) ;
+  }
+
+  return ret ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the current values of the parameters in the array passed to the
+/// generated functions
+
+void CompiledLikelihood::setValues() const
+{
+  _values.resize(_params.getSize()) ;
+  RooFIter iter = _params.fwdIterator() ;
+  RooAbsArg* arg ;
+  Int_t i(0) ;
+  while((arg=iter.next())) {
+    _values[i++] = static_cast<RooAbsReal*>(arg)->getVal() ;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Gradient with respect to the variables, for their current values. The
+/// derivatives of the channels are computed by the generated code, the ones of
+/// the constraint terms by finite differences of their logarithms. Return false
+/// if the gradient of the generated code is not available.
+
+Bool_t CompiledLikelihood::gradient(const RooArgList& vars, Double_t* grad) const
+{
+  if (!_gradient || (!_gradFunc && !compile()) || !_gradFunc) {
+    return kFALSE ;
+  }
+
+  setValues() ;
+  _grad.resize(_params.getSize()) ;
+  _gradFunc(_values.empty() ? 0 : &_values[0],_grad.empty() ? 0 : &_grad[0]) ;
+
+  for (Int_t i=0 ; i<vars.getSize() ; i++) {
+    RooAbsArg* var = vars.at(i) ;
+    const Int_t index = _params.index(var) ;
+    grad[i] = index>=0 ? _grad[index] : 0 ;
+
+    RooAbsRealLValue* lvalue = dynamic_cast<RooAbsRealLValue*>(var) ;
+    if (!lvalue) continue ;
+    RooFIter citer = _constraints.fwdIterator() ;
+    RooAbsArg* arg ;
+    while((arg=citer.next())) {
+      if (!arg->dependsOn(*var)) continue ;
+      RooAbsPdf* constr = static_cast<RooAbsPdf*>(arg) ;
+      const Double_t val = lvalue->getVal() ;
+      const Double_t h = 1e-5*(1+std::abs(val)) ;
+      const Double_t lo = std::max(val-h,lvalue->getMin()) ;
+      const Double_t hi = std::min(val+h,lvalue->getMax()) ;
+      if (hi<=lo) continue ;
+      lvalue->setVal(hi) ;
+      const Double_t logHi = constr->getLogVal(&_constrNormSet) ;
+      lvalue->setVal(lo) ;
+      const Double_t logLo = constr->getLogVal(&_constrNormSet) ;
+      lvalue->setVal(val) ;
+      grad[i] -= (logHi-logLo)/(hi-lo) ;
+    }
+  }
+
+  return kTRUE ;
+}
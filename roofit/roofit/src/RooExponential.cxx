@@ -57,6 +57,27 @@ Double_t RooExponential::evaluate() const{
   return exp(c*x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of the exponential for a block of events at once, from
+/// the batches of values of x and c (see RooAbsReal::getValBatch())
+
+Bool_t RooExponential::evaluateBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  if (normSet && hasConditionalObservables(data,normSet)) return kFALSE ;
+  const Double_t normVal = getBatchNorm(normSet) ;
+
+  vector<Double_t> xVal(nEvents), cVal(nEvents) ;
+  x.arg().getValBatch(&xVal[0],firstEvent,nEvents,data,x.nset()) ;
+  c.arg().getValBatch(&cVal[0],firstEvent,nEvents,data,c.nset()) ;
+
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    output[i] = exp(cVal[i]*xVal[i]) ;
+  }
+
+  normalizeBatch(output,nEvents,normVal) ;
+  return kTRUE ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooExponential::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const
@@ -69,6 +69,30 @@ Double_t RooGaussian::evaluate() const
   return ret ;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of the Gaussian for a block of events at once, from the
+/// batches of values of x, mean and sigma (see RooAbsReal::getValBatch())
+
+Bool_t RooGaussian::evaluateBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  if (normSet && hasConditionalObservables(data,normSet)) return kFALSE ;
+  const Double_t normVal = getBatchNorm(normSet) ;
+
+  vector<Double_t> xVal(nEvents), meanVal(nEvents), sigmaVal(nEvents) ;
+  x.arg().getValBatch(&xVal[0],firstEvent,nEvents,data,x.nset()) ;
+  mean.arg().getValBatch(&meanVal[0],firstEvent,nEvents,data,mean.nset()) ;
+  sigma.arg().getValBatch(&sigmaVal[0],firstEvent,nEvents,data,sigma.nset()) ;
+
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    const Double_t arg = xVal[i] - meanVal[i] ;
+    const Double_t sig = sigmaVal[i] ;
+    output[i] = exp(-0.5*arg*arg/(sig*sig)) ;
+  }
+
+  normalizeBatch(output,nEvents,normVal) ;
+  return kTRUE ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// calculate and return the negative log-likelihood of the Poisson
 
@@ -29,6 +29,7 @@
 #include <set>
 #include <deque>
 #include <stack>
+#include <vector>
 
 #include <iostream>
 
@@ -571,6 +572,13 @@ public:
   mutable Bool_t _valueDirty ;  // Flag set if value needs recalculating because input values modified
   mutable Bool_t _shapeDirty ;  // Flag set if value needs recalculating because input shapes modified
 
+  // Flattened value client graph used by setValueDirty()
+  void buildValueClientClosure() const ;
+  static void clientGraphChanged() { ++_clientGraphGen ; }
+  mutable std::vector<RooAbsArg*> _valueClientClosure ; //! All nodes downstream of this node reached by the propagation of value changes
+  mutable ULong64_t _valueClientClosureGen ; //! Value of _clientGraphGen when _valueClientClosure was built
+  static ULong64_t _clientGraphGen ; //! Counter of the changes of client links and operation modes of all nodes
+
   friend class RooRealProxy ;
   mutable OperMode _operMode ; // Dirty state propagation mode
   mutable Bool_t _fast ; // Allow fast access mode in getVal() and proxies
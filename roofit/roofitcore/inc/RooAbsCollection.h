@@ -163,6 +163,7 @@ protected:
 
   friend class RooMultiCatIter ;
 
+  static const Int_t _defaultHashThreshold ; // Size above which the lookups use hash tables
   RooLinkedList _list ; // Actual object store
 
   Bool_t _ownCont;  // Flag to identify a list that owns its contents.
@@ -55,6 +55,10 @@ public:
   Bool_t isSealed() const { return _sealed ; }
   const char* sealNotice() const { return _sealNotice.Data() ; }
 
+  // Precalculation of the normalization integrals that are constant during the minimization
+  static void setPrecalculateConstantIntegrals(Bool_t flag) ;
+  static Bool_t precalculateConstantIntegrals() ;
+
 
 protected:
 
@@ -72,6 +76,7 @@ protected:
   virtual RooArgSet requiredExtraObservables() const { return RooArgSet() ; }
   void optimizeCaching() ;
   void optimizeConstantTerms(Bool_t,Bool_t=kTRUE) ;
+  void precalculateIntegrals(Bool_t activate) ;
 
   RooArgSet*  _normSet ; // Pointer to set with observables used for normalization
   RooArgSet*  _funcCloneSet ; // Set owning all components of internal clone of input function
@@ -87,6 +92,9 @@ protected:
   RooAbsReal* _origFunc ; // Original function 
   RooAbsData* _origData ; // Original data 
   Bool_t      _optimized ; //!
+  RooArgSet   _constNormInts ; //! List of normalization integrals that are precalculated as constant
+
+  static Bool_t _precalcConstInts ; // Precalculate constant normalization integrals
 
   ClassDef(RooAbsOptTestStatistic,4) // Abstract base class for optimized test statistics
 };
@@ -186,6 +186,7 @@ public:
   virtual Bool_t traceEvalHook(Double_t value) const ;  
   virtual Double_t getValV(const RooArgSet* set=0) const ;
   virtual Double_t getLogVal(const RooArgSet* set=0) const ;
+  void getLogValBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet=0) const ;
 
   Double_t getNorm(const RooArgSet& nset) const { 
     // Get p.d.f normalization term needed for observables 'nset'
@@ -246,6 +247,7 @@ public:
   void setNormRangeOverride(const char* rangeName) ;
 
   const RooAbsReal* getNormIntegral(const RooArgSet& nset) const { return getNormObj(0,&nset,0) ; }
+  RooArgList normIntegrals() const ;
   
 protected:   
 
@@ -296,6 +298,12 @@ protected:
 
   virtual Bool_t syncNormalization(const RooArgSet* dset, Bool_t adjustProxies=kTRUE) const ;
 
+  // Support for the batch evaluations of derived classes
+  Bool_t hasConditionalObservables(const RooVectorDataStore& data, const RooArgSet* normSet) const ;
+  Double_t getBatchNorm(const RooArgSet* normSet) const ;
+  void normalizeBatch(Double_t* output, Int_t nEvents, Double_t normVal) const ;
+  Double_t logValue(Double_t prob) const ;
+
   friend class RooAbsAnaConvPdf ;
   mutable Double_t _rawValue ;
   mutable RooAbsReal* _norm   ;      //! Normalization integral (owned by _normMgr)
@@ -305,6 +313,7 @@ protected:
   public:
     CacheElem(RooAbsReal& norm) : _norm(&norm) {} ;
     void operModeHook(RooAbsArg::OperMode) ;
+    virtual Bool_t redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t isRecursive) ;
     virtual ~CacheElem() ; 
     virtual RooArgList containedArgs(Action) { return RooArgList(*_norm) ; }
     RooAbsReal* _norm ;
@@ -73,6 +73,9 @@ public:
 
   virtual Double_t getValV(const RooArgSet* set=0) const ;
 
+  // Evaluation for a block of events of a vector data store at once
+  void getValBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet=0) const ;
+
   Double_t getPropagatedError(const RooFitResult &fr, const RooArgSet &nset = RooArgSet());
 
   Bool_t operator==(Double_t value) const ;
@@ -191,6 +194,10 @@ public:
     return 1.0 ; 
   }
 
+  // Analytical gradient, used by RooMinimizer if available
+  virtual Bool_t hasGradient() const { return kFALSE ; }
+  virtual Bool_t gradient(const RooArgList& vars, Double_t* grad) const ;
+
   const RooNumIntConfig* getIntegratorConfig() const ;
   RooNumIntConfig* getIntegratorConfig() ;
   static RooNumIntConfig* defaultIntegratorConfig()  ;
@@ -371,6 +378,7 @@ protected:
     return kFALSE ;
   }
   virtual Double_t evaluate() const = 0 ;
+  virtual Bool_t evaluateBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const ;
 
   // Hooks for RooDataSet interface
   friend class RooRealIntegral ;
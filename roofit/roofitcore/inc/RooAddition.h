@@ -36,6 +36,9 @@ public:
 
   virtual Double_t defaultErrorLevel() const ;
 
+  virtual Bool_t hasGradient() const ;
+  virtual Bool_t gradient(const RooArgList& vars, Double_t* grad) const ;
+
   void printMetaArgs(std::ostream& os) const ;
 
   const RooArgList& list1() const { return _set ; }
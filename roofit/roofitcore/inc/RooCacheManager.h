@@ -84,6 +84,7 @@ public:
   } 
 
   T* getObjByIndex(Int_t index) const ;
+  Bool_t setObjByIndex(Int_t index, T* obj) ;
   const RooNameSet* nameSet1ByIndex(Int_t index) const ;
   const RooNameSet* nameSet2ByIndex(Int_t index) const ;
 
@@ -333,6 +334,23 @@ T* RooCacheManager<T>::getObjByIndex(Int_t index) const
   return _object[index] ;
 }
 
+template<class T>
+Bool_t RooCacheManager<T>::setObjByIndex(Int_t index, T* obj)
+{
+  // Store payload object in the empty (sterile) slot at given index, keeping
+  // the normalization sets of the slot. Return false if there is no such slot
+
+  if (index<0||index>=_size||_object[index]) {
+    return kFALSE ;
+  }
+  _object[index] = obj ;
+
+  // Allow optional post-processing of object inserted in cache
+  insertObjectHook(*obj) ;
+
+  return kTRUE ;
+}
+
 template<class T>
 const RooNameSet* RooCacheManager<T>::nameSet1ByIndex(Int_t index) const
 {
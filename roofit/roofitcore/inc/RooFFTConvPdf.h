@@ -19,8 +19,10 @@
 #include "RooHistPdf.h"
 #include "TVirtualFFT.h"
 class RooRealVar ;
+class RooChangeTracker ;
 
 #include <map>
+#include <vector>
  
 class RooFFTConvPdf : public RooAbsCachedPdf {
 public:
@@ -92,6 +94,18 @@ protected:
     RooAbsBinning* histBinning ;
     RooAbsBinning* scanBinning ;
 
+    // Transforms of the sampled input p.d.f.s for each slice of the cache, which are
+    // only recalculated when the parameters of the corresponding input p.d.f. change
+    RooChangeTracker* tracker1 ; // Parameters of the first input p.d.f.
+    RooChangeTracker* tracker2 ; // Parameters of the second input p.d.f.
+    Bool_t redo1 ; // First input p.d.f. changed since the last fill
+    Bool_t redo2 ; // Second input p.d.f. changed since the last fill
+    Double_t shift1 ; // Shift of the stored transforms of the first input p.d.f.
+    Double_t shift2 ; // Shift of the stored transforms of the second input p.d.f.
+    std::vector<std::vector<Double_t> > spec1 ; // Transforms of the first input p.d.f. (re,im pairs)
+    std::vector<std::vector<Double_t> > spec2 ; // Transforms of the second input p.d.f. (re,im pairs)
+    std::vector<Int_t> zeroBin1 ; // Position of the zero bin of the first input p.d.f.
+
   };
 
   friend class FFTCacheElem ;  
@@ -102,7 +116,7 @@ protected:
   virtual RooArgSet* actualParameters(const RooArgSet& nset) const ;
   virtual RooAbsArg& pdfObservable(RooAbsArg& histObservable) const ;
   virtual void fillCacheObject(PdfCacheElem& cache) const ;
-  void fillCacheSlice(FFTCacheElem& cache, const RooArgSet& slicePosition) const ;
+  void fillCacheSlice(FFTCacheElem& cache, const RooArgSet& slicePosition, Int_t slice=0) const ;
 
   virtual PdfCacheElem* createCache(const RooArgSet* nset) const ;
   virtual TString histNameSuffix() const ;
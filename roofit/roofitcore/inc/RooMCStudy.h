@@ -53,6 +53,8 @@ public:
   Bool_t fit(Int_t nSamples, const char* asciiFilePat) ;
   Bool_t fit(Int_t nSamples, TList& dataSetList) ;
   Bool_t addFitResult(const RooFitResult& fr) ;
+  void setNumWorkers(Int_t nWorkers) ;
+  Int_t numWorkers() const { return _nWorkers ; }
 
   // Result accessors
   const RooArgSet* fitParams(Int_t sampleNum) const ;
@@ -103,6 +105,7 @@ protected:
   RooPlot* makeFrameAndPlotCmd(const RooRealVar& param, RooLinkedList& cmdList, Bool_t symRange=kFALSE) const ;
 
   Bool_t run(Bool_t generate, Bool_t fit, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat) ;
+  Bool_t runMultiProcess(Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData) ;
   Bool_t fitSample(RooAbsData* genSample) ;
   RooFitResult* doFit(RooAbsData* genSample) ;	
 
@@ -142,6 +145,7 @@ protected:
   Bool_t      _verboseGen       ; // Verbose generation?
   Bool_t      _perExptGenParams ; // Do generation parameter change per event?
   Bool_t      _silence          ; // Silent running mode?
+  Int_t       _nWorkers         ; // Number of worker processes of generateAndFit()
 
   std::list<RooAbsMCStudyModule*> _modList ; // List of additional study modules ;
 
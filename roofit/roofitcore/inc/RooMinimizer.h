@@ -51,6 +51,8 @@ public:
   void setOffsetting(Bool_t flag) ;
   void setMaxIterations(Int_t n) ;
   void setMaxFunctionCalls(Int_t n) ; 
+  void setUseGradient(Bool_t flag=kTRUE) ;
+  Bool_t useGradient() const { return _useGradient ; }
 
   RooFitResult* fit(const char* options) ;
 
@@ -100,8 +102,10 @@ protected:
   inline std::ofstream* logfile() { return fitterFcn()->GetLogFile(); }
   inline Double_t& maxFCN() { return fitterFcn()->GetMaxFCN() ; }
   
-  const RooMinimizerFcn* fitterFcn() const {  return ( fitter()->GetFCN() ? ((RooMinimizerFcn*) fitter()->GetFCN()) : _fcn ) ; }
-  RooMinimizerFcn* fitterFcn() { return ( fitter()->GetFCN() ? ((RooMinimizerFcn*) fitter()->GetFCN()) : _fcn ) ; }
+  const RooMinimizerFcn* fitterFcn() const {  return ( fitter()->GetFCN() ? dynamic_cast<RooMinimizerFcn*>(fitter()->GetFCN()) : _fcn ) ; }
+  RooMinimizerFcn* fitterFcn() { return ( fitter()->GetFCN() ? dynamic_cast<RooMinimizerFcn*>(fitter()->GetFCN()) : _fcn ) ; }
+
+  bool fitFcn() const ;
 
 private:
 
@@ -109,6 +113,7 @@ private:
   Int_t       _status ;
   Bool_t      _optConst ;
   Bool_t      _profile ;
+  Bool_t      _useGradient ;
   RooAbsReal* _func ;
 
   Bool_t      _verbose ;
@@ -27,10 +27,11 @@
 
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 class RooMinimizer;
 
-class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
+class RooMinimizerFcn : public ROOT::Math::IMultiGradFunction {
 
  public:
 
@@ -42,6 +43,10 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
   virtual ROOT::Math::IBaseFunctionMultiDim* Clone() const;
   virtual unsigned int NDim() const { return _nDim; }
 
+  // Gradient of the function, if it provides one (see RooAbsReal::hasGradient())
+  Bool_t HasGradient() const { return _funct->hasGradient(); }
+  virtual void Gradient(const double *x, double *grad) const;
+
   RooArgList* GetFloatParamList() { return _floatParamList; }
   RooArgList* GetConstParamList() { return _constParamList; }
   RooArgList* GetInitFloatParamList() { return _initFloatParamList; }
@@ -77,6 +82,7 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
 
 
   virtual double DoEval(const double * x) const;  
+  virtual double DoDerivative(const double * x, unsigned int icoord) const;
   void updateFloatVec() ;
 
 private:
@@ -101,6 +107,9 @@ private:
   RooArgList* _initFloatParamList;
   RooArgList* _initConstParamList;
 
+  mutable std::vector<double> _gradX;    // Parameters of the last computed gradient
+  mutable std::vector<double> _gradient; // Last computed gradient
+
 };
 
 #endif
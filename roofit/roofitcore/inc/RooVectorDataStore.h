@@ -110,6 +110,14 @@ public:
 
   const RooVectorDataStore* cache() const { return _cache ; }
 
+  // Direct access to the values of a real column, used by batch evaluations
+  const Double_t* realColumn(const RooAbsReal& real) const ;
+  const Float_t* realFloatColumn(const RooAbsReal& real) const ;
+
+  // Single precision storage of the values of real columns
+  void setFloatStorage(const RooArgSet& vars, Bool_t flag=kTRUE) ;
+
+  void loadValues(const TTree *t, const RooFormulaVar* select=0, const char* rangeName=0, Int_t nStart=0, Int_t nStop=2000000000) ;
   void loadValues(const RooAbsDataStore *tds, const RooFormulaVar* select=0, const char* rangeName=0, Int_t nStart=0, Int_t nStop=2000000000) ;
   
   void dump() ;
@@ -135,13 +143,18 @@ public:
   class RealVector {
   public:
     RealVector(UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Double_t))) : 
-      _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _float(kFALSE), _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _vecF0(0), _tracker(0), _nset(0) { 
       _vec.reserve(initialCapacity);
     }
 
     RealVector(RooAbsReal* arg, UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Double_t))) : 
-      _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
-      _vec.reserve(initialCapacity);
+      _float(kFALSE), _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _vecF0(0), _tracker(0), _nset(0) { 
+      if (arg && arg->getAttribute("StoreFloat")) {
+	_float = kTRUE ;
+	_vecF.reserve(initialCapacity);
+      } else {
+	_vec.reserve(initialCapacity);
+      }
     }
 
     virtual ~RealVector() {
@@ -150,8 +163,9 @@ public:
     }
 
     RealVector(const RealVector& other, RooAbsReal* real=0) : 
-      _vec(other._vec), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf), _nset(0)   {
+      _vec(other._vec), _vecF(other._vecF), _float(other._float), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf), _nset(0)   {
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+      _vecF0 = _vecF.size()>0 ? &_vecF.front() : 0 ;
       if (other._tracker) {
 	_tracker = new RooChangeTracker(Form("track_%s",_nativeReal->GetName()),"tracker",other._tracker->parameters()) ;
       } else {
@@ -168,17 +182,33 @@ public:
       _real = other._real;
       _buf = other._buf;
       _nativeBuf = other._nativeBuf;
-      if (other._vec.size() <= _vec.capacity() / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Double_t))) {
-	std::vector<Double_t> tmp;
-	tmp.reserve(std::max(other._vec.size(), VECTOR_BUFFER_SIZE / sizeof(Double_t)));
-	tmp.assign(other._vec.begin(), other._vec.end());
-	_vec.swap(tmp);
-      } else {
-	_vec = other._vec;
-      }
+      _float = other._float;
+      assignVec(_vec, other._vec);
+      assignVec(_vecF, other._vecF);
       _vec0 = _vec.size()>0 ? &_vec.front() : 0;
+      _vecF0 = _vecF.size()>0 ? &_vecF.front() : 0;
       return *this;
     }
+
+    // Store the values in single precision (kTRUE) or double precision. The
+    // values already stored are converted
+    void setFloatStorage(Bool_t flag) {
+      if (flag==_float) return ;
+      if (flag) {
+	std::vector<Float_t> tmp(_vec.begin(),_vec.end()) ;
+	_vecF.swap(tmp) ;
+	std::vector<Double_t>().swap(_vec) ;
+      } else {
+	std::vector<Double_t> tmp(_vecF.begin(),_vecF.end()) ;
+	_vec.swap(tmp) ;
+	std::vector<Float_t>().swap(_vecF) ;
+      }
+      _float = flag ;
+      _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+      _vecF0 = _vecF.size()>0 ? &_vecF.front() : 0 ;
+    }
+
+    Bool_t floatStorage() const { return _float ; }
     
     void setNset(RooArgSet* newNset) { _nset = newNset ? new RooArgSet(*newNset) : 0 ; }
 
@@ -212,66 +242,112 @@ public:
     }
 
     void fill() { 
-      _vec.push_back(*_buf) ; 
-      _vec0 = &_vec.front() ;
+      if (_float) {
+	_vecF.push_back(Float_t(*_buf)) ;
+	_vecF0 = &_vecF.front() ;
+      } else {
+	_vec.push_back(*_buf) ; 
+	_vec0 = &_vec.front() ;
+      }
     } ;
 
     void write(Int_t i) {
 /*         std::cout << "write(" << this << ") [" << i << "] nativeReal = " << _nativeReal << " = " << _nativeReal->GetName() << " real = " << _real << " buf = " << _buf << " value = " << *_buf << " native getVal() = " << _nativeReal->getVal() << " getVal() = " << _real->getVal() << std::endl ;  */
-      _vec[i] = *_buf ;
+      if (_float) {
+	_vecF[i] = Float_t(*_buf) ;
+      } else {
+	_vec[i] = *_buf ;
+      }
     }
     
     void reset() { 
-      // make sure the vector releases the underlying memory
+      // make sure the vectors release the underlying memory
       std::vector<Double_t> tmp;
       _vec.swap(tmp);
+      std::vector<Float_t> tmpF;
+      _vecF.swap(tmpF);
       _vec0 = 0;
+      _vecF0 = 0;
     }
 
     inline void get(Int_t idx) const { 
-      *_buf = *(_vec0+idx) ; 
+      *_buf = _vecF0 ? Double_t(*(_vecF0+idx)) : *(_vec0+idx) ; 
     }
 
     inline void getNative(Int_t idx) const { 
-      *_nativeBuf = *(_vec0+idx) ; 
+      *_nativeBuf = _vecF0 ? Double_t(*(_vecF0+idx)) : *(_vec0+idx) ; 
     }
 
-    Int_t size() const { return _vec.size() ; }
+    inline Double_t value(Int_t idx) const { 
+      return _float ? Double_t(_vecF[idx]) : _vec[idx] ; 
+    }
+
+    Int_t size() const { return _float ? _vecF.size() : _vec.size() ; }
+
+    Int_t capacity() const { return _float ? _vecF.capacity() : _vec.capacity() ; }
 
     void resize(Int_t siz) {
-      if (siz < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Double_t))) {
-	// do an expensive copy, if we save at least a factor 2 in size
-	std::vector<Double_t> tmp;
-	tmp.reserve(std::max(siz, Int_t(VECTOR_BUFFER_SIZE / sizeof(Double_t))));
-	if (!_vec.empty())
-	    tmp.assign(_vec.begin(), std::min(_vec.end(), _vec.begin() + siz));
-	if (Int_t(tmp.size()) != siz) 
-	    tmp.resize(siz);
-	_vec.swap(tmp);
+      if (_float) {
+	resizeVec(_vecF, siz) ;
       } else {
-	_vec.resize(siz);
+	resizeVec(_vec, siz) ;
       }
       _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
+      _vecF0 = _vecF.size() > 0 ? &_vecF.front() : 0;
     }
 
     void reserve(Int_t siz) {
-      _vec.reserve(siz);
+      if (_float) {
+	_vecF.reserve(siz);
+      } else {
+	_vec.reserve(siz);
+      }
       _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
+      _vecF0 = _vecF.size() > 0 ? &_vecF.front() : 0;
     }
 
   protected:
     std::vector<Double_t> _vec ;
+    std::vector<Float_t> _vecF ; // Values in single precision, if _float is set
+    Bool_t _float ; // Values are stored in single precision
 
   private:
+    template <class T> static void resizeVec(std::vector<T>& vec, Int_t siz) {
+      if (siz < Int_t(vec.capacity()) / 2 && vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(T))) {
+	// do an expensive copy, if we save at least a factor 2 in size
+	std::vector<T> tmp;
+	tmp.reserve(std::max(siz, Int_t(VECTOR_BUFFER_SIZE / sizeof(T))));
+	if (!vec.empty())
+	    tmp.assign(vec.begin(), std::min(vec.end(), vec.begin() + siz));
+	if (Int_t(tmp.size()) != siz) 
+	    tmp.resize(siz);
+	vec.swap(tmp);
+      } else {
+	vec.resize(siz);
+      }
+    }
+
+    template <class T> static void assignVec(std::vector<T>& vec, const std::vector<T>& other) {
+      if (other.size() <= vec.capacity() / 2 && vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(T))) {
+	std::vector<T> tmp;
+	tmp.reserve(std::max(other.size(), VECTOR_BUFFER_SIZE / sizeof(T)));
+	tmp.assign(other.begin(), other.end());
+	vec.swap(tmp);
+      } else {
+	vec = other;
+      }
+    }
+
     friend class RooVectorDataStore ;
     RooAbsReal* _nativeReal ;
     RooAbsReal* _real ;
     Double_t* _buf ; //!
     Double_t* _nativeBuf ; //!
     Double_t* _vec0 ; //!
+    Float_t* _vecF0 ; //!
     RooChangeTracker* _tracker ; //
     RooArgSet* _nset ; //! 
-    ClassDef(RealVector,1) // STL-vector-based Data Storage class
+    ClassDef(RealVector,2) // STL-vector-based Data Storage class
   } ;
   
 
@@ -350,7 +426,7 @@ public:
 /*       std::cout << "setErrorBuffer(" << _nativeReal->GetName() << ") newBuf = " << newBuf << std::endl ; */
       _bufE = newBuf ; 
       if (!_vecE) _vecE = new std::vector<Double_t> ;
-      _vecE->reserve(_vec.capacity()) ;
+      _vecE->reserve(capacity()) ;
       if (!_nativeBufE) _nativeBufE = _bufE ;
     }
     void setAsymErrorBuffer(Double_t* newBufL, Double_t* newBufH) { 
@@ -358,8 +434,8 @@ public:
       if (!_vecEL) {
         _vecEL = new std::vector<Double_t> ;
 	_vecEH = new std::vector<Double_t> ;
-	_vecEL->reserve(_vec.capacity()) ;
-	_vecEH->reserve(_vec.capacity()) ;
+	_vecEL->reserve(capacity()) ;
+	_vecEH->reserve(capacity()) ;
       }
       if (!_nativeBufEL) {
 	_nativeBufEL = _bufEL ;
@@ -729,6 +805,8 @@ public:
 
   void setAllBuffersNative() ;
 
+  const RealVector* findRealVector(const RooAbsReal& real) const ;
+
   Int_t _nReal ;
   Int_t _nRealF ;
   Int_t _nCat ;
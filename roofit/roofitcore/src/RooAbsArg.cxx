@@ -84,6 +84,7 @@ ClassImp(RooAbsArg);
 Bool_t RooAbsArg::_verboseDirty(kFALSE) ;
 Bool_t RooAbsArg::_inhibitDirty(kFALSE) ;
 Bool_t RooAbsArg::inhibitDirty() const { return _inhibitDirty && !_localNoInhibitDirty; }
+ULong64_t RooAbsArg::_clientGraphGen(1) ;
 
 std::map<RooAbsArg*,TRefArray*> RooAbsArg::_ioEvoList ;
 std::stack<RooAbsArg*> RooAbsArg::_ioReadStack ;
@@ -95,7 +96,7 @@ std::stack<RooAbsArg*> RooAbsArg::_ioReadStack ;
 RooAbsArg::RooAbsArg()
    : TNamed(), _deleteWatch(kFALSE), _operMode(Auto), _fast(kFALSE), _ownedComponents(0),
      _prohibitServerRedirect(kFALSE), _eocache(0), _namePtr(0), _isConstant(kFALSE), _localNoInhibitDirty(kFALSE),
-     _myws(0)
+     _myws(0), _valueClientClosureGen(0)
 {
   _clientShapeIter = _clientListShape.MakeIterator() ;
   _clientValueIter = _clientListValue.MakeIterator() ;
@@ -112,7 +113,7 @@ RooAbsArg::RooAbsArg()
 RooAbsArg::RooAbsArg(const char *name, const char *title)
    : TNamed(name, title), _deleteWatch(kFALSE), _valueDirty(kTRUE), _shapeDirty(kTRUE), _operMode(Auto), _fast(kFALSE),
      _ownedComponents(0), _prohibitServerRedirect(kFALSE), _eocache(0), _namePtr(0), _isConstant(kFALSE),
-     _localNoInhibitDirty(kFALSE), _myws(0)
+     _localNoInhibitDirty(kFALSE), _myws(0), _valueClientClosureGen(0)
 {
   _namePtr = (TNamed*) RooNameReg::instance().constPtr(GetName()) ;
 
@@ -129,7 +130,8 @@ RooAbsArg::RooAbsArg(const RooAbsArg &other, const char *name)
    : TNamed(other.GetName(), other.GetTitle()), RooPrintable(other), _boolAttrib(other._boolAttrib),
      _stringAttrib(other._stringAttrib), _deleteWatch(other._deleteWatch), _operMode(Auto), _fast(kFALSE),
      _ownedComponents(0), _prohibitServerRedirect(kFALSE), _eocache(other._eocache), _namePtr(other._namePtr),
-     _isConstant(other._isConstant), _localNoInhibitDirty(other._localNoInhibitDirty), _myws(0)
+     _isConstant(other._isConstant), _localNoInhibitDirty(other._localNoInhibitDirty), _myws(0),
+     _valueClientClosureGen(0)
 {
   // Use name in argument, if supplied
   if (name) {
@@ -359,6 +361,7 @@ void RooAbsArg::addServer(RooAbsArg& server, Bool_t valueProp, Bool_t shapeProp)
   // Add server link to given server
   _serverList.Add(&server) ;
 
+  clientGraphChanged() ;
   server._clientList.Add(this) ;
   if (valueProp) server._clientListValue.Add(this) ;
   if (shapeProp) server._clientListShape.Add(this) ;
@@ -399,6 +402,7 @@ void RooAbsArg::removeServer(RooAbsArg& server, Bool_t force)
   }
 
   // Remove server link to given server
+  clientGraphChanged() ;
   if (!force) {
     _serverList.Remove(&server) ;
 
@@ -447,6 +451,7 @@ void RooAbsArg::changeServer(RooAbsArg& server, Bool_t valueProp, Bool_t shapePr
   }
 
   // Remove all propagation links, then reinstall requested ones ;
+  clientGraphChanged() ;
   Int_t vcount = server._clientListValue.refCount(this) ;
   Int_t scount = server._clientListShape.refCount(this) ;
   server._clientListValue.RemoveAll(this) ;
@@ -843,6 +848,20 @@ void RooAbsArg::setValueDirty(const RooAbsArg* source) const
     return ;
   }
 
+  // Mark the flattened set of downstream nodes, instead of following every path
+  // of the client graph. The set is rebuilt after any change of the client links
+  // or the operation modes
+  if (source==0 && !_verboseDirty) {
+    if (_valueClientClosureGen!=_clientGraphGen) {
+      buildValueClientClosure() ;
+    }
+    _valueDirty = kTRUE ;
+    for (RooAbsArg* client : _valueClientClosure) {
+      client->_valueDirty = kTRUE ;
+    }
+    return ;
+  }
+
   // Cyclical dependency interception
   if (source==0) {
     source=this ;
@@ -873,6 +892,44 @@ void RooAbsArg::setValueDirty(const RooAbsArg* source) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Collect the nodes marked dirty by the recursive propagation of a value change
+/// of this object: all the value clients reached through nodes in Auto operation
+/// mode (the propagation stops at the nodes in another mode), each node once.
+
+void RooAbsArg::buildValueClientClosure() const
+{
+  _valueClientClosure.clear() ;
+
+  std::set<const RooAbsArg*> visited ;
+  std::vector<const RooAbsArg*> stack(1,this) ;
+  Bool_t cycle(kFALSE) ;
+  while (!stack.empty()) {
+    const RooAbsArg* node = stack.back() ;
+    stack.pop_back() ;
+    RooFIter clientValueIter = node->_clientListValue.fwdIterator() ;
+    RooAbsArg* client ;
+    while ((client=clientValueIter.next())) {
+      if (client==this) {
+	cycle = kTRUE ;
+	continue ;
+      }
+      if (client->_operMode!=Auto || !visited.insert(client).second) continue ;
+      _valueClientClosure.push_back(client) ;
+      stack.push_back(client) ;
+    }
+  }
+
+  if (cycle) {
+    coutE(LinkStateMgmt) << "RooAbsArg::setValueDirty(" << GetName()
+			 << "): cyclical dependency detected, source = " << GetName() << endl ;
+  }
+
+  _valueClientClosureGen = _clientGraphGen ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Mark this object as having changed its shape, and propagate this status
 /// change to all of our clients.
@@ -1751,6 +1808,7 @@ void RooAbsArg::setOperMode(OperMode mode, Bool_t recurseADirty)
   if (mode==_operMode) return ;
 
   _operMode = mode ;
+  clientGraphChanged() ;
   _fast = ((mode==AClean) || dynamic_cast<RooRealVar*>(this)!=0 || dynamic_cast<RooConstVar*>(this)!=0 ) ;
   for (Int_t i=0 ;i<numCaches() ; i++) {
     getCache(i)->operModeHook() ;
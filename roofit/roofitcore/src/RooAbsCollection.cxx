@@ -61,11 +61,15 @@ char* operator+( streampos&, char* );
 ClassImp(RooAbsCollection);
   ;
 
+// Collections with more elements than this use hash tables for the lookups
+// by name and by pointer (e.g. the duplicate checks of RooArgSet::add())
+const Int_t RooAbsCollection::_defaultHashThreshold = 64 ;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
 
 RooAbsCollection::RooAbsCollection() :
-  _list(0),
+  _list(_defaultHashThreshold),
   _ownCont(kFALSE),
   _name(),
   _allRRV(kTRUE)
@@ -78,7 +82,7 @@ RooAbsCollection::RooAbsCollection() :
 /// Empty collection constructor
 
 RooAbsCollection::RooAbsCollection(const char *name) :
-  _list(0),
+  _list(_defaultHashThreshold),
   _ownCont(kFALSE),
   _name(name),
   _allRRV(kTRUE)
@@ -95,7 +99,7 @@ RooAbsCollection::RooAbsCollection(const char *name) :
 RooAbsCollection::RooAbsCollection(const RooAbsCollection& other, const char *name) :
   TObject(other),
   RooPrintable(other),
-  _list(other._list.getHashTableSize()) ,
+  _list(other._list.getHashTableSize()>0 ? other._list.getHashTableSize() : _defaultHashThreshold) ,
   _ownCont(kFALSE),
   _name(name),
   _allRRV(other._allRRV)
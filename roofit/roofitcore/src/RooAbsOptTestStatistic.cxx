@@ -66,6 +66,17 @@ using namespace std;
 ClassImp(RooAbsOptTestStatistic);
 ;
 
+Bool_t RooAbsOptTestStatistic::_precalcConstInts = kFALSE ;
+
+////////////////////////////////////////////////////////////////////////////////
+/// If set, the constant term optimization also evaluates once all normalization
+/// integrals of the p.d.f.s that depend only on constant parameters, and freezes
+/// their values for the duration of the minimization. The integrals are
+/// evaluated again when the value of a constant parameter is changed
+
+void RooAbsOptTestStatistic::setPrecalculateConstantIntegrals(Bool_t flag) { _precalcConstInts = flag ; }
+Bool_t RooAbsOptTestStatistic::precalculateConstantIntegrals() { return _precalcConstInts ; }
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default Constructor
@@ -430,16 +441,16 @@ void RooAbsOptTestStatistic::initSlave(RooAbsReal& real, RooAbsData& indata, con
 
 RooAbsOptTestStatistic::~RooAbsOptTestStatistic()
 {
-  if (operMode()==Slave) {
-    delete _funcClone ;
-    delete _funcObsSet ;
-    if (_projDeps) {
-      delete _projDeps ;
-    }
-    if (_ownData) {
-      delete _dataClone ;
-    }
-  } 
+  // The slave objects are also set up by a test statistic switched
+  // to multi-threaded mode after its construction
+  delete _funcClone ;
+  delete _funcObsSet ;
+  if (_projDeps) {
+    delete _projDeps ;
+  }
+  if (_ownData) {
+    delete _dataClone ;
+  }
   delete _normSet ;
 }
 
@@ -559,6 +570,11 @@ void RooAbsOptTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool
     // Request a forcible cache update of all cached nodes
     _dataClone->store()->forceCacheUpdate() ;
 
+    // Recalculate the constant integrals with the new parameter values
+    if (_precalcConstInts && _optimized) {
+      precalculateIntegrals(kTRUE) ;
+    }
+
     break ;
   }
 
@@ -717,6 +733,10 @@ void RooAbsOptTestStatistic::optimizeConstantTerms(Bool_t activate, Bool_t apply
     // Disable reading of observables that are no longer used
     _dataClone->optimizeReadingWithCaching(*_funcClone, _cachedNodes,requiredExtraObservables()) ;
 
+    if (_precalcConstInts) {
+      precalculateIntegrals(kTRUE) ;
+    }
+
     _optimized = kTRUE ;
 
   } else {
@@ -735,6 +755,7 @@ void RooAbsOptTestStatistic::optimizeConstantTerms(Bool_t activate, Bool_t apply
 
     _cachedNodes.removeAll() ;
 
+    precalculateIntegrals(kFALSE) ;
 
     _optimized = kFALSE ;
   }
@@ -742,6 +763,62 @@ void RooAbsOptTestStatistic::optimizeConstantTerms(Bool_t activate, Bool_t apply
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate once the normalization integrals of the p.d.f.s in the test statistic
+/// that do not depend on the observables and have only constant parameters, and
+/// put them in AClean value caching mode so that they are not evaluated again.
+/// Any previously precalculated integrals are first returned to normal operation,
+/// which is all that is done if activate is false
+
+void RooAbsOptTestStatistic::precalculateIntegrals(Bool_t activate)
+{
+  RooFIter iter = _constNormInts.fwdIterator() ;
+  RooAbsArg* normInt ;
+  while((normInt=iter.next())) {
+    normInt->setOperMode(RooAbsArg::Auto) ;
+    normInt->setValueDirty() ;
+  }
+  _constNormInts.removeAll() ;
+
+  if (!activate) {
+    return ;
+  }
+
+  const RooArgSet* obs = _dataClone->get() ;
+  RooArgSet branches ;
+  _funcClone->branchNodeServerList(&branches) ;
+  RooFIter bIter = branches.fwdIterator() ;
+  RooAbsArg* branch ;
+  while((branch=bIter.next())) {
+    RooAbsPdf* pdf = dynamic_cast<RooAbsPdf*>(branch) ;
+    if (!pdf) continue ;
+
+    RooArgList normInts(pdf->normIntegrals()) ;
+    RooFIter nIter = normInts.fwdIterator() ;
+    while((normInt=nIter.next())) {
+      if (normInt->operMode()!=RooAbsArg::Auto || normInt->dependsOnValue(*obs)) continue ;
+
+      RooArgSet* params = normInt->getParameters(*obs) ;
+      RooAbsCollection* floatParams = params->selectByAttrib("Constant",kFALSE) ;
+      Bool_t allConstant = (floatParams->getSize()==0) ;
+      delete floatParams ;
+      delete params ;
+      if (!allConstant) continue ;
+
+      ((RooAbsReal*)normInt)->getVal() ;
+      normInt->setOperMode(RooAbsArg::AClean) ;
+      _constNormInts.add(*normInt) ;
+    }
+  }
+
+  if (_constNormInts.getSize()>0) {
+    coutI(Minimization) << " A total of " << _constNormInts.getSize() << " normalization integrals depend only on constant"
+			<< " parameters and have been precalculated." << endl ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 ///   cout << "RAOTS::setDataSlave(" << this << ") START" << endl ;
 /// Change dataset that is used to given one. If cloneData is kTRUE, a clone of
@@ -157,6 +157,7 @@ the proxy holds a function, and will trigger an assert
 #include "RooMinimizer.h"
 #include "RooRealIntegral.h"
 #include "RooWorkspace.h"
+#include "RooVectorDataStore.h"
 #include "Math/CholeskyDecomp.h"
 #include <string>
 
@@ -189,7 +190,7 @@ RooAbsPdf::RooAbsPdf() : _norm(0), _normSet(0), _specGeneratorConfig(0)
 /// Constructor with name and title only
 
 RooAbsPdf::RooAbsPdf(const char *name, const char *title) : 
-  RooAbsReal(name,title), _norm(0), _normSet(0), _normMgr(this,10), _selectComp(kTRUE), _specGeneratorConfig(0)
+  RooAbsReal(name,title), _norm(0), _normSet(0), _normMgr(this,10,kFALSE), _selectComp(kTRUE), _specGeneratorConfig(0)
 {
   resetErrorCounters() ;
   setTraceCounter(0) ;
@@ -202,7 +203,7 @@ RooAbsPdf::RooAbsPdf(const char *name, const char *title) :
 
 RooAbsPdf::RooAbsPdf(const char *name, const char *title, 
 		     Double_t plotMin, Double_t plotMax) :
-  RooAbsReal(name,title,plotMin,plotMax), _norm(0), _normSet(0), _normMgr(this,10), _selectComp(kTRUE), _specGeneratorConfig(0)
+  RooAbsReal(name,title,plotMin,plotMax), _norm(0), _normSet(0), _normMgr(this,10,kFALSE), _selectComp(kTRUE), _specGeneratorConfig(0)
 {
   resetErrorCounters() ;
   setTraceCounter(0) ;
@@ -211,7 +212,11 @@ RooAbsPdf::RooAbsPdf(const char *name, const char *title,
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Copy constructor
+/// Copy constructor. The normalization integrals of the original are copied
+/// with their configuration (the analytical and numerical parts of the
+/// integration), so that the copies of a p.d.f made for each channel, test
+/// statistic or data set do not have to set up their integrals again. The
+/// copied integrals follow the redirection of the servers of the copy.
 
 RooAbsPdf::RooAbsPdf(const RooAbsPdf& other, const char* name) : 
   RooAbsReal(other,name), _norm(0), _normSet(0),
@@ -225,6 +230,21 @@ RooAbsPdf::RooAbsPdf(const RooAbsPdf& other, const char* name) :
   } else {
     _specGeneratorConfig = 0 ;
   }
+
+  // Only plain integrals of a copy with the same name can be attached to the copy
+  if (!name || other.namePtr()==namePtr()) {
+    for (Int_t i=0 ; i<other._normMgr.cacheSize() ; i++) {
+      CacheElem* cache = (CacheElem*) other._normMgr.getObjByIndex(i) ;
+      RooRealIntegral* normInt = cache ? dynamic_cast<RooRealIntegral*>(cache->_norm) : 0 ;
+      if (!normInt || normInt->IsA()!=RooRealIntegral::Class() || normInt->numIntCatVars().getSize()>0) continue ;
+      RooAbsReal* normClone = (RooAbsReal*) normInt->Clone() ;
+      normClone->redirectServers(RooArgSet(*this),kFALSE,kFALSE) ;
+      CacheElem* cacheClone = new CacheElem(*normClone) ;
+      if (!_normMgr.setObjByIndex(i,cacheClone)) {
+	delete cacheClone ;
+      }
+    }
+  }
 }
 
 
@@ -312,6 +332,63 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the p.d.f depends on observables of the data store that are not in
+/// normSet (all the observables of the data if normSet is null). Without such conditional
+/// observables, the normalization integral has the same value for all the events of
+/// the data. Used by the implementations of evaluateBatch().
+
+Bool_t RooAbsPdf::hasConditionalObservables(const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  RooArgSet* condObs = getObservables(*data.get()) ;
+  if (normSet) {
+    condObs->remove(*normSet,kTRUE,kTRUE) ;
+  }
+  Bool_t ret = (condObs->getSize()>0) ;
+  delete condObs ;
+  return ret ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the normalization integral over normSet (1 if normSet is null) of a block of
+/// events evaluated by evaluateBatch(), after synchronizing the normalization as
+/// done by getValV() before evaluating a single event. The normalization must be the
+/// same for all the events (see hasConditionalObservables()).
+
+Double_t RooAbsPdf::getBatchNorm(const RooArgSet* normSet) const
+{
+  if (!normSet) return 1. ;
+
+  if (normSet!=_normSet || _norm==0) {
+    syncNormalization(normSet) ;
+  }
+  Double_t normVal = _norm->getVal() ;
+  if (normVal<=0.) {
+    logEvalError("p.d.f normalization integral is zero or negative") ;
+  }
+  return normVal ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normalize the unnormalized values of the p.d.f in output[0] ... output[nEvents-1]
+/// by normVal, given by getBatchNorm(), as done by getValV() for a single event: the
+/// values that are negative or NaN, or all of them if normVal is not positive, are
+/// set to zero.
+
+void RooAbsPdf::normalizeBatch(Double_t* output, Int_t nEvents, Double_t normVal) const
+{
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    Bool_t error = traceEvalPdf(output[i]) ;
+    output[i] = (error || normVal<=0.) ? 0 : output[i]/normVal ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Analytical integral with normalization (see RooAbsReal::analyticalIntegralWN() for further information)
 ///
@@ -606,8 +683,32 @@ void RooAbsPdf::setTraceCounter(Int_t value, Bool_t allNodes)
 
 Double_t RooAbsPdf::getLogVal(const RooArgSet* nset) const 
 {
-  Double_t prob = getVal(nset) ;
+  return logValue(getVal(nset)) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill output with the logs of the values of the p.d.f normalized over normSet for
+/// the events firstEvent ... firstEvent+nEvents-1 of the data store, computed by
+/// blocks of events with getValBatch(). The errors are reported as by getLogVal().
+
+void RooAbsPdf::getLogValBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  getValBatch(output,firstEvent,nEvents,data,normSet) ;
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    output[i] = logValue(output[i]) ;
+  }
+}
+
+
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the log of the given value of the p.d.f, for getLogVal() and
+/// getLogValBatch(). An error is logged if the value is not positive.
+
+Double_t RooAbsPdf::logValue(Double_t prob) const
+{
   if (fabs(prob)>1e6) {
     coutW(Eval) << "RooAbsPdf::getLogVal(" << GetName() << ") WARNING: large likelihood value: " << prob << endl ;
   }
@@ -749,6 +850,12 @@ Double_t RooAbsPdf::extendedTerm(Double_t observed, const RooArgSet* nset) const
 /// CloneData(Bool flag)           -- Use clone of dataset in NLL (default is true)
 /// Offset(Bool_t)                  -- Offset likelihood by initial value (so that starting value of FCN in minuit is zero). This
 ///                                    can improve numeric stability in simultaneously fits with components with large likelihood values
+/// BatchMode(Bool_t)               -- Evaluate the p.d.f by blocks of events taken from the columns of the data (see RooNLLVar::enableBatchMode()).
+///                                    The likelihood is the same, and faster to compute for the p.d.f.s that implement batch evaluations
+/// NumThreads(int num)             -- Parallelize NLL calculation on num threads of the ROOT thread pool (0 = size of the implicit multi-threading pool),
+///                                    each with its own clone of the p.d.f and the data, instead of num processes.
+///                                    The events (or RooSimultaneous components) are split with the default strategy of NumCPU,
+///                                    and the result does not depend on the scheduling of the threads (see RooAbsTestStatistic::setNumThreads())
 /// 
 /// 
 
@@ -798,6 +905,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineSet("glObs","GlobalObservables",0,0) ;
   pc.defineInt("constrAll","Constrained",0,0) ;
   pc.defineInt("doOffset","OffsetLikelihood",0,0) ;
+  pc.defineInt("batchMode","BatchMode",0,0) ;
+  pc.defineInt("numThreads","NumThreads",0,1) ;
   pc.defineSet("extCons","ExternalConstraints",0,0) ;
   pc.defineMutex("Range","RangeWithName") ;
   pc.defineMutex("Constrain","Constrained") ;
@@ -822,6 +931,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   Int_t optConst = pc.getInt("optConst") ;
   Int_t cloneData = pc.getInt("cloneData") ;
   Int_t doOffset = pc.getInt("doOffset") ;
+  Bool_t batchMode = pc.getInt("batchMode") ;
+  Int_t numThreads = pc.getInt("numThreads") ;
   
   // If no explicit cloneData command is specified, cloneData is set to true if optimization is activated
   if (cloneData==2) {
@@ -900,7 +1011,10 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     // Simple case: default range, or single restricted range
     //cout<<"FK: Data test 1: "<<data.sumEntries()<<endl;
 
-    nll = new RooNLLVar(baseName.c_str(),"-log(likelihood)",*this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+    RooNLLVar* nllVar = new RooNLLVar(baseName.c_str(),"-log(likelihood)",*this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+    nllVar->setNumThreads(numThreads) ;
+    nllVar->enableBatchMode(batchMode) ;
+    nll = nllVar ;
 
   } else {
     // Composite case: multiple ranges
@@ -910,7 +1024,9 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     strlcpy(buf,rangeName,bufSize) ;
     char* token = strtok(buf,",") ;
     while(token) {
-      RooAbsReal* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+      RooNLLVar* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+      nllComp->setNumThreads(numThreads) ;
+      nllComp->enableBatchMode(batchMode) ;
       nllList.add(*nllComp) ;
       token = strtok(0,",") ;
     }
@@ -1030,6 +1146,9 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
 /// ExternalConstraints(const RooArgSet& ) -- Include given external constraints to likelihood
 /// Offset(Bool_t)                  -- Offset likelihood by initial value (so that starting value of FCN in minuit is zero). This
 ///                                    can improve numeric stability in simultaneously fits with components with large likelihood values
+/// BatchMode(Bool_t)               -- Evaluate the p.d.f by blocks of events taken from the columns of the data (see RooNLLVar::enableBatchMode()).
+///                                    The likelihood is the same, and faster to compute for the p.d.f.s that implement batch evaluations
+/// NumThreads(int num)             -- Parallelize NLL calculation on num threads instead of num processes (see createNLL())
 ///
 /// Options to control flow of fit procedure
 /// ----------------------------------------
@@ -1106,7 +1225,7 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
   RooCmdConfig pc(Form("RooAbsPdf::fitTo(%s)",GetName())) ;
 
   RooLinkedList fitCmdList(cmdList) ;
-  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood") ;
+  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood,BatchMode,NumThreads") ;
 
   pc.defineString("fitOpt","FitOptions",0,"") ;
   pc.defineInt("optConst","Optimize",0,2) ;
@@ -2986,6 +3105,62 @@ void RooAbsPdf::CacheElem::operModeHook(RooAbsArg::OperMode)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Redirect the servers of the normalization integral together with the ones
+/// of the p.d.f, as in a copy of the expression tree or an attachment to a data
+/// set. Return true, to have the integral deleted and created again, if it
+/// cannot follow the redirection: if a server of the integral would change
+/// class, if the p.d.f itself would be replaced, or if a branch server of the
+/// p.d.f is replaced while some servers of the integral are not.
+
+Bool_t RooAbsPdf::CacheElem::redirectServersHook(const RooAbsCollection& newServerList, Bool_t /*mustReplaceAll*/,
+						 Bool_t nameChange, Bool_t /*isRecursive*/)
+{
+  if (!_owner || nameChange) return kTRUE ;
+
+  RooAbsArg* newOwner = newServerList.find(_owner->GetName()) ;
+  if (newOwner && newOwner!=_owner) return kTRUE ;
+
+  Bool_t branchReplaced(kFALSE) ;
+  RooFIter sIter = _owner->serverMIterator() ;
+  RooAbsArg* server ;
+  while((server=sIter.next())) {
+    RooAbsArg* newServer = newServerList.find(server->GetName()) ;
+    if (server->isDerived() && newServer && newServer!=server) {
+      branchReplaced = kTRUE ;
+    }
+  }
+
+  RooFIter nIter = _norm->serverMIterator() ;
+  while((server=nIter.next())) {
+    if (server==_owner) continue ;
+    RooAbsArg* newServer = newServerList.find(server->GetName()) ;
+    if (newServer ? newServer->IsA()!=server->IsA() : branchReplaced) return kTRUE ;
+  }
+
+  _norm->redirectServers(newServerList,kFALSE,kFALSE) ;
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normalization integrals currently cached by this p.d.f (for all normalization sets)
+
+RooArgList RooAbsPdf::normIntegrals() const
+{
+  RooArgList ret ;
+  for (Int_t i=0 ; i<_normMgr.cacheSize() ; i++) {
+    CacheElem* cache = (CacheElem*) _normMgr.getObjByIndex(i) ;
+    if (cache && cache->_norm) {
+      ret.add(*cache->_norm,kTRUE) ;
+    }
+  }
+  return ret ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Destructor of normalization cache element. If this element 
 /// provides the 'current' normalization stored in RooAbsPdf::_norm
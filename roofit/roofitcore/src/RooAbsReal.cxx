@@ -103,6 +103,8 @@
 #include "TVector.h"
 
 #include <sstream>
+#include <algorithm>
+#include <mutex>
 
 using namespace std ;
 
@@ -120,6 +122,11 @@ RooAbsReal::ErrorLoggingMode RooAbsReal::_evalErrorMode = RooAbsReal::PrintError
 Int_t RooAbsReal::_evalErrorCount = 0 ;
 map<const RooAbsArg*,pair<string,list<RooAbsReal::EvalError> > > RooAbsReal::_evalErrorList ;
 
+namespace {
+  // Serializes the logging of evaluation errors by test statistics evaluated in several threads
+  std::recursive_mutex& evalErrorMutex() { static std::recursive_mutex m ; return m ; }
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// coverity[UNINIT_CTOR]
@@ -264,6 +271,84 @@ Double_t RooAbsReal::getValV(const RooArgSet* nset) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill output[0] ... output[nEvents-1] with the values of this object, normalized
+/// over normSet, for the events firstEvent ... firstEvent+nEvents-1 of the given data
+/// store. This gives the same values as loading each event and calling getVal(normSet),
+/// but avoids walking the expression tree for each event when possible:
+///
+/// - The values of the observables of the data, and of the functions cached
+///   in the data by the constant term optimization, are copied from the data columns
+/// - Objects that do not depend on the observables of the data have the same
+///   value for all events
+/// - Classes that implement evaluateBatch() compute the values for all
+///   events at once, from the batches of values of their servers
+///
+/// Otherwise each event is loaded and the object evaluated with getVal().
+
+void RooAbsReal::getValBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  if (nEvents<=0) return ;
+
+  const Double_t* column = data.realColumn(*this) ;
+  if (column) {
+    std::copy(column+firstEvent,column+firstEvent+nEvents,output) ;
+    return ;
+  }
+  const Float_t* floatColumn = data.realFloatColumn(*this) ;
+  if (floatColumn) {
+    std::copy(floatColumn+firstEvent,floatColumn+firstEvent+nEvents,output) ;
+    return ;
+  }
+
+  if (!dependsOnValue(*data.get())) {
+    std::fill(output,output+nEvents,getVal(normSet)) ;
+    return ;
+  }
+
+  if (evaluateBatch(output,firstEvent,nEvents,data,normSet)) {
+    return ;
+  }
+
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    data.get(firstEvent+i) ;
+    output[i] = getVal(normSet) ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of this object for the events firstEvent ...
+/// firstEvent+nEvents-1 of the data store in output, as getValBatch(). Classes
+/// that can evaluate blocks of events faster than one event at a time should
+/// override this function, get the values of their servers with getValBatch()
+/// and return true. This default implementation returns false, and the events
+/// are then evaluated one by one.
+
+Bool_t RooAbsReal::evaluateBatch(Double_t* /*output*/, Int_t /*firstEvent*/, Int_t /*nEvents*/,
+				 const RooVectorDataStore& /*data*/, const RooArgSet* /*normSet*/) const
+{
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill grad[i] with the derivative of the value of this object with respect
+/// to the variable vars[i], for the current values of the variables. Classes
+/// that can compute their gradient analytically should override this function
+/// and hasGradient(), and return true: RooMinimizer then passes the gradient to
+/// the minimizer instead of letting it compute numerical derivatives. This
+/// default implementation returns false.
+
+Bool_t RooAbsReal::gradient(const RooArgList& /*vars*/, Double_t* /*grad*/) const
+{
+  return kFALSE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooAbsReal::numEvalErrorItems()
@@ -3601,6 +3686,8 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     return ;
   }
 
+  std::lock_guard<std::recursive_mutex> lock(evalErrorMutex()) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -3656,6 +3743,8 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
     return ;
   }
 
+  std::lock_guard<std::recursive_mutex> lock(evalErrorMutex()) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -32,6 +32,15 @@ organizes multi-processor parallel calculation of test statistic
 values. For the latter, the test statistic value is calculated in
 partitions in parallel executing processes and a posteriori
 combined in the main thread.
+
+With setNumThreads(), the partitions are instead calculated in the same
+process by tasks of the implicit multi-threading pool. Each task evaluates
+its own clone of the function and the data (as the processes do), and the
+partial results are summed in a fixed order with compensated (Kahan)
+summation, so that the value does not depend on the scheduling of the
+tasks. The first evaluation after the initialization or a change of the
+optimization is done sequentially, so that the caches of the clones (e.g.
+the normalization integrals) are set up before they are used concurrently.
 **/
 
 
@@ -51,7 +60,13 @@ combined in the main thread.
 #include "TTimeStamp.h"
 #include "RooProdPdf.h"
 #include "RooRealSumPdf.h"
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -64,7 +79,7 @@ RooAbsTestStatistic::RooAbsTestStatistic() :
   _func(0), _data(0), _projDeps(0), _splitRange(0), _simCount(0),
   _verbose(kFALSE), _init(kFALSE), _gofOpMode(Slave), _nEvents(0), _setNum(0),
   _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0),
-  _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
+  _nThreads(1), _mtSerial(kFALSE), _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
   _offsetCarry(0), _evalCarry(0)
 {
 }
@@ -102,6 +117,8 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _gofArray(0),
   _nCPU(nCPU),
   _mpfeArray(0),
+  _nThreads(1),
+  _mtSerial(kFALSE),
   _mpinterl(interleave),
   _doOffset(kFALSE),
   _offset(0),
@@ -161,6 +178,8 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _gofSplitMode(other._gofSplitMode),
   _nCPU(other._nCPU),
   _mpfeArray(0),
+  _nThreads(other._nThreads),
+  _mtSerial(kFALSE),
   _mpinterl(other._mpinterl),
   _doOffset(other._doOffset),
   _offset(other._offset),
@@ -178,6 +197,10 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
       
     _gofOpMode = MPMaster ;
 
+  } else if (_nThreads>1) {
+
+    _gofOpMode = MTMaster ;
+
   } else {
 
     // Determine if RooAbsReal is a RooSimultaneous
@@ -211,7 +234,7 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
     delete[] _mpfeArray ;
   }
 
-  if (SimMaster == _gofOpMode && _init) {
+  if ((SimMaster == _gofOpMode || MTMaster == _gofOpMode) && _init) {
     for (Int_t i = 0; i < _nGof; ++i) delete _gofArray[i];
     delete[] _gofArray ;
   }
@@ -227,7 +250,7 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
 /// is calculated from on a RooSimultaneous, the test statistic calculation
 /// is performed separately on each simultaneous p.d.f component and associated
 /// data and then combined. If the test statistic calculation is parallelized
-/// partitions are calculated in nCPU processes and a posteriori combined.
+/// partitions are calculated in nCPU processes (or nThreads tasks) and a posteriori combined.
 
 Double_t RooAbsTestStatistic::evaluate() const
 {
@@ -287,6 +310,10 @@ Double_t RooAbsTestStatistic::evaluate() const
     _evalCarry = carry;
     return ret ;
 
+  } else if (MTMaster == _gofOpMode) {
+
+    return evaluateMT() ;
+
   } else {
 
     // Evaluate as straight FUNC
@@ -342,6 +369,8 @@ Bool_t RooAbsTestStatistic::initialize()
   
   if (MPMaster == _gofOpMode) {
     initMPMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
+  } else if (MTMaster == _gofOpMode) {
+    initMTMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   } else if (SimMaster == _gofOpMode) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   }
@@ -356,7 +385,7 @@ Bool_t RooAbsTestStatistic::initialize()
 
 Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t)
 {
-  if (SimMaster == _gofOpMode && _gofArray) {
+  if ((SimMaster == _gofOpMode || MTMaster == _gofOpMode) && _gofArray) {
     // Forward to slaves
     for (Int_t i = 0; i < _nGof; ++i) {
       if (_gofArray[i]) {
@@ -383,7 +412,7 @@ Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServe
 
 void RooAbsTestStatistic::printCompactTreeHook(ostream& os, const char* indent)
 {
-  if (SimMaster == _gofOpMode) {
+  if (SimMaster == _gofOpMode || MTMaster == _gofOpMode) {
     // Forward to slaves
     os << indent << "RooAbsTestStatistic begin GOF contents" << endl ;
     for (Int_t i = 0; i < _nGof; ++i) {
@@ -421,6 +450,12 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
     for (Int_t i = 0; i < _nCPU; ++i) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
     }
+  } else if (MTMaster == _gofOpMode) {
+    for (Int_t i = 0; i < _nGof; ++i) {
+      _gofArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
+    }
+    // The optimized trees may create new caches at their first evaluation
+    _mtSerial = kTRUE ;
   }
 }
 
@@ -478,6 +513,120 @@ void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const R
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of threads of the multi-threaded calculation mode. The data
+/// (or the components of a RooSimultaneous) are partitioned as in the
+/// multi-processor mode with the same split strategy, and each partition is
+/// calculated by a task of the ROOT thread pool on its own clone of the test
+/// statistic. With nThreads=0, the size of the implicit multi-threading pool
+/// is used. This must be called before the first evaluation, and cannot be
+/// combined with the multi-processor mode. The p.d.f.s and functions used must
+/// be safe to evaluate concurrently on separate clones.
+
+void RooAbsTestStatistic::setNumThreads(Int_t nThreads)
+{
+  if (nThreads==0) {
+    nThreads = 1 ;
+#ifdef R__USE_IMT
+    if (ROOT::IsImplicitMTEnabled()) {
+      nThreads = ROOT::GetImplicitMTPoolSize() ;
+    }
+#endif
+  }
+  if (nThreads<1) {
+    nThreads = 1 ;
+  }
+
+  if (_init) {
+    coutE(Eval) << "RooAbsTestStatistic::setNumThreads(" << GetName() << ") ERROR: cannot change the number of threads of an initialized test statistic" << endl ;
+    return ;
+  }
+  if (MPMaster == _gofOpMode) {
+    if (nThreads>1) {
+      coutW(Eval) << "RooAbsTestStatistic::setNumThreads(" << GetName() << ") WARNING: multi-threaded and multi-processor modes cannot be combined, ignoring the number of threads" << endl ;
+    }
+    return ;
+  }
+
+  _nThreads = nThreads ;
+  if (_nThreads>1) {
+    _gofOpMode = MTMaster ;
+  } else if (MTMaster == _gofOpMode) {
+    _gofOpMode = dynamic_cast<RooSimultaneous*>(_func) ? SimMaster : Slave ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize multi-threaded calculation mode. Create one component test statistic
+/// for each thread, with its own clone of the function and of the data, calculating
+/// one partition of the test statistic.
+
+void RooAbsTestStatistic::initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
+{
+#ifndef R__USE_IMT
+  coutW(Eval) << "RooAbsTestStatistic::initMTMode(" << GetName() << ") WARNING: ROOT is built without implicit multi-threading, the "
+	      << _nThreads << " partitions are calculated sequentially" << endl;
+#endif
+
+  _nGof = _nThreads;
+  _gofArray = new pRooAbsTestStatistic[_nGof];
+
+  for (Int_t i = 0; i < _nGof; ++i) {
+    _gofArray[i] = create(Form("%s_MT%d",GetName(),i),Form("%s_MT%d",GetTitle(),i),*real,*data,*projDeps,rangeName,addCoefRangeName,1,_mpinterl,_verbose,_splitRange);
+    _gofArray[i]->recursiveRedirectServers(_paramSet);
+    _gofArray[i]->setMPSet(i,_nGof);
+  }
+  _mtSerial = kTRUE;
+  coutI(Eval) << "RooAbsTestStatistic::initMTMode: created " << _nGof << " thread-local calculators." << endl;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the partitions of the multi-threaded mode in parallel tasks and
+/// combine them in a fixed order, in the same way as the multi-processor mode.
+
+Double_t RooAbsTestStatistic::evaluateMT() const
+{
+  std::vector<Double_t> values(_nGof), carries(_nGof);
+  auto evalPartition = [&](UInt_t i) {
+    values[i] = _gofArray[i]->getValV();
+    carries[i] = _gofArray[i]->getCarry();
+  };
+
+  Bool_t parallel = kFALSE;
+#ifdef R__USE_IMT
+  parallel = !_mtSerial;
+  if (parallel) {
+    ROOT::TThreadExecutor pool;
+    pool.Foreach(evalPartition, ROOT::TSeq<UInt_t>(0,_nGof));
+  }
+#endif
+  if (!parallel) {
+    for (Int_t i = 0; i < _nGof; ++i) evalPartition(i);
+  }
+  _mtSerial = kFALSE;
+
+  Double_t sum(0), carry = 0.;
+  for (Int_t i = 0; i < _nGof; ++i) {
+    Double_t y = values[i];
+    carry += carries[i];
+    y -= carry;
+    const Double_t t = sum + y;
+    carry = (t - sum) - y;
+    sum = t;
+  }
+
+  // The partitions do not apply the global normalization
+  const Double_t norm = globalNormalization();
+  _evalCarry = carry / norm;
+  return sum / norm ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize simultaneous p.d.f processing mode. Strip simultaneous
 /// p.d.f into individual components, split dataset in subset
@@ -658,6 +807,14 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
     coutF(DataHandling) << "RooAbsTestStatistic::setData(" << GetName() << ") FATAL: setData() is not supported in multi-processor mode" << endl;
     throw string("RooAbsTestStatistic::setData is not supported in MPMaster mode");
     break;
+  case MTMaster:
+    // Forward to thread-local slaves, which each need their own copy of the data
+    for (Int_t i = 0; i < _nGof; ++i) {
+      _gofArray[i]->setData(indata, kTRUE);
+    }
+    _mtSerial = kTRUE ;
+    setValueDirty() ;
+    break;
   }
 
   return kTRUE;
@@ -694,6 +851,13 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
       _mpfeArray[i]->enableOffsetting(flag);
     }
     break;
+  case MTMaster:
+    _doOffset = flag;
+    for (Int_t i = 0; i < _nGof; ++i) {
+      _gofArray[i]->enableOffsetting(flag);
+    }
+    setValueDirty() ;
+    break;
   }
 }
 
@@ -75,6 +75,7 @@ of each coefficient_i.
 #include "RooGlobalFunc.h"
 #include "RooRealIntegral.h"
 #include "RooTrace.h"
+#include "RooVectorDataStore.h"
 
 #include "Riostream.h"
 #include <algorithm>
@@ -860,6 +861,60 @@ Double_t RooAddPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of the sum for a block of events at once, from the batches
+/// of values of the component p.d.f.s (see RooAbsReal::getValBatch()). The
+/// coefficients must be the same for all the events: the events are evaluated
+/// one by one if the p.d.f has conditional observables.
+
+Bool_t RooAddPdf::evaluateBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  if (!normSet || hasConditionalObservables(data,normSet)) return kFALSE ;
+  RooFIter ci = _coefList.fwdIterator() ;
+  RooAbsArg* coef ;
+  while((coef=ci.next())) {
+    if (coef->dependsOnValue(*data.get())) return kFALSE ;
+  }
+
+  const Double_t normVal = getBatchNorm(normSet) ;
+
+  const RooArgSet* nset = normSet ;
+  if (nset->getSize()==0 && _refCoefNorm.getSize()!=0) {
+    nset = &_refCoefNorm ;
+  }
+
+  CacheElem* cache = getProjCache(nset) ;
+  updateCoefficients(*cache,nset) ;
+
+  // Do running sum of coef/pdf pairs for all the events
+  std::fill(output,output+nEvents,0.) ;
+  std::vector<Double_t> pdfVal(nEvents) ;
+  RooAbsPdf* pdf ;
+  Int_t i(0) ;
+  RooFIter pi = _pdfList.fwdIterator() ;
+  while((pdf = (RooAbsPdf*)pi.next())) {
+    if (pdf->isSelectedComp()) {
+      pdf->getValBatch(&pdfVal[0],firstEvent,nEvents,data,nset) ;
+      if (cache->_needSupNorm) {
+	const Double_t snormVal = ((RooAbsReal*)cache->_suppNormList.at(i))->getVal() ;
+	for (Int_t j=0 ; j<nEvents ; j++) {
+	  output[j] += pdfVal[j]*_coefCache[i]/snormVal ;
+	}
+      } else {
+	for (Int_t j=0 ; j<nEvents ; j++) {
+	  output[j] += pdfVal[j]*_coefCache[i] ;
+	}
+      }
+    }
+    i++ ;
+  }
+
+  normalizeBatch(output,nEvents,normVal) ;
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset error counter to given value, limiting the number
 /// of future error messages for this pdf to 'resetValue'
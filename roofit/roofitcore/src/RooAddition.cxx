@@ -33,6 +33,7 @@ i.e. all integrals of the product are handled numerically
 #include <memory>
 #include <list>
 #include <algorithm>
+#include <vector>
 using namespace std ;
 
 #include "RooAddition.h"
@@ -228,6 +229,40 @@ Double_t RooAddition::defaultErrorLevel() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// The sum has an analytical gradient if all its non-constant terms have one
+
+Bool_t RooAddition::hasGradient() const
+{
+  RooFIter iter = _set.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=iter.next())) {
+    if (!arg->isConstant() && !static_cast<RooAbsReal*>(arg)->hasGradient()) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Gradient of the sum with respect to the variables: the sum of the gradients
+/// of the terms
+
+Bool_t RooAddition::gradient(const RooArgList& vars, Double_t* grad) const
+{
+  const Int_t n = vars.getSize() ;
+  for (Int_t i=0 ; i<n ; i++) grad[i] = 0 ;
+  std::vector<Double_t> termGrad(n) ;
+  RooFIter iter = _set.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=iter.next())) {
+    if (arg->isConstant() || n==0) continue ;
+    if (!static_cast<RooAbsReal*>(arg)->gradient(vars,&termGrad[0])) return kFALSE ;
+    for (Int_t i=0 ; i<n ; i++) grad[i] += termGrad[i] ;
+  }
+  return kTRUE ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void RooAddition::enableOffsetting(Bool_t flag) 
@@ -234,6 +234,9 @@ RooDataSet::RooDataSet() : _wgtVar(0)
 ///
 /// StoreError(const RooArgSet&)     -- Store symmetric error along with value for given subset of observables
 /// StoreAsymError(const RooArgSet&) -- Store asymmetric error along with value for given subset of observables
+/// StoreFloat(const RooArgSet&)     -- Store the values of the given subset of observables in single precision,
+///                                     which halves their memory (vector storage only). This is lossless for the
+///                                     values imported from Float_t branches of a TTree
 ///
 
 RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& vars, const RooCmdArg& arg1, const RooCmdArg& arg2, const RooCmdArg& arg3,
@@ -263,6 +266,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
   pc.defineObject("dummy2","LinkDataSliceMany",0) ;
   pc.defineSet("errorSet","StoreError",0) ;
   pc.defineSet("asymErrSet","StoreAsymError",0) ;
+  pc.defineSet("floatSet","StoreFloat",0) ;
   pc.defineMutex("ImportTree","ImportData","ImportDataSlice","LinkDataSlice","ImportFromFile") ;
   pc.defineMutex("CutSpec","CutVar") ;
   pc.defineMutex("WeightVarName","WeightVar") ;
@@ -299,6 +303,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
   RooCategory* indexCat = static_cast<RooCategory*>(pc.getObject("indexCat")) ;
   RooArgSet* errorSet = pc.getSet("errorSet") ;
   RooArgSet* asymErrorSet = pc.getSet("asymErrSet") ;
+  RooArgSet* floatSet = pc.getSet("floatSet") ;
   const char* fname = pc.getString("fname") ;
   const char* tname = pc.getString("tname") ;
   Int_t ownLinked = pc.getInt("ownLinked") ;
@@ -371,6 +376,13 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
       wgtVarName = _wgtVar->GetName() ;
     }
 
+    // Flag the observables to be stored in single precision before the creation of the store
+    if (floatSet) {
+      RooArgSet* intFloatSet = (RooArgSet*) _vars.selectCommon(*floatSet) ;
+      intFloatSet->setAttribAll("StoreFloat") ;
+      delete intFloatSet ;
+    }
+
     // Create empty datastore 
     RooTreeDataStore* tstore(0) ;
     RooVectorDataStore* vstore(0) ;
@@ -497,9 +509,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
 	if (tstore) {
 	  tstore->loadValues(impTree,&cutVarTmp,cutRange);      
 	} else {
-	  RooTreeDataStore tmpstore(name,title,_vars,wgtVarName) ;
-	  tmpstore.loadValues(impTree,&cutVarTmp,cutRange) ;
-	  _dstore->append(tmpstore) ;
+	  vstore->loadValues(impTree,&cutVarTmp,cutRange) ;
 	}
       } else if (fname && strlen(fname)) {
 
@@ -518,9 +528,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
 	if (tstore) {
 	  tstore->loadValues(t,&cutVarTmp,cutRange);      	
 	} else {
-	  RooTreeDataStore tmpstore(name,title,_vars,wgtVarName) ;
-	  tmpstore.loadValues(t,&cutVarTmp,cutRange) ;
-	  _dstore->append(tmpstore) ;
+	  vstore->loadValues(t,&cutVarTmp,cutRange) ;
 	}
 	f->Close() ;
 
@@ -556,9 +564,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
 	if (tstore) {
 	  tstore->loadValues(impTree,cutVar,cutRange);
 	} else {
-	  RooTreeDataStore tmpstore(name,title,_vars,wgtVarName) ;
-	  tmpstore.loadValues(impTree,cutVar,cutRange) ;
-	  _dstore->append(tmpstore) ;
+	  vstore->loadValues(impTree,cutVar,cutRange) ;
 	}
 	} else if (fname && strlen(fname)) {
 	// Case 5b --- Import TTree from file with cutvar
@@ -575,9 +581,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
 	if (tstore) {
 	  tstore->loadValues(t,cutVar,cutRange);      	
 	} else {
-	  RooTreeDataStore tmpstore(name,title,_vars,wgtVarName) ;
-	  tmpstore.loadValues(t,cutVar,cutRange) ;
-	  _dstore->append(tmpstore) ;
+	  vstore->loadValues(t,cutVar,cutRange) ;
 	}
 
 	f->Close() ;
@@ -612,9 +616,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
 	if (tstore) {
 	  tstore->loadValues(impTree,0,cutRange);
 	} else {
-	  RooTreeDataStore tmpstore(name,title,_vars,wgtVarName) ;
-	  tmpstore.loadValues(impTree,0,cutRange) ;
-	  _dstore->append(tmpstore) ;
+	  vstore->loadValues(impTree,0,cutRange) ;
 	}
       } else if (fname && strlen(fname)) {
 	// Case 5c --- Import TTree from file
@@ -631,9 +633,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
 	if (tstore) {
 	  tstore->loadValues(t,0,cutRange);      	
 	} else {
-	  RooTreeDataStore tmpstore(name,title,_vars,wgtVarName) ;
-	  tmpstore.loadValues(t,0,cutRange) ;
-	  _dstore->append(tmpstore) ;
+	  vstore->loadValues(t,0,cutRange) ;
 	}
 	f->Close() ;
       }
@@ -762,17 +762,13 @@ RooDataSet::RooDataSet(const char *name, const char *title, TTree *intree,
 		       const RooArgSet& vars, const RooFormulaVar& cutVar, const char* wgtVarName) :
   RooAbsData(name,title,vars)
 {
-  // Create tree version of datastore 
-  RooTreeDataStore* tstore = new RooTreeDataStore(name,title,_vars,*intree,cutVar,wgtVarName) ;
-
-  // Convert to vector datastore if needed
   if (defaultStorageType==Tree) {
-    _dstore = tstore ;
+    _dstore = new RooTreeDataStore(name,title,_vars,*intree,cutVar,wgtVarName) ;
   } else if (defaultStorageType==Vector) {
+    // Read the tree directly into the vector datastore
     RooVectorDataStore* vstore = new RooVectorDataStore(name,title,_vars,wgtVarName) ;
     _dstore = vstore ;
-    _dstore->append(*tstore) ;
-    delete tstore ;
+    vstore->loadValues(intree,&cutVar) ;
   } else {
     _dstore = 0 ;
   }
@@ -804,17 +800,18 @@ RooDataSet::RooDataSet(const char *name, const char *title, TTree *intree,
 		       const RooArgSet& vars, const char *selExpr, const char* wgtVarName) :
   RooAbsData(name,title,vars)
 {
-  // Create tree version of datastore 
-  RooTreeDataStore* tstore = new RooTreeDataStore(name,title,_vars,*intree,selExpr,wgtVarName) ;
-
-  // Convert to vector datastore if needed
   if (defaultStorageType==Tree) {
-    _dstore = tstore ;
+    _dstore = new RooTreeDataStore(name,title,_vars,*intree,selExpr,wgtVarName) ;
   } else if (defaultStorageType==Vector) {
+    // Read the tree directly into the vector datastore
     RooVectorDataStore* vstore = new RooVectorDataStore(name,title,_vars,wgtVarName) ;
     _dstore = vstore ;
-    _dstore->append(*tstore) ;
-    delete tstore ;
+    if (selExpr && *selExpr) {
+      RooFormulaVar select(selExpr,selExpr,_vars) ;
+      vstore->loadValues(intree,&select) ;
+    } else {
+      vstore->loadValues(intree) ;
+    }
   } else {
     _dstore = 0 ;
   }
@@ -53,6 +53,11 @@
  // set in the constructor or through the setInterpolationOrder() member function. 
  // For N>1000 interpolation will not substantially improve the performance.
  //
+ // The Fourier transforms of the two input p.d.f.s are kept in the cache: when only the
+ // parameters of one of them change (for example those of the resolution model), only this
+ // input p.d.f. is sampled and transformed again. The FFTW plans of the transforms are shared
+ // by all the caches of the same size through the plan cache of the FFTW interface.
+ //
  // Additionial information on caching activities can be displayed by monitoring
  // the message stream with topic "Caching" at the INFO level, i.e. 
  // do RooMsgService::instance().addStream(RooMsgService::INFO,Topic("Caching")) 
@@ -119,6 +124,7 @@
 #include "RooGlobalFunc.h"
 #include "RooLinearVar.h"
 #include "RooConstVar.h"
+#include "RooChangeTracker.h"
 #include "TClass.h"
 #include "TSystem.h"
 
@@ -247,7 +253,8 @@ RooFFTConvPdf::PdfCacheElem* RooFFTConvPdf::createCache(const RooArgSet* nset) c
 
 RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooArgSet* nsetIn) : 
   PdfCacheElem(self,nsetIn),
-  fftr2c1(0),fftr2c2(0),fftc2r(0) 
+  fftr2c1(0),fftr2c2(0),fftc2r(0),tracker1(0),tracker2(0),redo1(kTRUE),redo2(kTRUE),
+  shift1(self._shift1),shift2(self._shift2)
 {
   RooAbsPdf* clonePdf1 = (RooAbsPdf*) self._pdf1.arg().cloneTree() ;
   RooAbsPdf* clonePdf2 = (RooAbsPdf*) self._pdf2.arg().cloneTree() ;
@@ -310,6 +317,15 @@ RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooAr
 
   delete fftParams ;
 
+  // Track the parameters of each input p.d.f. separately, to keep the transform of
+  // the other one when only one of them changes
+  RooArgSet* params1 = pdf1Clone->getParameters(*hist()->get()) ;
+  RooArgSet* params2 = pdf2Clone->getParameters(*hist()->get()) ;
+  tracker1 = new RooChangeTracker(Form("%s_FFTPARAMS1",pdf1Clone->GetName()),"tracker",*params1,kTRUE) ;
+  tracker2 = new RooChangeTracker(Form("%s_FFTPARAMS2",pdf2Clone->GetName()),"tracker",*params2,kTRUE) ;
+  delete params1 ;
+  delete params2 ;
+
   // Save copy of original histX binning and make alternate binning
   // for extended range scanning
 
@@ -347,6 +363,8 @@ RooArgList RooFFTConvPdf::FFTCacheElem::containedArgs(Action a)
 
   ret.add(*pdf1Clone) ;
   ret.add(*pdf2Clone) ;
+  ret.add(*tracker1) ;
+  ret.add(*tracker2) ;
   if (pdf1Clone->ownedComponents()) {
     ret.add(*pdf1Clone->ownedComponents()) ;
   }
@@ -366,6 +384,9 @@ RooFFTConvPdf::FFTCacheElem::~FFTCacheElem()
   delete fftr2c2 ; 
   delete fftc2r ; 
 
+  delete tracker1 ;
+  delete tracker2 ;
+
   delete pdf1Clone ;
   delete pdf2Clone ;
 
@@ -383,9 +404,18 @@ RooFFTConvPdf::FFTCacheElem::~FFTCacheElem()
 void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const 
 {
   RooDataHist& cacheHist = *cache.hist() ;
+  FFTCacheElem& aux = (FFTCacheElem&)cache ;
   
-  ((FFTCacheElem&)cache).pdf1Clone->setOperMode(ADirty,kTRUE) ;
-  ((FFTCacheElem&)cache).pdf2Clone->setOperMode(ADirty,kTRUE) ;
+  aux.pdf1Clone->setOperMode(ADirty,kTRUE) ;
+  aux.pdf2Clone->setOperMode(ADirty,kTRUE) ;
+
+  // Determine which of the stored transforms of the input p.d.f.s have to be recalculated
+  Bool_t changed1 = aux.tracker1->hasChanged(kTRUE) ;
+  Bool_t changed2 = aux.tracker2->hasChanged(kTRUE) ;
+  aux.redo1 = changed1 || aux.shift1!=_shift1 ;
+  aux.redo2 = changed2 || aux.shift2!=_shift2 ;
+  aux.shift1 = _shift1 ;
+  aux.shift2 = _shift2 ;
 
   // Determine if there other observables than the convolution observable in the cache
   RooArgSet otherObs ;
@@ -401,7 +431,7 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
 
   // Handle trivial scenario -- no other observables
   if (otherObs.getSize()==0) {
-    fillCacheSlice((FFTCacheElem&)cache,RooArgSet()) ;
+    fillCacheSlice(aux,RooArgSet()) ;
     return ;
   }
 
@@ -429,6 +459,7 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
   delete iter ;
 
   Bool_t loop(kTRUE) ;
+  Int_t slice(0) ;
   while(loop) {
     // Set current slice position
     for (Int_t j=0 ; j<n ; j++) { obsLV[j]->setBin(binCur[j],binningName()) ; }
@@ -436,7 +467,7 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
 //     cout << "filling slice: bin of obsLV[0] = " << obsLV[0]->getBin() << endl ;
 
     // Fill current slice
-    fillCacheSlice((FFTCacheElem&)cache,otherObs) ;
+    fillCacheSlice(aux,otherObs,slice++) ;
 
     // Determine which iterator to increment
     while(binCur[curObs]==binMax[curObs]) {
@@ -466,9 +497,11 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Fill a slice of cachePdf with the output of the FFT convolution calculation
+/// Fill a slice of cachePdf with the output of the FFT convolution calculation.
+/// The transforms of the input p.d.f.s are taken from the ones stored in the cache
+/// for this slice number, unless the corresponding input p.d.f. changed.
 
-void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos) const 
+void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos, Int_t slice) const 
 {
   // Extract histogram that is the basis of the RooHistPdf
   RooDataHist& cacheHist = *aux.hist() ;
@@ -486,12 +519,32 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
 
   Int_t N,N2,binShift1,binShift2 ;
   
+  if (Int_t(aux.spec1.size())<=slice) {
+    aux.spec1.resize(slice+1) ;
+    aux.spec2.resize(slice+1) ;
+    aux.zeroBin1.resize(slice+1) ;
+  }
+  std::vector<Double_t>& spec1 = aux.spec1[slice] ;
+  std::vector<Double_t>& spec2 = aux.spec2[slice] ;
+  Bool_t redo1 = aux.redo1 || spec1.empty() ;
+  Bool_t redo2 = aux.redo2 || spec2.empty() ;
+
   RooRealVar* histX = (RooRealVar*) cacheHist.get()->find(_x.arg().GetName()) ;
   if (_bufStrat==Extend) histX->setBinning(*aux.scanBinning) ;
-  Double_t* input1 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf1Clone,cacheHist,slicePos,N,N2,binShift1,_shift1) ;
-  Double_t* input2 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf2Clone,cacheHist,slicePos,N,N2,binShift2,_shift2) ;
+  Double_t* input1 = redo1 ? scanPdf((RooRealVar&)_x.arg(),*aux.pdf1Clone,cacheHist,slicePos,N,N2,binShift1,_shift1) : 0 ;
+  Double_t* input2 = redo2 ? scanPdf((RooRealVar&)_x.arg(),*aux.pdf2Clone,cacheHist,slicePos,N,N2,binShift2,_shift2) : 0 ;
   if (_bufStrat==Extend) histX->setBinning(*aux.histBinning) ;
 
+  if (redo1) {
+    aux.zeroBin1[slice] = binShift1 ;
+  } else {
+    binShift1 = aux.zeroBin1[slice] ;
+  }
+  if (!redo1 && !redo2) {
+    // Same sizes as in scanPdf()
+    N = histX->numBins(binningName()) ;
+    N2 = N+2*static_cast<Int_t>((N*bufferFraction())/2 + 0.5) ;
+  }
 
 
 
@@ -503,19 +556,30 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
   }
   
   // Real->Complex FFT Transform on p.d.f. 1 sampling
-  aux.fftr2c1->SetPoints(input1);
-  aux.fftr2c1->Transform();
+  if (redo1) {
+    aux.fftr2c1->SetPoints(input1);
+    aux.fftr2c1->Transform();
+    spec1.resize(2*(N2/2+1)) ;
+    for (Int_t i=0 ; i<N2/2+1 ; i++) {
+      aux.fftr2c1->GetPointComplex(i,spec1[2*i],spec1[2*i+1]) ;
+    }
+  }
 
   // Real->Complex FFT Transform on p.d.f 2 sampling
-  aux.fftr2c2->SetPoints(input2);
-  aux.fftr2c2->Transform();
+  if (redo2) {
+    aux.fftr2c2->SetPoints(input2);
+    aux.fftr2c2->Transform();
+    spec2.resize(2*(N2/2+1)) ;
+    for (Int_t i=0 ; i<N2/2+1 ; i++) {
+      aux.fftr2c2->GetPointComplex(i,spec2[2*i],spec2[2*i+1]) ;
+    }
+  }
 
   // Loop over first half +1 of complex output results, multiply 
   // and set as input of reverse transform
   for (Int_t i=0 ; i<N2/2+1 ; i++) {
-    Double_t re1,re2,im1,im2 ;
-    aux.fftr2c1->GetPointComplex(i,re1,im1) ;
-    aux.fftr2c2->GetPointComplex(i,re2,im2) ;
+    Double_t re1 = spec1[2*i], im1 = spec1[2*i+1] ;
+    Double_t re2 = spec2[2*i], im2 = spec2[2*i+1] ;
     Double_t re = re1*re2 - im1*im2 ;
     Double_t im = re1*im2 + re2*im1 ;
     TComplex t(re,im) ;
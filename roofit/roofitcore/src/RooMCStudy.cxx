@@ -35,6 +35,11 @@ extra steps in the cycle. Output of these modules can be stored
 alongside the fit results in the aggregate results dataset.
 These study modules should derive from classs RooAbsMCStudyModel
 
+With setNumWorkers(), generateAndFit() shares the samples between several
+worker processes, which each run their part of the study with a different
+seed of the random generator. The fitted parameters, the saved fit results
+and the kept generated data sets are then collected in this object.
+
 **/
 
 
@@ -62,6 +67,11 @@ These study modules should derive from classs RooAbsMCStudyModel
 #include "RooPullVar.h"
 #include "RooMsgService.h"
 #include "RooProdPdf.h"
+#include "TParameter.h"
+#ifdef ROOFIT_MULTIPROC
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 using namespace std ;
 
@@ -151,6 +161,7 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& model, const RooArgSet& observables,
 
   // Decode command line arguments
   _silence = pc.getInt("silence") ;
+  _nWorkers = 0 ;
   _verboseGen = pc.getInt("verboseGen") ;
   _extendedGen = pc.getInt("extendedGen") ;
   _binGenData = pc.getInt("binGenData") ;
@@ -338,7 +349,8 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& genModel, const RooAbsPdf& fitModel,
   _fitOptions(fitOptions),
   _canAddFitResults(kTRUE),
   _perExptGenParams(0),
-  _silence(kFALSE)
+  _silence(kFALSE),
+  _nWorkers(0)
 {
   // Decode generator options
   TString genOpt(genOptions) ;
@@ -656,12 +668,135 @@ Bool_t RooMCStudy::generateAndFit(Int_t nSamples, Int_t nEvtPerSample, Bool_t ke
   _fitResList.Delete() ; // even though the fit results are owned by gROOT, we still want to scratch them here.
   _genDataList.Delete() ;
   _fitParData->reset() ;
+
+  if (_nWorkers>1 && nSamples>1) {
+#ifdef ROOFIT_MULTIPROC
+    if (!(asciiFilePat && *asciiFilePat)) {
+      return runMultiProcess(nSamples,nEvtPerSample,keepGenData) ;
+    }
+    coutW(InputArguments) << "RooMCStudy::generateAndFit(" << GetName()
+			  << ") WARNING: the samples written to ascii files are generated in a single process" << endl ;
+#else
+    coutW(InputArguments) << "RooMCStudy::generateAndFit(" << GetName()
+			  << ") WARNING: ROOT is built without multi-process support, running in a single process" << endl ;
+#endif
+  }
   
   return run(kTRUE,kTRUE,nSamples,nEvtPerSample,keepGenData,asciiFilePat) ;
 }
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Internal method. Generate and fit 'nSamples' samples in _nWorkers worker processes,
+/// each running run() on its share of the samples with its own seed of the random
+/// generator, drawn here from RooRandom. The fit parameters, fit results and kept
+/// generated data of the workers are merged in the order of the workers.
+///
+/// The study modules are run and finalized in the workers, their output is part of
+/// the merged fit parameters. The generator parameters of the samples are also
+/// merged in the fit parameters, but genParDataSet() is not filled.
+
+Bool_t RooMCStudy::runMultiProcess(Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData)
+{
+#ifdef ROOFIT_MULTIPROC
+  const Int_t nWorkers = _nWorkers<nSamples ? _nWorkers : nSamples ;
+  std::vector<UInt_t> seeds(nWorkers) ;
+  for (Int_t k=0 ; k<nWorkers ; k++) {
+    seeds[k] = RooRandom::randomGenerator()->Integer(kMaxInt) + 1 ;
+  }
+
+  auto work = [&](UInt_t k) -> TList* {
+    RooRandom::randomGenerator()->SetSeed(seeds[k]) ;
+    const Int_t nWork = nSamples/nWorkers + (Int_t(k) < nSamples%nWorkers ? 1 : 0) ;
+    run(kTRUE,kTRUE,nWork,nEvtPerSample,keepGenData,0) ;
+
+    TList* out = new TList ;
+    out->Add(new TParameter<Int_t>("worker",k)) ;
+    out->Add(new RooDataSet(*_fitParData,_fitParData->GetName())) ;
+    TList* frList = new TList ;
+    frList->SetName("fitResults") ;
+    frList->AddAll(&_fitResList) ;
+    out->Add(frList) ;
+    TList* dataList = new TList ;
+    dataList->SetName("genData") ;
+    dataList->AddAll(&_genDataList) ;
+    out->Add(dataList) ;
+    return out ;
+  } ;
+
+  ROOT::TProcessExecutor pool(nWorkers) ;
+  std::vector<TList*> results = pool.Map(work,ROOT::TSeq<UInt_t>(0,nWorkers)) ;
+
+  // The results come back in any order
+  std::vector<TList*> byWorker(nWorkers,(TList*)0) ;
+  for (TList* out : results) {
+    if (!out) continue ;
+    out->SetOwner() ;
+    TParameter<Int_t>* k = static_cast<TParameter<Int_t>*>(out->FindObject("worker")) ;
+    if (k && k->GetVal()>=0 && k->GetVal()<nWorkers) {
+      byWorker[k->GetVal()] = out ;
+    } else {
+      delete out ;
+    }
+  }
+
+  Int_t nDone(0) ;
+  Bool_t first(kTRUE) ;
+  for (TList* out : byWorker) {
+    if (!out) continue ;
+    nDone++ ;
+    RooDataSet* fitParData = static_cast<RooDataSet*>(out->At(1)) ;
+    if (first) {
+      out->Remove(fitParData) ;
+      delete _fitParData ;
+      _fitParData = fitParData ;
+      first = kFALSE ;
+    } else {
+      _fitParData->append(*fitParData) ;
+    }
+    TList* frList = static_cast<TList*>(out->FindObject("fitResults")) ;
+    TList* dataList = static_cast<TList*>(out->FindObject("genData")) ;
+    if (frList) {
+      _fitResList.AddAll(frList) ;
+      frList->Clear("nodelete") ;
+    }
+    if (dataList) {
+      _genDataList.AddAll(dataList) ;
+      dataList->Clear("nodelete") ;
+    }
+    delete out ;
+  }
+
+  if (nDone<nWorkers) {
+    coutE(Generation) << "RooMCStudy::runMultiProcess(" << GetName() << ") ERROR: the results of "
+		      << nWorkers-nDone << " of the " << nWorkers << " workers are missing" << endl ;
+  }
+
+  _canAddFitResults = kFALSE ;
+  return nDone<nWorkers ;
+#else
+  return run(kTRUE,kTRUE,nSamples,nEvtPerSample,keepGenData,0) ;
+#endif
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Share the samples of generateAndFit() between 'nWorkers' worker processes.
+/// The sequences of random numbers, hence the samples, depend on the number
+/// of workers, but the study is reproducible for the same seed of RooRandom
+/// and number of workers. With nWorkers<=1 (the default), the samples are
+/// generated and fitted in this process. The study modules and the fit are
+/// run in the workers: the model has to be usable in a forked process.
+
+void RooMCStudy::setNumWorkers(Int_t nWorkers)
+{
+  _nWorkers = nWorkers ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Generate 'nSamples' samples of 'nEvtPerSample' events.
 /// If keepGenData is set, all generated data sets will be kept in memory 
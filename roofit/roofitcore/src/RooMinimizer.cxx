@@ -123,6 +123,7 @@ RooMinimizer::RooMinimizer(RooAbsReal& function)
   _profileStart = kFALSE ;
   _printLevel = 1 ;
   _minimizerType = "Minuit"; // default minimizer
+  _useGradient = _func->hasGradient() ;
 
   if (_theFitter) delete _theFitter ;
   _theFitter = new ROOT::Fit::Fitter;
@@ -243,6 +244,38 @@ void RooMinimizer::setOffsetting(Bool_t flag)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Pass the analytical gradient of the function (RooAbsReal::gradient()) to the
+/// minimizer, instead of letting it compute numerical derivatives. This is the
+/// default if the function has a gradient.
+
+void RooMinimizer::setUseGradient(Bool_t flag)
+{
+  if (flag && !_func->hasGradient()) {
+    coutW(Minimization) << "RooMinimizer::setUseGradient: WARNING the function " << _func->GetName()
+			<< " does not provide an analytical gradient, using numerical derivatives" << endl ;
+    flag = kFALSE ;
+  }
+  _useGradient = flag ;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run the minimizer of the fitter on the function, with its gradient if it is used
+
+bool RooMinimizer::fitFcn() const
+{
+  if (_useGradient) {
+    return _theFitter->FitFCN(static_cast<const ROOT::Math::IMultiGradFunction&>(*_fcn)) ;
+  }
+  return _theFitter->FitFCN(static_cast<const ROOT::Math::IMultiGenFunction&>(*_fcn)) ;
+}
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Choose the minimzer algorithm.
 
@@ -321,7 +354,7 @@ Int_t RooMinimizer::minimize(const char* type, const char* alg)
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::CollectErrors) ;
   RooAbsReal::clearEvalErrorLog() ;
 
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -350,7 +383,7 @@ Int_t RooMinimizer::migrad()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"migrad");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -513,7 +546,7 @@ Int_t RooMinimizer::seek()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"seek");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -542,7 +575,7 @@ Int_t RooMinimizer::simplex()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"simplex");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -571,7 +604,7 @@ Int_t RooMinimizer::improve()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"migradimproved");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -20,6 +20,7 @@
 //                                                                                   
 
 #include <iostream>
+#include <algorithm>
 
 #include "RooFit.h"
 #include "RooMinimizerFcn.h"
@@ -94,7 +95,8 @@ RooMinimizerFcn::RooMinimizerFcn(RooAbsReal *funct, RooMinimizer* context,
 
 
 
-RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IBaseFunctionMultiDim(other), 
+RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IBaseFunctionMultiDim(other),
+  ROOT::Math::IMultiGradFunction(other),
   _evalCounter(other._evalCounter),
   _funct(other._funct),
   _context(other._context),
@@ -582,5 +584,43 @@ double RooMinimizerFcn::DoEval(const double *x) const
   return fvalue;
 }
 
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Gradient of the function with respect to the floating parameters, computed
+/// by RooAbsReal::gradient(). Only used by RooMinimizer if the function has an
+/// analytical gradient.
+
+void RooMinimizerFcn::Gradient(const double *x, double *grad) const
+{
+  for (int index = 0; index < _nDim; index++) {
+    SetPdfParamVal(index,x[index]);
+  }
+
+  if (!_funct->gradient(*_floatParamList,grad)) {
+    oocoutE(_context,Minimization) << "RooMinimizerFcn::Gradient: the function " << _funct->GetName()
+				   << " does not provide its gradient" << endl ;
+    for (int index = 0; index < _nDim; index++) grad[index] = 0 ;
+  }
+
+  _gradX.assign(x,x+_nDim) ;
+  _gradient.assign(grad,grad+_nDim) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Derivative with respect to one parameter, from the gradient at the same
+/// parameters if it is the last one computed
+
+double RooMinimizerFcn::DoDerivative(const double *x, unsigned int icoord) const
+{
+  if (_gradX.size()!=UInt_t(_nDim) || !std::equal(_gradX.begin(),_gradX.end(),x)) {
+    std::vector<double> grad(_nDim) ;
+    Gradient(x,_nDim ? &grad[0] : 0) ;
+  }
+  return _gradient[icoord] ;
+}
+
 #endif
 
@@ -39,6 +39,7 @@ In extended mode, a (Nexpect - Nobserved*log(NExpected) term is added
 #include "RooCmdConfig.h"
 #include "RooMsgService.h"
 #include "RooAbsDataStore.h"
+#include "RooVectorDataStore.h"
 #include "RooRealMPFE.h"
 #include "RooRealSumPdf.h"
 #include "RooRealVar.h"
@@ -63,6 +64,8 @@ RooArgSet RooNLLVar::_emptySet ;
 ///  ConditionalObservables() | Define conditional observables
 ///  Verbose()                | Verbose output of GOF framework classes
 ///  CloneData()              | Clone input dataset for internal use (default is kTRUE)
+///  BatchMode()              | Evaluate the p.d.f by blocks of events (see enableBatchMode())
+///  NumThreads()             | Parallelize the calculation on threads (see RooAbsTestStatistic::setNumThreads())
 
 RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbsData& indata,
 		     const RooCmdArg& arg1, const RooCmdArg& arg2,const RooCmdArg& arg3,
@@ -82,6 +85,8 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
   RooCmdConfig pc("RooNLLVar::RooNLLVar") ;
   pc.allowUndefined() ;
   pc.defineInt("extended","Extended",0,kFALSE) ;
+  pc.defineInt("batchMode","BatchMode",0,kFALSE) ;
+  pc.defineInt("numThreads","NumThreads",0,1) ;
 
   pc.process(arg1) ;  pc.process(arg2) ;  pc.process(arg3) ;
   pc.process(arg4) ;  pc.process(arg5) ;  pc.process(arg6) ;
@@ -89,6 +94,7 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
 
   _extended = pc.getInt("extended") ;
   _weightSq = kFALSE ;
+  _batchMode = pc.getInt("batchMode") ;
   _first = kTRUE ;
   _offset = 0.;
   _offsetCarry = 0.;
@@ -96,6 +102,8 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
   _offsetCarrySaveW2 = 0.;
 
   _binnedPdf = 0 ;
+
+  setNumThreads(pc.getInt("numThreads")) ;
 }
 
 
@@ -110,6 +118,7 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,RooArgSet(),rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
+  _batchMode(kFALSE),
   _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
@@ -155,6 +164,7 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,projDeps,rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
+  _batchMode(kFALSE),
   _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
@@ -194,6 +204,7 @@ RooNLLVar::RooNLLVar(const RooNLLVar& other, const char* name) :
   RooAbsOptTestStatistic(other,name),
   _extended(other._extended),
   _weightSq(other._weightSq),
+  _batchMode(other._batchMode),
   _first(kTRUE), _offsetSaveW2(other._offsetSaveW2),
   _offsetCarrySaveW2(other._offsetCarrySaveW2),
   _binw(other._binw) {
@@ -227,10 +238,33 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
   } else if ( _gofOpMode==MPMaster) {
     for (Int_t i=0 ; i<_nCPU ; i++)
       _mpfeArray[i]->applyNLLWeightSquared(flag);
-  } else if ( _gofOpMode==SimMaster) {
+  } else if ( _gofOpMode==SimMaster || _gofOpMode==MTMaster) {
     for (Int_t i=0 ; i<_nGof ; i++)
       ((RooNLLVar*)_gofArray[i])->applyWeightSquared(flag);
+    setValueDirty();
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// If flag is true, the p.d.f is evaluated by blocks of events with
+/// RooAbsPdf::getLogValBatch() instead of one event at a time, for unweighted
+/// data sets stored in a RooVectorDataStore and without interleaved partitions.
+/// The result is the same. The mode must be set before the first evaluation of
+/// a likelihood computed by several processes.
+
+void RooNLLVar::enableBatchMode(Bool_t flag)
+{
+  _batchMode = flag ;
+  if (_gofOpMode==SimMaster || (_gofOpMode==MTMaster && _init)) {
+    for (Int_t i=0 ; i<_nGof ; i++)
+      ((RooNLLVar*)_gofArray[i])->enableBatchMode(flag);
+  } else if (_gofOpMode==MPMaster && _init) {
+    coutW(Minimization) << "RooNLLVar::enableBatchMode(" << GetName() << ") WARNING: the batch mode of the"
+			<< " likelihood computed by several processes cannot be changed after its first evaluation" << std::endl ;
   }
+  setValueDirty() ;
 }
 
 
@@ -306,28 +340,59 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
   } else {
 
-    for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
+    const RooVectorDataStore* vstore(0) ;
+    if (_batchMode && stepSize==1 && !_dataClone->isWeighted()) {
+      vstore = dynamic_cast<const RooVectorDataStore*>(_dataClone->store()) ;
+    }
 
-      _dataClone->get(i) ;
+    if (vstore) {
 
-      if (!_dataClone->valid()) continue;
+      // Evaluate the p.d.f by blocks of events: all the events have a unit weight
+      const Int_t batchSize(1024) ;
+      std::vector<Double_t> logProbs(std::min(batchSize,lastEvent-firstEvent)) ;
+      for (Int_t begin=firstEvent ; begin<lastEvent ; begin+=batchSize) {
 
-      Double_t eventWeight = _dataClone->weight();
-      if (0. == eventWeight * eventWeight) continue ;
-      if (_weightSq) eventWeight = _dataClone->weightSquared() ;
+	const Int_t nEvents = std::min(batchSize,lastEvent-begin) ;
+	pdfClone->getLogValBatch(&logProbs[0],begin,nEvents,*vstore,_normSet) ;
 
-      Double_t term = -eventWeight * pdfClone->getLogVal(_normSet);
+	for (i=0 ; i<nEvents ; i++) {
+	  Double_t y = 1. - sumWeightCarry;
+	  Double_t t = sumWeight + y;
+	  sumWeightCarry = (t - sumWeight) - y;
+	  sumWeight = t;
 
+	  y = -logProbs[i] - carry;
+	  t = result + y;
+	  carry = (t - result) - y;
+	  result = t;
+	}
+      }
 
-      Double_t y = eventWeight - sumWeightCarry;
-      Double_t t = sumWeight + y;
-      sumWeightCarry = (t - sumWeight) - y;
-      sumWeight = t;
+    } else {
+
+      for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
+
+	_dataClone->get(i) ;
+
+	if (!_dataClone->valid()) continue;
+
+	Double_t eventWeight = _dataClone->weight();
+	if (0. == eventWeight * eventWeight) continue ;
+	if (_weightSq) eventWeight = _dataClone->weightSquared() ;
 
-      y = term - carry;
-      t = result + y;
-      carry = (t - result) - y;
-      result = t;
+	Double_t term = -eventWeight * pdfClone->getLogVal(_normSet);
+
+
+	Double_t y = eventWeight - sumWeightCarry;
+	Double_t t = sumWeight + y;
+	sumWeightCarry = (t - sumWeight) - y;
+	sumWeight = t;
+
+	y = term - carry;
+	t = result + y;
+	carry = (t - result) - y;
+	result = t;
+      }
     }
 
     // include the extended maximum likelihood term, if requested
@@ -86,7 +86,8 @@ RooObjCacheManager::~RooObjCacheManager()
 ////////////////////////////////////////////////////////////////////////////////
 /// Intercept server redirect calls. If clearOnRedirect was set, sterilize
 /// the cache (i.e. keep the structure but delete all contents). If not
-/// forward serverRedirect to cache elements
+/// forward serverRedirect to cache elements, and delete the elements that
+/// cannot follow the redirect (their hook returns true)
 
 Bool_t RooObjCacheManager::redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t isRecursive) 
 { 
@@ -97,8 +98,9 @@ Bool_t RooObjCacheManager::redirectServersHook(const RooAbsCollection& newServer
   } else {
 
     for (Int_t i=0 ; i<cacheSize() ; i++) {
-      if (_object[i]) {
-	_object[i]->redirectServersHook(newServerList,mustReplaceAll,nameChange,isRecursive) ;
+      if (_object[i] && _object[i]->redirectServersHook(newServerList,mustReplaceAll,nameChange,isRecursive)) {
+	delete _object[i] ;
+	_object[i] = 0 ;
       }
     }
 
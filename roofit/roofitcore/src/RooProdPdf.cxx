@@ -494,6 +494,70 @@ Double_t RooProdPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of the product for a block of events at once, from the
+/// batches of values of its terms (see RooAbsReal::getValBatch())
+
+Bool_t RooProdPdf::evaluateBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  if (normSet && !selfNormalized() && hasConditionalObservables(data,normSet)) return kFALSE ;
+
+  const Double_t normVal = getBatchNorm(normSet) ;
+
+  _curNormSet = (RooArgSet*)normSet ;
+  Int_t code ;
+  CacheElem* cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+
+  // If cache doesn't have our configuration, recalculate here
+  if (!cache) {
+    RooArgList *plist(0) ;
+    RooLinkedList *nlist(0) ;
+    getPartIntList(_curNormSet,0,plist,nlist,code) ;
+    cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+  }
+
+  std::vector<Double_t> piVal(nEvents) ;
+  if (cache->_isRearranged) {
+
+    cache->_rearrangedNum->getValBatch(output,firstEvent,nEvents,data) ;
+    cache->_rearrangedDen->getValBatch(&piVal[0],firstEvent,nEvents,data) ;
+    for (Int_t i=0 ; i<nEvents ; i++) {
+      output[i] /= piVal[i] ;
+    }
+
+  } else {
+
+    // Running product of the terms, stopped for the events below the cutoff
+    RooAbsReal* partInt;
+    RooArgSet* nset;
+    RooFIter plIter = cache->_partList.fwdIterator();
+    RooFIter nlIter = cache->_normList.fwdIterator();
+    Bool_t first(kTRUE) ;
+    for (partInt = (RooAbsReal*) plIter.next(),
+	nset = (RooArgSet*) nlIter.next(); partInt && nset;
+      partInt = (RooAbsReal*) plIter.next(),
+      nset = (RooArgSet*) nlIter.next()) {
+      if (first) {
+	partInt->getValBatch(output,firstEvent,nEvents,data,nset->getSize() > 0 ? nset : 0) ;
+	first = kFALSE ;
+	continue ;
+      }
+      partInt->getValBatch(&piVal[0],firstEvent,nEvents,data,nset->getSize() > 0 ? nset : 0) ;
+      for (Int_t i=0 ; i<nEvents ; i++) {
+	if (output[i] > _cutOff) output[i] *= piVal[i] ;
+      }
+    }
+    if (first) {
+      std::fill(output,output+nEvents,1.) ;
+    }
+  }
+
+  normalizeBatch(output,nEvents,normVal) ;
+  return kTRUE ;
+}
+
+
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate running product of pdfs terms, using the supplied
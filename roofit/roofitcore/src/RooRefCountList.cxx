@@ -41,10 +41,12 @@ ClassImp(RooRefCountList);
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Default constructor construct lists with initial hash table size of 17
+/// Default constructor. The lists use hash tables when they have more than
+/// 64 elements, so that the lookups done by Add() (e.g. for the clients of a
+/// parameter shared by many functions, read back from a file) stay fast
 
 RooRefCountList::RooRefCountList()
-  : RooLinkedList(0) 
+  : RooLinkedList(64) 
 { 
 }
 
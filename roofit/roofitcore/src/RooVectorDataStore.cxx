@@ -622,6 +622,90 @@ const RooArgSet* RooVectorDataStore::getNative(Int_t index) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the array of the values of the given real valued object for all the
+/// events of the store, if it is one of its observables, or a function cached
+/// by the constant term optimization (which is then in AClean mode).
+/// Return a null pointer otherwise. The array is only valid until the next
+/// change of the store.
+
+const Double_t* RooVectorDataStore::realColumn(const RooAbsReal& real) const
+{
+  const RealVector* rv = findRealVector(real) ;
+  return rv ? rv->_vec0 : 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Same as realColumn(), for the columns stored in single precision (see
+/// setFloatStorage()). Return a null pointer for the other columns.
+
+const Float_t* RooVectorDataStore::realFloatColumn(const RooAbsReal& real) const
+{
+  const RealVector* rv = findRealVector(real) ;
+  return rv ? rv->_vecF0 : 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the column of the given real valued object, in this store or in
+/// the cache of the constant term optimization, or a null pointer
+
+const RooVectorDataStore::RealVector* RooVectorDataStore::findRealVector(const RooAbsReal& real) const
+{
+  for (vector<RealVector*>::const_iterator iter=_realStoreList.begin() ; iter!=_realStoreList.end() ; ++iter) {
+    if ((*iter)->_real==&real || (*iter)->_nativeReal==&real) {
+      return *iter ;
+    }
+  }
+  for (vector<RealFullVector*>::const_iterator iter=_realfStoreList.begin() ; iter!=_realfStoreList.end() ; ++iter) {
+    const RealVector* rv = *iter ;
+    if (rv->_real==&real || rv->_nativeReal==&real) {
+      return rv ;
+    }
+  }
+  if (_cache && real.operMode()==RooAbsArg::AClean) {
+    return _cache->findRealVector(real) ;
+  }
+  return 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the values of the real observables in 'vars' in single precision
+/// (flag=kTRUE) or in double precision. The values already stored are
+/// converted, with a loss of precision for the conversion to single
+/// precision, unless they were read from Float_t branches of a TTree. This
+/// halves the memory used by the values of these observables; their errors
+/// (for the observables with StoreError or StoreAsymError) and the cached
+/// functions of the constant term optimization stay in double precision.
+///
+/// The observables with the attribute "StoreFloat" (set for example by the
+/// StoreFloat() option of the RooDataSet constructor) are stored in single
+/// precision from the creation of the store, without an intermediate copy.
+
+void RooVectorDataStore::setFloatStorage(const RooArgSet& vars, Bool_t flag)
+{
+  for (vector<RealVector*>::iterator iter=_realStoreList.begin() ; iter!=_realStoreList.end() ; ++iter) {
+    if (vars.find((*iter)->_nativeReal->GetName())) {
+      (*iter)->setFloatStorage(flag) ;
+    }
+  }
+  for (vector<RealFullVector*>::iterator iter=_realfStoreList.begin() ; iter!=_realfStoreList.end() ; ++iter) {
+    if (vars.find((*iter)->_nativeReal->GetName())) {
+      (*iter)->setFloatStorage(flag) ;
+    }
+  }
+  RooArgSet* common = (RooArgSet*) _varsww.selectCommon(vars) ;
+  common->setAttribAll("StoreFloat",flag) ;
+  delete common ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the weight of the n-th data point (n='index') in memory
 
@@ -744,6 +828,104 @@ void RooVectorDataStore::weightError(Double_t& lo, Double_t& hi, RooAbsData::Err
 ////////////////////////////////////////////////////////////////////////////////
 ///   throw(std::string("RooVectorDataSore::loadValues() NOT IMPLEMENTED")) ;
 
+void RooVectorDataStore::loadValues(const TTree *t, const RooFormulaVar* select, const char* /*rangeName*/, Int_t /*nStart*/, Int_t /*nStop*/) 
+{
+  // Load values from tree 't' into this data collection, optionally
+  // selecting events using 'select' RooFormulaVar. The values are read
+  // directly into the columns of the store, in the same way as
+  // RooTreeDataStore::loadValues(), without an intermediate tree
+
+  // Change directory to memory dir before cloning tree to avoid ROOT errors
+  TString pwd(gDirectory->GetPath()) ;
+  TString memDir(gROOT->GetName()) ;
+  memDir.Append(":/") ;
+  Bool_t notInMemNow= (pwd!=memDir) ;
+
+  if (notInMemNow) {
+    gDirectory->cd(memDir) ;
+  }
+
+  TTree* tClone ;
+  if (dynamic_cast<const TChain*>(t)) {
+    tClone = (TTree*) t->Clone() ; 
+  } else {
+    tClone = ((TTree*)t)->CloneTree() ;
+  }
+
+  // Change directory back to original directory
+  tClone->SetDirectory(0) ;
+
+  if (notInMemNow) {
+    gDirectory->cd(pwd) ;
+  }
+
+  // Clone list of variables and attach them to the cloned source tree
+  RooArgSet *sourceArgSet = (RooArgSet*) _varsww.snapshot(kFALSE) ;
+  TIterator* sourceIter =  sourceArgSet->createIterator() ;
+  RooAbsArg* sourceArg = 0;
+  while ((sourceArg=(RooAbsArg*)sourceIter->Next())) {
+    sourceArg->attachToTree(*tClone) ;
+  }
+
+  // Redirect formula servers to sourceArgSet
+  RooFormulaVar* selectClone(0) ;
+  if (select) {
+    selectClone = (RooFormulaVar*) select->cloneTree() ;
+    selectClone->recursiveRedirectServers(*sourceArgSet) ;
+    selectClone->setOperMode(RooAbsArg::ADirty,kTRUE) ;
+  }
+
+  // Loop over events in source tree   
+  RooAbsArg* destArg = 0;
+  TIterator* destIter = _varsww.createIterator() ;
+  Int_t numInvalid(0) ;
+  Int_t nevent= (Int_t)tClone->GetEntries();
+  reserve(numEntries() + nevent) ;
+  for(Int_t i=0; i < nevent; ++i) {
+    Int_t entryNumber=tClone->GetEntryNumber(i);
+    if (entryNumber<0) break;
+    tClone->GetEntry(entryNumber,1);
+
+    // Copy from source to destination
+    destIter->Reset() ;
+    sourceIter->Reset() ;
+    Bool_t allOK(kTRUE) ;
+    while ((destArg = (RooAbsArg*)destIter->Next())) {              
+      sourceArg = (RooAbsArg*) sourceIter->Next() ;
+      destArg->copyCache(sourceArg) ;
+      sourceArg->copyCache(destArg) ;
+      if (!destArg->isValid()) {
+	numInvalid++ ;
+	allOK=kFALSE ;
+	break ;
+      }       
+    }   
+
+    // Does this event pass the cuts?
+    if (!allOK || (selectClone && selectClone->getVal()==0)) {
+      continue ; 
+    }
+
+    fill() ;
+  }
+  delete destIter ;
+
+  if (numInvalid>0) {
+    coutI(Eval) << "RooVectorDataStore::loadValues(" << GetName() << ") Ignored " << numInvalid << " out of range events" << endl ;
+  }
+  
+  SetTitle(t->GetTitle());
+
+  delete sourceIter ;
+  delete sourceArgSet ;
+  delete selectClone ;
+  delete tClone ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
 void RooVectorDataStore::loadValues(const RooAbsDataStore *ads, const RooFormulaVar* select, const char* rangeName, Int_t nStart, Int_t nStop) 
 {
   // Load values from dataset 't' into this data collection, optionally
@@ -1482,9 +1664,9 @@ void RooVectorDataStore::dump()
   for (; iter!=_realStoreList.end() ; ++iter) {
     cout << "RealVector " << *iter << " _nativeReal = " << (*iter)->_nativeReal << " = " << (*iter)->_nativeReal->GetName() << " bufptr = " << (*iter)->_buf  << endl ;
     cout << " values : " ;
-    Int_t imax = (*iter)->_vec.size()>10 ? 10 : (*iter)->_vec.size() ;
+    Int_t imax = (*iter)->size()>10 ? 10 : (*iter)->size() ;
     for (Int_t i=0 ; i<imax ; i++) {
-      cout << (*iter)->_vec[i] << " " ;
+      cout << (*iter)->value(i) << " " ;
     }
     cout << endl ;
   }    
@@ -1494,9 +1676,9 @@ void RooVectorDataStore::dump()
 	 << " bufptr = " << (*iter2)->_buf  << " errbufptr = " << (*iter2)->_bufE << endl ;
 
     cout << " values : " ;
-    Int_t imax = (*iter2)->_vec.size()>10 ? 10 : (*iter2)->_vec.size() ;
+    Int_t imax = (*iter2)->size()>10 ? 10 : (*iter2)->size() ;
     for (Int_t i=0 ; i<imax ; i++) {
-      cout << (*iter2)->_vec[i] << " " ;
+      cout << (*iter2)->value(i) << " " ;
     }
     cout << endl ;
     if ((*iter2)->_vecE) {
@@ -1554,6 +1736,7 @@ void RooVectorDataStore::RealVector::Streamer(TBuffer &R__b)
    if (R__b.IsReading()) {
       R__b.ReadClassBuffer(RooVectorDataStore::RealVector::Class(),this);
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+      _vecF0 = _vecF.size()>0 ? &_vecF.front() : 0 ;
    } else {
       R__b.WriteClassBuffer(RooVectorDataStore::RealVector::Class(),this);
    }
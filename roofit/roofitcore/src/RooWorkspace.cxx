@@ -2643,29 +2643,22 @@ void RooWorkspace::Streamer(TBuffer &R__b)
 
       R__b.ReadClassBuffer(RooWorkspace::Class(),this);
             
-      // Perform any pass-2 schema evolution here
+      // Perform any pass-2 schema evolution here, and make expensive object
+      // cache of all objects point to intermal copy (somehow this doesn't work
+      // OK automatically), in a single pass over the nodes
       RooFIter fiter = _allOwnedNodes.fwdIterator() ;
       RooAbsArg* node ;
       while((node=fiter.next())) {
 	node->ioStreamerPass2() ;
-      }
-      RooAbsArg::ioStreamerPass2Finalize() ;
-      
-      // Make expensive object cache of all objects point to intermal copy.
-      // Somehow this doesn't work OK automatically
-      TIterator* iter = _allOwnedNodes.createIterator() ;
-      while((node=(RooAbsArg*)iter->Next())) {
 	node->setExpensiveObjectCache(_eocache) ;
-   node->setWorkspace(*this);
-   if (node->IsA()->InheritsFrom(RooAbsOptTestStatistic::Class())) {
-      RooAbsOptTestStatistic *tmp = (RooAbsOptTestStatistic *)node;
-      if (tmp->isSealed() && tmp->sealNotice() && strlen(tmp->sealNotice()) > 0) {
-         cout << "RooWorkspace::Streamer(" << GetName() << ") " << node->IsA()->GetName() << "::" << node->GetName()
-              << " : " << tmp->sealNotice() << endl;
-      }
-   }
+	node->setWorkspace(*this);
+	RooAbsOptTestStatistic *tmp = dynamic_cast<RooAbsOptTestStatistic*>(node) ;
+	if (tmp && tmp->isSealed() && tmp->sealNotice() && strlen(tmp->sealNotice()) > 0) {
+	  cout << "RooWorkspace::Streamer(" << GetName() << ") " << node->IsA()->GetName() << "::" << node->GetName()
+	       << " : " << tmp->sealNotice() << endl;
+	}
       }
-      delete iter ;
+      RooAbsArg::ioStreamerPass2Finalize() ;
 
 
    } else {
@@ -2746,6 +2739,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
 	 iterx->first->_clientListShape.Add(*citer) ;
        }
      }
+     RooAbsArg::clientGraphChanged() ;
 
    }
 }
@@ -232,6 +232,10 @@ class ToyMCSampler: public TestStatSampler {
       // calling with argument or NULL deactivates proof
       void SetProofConfig(ProofConfig *pc = NULL) { fProofConfig = pc; }
 
+      // run the toys in n local worker processes (n <= 1: serial run), when no ProofConfig is given
+      void SetNWorkers(Int_t n = 0) { fNWorkers = n; }
+      Int_t GetNWorkers() const { return fNWorkers; }
+
       void SetProtoData(const RooDataSet* d) { fProtoData = d; }
 
    protected:
@@ -244,6 +248,9 @@ class ToyMCSampler: public TestStatSampler {
       // helper method for clearing  the cache
       virtual void ClearCache();
 
+      // parallel run in local worker processes
+      RooDataSet* GetSamplingDistributionsMultiProcess(RooArgSet& paramPoint);
+
 
       // densities, snapshots, and test statistics to reweight to
       RooAbsPdf *fPdf; // model (can be alt or null)
@@ -278,6 +285,10 @@ class ToyMCSampler: public TestStatSampler {
 
       ProofConfig *fProofConfig;   //!
 
+      Int_t fNWorkers;             //! number of local worker processes
+      UInt_t fToySeed;             //! seed of the first toy in parallel runs (0: no reseeding)
+      Int_t fFirstToy;             //! index of the first toy of this worker
+
       mutable NuisanceParametersSampler *fNuisanceParametersSampler; //!
 
       // objects below cache information and are mutable and non-persistent
@@ -28,6 +28,12 @@ TestStatistic.
 For parallel runs, ToyMCSampler can be given an instance of ProofConfig
 and then run in parallel using proof or proof-lite. Internally, it uses
 ToyMCStudy with the RooStudyManager.
+
+Alternatively, SetNWorkers() runs the toys in forked worker processes on the
+local machine (with TProcessExecutor), without PROOF. Each worker generates
+and evaluates its share of the toys and the sampling distributions are merged.
+Each toy uses its own seed, drawn once from RooRandom before the run, so that
+the results do not depend on the number of workers.
 */
 
 #include "RooStats/ToyMCSampler.h"
@@ -51,6 +57,10 @@ ToyMCStudy with the RooStudyManager.
 
 #include "TMath.h"
 
+#ifdef ROOSTATS_MULTIPROC
+#include "ROOT/TProcessExecutor.hxx"
+#endif
+
 
 using namespace RooFit;
 using namespace std;
@@ -176,6 +186,9 @@ ToyMCSampler::ToyMCSampler() : fSamplingDistName("SD"), fNToys(1)
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 0;
+   fToySeed = 0;
+   fFirstToy = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -216,6 +229,9 @@ ToyMCSampler::ToyMCSampler(TestStatistic &ts, Int_t ntoys) : fSamplingDistName(t
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 0;
+   fToySeed = 0;
+   fFirstToy = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -328,9 +344,13 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
 {
 
    // ======= S I N G L E   R U N ? =======
-   if(!fProofConfig)
+   if(!fProofConfig && fNWorkers <= 1)
       return GetSamplingDistributionsSingleWorker(paramPointIn);
 
+   // ======= L O C A L   W O R K E R S =======
+   if(!fProofConfig)
+      return GetSamplingDistributionsMultiProcess(paramPointIn);
+
    // ======= P A R A L L E L   R U N =======
    if (!CheckConfig()){
       oocoutE((TObject*)NULL, InputArguments)
@@ -371,6 +391,65 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    return output;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Run the toys in fNWorkers forked processes and merge their sampling
+/// distributions. Each worker runs GetSamplingDistributionsSingleWorker()
+/// for a contiguous range of the toys, each toy with its own seed.
+
+RooDataSet* ToyMCSampler::GetSamplingDistributionsMultiProcess(RooArgSet& paramPointIn)
+{
+#ifdef ROOSTATS_MULTIPROC
+   if (!CheckConfig()){
+      oocoutE((TObject*)NULL, InputArguments)
+         << "Bad COnfiguration in ToyMCSampler "
+         << endl;
+      return nullptr;
+   }
+
+   // turn adaptive sampling off if given
+   if(fToysInTails) {
+      fToysInTails = 0;
+      oocoutW((TObject*)NULL, InputArguments)
+         << "Adaptive sampling in ToyMCSampler is not supported for parallel runs."
+         << endl;
+   }
+
+   const Int_t totToys = fNToys;
+   const UInt_t nWorkers = fNWorkers;
+   UInt_t seed = RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max());
+   if (seed == 0) seed = 1;
+
+   // the workers are forked processes: the changes of the settings are only seen by them
+   ROOT::TProcessExecutor pool(nWorkers);
+   auto results = pool.Map([&](UInt_t k) {
+      fFirstToy = Int_t(Long64_t(totToys) * k / nWorkers);
+      fNToys = Int_t(Long64_t(totToys) * (k + 1) / nWorkers) - fFirstToy;
+      fToySeed = seed;
+      return GetSamplingDistributionsSingleWorker(paramPointIn);
+   }, ROOT::TSeq<UInt_t>(0, nWorkers));
+
+   RooDataSet* output = nullptr;
+   for (auto r : results) {
+      if (!r) continue;
+      if (!output) {
+         output = r;
+      } else {
+         output->append(*r);
+         delete r;
+      }
+   }
+   if (!output || output->numEntries() < totToys) {
+      oocoutW((TObject*)NULL, Generation) << "ToyMCSampler: the workers returned "
+         << (output ? output->numEntries() : 0) << " toys out of " << totToys << endl;
+   }
+   return output;
+#else
+   oocoutW((TObject*)NULL, InputArguments)
+      << "ToyMCSampler: worker processes are not supported on this platform, running the toys serially" << endl;
+   return GetSamplingDistributionsSingleWorker(paramPointIn);
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This is the main function for serial runs. It is called automatically
 /// from inside GetSamplingDistribution when no ProofConfig is given.
@@ -423,6 +502,12 @@ RooDataSet* ToyMCSampler::GetSamplingDistributionsSingleWorker(RooArgSet& paramP
       // first one.
       Double_t valueFirst = -999.0, weight = 1.0;
 
+      // in parallel runs, each toy has its own random seed (but avoid 0, which is the time)
+      if (fToySeed) {
+         UInt_t toySeed = fToySeed + UInt_t(fFirstToy + i);
+         RooRandom::randomGenerator()->SetSeed(toySeed ? toySeed : 1);
+      }
+
       // set variables to requested parameter point
       *allVars = *saveAll; // important for example for SimpleLikelihoodRatioTestStat
 
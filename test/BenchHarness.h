@@ -0,0 +1,301 @@
+// @(#)root/test:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_BenchHarness
+#define ROOT_BenchHarness
+
+//
+// Harness of the benchmark programs benchIO, benchTDF, benchRooFit,
+// benchGeom and benchWrite: the measurement loops, the printout, the JSON
+// output and the parsing of the switches they have in common:
+//       -h            - print the usage
+//       -r repet      - number of measurements of each benchmark, the fastest
+//                       one is reported
+//       -o file       - also write the results to file in JSON format, to be
+//                       compared across releases
+//       filter        - run only the benchmarks whose name contains filter
+// A benchmark program registers its own switches with AddOption, and -t and
+// -j with AddMinTimeOption and AddThreadsOption, calls ParseArguments, then
+// runs its cases with RunScaled or RunRepeated, or records them with Report.
+//
+// Each program is a single source file: the harness lives in an anonymous
+// namespace, as the rest of the program; its functions are inline so that a
+// program does not have to use all of them.
+
+#include "TROOT.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+namespace Bench {
+
+/// Runs n operations, returns the bytes or items processed (0 if not relevant)
+using ScaledFunc_t = std::function<Long64_t(Long64_t)>;
+/// Runs the benchmark once, returns the number of operations done
+using RepeatedFunc_t = std::function<Long64_t()>;
+/// Sets the value of a switch from its argument, returns false if it is invalid
+using OptionFunc_t = std::function<Bool_t(const char *)>;
+
+/// What the value returned by a ScaledFunc_t counts
+enum class EProcessed { kBytes, kItems };
+
+struct Result {
+   std::string fName;      ///< Name of the benchmark
+   Long64_t fOps;          ///< Number of operations of the fastest measurement
+   Double_t fSeconds;      ///< Duration of the fastest measurement
+   Long64_t fItems;        ///< Items processed by the fastest measurement, 0 if not relevant
+   Long64_t fBytes;        ///< Bytes processed by the fastest measurement, 0 if not relevant
+   Int_t fThreads;         ///< Number of threads, -1 if not relevant
+   std::string fExtraJson; ///< Additional members of the JSON object, each one preceded by ", "
+};
+
+struct Option {
+   std::string fSwitch;  ///< e.g. "-n"
+   std::string fArgName; ///< Name of the argument in the usage, e.g. "entries"
+   OptionFunc_t fSet;
+};
+
+const char *gProgram = "bench";
+Double_t gMinTime = 0;     ///< Minimal time of a measurement of RunScaled, 0 without -t
+Int_t gRepetitions = 3;
+UInt_t gMaxThreads = 0;    ///< Largest number of threads (-j), the number of cores by default
+Int_t gThreads = -1;       ///< Number of threads of the measurements being run, -1 if not relevant
+const char *gFilter = "";
+const char *gJson = nullptr;
+EProcessed gProcessed = EProcessed::kBytes;
+const char *gItemName = "items"; ///< Name of the items in the printout, e.g. "entries"
+std::vector<Option> gOptions;
+std::vector<std::pair<std::string, std::string>> gContext; ///< Name and JSON value of the context entries
+std::vector<Result> gResults;
+
+// Keeps the compiler from dropping the values computed by the benchmarks.
+volatile Double_t gSink = 0;
+
+inline Bool_t Selected(const std::string &name)
+{
+   return strstr(name.c_str(), gFilter) != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Switches
+
+inline void AddOption(const char *sw, const char *argName, const OptionFunc_t &set)
+{
+   gOptions.push_back({sw, argName, set});
+}
+
+inline void AddMinTimeOption(Double_t defaultTime)
+{
+   gMinTime = defaultTime;
+   AddOption("-t", "mintime", [](const char *arg) {
+      gMinTime = atof(arg);
+      return kTRUE;
+   });
+}
+
+inline void AddThreadsOption(const char *argName = "maxthreads")
+{
+   AddOption("-j", argName, [](const char *arg) {
+      gMaxThreads = atoi(arg);
+      return kTRUE;
+   });
+}
+
+/// Add an entry to the context of the JSON output; value is JSON.
+inline void AddContext(const std::string &name, const std::string &value)
+{
+   gContext.emplace_back(name, value);
+}
+
+inline void Usage()
+{
+   std::string usage = std::string("Usage: ") + gProgram + " [-h]";
+   for (auto &option : gOptions)
+      usage += " [" + option.fSwitch + " " + option.fArgName + "]";
+   usage += " [-r repetitions] [-o results.json] [filter]";
+   printf("%s\n", usage.c_str());
+}
+
+/// Parses the switches of the program, returns the exit code of the program
+/// if it is to stop (after -h or an invalid switch), -1 otherwise.
+inline Int_t ParseArguments(int argc, char **argv, const char *program)
+{
+   gProgram = program;
+   for (Int_t i = 1; i < argc; ++i) {
+      Bool_t valid = kTRUE;
+      if (!strcmp(argv[i], "-h")) {
+         Usage();
+         return 0;
+      } else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+         gRepetitions = atoi(argv[++i]);
+         if (gRepetitions < 1)
+            gRepetitions = 1;
+      } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+         gJson = argv[++i];
+      } else if (argv[i][0] != '-') {
+         gFilter = argv[i];
+      } else {
+         valid = kFALSE;
+         for (auto &option : gOptions) {
+            if (option.fSwitch == argv[i] && i + 1 < argc) {
+               valid = option.fSet(argv[++i]);
+               break;
+            }
+         }
+      }
+      if (!valid) {
+         Usage();
+         return 1;
+      }
+   }
+   if (gMaxThreads < 1)
+      gMaxThreads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+   return -1;
+}
+
+/// Numbers of threads of the scaling benchmarks: 1, 2, 4, ... up to gMaxThreads
+inline std::vector<UInt_t> ThreadCounts()
+{
+   std::vector<UInt_t> counts;
+   for (UInt_t n = 1; n < gMaxThreads; n *= 2)
+      counts.push_back(n);
+   counts.push_back(gMaxThreads);
+   return counts;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Measurements
+
+/// Records and prints a result; extra is appended to the printout.
+inline void Report(const Result &res, const char *extra = "")
+{
+   gResults.push_back(res);
+   printf("%-56s %12lld ops %14.2f ns/op", res.fName.c_str(), res.fOps, 1e9 * res.fSeconds / res.fOps);
+   if (res.fBytes > 0)
+      printf(" %10.2f MB/s", res.fBytes / res.fSeconds / 1e6);
+   if (res.fItems > 0)
+      printf(" %10.3f M%s/s", res.fItems / res.fSeconds / 1e6, gItemName);
+   printf("%s\n", extra);
+}
+
+inline Double_t Measure(const ScaledFunc_t &func, Long64_t n, Long64_t &processed)
+{
+   auto start = std::chrono::steady_clock::now();
+   processed = func(n);
+   std::chrono::duration<Double_t> elapsed = std::chrono::steady_clock::now() - start;
+   return elapsed.count();
+}
+
+/// Runs func with a number of operations scaled until a measurement takes at
+/// least gMinTime, then gRepetitions times, and reports the fastest one.
+inline void RunScaled(const std::string &name, const ScaledFunc_t &func)
+{
+   if (!Selected(name))
+      return;
+
+   Long64_t n = 1, processed = 0;
+   Double_t seconds = Measure(func, n, processed);
+   while (seconds < gMinTime) {
+      Double_t factor = seconds > 0 ? 1.4 * gMinTime / seconds : 100.;
+      if (factor > 100.)
+         factor = 100.;
+      if (factor < 2.)
+         factor = 2.;
+      n = Long64_t(n * factor);
+      seconds = Measure(func, n, processed);
+   }
+   for (Int_t r = 1; r < gRepetitions; ++r) {
+      Long64_t p;
+      Double_t s = Measure(func, n, p);
+      if (s < seconds) {
+         seconds = s;
+         processed = p;
+      }
+   }
+
+   const Bool_t bytes = gProcessed == EProcessed::kBytes;
+   Report({name, n, seconds, bytes ? 0 : processed, bytes ? processed : 0, gThreads, ""});
+}
+
+/// Runs func gRepetitions times and reports the fastest run, the operations
+/// being the processed items.
+inline void RunRepeated(const std::string &name, const RepeatedFunc_t &func)
+{
+   if (!Selected(name))
+      return;
+
+   Double_t seconds = 0;
+   Long64_t ops = 0;
+   for (Int_t r = 0; r < gRepetitions; ++r) {
+      auto start = std::chrono::steady_clock::now();
+      Long64_t n = func();
+      std::chrono::duration<Double_t> elapsed = std::chrono::steady_clock::now() - start;
+      if (r == 0 || elapsed.count() < seconds) {
+         seconds = elapsed.count();
+         ops = n;
+      }
+   }
+   if (ops < 1)
+      ops = 1;
+
+   Report({name, ops, seconds, ops, 0, gThreads, ""});
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Output
+
+/// Writes the results to the file of -o, if any.
+inline void WriteJson()
+{
+   if (!gJson)
+      return;
+   FILE *fp = fopen(gJson, "w");
+   if (!fp) {
+      fprintf(stderr, "Error in <%s>: cannot open %s\n", gProgram, gJson);
+      exit(1);
+   }
+   fprintf(fp, "{\n  \"context\": {\n");
+   fprintf(fp, "    \"root_version\": \"%s\",\n", gROOT->GetVersion());
+   fprintf(fp, "    \"git_commit\": \"%s\",\n", gROOT->GetGitCommit());
+   fprintf(fp, "    \"date\": \"%d\",\n", gROOT->GetVersionDate());
+   if (gMinTime > 0)
+      fprintf(fp, "    \"min_time\": %g,\n", gMinTime);
+   for (auto &entry : gContext)
+      fprintf(fp, "    \"%s\": %s,\n", entry.first.c_str(), entry.second.c_str());
+   fprintf(fp, "    \"repetitions\": %d\n", gRepetitions);
+   fprintf(fp, "  },\n  \"benchmarks\": [\n");
+   for (std::size_t i = 0; i < gResults.size(); ++i) {
+      const Result &res = gResults[i];
+      fprintf(fp, "    {\"name\": \"%s\", \"iterations\": %lld, \"real_time\": %.9g, \"ns_per_op\": %.6g",
+              res.fName.c_str(), res.fOps, res.fSeconds, 1e9 * res.fSeconds / res.fOps);
+      if (res.fItems > 0)
+         fprintf(fp, ", \"items_per_second\": %.6g", res.fItems / res.fSeconds);
+      if (res.fBytes > 0)
+         fprintf(fp, ", \"bytes_per_second\": %.6g", res.fBytes / res.fSeconds);
+      if (res.fThreads >= 0)
+         fprintf(fp, ", \"threads\": %d", res.fThreads);
+      fprintf(fp, "%s}%s\n", res.fExtraJson.c_str(), i + 1 < gResults.size() ? "," : "");
+   }
+   fprintf(fp, "  ]\n}\n");
+   fclose(fp);
+}
+
+} // namespace Bench
+} // anonymous namespace
+
+#endif
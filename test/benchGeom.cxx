@@ -0,0 +1,406 @@
+// @(#)root/test:$Id$
+
+//
+// Benchmarks of the geometry navigation, to catch regressions and to compare
+// navigation algorithms and voxelization schemes on the same tracks:
+//  - Locate:           TGeoNavigator::FindNode of the starting points
+//  - Safety:           FindNode, then Safety of the starting points
+//  - FindNextBoundary: InitTrack, then the distance to the next boundary
+//  - Transport:        FindNextBoundaryAndStep until the track leaves the
+//                      geometry, reported per step
+//  - Locate and Transport with 1 to N threads, each one with its navigator
+//
+// The cost of Safety and of FindNextBoundary alone is the difference with
+// Locate. Two track distributions are generated in each geometry:
+//  - random:  points uniform in the top volume, isotropic directions
+//  - physics: vertices smeared around the center of the top volume,
+//             directions uniform in |eta| < 2.5 and in phi, as the tracks of
+//             a collider experiment
+//
+// Usage: benchGeom [-h] [-n tracks] [-j maxthreads] [-g geometries] [-f file]
+//                  [-v bvh|nobvh] [-r repetitions] [-o results.json] [filter]
+//
+// switches:
+//       -h            - print this usage
+//       -n tracks     - number of tracks of each distribution (default 100000)
+//       -j maxthreads - largest number of threads of the scaling benchmarks
+//                       (default: number of cores)
+//       -g geometries - comma separated list of geometries: builtin, a
+//                       detector generated by this program, or the name of a
+//                       geometry of http://root.cern.ch/files, downloaded
+//                       once in the current directory (default
+//                       builtin,alice3,atlas,cms,lhcbfull)
+//       -f file       - also a user geometry, in a ROOT or GDML file; can be
+//                       repeated
+//       -v bvh        - use the BVH of the voxel finder for all the volumes
+//                       with several daughters, nobvh never uses it
+//       -r repet      - number of measurements of each benchmark, the fastest
+//                       one is reported (default 3)
+//       -o file       - also write the results to file in JSON format, to be
+//                       compared across releases
+//
+// parameters:
+//       filter        - run only the benchmarks whose name contains filter
+//
+// The tracks are generated before the measurements, with a fixed seed, so
+// that two runs measure the same navigation. The number of operations per
+// second and the time per operation are printed.
+
+#include "RConfigure.h"
+#include "TError.h"
+#include "TGeoBBox.h"
+#include "TGeoManager.h"
+#include "TGeoMaterial.h"
+#include "TGeoMatrix.h"
+#include "TGeoMedium.h"
+#include "TGeoNavigator.h"
+#include "TGeoVolume.h"
+#include "TGeoVoxelFinder.h"
+#include "TFile.h"
+#include "TMath.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+#include "TSystem.h"
+
+#include "BenchHarness.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Bench::gSink;
+
+struct Track {
+   Double_t fPoint[3];
+   Double_t fDir[3];
+};
+
+ULong64_t gTracks = 100000;
+
+// Bound of the steps of one track, for the tracks trapped by a bad geometry.
+const Int_t kMaxSteps = 100000;
+
+////////////////////////////////////////////////////////////////////////////////
+// Geometries
+
+// A collider detector: layers of rotated silicon modules, many daughters of
+// the same volume, and a calorimeter divided in phi and in z.
+void BuildGeometry()
+{
+   new TGeoManager("builtin", "benchGeom detector");
+   TGeoMedium *vacuum = new TGeoMedium("Vacuum", 1, new TGeoMaterial("Vacuum", 0, 0, 0));
+   TGeoMedium *silicon = new TGeoMedium("Silicon", 2, new TGeoMaterial("Si", 28.09, 14, 2.33));
+   TGeoMedium *lead = new TGeoMedium("Lead", 3, new TGeoMaterial("Pb", 207.19, 82, 11.35));
+
+   TGeoVolume *top = gGeoManager->MakeBox("TOP", vacuum, 100, 100, 150);
+   gGeoManager->SetTopVolume(top);
+
+   const Int_t nlayers = 5;
+   for (Int_t l = 0; l < nlayers; ++l) {
+      const Double_t radius = 10. * (l + 1);
+      const Int_t nmodules = 64 * (l + 1);
+      const Double_t halfwidth = 0.9 * TMath::Pi() * radius / nmodules;
+      TGeoVolume *layer = gGeoManager->MakeTube(Form("LAYER%d", l), vacuum, radius - 1, radius + 1, 31);
+      TGeoVolume *module = gGeoManager->MakeBox(Form("MODULE%d", l), silicon, 0.15, halfwidth, 30);
+      for (Int_t m = 0; m < nmodules; ++m) {
+         const Double_t phi = 360. * m / nmodules;
+         TGeoRotation *rot = new TGeoRotation("", phi, 0, 0);
+         const Double_t x = radius * TMath::Cos(phi * TMath::DegToRad());
+         const Double_t y = radius * TMath::Sin(phi * TMath::DegToRad());
+         layer->AddNode(module, m, new TGeoCombiTrans(x, y, 0, rot));
+      }
+      top->AddNode(layer, l);
+   }
+
+   TGeoVolume *calo = gGeoManager->MakeTube("CALO", lead, 60, 90, 100);
+   TGeoVolume *sector = calo->Divide("SECTOR", 2, 64, 0, 0);
+   sector->Divide("CELL", 3, 20, 0, 0);
+   top->AddNode(calo, 1);
+
+   gGeoManager->CloseGeometry();
+}
+
+Bool_t LoadGeometry(const std::string &geom)
+{
+   if (geom == "builtin") {
+      delete gGeoManager;
+      BuildGeometry();
+   } else if (geom.find('.') != std::string::npos) {
+      TGeoManager::Import(geom.c_str());
+   } else {
+      TGeoManager::Import(Form("http://root.cern.ch/files/%s.root", geom.c_str()));
+   }
+   if (!gGeoManager || !gGeoManager->GetTopVolume()) {
+      fprintf(stderr, "Error in <benchGeom>: cannot load the geometry %s\n", geom.c_str());
+      return kFALSE;
+   }
+   return kTRUE;
+}
+
+// The name of the benchmarks of a geometry file, without directory and extension.
+std::string GeometryName(const std::string &geom)
+{
+   std::string name = geom.substr(geom.find_last_of('/') + 1);
+   return name.substr(0, name.find('.'));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Tracks
+
+std::vector<Track> RandomTracks(ULong64_t n)
+{
+   TGeoVolume *top = gGeoManager->GetTopVolume();
+   TGeoBBox *box = (TGeoBBox *)top->GetShape();
+   const Double_t *origin = box->GetOrigin();
+   const Double_t half[3] = {box->GetDX(), box->GetDY(), box->GetDZ()};
+   TRandom3 rng(1);
+   std::vector<Track> tracks;
+   tracks.reserve(n);
+   ULong64_t trials = 0;
+   while (tracks.size() < n && trials++ < 100 * n) {
+      Track t;
+      for (Int_t i = 0; i < 3; ++i)
+         t.fPoint[i] = origin[i] - half[i] + 2 * half[i] * rng.Rndm();
+      if (!top->Contains(t.fPoint))
+         continue;
+      const Double_t phi = TMath::TwoPi() * rng.Rndm();
+      const Double_t theta = TMath::ACos(1. - 2. * rng.Rndm());
+      t.fDir[0] = TMath::Sin(theta) * TMath::Cos(phi);
+      t.fDir[1] = TMath::Sin(theta) * TMath::Sin(phi);
+      t.fDir[2] = TMath::Cos(theta);
+      tracks.push_back(t);
+   }
+   return tracks;
+}
+
+std::vector<Track> PhysicsTracks(ULong64_t n)
+{
+   TGeoVolume *top = gGeoManager->GetTopVolume();
+   TGeoBBox *box = (TGeoBBox *)top->GetShape();
+   const Double_t *origin = box->GetOrigin();
+   const Double_t sigma[3] = {1e-3 * box->GetDX(), 1e-3 * box->GetDY(), 1e-2 * box->GetDZ()};
+   TRandom3 rng(2);
+   std::vector<Track> tracks;
+   tracks.reserve(n);
+   ULong64_t trials = 0;
+   while (tracks.size() < n && trials++ < 100 * n) {
+      Track t;
+      for (Int_t i = 0; i < 3; ++i)
+         t.fPoint[i] = rng.Gaus(origin[i], sigma[i]);
+      if (!top->Contains(t.fPoint))
+         continue;
+      const Double_t eta = rng.Uniform(-2.5, 2.5);
+      const Double_t phi = TMath::TwoPi() * rng.Rndm();
+      const Double_t theta = 2. * TMath::ATan(TMath::Exp(-eta));
+      t.fDir[0] = TMath::Sin(theta) * TMath::Cos(phi);
+      t.fDir[1] = TMath::Sin(theta) * TMath::Sin(phi);
+      t.fDir[2] = TMath::Cos(theta);
+      tracks.push_back(t);
+   }
+   return tracks;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Navigation of a range of tracks with one navigator
+
+using NavFunc_t = ULong64_t (*)(TGeoNavigator *, const Track *, const Track *);
+
+ULong64_t Locate(TGeoNavigator *nav, const Track *begin, const Track *end)
+{
+   ULong64_t found = 0;
+   for (const Track *t = begin; t != end; ++t) {
+      if (nav->FindNode(t->fPoint[0], t->fPoint[1], t->fPoint[2]))
+         ++found;
+   }
+   gSink = gSink + found;
+   return end - begin;
+}
+
+ULong64_t Safety(TGeoNavigator *nav, const Track *begin, const Track *end)
+{
+   Double_t sum = 0;
+   for (const Track *t = begin; t != end; ++t) {
+      nav->FindNode(t->fPoint[0], t->fPoint[1], t->fPoint[2]);
+      sum += nav->Safety();
+   }
+   gSink = gSink + sum;
+   return end - begin;
+}
+
+ULong64_t NextBoundary(TGeoNavigator *nav, const Track *begin, const Track *end)
+{
+   Double_t sum = 0;
+   for (const Track *t = begin; t != end; ++t) {
+      nav->InitTrack(t->fPoint, t->fDir);
+      nav->FindNextBoundary();
+      sum += nav->GetStep();
+   }
+   gSink = gSink + sum;
+   return end - begin;
+}
+
+// Returns the number of steps.
+ULong64_t Transport(TGeoNavigator *nav, const Track *begin, const Track *end)
+{
+   ULong64_t steps = 0;
+   Double_t length = 0;
+   for (const Track *t = begin; t != end; ++t) {
+      nav->InitTrack(t->fPoint, t->fDir);
+      Int_t nsmall = 0;
+      for (Int_t s = 0; s < kMaxSteps && !nav->IsOutside(); ++s) {
+         nav->FindNextBoundaryAndStep();
+         ++steps;
+         length += nav->GetStep();
+         // A track which does not move any more is given up.
+         if (nav->GetStep() < 1e-8) {
+            if (++nsmall > 10)
+               break;
+         } else {
+            nsmall = 0;
+         }
+      }
+   }
+   gSink = gSink + length;
+   return steps;
+}
+
+// The tracks are shared in contiguous ranges between nthreads threads, each one
+// with its own navigator.
+ULong64_t RunThreads(NavFunc_t func, const std::vector<Track> &tracks, UInt_t nthreads)
+{
+   TGeoManager::ClearThreadsMap();
+   std::vector<ULong64_t> items(nthreads, 0);
+   std::vector<std::thread> threads;
+   const size_t chunk = (tracks.size() + nthreads - 1) / nthreads;
+   for (UInt_t i = 0; i < nthreads; ++i) {
+      const size_t first = std::min(tracks.size(), i * chunk);
+      const size_t last = std::min(tracks.size(), first + chunk);
+      threads.emplace_back([&, i, first, last]() {
+         TGeoNavigator *nav = gGeoManager->AddNavigator();
+         items[i] = func(nav, tracks.data() + first, tracks.data() + last);
+         gGeoManager->RemoveNavigator(nav);
+      });
+   }
+   ULong64_t total = 0;
+   for (UInt_t i = 0; i < nthreads; ++i) {
+      threads[i].join();
+      total += items[i];
+   }
+   return total;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Benchmarks of one geometry
+
+void RunGeometry(const std::string &name)
+{
+   const std::vector<std::pair<std::string, std::vector<Track>>> samples = {{"random", RandomTracks(gTracks)},
+                                                                             {"physics", PhysicsTracks(gTracks)}};
+   const std::vector<std::pair<std::string, NavFunc_t>> benchmarks = {
+      {"Locate", Locate}, {"Safety", Safety}, {"FindNextBoundary", NextBoundary}, {"Transport", Transport}};
+
+   TGeoNavigator *nav = gGeoManager->GetCurrentNavigator();
+   if (!nav)
+      nav = gGeoManager->AddNavigator();
+   for (auto &sample : samples) {
+      if (sample.second.size() < gTracks)
+         fprintf(stderr, "Warning in <benchGeom>: only %zu %s tracks could be generated in %s\n",
+                 sample.second.size(), sample.first.c_str(), name.c_str());
+      const Track *begin = sample.second.data();
+      const Track *end = begin + sample.second.size();
+      for (auto &bench : benchmarks) {
+         NavFunc_t func = bench.second;
+         Bench::RunRepeated(name + "/" + sample.first + "/" + bench.first, [=]() { return func(nav, begin, end); });
+      }
+   }
+
+   // Scaling with the number of threads. The navigation is multi-threaded
+   // from now on, until the next geometry is loaded.
+   for (UInt_t n : Bench::ThreadCounts()) {
+      std::string suffix = "/threads=" + std::to_string(n);
+      Bool_t selected = kFALSE;
+      for (auto &sample : samples)
+         selected |= Bench::Selected(name + "/" + sample.first + "/Locate" + suffix) ||
+                     Bench::Selected(name + "/" + sample.first + "/Transport" + suffix);
+      if (!selected)
+         continue;
+      gGeoManager->SetMaxThreads(n);
+      Bench::gThreads = n;
+      for (auto &sample : samples) {
+         const std::vector<Track> &tracks = sample.second;
+         Bench::RunRepeated(name + "/" + sample.first + "/Locate" + suffix,
+                            [&]() { return RunThreads(Locate, tracks, n); });
+         Bench::RunRepeated(name + "/" + sample.first + "/Transport" + suffix,
+                            [&]() { return RunThreads(Transport, tracks, n); });
+      }
+      Bench::gThreads = 0;
+   }
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+   std::string list = "builtin,alice3,atlas,cms,lhcbfull";
+   std::vector<std::string> files;
+   Bench::AddOption("-n", "tracks", [](const char *arg) {
+      gTracks = strtoull(arg, nullptr, 10);
+      if (gTracks < 1)
+         gTracks = 1;
+      return kTRUE;
+   });
+   Bench::AddThreadsOption();
+   Bench::AddOption("-g", "geometries", [&list](const char *arg) {
+      list = arg;
+      return kTRUE;
+   });
+   Bench::AddOption("-f", "file", [&files](const char *arg) {
+      files.push_back(arg);
+      return kTRUE;
+   });
+   Bench::AddOption("-v", "bvh|nobvh", [](const char *arg) {
+      if (!strcmp(arg, "bvh"))
+         TGeoVoxelFinder::SetBVHLimits(2, 0.);
+      else if (!strcmp(arg, "nobvh"))
+         TGeoVoxelFinder::SetBVHLimits(-1);
+      else
+         return kFALSE;
+      return kTRUE;
+   });
+   const Int_t status = Bench::ParseArguments(argc, argv, "benchGeom");
+   if (status >= 0)
+      return status;
+   Bench::AddContext("tracks", std::to_string(gTracks));
+   Bench::gThreads = 0;
+
+   gROOT->SetBatch();
+   TGeoManager::SetVerboseLevel(0);
+   TFile::SetCacheFileDir(".");
+
+   std::vector<std::string> geoms;
+   for (size_t pos = 0; pos <= list.size();) {
+      size_t comma = list.find(',', pos);
+      if (comma == std::string::npos)
+         comma = list.size();
+      if (comma > pos)
+         geoms.push_back(list.substr(pos, comma - pos));
+      pos = comma + 1;
+   }
+   geoms.insert(geoms.end(), files.begin(), files.end());
+
+   for (auto &geom : geoms) {
+      if (LoadGeometry(geom))
+         RunGeometry(GeometryName(geom));
+   }
+   delete gGeoManager;
+
+   Bench::WriteJson();
+   return 0;
+}
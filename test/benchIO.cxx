@@ -0,0 +1,444 @@
+// @(#)root/test:$Id$
+
+//
+// Microbenchmarks of the core I/O operations, to catch per-operation
+// regressions that the end-to-end timings of bench and stress cannot show:
+//  - streaming of the primitive types and arrays with TBufferFile
+//  - compression and decompression of a basket-sized buffer, for each
+//    algorithm and level, with the calls used by TBasket
+//  - TBranch::GetEntry for the common leaf types
+//  - TTreeReader loops
+//  - member-wise streaming of nested classes (TStreamerInfoActions) with
+//    the Event class of libEvent
+//
+// Usage: benchIO [-h] [-t mintime] [-r repetitions] [-o results.json] [filter]
+//
+// switches:
+//       -h            - print this usage
+//       -t mintime    - minimal time in seconds of each measurement (default 0.2)
+//       -r repet      - number of measurements of each benchmark, the fastest
+//                       one is reported (default 3)
+//       -o file       - also write the results to file in JSON format, to be
+//                       compared across releases
+//
+// parameters:
+//       filter        - run only the benchmarks whose name contains filter
+//
+// Each benchmark is run with a number of operations scaled until one
+// measurement takes at least mintime. The time per operation and, where it
+// makes sense, the processed bytes per second are printed.
+
+#include "Compression.h"
+#include "RZip.h"
+#include "TBufferFile.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderArray.h"
+#include "TTreeReaderValue.h"
+
+#include "Event.h"
+
+#include "BenchHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Bench::gSink;
+
+const Int_t kChunk = 4096;        // primitives streamed before rewinding the buffer
+const Int_t kBasketSize = 32000;  // default basket size of TTree::Branch
+const char *kTreeFile = "benchIO.root";
+const Long64_t kTreeEntries = 200000;
+
+////////////////////////////////////////////////////////////////////////////////
+// TBufferFile
+
+template <typename T>
+Long64_t WritePrimitive(Long64_t n)
+{
+   TBufferFile buf(TBuffer::kWrite, kChunk * sizeof(T) + 64);
+   T value = 1;
+   for (Long64_t i = 0; i < n; ++i) {
+      if (i % kChunk == 0)
+         buf.SetBufferOffset(0);
+      buf << value;
+      value += 3;
+   }
+   return n * sizeof(T);
+}
+
+template <typename T>
+Long64_t ReadPrimitive(Long64_t n)
+{
+   TBufferFile buf(TBuffer::kWrite, kChunk * sizeof(T) + 64);
+   for (Int_t i = 0; i < kChunk; ++i)
+      buf << T(i);
+   buf.SetReadMode();
+   T value, sum = 0;
+   for (Long64_t i = 0; i < n; ++i) {
+      if (i % kChunk == 0)
+         buf.SetBufferOffset(0);
+      buf >> value;
+      sum += value;
+   }
+   gSink = gSink + sum;
+   return n * sizeof(T);
+}
+
+Long64_t WriteDoubleArray(Long64_t n)
+{
+   std::vector<Double_t> values(kChunk, 1.5);
+   TBufferFile buf(TBuffer::kWrite, kChunk * sizeof(Double_t) + 64);
+   for (Long64_t i = 0; i < n; ++i) {
+      buf.SetBufferOffset(0);
+      buf.WriteFastArray(values.data(), kChunk);
+   }
+   return n * kChunk * sizeof(Double_t);
+}
+
+Long64_t ReadDoubleArray(Long64_t n)
+{
+   std::vector<Double_t> values(kChunk, 1.5);
+   TBufferFile buf(TBuffer::kWrite, kChunk * sizeof(Double_t) + 64);
+   buf.WriteFastArray(values.data(), kChunk);
+   buf.SetReadMode();
+   for (Long64_t i = 0; i < n; ++i) {
+      buf.SetBufferOffset(0);
+      buf.ReadFastArray(values.data(), kChunk);
+   }
+   gSink = gSink + values[kChunk - 1];
+   return n * kChunk * sizeof(Double_t);
+}
+
+Long64_t WriteTString(Long64_t n)
+{
+   TString str("a string of a few tens of characters");
+   TBufferFile buf(TBuffer::kWrite, kChunk * (str.Length() + 1) + 64);
+   for (Long64_t i = 0; i < n; ++i) {
+      if (i % kChunk == 0)
+         buf.SetBufferOffset(0);
+      buf.WriteTString(str);
+   }
+   return n * (str.Length() + 1);
+}
+
+Long64_t ReadTString(Long64_t n)
+{
+   TString str("a string of a few tens of characters");
+   TBufferFile buf(TBuffer::kWrite, kChunk * (str.Length() + 1) + 64);
+   for (Int_t i = 0; i < kChunk; ++i)
+      buf.WriteTString(str);
+   buf.SetReadMode();
+   Long64_t bytes = 0;
+   for (Long64_t i = 0; i < n; ++i) {
+      if (i % kChunk == 0)
+         buf.SetBufferOffset(0);
+      buf.ReadTString(str);
+      bytes += str.Length() + 1;
+   }
+   return bytes;
+}
+
+void RunBufferFile()
+{
+   Bench::RunScaled("TBufferFile/Write/Char_t", WritePrimitive<Char_t>);
+   Bench::RunScaled("TBufferFile/Read/Char_t", ReadPrimitive<Char_t>);
+   Bench::RunScaled("TBufferFile/Write/Short_t", WritePrimitive<Short_t>);
+   Bench::RunScaled("TBufferFile/Read/Short_t", ReadPrimitive<Short_t>);
+   Bench::RunScaled("TBufferFile/Write/Int_t", WritePrimitive<Int_t>);
+   Bench::RunScaled("TBufferFile/Read/Int_t", ReadPrimitive<Int_t>);
+   Bench::RunScaled("TBufferFile/Write/Long64_t", WritePrimitive<Long64_t>);
+   Bench::RunScaled("TBufferFile/Read/Long64_t", ReadPrimitive<Long64_t>);
+   Bench::RunScaled("TBufferFile/Write/Float_t", WritePrimitive<Float_t>);
+   Bench::RunScaled("TBufferFile/Read/Float_t", ReadPrimitive<Float_t>);
+   Bench::RunScaled("TBufferFile/Write/Double_t", WritePrimitive<Double_t>);
+   Bench::RunScaled("TBufferFile/Read/Double_t", ReadPrimitive<Double_t>);
+   Bench::RunScaled("TBufferFile/WriteFastArray/Double_t", WriteDoubleArray);
+   Bench::RunScaled("TBufferFile/ReadFastArray/Double_t", ReadDoubleArray);
+   Bench::RunScaled("TBufferFile/Write/TString", WriteTString);
+   Bench::RunScaled("TBufferFile/Read/TString", ReadTString);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Compression
+
+/// A basket-sized buffer of streamed values, compressible like real data.
+std::vector<char> MakeBasketContent()
+{
+   TBufferFile buf(TBuffer::kWrite, kBasketSize + 64);
+   for (Int_t i = 0; buf.Length() + 16 < kBasketSize; ++i) {
+      buf << Int_t(i % 100);
+      buf << Float_t(0.001 * i);
+      buf << Double_t(i % 7) * 0.25;
+   }
+   std::vector<char> content(buf.Buffer(), buf.Buffer() + buf.Length());
+   content.resize(kBasketSize, 0);
+   return content;
+}
+
+const char *AlgorithmName(ROOT::ECompressionAlgorithm algorithm)
+{
+   switch (algorithm) {
+   case ROOT::kZLIB: return "ZLIB";
+   case ROOT::kLZMA: return "LZMA";
+   case ROOT::kLZ4: return "LZ4";
+   case ROOT::kZSTD: return "ZSTD";
+   default: return "unknown";
+   }
+}
+
+void RunCompression()
+{
+   std::vector<char> content = MakeBasketContent();
+   // The compression can expand incompressible data by the header size.
+   std::vector<char> compressed(kBasketSize + 1024);
+   std::vector<char> uncompressed(kBasketSize);
+
+   const ROOT::ECompressionAlgorithm algorithms[] = {ROOT::kZLIB, ROOT::kLZMA, ROOT::kLZ4, ROOT::kZSTD};
+   const Int_t levels[] = {1, 5, 9};
+   for (auto algorithm : algorithms) {
+      for (auto level : levels) {
+         TString name = TString::Format("%s/%d", AlgorithmName(algorithm), level);
+         Int_t srcsize = kBasketSize, tgtsize = compressed.size(), nzip = 0;
+         R__zipMultipleAlgorithm(level, &srcsize, content.data(), &tgtsize, compressed.data(), &nzip, algorithm);
+         if (nzip <= 0) {
+            // e.g. the algorithm is not part of this build
+            if (Bench::Selected(name.Data()))
+               printf("%-40s not available\n", name.Data());
+            continue;
+         }
+         if (Bench::Selected(("Compress/" + name).Data()) || Bench::Selected(("Uncompress/" + name).Data()))
+            printf("%-40s compression factor %.2f\n", name.Data(), Double_t(kBasketSize) / nzip);
+
+         Bench::RunScaled(("Compress/" + name).Data(), [&](Long64_t n) {
+            for (Long64_t i = 0; i < n; ++i) {
+               Int_t isize = kBasketSize, osize = compressed.size(), nout = 0;
+               R__zipMultipleAlgorithm(level, &isize, content.data(), &osize, compressed.data(), &nout, algorithm);
+            }
+            return n * kBasketSize;
+         });
+         Bench::RunScaled(("Uncompress/" + name).Data(), [&](Long64_t n) {
+            for (Long64_t i = 0; i < n; ++i) {
+               Int_t srcsize = nzip, tgtsize = kBasketSize, nout = 0;
+               R__unzip(&srcsize, (UChar_t *)compressed.data(), &tgtsize, (UChar_t *)uncompressed.data(), &nout);
+               if (nout != kBasketSize) {
+                  fprintf(stderr, "Error in <benchIO>: %s decompressed %d bytes instead of %d\n",
+                          AlgorithmName(algorithm), nout, kBasketSize);
+                  exit(1);
+               }
+            }
+            return n * kBasketSize;
+         });
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// TTree
+
+void MakeTreeFile()
+{
+   TFile file(kTreeFile, "RECREATE");
+   TTree tree("T", "tree of the I/O benchmarks");
+   Int_t i;
+   Long64_t l;
+   Float_t f;
+   Double_t d;
+   Double_t fixed[16];
+   Int_t nvar;
+   Float_t var[32];
+   std::vector<Double_t> vec;
+   tree.Branch("i", &i, "i/I");
+   tree.Branch("l", &l, "l/L");
+   tree.Branch("f", &f, "f/F");
+   tree.Branch("d", &d, "d/D");
+   tree.Branch("fixed", fixed, "fixed[16]/D");
+   tree.Branch("nvar", &nvar, "nvar/I");
+   tree.Branch("var", var, "var[nvar]/F");
+   tree.Branch("vec", &vec);
+   for (Long64_t e = 0; e < kTreeEntries; ++e) {
+      i = e % 1000;
+      l = e * 3;
+      f = 0.01 * (e % 997);
+      d = 0.5 * e;
+      for (Int_t k = 0; k < 16; ++k)
+         fixed[k] = k + 0.5 * i;
+      nvar = e % 32;
+      for (Int_t k = 0; k < nvar; ++k)
+         var[k] = k * f;
+      vec.resize(e % 8);
+      for (auto &v : vec)
+         v = d;
+      tree.Fill();
+   }
+   tree.Write();
+}
+
+void RunGetEntry(TTree *tree, const char *branchname)
+{
+   TBranch *branch = tree->GetBranch(branchname);
+   TString name = TString::Format("TBranch::GetEntry/%s", branch->GetTitle());
+   if (branch->GetListOfLeaves()->GetEntries() == 1 && !strcmp(branch->GetTitle(), branch->GetName()))
+      name = TString::Format("TBranch::GetEntry/%s", branch->GetClassName());
+   Bench::RunScaled(name.Data(), [&](Long64_t n) {
+      Long64_t bytes = 0;
+      for (Long64_t i = 0; i < n; ++i)
+         bytes += branch->GetEntry(i % kTreeEntries);
+      return bytes;
+   });
+}
+
+void RunTree()
+{
+   MakeTreeFile();
+   TFile file(kTreeFile);
+   TTree *tree = nullptr;
+   file.GetObject("T", tree);
+   if (!tree) {
+      fprintf(stderr, "Error in <benchIO>: cannot read the tree of %s\n", kTreeFile);
+      exit(1);
+   }
+
+   // The branches are read one after the other; var also reads its count nvar.
+   Int_t i, nvar;
+   Long64_t l;
+   Float_t f, var[32];
+   Double_t d, fixed[16];
+   std::vector<Double_t> *vec = nullptr;
+   tree->SetBranchAddress("i", &i);
+   tree->SetBranchAddress("l", &l);
+   tree->SetBranchAddress("f", &f);
+   tree->SetBranchAddress("d", &d);
+   tree->SetBranchAddress("fixed", fixed);
+   tree->SetBranchAddress("nvar", &nvar);
+   tree->SetBranchAddress("var", var);
+   tree->SetBranchAddress("vec", &vec);
+   const char *branches[] = {"i", "l", "f", "d", "fixed", "var", "vec"};
+   for (auto branchname : branches)
+      RunGetEntry(tree, branchname);
+   tree->ResetBranchAddresses();
+   delete vec;
+
+   Bench::RunScaled("TTreeReader/Value/Double_t", [&](Long64_t n) {
+      TTreeReader reader(tree);
+      TTreeReaderValue<Double_t> rd(reader, "d");
+      Double_t sum = 0;
+      for (Long64_t e = 0; e < n; ++e) {
+         reader.SetEntry(e % kTreeEntries);
+         sum += *rd;
+      }
+      gSink = gSink + sum;
+      return n * sizeof(Double_t);
+   });
+   Bench::RunScaled("TTreeReader/Values/I,L,F,D", [&](Long64_t n) {
+      TTreeReader reader(tree);
+      TTreeReaderValue<Int_t> ri(reader, "i");
+      TTreeReaderValue<Long64_t> rl(reader, "l");
+      TTreeReaderValue<Float_t> rf(reader, "f");
+      TTreeReaderValue<Double_t> rd(reader, "d");
+      Double_t sum = 0;
+      for (Long64_t e = 0; e < n; ++e) {
+         reader.SetEntry(e % kTreeEntries);
+         sum += *ri + *rl + *rf + *rd;
+      }
+      gSink = gSink + sum;
+      return n * 24;
+   });
+   Bench::RunScaled("TTreeReader/Array/var[nvar]/F", [&](Long64_t n) {
+      TTreeReader reader(tree);
+      TTreeReaderArray<Float_t> rvar(reader, "var");
+      Double_t sum = 0;
+      Long64_t bytes = 0;
+      for (Long64_t e = 0; e < n; ++e) {
+         reader.SetEntry(e % kTreeEntries);
+         for (auto v : rvar)
+            sum += v;
+         bytes += rvar.GetSize() * sizeof(Float_t);
+      }
+      gSink = gSink + sum;
+      return bytes;
+   });
+   Bench::RunScaled("TTreeReader/Array/vector<double>", [&](Long64_t n) {
+      TTreeReader reader(tree);
+      TTreeReaderArray<Double_t> rvec(reader, "vec");
+      Double_t sum = 0;
+      Long64_t bytes = 0;
+      for (Long64_t e = 0; e < n; ++e) {
+         reader.SetEntry(e % kTreeEntries);
+         for (auto v : rvec)
+            sum += v;
+         bytes += rvec.GetSize() * sizeof(Double_t);
+      }
+      gSink = gSink + sum;
+      return bytes;
+   });
+
+   delete tree;
+   file.Close();
+   gSystem->Unlink(kTreeFile);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Streaming of nested classes
+
+void RunStreamerInfo()
+{
+   // Event holds an EventHeader and a TClonesArray of Track, streamed with their StreamerInfo actions.
+   Event event;
+   event.Build(0, 100);
+   Int_t ntrack = event.GetNtrack();
+   TBufferFile buf(TBuffer::kWrite, 512 * 1024);
+   event.Streamer(buf);
+   Int_t length = buf.Length();
+
+   Bench::RunScaled("Streamer/Write/Event", [&](Long64_t n) {
+      for (Long64_t i = 0; i < n; ++i) {
+         buf.SetBufferOffset(0);
+         event.Streamer(buf);
+      }
+      return n * length;
+   });
+   buf.SetBufferOffset(0);
+   event.Streamer(buf);
+   buf.SetReadMode();
+   Bench::RunScaled("Streamer/Read/Event", [&](Long64_t n) {
+      for (Long64_t i = 0; i < n; ++i) {
+         buf.SetBufferOffset(0);
+         event.Clear("C");
+         event.Streamer(buf);
+      }
+      return n * length;
+   });
+   if (event.GetNtrack() != ntrack) {
+      fprintf(stderr, "Error in <benchIO>: read %d tracks instead of %d\n", event.GetNtrack(), ntrack);
+      exit(1);
+   }
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+   Bench::AddMinTimeOption(0.2);
+   const Int_t status = Bench::ParseArguments(argc, argv, "benchIO");
+   if (status >= 0)
+      return status;
+
+   gROOT->SetBatch();
+   RunBufferFile();
+   RunCompression();
+   RunTree();
+   RunStreamerInfo();
+
+   Bench::WriteJson();
+   return 0;
+}
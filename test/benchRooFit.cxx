@@ -0,0 +1,365 @@
+// @(#)root/test:$Id$
+
+//
+// Benchmarks of the likelihood evaluation of RooFit, to track the speed of
+// the fits that stressRooFit and stressHistFactory only check for
+// correctness:
+//  - evaluations of the unbinned negative log-likelihood of standard p.d.f.s
+//  - the same for RooAddPdf and RooProdPdf compositions
+//  - the NLL of a RooAddPdf calculated in 1 to N processes (NumCPU), on 1 to
+//    N threads (NumThreads) and by blocks of events (BatchMode)
+//  - the fit of a RooAddPdf with these modes
+//  - HistFactory models of 10, 100 and 1000 channels: building the
+//    workspace, writing and reading it back, evaluating the NLL, also
+//    through the generated CompiledLikelihood, and fitting
+//
+// Usage: benchRooFit [-h] [-t mintime] [-e events] [-j maxcpu] [-c maxchannels]
+//                    [-r repetitions] [-o results.json] [filter]
+//
+// switches:
+//       -h            - print this usage
+//       -t mintime    - minimal time in seconds of each measurement (default 0.5)
+//       -e events     - number of events of the unbinned datasets (default 100000)
+//       -j maxcpu     - largest number of processes and threads of the
+//                       parallel benchmarks (default: number of cores)
+//       -c channels   - largest number of channels of the HistFactory models
+//                       (default 1000)
+//       -r repet      - number of measurements of each benchmark, the fastest
+//                       one is reported (default 3)
+//       -o file       - also write the results to file in JSON format, to be
+//                       compared across releases
+//
+// parameters:
+//       filter        - run only the benchmarks whose name contains filter
+//
+// Each benchmark is run with a number of operations (NLL evaluations, fits,
+// ...) scaled until one measurement takes at least mintime. The time per
+// operation and, for the NLL evaluations, the number of events per second
+// are printed.
+
+#include "RConfigure.h"
+#include "TFile.h"
+#include "TH1D.h"
+#include "TROOT.h"
+#include "TString.h"
+#include "TSystem.h"
+
+#include "RooAbsPdf.h"
+#include "RooAbsReal.h"
+#include "RooAddPdf.h"
+#include "RooArgList.h"
+#include "RooArgSet.h"
+#include "RooBreitWigner.h"
+#include "RooCBShape.h"
+#include "RooChebychev.h"
+#include "RooDataSet.h"
+#include "RooExponential.h"
+#include "RooGaussian.h"
+#include "RooGlobalFunc.h"
+#include "RooMsgService.h"
+#include "RooPolynomial.h"
+#include "RooProdPdf.h"
+#include "RooRandom.h"
+#include "RooRealVar.h"
+#include "RooVoigtian.h"
+#include "RooWorkspace.h"
+#include "RooStats/ModelConfig.h"
+#include "RooStats/HistFactory/Channel.h"
+#include "RooStats/HistFactory/CompiledLikelihood.h"
+#include "RooStats/HistFactory/HistoToWorkspaceFactoryFast.h"
+#include "RooStats/HistFactory/Measurement.h"
+#include "RooStats/HistFactory/Sample.h"
+
+#include "BenchHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace RooFit;
+
+namespace {
+
+using Bench::gSink;
+
+Int_t gEvents = 100000;
+Int_t gMaxChannels = 1000;
+
+const char *kWorkspaceFile = "benchRooFit.root";
+const Int_t kChannels[] = {10, 100, 1000};
+const Int_t kBinsPerChannel = 10;
+
+/// Evaluates the NLL n times, moving the parameter so that each evaluation is a real one
+Long64_t EvaluateNLL(RooAbsReal &nll, RooRealVar &par, Long64_t n, Long64_t nevents)
+{
+   const Double_t value = par.getVal();
+   const Double_t step = 1e-3 * (par.getMax() - par.getMin());
+   Double_t sum = 0;
+   for (Long64_t i = 0; i < n; ++i) {
+      par.setVal(value + (i % 2 ? step : -step));
+      sum += nll.getVal();
+   }
+   par.setVal(value);
+   gSink = gSink + sum;
+   return n * nevents;
+}
+
+void RunNLL(const std::string &name, RooAbsPdf &pdf, const RooArgSet &obs, RooRealVar &par)
+{
+   if (!Bench::Selected(name))
+      return;
+   std::unique_ptr<RooDataSet> data(pdf.generate(obs, gEvents));
+   std::unique_ptr<RooAbsReal> nll(pdf.createNLL(*data));
+   Bench::RunScaled(name, [&](Long64_t n) { return EvaluateNLL(*nll, par, n, gEvents); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Unbinned NLL of the standard p.d.f.s
+
+void RunStandardPdfs()
+{
+   RooRealVar x("x", "x", 0., 10.);
+   RooRealVar mean("mean", "mean", 5., 0., 10.);
+   RooRealVar sigma("sigma", "sigma", 1., 0.1, 5.);
+   RooRealVar tau("tau", "tau", -0.3, -5., 0.);
+   RooRealVar a1("a1", "a1", 0.1, -1., 1.);
+   RooRealVar a2("a2", "a2", 0.01, -1., 1.);
+   RooRealVar alpha("alpha", "alpha", 1.5, 0.1, 5.);
+   RooRealVar npow("npow", "npow", 2., 1., 10.);
+   RooRealVar width("width", "width", 1., 0.1, 5.);
+
+   RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+   RooExponential expo("expo", "expo", x, tau);
+   RooPolynomial poly("poly", "poly", x, RooArgList(a1, a2));
+   RooChebychev cheb("cheb", "cheb", x, RooArgList(a1, a2));
+   RooCBShape cb("cb", "cb", x, mean, sigma, alpha, npow);
+   RooBreitWigner bw("bw", "bw", x, mean, width);
+   RooVoigtian voigt("voigt", "voigt", x, mean, width, sigma);
+
+   RunNLL("NLL/RooGaussian", gauss, x, mean);
+   RunNLL("NLL/RooExponential", expo, x, tau);
+   RunNLL("NLL/RooPolynomial", poly, x, a1);
+   RunNLL("NLL/RooChebychev", cheb, x, a1);
+   RunNLL("NLL/RooCBShape", cb, x, mean);
+   RunNLL("NLL/RooBreitWigner", bw, x, mean);
+   RunNLL("NLL/RooVoigtian", voigt, x, mean);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Compositions, and the parallel and batch calculation modes
+
+void RunCompositions()
+{
+   RooRealVar x("x", "x", 0., 10.);
+   RooRealVar y("y", "y", 0., 10.);
+   RooRealVar mean("mean", "mean", 5., 0., 10.);
+   RooRealVar sigma("sigma", "sigma", 1., 0.1, 5.);
+   RooRealVar tau("tau", "tau", -0.3, -5., 0.);
+   RooRealVar meany("meany", "meany", 4., 0., 10.);
+   RooRealVar sigmay("sigmay", "sigmay", 2., 0.1, 5.);
+   RooRealVar tauy("tauy", "tauy", -0.2, -5., 0.);
+   RooRealVar frac("frac", "frac", 0.3, 0., 1.);
+
+   RooGaussian sigx("sigx", "sigx", x, mean, sigma);
+   RooExponential bkgx("bkgx", "bkgx", x, tau);
+   RooGaussian sigy("sigy", "sigy", y, meany, sigmay);
+   RooExponential bkgy("bkgy", "bkgy", y, tauy);
+   RooAddPdf add("add", "gauss + expo", RooArgList(sigx, bkgx), frac);
+   RooProdPdf prod("prod", "gauss(x) * gauss(y)", RooArgList(sigx, sigy));
+   RooProdPdf sig2d("sig2d", "sig2d", RooArgList(sigx, sigy));
+   RooProdPdf bkg2d("bkg2d", "bkg2d", RooArgList(bkgx, bkgy));
+   RooAddPdf add2d("add2d", "gauss(x) gauss(y) + expo(x) expo(y)", RooArgList(sig2d, bkg2d), frac);
+
+   RunNLL("NLL/RooAddPdf", add, x, mean);
+   RunNLL("NLL/RooProdPdf", prod, RooArgSet(x, y), mean);
+   RunNLL("NLL/RooAddPdf(RooProdPdf)", add2d, RooArgSet(x, y), mean);
+
+   std::unique_ptr<RooDataSet> data(add.generate(x, gEvents));
+   RooArgSet *params = add.getParameters(*data);
+   RooArgSet initial;
+   params->snapshot(initial);
+
+   struct TMode {
+      std::string fName;
+      RooCmdArg fArg;
+   };
+   std::vector<TMode> modes = {{"serial", RooCmdArg::none()}, {"BatchMode", BatchMode()}};
+   for (Int_t n : Bench::ThreadCounts())
+      modes.push_back({"NumCPU=" + std::to_string(n), NumCPU(n)});
+#ifdef R__USE_IMT
+   for (Int_t n : Bench::ThreadCounts())
+      modes.push_back({"NumThreads=" + std::to_string(n), NumThreads(n)});
+#endif
+
+   for (auto &mode : modes) {
+      std::string name = "NLL/RooAddPdf/" + mode.fName;
+      if (Bench::Selected(name)) {
+         std::unique_ptr<RooAbsReal> nll(add.createNLL(*data, mode.fArg));
+         Bench::RunScaled(name, [&](Long64_t n) { return EvaluateNLL(*nll, mean, n, gEvents); });
+      }
+      Bench::RunScaled("Fit/RooAddPdf/" + mode.fName, [&](Long64_t n) {
+         for (Long64_t i = 0; i < n; ++i) {
+            *params = initial;
+            add.fitTo(*data, mode.fArg, PrintLevel(-1), Verbose(kFALSE));
+         }
+         gSink = gSink + mean.getVal();
+         return 0;
+      });
+   }
+   delete params;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// HistFactory models
+
+/// A HistFactory measurement of nchannels channels of a signal and a background
+/// sample, with a signal strength and systematics shared by all the channels.
+RooWorkspace *MakeHistFactoryWorkspace(Int_t nchannels, std::vector<std::unique_ptr<TH1>> &histos)
+{
+   using namespace RooStats::HistFactory;
+   Measurement meas("meas", "benchRooFit");
+   meas.SetPOI("mu");
+   meas.SetLumi(1.0);
+   meas.SetLumiRelErr(0.02);
+   meas.SetExportOnly(true);
+   for (Int_t c = 0; c < nchannels; ++c) {
+      TString ch = TString::Format("ch%d", c);
+      auto sig = new TH1D(ch + "_sig", "signal", kBinsPerChannel, 0., 1.);
+      auto bkg = new TH1D(ch + "_bkg", "background", kBinsPerChannel, 0., 1.);
+      auto obs = new TH1D(ch + "_data", "data", kBinsPerChannel, 0., 1.);
+      for (Int_t b = 1; b <= kBinsPerChannel; ++b) {
+         sig->SetBinContent(b, 2. + 10. * b / kBinsPerChannel);
+         bkg->SetBinContent(b, 100. - 2. * b + c % 7);
+         obs->SetBinContent(b, sig->GetBinContent(b) + bkg->GetBinContent(b));
+      }
+      histos.emplace_back(sig);
+      histos.emplace_back(bkg);
+      histos.emplace_back(obs);
+
+      Channel channel(ch.Data());
+      channel.SetData(obs);
+      Sample signal("signal");
+      signal.SetHisto(sig);
+      signal.AddNormFactor("mu", 1., 0., 5.);
+      signal.AddOverallSys("sig_xsec", 0.9, 1.1);
+      Sample background("background");
+      background.SetHisto(bkg);
+      background.AddOverallSys("bkg_norm", 0.95, 1.05);
+      channel.AddSample(signal);
+      channel.AddSample(background);
+      meas.AddChannel(channel);
+   }
+   return HistoToWorkspaceFactoryFast::MakeCombinedModel(meas);
+}
+
+void RunHistFactory()
+{
+   const char *benchmarks[] = {"Build", "Write", "Read", "NLL", "NLL/CompiledLikelihood", "Fit"};
+   TH1::AddDirectory(kFALSE);
+   for (Int_t nchannels : kChannels) {
+      if (nchannels > gMaxChannels)
+         break;
+      std::string prefix = "HistFactory/" + std::to_string(nchannels) + "ch/";
+      Bool_t any = kFALSE;
+      for (auto bench : benchmarks)
+         any = any || Bench::Selected(prefix + bench);
+      if (!any)
+         continue;
+
+      std::vector<std::unique_ptr<TH1>> histos;
+      Bench::RunScaled(prefix + "Build", [&](Long64_t n) {
+         for (Long64_t i = 0; i < n; ++i) {
+            histos.clear();
+            delete MakeHistFactoryWorkspace(nchannels, histos);
+         }
+         return 0;
+      });
+      histos.clear();
+      std::unique_ptr<RooWorkspace> ws(MakeHistFactoryWorkspace(nchannels, histos));
+      Bench::RunScaled(prefix + "Write", [&](Long64_t n) {
+         for (Long64_t i = 0; i < n; ++i) {
+            TFile file(kWorkspaceFile, "RECREATE");
+            ws->Write();
+         }
+         return 0;
+      });
+      Bench::RunScaled(prefix + "Read", [&](Long64_t n) {
+         for (Long64_t i = 0; i < n; ++i) {
+            TFile file(kWorkspaceFile);
+            delete file.Get(ws->GetName());
+         }
+         return 0;
+      });
+      gSystem->Unlink(kWorkspaceFile);
+
+      auto mc = dynamic_cast<RooStats::ModelConfig *>(ws->obj("ModelConfig"));
+      RooAbsData *data = ws->data("obsData");
+      RooRealVar *mu = ws->var("mu");
+      if (!mc || !data || !mu) {
+         fprintf(stderr, "Error in <benchRooFit>: incomplete HistFactory workspace\n");
+         exit(1);
+      }
+      RooAbsPdf *pdf = mc->GetPdf();
+      const Long64_t nbins = Long64_t(nchannels) * kBinsPerChannel;
+      if (Bench::Selected(prefix + "NLL")) {
+         std::unique_ptr<RooAbsReal> nll(pdf->createNLL(*data, Constrain(*mc->GetNuisanceParameters()),
+                                                        GlobalObservables(*mc->GetGlobalObservables())));
+         Bench::RunScaled(prefix + "NLL", [&](Long64_t n) { return EvaluateNLL(*nll, *mu, n, nbins); });
+      }
+      if (Bench::Selected(prefix + "NLL/CompiledLikelihood")) {
+         RooStats::HistFactory::CompiledLikelihood nll("nll", "nll", *pdf, *data, mc->GetGlobalObservables());
+         if (nll.isValid())
+            Bench::RunScaled(prefix + "NLL/CompiledLikelihood",
+                             [&](Long64_t n) { return EvaluateNLL(nll, *mu, n, nbins); });
+      }
+      RooArgSet *params = pdf->getParameters(*data);
+      RooArgSet initial;
+      params->snapshot(initial);
+      Bench::RunScaled(prefix + "Fit", [&](Long64_t n) {
+         for (Long64_t i = 0; i < n; ++i) {
+            *params = initial;
+            pdf->fitTo(*data, Constrain(*mc->GetNuisanceParameters()), GlobalObservables(*mc->GetGlobalObservables()),
+                       PrintLevel(-1), Verbose(kFALSE));
+         }
+         gSink = gSink + mu->getVal();
+         return 0;
+      });
+      delete params;
+   }
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+   Bench::AddMinTimeOption(0.5);
+   Bench::AddOption("-e", "events", [](const char *arg) {
+      gEvents = atoi(arg);
+      if (gEvents < 1)
+         gEvents = 1;
+      return kTRUE;
+   });
+   Bench::AddThreadsOption("maxcpu");
+   Bench::AddOption("-c", "maxchannels", [](const char *arg) {
+      gMaxChannels = atoi(arg);
+      return kTRUE;
+   });
+   const Int_t status = Bench::ParseArguments(argc, argv, "benchRooFit");
+   if (status >= 0)
+      return status;
+   Bench::AddContext("events", std::to_string(gEvents));
+   Bench::gProcessed = Bench::EProcessed::kItems;
+   Bench::gItemName = "events";
+
+   gROOT->SetBatch();
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+   RooRandom::randomGenerator()->SetSeed(4357);
+   RunStandardPdfs();
+   RunCompositions();
+   RunHistFactory();
+
+   Bench::WriteJson();
+   return 0;
+}
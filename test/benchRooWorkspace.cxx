@@ -0,0 +1,107 @@
+// Benchmark of the writing and reading of a large RooWorkspace
+//
+// A synthetic simultaneous model with many channels is built, in the way of
+// a large HistFactory workspace: each channel has its own observable, shape
+// parameters and normalization, and all the channels share a luminosity and
+// a width parameter (which then have many clients). The workspace is written
+// to a file and read back, and the times are printed.
+//
+// Usage: benchRooWorkspace [number of channels, default 2000]
+
+#include "TFile.h"
+#include "TStopwatch.h"
+#include "TString.h"
+#include "TSystem.h"
+
+#include "RooGlobalFunc.h"
+#include "RooMsgService.h"
+#include "RooWorkspace.h"
+#include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooProduct.h"
+#include "RooAddPdf.h"
+#include "RooSimultaneous.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace RooFit;
+
+int main(int argc, char **argv)
+{
+   const int nChannels = argc > 1 ? atoi(argv[1]) : 2000;
+   const char *fileName = "benchRooWorkspace.root";
+
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+   TStopwatch w;
+   w.Start();
+
+   RooRealVar lumi("lumi", "luminosity", 1., 0.5, 1.5);
+   RooRealVar sigma("sigma", "width", 1., 0.1, 5.);
+   RooCategory channel("channel", "channel");
+   RooArgSet owned;
+   RooSimultaneous sim("sim", "simultaneous model", channel);
+
+   for (int i = 0; i < nChannels; ++i) {
+      channel.defineType(Form("ch%d", i), i);
+
+      RooRealVar *x = new RooRealVar(Form("x_%d", i), "x", 0., 10.);
+      RooRealVar *mean = new RooRealVar(Form("mean_%d", i), "mean", 5., 0., 10.);
+      RooRealVar *tau = new RooRealVar(Form("tau_%d", i), "tau", -0.5, -5., 0.);
+      RooRealVar *mu = new RooRealVar(Form("mu_%d", i), "signal strength", 100., 0., 1000.);
+      RooRealVar *nbkg = new RooRealVar(Form("nbkg_%d", i), "background yield", 1000., 0., 10000.);
+      RooGaussian *sig = new RooGaussian(Form("sig_%d", i), "signal", *x, *mean, sigma);
+      RooExponential *bkg = new RooExponential(Form("bkg_%d", i), "background", *x, *tau);
+      RooProduct *nsig = new RooProduct(Form("nsig_%d", i), "signal yield", RooArgList(lumi, *mu));
+      RooAddPdf *model =
+         new RooAddPdf(Form("model_%d", i), "model", RooArgList(*sig, *bkg), RooArgList(*nsig, *nbkg));
+      owned.addOwned(RooArgSet(*x, *mean, *tau, *mu, *nbkg, *sig, *bkg, *nsig, *model));
+
+      sim.addPdf(*model, Form("ch%d", i));
+   }
+
+   RooWorkspace ws("w", "benchmark workspace");
+   ws.import(sim, Silence());
+   w.Stop();
+   const int nNodes = ws.components().getSize();
+   std::cout << "benchRooWorkspace: " << nChannels << " channels, " << nNodes << " nodes" << std::endl;
+   std::cout << "  building and importing the model: " << w.RealTime() << " s" << std::endl;
+
+   w.Start();
+   {
+      TFile f(fileName, "RECREATE");
+      ws.Write();
+   }
+   w.Stop();
+   std::cout << "  writing the workspace:            " << w.RealTime() << " s" << std::endl;
+
+   w.Start();
+   RooWorkspace *ws2 = 0;
+   TFile f(fileName);
+   f.GetObject("w", ws2);
+   w.Stop();
+   std::cout << "  reading the workspace:            " << w.RealTime() << " s" << std::endl;
+
+   int ret = 0;
+   if (!ws2 || ws2->components().getSize() != nNodes || !ws2->pdf("sim") || !ws2->var("lumi")) {
+      std::cerr << "benchRooWorkspace: the workspace read back is different: FAILED" << std::endl;
+      ret = 1;
+   } else {
+      // all the channels of the read model have to use the same shared parameter
+      RooRealVar *lumi2 = ws2->var("lumi");
+      lumi2->setVal(1.2);
+      RooAbsReal *nsig = ws2->function(Form("nsig_%d", nChannels - 1));
+      if (!nsig || std::abs(nsig->getVal() - 120) > 1e-9) {
+         std::cerr << "benchRooWorkspace: the links of the workspace read back are wrong: FAILED" << std::endl;
+         ret = 1;
+      }
+   }
+
+   delete ws2;
+   gSystem->Unlink(fileName);
+   return ret;
+}
@@ -0,0 +1,295 @@
+// @(#)root/test:$Id$
+
+//
+// Benchmarks of the TDataFrame event loop, to catch regressions of the
+// per-entry overhead of the nodes, of the jitting and of the scaling with
+// the number of threads:
+//  - empty loops over entries without columns, over a TTrivialDS, over a
+//    TTree and over a TRootDS
+//  - chains of typed and jitted Filter and Define of varying depth
+//  - the jitting of the transformations alone
+//  - Histo1D filling, typed and jitted
+//  - Snapshot of two columns to a file
+//  - with implicit multi-threading, the same loop on 1 to N threads
+//
+// Usage: benchTDF [-h] [-n entries] [-j maxthreads] [-r repetitions] [-o results.json] [filter]
+//
+// switches:
+//       -h            - print this usage
+//       -n entries    - number of entries of each event loop (default 2000000)
+//       -j maxthreads - largest number of threads of the scaling benchmarks
+//                       (default: number of cores)
+//       -r repet      - number of measurements of each benchmark, the fastest
+//                       one is reported (default 3)
+//       -o file       - also write the results to file in JSON format, to be
+//                       compared across releases
+//
+// parameters:
+//       filter        - run only the benchmarks whose name contains filter
+//
+// Each measurement builds the computation graph and runs one event loop, so
+// that the jitting of the transformations is part of the jitted benchmarks.
+// The time per entry and the number of entries per second are printed.
+
+#include "RConfigure.h"
+#include "ROOT/TDataFrame.hxx"
+#include "ROOT/TRootDS.hxx"
+#include "ROOT/TTrivialDS.hxx"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "BenchHarness.h"
+
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace ROOT::Experimental;
+using namespace ROOT::Experimental::TDF;
+
+namespace {
+
+using Bench::gSink;
+
+ULong64_t gEntries = 2000000;
+
+const char *kTreeFile = "benchTDF.root";
+const char *kSnapshotFile = "benchTDF_snapshot.root";
+const Int_t kDepths[] = {1, 4, 16};
+// A value no entry number reaches, so that the filters pass all the entries without being folded away.
+const ULong64_t kNever = 1234567890123ULL;
+
+/// Builds the graph and runs an event loop over entries entries, the fastest of
+/// the repetitions being reported
+void Run(const std::string &name, ULong64_t entries, const std::function<void(ULong64_t)> &func)
+{
+   Bench::RunRepeated(name, [&]() {
+      func(entries);
+      return Long64_t(entries);
+   });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Inputs
+
+void WriteTree(ULong64_t entries)
+{
+   TFile file(kTreeFile, "RECREATE");
+   TTree tree("t", "benchTDF input");
+   Double_t x = 0;
+   Int_t i = 0;
+   tree.Branch("x", &x, "x/D");
+   tree.Branch("i", &i, "i/I");
+   for (ULong64_t e = 0; e < entries; ++e) {
+      x = 0.001 * (e % 100000);
+      i = e % 100;
+      tree.Fill();
+   }
+   tree.Write();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Empty loops: the overhead per entry of the event loop itself
+
+void RunEmptyLoops()
+{
+   Run("EmptyLoop/NoColumns", gEntries, [](ULong64_t n) {
+      TDataFrame df(n);
+      gSink = gSink + *df.Count();
+   });
+   Run("EmptyLoop/TTrivialDS", gEntries, [](ULong64_t n) {
+      auto df = MakeTrivialDataFrame(n);
+      gSink = gSink + *df.Count();
+   });
+   Run("EmptyLoop/TTree", gEntries, [](ULong64_t) {
+      TDataFrame df("t", kTreeFile);
+      gSink = gSink + *df.Count();
+   });
+   Run("EmptyLoop/TRootDS", gEntries, [](ULong64_t) {
+      auto df = MakeRootDataFrame("t", kTreeFile);
+      gSink = gSink + *df.Count();
+   });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Chains of filters and defines
+
+// TInterface cannot be assigned: the chains keep every node, each one built on the previous.
+using FilterChain_t = std::vector<TInterface<ROOT::Detail::TDF::TFilterBase>>;
+using DefineChain_t = std::vector<TInterface<ROOT::Detail::TDF::TLoopManager>>;
+
+std::string Column(Int_t d)
+{
+   return "x" + std::to_string(d);
+}
+
+void RunChains()
+{
+   for (Int_t depth : kDepths) {
+      Run("Filter/Typed/depth=" + std::to_string(depth), gEntries, [depth](ULong64_t n) {
+         auto df = MakeTrivialDataFrame(n);
+         FilterChain_t nodes;
+         nodes.reserve(depth);
+         nodes.push_back(df.Filter([](ULong64_t c) { return c != kNever; }, {"col0"}));
+         for (Int_t d = 1; d < depth; ++d)
+            nodes.push_back(nodes.back().Filter([](ULong64_t c) { return c != kNever; }, {"col0"}));
+         gSink = gSink + *nodes.back().Count();
+      });
+      Run("Filter/Jitted/depth=" + std::to_string(depth), gEntries, [depth](ULong64_t n) {
+         auto df = MakeTrivialDataFrame(n);
+         std::string expr = "col0 != " + std::to_string(kNever) + "ULL";
+         FilterChain_t nodes;
+         nodes.reserve(depth);
+         nodes.push_back(df.Filter(expr));
+         for (Int_t d = 1; d < depth; ++d)
+            nodes.push_back(nodes.back().Filter(expr));
+         gSink = gSink + *nodes.back().Count();
+      });
+      Run("Define/Typed/depth=" + std::to_string(depth), gEntries, [depth](ULong64_t n) {
+         auto df = MakeTrivialDataFrame(n);
+         DefineChain_t nodes;
+         nodes.reserve(depth);
+         nodes.push_back(df.Define("x0", [](ULong64_t c) { return double(c); }, {"col0"}));
+         for (Int_t d = 1; d < depth; ++d)
+            nodes.push_back(nodes.back().Define(Column(d), [](double x) { return x + 1.; }, {Column(d - 1)}));
+         gSink = gSink + *nodes.back().Sum<double>(Column(depth - 1));
+      });
+      Run("Define/Jitted/depth=" + std::to_string(depth), gEntries, [depth](ULong64_t n) {
+         auto df = MakeTrivialDataFrame(n);
+         DefineChain_t nodes;
+         nodes.reserve(depth);
+         nodes.push_back(df.Define("x0", "double(col0)"));
+         for (Int_t d = 1; d < depth; ++d)
+            nodes.push_back(nodes.back().Define(Column(d), Column(d - 1) + " + 1."));
+         gSink = gSink + *nodes.back().Sum<double>(Column(depth - 1));
+      });
+   }
+
+   // The same chains over a single entry: the time is spent building and jitting the graph.
+   Run("Jit/Filter/depth=16", 1, [](ULong64_t n) {
+      TDataFrame df(n);
+      std::string expr = "tdfentry_ != " + std::to_string(kNever) + "ULL";
+      FilterChain_t nodes;
+      nodes.reserve(16);
+      nodes.push_back(df.Filter(expr));
+      for (Int_t d = 1; d < 16; ++d)
+         nodes.push_back(nodes.back().Filter(expr));
+      gSink = gSink + *nodes.back().Count();
+   });
+   Run("Jit/Define/depth=16", 1, [](ULong64_t n) {
+      TDataFrame df(n);
+      DefineChain_t nodes;
+      nodes.reserve(16);
+      nodes.push_back(df.Define("x0", "double(tdfentry_)"));
+      for (Int_t d = 1; d < 16; ++d)
+         nodes.push_back(nodes.back().Define(Column(d), Column(d - 1) + " + 1."));
+      gSink = gSink + *nodes.back().Sum<double>("x15");
+   });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Actions
+
+void RunActions()
+{
+   const TH1DModel model("h", "h", 100, 0., 100.);
+   Run("Histo1D/Typed/TTrivialDS", gEntries, [&](ULong64_t n) {
+      auto df = MakeTrivialDataFrame(n);
+      auto h = df.Define("x", [](ULong64_t c) { return double(c % 100); }, {"col0"}).Histo1D<double>(model, "x");
+      gSink = gSink + h->GetMean();
+   });
+   Run("Histo1D/Jitted/TTrivialDS", gEntries, [&](ULong64_t n) {
+      auto df = MakeTrivialDataFrame(n);
+      auto h = df.Define("x", [](ULong64_t c) { return double(c % 100); }, {"col0"}).Histo1D(model, "x");
+      gSink = gSink + h->GetMean();
+   });
+   Run("Histo1D/Typed/TTree", gEntries, [&](ULong64_t) {
+      TDataFrame df("t", kTreeFile);
+      auto h = df.Histo1D<Int_t>(model, "i");
+      gSink = gSink + h->GetMean();
+   });
+   Run("Histo1D/Typed/TRootDS", gEntries, [&](ULong64_t) {
+      auto df = MakeRootDataFrame("t", kTreeFile);
+      auto h = df.Histo1D<Int_t>(model, "i");
+      gSink = gSink + h->GetMean();
+   });
+   Run("Snapshot/Typed/2 columns", gEntries, [](ULong64_t n) {
+      TDataFrame df(n);
+      df.Define("x", [](ULong64_t e) { return 0.001 * (e % 100000); }, {"tdfentry_"})
+         .Define("i", [](ULong64_t e) { return Int_t(e % 100); }, {"tdfentry_"})
+         .Snapshot<double, Int_t>("t", kSnapshotFile, {"x", "i"});
+   });
+   gSystem->Unlink(kSnapshotFile);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Scaling with the number of threads
+
+#ifdef R__USE_IMT
+void RunScaling()
+{
+   const TH1DModel model("h", "h", 100, 0., 100.);
+   for (UInt_t n : Bench::ThreadCounts()) {
+      std::string suffix = "/threads=" + std::to_string(n);
+      if (!Bench::Selected("MT/TTrivialDS" + suffix) && !Bench::Selected("MT/TTree" + suffix) &&
+          !Bench::Selected("MT/TRootDS" + suffix))
+         continue;
+      ROOT::EnableImplicitMT(n);
+      Bench::gThreads = n;
+      Run("MT/TTrivialDS" + suffix, gEntries, [&](ULong64_t entries) {
+         auto df = MakeTrivialDataFrame(entries);
+         auto h = df.Filter([](ULong64_t c) { return c != kNever; }, {"col0"})
+                     .Define("x", [](ULong64_t c) { return double(c % 100); }, {"col0"})
+                     .Histo1D<double>(model, "x");
+         gSink = gSink + h->GetMean();
+      });
+      Run("MT/TTree" + suffix, gEntries, [&](ULong64_t) {
+         TDataFrame df("t", kTreeFile);
+         auto h = df.Filter([](Int_t i) { return i != 100; }, {"i"}).Histo1D<double>(model, "x");
+         gSink = gSink + h->GetMean();
+      });
+      Run("MT/TRootDS" + suffix, gEntries, [&](ULong64_t) {
+         auto df = MakeRootDataFrame("t", kTreeFile);
+         auto h = df.Filter([](Int_t i) { return i != 100; }, {"i"}).Histo1D<double>(model, "x");
+         gSink = gSink + h->GetMean();
+      });
+      ROOT::DisableImplicitMT();
+      Bench::gThreads = 0;
+   }
+}
+#endif
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+   Bench::AddOption("-n", "entries", [](const char *arg) {
+      gEntries = strtoull(arg, nullptr, 10);
+      if (gEntries < 1)
+         gEntries = 1;
+      return kTRUE;
+   });
+   Bench::AddThreadsOption();
+   const Int_t status = Bench::ParseArguments(argc, argv, "benchTDF");
+   if (status >= 0)
+      return status;
+   Bench::AddContext("entries", std::to_string(gEntries));
+   Bench::gThreads = 0;
+   Bench::gItemName = "entries";
+
+   gROOT->SetBatch();
+   WriteTree(gEntries);
+   RunEmptyLoops();
+   RunChains();
+   RunActions();
+#ifdef R__USE_IMT
+   RunScaling();
+#endif
+   gSystem->Unlink(kTreeFile);
+
+   Bench::WriteJson();
+   return 0;
+}
@@ -0,0 +1,532 @@
+// @(#)root/test:$Id$
+
+//
+// Scaling of the multi-threaded writing of trees, to find where the writing
+// saturates and which serial part limits it:
+//  - fill:     TTree::Fill into one file, the baskets of a cluster being
+//              compressed in parallel by the IMT flushing
+//  - async:    the same with TTree::SetIMTAsyncFlush, the flushes overlapping
+//              with the next fills
+//  - merger:   one tree per thread, merged into one file by TBufferMerger
+//  - snapshot: TDataFrame::Snapshot of columns defined from the entry number
+//
+// Every writer is measured for each number of branches of doubles, basket
+// size and compression algorithm, with 1 to N threads. The throughput in MB/s
+// of uncompressed data and the CPU efficiency, the CPU time of the process
+// divided by the real time and the number of threads, are printed for each
+// measurement. A summary per configuration follows: the best throughput, the
+// number of threads where adding threads stops paying off, the serial
+// fraction estimated from the speedup (Karp-Flatt metric) and the serial part
+// which is the likely bottleneck.
+//
+// Usage: benchWrite [-h] [-m megabytes] [-j maxthreads] [-w writers] [-b branches]
+//                   [-s basketsizes] [-c compressions] [-r repetitions] [-o results.json] [filter]
+//
+// switches:
+//       -h              - print this usage
+//       -m megabytes    - uncompressed size of the data written by each
+//                         measurement (default 200)
+//       -j maxthreads   - largest number of threads (default: number of cores)
+//       -w writers      - comma separated list among fill, async, merger and
+//                         snapshot (default all)
+//       -b branches     - comma separated numbers of branches (default 4,64)
+//       -s basketsizes  - comma separated basket sizes in bytes (default
+//                         32000,256000); Snapshot always uses the default one
+//       -c compressions - comma separated list of algorithm:level among zlib,
+//                         lzma, lz4 and zstd, or none (default
+//                         none,zlib:1,lz4:4,lzma:1)
+//       -r repet        - number of measurements of each benchmark, the fastest
+//                         one is reported (default 2)
+//       -o file         - also write the results to file in JSON format, to be
+//                         compared across releases
+//
+// parameters:
+//       filter          - run only the benchmarks whose name contains filter
+//
+// With one thread the implicit multi-threading is disabled, so that the
+// speedups are relative to the sequential writing. The serial part of the
+// fill and async writers is estimated by comparison with the same writing
+// without compression, which only leaves the work done in the filling
+// thread; TTreePerfStats::Print("write") details it branch by branch.
+
+#include "Compression.h"
+#include "RConfigure.h"
+#include "ROOT/TBufferMerger.hxx"
+#include "ROOT/TDataFrame.hxx"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TString.h"
+#include "TTree.h"
+
+#include "BenchHarness.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace ROOT::Experimental;
+using namespace ROOT::Experimental::TDF;
+
+namespace {
+
+struct Config {
+   std::string fWriter;     ///< fill, async, merger or snapshot
+   Int_t fBranches;         ///< Number of branches of doubles
+   Int_t fBasketSize;       ///< Basket size of the branches, 0 for the default one
+   Int_t fCompress;         ///< Compression settings of the file
+   std::string fCompressName;
+
+   std::string GetName() const
+   {
+      std::string basket = fBasketSize ? std::to_string(fBasketSize) : "default";
+      return fWriter + "/branches=" + std::to_string(fBranches) + "/basket=" + basket + "/" + fCompressName;
+   }
+};
+
+/// What the writers report, besides their duration
+struct WriteStats {
+   Long64_t fFileBytes = 0; ///< Size of the output file
+   size_t fPeakQueue = 0;   ///< Largest number of buffers waiting in the TBufferMerger queue
+};
+
+/// Writes the entries with n threads
+using BenchFunc_t = std::function<WriteStats(const Config &, ULong64_t, UInt_t)>;
+
+/// What the summary needs of a measurement
+struct Measurement {
+   std::string fConfig;   ///< Name of the configuration, without the number of threads
+   Config fSetup;         ///< Configuration
+   UInt_t fThreads;       ///< Number of threads
+   ULong64_t fEntries;    ///< Number of entries written
+   Long64_t fBytes;       ///< Uncompressed bytes written
+   Double_t fSeconds;     ///< Real time of the fastest measurement
+   Double_t fCpuSeconds;  ///< CPU time of the process during the fastest measurement
+   WriteStats fStats;     ///< Statistics of the fastest measurement
+};
+
+Double_t gMegabytes = 200;
+std::vector<Measurement> gMeasurements;
+
+const char *kOutputFile = "benchWrite.root";
+// Uncompressed size filled in a TBufferMergerFile between two merges.
+const Long64_t kMergeBytes = 4000000;
+// Below this serial fraction, the writing is considered to scale.
+const Double_t kScaling = 0.1;
+
+Double_t CpuTime()
+{
+   ProcInfo_t info;
+   gSystem->GetProcInfo(&info);
+   return info.fCpuUser + info.fCpuSys;
+}
+
+Long64_t FileSize(const char *name)
+{
+   FileStat_t st;
+   if (gSystem->GetPathInfo(name, st))
+      return 0;
+   return st.fSize;
+}
+
+void Run(const Config &config, UInt_t nthreads, const BenchFunc_t &func)
+{
+   const std::string name = config.GetName() + "/threads=" + std::to_string(nthreads);
+   if (!Bench::Selected(name))
+      return;
+
+   ULong64_t entries = gMegabytes * 1e6 / (sizeof(Double_t) * config.fBranches);
+   if (entries < 1)
+      entries = 1;
+   const Long64_t bytes = entries * sizeof(Double_t) * config.fBranches;
+   Measurement res = {config.GetName(), config, nthreads, entries, bytes, 0, 0, WriteStats()};
+   for (Int_t r = 0; r < Bench::gRepetitions; ++r) {
+      const Double_t cpu = CpuTime();
+      auto start = std::chrono::steady_clock::now();
+      WriteStats stats = func(config, entries, nthreads);
+      std::chrono::duration<Double_t> elapsed = std::chrono::steady_clock::now() - start;
+      if (r == 0 || elapsed.count() < res.fSeconds) {
+         res.fSeconds = elapsed.count();
+         res.fCpuSeconds = CpuTime() - cpu;
+         res.fStats = stats;
+      }
+   }
+   gSystem->Unlink(kOutputFile);
+
+   gMeasurements.push_back(res);
+   const Double_t efficiency = res.fCpuSeconds / (res.fSeconds * nthreads);
+   const std::string json = TString::Format(", \"cpu_time\": %.6g, \"cpu_efficiency\": %.4g, \"file_bytes\": %lld",
+                                            res.fCpuSeconds, efficiency, res.fStats.fFileBytes).Data();
+   const TString text =
+      TString::Format("  cpu efficiency %5.2f  file %8.1f MB", efficiency, res.fStats.fFileBytes / 1e6);
+   Bench::Report({name, Long64_t(entries), res.fSeconds, Long64_t(entries), bytes, Int_t(nthreads), json},
+                 text.Data());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Writers
+
+// Values with 16 random bits, which compress moderately, as the measurements
+// of a detector.
+inline Double_t Value(ULong64_t entry, Int_t branch)
+{
+   ULong64_t h = (entry * 0x9E3779B97F4A7C15ULL) ^ (branch * 0xC2B2AE3D27D4EB4FULL);
+   h ^= h >> 29;
+   return (h & 0xffff) * 0.01;
+}
+
+void MakeBranches(TTree &tree, std::vector<Double_t> &values, Int_t basketsize)
+{
+   for (std::size_t b = 0; b < values.size(); ++b) {
+      std::string name = "x" + std::to_string(b);
+      tree.Branch(name.c_str(), &values[b], (name + "/D").c_str(), basketsize);
+   }
+}
+
+WriteStats WriteFill(const Config &config, ULong64_t entries, Bool_t async)
+{
+   {
+      TFile file(kOutputFile, "RECREATE", "", config.fCompress);
+      TTree tree("t", "benchWrite");
+      std::vector<Double_t> values(config.fBranches);
+      MakeBranches(tree, values, config.fBasketSize);
+#ifdef R__USE_IMT
+      if (async)
+         tree.SetIMTAsyncFlush();
+#else
+      (void)async;
+#endif
+      for (ULong64_t e = 0; e < entries; ++e) {
+         for (Int_t b = 0; b < config.fBranches; ++b)
+            values[b] = Value(e, b);
+         tree.Fill();
+      }
+      tree.Write();
+   }
+   WriteStats stats;
+   stats.fFileBytes = FileSize(kOutputFile);
+   return stats;
+}
+
+WriteStats WriteMerger(const Config &config, ULong64_t entries, UInt_t nthreads)
+{
+   WriteStats stats;
+   {
+      TBufferMerger merger(kOutputFile, "RECREATE", config.fCompress);
+      const ULong64_t perWrite = std::max<Long64_t>(1, kMergeBytes / (sizeof(Double_t) * config.fBranches));
+      std::vector<std::thread> threads;
+      for (UInt_t i = 0; i < nthreads; ++i) {
+         const ULong64_t first = entries * i / nthreads;
+         const ULong64_t last = entries * (i + 1) / nthreads;
+         threads.emplace_back([&, first, last]() {
+            auto file = merger.GetFile();
+            auto tree = new TTree("t", "benchWrite");
+            tree->ResetBit(kMustCleanup);
+            std::vector<Double_t> values(config.fBranches);
+            MakeBranches(*tree, values, config.fBasketSize);
+            for (ULong64_t e = first; e < last; ++e) {
+               for (Int_t b = 0; b < config.fBranches; ++b)
+                  values[b] = Value(e, b);
+               tree->Fill();
+               if ((e - first + 1) % perWrite == 0)
+                  file->Write();
+            }
+            file->Write();
+            tree->ResetBranchAddresses();
+         });
+      }
+      for (auto &t : threads)
+         t.join();
+      stats.fPeakQueue = merger.GetPeakQueueSize();
+   }
+   stats.fFileBytes = FileSize(kOutputFile);
+   return stats;
+}
+
+// TInterface cannot be assigned: the chain keeps every node, each one built on the previous.
+using DefineChain_t = std::vector<TInterface<ROOT::Detail::TDF::TLoopManager>>;
+
+WriteStats WriteSnapshot(const Config &config, ULong64_t entries)
+{
+   {
+      TDataFrame df(entries);
+      DefineChain_t nodes;
+      nodes.reserve(config.fBranches);
+      std::vector<std::string> columns;
+      for (Int_t b = 0; b < config.fBranches; ++b) {
+         columns.push_back("x" + std::to_string(b));
+         auto value = [b](ULong64_t e) { return Value(e, b); };
+         if (b == 0)
+            nodes.push_back(df.Define(columns.back(), value, {"tdfentry_"}));
+         else
+            nodes.push_back(nodes.back().Define(columns.back(), value, {"tdfentry_"}));
+      }
+      TSnapshotOptions options;
+      options.fCompressionAlgorithm = ROOT::ECompressionAlgorithm(config.fCompress / 100);
+      options.fCompressionLevel = config.fCompress % 100;
+      nodes.back().Snapshot("t", kOutputFile, columns, options);
+   }
+   WriteStats stats;
+   stats.fFileBytes = FileSize(kOutputFile);
+   return stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Measurements
+
+void SetThreads(UInt_t n)
+{
+#ifdef R__USE_IMT
+   if (n > 1)
+      ROOT::EnableImplicitMT(n);
+   else
+      ROOT::DisableImplicitMT();
+#else
+   (void)n;
+#endif
+}
+
+void RunWriter(const Config &config)
+{
+   for (UInt_t n : Bench::ThreadCounts()) {
+      if (config.fWriter == "merger") {
+         // Threads of its own, without implicit multi-threading.
+         Run(config, n, [](const Config &c, ULong64_t entries, UInt_t nthreads) {
+            return WriteMerger(c, entries, nthreads);
+         });
+         continue;
+      }
+#ifndef R__USE_IMT
+      if (n > 1)
+         break;
+#endif
+      SetThreads(n);
+      if (config.fWriter == "snapshot") {
+         Run(config, n, [](const Config &c, ULong64_t entries, UInt_t) { return WriteSnapshot(c, entries); });
+      } else {
+         const Bool_t async = config.fWriter == "async";
+         Run(config, n, [async](const Config &c, ULong64_t entries, UInt_t) { return WriteFill(c, entries, async); });
+      }
+      SetThreads(1);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Summary
+
+const Measurement *FindResult(const std::string &config, UInt_t nthreads)
+{
+   for (auto &res : gMeasurements) {
+      if (res.fConfig == config && res.fThreads == nthreads)
+         return &res;
+   }
+   return nullptr;
+}
+
+std::string Bottleneck(const std::vector<const Measurement *> &runs, Double_t serial)
+{
+   const Measurement &first = *runs.front();
+   const Measurement &last = *runs.back();
+   const Config &config = first.fSetup;
+   char text[256];
+
+   if (config.fWriter == "merger") {
+      if (last.fStats.fPeakQueue >= last.fThreads) {
+         snprintf(text, sizeof(text),
+                  "the output thread of TBufferMerger, %zu buffers were waiting to be merged with %u threads",
+                  last.fStats.fPeakQueue, last.fThreads);
+         return text;
+      }
+      if (serial < kScaling)
+         return "none, the writers scale";
+      return "shared resources (memory bandwidth, allocations, storage), the output thread kept up";
+   }
+   if (config.fWriter == "snapshot") {
+      if (serial < kScaling)
+         return "none, the event loop and the writing scale";
+      return "the serial parts of Snapshot: the jitting of the call and the output thread of TBufferMerger";
+   }
+
+   // fill and async: only the compression is done by the IMT tasks.
+   if (config.fCompress % 100 == 0)
+      return "the filling thread: without compression, the flushes have nothing to do in parallel";
+   Config uncompressed = config;
+   uncompressed.fCompress = 0;
+   uncompressed.fCompressName = "none";
+   const Measurement *reference = FindResult(uncompressed.GetName(), 1);
+   if (serial < kScaling)
+      return "none, the compression of the baskets scales";
+   if (!reference) {
+      return "the filling thread (serialization and basket writes); add the compression none for its share";
+   }
+   const Double_t share = std::min(1., reference->fSeconds / first.fSeconds);
+   snprintf(text, sizeof(text),
+            "the filling thread: serialization and basket writes are %.0f%% of the sequential time, "
+            "at most %.1fx faster",
+            100 * share, 1 / share);
+   return text;
+}
+
+void PrintSummary()
+{
+   std::vector<std::string> configs;
+   for (auto &res : gMeasurements) {
+      if (std::find(configs.begin(), configs.end(), res.fConfig) == configs.end())
+         configs.push_back(res.fConfig);
+   }
+   if (configs.empty())
+      return;
+
+   printf("\nSummary, throughput of uncompressed data:\n");
+   for (auto &config : configs) {
+      std::vector<const Measurement *> runs;
+      for (UInt_t n : Bench::ThreadCounts()) {
+         if (auto res = FindResult(config, n))
+            runs.push_back(res);
+      }
+      if (runs.empty() || runs.front()->fThreads != 1)
+         continue;
+
+      const Measurement *best = runs.front();
+      for (auto res : runs) {
+         if (res->fSeconds < best->fSeconds)
+            best = res;
+      }
+      printf("%s\n", config.c_str());
+      printf("   best %.1f MB/s with %u threads", best->fBytes / best->fSeconds / 1e6, best->fThreads);
+      if (runs.size() < 2) {
+         printf("\n");
+         continue;
+      }
+
+      // Adding threads stops paying off when doubling them brings less than 10%.
+      UInt_t saturation = 0;
+      for (std::size_t i = 0; i + 1 < runs.size(); ++i) {
+         if (runs[i]->fSeconds / runs[i + 1]->fSeconds < 1.1) {
+            saturation = runs[i]->fThreads;
+            break;
+         }
+      }
+      const Measurement &last = *runs.back();
+      const Double_t speedup = runs.front()->fSeconds / last.fSeconds;
+      const Double_t n = last.fThreads;
+      const Double_t serial = (1 / speedup - 1 / n) / (1 - 1 / n);
+      if (saturation)
+         printf(", saturates at %u threads", saturation);
+      else
+         printf(", does not saturate up to %u threads", last.fThreads);
+      printf("\n   speedup %.2f and cpu efficiency %.2f with %u threads, serial fraction %.2f\n", speedup,
+             last.fCpuSeconds / (last.fSeconds * n), last.fThreads, serial);
+      printf("   bottleneck: %s\n", Bottleneck(runs, serial).c_str());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Options
+
+std::vector<std::string> Split(const std::string &list)
+{
+   std::vector<std::string> items;
+   for (std::size_t pos = 0; pos <= list.size();) {
+      std::size_t comma = list.find(',', pos);
+      if (comma == std::string::npos)
+         comma = list.size();
+      if (comma > pos)
+         items.push_back(list.substr(pos, comma - pos));
+      pos = comma + 1;
+   }
+   return items;
+}
+
+// Returns the compression settings of "algorithm:level", -1 if invalid.
+Int_t ParseCompression(const std::string &text)
+{
+   if (text == "none")
+      return 0;
+   const std::size_t colon = text.find(':');
+   const std::string algorithm = text.substr(0, colon);
+   const Int_t level = colon == std::string::npos ? 1 : atoi(text.c_str() + colon + 1);
+   if (level < 0 || level > 99)
+      return -1;
+   static const std::map<std::string, ROOT::ECompressionAlgorithm> algorithms = {
+      {"zlib", ROOT::kZLIB}, {"lzma", ROOT::kLZMA}, {"lz4", ROOT::kLZ4}, {"zstd", ROOT::kZSTD}};
+   auto it = algorithms.find(algorithm);
+   if (it == algorithms.end())
+      return -1;
+   return ROOT::CompressionSettings(it->second, level);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+   std::string writers = "fill,async,merger,snapshot";
+   std::string branches = "4,64";
+   std::string basketsizes = "32000,256000";
+   std::string compressions = "none,zlib:1,lz4:4,lzma:1";
+   Bench::gRepetitions = 2;
+   Bench::AddOption("-m", "megabytes", [](const char *arg) {
+      gMegabytes = atof(arg);
+      if (gMegabytes <= 0)
+         gMegabytes = 1;
+      return kTRUE;
+   });
+   Bench::AddThreadsOption();
+   Bench::AddOption("-w", "writers", [&writers](const char *arg) {
+      writers = arg;
+      return kTRUE;
+   });
+   Bench::AddOption("-b", "branches", [&branches](const char *arg) {
+      branches = arg;
+      return kTRUE;
+   });
+   Bench::AddOption("-s", "basketsizes", [&basketsizes](const char *arg) {
+      basketsizes = arg;
+      return kTRUE;
+   });
+   Bench::AddOption("-c", "compressions", [&compressions](const char *arg) {
+      compressions = arg;
+      return kTRUE;
+   });
+   const Int_t status = Bench::ParseArguments(argc, argv, "benchWrite");
+   if (status >= 0)
+      return status;
+   Bench::AddContext("megabytes", TString::Format("%g", gMegabytes).Data());
+   Bench::gItemName = "entries";
+
+   std::vector<Config> configs;
+   for (auto &writer : Split(writers)) {
+      if (writer != "fill" && writer != "async" && writer != "merger" && writer != "snapshot") {
+         fprintf(stderr, "Error in <benchWrite>: unknown writer %s\n", writer.c_str());
+         return 1;
+      }
+      for (auto &b : Split(branches)) {
+         // Snapshot has no basket size option.
+         std::vector<std::string> sizes = writer == "snapshot" ? std::vector<std::string>{"0"} : Split(basketsizes);
+         for (auto &s : sizes) {
+            for (auto &c : Split(compressions)) {
+               const Int_t compress = ParseCompression(c);
+               if (compress < 0) {
+                  fprintf(stderr, "Error in <benchWrite>: unknown compression %s\n", c.c_str());
+                  return 1;
+               }
+               configs.push_back({writer, std::max(1, atoi(b.c_str())), atoi(s.c_str()), compress, c});
+            }
+         }
+      }
+   }
+
+   gROOT->SetBatch();
+   ROOT::EnableThreadSafety();
+   for (auto &config : configs)
+      RunWriter(config);
+   PrintSummary();
+
+   Bench::WriteJson();
+   return 0;
+}
@@ -32,6 +32,10 @@
 // root > stressGeometry(exp_name); // where exp_name is the geometry file name without .root
 // OR simply: stressGeometry(); to run tests for a set of geometries
 //
+// The time spent in ReadRef can be compared with and without the BVH of the
+// voxel finder: stressGeometry <geom> nobvh disables it, stressGeometry <geom> bvh
+// uses it for all the volumes with several daughters.
+//
 // Authors: Rene Brun, Andrei Gheata, 22 march 2005
 
 #include "TStopwatch.h"
@@ -52,6 +56,7 @@
 #include "TMath.h"
 #include "TSystem.h"
 #include "TVirtualGeoConverter.h"
+#include "TGeoVoxelFinder.h"
 
 // Total and reference times
 Double_t tpstot = 0;
@@ -74,6 +79,8 @@ int main(int argc, char **argv)
    if (argc > 1) {
        for (Int_t iarg=1; iarg<argc; ++iarg) {
           if (!strcmp(argv[iarg], "vecgeom")) vecgeom = kTRUE;
+          if (!strcmp(argv[iarg], "nobvh")) TGeoVoxelFinder::SetBVHLimits(-1);
+          if (!strcmp(argv[iarg], "bvh")) TGeoVoxelFinder::SetBVHLimits(2, 0.);
        }
    }
    stressGeometry(geom,kFALSE,vecgeom);
@@ -0,0 +1,100 @@
+// @(#)root/tmva $Id$
+
+/*************************************************************************
+ * Copyright (C) 2018, Rene Brun and Fons Rademakers.                    *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMVA_BinnedEventSample
+#define ROOT_TMVA_BinnedEventSample
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// BinnedEventSample                                                    //
+//                                                                      //
+// Input variables of the training events of a forest, replaced once    //
+// by the index of their bin, for the histogram based growing of the    //
+// decision trees                                                       //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+#include <vector>
+
+namespace TMVA {
+
+   class Event;
+
+   class BinnedEventSample {
+
+   public:
+
+      // content of one bin of the histogram of a variable in a tree node
+      struct Bin {
+         Double_t fSigW;     // sum of the weights of the signal events
+         Double_t fBkgW;     // sum of the weights of the background events
+         Double_t fSigN;     // number of signal events
+         Double_t fBkgN;     // number of background events
+         Double_t fTarget;   // sum of weight*target (regression)
+         Double_t fTarget2;  // sum of weight*target^2 (regression)
+      };
+
+      // the histograms of all variables of a node, one after the other
+      typedef std::vector<Bin> Histogram;
+
+      // the events of the sample given to one tree, with the quantities
+      // needed to fill the histograms
+      struct Events {
+         Events( const std::vector<const TMVA::Event*>& eventSample, const std::vector<UInt_t>& rows,
+                 UInt_t sigClass, Bool_t regression );
+
+         std::vector<UInt_t>   fRows;     // index of the event in the binned sample
+         std::vector<Char_t>   fIsSignal; // is the event of the signal class?
+         std::vector<Double_t> fWeights;  // (boosted) weight of the event
+         std::vector<Float_t>  fTargets;  // first target, empty for classification
+      };
+
+      // bin the events with at most nBins bins per variable, whose edges are
+      // quantiles of the distributions of the variables
+      BinnedEventSample( const std::vector<const TMVA::Event*>& eventSample, UInt_t nVars, UInt_t nBins );
+
+      UInt_t GetNEvents() const { return fNEvents; }
+      UInt_t GetNVars() const { return fNVars; }
+      UInt_t GetNBins( UInt_t ivar ) const { return fOffsets[ivar+1] - fOffsets[ivar]; }
+      UInt_t GetOffset( UInt_t ivar ) const { return fOffsets[ivar]; }
+      UInt_t GetTotalNBins() const { return fOffsets[fNVars]; }
+
+      // the bins of the variable ivar of all events
+      const UShort_t* GetColumn( UInt_t ivar ) const { return &fBins[size_t(ivar)*fNEvents]; }
+
+      // the events in the bins above ibin have values >= GetCutValue(ivar, ibin)
+      Float_t GetCutValue( UInt_t ivar, UInt_t ibin ) const { return fEdges[fOffsets[ivar] - ivar + ibin]; }
+      Float_t GetLowEdge( UInt_t ivar, UInt_t ibin ) const;
+
+      // histograms of the events index[0..n-1], filled in parallel over the
+      // variables and the events when ROOT is built with imt
+      void FillHistogram( const Events& events, const UInt_t* index, UInt_t n, Histogram& hist ) const;
+
+      // hist -= other, giving the histogram of the sibling node from the one of its parent
+      static void Subtract( Histogram& hist, const Histogram& other );
+
+   private:
+
+      void FillHistogram( const Events& events, const UInt_t* index, UInt_t begin, UInt_t end,
+                          UInt_t ivar, Bin* hist ) const;
+
+      UInt_t fNEvents;               // number of binned events
+      UInt_t fNVars;                 // number of variables
+      std::vector<UInt_t> fOffsets;  // first bin of each variable in a histogram, and total number of bins
+      std::vector<Float_t> fEdges;   // lower edges of the bins of each variable, except of the first one
+      std::vector<Float_t> fMin;     // minimum of each variable
+      std::vector<UShort_t> fBins;   // bin of each event, one column per variable
+   };
+
+} // namespace TMVA
+
+#endif
@@ -13,6 +13,7 @@
 #define ROOT_TMVA_CROSS_EVALUATION
 
 #include "TString.h"
+#include "TGraph.h"
 #include "TMultiGraph.h"
 
 #include "TMVA/IMethod.h"
@@ -90,6 +91,32 @@ public:
    std::vector<Double_t> GetTrainEff30Values() { return fTrainEff30s; }
    };
 
+// Used internally to transfer the statistics of a single fold from the
+// worker that processed it (Jobs > 1) to the CrossValidationResult.
+class CrossValidationFoldResult : public TObject {
+   friend class CrossValidation;
+
+private:
+   UInt_t fFold;
+   Float_t fROCIntegral;
+   TGraph fROCCurve;
+
+   Double_t fSig;
+   Double_t fSep;
+   Double_t fEff01;
+   Double_t fEff10;
+   Double_t fEff30;
+   Double_t fEffArea;
+   Double_t fTrainEff01;
+   Double_t fTrainEff10;
+   Double_t fTrainEff30;
+
+public:
+   CrossValidationFoldResult(UInt_t iFold = 0);
+
+   ClassDef(CrossValidationFoldResult, 1);
+};
+
    class CrossValidation : public Envelope {
 
    public:
@@ -113,7 +140,8 @@ public:
       void Evaluate();
 
    private:
-      void ProcessFold(UInt_t iFold, UInt_t iMethod);
+      CrossValidationFoldResult ProcessFold(UInt_t iFold, UInt_t iMethod);
+      void AddFoldResult(const CrossValidationFoldResult &foldResult, UInt_t iMethod);
       void MergeFolds();
 
       Types::EAnalysisType fAnalysisType;
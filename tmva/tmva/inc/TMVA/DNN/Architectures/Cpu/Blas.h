@@ -15,11 +15,22 @@
 // CPUs.                                                         //
 ///////////////////////////////////////////////////////////////////
 
+// If TMVA is built without BLAS (R__DNNCPU_NOBLAS in RConfigure.h), the
+// functions are implemented here, with a cache-blocked matrix
+// multiplication executed in parallel by the TMVA thread pool.
+
 #ifndef TMVA_DNN_ARCHITECTURES_CPU_BLAS
 #define TMVA_DNN_ARCHITECTURES_CPU_BLAS
 
+#include "RConfigure.h"
+
 #include <iostream>
 
+#ifdef R__DNNCPU_NOBLAS
+#include <algorithm>
+#include "TMVA/Config.h"
+#else
+
 // External Library Routines
 //____________________________________________________________________________
 extern "C" void saxpy_(const int * n, const float * alpha, const float * x,
@@ -53,6 +64,8 @@ extern "C" void sgemm_(const char * transa, const char * transb,
                        const float * B, const int * ldb, const float * beta,
                        float * C, const int * ldc);
 
+#endif // R__DNNCPU_NOBLAS
+
 namespace TMVA
 {
 namespace DNN
@@ -90,6 +103,8 @@ inline void Ger(const int * m, const int * n, const Real_t * alpha,
                 const Real_t * y, const int * incy,
                 Real_t * A, const int * lda);
 
+#ifndef R__DNNCPU_NOBLAS
+
 // Specializations
 //____________________________________________________________________________
 template<>
@@ -164,6 +179,148 @@ inline void Ger<float>(const int * m, const int * n, const float * alpha,
    sger_(m, n, alpha, x, incx, y, incy, A, lda);
 }
 
+#else // R__DNNCPU_NOBLAS
+
+// Implementations
+//____________________________________________________________________________
+template <typename Real_t>
+inline void Axpy(const int * n, const Real_t * alpha,
+                 const Real_t * x, const int * incx,
+                 Real_t * y, const int * incy)
+{
+   for (int i = 0; i < *n; i++) {
+      y[i * *incy] += *alpha * x[i * *incx];
+   }
+}
+
+template <typename Real_t>
+inline void Gemv(const char *trans, const int * m, const int * n,
+                 const Real_t * alpha, const Real_t * A, const int * lda,
+                 const Real_t * x, const int * incx,
+                 const Real_t * beta, Real_t * y, const int * incy)
+{
+   bool transposed = (*trans == 'T' || *trans == 't');
+   int ny = transposed ? *n : *m;
+   for (int i = 0; i < ny; i++) {
+      y[i * *incy] = (*beta == 0.0) ? 0.0 : *beta * y[i * *incy];
+   }
+   for (int j = 0; j < *n; j++) {
+      const Real_t *column = A + j * *lda;
+      if (transposed) {
+         Real_t sum = 0.0;
+         for (int i = 0; i < *m; i++) {
+            sum += column[i] * x[i * *incx];
+         }
+         y[j * *incy] += *alpha * sum;
+      } else {
+         Real_t xj = *alpha * x[j * *incx];
+         for (int i = 0; i < *m; i++) {
+            y[i * *incy] += xj * column[i];
+         }
+      }
+   }
+}
+
+/** Multiply the (\p transa) block of \p A of rows \p i0 to \p i1 and columns
+ *  \p p0 to \p p1 with the corresponding (\p transb) block of \p B and add
+ *  the result to the block of \p C of columns \p j0 to \p j1. */
+template <typename Real_t>
+inline void GemmBlock(bool transa, bool transb, int i0, int i1, int j0, int j1, int p0, int p1,
+                      Real_t alpha, const Real_t * A, int lda, const Real_t * B, int ldb,
+                      Real_t * C, int ldc)
+{
+   for (int j = j0; j < j1; j++) {
+      Real_t *c = C + j * ldc;
+      if (!transa) {
+         // c += A(:, p) * B(p, j), contiguous in the rows of A and C.
+         for (int p = p0; p < p1; p++) {
+            Real_t b = alpha * (transb ? B[j + p * ldb] : B[p + j * ldb]);
+            const Real_t *a = A + p * lda;
+            for (int i = i0; i < i1; i++) {
+               c[i] += a[i] * b;
+            }
+         }
+      } else {
+         // c(i) += A(p, i) * B(p, j), a dot product contiguous in p.
+         for (int i = i0; i < i1; i++) {
+            const Real_t *a = A + i * lda;
+            Real_t sum = 0.0;
+            if (!transb) {
+               const Real_t *b = B + j * ldb;
+               for (int p = p0; p < p1; p++) {
+                  sum += a[p] * b[p];
+               }
+            } else {
+               for (int p = p0; p < p1; p++) {
+                  sum += a[p] * B[j + p * ldb];
+               }
+            }
+            c[i] += alpha * sum;
+         }
+      }
+   }
+}
+
+template <typename Real_t>
+inline void Gemm(const char *transa, const char *transb,
+                 const int * m, const int * n, const int* k,
+                 const Real_t * alpha, const Real_t * A, const int * lda,
+                 const Real_t * B, const int * ldb, const Real_t * beta,
+                 Real_t * C, const int * ldc)
+{
+   // Block sizes chosen such that the blocks of A, B and C fit in the L2 cache.
+   const int mBlock = 128;
+   const int nBlock = 32;
+   const int kBlock = 256;
+
+   bool ta = (*transa == 'T' || *transa == 't');
+   bool tb = (*transb == 'T' || *transb == 't');
+
+   // Each task computes a block of columns of C.
+   auto f = [=](UInt_t jBlock)
+   {
+      int j0 = jBlock * nBlock;
+      int j1 = std::min(j0 + nBlock, *n);
+      for (int j = j0; j < j1; j++) {
+         Real_t *c = C + j * *ldc;
+         for (int i = 0; i < *m; i++) {
+            c[i] = (*beta == 0.0) ? 0.0 : *beta * c[i];
+         }
+      }
+      for (int p0 = 0; p0 < *k; p0 += kBlock) {
+         int p1 = std::min(p0 + kBlock, *k);
+         for (int i0 = 0; i0 < *m; i0 += mBlock) {
+            int i1 = std::min(i0 + mBlock, *m);
+            GemmBlock(ta, tb, i0, i1, j0, j1, p0, p1, *alpha, A, *lda, B, *ldb, C, *ldc);
+         }
+      }
+   };
+
+   int nBlocks = (*n + nBlock - 1) / nBlock;
+   if (nBlocks == 1) {
+      f(0);
+   } else {
+      TMVA::Config::Instance().GetThreadExecutor().Foreach(f, ROOT::TSeqI(nBlocks));
+   }
+}
+
+template <typename Real_t>
+inline void Ger(const int * m, const int * n, const Real_t * alpha,
+                const Real_t * x, const int * incx,
+                const Real_t * y, const int * incy,
+                Real_t * A, const int * lda)
+{
+   for (int j = 0; j < *n; j++) {
+      Real_t yj = *alpha * y[j * *incy];
+      Real_t *column = A + j * *lda;
+      for (int i = 0; i < *m; i++) {
+         column[i] += x[i * *incx] * yj;
+      }
+   }
+}
+
+#endif // R__DNNCPU_NOBLAS
+
 } // namespace Blas
 } // namespace DNN
 } // namespace TMVA
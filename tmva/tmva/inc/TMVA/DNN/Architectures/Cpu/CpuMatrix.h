@@ -17,7 +17,9 @@
 #ifndef TMVA_DNN_ARCHITECTURES_CPU_CPUMATRIX
 #define TMVA_DNN_ARCHITECTURES_CPU_CPUMATRIX
 
+#include <algorithm>
 #include <cstddef>
+#include <numeric>
 #include <vector>
 
 #include "TMatrix.h"
@@ -36,6 +38,11 @@ namespace DNN
  * BLAS. Provides Map and MapFrom member functions to simplify the application of
  * activation functions and derivatives to matrices.
  *
+ * Element-wise operations are split into chunks of contiguous elements, each
+ * processed by one task of the thread pool, so that the cost of scheduling a
+ * task is amortized over many elements and the loops over the elements of a
+ * chunk can be vectorized by the compiler.
+ *
  * Copying and assignment of TCpuMatrix objects only performs shallow copies, i.e.
  * copying is fast and the resulting objects share the element data.
  *
@@ -48,6 +55,7 @@ class TCpuMatrix
 private:
 
    static std::vector<AFloat> fOnes;  ///< Vector filled with ones used for BLAS calls.
+   static constexpr size_t fgChunkSize = 4096; ///< Number of elements processed by one task.
 
    TCpuBuffer<AFloat> fBuffer; ///< The buffer holding the matrix elements
                                ///< in column-major format.
@@ -89,6 +97,17 @@ public:
    template <typename Function_t>
    void MapFrom(Function_t &f, const TCpuMatrix & A);
 
+   /** Call \p f(begin, end) for consecutive ranges of the indices 0 to
+    *  \p nElements, executed in parallel using TThreadExecutor. */
+   template <typename Function_t>
+   void ForEachChunk(Function_t &f, size_t nElements) const;
+
+   /** Sum of the values returned by \p f(begin, end) for consecutive ranges of
+    *  the indices 0 to \p nElements. The partial sums are added in a fixed
+    *  order, so that the result does not depend on the number of threads. */
+   template <typename Function_t>
+   AFloat SumChunks(Function_t &f, size_t nElements) const;
+
    size_t GetNrows() const {return fNRows;}
    size_t GetNcols() const {return fNCols;}
    size_t GetNElements() const {return fNRows * fNCols;}
@@ -113,6 +132,9 @@ private:
 template<typename AFloat>
 std::vector<AFloat> TCpuMatrix<AFloat>::fOnes {};
 
+template<typename AFloat>
+constexpr size_t TCpuMatrix<AFloat>::fgChunkSize;
+
 
 // Inline Functions.
 //______________________________________________________________________________
@@ -122,13 +144,14 @@ inline void TCpuMatrix<AFloat>::Map(Function_t &f)
 {
    AFloat  *data = GetRawDataPointer();
 
-   auto ff = [data, &f](UInt_t workerID)
+   auto ff = [data, &f](size_t begin, size_t end)
    {
-      data[workerID] = f(data[workerID]);
-      return 0;
+      for (size_t i = begin; i < end; i++) {
+         data[i] = f(data[i]);
+      }
    };
 
-   GetThreadExecutor().Map(ff, ROOT::TSeqI(fNCols * fNRows));
+   ForEachChunk(ff, fNCols * fNRows);
 }
 
 template<typename AFloat>
@@ -138,13 +161,54 @@ inline void TCpuMatrix<AFloat>::MapFrom(Function_t &f, const TCpuMatrix &A)
          AFloat  *dataB = GetRawDataPointer();
    const AFloat  *dataA = A.GetRawDataPointer();
 
-   auto ff = [&dataB, &dataA, &f](UInt_t workerID)
+   auto ff = [dataB, dataA, &f](size_t begin, size_t end)
+   {
+      for (size_t i = begin; i < end; i++) {
+         dataB[i] = f(dataA[i]);
+      }
+   };
+
+   ForEachChunk(ff, fNCols * fNRows);
+}
+
+template<typename AFloat>
+template<typename Function_t>
+inline void TCpuMatrix<AFloat>::ForEachChunk(Function_t &f, size_t nElements) const
+{
+   size_t nChunks = (nElements + fgChunkSize - 1) / fgChunkSize;
+   if (nChunks <= 1) {
+      // Not worth a task of the thread pool.
+      if (nElements > 0) f(0, nElements);
+      return;
+   }
+
+   auto ff = [&f, nElements](UInt_t chunk)
+   {
+      size_t begin = chunk * fgChunkSize;
+      f(begin, std::min(begin + fgChunkSize, nElements));
+   };
+
+   GetThreadExecutor().Foreach(ff, ROOT::TSeqI(nChunks));
+}
+
+template<typename AFloat>
+template<typename Function_t>
+inline AFloat TCpuMatrix<AFloat>::SumChunks(Function_t &f, size_t nElements) const
+{
+   size_t nChunks = (nElements + fgChunkSize - 1) / fgChunkSize;
+   if (nChunks <= 1) {
+      return (nElements > 0) ? f(0, nElements) : AFloat{};
+   }
+
+   std::vector<AFloat> sums(nChunks);
+   auto ff = [&f, &sums, nElements](UInt_t chunk)
    {
-      dataB[workerID] = f(dataA[workerID]);
-      return 0;
+      size_t begin = chunk * fgChunkSize;
+      sums[chunk] = f(begin, std::min(begin + fgChunkSize, nElements));
    };
 
-   GetThreadExecutor().Map(ff, ROOT::TSeqI(fNCols * fNRows));
+   GetThreadExecutor().Foreach(ff, ROOT::TSeqI(nChunks));
+   return std::accumulate(sums.begin(), sums.end(), AFloat{});
 }
 
 } // namespace DNN
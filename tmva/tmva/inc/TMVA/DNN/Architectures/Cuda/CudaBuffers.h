@@ -80,6 +80,10 @@ public:
 
    size_t GetSize() const {return fSize;}
 
+   /** Wait for the end of the last asynchronous transfer from or to the
+    *  buffer, before its content is modified on the host. */
+   void Synchronize() const;
+
 };
 
 /** TCudaDeviceBuffer
@@ -88,7 +92,10 @@ public:
  *  std::shared_pointer with custom destructor to ensure consistent
  *  memory management and allow for easy copying/moving. A device
  *  buffer has an associated CUDA compute stream , which is used for
- *  implicit synchronization of data transfers.
+ *  implicit synchronization of data transfers. Buffers created with
+ *  their own compute stream receive the data from the host on a
+ *  separate non-blocking stream, so that the transfer of a batch
+ *  overlaps with the computations on the previous one.
  *
  * \tparam AFloat The floating point type to be stored in the buffers.
  */
@@ -100,6 +107,7 @@ private:
    size_t                    fOffset;        ///< Offset for sub-buffers
    size_t                    fSize;
    cudaStream_t              fComputeStream; ///< cudaStream for data transfer
+   cudaStream_t              fTransferStream; ///< cudaStream for the copies from the host
    std::shared_ptr<AFloat *> fDevicePointer; ///< Pointer to the buffer data
 
    // Custom destructor required to free pinned host memory using cudaFree.
@@ -0,0 +1,340 @@
+// @(#)root/tmva/tmva/dnn:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/////////////////////////////////////////////////////////////////////
+// Data loader for neural network input data read from a TTree     //
+// during the training, for training sets that do not fit in       //
+// memory.                                                         //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef TMVA_DNN_TREEDATALOADER
+#define TMVA_DNN_TREEDATALOADER
+
+#include "TMVA/DNN/DataLoader.h"
+
+#include "TChain.h"
+#include "TError.h"
+#include "TROOT.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace TMVA {
+namespace DNN  {
+
+/** TTreeDataLoader
+ *
+ * Streaming counterpart of TDataLoader for training sets that do not fit in
+ * memory. A background thread reads the entries of a TTree or TChain, cluster
+ * by cluster, into windows of windowSize events, each holding the input,
+ * output and weight matrices of its events. The batches of the current window
+ * are transferred to the device by a TDataLoader<MatrixInput_t, AArchitecture>,
+ * while the thread reads and decompresses the next windows, at most maxWindows
+ * ahead of the training. The memory used is thus bounded by maxWindows + 2
+ * windows, independently of the size of the training set.
+ *
+ * The order of the clusters is shuffled at the start of each epoch and the
+ * events are shuffled within each window. The input, output and weight values
+ * are TTreeFormula expressions of the tree. The tree must not be used by the
+ * caller while an epoch is read.
+ *
+ *     TTreeDataLoader<Architecture_t> loader(tree, {"x", "y"}, {"classID == 0"}, "weight", 32, 100000);
+ *     for (size_t epoch = 0; epoch < nEpochs; epoch++) {
+ *        loader.StartEpoch();
+ *        while (loader.NextWindow()) {
+ *           for (auto batch : loader) { ... }
+ *        }
+ *     }
+ *
+ * \tparam AArchitecture The achitecture class of the underlying architecture.
+ */
+template <typename AArchitecture>
+class TTreeDataLoader
+{
+private:
+
+   using WindowLoader_t  = TDataLoader<MatrixInput_t, AArchitecture>;
+   using BatchIterator_t = TBatchIterator<MatrixInput_t, AArchitecture>;
+   using Formulas_t      = std::vector<std::unique_ptr<TTreeFormula>>;
+
+   /** The events of one window and the loader of their batches. */
+   struct TWindow {
+      TMatrixT<Double_t> fInput;
+      TMatrixT<Double_t> fOutput;
+      TMatrixT<Double_t> fWeights;
+      MatrixInput_t      fData;
+      std::unique_ptr<WindowLoader_t> fLoader;
+
+      TWindow(size_t nEvents, size_t nInputFeatures, size_t nOutputFeatures)
+         : fInput(nEvents, nInputFeatures), fOutput(nEvents, nOutputFeatures), fWeights(nEvents, 1),
+           fData(fInput, fOutput, fWeights)
+      {
+      }
+   };
+
+   TTree *fTree;
+   Formulas_t fInputFormulas;
+   Formulas_t fOutputFormulas;
+   std::unique_ptr<TTreeFormula> fWeightFormula;
+
+   size_t fBatchSize;
+   size_t fWindowSize;  ///< Number of events per window, a multiple of the batch size.
+   size_t fNStreams;    ///< Number of buffer pairs of the loader of a window.
+   size_t fMaxWindows;  ///< Maximum number of windows read ahead of the training.
+
+   std::vector<std::pair<Long64_t, Long64_t>> fClusters; ///< First and last + 1 entry of each cluster.
+   std::mt19937 fRandom;
+
+   std::thread fReader;
+   std::mutex fMutex;
+   std::condition_variable fCondition;
+   std::deque<std::unique_ptr<TWindow>> fQueue; ///< Windows read and not yet trained on.
+   bool fEndOfEpoch;
+   bool fStop;
+
+   std::unique_ptr<TWindow> fCurrent;
+
+   void AddClusters(TTree *tree, Long64_t offset);
+   std::unique_ptr<TTreeFormula> MakeFormula(const std::string &expression);
+   void ReadEpoch(std::vector<size_t> clusterOrder, unsigned int seed);
+   bool PushWindow(std::unique_ptr<TWindow> window);
+   void StopReader();
+
+public:
+
+   TTreeDataLoader(TTree *tree, const std::vector<std::string> &inputs, const std::vector<std::string> &outputs,
+                   const std::string &weight, size_t batchSize, size_t windowSize, size_t nStreams = 1,
+                   size_t maxWindows = 2, unsigned int seed = 0);
+   TTreeDataLoader(const TTreeDataLoader &) = delete;
+   TTreeDataLoader & operator=(const TTreeDataLoader &) = delete;
+   ~TTreeDataLoader() { StopReader(); }
+
+   /** Start reading a new epoch in the background, in a new random order of
+    *  the clusters. The windows of an unfinished epoch are discarded. */
+   void StartEpoch();
+
+   /** Move to the next window of the epoch, waiting for it to be read if
+    *  necessary. Returns false at the end of the epoch. */
+   bool NextWindow();
+
+   /** Number of events in the current window. */
+   size_t GetWindowSize() const { return fCurrent ? fCurrent->fInput.GetNrows() : 0; }
+
+   /** Iteration over the batches of the current window. */
+   BatchIterator_t begin() { return fCurrent->fLoader->begin(); }
+   BatchIterator_t end() { return fCurrent->fLoader->end(); }
+};
+
+//
+// TTreeDataLoader Class.
+//______________________________________________________________________________
+template <typename AArchitecture>
+TTreeDataLoader<AArchitecture>::TTreeDataLoader(TTree *tree, const std::vector<std::string> &inputs,
+                                                const std::vector<std::string> &outputs, const std::string &weight,
+                                                size_t batchSize, size_t windowSize, size_t nStreams,
+                                                size_t maxWindows, unsigned int seed)
+   : fTree(tree), fBatchSize(batchSize), fWindowSize(std::max(windowSize, batchSize)),
+     fNStreams(nStreams), fMaxWindows(std::max(maxWindows, size_t(1))), fRandom(seed), fEndOfEpoch(true),
+     fStop(false)
+{
+   // the tree is read by another thread than the one of the training
+   ROOT::EnableThreadSafety();
+
+   // the batches of a window, except the last one of the epoch, are all complete
+   fWindowSize = ((fWindowSize + fBatchSize - 1) / fBatchSize) * fBatchSize;
+
+   fTree->LoadTree(0);
+   for (const std::string &input : inputs) fInputFormulas.push_back(MakeFormula(input));
+   for (const std::string &output : outputs) fOutputFormulas.push_back(MakeFormula(output));
+   if (!weight.empty()) fWeightFormula = MakeFormula(weight);
+
+   // the clusters of a chain are the ones of its trees
+   TChain *chain = dynamic_cast<TChain *>(fTree);
+   if (chain) {
+      chain->GetEntries();
+      for (Int_t itree = 0; itree < chain->GetNtrees(); itree++) {
+         Long64_t offset = chain->GetTreeOffset()[itree];
+         chain->LoadTree(offset);
+         AddClusters(chain->GetTree(), offset);
+      }
+   } else {
+      AddClusters(fTree, 0);
+   }
+}
+
+//______________________________________________________________________________
+template <typename AArchitecture>
+void TTreeDataLoader<AArchitecture>::AddClusters(TTree *tree, Long64_t offset)
+{
+   if (!tree) return;
+   Long64_t nEntries = tree->GetEntries();
+   TTree::TClusterIterator clusters = tree->GetClusterIterator(0);
+   Long64_t first = 0;
+   while ((first = clusters.Next()) < nEntries) {
+      fClusters.push_back(std::make_pair(offset + first, offset + std::min(clusters.GetNextEntry(), nEntries)));
+   }
+}
+
+//______________________________________________________________________________
+template <typename AArchitecture>
+std::unique_ptr<TTreeFormula> TTreeDataLoader<AArchitecture>::MakeFormula(const std::string &expression)
+{
+   std::unique_ptr<TTreeFormula> formula(new TTreeFormula("TreeDataLoader", expression.c_str(), fTree));
+   if (formula->GetNdim() == 0) {
+      ::Fatal("TTreeDataLoader", "Invalid expression \"%s\" for the tree %s", expression.c_str(), fTree->GetName());
+   }
+   return formula;
+}
+
+//______________________________________________________________________________
+template <typename AArchitecture>
+void TTreeDataLoader<AArchitecture>::StartEpoch()
+{
+   StopReader();
+   fQueue.clear();
+   fCurrent.reset();
+   fEndOfEpoch = false;
+   fStop = false;
+
+   std::vector<size_t> clusterOrder(fClusters.size());
+   std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+   std::shuffle(clusterOrder.begin(), clusterOrder.end(), fRandom);
+
+   fReader = std::thread(&TTreeDataLoader::ReadEpoch, this, std::move(clusterOrder), fRandom());
+}
+
+//______________________________________________________________________________
+template <typename AArchitecture>
+bool TTreeDataLoader<AArchitecture>::NextWindow()
+{
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCondition.wait(lock, [this] { return !fQueue.empty() || fEndOfEpoch; });
+      if (fQueue.empty()) {
+         fCurrent.reset();
+         return false;
+      }
+      fCurrent = std::move(fQueue.front());
+      fQueue.pop_front();
+   }
+   fCondition.notify_all();
+
+   // the buffers of the loader are allocated by the thread of the training
+   fCurrent->fLoader.reset(new WindowLoader_t(fCurrent->fData, fCurrent->fInput.GetNrows(), fBatchSize,
+                                              fInputFormulas.size(), fOutputFormulas.size(), fNStreams));
+   return true;
+}
+
+//______________________________________________________________________________
+template <typename AArchitecture>
+bool TTreeDataLoader<AArchitecture>::PushWindow(std::unique_ptr<TWindow> window)
+{
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCondition.wait(lock, [this] { return fQueue.size() < fMaxWindows || fStop; });
+      if (fStop) return false;
+      fQueue.push_back(std::move(window));
+   }
+   fCondition.notify_all();
+   return true;
+}
+
+//______________________________________________________________________________
+template <typename AArchitecture>
+void TTreeDataLoader<AArchitecture>::StopReader()
+{
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fStop = true;
+   }
+   fCondition.notify_all();
+   if (fReader.joinable()) fReader.join();
+}
+
+/** Body of the reader thread: read the clusters in the order clusterOrder into
+ *  windows of fWindowSize events, whose rows are filled in a random order. */
+//______________________________________________________________________________
+template <typename AArchitecture>
+void TTreeDataLoader<AArchitecture>::ReadEpoch(std::vector<size_t> clusterOrder, unsigned int seed)
+{
+   std::mt19937 random(seed);
+
+   Long64_t nRemaining = 0;
+   for (const auto &cluster : fClusters) nRemaining += cluster.second - cluster.first;
+
+   std::unique_ptr<TWindow> window;
+   std::vector<size_t> rows;
+   size_t iRow = 0;
+   Int_t treeNumber = -1;
+
+   for (size_t iCluster : clusterOrder) {
+      for (Long64_t entry = fClusters[iCluster].first; entry < fClusters[iCluster].second; entry++) {
+         if (!window) {
+            size_t nEvents = std::min(Long64_t(fWindowSize), nRemaining);
+            window.reset(new TWindow(nEvents, fInputFormulas.size(), fOutputFormulas.size()));
+            rows.resize(nEvents);
+            std::iota(rows.begin(), rows.end(), 0);
+            std::shuffle(rows.begin(), rows.end(), random);
+            iRow = 0;
+         }
+
+         fTree->LoadTree(entry);
+         if (fTree->GetTreeNumber() != treeNumber) {
+            treeNumber = fTree->GetTreeNumber();
+            for (auto &formula : fInputFormulas) formula->UpdateFormulaLeaves();
+            for (auto &formula : fOutputFormulas) formula->UpdateFormulaLeaves();
+            if (fWeightFormula) fWeightFormula->UpdateFormulaLeaves();
+         }
+
+         size_t row = rows[iRow++];
+         for (size_t i = 0; i < fInputFormulas.size(); i++) {
+            fInputFormulas[i]->GetNdata();
+            window->fInput(row, i) = fInputFormulas[i]->EvalInstance();
+         }
+         for (size_t i = 0; i < fOutputFormulas.size(); i++) {
+            fOutputFormulas[i]->GetNdata();
+            window->fOutput(row, i) = fOutputFormulas[i]->EvalInstance();
+         }
+         if (fWeightFormula) {
+            fWeightFormula->GetNdata();
+            window->fWeights(row, 0) = fWeightFormula->EvalInstance();
+         } else {
+            window->fWeights(row, 0) = 1.0;
+         }
+
+         nRemaining--;
+         if (iRow == rows.size()) {
+            if (!PushWindow(std::move(window))) return;
+         }
+      }
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fEndOfEpoch = true;
+   }
+   fCondition.notify_all();
+}
+
+} // namespace DNN
+} // namespace TMVA
+
+#endif
@@ -38,6 +38,7 @@
 
 #include <vector>
 #include <map>
+#include <memory>
 #include <string>
 #include <fstream>
 
@@ -49,6 +50,16 @@
 namespace TMVA {
 
    class MsgLogger;
+
+   // values of events given directly instead of in a tree (DataLoader::AddDataFrame):
+   // one column of values per name, and the weights of the events (empty for unit weights)
+   struct EventColumns {
+      std::vector<std::string>            fNames;
+      std::vector< std::vector<Float_t> > fValues;
+      std::vector<Float_t>                fWeights;
+
+      UInt_t GetEntries() const { return fValues.empty() ? fWeights.size() : fValues[0].size(); }
+   };
    
    class TreeInfo:public TObject {
 
@@ -56,12 +67,16 @@ namespace TMVA {
 
       TreeInfo( TTree* tr, const TString& className, Double_t weight=1.0, Types::ETreeType tt = Types::kMaxTreeType, Bool_t own=kFALSE ) 
       : fTree(tr), fClassName(className), fWeight(weight), fTreeType(tt), fOwner(own) {}
+      TreeInfo( const std::shared_ptr<const EventColumns>& columns, const TString& className, Double_t weight=1.0,
+                Types::ETreeType tt = Types::kMaxTreeType )
+      : fTree(0), fClassName(className), fWeight(weight), fTreeType(tt), fOwner(kFALSE), fColumns(columns) {}
       TreeInfo():fTree(0),fClassName(""),fWeight(1.0), fTreeType(Types::kMaxTreeType), fOwner(kFALSE) {}
       ~TreeInfo() { if (fOwner) delete fTree; }
 
       TTree*           GetTree()      const { return fTree; }
+      const std::shared_ptr<const EventColumns>& GetColumns() const { return fColumns; }
       Double_t         GetWeight()    const { return fWeight; }
-      UInt_t           GetEntries()   const { if( !fTree ) return 0; else return fTree->GetEntries(); }
+      UInt_t           GetEntries()   const { if (fColumns) return fColumns->GetEntries(); if( !fTree ) return 0; else return fTree->GetEntries(); }
       Types::ETreeType GetTreeType()  const { return fTreeType; }
       const TString&   GetClassName() const { return fClassName; }
 
@@ -72,6 +87,7 @@ namespace TMVA {
       Double_t         fWeight;   // weight for the tree
       Types::ETreeType fTreeType; // tree is for training/testing/both
       Bool_t           fOwner;    // true if created from file
+      std::shared_ptr<const EventColumns> fColumns; //! values of the events if not read from a tree
    protected:
        ClassDef(TreeInfo,1);      
    };
@@ -94,6 +110,8 @@ namespace TMVA {
                                   const TCut& cut = "", Types::ETreeType tt = Types::kMaxTreeType );
       void     AddTree          ( const TString& tr, const TString& className, Double_t weight=1.0, 
                                   const TCut& cut = "", Types::ETreeType tt = Types::kMaxTreeType );
+      void     AddColumns       ( const std::shared_ptr<const EventColumns>& columns, const TString& className,
+                                  Double_t weight=1.0, Types::ETreeType tt = Types::kMaxTreeType );
 
       // accessors
       std::vector< TString >* GetClassList() const;
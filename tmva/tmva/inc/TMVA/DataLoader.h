@@ -29,6 +29,7 @@
 #define ROOT_TMVA_DataLoader
 
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
@@ -37,6 +38,7 @@
 #include "TMVA/Factory.h"
 #include "TMVA/Types.h"
 #include "TMVA/DataSet.h"
+#include "TMVA/DataInputHandler.h"
 
 class TFile;
 class TTree;
@@ -75,6 +77,14 @@ namespace TMVA {
       void AddTrainingEvent( const TString& className, const std::vector<Double_t>& event, Double_t weight );
       void AddTestEvent    ( const TString& className, const std::vector<Double_t>& event, Double_t weight );
       void AddEvent        ( const TString& className, Types::ETreeType tt, const std::vector<Double_t>& event, Double_t weight );
+
+      // add the events of a class from the columns of a TDataFrame, read in one event loop of the data frame
+      template <typename T = Double_t, typename DataFrame>
+      void AddDataFrame( DataFrame& df, const TString& className, Types::ETreeType tt = Types::kMaxTreeType,
+                         const std::string& weightColumn = "" );
+      void AddColumns  ( const std::shared_ptr<const EventColumns>& columns, const TString& className,
+                         Types::ETreeType tt = Types::kMaxTreeType );
+      std::vector<std::string> GetColumnNames();
       Bool_t UserAssignEvents(UInt_t clIndex);
       TTree* CreateEventAssignTrees( const TString& name );
 
@@ -220,5 +230,40 @@ namespace TMVA {
    void DataLoaderCopy(TMVA::DataLoader* des, TMVA::DataLoader* src);
 } // namespace TMVA
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add the events of the class className from a data frame (ROOT::Experimental::TDataFrame
+/// or any node of it, e.g. after Filter and Define), without writing them to a tree first.
+/// The variables, targets and spectators, which must be declared before, are read from
+/// the columns of the same names, of type T; the weights, if any, from the column
+/// weightColumn. All the columns are read in one event loop, which runs in parallel
+/// if the implicit multi-threading is enabled. The cut and the weight expression of the
+/// class are not applied to these events: use Filter and the weight column instead.
+
+template <typename T, typename DataFrame>
+void TMVA::DataLoader::AddDataFrame( DataFrame& df, const TString& className, Types::ETreeType tt,
+                                     const std::string& weightColumn )
+{
+   const std::vector<std::string> names = GetColumnNames();
+
+   // book all the columns before the event loop, which is run by the first GetValue
+   std::vector<decltype(df.template Take<T>(std::string()))> results;
+   for (const std::string& name : names) results.push_back(df.template Take<T>(name));
+   if (!weightColumn.empty()) results.push_back(df.template Take<T>(weightColumn));
+
+   auto columns = std::make_shared<EventColumns>();
+   columns->fNames = names;
+   columns->fValues.resize(names.size());
+   for (UInt_t icol = 0; icol < names.size(); icol++) {
+      const auto& values = results[icol].GetValue();
+      columns->fValues[icol].assign(values.begin(), values.end());
+   }
+   if (!weightColumn.empty()) {
+      const auto& weights = results.back().GetValue();
+      columns->fWeights.assign(weights.begin(), weights.end());
+   }
+
+   AddColumns(columns, className, tt);
+}
+
 #endif
 
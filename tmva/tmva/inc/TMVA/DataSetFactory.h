@@ -246,6 +246,13 @@ namespace TMVA {
                                    EventVectorOfClassesOfTreeType& eventsmap,
                                    EvtStatsPerClass& eventCounts);
 
+      void      BuildEventVectorFromColumns( DataSetInfo& dsi,
+                                             const TreeInfo& tinfo,
+                                             UInt_t cl,
+                                             EventVector& event_v,
+                                             EventStats& classEventCounts,
+                                             std::map<TString, int>& nanInfErrors );
+
       DataSet*  MixEvents        ( DataSetInfo& dsi,
                                    EventVectorOfClassesOfTreeType& eventsmap,
                                    EvtStatsPerClass& eventCounts,
@@ -49,6 +49,7 @@
 #include "TMVA/SeparationBase.h"
 #include "TMVA/RegressionVariance.h"
 #include "TMVA/DataSetInfo.h"
+#include "TMVA/BinnedEventSample.h"
 
 class TRandom3;
 
@@ -97,6 +98,10 @@ namespace TMVA {
       //                        DecisionTreeNode *node = NULL);
       UInt_t BuildTree( const EventConstList & eventSample,
                         DecisionTreeNode *node = NULL);
+      // building of a tree from the histograms of the binned variables; rows are the
+      // indices of the events of eventSample in binnedSample
+      UInt_t BuildTree( const EventConstList & eventSample, const BinnedEventSample & binnedSample,
+                        const std::vector<UInt_t> & rows );
       // determine the way how a node is split (which variable, which cut value)
 
       Double_t TrainNode( const EventConstList & eventSample,  DecisionTreeNode *node ) { return TrainNodeFast( eventSample, node ); }
@@ -118,6 +123,8 @@ namespace TMVA {
       // returns: 1 = Signal (right),  -1 = Bkg (left)
 
       Double_t CheckEvent( const TMVA::Event * , Bool_t UseYesNoLeaf = kFALSE ) const;     
+      // adds weight times the response of the tree to sums, for nEvents events given in column-major order
+      void CheckEvents( const Float_t* values, Long64_t nEvents, Bool_t UseYesNoLeaf, Double_t weight, Double_t* sums ) const;
       TMVA::DecisionTreeNode* GetEventNode(const TMVA::Event & e) const;
 
       // return the individual relative variable importance 
@@ -197,6 +204,16 @@ namespace TMVA {
       // calculates the purity S/(S+B) of a given event sample
       Double_t SamplePurity(EventList eventSample);
 
+      // split the node with the events index, whose histograms are hist, and build its daughters
+      void BuildNodeHist( const EventConstList & eventSample, const BinnedEventSample & binnedSample,
+                          const BinnedEventSample::Events & events, std::vector<UInt_t> & index,
+                          BinnedEventSample::Histogram & hist, DecisionTreeNode *node );
+      // determine the best cut of a node from the histograms of its events
+      Double_t TrainNodeHist( const BinnedEventSample & binnedSample, const BinnedEventSample::Histogram & hist,
+                              DecisionTreeNode *node, Double_t nTotS, Double_t nTotB,
+                              Double_t nTotS_unWeighted, Double_t nTotB_unWeighted,
+                              Double_t target, Double_t target2, Int_t & cutVar, UInt_t & cutBin );
+
       UInt_t    fNvars;          // number of variables used to separate S and B
       Int_t     fNCuts;          // number of grid point in variable cut scans
       Bool_t    fUseFisherCuts;  // use multivariate splits using the Fisher criterium
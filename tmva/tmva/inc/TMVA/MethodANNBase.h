@@ -148,6 +148,10 @@ namespace TMVA {
       void     ForceNetworkInputs( const Event* ev, Int_t ignoreIndex = -1 );
       Double_t GetNetworkOutput() { return GetOutputNeuron()->GetActivationValue(); }
 
+      // batch evaluation of the network, layer by layer, without the state of the neurons
+      Bool_t   HasBatchResponse() const;
+      void     GetBatchResponse( const Float_t* values, Long64_t nEvents, Double_t* mvaValues ) const;
+
       // debugging utilities
       void     PrintMessage( TString message, Bool_t force = kFALSE ) const;
       void     ForceNetworkCalculations();
@@ -155,11 +155,18 @@ namespace TMVA {
       void MakeClassInstantiateNode( DecisionTreeNode *n, std::ostream& fout,
                                      const TString& className ) const;
 
+      // tree written as nested if/else statements (option MakeClassUnrolled)
+      void MakeClassUnrolledNode( const DecisionTreeNode *n, std::ostream& fout, UInt_t depth ) const;
+
       void GetHelpMessage() const;
 
    protected:
       void DeclareCompatibilityOptions();
 
+      // batch evaluation of the forest, tree by tree
+      Bool_t HasBatchResponse() const { return !fDoPreselection; }
+      void   GetBatchResponse( const Float_t* values, Long64_t nEvents, Double_t* mvaValues ) const;
+
    private:
       // Init used in the various constructors
       void Init( void );
@@ -191,15 +198,35 @@ namespace TMVA {
       void UpdateTargetsRegression( std::vector<const TMVA::Event*>&,Bool_t first=kFALSE);
       Double_t GetGradBoostMVA(const TMVA::Event *e, UInt_t nTrees);
       void     GetBaggedSubSample(std::vector<const TMVA::Event*>&);
+      UInt_t   GrowTree( DecisionTree *dt );
+
+      // node of the flat copy of the forest used for the evaluation: the nodes
+      // of a tree are stored depth first, with the daughter of the events
+      // failing the cut following its mother node
+      struct FlatNode {
+         Float_t fValue;    // cut value, or purity (response for regression trees) of a leaf
+         Short_t fSelector; // variable of the cut, -1 for a leaf
+         Short_t fNodeType; // type of a leaf (+1 signal, -1 background), 0 for regression trees
+         UInt_t  fPass;     // daughter of the events with value >= fValue
+      };
+
+      void     FlattenForest();
+      Int_t    FlattenNode( const DecisionTreeNode *n, Bool_t regression );
+      Bool_t   HasFlatForest( UInt_t nTrees ) const { return nTrees > 0 && fFlatRoots.size() >= nTrees; }
+      Double_t GetFlatTreeResponse( UInt_t itree, const Float_t* values, Long64_t stride, Bool_t useYesNoLeaf ) const;
 
       std::vector<const TMVA::Event*>       fEventSample;     // the training events
       std::vector<const TMVA::Event*>       fValidationSample;// the Validation events
       std::vector<const TMVA::Event*>       fSubSample;       // subsample for bagged grad boost
       std::vector<const TMVA::Event*>      *fTrainSample;     // pointer to sample actually used in training (fEventSample or fSubSample) for example
+      std::vector<UInt_t>                   fSubSampleRows;   // index in fEventSample of the events of fSubSample
+      BinnedEventSample                    *fBinnedSample;    //! the binned fEventSample, for the histogram based training
 
       Int_t                           fNTrees;          // number of decision trees requested
       std::vector<DecisionTree*>      fForest;          // the collection of decision trees
       std::vector<double>             fBoostWeights;    // the weights applied in the individual boosts
+      std::vector<FlatNode>           fFlatNodes;       //! the nodes of fForest, see FlattenForest
+      std::vector<UInt_t>             fFlatRoots;       //! index in fFlatNodes of the root node of each tree
       Double_t                        fSigToBkgFraction;// Signal to Background fraction assumed during training
       TString                         fBoostType;       // string specifying the boost type
       Double_t                        fAdaBoostBeta;    // beta parameter for AdaBoost algorithm
@@ -225,6 +252,8 @@ namespace TMVA {
       Bool_t                          fUseFisherCuts;   // use multivariate splits using the Fisher criterium
       Double_t                        fMinLinCorrForFisher; // the minimum linear correlation between two variables demanded for use in fisher criterium in node splitting
       Bool_t                          fUseExclusiveVars; // individual variables already used in fisher criterium are not anymore analysed individually for node splitting
+      Bool_t                          fUseHistogramTraining; // grow the trees from the histograms of the variables binned once before the training
+      Bool_t                          fMakeClassUnrolled; // write the trees as nested if/else statements in the standalone class
       Bool_t                          fUseYesNoLeaf;    // use sig or bkg classification in leave nodes or sig/bkg
       Double_t                        fNodePurityLimit; // purity limit for sig/bkg nodes
       UInt_t                          fNNodesMax;       // max # of nodes
@@ -301,4 +330,20 @@ const std::vector<TMVA::DecisionTree*>& TMVA::MethodBDT::GetForest()         con
 const std::vector<const TMVA::Event*> & TMVA::MethodBDT::GetTrainingEvents() const { return fEventSample; }
 const std::vector<double>&              TMVA::MethodBDT::GetBoostWeights()   const { return fBoostWeights; }
 
+////////////////////////////////////////////////////////////////////////////////
+/// response of the tree itree (as in DecisionTree::CheckEvent) for the event
+/// whose variable ivar is values[ivar*stride]
+
+inline Double_t TMVA::MethodBDT::GetFlatTreeResponse( UInt_t itree, const Float_t* values, Long64_t stride,
+                                                      Bool_t useYesNoLeaf ) const
+{
+   const FlatNode* nodes = fFlatNodes.data();
+   const FlatNode* node  = nodes + fFlatRoots[itree];
+   while (node->fSelector >= 0) {
+      node = (values[node->fSelector*stride] >= node->fValue) ? nodes + node->fPass : node + 1;
+   }
+   if (useYesNoLeaf && node->fNodeType != 0) return Double_t( node->fNodeType );
+   return node->fValue;
+}
+
 #endif
@@ -44,6 +44,7 @@
 #include <iosfwd>
 #include <vector>
 #include <map>
+#include <mutex>
 #include "assert.h"
 
 #include "TString.h"
@@ -198,10 +199,19 @@ namespace TMVA {
       // signal/background classification response
       Double_t GetMvaValue( const TMVA::Event* const ev, Double_t* err = 0, Double_t* errUpper = 0 );
 
+      // classification response for a batch of events, the input values given in column-major
+      // order (values[ivar*nEvents + ievt]); can be called from several threads at the same time
+      void GetMvaValuesBatch( const Float_t* values, Long64_t nEvents, Double_t* mvaValues );
+
    protected:
       // helper function to set errors to -1
       void NoErrorCalc(Double_t* const err, Double_t* const errUpper);
 
+      // methods with a batch response overload these two; GetBatchResponse gets the transformed
+      // input values in column-major order and must not modify the state of the method
+      virtual Bool_t HasBatchResponse() const { return kFALSE; }
+      virtual void   GetBatchResponse( const Float_t* /*values*/, Long64_t /*nEvents*/, Double_t* /*mvaValues*/ ) const {}
+
       // signal/background classification response for all current set of data
       virtual std::vector<Double_t> GetMvaValues(Long64_t firstEvt = 0, Long64_t lastEvt = -1, Bool_t logProgress = false);
 
@@ -401,6 +411,7 @@ namespace TMVA {
       DataSetInfo&     DataInfo() const { return fDataSetInfo; }
 
       mutable const Event*   fTmpEvent; //! temporary event when testing on a different DataSet than the own one
+      std::mutex             fBatchMutex; //! serializes the parts of the batch evaluation that use the state of the method
 
       // event reference and update
       // NOTE: these Event accessors make sure that you get the events transformed according to the
@@ -123,6 +123,10 @@ protected:
    void MakeClassSpecific( std::ostream&, const TString& ) const;
    void GetHelpMessage() const;
 
+   // batch evaluation of the network, with the events of a batch as the rows of the input matrix
+   Bool_t HasBatchResponse() const { return kTRUE; }
+   void   GetBatchResponse( const Float_t* values, Long64_t nEvents, Double_t* mvaValues ) const;
+
 public:
 
    // Standard Constructors
@@ -98,6 +98,10 @@ namespace TMVA {
       // make ROOT-independent C++ class for classifier response (classifier-specific implementation)
       void MakeClassSpecific( std::ostream&, const TString& ) const;
 
+      // batch evaluation of the linear discriminant
+      Bool_t HasBatchResponse() const { return kTRUE; }
+      void   GetBatchResponse( const Float_t* values, Long64_t nEvents, Double_t* mvaValues ) const;
+
       // get help message text
       void GetHelpMessage() const;
 
@@ -91,6 +91,12 @@ namespace TMVA
       // get help message text
       void GetHelpMessage() const;
 
+      // the nearest neighbors of a batch of events are searched in parallel
+      Bool_t HasBatchResponse() const { return !fUseLDA; }
+      void   GetBatchResponse(const Float_t* values, Long64_t nEvents, Double_t* mvaValues) const;
+
+      std::vector<Double_t> GetMvaValues(Long64_t firstEvt = 0, Long64_t lastEvt = -1, Bool_t logProgress = false);
+
    private:
 
       // the option handling methods
@@ -112,6 +118,7 @@ namespace TMVA
       const std::vector<Double_t> getRMS(const kNN::List &rlist, const kNN::Event &event_knn) const;
 
       double getLDAValue(const kNN::List &rlist, const kNN::Event &event_knn);
+      Double_t getkNNValue(const kNN::List &rlist, const kNN::Event &event_knn, Bool_t verbose) const;
 
    private:
 
@@ -119,6 +119,7 @@ namespace TMVA {
 
          Bool_t Find(Event event, UInt_t nfind = 100, const std::string &option = "count") const;
          Bool_t Find(UInt_t nfind, const std::string &option) const;
+         Bool_t Find(const Event &event, UInt_t nfind, List &nlist, const std::string &option = "count") const;
       
          const EventVec& GetEventVec() const;
 
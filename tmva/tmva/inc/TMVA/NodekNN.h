@@ -73,6 +73,10 @@ namespace TMVA
 
             const Node* Add(const T &event, UInt_t depth);
 
+            // update the range of the splitting variable with event and return
+            // the existing daughter node to which Add would pass the event
+            Node* Route(const T &event);
+
             void SetNodeL(Node *node);
             void SetNodeR(Node *node);
 
@@ -280,6 +284,23 @@ const TMVA::kNN::Node<T>* TMVA::kNN::Node<T>::Add(const T &event, const UInt_t d
    return node;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// first step of Add for a node with daughters: update the minimum and maximum
+/// values of the splitting variable and return the daughter node of the event,
+/// such that the events can be routed through the top levels of the tree
+/// before the sub-trees below them are filled independently
+
+template<class T>
+TMVA::kNN::Node<T>* TMVA::kNN::Node<T>::Route(const T &event)
+{
+   const Float_t value = event.GetVar(fMod);
+
+   fVarMin = std::min(fVarMin, value);
+   fVarMax = std::max(fVarMax, value);
+
+   return (value < fVarDis) ? fNodeL : fNodeR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 template<class T>
 void TMVA::kNN::Node<T>::Print() const
@@ -92,6 +92,10 @@ namespace TMVA {
       Double_t EvaluateMVA( MethodBase* method,           Double_t aux = 0 );
       Double_t EvaluateMVA( const TString& methodTag,     Double_t aux = 0 );
 
+      // returns the MVA responses of nEvents events, whose input values are given in column-major
+      // order (values[ivar*nEvents + ievt]); can be called from several threads with the same reader
+      void     EvaluateMVA( const Float_t* values, Long64_t nEvents, const TString& methodTag, Double_t* mvaValues );
+
       // returns error on MVA response for given event
       // NOTE: must be called AFTER "EvaluateMVA(...)" call !
       Double_t GetMVAError() const { return fMvaEventError; }
@@ -79,7 +79,7 @@ namespace TMVA {
       Int_t        GetNumOfTransformations() const { return fTransformations.GetSize(); }
       const std::vector<Event*>* CalcTransformations( const std::vector<Event*>&, Bool_t createNewVector = kFALSE );
 
-      void         CalcStats( const std::vector<Event*>& events );
+      void         CalcStats( const std::vector<Event*>& events, Bool_t transform = kFALSE );
       void         AddStats ( Int_t k, UInt_t ivar, Double_t mean, Double_t rms, Double_t min, Double_t max );
       Double_t     GetMean  ( Int_t ivar, Int_t cls = -1 ) const;
       Double_t     GetRMS   ( Int_t ivar, Int_t cls = -1 ) const;
@@ -109,7 +109,7 @@ namespace TMVA {
       TDirectory*    GetRootDir() const { return fRootBaseDir; }
       void           SetRootDir( TDirectory *d ) { fRootBaseDir = d; }
 
-      void           PlotVariables( const std::vector<Event*>& events, TDirectory* theDirectory = 0 );
+      void           PlotVariables( const std::vector<Event*>& events, TDirectory* theDirectory = 0, Bool_t transform = kFALSE );
 
    private:
 
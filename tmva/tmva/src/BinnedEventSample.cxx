@@ -0,0 +1,209 @@
+// @(#)root/tmva $Id$
+
+/*************************************************************************
+ * Copyright (C) 2018, Rene Brun and Fons Rademakers.                    *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/*! \class TMVA::BinnedEventSample
+\ingroup TMVA
+
+Input variables of the training events of a forest, binned once before the
+training, for the histogram based growing of the decision trees
+(DecisionTree::BuildTree with a BinnedEventSample).
+
+The bin edges are quantiles of the distribution of each variable, and each
+event is stored as one bin index per variable, in one compact column per
+variable. The split of a node is then found from the histograms of the
+variables in the node, without sorting or re-binning the events of each node,
+and the histograms of the larger daughter node are obtained by subtracting
+the ones of its sibling from the ones of the parent node.
+*/
+
+#include "TMVA/BinnedEventSample.h"
+
+#include "TMVA/Config.h"
+#include "TMVA/Event.h"
+
+#include <algorithm>
+
+namespace {
+// events per task when filling the histograms of a node
+const UInt_t kChunkSize = 16384;
+// maximum number of partial histograms per node, summed in a fixed order
+const UInt_t kMaxChunks = 8;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// collect the weights, classes and targets of the events given to one tree;
+/// rows are the indices of these events in the BinnedEventSample
+
+TMVA::BinnedEventSample::Events::Events( const std::vector<const TMVA::Event*>& eventSample,
+                                         const std::vector<UInt_t>& rows,
+                                         UInt_t sigClass, Bool_t regression )
+   : fRows(rows),
+     fIsSignal(eventSample.size()),
+     fWeights(eventSample.size())
+{
+   if (regression) fTargets.resize(eventSample.size());
+   for (UInt_t iev=0; iev<eventSample.size(); iev++) {
+      fIsSignal[iev] = (eventSample[iev]->GetClass() == sigClass);
+      fWeights[iev]  = eventSample[iev]->GetWeight();
+      if (regression) fTargets[iev] = eventSample[iev]->GetTarget(0);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// find the bin edges of each variable and store the bin of each event
+
+TMVA::BinnedEventSample::BinnedEventSample( const std::vector<const TMVA::Event*>& eventSample,
+                                            UInt_t nVars, UInt_t nBins )
+   : fNEvents(eventSample.size()),
+     fNVars(nVars),
+     fOffsets(nVars+1, 0),
+     fMin(nVars, 0),
+     fBins(size_t(nVars)*eventSample.size())
+{
+   nBins = std::min(std::max(nBins, UInt_t(2)), UInt_t(65535));
+
+   std::vector< std::vector<Float_t> > edges(fNVars);
+
+   auto binVariable = [&](UInt_t ivar) {
+      std::vector<Float_t> values(fNEvents);
+      for (UInt_t iev=0; iev<fNEvents; iev++) values[iev] = eventSample[iev]->GetValueFast(ivar);
+      std::sort(values.begin(), values.end());
+      if (fNEvents > 0) fMin[ivar] = values[0];
+
+      // the edges are the values at the quantiles k/nBins, skipping the
+      // duplicates, such that discrete variables get one bin per value
+      std::vector<Float_t>& edge = edges[ivar];
+      for (UInt_t k=1; k<nBins && fNEvents > 0; k++) {
+         Float_t q = values[(size_t(k)*fNEvents)/nBins];
+         if (q > (edge.empty() ? values[0] : edge.back())) edge.push_back(q);
+      }
+
+      UShort_t* column = &fBins[size_t(ivar)*fNEvents];
+      for (UInt_t iev=0; iev<fNEvents; iev++) {
+         column[iev] = std::upper_bound(edge.begin(), edge.end(), eventSample[iev]->GetValueFast(ivar)) - edge.begin();
+      }
+   };
+
+#ifdef R__USE_IMT
+   TMVA::Config::Instance().GetThreadExecutor().Foreach(binVariable, ROOT::TSeqI(fNVars));
+#else
+   for (UInt_t ivar=0; ivar<fNVars; ivar++) binVariable(ivar);
+#endif
+
+   for (UInt_t ivar=0; ivar<fNVars; ivar++) {
+      fOffsets[ivar+1] = fOffsets[ivar] + edges[ivar].size() + 1;
+      fEdges.insert(fEdges.end(), edges[ivar].begin(), edges[ivar].end());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// lowest value of the variable ivar in the bin ibin
+
+Float_t TMVA::BinnedEventSample::GetLowEdge( UInt_t ivar, UInt_t ibin ) const
+{
+   return (ibin == 0) ? fMin[ivar] : GetCutValue(ivar, ibin-1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// add the events index[begin..end-1] to the histogram of the variable ivar
+
+void TMVA::BinnedEventSample::FillHistogram( const Events& events, const UInt_t* index, UInt_t begin, UInt_t end,
+                                             UInt_t ivar, Bin* hist ) const
+{
+   const UShort_t* column = GetColumn(ivar);
+   const UInt_t*   rows   = events.fRows.data();
+   const Double_t* weight = events.fWeights.data();
+   const Char_t*   isSig  = events.fIsSignal.data();
+
+   if (events.fTargets.empty()) {
+      for (UInt_t i=begin; i<end; i++) {
+         const UInt_t iev = index[i];
+         Bin& bin = hist[column[rows[iev]]];
+         if (isSig[iev]) { bin.fSigW += weight[iev]; bin.fSigN += 1; }
+         else            { bin.fBkgW += weight[iev]; bin.fBkgN += 1; }
+      }
+   }
+   else {
+      const Float_t* target = events.fTargets.data();
+      for (UInt_t i=begin; i<end; i++) {
+         const UInt_t iev = index[i];
+         Bin& bin = hist[column[rows[iev]]];
+         if (isSig[iev]) { bin.fSigW += weight[iev]; bin.fSigN += 1; }
+         else            { bin.fBkgW += weight[iev]; bin.fBkgN += 1; }
+         const Double_t wt = weight[iev]*target[iev];
+         bin.fTarget  += wt;
+         bin.fTarget2 += wt*target[iev];
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// fill the histograms of all variables with the events index[0..n-1].
+/// The work is split in one task per variable and per chunk of events; each
+/// chunk fills its own partial histograms, which are then added in a fixed
+/// order, so that the result does not depend on the number of threads.
+
+void TMVA::BinnedEventSample::FillHistogram( const Events& events, const UInt_t* index, UInt_t n,
+                                             Histogram& hist ) const
+{
+   const Bin empty = {0, 0, 0, 0, 0, 0};
+   hist.assign(GetTotalNBins(), empty);
+
+   const UInt_t nChunks = std::min(kMaxChunks, (n + kChunkSize - 1)/kChunkSize);
+   if (nChunks <= 1 && size_t(n)*fNVars <= kChunkSize) {
+      // not worth tasks of the thread pool
+      for (UInt_t ivar=0; ivar<fNVars; ivar++) FillHistogram(events, index, 0, n, ivar, &hist[fOffsets[ivar]]);
+      return;
+   }
+
+   // with a single chunk, the tasks of the different variables fill disjoint parts of hist
+   std::vector<Histogram> partial(nChunks > 1 ? nChunks : 0, Histogram(GetTotalNBins(), empty));
+   auto fillTask = [&](UInt_t task) {
+      const UInt_t ivar  = task % fNVars;
+      const UInt_t chunk = task / fNVars;
+      const UInt_t begin = (size_t(n)*chunk)/nChunks;
+      const UInt_t end   = (size_t(n)*(chunk+1))/nChunks;
+      Bin* h = partial.empty() ? &hist[fOffsets[ivar]] : &partial[chunk][fOffsets[ivar]];
+      FillHistogram(events, index, begin, end, ivar, h);
+   };
+
+#ifdef R__USE_IMT
+   TMVA::Config::Instance().GetThreadExecutor().Foreach(fillTask, ROOT::TSeqI(fNVars*nChunks));
+#else
+   for (UInt_t task=0; task<fNVars*nChunks; task++) fillTask(task);
+#endif
+
+   for (UInt_t chunk=0; chunk<partial.size(); chunk++) {
+      const Histogram& p = partial[chunk];
+      for (UInt_t ibin=0; ibin<hist.size(); ibin++) {
+         hist[ibin].fSigW    += p[ibin].fSigW;
+         hist[ibin].fBkgW    += p[ibin].fBkgW;
+         hist[ibin].fSigN    += p[ibin].fSigN;
+         hist[ibin].fBkgN    += p[ibin].fBkgN;
+         hist[ibin].fTarget  += p[ibin].fTarget;
+         hist[ibin].fTarget2 += p[ibin].fTarget2;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// subtract the histograms other from hist
+
+void TMVA::BinnedEventSample::Subtract( Histogram& hist, const Histogram& other )
+{
+   for (UInt_t ibin=0; ibin<hist.size(); ibin++) {
+      hist[ibin].fSigW    -= other[ibin].fSigW;
+      hist[ibin].fBkgW    -= other[ibin].fBkgW;
+      hist[ibin].fSigN    -= other[ibin].fSigN;
+      hist[ibin].fBkgN    -= other[ibin].fBkgN;
+      hist[ibin].fTarget  -= other[ibin].fTarget;
+      hist[ibin].fTarget2 -= other[ibin].fTarget2;
+   }
+}
@@ -32,6 +32,7 @@
 #include "TGraph.h"
 #include "TMath.h"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -103,6 +104,13 @@ TCanvas* TMVA::CrossValidationResult::Draw(const TString name) const
    return c;
 }
 
+//_______________________________________________________________________
+TMVA::CrossValidationFoldResult::CrossValidationFoldResult(UInt_t iFold)
+   : fFold(iFold), fROCIntegral(0), fSig(0), fSep(0), fEff01(0), fEff10(0), fEff30(0), fEffArea(0), fTrainEff01(0),
+     fTrainEff10(0), fTrainEff30(0)
+{
+}
+
 /**
 * \class TMVA::CrossValidation
 * \ingroup TMVA
@@ -337,12 +345,12 @@ void TMVA::CrossValidation::SetSplitExpr(TString splitExpr)
 ///   - Prepares train and test data sets
 ///   - Trains method
 ///   - Evalutes on test set
-///   - Stores the evaluation internally
+///   - Returns the evaluation, to be stored with AddFoldResult
 ///
 /// @param iFold fold to evaluate
 ///
 
-void TMVA::CrossValidation::ProcessFold(UInt_t iFold, UInt_t iMethod)
+TMVA::CrossValidationFoldResult TMVA::CrossValidation::ProcessFold(UInt_t iFold, UInt_t iMethod)
 {
    TString methodName = fMethods[iMethod].GetValue<TString>("MethodName");
    TString methodTitle = fMethods[iMethod].GetValue<TString>("MethodTitle");
@@ -377,27 +385,29 @@ void TMVA::CrossValidation::ProcessFold(UInt_t iFold, UInt_t iMethod)
    fFoldFactory->EvaluateAllMethods();
 
    // Results for aggregation (ROC integral, efficiencies etc.)
+   CrossValidationFoldResult result(iFold);
    if (fAnalysisType == Types::kClassification or fAnalysisType == Types::kMulticlass) {
-      fResults[iMethod].fROCs[iFold] = fFoldFactory->GetROCIntegral(fDataLoader->GetName(), foldTitle);
+      result.fROCIntegral = fFoldFactory->GetROCIntegral(fDataLoader->GetName(), foldTitle);
 
       TGraph *gr = fFoldFactory->GetROCCurve(fDataLoader->GetName(), foldTitle, true);
       gr->SetLineColor(iFold + 1);
       gr->SetLineWidth(2);
       gr->SetTitle(foldTitle.Data());
-      fResults[iMethod].fROCCurves->Add(gr);
+      result.fROCCurve = *gr;
+      delete gr;
 
-      fResults[iMethod].fSigs.push_back(smethod->GetSignificance());
-      fResults[iMethod].fSeps.push_back(smethod->GetSeparation());
+      result.fSig = smethod->GetSignificance();
+      result.fSep = smethod->GetSeparation();
 
       if (fAnalysisType == Types::kClassification) {
          Double_t err;
-         fResults[iMethod].fEff01s.push_back(smethod->GetEfficiency("Efficiency:0.01", Types::kTesting, err));
-         fResults[iMethod].fEff10s.push_back(smethod->GetEfficiency("Efficiency:0.10", Types::kTesting, err));
-         fResults[iMethod].fEff30s.push_back(smethod->GetEfficiency("Efficiency:0.30", Types::kTesting, err));
-         fResults[iMethod].fEffAreas.push_back(smethod->GetEfficiency("", Types::kTesting, err));
-         fResults[iMethod].fTrainEff01s.push_back(smethod->GetTrainingEfficiency("Efficiency:0.01"));
-         fResults[iMethod].fTrainEff10s.push_back(smethod->GetTrainingEfficiency("Efficiency:0.10"));
-         fResults[iMethod].fTrainEff30s.push_back(smethod->GetTrainingEfficiency("Efficiency:0.30"));
+         result.fEff01 = smethod->GetEfficiency("Efficiency:0.01", Types::kTesting, err);
+         result.fEff10 = smethod->GetEfficiency("Efficiency:0.10", Types::kTesting, err);
+         result.fEff30 = smethod->GetEfficiency("Efficiency:0.30", Types::kTesting, err);
+         result.fEffArea = smethod->GetEfficiency("", Types::kTesting, err);
+         result.fTrainEff01 = smethod->GetTrainingEfficiency("Efficiency:0.01");
+         result.fTrainEff10 = smethod->GetTrainingEfficiency("Efficiency:0.10");
+         result.fTrainEff30 = smethod->GetTrainingEfficiency("Efficiency:0.30");
       } else if (fAnalysisType == Types::kMulticlass) {
          // Nothing here for now
       }
@@ -416,8 +426,39 @@ void TMVA::CrossValidation::ProcessFold(UInt_t iFold, UInt_t iMethod)
 
    fFoldFactory->DeleteAllMethods();
    fFoldFactory->fMethodsMap.clear();
+
+   return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Stores the evaluation of a fold in the results of the method iMethod.
+/// The folds have to be added in increasing order.
+///
+
+void TMVA::CrossValidation::AddFoldResult(const CrossValidationFoldResult &foldResult, UInt_t iMethod)
+{
+   if (fAnalysisType != Types::kClassification and fAnalysisType != Types::kMulticlass)
+      return;
+
+   CrossValidationResult &result = fResults[iMethod];
+   result.fROCs[foldResult.fFold] = foldResult.fROCIntegral;
+   result.fROCCurves->Add(new TGraph(foldResult.fROCCurve));
+
+   result.fSigs.push_back(foldResult.fSig);
+   result.fSeps.push_back(foldResult.fSep);
+
+   if (fAnalysisType == Types::kClassification) {
+      result.fEff01s.push_back(foldResult.fEff01);
+      result.fEff10s.push_back(foldResult.fEff10);
+      result.fEff30s.push_back(foldResult.fEff30);
+      result.fEffAreas.push_back(foldResult.fEffArea);
+      result.fTrainEff01s.push_back(foldResult.fTrainEff01);
+      result.fTrainEff10s.push_back(foldResult.fTrainEff10);
+      result.fTrainEff30s.push_back(foldResult.fTrainEff30);
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Does training, test set evaluation and performance evaluation of using
 /// cross-evalution.
@@ -445,8 +486,33 @@ void TMVA::CrossValidation::Evaluate()
       Log() << kINFO << "Evaluate method: " << methodTitle << Endl;
 
       // Process K folds
-      for (UInt_t iFold = 0; iFold < fNumFolds; ++iFold) {
-         ProcessFold(iFold, iMethod);
+      if (fJobs <= 1) {
+         for (UInt_t iFold = 0; iFold < fNumFolds; ++iFold) {
+            AddFoldResult(ProcessFold(iFold, iMethod), iMethod);
+         }
+      } else {
+         // Each fold is trained in its own process. The weight files of the
+         // folds, read by MethodCrossValidation below, are written to disk by
+         // the workers, and only the fold statistics are sent back.
+         fWorkers.SetNWorkers(fJobs);
+         auto executor = [=](UInt_t iFold) -> CrossValidationFoldResult {
+            TMVA::MsgLogger::InhibitOutput();
+            TMVA::gConfig().SetSilent(kTRUE);
+            TMVA::gConfig().SetUseColor(kFALSE);
+            TMVA::gConfig().SetDrawProgressBar(kFALSE);
+            return ProcessFold(iFold, iMethod);
+         };
+
+         auto foldResults = fWorkers.Map(executor, ROOT::TSeqI(fNumFolds));
+
+         // results arrive in the order in which the workers finish
+         std::sort(foldResults.begin(), foldResults.end(),
+                   [](const CrossValidationFoldResult &a, const CrossValidationFoldResult &b) {
+                      return a.fFold < b.fFold;
+                   });
+         for (auto &foldResult : foldResults) {
+            AddFoldResult(foldResult, iMethod);
+         }
       }
 
       // Serialise the cross evaluated method
@@ -14,8 +14,11 @@
  // CPU architectures using Roots TThreadExecutor and BLAS.            //
  ///////////////////////////////////////////////////////////////////
 
+// The functions are evaluated in the precision of the matrix elements, so
+// that the loops over the elements can be vectorized in single precision.
+
 #include "TMVA/DNN/Architectures/Cpu.h"
-#include <math.h>
+#include <cmath>
 
 namespace TMVA
 {
@@ -27,7 +30,7 @@ template<typename AFloat>
 void TCpu<AFloat>::IdentityDerivative(TCpuMatrix<AFloat> & B,
                                       const TCpuMatrix<AFloat> &/*A*/)
 {
-   auto f = [](AFloat) {return 1.0;};
+   auto f = [](AFloat) {return AFloat(1.0);};
    B.Map(f);
 }
 
@@ -35,7 +38,7 @@ void TCpu<AFloat>::IdentityDerivative(TCpuMatrix<AFloat> & B,
 template<typename AFloat>
 void TCpu<AFloat>::Relu(TCpuMatrix<AFloat> & B)
 {
-   auto f = [](AFloat x) {return (x < 0.0) ? 0.0 : x;};
+   auto f = [](AFloat x) {return (x < AFloat(0.0)) ? AFloat(0.0) : x;};
    B.Map(f);
 }
 
@@ -44,7 +47,7 @@ template<typename AFloat>
 void TCpu<AFloat>::ReluDerivative(TCpuMatrix<AFloat> & B,
                                                const TCpuMatrix<AFloat> &A)
 {
-   auto f = [](AFloat x) {return (x < 0.0) ? 0.0 : 1.0;};
+   auto f = [](AFloat x) {return (x < AFloat(0.0)) ? AFloat(0.0) : AFloat(1.0);};
    B.MapFrom(f, A);
 }
 
@@ -52,7 +55,7 @@ void TCpu<AFloat>::ReluDerivative(TCpuMatrix<AFloat> & B,
 template<typename AFloat>
 void TCpu<AFloat>::Sigmoid(TCpuMatrix<AFloat> & B)
 {
-   auto f = [](AFloat x) {return 1.0 / (1.0 + exp(-x));};
+   auto f = [](AFloat x) {return AFloat(1.0) / (AFloat(1.0) + std::exp(-x));};
    B.Map(f);
 }
 
@@ -62,8 +65,8 @@ void TCpu<AFloat>::SigmoidDerivative(TCpuMatrix<AFloat> & B,
                                      const TCpuMatrix<AFloat> &A)
 {
    auto f = [](AFloat x) {
-      AFloat sig = 1.0 / (1.0 + exp(-x));
-      return sig * (1.0 - sig);
+      AFloat sig = AFloat(1.0) / (AFloat(1.0) + std::exp(-x));
+      return sig * (AFloat(1.0) - sig);
    };
    B.MapFrom(f, A);
 }
@@ -72,7 +75,7 @@ void TCpu<AFloat>::SigmoidDerivative(TCpuMatrix<AFloat> & B,
 template<typename AFloat>
 void TCpu<AFloat>::Tanh(TCpuMatrix<AFloat> & B)
 {
-   auto f = [](AFloat x) {return tanh(x);};
+   auto f = [](AFloat x) {return std::tanh(x);};
    B.Map(f);
 }
 
@@ -82,8 +85,8 @@ void TCpu<AFloat>::TanhDerivative(TCpuMatrix<AFloat> & B,
                                   const TCpuMatrix<AFloat> &A)
 {
    auto f = [](AFloat x) {
-      AFloat t = tanh(x);
-      return 1 - t * t;
+      AFloat t = std::tanh(x);
+      return AFloat(1.0) - t * t;
    };
    B.MapFrom(f, A);
 }
@@ -92,7 +95,7 @@ void TCpu<AFloat>::TanhDerivative(TCpuMatrix<AFloat> & B,
 template<typename AFloat>
 void TCpu<AFloat>::SymmetricRelu(TCpuMatrix<AFloat> & B)
 {
-   auto f = [](AFloat x) {return fabs(x);};
+   auto f = [](AFloat x) {return std::fabs(x);};
    B.Map(f);
 }
 
@@ -102,7 +105,7 @@ void TCpu<AFloat>::SymmetricReluDerivative(TCpuMatrix<AFloat> & B,
                                            const TCpuMatrix<AFloat> &A)
 {
    auto f = [](AFloat x) {
-      return (x < 0.0) ? -1.0 : 1.0;
+      return (x < AFloat(0.0)) ? AFloat(-1.0) : AFloat(1.0);
    };
    B.MapFrom(f, A);
 }
@@ -111,7 +114,7 @@ void TCpu<AFloat>::SymmetricReluDerivative(TCpuMatrix<AFloat> & B,
 template<typename AFloat>
 void TCpu<AFloat>::SoftSign(TCpuMatrix<AFloat> & B)
 {
-   auto f = [](AFloat x) {return x / (1 + fabs(x));};
+   auto f = [](AFloat x) {return x / (AFloat(1.0) + std::fabs(x));};
    B.Map(f);
 }
 
@@ -121,8 +124,8 @@ void TCpu<AFloat>::SoftSignDerivative(TCpuMatrix<AFloat> & B,
                                       const TCpuMatrix<AFloat> &A)
 {
    auto f = [](AFloat x) {
-      x = 1.0 + fabs(x);
-      x = 1.0 / (x * x);
+      x = AFloat(1.0) + std::fabs(x);
+      x = AFloat(1.0) / (x * x);
       return x;
    };
    B.MapFrom(f, A);
@@ -132,7 +135,7 @@ void TCpu<AFloat>::SoftSignDerivative(TCpuMatrix<AFloat> & B,
 template<typename AFloat>
 void TCpu<AFloat>::Gauss(TCpuMatrix<AFloat> & B)
 {
-   auto f = [](AFloat x) {return exp(- x * x);};
+   auto f = [](AFloat x) {return std::exp(- x * x);};
    B.Map(f);
 }
 
@@ -141,7 +144,7 @@ template<typename AFloat>
 void TCpu<AFloat>::GaussDerivative(TCpuMatrix<AFloat> & B,
                                    const TCpuMatrix<AFloat> &A)
 {
-   auto f = [](AFloat x) {return - 2.0 * x * exp(- x * x);};
+   auto f = [](AFloat x) {return AFloat(-2.0) * x * std::exp(- x * x);};
    B.MapFrom(f, A);
 }
 
@@ -15,6 +15,7 @@
  /////////////////////////////////////////////////////////////////////
 
 #include "TMVA/DNN/Architectures/Reference.h"
+#include <cmath>
 
 namespace TMVA
 {
@@ -29,23 +30,19 @@ AFloat TCpu<AFloat>::MeanSquaredError(const TCpuMatrix<AFloat> &Y, const TCpuMat
    const AFloat *dataY = Y.GetRawDataPointer();
    const AFloat *dataOutput = output.GetRawDataPointer();
    const AFloat *dataWeights = weights.GetRawDataPointer();
-   std::vector<AFloat> temp(Y.GetNElements());
    size_t m = Y.GetNrows();
    AFloat norm = 1.0 / ((AFloat) Y.GetNrows() * Y.GetNcols());
 
-   auto f = [&dataY, &dataOutput, &dataWeights, &temp, m](UInt_t workerID) {
-      AFloat dy = dataY[workerID] - dataOutput[workerID];
-      temp[workerID] = dataWeights[workerID % m] * dy * dy;
-      return 0;
-   };
-
-   auto reduction = [](const std::vector<AFloat> & v )
-   {
-      return std::accumulate(v.begin(),v.end(),AFloat{});
+   auto f = [dataY, dataOutput, dataWeights, m](size_t begin, size_t end) {
+      AFloat sum = 0.0;
+      for (size_t i = begin; i < end; i++) {
+         AFloat dy = dataY[i] - dataOutput[i];
+         sum += dataWeights[i % m] * dy * dy;
+      }
+      return sum;
    };
 
-   Y.GetThreadExecutor().Map(f, ROOT::TSeqI(Y.GetNElements()));
-   return norm * Y.GetThreadExecutor().Reduce(temp, reduction);
+   return norm * Y.SumChunks(f, Y.GetNElements());
 }
 
 //______________________________________________________________________________
@@ -62,13 +59,14 @@ void TCpu<AFloat>::MeanSquaredErrorGradients(TCpuMatrix<AFloat> &dY, const TCpuM
    size_t m = Y.GetNrows();
    AFloat norm = 1.0 / ((AFloat) Y.GetNrows() * Y.GetNcols());
 
-   auto f = [&dataDY, &dataY, &dataOutput, &dataWeights, m, norm](UInt_t workerID) {
-      dataDY[workerID] = -2.0 * norm * (dataY[workerID] - dataOutput[workerID]);
-      dataDY[workerID] *= dataWeights[workerID % m];
-      return 0;
+   auto f = [dataDY, dataY, dataOutput, dataWeights, m, norm](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+         dataDY[i] = AFloat(-2.0) * norm * (dataY[i] - dataOutput[i]);
+         dataDY[i] *= dataWeights[i % m];
+      }
    };
 
-   Y.GetThreadExecutor().Map(f, ROOT::TSeqI(Y.GetNElements()));
+   Y.ForEachChunk(f, Y.GetNElements());
 }
 
 //______________________________________________________________________________
@@ -79,26 +77,21 @@ AFloat TCpu<AFloat>::CrossEntropy(const TCpuMatrix<AFloat> &Y, const TCpuMatrix<
    const AFloat *dataY = Y.GetRawDataPointer();
    const AFloat *dataOutput = output.GetRawDataPointer();
    const AFloat *dataWeights = weights.GetRawDataPointer();
-   std::vector<AFloat> temp(Y.GetNElements());
 
    size_t m = Y.GetNrows();
    AFloat norm = 1.0 / ((AFloat) Y.GetNrows() * Y.GetNcols());
 
-   auto f = [&dataY, &dataOutput, &dataWeights, &temp, m](UInt_t workerID) {
-      AFloat y   = dataY[workerID];
-      AFloat sig = 1.0 / (1.0 + exp(- dataOutput[workerID]));
-      temp[workerID] = - (y * log(sig) + (1.0 - y) * log(1.0 - sig));
-      temp[workerID] *= dataWeights[workerID % m];
-      return 0;
-   };
-
-   auto reduction = [](const std::vector<AFloat> & v )
-   {
-      return std::accumulate(v.begin(),v.end(),AFloat{});
+   auto f = [dataY, dataOutput, dataWeights, m](size_t begin, size_t end) {
+      AFloat sum = 0.0;
+      for (size_t i = begin; i < end; i++) {
+         AFloat y   = dataY[i];
+         AFloat sig = AFloat(1.0) / (AFloat(1.0) + std::exp(- dataOutput[i]));
+         sum -= dataWeights[i % m] * (y * std::log(sig) + (AFloat(1.0) - y) * std::log(AFloat(1.0) - sig));
+      }
+      return sum;
    };
 
-   Y.GetThreadExecutor().Map(f, ROOT::TSeqI(Y.GetNElements()));
-   return norm * Y.GetThreadExecutor().Reduce(temp, reduction);
+   return norm * Y.SumChunks(f, Y.GetNElements());
 }
 
 //______________________________________________________________________________
@@ -114,15 +107,15 @@ void TCpu<AFloat>::CrossEntropyGradients(TCpuMatrix<AFloat> &dY, const TCpuMatri
    size_t m = Y.GetNrows();
    AFloat norm = 1.0 / ((AFloat) Y.GetNrows() * Y.GetNcols());
 
-   auto f = [&dataDY, &dataY, &dataOutput, &dataWeights, m, norm](UInt_t workerID) {
-      AFloat y   = dataY[workerID];
-      AFloat sig = 1.0 / (1.0 + exp(- dataOutput[workerID]));
-      dataDY[workerID] = norm * (sig - y);
-      dataDY[workerID] *= dataWeights[workerID % m];
-      return 0;
+   auto f = [dataDY, dataY, dataOutput, dataWeights, m, norm](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+         AFloat sig = AFloat(1.0) / (AFloat(1.0) + std::exp(- dataOutput[i]));
+         dataDY[i] = norm * (sig - dataY[i]);
+         dataDY[i] *= dataWeights[i % m];
+      }
    };
 
-   Y.GetThreadExecutor().Map(f, ROOT::TSeqI(Y.GetNElements()));
+   Y.ForEachChunk(f, Y.GetNElements());
 }
 
 //______________________________________________________________________________
@@ -134,31 +127,29 @@ AFloat TCpu<AFloat>::SoftmaxCrossEntropy(const TCpuMatrix<AFloat> &Y, const TCpu
    const AFloat  *dataOutput = output.GetRawDataPointer();
    const AFloat *dataWeights = weights.GetRawDataPointer();
 
-   std::vector<AFloat> temp(Y.GetNrows());
    size_t m = Y.GetNrows();
    size_t n = Y.GetNcols();
    AFloat norm = 1.0 / ((AFloat) m);
 
-   auto f = [&dataY, &dataOutput, &dataWeights, &temp, n, m](UInt_t workerID) {
-      AFloat sum = 0.0;
-      for (size_t j = 0; j < n; j++) {
-         sum += exp(dataOutput[workerID + j * m]);
-      }
-      for (size_t j = 0; j < n; j++) {
-         temp[workerID] -=
-            dataY[workerID + j * m] * log(exp(dataOutput[workerID + j * m]) / sum);
+   auto f = [dataY, dataOutput, dataWeights, n, m](size_t begin, size_t end) {
+      AFloat total = 0.0;
+      for (size_t row = begin; row < end; row++) {
+         AFloat sum = 0.0;
+         for (size_t j = 0; j < n; j++) {
+            sum += std::exp(dataOutput[row + j * m]);
+         }
+         // log(exp(x) / sum) = x - log(sum)
+         AFloat logSum = std::log(sum);
+         AFloat loss = 0.0;
+         for (size_t j = 0; j < n; j++) {
+            loss -= dataY[row + j * m] * (dataOutput[row + j * m] - logSum);
+         }
+         total += loss * dataWeights[row];
       }
-      temp[workerID] *= dataWeights[workerID];
-      return 0;
+      return total;
    };
 
-   auto reduction = [](const std::vector<AFloat> & v )
-   {
-      return std::accumulate(v.begin(),v.end(),AFloat{});
-   };
-
-   Y.GetThreadExecutor().Map(f, ROOT::TSeqI(Y.GetNrows()));
-   return norm * Y.GetThreadExecutor().Reduce(temp, reduction);
+   return norm * Y.SumChunks(f, Y.GetNrows());
 }
 
 //______________________________________________________________________________
@@ -175,23 +166,24 @@ void TCpu<AFloat>::SoftmaxCrossEntropyGradients(TCpuMatrix<AFloat> &dY, const TC
    size_t n = Y.GetNcols();
    AFloat norm = 1.0 / ((AFloat) m);
 
-   auto f = [&dataDY, &dataY, &dataOutput, &dataWeights, norm, n, m](UInt_t workerID) {
-      AFloat sum  = 0.0;
-      AFloat sumY = 0.0;
-      AFloat weight = dataWeights[workerID];
-      for (size_t j = 0; j < n; j++) {
-         sum  += exp(dataOutput[workerID + j * m]);
-         sumY += dataY[workerID + j * m];
-      }
-      for (size_t j = 0; j < n; j++) {
-         dataDY[workerID + j * m] =
-            norm * (exp(dataOutput[workerID + j * m]) / sum * sumY - dataY[workerID + j * m]);
-         dataDY[workerID + j * m] *= weight;
+   auto f = [dataDY, dataY, dataOutput, dataWeights, norm, n, m](size_t begin, size_t end) {
+      for (size_t row = begin; row < end; row++) {
+         AFloat sum  = 0.0;
+         AFloat sumY = 0.0;
+         AFloat weight = dataWeights[row];
+         for (size_t j = 0; j < n; j++) {
+            sum  += std::exp(dataOutput[row + j * m]);
+            sumY += dataY[row + j * m];
+         }
+         for (size_t j = 0; j < n; j++) {
+            dataDY[row + j * m] =
+               norm * (std::exp(dataOutput[row + j * m]) / sum * sumY - dataY[row + j * m]);
+            dataDY[row + j * m] *= weight;
+         }
       }
-      return 0;
    };
 
-   Y.GetThreadExecutor().Map(f, ROOT::TSeqI(Y.GetNrows()));
+   Y.ForEachChunk(f, Y.GetNrows());
 }
 
 } // namespace DNN
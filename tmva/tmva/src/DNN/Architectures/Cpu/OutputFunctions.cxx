@@ -15,6 +15,7 @@
 ///////////////////////////////////////////////////////////////
 
 #include "TMVA/DNN/Architectures/Cpu.h"
+#include <cmath>
 
 namespace TMVA
 {
@@ -25,7 +26,7 @@ template<typename AFloat>
 void TCpu<AFloat>::Sigmoid(TCpuMatrix<AFloat> & B,
                            const TCpuMatrix<AFloat> & A)
 {
-   auto f = [](AFloat x) {return 1.0 / (1.0 + exp(-x));};
+   auto f = [](AFloat x) {return AFloat(1.0) / (AFloat(1.0) + std::exp(-x));};
    B.MapFrom(f, A);
 }
 
@@ -38,19 +39,21 @@ void TCpu<AFloat>::Softmax(TCpuMatrix<AFloat> & B,
    size_t n = A.GetNcols();
    size_t m = A.GetNrows();
 
-   auto f = [&dataA, &dataB, n, m](UInt_t workerID)
+   auto f = [dataA, dataB, n, m](size_t begin, size_t end)
    {
-      AFloat sum = 0.0;
-      for (size_t i = 0; i < n; i++) {
-         sum += exp(dataA[workerID + i * m]);
+      for (size_t row = begin; row < end; row++) {
+         AFloat sum = 0.0;
+         for (size_t i = 0; i < n; i++) {
+            dataB[row + i * m] = std::exp(dataA[row + i * m]);
+            sum += dataB[row + i * m];
+         }
+         for (size_t i = 0; i < n; i++) {
+            dataB[row + i * m] /= sum;
+         }
       }
-      for (size_t i = 0; i < n; i++) {
-         dataB[workerID + i * m] = exp(dataA[workerID + i * m]) / sum;
-      }
-      return 0;
    };
 
-   B.GetThreadExecutor().Map(f, ROOT::TSeqI(A.GetNrows()));
+   B.ForEachChunk(f, A.GetNrows());
 }
 
 } // namespace DNN
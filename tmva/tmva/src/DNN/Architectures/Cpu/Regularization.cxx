@@ -15,6 +15,7 @@
 ///////////////////////////////////////////////////////////////////////
 
 #include "TMVA/DNN/Architectures/Reference.h"
+#include <cmath>
 
 namespace TMVA
 {
@@ -26,25 +27,17 @@ template<typename AFloat>
 AFloat TCpu<AFloat>::L1Regularization(const TCpuMatrix<AFloat> &Weights)
 {
    const AFloat  *data = Weights.GetRawDataPointer();
-   std::vector<AFloat> temp(Weights.GetNElements());
 
-   auto f = [&data, &temp](UInt_t workerID)
+   auto f = [data](size_t begin, size_t end)
    {
-      temp[workerID] = fabs(data[workerID]);
-      return 0;
+      AFloat sum = 0.0;
+      for (size_t i = begin; i < end; i++) {
+         sum += std::fabs(data[i]);
+      }
+      return sum;
    };
 
-   auto reduction = [](const std::vector<AFloat> & v )
-   {
-      return std::accumulate(v.begin(),v.end(),AFloat{});
-   };
-   // auto reduction = [](AFloat sum1, AFloat sum2)
-   // {
-   //    return sum1 + sum2;
-   // };
-
-   Weights.GetThreadExecutor().Map(f, ROOT::TSeqI(Weights.GetNElements()));
-   return Weights.GetThreadExecutor().Reduce(temp, reduction);
+   return Weights.SumChunks(f, Weights.GetNElements());
 }
 
 //______________________________________________________________________________
@@ -57,14 +50,15 @@ void TCpu<AFloat>::AddL1RegularizationGradients(
          AFloat  *dataB     =  B.GetRawDataPointer();
    const AFloat  *dataA      = A.GetRawDataPointer();
 
-   auto f = [&dataA, &dataB, weightDecay](UInt_t workerID)
+   auto f = [dataA, dataB, weightDecay](size_t begin, size_t end)
    {
-      AFloat sign = (dataA[workerID] < 0.0) ? -1.0 : 1.0;
-      dataB[workerID] += weightDecay * sign;
-      return 0;
+      for (size_t i = begin; i < end; i++) {
+         AFloat sign = (dataA[i] < AFloat(0.0)) ? AFloat(-1.0) : AFloat(1.0);
+         dataB[i] += weightDecay * sign;
+      }
    };
 
-   B.GetThreadExecutor().Map(f, ROOT::TSeqI(B.GetNElements()));
+   B.ForEachChunk(f, B.GetNElements());
 }
 
 //______________________________________________________________________________
@@ -72,25 +66,17 @@ template<typename AFloat>
 AFloat TCpu<AFloat>::L2Regularization(const TCpuMatrix<AFloat> &Weights)
 {
    const AFloat  *data = Weights.GetRawDataPointer();
-   std::vector<AFloat> temp(Weights.GetNElements());
-
-   auto f = [&data, &temp](UInt_t workerID)
-   {
-      temp[workerID] = data[workerID] * data[workerID];
-      return 0;
-   };
 
-   auto reduction = [](const std::vector<AFloat> & v )
+   auto f = [data](size_t begin, size_t end)
    {
-      return std::accumulate(v.begin(),v.end(),AFloat{});
+      AFloat sum = 0.0;
+      for (size_t i = begin; i < end; i++) {
+         sum += data[i] * data[i];
+      }
+      return sum;
    };
-   // auto reduction = [](AFloat sum1, AFloat sum2)
-   // {
-   //    return sum1 + sum2;
-   // };
 
-   Weights.GetThreadExecutor().Map(f, ROOT::TSeqI(Weights.GetNElements()));
-   return Weights.GetThreadExecutor().Reduce(temp, reduction);
+   return Weights.SumChunks(f, Weights.GetNElements());
 }
 
 //______________________________________________________________________________
@@ -103,13 +89,14 @@ void TCpu<AFloat>::AddL2RegularizationGradients(
          AFloat  *dataB     =  B.GetRawDataPointer();
    const AFloat  *dataA      = A.GetRawDataPointer();
 
-   auto f = [&dataA, &dataB, weightDecay](UInt_t workerID)
+   auto f = [dataA, dataB, weightDecay](size_t begin, size_t end)
    {
-      dataB[workerID] += 2.0 * weightDecay * dataA[workerID];
-      return 0;
+      for (size_t i = begin; i < end; i++) {
+         dataB[i] += AFloat(2.0) * weightDecay * dataA[i];
+      }
    };
 
-   B.GetThreadExecutor().Map(f, ROOT::TSeqI(B.GetNElements()));
+   B.ForEachChunk(f, B.GetNElements());
 }
 
 } // namespace DNN
@@ -50,6 +50,14 @@ TCudaHostBuffer<AFloat>::operator AFloat * () const
    return *fHostPointer + fOffset;
 }
 
+//______________________________________________________________________________
+template<typename AFloat>
+void TCudaHostBuffer<AFloat>::Synchronize() const
+{
+   // no transfer yet, or one on the default stream, which was synchronous
+   if (fComputeStream) cudaStreamSynchronize(fComputeStream);
+}
+
 //______________________________________________________________________________
 template<typename AFloat>
 TCudaHostBuffer<AFloat> TCudaHostBuffer<AFloat>::GetSubBuffer(size_t offset,
@@ -80,13 +88,14 @@ TCudaDeviceBuffer<AFloat>::TCudaDeviceBuffer(size_t size)
    cudaMalloc(pointer, size * sizeof(AFloat));
    fDevicePointer = std::shared_ptr<AFloat *>(pointer, fDestructor);
    cudaStreamCreate(&fComputeStream);
+   cudaStreamCreateWithFlags(&fTransferStream, cudaStreamNonBlocking);
 }
 
 //______________________________________________________________________________
 template<typename AFloat>
 TCudaDeviceBuffer<AFloat>::TCudaDeviceBuffer(size_t size,
                                                  cudaStream_t stream)
-    : fOffset(0), fSize(size), fComputeStream(stream), fDestructor()
+    : fOffset(0), fSize(size), fComputeStream(stream), fTransferStream(stream), fDestructor()
 {
    AFloat ** pointer = new AFloat * [1];
    cudaMalloc(pointer, size * sizeof(AFloat));
@@ -98,7 +107,7 @@ template<typename AFloat>
 TCudaDeviceBuffer<AFloat>::TCudaDeviceBuffer(AFloat * devicePointer,
                                                  size_t size,
                                                  cudaStream_t stream)
-    : fOffset(0), fSize(size), fComputeStream(stream), fDestructor()
+    : fOffset(0), fSize(size), fComputeStream(stream), fTransferStream(stream), fDestructor()
 {
    AFloat ** pointer = new AFloat * [1];
    *pointer       = devicePointer;
@@ -127,9 +136,20 @@ TCudaDeviceBuffer<AFloat>::operator AFloat * () const
 template<typename AFloat>
 void TCudaDeviceBuffer<AFloat>::CopyFrom(const TCudaHostBuffer<AFloat> &buffer) const
 {
+   // wait for the end of the computations on the previous content
    cudaStreamSynchronize(fComputeStream);
    cudaMemcpyAsync(*this, buffer, fSize * sizeof(AFloat),
-                   cudaMemcpyHostToDevice, fComputeStream);
+                   cudaMemcpyHostToDevice, fTransferStream);
+   buffer.fComputeStream = fTransferStream;
+
+   // the computations on the new content wait for the transfer on the device
+   if (fTransferStream != fComputeStream) {
+      cudaEvent_t event;
+      cudaEventCreateWithFlags(&event, cudaEventDisableTiming);
+      cudaEventRecord(event, fTransferStream);
+      cudaStreamWaitEvent(fComputeStream, event, 0);
+      cudaEventDestroy(event);
+   }
 }
 
 //______________________________________________________________________________
@@ -148,6 +168,9 @@ void TDataLoader<MatrixInput_t, TCuda<float>>::CopyInput(
     IndexIterator_t sampleIterator,
     size_t batchSize)
 {
+   // the previous batch in this buffer may still be in transfer
+   buffer.Synchronize();
+
    const TMatrixT<Double_t> &inputMatrix  = std::get<0>(fData);
    size_t n = inputMatrix.GetNcols();
 
@@ -200,6 +223,9 @@ void TDataLoader<TMVAInput_t, TCuda<float>>::CopyInput(
     IndexIterator_t sampleIterator,
     size_t batchSize)
 {
+   // the previous batch in this buffer may still be in transfer
+   buffer.Synchronize();
+
    Event *event = std::get<0>(fData)[0];
    size_t n  = event->GetNVariables();
    for (size_t i = 0; i < batchSize; i++) {
@@ -266,6 +292,9 @@ template <>
 void TDataLoader<MatrixInput_t, TCuda<double>>::CopyInput(TCudaHostBuffer<double> &buffer,
                                                           IndexIterator_t sampleIterator, size_t batchSize)
 {
+   // the previous batch in this buffer may still be in transfer
+   buffer.Synchronize();
+
    const TMatrixT<Double_t> &inputMatrix  = std::get<0>(fData);
    size_t n = inputMatrix.GetNcols();
 
@@ -316,6 +345,9 @@ template <>
 void TDataLoader<TMVAInput_t, TCuda<double>>::CopyInput(TCudaHostBuffer<double> &buffer, IndexIterator_t sampleIterator,
                                                         size_t batchSize)
 {
+   // the previous batch in this buffer may still be in transfer
+   buffer.Synchronize();
+
    Event *event = std::get<0>(fData)[0];
    size_t n  = event->GetNVariables();
    for (size_t i = 0; i < batchSize; i++) {
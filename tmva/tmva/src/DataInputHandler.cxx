@@ -112,6 +112,27 @@ void TMVA::DataInputHandler::AddTree( TTree* tree,
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// add events of *className* given as columns of values for tt (Training;Testing..)
+/// type as input; the columns are shared, not copied
+
+void TMVA::DataInputHandler::AddColumns( const std::shared_ptr<const EventColumns>& columns,
+                                         const TString& className,
+                                         Double_t weight,
+                                         Types::ETreeType tt )
+{
+   if (!columns) Log() << kFATAL << "Zero pointer for columns of class " << className.Data() << Endl;
+   if (columns->GetEntries()==0) Log() << kFATAL << "Encountered empty columns of class " << className.Data() << Endl;
+   if (fInputTrees[className.Data()].empty()) {
+      fExplicitTrainTest[className.Data()] = (tt != Types::kMaxTreeType);
+   }
+   else if (fExplicitTrainTest[className.Data()] != (tt!=Types::kMaxTreeType) && tt==Types::kMaxTreeType) {
+      Log() << kFATAL << "For the columns of class " << className.Data() << " you did not specify a type,"
+            << " while you did for the first input of this class" << Endl;
+   }
+   fInputTrees[className.Data()].push_back(TreeInfo( columns, className, weight, tt ));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// add a signal tree to the dataset to be used as input
 
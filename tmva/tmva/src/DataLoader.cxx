@@ -311,6 +311,37 @@ void TMVA::DataLoader::AddEvent( const TString& className, Types::ETreeType tt,
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// add the events of a class given as columns of values (see AddDataFrame); the
+/// columns are named after the expressions of the variables, targets and spectators
+
+void TMVA::DataLoader::AddColumns( const std::shared_ptr<const EventColumns>& columns, const TString& className,
+                                   Types::ETreeType tt )
+{
+   DefaultDataSetInfo().AddClass(className); // creates the class if necessary
+
+   // set analysistype to "kMulticlass" if more than two classes and analysistype == kNoAnalysisType
+   if( fAnalysisType == Types::kNoAnalysisType && DefaultDataSetInfo().GetNClasses() > 2 )
+      fAnalysisType = Types::kMulticlass;
+
+   Log() << kINFO << "Add columns of type " << className << " with " << columns->GetEntries() << " events" << Endl;
+   DataInput().AddColumns( columns, className, 1.0, tt );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// names of the columns read by AddDataFrame: the expressions of the variables,
+/// targets and spectators
+
+std::vector<std::string> TMVA::DataLoader::GetColumnNames()
+{
+   std::vector<std::string> names;
+   for (const VariableInfo& info : DefaultDataSetInfo().GetVariableInfos())  names.push_back(info.GetExpression().Data());
+   for (const VariableInfo& info : DefaultDataSetInfo().GetTargetInfos())    names.push_back(info.GetExpression().Data());
+   for (const VariableInfo& info : DefaultDataSetInfo().GetSpectatorInfos()) names.push_back(info.GetExpression().Data());
+   if (names.empty()) Log() << kFATAL << "AddDataFrame: the variables have to be declared before the data" << Endl;
+   return names;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 
@@ -699,12 +730,14 @@ void TMVA::DataLoaderCopy(TMVA::DataLoader* des, TMVA::DataLoader* src)
 {
    for( std::vector<TreeInfo>::const_iterator treeinfo=src->DataInput().Sbegin();treeinfo!=src->DataInput().Send();++treeinfo)
    {
-      des->AddSignalTree( (*treeinfo).GetTree(), (*treeinfo).GetWeight(),(*treeinfo).GetTreeType());
+      if ((*treeinfo).GetColumns()) des->AddColumns( (*treeinfo).GetColumns(), "Signal", (*treeinfo).GetTreeType());
+      else des->AddSignalTree( (*treeinfo).GetTree(), (*treeinfo).GetWeight(),(*treeinfo).GetTreeType());
    }
 
    for( std::vector<TreeInfo>::const_iterator treeinfo=src->DataInput().Bbegin();treeinfo!=src->DataInput().Bend();++treeinfo)
    {
-      des->AddBackgroundTree( (*treeinfo).GetTree(), (*treeinfo).GetWeight(),(*treeinfo).GetTreeType());
+      if ((*treeinfo).GetColumns()) des->AddColumns( (*treeinfo).GetColumns(), "Background", (*treeinfo).GetTreeType());
+      else des->AddBackgroundTree( (*treeinfo).GetTree(), (*treeinfo).GetWeight(),(*treeinfo).GetTreeType());
    }
 }
 
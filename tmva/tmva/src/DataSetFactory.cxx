@@ -85,6 +85,25 @@ namespace TMVA {
       Int_t fullFits = a/b;
       return LargestCommonDivider(b,a-b*fullFits);
    }
+
+   // insert the events of src into events, one after each group of nGroup
+   // events, as long as there are enough of them; the rest is appended.
+   // Builds the result in one pass instead of inserting into the vector.
+   void AlternateEvents(std::vector<Event*>& events, const std::vector<Event*>& src, UInt_t nGroup)
+   {
+      std::vector<Event*> mixed;
+      mixed.reserve(events.size() + src.size());
+      std::vector<Event*>::const_iterator itEvent = events.begin(), itSrc = src.begin();
+      for (; itSrc != src.end(); ++itSrc) {
+         if (UInt_t(events.end() - itEvent) < nGroup) break;
+         mixed.insert(mixed.end(), itEvent, itEvent + nGroup);
+         itEvent += nGroup;
+         mixed.push_back(*itSrc);
+      }
+      mixed.insert(mixed.end(), itEvent, std::vector<Event*>::const_iterator(events.end()));
+      mixed.insert(mixed.end(), itSrc, src.end());
+      events.swap(mixed);
+   }
 }
 
 
@@ -677,6 +696,86 @@ TMVA::DataSetFactory::InitOptions( TMVA::DataSetInfo& dsi,
             <<" differs from mixmode="<<mixMode<<Endl;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// add to event_v the events of the class cl given as columns of values: the
+/// variables, targets and spectators are the columns named after their
+/// expressions, and the weight is the weight of the input times the weight
+/// column, if any. The cut and the weight expression of the class, which are
+/// formulas of tree branches, are not applied to these events.
+
+void TMVA::DataSetFactory::BuildEventVectorFromColumns( TMVA::DataSetInfo& dsi,
+                                                        const TreeInfo& tinfo,
+                                                        UInt_t cl,
+                                                        EventVector& event_v,
+                                                        EventStats& classEventCounts,
+                                                        std::map<TString, int>& nanInfErrors )
+{
+   const EventColumns& columns = *tinfo.GetColumns();
+   const TString& className = dsi.GetClassInfo(cl)->GetName();
+
+   if (dsi.GetClassInfo(cl)->GetCut().GetTitle()[0] != 0 || dsi.GetClassInfo(cl)->GetWeight() != "") {
+      Log() << kWARNING << Form("Dataset[%s] : ",dsi.GetName()) << "The cut and the weight expression of class \""
+            << className << "\" are not applied to the events given as columns" << Endl;
+   }
+
+   // find the column of each variable, target and spectator
+   auto findColumns = [&](const std::vector<VariableInfo>& infos) {
+      std::vector<const Float_t*> found;
+      for (const VariableInfo& info : infos) {
+         auto it = std::find(columns.fNames.begin(), columns.fNames.end(), std::string(info.GetExpression().Data()));
+         if (it == columns.fNames.end()) {
+            Log() << kFATAL << Form("Dataset[%s] : ",dsi.GetName()) << "No column \"" << info.GetExpression()
+                  << "\" in the input of class \"" << className << "\"" << Endl;
+         }
+         found.push_back(columns.fValues[it - columns.fNames.begin()].data());
+      }
+      return found;
+   };
+   const std::vector<const Float_t*> varColumns = findColumns(dsi.GetVariableInfos());
+   const std::vector<const Float_t*> tgtColumns = findColumns(dsi.GetTargetInfos());
+   const std::vector<const Float_t*> visColumns = findColumns(dsi.GetSpectatorInfos());
+
+   std::vector<Float_t> vars(varColumns.size());
+   std::vector<Float_t> tgts(tgtColumns.size());
+   std::vector<Float_t> vis(visColumns.size());
+
+   const UInt_t nEvts = columns.GetEntries();
+   classEventCounts.nInitialEvents += nEvts;
+   event_v.reserve(event_v.size() + nEvts);
+
+   for (UInt_t ievt=0; ievt<nEvts; ievt++) {
+      Bool_t contains_NaN_or_inf = kFALSE;
+      auto readValues = [&](const std::vector<const Float_t*>& src, std::vector<Float_t>& dest, const char* what) {
+         for (UInt_t i=0; i<src.size(); i++) {
+            dest[i] = src[i][ievt];
+            if (!TMath::Finite(dest[i])) {
+               contains_NaN_or_inf = kTRUE;
+               ++nanInfErrors[TString::Format("Dataset[%s] : %s column has indeterminate or infinite values", dsi.GetName(), what)];
+            }
+         }
+      };
+      readValues(varColumns, vars, "Input");
+      readValues(tgtColumns, tgts, "Target");
+      readValues(visColumns, vis, "Spectator");
+      for (UInt_t ivar=0; ivar<vars.size(); ivar++) classEventCounts.varAvLength[ivar] += 1;
+
+      Float_t weight = tinfo.GetWeight();
+      if (!columns.fWeights.empty()) weight *= columns.fWeights[ievt];
+
+      classEventCounts.nEvBeforeCut++;
+      if (!TMath::IsNaN(weight))
+         classEventCounts.nWeEvBeforeCut += weight;
+
+      if (weight < 0) classEventCounts.nNegWeights++;
+      if (contains_NaN_or_inf) continue;
+
+      classEventCounts.nEvAfterCut++;
+      classEventCounts.nWeEvAfterCut += weight;
+
+      event_v.push_back(new Event(vars, tgts , vis, cl , weight));
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// build empty event vectors
 /// distributes events between kTraining/kTesting/kMaxTreeType
@@ -743,6 +842,12 @@ TMVA::DataSetFactory::BuildEventVector( TMVA::DataSetInfo& dsi,
 
          EventVector& event_v = eventsmap[currentInfo.GetTreeType()].at(cl);
 
+         // events given as columns of values, e.g. from a TDataFrame, instead of a tree
+         if (currentInfo.GetColumns()) {
+            BuildEventVectorFromColumns( dsi, currentInfo, cl, event_v, classEventCounts, nanInfErrors );
+            continue;
+         }
+
          Bool_t isChain = (TString("TChain") == currentInfo.GetTree()->ClassName());
          currentInfo.GetTree()->LoadTree(0);
          ChangeToNewTree( currentInfo, dsi );
@@ -1306,46 +1411,16 @@ TMVA::DataSetFactory::MixEvents( DataSetInfo& dsi,
             Log() << kINFO << Form("Dataset[%s] : ",dsi.GetName()) << "Testing sample: You are trying to mix events in alternate mode although the classes have different event numbers. This works but the alternation stops at the last event of the smaller class."<<Endl;
          }
       }
-      typedef EventVector::iterator EvtVecIt;
-      EvtVecIt itEvent, itEventEnd;
-
       // insert first class
       Log() << kDEBUG << "insert class 0 into training and test vector" << Endl;
       trainingEventVector->insert( trainingEventVector->end(), tmpEventVector[Types::kTraining].at(0).begin(), tmpEventVector[Types::kTraining].at(0).end() );
       testingEventVector->insert( testingEventVector->end(),   tmpEventVector[Types::kTesting].at(0).begin(),  tmpEventVector[Types::kTesting].at(0).end() );
 
-      // insert other classes
-      EvtVecIt itTarget;
+      // insert other classes, the events of class cls after each group of cls events
       for( UInt_t cls = 1; cls < dsi.GetNClasses(); ++cls ){
          Log() << kDEBUG << Form("Dataset[%s] : ",dsi.GetName())<< "insert class " << cls << Endl;
-         // training vector
-         itTarget = trainingEventVector->begin() - 1; // start one before begin
-         // loop over source
-         for( itEvent = tmpEventVector[Types::kTraining].at(cls).begin(), itEventEnd = tmpEventVector[Types::kTraining].at(cls).end(); itEvent != itEventEnd; ++itEvent ){
-            //            if( std::distance( itTarget, trainingEventVector->end()) < Int_t(cls+1) ) {
-            if( (trainingEventVector->end() - itTarget) < Int_t(cls+1) ) {
-               itTarget = trainingEventVector->end();
-               trainingEventVector->insert( itTarget, itEvent, itEventEnd ); // fill in the rest without mixing
-               break;
-            }else{
-               itTarget += cls+1;
-               trainingEventVector->insert( itTarget, (*itEvent) ); // fill event
-            }
-         }
-         // testing vector
-         itTarget = testingEventVector->begin() - 1;
-         // loop over source
-         for( itEvent = tmpEventVector[Types::kTesting].at(cls).begin(), itEventEnd = tmpEventVector[Types::kTesting].at(cls).end(); itEvent != itEventEnd; ++itEvent ){
-            //             if( std::distance( itTarget, testingEventVector->end()) < Int_t(cls+1) ) {
-            if( ( testingEventVector->end() - itTarget ) < Int_t(cls+1) ) {
-               itTarget = testingEventVector->end();
-               testingEventVector->insert( itTarget, itEvent, itEventEnd ); // fill in the rest without mixing
-               break;
-            }else{
-               itTarget += cls+1;
-               testingEventVector->insert( itTarget, (*itEvent) ); // fill event
-            }
-         }
+         AlternateEvents( *trainingEventVector, tmpEventVector[Types::kTraining].at(cls), cls );
+         AlternateEvents( *testingEventVector,  tmpEventVector[Types::kTesting].at(cls),  cls );
       }
    }else{
       for( UInt_t cls = 0; cls < dsi.GetNClasses(); ++cls ){
@@ -523,6 +523,189 @@ UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & ev
    return fNNodes;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// building the decision tree like BuildTree(eventSample), but choosing the
+/// splits from the histograms of the variables binned once in binnedSample.
+/// The histograms of a node are filled with one pass over its events (in
+/// parallel over the variables and the events with imt), and the ones of the
+/// larger daughter node are obtained by subtracting the histograms of its
+/// sibling from the ones of their parent. Fisher cuts are not used.
+/// (returns the number of nodes)
+
+UInt_t TMVA::DecisionTree::BuildTree( const EventConstList & eventSample, const BinnedEventSample & binnedSample,
+                                      const std::vector<UInt_t> & rows )
+{
+   UInt_t nevents = eventSample.size();
+   if (nevents == 0) Log() << kFATAL << ":<BuildTree> eventsample Size == 0 " << Endl;
+   if (rows.size() != nevents) {
+      Log() << kFATAL << ":<BuildTree> " << rows.size() << " binned events given for an event sample of size "
+            << nevents << Endl;
+   }
+
+   //start with the root node
+   TMVA::DecisionTreeNode *node = new TMVA::DecisionTreeNode();
+   fNNodes = 1;
+   this->SetRoot(node);
+   this->GetRoot()->SetPos('s');
+   this->GetRoot()->SetDepth(0);
+   this->GetRoot()->SetParentTree(this);
+   fMinSize = fMinNodeSize/100. * nevents;
+   if (fNvars==0) fNvars = eventSample[0]->GetNVariables();
+   fVariableImportance.resize(fNvars);
+
+   BinnedEventSample::Events events(eventSample, rows, fSigClass, DoRegression());
+   std::vector<UInt_t> index(nevents);
+   for (UInt_t iev=0; iev<nevents; iev++) index[iev] = iev;
+
+   BinnedEventSample::Histogram hist;
+   binnedSample.FillHistogram(events, index.data(), nevents, hist);
+   this->BuildNodeHist(eventSample, binnedSample, events, index, hist, node);
+
+   return fNNodes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// fill the statistics of the node with the events index, and split it
+/// if possible, recursively building its daughter nodes. The memory of
+/// index and hist is reused for the daughter nodes.
+
+void TMVA::DecisionTree::BuildNodeHist( const EventConstList & eventSample, const BinnedEventSample & binnedSample,
+                                        const BinnedEventSample::Events & events, std::vector<UInt_t> & index,
+                                        BinnedEventSample::Histogram & hist, TMVA::DecisionTreeNode *node )
+{
+   const UInt_t nevents = index.size();
+
+   Double_t s=0, b=0;
+   Double_t suw=0, buw=0;
+   Double_t sub=0, bub=0; // unboosted!
+   Double_t target=0, target2=0;
+   for (UInt_t i=0; i<nevents; i++) {
+      const UInt_t iev = index[i];
+      const Double_t weight = events.fWeights[iev];
+      const Double_t orgWeight = eventSample[iev]->GetOriginalWeight(); // unboosted!
+      if (events.fIsSignal[iev]) {
+         s += weight;
+         suw += 1;
+         sub += orgWeight;
+      }
+      else {
+         b += weight;
+         buw += 1;
+         bub += orgWeight;
+      }
+      if (DoRegression()) {
+         const Double_t tgt = events.fTargets[iev];
+         target +=weight*tgt;
+         target2+=weight*tgt*tgt;
+      }
+   }
+
+   if (s+b < 0) {
+      Log() << kWARNING << " One of the Decision Tree nodes has negative total number of signal or background events. "
+            << "(Nsig="<<s<<" Nbkg="<<b<<" Probably you use a Monte Carlo with negative weights. Make sure that the "
+            << "minimal number of events demanded for a tree node (MinNodeSize="<<fMinNodeSize
+            << "%) is large enough to allow for reasonable averaging, or try the option NoNegWeightsInTraining." << Endl;
+   }
+
+   node->SetNSigEvents(s);
+   node->SetNBkgEvents(b);
+   node->SetNSigEvents_unweighted(suw);
+   node->SetNBkgEvents_unweighted(buw);
+   node->SetNSigEvents_unboosted(sub);
+   node->SetNBkgEvents_unboosted(bub);
+   node->SetPurity();
+   if (node == this->GetRoot()) {
+      node->SetNEvents(s+b);
+      node->SetNEvents_unweighted(suw+buw);
+      node->SetNEvents_unboosted(sub+bub);
+   }
+
+   Double_t separationGain = 0;
+   Int_t cutVar = -1;
+   UInt_t cutBin = 0;
+   if ((nevents >= 2*fMinSize  && s+b >= 2*fMinSize) && node->GetDepth() < fMaxDepth
+       && ( ( s!=0 && b !=0 && !DoRegression()) || ( (s+b)!=0 && DoRegression()) ) ) {
+      separationGain = this->TrainNodeHist(binnedSample, hist, node, s, b, suw, buw, target, target2, cutVar, cutBin);
+   }
+
+   if (separationGain < std::numeric_limits<double>::epsilon()) { // it is a leaf node
+      if (DoRegression()) {
+         node->SetSeparationIndex(fRegType->GetSeparationIndex(s+b,target,target2));
+         node->SetResponse(target/(s+b));
+         if( almost_equal_double(target2/(s+b), target/(s+b)*target/(s+b)) ) {
+            node->SetRMS(0);
+         }else{
+            node->SetRMS(TMath::Sqrt(target2/(s+b) - target/(s+b)*target/(s+b)));
+         }
+      }
+      else {
+         node->SetSeparationIndex(fSepType->GetSeparationIndex(s,b));
+         if   (node->GetPurity() > fNodePurityLimit) node->SetNodeType(1);
+         else node->SetNodeType(-1);
+      }
+      if (node->GetDepth() > this->GetTotalTreeDepth()) this->SetTotalTreeDepth(node->GetDepth());
+      return;
+   }
+
+   // an event goes right if its bin is above cutBin, for cut type kTRUE
+   const UShort_t* column = binnedSample.GetColumn(cutVar);
+   const Bool_t cutType = node->GetCutType();
+   std::vector<UInt_t> leftIndex, rightIndex;
+
+   Double_t nRight=0, nLeft=0;
+   Double_t nRightUnBoosted=0, nLeftUnBoosted=0;
+
+   for (UInt_t i=0; i<nevents; i++) {
+      const UInt_t iev = index[i];
+      if ((column[events.fRows[iev]] > cutBin) == cutType) {
+         rightIndex.push_back(iev);
+         nRight += events.fWeights[iev];
+         nRightUnBoosted += eventSample[iev]->GetOriginalWeight();
+      }
+      else {
+         leftIndex.push_back(iev);
+         nLeft += events.fWeights[iev];
+         nLeftUnBoosted += eventSample[iev]->GetOriginalWeight();
+      }
+   }
+   std::vector<UInt_t>().swap(index);
+
+   // sanity check
+   if (leftIndex.empty() || rightIndex.empty()) {
+      Log() << kFATAL << "<TrainNode> all events went to the same branch, left:" << leftIndex.size()
+            << " right:" << rightIndex.size() << " while the separation is thought to be " << separationGain
+            << " when cutting on variable " << node->GetSelector() << " at value " << node->GetCutValue() << Endl;
+   }
+
+   // continue building daughter nodes for the left and the right eventsample
+   TMVA::DecisionTreeNode *rightNode = new TMVA::DecisionTreeNode(node,'r');
+   fNNodes++;
+   rightNode->SetNEvents(nRight);
+   rightNode->SetNEvents_unboosted(nRightUnBoosted);
+   rightNode->SetNEvents_unweighted(rightIndex.size());
+
+   TMVA::DecisionTreeNode *leftNode = new TMVA::DecisionTreeNode(node,'l');
+   fNNodes++;
+   leftNode->SetNEvents(nLeft);
+   leftNode->SetNEvents_unboosted(nLeftUnBoosted);
+   leftNode->SetNEvents_unweighted(leftIndex.size());
+
+   node->SetNodeType(0);
+   node->SetLeft(leftNode);
+   node->SetRight(rightNode);
+
+   // fill the histograms of the smaller daughter, and get the ones of the
+   // larger daughter by subtraction from the ones of this node
+   BinnedEventSample::Histogram smallHist;
+   const Bool_t rightIsSmaller = rightIndex.size() <= leftIndex.size();
+   const std::vector<UInt_t> & smallIndex = rightIsSmaller ? rightIndex : leftIndex;
+   binnedSample.FillHistogram(events, smallIndex.data(), smallIndex.size(), smallHist);
+   BinnedEventSample::Subtract(hist, smallHist);
+
+   this->BuildNodeHist(eventSample, binnedSample, events, rightIndex, rightIsSmaller ? smallHist : hist, rightNode);
+   this->BuildNodeHist(eventSample, binnedSample, events, leftIndex,  rightIsSmaller ? hist : smallHist, leftNode);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// fill the existing the decision tree structure by filling event
 /// in from the top node and see where they happen to end up
@@ -1351,6 +1534,109 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Decide how to split a node like TrainNodeFast, scanning the cuts at the
+/// bin edges of the binned variables: the histograms of the node are turned
+/// into cumulative distributions on the fly. The selected variable and the
+/// bin of the cut are returned in cutVar and cutBin.
+
+Double_t TMVA::DecisionTree::TrainNodeHist( const BinnedEventSample & binnedSample,
+                                            const BinnedEventSample::Histogram & hist,
+                                            TMVA::DecisionTreeNode *node, Double_t nTotS, Double_t nTotB,
+                                            Double_t nTotS_unWeighted, Double_t nTotB_unWeighted,
+                                            Double_t target, Double_t target2, Int_t & cutVar, UInt_t & cutBin )
+{
+   Double_t separationGainTotal = -1, sepTmp;
+   Double_t slWBest = 0, blWBest = 0;
+   cutVar = -1;
+   cutBin = 0;
+
+   Bool_t *useVariable = new Bool_t[fNvars+1];   // for performance reasons instead of std::vector<Bool_t> useVariable(fNvars);
+   UInt_t *mapVariable = new UInt_t[fNvars+1];    // map the subset of variables used in randomised trees to the original variable number (used in the Event() )
+
+   if (fRandomisedTree) { // choose for each node splitting a random subset of variables to choose from
+      UInt_t tmp=fUseNvars;
+      GetRandomisedVariables(useVariable,mapVariable,tmp);
+   }
+   else {
+      for (UInt_t ivar=0; ivar < fNvars; ivar++) {
+         useVariable[ivar] = kTRUE;
+         mapVariable[ivar] = ivar;
+      }
+   }
+
+   for (UInt_t ivar=0; ivar < fNvars; ivar++) {
+      if (!useVariable[ivar]) continue;
+
+      const BinnedEventSample::Bin* h = &hist[binnedSample.GetOffset(ivar)];
+      const UInt_t nBins = binnedSample.GetNBins(ivar);
+
+      // the events in the bins 0..iBin would go to the left branch, the others to the right
+      Double_t sl = 0, bl = 0, slW = 0, blW = 0, tl = 0, t2l = 0;
+      for (UInt_t iBin=0; iBin<nBins-1; iBin++) { // the last bin contains "all events" -->skip
+         sl  += h[iBin].fSigN;
+         bl  += h[iBin].fBkgN;
+         slW += h[iBin].fSigW;
+         blW += h[iBin].fBkgW;
+         tl  += h[iBin].fTarget;
+         t2l += h[iBin].fTarget2;
+
+         const Double_t sr  = nTotS_unWeighted-sl;
+         const Double_t br  = nTotB_unWeighted-bl;
+         const Double_t srW = nTotS-slW;
+         const Double_t brW = nTotB-blW;
+         // both daughters should match the minimum node size, and not be empty
+         if ( (sl+bl) < 0.5 || (sr+br) < 0.5 ) continue;
+         if ( ((sl+bl)>=fMinSize && (sr+br)>=fMinSize)
+              && ((slW+blW)>=fMinSize && (srW+brW)>=fMinSize) ) {
+            if (DoRegression()) {
+               sepTmp = fRegType->GetSeparationGain(slW+blW, tl, t2l, nTotS+nTotB, target, target2);
+            } else {
+               sepTmp = fSepType->GetSeparationGain(slW, blW, nTotS, nTotB);
+            }
+            if (separationGainTotal < sepTmp) {
+               separationGainTotal = sepTmp;
+               cutVar  = ivar;
+               cutBin  = iBin;
+               slWBest = slW;
+               blWBest = blW;
+            }
+         }
+      }
+   }
+
+   if (cutVar >= 0) {
+      Bool_t cutType = kTRUE;
+      if (DoRegression()) {
+         node->SetSeparationIndex(fRegType->GetSeparationIndex(nTotS+nTotB,target,target2));
+         node->SetResponse(target/(nTotS+nTotB));
+         if ( almost_equal_double(target2/(nTotS+nTotB), target/(nTotS+nTotB)*target/(nTotS+nTotB)) ) {
+            node->SetRMS(0);
+         }else{
+            node->SetRMS(TMath::Sqrt(target2/(nTotS+nTotB) - target/(nTotS+nTotB)*target/(nTotS+nTotB)));
+         }
+      }
+      else {
+         node->SetSeparationIndex(fSepType->GetSeparationIndex(nTotS,nTotB));
+         cutType = (slWBest/nTotS > blWBest/nTotB);
+      }
+      node->SetSelector((UInt_t)cutVar);
+      node->SetCutValue(binnedSample.GetCutValue(cutVar, cutBin));
+      node->SetCutType(cutType);
+      node->SetSeparationGain(separationGainTotal);
+      node->SetNFisherCoeff(0);
+      fVariableImportance[cutVar] += separationGainTotal*separationGainTotal * (nTotS+nTotB) * (nTotS+nTotB) ;
+   }
+   else {
+      separationGainTotal = 0;
+   }
+
+   delete [] useVariable;
+   delete [] mapVariable;
+
+   return separationGainTotal;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// calculate the fisher coefficients for the event sample and the variables used
 
@@ -1725,6 +2011,51 @@ Double_t TMVA::DecisionTree::CheckEvent( const TMVA::Event * e, Bool_t UseYesNoL
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// the response of the tree (as in CheckEvent) for a batch of nEvents events,
+/// whose input values are given in column-major order (values[ivar*nEvents + ievt]).
+/// weight times the response of each event is added to sums[ievt]
+
+void TMVA::DecisionTree::CheckEvents( const Float_t* values, Long64_t nEvents, Bool_t UseYesNoLeaf,
+                                      Double_t weight, Double_t* sums ) const
+{
+   TMVA::DecisionTreeNode *root = this->GetRoot();
+   if (!root){
+      Log() << kFATAL << "CheckEvents: started with undefined ROOT node" <<Endl;
+      return;
+   }
+
+   Bool_t regression = DoRegression();
+   for (Long64_t ievt = 0; ievt < nEvents; ievt++) {
+      const TMVA::DecisionTreeNode *current = root;
+      while (current->GetNodeType() == 0) { // intermediate node in a (pruned) tree
+         Bool_t right;
+         UInt_t nCoeff = current->GetNFisherCoeff();
+         if (nCoeff == 0) {
+            right = (values[current->GetSelector()*nEvents + ievt] >= current->GetCutValue());
+         } else {
+            Double_t fisher = current->GetFisherCoeff(nCoeff-1); // the offset
+            for (UInt_t ivar = 0; ivar < nCoeff-1; ivar++)
+               fisher += current->GetFisherCoeff(ivar)*values[ivar*nEvents + ievt];
+            right = fisher > current->GetCutValue();
+         }
+         if (!current->GetCutType()) right = !right;
+
+         current = right ? current->GetRight() : current->GetLeft();
+         if (!current) {
+            Log() << kFATAL << "DT::CheckEvents: inconsistent tree structure" <<Endl;
+            return;
+         }
+      }
+
+      Double_t response;
+      if (regression)        response = current->GetResponse();
+      else if (UseYesNoLeaf) response = Double_t( current->GetNodeType() );
+      else                   response = current->GetPurity();
+      sums[ievt] += weight * response;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// calculates the purity S/(S+B) of a given event sample
 
@@ -48,6 +48,10 @@ Base class for all TMVA methods using artificial neural networks.
 #include "TMVA/TSynapse.h"
 #include "TMVA/TActivationChooser.h"
 #include "TMVA/TActivationTanh.h"
+#include "TMVA/TActivationIdentity.h"
+#include "TMVA/TActivationReLU.h"
+#include "TMVA/TActivationSigmoid.h"
+#include "TMVA/TNeuronInputSum.h"
 #include "TMVA/Types.h"
 #include "TMVA/Tools.h"
 #include "TMVA/TNeuronInputChooser.h"
@@ -619,6 +623,76 @@ Double_t TMVA::MethodANNBase::GetMvaValue( Double_t* err, Double_t* errUpper )
    return neuron->GetActivationValue();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// the batch evaluation supports the weighted sum of the inputs and the activation
+/// functions that do not keep a state (all but the radial one)
+
+Bool_t TMVA::MethodANNBase::HasBatchResponse() const
+{
+   if (!fNetwork || !dynamic_cast<TNeuronInputSum*>(fInputCalculator)) return kFALSE;
+   TActivation* activations[] = { fActivation, fOutput, fIdentity };
+   for (TActivation* activation : activations) {
+      if (!dynamic_cast<TActivationIdentity*>(activation) && !dynamic_cast<TActivationTanh*>(activation) &&
+          !dynamic_cast<TActivationReLU*>(activation) && !dynamic_cast<TActivationSigmoid*>(activation)) return kFALSE;
+   }
+   // each neuron is connected to all neurons of the previous layer, in order
+   for (Int_t i = 1; i < fNetwork->GetEntriesFast(); i++) {
+      TObjArray* layer = (TObjArray*)fNetwork->At(i);
+      Int_t numPrev = ((TObjArray*)fNetwork->At(i-1))->GetEntriesFast();
+      for (Int_t j = 0; j < layer->GetEntriesFast(); j++) {
+         TNeuron* neuron = (TNeuron*)layer->At(j);
+         if (!neuron->IsInputNeuron() && neuron->NumPreLinks() != numPrev) return kFALSE;
+      }
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// get the MVA values of a batch of events (see MethodBase::GetMvaValuesBatch):
+/// the activations of a layer are computed for all events from the ones of the
+/// previous layer, in local arrays instead of the neurons
+
+void TMVA::MethodANNBase::GetBatchResponse( const Float_t* values, Long64_t nEvents, Double_t* mvaValues ) const
+{
+   Int_t numLayers = fNetwork->GetEntriesFast();
+   std::vector<Double_t> prev, cur;
+
+   for (Int_t i = 0; i < numLayers; i++) {
+      TObjArray* layer = (TObjArray*)fNetwork->At(i);
+      Int_t numNeurons = layer->GetEntriesFast();
+      TActivation* activation = (i == 0) ? fIdentity : ((i == numLayers-1) ? fOutput : fActivation);
+      cur.assign(numNeurons*nEvents, 0.);
+
+      for (Int_t j = 0; j < numNeurons; j++) {
+         TNeuron* neuron = (TNeuron*)layer->At(j);
+         Double_t* out = &cur[j*nEvents];
+         if (i == 0 && j < (Int_t)GetNvar()) {
+            const Float_t* in = values + j*nEvents;
+            for (Long64_t ievt = 0; ievt < nEvents; ievt++) out[ievt] = in[ievt];
+            continue;
+         }
+         if (neuron->IsInputNeuron()) {
+            // bias neuron, with identity activation
+            std::fill(out, out + nEvents, neuron->GetValue());
+            continue;
+         }
+         for (Int_t k = 0; k < neuron->NumPreLinks(); k++) {
+            Double_t weight = neuron->PreLinkAt(k)->GetWeight();
+            const Double_t* in = &prev[k*nEvents];
+            for (Long64_t ievt = 0; ievt < nEvents; ievt++) out[ievt] += weight*in[ievt];
+         }
+         if (dynamic_cast<TActivationSigmoid*>(activation)) {
+            for (Long64_t ievt = 0; ievt < nEvents; ievt++) out[ievt] = 1.0/(1.0+TMath::Exp(-out[ievt]));
+         } else if (!dynamic_cast<TActivationIdentity*>(activation)) {
+            for (Long64_t ievt = 0; ievt < nEvents; ievt++) out[ievt] = activation->Eval(out[ievt]);
+         }
+      }
+      std::swap(prev, cur);
+   }
+
+   std::copy(prev.begin(), prev.begin() + nEvents, mvaValues);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// get the regression value generated by the NN
 
@@ -167,6 +167,7 @@ TMVA::MethodBDT::MethodBDT( const TString& jobName,
                             const TString& theOption ) :
    TMVA::MethodBase( jobName, Types::kBDT, methodTitle, theData, theOption)
    , fTrainSample(0)
+   , fBinnedSample(0)
    , fNTrees(0)
    , fSigToBkgFraction(0)
    , fAdaBoostBeta(0)
@@ -182,6 +183,8 @@ TMVA::MethodBDT::MethodBDT( const TString& jobName,
    , fUseFisherCuts(0)        // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fMinLinCorrForFisher(.8) // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseExclusiveVars(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
+   , fUseHistogramTraining(kFALSE)
+   , fMakeClassUnrolled(kFALSE)
    , fUseYesNoLeaf(kFALSE)
    , fNodePurityLimit(0)
    , fNNodesMax(0)
@@ -222,6 +225,7 @@ TMVA::MethodBDT::MethodBDT( DataSetInfo& theData,
                             const TString& theWeightFile)
    : TMVA::MethodBase( Types::kBDT, theData, theWeightFile)
    , fTrainSample(0)
+   , fBinnedSample(0)
    , fNTrees(0)
    , fSigToBkgFraction(0)
    , fAdaBoostBeta(0)
@@ -237,6 +241,8 @@ TMVA::MethodBDT::MethodBDT( DataSetInfo& theData,
    , fUseFisherCuts(0)        // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fMinLinCorrForFisher(.8) // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseExclusiveVars(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
+   , fUseHistogramTraining(kFALSE)
+   , fMakeClassUnrolled(kFALSE)
    , fUseYesNoLeaf(kFALSE)
    , fNodePurityLimit(0)
    , fNNodesMax(0)
@@ -420,8 +426,11 @@ void TMVA::MethodBDT::DeclareOptions()
    DeclareOptionRef(fUseFisherCuts=kFALSE, "UseFisherCuts", "Use multivariate splits using the Fisher criterion");
    DeclareOptionRef(fMinLinCorrForFisher=.8,"MinLinCorrForFisher", "The minimum linear correlation between two variables demanded for use in Fisher criterion in node splitting");
    DeclareOptionRef(fUseExclusiveVars=kFALSE,"UseExclusiveVars","Variables already used in fisher criterion are not anymore analysed individually for node splitting");
+   DeclareOptionRef(fUseHistogramTraining=kFALSE,"UseHistogramTraining","Grow the trees from histograms of the variables, binned once before the training in nCuts+1 quantile bins (parallel with imt)");
 
 
+   DeclareOptionRef(fMakeClassUnrolled=kFALSE,"MakeClassUnrolled","Write the trees as nested if/else statements in the standalone response class (MakeClass), instead of node objects");
+
    DeclareOptionRef(fDoPreselection=kFALSE,"DoPreselection","and and apply automatic pre-selection for 100% efficient signal (bkg) cuts prior to training");
 
 
@@ -605,6 +614,17 @@ void TMVA::MethodBDT::ProcessOptions()
       fNCuts=20;
    }
 
+   if (fUseHistogramTraining) {
+      if (fUseFisherCuts) {
+         Log() << kWARNING << "The option UseHistogramTraining does not support UseFisherCuts, I will ignore it!" << Endl;
+         fUseHistogramTraining = kFALSE;
+      }
+      else if (fNCuts <= 0) {
+         Log() << kINFO << "UseHistogramTraining needs nCuts>0, I use nCuts=255" << Endl;
+         fNCuts = 255;
+      }
+   }
+
    if (fNTrees==0){
       Log() << kERROR << " Zero Decision Trees demanded... that does not work !! "
             << " I set it to 1 .. just so that the program does not crash"
@@ -729,6 +749,8 @@ void TMVA::MethodBDT::Reset( void )
    // remove all the trees
    for (UInt_t i=0; i<fForest.size();           i++) delete fForest[i];
    fForest.clear();
+   fFlatNodes.clear();
+   fFlatRoots.clear();
 
    fBoostWeights.clear();
    if (fMonitorNtuple) { fMonitorNtuple->Delete(); fMonitorNtuple=NULL; }
@@ -752,6 +774,7 @@ void TMVA::MethodBDT::Reset( void )
 TMVA::MethodBDT::~MethodBDT( void )
 {
    for (UInt_t i=0; i<fForest.size();           i++) delete fForest[i];
+   delete fBinnedSample;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1146,6 +1169,11 @@ void TMVA::MethodBDT::Train()
    // known).
    InitEventSample();
 
+   // the forest changes from now on, the trees are evaluated directly until
+   // they are flattened at the end of the training
+   fFlatNodes.clear();
+   fFlatRoots.clear();
+
    if (fNTrees==0){
       Log() << kERROR << " Zero Decision Trees demanded... that does not work !! "
             << " I set it to 1 .. just so that the program does not crash"
@@ -1153,6 +1181,12 @@ void TMVA::MethodBDT::Train()
       fNTrees = 1;
    }
 
+   // bin the variables of the training events once for all trees
+   if (fUseHistogramTraining) {
+      delete fBinnedSample;
+      fBinnedSample = new BinnedEventSample(fEventSample, GetNvar(), fNCuts+1);
+   }
+
    if (fInteractive && fInteractive->NotInitialized()){
      std::vector<TString> titles = {"Boost weight", "Error Fraction"};
      fInteractive->Init(titles);
@@ -1303,7 +1337,7 @@ void TMVA::MethodBDT::Train()
             }
             // the minimum linear correlation between two variables demanded for use in fisher criterion in node splitting
 
-            nNodesBeforePruning = fForest.back()->BuildTree(*fTrainSample);
+            nNodesBeforePruning = this->GrowTree(fForest.back());
             Double_t bw = this->Boost(*fTrainSample, fForest.back(),i);
             if (bw > 0) {
                fBoostWeights.push_back(bw);
@@ -1326,7 +1360,7 @@ void TMVA::MethodBDT::Train()
             fForest.back()->SetUseExclusiveVars(fUseExclusiveVars);
          }
 
-         nNodesBeforePruning = fForest.back()->BuildTree(*fTrainSample);
+         nNodesBeforePruning = this->GrowTree(fForest.back());
 
          if (fUseYesNoLeaf && !DoRegression() && fBoostType!="Grad") { // remove leaf nodes where both daughter nodes are of same type
             nNodesBeforePruning = fForest.back()->CleanTree();
@@ -1400,6 +1434,7 @@ void TMVA::MethodBDT::Train()
    }
    TMVA::DecisionTreeNode::fgIsTraining=false;
 
+   FlattenForest();
 
    // reset all previously stored/accumulated BOOST weights in the event sample
    //   for (UInt_t iev=0; iev<fEventSample.size(); iev++) fEventSample[iev]->SetBoostWeight(1.);
@@ -1408,6 +1443,8 @@ void TMVA::MethodBDT::Train()
    for (UInt_t i=0; i<fValidationSample.size(); i++) delete fValidationSample[i];
    fEventSample.clear();
    fValidationSample.clear();
+   delete fBinnedSample;
+   fBinnedSample = 0;
 
    if (!fExitFromTraining) fIPyMaxIter = fIPyCurrentIter;
    ExitFromTraining();
@@ -1420,6 +1457,11 @@ void TMVA::MethodBDT::Train()
 Double_t TMVA::MethodBDT::GetGradBoostMVA(const TMVA::Event* e, UInt_t nTrees)
 {
    Double_t sum=0;
+   if (HasFlatForest(nTrees)) {
+      const Float_t* values = e->GetValues().data();
+      for (UInt_t itree=0; itree<nTrees; itree++) sum += GetFlatTreeResponse(itree, values, 1, kFALSE);
+      return 2.0/(1.0+exp(-2.0*sum))-1;
+   }
    for (UInt_t itree=0; itree<nTrees; itree++) {
       //loop over all trees in forest
       sum += fForest[itree]->CheckEvent(e,kFALSE);
@@ -2045,10 +2087,14 @@ void TMVA::MethodBDT::GetBaggedSubSample(std::vector<const TMVA::Event*>& eventS
    TRandom3 *trandom   = new TRandom3(100*fForest.size()+1234);
 
    if (!fSubSample.empty()) fSubSample.clear();
+   fSubSampleRows.clear();
 
-   for (std::vector<const TMVA::Event*>::const_iterator e=eventSample.begin(); e!=eventSample.end();++e) {
+   for (UInt_t ievt=0; ievt<eventSample.size(); ievt++) {
       n = trandom->PoissonD(fBaggedSampleFraction);
-      for (Int_t i=0;i<n;i++) fSubSample.push_back(*e);
+      for (Int_t i=0;i<n;i++) {
+         fSubSample.push_back(eventSample[ievt]);
+         fSubSampleRows.push_back(ievt);
+      }
    }
 
    delete trandom;
@@ -2069,6 +2115,21 @@ void TMVA::MethodBDT::GetBaggedSubSample(std::vector<const TMVA::Event*>& eventS
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// build the tree dt with the current training sample, from the binned
+/// variables if UseHistogramTraining is set (returns the number of nodes)
+
+UInt_t TMVA::MethodBDT::GrowTree( DecisionTree *dt )
+{
+   if (!fBinnedSample) return dt->BuildTree(*fTrainSample);
+
+   if (fTrainSample == &fSubSample) return dt->BuildTree(fSubSample, *fBinnedSample, fSubSampleRows);
+
+   std::vector<UInt_t> rows(fEventSample.size());
+   for (UInt_t ievt=0; ievt<rows.size(); ievt++) rows[ievt] = ievt;
+   return dt->BuildTree(fEventSample, *fBinnedSample, rows);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// A special boosting only for Regression (not implemented).
 
@@ -2290,6 +2351,8 @@ void TMVA::MethodBDT::ReadWeightsFromXML(void* parent) {
       fBoostWeights.push_back(boostWeight);
       ch = gTools().GetNextChild(ch);
    }
+
+   FlattenForest();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2326,6 +2389,8 @@ void  TMVA::MethodBDT::ReadWeightsFromStream( std::istream& istr )
       fForest.back()->Read(istr, GetTrainingTMVAVersionCode());
       fBoostWeights.push_back(boostWeight);
    }
+
+   FlattenForest();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2370,6 +2435,14 @@ Double_t TMVA::MethodBDT::PrivateGetMvaValue(const TMVA::Event* ev, Double_t* er
 
    Double_t myMVA = 0;
    Double_t norm  = 0;
+   if (HasFlatForest(nTrees)) {
+      const Float_t* values = ev->GetValues().data();
+      for (UInt_t itree=0; itree<nTrees; itree++) {
+         myMVA += fBoostWeights[itree] * GetFlatTreeResponse(itree, values, 1, fUseYesNoLeaf);
+         norm  += fBoostWeights[itree];
+      }
+      return ( norm > std::numeric_limits<double>::epsilon() ) ? myMVA /= norm : 0 ;
+   }
    for (UInt_t itree=0; itree<nTrees; itree++) {
       //
       myMVA += fBoostWeights[itree] * fForest[itree]->CheckEvent(ev,fUseYesNoLeaf);
@@ -2379,6 +2452,112 @@ Double_t TMVA::MethodBDT::PrivateGetMvaValue(const TMVA::Event* ev, Double_t* er
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the MVA values of a batch of events (see MethodBase::GetMvaValuesBatch),
+/// as PrivateGetMvaValue does for one event. The forest is evaluated one tree at
+/// a time for all the events, so that the nodes of the tree stay in the cache.
+
+void TMVA::MethodBDT::GetBatchResponse( const Float_t* values, Long64_t nEvents, Double_t* mvaValues ) const
+{
+   std::fill(mvaValues, mvaValues + nEvents, 0.);
+   UInt_t nTrees = fForest.size();
+
+   if (HasFlatForest(nTrees)) {
+      Bool_t grad = (fBoostType=="Grad");
+      Bool_t useYesNoLeaf = grad ? kFALSE : fUseYesNoLeaf;
+      Double_t norm = 0;
+      for (UInt_t itree=0; itree<nTrees; itree++) {
+         Double_t weight = grad ? 1.0 : fBoostWeights[itree];
+         for (Long64_t ievt=0; ievt<nEvents; ievt++)
+            mvaValues[ievt] += weight * GetFlatTreeResponse(itree, values + ievt, nEvents, useYesNoLeaf);
+         norm += weight;
+      }
+      for (Long64_t ievt=0; ievt<nEvents; ievt++) {
+         if (grad) mvaValues[ievt] = 2.0/(1.0+exp(-2.0*mvaValues[ievt]))-1;
+         else      mvaValues[ievt] = ( norm > std::numeric_limits<double>::epsilon() ) ? mvaValues[ievt]/norm : 0;
+      }
+      return;
+   }
+
+   if (fBoostType=="Grad") {
+      for (UInt_t itree=0; itree<nTrees; itree++)
+         fForest[itree]->CheckEvents(values, nEvents, kFALSE, 1.0, mvaValues);
+      for (Long64_t ievt=0; ievt<nEvents; ievt++)
+         mvaValues[ievt] = 2.0/(1.0+exp(-2.0*mvaValues[ievt]))-1; //MVA output between -1 and 1
+      return;
+   }
+
+   Double_t norm  = 0;
+   for (UInt_t itree=0; itree<nTrees; itree++) {
+      fForest[itree]->CheckEvents(values, nEvents, fUseYesNoLeaf, fBoostWeights[itree], mvaValues);
+      norm  += fBoostWeights[itree];
+   }
+   for (Long64_t ievt=0; ievt<nEvents; ievt++)
+      mvaValues[ievt] = ( norm > std::numeric_limits<double>::epsilon() ) ? mvaValues[ievt]/norm : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the trees of the forest into the contiguous array fFlatNodes, which
+/// PrivateGetMvaValue and GetBatchResponse traverse instead of the
+/// DecisionTreeNode objects. Forests with Fisher cuts are not flattened and
+/// are evaluated on the trees.
+
+void TMVA::MethodBDT::FlattenForest()
+{
+   fFlatNodes.clear();
+   fFlatRoots.clear();
+
+   for (UInt_t itree=0; itree<fForest.size(); itree++) {
+      Int_t root = fForest[itree]->GetRoot()
+         ? FlattenNode(fForest[itree]->GetRoot(), fForest[itree]->DoRegression()) : -1;
+      if (root < 0) {
+         Log() << kDEBUG << "the forest is evaluated without the flat copy of its nodes" << Endl;
+         fFlatNodes.clear();
+         fFlatRoots.clear();
+         return;
+      }
+      fFlatRoots.push_back(root);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append the node n and its daughters to fFlatNodes, and return the index of
+/// n, or -1 if the node cannot be represented (Fisher cut, missing daughter).
+/// As in DecisionTree::CheckEvent, the nodes of non-zero type are leaves.
+
+Int_t TMVA::MethodBDT::FlattenNode( const DecisionTreeNode *n, Bool_t regression )
+{
+   Int_t index = fFlatNodes.size();
+   FlatNode flat;
+   if (n->GetNodeType() != 0) {
+      flat.fValue    = regression ? n->GetResponse() : n->GetPurity();
+      flat.fSelector = -1;
+      flat.fNodeType = regression ? 0 : n->GetNodeType();
+      flat.fPass     = 0;
+      fFlatNodes.push_back(flat);
+      return index;
+   }
+
+   const DecisionTreeNode* right = (const DecisionTreeNode*)n->GetRight();
+   const DecisionTreeNode* left  = (const DecisionTreeNode*)n->GetLeft();
+   if (n->GetNFisherCoeff() != 0 || n->GetSelector() < 0 || !right || !left) return -1;
+
+   flat.fValue    = n->GetCutValue();
+   flat.fSelector = n->GetSelector();
+   flat.fNodeType = 0;
+   flat.fPass     = 0;
+   fFlatNodes.push_back(flat);
+
+   // the cut type is folded into the order of the daughters
+   const DecisionTreeNode* pass = n->GetCutType() ? right : left;
+   const DecisionTreeNode* fail = n->GetCutType() ? left  : right;
+   if (FlattenNode(fail, regression) < 0) return -1;
+   Int_t ipass = FlattenNode(pass, regression);
+   if (ipass < 0) return -1;
+   fFlatNodes[index].fPass = ipass;
+   return index;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get the multiclass MVA response for the BDT classifier.
 
@@ -2394,8 +2573,9 @@ const std::vector<Float_t>& TMVA::MethodBDT::GetMulticlassValues()
    // trees 0, nClasses, 2*nClasses, ... belong to class 0
    // trees 1, nClasses+1, 2*nClasses+1, ... belong to class 1 and so forth
    UInt_t classOfTree = 0;
+   const Float_t* values = HasFlatForest(forestSize) ? e->GetValues().data() : 0;
    for (UInt_t itree = 0; itree < forestSize; ++itree) {
-      temp[classOfTree] += fForest[itree]->CheckEvent(e, kFALSE);
+      temp[classOfTree] += values ? GetFlatTreeResponse(itree, values, 1, kFALSE) : fForest[itree]->CheckEvent(e, kFALSE);
       if (++classOfTree == nClasses) classOfTree = 0; // cheap modulo
    }
 
@@ -2639,8 +2819,16 @@ void TMVA::MethodBDT::MakeClassSpecific( std::ostream& fout, const TString& clas
    nodeName.ReplaceAll("Read","");
    nodeName.Append("Node");
    // write BDT-specific classifier response
-   fout << "   std::vector<"<<nodeName<<"*> fForest;       // i.e. root nodes of decision trees" << std::endl;
-   fout << "   std::vector<double>                fBoostWeights; // the weights applied in the individual boosts" << std::endl;
+   if (fMakeClassUnrolled) {
+      fout << "   // the decision trees, written as nested if/else statements" << std::endl;
+      for (UInt_t itree=0; itree<GetNTrees(); itree++) {
+         fout << "   double Tree" << itree << "( const std::vector<double>& inputValues ) const;" << std::endl;
+      }
+   }
+   else {
+      fout << "   std::vector<"<<nodeName<<"*> fForest;       // i.e. root nodes of decision trees" << std::endl;
+      fout << "   std::vector<double>                fBoostWeights; // the weights applied in the individual boosts" << std::endl;
+   }
    fout << "};" << std::endl << std::endl;
    fout << "double " << className << "::GetMvaValue__( const std::vector<double>& inputValues ) const" << std::endl;
    fout << "{" << std::endl;
@@ -2662,6 +2850,43 @@ void TMVA::MethodBDT::MakeClassSpecific( std::ostream& fout, const TString& clas
       }
    }
 
+   if (fMakeClassUnrolled) {
+      // the response of each tree and the boost weights are written out in full precision
+      std::streamsize precision = fout.precision();
+      fout << std::setprecision(17);
+      Double_t norm = 0;
+      for (UInt_t itree=0; itree<GetNTrees(); itree++) {
+         if (fBoostType=="Grad") {
+            fout << "   myMVA += Tree" << itree << "(inputValues);" << std::endl;
+         }
+         else {
+            fout << "   myMVA += " << fBoostWeights[itree] << " * Tree" << itree << "(inputValues);" << std::endl;
+            norm += fBoostWeights[itree];
+         }
+      }
+      if (fBoostType=="Grad") fout << "   return 2.0/(1.0+exp(-2.0*myMVA))-1.0;" << std::endl;
+      else                    fout << "   return myMVA / " << norm << ";" << std::endl;
+      fout << "}" << std::endl << std::endl;
+
+      for (UInt_t itree=0; itree<GetNTrees(); itree++) {
+         fout << "double " << className << "::Tree" << itree << "( const std::vector<double>& inputValues ) const" << std::endl;
+         fout << "{" << std::endl;
+         MakeClassUnrolledNode(fForest[itree]->GetRoot(), fout, 1);
+         fout << "}" << std::endl << std::endl;
+      }
+      fout.precision(precision);
+
+      fout << "void " << className << "::Initialize()" << std::endl;
+      fout << "{" << std::endl;
+      fout << "}" << std::endl;
+      fout << " " << std::endl;
+      fout << "// Clean up" << std::endl;
+      fout << "inline void " << className << "::Clear() " << std::endl;
+      fout << "{" << std::endl;
+      fout << "}" << std::endl;
+      return;
+   }
+
    if (fBoostType!="Grad"){
       fout << "   double norm  = 0;" << std::endl;
    }
@@ -2711,6 +2936,9 @@ void TMVA::MethodBDT::MakeClassSpecific( std::ostream& fout, const TString& clas
 
 void TMVA::MethodBDT::MakeClassSpecificHeader(  std::ostream& fout, const TString& className) const
 {
+   // the unrolled trees do not need the node class
+   if (fMakeClassUnrolled) return;
+
    TString nodeName = className;
    nodeName.ReplaceAll("Read","");
    nodeName.Append("Node");
@@ -2860,6 +3088,52 @@ void TMVA::MethodBDT::MakeClassInstantiateNode( DecisionTreeNode *n, std::ostrea
         << n->GetResponse() << ") ";
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Recursively descends a tree and writes it as nested if/else statements
+/// returning the response of the leaves, with the cuts of DecisionTree::CheckEvent.
+/// The cut values are written as float literals, such that the comparisons
+/// with the input values are the same as in the training.
+
+void TMVA::MethodBDT::MakeClassUnrolledNode( const DecisionTreeNode *n, std::ostream& fout, UInt_t depth ) const
+{
+   if (n == NULL) {
+      Log() << kFATAL << "MakeClassUnrolledNode: started with undefined node" <<Endl;
+      return ;
+   }
+   TString indent(' ', 3*depth);
+
+   if (n->GetNodeType() != 0) {
+      Double_t response;
+      if (fBoostType=="Grad")  response = n->GetResponse();
+      else if (fUseYesNoLeaf)  response = n->GetNodeType();
+      else                     response = n->GetPurity();
+      fout << indent << "return " << response << ";" << std::endl;
+      return;
+   }
+
+   fout << indent << "if (";
+   if (n->GetNFisherCoeff() == 0) {
+      fout << "inputValues[" << n->GetSelector() << "] >= ";
+   }
+   else {
+      fout << n->GetFisherCoeff(n->GetNFisherCoeff()-1);
+      for (UInt_t ivar=0; ivar<n->GetNFisherCoeff()-1; ivar++)
+         fout << " + " << n->GetFisherCoeff(ivar) << "*inputValues[" << ivar << "]";
+      fout << " > ";
+   }
+   fout << std::scientific << std::setprecision(8) << n->GetCutValue() << "f";
+   fout.unsetf(std::ios::floatfield);
+   fout << std::setprecision(17) << ") {" << std::endl;
+
+   const DecisionTreeNode* pass = (const DecisionTreeNode*)(n->GetCutType() ? n->GetRight() : n->GetLeft());
+   const DecisionTreeNode* fail = (const DecisionTreeNode*)(n->GetCutType() ? n->GetLeft()  : n->GetRight());
+   MakeClassUnrolledNode(pass, fout, depth+1);
+   fout << indent << "}" << std::endl;
+   fout << indent << "else {" << std::endl;
+   MakeClassUnrolledNode(fail, fout, depth+1);
+   fout << indent << "}" << std::endl;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Find useful preselection cuts that will be applied before
 /// and Decision Tree training.. (and of course also applied
@@ -841,6 +841,47 @@ Double_t TMVA::MethodBase::GetMvaValue( const Event* const ev, Double_t* err, Do
    return val;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Classification response for a batch of nEvents events, whose input values
+/// are given in column-major order: the value of variable ivar of event ievt
+/// is values[ivar*nEvents + ievt]. The responses are written to mvaValues.
+///
+/// Methods with a batch response (HasBatchResponse) evaluate all the events
+/// at once without modifying their state, after the transformation of the
+/// input. The other methods evaluate the events one at a time. The steps using
+/// the state of the method (the variable transformations, which keep their
+/// output event, and the evaluation of the other methods) are serialized, so
+/// that several threads can evaluate batches with the same method.
+
+void TMVA::MethodBase::GetMvaValuesBatch( const Float_t* values, Long64_t nEvents, Double_t* mvaValues )
+{
+   UInt_t nvar = GetNvar();
+   Event ev(std::vector<Float_t>(nvar), 0);
+
+   if (!HasBatchResponse()) {
+      std::lock_guard<std::mutex> guard(fBatchMutex);
+      for (Long64_t ievt = 0; ievt < nEvents; ievt++) {
+         for (UInt_t ivar = 0; ivar < nvar; ivar++) ev.SetVal(ivar, values[ivar*nEvents + ievt]);
+         mvaValues[ievt] = GetMvaValue(&ev);
+      }
+      return;
+   }
+
+   std::vector<Float_t> transformed;
+   if (GetTransformationHandler().GetNumOfTransformations() > 0) {
+      transformed.resize(nvar*nEvents);
+      std::lock_guard<std::mutex> guard(fBatchMutex);
+      for (Long64_t ievt = 0; ievt < nEvents; ievt++) {
+         for (UInt_t ivar = 0; ivar < nvar; ivar++) ev.SetVal(ivar, values[ivar*nEvents + ievt]);
+         const Event* tev = GetTransformationHandler().Transform(&ev);
+         for (UInt_t ivar = 0; ivar < nvar; ivar++) transformed[ivar*nEvents + ievt] = tev->GetValue(ivar);
+      }
+      values = transformed.data();
+   }
+
+   GetBatchResponse(values, nEvents, mvaValues);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// uses a pre-set cut on the MVA output (SetSignalReferenceCut and SetSignalReferenceCutOrientation)
 /// for a quick determination if an event would be selected as signal or background
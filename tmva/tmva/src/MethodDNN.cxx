@@ -926,14 +926,17 @@ void TMVA::MethodDNN::TrainGpu()
       }
 
       size_t nThreads = 1;
+      // two buffers per thread, such that the next batch is prepared on
+      // the host and transferred while the device works on the current one
+      size_t nStreams = 2 * nThreads;
       TMVAInput_t trainingTuple = std::tie(trainingInputData, DataInfo());
       TMVAInput_t testTuple = std::tie(testInputData, DataInfo());
       DataLoader_t trainingData(trainingTuple, nTrainingSamples,
                                 net.GetBatchSize(), net.GetInputWidth(),
-                                net.GetOutputWidth(), nThreads);
+                                net.GetOutputWidth(), nStreams);
       DataLoader_t testData(testTuple, nTestSamples, testNet.GetBatchSize(),
                             net.GetInputWidth(), net.GetOutputWidth(),
-                            nThreads);
+                            nStreams);
       DNN::TGradientDescent<TCuda<>> minimizer(settings.learningRate,
                                              settings.convergenceSteps,
                                              settings.testInterval);
@@ -1263,6 +1266,32 @@ Double_t TMVA::MethodDNN::GetMvaValue( Double_t* /*errLower*/, Double_t* /*errUp
    return YHat(0,0);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// MVA values of a batch of events (see MethodBase::GetMvaValuesBatch). The
+/// events are propagated through a copy of the network, as the rows of the input
+/// matrix, in groups of at most 1024 events.
+
+void TMVA::MethodDNN::GetBatchResponse( const Float_t* values, Long64_t nEvents, Double_t* mvaValues ) const
+{
+   const Long64_t maxBatchSize = 1024;
+   size_t nVariables = GetNvar();
+
+   for (Long64_t first = 0; first < nEvents; first += maxBatchSize) {
+      size_t batchSize = std::min(maxBatchSize, nEvents - first);
+      Net_t net(batchSize, fNet);
+      Matrix_t X(batchSize, nVariables);
+      Matrix_t YHat(batchSize, 1);
+
+      for (size_t i = 0; i < nVariables; i++) {
+         const Float_t* column = values + i*nEvents + first;
+         for (size_t ievt = 0; ievt < batchSize; ievt++) X(ievt,i) = column[ievt];
+      }
+
+      net.Prediction(YHat, X, fOutputFunction);
+      for (size_t ievt = 0; ievt < batchSize; ievt++) mvaValues[first + ievt] = YHat(ievt,0);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 const std::vector<Float_t> & TMVA::MethodDNN::GetRegressionValues()
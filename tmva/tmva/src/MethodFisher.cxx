@@ -124,6 +124,7 @@ The corresponding numbers are printed on standard output.
 
 #include <iomanip>
 #include <cassert>
+#include <algorithm>
 
 REGISTER_METHOD(Fisher)
 
@@ -279,6 +280,21 @@ Double_t TMVA::MethodFisher::GetMvaValue( Double_t* err, Double_t* errUpper )
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// returns the Fisher value of a batch of events (see MethodBase::GetMvaValuesBatch),
+/// one variable at a time for all the events
+
+void TMVA::MethodFisher::GetBatchResponse( const Float_t* values, Long64_t nEvents, Double_t* mvaValues ) const
+{
+   std::fill(mvaValues, mvaValues + nEvents, fF0);
+   for (UInt_t ivar=0; ivar<GetNvar(); ivar++) {
+      Double_t coeff = (*fFisherCoeff)[ivar];
+      const Float_t* column = values + ivar*nEvents;
+      for (Long64_t ievt=0; ievt<nEvents; ievt++)
+         mvaValues[ievt] += coeff*column[ievt];
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// initialization method; creates global matrices and vectors
 
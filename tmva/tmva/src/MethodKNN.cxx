@@ -33,6 +33,7 @@ Analysis of k-nearest neighbor.
 #include "TMVA/MethodKNN.h"
 
 #include "TMVA/ClassifierFactory.h"
+#include "TMVA/Config.h"
 #include "TMVA/Configurable.h"
 #include "TMVA/DataSetInfo.h"
 #include "TMVA/Event.h"
@@ -41,6 +42,7 @@ Analysis of k-nearest neighbor.
 #include "TMVA/MethodBase.h"
 #include "TMVA/MsgLogger.h"
 #include "TMVA/Ranking.h"
+#include "TMVA/Timer.h"
 #include "TMVA/Tools.h"
 #include "TMVA/Types.h"
 
@@ -48,6 +50,7 @@ Analysis of k-nearest neighbor.
 #include "TMath.h"
 #include "TTree.h"
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <cstdlib>
@@ -56,6 +59,11 @@ REGISTER_METHOD(KNN)
 
 ClassImp(TMVA::MethodKNN);
 
+namespace {
+// events per task of the batch evaluation
+const Long64_t kBatchChunkSize = 256;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// standard constructor
 
@@ -326,6 +334,18 @@ Double_t TMVA::MethodKNN::GetMvaValue( Double_t* err, Double_t* errUpper )
 
    if (fUseLDA) return MethodKNN::getLDAValue(rlist, event_knn);
 
+   return MethodKNN::getkNNValue(rlist, event_knn, kTRUE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Classifier response from the list of nearest neighbors of event_knn.
+/// The informational messages are only printed if verbose is set, since the
+/// batch evaluation calls this function from several threads
+
+Double_t TMVA::MethodKNN::getkNNValue(const kNN::List &rlist, const kNN::Event &event_knn, Bool_t verbose) const
+{
+   const UInt_t knn = static_cast<UInt_t>(fnkNN);
+
    //
    // Set flags for kernel option=Gaus, Poln
    //
@@ -376,7 +396,7 @@ Double_t TMVA::MethodKNN::GetMvaValue( Double_t* err, Double_t* errUpper )
       if (lit->second < 0.0) {
          Log() << kFATAL << "A neighbor has negative distance to query event" << Endl;
       }
-      else if (!(lit->second > 0.0)) {
+      else if (!(lit->second > 0.0) && verbose) {
          Log() << kVERBOSE << "A neighbor has zero distance to query event" << Endl;
       }
 
@@ -415,7 +435,7 @@ Double_t TMVA::MethodKNN::GetMvaValue( Double_t* err, Double_t* errUpper )
    }
 
    // check that number of events matches number of k in knn
-   if (count_all < knn) {
+   if (count_all < knn && verbose) {
       Log() << kDEBUG << "count_all and kNN have different size: " << count_all << " < " << knn << Endl;
    }
 
@@ -428,6 +448,95 @@ Double_t TMVA::MethodKNN::GetMvaValue( Double_t* err, Double_t* errUpper )
    return weight_sig/weight_all;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Classifier response for a batch of events (see MethodBase::GetMvaValuesBatch).
+/// The searches of the nearest neighbors of the events, which take most of the
+/// time, are independent and run in parallel when ROOT is built with imt
+
+void TMVA::MethodKNN::GetBatchResponse(const Float_t* values, Long64_t nEvents, Double_t* mvaValues) const
+{
+   const UInt_t nvar = GetNVariables();
+   const UInt_t knn = static_cast<UInt_t>(fnkNN);
+   const Long64_t nChunks = (nEvents + kBatchChunkSize - 1)/kBatchChunkSize;
+
+   auto evaluateChunk = [&](UInt_t ichunk) {
+      kNN::VarVec vvec(nvar, 0.0);
+      kNN::List rlist;
+
+      const Long64_t end = std::min(nEvents, (ichunk + 1)*kBatchChunkSize);
+      for (Long64_t ievt = ichunk*kBatchChunkSize; ievt < end; ++ievt) {
+         for (UInt_t ivar = 0; ivar < nvar; ++ivar) vvec[ivar] = values[ivar*nEvents + ievt];
+
+         const kNN::Event event_knn(vvec, 1.0, 3);
+         fModule->Find(event_knn, knn + 2, rlist);
+
+         if (rlist.size() != knn + 2) {
+            Log() << kFATAL << "kNN result list is empty" << Endl;
+            mvaValues[ievt] = -100.0;
+            continue;
+         }
+
+         mvaValues[ievt] = MethodKNN::getkNNValue(rlist, event_knn, kFALSE);
+      }
+   };
+
+#ifdef R__USE_IMT
+   TMVA::Config::Instance().GetThreadExecutor().Foreach(evaluateChunk, ROOT::TSeqI(nChunks));
+#else
+   for (Long64_t ichunk = 0; ichunk < nChunks; ++ichunk) evaluateChunk(ichunk);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Classifier response for the events of the current data type: the input
+/// values of the events are collected and evaluated in batches with
+/// GetBatchResponse, instead of one event at a time
+
+std::vector<Double_t> TMVA::MethodKNN::GetMvaValues(Long64_t firstEvt, Long64_t lastEvt, Bool_t logProgress)
+{
+   if (!HasBatchResponse()) return MethodBase::GetMvaValues(firstEvt, lastEvt, logProgress);
+
+   Long64_t nEvents = Data()->GetNEvents();
+   if (firstEvt > lastEvt || lastEvt > nEvents) lastEvt = nEvents;
+   if (firstEvt < 0) firstEvt = 0;
+   std::vector<Double_t> values(lastEvt-firstEvt);
+   nEvents = values.size();
+
+   // use timer
+   Timer timer( nEvents, GetName(), kTRUE );
+
+   if (logProgress)
+      Log() << kHEADER << Form("[%s] : ",DataInfo().GetName()) << "Evaluation of " << GetMethodName() << " on "
+            << (Data()->GetCurrentType()==Types::kTraining?"training":"testing") << " sample (" << nEvents << " events)" << Endl;
+
+   const UInt_t nvar = GetNVariables();
+   const Long64_t batchSize = 16*kBatchChunkSize;
+   std::vector<Float_t> batch;
+
+   for (Long64_t first = 0; first < nEvents; first += batchSize) {
+      const Long64_t n = std::min(batchSize, nEvents - first);
+
+      // GetEvent applies the variable transformations, it is not thread safe
+      batch.resize(nvar*n);
+      for (Long64_t ievt = 0; ievt < n; ++ievt) {
+         Data()->SetCurrentEvent(firstEvt + first + ievt);
+         const Event *ev = GetEvent();
+         for (UInt_t ivar = 0; ivar < nvar; ++ivar) batch[ivar*n + ievt] = ev->GetValue(ivar);
+      }
+
+      GetBatchResponse(batch.data(), n, &values[first]);
+
+      if (logProgress) timer.DrawProgressBar( first + n - 1 );
+   }
+
+   if (logProgress) {
+      Log() << kINFO << "Elapsed time for evaluation of " << nEvents <<  " events: "
+            << timer.GetElapsedTime() << "       " << Endl;
+   }
+
+   return values;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return vector of averages for target values of k-nearest neighbors.
 /// Use own copy of the regression vector, I do not like using a pointer to vector.
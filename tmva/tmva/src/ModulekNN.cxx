@@ -31,6 +31,7 @@
 
 #include "TMVA/ModulekNN.h"
 
+#include "TMVA/Config.h"
 #include "TMVA/MsgLogger.h"
 #include "TMVA/Types.h"
 
@@ -319,9 +320,46 @@ Bool_t TMVA::kNN::ModulekNN::Fill(const UShort_t odepth, const UInt_t ifrac, con
       return kFALSE;
    }
 
-   for (EventVec::const_iterator event = fEvent.begin(); event != fEvent.end(); ++event) {
-      fTree->Add(*event, 0);
+   // route the events through the balanced top levels of the tree, in their
+   // order, and collect the events that end in each of the bottom nodes
+   std::vector<Node<Event> *> leaves;
+   std::vector<UInt_t> depths;
+   std::vector<std::vector<UInt_t> > ievents;
+   std::map<Node<Event> *, UInt_t> ileaf;
+
+   for (UInt_t ievent = 0; ievent < fEvent.size(); ++ievent) {
+      Node<Event> *node = fTree;
+      UInt_t depth = 0;
+      while (node->GetNodeL() && node->GetNodeR()) {
+         node = node->Route(fEvent[ievent]);
+         ++depth;
+      }
+
+      std::map<Node<Event> *, UInt_t>::const_iterator lit = ileaf.find(node);
+      if (lit == ileaf.end()) {
+         lit = ileaf.insert(std::make_pair(node, UInt_t(leaves.size()))).first;
+         leaves.push_back(node);
+         depths.push_back(depth);
+         ievents.push_back(std::vector<UInt_t>());
+      }
+      ievents[lit->second].push_back(ievent);
+   }
 
+   // the sub-trees below the bottom nodes are independent: fill them in parallel,
+   // which gives the same tree as adding all events one by one from the root node
+   auto fillLeaf = [&](UInt_t i) {
+      for (std::vector<UInt_t>::const_iterator iev = ievents[i].begin(); iev != ievents[i].end(); ++iev) {
+         leaves[i]->Add(fEvent[*iev], depths[i]);
+      }
+   };
+
+#ifdef R__USE_IMT
+   TMVA::Config::Instance().GetThreadExecutor().Foreach(fillLeaf, ROOT::TSeqI(leaves.size()));
+#else
+   for (UInt_t i = 0; i < leaves.size(); ++i) fillLeaf(i);
+#endif
+
+   for (EventVec::const_iterator event = fEvent.begin(); event != fEvent.end(); ++event) {
       std::map<Short_t, UInt_t>::iterator cit = fCount.find(event->GetType());
       if (cit == fCount.end()) {
          fCount[event->GetType()] = 1;
@@ -346,6 +384,24 @@ Bool_t TMVA::kNN::ModulekNN::Fill(const UShort_t odepth, const UInt_t ifrac, con
 /// using previously computed width of variable distribution
 
 Bool_t TMVA::kNN::ModulekNN::Find(Event event, const UInt_t nfind, const std::string &option) const
+{
+   if (!Find(event, nfind, fkNNList, option)) {
+      return kFALSE;
+   }
+
+   // latest event for k-nearest neighbor search
+   fkNNEvent = (fVarScale.empty() ? event : Scale(event));
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// find in tree the nfind closest events to event and store them in nlist;
+/// unlike the method above, it does not change the state of the module and
+/// can be called concurrently from several threads
+
+Bool_t TMVA::kNN::ModulekNN::Find(const Event &event, const UInt_t nfind, List &nlist,
+                                  const std::string &option) const
 {
    if (!fTree) {
       Log() << kFATAL << "ModulekNN::Find() - tree has not been filled" << Endl;
@@ -360,28 +416,24 @@ Bool_t TMVA::kNN::ModulekNN::Find(Event event, const UInt_t nfind, const std::st
       return kFALSE;
    }
 
+   nlist.clear();
+
    // if variable widths are computed then rescale variable in this event
    // to same widths as events in stored kd-tree
-   if (!fVarScale.empty()) {
-      event = Scale(event);
-   }
-
-   // latest event for k-nearest neighbor search
-   fkNNEvent = event;
-   fkNNList.clear();
+   const Event sevent = (fVarScale.empty() ? event : Scale(event));
 
    if(option.find("weight") != std::string::npos)
       {
          // recursive kd-tree search for nfind-nearest neighbors
          // use event weight to find all nearest events
          // that have sum of weights >= nfind
-         kNN::Find<kNN::Event>(fkNNList, fTree, event, Double_t(nfind), 0.0);
+         kNN::Find<kNN::Event>(nlist, fTree, sevent, Double_t(nfind), 0.0);
       }
    else
       {
          // recursive kd-tree search for nfind-nearest neighbors
          // count nodes and do not use event weight
-         kNN::Find<kNN::Event>(fkNNList, fTree, event, nfind);
+         kNN::Find<kNN::Event>(nlist, fTree, sevent, nfind);
       }
 
    return kTRUE;
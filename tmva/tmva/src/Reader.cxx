@@ -119,6 +119,7 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <algorithm>
 
 #include <iostream>
 
@@ -509,6 +510,42 @@ Double_t TMVA::Reader::EvaluateMVA( const std::vector<Float_t>& inputVec, const
    return val;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate a batch of nEvents events for a given method. The input values are
+/// given in column-major order: the value of variable ivar of event ievt is
+/// values[ivar*nEvents + ievt]. The MVA values are written to mvaValues, -999
+/// for the events with a NaN input. This does not use the state of the reader,
+/// so that it can be called from several threads at the same time, see
+/// MethodBase::GetMvaValuesBatch. The BDT, MLP, DNN and Fisher methods evaluate
+/// the batch at once, the other methods one event at a time.
+
+void TMVA::Reader::EvaluateMVA( const Float_t* values, Long64_t nEvents, const TString& methodTag, Double_t* mvaValues )
+{
+   IMethod* imeth = FindMVA( methodTag );
+   MethodBase* meth = dynamic_cast<TMVA::MethodBase*>(imeth);
+   if (meth==0) {
+      std::fill(mvaValues, mvaValues + nEvents, 0.);
+      return;
+   }
+
+   meth->GetMvaValuesBatch( values, nEvents, mvaValues );
+
+   UInt_t nvar = DataInfo().GetNVariables();
+   Long64_t nNaN = 0;
+   for (Long64_t ievt = 0; ievt < nEvents; ievt++) {
+      for (UInt_t ivar = 0; ivar < nvar; ivar++) {
+         if (TMath::IsNaN(values[ivar*nEvents + ievt])) {
+            mvaValues[ievt] = -999;
+            nNaN++;
+            break;
+         }
+      }
+   }
+   if (nNaN > 0) {
+      Log() << kERROR << nNaN << " events of the batch have a NaN variable --> return MVA value -999 for them, \n that's all I can do, please fix or remove these events." << Endl;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Evaluate a std::vector<double> of input data for a given method
 /// The parameter aux is obligatory for the cuts method where it represents the efficiency cutoff
@@ -205,6 +205,17 @@ const std::vector<TMVA::Event*>* TMVA::TransformationHandler::CalcTransformation
    if (fTransformations.GetEntries() <= 0)
       return &events;
 
+   // a single transformation whose result is not kept is prepared on the
+   // original events, and the statistics and plots are filled by transforming
+   // one event at a time, instead of transforming a copy of all events
+   if (!createNewVector && fTransformations.GetEntries() == 1) {
+      VariableTransformBase *trf = (VariableTransformBase*) fTransformations.First();
+      Bool_t prepared = trf->PrepareTransformation(events);
+      CalcStats(events, prepared);
+      PlotVariables(events, 0, prepared);
+      return 0;
+   }
+
    // the transformedEvents are initialised with the initial events and then
    // subsequently replaced with transformed ones. The n-th transformation will
    // and on the events as they look like after the (n-1)-the transformation
@@ -243,9 +254,10 @@ const std::vector<TMVA::Event*>* TMVA::TransformationHandler::CalcTransformation
 
 ////////////////////////////////////////////////////////////////////////////////
 /// method to calculate minimum, maximum, mean, and RMS for all
-/// variables used in the MVA
+/// variables used in the MVA; if transform is set, each event is passed
+/// through the transformations before being used
 
-void TMVA::TransformationHandler::CalcStats (const std::vector<Event*>& events )
+void TMVA::TransformationHandler::CalcStats (const std::vector<Event*>& events, Bool_t transform )
 {
    UInt_t nevts = events.size();
 
@@ -253,8 +265,9 @@ void TMVA::TransformationHandler::CalcStats (const std::vector<Event*>& events )
       Log() << kFATAL << "No events available to find min, max, mean and rms" << Endl;
 
    // if transformation has not been succeeded, the tree may be empty
-   const UInt_t nvar = events[0]->GetNVariables();
-   const UInt_t ntgt = events[0]->GetNTargets();
+   const Event* firstEvent = transform ? Transform(events[0]) : events[0];
+   const UInt_t nvar = firstEvent->GetNVariables();
+   const UInt_t ntgt = firstEvent->GetNTargets();
 
    Double_t  *sumOfWeights = new Double_t[fNumC];
    Double_t* *x2           = new Double_t*[fNumC];
@@ -276,7 +289,7 @@ void TMVA::TransformationHandler::CalcStats (const std::vector<Event*>& events )
    }
 
    for (UInt_t ievt=0; ievt<nevts; ievt++) {
-      const Event* ev  = events[ievt];
+      const Event* ev  = transform ? Transform(events[ievt]) : events[ievt];
       Int_t  cls = ev->GetClass();
 
       Double_t weight = ev->GetWeight();
@@ -446,8 +459,11 @@ TString TMVA::TransformationHandler::GetVariableAxisTitle( const VariableInfo& i
 /// create histograms from the input variables
 ///  - histograms for all input variables
 ///  - scatter plots for all pairs of input variables
+///
+/// if transform is set, each event is passed through the transformations
+/// before being used
 
-void TMVA::TransformationHandler::PlotVariables (const std::vector<Event*>& events, TDirectory* theDirectory )
+void TMVA::TransformationHandler::PlotVariables (const std::vector<Event*>& events, TDirectory* theDirectory, Bool_t transform )
 {
    if (fRootBaseDir==0 && theDirectory == 0) return;
 
@@ -461,7 +477,7 @@ void TMVA::TransformationHandler::PlotVariables (const std::vector<Event*>& even
       transfType += "_";
       transfType += GetName();
    }else{ // you plot for the individual classifiers. Note, here the "statistics" still need to be calculated as you are in the testing phase
-      CalcStats(events);
+      CalcStats(events, transform);
    }
 
    const UInt_t nvar = fDataSetInfo.GetNVariables();
@@ -621,7 +637,7 @@ void TMVA::TransformationHandler::PlotVariables (const std::vector<Event*>& even
    // fill the histograms (this approach should be faster than individual projection
    for (UInt_t ievt=0; ievt<nevts; ievt++) {
 
-      const Event* ev = events[ievt];
+      const Event* ev = transform ? Transform(events[ievt]) : events[ievt];
 
       Float_t weight = ev->GetWeight();
       Int_t   cls    = ev->GetClass();
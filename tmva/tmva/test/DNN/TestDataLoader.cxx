@@ -32,6 +32,9 @@ int main ()
    error = testIdentity<TReference<Scalar_t>>();
    std::cout << "Identity: Maximum relative error = " << error << std::endl;
    maximumError = std::max(error, maximumError);
+   error = testTreeSum<TReference<Scalar_t>>();
+   std::cout << "Tree sum: Maximum relative error = " << error << std::endl;
+   maximumError = std::max(error, maximumError);
 
    if (maximumError > 1e-3) {
       return 1;
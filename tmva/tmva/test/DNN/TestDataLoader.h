@@ -15,6 +15,8 @@
 
 #include "TMVA/DNN/Net.h"
 #include "TMVA/DNN/DataLoader.h"
+#include "TMVA/DNN/TreeDataLoader.h"
+#include "TTree.h"
 #include "Utility.h"
 
 namespace TMVA
@@ -97,5 +99,55 @@ auto testIdentity()
    return maximumError;
 }
 
+/** Test that the streaming data loader reads all the entries of a tree in
+ *  each epoch, by summing up all elements batch wise and comparing to the sum
+ *  over the complete tree.
+ */
+//______________________________________________________________________________
+template <typename Architecture_t>
+auto testTreeSum()
+    -> typename Architecture_t::Scalar_t
+{
+   using Scalar_t     = typename Architecture_t::Scalar_t;
+   using Matrix_t     = typename Architecture_t::Matrix_t;
+   using DataLoader_t = TTreeDataLoader<Architecture_t>;
+
+   Long64_t nEntries = 10000;
+   Double_t x = 0;
+   TTree tree("tree", "tree");
+   tree.SetDirectory(nullptr);
+   tree.Branch("x", &x, "x/D");
+   tree.SetAutoFlush(1000);
+   for (Long64_t i = 0; i < nEntries; i++) {
+      x = i;
+      tree.Fill();
+   }
+
+   // windows do not contain whole clusters, and all batches are complete
+   DataLoader_t loader(&tree, {"x"}, {"2 * x"}, "x + 1", 5, 1234);
+
+   Matrix_t Sum(1, 1);
+   Scalar_t sumTotal = 4.0 * 0.5 * nEntries * (nEntries - 1) + nEntries;
+   Scalar_t maximumError = 0.0;
+
+   for (size_t epoch = 0; epoch < 2; epoch++) {
+      Scalar_t sum = 0.0;
+      loader.StartEpoch();
+      while (loader.NextWindow()) {
+         for (auto b : loader) {
+            Architecture_t::SumColumns(Sum, b.GetInput());
+            sum += Sum(0, 0);
+            Architecture_t::SumColumns(Sum, b.GetOutput());
+            sum += Sum(0, 0);
+            Architecture_t::SumColumns(Sum, b.GetWeights());
+            sum += Sum(0, 0);
+         }
+      }
+      maximumError = std::max(maximumError, Scalar_t(fabs(sumTotal - sum) / sumTotal));
+   }
+
+   return maximumError;
+}
+
 } // namespace DNN
 } // namespace TMVA
@@ -32,6 +32,9 @@ int main ()
    error = testIdentity<TCpu<Scalar_t>>();
    std::cout << "Identity: Maximum relative error = " << error << std::endl;
    maximumError = std::max(error, maximumError);
+   error = testTreeSum<TCpu<Scalar_t>>();
+   std::cout << "Tree sum: Maximum relative error = " << error << std::endl;
+   maximumError = std::max(error, maximumError);
 
    if (maximumError > 1e-3) {
       return 1;
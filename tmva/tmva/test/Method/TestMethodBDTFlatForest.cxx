@@ -0,0 +1,116 @@
+// @(#)root/tmva $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "TMVA/DataLoader.h"
+#include "TMVA/DecisionTree.h"
+#include "TMVA/Event.h"
+#include "TMVA/Factory.h"
+#include "TMVA/MethodBDT.h"
+#include "TMVA/Reader.h"
+#include "TMVA/Types.h"
+
+#include "TFile.h"
+#include "TMath.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+//
+// Verifies that the response of the flat copy of the forest, used by the
+// Reader, is the same as the response obtained by descending the trees.
+//
+
+namespace {
+
+const UInt_t kNVariables = 3;
+
+struct FlatForestContext {
+
+   FlatForestContext()
+   {
+      TFile outputFile("TMVABDTFlatForest.root", "RECREATE");
+      TMVA::Factory factory("TMVABDTFlatForest", &outputFile, "Silent:!V:!DrawProgressBar:AnalysisType=Classification");
+      TMVA::DataLoader dataLoader("dataset");
+      for (UInt_t ivar = 0; ivar < kNVariables; ivar++) {
+         dataLoader.AddVariable(Form("x%d", ivar), 'F');
+      }
+
+      TRandom3 rng(42);
+      for (Int_t i = 0; i < 2000; i++) {
+         for (Int_t cls = 0; cls < 2; cls++) {
+            std::vector<Double_t> event(kNVariables);
+            for (UInt_t ivar = 0; ivar < kNVariables; ivar++) {
+               event[ivar] = rng.Gaus(cls ? 0.5 : -0.5, 1.0 + ivar);
+            }
+            dataLoader.AddEvent(cls ? "Signal" : "Background", (i % 2) ? TMVA::Types::kTesting : TMVA::Types::kTraining,
+                                event, 1.0);
+         }
+      }
+      dataLoader.PrepareTrainingAndTestTree("", "SplitMode=Block:NormMode=NumEvents:!V");
+
+      factory.BookMethod(&dataLoader, TMVA::Types::kBDT, "BDT", "!H:!V:NTrees=50:BoostType=AdaBoost:!UseYesNoLeaf");
+      factory.BookMethod(&dataLoader, TMVA::Types::kBDT, "BDTG", "!H:!V:NTrees=50:BoostType=Grad:MaxDepth=4");
+      factory.TrainAllMethods();
+   }
+
+   void Compare(const char *methodName, Bool_t grad)
+   {
+      std::vector<Float_t> vars(kNVariables);
+      TMVA::Reader reader("!Color:Silent:!V");
+      for (UInt_t ivar = 0; ivar < kNVariables; ivar++) {
+         reader.AddVariable(Form("x%d", ivar), &vars[ivar]);
+      }
+      reader.BookMVA(methodName, Form("dataset/weights/TMVABDTFlatForest_%s.weights.xml", methodName));
+      TMVA::MethodBDT *bdt = dynamic_cast<TMVA::MethodBDT *>(reader.FindMVA(methodName));
+      ASSERT_NE(bdt, nullptr);
+
+      const std::vector<TMVA::DecisionTree *> &forest = bdt->GetForest();
+      const std::vector<double> &boostWeights = bdt->GetBoostWeights();
+
+      TRandom3 rng(7);
+      for (Int_t ievt = 0; ievt < 1000; ievt++) {
+         for (UInt_t ivar = 0; ivar < kNVariables; ivar++) {
+            vars[ivar] = rng.Gaus(0, 2);
+         }
+         TMVA::Event event(vars, 0);
+
+         Double_t sum = 0;
+         Double_t norm = 0;
+         for (UInt_t itree = 0; itree < forest.size(); itree++) {
+            Double_t weight = grad ? 1.0 : boostWeights[itree];
+            sum += weight * forest[itree]->CheckEvent(&event, kFALSE);
+            norm += weight;
+         }
+         Double_t expected = grad ? 2.0 / (1.0 + TMath::Exp(-2.0 * sum)) - 1 : sum / norm;
+
+         EXPECT_NEAR(reader.EvaluateMVA(methodName), expected, 1e-9) << methodName << " event " << ievt;
+      }
+   }
+};
+
+FlatForestContext &GetContext()
+{
+   static FlatForestContext context;
+   return context;
+}
+
+} // namespace
+
+TEST(MethodBDTFlatForest, AdaBoost)
+{
+   GetContext().Compare("BDT", kFALSE);
+}
+
+TEST(MethodBDTFlatForest, GradBoost)
+{
+   GetContext().Compare("BDTG", kTRUE);
+}
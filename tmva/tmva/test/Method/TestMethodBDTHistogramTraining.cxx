@@ -0,0 +1,70 @@
+// @(#)root/tmva $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "TMVA/DataLoader.h"
+#include "TMVA/Factory.h"
+#include "TMVA/Types.h"
+
+#include "TFile.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+//
+// Verifies that the trees grown from the binned variables (UseHistogramTraining)
+// separate signal and background as well as the ones of the standard training.
+//
+
+TEST(MethodBDTHistogramTraining, ROCIntegral)
+{
+   const UInt_t nVariables = 4;
+
+   TFile outputFile("TMVABDTHistogramTraining.root", "RECREATE");
+   TMVA::Factory factory("TMVABDTHistogramTraining", &outputFile,
+                         "Silent:!V:!DrawProgressBar:AnalysisType=Classification");
+   TMVA::DataLoader dataLoader("dataset");
+   for (UInt_t ivar = 0; ivar < nVariables; ivar++) {
+      dataLoader.AddVariable(Form("x%d", ivar), 'F');
+   }
+   dataLoader.AddVariable("n", 'I');
+
+   TRandom3 rng(42);
+   for (Int_t i = 0; i < 4000; i++) {
+      for (Int_t cls = 0; cls < 2; cls++) {
+         std::vector<Double_t> event(nVariables + 1);
+         for (UInt_t ivar = 0; ivar < nVariables; ivar++) {
+            event[ivar] = rng.Gaus(cls ? 0.3 : -0.3, 1.0 + ivar);
+         }
+         event[nVariables] = rng.Poisson(cls ? 3 : 2);
+         dataLoader.AddEvent(cls ? "Signal" : "Background", (i % 2) ? TMVA::Types::kTesting : TMVA::Types::kTraining,
+                             event, 1.0);
+      }
+   }
+   dataLoader.PrepareTrainingAndTestTree("", "SplitMode=Block:NormMode=NumEvents:!V");
+
+   factory.BookMethod(&dataLoader, TMVA::Types::kBDT, "BDT", "!H:!V:NTrees=100:BoostType=AdaBoost:nCuts=63");
+   factory.BookMethod(&dataLoader, TMVA::Types::kBDT, "BDTHist",
+                      "!H:!V:NTrees=100:BoostType=AdaBoost:nCuts=63:UseHistogramTraining");
+   factory.BookMethod(&dataLoader, TMVA::Types::kBDT, "BDTGHist",
+                      "!H:!V:NTrees=100:BoostType=Grad:UseBaggedBoost:nCuts=63:UseHistogramTraining");
+   factory.TrainAllMethods();
+   factory.TestAllMethods();
+   factory.EvaluateAllMethods();
+
+   Double_t rocStandard = factory.GetROCIntegral(&dataLoader, "BDT");
+   Double_t rocHist = factory.GetROCIntegral(&dataLoader, "BDTHist");
+   Double_t rocGradHist = factory.GetROCIntegral(&dataLoader, "BDTGHist");
+
+   EXPECT_GT(rocStandard, 0.7);
+   EXPECT_NEAR(rocHist, rocStandard, 0.02);
+   EXPECT_NEAR(rocGradHist, rocStandard, 0.03);
+}
@@ -0,0 +1,123 @@
+// @(#)root/tmva $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "TMVA/DataLoader.h"
+#include "TMVA/Factory.h"
+#include "TMVA/Reader.h"
+#include "TMVA/Types.h"
+
+#include "TFile.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+//
+// Trains a few methods and verifies that the batch evaluation of the Reader
+// gives the same MVA values as the evaluation of one event at a time.
+//
+
+namespace {
+
+const UInt_t kNVariables = 3;
+const Long64_t kNEvents = 1000;
+
+struct BatchEvaluationContext {
+
+   BatchEvaluationContext()
+   {
+      TFile outputFile("TMVAReaderBatch.root", "RECREATE");
+      TMVA::Factory factory("TMVAReaderBatch", &outputFile, "Silent:!V:!DrawProgressBar:AnalysisType=Classification");
+      TMVA::DataLoader dataLoader("dataset");
+      for (UInt_t ivar = 0; ivar < kNVariables; ivar++) {
+         dataLoader.AddVariable(Form("x%d", ivar), 'F');
+      }
+
+      TRandom3 rng(42);
+      for (Int_t i = 0; i < 2000; i++) {
+         for (Int_t cls = 0; cls < 2; cls++) {
+            std::vector<Double_t> event(kNVariables);
+            for (UInt_t ivar = 0; ivar < kNVariables; ivar++) {
+               event[ivar] = rng.Gaus(cls ? 0.5 : -0.5, 1.0 + ivar);
+            }
+            dataLoader.AddEvent(cls ? "Signal" : "Background", (i % 2) ? TMVA::Types::kTesting : TMVA::Types::kTraining,
+                                event, 1.0);
+         }
+      }
+      dataLoader.PrepareTrainingAndTestTree("", "SplitMode=Block:NormMode=NumEvents:!V");
+
+      factory.BookMethod(&dataLoader, TMVA::Types::kFisher, "Fisher", "!H:!V");
+      factory.BookMethod(&dataLoader, TMVA::Types::kBDT, "BDT", "!H:!V:NTrees=50:BoostType=AdaBoost");
+      factory.BookMethod(&dataLoader, TMVA::Types::kBDT, "BDTG", "!H:!V:NTrees=50:BoostType=Grad");
+      factory.BookMethod(&dataLoader, TMVA::Types::kMLP, "MLP", "!H:!V:HiddenLayers=5:NCycles=20:VarTransform=N");
+      factory.BookMethod(&dataLoader, TMVA::Types::kKNN, "KNN", "!H:!V:nkNN=20:UseKernel:Kernel=Gaus:ScaleFrac=0.8");
+      factory.TrainAllMethods();
+   }
+
+   void Compare(const char *methodName)
+   {
+      std::vector<Float_t> vars(kNVariables);
+      TMVA::Reader reader("!Color:Silent:!V");
+      for (UInt_t ivar = 0; ivar < kNVariables; ivar++) {
+         reader.AddVariable(Form("x%d", ivar), &vars[ivar]);
+      }
+      reader.BookMVA(methodName, Form("dataset/weights/TMVAReaderBatch_%s.weights.xml", methodName));
+
+      TRandom3 rng(7);
+      std::vector<Float_t> values(kNVariables * kNEvents);
+      for (auto &value : values) {
+         value = rng.Gaus(0, 2);
+      }
+
+      std::vector<Double_t> batch(kNEvents);
+      reader.EvaluateMVA(values.data(), kNEvents, methodName, batch.data());
+
+      for (Long64_t ievt = 0; ievt < kNEvents; ievt++) {
+         for (UInt_t ivar = 0; ivar < kNVariables; ivar++) {
+            vars[ivar] = values[ivar * kNEvents + ievt];
+         }
+         EXPECT_NEAR(reader.EvaluateMVA(methodName), batch[ievt], 1e-9) << methodName << " event " << ievt;
+      }
+   }
+};
+
+BatchEvaluationContext &GetContext()
+{
+   static BatchEvaluationContext context;
+   return context;
+}
+
+} // namespace
+
+TEST(ReaderBatchEvaluation, Fisher)
+{
+   GetContext().Compare("Fisher");
+}
+
+TEST(ReaderBatchEvaluation, BDT)
+{
+   GetContext().Compare("BDT");
+}
+
+TEST(ReaderBatchEvaluation, BDTG)
+{
+   GetContext().Compare("BDTG");
+}
+
+TEST(ReaderBatchEvaluation, MLP)
+{
+   GetContext().Compare("MLP");
+}
+
+TEST(ReaderBatchEvaluation, KNN)
+{
+   GetContext().Compare("KNN");
+}
@@ -0,0 +1,95 @@
+// @(#)root/tmva $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ROOT/TDataFrame.hxx>
+#include <TMVA/DataLoader.h>
+#include <TMVA/DataSet.h>
+#include <TMVA/DataSetInfo.h>
+#include <TMVA/Event.h>
+#include <TMVA/Tools.h>
+#include <TMath.h>
+
+#include <vector>
+
+//
+// Verifies that the events given to the DataLoader from the columns of a
+// TDataFrame give the same data set as the events added one by one.
+//
+
+namespace {
+
+const ULong64_t kNEvents = 400;
+
+Double_t Variable(ULong64_t entry, Int_t cls, Int_t ivar)
+{
+   return TMath::Sin(0.1 * entry + ivar) + (cls ? 0.5 : -0.5);
+}
+
+void DeclareVariables(TMVA::DataLoader &dataLoader)
+{
+   dataLoader.AddVariable("x0", 'F');
+   dataLoader.AddVariable("x1", 'F');
+   dataLoader.AddSpectator("s", 'F');
+}
+
+} // namespace
+
+TEST(DataLoaderDataFrame, SameDataSet)
+{
+   TMVA::Tools::Instance();
+   const char *splitOpt = "SplitMode=Block:NormMode=None:!V";
+
+   TMVA::DataLoader reference("dataset_reference");
+   DeclareVariables(reference);
+   for (ULong64_t entry = 0; entry < kNEvents; entry++) {
+      for (Int_t cls = 0; cls < 2; cls++) {
+         std::vector<Double_t> event = {Variable(entry, cls, 0), Variable(entry, cls, 1), Double_t(entry)};
+         reference.AddEvent(cls ? "Signal" : "Background", (entry % 2) ? TMVA::Types::kTesting : TMVA::Types::kTraining,
+                            event, 1.0 + 0.01 * entry);
+      }
+   }
+   reference.PrepareTrainingAndTestTree("", splitOpt);
+
+   TMVA::DataLoader fromDataFrame("dataset_dataframe");
+   DeclareVariables(fromDataFrame);
+   for (Int_t cls = 0; cls < 2; cls++) {
+      // the columns of the two classes are defined in separate data frames
+      ROOT::Experimental::TDataFrame df(kNEvents);
+      auto columns = df.Define("w", [](ULong64_t entry) { return 1.0 + 0.01 * entry; }, {"tdfentry_"})
+                        .Define("s", [](ULong64_t entry) { return Double_t(entry); }, {"tdfentry_"})
+                        .Define("x0", [cls](ULong64_t entry) { return Variable(entry, cls, 0); }, {"tdfentry_"})
+                        .Define("x1", [cls](ULong64_t entry) { return Variable(entry, cls, 1); }, {"tdfentry_"});
+      auto training = columns.Filter([](ULong64_t entry) { return entry % 2 == 0; }, {"tdfentry_"});
+      auto testing = columns.Filter([](ULong64_t entry) { return entry % 2 == 1; }, {"tdfentry_"});
+      fromDataFrame.AddDataFrame(training, cls ? "Signal" : "Background", TMVA::Types::kTraining, "w");
+      fromDataFrame.AddDataFrame(testing, cls ? "Signal" : "Background", TMVA::Types::kTesting, "w");
+   }
+   fromDataFrame.PrepareTrainingAndTestTree("", splitOpt);
+
+   TMVA::DataSet *expected = reference.GetDataSetInfo().GetDataSet();
+   TMVA::DataSet *actual = fromDataFrame.GetDataSetInfo().GetDataSet();
+
+   for (auto type : {TMVA::Types::kTraining, TMVA::Types::kTesting}) {
+      expected->SetCurrentType(type);
+      actual->SetCurrentType(type);
+      ASSERT_EQ(actual->GetNEvents(), expected->GetNEvents());
+      for (Long64_t ievt = 0; ievt < expected->GetNEvents(); ievt++) {
+         const TMVA::Event *e = expected->GetEvent(ievt);
+         const TMVA::Event *a = actual->GetEvent(ievt);
+         EXPECT_EQ(a->GetClass(), e->GetClass());
+         EXPECT_FLOAT_EQ(a->GetWeight(), e->GetWeight());
+         EXPECT_FLOAT_EQ(a->GetValue(0), e->GetValue(0));
+         EXPECT_FLOAT_EQ(a->GetValue(1), e->GetValue(1));
+         EXPECT_FLOAT_EQ(a->GetSpectator(0), e->GetSpectator(0));
+      }
+   }
+}
@@ -53,6 +53,9 @@
 #pragma link C++ class TTreeCloner+;
 #pragma link C++ class TTreeCache+;
 #pragma link C++ class TTreeCacheUnzip+;
+#pragma link C++ class TTreeCompressionAdvisor;
+#pragma link C++ class TTreeCompressionAdvisor::TMeasurement+;
+#pragma link C++ class TTreeCompressionAdvisor::TBranchAdvice+;
 #pragma link C++ class TVirtualTreePlayer;
 #pragma link C++ class TVirtualIndex+;
 #pragma link C++ class TTreeResult+;
@@ -85,6 +88,7 @@
 #pragma link C++ function operator+(const TEventList&, const TEventList&);
 #pragma link C++ function operator-(const TEventList&, const TEventList&);
 #pragma link C++ function operator*(const TEventList&, const TEventList&);
+#pragma link C++ function ROOT::TreeUtils::ReadBranchesInBulk;
 
 #pragma read sourceClass="TTree" targetClass="TTree" version="[-16]" source="" target="fDefaultEntryOffsetLen" code="{ fDefaultEntryOffsetLen = 1000; }"
 #pragma read sourceClass="TTree" targetClass="TTree" version="[-18]" source="" target="fNClusterRange" code="{ fNClusterRange = 0; }"
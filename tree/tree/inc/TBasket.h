@@ -27,6 +27,8 @@
 
 #include "TKey.h"
 
+#include <vector>
+
 class TFile;
 class TTree;
 class TBranch;
@@ -53,6 +55,9 @@ private:
    // Returns true if the underlying TLeaf can regenerate the entry offsets for us.
    Bool_t CanGenerateOffsetArray();
 
+   // Write the entry offsets as a separate, uncompressed record (kSeparateOffsetMap).
+   void WriteEntryOffsetMap(TFile *file, const Int_t *entryOffset);
+
 protected:
    Int_t       fBufferSize{0};                ///< fBuffer length in bytes
    Int_t       fNevBufSize{0};                ///< Length in Int_t of fEntryOffset OR fixed length of each entry if fEntryOffset is null!
@@ -68,6 +73,9 @@ protected:
    TBranch    *fBranch{nullptr};              ///<Pointer to the basket support branch
    TBuffer    *fCompressedBufferRef{nullptr}; ///<! Compressed buffer.
    Int_t       fLastWriteBufferSize{0};       ///<! Size of the buffer last time we wrote it to disk
+   Int_t       fAsyncCycle{-1};               ///<! Key cycle when written asynchronously; -1 to use the branch's write basket
+   Long64_t    fSeekOffsetMap{0};             ///<!Location of the separate entry offset record; serialized in the custom streamer
+   Int_t       fNbytesOffsetMap{0};           ///<!Size in bytes of the separate entry offset record
 
 public:
    // The IO bits flag is to provide improved forward-compatibility detection.
@@ -83,11 +91,12 @@ public:
    // in the fIOBits -- then the zombie flag will be set for this object.
    //
    enum class EIOBits : Char_t {
-      // The following to bits are reserved for now; when supported, set
-      // kSupported = kGenerateOffsetMap | kBasketClassMap
+      // The following bit is reserved for now; when supported, set
+      // kSupported = kGenerateOffsetMap | kSeparateOffsetMap | kBasketClassMap
       kGenerateOffsetMap = BIT(0),
-      // kBasketClassMap = BIT(1),
-      kSupported = kGenerateOffsetMap
+      kSeparateOffsetMap = BIT(1),
+      // kBasketClassMap = BIT(2),
+      kSupported = kGenerateOffsetMap | kSeparateOffsetMap
    };
    // This enum covers IOBits that are known to this ROOT release but
    // not supported; provides a mechanism for us to have experimental
@@ -96,7 +105,7 @@ public:
    // (kUnsupported | kSupported) should result in the '|' of all IOBits.
    enum class EUnsupportedIOBits : Char_t { kUnsupported = 0 };
    // The number of known, defined IOBits.
-   static constexpr int kIOBitCount = 1;
+   static constexpr int kIOBitCount = 2;
 
    TBasket();
    TBasket(TDirectory *motherDir);
@@ -105,6 +114,7 @@ public:
 
    virtual void    AdjustSize(Int_t newsize);
    virtual void    DeleteEntryOffset();
+           void    DetachForAsyncWrite(Int_t cycle);
    virtual Int_t   DropBuffers();
    TBranch        *GetBranch() const {return fBranch;}
            Int_t   GetBufferSize() const {return fBufferSize;}
@@ -117,10 +127,12 @@ public:
            Int_t   GetNevBuf() const {return fNevBuf;}
            Int_t   GetNevBufSize() const {return fNevBufSize;}
            Int_t   GetLast() const {return fLast;}
+           Long64_t GetSeekOffsetMap() const {return fSeekOffsetMap;}
    virtual void    MoveEntries(Int_t dentries);
    virtual void    PrepareBasket(Long64_t /* entry */) {};
            Int_t   ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file);
            Int_t   ReadBasketBytes(Long64_t pos, TFile *file);
+           Int_t   ReadEntryOffsetMap(Long64_t pos, TFile *file, std::vector<Int_t> &offsets);
    virtual void    Reset();
 
            Int_t   LoadBasketBuffers(Long64_t pos, Int_t len, TFile *file, TTree *tree = 0);
@@ -23,7 +23,9 @@
 //     the list of TLeaves (branch description)                         //
 //////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include "TNamed.h"
 
@@ -62,6 +64,7 @@ class TBranch : public TNamed , public TAttFill {
 protected:
    friend class TTreeCloner;
    friend class TTree;
+   friend class TBasket;
 
    // TBranch status bits
    enum EStatusBits {
@@ -114,6 +117,24 @@ protected:
 
    Bool_t      fSkipZip;          ///<! After being read, the buffer will not be unzipped.
 
+   Int_t       fNCompressionDict{0};        ///<  Number of bytes in fCompressionDict
+   char       *fCompressionDict{nullptr};   ///<[fNCompressionDict] Trained dictionary the baskets are compressed against (ZSTD only)
+   UInt_t      fCompressionDictID{0};       ///<! Identifier of fCompressionDict in the compression library, 0 if not registered
+   Int_t       fCompressionDictMaxSize{0};  ///<! Maximum size of the dictionary to train, 0 if not training
+   Long64_t    fCompressionDictTraining{0}; ///<! Number of uncompressed basket bytes to sample before training
+   std::vector<char>   fDictSamples;        ///<! Uncompressed basket payloads collected for the training
+   std::vector<size_t> fDictSampleSizes;    ///<! Size of each sample in fDictSamples
+
+   std::vector<char>   fBasketArraysOnFile;          ///<! fBasketBytes, fBasketEntry and fBasketSeek as read by Streamer, until their first use
+   std::atomic<Bool_t> fBasketArraysPending{kFALSE}; ///<! True while the basket arrays are only in fBasketArraysOnFile
+
+   /// Samples handed over by AddCompressionDictionarySample for the training of a dictionary
+   struct TDictionaryTraining {
+      std::vector<char>   fSamples;
+      std::vector<size_t> fSampleSizes;
+      Int_t               fMaxSize = 0; ///< Maximum size of the dictionary, 0 if there is nothing to train
+   };
+
    typedef void (TBranch::*ReadLeaves_t)(TBuffer &b);
    ReadLeaves_t fReadLeaves;      ///<! Pointer to the ReadLeaves implementation to use.
    typedef void (TBranch::*FillLeaves_t)(TBuffer &b);
@@ -125,10 +146,12 @@ protected:
    void     FillLeavesImpl(TBuffer &b);
 
    void     SetSkipZip(Bool_t skip = kTRUE) { fSkipZip = skip; }
+   void     LoadBasketArrays() const { if (fBasketArraysPending.load(std::memory_order_acquire)) const_cast<TBranch *>(this)->DecodeBasketArrays(); }
    void     Init(const char *name, const char *leaflist, Int_t compress);
 
    TBasket *GetFreshBasket();
    TBasket *GetFreshCluster();
+   TBasket *LoadBasketOfEntry(Long64_t entry);
    Int_t    WriteBasket(TBasket* basket, Int_t where) { return WriteBasketImpl(basket, where, nullptr); }
 
    TString  GetRealFileName() const;
@@ -136,6 +159,15 @@ protected:
 private:
    Int_t FillEntryBuffer(TBasket* basket,TBuffer* buf, Int_t& lnew);
    Int_t    WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *);
+   Int_t    FlushBasketsImpl(ROOT::Internal::TBranchIMTHelper *);
+   Int_t    FlushOneBasketImpl(UInt_t which, ROOT::Internal::TBranchIMTHelper *);
+   Int_t    GetBulkBasket(Long64_t entry, TBasket *&basket, Int_t &entrySize);
+   UInt_t   AddCompressionDictionarySample(const char *buffer, Int_t len, TDictionaryTraining &training);
+   static std::vector<char> TrainCompressionDictionary(const TDictionaryTraining &training);
+   UInt_t   SetTrainedCompressionDictionary(const std::vector<char> &dict);
+   void     DecodeBasketArrays();
+   void     ReadCurrentVersion(TBuffer &b);
+   void     SetCompressionDictionary(const char *dict, Int_t len);
    TBranch(const TBranch&) = delete;             // not implemented
    TBranch& operator=(const TBranch&) = delete;  // not implemented
 
@@ -150,6 +182,7 @@ public:
    virtual void      Browse(TBrowser *b);
    virtual void      DeleteBaskets(Option_t* option="");
    virtual void      DropBaskets(Option_t *option = "");
+           void      EnableCompressionDictionary(Int_t maxsize = 16384, Long64_t trainingbytes = 0);
            void      ExpandBasketArrays();
            Int_t     Fill() { return FillImpl(nullptr); }
    virtual Int_t     FillImpl(ROOT::Internal::TBranchIMTHelper *);
@@ -160,18 +193,24 @@ public:
 
    virtual char     *GetAddress() const {return fAddress;}
            TBasket  *GetBasket(Int_t basket);
-           Int_t    *GetBasketBytes() const {return fBasketBytes;}
-           Long64_t *GetBasketEntry() const {return fBasketEntry;}
+           Int_t    *GetBasketBytes() const {LoadBasketArrays(); return fBasketBytes;}
+           Long64_t *GetBasketEntry() const {LoadBasketArrays(); return fBasketEntry;}
+           Int_t     GetBasketEntryOffsets(Int_t basket, std::vector<Int_t> &offsets);
    virtual Long64_t  GetBasketSeek(Int_t basket) const;
    virtual Int_t     GetBasketSize() const {return fBasketSize;}
    virtual TList    *GetBrowsables();
    virtual const char* GetClassName() const;
            Int_t     GetCompressionAlgorithm() const;
+           Int_t     GetCompressionDictionarySize() const { return fNCompressionDict; }
            Int_t     GetCompressionLevel() const;
            Int_t     GetCompressionSettings() const;
+           Int_t     GetBulkEntries(Long64_t entry, TBuffer &user_buf);
+           Long64_t  GetBulkEntries(Long64_t first, Long64_t nentries, void *buffer);
+           Int_t     GetBulkEntrySize() const;
    TDirectory       *GetDirectory() const {return fDirectory;}
    virtual Int_t     GetEntry(Long64_t entry=0, Int_t getall = 0);
    virtual Int_t     GetEntryExport(Long64_t entry, Int_t getall, TClonesArray *list, Int_t n);
+           Int_t     GetEntriesSerialized(Long64_t entry, TBuffer &user_buf);
            Int_t     GetEntryOffsetLen() const { return fEntryOffsetLen; }
            Int_t     GetEvent(Long64_t entry=0) {return GetEntry(entry);}
    const char       *GetIconName() const;
@@ -237,7 +276,7 @@ public:
 
    static  void      ResetCount();
 
-   ClassDef(TBranch, 13); // Branch descriptor
+   ClassDef(TBranch, 14); // Branch descriptor
 };
 
 //______________________________________________________________________________
@@ -29,6 +29,8 @@ class TTree;
 class TBranchRef : public TBranch {
 private:
    Long64_t   fRequestedEntry;  ///<! Cursor indicating which entry is being requested.
+   Long64_t   fResolvedEntry;   ///<! Entry whose parents have all been read, see SetReadAllParents.
+   Bool_t     fReadAllParents;  ///<! Read all the parents of an entry at the first reference resolved.
 
 protected:
    TRefTable *fRefTable;        ///< pointer to the TRefTable
@@ -42,11 +44,13 @@ public:
    virtual ~TBranchRef();
    virtual void    Clear(Option_t *option="");
    TRefTable      *GetRefTable() const {return fRefTable;}
+   Bool_t          GetReadAllParents() const {return fReadAllParents;}
    virtual Bool_t  Notify();
    virtual void    Print(Option_t *option="") const;
    virtual void    Reset(Option_t *option="");
    virtual void    ResetAfterMerge(TFileMergeInfo *);
    virtual Int_t   SetParent(const TObject* obj, Int_t branchID);
+   void            SetReadAllParents(Bool_t all = kTRUE) {fReadAllParents = all; fResolvedEntry = -1;}
    virtual void    SetRequestedEntry(Long64_t entry) {fRequestedEntry = entry;}
 
 private:
@@ -29,6 +29,7 @@ class TCut;
 class TEntryList;
 class TEventList;
 class TCollection;
+class TFileCollection;
 
 class TChain : public TTree {
 
@@ -43,6 +44,9 @@ protected:
    TObjArray   *fFiles;            ///< -> List of file names containing the trees (TChainElement, owned)
    TList       *fStatus;           ///< -> List of active/inactive branches (TChainElement, owned)
    TChain      *fProofChain;       ///<! chain proxy when going to be processed by PROOF
+   TObjArray   *fOpenFiles;        ///<! Files opened by PrefetchEntries, indexed as fFiles, until loaded by LoadTree (owned)
+   Int_t        fParallelOpen;     ///<! Number of files opened in parallel to compute the number of entries
+   Bool_t       fKeepFilesOpen;    ///<! If true, the files opened in parallel are kept open for LoadTree
 
 private:
    TChain(const TChain&);            // not implemented
@@ -87,6 +91,7 @@ public:
    virtual Int_t     Fill() { MayNotUse("Fill()"); return -1; }
    virtual TBranch  *FindBranch(const char* name);
    virtual TLeaf    *FindLeaf(const char* name);
+   using TTree::GetBranch;
    virtual TBranch  *GetBranch(const char* name);
    virtual Bool_t    GetBranchStatus(const char* branchname) const;
    virtual Long64_t  GetCacheSize() const { return fTree ? fTree->GetCacheSize() : fCacheSize; }
@@ -122,10 +127,12 @@ public:
            void      Lookup(Bool_t force = kFALSE);
    virtual void      Loop(Option_t *option="", Long64_t nentries=kMaxEntries, Long64_t firstentry=0); // *MENU*
    virtual void      ls(Option_t *option="") const;
+   virtual TFileCollection *MakeManifest(Bool_t clusters = kTRUE) const;
    virtual Long64_t  Merge(const char *name, Option_t *option = "");
    virtual Long64_t  Merge(TCollection *list, Option_t *option = "");
    virtual Long64_t  Merge(TCollection *list, TFileMergeInfo *info);
    virtual Long64_t  Merge(TFile *file, Int_t basketsize, Option_t *option="");
+   virtual Long64_t  PrefetchEntries(Int_t nparallel = 8, Bool_t keepopen = kFALSE);
    virtual void      Print(Option_t *option="") const;
    virtual Long64_t  Process(const char *filename, Option_t *option="", Long64_t nentries=kMaxEntries, Long64_t firstentry=0); // *MENU*
    virtual Long64_t  Process(TSelector* selector, Option_t* option = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0);
@@ -159,6 +166,7 @@ public:
    virtual void      SetEventList(TEventList *evlist);
    virtual void      SetMakeClass(Int_t make) { TTree::SetMakeClass(make); if (fTree) fTree->SetMakeClass(make);}
    virtual void      SetPacketSize(Int_t size = 100);
+   virtual void      SetParallelOpen(Int_t nparallel = 8, Bool_t keepopen = kFALSE);
    virtual void      SetProof(Bool_t on = kTRUE, Bool_t refresh = kFALSE, Bool_t gettreeheader = kFALSE);
    virtual void      SetWeight(Double_t w=1, Option_t *option="");
    virtual void      UseCache(Int_t maxCacheSize = 10, Int_t pageSize = 0);
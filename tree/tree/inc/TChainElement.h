@@ -23,6 +23,8 @@
 
 #include "TNamed.h"
 
+#include <vector>
+
 class TBranch;
 
 class TChainElement : public TNamed {
@@ -44,6 +46,7 @@ protected:
    char         *fPackets;           ///<! Packet descriptor string
    TBranch     **fBranchPtr;         ///<! Address of user branch pointer (to updated upon loading a file)
    Int_t         fLoadResult;        ///<! Return value of TChain::LoadTree(); 0 means success
+   std::vector<Long64_t> fClusterStarts; ///<! First entries of the clusters of the tree, if known from a manifest
 
 public:
    TChainElement();
@@ -55,6 +58,7 @@ public:
    virtual Bool_t      GetBaddressIsPtr() const { return fBaddressIsPtr; }
    virtual UInt_t      GetBaddressType() const { return fBaddressType; }
    virtual TBranch   **GetBranchPtr() const { return fBranchPtr; }
+   const std::vector<Long64_t> &GetClusterStarts() const { return fClusterStarts; }
    virtual Long64_t    GetEntries() const {return fEntries;}
            Int_t       GetLoadResult() const { return fLoadResult; }
    virtual char       *GetPackets() const {return fPackets;}
@@ -67,6 +71,7 @@ public:
    virtual void        SetBaddressIsPtr(Bool_t isptr) { fBaddressIsPtr = isptr; }
    virtual void        SetBaddressType(UInt_t type) { fBaddressType = type; }
    virtual void        SetBranchPtr(TBranch **ptr) { fBranchPtr = ptr; }
+           void        SetClusterStarts(const std::vector<Long64_t> &starts) { fClusterStarts = starts; }
            void        SetLoadResult(Int_t result) { fLoadResult = result; }
    virtual void        SetLookedUp(Bool_t y = kTRUE);
    virtual void        SetNumberEntries(Long64_t n) {fEntries=n;}
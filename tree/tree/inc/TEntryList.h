@@ -73,6 +73,7 @@ class TEntryList: public TNamed
    virtual TList      *GetLists() const { return fLists; }
    virtual TDirectory *GetDirectory() const { return fDirectory; }
    virtual Long64_t    GetN() const { return fN; }
+   Long64_t            GetNInRange(Long64_t first, Long64_t last) const;
    virtual const char *GetTreeName() const { return fTreeName.Data(); }
    virtual const char *GetFileName() const { return fFileName.Data(); }
    virtual Int_t       GetTreeNumber() const { return fTreeNumber; }
@@ -104,6 +105,7 @@ class TEntryList: public TNamed
    virtual void        SetTreeNumber(Int_t index) { fTreeNumber=index;  }
    virtual void        SetReapplyCut(Bool_t apply = kFALSE) {fReapply = apply;}; // *TOGGLE* *GETTER=GetReapplyCut
    virtual void        Subtract(const TEntryList *elist);
+   virtual void        Intersect(const TEntryList *elist);
 
    static  Int_t       Relocate(const char *fn,
                                 const char *newroot, const char *oldroot = 0, const char *enlnm = 0);
@@ -29,6 +29,9 @@
 // - Merge() - adds all entries from one block to the other. If the first block
 //             uses array representation, it's changed to bits representation only
 //             if the total number of passing entries is still less than kBlockSize
+// - Subtract(), Intersect() - remove the entries (not) contained in the other block.
+//             Merge(), Subtract() and Intersect() work on whole words of the bit
+//             representation rather than entry by entry.
 // - GetEntry(n) - returns n-th non-zero entry.
 // - Next()      - return next non-zero entry. In case of representation 1), Next()
 //                 is faster than GetEntry()
@@ -55,6 +58,8 @@ class TEntryListBlock:public TObject
    Int_t    fLastIndexReturned; ///<! to optimize GetEntry() in a loop
 
    void Transform(Bool_t dir, UShort_t *indexnew);
+   void FillBits(UShort_t *bits) const;
+   Int_t AdoptBits(UShort_t *bits);
 
  public:
 
@@ -69,11 +74,14 @@ class TEntryListBlock:public TObject
    Int_t   Contains(Int_t entry);
    void    OptimizeStorage();
    Int_t   Merge(TEntryListBlock *block);
+   Int_t   Subtract(TEntryListBlock *block);
+   Int_t   Intersect(TEntryListBlock *block);
    Int_t   Next();
    Int_t   GetEntry(Int_t entry);
    void    ResetIndices() {fLastIndexQueried = -1, fLastIndexReturned = -1;}
    Int_t   GetType() { return fType; }
    Int_t   GetNPassed();
+   Int_t   GetNPassed(Int_t first, Int_t last) const;
    virtual void Print(const Option_t *option = "") const;
    void    PrintWithShift(Int_t shift) const;
 
@@ -45,7 +45,10 @@ protected:
    friend void TFriendElement__SetTree(TTree *tree, TList *frlist);
 
 public:
-   enum EStatusBits { kFromChain = BIT(11) };
+   enum EStatusBits {
+      kFromChain = BIT(11),
+      kAligned = BIT(12)     ///< the friend has the same entries as its parent tree, in the same order
+   };
    TFriendElement();
    TFriendElement(TTree *tree, const char *treename, const char *filename);
    TFriendElement(TTree *tree, const char *treename, TFile *file);
@@ -57,7 +60,9 @@ public:
    virtual TTree      *GetParentTree() const {return fParentTree;}
    virtual TTree      *GetTree();
    virtual const char *GetTreeName() const {return fTreeName.Data();}
+           Bool_t      IsAligned() const { return TestBit(kAligned); }
    virtual void        ls(Option_t *option="") const;
+           void        SetAligned(Bool_t aligned = kTRUE) { SetBit(kAligned, aligned); }
 
    ClassDef(TFriendElement,2)  //A friend element of another TTree
 };
@@ -67,6 +67,12 @@ class TTreeCloner;
 class TFileMergeInfo;
 class TVirtualPerfStats;
 
+namespace ROOT {
+  namespace Internal {
+    class TBasketAsyncWriteQueue; ///< Queue of baskets being written by IMT tasks while TTree::Fill goes on.
+  }
+}
+
 class TTree : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
    using TIOFeatures = ROOT::TIOFeatures;
@@ -139,8 +145,16 @@ private:
    mutable Bool_t fIMTFlush{false};               ///<! True if we are doing a multithreaded flush.
    mutable std::atomic<Long64_t> fIMTTotBytes;    ///<! Total bytes for the IMT flush baskets
    mutable std::atomic<Long64_t> fIMTZipBytes;    ///<! Zip bytes for the IMT flush baskets.
+   Int_t          fIMTAsyncFlush{0};              ///<! Maximum number of baskets in flight when flushing asynchronously (0 if disabled)
+   ROOT::Internal::TBasketAsyncWriteQueue *fAsyncFlushQueue{nullptr}; ///<! Baskets being written by IMT tasks (if any)
+   Long64_t       fAdaptiveBasketMemory{0};       ///<! Memory budget of the baskets resized at each cluster boundary (0 if disabled)
+   Int_t          fAdaptiveBasketsPerCluster{1};  ///<! Target number of baskets per branch and cluster when resizing
+   Long64_t       fAdaptiveLastEntry{0};          ///<! Number of entries at the previous resizing
+   std::vector<std::pair<Long64_t, Long64_t>> fAdaptiveBytes; ///<! Per branch without sub-branches, tot and zip bytes at the previous resizing
 
    void             InitializeBranchLists(bool checkLeafCount);
+   Int_t            QueueBaskets();
+   void             RebalanceBaskets();
    void             SortBranchesByTime();
 
 protected:
@@ -161,6 +175,7 @@ protected:
    void             ImportClusterRanges(TTree *fromtree);
    void             MoveReadCache(TFile *src, TDirectory *dir);
    Int_t            SetCacheSizeAux(Bool_t autocache = kTRUE, Long64_t cacheSize = 0);
+   Int_t            FlushBasketsImpl() const;
 
    class TFriendLock {
       // Helper class to prevent infinite recursion in the
@@ -362,10 +377,14 @@ public:
    virtual TLeaf          *FindLeaf(const char* name);
    virtual Int_t           Fit(const char* funcname, const char* varexp, const char* selection = "", Option_t* option = "", Option_t* goption = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0); // *MENU*
    virtual Int_t           FlushBaskets() const;
+           Int_t           FlushAsyncBaskets() const;
    virtual const char     *GetAlias(const char* aliasName) const;
    virtual Long64_t        GetAutoFlush() const {return fAutoFlush;}
    virtual Long64_t        GetAutoSave()  const {return fAutoSave;}
    virtual TBranch        *GetBranch(const char* name);
+           TBranch        *GetBranch(std::string_view name);
+           TBranch        *GetBranch(const TString &name) { return GetBranch(name.Data()); }
+           TBranch        *GetBranch(const std::string &name) { return GetBranch(name.c_str()); }
    virtual TBranchRef     *GetBranchRef() const { return fBranchRef; };
    virtual Bool_t          GetBranchStatus(const char* branchname) const;
    static  Int_t           GetBranchStyle();
@@ -397,6 +416,7 @@ public:
    virtual const char     *GetFriendAlias(TTree*) const;
    TH1                    *GetHistogram() { return GetPlayer()->GetHistogram(); }
    virtual Bool_t          GetImplicitMT() { return fIMTEnabled; }
+           Int_t           GetIMTAsyncFlush() const { return fIMTAsyncFlush; }
    virtual Int_t          *GetIndex() { return &fIndex.fArray[0]; }
    virtual Double_t       *GetIndexValues() { return &fIndexValues.fArray[0]; }
            ROOT::TIOFeatures GetIOFeatures() const;
@@ -497,6 +517,7 @@ public:
    virtual void            ResetBranchAddress(TBranch *);
    virtual void            ResetBranchAddresses();
    virtual Long64_t        Scan(const char* varexp = "", const char* selection = "", Option_t* option = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0); // *MENU*
+           void            SetAdaptiveBasketSizes(Long64_t maxmemory, Int_t basketspercluster = 1);
    virtual Bool_t          SetAlias(const char* aliasName, const char* aliasFormula);
    virtual void            SetAutoSave(Long64_t autos = -300000000);
    virtual void            SetAutoFlush(Long64_t autof = -30000000);
@@ -540,6 +561,7 @@ public:
    virtual void            SetEventList(TEventList* list);
    virtual void            SetEntryList(TEntryList* list, Option_t *opt="");
    virtual void            SetImplicitMT(Bool_t enabled) { fIMTEnabled = enabled; }
+           void            SetIMTAsyncFlush(Int_t maxbaskets = 64);
    virtual void            SetMakeClass(Int_t make);
    virtual void            SetMaxEntryLoop(Long64_t maxev = kMaxEntries) { fMaxEntryLoop = maxev; } // *MENU*
    static  void            SetMaxTreeSize(Long64_t maxsize = 100000000000LL);
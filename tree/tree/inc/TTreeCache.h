@@ -26,6 +26,7 @@
 
 class TTree;
 class TBranch;
+class TEntryList;
 
 class TTreeCache : public TFileCacheRead {
 
@@ -57,11 +58,21 @@ protected:
    EPrefillType    fPrefillType;      ///<  Whether a pre-filling is enabled (and if applicable which type)
    static  Int_t   fgLearnEntries;    ///<  number of entries used for learning mode
    Bool_t          fAutoCreated;      ///<! true if cache was automatically created
+   Int_t           fClusterLookahead; ///<! number of clusters after the cached ones announced to the file for asynchronous reading
+   Long64_t        fLookaheadMaxBytes;///<! maximum number of bytes announced ahead of the cached clusters (0: fClusterLookahead * buffer size)
+   Long64_t        fEntryLookahead;   ///<! entry up to which the following clusters have been announced
+   Int_t           fLookaheadSupported; ///<! whether the file supports asynchronous read hints (-1: not yet probed)
+   Int_t           fNReadAhead;       ///<! Number of blocks announced ahead of the cached clusters
+   TEntryList     *fEntrySelection;   ///<! selected entries (owned): the baskets without any are not prefetched
+   Bool_t          fFillingFriends;   ///<! true while the caches of the aligned friends are being filled
 
 private:
    TTreeCache(const TTreeCache &);            //this class cannot be copied
    TTreeCache& operator=(const TTreeCache &);
 
+   void IssueLookahead(TTree *tree);
+   void FillAlignedFriends(TTree *tree);
+
 public:
 
    TTreeCache();
@@ -74,11 +85,13 @@ public:
    virtual void         Disable() {fEnabled = kFALSE;}
    virtual void         Enable() {fEnabled = kTRUE;}
    const TObjArray     *GetCachedBranches() const { return fBranches; }
+   Int_t                GetClusterLookahead() const { return fClusterLookahead; }
    EPrefillType         GetConfiguredPrefillType() const;
    Double_t             GetEfficiency() const;
    Double_t             GetEfficiencyRel() const;
    virtual Int_t        GetEntryMin() const {return fEntryMin;}
    virtual Int_t        GetEntryMax() const {return fEntryMax;}
+   const TEntryList    *GetEntrySelection() const {return fEntrySelection;}
    static Int_t         GetLearnEntries();
    virtual EPrefillType GetLearnPrefill() const {return fPrefillType;}
    TTree               *GetTree() const {return fTree;}
@@ -95,8 +108,10 @@ public:
    virtual Int_t        ReadBufferPrefetch(char *buf, Long64_t pos, Int_t len);
    virtual void         ResetCache();
    void                 SetAutoCreated(Bool_t val) {fAutoCreated = val;}
+   void                 SetClusterLookahead(Int_t nclusters, Long64_t maxbytes = 0);
    virtual Int_t        SetBufferSize(Int_t buffersize);
    virtual void         SetEntryRange(Long64_t emin,   Long64_t emax);
+   void                 SetEntrySelection(const TEntryList *elist);
    virtual void         SetFile(TFile *file, TFile::ECacheAction action=TFile::kDisconnect);
    virtual void         SetLearnPrefill(EPrefillType type = kNoPrefill);
    static void          SetLearnEntries(Int_t n = 10);
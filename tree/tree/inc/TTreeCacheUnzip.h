@@ -28,6 +28,7 @@
 #include "Bytes.h"
 #include "TTreeCache.h"
 #include "ROOT/TTaskGroup.hxx"
+#include "ROOT/TBufferPool.hxx"
 #include <atomic>
 #include <queue>
 #include <memory>
@@ -54,7 +55,8 @@ protected:
       // Note: we cannot use std::unique_ptr<std::unique_ptr<char[]>[]> or vector of unique_ptr
       // for fUnzipChunks since std::unique_ptr is not copy constructable.
       // However, in future upgrade we cannot use make_vector in C++14.
-      std::unique_ptr<char[]> *fUnzipChunks;     ///<! [fNseek] Individual unzipped chunks. Their summed size is kept under control.
+      using Chunk_t = std::unique_ptr<char[], ROOT::Internal::TBufferPool::TDeleter>;
+      Chunk_t                 *fUnzipChunks;     ///<! [fNseek] Individual unzipped chunks, from the TBufferPool. Their summed size is kept under control.
       std::vector<Int_t>       fUnzipLen;        ///<! [fNseek] Length of the unzipped buffers
       std::atomic<Byte_t>     *fUnzipStatus;     ///<! [fNSeek] 
 
@@ -101,7 +103,10 @@ protected:
    // Unzipping related members
    Int_t       fNseekMax;         ///<!  fNseek can change so we need to know its max size
    Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of a group of baskets ready to be unzipped by a IMT task
-   Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is 2*fBufferSize)
+   Long64_t    fUnzipBufferSize;  ///<!  Byte budget for the blocks unzipped ahead of the reader (default is 2*fBufferSize)
+   std::atomic<Long64_t> fUnzipPendingBytes; ///<! Bytes unzipped and not yet consumed, or reserved by scheduled tasks
+   Int_t       fUnzipNext;        ///<!  Index of the next block to hand over to an unzipping task
+   Double_t    fUnzipRatio;       ///<!  Estimated unzipped/zipped size ratio, used to reserve the budget of a task
 
    static Double_t fgRelBuffSize; ///< This is the percentage of the TTreeCacheUnzip that will be used
 
@@ -120,6 +125,9 @@ private:
 
    // Private methods
    void  Init();
+#ifdef R__USE_IMT
+   void  ScheduleUnzip();
+#endif
 
 public:
    TTreeCacheUnzip();
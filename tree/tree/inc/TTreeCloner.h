@@ -22,6 +22,7 @@
 
 #include "TObjArray.h"
 
+#include <utility>
 #include <vector>
 
 #ifdef R__OLDHPACC
@@ -64,6 +65,8 @@ class TTreeCloner {
    TFileCacheRead *fFileCache;   ///< File Cache used to reduce the number of individual reads
    TFileCacheRead *fPrevCache;   ///< Cache that set before the TTreeCloner ctor for the 'from' TTree if any.
 
+   enum { kPipelineDepth = 8 }; ///< Number of baskets read ahead of the one being written
+
    enum ECloneMethod {
       kDefault             = 0,
       kSortBasketsByBranch = 1,
@@ -118,6 +121,7 @@ public:
    void   CopyProcessIds();
    const char *GetWarning() const { return fWarningMsg; }
    Bool_t Exec();
+   static Int_t CopyTrees(const std::vector<std::pair<TTree *, TTree *>> &trees, Option_t *option = "");
    Bool_t IsValid() { return fIsValid; }
    Bool_t NeedConversion() { return fNeedConversion; }
    void   SetCacheSize(Int_t size);
@@ -0,0 +1,93 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeCompressionAdvisor
+#define ROOT_TTreeCompressionAdvisor
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TTreeCompressionAdvisor                                              //
+//                                                                      //
+// Measure, on a sample of the baskets of each branch of a tree, the    //
+// compression ratio and the compression and decompression speeds of    //
+// several algorithms and levels, and recommend per-branch compression  //
+// settings optimized for the reading time or for the size.             //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include "TString.h"
+
+#include <string>
+#include <vector>
+
+class TBranch;
+class TTree;
+
+class TTreeCompressionAdvisor {
+public:
+   enum EObjective {
+      kRead, ///< Minimize the time to read the branch: decompression plus the transfer of the compressed bytes
+      kSize  ///< Minimize the size of the branch on disk
+   };
+
+   /// Measurement of one compression setting on the sampled baskets of a branch.
+   struct TMeasurement {
+      Int_t    fSettings;        ///< Compression settings, 100 * algorithm + level
+      Long64_t fCompressedBytes; ///< Size of the compressed sampled baskets
+      Double_t fCompressTime;    ///< Seconds to compress the sampled baskets
+      Double_t fDecompressTime;  ///< Seconds to decompress them
+   };
+
+   /// Measurements and recommendation for one branch.
+   struct TBranchAdvice {
+      std::string fName;                      ///< Name of the branch
+      Int_t       fCurrentSettings;           ///< Compression settings of the branch in the tree
+      Int_t       fNBaskets;                  ///< Number of sampled baskets
+      Long64_t    fSampledBytes;              ///< Uncompressed size of the sampled baskets
+      Long64_t    fCurrentBytes;              ///< Size of the sampled baskets in the file
+      std::vector<TMeasurement> fMeasurements; ///< One per candidate setting
+      Int_t       fBest;                      ///< Index of the recommended measurement, -1 if none
+
+      Int_t GetRecommendedSettings() const { return fBest < 0 ? fCurrentSettings : fMeasurements[fBest].fSettings; }
+   };
+
+private:
+   TTree     *fTree;           ///<! Tree whose baskets are sampled
+   Int_t      fNBaskets;       ///<  Number of baskets sampled per branch
+   EObjective fObjective;      ///<  What the recommendation optimizes
+   Double_t   fReadBandwidth;  ///<  Bytes per second of the storage, for the kRead objective
+   std::vector<Int_t> fCandidates;         ///< Compression settings to measure
+   std::vector<TBranchAdvice> fAdvice;     ///< Measurements, per branch
+
+   void  Choose(TBranchAdvice &advice) const;
+   void  MeasureBranch(TBranch *branch);
+
+public:
+   TTreeCompressionAdvisor(TTree *tree, EObjective objective = kRead, Int_t nbaskets = 3);
+
+   void  SetCandidates(const std::vector<Int_t> &settings) { fCandidates = settings; }
+   void  SetObjective(EObjective objective);
+   void  SetReadBandwidth(Double_t bytesPerSecond);
+
+   const std::vector<Int_t>         &GetCandidates() const { return fCandidates; }
+   const std::vector<TBranchAdvice> &GetAdvice() const { return fAdvice; }
+   EObjective GetObjective() const { return fObjective; }
+   Double_t   GetReadBandwidth() const { return fReadBandwidth; }
+   Int_t      GetRecommendation(const char *branchname) const;
+
+   Int_t  Measure();
+   Int_t  Apply(TTree *tree) const;
+   void   Print(Option_t *option = "") const;
+
+   static TString GetSettingsName(Int_t settings);
+};
+
+#endif
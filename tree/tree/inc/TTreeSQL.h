@@ -50,6 +50,9 @@ protected:
    TSQLRow               *fRow;
    TSQLServer            *fServer;
    Bool_t                 fBranchChecked;
+   Int_t                  fInsertBatchSize;  //! Number of rows inserted together by Fill
+   Int_t                  fPendingRows;      //! Number of rows filled but not inserted yet
+   std::vector<TString>   fPendingInserts;   //! INSERT statements of the pending rows
 
    void                   CheckBasket(TBranch * tb);
    Bool_t                 CheckBranch(TBranch * tb);
@@ -68,6 +71,7 @@ protected:
 
 public:
    TTreeSQL(TSQLServer * server, TString DB, const TString& table);
+   virtual ~TTreeSQL();
 
    virtual Int_t          Branch(TCollection *list, Int_t bufsize=32000, Int_t splitlevel=99, const char *name="");
    virtual Int_t          Branch(TList *list, Int_t bufsize=32000, Int_t splitlevel=99);
@@ -81,14 +85,18 @@ public:
    virtual TBranch       *Branch(const char *name, void *address, const char *leaflist, Int_t bufsize);
 
    virtual Int_t          Fill();
+   virtual Int_t          FlushBaskets() const;
+           Int_t          FlushInserts();
    virtual Int_t          GetEntry(Long64_t entry=0, Int_t getall=0);
    virtual Long64_t       GetEntries()    const;
    virtual Long64_t       GetEntries(const char *sel) { return TTree::GetEntries(sel); }
    virtual Long64_t       GetEntriesFast()const;
+           Int_t          GetInsertBatchSize() const { return fInsertBatchSize; }
            TString        GetTableName(){ return fTable; }
    virtual Long64_t       LoadTree(Long64_t entry);
    virtual Long64_t       PrepEntry(Long64_t entry);
            void           Refresh();
+           void           SetInsertBatchSize(Int_t nrows = 1000);
 
    ClassDef(TTreeSQL,1);  // TTree Implementation read and write to a SQL database.
 };
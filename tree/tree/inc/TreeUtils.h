@@ -23,9 +23,13 @@
 #define ROOT_TreeUtils
 
 #include <iosfwd>
+#include <string>
+#include <vector>
 
 #include "Rtypes.h"
 
+class TTree;
+
 namespace ROOT {
 namespace TreeUtils {
 
@@ -40,6 +44,14 @@ namespace TreeUtils {
 template<class DataType, class Tuple>
 Long64_t FillNtupleFromStream(std::istream &inputStream, Tuple &tuple, char delimiter, bool strictMode);
 
+//2. Function to read the values of several branches over a range of entries
+//into contiguous caller-owned buffers (for example NumPy arrays) with the
+//bulk interface of TBranch. The buffers are given by their addresses, so that
+//the function can be called from Python.
+
+Long64_t ReadBranchesInBulk(TTree &tree, const std::vector<std::string> &branches, Long64_t first,
+                            Long64_t nentries, const std::vector<ULong64_t> &addresses);
+
 }
 }
 
@@ -22,7 +22,11 @@
 #include "TVirtualMutex.h"
 #include "TVirtualPerfStats.h"
 #include "TTimeStamp.h"
+#include "TPerfCounters.h"
+#include "TTimelineTracer.h"
+#include "TArrayI.h"
 #include "ROOT/TIOFeatures.hxx"
+#include "ROOT/TBufferPool.hxx"
 #include "RZip.h"
 
 #include <bitset>
@@ -65,7 +69,7 @@ TBasket::TBasket(const char *name, const char *title, TBranch *branch)
    SetTitle(title);
    fClassName   = "TBasket";
    fBuffer = nullptr;
-   fBufferRef   = new TBufferFile(TBuffer::kWrite, fBufferSize);
+   fBufferRef   = ROOT::Internal::TBufferPool::NewBuffer(TBuffer::kWrite, fBufferSize);
    fVersion    += 1000;
    if (branch->GetDirectory()) {
       TFile *file = branch->GetFile();
@@ -79,7 +83,7 @@ TBasket::TBasket(const char *name, const char *title, TBranch *branch)
 #endif
       fOwnsCompressedBuffer = kFALSE;
       if (!fCompressedBufferRef) {
-         fCompressedBufferRef = new TBufferFile(TBuffer::kRead, fBufferSize);
+         fCompressedBufferRef = ROOT::Internal::TBufferPool::NewBuffer(TBuffer::kRead, fBufferSize);
          fOwnsCompressedBuffer = kTRUE;
       }
    }
@@ -104,7 +108,10 @@ TBasket::~TBasket()
 {
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
-   if (fBufferRef) delete fBufferRef;
+   if (fBufferRef) {
+      ROOT::Internal::TBufferPool::ReleaseMemory(*fBufferRef);
+      delete fBufferRef;
+   }
    fBufferRef = 0;
    fBuffer = 0;
    fDisplacement= 0;
@@ -140,6 +147,9 @@ Long64_t TBasket::CopyTo(TFile *to)
    fBuffer = fBufferRef->Buffer();
    Create(nout, to);
    fBufferRef->SetBufferOffset(0);
+   // The separate entry offset record (if any) is not copied; readers fall back to the payload.
+   fSeekOffsetMap = 0;
+   fNbytesOffsetMap = 0;
    fHeaderOnly = kTRUE;
    Streamer(*fBufferRef);
    fHeaderOnly = kFALSE;
@@ -157,6 +167,22 @@ void TBasket::DeleteEntryOffset()
    fNevBufSize  = 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare this basket to be written by an IMT task while its branch keeps
+/// filling a new basket.
+///
+/// The basket stops sharing the branch's transient compression buffer (it will
+/// allocate its own on WriteBuffer) and remembers the key cycle it would have
+/// been given, as the branch's write basket is moved on before the write happens.
+
+void TBasket::DetachForAsyncWrite(Int_t cycle)
+{
+   if (!fOwnsCompressedBuffer) {
+      fCompressedBufferRef = nullptr;
+   }
+   fAsyncCycle = cycle;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Drop buffers of this basket if it is not the current basket.
 
@@ -166,7 +192,10 @@ Int_t TBasket::DropBuffers()
 
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
-   if (fBufferRef)    delete fBufferRef;
+   if (fBufferRef) {
+      ROOT::Internal::TBufferPool::ReleaseMemory(*fBufferRef);
+      delete fBufferRef;
+   }
    if (fCompressedBufferRef && fOwnsCompressedBuffer) delete fCompressedBufferRef;
    fBufferRef   = 0;
    fCompressedBufferRef = 0;
@@ -246,7 +275,7 @@ Int_t TBasket::LoadBasketBuffers(Long64_t pos, Int_t len, TFile *file, TTree *tr
       }
       fBufferRef->SetReadMode();
    } else {
-      fBufferRef = new TBufferFile(TBuffer::kRead, len);
+      fBufferRef = ROOT::Internal::TBufferPool::NewBuffer(TBuffer::kRead, len);
    }
    fBufferRef->SetParent(file);
    char *buffer = fBufferRef->Buffer();
@@ -366,15 +395,22 @@ Int_t TBasket::ReadBasketBuffersUncompressedCase()
 
 ////////////////////////////////////////////////////////////////////////////////
 /// We always create the TBuffer for the basket but it hold the buffer from the cache.
+/// If mustFree, the buffer comes from the TBufferPool and the basket gives it back.
 
 Int_t TBasket::ReadBasketBuffersUnzip(char* buffer, Int_t size, Bool_t mustFree, TFile* file)
 {
    if (fBufferRef) {
-      fBufferRef->SetBuffer(buffer, size, mustFree);
+      ROOT::Internal::TBufferPool::ReleaseMemory(*fBufferRef);
+      if (mustFree)
+         fBufferRef->SetBuffer(buffer, size, kFALSE, &ROOT::Internal::TBufferPool::ReAllocChar);
+      else
+         fBufferRef->SetBuffer(buffer, size, kFALSE);
       fBufferRef->SetReadMode();
       fBufferRef->Reset();
+   } else if (mustFree) {
+      fBufferRef = ROOT::Internal::TBufferPool::NewBuffer(TBuffer::kRead, buffer, size);
    } else {
-      fBufferRef = new TBufferFile(TBuffer::kRead, size, buffer, mustFree);
+      fBufferRef = new TBufferFile(TBuffer::kRead, size, buffer, kFALSE);
    }
    fBufferRef->SetParent(file);
 
@@ -410,12 +446,25 @@ static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t l
       bufferRef->Reset();
       result = bufferRef;
    } else {
-      result = new TBufferFile(TBuffer::kRead, len);
+      result = ROOT::Internal::TBufferPool::NewBuffer(TBuffer::kRead, len);
    }
    result->SetParent(file);
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Report a basket read by the branch to the perf stats of its tree, if any.
+/// start is the time stamp before the decompression, 0 if it was not
+/// decompressed here.
+
+static inline void R__BasketReadEvent(TBranch *branch, Long64_t pos, Double_t start, Int_t complen, Int_t objlen)
+{
+   TVirtualPerfStats *perfStats = branch->GetTree()->GetPerfStats();
+   if (R__unlikely(perfStats)) {
+      perfStats->BasketReadEvent(branch, pos, start, complen, objlen);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize the compressed buffer; either from the TTree or create a local one.
 
@@ -456,6 +505,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    if(!fBranch->GetDirectory()) {
       return -1;
    }
+   ROOT::TTimelineTracer::TSpan span("io", "TBasket::ReadBasketBuffers", "bytes", len);
 
    Bool_t oldCase;
    char *rawUncompressedBuffer, *rawCompressedBuffer;
@@ -477,6 +527,8 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
          // Note that in the kNotDecompressed case, the above function will return 0;
          // In such a case, we should stop processing
          if (len <= 0) return -len;
+         // The cache did the decompression, the time is not known here.
+         R__BasketReadEvent(fBranch, pos, 0, fNbytes - fKeylen, fObjlen);
          goto AfterBuffer;
       }
    }
@@ -484,6 +536,30 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    // Determine which buffer to use, so that we can avoid a memcpy in case of
    // the basket was not compressed.
    TBuffer* readBufferRef;
+
+   // A memory mapped file gives the basket straight from the mapping: unstream
+   // the header and decompress from there, without copying the compressed data.
+   if (file->IsMapped()) {
+      const char *mappedBuffer = nullptr;
+      {
+         TVirtualPerfStats* temp = gPerfStats;
+         if (fBranch->GetTree()->GetPerfStats() != 0) gPerfStats = fBranch->GetTree()->GetPerfStats();
+         R__LOCKGUARD_IMT2(gROOTMutex); // Lock for parallel TTree I/O
+         mappedBuffer = file->GetMappedBuffer(pos, len);
+         gPerfStats = temp;
+      }
+      if (mappedBuffer) {
+         fBranch->GetTree()->IncrementTotalBuffers(-fBufferSize);
+         TBufferFile mappedBufferRef(TBuffer::kRead, len, const_cast<char *>(mappedBuffer), kFALSE);
+         mappedBufferRef.SetParent(file);
+         Streamer(mappedBufferRef);
+         if (IsZombie()) {
+            return 1;
+         }
+         rawCompressedBuffer = const_cast<char *>(mappedBuffer);
+         goto UncompressedBuffer;
+      }
+   }
    if (R__unlikely(fBranch->GetCompressionLevel()==0)) {
       readBufferRef = fBufferRef;
    } else {
@@ -550,6 +626,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    {
       if (R__likely(fObjlen+fKeylen == fNbytes)) {
          // The basket was really not compressed as expected.
+         R__BasketReadEvent(fBranch, pos, 0, fObjlen, fObjlen);
          goto AfterBuffer;
       } else {
          // Well, somehow the buffer was compressed anyway, we have the compressed data in the uncompressed buffer
@@ -565,6 +642,8 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       }
    }
 
+UncompressedBuffer:
+
    // Initialize buffer to hold the uncompressed data
    // Note that in previous versions we didn't allocate buffers until we verified
    // the zip headers; this is no longer beforehand as the buffer lifetime is scoped
@@ -583,10 +662,11 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
 
       // Optional monitor for zip time profiling.
       Double_t start = 0;
-      if (R__unlikely(gPerfStats)) {
+      if (R__unlikely(gPerfStats || fBranch->GetTree()->GetPerfStats())) {
          start = TTimeStamp();
       }
 
+      ROOT::TTimelineTracer::TSpan unzipSpan("io", "TBasket unzip", "bytes", fObjlen);
       memcpy(rawUncompressedBuffer, rawCompressedBuffer, fKeylen);
       char *rawUncompressedObjectBuffer = rawUncompressedBuffer+fKeylen;
       UChar_t *rawCompressedObjectBuffer = (UChar_t*)rawCompressedBuffer+fKeylen;
@@ -622,15 +702,22 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
          return 1;
       }
       len = fObjlen+fKeylen;
+      static const auto unzipped = ROOT::TPerfCounters::Register("root_basket_unzipped_total", "Baskets unzipped");
+      static const auto unzippedBytes =
+         ROOT::TPerfCounters::Register("root_basket_unzipped_bytes_total", "Bytes produced by the unzipping of baskets");
+      unzipped.Add();
+      unzippedBytes.Add(fObjlen);
       TVirtualPerfStats* temp = gPerfStats;
       if (fBranch->GetTree()->GetPerfStats() != 0) gPerfStats = fBranch->GetTree()->GetPerfStats();
       if (R__unlikely(gPerfStats)) {
          gPerfStats->UnzipEvent(fBranch->GetTree(),pos,start,nintot,fObjlen);
       }
       gPerfStats = temp;
+      R__BasketReadEvent(fBranch, pos, start, nintot, fObjlen);
    } else {
       // Nothing is compressed - copy over wholesale.
       memcpy(rawUncompressedBuffer, rawCompressedBuffer, len);
+      R__BasketReadEvent(fBranch, pos, 0, fObjlen, fObjlen);
    }
 
 AfterBuffer:
@@ -693,6 +780,88 @@ Int_t TBasket::ReadBasketBytes(Long64_t pos, TFile *file)
    return fNbytes;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the entry offsets of the basket whose key starts at `pos`, without
+/// reading or decompressing the basket payload.
+///
+/// Only the basket header and, when the basket was written with the
+/// `kSeparateOffsetMap` IO feature, the separate uncompressed offset record
+/// are read.  On success `offsets` holds one offset (relative to the start of
+/// the basket buffer) per entry and the number of entries is returned.
+/// Returns -1 if the header cannot be read or the basket has no separate
+/// offset record; in that case the caller has to read the basket itself.
+
+Int_t TBasket::ReadEntryOffsetMap(Long64_t pos, TFile *file, std::vector<Int_t> &offsets)
+{
+   offsets.clear();
+   if (!file || ReadBasketBytes(pos, file) <= 0 || fKeylen <= 0) {
+      return -1;
+   }
+
+   std::vector<char> header(fKeylen);
+   if (file->ReadBuffer(header.data(), pos, fKeylen)) {
+      return -1;
+   }
+   TBufferFile hbuf(TBuffer::kRead, fKeylen, header.data(), kFALSE);
+   fHeaderOnly = kTRUE;
+   Streamer(hbuf);
+   fHeaderOnly = kFALSE;
+   if (IsZombie() || !fSeekOffsetMap || fNbytesOffsetMap <= 0) {
+      return -1;
+   }
+
+   const Int_t len = 64;
+   char keyheader[len];
+   Int_t nbytes, objlen, keylen;
+   file->GetRecordHeader(keyheader, fSeekOffsetMap, len, nbytes, objlen, keylen);
+   if (nbytes != fNbytesOffsetMap || keylen <= 0 || objlen <= 0) {
+      Error("ReadEntryOffsetMap", "Inconsistent entry offset record at %lld for basket at %lld", fSeekOffsetMap, pos);
+      return -1;
+   }
+   std::vector<char> record(objlen);
+   if (file->ReadBuffer(record.data(), fSeekOffsetMap + keylen, objlen)) {
+      return -1;
+   }
+   TBufferFile rbuf(TBuffer::kRead, objlen, record.data(), kFALSE);
+   Int_t n = 0;
+   rbuf >> n;
+   if (n != fNevBuf || (Int_t)(n * sizeof(Int_t) + sizeof(Int_t)) > objlen) {
+      Error("ReadEntryOffsetMap", "Entry offset record at %lld does not match basket at %lld", fSeekOffsetMap, pos);
+      return -1;
+   }
+   offsets.resize(n);
+   rbuf.ReadFastArray(offsets.data(), n);
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the entry offsets as a separate uncompressed record, next to the
+/// basket itself, and remember its location in the basket header.
+///
+/// The record is a streamed TArrayI (number of entries followed by the
+/// offsets) so that it is self-describing for generic file inspection tools.
+/// The offsets are still stored in the basket payload as well; the record is
+/// purely additive and older releases simply ignore it.  The caller must hold
+/// the file write lock.
+
+void TBasket::WriteEntryOffsetMap(TFile *file, const Int_t *entryOffset)
+{
+   TBufferFile buf(TBuffer::kWrite, (fNevBuf + 1) * sizeof(Int_t));
+   buf << fNevBuf;
+   buf.WriteFastArray(entryOffset, fNevBuf);
+
+   TKey key(GetName(), "entry offsets", TArrayI::Class(), buf.Length(), file);
+   if (!key.GetSeekKey()) {
+      return;
+   }
+   memcpy(key.GetBuffer(), buf.Buffer(), buf.Length());
+   if (key.WriteFile(1) <= 0) {
+      return;
+   }
+   fSeekOffsetMap = key.GetSeekKey();
+   fNbytesOffsetMap = key.GetNbytes();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset the basket to the starting state. i.e. as it was after calling
 /// the constructor (and potentially attaching a TBuffer.)
@@ -751,6 +920,8 @@ void TBasket::Reset()
    fNevBufSize = newNevBufSize;
 
    fNevBuf      = 0;
+   fSeekOffsetMap   = 0;
+   fNbytesOffsetMap = 0;
    Int_t *storeEntryOffset = fEntryOffset;
    fEntryOffset = 0;
    Int_t *storeDisplacement = fDisplacement;
@@ -843,6 +1014,10 @@ void TBasket::Streamer(TBuffer &b)
             fNevBufSize = 0;
             MakeZombie();
          }
+         if (fIOBits & static_cast<UChar_t>(EIOBits::kSeparateOffsetMap)) {
+            b >> fSeekOffsetMap;
+            b >> fNbytesOffsetMap;
+         }
       }
       b >> fNevBuf;
       b >> fLast;
@@ -873,7 +1048,7 @@ void TBasket::Streamer(TBuffer &b)
          fEntryOffset = reinterpret_cast<Int_t *>(-1);
       }
       if (flag == 1 || flag > 10) {
-         fBufferRef = new TBufferFile(TBuffer::kRead,fBufferSize);
+         fBufferRef = ROOT::Internal::TBufferPool::NewBuffer(TBuffer::kRead, fBufferSize);
          fBufferRef->SetParent(b.GetParent());
          char *buf  = fBufferRef->Buffer();
          if (v > 1) b.ReadFastArray(buf,fLast);
@@ -897,6 +1072,10 @@ void TBasket::Streamer(TBuffer &b)
       if (fIOBits) {
          b << -fNevBufSize;
          b << fIOBits;
+         if (fIOBits & static_cast<UChar_t>(EIOBits::kSeparateOffsetMap)) {
+            b << fSeekOffsetMap;
+            b << fNbytesOffsetMap;
+         }
       } else {
          b << fNevBufSize;
       }
@@ -997,6 +1176,10 @@ Int_t TBasket::WriteBuffer()
    }
    fMotherDir = file; // fBranch->GetDirectory();
 
+   // Optional monitor of the compression and write times.
+   TVirtualPerfStats *perfStats = fBranch->GetTree()->GetPerfStats();
+   Double_t zipTime = 0;
+
    // This mutex prevents multiple TBasket::WriteBuffer invocations from interacting
    // with the underlying TFile at once - TFile is assumed to *not* be thread-safe.
    //
@@ -1020,6 +1203,8 @@ Int_t TBasket::WriteBuffer()
 
       Create(nout,file);
       fBufferRef->SetBufferOffset(0);
+      fSeekOffsetMap = 0;            // the separate entry offset record stays in the source file
+      fNbytesOffsetMap = 0;
       fHeaderOnly = kTRUE;
 
       Streamer(*fBufferRef);         //write key itself again
@@ -1031,6 +1216,11 @@ Int_t TBasket::WriteBuffer()
    // Transfer fEntryOffset table at the end of fBuffer.
    fLast = fBufferRef->Length();
    Int_t *entryOffset = GetEntryOffset();
+   fSeekOffsetMap = 0;
+   fNbytesOffsetMap = 0;
+   if (entryOffset && fNevBuf && (fIOBits & static_cast<UChar_t>(TBasket::EIOBits::kSeparateOffsetMap))) {
+      WriteEntryOffsetMap(file, entryOffset);
+   }
    if (entryOffset) {
       Bool_t hasOffsetBit = fIOBits & static_cast<UChar_t>(TBasket::EIOBits::kGenerateOffsetMap);
       if (!CanGenerateOffsetArray()) {
@@ -1067,7 +1257,7 @@ Int_t TBasket::WriteBuffer()
    fObjlen    = lbuf - fKeylen;
 
    fHeaderOnly = kTRUE;
-   fCycle = fBranch->GetWriteBasket();
+   fCycle = fAsyncCycle < 0 ? fBranch->GetWriteBasket() : fAsyncCycle;
    Int_t cxlevel = fBranch->GetCompressionLevel();
    ROOT::ECompressionAlgorithm cxAlgorithm = static_cast<ROOT::ECompressionAlgorithm>(fBranch->GetCompressionAlgorithm());
    if (cxlevel > 0) {
@@ -1084,6 +1274,23 @@ Int_t TBasket::WriteBuffer()
       char *bufcur = &fBuffer[fKeylen];
       noutot = 0;
       nzip   = 0;
+      // Small baskets compress much better against a dictionary trained on the branch content.
+      UInt_t dictID = 0;
+      if (cxAlgorithm == ROOT::kZSTD) {
+         TBranch::TDictionaryTraining training;
+         dictID = fBranch->AddCompressionDictionarySample(objbuf, fObjlen, training);
+         if (training.fMaxSize > 0) {
+            // The training is long: let the other baskets be written meanwhile.
+#ifdef R__USE_IMT
+            sentry.unlock();
+#endif  // R__USE_IMT
+            std::vector<char> dict = TBranch::TrainCompressionDictionary(training);
+#ifdef R__USE_IMT
+            sentry.lock();
+#endif  // R__USE_IMT
+            dictID = fBranch->SetTrainedCompressionDictionary(dict);
+         }
+      }
       for (Int_t i = 0; i < nbuffers; ++i) {
          if (i == nbuffers - 1) bufmax = fObjlen - nzip;
          else bufmax = kMAXZIPBUF;
@@ -1096,7 +1303,18 @@ Int_t TBasket::WriteBuffer()
          // NOTE this is declared with C linkage, so it shouldn't except.  Also, when
          // USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
          // (see fCompressedBufferRef in constructor).
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+         Double_t zipStart = 0;
+         if (R__unlikely(perfStats)) {
+            zipStart = TTimeStamp();
+         }
+         if (dictID) {
+            R__zipWithDictionary(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, dictID);
+         } else {
+            R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+         }
+         if (R__unlikely(perfStats)) {
+            zipTime += Double_t(TTimeStamp()) - zipStart;
+         }
 #ifdef R__USE_IMT
          sentry.lock();
 #endif  // R__USE_IMT
@@ -1140,8 +1358,15 @@ Int_t TBasket::WriteBuffer()
    }
 
 WriteFile:
+   Double_t start = 0;
+   if (R__unlikely(perfStats)) {
+      start = TTimeStamp();
+   }
    Int_t nBytes = WriteFileKeepBuffer();
    fHeaderOnly = kFALSE;
+   if (R__unlikely(perfStats)) {
+      perfStats->BasketWriteEvent(fBranch, zipTime, start, fObjlen, nout);
+   }
    return nBytes>0 ? fKeylen+nout : -1;
 }
 
@@ -12,6 +12,7 @@
 #include "TBranch.h"
 
 #include "Compression.h"
+#include "RZip.h"
 #include "TBasket.h"
 #include "TBranchBrowsable.h"
 #include "TBrowser.h"
@@ -34,18 +35,22 @@
 #include "TROOT.h"
 #include "TSystem.h"
 #include "TMath.h"
+#include "TTimeStamp.h"
 #include "TTree.h"
 #include "TTreeCache.h"
 #include "TTreeCacheUnzip.h"
 #include "TVirtualMutex.h"
 #include "TVirtualPad.h"
+#include "TVirtualPerfStats.h"
 
 #include "TBranchIMTHelper.h"
 
+#include "ROOT/ByteSwapArray.hxx"
 #include "ROOT/TIOFeatures.hxx"
 
 #include <atomic>
 #include <cstddef>
+#include <mutex>
 #include <string.h>
 #include <stdio.h>
 
@@ -485,6 +490,13 @@ TBranch::~TBranch()
       delete fTransientBuffer;
       fTransientBuffer = 0;
    }
+
+   if (fCompressionDictID) {
+      R__zipUnregisterDictionary(fCompressionDictID);
+      fCompressionDictID = 0;
+   }
+   delete [] fCompressionDict;
+   fCompressionDict = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -514,6 +526,7 @@ TBuffer* TBranch::GetTransientBuffer(Int_t size)
 
 void TBranch::AddBasket(TBasket& b, Bool_t ondisk, Long64_t startEntry)
 {
+   LoadBasketArrays();
    TBasket *basket = &b;
 
    basket->SetBranch(this);
@@ -580,6 +593,7 @@ void TBranch::AddBasket(TBasket& b, Bool_t ondisk, Long64_t startEntry)
 
 void TBranch::AddLastBasket(Long64_t startEntry)
 {
+   LoadBasketArrays();
    if (fWriteBasket >= fMaxBaskets) {
       ExpandBasketArrays();
    }
@@ -627,6 +641,7 @@ void TBranch::Browse(TBrowser* b)
 
 void TBranch::DeleteBaskets(Option_t* option)
 {
+   LoadBasketArrays();
    TString opt = option;
    opt.ToLower();
    TFile *file = GetFile(0);
@@ -658,6 +673,7 @@ void TBranch::DeleteBaskets(Option_t* option)
 
 void TBranch::DropBaskets(Option_t* options)
 {
+   LoadBasketArrays();
    Bool_t all = kFALSE;
    if (options && options[0]) {
       TString opt = options;
@@ -720,12 +736,111 @@ void TBranch::DropBaskets(Option_t* options)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Train a compression dictionary for this branch and its sub-branches.
+///
+/// Small baskets compress poorly because each one is compressed on its own.
+/// With this option the uncompressed content of the first baskets written
+/// (about `trainingbytes` bytes, by default 100 times `maxsize`) is used to
+/// train a dictionary of at most `maxsize` bytes.  The dictionary is stored
+/// once with the branch metadata and all the following baskets are compressed
+/// against it; the baskets written before the training keep their regular
+/// compression.  On reading the dictionary is loaded with the branch and kept
+/// in memory for as long as the branch exists.
+///
+/// Dictionaries are only supported by the ZSTD algorithm (see
+/// TFile::SetCompressionSettings); for the other algorithms the option has no
+/// effect.  Calling it with `maxsize = 0` stops a training not yet completed.
+///
+/// Note that files written with a dictionary cannot be read by versions of
+/// ROOT not supporting them.
+
+void TBranch::EnableCompressionDictionary(Int_t maxsize, Long64_t trainingbytes)
+{
+   if (maxsize < 0) maxsize = 0;
+   if (trainingbytes <= 0) trainingbytes = 100 * (Long64_t)maxsize;
+   if (fNCompressionDict == 0) {
+      fCompressionDictMaxSize = maxsize;
+      fCompressionDictTraining = trainingbytes;
+      if (!maxsize) {
+         std::vector<char>().swap(fDictSamples);
+         std::vector<size_t>().swap(fDictSampleSizes);
+      }
+   }
+
+   Int_t nb = fBranches.GetEntriesFast();
+   for (Int_t i = 0; i < nb; ++i) {
+      TBranch *branch = (TBranch*)fBranches.UncheckedAt(i);
+      branch->EnableCompressionDictionary(maxsize, trainingbytes);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called by TBasket::WriteBuffer, with the write lock of the file held,
+/// before compressing the uncompressed payload `buffer` of `len` bytes.  While
+/// a dictionary is being trained the payload is kept as a sample.  Once enough
+/// bytes were collected the samples are moved to `training`, and no more are
+/// collected: the caller trains the dictionary with TrainCompressionDictionary
+/// after releasing the lock, then sets it with SetTrainedCompressionDictionary.
+/// Returns the identifier of the dictionary to compress the basket with, or 0
+/// if the basket is to be compressed on its own.
+
+UInt_t TBranch::AddCompressionDictionarySample(const char *buffer, Int_t len, TDictionaryTraining &training)
+{
+   if (fCompressionDictID || fCompressionDictMaxSize <= 0 || len <= 0) {
+      return fCompressionDictID;
+   }
+   // Large baskets do not need a dictionary; do not let them dominate the training either.
+   const Int_t kMaxSampleSize = 128 * 1024;
+   Int_t nsample = TMath::Min(len, kMaxSampleSize);
+   fDictSamples.insert(fDictSamples.end(), buffer, buffer + nsample);
+   fDictSampleSizes.push_back(nsample);
+   if ((Long64_t)fDictSamples.size() < fCompressionDictTraining) {
+      return 0;
+   }
+
+   training.fSamples.swap(fDictSamples);
+   training.fSampleSizes.swap(fDictSampleSizes);
+   training.fMaxSize = fCompressionDictMaxSize;
+   fCompressionDictMaxSize = 0;
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the dictionary trained on the samples collected by
+/// AddCompressionDictionarySample, empty if the training failed.  Does not
+/// use the branch, so that it can run without the write lock of the file.
+
+std::vector<char> TBranch::TrainCompressionDictionary(const TDictionaryTraining &training)
+{
+   std::vector<char> dict(training.fMaxSize);
+   Int_t ndict = R__zipTrainDictionary(dict.data(), training.fMaxSize, training.fSamples.data(),
+                                       training.fSampleSizes.data(), training.fSampleSizes.size());
+   dict.resize(TMath::Max(ndict, 0));
+   return dict;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the dictionary returned by TrainCompressionDictionary, with the write
+/// lock of the file held, and return its identifier, 0 if the training failed.
+
+UInt_t TBranch::SetTrainedCompressionDictionary(const std::vector<char> &dict)
+{
+   if (dict.empty()) {
+      Warning("AddCompressionDictionarySample", "Unable to train a compression dictionary for branch %s, the baskets will be compressed individually.", GetName());
+      return 0;
+   }
+   SetCompressionDictionary(dict.data(), dict.size());
+   return fCompressionDictID;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increase BasketEntry buffer of a minimum of 10 locations
 /// and a maximum of 50 per cent of current size.
 
 void TBranch::ExpandBasketArrays()
 {
+   LoadBasketArrays();
    Int_t newsize = TMath::Max(10,Int_t(1.5*fMaxBaskets));
    fBasketBytes  = TStorage::ReAllocInt(fBasketBytes, newsize, fMaxBaskets);
    fBasketEntry  = (Long64_t*)TStorage::ReAlloc(fBasketEntry,
@@ -783,6 +898,13 @@ Int_t TBranch::FillImpl(ROOT::Internal::TBranchIMTHelper *imtHelper)
    Int_t lnew = 0;
    Int_t nbytes = 0;
 
+   // Optional monitor of the serialization time, including the streamers.
+   TVirtualPerfStats *perfStats = fTree->GetPerfStats();
+   Double_t start = 0;
+   if (R__unlikely(perfStats)) {
+      start = TTimeStamp();
+   }
+
    if (fEntryBuffer) {
       nbytes = FillEntryBuffer(basket,buf,lnew);
    } else {
@@ -799,6 +921,10 @@ Int_t TBranch::FillImpl(ROOT::Internal::TBranchIMTHelper *imtHelper)
       nbytes = lnew - lold;
    }
 
+   if (R__unlikely(perfStats)) {
+      perfStats->BranchFillEvent(this, start, nbytes);
+   }
+
    if (fEntryOffsetLen) {
       Int_t nevbuf = basket->GetNevBuf();
       // Total size in bytes of EntryOffset table.
@@ -1028,6 +1154,16 @@ TLeaf* TBranch::FindLeaf(const char* searchname)
 /// Return the number of bytes written or -1 in case of write error.
 
 Int_t TBranch::FlushBaskets()
+{
+   return FlushBasketsImpl(nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of FlushBaskets; if imtHelper is non-null, the baskets are
+/// written through it (in IMT tasks or, for the write basket, handed over to
+/// the asynchronous flush queue).
+
+Int_t TBranch::FlushBasketsImpl(ROOT::Internal::TBranchIMTHelper *imtHelper)
 {
    UInt_t nerror = 0;
    Int_t nbytes = 0;
@@ -1040,7 +1176,7 @@ Int_t TBranch::FlushBaskets()
    //}
    for(Int_t i=0; i != maxbasket; ++i) {
       if (fBaskets.UncheckedAt(i)) {
-         Int_t nwrite = FlushOneBasket(i);
+         Int_t nwrite = FlushOneBasketImpl(i, imtHelper);
          if (nwrite<0) {
             ++nerror;
          } else {
@@ -1054,7 +1190,7 @@ Int_t TBranch::FlushBaskets()
       if (!branch) {
          continue;
       }
-      Int_t nwrite = branch->FlushBaskets();
+      Int_t nwrite = branch->FlushBasketsImpl(imtHelper);
       if (nwrite<0) {
          ++nerror;
       } else {
@@ -1075,6 +1211,15 @@ Int_t TBranch::FlushBaskets()
 
 Int_t TBranch::FlushOneBasket(UInt_t ibasket)
 {
+   return FlushOneBasketImpl(ibasket, nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of FlushOneBasket, writing the basket through imtHelper if non-null.
+
+Int_t TBranch::FlushOneBasketImpl(UInt_t ibasket, ROOT::Internal::TBranchIMTHelper *imtHelper)
+{
+   LoadBasketArrays();
    Int_t nbytes = 0;
    if (fDirectory && fBaskets.GetEntries()) {
       TBasket *basket = (TBasket*)fBaskets.UncheckedAt(ibasket);
@@ -1088,7 +1233,7 @@ Int_t TBranch::FlushOneBasket(UInt_t ibasket)
             if (basket->GetBufferRef()->IsReading()) {
                basket->SetWriteMode();
             }
-            nbytes = WriteBasket(basket,ibasket);
+            nbytes = WriteBasketImpl(basket, ibasket, imtHelper);
 
          } else {
             // If the basket is empty or has already been written.
@@ -1116,6 +1261,7 @@ Int_t TBranch::FlushOneBasket(UInt_t ibasket)
 
 TBasket* TBranch::GetBasket(Int_t basketnumber)
 {
+   LoadBasketArrays();
    // This counter in the sequential case collects errors coming also from
    // different files (suppose to have a program reading f1.root, f2.root ...)
    // In the mt case, it is made atomic: it safely collects errors from
@@ -1128,6 +1274,9 @@ TBasket* TBranch::GetBasket(Int_t basketnumber)
    if (basket) return basket;
    if (basketnumber == fWriteBasket) return 0;
 
+   // The basket may still be in the hands of the asynchronous flush.
+   if (R__unlikely(fBasketSeek[basketnumber] == 0)) fTree->FlushAsyncBaskets();
+
    // create/decode basket parameters from buffer
    TFile *file = GetFile(0);
    if (file == 0) {
@@ -1181,11 +1330,55 @@ TBasket* TBranch::GetBasket(Int_t basketnumber)
    return basket;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill `offsets` with the offset of each entry within the buffer of the
+/// basket number `basketnumber`; returns the number of entries in the basket
+/// or -1 on error.
+///
+/// If the basket is not in memory and was written with the
+/// `ROOT::Experimental::EIOFeatures::kSeparateOffsetMap` IO feature, only the
+/// small uncompressed offset record is read from the file: this allows sizing
+/// or locating variable-size entries without decompressing the basket.
+/// Otherwise the basket is read.
+
+Int_t TBranch::GetBasketEntryOffsets(Int_t basketnumber, std::vector<Int_t> &offsets)
+{
+   LoadBasketArrays();
+   offsets.clear();
+   if (basketnumber < 0 || basketnumber > fWriteBasket) return -1;
+
+   TBasket *basket = (TBasket*)fBaskets.UncheckedAt(basketnumber);
+   if (!basket && fBasketSeek[basketnumber]) {
+      TFile *file = GetFile(0);
+      if (file && fIOFeatures.Test(ROOT::Experimental::EIOFeatures::kSeparateOffsetMap)) {
+         TBasket header(file);
+         Int_t nentries = header.ReadEntryOffsetMap(fBasketSeek[basketnumber], file, offsets);
+         if (nentries >= 0) return nentries;
+      }
+   }
+   if (!basket) basket = GetBasket(basketnumber);
+   if (!basket) return -1;
+
+   Int_t nentries = basket->GetNevBuf();
+   Int_t *entryOffset = basket->GetEntryOffset();
+   if (entryOffset) {
+      offsets.assign(entryOffset, entryOffset + nentries);
+   } else {
+      // Fixed-size entries: fNevBufSize holds the size of each entry.
+      offsets.resize(nentries);
+      for (Int_t i = 0; i < nentries; ++i) {
+         offsets[i] = basket->GetKeylen() + i * basket->GetNevBufSize();
+      }
+   }
+   return nentries;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return address of basket in the file
 
 Long64_t TBranch::GetBasketSeek(Int_t basketnumber) const
 {
+   LoadBasketArrays();
    if (basketnumber <0 || basketnumber > fWriteBasket) return 0;
    return fBasketSeek[basketnumber];
 }
@@ -1243,6 +1436,7 @@ const char* TBranch::GetIconName() const
 
 Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
 {
+   LoadBasketArrays();
    // Remember which entry we are reading.
    fReadEntry = entry;
 
@@ -1336,6 +1530,189 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
    return buf->Length() - bufbegin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the size in bytes of one entry if this branch can be read with the
+/// bulk interface (GetBulkEntries, GetEntriesSerialized), 0 otherwise.
+///
+/// The bulk interface is available for the branches made of a single leaf of
+/// a basic type (TLeafB, TLeafS, TLeafI, TLeafL, TLeafF, TLeafD, TLeafO),
+/// possibly a fixed-size array, without leaf count nor sub-branches: all the
+/// entries of the baskets of such branches have the same size and the same
+/// layout in memory and on file, up to the byte order.
+
+Int_t TBranch::GetBulkEntrySize() const
+{
+   if (IsA() != TBranch::Class() || fNleaves != 1 || fBranches.GetEntriesFast()) return 0;
+   TLeaf *leaf = (TLeaf*)fLeaves.UncheckedAt(0);
+   if (!leaf || leaf->GetLeafCount()) return 0;
+   TClass *cl = leaf->IsA();
+   if (cl != TLeafB::Class() && cl != TLeafS::Class() && cl != TLeafI::Class() && cl != TLeafL::Class() &&
+       cl != TLeafF::Class() && cl != TLeafD::Class() && cl != TLeafO::Class()) {
+      return 0;
+   }
+   return leaf->GetLenType() * leaf->GetLenStatic();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Locate and load the basket containing entry for a bulk read.
+///
+/// On success, return the number of entries between entry and the end of the
+/// basket (the basket is made the current read basket); return 0 if entry is
+/// out of range and -1 in case of error or if the branch (or the basket, in
+/// case of very old files) cannot be bulk-read.
+
+Int_t TBranch::GetBulkBasket(Long64_t entry, TBasket *&basket, Int_t &entrySize)
+{
+   entrySize = GetBulkEntrySize();
+   if (!entrySize) {
+      Error("GetBulkEntries", "Branch %s cannot be read in bulk: only single-leaf branches of fixed-size basic types are supported.", GetName());
+      return -1;
+   }
+   if ((entry < fFirstEntry) || (entry >= fEntryNumber)) {
+      return 0;
+   }
+   basket = LoadBasketOfEntry(entry);
+   if (!basket) {
+      return -1;
+   }
+   if (R__unlikely(basket->GetEntryOffset() || basket->GetNevBufSize() != entrySize)) {
+      Error("GetBulkEntries", "Basket %d of branch %s does not have the fixed-size layout needed for bulk reads.", fReadBasket, GetName());
+      return -1;
+   }
+   return fNextBasketEntry - entry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make the basket containing entry, which must be in range, the current read
+/// basket, loading it if needed, and return it with its buffer in read mode.
+/// Return nullptr if no basket contains entry or if it cannot be read.
+///
+/// This is the part of GetEntry used by the bulk and column-wise reads.
+
+TBasket *TBranch::LoadBasketOfEntry(Long64_t entry)
+{
+   LoadBasketArrays();
+   fReadEntry = entry;
+   if (!(fFirstBasketEntry <= entry && entry < fNextBasketEntry && fCurrentBasket)) {
+      fReadBasket = TMath::BinarySearch(fWriteBasket + 1, fBasketEntry, entry);
+      if (fReadBasket < 0) {
+         fNextBasketEntry = -1;
+         Error("LoadBasketOfEntry", "In the branch %s, no basket contains the entry %lld\n", GetName(), entry);
+         return nullptr;
+      }
+      if (fReadBasket == fWriteBasket) {
+         fNextBasketEntry = fEntryNumber;
+      } else {
+         fNextBasketEntry = fBasketEntry[fReadBasket+1];
+      }
+      fFirstBasketEntry = fBasketEntry[fReadBasket];
+      fCurrentBasket = GetBasket(fReadBasket);
+      if (!fCurrentBasket) {
+         fFirstBasketEntry = -1;
+         fNextBasketEntry = -1;
+         return nullptr;
+      }
+   }
+   TBuffer *buf = fCurrentBasket->GetBufferRef();
+   if (R__unlikely(!buf)) {
+      return nullptr;
+   }
+   if (R__unlikely(!buf->IsReading())) {
+      fCurrentBasket->SetReadMode();
+   }
+   return fCurrentBasket;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read, in one go, all the entries from entry to the end of the basket containing it.
+///
+/// The entries are copied, in their on-file (big-endian) representation, at
+/// the beginning of user_buf, which is expanded if needed; its buffer offset is
+/// set to 0. The per-entry TBuffer and TLeaf machinery is not used, so the
+/// branch address is not updated.
+///
+/// This is meant for consumers (e.g. sending data over the network) that need
+/// the serialized form; use GetBulkEntries to get the values in memory.
+///
+/// Only branches for which GetBulkEntrySize() is non-zero are supported.
+/// Return the number of entries read, 0 if entry is out of range and -1 in case of error.
+
+Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf)
+{
+   TBasket *basket = nullptr;
+   Int_t entrySize = 0;
+   Int_t nentries = GetBulkBasket(entry, basket, entrySize);
+   if (nentries <= 0) return nentries;
+
+   Int_t nbytes = nentries * entrySize;
+   const char *src = basket->GetBufferRef()->Buffer() + basket->GetKeylen() + (entry - fFirstBasketEntry) * entrySize;
+   if (user_buf.BufferSize() < nbytes) {
+      user_buf.Expand(nbytes, kFALSE);
+   }
+   memcpy(user_buf.Buffer(), src, nbytes);
+   user_buf.SetBufferOffset(0);
+   return nentries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read, in one go, all the entries from entry to the end of the basket containing it.
+///
+/// The values are stored contiguously, in the machine representation, at the
+/// beginning of user_buf (expanded if needed, buffer offset set to 0): for a
+/// `Float_t` branch, `reinterpret_cast<Float_t*>(user_buf.Buffer())[i]` is the
+/// value of entry `entry + i`. The byte swap is done in place by
+/// ROOT::Internal::FromBigEndianArray, 16 bytes at a time with SSE2 (SSSE3 if
+/// available) and a scalar loop for the remaining elements, bypassing the
+/// per-entry TBuffer and TLeaf machinery; the branch address is therefore not
+/// updated.
+///
+/// Only branches for which GetBulkEntrySize() is non-zero are supported.
+/// Return the number of entries read, 0 if entry is out of range and -1 in case of error.
+
+Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf)
+{
+   Int_t nentries = GetEntriesSerialized(entry, user_buf);
+   if (nentries <= 0) return nentries;
+
+   TLeaf *leaf = (TLeaf*)fLeaves.UncheckedAt(0);
+   ROOT::Internal::FromBigEndianArray(user_buf.Buffer(), user_buf.Buffer(), (size_t)nentries * leaf->GetLenStatic(), leaf->GetLenType());
+   return nentries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the values of nentries entries starting at first into the contiguous,
+/// caller-owned, buffer (which must be able to hold nentries * GetBulkEntrySize() bytes).
+///
+/// The data of each basket traversed is byte swapped straight from the basket
+/// buffer into buffer, bypassing the per-entry TBuffer and TLeaf machinery; the
+/// branch address is not updated. The range is truncated at the last entry of
+/// the branch.
+///
+/// Only branches for which GetBulkEntrySize() is non-zero are supported.
+/// Return the number of entries read or -1 in case of error.
+
+Long64_t TBranch::GetBulkEntries(Long64_t first, Long64_t nentries, void *buffer)
+{
+   char *dest = static_cast<char*>(buffer);
+   Long64_t nread = 0;
+   while (nread < nentries) {
+      TBasket *basket = nullptr;
+      Int_t entrySize = 0;
+      Long64_t entry = first + nread;
+      Int_t navailable = GetBulkBasket(entry, basket, entrySize);
+      if (navailable < 0) return -1;
+      if (navailable == 0) break;
+
+      Long64_t n = TMath::Min((Long64_t)navailable, nentries - nread);
+      const char *src = basket->GetBufferRef()->Buffer() + basket->GetKeylen() + (entry - fFirstBasketEntry) * entrySize;
+      TLeaf *leaf = (TLeaf*)fLeaves.UncheckedAt(0);
+      ROOT::Internal::FromBigEndianArray(dest, src, (size_t)n * leaf->GetLenStatic(), leaf->GetLenType());
+      dest += n * entrySize;
+      nread += n;
+   }
+   return nread;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read all leaves of an entry and export buffers to real objects in a TClonesArray list.
 ///
@@ -1343,6 +1720,7 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
 
 Int_t TBranch::GetEntryExport(Long64_t entry, Int_t /*getall*/, TClonesArray* li, Int_t nentries)
 {
+   LoadBasketArrays();
    // Remember which entry we are reading.
    fReadEntry = entry;
 
@@ -1469,6 +1847,7 @@ TFile* TBranch::GetFile(Int_t mode)
 
 TBasket* TBranch::GetFreshBasket()
 {
+   LoadBasketArrays();
    TBasket *basket = 0;
    if (GetTree()->MemoryFull(0)) {
       if (fNBaskets==1) {
@@ -1513,6 +1892,7 @@ TBasket* TBranch::GetFreshBasket()
 
 TBasket *TBranch::GetFreshCluster()
 {
+   LoadBasketArrays();
    TBasket *basket = 0;
 
    // If GetClusterIterator is called with a negative entry then GetStartEntry will be 0
@@ -1818,6 +2198,7 @@ void TBranch::KeepCircular(Long64_t maxEntries)
 
 Int_t TBranch::LoadBaskets()
 {
+   LoadBasketArrays();
    Int_t nimported = 0;
    Int_t nbaskets = fWriteBasket;
    TFile *file = GetFile(0);
@@ -1996,6 +2377,8 @@ void TBranch::FillLeavesImpl(TBuffer& b)
 void TBranch::Refresh(TBranch* b)
 {
    if (b==0) return;
+   LoadBasketArrays();
+   b->LoadBasketArrays();
 
    fEntryOffsetLen = b->fEntryOffsetLen;
    fWriteBasket    = b->fWriteBasket;
@@ -2044,6 +2427,7 @@ void TBranch::Refresh(TBranch* b)
 
 void TBranch::Reset(Option_t*)
 {
+   LoadBasketArrays();
    fReadBasket = 0;
    fReadEntry = -1;
    fFirstBasketEntry = -1;
@@ -2085,6 +2469,7 @@ void TBranch::Reset(Option_t*)
 
 void TBranch::ResetAfterMerge(TFileMergeInfo *)
 {
+   LoadBasketArrays();
    fReadBasket       = 0;
    fReadEntry        = -1;
    fFirstBasketEntry = -1;
@@ -2301,6 +2686,35 @@ void TBranch::SetCompressionSettings(Int_t settings)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the dictionary the baskets of this branch are compressed against and
+/// register it with the compression library.  Used once the training is over
+/// and by TTreeCloner, which copies the baskets without uncompressing them.
+
+void TBranch::SetCompressionDictionary(const char *dict, Int_t len)
+{
+   if (fCompressionDictID) {
+      R__zipUnregisterDictionary(fCompressionDictID);
+      fCompressionDictID = 0;
+   }
+   delete [] fCompressionDict;
+   fCompressionDict = 0;
+   fNCompressionDict = 0;
+   fCompressionDictMaxSize = 0;
+   std::vector<char>().swap(fDictSamples);
+   std::vector<size_t>().swap(fDictSampleSizes);
+   if (!dict || len <= 0) {
+      return;
+   }
+   fCompressionDict = new char[len];
+   memcpy(fCompressionDict, dict, len);
+   fNCompressionDict = len;
+   fCompressionDictID = R__zipRegisterDictionary(fCompressionDict, fNCompressionDict);
+   if (!fCompressionDictID) {
+      Error("SetCompressionDictionary", "Unable to register the compression dictionary of branch %s.", GetName());
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Update the default value for the branch's fEntryOffsetLen if and only if
 /// it was already non zero (and the new value is not zero)
@@ -2455,9 +2869,27 @@ void TBranch::Streamer(TBuffer& b)
       fFirstBasketEntry = -1;
       fNextBasketEntry  = -1;
 
+      fBasketArraysPending = kFALSE;
+      fBasketArraysOnFile.clear();
+
       Version_t v = b.ReadVersion(&R__s, &R__c);
       if (v > 9) {
-         b.ReadClassBuffer(TBranch::Class(), this, v, R__s, R__c);
+         if (fCompressionDictID) {
+            R__zipUnregisterDictionary(fCompressionDictID);
+            fCompressionDictID = 0;
+         }
+         if (v == TBranch::Class_Version() && dynamic_cast<TBufferFile *>(&b)) {
+            ReadCurrentVersion(b);
+            b.CheckByteCount(R__s, R__c, TBranch::IsA());
+         } else {
+            b.ReadClassBuffer(TBranch::Class(), this, v, R__s, R__c);
+         }
+         if (fNCompressionDict > 0) {
+            fCompressionDictID = R__zipRegisterDictionary(fCompressionDict, fNCompressionDict);
+            if (!fCompressionDictID) {
+               Error("Streamer", "Unable to load the compression dictionary of branch %s.", GetName());
+            }
+         }
 
          if (fWriteBasket>=fBaskets.GetSize()) {
             fBaskets.Expand(fWriteBasket+1);
@@ -2652,6 +3084,7 @@ void TBranch::Streamer(TBuffer& b)
          }
       }
    } else {
+      LoadBasketArrays();
       Int_t maxBaskets = fMaxBaskets;
       fMaxBaskets = fWriteBasket+1;
       Int_t lastBasket = fMaxBaskets;
@@ -2680,12 +3113,118 @@ void TBranch::Streamer(TBuffer& b)
    }
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new array of n elements decoded from the big-endian bytes at
+/// onfile, which is moved past them, or 0 if the array was not written.
+
+template <typename T>
+T *DecodeBasketArray(const char *&onfile, Int_t n)
+{
+   if (!*onfile++)
+      return 0;
+   T *array = new T[n];
+   ROOT::Internal::FromBigEndianArray(array, onfile, n, sizeof(T));
+   onfile += n * sizeof(T);
+   return array;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the members of the current class version from the binary buffer b,
+/// in the order of its streamer info, as ReadClassBuffer does. The basket
+/// arrays are not decoded: their on-file bytes are kept in fBasketArraysOnFile
+/// until the first use of the arrays, see DecodeBasketArrays. A job usually
+/// reads a few of the many branches of a tree, and the arrays of the others
+/// are then never allocated nor byte swapped.
+
+void TBranch::ReadCurrentVersion(TBuffer &b)
+{
+   static TClass *ioFeaturesClass = TClass::GetClass(typeid(ROOT::TIOFeatures));
+
+   TNamed::Streamer(b);
+   TAttFill::Streamer(b);
+   b >> fCompress;
+   b >> fBasketSize;
+   b >> fEntryOffsetLen;
+   b >> fWriteBasket;
+   b >> fEntryNumber;
+   ioFeaturesClass->Streamer(&fIOFeatures, b);
+   b >> fOffset;
+   b >> fMaxBaskets;
+   b >> fSplitLevel;
+   b >> fEntries;
+   b >> fFirstEntry;
+   b >> fTotBytes;
+   b >> fZipBytes;
+   fBranches.Streamer(b);
+   fLeaves.Streamer(b);
+   fBaskets.Streamer(b);
+
+   // fBasketBytes, fBasketEntry and fBasketSeek: each one is a flag telling
+   // whether the array was written, followed by its fMaxBaskets elements.
+   delete [] fBasketBytes;
+   delete [] fBasketEntry;
+   delete [] fBasketSeek;
+   fBasketBytes = 0;
+   fBasketEntry = 0;
+   fBasketSeek  = 0;
+   const Bool_t validSize = fMaxBaskets > 0 && fMaxBaskets <= b.BufferSize();
+   fBasketArraysOnFile.reserve(3 + (validSize ? fMaxBaskets * (sizeof(Int_t) + 2 * sizeof(Long64_t)) : 0));
+   for (size_t size : {sizeof(Int_t), sizeof(Long64_t), sizeof(Long64_t)}) {
+      Char_t isArray;
+      b >> isArray;
+      fBasketArraysOnFile.push_back(isArray && validSize);
+      if (isArray && validSize) {
+         const size_t start = fBasketArraysOnFile.size();
+         fBasketArraysOnFile.resize(start + fMaxBaskets * size);
+         b.ReadFastArray(&fBasketArraysOnFile[start], Int_t(fMaxBaskets * size));
+      }
+   }
+   fBasketArraysPending.store(kTRUE, std::memory_order_release);
+
+   fFileName.Streamer(b);
+   b >> fNCompressionDict;
+   Char_t isArray;
+   b >> isArray;
+   delete [] fCompressionDict;
+   fCompressionDict = nullptr;
+   if (isArray && fNCompressionDict > 0) {
+      fCompressionDict = new char[fNCompressionDict];
+      b.ReadFastArray(fCompressionDict, fNCompressionDict);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decode fBasketBytes, fBasketEntry and fBasketSeek from the bytes kept by
+/// ReadCurrentVersion. Called by LoadBasketArrays at the first use of the
+/// arrays, possibly concurrently by the threads of TTreeCacheUnzip.
+
+void TBranch::DecodeBasketArrays()
+{
+   static std::mutex decodeMutex;
+   std::lock_guard<std::mutex> lock(decodeMutex);
+   if (!fBasketArraysPending.load(std::memory_order_relaxed))
+      return;
+
+   const char *onfile = fBasketArraysOnFile.data();
+   fBasketBytes = DecodeBasketArray<Int_t>(onfile, fMaxBaskets);
+   fBasketEntry = DecodeBasketArray<Long64_t>(onfile, fMaxBaskets);
+   fBasketSeek  = DecodeBasketArray<Long64_t>(onfile, fMaxBaskets);
+
+   std::vector<char>().swap(fBasketArraysOnFile);
+   fBasketArraysPending.store(kFALSE, std::memory_order_release);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write the current basket to disk and return the number of bytes
 /// written to the file.
 
 Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *imtHelper)
 {
+   LoadBasketArrays();
    Int_t nevbuf = basket->GetNevBuf();
    if (fEntryOffsetLen > 10 &&  (4*nevbuf) < fEntryOffsetLen ) {
       // Make sure that the fEntryOffset array does not stay large unnecessarily.
@@ -2695,6 +3234,52 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
       fEntryOffsetLen = 2*nevbuf; // assume some fluctuations.
    }
 
+#ifdef R__USE_IMT
+   ROOT::Internal::TBasketAsyncWriteQueue *asyncQueue = imtHelper ? imtHelper->GetAsyncQueue() : nullptr;
+   if (asyncQueue && where == fWriteBasket) {
+      // Asynchronous flush: hand the full basket over to an IMT task and move on to
+      // a fresh write basket right away.  The task only compresses and writes the
+      // basket, which it owns from now on; the branch bookkeeping is done by `commit`
+      // on the filling thread once the write has completed (see TTree::FlushAsyncBaskets).
+      fBaskets[where] = 0;
+      --fNBaskets;
+      if (basket == fCurrentBasket) {
+         fCurrentBasket    = 0;
+         fFirstBasketEntry = -1;
+         fNextBasketEntry  = -1;
+      }
+      basket->DetachForAsyncWrite(where);
+      ++fWriteBasket;
+      if (fWriteBasket >= fMaxBaskets) {
+         ExpandBasketArrays();
+      }
+      fBasketEntry[fWriteBasket] = fEntryNumber;
+
+      auto write = [this, basket]() {
+         Int_t nout = basket->WriteBuffer();
+         if (nout < 0) Error("TBranch::WriteBasketImpl", "basket's WriteBuffer failed.\n");
+         return nout;
+      };
+      auto commit = [=](Int_t nout) {
+         fBasketBytes[where] = basket->GetNbytes();
+         fBasketSeek[where]  = basket->GetSeekKey();
+         if (nout > 0) {
+            Int_t addbytes = basket->GetObjlen() + basket->GetKeylen();
+            fZipBytes += nout;
+            fTotBytes += addbytes;
+            fTree->AddTotBytes(addbytes);
+            fTree->AddZipBytes(nout);
+         }
+         basket->DropBuffers();
+         delete basket;
+      };
+      Long64_t nbytes = 0;
+      Int_t nerrors = 0;
+      asyncQueue->Push(write, commit, nbytes, nerrors);
+      return nerrors ? -1 : 0;
+   }
+#endif
+
    // Note: captures `basket`, `where`, and `this` by value; modifies the TBranch and basket,
    // as we make a copy of the pointer.  We cannot capture `basket` by reference as the pointer
    // itself might be modified after `WriteBasketImpl` exits.
@@ -2758,6 +3343,7 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
 
 void TBranch::SetFirstEntry(Long64_t entry)
 {
+   LoadBasketArrays();
    fFirstEntry = entry;
    fEntries = 0;
    fEntryNumber = entry;
@@ -48,6 +48,8 @@ A Branch for the case of an object.
 #include "TStreamerInfoActions.h"
 #include "TSchemaRuleSet.h"
 
+#include "ROOT/ByteSwapArray.hxx"
+
 ClassImp(TBranchElement);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1953,7 +1955,7 @@ void TBranchElement::InitInfo()
 
             TStreamerInfo* info;
             if( targetClass != cl )
-               info = (TStreamerInfo*)targetClass->GetConversionStreamerInfo( cl, fCheckSum );
+               info = (TStreamerInfo*)targetClass->FindConversionStreamerInfo( cl, fCheckSum );
             else {
                info = (TStreamerInfo*)cl->FindStreamerInfo( fCheckSum );
                if (info) {
@@ -2344,6 +2346,95 @@ Int_t TBranchElement::GetEntry(Long64_t entry, Int_t getall)
    return nbytes;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the size in bytes of the values of this branch if it can be read
+/// column-wise with GetEntryColumn, 0 otherwise.
+///
+/// This is the case of the branches of the data members of basic type of the
+/// objects of a split TClonesArray or STL collection (kClonesMemberNode and
+/// kSTLMemberNode), when the member is not an array and is read without
+/// conversion (no Double32_t, Float16_t nor schema evolution): the basket
+/// then holds, for each entry, the values of the member for all the elements
+/// of the collection, one after the other.
+
+Int_t TBranchElement::GetColumnValueSize() const
+{
+   if ((fType != kClonesMemberNode && fType != kSTLMemberNode) || fID < 0 || fBranches.GetEntriesFast()) {
+      return 0;
+   }
+   TStreamerInfo *info = GetInfo();
+   if (!info) {
+      return 0;
+   }
+   TStreamerElement *element = (TStreamerElement*)info->GetElements()->At(fID);
+   if (!element || element->IsA() != TStreamerBasicType::Class() || element->GetArrayLength() ||
+       element->GetNewType() != element->GetType()) {
+      return 0;
+   }
+   switch (element->GetType()) {
+      case TVirtualStreamerInfo::kBool:
+      case TVirtualStreamerInfo::kChar:
+      case TVirtualStreamerInfo::kUChar:   return 1;
+      case TVirtualStreamerInfo::kShort:
+      case TVirtualStreamerInfo::kUShort:  return 2;
+      case TVirtualStreamerInfo::kInt:
+      case TVirtualStreamerInfo::kUInt:
+      case TVirtualStreamerInfo::kFloat:   return 4;
+      case TVirtualStreamerInfo::kLong64:
+      case TVirtualStreamerInfo::kULong64:
+      case TVirtualStreamerInfo::kDouble:  return 8;
+      default:                             return 0;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read, column-wise, the values of this data member for all the elements of
+/// the collection of the given entry.
+///
+/// The values are stored contiguously, in the machine representation, at the
+/// beginning of user_buf (expanded if needed, buffer offset set to 0): they
+/// are byte swapped straight from the basket. Neither the collection nor its
+/// objects are read or created, and the branch address is not updated.
+///
+/// Only branches for which GetColumnValueSize() is non-zero are supported.
+/// Return the number of values, i.e. the size of the collection in this entry,
+/// or -1 if entry is out of range or in case of error.
+
+Int_t TBranchElement::GetEntryColumn(Long64_t entry, TBuffer &user_buf)
+{
+   const Int_t valueSize = GetColumnValueSize();
+   if (!valueSize) {
+      Error("GetEntryColumn", "Branch %s cannot be read column-wise: only the data members of basic type of split collections are supported.", GetName());
+      return -1;
+   }
+   if ((entry < fFirstEntry) || (entry >= fEntryNumber)) {
+      return -1;
+   }
+   TBasket *basket = LoadBasketOfEntry(entry);
+   if (!basket) {
+      return -1;
+   }
+   Int_t *entryOffset = basket->GetEntryOffset();
+   if (R__unlikely(!entryOffset)) {
+      Error("GetEntryColumn", "Basket %d of branch %s has no entry offsets.", fReadBasket, GetName());
+      return -1;
+   }
+   const Int_t ientry = entry - fFirstBasketEntry;
+   const Int_t begin = entryOffset[ientry];
+   const Int_t end = (entry + 1 < fNextBasketEntry) ? entryOffset[ientry + 1] : basket->GetLast();
+   const Int_t nbytes = end - begin;
+   if (R__unlikely(nbytes < 0 || nbytes % valueSize)) {
+      Error("GetEntryColumn", "Entry %lld of branch %s does not contain values of %d bytes.", entry, GetName(), valueSize);
+      return -1;
+   }
+   if (user_buf.BufferSize() < nbytes) {
+      user_buf.Expand(nbytes, kFALSE);
+   }
+   ROOT::Internal::FromBigEndianArray(user_buf.Buffer(), basket->GetBufferRef()->Buffer() + begin, nbytes / valueSize, valueSize);
+   user_buf.SetBufferOffset(0);
+   return nbytes / valueSize;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill expectedClass and expectedType with information on the data type of the
 /// object/values contained in this branch (and thus the type of pointers
@@ -3289,6 +3380,7 @@ Bool_t TBranchElement::IsFolder() const
 
 Bool_t TBranchElement::IsMissingCollection() const
 {
+   LoadBasketArrays();
    Bool_t ismissing = kFALSE;
    TBasket* basket = (TBasket*) fBaskets.UncheckedAt(fReadBasket);
    if (basket && fTree) {
@@ -5052,7 +5144,7 @@ void TBranchElement::SetReadActionSequence()
       if( fSplitLevel >= TTree::kSplitCollectionOfPointers && fBranchCount->fSTLtype == ROOT::kSTLvector) {
          original = fInfo->GetReadMemberWiseActions(kTRUE);
       } else {
-         TVirtualStreamerInfo *info = GetInfoImp();
+         TStreamerInfo *info = GetInfoImp();
          if (GetParentClass() == info->GetClass()) {
             if( fTargetClass.GetClassName()[0] && fBranchClass != fTargetClass ) {
                original = GetCollectionProxy()->GetConversionReadMemberWiseActions(fBranchClass.GetClass(), fClassVersion);
@@ -5060,10 +5152,14 @@ void TBranchElement::SetReadActionSequence()
                original = GetCollectionProxy()->GetReadMemberWiseActions(fClassVersion);
             }
          } else if (GetCollectionProxy()) {
-            // Base class and embedded objects.
+            // Base class and embedded objects, shared by the branches of all the trees
+            // when possible.
 
-            transient = TStreamerInfoActions::TActionSequence::CreateReadMemberWiseActions(info,*GetCollectionProxy());
-            original = transient;
+            original = info->GetReadMemberWiseActions(*GetCollectionProxy());
+            if (!original) {
+               transient = TStreamerInfoActions::TActionSequence::CreateReadMemberWiseActions(info,*GetCollectionProxy());
+               original = transient;
+            }
          }
       }
    } else if (fType == 31) {
@@ -18,11 +18,18 @@
 #include "ROOT/TTaskGroup.hxx"
 #endif
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+
 /// A helper class for managing IMT work during TTree:Fill operations.
 ///
 namespace ROOT {
 namespace Internal {
 
+class TBasketAsyncWriteQueue;
+
 class TBranchIMTHelper {
 
 #ifdef R__USE_IMT
@@ -30,6 +37,9 @@ using TaskGroup_t = ROOT::Experimental::TTaskGroup;
 #endif
 
 public:
+   TBranchIMTHelper() = default;
+   TBranchIMTHelper(TBasketAsyncWriteQueue *asyncQueue) : fAsyncQueue(asyncQueue) {}
+
    template<typename FN> void Run(const FN &lambda) {
 #ifdef R__USE_IMT
       if (!fGroup) { fGroup.reset(new TaskGroup_t()); }
@@ -55,7 +65,11 @@ public:
    Long64_t GetNbytes() { return fBytes; }
    Long64_t GetNerrors() {  return fNerrors; }
 
+   /// Queue to which full baskets are handed over when the tree flushes asynchronously (or nullptr).
+   TBasketAsyncWriteQueue *GetAsyncQueue() const { return fAsyncQueue; }
+
 private:
+   TBasketAsyncWriteQueue *fAsyncQueue{nullptr}; // Not owned.
    std::atomic<Long64_t> fBytes{0};   // Total number of bytes written by this helper.
    std::atomic<Int_t>    fNerrors{0}; // Total error count of all tasks done by this helper.
 #ifdef R__USE_IMT
@@ -63,6 +77,88 @@ private:
 #endif
 };
 
+/// A bounded queue of full baskets being compressed and written by IMT tasks
+/// while TTree::Fill keeps going on fresh baskets.
+///
+/// Only the compression and the write of the basket happen in the task; the
+/// bookkeeping of the owning branch (basket seek and size bookkeeping, byte
+/// counters) is deferred to Retire(), which is always called by the thread
+/// filling the tree.  When more than fMaxPending baskets are in flight, Push()
+/// blocks until all of them are written.
+///
+class TBasketAsyncWriteQueue {
+
+#ifdef R__USE_IMT
+using TaskGroup_t = ROOT::Experimental::TTaskGroup;
+#endif
+
+   struct TPendingBasket {
+      std::function<Int_t()>     fWrite;   // Compress and write the basket; run in a task.
+      std::function<void(Int_t)> fCommit;  // Update the branch bookkeeping; run by the filling thread.
+      Int_t                      fNout{0}; // Result of fWrite.
+      std::atomic<bool>          fDone{false};
+   };
+
+public:
+   TBasketAsyncWriteQueue(Int_t maxPending) : fMaxPending(maxPending > 0 ? maxPending : 1) {}
+   ~TBasketAsyncWriteQueue() { Long64_t nbytes = 0; Retire(kTRUE, nbytes); }
+
+   template<typename WRITE, typename COMMIT> void Push(const WRITE &write, const COMMIT &commit, Long64_t &nbytes, Int_t &nerrors) {
+      if (fPending.size() >= (size_t)fMaxPending) {
+         nerrors += Retire(kTRUE, nbytes);
+      }
+      fPending.emplace_back(new TPendingBasket);
+      TPendingBasket *pending = fPending.back().get();
+      pending->fWrite = write;
+      pending->fCommit = commit;
+#ifdef R__USE_IMT
+      if (!fGroup) { fGroup.reset(new TaskGroup_t()); }
+      fGroup->Run( [pending]() {
+         pending->fNout = pending->fWrite();
+         pending->fDone = true;
+      });
+#else
+      pending->fNout = pending->fWrite();
+      pending->fDone = true;
+#endif
+   }
+
+   /// Commit the baskets whose write has completed, in submission order.
+   /// If `wait` is true, first wait for all the baskets in flight.
+   /// Adds the number of bytes written to `nbytes` and returns the number
+   /// of baskets that failed to be written.
+   Int_t Retire(Bool_t wait, Long64_t &nbytes) {
+#ifdef R__USE_IMT
+      if (wait && fGroup) fGroup->Wait();
+#else
+      (void)wait;
+#endif
+      Int_t nerrors = 0;
+      while (!fPending.empty() && fPending.front()->fDone) {
+         TPendingBasket &pending = *fPending.front();
+         pending.fCommit(pending.fNout);
+         if (pending.fNout < 0) {
+            ++nerrors;
+         } else {
+            nbytes += pending.fNout;
+         }
+         fPending.pop_front();
+      }
+      return nerrors;
+   }
+
+   Int_t  GetMaxPending() const { return fMaxPending; }
+   size_t GetNpending() const { return fPending.size(); }
+   void   SetMaxPending(Int_t maxPending) { fMaxPending = maxPending > 0 ? maxPending : 1; }
+
+private:
+   Int_t fMaxPending; // Maximum number of baskets in flight before Push() blocks.
+   std::deque<std::unique_ptr<TPendingBasket>> fPending;
+#ifdef R__USE_IMT
+   std::unique_ptr<TaskGroup_t> fGroup;
+#endif
+};
+
 } // Internal
 } // ROOT
 
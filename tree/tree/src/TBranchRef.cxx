@@ -20,6 +20,11 @@ TBranch has read the TBranchRef's current entry it will not be told
 to re-read, in case the use has changed objects read from the
 branch.
 
+With SetReadAllParents(), the first reference resolved in an entry
+reads all the branches holding objects referenced by this entry at
+once, instead of one branch per resolved reference; the following
+references of the entry are then resolved without reading any branch.
+
 ### LIMITATION :
 Note that this does NOT allow for autoloading of references spanning
 different entries. The TBranchRef's current entry has to correspond
@@ -43,7 +48,7 @@ ClassImp(TBranchRef);
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor.
 
-TBranchRef::TBranchRef(): TBranch(), fRequestedEntry(-1), fRefTable(0)
+TBranchRef::TBranchRef(): TBranch(), fRequestedEntry(-1), fResolvedEntry(-1), fReadAllParents(kFALSE), fRefTable(0)
 {
    fReadLeaves = (ReadLeaves_t)&TBranchRef::ReadLeavesImpl;
    fFillLeaves = (FillLeaves_t)&TBranchRef::FillLeavesImpl;
@@ -53,7 +58,7 @@ TBranchRef::TBranchRef(): TBranch(), fRequestedEntry(-1), fRefTable(0)
 /// Main constructor called by TTree::BranchRef.
 
 TBranchRef::TBranchRef(TTree *tree)
-    : TBranch(), fRequestedEntry(-1), fRefTable(0)
+    : TBranch(), fRequestedEntry(-1), fResolvedEntry(-1), fReadAllParents(kFALSE), fRefTable(0)
 {
    if (!tree) return;
    SetName("TRefTable");
@@ -121,6 +126,16 @@ Bool_t TBranchRef::Notify()
       // Load the RefTable if we need to.
       GetEntry(fRequestedEntry);
    }
+   if (fReadAllParents && fResolvedEntry != fRequestedEntry) {
+      fResolvedEntry = fRequestedEntry;
+      TObjArray *parents = fRefTable->GetParents();
+      for (Int_t pnumber : fRefTable->GetEntryParents()) {
+         TBranch *parent = (TBranch*)parents->UncheckedAt(pnumber);
+         // don't re-read, the user might have changed some object
+         if (parent && parent->GetReadEntry() != fRequestedEntry)
+            parent->GetEntry(fRequestedEntry);
+      }
+   }
    TBranch *branch = (TBranch*)fRefTable->GetParent(uid, context);
    if (branch) {
       // don't re-read, the user might have changed some object
@@ -189,6 +204,7 @@ void TBranchRef::Reset(Option_t *option)
    TBranch::Reset(option);
    if (!fRefTable) fRefTable = new TRefTable(this,100);
    fRefTable->Reset();
+   fResolvedEntry = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -200,6 +216,7 @@ void TBranchRef::ResetAfterMerge(TFileMergeInfo *info)
    TBranch::ResetAfterMerge(info);
    if (!fRefTable) fRefTable = new TRefTable(this,100);
    fRefTable->Reset();
+   fResolvedEntry = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,8 @@ the trees in the chain.
 #include "TMath.h"
 #include "TFile.h"
 #include "TFileInfo.h"
+#include "TFileCollection.h"
+#include "TFileInfo.h"
 #include "TFriendElement.h"
 #include "TLeaf.h"
 #include "TList.h"
@@ -55,6 +57,11 @@ the trees in the chain.
 #include "TFilePrefetch.h"
 #include "TVirtualMutex.h"
 
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
 ClassImp(TChain);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -72,6 +79,9 @@ TChain::TChain()
 , fFiles(0)
 , fStatus(0)
 , fProofChain(0)
+, fOpenFiles(0)
+, fParallelOpen(0)
+, fKeepFilesOpen(kFALSE)
 {
    fTreeOffset = new Long64_t[fTreeOffsetLen];
    fFiles = new TObjArray(fTreeOffsetLen);
@@ -146,6 +156,9 @@ TChain::TChain(const char* name, const char* title)
 , fFiles(0)
 , fStatus(0)
 , fProofChain(0)
+, fOpenFiles(0)
+, fParallelOpen(0)
+, fKeepFilesOpen(kFALSE)
 {
    //
    //*-*
@@ -202,6 +215,9 @@ TChain::~TChain()
    fTree = 0;
    delete[] fTreeOffset;
    fTreeOffset = 0;
+   if (fOpenFiles) fOpenFiles->Delete();
+   delete fOpenFiles;
+   fOpenFiles = 0;
 
    // Remove from the global lists
    if (rootAlive) {
@@ -537,6 +553,12 @@ Int_t TChain::AddFile(const char* name, Long64_t nentries /* = TTree::kMaxEntrie
 /// Add all files referenced in the list to the chain. The object type in the
 /// list must be either TFileInfo or TObjString or TUrl .
 /// The function return 1 if successful, 0 otherwise.
+///
+/// If a TFileInfo carries meta data for the tree of the chain (as the
+/// manifests made by TChain::MakeManifest do), its number of entries and
+/// cluster boundaries are used and the file is not opened. For local files
+/// the meta data are only trusted if the size and modification time of the
+/// file, when recorded in the TFileInfo, did not change.
 
 Int_t TChain::AddFileInfoList(TCollection* filelist, Long64_t nfiles /* = TTree::kMaxEntries */)
 {
@@ -550,6 +572,7 @@ Int_t TChain::AddFileInfoList(TCollection* filelist, Long64_t nfiles /* = TTree:
       // Get the url
       TString cn = o->ClassName();
       const char *url = 0;
+      TFileInfoMeta *meta = 0;
       if (cn == "TFileInfo") {
          TFileInfo *fi = (TFileInfo *)o;
          url = (fi->GetCurrentUrl()) ? fi->GetCurrentUrl()->GetUrl() : 0;
@@ -557,6 +580,17 @@ Int_t TChain::AddFileInfoList(TCollection* filelist, Long64_t nfiles /* = TTree:
             Warning("AddFileInfoList", "found TFileInfo with empty Url - ignoring");
             continue;
          }
+         meta = fi->GetMetaData(TString::Format("/%s", GetName()));
+         if (meta && (!meta->IsTree() || meta->GetEntries() <= 0))
+            meta = 0;
+         TUrl u(url, kTRUE);
+         FileStat_t st;
+         if (meta && !strcmp(u.GetProtocol(), "file") && !gSystem->GetPathInfo(u.GetFile(), st) &&
+             ((fi->GetSize() >= 0 && fi->GetSize() != st.fSize) ||
+              (fi->GetModTime() > 0 && fi->GetModTime() != st.fMtime))) {
+            Info("AddFileInfoList", "file %s changed since its meta data were recorded - ignoring them", url);
+            meta = 0;
+         }
       } else if (cn == "TUrl") {
          url = ((TUrl*)o)->GetUrl();
       } else if (cn == "TObjString") {
@@ -569,7 +603,14 @@ Int_t TChain::AddFileInfoList(TCollection* filelist, Long64_t nfiles /* = TTree:
       }
       // Good entry
       cnt++;
-      AddFile(url);
+      if (meta) {
+         Int_t ntrees = fNtrees;
+         AddFile(url, meta->GetEntries());
+         if (fNtrees > ntrees)
+            ((TChainElement*) fFiles->UncheckedAt(fNtrees - 1))->SetClusterStarts(meta->GetClusterStarts());
+      } else {
+         AddFile(url);
+      }
       if (cnt >= nfiles)
          break;
    }
@@ -930,6 +971,9 @@ Long64_t TChain::GetEntries() const
                                " run TChain::SetProof(kTRUE, kTRUE) first");
       return fProofChain->GetEntries();
    }
+   if (fEntries == TTree::kMaxEntries && fParallelOpen > 1) {
+      const_cast<TChain*>(this)->PrefetchEntries(fParallelOpen, fKeepFilesOpen);
+   }
    if (fEntries == TTree::kMaxEntries) {
       const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
    }
@@ -1307,12 +1351,11 @@ Long64_t TChain::LoadTree(Long64_t entry)
          //
          // An alternative would move this code to each of
          // the functions calling LoadTree (and to overload a few more).
-         TIter next(fFriends);
          TFriendLock lock(this, kLoadTree);
-         TFriendElement* fe = 0;
          TFriendElement* fetree = 0;
          Bool_t needUpdate = kFALSE;
-         while ((fe = (TFriendElement*) next())) {
+         for (TObject *element : ROOT::Detail::TListRange(fFriends)) {
+            TFriendElement* fe = (TFriendElement*) element;
             TObjLink* lnk = 0;
             if (fTree->GetListOfFriends()) {
                lnk = fTree->GetListOfFriends()->FirstLink();
@@ -1331,7 +1374,7 @@ Long64_t TChain::LoadTree(Long64_t entry)
                Int_t oldNumber = ((TChain*) at)->GetTreeNumber();
                TTree* old = at->GetTree();
                TTree* oldintree = fetree ? fetree->GetTree() : 0;
-               at->LoadTreeFriend(entry, this);
+               fe->IsAligned() ? at->LoadTree(entry) : at->LoadTreeFriend(entry, this);
                Int_t newNumber = ((TChain*) at)->GetTreeNumber();
                if ((oldNumber != newNumber) || (old != at->GetTree()) || (oldintree && (oldintree != at->GetTree()))) {
                   // We can not compare just the tree pointers because
@@ -1346,7 +1389,7 @@ Long64_t TChain::LoadTree(Long64_t entry)
                // direct friend of the chain, it should be scanned
                // used the chain entry number and NOT the tree entry
                // number (treeReadEntry) hence we redo:
-               at->LoadTreeFriend(entry, this);
+               fe->IsAligned() ? at->LoadTree(entry) : at->LoadTreeFriend(entry, this);
             }
          }
          if (needUpdate) {
@@ -1461,7 +1504,11 @@ Long64_t TChain::LoadTree(Long64_t entry)
 
    // FIXME: We leak memory here, we've just lost the open file
    //        if we did not delete it above.
-   {
+   if (fOpenFiles && treenum < fOpenFiles->GetSize() && fOpenFiles->UncheckedAt(treenum)) {
+      // reuse the file opened by PrefetchEntries
+      fFile = (TFile*) fOpenFiles->RemoveAt(treenum);
+      fFile->SetBit(kMustCleanup);
+   } else {
       TDirectory::TContext ctxt;
       fFile = TFile::Open(element->GetTitle());
       if (fFile) fFile->SetBit(kMustCleanup);
@@ -1594,10 +1641,9 @@ Long64_t TChain::LoadTree(Long64_t entry)
    if (fFriends) {
       // An alternative would move this code to each of the function
       // calling LoadTree (and to overload a few more).
-      TIter next(fFriends);
       TFriendLock lock(this, kLoadTree);
-      TFriendElement* fe = 0;
-      while ((fe = (TFriendElement*) next())) {
+      for (TObject *obj : ROOT::Detail::TListRange(fFriends)) {
+         TFriendElement* fe = (TFriendElement*) obj;
          TTree* t = fe->GetTree();
          if (!t) continue;
          if (t->GetTreeIndex()) {
@@ -1606,7 +1652,7 @@ Long64_t TChain::LoadTree(Long64_t entry)
          if (t->GetTree() && t->GetTree()->GetTreeIndex()) {
             t->GetTree()->GetTreeIndex()->UpdateFormulaLeaves(GetTree());
          }
-         t->LoadTreeFriend(entry, this);
+         fe->IsAligned() ? t->LoadTree(entry) : t->LoadTreeFriend(entry, this);
          TTree* friend_t = t->GetTree();
          if (friend_t) {
             fTree->AddFriend(friend_t, fe->GetName())->SetBit(TFriendElement::kFromChain);
@@ -1674,6 +1720,10 @@ Long64_t TChain::LoadTree(Long64_t entry)
 /// Check / locate the files in the chain.
 /// By default only the files not yet looked up are checked.
 /// Use force = kTRUE to check / re-check every file.
+///
+/// The consecutive files served by the same stager are located together,
+/// with one TFileStager::LocateCollection call: stagers like the one of
+/// XRootD send the requests of such a batch in parallel.
 
 void TChain::Lookup(Bool_t force)
 {
@@ -1683,23 +1733,70 @@ void TChain::Lookup(Bool_t force)
    printf("\n");
    printf("TChain::Lookup - Looking up %d files .... \n", nelements);
    Int_t nlook = 0;
+   Int_t n1 = (nelements > 100) ? (Int_t) nelements / 100 : 1;
    TFileStager *stg = 0;
+   std::vector<TChainElement *> batch;
+
+   // Locate the files of the current batch and update their elements
+   auto locateBatch = [&]() {
+      if (batch.empty())
+         return;
+      TFileCollection fc;
+      std::vector<TFileInfo *> infos;
+      for (auto elem : batch) {
+         // Locate the url without options and anchor
+         TUrl elemurl(elem->GetTitle(), kTRUE);
+         elemurl.SetOptions("");
+         elemurl.SetAnchor("");
+         infos.push_back(new TFileInfo(elemurl.GetUrl()));
+         // Not TFileCollection::Add, which skips the duplicates
+         fc.GetList()->Add(infos.back());
+      }
+      stg->LocateCollection(&fc);
+      for (size_t i = 0; i < batch.size(); ++i) {
+         TChainElement *elem = batch[i];
+         nlook++;
+         TUrl elemurl(elem->GetTitle(), kTRUE);
+         // Save current options and anchor
+         TString anchor = elemurl.GetAnchor();
+         TString options = elemurl.GetOptions();
+         if (infos[i]->TestBit(TFileInfo::kStaged)) {
+            if (!(nlook % n1)) {
+               printf("Lookup | %3d %% finished\r", 100 * nlook / nelements);
+               fflush(stdout);
+            }
+            // Get the effective end-point Url
+            elemurl.SetUrl(infos[i]->GetFirstUrl()->GetUrl());
+            // Restore original options and anchor, if any
+            elemurl.SetOptions(options);
+            elemurl.SetAnchor(anchor);
+            // Save it into the element
+            elem->SetTitle(elemurl.GetUrl());
+            // Remember
+            elem->SetLookedUp();
+         } else {
+            // Failure: remove
+            fFiles->Remove(elem);
+            TString eurl(infos[i]->GetFirstUrl()->GetUrl());
+            if (gSystem->AccessPathName(eurl))
+               Error("Lookup", "file %s does not exist\n", eurl.Data());
+            else
+               Error("Lookup", "file %s cannot be read\n", eurl.Data());
+         }
+      }
+      batch.clear();
+   };
+
    while ((element = (TChainElement*) next())) {
       // Do not do it more than needed
       if (element->HasBeenLookedUp() && !force) continue;
-      // Count
-      nlook++;
-      // Get the Url
+      // Get the Url, without options and anchor
       TUrl elemurl(element->GetTitle(), kTRUE);
-      // Save current options and anchor
-      TString anchor = elemurl.GetAnchor();
-      TString options = elemurl.GetOptions();
-      // Reset options and anchor
       elemurl.SetOptions("");
       elemurl.SetAnchor("");
-      // Locate the file
       TString eurl(elemurl.GetUrl());
       if (!stg || !stg->Matches(eurl)) {
+         locateBatch();
          SafeDelete(stg);
          {
             TDirectory::TContext ctxt;
@@ -1710,30 +1807,10 @@ void TChain::Lookup(Bool_t force)
             break;
          }
       }
-      Int_t n1 = (nelements > 100) ? (Int_t) nelements / 100 : 1;
-      if (stg->Locate(eurl.Data(), eurl) == 0) {
-         if (nlook > 0 && !(nlook % n1)) {
-            printf("Lookup | %3d %% finished\r", 100 * nlook / nelements);
-            fflush(stdout);
-         }
-         // Get the effective end-point Url
-         elemurl.SetUrl(eurl);
-         // Restore original options and anchor, if any
-         elemurl.SetOptions(options);
-         elemurl.SetAnchor(anchor);
-         // Save it into the element
-         element->SetTitle(elemurl.GetUrl());
-         // Remember
-         element->SetLookedUp();
-      } else {
-         // Failure: remove
-         fFiles->Remove(element);
-         if (gSystem->AccessPathName(eurl))
-            Error("Lookup", "file %s does not exist\n", eurl.Data());
-         else
-            Error("Lookup", "file %s cannot be read\n", eurl.Data());
-      }
+      batch.push_back(element);
    }
+   if (stg)
+      locateBatch();
    if (nelements > 0)
       printf("Lookup | %3d %% finished\n", 100 * nlook / nelements);
    else
@@ -2129,6 +2206,180 @@ void TChain::ParseTreeFilename(const char *name, TString &filename, TString &tre
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Make a manifest of the files of the chain: a TFileCollection with one
+/// TFileInfo per file, holding its size, modification time (for local files)
+/// and UUID, and a TFileInfoMeta with the number of entries of the tree, its
+/// sizes and, if clusters is true, the first entry of each of its clusters.
+/// Each file is opened once. The manifest can be saved next to the data
+/// and given to TChain::AddFileInfoList to build the chain again without
+/// opening the files:
+/// ~~~ {.cpp}
+///     TFileCollection *fc = chain.MakeManifest();
+///     fc->SaveAs("manifest.root");
+///     ...
+///     TChain other("T");
+///     other.AddFileInfoList(fc->GetList());
+/// ~~~
+/// The caller owns the returned collection. Returns 0 if a file or its tree
+/// cannot be read.
+
+TFileCollection *TChain::MakeManifest(Bool_t clusters) const
+{
+   TFileCollection *fc = new TFileCollection(GetName(), GetTitle());
+   TIter next(fFiles);
+   TChainElement *element;
+   while ((element = (TChainElement*) next())) {
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> file(TFile::Open(element->GetTitle()));
+      TTree *tree = nullptr;
+      if (file && !file->IsZombie())
+         file->GetObject(element->GetName(), tree);
+      if (!tree) {
+         Error("MakeManifest", "cannot read the tree %s from the file %s", element->GetName(), element->GetTitle());
+         delete fc;
+         return 0;
+      }
+      TFileInfo *fi = new TFileInfo(element->GetTitle(), file->GetSize(), file->GetUUID().AsString());
+      TUrl u(element->GetTitle(), kTRUE);
+      FileStat_t st;
+      if (!strcmp(u.GetProtocol(), "file") && !gSystem->GetPathInfo(u.GetFile(), st))
+         fi->SetModTime(st.fMtime);
+      TFileInfoMeta *meta = new TFileInfoMeta(GetName(), "TTree", tree->GetEntries(), 0, tree->GetEntries() - 1,
+                                              tree->GetTotBytes(), tree->GetZipBytes());
+      if (clusters) {
+         std::vector<Long64_t> starts;
+         auto clusterIter = tree->GetClusterIterator(0);
+         Long64_t start;
+         while ((start = clusterIter()) < tree->GetEntries())
+            starts.push_back(start);
+         meta->SetClusterStarts(starts);
+      }
+      fi->AddMetaData(meta);
+      fc->Add(fi);
+   }
+   fc->Update();
+   return fc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open in parallel the files of the chain whose number of entries is not
+/// known yet, read the header of their tree and set the number of entries
+/// of the corresponding TChainElement, the tree offsets and the total number
+/// of entries of the chain. At most nparallel files are opened at the same
+/// time. This avoids the serial latency of TChain::GetEntries or
+/// TChain::LoadTree on chains made of many (remote) files added with the
+/// default number of entries (TTree::kMaxEntries).
+///
+/// If keepopen is true, the files are not closed: they are reused by
+/// TChain::LoadTree when the corresponding tree is loaded, so that each file
+/// is opened only once. Otherwise they are closed as soon as the number of
+/// entries has been read.
+///
+/// Returns the total number of entries of the chain, or -1 if some of the
+/// files could not be opened (their number of entries stays unknown and an
+/// error is printed).
+///
+/// If more than one file is opened at a time, this method calls
+/// ROOT::EnableThreadSafety(), which stays in effect for the whole process.
+///
+/// See also TChain::SetParallelOpen, which makes TChain::GetEntries use this
+/// method automatically.
+
+Long64_t TChain::PrefetchEntries(Int_t nparallel, Bool_t keepopen)
+{
+   if (fProofChain && !(fProofChain->TestBit(kProofLite))) {
+      Warning("PrefetchEntries", "not supported for PROOF chains");
+      return -1;
+   }
+
+   std::vector<Int_t> todo;
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      TChainElement *element = (TChainElement*) fFiles->UncheckedAt(i);
+      if (element->GetEntries() == TTree::kMaxEntries
+          && !(fOpenFiles && i < fOpenFiles->GetSize() && fOpenFiles->UncheckedAt(i)))
+         todo.push_back(i);
+   }
+   if (!todo.empty()) {
+      const Int_t nfiles = todo.size();
+      std::vector<Long64_t> entries(nfiles, TTree::kMaxEntries);
+      std::vector<TFile*> files(nfiles, nullptr);
+      std::atomic<Int_t> next(0);
+
+      auto openFiles = [&]() {
+         TDirectory::TContext ctxt;
+         for (Int_t n = next++; n < nfiles; n = next++) {
+            TChainElement *element = (TChainElement*) fFiles->UncheckedAt(todo[n]);
+            TFile *file = TFile::Open(element->GetTitle());
+            if (!file || file->IsZombie()) {
+               delete file;
+               continue;
+            }
+            TTree *tree = dynamic_cast<TTree*>(file->Get(element->GetName()));
+            if (tree) {
+               entries[n] = tree->GetEntries();
+               delete tree;
+            }
+            if (keepopen && entries[n] != TTree::kMaxEntries) {
+               files[n] = file;
+            } else {
+               delete file;
+            }
+         }
+      };
+
+      const Int_t nthreads = std::max(1, std::min(nparallel, nfiles));
+      if (nthreads > 1) {
+         ROOT::EnableThreadSafety();
+         std::vector<std::thread> threads;
+         for (Int_t t = 0; t < nthreads; ++t)
+            threads.emplace_back(openFiles);
+         for (auto &thread : threads)
+            thread.join();
+      } else {
+         openFiles();
+      }
+
+      for (Int_t n = 0; n < nfiles; ++n) {
+         TChainElement *element = (TChainElement*) fFiles->UncheckedAt(todo[n]);
+         if (entries[n] == TTree::kMaxEntries) {
+            Error("PrefetchEntries", "cannot read the tree %s from the file %s", element->GetName(), element->GetTitle());
+            continue;
+         }
+         element->SetNumberEntries(entries[n]);
+         if (files[n]) {
+            if (!fOpenFiles) fOpenFiles = new TObjArray(fNtrees);
+            fOpenFiles->AddAtAndExpand(files[n], todo[n]);
+         }
+      }
+   }
+
+   // Recompute the offsets of the trees and the total number of entries.
+   Long64_t total = 0;
+   Bool_t complete = kTRUE;
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      fTreeOffset[i] = total;
+      TChainElement *element = (TChainElement*) fFiles->UncheckedAt(i);
+      if (element->GetEntries() == TTree::kMaxEntries) {
+         complete = kFALSE;
+         break;
+      }
+      total += element->GetEntries();
+   }
+   if (!complete) {
+      for (Int_t i = 0; i < fNtrees; ++i) {
+         if (((TChainElement*) fFiles->UncheckedAt(i))->GetEntries() == TTree::kMaxEntries) {
+            for (Int_t j = i + 1; j <= fNtrees; ++j) fTreeOffset[j] = TTree::kMaxEntries;
+            break;
+         }
+      }
+      return -1;
+   }
+   fTreeOffset[fNtrees] = total;
+   fEntries = total;
+   return fEntries;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print the header information of each tree in the chain.
 /// See TTree::Print for a list of options.
@@ -2210,6 +2461,9 @@ void TChain::RecursiveRemove(TObject *obj)
    if (fTree == obj) {
       fTree = 0;
    }
+   if (fOpenFiles) {
+      fOpenFiles->Remove(obj);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2242,6 +2496,7 @@ void TChain::Reset(Option_t*)
 {
    delete fFile;
    fFile = 0;
+   if (fOpenFiles) fOpenFiles->Delete();
    fNtrees         = 0;
    fTreeNumber     = -1;
    fTree           = 0;
@@ -2741,6 +2996,18 @@ void TChain::SetPacketSize(Int_t size)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Make TChain::GetEntries, when the number of entries of some files is not
+/// known yet, call TChain::PrefetchEntries(nparallel, keepopen) instead of
+/// opening the files one after the other. With nparallel > 1 this calls
+/// ROOT::EnableThreadSafety(), which stays in effect for the whole process.
+
+void TChain::SetParallelOpen(Int_t nparallel, Bool_t keepopen)
+{
+   fParallelOpen = nparallel;
+   fKeepFilesOpen = keepopen;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Enable/Disable PROOF processing on the current default Proof (gProof).
 ///
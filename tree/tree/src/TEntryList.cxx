@@ -55,6 +55,8 @@ End_Macro
 - __Subtract__() - if the lists are for the same TTree, removes the entries of the second
                list from the first list. If the lists are for TChains, loops over all
                sub-lists
+- __Intersect__() - keeps only the entries of the first list which are also in the
+               second one, matching the sub-lists as Subtract() does
 - __GetEntry(n)__ - returns the n-th entry number
 - __Next__()      - returns next entry number. Note, that this function is
                 much faster than GetEntry, and it's called when GetEntry() is called
@@ -1229,13 +1231,17 @@ void TEntryList::Subtract(const TEntryList *elist)
          //second list is also only for 1 tree
          if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
              !strcmp(elist->fFileName.Data(),fFileName.Data())){
-            //same tree
-            Long64_t n2 = elist->GetN();
-            Long64_t entry;
-            for (Int_t i=0; i<n2; i++){
-               entry = (const_cast<TEntryList*>(elist))->GetEntry(i);
-               Remove(entry);
+            //same tree, subtract block by block
+            if (!elist->fBlocks) return;
+            Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+            for (Int_t i=0; i<nmin; i++){
+               TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+               TEntryListBlock *block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+               Long64_t nold = block1->GetNPassed();
+               fN = fN - nold + block1->Subtract(block2);
             }
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
          } else {
             //different trees
             return;
@@ -1270,6 +1276,86 @@ void TEntryList::Subtract(const TEntryList *elist)
    return;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep only the entries which are also contained in elist.
+/// In case of lists for different trees, the result is empty; if the lists are
+/// for TChains, the sub-lists for the same trees are intersected and the other
+/// ones emptied. Subentries of TEntryListArray are not considered.
+
+void TEntryList::Intersect(const TEntryList *elist)
+{
+   if (!fLists){
+      if (!fBlocks) return;
+      const TEntryList *other = 0;
+      if (!elist->fLists){
+         if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
+             !strcmp(elist->fFileName.Data(),fFileName.Data()))
+            other = elist;
+      } else {
+         //second list has sublists, try to find one for the same tree as this list
+         TIter next1(elist->GetLists());
+         TEntryList *templist = 0;
+         while ((templist = (TEntryList*)next1())){
+            if (!strcmp(templist->fTreeName.Data(),fTreeName.Data()) &&
+                !strcmp(templist->fFileName.Data(),fFileName.Data())){
+               other = templist;
+               break;
+            }
+         }
+      }
+      //intersect block by block, the blocks missing in the other list are emptied
+      Int_t nother = (other && other->fBlocks) ? other->fNBlocks : 0;
+      fN = 0;
+      for (Int_t i=0; i<fNBlocks; i++){
+         TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+         if (i < nother) {
+            fN += block1->Intersect((TEntryListBlock*)other->fBlocks->UncheckedAt(i));
+         } else {
+            TEntryListBlock empty;
+            fN += block1->Intersect(&empty);
+         }
+      }
+      fLastIndexQueried = -1;
+      fLastIndexReturned = 0;
+   } else {
+      //this list has sublists
+      TIter next2(fLists);
+      TEntryList *templist = 0;
+      Long64_t oldn=0;
+      while ((templist = (TEntryList*)next2())){
+         oldn = templist->GetN();
+         templist->Intersect(elist);
+         fN = fN - oldn + templist->GetN();
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of entries of this list in the range [first, last).
+/// Only lists for a single TTree (without sub-lists) are supported; -1 is
+/// returned otherwise.
+/// Cheap enough to decide whether a whole cluster of entries can be skipped.
+
+Long64_t TEntryList::GetNInRange(Long64_t first, Long64_t last) const
+{
+   if (fLists) return -1;
+   if (!fBlocks || first >= last) return 0;
+   first = TMath::Max(first, (Long64_t)0);
+   Int_t ifirst = first/kBlockSize;
+   Int_t ilast = TMath::Min((last-1)/kBlockSize, (Long64_t)fNBlocks-1);
+   Long64_t n = 0;
+   for (Int_t i=ifirst; i<=ilast; i++){
+      TEntryListBlock *block = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+      Long64_t offset = (Long64_t)i*kBlockSize;
+      if (first <= offset && last >= offset + kBlockSize)
+         n += block->GetNPassed();
+      else
+         n += block->GetNPassed(TMath::Max(first - offset, (Long64_t)0),
+                                TMath::Min(last - offset, (Long64_t)kBlockSize));
+   }
+   return n;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TEntryList operator||(TEntryList &elist1, TEntryList &elist2)
@@ -38,6 +38,12 @@ End_Macro
  - __Merge__() - adds all entries from one block to the other. If the first block
              uses array representation, it's changed to bits representation only
              if the total number of passing entries is still less than kBlockSize
+ - __Subtract__() - removes all entries of the other block from this one
+ - __Intersect__() - keeps only the entries also contained in the other block
+
+Merge(), Subtract() and Intersect() combine the blocks a whole word of the bit
+representation at a time, converting list blocks to bits first when needed, and
+the result is stored in the most compact representation again.
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
@@ -46,8 +52,46 @@ End_Macro
 #include "TEntryListBlock.h"
 #include "TString.h"
 
+#include <algorithm>
+
 ClassImp(TEntryListBlock);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of bits set in a word of the bit representation
+
+inline Int_t CountBits(UInt_t word)
+{
+#if defined(__GNUC__)
+   return __builtin_popcount(word);
+#else
+   Int_t n = 0;
+   for (; word; ++n)
+      word &= word - 1;
+   return n;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Position of the lowest bit set in a non-zero word of the bit representation
+
+inline Int_t LowestBit(UInt_t word)
+{
+#if defined(__GNUC__)
+   return __builtin_ctz(word);
+#else
+   Int_t n = 0;
+   while (!(word & 1)) {
+      word >>= 1;
+      ++n;
+   }
+   return n;
+#endif
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default c-tor
 
@@ -242,123 +286,89 @@ Int_t TEntryListBlock::Contains(Int_t entry)
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
+   Int_t i;
    if (block->GetNPassed() == 0) return GetNPassed();
    if (GetNPassed() == 0){
       //this block is empty
-      fN = block->fN;
-      fIndices = new UShort_t[fN];
-      for (i=0; i<fN; i++)
-         fIndices[i] = block->fIndices[i];
-      fNPassed = block->fNPassed;
-      fType = block->fType;
-      fPassing = block->fPassing;
-      fCurrent = block->fCurrent;
-      fLastIndexReturned = -1;
-      fLastIndexQueried = -1;
-      return fNPassed;
+      *this = *block;
+      return GetNPassed();
    }
-   if (fType==0){
-      //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
-         }
-      } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
+   if (fType==1 && block->fType==1 && fPassing && block->fPassing &&
+       GetNPassed() + block->GetNPassed() <= kBlockSize){
+      //both blocks are short lists of passing entries, make a bigger list
+      Int_t en = block->fNPassed;
+      Int_t newsize = fNPassed + en;
+      UShort_t *newlist = new UShort_t[newsize];
+      UShort_t *elst = block->fIndices;
+      Int_t newpos, elpos;
+      newpos = elpos = 0;
+      for (i=0; i<fNPassed; i++) {
+         while (elpos < en && fIndices[i] > elst[elpos]) {
+            newlist[newpos] = elst[elpos];
+            newpos++;
+            elpos++;
          }
+         if (elpos < en && fIndices[i] == elst[elpos]) elpos++;
+         newlist[newpos] = fIndices[i];
+         newpos++;
       }
-   } else {
-      //stored as a list
-      if (GetNPassed() + block->GetNPassed() > kBlockSize){
-         //change to bits
-         UShort_t *bits = new UShort_t[kBlockSize];
-         Transform(1, bits);
-         Merge(block);
-      } else {
-         //this is only possible if fPassing=1 in both blocks
-         if (block->fType==1){
-            //second block stored as a list
-            //make a bigger list
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            UShort_t *elst = block->fIndices;
-            Int_t newpos, elpos;
-            newpos = elpos = 0;
-            for (i=0; i<fNPassed; i++) {
-               while (elpos < en && fIndices[i] > elst[elpos]) {
-                  newlist[newpos] = elst[elpos];
-                  newpos++;
-                  elpos++;
-               }
-               if (fIndices[i] == elst[elpos]) elpos++;
-               newlist[newpos] = fIndices[i];
-               newpos++;
-            }
-            while (elpos < en) {
-               newlist[newpos] = elst[elpos];
-               newpos++;
-               elpos++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         } else {
-            //second block is stored as bits
-
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            Int_t newpos, current;
-            newpos = current = 0;
-            for (i=0; i<kBlockSize*16; i++){
-               if (!block->Contains(i)) continue;
-               while(current < fNPassed && fIndices[current]<i){
-                  newlist[newpos] = fIndices[current];
-                  current++;
-                  newpos++;
-               }
-               if (fIndices[current]==i) current++;
-               newlist[newpos] = i;
-               newpos++;
-            }
-            while(current<fNPassed){
-               newlist[newpos] = fIndices[current];
-               newpos++;
-               current++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         }
+      while (elpos < en) {
+         newlist[newpos] = elst[elpos];
+         newpos++;
+         elpos++;
       }
+      delete [] fIndices;
+      fIndices = newlist;
+      fNPassed = newpos;
+      fN = fNPassed;
+      fLastIndexQueried = -1;
+      fLastIndexReturned = -1;
+      return GetNPassed();
    }
-   fLastIndexQueried = -1;
-   fLastIndexReturned = -1;
+   //combine the bit representations word by word
+   UShort_t *bits = new UShort_t[kBlockSize];
+   UShort_t other[kBlockSize];
+   FillBits(bits);
+   block->FillBits(other);
+   for (i=0; i<kBlockSize; i++)
+      bits[i] |= other[i];
+   AdoptBits(bits);
+   OptimizeStorage();
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove from this block all the entries contained in the other block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(TEntryListBlock *block)
+{
+   if (GetNPassed() == 0 || block->GetNPassed() == 0) return GetNPassed();
+   UShort_t *bits = new UShort_t[kBlockSize];
+   UShort_t other[kBlockSize];
+   FillBits(bits);
+   block->FillBits(other);
+   for (Int_t i=0; i<kBlockSize; i++)
+      bits[i] &= ~other[i];
+   AdoptBits(bits);
+   OptimizeStorage();
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep in this block only the entries also contained in the other block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Intersect(TEntryListBlock *block)
+{
+   if (GetNPassed() == 0) return 0;
+   UShort_t *bits = new UShort_t[kBlockSize];
+   UShort_t other[kBlockSize];
+   FillBits(bits);
+   block->FillBits(other);
+   for (Int_t i=0; i<kBlockSize; i++)
+      bits[i] &= other[i];
+   AdoptBits(bits);
    OptimizeStorage();
    return GetNPassed();
 }
@@ -375,6 +385,35 @@ Int_t TEntryListBlock::GetNPassed()
       return kBlockSize*16-fNPassed;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the number of entries passing the selection in [first, last)
+
+Int_t TEntryListBlock::GetNPassed(Int_t first, Int_t last) const
+{
+   first = std::max(first, 0);
+   last = std::min(last, (Int_t)kBlockSize*16);
+   if (first >= last) return 0;
+   if (!fIndices)
+      return fPassing ? 0 : last - first;
+   if (fType==0){
+      //bits: count the partial words at the edges, the full words in between
+      Int_t n = 0;
+      Int_t ifirst = first>>4;
+      Int_t ilast = (last-1)>>4;
+      for (Int_t i=ifirst; i<=ilast; i++){
+         UInt_t word = fIndices[i];
+         if (i == ifirst) word &= 0xFFFF << (first & 15);
+         if (i == ilast) word &= 0xFFFF >> (15 - ((last-1) & 15));
+         n += CountBits(word);
+      }
+      return n;
+   }
+   //list: the indices are sorted
+   Int_t n = std::lower_bound(fIndices, fIndices+fNPassed, last) -
+             std::lower_bound(fIndices, fIndices+fNPassed, first);
+   return fPassing ? n : last - first - n;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return entry \#entry.
 /// See also Next()
@@ -387,14 +426,17 @@ Int_t TEntryListBlock::GetEntry(Int_t entry)
    else {
       Int_t i=0; Int_t j=0; Int_t entries_found=0;
       if (fType==0){
-         if ((fIndices[i] & (1<<j))!=0)
-            entries_found++;
-         while (entries_found<entry+1){
-            if (j==15){i++; j=0;}
-            else j++;
-            if ((fIndices[i] & (1<<j))!=0)
-               entries_found++;
+         //skip whole words until the one holding the entry
+         Int_t nbits = CountBits(fIndices[i]);
+         while (entries_found+nbits<entry+1){
+            entries_found += nbits;
+            i++;
+            nbits = CountBits(fIndices[i]);
          }
+         UInt_t word = fIndices[i];
+         for (; entries_found<entry; entries_found++)
+            word &= word - 1;
+         j = LowestBit(word);
          fLastIndexQueried = entry;
          fLastIndexReturned = i*16+j;
          return fLastIndexReturned;
@@ -453,19 +495,13 @@ Int_t TEntryListBlock::Next()
    }
 
    if (fType==0) {
-      //bits
-      Int_t i=0;
-      Int_t j=0;
+      //bits: skip the empty words
       fLastIndexReturned++;
-      i = fLastIndexReturned>>4;
-      j = fLastIndexReturned & 15;
-      Bool_t result=(fIndices[i] & (1<<j))!=0;
-      while (result==0){
-         if (j==15) {j=0; i++;}
-         else j++;
-         result = (fIndices[i] & (1<<j))!=0;
-      }
-      fLastIndexReturned = i*16+j;
+      Int_t i = fLastIndexReturned>>4;
+      UInt_t word = fIndices[i] & (0xFFFF << (fLastIndexReturned & 15));
+      while (word==0)
+         word = fIndices[++i];
+      fLastIndexReturned = i*16+LowestBit(word);
       fLastIndexQueried++;
       return fLastIndexReturned;
 
@@ -567,21 +603,15 @@ void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
    Int_t ilist = 0;
    Int_t ibite, ibit;
    if (!dir) {
-         for (i=0; i<kBlockSize*16; i++){
-            ibite = i >> 4;
-            ibit = i & 15;
-            Bool_t result = (fIndices[ibite] & (1<<ibit))!=0;
-            if (result && fPassing){
-               //fill with the entries that pass
-               indexnew[ilist] = i;
-               ilist++;
-            }
-            else if (!result && !fPassing){
-               //fill with the entries that don't pass
-               indexnew[ilist] = i;
-               ilist++;
-            }
+      //fill with the entries that pass, or with the ones that don't pass
+      for (ibite=0; ibite<kBlockSize; ibite++){
+         UInt_t word = fPassing ? fIndices[ibite] : (~fIndices[ibite] & 0xFFFF);
+         while (word){
+            indexnew[ilist] = ibite*16 + LowestBit(word);
+            ilist++;
+            word &= word - 1;
          }
+      }
       if (fIndices)
          delete [] fIndices;
       fIndices = indexnew;
@@ -618,3 +648,41 @@ void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
    fPassing = 1;
    return;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the kBlockSize words of bits with the bit representation of this block,
+/// whatever the current representation
+
+void TEntryListBlock::FillBits(UShort_t *bits) const
+{
+   if (fType==0 && fIndices){
+      std::copy(fIndices, fIndices+kBlockSize, bits);
+      return;
+   }
+   //a list stores either the entries that pass or the ones that don't
+   std::fill(bits, bits+kBlockSize, fPassing ? 0 : 0xFFFF);
+   if (!fIndices) return;
+   for (Int_t i=0; i<fNPassed; i++)
+      bits[fIndices[i]>>4] ^= 1<<(fIndices[i] & 15);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the content of this block with the kBlockSize words of bits, which
+/// the block takes ownership of. Returns the resulting number of entries
+
+Int_t TEntryListBlock::AdoptBits(UShort_t *bits)
+{
+   if (fIndices)
+      delete [] fIndices;
+   fIndices = bits;
+   fType = 0;
+   fN = kBlockSize;
+   fPassing = 1;
+   fNPassed = 0;
+   for (Int_t i=0; i<kBlockSize; i++)
+      fNPassed += CountBits(bits[i]);
+   fCurrent = 0;
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   return fNPassed;
+}
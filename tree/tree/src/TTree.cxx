@@ -337,6 +337,7 @@ End_Macro
 #include "TTree.h"
 
 #include "ROOT/TIOFeatures.hxx"
+#include "ROOT/StringUtils.hxx"
 #include "TArrayC.h"
 #include "TBufferFile.h"
 #include "TBaseClass.h"
@@ -380,6 +381,7 @@ End_Macro
 #include "TStreamerInfo.h"
 #include "TStyle.h"
 #include "TSystem.h"
+#include "TTimeStamp.h"
 #include "TTreeCloner.h"
 #include "TTreeCache.h"
 #include "TTreeCacheUnzip.h"
@@ -870,6 +872,13 @@ TTree::TTree(const char* name, const char* title, Int_t splitlevel /* = 99 */,
 
 TTree::~TTree()
 {
+#ifdef R__USE_IMT
+   if (fAsyncFlushQueue) {
+      FlushAsyncBaskets();
+      delete fAsyncFlushQueue;
+      fAsyncFlushQueue = nullptr;
+   }
+#endif
    if (fDirectory) {
       // We are in a directory, which may possibly be a file.
       if (fDirectory->GetList()) {
@@ -1394,6 +1403,9 @@ Long64_t TTree::AutoSave(Option_t* option)
    if (opt.Contains("flushbaskets")) {
       if (gDebug > 0) Info("AutoSave", "calling FlushBaskets \n");
       FlushBaskets();
+   } else {
+      // The branch bookkeeping of the baskets in flight must be up to date.
+      FlushAsyncBaskets();
    }
 
    fSavedBytes = GetZipBytes();
@@ -4454,7 +4466,10 @@ Int_t TTree::Fill()
 
 #ifdef R__USE_IMT
    const auto useIMT = ROOT::IsImplicitMTEnabled() && fIMTEnabled;
-   ROOT::Internal::TBranchIMTHelper imtHelper;
+   if (useIMT && fIMTAsyncFlush > 0 && !fAsyncFlushQueue) {
+      fAsyncFlushQueue = new ROOT::Internal::TBasketAsyncWriteQueue(fIMTAsyncFlush);
+   }
+   ROOT::Internal::TBranchIMTHelper imtHelper(useIMT ? fAsyncFlushQueue : nullptr);
    if (useIMT) {
       fIMTFlush = true;
       fIMTZipBytes.store(0);
@@ -4504,6 +4519,12 @@ Int_t TTree::Fill()
       nbytes += imtHelper.GetNbytes();
       nerror += imtHelper.GetNerrors();
    }
+   if (fAsyncFlushQueue) {
+      // Commit the baskets whose asynchronous write has completed in the meantime.
+      Long64_t nasync = 0;
+      nerror += fAsyncFlushQueue->Retire(kFALSE, nasync);
+      nbytes += nasync;
+   }
 #endif
 
    if (fBranchRef)
@@ -4540,7 +4561,10 @@ Int_t TTree::Fill()
          if (autoFlush || autoSave) {
             // First call FlushBasket to make sure that fTotBytes is up to date.
             FlushBaskets();
-            OptimizeBaskets(GetTotBytes(), 1, "");
+            if (fAdaptiveBasketMemory > 0)
+               RebalanceBaskets();
+            else
+               OptimizeBaskets(GetTotBytes(), 1, "");
             autoFlush = false; // avoid auto flushing again later
 
             if (gDebug > 0)
@@ -4591,11 +4615,16 @@ Int_t TTree::Fill()
    }
 
    if (autoFlush) {
-      FlushBaskets();
+      if (fAsyncFlushQueue && ROOT::IsImplicitMTEnabled() && fIMTEnabled)
+         QueueBaskets();
+      else
+         FlushBaskets();
       if (gDebug > 0)
          Info("TTree::Fill", "FlushBaskets() called at entry %lld, fZipBytes=%lld, fFlushedBytes=%lld\n", fEntries,
               GetZipBytes(), fFlushedBytes);
       fFlushedBytes = GetZipBytes();
+      if (fAdaptiveBasketMemory > 0)
+         RebalanceBaskets();
    }
 
    if (autoSave) {
@@ -4945,10 +4974,30 @@ struct BoolRAIIToggle {
 /// Return the number of bytes written or -1 in case of write error.
 
 Int_t TTree::FlushBaskets() const
+{
+   if (R__likely(!fPerfStats))
+      return FlushBasketsImpl();
+   Double_t start = TTimeStamp();
+   Int_t nbytes = FlushBasketsImpl();
+   fPerfStats->FlushEvent(const_cast<TTree *>(this), start, nbytes);
+   return nbytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the baskets of all the branches, see FlushBaskets.
+
+Int_t TTree::FlushBasketsImpl() const
 {
    if (!fDirectory) return 0;
    Int_t nbytes = 0;
    Int_t nerror = 0;
+   // First wait for the baskets handed over to the asynchronous flush, if any.
+   Int_t nasync = FlushAsyncBaskets();
+   if (nasync < 0) {
+      ++nerror;
+   } else {
+      nbytes += nasync;
+   }
    TObjArray *lb = const_cast<TTree*>(this)->GetListOfBranches();
    Int_t nb = lb->GetEntriesFast();
 
@@ -4995,7 +5044,7 @@ Int_t TTree::FlushBaskets() const
       const_cast<TTree*>(this)->AddTotBytes(fIMTTotBytes);
       const_cast<TTree*>(this)->AddZipBytes(fIMTZipBytes);
 
-      return nerrpar ? -1 : nbpar.load();
+      return (nerrpar || nerror) ? -1 : nbpar.load() + nbytes;
    }
 #endif
    for (Int_t j = 0; j < nb; j++) {
@@ -5016,6 +5065,63 @@ Int_t TTree::FlushBaskets() const
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for all the baskets handed over to the asynchronous flush (see
+/// SetIMTAsyncFlush) to be compressed and written, and update the bookkeeping
+/// of their branches.
+///
+/// This is called by FlushBaskets, and hence by Write and AutoSave, so that
+/// the tree header is never written while baskets are still in flight.
+///
+/// Return the number of bytes written or -1 in case of write error.
+
+Int_t TTree::FlushAsyncBaskets() const
+{
+#ifdef R__USE_IMT
+   if (!fAsyncFlushQueue || !fAsyncFlushQueue->GetNpending()) return 0;
+   Long64_t nbytes = 0;
+   Int_t nerror = fAsyncFlushQueue->Retire(kTRUE, nbytes);
+   return nerror ? -1 : nbytes;
+#else
+   return 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hand the write basket of every branch over to the asynchronous flush queue.
+///
+/// This is what TTree::Fill does instead of FlushBaskets at the end of a
+/// cluster when the asynchronous flush is enabled: the baskets still end at
+/// the cluster boundary, but Fill does not wait for them to be written.
+///
+/// Return -1 in case of error, 0 otherwise.
+
+Int_t TTree::QueueBaskets()
+{
+   if (!fDirectory) return 0;
+   Int_t nerror = 0;
+#ifdef R__USE_IMT
+   ROOT::Internal::TBranchIMTHelper imtHelper(fAsyncFlushQueue);
+   fIMTFlush = true;
+   fIMTZipBytes.store(0);
+   fIMTTotBytes.store(0);
+   Int_t nb = fBranches.GetEntriesFast();
+   for (Int_t j = 0; j < nb; j++) {
+      TBranch* branch = (TBranch*) fBranches.UncheckedAt(j);
+      if (branch && branch->FlushBasketsImpl(&imtHelper) < 0) {
+         ++nerror;
+      }
+   }
+   // Baskets other than the write basket (if any) are flushed in parallel tasks of the helper.
+   imtHelper.Wait();
+   fIMTFlush = false;
+   AddTotBytes(fIMTTotBytes);
+   AddZipBytes(fIMTZipBytes);
+   nerror += imtHelper.GetNerrors();
+#endif
+   return nerror ? -1 : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the expanded value of the alias.  Search in the friends if any.
 
@@ -5150,6 +5256,17 @@ TBranch* TTree::GetBranch(const char* name)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return pointer to the branch with the given name, given as a string_view.
+/// The name is copied to a buffer on the stack to be passed to
+/// GetBranch(const char*), without any allocation for the usual names.
+
+TBranch* TTree::GetBranch(std::string_view name)
+{
+   ROOT::Internal::TNullTerminatedString cname(name);
+   return GetBranch(cname.c_str());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return status of branch with name branchname.
 ///
@@ -5513,9 +5630,8 @@ Int_t TTree::GetEntry(Long64_t entry, Int_t getall)
    // GetEntry in list of friends
    if (!fFriends) return nbytes;
    TFriendLock lock(this,kGetEntry);
-   TIter nextf(fFriends);
-   TFriendElement *fe;
-   while ((fe = (TFriendElement*)nextf())) {
+   for (TObject *obj : ROOT::Detail::TListRange(fFriends)) {
+      TFriendElement *fe = (TFriendElement*)obj;
       TTree *t = fe->GetTree();
       if (t) {
          if (fe->TestBit(TFriendElement::kFromChain)) {
@@ -5716,9 +5832,8 @@ Int_t TTree::GetEntryWithIndex(Int_t major, Int_t minor)
    // GetEntry in list of friends
    if (!fFriends) return nbytes;
    TFriendLock lock(this,kGetEntryWithIndex);
-   TIter nextf(fFriends);
-   TFriendElement* fe = 0;
-   while ((fe = (TFriendElement*) nextf())) {
+   for (TObject *obj : ROOT::Detail::TListRange(fFriends)) {
+      TFriendElement* fe = (TFriendElement*) obj;
       TTree *t = fe->GetTree();
       if (t) {
          serial = t->GetEntryNumberWithIndex(major,minor);
@@ -6238,10 +6353,9 @@ Long64_t TTree::LoadTree(Long64_t entry)
       Bool_t needUpdate = kFALSE;
       {
          // This scope is need to insure the lock is released at the right time
-         TIter nextf(fFriends);
          TFriendLock lock(this, kLoadTree);
-         TFriendElement* fe = 0;
-         while ((fe = (TFriendElement*) nextf())) {
+         for (TObject *obj : ROOT::Detail::TListRange(fFriends)) {
+            TFriendElement* fe = (TFriendElement*) obj;
             if (fe->TestBit(TFriendElement::kFromChain)) {
                // This friend element was added by the chain that owns this
                // tree, the chain will deal with loading the correct entry.
@@ -6252,14 +6366,15 @@ Long64_t TTree::LoadTree(Long64_t entry)
                // Somehow we failed to retrieve the friend TTree.
             } else if (friendTree->IsA() == TTree::Class()) {
                // Friend is actually a tree.
-               if (friendTree->LoadTreeFriend(entry, this) >= 0) {
+               // An aligned friend has the entry number of its parent: skip the index lookup.
+               if ((fe->IsAligned() ? friendTree->LoadTree(entry) : friendTree->LoadTreeFriend(entry, this)) >= 0) {
                   friendHasEntry = kTRUE;
                }
             } else {
                // Friend is actually a chain.
                // FIXME: This logic should be in the TChain override.
                Int_t oldNumber = friendTree->GetTreeNumber();
-               if (friendTree->LoadTreeFriend(entry, this) >= 0) {
+               if ((fe->IsAligned() ? friendTree->LoadTree(entry) : friendTree->LoadTreeFriend(entry, this)) >= 0) {
                   friendHasEntry = kTRUE;
                }
                Int_t newNumber = friendTree->GetTreeNumber();
@@ -6891,6 +7006,87 @@ void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *opti
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Append to branches the branches of list without sub-branches, recursively.
+
+static void R__CollectLeafBranches(TObjArray &list, std::vector<TBranch*> &branches)
+{
+   Int_t nb = list.GetEntriesFast();
+   for (Int_t i = 0; i < nb; ++i) {
+      TBranch *branch = (TBranch*) list.UncheckedAt(i);
+      if (branch->GetListOfBranches()->GetEntriesFast() > 0)
+         R__CollectLeafBranches(*branch->GetListOfBranches(), branches);
+      else
+         branches.push_back(branch);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Resize the baskets of the leaf branches from what was written during the
+/// cluster just completed (see SetAdaptiveBasketSizes).
+///
+/// Each branch is given the size holding its share of a cluster in
+/// fAdaptiveBasketsPerCluster baskets, including the entry offsets.  A
+/// basket costs its size plus the compression buffer, estimated from the
+/// compression ratio observed during the cluster; if the total cost exceeds
+/// fAdaptiveBasketMemory all the sizes are scaled down.  Changes smaller than
+/// 20% are ignored so that the buffers are not reallocated at every cluster.
+
+void TTree::RebalanceBaskets()
+{
+   // The baskets of the cluster may still be in the asynchronous flush queue:
+   // the byte counts of their branches are only updated once they are written.
+   FlushAsyncBaskets();
+
+   std::vector<TBranch*> branches;
+   R__CollectLeafBranches(fBranches, branches);
+   Int_t nbranches = branches.size();
+   if (fEntries < fAdaptiveLastEntry) {
+      // The tree was reset.
+      fAdaptiveLastEntry = 0;
+      fAdaptiveBytes.clear();
+   }
+   Long64_t nentries = fEntries - fAdaptiveLastEntry;
+   if (nbranches == 0 || nentries <= 0) return;
+   if ((Int_t)fAdaptiveBytes.size() != nbranches) {
+      // Branches were added: measure them from scratch.
+      fAdaptiveBytes.resize(nbranches, std::make_pair(0LL, 0LL));
+   }
+   fAdaptiveLastEntry = fEntries;
+
+   const Double_t perCluster = fAdaptiveBasketsPerCluster;
+   std::vector<Double_t> wanted(nbranches, 0.);
+   Double_t totalCost = 0.;
+   for (Int_t i = 0; i < nbranches; ++i) {
+      TBranch *branch = branches[i];
+      Long64_t totBytes = branch->GetTotBytes();
+      Long64_t zipBytes = branch->GetZipBytes();
+      Long64_t clusterTot = totBytes - fAdaptiveBytes[i].first;
+      Long64_t clusterZip = zipBytes - fAdaptiveBytes[i].second;
+      fAdaptiveBytes[i] = std::make_pair(totBytes, zipBytes);
+      if (clusterTot <= 0) continue;
+      Double_t ratio = clusterZip > 0 ? Double_t(clusterTot) / clusterZip : 1.;
+      wanted[i] = (clusterTot + nentries * sizeof(Int_t) * 2) / perCluster;
+      totalCost += wanted[i] * (1. + 1. / TMath::Max(ratio, 1.));
+   }
+   Double_t scale = totalCost > fAdaptiveBasketMemory ? fAdaptiveBasketMemory / totalCost : 1.;
+
+   static const Double_t hardmax = 1*1024*1024*1024; // Never give more than 1Gb to a single buffer.
+   for (Int_t i = 0; i < nbranches; ++i) {
+      if (wanted[i] <= 0) continue;
+      TBranch *branch = branches[i];
+      Double_t sizeOfOneEntry = branch->GetEntries() ? 1. + Double_t(branch->GetTotBytes()) / branch->GetEntries() : 0.;
+      Double_t bsize = TMath::Min(hardmax, TMath::Max(wanted[i] * scale, TMath::Max(512., sizeOfOneEntry)));
+      Int_t newBsize = Int_t(bsize);
+      newBsize = newBsize - newBsize % 512 + 512;
+      Int_t oldBsize = branch->GetBasketSize();
+      if (TMath::Abs(newBsize - oldBsize) < 0.2 * oldBsize) continue;
+      if (gDebug > 0)
+         Info("RebalanceBaskets", "Changing buffer size from %6d to %6d bytes for %s", oldBsize, newBsize, branch->GetName());
+      branch->SetBasketSize(newBsize);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interface to the Principal Components Analysis class.
 ///
@@ -7655,6 +7851,8 @@ void TTree::RemoveFriend(TTree* oldFriend)
 
 void TTree::Reset(Option_t* option)
 {
+   FlushAsyncBaskets();
+
    fNotify        = 0;
    fEntries       = 0;
    fNClusterRange = 0;
@@ -7808,6 +8006,41 @@ Bool_t TTree::SetAlias(const char* aliasName, const char* aliasFormula)
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable (maxmemory > 0) or disable (maxmemory == 0) the continuous resizing
+/// of the baskets during Fill.
+///
+/// OptimizeBaskets is called once, at the first auto-flush, and only sees the
+/// entries written so far.  In this mode the basket sizes of all the leaf
+/// branches are instead recomputed at every cluster boundary from what the
+/// cluster just written contained: each branch gets the size that holds its
+/// share of a cluster in `basketspercluster` baskets, within a total memory
+/// budget of `maxmemory` bytes.  The memory taken by a basket includes its
+/// compression buffer, estimated from the compression ratio observed for the
+/// branch.  This keeps the basket sizes in line with the branch occupancy when
+/// it drifts during long jobs.
+///
+/// The first resizing replaces the call to OptimizeBaskets; calling this
+/// after the first auto-flush starts from the following cluster boundary.
+
+void TTree::SetAdaptiveBasketSizes(Long64_t maxmemory, Int_t basketspercluster)
+{
+   if (maxmemory < 0) maxmemory = 0;
+   if (basketspercluster < 1) basketspercluster = 1;
+   fAdaptiveBasketMemory = maxmemory;
+   fAdaptiveBasketsPerCluster = basketspercluster;
+   fAdaptiveLastEntry = fEntries;
+   fAdaptiveBytes.clear();
+   if (maxmemory) {
+      // Start measuring from the data already written.
+      FlushAsyncBaskets();
+      std::vector<TBranch*> branches;
+      R__CollectLeafBranches(fBranches, branches);
+      for (TBranch *branch : branches)
+         fAdaptiveBytes.push_back(std::make_pair(branch->GetTotBytes(), branch->GetZipBytes()));
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This function may be called at the start of a program to change
 /// the default value for fAutoFlush.
@@ -8319,6 +8552,12 @@ Int_t TTree::SetCacheSizeAux(Bool_t autocache /* = kTRUE */, Long64_t cacheSize
       return 0;
    }
 
+   // The baskets of a memory mapped file are decompressed straight from the
+   // mapping, a cache would only add a copy.
+   if (autocache && file->IsMapped()) {
+      return 0;
+   }
+
    // Check for an existing cache
    TTreeCache* pf = GetReadCache(file);
    if (pf) {
@@ -8734,6 +8973,49 @@ void TTree::SetFileNumber(Int_t number)
    fFileNumber = number;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable (maxbaskets > 0) or disable (maxbaskets == 0) the asynchronous
+/// flushing of baskets during TTree::Fill.
+///
+/// When enabled, and when implicit multi-threading is enabled for this tree
+/// (see ROOT::EnableImplicitMT and TTree::SetImplicitMT), the baskets that
+/// become full during Fill, as well as the baskets ending a cluster when the
+/// auto-flush threshold is reached, are not compressed and written before Fill
+/// returns: they are handed over to IMT tasks and Fill goes on with fresh
+/// baskets. At most `maxbaskets` baskets can be in flight at any time; when
+/// this bound is reached, Fill waits for all of them to be written.
+///
+/// The baskets in flight are waited for by FlushBaskets, and hence by Write
+/// and AutoSave; the tree must be written (or its baskets flushed) before its
+/// file is closed. Each basket in flight holds its own compression buffer, so
+/// the memory used grows with `maxbaskets`.
+///
+/// This is a transient setting: the files written are readable by any reader.
+
+void TTree::SetIMTAsyncFlush(Int_t maxbaskets)
+{
+   if (maxbaskets < 0) {
+      Warning("SetIMTAsyncFlush", "the maximum number of baskets in flight must be positive. Disabling the asynchronous flush");
+      maxbaskets = 0;
+   }
+#ifdef R__USE_IMT
+   fIMTAsyncFlush = maxbaskets;
+   if (fAsyncFlushQueue) {
+      if (maxbaskets) {
+         fAsyncFlushQueue->SetMaxPending(maxbaskets);
+      } else {
+         FlushAsyncBaskets();
+         delete fAsyncFlushQueue;
+         fAsyncFlushQueue = nullptr;
+      }
+   }
+#else
+   if (maxbaskets) {
+      Warning("SetIMTAsyncFlush", "ROOT was built without implicit multi-threading support; baskets are flushed synchronously");
+   }
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set all the branches in this TTree to be in decomposed object mode
 /// (also known as MakeClass mode).
@@ -213,6 +213,23 @@ branches that will be used very rarely.
        ... here you process your entry
     }
 ~~~
+## CLUSTER LOOKAHEAD
+
+Over high latency links, the processing of the entries of a cluster and the
+reading of the next one can be overlapped: with
+~~~ {.cpp}
+    TTreeCache *cache = (TTreeCache*)f->GetCacheRead(T);
+    cache->SetClusterLookahead(2);   // announce the 2 clusters following the cached ones
+~~~
+each time the cache is filled, the baskets of the cached branches in the
+following clusters are announced to the file with TFile::ReadBufferAsync.
+The file implementation (kernel read-ahead for local files, asynchronous
+requests for the xrootd and davix plugins) then fetches them while the
+current clusters are processed.  The amount of data announced ahead is
+limited (by default the lookahead depth times the cache size).  The default
+depth can be set with the TTreeCache.ClusterLookahead resource; files that do
+not support ReadBufferAsync ignore the setting.
+
 ## SPECIAL CASES WHERE TreeCache should not be activated
 
 When reading only a small fraction of all entries such that not all branch
@@ -235,13 +252,21 @@ of effective system reads for a given file with a code like
 #include "TList.h"
 #include "TBranch.h"
 #include "TEventList.h"
+#include "TEntryList.h"
 #include "TObjString.h"
 #include "TRegexp.h"
 #include "TLeaf.h"
 #include "TFriendElement.h"
 #include "TFile.h"
+#include "TMath.h"
+#include "TPerfCounters.h"
+#include "TTimelineTracer.h"
 #include <limits.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 Int_t TTreeCache::fgLearnEntries = 100;
 
 ClassImp(TTreeCache);
@@ -272,7 +297,14 @@ TTreeCache::TTreeCache() : TFileCacheRead(),
    fReadDirectionSet(kFALSE),
    fEnabled(kTRUE),
    fPrefillType(GetConfiguredPrefillType()),
-   fAutoCreated(kFALSE)
+   fAutoCreated(kFALSE),
+   fClusterLookahead(gEnv->GetValue("TTreeCache.ClusterLookahead", 0)),
+   fLookaheadMaxBytes(0),
+   fEntryLookahead(-1),
+   fLookaheadSupported(-1),
+   fNReadAhead(0),
+   fEntrySelection(0),
+   fFillingFriends(kFALSE)
 {
 }
 
@@ -302,7 +334,14 @@ TTreeCache::TTreeCache(TTree *tree, Int_t buffersize) : TFileCacheRead(tree->Get
    fReadDirectionSet(kFALSE),
    fEnabled(kTRUE),
    fPrefillType(GetConfiguredPrefillType()),
-   fAutoCreated(kFALSE)
+   fAutoCreated(kFALSE),
+   fClusterLookahead(gEnv->GetValue("TTreeCache.ClusterLookahead", 0)),
+   fLookaheadMaxBytes(0),
+   fEntryLookahead(-1),
+   fLookaheadSupported(-1),
+   fNReadAhead(0),
+   fEntrySelection(0),
+   fFillingFriends(kFALSE)
 {
    fEntryNext = fEntryMin + fgLearnEntries;
    Int_t nleaves = tree->GetListOfLeaves()->GetEntries();
@@ -320,6 +359,7 @@ TTreeCache::~TTreeCache()
 
    delete fBranches;
    if (fBrNames) {fBrNames->Delete(); delete fBrNames; fBrNames=0;}
+   delete fEntrySelection;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -700,6 +740,8 @@ Bool_t TTreeCache::FillBuffer()
    // Triggered by the user, not the learning phase
    if (entry == -1)  entry = 0;
 
+   ROOT::TTimelineTracer::TSpan span("io", "TTreeCache::FillBuffer", "entry", entry);
+
    fEntryCurrentMax = fEntryCurrent;
    TTree::TClusterIterator clusterIter = tree->GetClusterIterator(entry);
    fEntryCurrent = clusterIter();
@@ -721,7 +763,7 @@ Bool_t TTreeCache::FillBuffer()
    // list.
    TEventList *elist = fTree->GetEventList();
    Long64_t chainOffset = 0;
-   if (elist) {
+   if (elist || fEntrySelection) {
       if (fTree->IsA() ==TChain::Class()) {
          TChain *chain = (TChain*)fTree;
          Int_t t = chain->GetTreeNumber();
@@ -788,10 +830,12 @@ Bool_t TTreeCache::FillBuffer()
                //important: do not try to read fEntryNext, otherwise you jump to the next autoflush
                if (entries[j] >= fEntryNext) break; // break out of the for each branch loop.
                if (entries[j] < minEntry && (j<nb-1 && entries[j+1] <= minEntry)) continue;
-               if (elist) {
+               if (elist || fEntrySelection) {
                   Long64_t emax = fEntryMax;
                   if (j<nb-1) emax = entries[j+1]-1;
-                  if (!elist->ContainsRange(entries[j]+chainOffset,emax+chainOffset)) continue;
+                  if (elist && !elist->ContainsRange(entries[j]+chainOffset,emax+chainOffset)) continue;
+                  // GetNInRange is negative for the lists of sub-lists: no selection then
+                  if (fEntrySelection && fEntrySelection->GetNInRange(entries[j]+chainOffset,emax+chainOffset+1) == 0) continue;
                }
                if (pass==2 && !firstBasketSeen) {
                   // Okay, this has already been requested in the first pass.
@@ -912,10 +956,133 @@ Bool_t TTreeCache::FillBuffer()
          fFirstTime = kFALSE;
       }
    }
+   if (fClusterLookahead > 0 && !fIsLearning && !fReverseRead) {
+      IssueLookahead(tree);
+   }
+   if (!fIsLearning) {
+      FillAlignedFriends(tree);
+   }
    fIsLearning = kFALSE;
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill, together with this cache, the caches of the friends declared aligned
+/// (TFriendElement::SetAligned) and stored in other files, so that the reads
+/// of a tree and of its friends are scheduled at the same cluster boundaries
+/// rather than each time the reading of a friend crosses one of its own
+/// clusters. The entry of the friends has already been set by the LoadTree
+/// of their parent.
+
+void TTreeCache::FillAlignedFriends(TTree *tree)
+{
+   if (fFillingFriends) return;
+   fFillingFriends = kTRUE;
+   for (TTree *t : {fTree, tree}) {
+      if (!t || !t->GetListOfFriends() || (t == tree && tree == fTree)) continue;
+      for (TObject *obj : *t->GetListOfFriends()) {
+         TFriendElement *fe = (TFriendElement*) obj;
+         if (!fe->IsAligned()) continue;
+         TTree *friendTree = fe->GetTree() ? fe->GetTree()->GetTree() : 0;
+         TFile *friendFile = friendTree ? friendTree->GetCurrentFile() : 0;
+         if (!friendFile || friendFile == fFile || friendTree->GetReadEntry() < 0) continue;
+         TTreeCache *friendCache = dynamic_cast<TTreeCache*>(friendFile->GetCacheRead(friendTree));
+         if (friendCache && friendCache != this && friendCache->IsEnabled() && !friendCache->IsLearning()) {
+            friendCache->FillBuffer();
+         }
+      }
+   }
+   fFillingFriends = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Announce to the file, via TFile::ReadBufferAsync, the baskets of the cached
+/// branches in the fClusterLookahead clusters following the cached entry range
+/// [fEntryCurrent, fEntryNext), so that their transfer overlaps with the
+/// processing of the cached entries.  The clusters already announced by a
+/// previous call are skipped and at most fLookaheadMaxBytes are announced.
+
+void TTreeCache::IssueLookahead(TTree *tree)
+{
+   if (!fFile || fEntryNext < 0 || fEntryNext >= fEntryMax) return;
+   if (fLookaheadSupported < 0) {
+      // ReadBufferAsync(0, 0) returns kTRUE when the file does not support asynchronous reads.
+      fLookaheadSupported = fFile->ReadBufferAsync(0, 0) ? 0 : 1;
+   }
+   if (!fLookaheadSupported) return;
+
+   TTree::TClusterIterator clusterIter = tree->GetClusterIterator(fEntryNext);
+   Long64_t lookaheadMin = clusterIter();
+   Long64_t lookaheadMax = clusterIter.GetNextEntry();
+   for (Int_t i = 1; i < fClusterLookahead && lookaheadMax < fEntryMax; ++i) {
+      clusterIter.Next();
+      lookaheadMax = clusterIter.GetNextEntry();
+   }
+   if (lookaheadMax > fEntryMax) lookaheadMax = fEntryMax;
+   // Skip what was announced already, unless we jumped backward.
+   if (fEntryLookahead > lookaheadMin && fEntryLookahead <= lookaheadMax) lookaheadMin = fEntryLookahead;
+   if (lookaheadMin >= lookaheadMax) return;
+
+   Long64_t maxbytes = fLookaheadMaxBytes > 0 ? fLookaheadMaxBytes : (Long64_t)fClusterLookahead * fBufferSizeMin;
+   std::vector<std::pair<Long64_t, Int_t>> blocks;
+   Long64_t nbytes = 0;
+   Long64_t entryEnd = lookaheadMax;
+   for (Int_t i = 0; i < fNbranches && nbytes < maxbytes; ++i) {
+      TBranch *b = (TBranch*)fBranches->UncheckedAt(i);
+      if (b->GetDirectory() == 0 || b->GetDirectory()->GetFile() != fFile) continue;
+      Int_t nb = b->GetMaxBaskets();
+      Int_t *lbaskets = b->GetBasketBytes();
+      Long64_t *entries = b->GetBasketEntry();
+      if (!lbaskets || !entries) continue;
+      Int_t blistsize = b->GetListOfBaskets()->GetSize();
+      // Only the entries of the written baskets are sorted.
+      Int_t nsorted = TMath::Min(nb, b->GetWriteBasket() + 1);
+      Int_t j = (Int_t)TMath::BinarySearch(nsorted, entries, lookaheadMin);
+      if (j < 0) j = 0;
+      for (; j < nsorted && entries[j] < lookaheadMax; ++j) {
+         if (j < blistsize && b->GetListOfBaskets()->UncheckedAt(j)) continue;
+         Long64_t pos = b->GetBasketSeek(j);
+         Int_t len = lbaskets[j];
+         if (pos <= 0 || len <= 0) continue;
+         // Baskets starting in the current cluster have been requested by FillBuffer.
+         if (entries[j] < fEntryNext) continue;
+         if (nbytes + len > maxbytes) {
+            // Stop at the cluster boundary below this basket so the next call resumes there.
+            if (entries[j] < entryEnd) entryEnd = entries[j];
+            break;
+         }
+         blocks.emplace_back(pos, len);
+         nbytes += len;
+      }
+   }
+   if (blocks.empty()) return;
+
+   // Merge adjacent blocks to limit the number of requests.
+   std::sort(blocks.begin(), blocks.end());
+   Long64_t pos = blocks[0].first;
+   Long64_t end = pos + blocks[0].second;
+   for (size_t k = 1; k <= blocks.size(); ++k) {
+      if (k < blocks.size() && blocks[k].first <= end) {
+         end = std::max(end, blocks[k].first + blocks[k].second);
+         continue;
+      }
+      fFile->ReadBufferAsync(pos, (Int_t)(end - pos));
+      if (k < blocks.size()) {
+         pos = blocks[k].first;
+         end = pos + blocks[k].second;
+      }
+   }
+   fNReadAhead += blocks.size();
+   if (entryEnd < lookaheadMax) {
+      TTree::TClusterIterator endIter = tree->GetClusterIterator(entryEnd);
+      entryEnd = endIter();
+   }
+   fEntryLookahead = entryEnd > lookaheadMin ? entryEnd : lookaheadMin;
+   if (gDebug > 0)
+      Info("IssueLookahead", "announced %d blocks (%lld bytes) for entries %lld to %lld", (Int_t)blocks.size(), nbytes,
+           lookaheadMin, fEntryLookahead);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the desired prefill type from the environment or resource variable
 /// - 0 - No prefill
@@ -1003,6 +1170,10 @@ void TTreeCache::Print(Option_t *option) const
    printf("Cache Efficiency ..................: %f\n",GetEfficiency());
    printf("Cache Efficiency Rel...............: %f\n",GetEfficiencyRel());
    printf("Learn entries......................: %d\n",TTreeCache::GetLearnEntries());
+   if (fClusterLookahead > 0) {
+      printf("Cluster lookahead..................: %d\n",fClusterLookahead);
+      printf("Blocks announced ahead.............: %d\n",fNReadAhead);
+   }
    if ( opt.Contains("cachedbranches") ) {
       opt.ReplaceAll("cachedbranches","");
       printf("Cached branches....................:\n");
@@ -1092,10 +1263,20 @@ Int_t TTreeCache::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
    if (!fEnabled) return 0;
 
+   Int_t res;
    if (fEnablePrefetching)
-      return TTreeCache::ReadBufferPrefetch(buf, pos, len);
+      res = TTreeCache::ReadBufferPrefetch(buf, pos, len);
    else
-      return TTreeCache::ReadBufferNormal(buf, pos, len);
+      res = TTreeCache::ReadBufferNormal(buf, pos, len);
+
+   static const auto hits = ROOT::TPerfCounters::Register("root_treecache_hits_total", "Reads served by a TTreeCache");
+   static const auto misses =
+      ROOT::TPerfCounters::Register("root_treecache_misses_total", "Reads not served by a TTreeCache");
+   if (res == 1)
+      hits.Add();
+   else
+      misses.Add();
+   return res;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1104,6 +1285,7 @@ Int_t TTreeCache::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 void TTreeCache::ResetCache()
 {
    TFileCacheRead::Prefetch(0,0);
+   fEntryLookahead = -1;
 
    if (fEnablePrefetching) {
       fFirstTime = kTRUE;
@@ -1148,6 +1330,21 @@ Int_t TTreeCache::SetBufferSize(Int_t buffersize)
    return 1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of clusters, following the ones held by the cache, whose
+/// baskets are announced to the file for asynchronous reading each time the
+/// cache is filled; 0 disables the lookahead.
+/// At most `maxbytes` are announced ahead; if 0, the limit is `nclusters`
+/// times the cache size.
+/// The default depth is taken from the TTreeCache.ClusterLookahead resource.
+
+void TTreeCache::SetClusterLookahead(Int_t nclusters, Long64_t maxbytes)
+{
+   fClusterLookahead = nclusters > 0 ? nclusters : 0;
+   fLookaheadMaxBytes = maxbytes > 0 ? maxbytes : 0;
+   fEntryLookahead = -1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the minimum and maximum entry number to be processed
 /// this information helps to optimize the number of baskets to read
@@ -1162,6 +1359,7 @@ void TTreeCache::SetEntryRange(Long64_t emin, Long64_t emax)
    fEntryMin  = emin;
    fEntryMax  = emax;
    fEntryNext  = fEntryMin + fgLearnEntries * (fIsLearning && !fIsManual);
+   fEntryLookahead = -1;
    if (gDebug > 0)
       Info("SetEntryRange", "fEntryMin=%lld, fEntryMax=%lld, fEntryNext=%lld",
                              fEntryMin, fEntryMax, fEntryNext);
@@ -1172,6 +1370,19 @@ void TTreeCache::SetEntryRange(Long64_t emin, Long64_t emax)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Restricts the prefetching to the baskets containing at least one of the
+/// entries of elist, numbered as the entries of the tree owning the cache
+/// (the chain entries if the owner is a TChain). The list is copied; 0 removes
+/// the restriction, as does UpdateBranches (e.g. when a chain moves to the
+/// next file). The baskets of the entries not in the list are still read on demand.
+
+void TTreeCache::SetEntrySelection(const TEntryList *elist)
+{
+   delete fEntrySelection;
+   fEntrySelection = elist ? new TEntryList(*elist) : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Overload to make sure that the object specific
 
@@ -1186,6 +1397,8 @@ void TTreeCache::SetFile(TFile *file, TFile::ECacheAction action)
       prevFile->SetCacheRead(0, fTree, action);
    }
    TFileCacheRead::SetFile(file, action);
+   fEntryLookahead = -1;
+   fLookaheadSupported = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1225,6 +1438,7 @@ void TTreeCache::StartLearningPhase()
    if (fBrNames) fBrNames->Delete();
    fIsTransferred = kFALSE;
    fEntryCurrent = -1;
+   fEntryLookahead = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1258,6 +1472,8 @@ void TTreeCache::UpdateBranches(TTree *tree)
 {
 
    fTree = tree;
+   // the selected entries were numbered for the previous tree
+   SetEntrySelection(0);
 
    fEntryMin  = 0;
    fEntryMax  = fTree->GetEntries();
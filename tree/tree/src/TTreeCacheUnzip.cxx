@@ -20,10 +20,10 @@ Core TTree-related code borrowed from the previous version
 
 ## Parallel Unzipping
 
-TTreeCache has been specialised in order to let additional threads
-free to unzip in advance its content. In this implementation we
-support up to 10 threads, but right now it makes more sense to
-limit their number to 1-2
+TTreeCache has been specialised in order to unzip its content in
+advance, with tasks run on the implicit multi-threading thread pool
+(see ROOT::EnableImplicitMT); without IMT the baskets are unzipped by
+the reader when needed.
 
 The application reading data is carefully synchronized, in order to:
  - if the block it wants is not unzipped, it self-unzips it without
@@ -35,25 +35,28 @@ The application reading data is carefully synchronized, in order to:
 This is supposed to cancel a part of the unzipping latency, at the
 expenses of cpu time.
 
-The default parameters are the same of the prev version, i.e. 20%
-of the TTreeCache cache size. To change it use
-TTreeCache::SetUnzipBufferSize(Long64_t bufferSize)
+The unzipping tasks work ahead of the reader within a byte budget: no
+new task is started while the unzipped blocks not yet consumed exceed
+it. The default budget is twice the TTreeCache size. To change it use
+TTreeCacheUnzip::SetUnzipBufferSize(Long64_t bufferSize)
 where bufferSize must be passed in bytes.
 */
 
 #include "TTreeCacheUnzip.h"
 #include "TBranch.h"
 #include "TChain.h"
+#include "TEntryList.h"
 #include "TEnv.h"
 #include "TEventList.h"
 #include "TFile.h"
 #include "TMath.h"
 #include "TMutex.h"
 #include "TROOT.h"
+#include "TTimelineTracer.h"
 #include "TVirtualMutex.h"
 
 #ifdef R__USE_IMT
-#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TTaskGroup.hxx"
 #endif
 
 extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
@@ -63,8 +66,8 @@ TTreeCacheUnzip::EParUnzipMode TTreeCacheUnzip::fgParallel = TTreeCacheUnzip::kD
 
 // The unzip cache does not consume memory by itself, it just allocates in advance
 // mem blocks which are then picked as they are by the baskets.
-// Hence there is no good reason to limit it too much
-Double_t TTreeCacheUnzip::fgRelBuffSize = .5;
+// The budget for those blocks, relative to the cache size, is given here.
+Double_t TTreeCacheUnzip::fgRelBuffSize = 2.;
 
 ClassImp(TTreeCacheUnzip);
 
@@ -115,7 +118,7 @@ Bool_t TTreeCacheUnzip::UnzipState::IsUnzipped(Int_t index) const {
 
 void TTreeCacheUnzip::UnzipState::Reset(Int_t oldSize, Int_t newSize) {
    std::vector<Int_t>       aUnzipLen    = std::vector<Int_t>(newSize, 0);
-   std::unique_ptr<char[]> *aUnzipChunks = new std::unique_ptr<char[]>[newSize];
+   Chunk_t                 *aUnzipChunks = new Chunk_t[newSize];
    std::atomic<Byte_t>     *aUnzipStatus = new std::atomic<Byte_t>[newSize];
    memset(aUnzipStatus, 0, newSize*sizeof(std::atomic<Byte_t>));
 
@@ -182,6 +185,9 @@ TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipPendingBytes(0),
+   fUnzipNext(0),
+   fUnzipRatio(1.),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
@@ -201,6 +207,9 @@ TTreeCacheUnzip::TTreeCacheUnzip(TTree *tree, Int_t buffersize) : TTreeCache(tre
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipPendingBytes(0),
+   fUnzipNext(0),
+   fUnzipRatio(1.),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
@@ -253,6 +262,13 @@ void TTreeCacheUnzip::Init()
 
 TTreeCacheUnzip::~TTreeCacheUnzip()
 {
+#ifdef R__USE_IMT
+   // The tasks use the unzip state: stop them before wiping it.
+   if (fUnzipTaskGroup) {
+      fUnzipTaskGroup->Cancel();
+      fUnzipTaskGroup.reset();
+   }
+#endif
    ResetCache();
    delete fIOMutex;
    fUnzipState.Clear(fNseekMax);
@@ -316,8 +332,9 @@ Bool_t TTreeCacheUnzip::FillBuffer()
    // Special case reading only the baskets containing entries in the
    // list.
    TEventList *elist = fTree->GetEventList();
+   const TEntryList *selection = GetEntrySelection();
    Long64_t chainOffset = 0;
-   if (elist) {
+   if (elist || selection) {
       if (fTree->IsA() ==TChain::Class()) {
          TChain *chain = (TChain*)fTree;
          Int_t t = chain->GetTreeNumber();
@@ -350,10 +367,11 @@ Bool_t TTreeCacheUnzip::FillBuffer()
          //important: do not try to read fEntryNext, otherwise you jump to the next autoflush
          if (entries[j] >= fEntryNext) continue;
          if (entries[j] < entry && (j < nb - 1 && entries[j+1] <= entry)) continue;
-         if (elist) {
+         if (elist || selection) {
             Long64_t emax = fEntryMax;
             if (j < nb - 1) emax = entries[j+1] - 1;
-            if (!elist->ContainsRange(entries[j] + chainOffset, emax + chainOffset)) continue;
+            if (elist && !elist->ContainsRange(entries[j] + chainOffset, emax + chainOffset)) continue;
+            if (selection && selection->GetNInRange(entries[j] + chainOffset, emax + chainOffset + 1) == 0) continue;
          }
          fNReadPref++;
 
@@ -558,6 +576,7 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
    myCycle = fCycle;
    rdoffs = fSeek[index];
    rdlen = fSeekLen[index];
+   ROOT::TTimelineTracer::TSpan span("io", "TTreeCacheUnzip::UnzipCache", "bytes", rdlen);
 
    Int_t loc = -1;
    if (!fNseek || fIsLearning) {
@@ -570,20 +589,13 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
    }
 
    // Prepare a memory buffer of adequate size
-   char* locbuff = 0;
-   if (rdlen > 16384) {
-      locbuff = new char[rdlen];
-   } else if (rdlen * 3 < 16384) {
-      locbuff = new char[rdlen * 2];
-   } else {
-      locbuff = new char[16384];
-   }
+   char* locbuff = ROOT::Internal::TBufferPool::Acquire(rdlen);
 
    readbuf = ReadBufferExt(locbuff, rdoffs, rdlen, loc);
 
    if (readbuf <= 0) {
       fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-      if (locbuff) delete [] locbuff;
+      ROOT::Internal::TBufferPool::Release(locbuff);
       return -1;
    }
 
@@ -599,7 +611,7 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
                    Info("UnzipCache", "Block %d is too big, skipping.", index);
 
            fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-           if (locbuff) delete [] locbuff;
+           ROOT::Internal::TBufferPool::Release(locbuff);
            return 0;
    }
 
@@ -609,67 +621,93 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
    if ((loclen > 0) && (loclen == objlen + keylen)) {
       if ((myCycle != fCycle) || !fIsTransferred) {
          fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-         if (locbuff) delete [] locbuff;
+         ROOT::Internal::TBufferPool::Release(locbuff);
          return 1;
       }
+      fUnzipPendingBytes += loclen; // Must be accounted before the reader can consume it
       fUnzipState.SetUnzipped(index, ptr, loclen); // Set it as done
       fNUnzip++;
    } else {
       fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
    }
 
-   if (locbuff) delete [] locbuff;
+   ROOT::Internal::TBufferPool::Release(locbuff);
    return 0;
 }
 
 #ifdef R__USE_IMT
 ////////////////////////////////////////////////////////////////////////////////
-/// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
-/// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping 
-/// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// Create the TTaskGroup that unzips the baskets of the cache ahead of the
+/// reader, and schedule the first tasks.  The tasks run on the IMT thread
+/// pool: nothing is done when implicit multi-threading is not enabled, the
+/// baskets are then unzipped by the reader itself.
 
 Int_t TTreeCacheUnzip::CreateTasks()
 {
-   auto mapFunction = [&]() {
-      auto unzipFunction = [&](const std::vector<Int_t> &indices) {
-         // If cache is invalidated and we should return immediately.
-         if (!fIsTransferred) return nullptr;
+   if (!ROOT::IsImplicitMTEnabled()) return 0;
 
-         for (auto ii : indices) {
-            if(fUnzipState.TryUnzipping(ii)) {
-               Int_t res = UnzipCache(ii);
-               if(res)
-                  if (gDebug > 0)
-                     Info("UnzipCache", "Unzipping failed or cache is in learning state");
-            }
-         }
-         return nullptr;
-      };
+   fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
+   fUnzipNext = 0;
 
-      Int_t accusz = 0;
-      std::vector<std::vector<Int_t>> basketIndices;
+   // Account for the blocks still held from a previous round.
+   Long64_t pending = 0;
+   for (Int_t i = 0; i < fNseek && i < fNseekMax; ++i) {
+      if (fUnzipState.IsUnzipped(i)) pending += fUnzipState.fUnzipLen[i];
+   }
+   fUnzipPendingBytes = pending;
+
+   fUnzipRatio = 1.;
+   if (fNbranches > 0) {
+      TTree *tree = ((TBranch*)fBranches->UncheckedAt(0))->GetTree();
+      Long64_t zipbytes = tree->GetZipBytes();
+      if (zipbytes > 0 && tree->GetTotBytes() > zipbytes) fUnzipRatio = Double_t(tree->GetTotBytes()) / zipbytes;
+   }
+
+   ScheduleUnzip();
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hand over groups of baskets (of at least fUnzipGroupSize compressed bytes)
+/// to unzipping tasks, in the order they were registered in the cache, as
+/// long as the unzipped bytes not yet consumed by the reader, plus an
+/// estimate for the groups already scheduled, stay below fUnzipBufferSize.
+/// Called when the cache is filled and each time the reader consumes an
+/// unzipped block.
+
+void TTreeCacheUnzip::ScheduleUnzip()
+{
+   if (!fUnzipTaskGroup || !fIsTransferred) return;
+   if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
+
+   while (fUnzipNext < fNseek && fUnzipPendingBytes.load() < fUnzipBufferSize) {
       std::vector<Int_t> indices;
-      if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
-      for (Int_t i = 0; i < fNseek; i++) {
-         while (accusz < fUnzipGroupSize) {
-            accusz += fSeekLen[i];
-            indices.push_back(i);
-            i++;
-            if (i >= fNseek) break;
+      Int_t accusz = 0;
+      while (fUnzipNext < fNseek && accusz < fUnzipGroupSize) {
+         if (fUnzipState.IsUntouched(fUnzipNext)) {
+            indices.push_back(fUnzipNext);
+            accusz += fSeekLen[fUnzipNext];
          }
-         if (i < fNseek) i--;
-         basketIndices.push_back(indices);
-         indices.clear();
-         accusz = 0;
+         ++fUnzipNext;
       }
-      ROOT::TThreadExecutor pool;
-      pool.Foreach(unzipFunction, basketIndices);
-   };
+      if (indices.empty()) break;
 
-   fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
-   fUnzipTaskGroup->Run(mapFunction);
-
-   return 0;
+      // Reserve the budget until the task is done; UnzipCache accounts for the actual blocks.
+      Long64_t reserved = Long64_t(accusz * fUnzipRatio);
+      fUnzipPendingBytes += reserved;
+      fUnzipTaskGroup->Run([this, indices, reserved]() {
+         for (auto ii : indices) {
+            // If cache is invalidated we should return immediately.
+            if (!fIsTransferred) break;
+            if (fUnzipState.TryUnzipping(ii)) {
+               Int_t res = UnzipCache(ii);
+               if (res && gDebug > 0)
+                  Info("UnzipCache", "Unzipping failed or cache is in learning state");
+            }
+         }
+         fUnzipPendingBytes -= reserved;
+      });
+   }
 }
 #endif
 
@@ -731,6 +769,10 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                   fUnzipState.fUnzipChunks[seekidx].reset();
                   *free = kFALSE;
                }
+#ifdef R__USE_IMT
+               fUnzipPendingBytes -= fUnzipState.fUnzipLen[seekidx];
+               ScheduleUnzip();
+#endif
 
                fNFound++;
                return fUnzipState.fUnzipLen[seekidx];
@@ -780,6 +822,10 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                fUnzipState.fUnzipChunks[seekidx].reset();
                *free = kFALSE;
             }
+#ifdef R__USE_IMT
+            fUnzipPendingBytes -= fUnzipState.fUnzipLen[seekidx];
+            ScheduleUnzip();
+#endif
 
             fNStalls++;
             return fUnzipState.fUnzipLen[seekidx];
@@ -841,7 +887,9 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// static function: Sets the unzip relatibe buffer size
+/// static function: Sets the default unzip byte budget of the caches created
+/// afterwards, relative to their prefetching buffer size (default 2).
+/// Prefer SetUnzipBufferSize to set an absolute budget on a given cache.
 
 void TTreeCacheUnzip::SetUnzipRelBufferSize(Float_t relbufferSize)
 {
@@ -849,8 +897,10 @@ void TTreeCacheUnzip::SetUnzipRelBufferSize(Float_t relbufferSize)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Sets the size for the unzipping cache... by default it should be
-/// two times the size of the prefetching cache
+/// Sets the byte budget for the baskets unzipped ahead of the reader: no
+/// new unzipping task is started while the unzipped blocks not yet consumed
+/// (plus an estimate for the running tasks) exceed it.  By default it is
+/// two times the size of the prefetching cache (see SetUnzipRelBufferSize).
 
 void TTreeCacheUnzip::SetUnzipBufferSize(Long64_t bufferSize)
 {
@@ -860,9 +910,9 @@ void TTreeCacheUnzip::SetUnzipBufferSize(Long64_t bufferSize)
 ////////////////////////////////////////////////////////////////////////////////
 /// Unzips a ROOT specific buffer... by reading the header at the beginning.
 /// returns the size of the inflated buffer or -1 if error
-/// Note!! : If *dest == 0 we will allocate the buffer and it will be the
-/// responsability of the caller to free it... it is useful for example
-/// to pass it to the creator of TBuffer
+/// Note!! : If *dest == 0 we will allocate the buffer from the TBufferPool and
+/// it will be the responsability of the caller to give it back with
+/// TBufferPool::Release()... it is useful for example to pass it to TBasket
 /// src is the original buffer with the record (header+compressed data)
 /// *dest is the inflated buffer (including the header)
 
@@ -886,7 +936,7 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
          return uzlen;
       }
       Int_t l = keylen + objlen;
-      *dest = new char[l];
+      *dest = ROOT::Internal::TBufferPool::Acquire(l);
       alloc = kTRUE;
    }
    // Must unzip the buffer
@@ -944,7 +994,7 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
          Error("UnzipBuffer", "nbytes = %d, keylen = %d, objlen = %d, noutot = %d, nout=%d, nin=%d, nbuf=%d",
                nbytes,keylen,objlen, noutot,nout,nin,nbuf);
          uzlen = -1;
-         if(alloc) delete [] *dest;
+         if(alloc) ROOT::Internal::TBufferPool::Release(*dest);
          *dest = 0;
          return uzlen;
       }
@@ -964,6 +1014,7 @@ void  TTreeCacheUnzip::Print(Option_t* option) const {
 
    printf("******TreeCacheUnzip statistics for file: %s ******\n",fFile->GetName());
    printf("Max allowed mem for pending buffers: %lld\n", fUnzipBufferSize);
+   printf("Mem currently used by pending buffers: %lld\n", fUnzipPendingBytes.load());
    printf("Number of blocks unzipped by threads: %d\n", fNUnzip);
    printf("Number of hits: %d\n", fNFound);
    printf("Number of stalls: %d\n", fNStalls);
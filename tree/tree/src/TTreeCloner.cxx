@@ -36,6 +36,128 @@ Class implementing or helping  the various TTree cloning method
 #include "TFileCacheRead.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes the baskets read by TTreeCloner::WriteBaskets to the output file.
+/// When pipelined, the baskets are written by a thread in the order they are
+/// pushed, while the next ones are read, using a pool of baskets.
+
+class TClonedBasketWriter {
+   struct TItem {
+      TBasket *fBasket;
+      TBranch *fBranch;
+      TFile *fFile;
+      Long64_t fEntry;
+   };
+
+   std::vector<TBasket *> fBaskets; // all the baskets of the pool
+   std::vector<TBasket *> fFree;    // baskets ready to be read into
+   std::deque<TItem> fQueue;        // baskets to be written
+   Bool_t fBusy = kFALSE;           // a basket is being written
+   Bool_t fStop = kFALSE;
+   std::mutex fMutex;
+   std::condition_variable fCondition;
+   std::thread fThread;
+
+   static void Write(const TItem &item)
+   {
+      item.fBasket->CopyTo(item.fFile);
+      item.fBranch->AddBasket(*item.fBasket, kTRUE, item.fEntry);
+   }
+
+   void Run()
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      while (true) {
+         fCondition.wait(lock, [this] { return fStop || !fQueue.empty(); });
+         if (fQueue.empty())
+            return;
+         TItem item = fQueue.front();
+         fQueue.pop_front();
+         fBusy = kTRUE;
+         lock.unlock();
+         Write(item);
+         lock.lock();
+         fBusy = kFALSE;
+         fFree.push_back(item.fBasket);
+         fCondition.notify_all();
+      }
+   }
+
+public:
+   TClonedBasketWriter(Bool_t pipeline, Int_t depth)
+   {
+      for (Int_t i = 0; i < (pipeline ? depth : 1); ++i)
+         fBaskets.push_back(new TBasket());
+      fFree = fBaskets;
+      if (pipeline)
+         fThread = std::thread(&TClonedBasketWriter::Run, this);
+   }
+
+   ~TClonedBasketWriter()
+   {
+      if (fThread.joinable()) {
+         {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fStop = kTRUE;
+         }
+         fCondition.notify_all();
+         fThread.join();
+      }
+      for (auto basket : fBaskets)
+         delete basket;
+   }
+
+   /// Return a basket to read into, waiting for one to be written if needed.
+   TBasket *GetBasket()
+   {
+      if (!fThread.joinable())
+         return fBaskets[0];
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCondition.wait(lock, [this] { return !fFree.empty(); });
+      TBasket *basket = fFree.back();
+      fFree.pop_back();
+      return basket;
+   }
+
+   /// Write basket, read from the input file, into the output branch.
+   void Push(TBasket *basket, TBranch *to, TFile *tofile, Long64_t entry)
+   {
+      TItem item{basket, to, tofile, entry};
+      if (!fThread.joinable()) {
+         Write(item);
+         return;
+      }
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fQueue.push_back(item);
+      }
+      fCondition.notify_all();
+   }
+
+   /// Wait for all the pushed baskets to be written.
+   void Drain()
+   {
+      if (!fThread.joinable())
+         return;
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCondition.wait(lock, [this] { return fQueue.empty() && !fBusy; });
+   }
+};
+
+} // anonymous namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -356,6 +478,21 @@ UInt_t TTreeCloner::CollectBranches(TBranch *from, TBranch *to) {
 
    }
 
+   if (from->fNCompressionDict) {
+      // The baskets are copied as-is: the output branch needs the dictionary they were compressed against.
+      if (to->fNCompressionDict == 0) {
+         to->SetCompressionDictionary(from->fCompressionDict, from->fNCompressionDict);
+      } else if (to->fCompressionDictID != from->fCompressionDictID) {
+         fWarningMsg.Form("The export branch and the import branch do not use the same compression dictionary. (The branch name is %s.)",
+                          from->GetName());
+         if (!(fOptions & kNoWarnings)) {
+            Warning("TTreeCloner::CollectBranches", "%s", fWarningMsg.Data());
+         }
+         fIsValid = kFALSE;
+         return 0;
+      }
+   }
+
    fFromBranches.AddLast(from);
    if (!from->TestBit(TBranch::kDoNotUseBufferMap)) {
       // Make sure that we reset the Buffer's map if needed.
@@ -721,10 +858,18 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Transfer the basket from the input file to the output file
+///
+/// With implicit multi-threading enabled (ROOT::EnableImplicitMT), the baskets
+/// are written to the output file by a separate thread while the next ones are
+/// read from the input file.
 
 void TTreeCloner::WriteBaskets()
 {
-   TBasket *basket = new TBasket();
+   Bool_t pipeline = kFALSE;
+#ifdef R__USE_IMT
+   pipeline = ROOT::IsImplicitMTEnabled() && fMaxBaskets > 1 && fFromTree->GetCurrentFile() != fToTree->GetCurrentFile();
+#endif
+   TClonedBasketWriter writer(pipeline, kPipelineDepth);
    for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
       TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
@@ -739,6 +884,7 @@ void TTreeCloner::WriteBaskets()
          if (fFileCache && j >= notCached) {
             notCached = FillCache(notCached);
          }
+         TBasket *basket = writer.GetBasket();
          if (from->GetBasketBytes()[index] == 0) {
             from->GetBasketBytes()[index] = basket->ReadBasketBytes(pos, fromfile);
          }
@@ -746,9 +892,10 @@ void TTreeCloner::WriteBaskets()
 
          basket->LoadBasketBuffers(pos,len,fromfile,fFromTree);
          basket->IncrementPidOffset(fPidOffset);
-         basket->CopyTo(tofile);
-         to->AddBasket(*basket,kTRUE,fToStartEntries + from->GetBasketEntry()[index]);
+         writer.Push(basket, to, tofile, fToStartEntries + from->GetBasketEntry()[index]);
       } else {
+         // the baskets in memory are added to the output branch by this thread
+         writer.Drain();
          TBasket *frombasket = from->GetBasket( index );
          if (frombasket && frombasket->GetNevBuf()>0) {
             TBasket *tobasket = (TBasket*)frombasket->Clone();
@@ -758,5 +905,44 @@ void TTreeCloner::WriteBaskets()
          }
       }
    }
-   delete basket;
+   writer.Drain();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fast clone each tree of 'trees', the first of each pair, at the end of the
+/// corresponding output tree, the second of each pair, as TTree::CopyEntries
+/// with the option "fast" does. With implicit multi-threading enabled, the
+/// trees are copied in parallel: each output tree must then be in a different
+/// file, and the input trees must be different objects.
+/// 'option' is passed to TTree::CopyEntries.
+/// Return the number of trees copied successfully.
+
+Int_t TTreeCloner::CopyTrees(const std::vector<std::pair<TTree *, TTree *>> &trees, Option_t *option)
+{
+   TString opt(option);
+   if (!opt.Contains("fast", TString::kIgnoreCase))
+      opt += " fast";
+
+   std::vector<Int_t> copied(trees.size(), 0);
+   auto copy = [&](UInt_t i) {
+      TTree *from = trees[i].first;
+      TTree *to = trees[i].second;
+      if (from && to && to->CopyEntries(from, -1, opt) >= 0)
+         copied[i] = 1;
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && trees.size() > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(copy, ROOT::TSeqU(trees.size()));
+   } else
+#endif
+   {
+      for (UInt_t i = 0; i < trees.size(); ++i)
+         copy(i);
+   }
+
+   Int_t ncopied = 0;
+   for (auto c : copied)
+      ncopied += c;
+   return ncopied;
 }
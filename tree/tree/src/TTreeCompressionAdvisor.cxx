@@ -0,0 +1,371 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TTreeCompressionAdvisor
+\ingroup tree
+
+Recommend per-branch compression settings from measurements.
+
+A single compression setting (`TFile::SetCompressionSettings`) rarely suits
+all the branches of a tree: the branches of floating point values compress
+poorly and are better served by a fast algorithm, while the integer and
+boolean branches shrink a lot with the stronger ones.
+
+The advisor reads a few baskets of each branch of an existing tree and, for
+each candidate setting, compresses and decompresses their content in memory,
+measuring the compressed size and the time spent. The recommendation for each
+branch is the candidate that minimizes:
+  - kSize: the compressed size;
+  - kRead: the time to read the branch back, i.e. the decompression time plus
+    the time to transfer the compressed bytes at the read bandwidth of the
+    storage (`SetReadBandwidth`, 100 MB/s by default).
+
+The recommendations can then be applied to the branches of a tree being written,
+typically a clone of the measured one:
+~~~{.cpp}
+TTree *input = file->Get<TTree>("events");
+TTreeCompressionAdvisor advisor(input, TTreeCompressionAdvisor::kRead);
+advisor.Measure();
+advisor.Print();
+
+TFile output("output.root", "RECREATE");
+TTree *clone = input->CloneTree(0);
+advisor.Apply(clone);
+clone->CopyEntries(input);
+~~~
+By default the candidates are ZLIB, LZ4, LZMA and ZSTD at a low, a medium and
+a high level; `SetCandidates` replaces them by a list of compression settings
+(`100 * algorithm + level`, see `ROOT::CompressionSettings`).
+*/
+
+#include "TTreeCompressionAdvisor.h"
+
+#include "Compression.h"
+#include "RZip.h"
+#include "TBasket.h"
+#include "TBranch.h"
+#include "TBuffer.h"
+#include "TError.h"
+#include "TObjArray.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Collect the branches holding baskets, i.e. all the branches of the tree
+/// down to the leaf ones.
+
+void CollectBranches(TObjArray *branches, std::vector<TBranch *> &result)
+{
+   Int_t nb = branches->GetEntriesFast();
+   for (Int_t i = 0; i < nb; ++i) {
+      TBranch *branch = (TBranch *)branches->UncheckedAt(i);
+      if (!branch) continue;
+      result.push_back(branch);
+      CollectBranches(branch->GetListOfBranches(), result);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compress the buffer in blocks of kMAXZIPBUF bytes, as TBasket::WriteBuffer
+/// does. Returns the size of the compressed buffer, or 0 if the content
+/// does not compress, in which case TBasket writes it as is.
+
+Int_t Compress(Int_t settings, char *src, Int_t srcsize, std::vector<char> &tgt)
+{
+   Int_t cxlevel = settings % 100;
+   auto cxAlgorithm = static_cast<ROOT::ECompressionAlgorithm>(settings / 100);
+   Int_t nbuffers = 1 + (srcsize - 1) / kMAXZIPBUF;
+   tgt.resize(srcsize + 9 * nbuffers + 28);
+   char *bufcur = tgt.data();
+   Int_t noutot = 0;
+   for (Int_t i = 0; i < nbuffers; ++i) {
+      Int_t bufmax = (i == nbuffers - 1) ? srcsize - i * kMAXZIPBUF : kMAXZIPBUF;
+      Int_t nout = 0;
+      R__zipMultipleAlgorithm(cxlevel, &bufmax, src + i * kMAXZIPBUF, &bufmax, bufcur, &nout, cxAlgorithm);
+      if (nout == 0 || noutot + nout >= srcsize) return 0;
+      bufcur += nout;
+      noutot += nout;
+   }
+   return noutot;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decompress the blocks written by Compress into tgt. Returns kFALSE if they
+/// do not give back tgtsize bytes.
+
+Bool_t Decompress(std::vector<char> &src, Int_t srcsize, char *tgt, Int_t tgtsize)
+{
+   UChar_t *bufcur = (UChar_t *)src.data();
+   Int_t nintot = 0, noutot = 0;
+   while (nintot < srcsize && noutot < tgtsize) {
+      Int_t nin, nbuf, nout = 0;
+      if (R__unzip_header(&nin, bufcur, &nbuf) != 0) return kFALSE;
+      R__unzip(&nin, bufcur, &nbuf, (UChar_t *)tgt + noutot, &nout);
+      if (!nout) return kFALSE;
+      bufcur += nin;
+      nintot += nin;
+      noutot += nout;
+   }
+   return noutot == tgtsize;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create an advisor for the branches of tree, sampling nbaskets baskets per
+/// branch, spread over the branch.
+
+TTreeCompressionAdvisor::TTreeCompressionAdvisor(TTree *tree, EObjective objective, Int_t nbaskets)
+   : fTree(tree), fNBaskets(nbaskets > 0 ? nbaskets : 1), fObjective(objective), fReadBandwidth(100. * 1024 * 1024)
+{
+   const ROOT::ECompressionAlgorithm algorithms[] = {ROOT::kZLIB, ROOT::kLZ4, ROOT::kLZMA, ROOT::kZSTD};
+   const Int_t levels[] = {1, 5, 9};
+   for (auto algorithm : algorithms) {
+      for (auto level : levels) {
+         fCandidates.push_back(ROOT::CompressionSettings(algorithm, level));
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Change the objective of the recommendations; the branches already
+/// measured are not measured again.
+
+void TTreeCompressionAdvisor::SetObjective(EObjective objective)
+{
+   fObjective = objective;
+   for (auto &advice : fAdvice) Choose(advice);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the read bandwidth of the storage, in bytes per second, used to weigh
+/// the compressed size against the decompression time for the kRead objective.
+
+void TTreeCompressionAdvisor::SetReadBandwidth(Double_t bytesPerSecond)
+{
+   if (bytesPerSecond <= 0) {
+      Error("TTreeCompressionAdvisor::SetReadBandwidth", "The bandwidth must be positive, not %g", bytesPerSecond);
+      return;
+   }
+   fReadBandwidth = bytesPerSecond;
+   for (auto &advice : fAdvice) Choose(advice);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Select the best measurement of the branch for the current objective.
+/// The ties are broken by the other criterion.
+
+void TTreeCompressionAdvisor::Choose(TBranchAdvice &advice) const
+{
+   advice.fBest = -1;
+   Double_t bestCost = 0, bestOther = 0;
+   for (size_t i = 0; i < advice.fMeasurements.size(); ++i) {
+      const TMeasurement &m = advice.fMeasurements[i];
+      Double_t readTime = m.fDecompressTime + m.fCompressedBytes / fReadBandwidth;
+      Double_t cost = fObjective == kSize ? (Double_t)m.fCompressedBytes : readTime;
+      Double_t other = fObjective == kSize ? readTime : (Double_t)m.fCompressedBytes;
+      if (advice.fBest < 0 || cost < bestCost || (cost == bestCost && other < bestOther)) {
+         advice.fBest = i;
+         bestCost = cost;
+         bestOther = other;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the sampled baskets of the branch and measure each candidate on them.
+
+void TTreeCompressionAdvisor::MeasureBranch(TBranch *branch)
+{
+   // Only the baskets already written to the file can be sampled.
+   Int_t nwritten = 0;
+   Int_t nbaskets = branch->GetWriteBasket();
+   for (Int_t i = 0; i < nbaskets; ++i) {
+      if (branch->GetBasketBytes()[i]) ++nwritten;
+   }
+   if (!nwritten) return;
+
+   TBranchAdvice advice;
+   advice.fName = branch->GetName();
+   advice.fCurrentSettings = branch->GetCompressionSettings();
+   advice.fNBaskets = 0;
+   advice.fSampledBytes = 0;
+   advice.fCurrentBytes = 0;
+   advice.fBest = -1;
+
+   std::vector<std::vector<char>> samples;
+   Int_t nsamples = std::min(fNBaskets, nwritten);
+   for (Int_t s = 0; s < nsamples; ++s) {
+      // Spread the samples over the written baskets.
+      Int_t target = (Int_t)((Long64_t)s * nwritten / nsamples);
+      Int_t index = -1;
+      for (Int_t i = 0, n = 0; i < nbaskets; ++i) {
+         if (!branch->GetBasketBytes()[i]) continue;
+         if (n++ == target) {
+            index = i;
+            break;
+         }
+      }
+      TBasket *basket = index < 0 ? nullptr : branch->GetBasket(index);
+      if (!basket || !basket->GetBufferRef()) {
+         Warning("TTreeCompressionAdvisor::MeasureBranch", "Cannot read basket %d of the branch %s", index,
+                 branch->GetName());
+         continue;
+      }
+      Int_t objlen = basket->GetObjlen();
+      if (objlen <= 0) continue;
+      const char *content = basket->GetBufferRef()->Buffer() + basket->GetKeylen();
+      samples.emplace_back(content, content + objlen);
+      advice.fSampledBytes += objlen;
+      advice.fCurrentBytes += branch->GetBasketBytes()[index] - basket->GetKeylen();
+      ++advice.fNBaskets;
+   }
+   branch->DropBaskets();
+   if (samples.empty()) return;
+
+   using clock = std::chrono::steady_clock;
+   std::vector<char> compressed, decompressed;
+   for (Int_t settings : fCandidates) {
+      TMeasurement m{settings, 0, 0., 0.};
+      for (auto &sample : samples) {
+         Int_t objlen = sample.size();
+         auto start = clock::now();
+         Int_t nout = Compress(settings, sample.data(), objlen, compressed);
+         auto middle = clock::now();
+         if (nout) {
+            decompressed.resize(objlen);
+            if (!Decompress(compressed, nout, decompressed.data(), objlen) ||
+                memcmp(decompressed.data(), sample.data(), objlen) != 0) {
+               Error("TTreeCompressionAdvisor::MeasureBranch", "The content of the branch %s does not survive %s",
+                     branch->GetName(), GetSettingsName(settings).Data());
+            }
+         }
+         auto end = clock::now();
+         // A basket which does not compress is stored as is, and not decompressed when read.
+         m.fCompressedBytes += nout ? nout : objlen;
+         m.fCompressTime += std::chrono::duration<Double_t>(middle - start).count();
+         if (nout) m.fDecompressTime += std::chrono::duration<Double_t>(end - middle).count();
+      }
+      advice.fMeasurements.push_back(m);
+   }
+   Choose(advice);
+   fAdvice.push_back(std::move(advice));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Measure the candidate settings on all the branches of the tree, replacing
+/// the previous measurements. Returns the number of branches measured; the
+/// branches without baskets on file are skipped.
+
+Int_t TTreeCompressionAdvisor::Measure()
+{
+   fAdvice.clear();
+   if (!fTree) {
+      Error("TTreeCompressionAdvisor::Measure", "No tree to measure");
+      return 0;
+   }
+   if (fCandidates.empty()) {
+      Error("TTreeCompressionAdvisor::Measure", "No compression settings to measure");
+      return 0;
+   }
+   std::vector<TBranch *> branches;
+   CollectBranches(fTree->GetListOfBranches(), branches);
+   for (TBranch *branch : branches) MeasureBranch(branch);
+   return fAdvice.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the compression settings recommended for the branch, or -1 if it
+/// was not measured.
+
+Int_t TTreeCompressionAdvisor::GetRecommendation(const char *branchname) const
+{
+   for (auto &advice : fAdvice) {
+      if (advice.fName == branchname) return advice.GetRecommendedSettings();
+   }
+   return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the recommended compression settings on the branches of tree with the
+/// same names as the measured ones, usually a tree about to be filled.
+/// Only the baskets written afterwards are affected. Returns the number of
+/// branches whose settings were set.
+
+Int_t TTreeCompressionAdvisor::Apply(TTree *tree) const
+{
+   if (!tree) return 0;
+   Int_t napplied = 0;
+   for (auto &advice : fAdvice) {
+      TBranch *branch = tree->GetBranch(advice.fName.c_str());
+      if (!branch) {
+         Warning("TTreeCompressionAdvisor::Apply", "No branch %s in the tree %s", advice.fName.c_str(),
+                 tree->GetName());
+         continue;
+      }
+      // SetCompressionSettings also sets the sub-branches; they come after
+      // their parent in fAdvice and get their own recommendation next.
+      branch->SetCompressionSettings(advice.GetRecommendedSettings());
+      ++napplied;
+   }
+   return napplied;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the recommendation for each branch. With the option "all", print
+/// the measurements of all the candidates.
+
+void TTreeCompressionAdvisor::Print(Option_t *option) const
+{
+   TString opt = option;
+   opt.ToLower();
+   Bool_t all = opt.Contains("all");
+
+   Printf("Compression advice for the tree %s, optimized for %s%s", fTree ? fTree->GetName() : "",
+          fObjective == kSize ? "the size" : "the reading time",
+          fObjective == kSize ? "" : Form(" at %.0f MB/s", fReadBandwidth / (1024 * 1024)));
+   for (auto &advice : fAdvice) {
+      Printf("%-40s %d baskets, %lld bytes: %s (%.2f) -> %s", advice.fName.c_str(), advice.fNBaskets,
+             advice.fSampledBytes, GetSettingsName(advice.fCurrentSettings).Data(),
+             advice.fCurrentBytes ? (Double_t)advice.fSampledBytes / advice.fCurrentBytes : 0.,
+             GetSettingsName(advice.GetRecommendedSettings()).Data());
+      if (!all) continue;
+      for (size_t i = 0; i < advice.fMeasurements.size(); ++i) {
+         const TMeasurement &m = advice.fMeasurements[i];
+         Printf("   %c %-8s ratio %6.2f  compression %8.1f MB/s  decompression %8.1f MB/s",
+                (Int_t)i == advice.fBest ? '*' : ' ', GetSettingsName(m.fSettings).Data(), (Double_t)advice.fSampledBytes / m.fCompressedBytes,
+                m.fCompressTime > 0 ? advice.fSampledBytes / m.fCompressTime / (1024 * 1024) : 0.,
+                m.fDecompressTime > 0 ? advice.fSampledBytes / m.fDecompressTime / (1024 * 1024) : 0.);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a readable name of the compression settings, e.g. "LZ4-4".
+
+TString TTreeCompressionAdvisor::GetSettingsName(Int_t settings)
+{
+   Int_t level = settings % 100;
+   if (level == 0) return "none";
+   switch (settings / 100) {
+   case ROOT::kUseGlobalCompressionSetting:
+   case ROOT::kZLIB: return TString::Format("ZLIB-%d", level);
+   case ROOT::kLZMA: return TString::Format("LZMA-%d", level);
+   case ROOT::kOldCompressionAlgo: return TString::Format("old-%d", level);
+   case ROOT::kLZ4: return TString::Format("LZ4-%d", level);
+   case ROOT::kZSTD: return TString::Format("ZSTD-%d", level);
+   default: return TString::Format("%d", settings);
+   }
+}
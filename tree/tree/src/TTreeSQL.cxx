@@ -46,7 +46,9 @@ TTreeSQL::TTreeSQL(TSQLServer *server, TString DB, const TString& table) :
    fTable(table.Data()),
    fResult(0), fRow(0),
    fServer(server),
-   fBranchChecked(kFALSE)
+   fBranchChecked(kFALSE),
+   fInsertBatchSize(1),
+   fPendingRows(0)
 {
    fCurrentEntry = -1;
    fQuery = TString("Select * from " + fTable);
@@ -61,6 +63,14 @@ TTreeSQL::TTreeSQL(TSQLServer *server, TString DB, const TString& table) :
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor: insert the pending rows.
+
+TTreeSQL::~TTreeSQL()
+{
+   FlushInserts();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Not implemented yet
 
@@ -597,15 +607,93 @@ Int_t TTreeSQL::Fill()
    if (fInsertQuery[fInsertQuery.Length()-1]!='(') {
       fInsertQuery.Remove(fInsertQuery.Length()-1);
       fInsertQuery += ")";
-      TSQLResult *res = fServer?fServer->Query(fInsertQuery):0;
+      if (fInsertBatchSize <= 1) {
+         TSQLResult *res = fServer?fServer->Query(fInsertQuery):0;
 
-      if (res) {
-         return res->GetRowCount();
+         if (res) {
+            return res->GetRowCount();
+         }
+         return -1;
       }
+
+      // MySQL, PostgreSQL and SQLite insert several rows with a single
+      // statement (kept below the default packet size of the servers); the
+      // others get one statement per row, executed in a single transaction.
+      TString dbms = fServer->GetDBMS();
+      if (!fPendingInserts.empty() && fPendingInserts.back().Length() < 1000000 &&
+          (dbms == "MySQL" || dbms == "PgSQL" || dbms == "SQLite")) {
+         Ssiz_t values = fInsertQuery.Index(" VALUES (") + 8;
+         fPendingInserts.back() += ", ";
+         fPendingInserts.back() += fInsertQuery(values, fInsertQuery.Length() - values);
+      } else {
+         fPendingInserts.push_back(fInsertQuery);
+      }
+      ++fPendingRows;
+      if (fPendingRows >= fInsertBatchSize && FlushInserts() < 0) {
+         return -1;
+      }
+      return 1;
    }
    return -1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Insert in the database the rows filled since the last call, when Fill
+/// inserts several rows at once (see SetInsertBatchSize). The statements are
+/// executed in a transaction, rolled back if one of them fails.
+/// Returns the number of rows inserted, or -1 in case of error.
+
+Int_t TTreeSQL::FlushInserts()
+{
+   if (fPendingInserts.empty() || fServer == 0) return 0;
+
+   Bool_t transaction = fPendingInserts.size() > 1 && fServer->StartTransaction();
+   Bool_t ok = kTRUE;
+   for (const auto &query : fPendingInserts) {
+      if (!fServer->Exec(query)) {
+         ok = kFALSE;
+         break;
+      }
+   }
+   if (transaction) {
+      if (ok)
+         fServer->Commit();
+      else
+         fServer->Rollback();
+   }
+   Int_t nrows = fPendingRows;
+   fPendingInserts.clear();
+   fPendingRows = 0;
+   if (!ok) {
+      Error("FlushInserts", "cannot insert %d rows into %s: %s", nrows, fTable.Data(), fServer->GetErrorMsg());
+      return -1;
+   }
+   return nrows;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Insert the pending rows, see FlushInserts.
+
+Int_t TTreeSQL::FlushBaskets() const
+{
+   return const_cast<TTreeSQL*>(this)->FlushInserts();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of rows Fill inserts at once. With nrows > 1 the rows are
+/// kept until nrows of them are filled, then inserted with a single multi-row
+/// INSERT statement (MySQL, PostgreSQL, SQLite) or with one statement per row
+/// in a single transaction (other servers), which is much faster than one
+/// statement per Fill. The pending rows are also inserted by FlushInserts,
+/// before reading the table and when the tree is deleted.
+/// The default, 1, inserts each row when it is filled.
+
+void TTreeSQL::SetInsertBatchSize(Int_t nrows)
+{
+   if (nrows < fPendingRows) FlushInserts();
+   fInsertBatchSize = nrows;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return a vector of columns index corresponding to the
 /// current SQL table and the branch given as argument
@@ -680,6 +768,7 @@ Long64_t  TTreeSQL::GetEntries() const
    if (!CheckTable(fTable.Data())) return 0;
 
    TTreeSQL* thisvar = const_cast<TTreeSQL*>(this);
+   thisvar->FlushInserts();
 
    // What if the user already started to call GetEntry
    // What about the initial value of fEntries is it really 0?
@@ -735,6 +824,7 @@ Long64_t TTreeSQL::LoadTree(Long64_t entry)
 
 Long64_t TTreeSQL::PrepEntry(Long64_t entry)
 {
+   if (fPendingRows > 0 && entry < fEntries) FlushInserts();
    if (entry < 0 || entry >= fEntries || fServer==0) return 0;
    fReadEntry = entry;
 
@@ -19,13 +19,20 @@ not reqiuired to be a member of any class.
 #include <istream>
 #include <cassert>
 #include <cctype>
+#include <algorithm>
 
 #include "TreeUtils.h"
+#include "TBranch.h"
 #include "TNtupleD.h"
 #include "TNtuple.h"
 #include "TError.h"
 #include "TTree.h"
 
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 namespace ROOT {
 namespace TreeUtils {
 
@@ -307,5 +314,79 @@ bool NextCharacterIsEOL(std::istream &input)
    return next == '\r' || next == '\n';
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the values of the nentries entries starting at first of the given
+/// branches into contiguous buffers, one per branch, at the given addresses.
+/// The buffer of a branch must hold nentries * TBranch::GetBulkEntrySize()
+/// bytes; the values are stored in the native byte order.
+///
+/// Only the branches readable with TBranch::GetBulkEntries (a single leaf of a
+/// basic type, possibly a fixed-size array) are supported. A TChain is read
+/// tree by tree. When implicit multi-threading is enabled, the branches of
+/// each tree are read by parallel tasks.
+///
+/// Return the number of entries read (less than nentries if the tree has less
+/// entries) or -1 in case of error.
+
+Long64_t ReadBranchesInBulk(TTree &tree, const std::vector<std::string> &branches, Long64_t first,
+                            Long64_t nentries, const std::vector<ULong64_t> &addresses)
+{
+   if (branches.size() != addresses.size()) {
+      ::Error("TreeUtils::ReadBranchesInBulk", "%lu branches but %lu buffers given",
+              (unsigned long)branches.size(), (unsigned long)addresses.size());
+      return -1;
+   }
+
+   const std::size_t nbranches = branches.size();
+   std::vector<TBranch *> bulkBranches(nbranches);
+   std::vector<Int_t> sizes(nbranches);
+   std::vector<char> ok(nbranches);
+
+   Long64_t nread = 0;
+   while (nread < nentries) {
+      const Long64_t local = tree.LoadTree(first + nread);
+      if (local < 0)
+         break;
+      TTree *current = tree.GetTree();
+      const Long64_t n = std::min(nentries - nread, current->GetEntries() - local);
+
+      for (std::size_t i = 0; i < nbranches; ++i) {
+         TBranch *branch = current->GetBranch(branches[i].c_str());
+         if (!branch || branch->GetTree() != current || branch->GetBulkEntrySize() == 0) {
+            ::Error("TreeUtils::ReadBranchesInBulk", "%s is not a branch of tree %s readable in bulk",
+                    branches[i].c_str(), current->GetName());
+            return -1;
+         }
+         bulkBranches[i] = branch;
+         sizes[i] = branch->GetBulkEntrySize();
+      }
+
+      auto readBranch = [&](std::size_t i) {
+         char *dest = reinterpret_cast<char *>(addresses[i]) + nread * sizes[i];
+         ok[i] = (bulkBranches[i]->GetBulkEntries(local, n, dest) == n);
+      };
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled() && nbranches > 1) {
+         ROOT::TThreadExecutor pool;
+         pool.Foreach(readBranch, ROOT::TSeq<std::size_t>(nbranches));
+      } else
+#endif
+      {
+         for (std::size_t i = 0; i < nbranches; ++i)
+            readBranch(i);
+      }
+
+      for (std::size_t i = 0; i < nbranches; ++i) {
+         if (!ok[i]) {
+            ::Error("TreeUtils::ReadBranchesInBulk", "cannot read the entries %lld to %lld of branch %s",
+                    first + nread, first + nread + n - 1, branches[i].c_str());
+            return -1;
+         }
+      }
+      nread += n;
+   }
+   return nread;
+}
+
 }//TreeUtils
 }//ROOT
@@ -403,3 +403,81 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<Bool_t *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, kTRUE);
 }
+
+// Entry offsets stored in a separate record must be readable without loading the basket
+// and must agree with the offsets of the decompressed basket.
+TEST(TBasket, TestSeparateOffsetMap)
+{
+   TMemFile *f = new TMemFile("tbasket_test.root", "CREATE");
+   ASSERT_NE(f, nullptr);
+   ASSERT_FALSE(f->IsZombie());
+
+   TTree t1("t1", "Simple tree for testing the separate entry offset record.");
+   ASSERT_FALSE(t1.IsZombie());
+   ROOT::TIOFeatures settings;
+   ASSERT_TRUE(settings.Set(ROOT::Experimental::EIOFeatures::kSeparateOffsetMap));
+   ASSERT_TRUE(settings.Test(ROOT::Experimental::EIOFeatures::kSeparateOffsetMap));
+   t1.SetIOFeatures(settings);
+
+   Int_t idx, idx2;
+   Int_t sample[10];
+   Int_t elem;
+   t1.Branch("elem", &elem, "elem/I");
+   t1.Branch("sample", &sample, "sample[elem]/I");
+   for (idx = 0; idx < gSampleEvents; idx++) {
+      for (idx2 = 0; idx2 < 10; idx2++) {
+         sample[idx2] = idx + idx2;
+      }
+      elem = idx % 9;
+      t1.Fill();
+   }
+   t1.Write();
+   f->Close();
+   std::vector<char> memBuffer;
+   Long64_t maxsize = f->GetSize();
+   memBuffer.reserve(maxsize);
+   f->CopyTo(&memBuffer[0], maxsize);
+   delete f;
+
+   TMemFile f2("tbasket_test.root", &memBuffer[0], maxsize, "READ");
+   TTree *saved_t1 = nullptr;
+   f2.GetObject("t1", saved_t1);
+   ASSERT_NE(saved_t1, nullptr);
+   TBranch *br = saved_t1->GetBranch("sample");
+   ASSERT_NE(br, nullptr);
+
+   // Read the offsets before the basket is loaded.
+   std::vector<Int_t> offsets;
+   ASSERT_EQ(br->GetBasketEntryOffsets(0, offsets), gSampleEvents);
+   ASSERT_EQ(offsets.size(), static_cast<size_t>(gSampleEvents));
+
+   TBasket *basket = br->GetBasket(0);
+   ASSERT_NE(basket, nullptr);
+   EXPECT_NE(basket->GetSeekOffsetMap(), 0);
+   Int_t *entryOffset = basket->GetEntryOffset();
+   ASSERT_NE(entryOffset, nullptr);
+   for (idx = 0; idx < gSampleEvents; idx++) {
+      EXPECT_EQ(offsets[idx], entryOffset[idx]);
+      if (idx) {
+         // Each entry holds the count-sized array of Int_t.
+         EXPECT_EQ(offsets[idx] - offsets[idx - 1], static_cast<Int_t>(((idx - 1) % 9) * sizeof(Int_t)));
+      }
+   }
+
+   // The offsets of an in-memory basket are served directly.
+   std::vector<Int_t> offsets2;
+   ASSERT_EQ(br->GetBasketEntryOffsets(0, offsets2), gSampleEvents);
+   EXPECT_EQ(offsets, offsets2);
+
+   Int_t saved_sample[10];
+   Int_t saved_elem;
+   saved_t1->SetBranchAddress("sample", &saved_sample);
+   saved_t1->SetBranchAddress("elem", &saved_elem);
+   for (idx = 0; idx < saved_t1->GetEntries(); idx++) {
+      saved_t1->GetEntry(idx);
+      EXPECT_EQ(idx % 9, saved_elem);
+      for (idx2 = 0; idx2 < saved_elem; idx2++) {
+         EXPECT_EQ(saved_sample[idx2], idx + idx2);
+      }
+   }
+}
@@ -1,3 +1,5 @@
+#include "Compression.h"
+#include "TBufferFile.h"
 #include "TFile.h"
 #include "TTree.h"
 #include "TBranch.h"
@@ -5,6 +7,8 @@
 
 #include "gtest/gtest.h"
 
+#include <vector>
+
 class TBranchTest : public ::testing::Test {
 protected:
    virtual void SetUp()
@@ -153,3 +157,139 @@ TEST_F(TBranchTest, twoPreviousTest)
    ASSERT_TRUE(branch->GetListOfBaskets()->At(7));
    delete file;
 }
+
+TEST_F(TBranchTest, bulkReadTest)
+{
+   TFile *file = new TFile("TBranchTestTree.root");
+   TTree *tree = (TTree *)file->Get("tree");
+   TBranch *branch = tree->GetBranch("branch");
+   ASSERT_EQ(Int_t(sizeof(Float_t)), branch->GetBulkEntrySize());
+
+   // Reference values, read entry by entry.
+   Float_t data = 0;
+   tree->SetBranchAddress("branch", &data);
+   std::vector<Float_t> expected;
+   for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry) {
+      tree->GetEntry(entry);
+      expected.push_back(data);
+   }
+
+   // One basket at a time.
+   TBufferFile buf(TBuffer::kWrite, 1);
+   Long64_t entry = 0;
+   while (entry < tree->GetEntries()) {
+      Int_t n = branch->GetBulkEntries(entry, buf);
+      ASSERT_GT(n, 0);
+      const Float_t *values = reinterpret_cast<Float_t *>(buf.Buffer());
+      for (Int_t i = 0; i < n; ++i) {
+         EXPECT_FLOAT_EQ(expected[entry + i], values[i]);
+      }
+      entry += n;
+   }
+   EXPECT_EQ(0, branch->GetBulkEntries(entry, buf));
+
+   // An entry range spanning several baskets.
+   std::vector<Float_t> values(expected.size());
+   EXPECT_EQ(Long64_t(expected.size() - 5), branch->GetBulkEntries(5, expected.size(), values.data()));
+   for (size_t i = 5; i < expected.size(); ++i) {
+      EXPECT_FLOAT_EQ(expected[i], values[i - 5]);
+   }
+   delete file;
+}
+
+TEST(TBranch, CompressionDictionary)
+{
+   struct Record {
+      Int_t fA;
+      Int_t fB;
+      Double_t fC;
+   } record;
+   const Int_t kEntries = 20000;
+   {
+      TFile file("TBranchDictTree.root", "RECREATE", "", ROOT::CompressionSettings(ROOT::kZSTD, 5));
+      TTree tree("tree", "A tree with small baskets");
+      TBranch *branch = tree.Branch("record", &record, "a/I:b/I:c/D", 1000);
+      branch->EnableCompressionDictionary(4096, 100000);
+      for (Int_t i = 0; i < kEntries; ++i) {
+         record.fA = i % 7;
+         record.fB = 1000 + i % 13;
+         record.fC = 0.25 * (i % 100);
+         tree.Fill();
+      }
+      EXPECT_GT(branch->GetCompressionDictionarySize(), 0);
+      tree.Write();
+   }
+
+   TFile file("TBranchDictTree.root");
+   TTree *tree = nullptr;
+   file.GetObject("tree", tree);
+   ASSERT_TRUE(tree != nullptr);
+   TBranch *branch = tree->GetBranch("record");
+   EXPECT_GT(branch->GetCompressionDictionarySize(), 0);
+   tree->SetBranchAddress("record", &record);
+   ASSERT_EQ(kEntries, tree->GetEntries());
+   for (Int_t i = 0; i < kEntries; ++i) {
+      ASSERT_GT(tree->GetEntry(i), 0);
+      EXPECT_EQ(i % 7, record.fA);
+      EXPECT_EQ(1000 + i % 13, record.fB);
+      EXPECT_DOUBLE_EQ(0.25 * (i % 100), record.fC);
+   }
+}
+
+TEST(TBranch, LazyBasketArrays)
+{
+   const Int_t kEntries = 1000;
+   Int_t a = 0;
+   Double_t b = 0;
+   std::vector<Long64_t> seeks, entries;
+   std::vector<Int_t> bytes;
+   {
+      TFile file("TBranchLazyTree.root", "RECREATE");
+      TTree tree("tree", "A tree with many baskets");
+      tree.Branch("a", &a, "a/I", 1000);
+      TBranch *branch = tree.Branch("b", &b, "b/D", 1000);
+      for (Int_t i = 0; i < kEntries; ++i) {
+         a = i;
+         b = 0.5 * i;
+         tree.Fill();
+      }
+      tree.Write();
+      for (Int_t i = 0; i < branch->GetWriteBasket(); ++i) {
+         seeks.push_back(branch->GetBasketSeek(i));
+         entries.push_back(branch->GetBasketEntry()[i]);
+         bytes.push_back(branch->GetBasketBytes()[i]);
+      }
+   }
+   ASSERT_GT(seeks.size(), 1u);
+
+   TFile file("TBranchLazyTree.root");
+   TTree *tree = nullptr;
+   file.GetObject("tree", tree);
+   ASSERT_TRUE(tree != nullptr);
+
+   // The arrays decoded at their first use are the ones written.
+   TBranch *branch = tree->GetBranch("b");
+   ASSERT_EQ(Int_t(seeks.size()), branch->GetWriteBasket());
+   for (size_t i = 0; i < seeks.size(); ++i) {
+      EXPECT_EQ(entries[i], branch->GetBasketEntry()[i]);
+      EXPECT_EQ(bytes[i], branch->GetBasketBytes()[i]);
+      EXPECT_EQ(seeks[i], branch->GetBasketSeek(i));
+   }
+
+   // Reading a branch decodes its arrays on the way.
+   tree->SetBranchAddress("a", &a);
+   for (Int_t i = 0; i < kEntries; ++i) {
+      ASSERT_GT(tree->GetBranch("a")->GetEntry(i), 0);
+      EXPECT_EQ(i, a);
+   }
+
+   // A fast clone finds the baskets through the decoded arrays.
+   TFile copy("TBranchLazyTreeCopy.root", "RECREATE");
+   TTree *clone = tree->CloneTree(-1, "fast");
+   ASSERT_TRUE(clone != nullptr);
+   clone->SetBranchAddress("b", &b);
+   for (Int_t i = 0; i < kEntries; ++i) {
+      ASSERT_GT(clone->GetEntry(i), 0);
+      EXPECT_DOUBLE_EQ(0.5 * i, b);
+   }
+}
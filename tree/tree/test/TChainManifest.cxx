@@ -0,0 +1,61 @@
+#include "TChain.h"
+#include "TChainElement.h"
+#include "TFile.h"
+#include "TFileCollection.h"
+#include "TFileInfo.h"
+#include "THashList.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+static void MakeFile(const char *filename, Int_t nentries)
+{
+   TFile file(filename, "RECREATE");
+   TTree tree("T", "T");
+   tree.SetAutoFlush(100);
+   Int_t x;
+   tree.Branch("x", &x, "x/I");
+   for (x = 0; x < nentries; ++x)
+      tree.Fill();
+   tree.Write();
+}
+
+TEST(TChain, Manifest)
+{
+   MakeFile("chainmanifest_0.root", 250);
+   MakeFile("chainmanifest_1.root", 420);
+   TChain chain("T");
+   chain.Add("chainmanifest_0.root");
+   chain.Add("chainmanifest_1.root");
+   std::unique_ptr<TFileCollection> fc(chain.MakeManifest());
+   ASSERT_NE(fc, nullptr);
+   EXPECT_EQ(fc->GetNFiles(), 2);
+   auto meta = static_cast<TFileInfo *>(fc->GetList()->At(1))->GetMetaData("/T");
+   ASSERT_NE(meta, nullptr);
+   EXPECT_EQ(meta->GetEntries(), 420);
+   EXPECT_EQ(meta->GetClusterStarts(), (std::vector<Long64_t>{0, 100, 200, 300, 400}));
+
+   // The chain built from the manifest knows its entries from the start.
+   TChain fromManifest("T");
+   fromManifest.AddFileInfoList(fc->GetList());
+   EXPECT_EQ(fromManifest.GetTreeOffset()[2], 670);
+   auto element = static_cast<TChainElement *>(fromManifest.GetListOfFiles()->At(0));
+   EXPECT_EQ(element->GetClusterStarts(), (std::vector<Long64_t>{0, 100, 200}));
+   Int_t x = -1;
+   fromManifest.SetBranchAddress("x", &x);
+   fromManifest.GetEntry(300);
+   EXPECT_EQ(x, 50);
+
+   // A file which changed since the manifest was made is opened again.
+   static_cast<TFileInfo *>(fc->GetList()->At(0))->SetSize(1);
+   TChain changed("T");
+   changed.AddFileInfoList(fc->GetList());
+   EXPECT_EQ(static_cast<TChainElement *>(changed.GetListOfFiles()->At(0))->GetEntries(), TTree::kMaxEntries);
+   EXPECT_EQ(changed.GetEntries(), 670);
+
+   gSystem->Unlink("chainmanifest_0.root");
+   gSystem->Unlink("chainmanifest_1.root");
+}
@@ -0,0 +1,80 @@
+#include "TChain.h"
+#include "TFile.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+static const Int_t kNFiles = 6;
+
+static TString FileName(Int_t i)
+{
+   return TString::Format("chainprefetch_%d.root", i);
+}
+
+static void MakeFiles()
+{
+   for (Int_t i = 0; i < kNFiles; ++i) {
+      TFile file(FileName(i), "RECREATE");
+      TTree tree("T", "T");
+      Int_t x;
+      tree.Branch("x", &x, "x/I");
+      for (x = 0; x < 100 * (i + 1); ++x)
+         tree.Fill();
+      tree.Write();
+   }
+}
+
+static void RemoveFiles()
+{
+   for (Int_t i = 0; i < kNFiles; ++i)
+      gSystem->Unlink(FileName(i));
+}
+
+TEST(TChain, PrefetchEntries)
+{
+   MakeFiles();
+   for (Bool_t keepopen : {kFALSE, kTRUE}) {
+      TChain chain("T");
+      for (Int_t i = 0; i < kNFiles; ++i)
+         chain.Add(FileName(i));
+      EXPECT_EQ(chain.PrefetchEntries(4, keepopen), 2100);
+      EXPECT_EQ(chain.GetEntries(), 2100);
+      EXPECT_EQ(chain.GetTreeOffset()[3], 600);
+
+      Int_t x = -1;
+      chain.SetBranchAddress("x", &x);
+      chain.GetEntry(650);
+      EXPECT_EQ(chain.GetTreeNumber(), 3);
+      EXPECT_EQ(x, 50);
+      chain.GetEntry(2099);
+      EXPECT_EQ(x, 599);
+   }
+
+   // files added after the prefetching are loaded past the files kept open
+   {
+      TChain chain("T");
+      for (Int_t i = 0; i < kNFiles / 2; ++i)
+         chain.Add(FileName(i));
+      EXPECT_EQ(chain.PrefetchEntries(2, kTRUE), 600);
+      for (Int_t i = kNFiles / 2; i < kNFiles; ++i)
+         chain.Add(FileName(i));
+      EXPECT_EQ(chain.GetEntries(), 2100);
+      Int_t x = -1;
+      chain.SetBranchAddress("x", &x);
+      chain.GetEntry(2099);
+      EXPECT_EQ(chain.GetTreeNumber(), kNFiles - 1);
+      EXPECT_EQ(x, 599);
+   }
+
+   TChain chain("T");
+   for (Int_t i = 0; i < kNFiles; ++i)
+      chain.Add(FileName(i));
+   chain.Add("chainprefetch_missing.root");
+   chain.SetParallelOpen(3);
+   EXPECT_EQ(chain.PrefetchEntries(3), -1);
+   EXPECT_EQ(chain.GetTreeOffset()[kNFiles], 2100);
+
+   RemoveFiles();
+}
@@ -0,0 +1,87 @@
+#include "TEntryList.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+// Entry numbers spanning several blocks, with dense, sparse and almost full regions
+// so that blocks end up in all the storage representations.
+static std::set<Long64_t> MakeEntries(Long64_t n, Int_t step, Int_t phase)
+{
+   std::set<Long64_t> entries;
+   for (Long64_t i = 0; i < n; ++i) {
+      Long64_t block = i / 64000;
+      if ((block % 3 == 0 && (i + phase) % step == 0) || (block % 3 == 1 && (i + phase) % (100 * step) == 0) ||
+          (block % 3 == 2 && (i + phase) % (50 * step) != 0))
+         entries.insert(i);
+   }
+   return entries;
+}
+
+static void FillList(TEntryList &elist, const std::set<Long64_t> &entries)
+{
+   for (auto entry : entries)
+      elist.Enter(entry);
+   elist.OptimizeStorage();
+}
+
+static void ExpectEqual(TEntryList &elist, const std::set<Long64_t> &entries)
+{
+   ASSERT_EQ(elist.GetN(), (Long64_t)entries.size());
+   Long64_t index = 0;
+   for (auto entry : entries) {
+      EXPECT_EQ(elist.GetEntry(index), entry);
+      ++index;
+   }
+   // Random access into the middle of the list
+   if (!entries.empty()) {
+      auto middle = std::next(entries.begin(), entries.size() / 2);
+      EXPECT_EQ(elist.GetEntry(entries.size() / 2), *middle);
+   }
+}
+
+TEST(TEntryList, SetOperations)
+{
+   const Long64_t n = 6 * 64000 + 123;
+   auto entries1 = MakeEntries(n, 3, 0);
+   auto entries2 = MakeEntries(n - 64000, 2, 1);
+
+   std::set<Long64_t> sum, difference, intersection;
+   std::set_union(entries1.begin(), entries1.end(), entries2.begin(), entries2.end(), std::inserter(sum, sum.end()));
+   std::set_difference(entries1.begin(), entries1.end(), entries2.begin(), entries2.end(),
+                       std::inserter(difference, difference.end()));
+   std::set_intersection(entries1.begin(), entries1.end(), entries2.begin(), entries2.end(),
+                         std::inserter(intersection, intersection.end()));
+
+   TEntryList list1, list2;
+   FillList(list1, entries1);
+   FillList(list2, entries2);
+
+   TEntryList added(list1);
+   added.Add(&list2);
+   ExpectEqual(added, sum);
+
+   TEntryList subtracted(list1);
+   subtracted.Subtract(&list2);
+   ExpectEqual(subtracted, difference);
+
+   TEntryList intersected(list1);
+   intersected.Intersect(&list2);
+   ExpectEqual(intersected, intersection);
+}
+
+TEST(TEntryList, NInRange)
+{
+   const Long64_t n = 4 * 64000;
+   auto entries = MakeEntries(n, 7, 3);
+   TEntryList elist;
+   FillList(elist, entries);
+
+   const Long64_t ranges[][2] = {{0, n}, {10, 20}, {63990, 64010}, {64000, 3 * 64000}, {100000, 250000}, {n, 2 * n}};
+   for (auto &range : ranges) {
+      Long64_t expected = std::distance(entries.lower_bound(range[0]), entries.lower_bound(range[1]));
+      EXPECT_EQ(elist.GetNInRange(range[0], range[1]), expected);
+   }
+}
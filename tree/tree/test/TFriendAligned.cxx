@@ -0,0 +1,73 @@
+#include "TFile.h"
+#include "TFriendElement.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+static void MakeFiles()
+{
+   TFile mainFile("friendaligned_main.root", "RECREATE");
+   TTree tree("T", "T");
+   tree.SetAutoFlush(1000);
+   Int_t run, event;
+   tree.Branch("run", &run, "run/I");
+   tree.Branch("event", &event, "event/I");
+   for (Int_t e = 0; e < 10000; ++e) {
+      run = e / 1000;
+      event = e % 1000;
+      tree.Fill();
+   }
+   tree.Write();
+
+   TFile friendFile("friendaligned_friend.root", "RECREATE");
+   TTree ftree("F", "F");
+   ftree.SetAutoFlush(700); // clusters not aligned with the ones of the main tree
+   Int_t frun, fevent;
+   Double_t x;
+   ftree.Branch("run", &frun, "run/I");
+   ftree.Branch("event", &fevent, "event/I");
+   ftree.Branch("x", &x, "x/D");
+   for (Int_t e = 0; e < 10000; ++e) {
+      frun = e / 1000;
+      fevent = e % 1000;
+      x = 0.5 * e;
+      ftree.Fill();
+   }
+   ftree.Write();
+}
+
+static void ReadFriend(Bool_t aligned, Bool_t index)
+{
+   TFile mainFile("friendaligned_main.root");
+   TTree *tree = nullptr;
+   mainFile.GetObject("T", tree);
+   ASSERT_NE(tree, nullptr);
+   TFriendElement *fe = tree->AddFriend("F", "friendaligned_friend.root");
+   ASSERT_NE(fe, nullptr);
+   fe->SetAligned(aligned);
+   if (index)
+      fe->GetTree()->BuildIndex("run", "event");
+   Int_t event = -1;
+   Double_t x = -1;
+   tree->SetBranchAddress("event", &event);
+   tree->SetBranchAddress("F.x", &x);
+   for (Long64_t e = 0; e < tree->GetEntries(); ++e) {
+      tree->GetEntry(e);
+      ASSERT_EQ(event, e % 1000);
+      ASSERT_EQ(x, 0.5 * e) << "entry " << e;
+   }
+}
+
+TEST(TFriendElement, Aligned)
+{
+   MakeFiles();
+   ReadFriend(kFALSE, kFALSE);
+   ReadFriend(kTRUE, kFALSE);
+   // aligned friends do not use their index
+   ReadFriend(kTRUE, kTRUE);
+   // sequential lookups in the index
+   ReadFriend(kFALSE, kTRUE);
+   gSystem->Unlink("friendaligned_main.root");
+   gSystem->Unlink("friendaligned_friend.root");
+}
@@ -0,0 +1,60 @@
+#include "TFile.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#ifdef R__USE_IMT
+
+// Write a tree with baskets handed over to IMT tasks and check it reads back identically.
+TEST(TTreeAsyncFlush, WriteAndRead)
+{
+   ROOT::EnableImplicitMT(4);
+   {
+      TFile file("TTreeAsyncFlush.root", "RECREATE");
+      TTree tree("tree", "A tree flushed asynchronously");
+      tree.SetAutoFlush(1000);
+      tree.SetIMTAsyncFlush(4);
+      EXPECT_EQ(4, tree.GetIMTAsyncFlush());
+      Int_t i = 0;
+      Float_t f = 0;
+      std::vector<Double_t> v;
+      tree.Branch("i", &i);
+      tree.Branch("f", &f);
+      tree.Branch("v", &v);
+      for (i = 0; i < 20000; ++i) {
+         f = i / 2.f;
+         v.assign(i % 7, i);
+         ASSERT_GE(tree.Fill(), 0);
+      }
+      tree.Write();
+      EXPECT_EQ(0, tree.FlushAsyncBaskets());
+   }
+   ROOT::DisableImplicitMT();
+
+   TFile file("TTreeAsyncFlush.root");
+   auto tree = static_cast<TTree *>(file.Get("tree"));
+   ASSERT_NE(nullptr, tree);
+   EXPECT_EQ(20000, tree->GetEntries());
+   Int_t i = -1;
+   Float_t f = -1;
+   std::vector<Double_t> *v = nullptr;
+   tree->SetBranchAddress("i", &i);
+   tree->SetBranchAddress("f", &f);
+   tree->SetBranchAddress("v", &v);
+   for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry) {
+      ASSERT_GT(tree->GetEntry(entry), 0);
+      EXPECT_EQ(entry, i);
+      EXPECT_FLOAT_EQ(entry / 2.f, f);
+      ASSERT_EQ(static_cast<size_t>(entry % 7), v->size());
+   }
+
+   // Clusters must still end at the auto-flush boundaries.
+   auto clusters = tree->GetClusterIterator(0);
+   clusters.Next();
+   EXPECT_EQ(1000, clusters.GetNextEntry());
+}
+
+#endif // R__USE_IMT
@@ -0,0 +1,77 @@
+#include "TMemFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+
+#include "gtest/gtest.h"
+
+static void FillClusters(TTree &tree, Int_t &n, Float_t *values, Int_t nclusters, Int_t size)
+{
+   for (Int_t i = 0; i < 1000 * nclusters; ++i) {
+      n = size;
+      for (Int_t j = 0; j < size; ++j)
+         values[j] = i + j;
+      tree.Fill();
+   }
+}
+
+TEST(TTreeBasketSizes, FollowOccupancy)
+{
+   TMemFile file("adaptivebaskets.root", "RECREATE");
+   TTree tree("tree", "A tree whose occupancy grows");
+   Int_t n = 0;
+   Float_t values[100];
+   tree.Branch("n", &n, "n/I");
+   TBranch *branch = tree.Branch("values", values, "values[n]/F");
+   tree.SetAutoFlush(1000);
+   tree.SetAdaptiveBasketSizes(100 * 1024 * 1024);
+
+   // One value per entry: the 1000 entries of a cluster hold ~4kB plus the entry offsets.
+   FillClusters(tree, n, values, 3, 1);
+   Int_t small = branch->GetBasketSize();
+   EXPECT_LT(small, 32000);
+   EXPECT_GT(small, 4000);
+
+   // A hundred values per entry, the baskets must follow.
+   FillClusters(tree, n, values, 3, 100);
+   Int_t large = branch->GetBasketSize();
+   EXPECT_GT(large, 300000);
+   EXPECT_EQ(6000, tree.GetEntries());
+}
+
+TEST(TTreeBasketSizes, MemoryBudget)
+{
+   TMemFile file("adaptivebudget.root", "RECREATE");
+   TTree tree("tree", "A tree with a tight budget");
+   Int_t n = 0;
+   Float_t values[100];
+   tree.Branch("n", &n, "n/I");
+   TBranch *branch = tree.Branch("values", values, "values[n]/F");
+   tree.SetAutoFlush(1000);
+   tree.SetAdaptiveBasketSizes(100000, 2);
+
+   FillClusters(tree, n, values, 3, 100);
+   EXPECT_LE(branch->GetBasketSize(), 100000 + 512);
+   EXPECT_EQ(3000, tree.GetEntries());
+}
+
+TEST(TTreeBasketSizes, LeafList)
+{
+   TMemFile file("adaptiveleaflist.root", "RECREATE");
+   TTree tree("tree", "A tree with a leaflist branch");
+   Float_t values[30];
+   TString leaflist;
+   for (Int_t j = 0; j < 30; ++j)
+      leaflist += TString::Format("%sv%d/F", j ? ":" : "", j);
+   TBranch *branch = tree.Branch("values", values, leaflist);
+   tree.SetAutoFlush(1000);
+   tree.SetAdaptiveBasketSizes(300000, 1);
+
+   // The branch needs ~128kB per cluster and is counted once in the budget, not once per leaf.
+   for (Int_t i = 0; i < 3000; ++i) {
+      for (Int_t j = 0; j < 30; ++j)
+         values[j] = i * 30 + j;
+      tree.Fill();
+   }
+   EXPECT_GT(branch->GetBasketSize(), 100000);
+   EXPECT_EQ(3000, tree.GetEntries());
+}
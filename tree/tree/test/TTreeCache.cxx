@@ -0,0 +1,96 @@
+#include "TFile.h"
+#include "TROOT.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+#include "TTreeCacheUnzip.h"
+
+#include "gtest/gtest.h"
+
+// Reading with a cluster lookahead must not change what is read.
+TEST(TTreeCache, ClusterLookahead)
+{
+   {
+      TFile file("TTreeCacheLookahead.root", "RECREATE");
+      TTree tree("tree", "A tree with many clusters");
+      tree.SetAutoFlush(500);
+      Int_t i = 0;
+      Double_t d = 0;
+      tree.Branch("i", &i);
+      tree.Branch("d", &d);
+      for (i = 0; i < 10000; ++i) {
+         d = 0.5 * i;
+         tree.Fill();
+      }
+      tree.Write();
+   }
+
+   TFile file("TTreeCacheLookahead.root");
+   auto tree = static_cast<TTree *>(file.Get("tree"));
+   ASSERT_NE(nullptr, tree);
+   tree->SetCacheSize(10000);
+   auto cache = dynamic_cast<TTreeCache *>(file.GetCacheRead(tree));
+   ASSERT_NE(nullptr, cache);
+   cache->SetClusterLookahead(3);
+   EXPECT_EQ(3, cache->GetClusterLookahead());
+
+   Int_t i = -1;
+   Double_t d = -1;
+   tree->SetBranchAddress("i", &i);
+   tree->SetBranchAddress("d", &d);
+   for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry) {
+      tree->GetEntry(entry);
+      ASSERT_EQ(entry, i);
+      ASSERT_EQ(0.5 * entry, d);
+   }
+   // Jumping backward restarts the lookahead from the new position.
+   tree->GetEntry(1234);
+   EXPECT_EQ(1234, i);
+
+   cache->SetClusterLookahead(0);
+   EXPECT_EQ(0, cache->GetClusterLookahead());
+}
+
+#ifdef R__USE_IMT
+// Baskets unzipped ahead of the reader by IMT tasks, within a small byte budget.
+TEST(TTreeCacheUnzip, IMTUnzipWithBudget)
+{
+   {
+      TFile file("TTreeCacheUnzip.root", "RECREATE");
+      TTree tree("tree", "A compressed tree");
+      tree.SetAutoFlush(2000);
+      Int_t i = 0;
+      Double_t d = 0;
+      tree.Branch("i", &i, 1000);
+      tree.Branch("d", &d, 1000);
+      for (i = 0; i < 20000; ++i) {
+         d = i % 13;
+         tree.Fill();
+      }
+      tree.Write();
+   }
+
+   ROOT::EnableImplicitMT(2);
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   {
+      TFile file("TTreeCacheUnzip.root");
+      auto tree = static_cast<TTree *>(file.Get("tree"));
+      ASSERT_NE(nullptr, tree);
+      tree->SetCacheSize(1000000);
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(file.GetCacheRead(tree));
+      ASSERT_NE(nullptr, cache);
+      cache->SetUnzipBufferSize(20000);
+
+      Int_t i = -1;
+      Double_t d = -1;
+      tree->SetBranchAddress("i", &i);
+      tree->SetBranchAddress("d", &d);
+      for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry) {
+         tree->GetEntry(entry);
+         ASSERT_EQ(entry, i);
+         ASSERT_EQ(entry % 13, d);
+      }
+   }
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -0,0 +1,116 @@
+#include "TFile.h"
+#include "TROOT.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCloner.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+static void MakeFile(const char *filename, Int_t offset)
+{
+   TFile file(filename, "RECREATE");
+   TTree tree("T", "T");
+   tree.SetAutoFlush(1000);
+   Int_t i;
+   Double_t x[10];
+   tree.Branch("i", &i, "i/I");
+   tree.Branch("x", x, "x[10]/D");
+   for (Int_t e = 0; e < 20000; ++e) {
+      i = e + offset;
+      for (Int_t k = 0; k < 10; ++k)
+         x[k] = i * 0.5 + k;
+      tree.Fill();
+   }
+   tree.Write();
+}
+
+static void CheckTree(TTree *tree, Int_t nfiles, Int_t offsetStep)
+{
+   ASSERT_NE(nullptr, tree);
+   ASSERT_EQ(20000 * nfiles, tree->GetEntries());
+   Int_t i;
+   Double_t x[10];
+   tree->SetBranchAddress("i", &i);
+   tree->SetBranchAddress("x", x);
+   for (Long64_t e = 0; e < tree->GetEntries(); e += 997) {
+      tree->GetEntry(e);
+      const Int_t expected = (e / 20000) * offsetStep + (e % 20000);
+      ASSERT_EQ(expected, i) << "entry " << e;
+      ASSERT_EQ(expected * 0.5 + 9, x[9]) << "entry " << e;
+   }
+   tree->ResetBranchAddresses();
+}
+
+static void CopyAndCheck()
+{
+   {
+      TFile out("treecloner_out.root", "RECREATE");
+      TTree *outTree = nullptr;
+      for (auto name : {"treecloner_in0.root", "treecloner_in1.root"}) {
+         TFile in(name);
+         TTree *inTree = (TTree *)in.Get("T");
+         out.cd();
+         if (!outTree)
+            outTree = inTree->CloneTree(0);
+         ASSERT_GT(outTree->CopyEntries(inTree, -1, "fast"), 0);
+      }
+      out.Write();
+   }
+   TFile out("treecloner_out.root");
+   CheckTree((TTree *)out.Get("T"), 2, 100000);
+}
+
+// The fast cloning gives the same tree whether the baskets are written by a separate thread or not.
+TEST(TTreeCloner, FastCopyEntries)
+{
+   MakeFile("treecloner_in0.root", 0);
+   MakeFile("treecloner_in1.root", 100000);
+   CopyAndCheck();
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(2);
+   CopyAndCheck();
+   ROOT::DisableImplicitMT();
+#endif
+   gSystem->Unlink("treecloner_in0.root");
+   gSystem->Unlink("treecloner_in1.root");
+   gSystem->Unlink("treecloner_out.root");
+}
+
+// Several trees are cloned at once into separate files.
+TEST(TTreeCloner, CopyTrees)
+{
+   const Int_t kNTrees = 3;
+   std::vector<std::unique_ptr<TFile>> inputs, outputs;
+   std::vector<std::pair<TTree *, TTree *>> trees;
+   for (Int_t t = 0; t < kNTrees; ++t) {
+      TString inName = TString::Format("treecloner_copy_in%d.root", t);
+      MakeFile(inName, 0);
+      inputs.emplace_back(new TFile(inName));
+      outputs.emplace_back(new TFile(TString::Format("treecloner_copy_out%d.root", t), "RECREATE"));
+      TTree *in = (TTree *)inputs.back()->Get("T");
+      outputs.back()->cd();
+      trees.emplace_back(in, in->CloneTree(0));
+   }
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(kNTrees);
+#endif
+   EXPECT_EQ(kNTrees, TTreeCloner::CopyTrees(trees));
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+   for (Int_t t = 0; t < kNTrees; ++t) {
+      CheckTree(trees[t].second, 1, 0);
+      outputs[t]->Write();
+   }
+   outputs.clear();
+   inputs.clear();
+   for (Int_t t = 0; t < kNTrees; ++t) {
+      gSystem->Unlink(TString::Format("treecloner_copy_in%d.root", t));
+      gSystem->Unlink(TString::Format("treecloner_copy_out%d.root", t));
+   }
+}
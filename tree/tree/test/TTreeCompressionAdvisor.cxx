@@ -0,0 +1,75 @@
+#include "TMemFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TRandom3.h"
+#include "TTreeCompressionAdvisor.h"
+#include "Compression.h"
+
+#include "gtest/gtest.h"
+
+static void FillTree(TTree &tree)
+{
+   Int_t counter = 0;
+   Double_t noise = 0;
+   tree.Branch("counter", &counter, "counter/I");
+   tree.Branch("noise", &noise, "noise/D");
+   tree.SetAutoFlush(1000);
+   TRandom3 rng(1);
+   for (Int_t i = 0; i < 5000; ++i) {
+      counter = i / 100;
+      noise = rng.Gaus();
+      tree.Fill();
+   }
+   tree.FlushBaskets();
+}
+
+TEST(TTreeCompressionAdvisor, Measure)
+{
+   TMemFile file("advisor.root", "RECREATE");
+   TTree tree("tree", "A tree with a compressible and an incompressible branch");
+   FillTree(tree);
+
+   TTreeCompressionAdvisor advisor(&tree, TTreeCompressionAdvisor::kSize, 2);
+   advisor.SetCandidates({ROOT::CompressionSettings(ROOT::kZLIB, 1), ROOT::CompressionSettings(ROOT::kLZMA, 9)});
+   EXPECT_EQ(2, advisor.Measure());
+
+   for (auto &advice : advisor.GetAdvice()) {
+      EXPECT_EQ(2, advice.fNBaskets);
+      EXPECT_GT(advice.fSampledBytes, 0);
+      ASSERT_EQ(2u, advice.fMeasurements.size());
+      for (auto &m : advice.fMeasurements) {
+         EXPECT_GT(m.fCompressedBytes, 0);
+         EXPECT_LE(m.fCompressedBytes, advice.fSampledBytes);
+      }
+   }
+   // The slowly increasing counter compresses much better than the random values.
+   auto &counter = advisor.GetAdvice()[0];
+   auto &noise = advisor.GetAdvice()[1];
+   EXPECT_EQ("counter", counter.fName);
+   EXPECT_LT(counter.fMeasurements[1].fCompressedBytes * 5, counter.fSampledBytes);
+   EXPECT_GT(noise.fMeasurements[1].fCompressedBytes * 2, noise.fSampledBytes);
+   EXPECT_EQ(ROOT::CompressionSettings(ROOT::kLZMA, 9), advisor.GetRecommendation("counter"));
+   EXPECT_EQ(-1, advisor.GetRecommendation("missing"));
+
+   // Reading through a very slow storage, the size still dominates.
+   advisor.SetObjective(TTreeCompressionAdvisor::kRead);
+   advisor.SetReadBandwidth(1);
+   EXPECT_EQ(ROOT::CompressionSettings(ROOT::kLZMA, 9), advisor.GetRecommendation("counter"));
+}
+
+TEST(TTreeCompressionAdvisor, Apply)
+{
+   TMemFile file("advisorapply.root", "RECREATE");
+   TTree tree("tree", "The measured tree");
+   FillTree(tree);
+
+   TTreeCompressionAdvisor advisor(&tree);
+   advisor.SetCandidates({ROOT::CompressionSettings(ROOT::kLZ4, 4)});
+   EXPECT_EQ(2, advisor.Measure());
+
+   TTree *clone = tree.CloneTree(0);
+   EXPECT_EQ(2, advisor.Apply(clone));
+   EXPECT_EQ(ROOT::CompressionSettings(ROOT::kLZ4, 4), clone->GetBranch("counter")->GetCompressionSettings());
+   EXPECT_EQ(ROOT::CompressionSettings(ROOT::kLZ4, 4), clone->GetBranch("noise")->GetCompressionSettings());
+   delete clone;
+}
@@ -0,0 +1,382 @@
+/// \file ROOT/TColumnStore.hxx
+/// \ingroup Tree ROOT7
+/// \date 2018-03-12
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_TColumnStore
+#define ROOT7_TColumnStore
+
+#include "Compression.h"
+#include "RtypesCore.h"
+
+#include "ROOT/RStringView.hxx"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+
+/** \class ROOT::Experimental::TColumnStoreOptions
+ Options of the writing of a column store.
+ */
+struct TColumnStoreOptions {
+   /// Uncompressed size of the pages, at most 16 MB.
+   UInt_t fPageSize = 64 * 1024;
+   /// The pages start at multiples of fAlignment in the file, and their size is padded to it; 1 packs them.
+   UInt_t fAlignment = 4096;
+   ROOT::ECompressionAlgorithm fCompressionAlgorithm = ROOT::kLZ4;
+   /// Compression level of the pages, 0 to store them as they are.
+   Int_t fCompressionLevel = 1;
+};
+
+namespace Detail {
+
+/// Name of the type of the values of a column, defined for the arithmetic types that can be stored.
+template <typename T>
+struct TColumnElementTraits {
+   static_assert(sizeof(T) == 0, "Only columns of arithmetic types and of vectors of them are supported");
+};
+
+#define R__COLUMN_ELEMENT_TRAITS(TYPE, NAME)                   \
+   template <>                                                 \
+   struct TColumnElementTraits<TYPE> {                         \
+      static const char *GetTypeName() { return NAME; }        \
+   };
+R__COLUMN_ELEMENT_TRAITS(bool, "bool")
+R__COLUMN_ELEMENT_TRAITS(char, "char")
+R__COLUMN_ELEMENT_TRAITS(unsigned char, "unsigned char")
+R__COLUMN_ELEMENT_TRAITS(short, "short")
+R__COLUMN_ELEMENT_TRAITS(unsigned short, "unsigned short")
+R__COLUMN_ELEMENT_TRAITS(int, "int")
+R__COLUMN_ELEMENT_TRAITS(unsigned int, "unsigned int")
+R__COLUMN_ELEMENT_TRAITS(Long64_t, "Long64_t")
+R__COLUMN_ELEMENT_TRAITS(ULong64_t, "ULong64_t")
+R__COLUMN_ELEMENT_TRAITS(float, "float")
+R__COLUMN_ELEMENT_TRAITS(double, "double")
+#undef R__COLUMN_ELEMENT_TRAITS
+
+/// Location of a page in the file.
+struct TPageInfo {
+   ULong64_t fFirstElement = 0; ///< Index of the first element of the page in its column
+   UInt_t fNElements = 0;
+   ULong64_t fOffset = 0;  ///< Position of the page in the file
+   UInt_t fStoredSize = 0; ///< Size of the page in the file, equal to the uncompressed one if not compressed
+};
+
+/// A column as stored: its elements are all of the same type, of fixed size. A collection column holds, for each
+/// entry, the index after its last element in the column of its values, which is the next column.
+struct TColumnDescriptor {
+   enum EKind { kValue = 0, kCollection = 1 };
+   std::string fName;
+   std::string fTypeName; ///< Type of the entries, e.g. "float" or "std::vector<float>"
+   EKind fKind = kValue;
+   UInt_t fElementSize = 0;
+   Int_t fParent = -1; ///< Index of the collection column of a column of values of a collection
+   ULong64_t fNElements = 0;
+   std::vector<TPageInfo> fPages;
+};
+
+class TColumnSink;
+class TColumnSource;
+
+} // namespace Detail
+
+namespace Internal {
+template <typename T>
+struct TColumnMaker;
+} // namespace Internal
+
+template <typename T>
+class TColumnWriter;
+template <typename T>
+class TColumnReader;
+
+/** \class ROOT::Experimental::TColumnStoreWriter
+ Writes a column store: a file holding the values of each column in pages of a single column.
+
+ ~~~ {.cpp}
+ auto writer = ROOT::Experimental::TColumnStoreWriter::Recreate("events.rcs");
+ auto pt = writer->MakeColumn<float>("pt");
+ auto hits = writer->MakeColumn<std::vector<float>>("hits");
+ for (...) {
+    pt.Fill(...);
+    hits.Fill(...);
+ }
+ writer->Close();
+ ~~~
+
+ The file starts with a header of one alignment unit. The pages of fPageSize bytes of the columns follow, each
+ compressed on its own and aligned, so that they can be read with direct I/O. The footer describes the columns and
+ indexes their pages, and the last 24 bytes of the file give its position.
+ */
+class TColumnStoreWriter {
+   TColumnStoreOptions fOptions;
+   std::string fPath;
+   std::ofstream fFile;
+   ULong64_t fFileSize = 0;
+   std::vector<std::unique_ptr<Detail::TColumnDescriptor>> fColumns;
+   std::vector<std::unique_ptr<Detail::TColumnSink>> fSinks;
+   bool fClosed = false;
+
+   TColumnStoreWriter(std::string_view path, const TColumnStoreOptions &options);
+   Detail::TColumnSink &AddColumn(std::string_view name, const std::string &typeName,
+                                  Detail::TColumnDescriptor::EKind kind, UInt_t elementSize, Int_t parent);
+   /// Add the collection column name and the column of its values, return their sinks.
+   std::pair<Detail::TColumnSink *, Detail::TColumnSink *>
+   AddCollection(std::string_view name, const std::string &valueTypeName, UInt_t valueSize);
+   void WriteAligned(const char *data, std::size_t size);
+
+   friend class Detail::TColumnSink;
+   template <typename T>
+   friend struct Internal::TColumnMaker;
+   void CommitPage(Detail::TColumnDescriptor &column, const char *data, UInt_t nElements);
+
+public:
+   static std::unique_ptr<TColumnStoreWriter>
+   Recreate(std::string_view path, const TColumnStoreOptions &options = TColumnStoreOptions());
+   ~TColumnStoreWriter();
+
+   /// Add the column name, of an arithmetic type or of a vector of an arithmetic type.
+   template <typename T>
+   TColumnWriter<T> MakeColumn(std::string_view name);
+
+   /// Number of entries of the column store, which is checked to be the same for all its columns by Close().
+   ULong64_t GetNEntries() const;
+   const TColumnStoreOptions &GetOptions() const { return fOptions; }
+
+   void Close();
+};
+
+/** \class ROOT::Experimental::TColumnStoreReader
+ Reads a column store written by TColumnStoreWriter.
+
+ ~~~ {.cpp}
+ auto reader = ROOT::Experimental::TColumnStoreReader::Open("events.rcs");
+ auto pt = reader->GetColumn<float>("pt");
+ for (ULong64_t i = 0; i < reader->GetNEntries(); ++i)
+    sum += pt(i);
+ ~~~
+
+ The column readers can be used concurrently, each from a single thread: each keeps the page it reads uncompressed,
+ only the reads of the file are serialized.
+ */
+class TColumnStoreReader {
+   std::string fPath;
+   std::ifstream fFile;
+   std::mutex fMutex; ///< Protects fFile
+   ULong64_t fNEntries = 0;
+   std::vector<Detail::TColumnDescriptor> fColumns;
+   std::vector<std::string> fColumnNames; ///< Names of the columns that are not the values of a collection
+
+   TColumnStoreReader(std::string_view path);
+   void ReadFooter();
+   /// Return the descriptor of the column name, checking that its entries are of type typeName.
+   const Detail::TColumnDescriptor &GetDescriptor(std::string_view name, const std::string &typeName) const;
+
+   friend class Detail::TColumnSource;
+   template <typename T>
+   friend struct Internal::TColumnMaker;
+   void ReadPage(const Detail::TColumnDescriptor &column, std::size_t page, std::vector<char> &buffer,
+                 std::vector<char> &compressed);
+
+public:
+   static std::unique_ptr<TColumnStoreReader> Open(std::string_view path);
+
+   ULong64_t GetNEntries() const { return fNEntries; }
+   const std::vector<std::string> &GetColumnNames() const { return fColumnNames; }
+   bool HasColumn(std::string_view name) const;
+   /// Type of the entries of the column name, e.g. "float" or "std::vector<float>".
+   std::string GetTypeName(std::string_view name) const;
+   const Detail::TColumnDescriptor &GetDescriptor(std::string_view name) const;
+   const std::vector<Detail::TColumnDescriptor> &GetDescriptors() const { return fColumns; }
+
+   /// Return a reader of the column name, whose entries must be of type T.
+   template <typename T>
+   TColumnReader<T> GetColumn(std::string_view name);
+};
+
+namespace Detail {
+
+/// Gathers the elements of a column in pages, and gives them to the writer once full.
+class TColumnSink {
+   TColumnStoreWriter &fWriter;
+   TColumnDescriptor &fColumn;
+   std::vector<char> fPage;
+   UInt_t fNElements = 0;    ///< Elements in fPage
+   UInt_t fMaxNElements = 0; ///< Elements of a full page
+
+public:
+   TColumnSink(TColumnStoreWriter &writer, TColumnDescriptor &column);
+   void Append(const void *elements, std::size_t n);
+   void Flush();
+   ULong64_t GetNElements() const { return fColumn.fNElements + fNElements; }
+};
+
+/// Keeps the page of a column holding the last element read, uncompressed.
+class TColumnSource {
+   TColumnStoreReader *fReader = nullptr;
+   const TColumnDescriptor *fColumn = nullptr;
+   std::vector<char> fPage;
+   std::vector<char> fCompressed;
+   ULong64_t fFirst = 0; ///< First element in fPage
+   ULong64_t fEnd = 0;   ///< Element after the last in fPage
+
+   void LoadPage(ULong64_t element);
+
+public:
+   TColumnSource(TColumnStoreReader &reader, const TColumnDescriptor &column) : fReader(&reader), fColumn(&column) {}
+
+   /// Return the address of element, and in n the number of elements contiguous to it.
+   const char *Map(ULong64_t element, ULong64_t &n)
+   {
+      if (element < fFirst || element >= fEnd)
+         LoadPage(element);
+      n = fEnd - element;
+      return fPage.data() + (element - fFirst) * fColumn->fElementSize;
+   }
+   const char *Map(ULong64_t element)
+   {
+      ULong64_t n;
+      return Map(element, n);
+   }
+   void ReadRange(ULong64_t first, ULong64_t n, char *out);
+};
+
+} // namespace Detail
+
+/// Appends the values of a column of type T to a column store.
+template <typename T>
+class TColumnWriter {
+   Detail::TColumnSink *fSink;
+
+public:
+   TColumnWriter(Detail::TColumnSink &sink) : fSink(&sink) {}
+   void Fill(const T &value) { fSink->Append(&value, 1); }
+   void FillN(const T *values, std::size_t n) { fSink->Append(values, n); }
+};
+
+/// Appends the values of a column of vectors to a column store, their sizes to its collection column and their
+/// elements to the column of its values.
+template <typename T>
+class TColumnWriter<std::vector<T>> {
+   Detail::TColumnSink *fOffsets;
+   Detail::TColumnSink *fValues;
+   ULong64_t fNValues = 0;
+
+public:
+   TColumnWriter(Detail::TColumnSink &offsets, Detail::TColumnSink &values) : fOffsets(&offsets), fValues(&values) {}
+   void Fill(const std::vector<T> &value)
+   {
+      fValues->Append(value.data(), value.size());
+      fNValues += value.size();
+      fOffsets->Append(&fNValues, 1);
+   }
+};
+
+/// Reads the values of a column of type T of a column store.
+template <typename T>
+class TColumnReader {
+   Detail::TColumnSource fSource;
+
+public:
+   TColumnReader(TColumnStoreReader &reader, const Detail::TColumnDescriptor &column) : fSource(reader, column) {}
+   const T &operator()(ULong64_t entry) { return *reinterpret_cast<const T *>(fSource.Map(entry)); }
+   /// Return the value of entry, and in n the number of values following it which are contiguous in memory.
+   const T *GetValues(ULong64_t entry, ULong64_t &n) { return reinterpret_cast<const T *>(fSource.Map(entry, n)); }
+   /// Copy the n values from entry first into out.
+   void ReadRange(ULong64_t first, ULong64_t n, T *out) { fSource.ReadRange(first, n, reinterpret_cast<char *>(out)); }
+};
+
+/// Reads the values of a column of vectors of a column store.
+template <typename T>
+class TColumnReader<std::vector<T>> {
+   Detail::TColumnSource fOffsets;
+   Detail::TColumnSource fValues;
+   std::vector<T> fValue;
+
+   ULong64_t GetOffset(ULong64_t entry) { return *reinterpret_cast<const ULong64_t *>(fOffsets.Map(entry)); }
+
+public:
+   TColumnReader(TColumnStoreReader &reader, const Detail::TColumnDescriptor &offsets,
+                 const Detail::TColumnDescriptor &values)
+      : fOffsets(reader, offsets), fValues(reader, values)
+   {
+   }
+   /// Number of elements of the vector of entry.
+   ULong64_t GetSize(ULong64_t entry) { return GetOffset(entry) - (entry ? GetOffset(entry - 1) : 0); }
+   /// Return the vector of entry, valid until the next call.
+   const std::vector<T> &operator()(ULong64_t entry)
+   {
+      const ULong64_t first = entry ? GetOffset(entry - 1) : 0;
+      fValue.resize(GetOffset(entry) - first);
+      fValues.ReadRange(first, fValue.size(), reinterpret_cast<char *>(fValue.data()));
+      return fValue;
+   }
+};
+
+namespace Internal {
+
+/// Creates the writers and readers of the columns of type T.
+template <typename T>
+struct TColumnMaker {
+   static TColumnWriter<T> MakeWriter(TColumnStoreWriter &writer, std::string_view name)
+   {
+      return TColumnWriter<T>(writer.AddColumn(name, Detail::TColumnElementTraits<T>::GetTypeName(),
+                                               Detail::TColumnDescriptor::kValue, sizeof(T), -1));
+   }
+   static TColumnReader<T> MakeReader(TColumnStoreReader &reader, std::string_view name)
+   {
+      return TColumnReader<T>(reader, reader.GetDescriptor(name, Detail::TColumnElementTraits<T>::GetTypeName()));
+   }
+};
+
+template <typename T>
+struct TColumnMaker<std::vector<T>> {
+   static_assert(!std::is_same<T, bool>::value, "std::vector<bool> does not hold its elements contiguously");
+   static TColumnWriter<std::vector<T>> MakeWriter(TColumnStoreWriter &writer, std::string_view name)
+   {
+      auto sinks = writer.AddCollection(name, Detail::TColumnElementTraits<T>::GetTypeName(), sizeof(T));
+      return TColumnWriter<std::vector<T>>(*sinks.first, *sinks.second);
+   }
+   static TColumnReader<std::vector<T>> MakeReader(TColumnStoreReader &reader, std::string_view name)
+   {
+      const std::string typeName = std::string("std::vector<") + Detail::TColumnElementTraits<T>::GetTypeName() + ">";
+      const auto &offsets = reader.GetDescriptor(name, typeName);
+      // the values of a collection are stored right after it
+      return TColumnReader<std::vector<T>>(reader, offsets, *(&offsets + 1));
+   }
+};
+
+} // namespace Internal
+
+template <typename T>
+TColumnWriter<T> TColumnStoreWriter::MakeColumn(std::string_view name)
+{
+   return Internal::TColumnMaker<T>::MakeWriter(*this, name);
+}
+
+template <typename T>
+TColumnReader<T> TColumnStoreReader::GetColumn(std::string_view name)
+{
+   return Internal::TColumnMaker<T>::MakeReader(*this, name);
+}
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
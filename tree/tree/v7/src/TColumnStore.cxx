@@ -0,0 +1,486 @@
+/// \file TColumnStore.cxx
+/// \ingroup Tree ROOT7
+/// \date 2018-03-12
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TColumnStore.hxx"
+
+#include "RConfig.h"
+#include "RZip.h"
+#include "TError.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const char kMagic[8] = {'R', 'O', 'O', 'T', 'C', 'O', 'L', 'S'};
+const UInt_t kVersion = 1;
+const std::size_t kTrailerSize = 24;
+// The ROOT compression routines handle at most 16MB per call, a page is compressed in one.
+const UInt_t kMaxPageSize = 0xffffff;
+
+// The elements are stored little endian.
+void SwapElements(char *data, std::size_t n, UInt_t size)
+{
+#ifndef R__BYTESWAP
+   for (std::size_t i = 0; i < n; ++i)
+      std::reverse(data + i * size, data + (i + 1) * size);
+#else
+   (void)data;
+   (void)n;
+   (void)size;
+#endif
+}
+
+const bool kSwapElements =
+#ifndef R__BYTESWAP
+   true;
+#else
+   false;
+#endif
+
+/// The footer, written little endian whatever the host.
+class TFooterWriter {
+   std::vector<char> fData;
+
+public:
+   void Put(ULong64_t value, int nbytes)
+   {
+      for (int i = 0; i < nbytes; ++i)
+         fData.push_back(char((value >> (8 * i)) & 0xff));
+   }
+   void PutU32(UInt_t value) { Put(value, 4); }
+   void PutU64(ULong64_t value) { Put(value, 8); }
+   void PutString(const std::string &value)
+   {
+      PutU32(value.size());
+      fData.insert(fData.end(), value.begin(), value.end());
+   }
+   const std::vector<char> &GetData() const { return fData; }
+};
+
+class TFooterReader {
+   const std::vector<char> &fData;
+   std::size_t fPos = 0;
+
+public:
+   TFooterReader(const std::vector<char> &data) : fData(data) {}
+   ULong64_t Get(int nbytes)
+   {
+      if (fPos + nbytes > fData.size())
+         throw std::runtime_error("TColumnStoreReader: the footer of the column store is truncated.");
+      ULong64_t value = 0;
+      for (int i = 0; i < nbytes; ++i)
+         value |= ULong64_t((unsigned char)fData[fPos++]) << (8 * i);
+      return value;
+   }
+   UInt_t GetU32() { return Get(4); }
+   ULong64_t GetU64() { return Get(8); }
+   std::string GetString()
+   {
+      const UInt_t size = GetU32();
+      if (fPos + size > fData.size())
+         throw std::runtime_error("TColumnStoreReader: the footer of the column store is truncated.");
+      std::string value(fData.data() + fPos, size);
+      fPos += size;
+      return value;
+   }
+};
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Experimental {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the column store path, overwriting an existing file.
+
+std::unique_ptr<TColumnStoreWriter> TColumnStoreWriter::Recreate(std::string_view path,
+                                                                 const TColumnStoreOptions &options)
+{
+   return std::unique_ptr<TColumnStoreWriter>(new TColumnStoreWriter(path, options));
+}
+
+TColumnStoreWriter::TColumnStoreWriter(std::string_view path, const TColumnStoreOptions &options)
+   : fOptions(options), fPath(path)
+{
+   if (fOptions.fPageSize == 0 || fOptions.fPageSize > kMaxPageSize)
+      throw std::runtime_error("TColumnStoreWriter: the size of the pages must be between 1 byte and 16 MB.");
+   if (fOptions.fAlignment == 0 || (fOptions.fAlignment & (fOptions.fAlignment - 1)))
+      throw std::runtime_error("TColumnStoreWriter: the alignment of the pages must be a power of two.");
+   fFile.open(fPath, std::ios::out | std::ios::binary | std::ios::trunc);
+   if (!fFile)
+      throw std::runtime_error("TColumnStoreWriter: cannot create " + fPath + ".");
+
+   TFooterWriter header;
+   for (char c : kMagic)
+      header.Put((unsigned char)c, 1);
+   header.PutU32(kVersion);
+   header.PutU32(fOptions.fAlignment);
+   WriteAligned(header.GetData().data(), header.GetData().size());
+}
+
+TColumnStoreWriter::~TColumnStoreWriter()
+{
+   try {
+      Close();
+   } catch (const std::exception &e) {
+      ::Error("TColumnStoreWriter::~TColumnStoreWriter", "%s", e.what());
+   }
+}
+
+Detail::TColumnSink &TColumnStoreWriter::AddColumn(std::string_view name, const std::string &typeName,
+                                                   Detail::TColumnDescriptor::EKind kind, UInt_t elementSize,
+                                                   Int_t parent)
+{
+   if (fClosed)
+      throw std::runtime_error("TColumnStoreWriter: cannot add the column " + std::string(name) + " to " + fPath +
+                               ", which is closed.");
+   if (GetNEntries() > 0)
+      throw std::runtime_error("TColumnStoreWriter: the column " + std::string(name) +
+                               " must be added before the columns are filled.");
+   for (const auto &column : fColumns) {
+      if (column->fName == name)
+         throw std::runtime_error("TColumnStoreWriter: the column " + std::string(name) + " already exists.");
+   }
+   std::unique_ptr<Detail::TColumnDescriptor> column(new Detail::TColumnDescriptor);
+   column->fName = std::string(name);
+   column->fTypeName = typeName;
+   column->fKind = kind;
+   column->fElementSize = elementSize;
+   column->fParent = parent;
+   fSinks.emplace_back(new Detail::TColumnSink(*this, *column));
+   fColumns.emplace_back(std::move(column));
+   return *fSinks.back();
+}
+
+std::pair<Detail::TColumnSink *, Detail::TColumnSink *>
+TColumnStoreWriter::AddCollection(std::string_view name, const std::string &valueTypeName, UInt_t valueSize)
+{
+   auto &offsets = AddColumn(name, "std::vector<" + valueTypeName + ">", Detail::TColumnDescriptor::kCollection,
+                             sizeof(ULong64_t), -1);
+   auto &values = AddColumn(std::string(name) + "._0", valueTypeName, Detail::TColumnDescriptor::kValue, valueSize,
+                            fColumns.size() - 1);
+   return std::make_pair(&offsets, &values);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write size bytes, padded to the alignment of the pages.
+
+void TColumnStoreWriter::WriteAligned(const char *data, std::size_t size)
+{
+   const std::size_t padding = (fOptions.fAlignment - size % fOptions.fAlignment) % fOptions.fAlignment;
+   static const char zeros[4096] = {0};
+   fFile.write(data, size);
+   for (std::size_t done = 0; done < padding; done += sizeof(zeros))
+      fFile.write(zeros, std::min(padding - done, sizeof(zeros)));
+   if (!fFile)
+      throw std::runtime_error("TColumnStoreWriter: cannot write to " + fPath + ".");
+   fFileSize += size + padding;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compress and write a page of nElements elements of column.
+
+void TColumnStoreWriter::CommitPage(Detail::TColumnDescriptor &column, const char *data, UInt_t nElements)
+{
+   const std::size_t size = std::size_t(nElements) * column.fElementSize;
+   std::vector<char> swapped;
+   if (kSwapElements) {
+      swapped.assign(data, data + size);
+      SwapElements(swapped.data(), nElements, column.fElementSize);
+      data = swapped.data();
+   }
+
+   int stored = 0;
+   std::vector<char> compressed;
+   if (fOptions.fCompressionLevel > 0) {
+      compressed.resize(size);
+      int srcSize = size;
+      int tgtSize = size; // pages that would not shrink make the compression fail
+      R__zipMultipleAlgorithm(fOptions.fCompressionLevel, &srcSize, const_cast<char *>(data), &tgtSize,
+                              compressed.data(), &stored, fOptions.fCompressionAlgorithm);
+   }
+   const bool isCompressed = stored > 0 && std::size_t(stored) < size;
+
+   Detail::TPageInfo page;
+   page.fFirstElement = column.fNElements;
+   page.fNElements = nElements;
+   page.fOffset = fFileSize;
+   page.fStoredSize = isCompressed ? stored : size;
+   WriteAligned(isCompressed ? compressed.data() : data, page.fStoredSize);
+   column.fPages.push_back(page);
+   column.fNElements += nElements;
+}
+
+ULong64_t TColumnStoreWriter::GetNEntries() const
+{
+   return fSinks.empty() ? 0 : fSinks.front()->GetNElements();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the pages not full yet and the footer, and close the file. Throws if the columns do not have the same
+/// number of entries.
+
+void TColumnStoreWriter::Close()
+{
+   if (fClosed)
+      return;
+   fClosed = true;
+   const ULong64_t nEntries = GetNEntries();
+   for (std::size_t i = 0; i < fColumns.size(); ++i) {
+      if (fColumns[i]->fParent < 0 && fSinks[i]->GetNElements() != nEntries)
+         throw std::runtime_error("TColumnStoreWriter: the column " + fColumns[i]->fName + " has " +
+                                  std::to_string(fSinks[i]->GetNElements()) + " entries instead of " +
+                                  std::to_string(nEntries) + ".");
+   }
+   for (auto &sink : fSinks)
+      sink->Flush();
+
+   TFooterWriter footer;
+   footer.PutU64(nEntries);
+   footer.PutU32(fColumns.size());
+   for (const auto &column : fColumns) {
+      footer.PutString(column->fName);
+      footer.PutString(column->fTypeName);
+      footer.PutU32(column->fKind);
+      footer.PutU32(column->fElementSize);
+      footer.PutU32(UInt_t(column->fParent));
+      footer.PutU64(column->fNElements);
+      footer.PutU32(column->fPages.size());
+      for (const auto &page : column->fPages) {
+         footer.PutU64(page.fFirstElement);
+         footer.PutU32(page.fNElements);
+         footer.PutU64(page.fOffset);
+         footer.PutU32(page.fStoredSize);
+      }
+   }
+   const ULong64_t footerOffset = fFileSize;
+   const ULong64_t footerSize = footer.GetData().size();
+   footer.PutU64(footerOffset);
+   footer.PutU64(footerSize);
+   for (char c : kMagic)
+      footer.Put((unsigned char)c, 1);
+   fFile.write(footer.GetData().data(), footer.GetData().size());
+   fFile.close();
+   if (!fFile)
+      throw std::runtime_error("TColumnStoreWriter: cannot write the footer of " + fPath + ".");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open the column store path for reading.
+
+std::unique_ptr<TColumnStoreReader> TColumnStoreReader::Open(std::string_view path)
+{
+   return std::unique_ptr<TColumnStoreReader>(new TColumnStoreReader(path));
+}
+
+TColumnStoreReader::TColumnStoreReader(std::string_view path) : fPath(path)
+{
+   fFile.open(fPath, std::ios::in | std::ios::binary);
+   if (!fFile)
+      throw std::runtime_error("TColumnStoreReader: cannot open " + fPath + ".");
+   ReadFooter();
+}
+
+void TColumnStoreReader::ReadFooter()
+{
+   const std::string notAStore = "TColumnStoreReader: " + fPath + " is not a column store.";
+   fFile.seekg(0, std::ios::end);
+   const ULong64_t fileSize = fFile.tellg();
+   if (!fFile || fileSize < sizeof(kMagic) + kTrailerSize)
+      throw std::runtime_error(notAStore);
+
+   std::vector<char> header(sizeof(kMagic) + 4);
+   fFile.seekg(0);
+   fFile.read(header.data(), header.size());
+   if (!fFile || memcmp(header.data(), kMagic, sizeof(kMagic)))
+      throw std::runtime_error(notAStore);
+   TFooterReader headerReader(header);
+   headerReader.Get(sizeof(kMagic));
+   if (headerReader.GetU32() > kVersion)
+      throw std::runtime_error("TColumnStoreReader: " + fPath + " was written by a newer version of ROOT.");
+
+   std::vector<char> trailer(kTrailerSize);
+   fFile.seekg(fileSize - kTrailerSize);
+   fFile.read(trailer.data(), trailer.size());
+   if (!fFile || memcmp(trailer.data() + 16, kMagic, sizeof(kMagic)))
+      throw std::runtime_error("TColumnStoreReader: " + fPath + " has no footer, it was not closed.");
+   TFooterReader trailerReader(trailer);
+   const ULong64_t footerOffset = trailerReader.GetU64();
+   const ULong64_t footerSize = trailerReader.GetU64();
+   if (footerOffset + footerSize + kTrailerSize != fileSize)
+      throw std::runtime_error(notAStore);
+
+   std::vector<char> data(footerSize);
+   fFile.seekg(footerOffset);
+   fFile.read(data.data(), data.size());
+   if (!fFile)
+      throw std::runtime_error("TColumnStoreReader: cannot read the footer of " + fPath + ".");
+   TFooterReader footer(data);
+   fNEntries = footer.GetU64();
+   fColumns.resize(footer.GetU32());
+   for (auto &column : fColumns) {
+      column.fName = footer.GetString();
+      column.fTypeName = footer.GetString();
+      column.fKind = Detail::TColumnDescriptor::EKind(footer.GetU32());
+      column.fElementSize = footer.GetU32();
+      column.fParent = Int_t(footer.GetU32());
+      column.fNElements = footer.GetU64();
+      column.fPages.resize(footer.GetU32());
+      for (auto &page : column.fPages) {
+         page.fFirstElement = footer.GetU64();
+         page.fNElements = footer.GetU32();
+         page.fOffset = footer.GetU64();
+         page.fStoredSize = footer.GetU32();
+      }
+      if (column.fParent < 0)
+         fColumnNames.push_back(column.fName);
+   }
+}
+
+bool TColumnStoreReader::HasColumn(std::string_view name) const
+{
+   return std::find(fColumnNames.begin(), fColumnNames.end(), name) != fColumnNames.end();
+}
+
+const Detail::TColumnDescriptor &TColumnStoreReader::GetDescriptor(std::string_view name) const
+{
+   for (const auto &column : fColumns) {
+      if (column.fParent < 0 && column.fName == name)
+         return column;
+   }
+   throw std::runtime_error("TColumnStoreReader: the column " + std::string(name) + " is not in " + fPath + ".");
+}
+
+const Detail::TColumnDescriptor &
+TColumnStoreReader::GetDescriptor(std::string_view name, const std::string &typeName) const
+{
+   const auto &column = GetDescriptor(name);
+   if (column.fTypeName != typeName)
+      throw std::runtime_error("TColumnStoreReader: the column " + column.fName + " has type " + column.fTypeName +
+                               " while " + typeName + " is requested.");
+   return column;
+}
+
+std::string TColumnStoreReader::GetTypeName(std::string_view name) const
+{
+   return GetDescriptor(name).fTypeName;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read and uncompress the page of column into buffer, through compressed. Thread-safe.
+
+void TColumnStoreReader::ReadPage(const Detail::TColumnDescriptor &column, std::size_t page,
+                                  std::vector<char> &buffer, std::vector<char> &compressed)
+{
+   const auto &info = column.fPages[page];
+   const std::size_t size = std::size_t(info.fNElements) * column.fElementSize;
+   buffer.resize(size);
+   const bool isCompressed = info.fStoredSize != size;
+   if (isCompressed)
+      compressed.resize(info.fStoredSize);
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fFile.seekg(info.fOffset);
+      fFile.read(isCompressed ? compressed.data() : buffer.data(), info.fStoredSize);
+      if (!fFile) {
+         fFile.clear();
+         throw std::runtime_error("TColumnStoreReader: cannot read a page of the column " + column.fName + " from " +
+                                  fPath + ".");
+      }
+   }
+   if (isCompressed) {
+      int srcSize = info.fStoredSize;
+      int tgtSize = size;
+      int irep = 0;
+      R__unzip(&srcSize, reinterpret_cast<unsigned char *>(compressed.data()), &tgtSize,
+               reinterpret_cast<unsigned char *>(buffer.data()), &irep);
+      if (std::size_t(irep) != size)
+         throw std::runtime_error("TColumnStoreReader: cannot uncompress a page of the column " + column.fName +
+                                  " of " + fPath + ".");
+   }
+   if (kSwapElements)
+      SwapElements(buffer.data(), info.fNElements, column.fElementSize);
+}
+
+namespace Detail {
+
+TColumnSink::TColumnSink(TColumnStoreWriter &writer, TColumnDescriptor &column)
+   : fWriter(writer), fColumn(column),
+     fMaxNElements(std::max<UInt_t>(1, writer.GetOptions().fPageSize / column.fElementSize))
+{
+   fPage.resize(std::size_t(fMaxNElements) * fColumn.fElementSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append n elements to the column, committing the pages which get full.
+
+void TColumnSink::Append(const void *elements, std::size_t n)
+{
+   const char *data = static_cast<const char *>(elements);
+   while (n > 0) {
+      const std::size_t count = std::min<std::size_t>(n, fMaxNElements - fNElements);
+      const std::size_t bytes = count * fColumn.fElementSize;
+      memcpy(fPage.data() + std::size_t(fNElements) * fColumn.fElementSize, data, bytes);
+      fNElements += count;
+      data += bytes;
+      n -= count;
+      if (fNElements == fMaxNElements)
+         Flush();
+   }
+}
+
+void TColumnSink::Flush()
+{
+   if (fNElements == 0)
+      return;
+   fWriter.CommitPage(fColumn, fPage.data(), fNElements);
+   fNElements = 0;
+}
+
+void TColumnSource::LoadPage(ULong64_t element)
+{
+   if (element >= fColumn->fNElements)
+      throw std::out_of_range("TColumnStoreReader: element " + std::to_string(element) + " of the column " +
+                              fColumn->fName + " is beyond its " + std::to_string(fColumn->fNElements) + " elements.");
+   const auto &pages = fColumn->fPages;
+   const auto next = std::upper_bound(pages.begin(), pages.end(), element,
+                                      [](ULong64_t e, const TPageInfo &page) { return e < page.fFirstElement; });
+   const std::size_t page = std::distance(pages.begin(), next) - 1;
+   fReader->ReadPage(*fColumn, page, fPage, fCompressed);
+   fFirst = pages[page].fFirstElement;
+   fEnd = fFirst + pages[page].fNElements;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy n elements from first into out, across the pages.
+
+void TColumnSource::ReadRange(ULong64_t first, ULong64_t n, char *out)
+{
+   while (n > 0) {
+      ULong64_t available = 0;
+      const char *elements = Map(first, available);
+      const ULong64_t count = std::min(n, available);
+      memcpy(out, elements, count * fColumn->fElementSize);
+      out += count * fColumn->fElementSize;
+      first += count;
+      n -= count;
+   }
+}
+
+} // namespace Detail
+
+} // namespace Experimental
+} // namespace ROOT
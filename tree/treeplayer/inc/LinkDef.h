@@ -122,6 +122,13 @@
 #pragma link C++ class ROOT::Experimental::TDF::TTrivialDS-;
 #pragma link C++ class ROOT::Experimental::TDF::TRootDS-;
 #pragma link C++ class ROOT::Experimental::TDF::TCsvDS-;
+#pragma link C++ class ROOT::Experimental::TDF::TCompressedCacheDS-;
+#ifdef ROOT_TCOLUMNSTOREDS
+#pragma link C++ class ROOT::Experimental::TDF::TColumnStoreDS-;
+#endif
+#ifdef R__HAS_ARROW
+#pragma link C++ class ROOT::Experimental::TDF::TArrowDS-;
+#endif
 
 #endif
 
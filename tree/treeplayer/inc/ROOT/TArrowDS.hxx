@@ -0,0 +1,82 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TARROWTDS
+#define ROOT_TARROWTDS
+
+#include "ROOT/TDataFrame.hxx"
+#include "ROOT/TDataSource.hxx"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arrow {
+class Array;
+class RecordBatch;
+class Table;
+}
+
+namespace ROOT {
+namespace Experimental {
+namespace TDF {
+
+class TArrowDS final : public ROOT::Experimental::TDF::TDataSource {
+private:
+   /// A column of the table exposed by the data source
+   struct TColumn {
+      std::string fName;
+      std::string fTypeName;
+      int fIndex = -1;               ///< Index of the column in the record batches
+      int fTypeId = -1;              ///< The arrow::Type::type of the column
+      std::size_t fByteWidth = 0;    ///< Size of the values of the columns read in place, 0 for the others
+      bool fRead = false;            ///< Whether a column reader was requested for this column
+      std::vector<void *> fValues;   ///< [slot] address of the current value
+      std::deque<bool> fBoolValues;  ///< [slot] current value of boolean columns, bit-packed in arrow
+      std::vector<std::string> fStringValues; ///< [slot] current value of string columns
+   };
+
+   unsigned int fNSlots = 0U;
+   std::shared_ptr<arrow::Table> fTable;
+   std::vector<std::string> fColNames;
+   std::vector<TColumn> fColumns;
+   std::vector<std::shared_ptr<arrow::RecordBatch>> fBatches;
+   std::vector<ULong64_t> fBatchFirstEntries;
+   std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
+   std::vector<Long64_t> fSlotBatches;                              ///< [slot] batch currently read, -1 if none
+   std::vector<std::vector<std::shared_ptr<arrow::Array>>> fSlotArrays; ///< [slot][column] arrays of the batch
+   std::vector<std::vector<const char *>> fSlotRawValues;           ///< [slot][column] values of the batch
+
+   std::size_t GetColumnIndex(std::string_view colName) const;
+   void SetBatch(unsigned int slot, std::size_t batchIndex);
+   std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &);
+
+public:
+   TArrowDS(std::shared_ptr<arrow::Table> table, const std::vector<std::string> &columns = {});
+   ~TArrowDS();
+   const std::vector<std::string> &GetColumnNames() const;
+   bool HasColumn(std::string_view colName) const;
+   std::string GetTypeName(std::string_view colName) const;
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges();
+   void SetEntry(unsigned int slot, ULong64_t entry);
+   void SetNSlots(unsigned int nSlots);
+   void Initialise();
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a TDataFrame reading an Apache Arrow table.
+/// \param[in] table The table, shared with the data source which reads its buffers in place.
+/// \param[in] columns Names of the columns to expose, all the columns of supported types if empty.
+TDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::Table> table, const std::vector<std::string> &columns = {});
+
+} // ns TDF
+} // ns Experimental
+} // ns ROOT
+
+#endif
@@ -0,0 +1,41 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TCACHEOPTIONS
+#define ROOT_TCACHEOPTIONS
+
+#include <Compression.h>
+#include <RtypesCore.h>
+#include <string>
+
+namespace ROOT {
+namespace Experimental {
+namespace TDF {
+/// A collection of options to steer the caching of columns in compressed chunks
+struct TCacheOptions {
+   using ECAlgo = ::ROOT::ECompressionAlgorithm;
+   TCacheOptions() = default;
+   TCacheOptions(const TCacheOptions &) = default;
+   TCacheOptions(TCacheOptions &&) = default;
+   TCacheOptions(ECAlgo comprAlgo, int comprLevel, ULong64_t chunkSize, ULong64_t maxMemory,
+                 const std::string &scratchDir = "")
+      : fCompressionAlgorithm(comprAlgo), fCompressionLevel(comprLevel), fChunkSize(chunkSize), fMaxMemory(maxMemory),
+        fScratchDir(scratchDir)
+   {
+   }
+   ECAlgo fCompressionAlgorithm = ROOT::kLZ4; //< Compression algorithm of the cached chunks
+   int fCompressionLevel = 1;                 //< Compression level of the cached chunks, 0 to store them as they are
+   ULong64_t fChunkSize = 65536;              //< Number of entries per chunk
+   ULong64_t fMaxMemory = 0;                  //< Bytes of chunks kept in memory before spilling to disk, 0: no limit
+   std::string fScratchDir;                   //< Directory of the scratch file, the temporary directory if empty
+};
+}
+}
+}
+
+#endif
@@ -0,0 +1,67 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TCOLUMNSTOREDS
+#define ROOT_TCOLUMNSTOREDS
+
+#include "ROOT/TDataFrame.hxx"
+#include "ROOT/TDataSource.hxx"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+
+class TColumnStoreReader;
+
+namespace TDF {
+
+namespace Internal {
+class TColumnStoreSlotColumn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief A TDataSource reading the column stores written by ROOT::Experimental::TColumnStoreWriter
+///
+/// Every slot has its own readers of the columns, which keep the page they read uncompressed: the values of the
+/// columns of arithmetic types are read in place in the pages, those of the vector columns are copied in a vector
+/// per slot. The entries are split in a few ranges per slot.
+class TColumnStoreDS final : public ROOT::Experimental::TDF::TDataSource {
+   std::unique_ptr<ROOT::Experimental::TColumnStoreReader> fReader;
+   unsigned int fNSlots = 0U;
+   std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
+   /// [column][slot] readers of the columns requested by GetColumnReaders
+   std::vector<std::vector<std::unique_ptr<Internal::TColumnStoreSlotColumn>>> fSlotColumns;
+   std::vector<std::string> fSlotColumnNames; ///< Names of the columns of fSlotColumns
+
+   std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &);
+
+public:
+   TColumnStoreDS(std::string_view fileName);
+   ~TColumnStoreDS();
+   const std::vector<std::string> &GetColumnNames() const;
+   bool HasColumn(std::string_view colName) const;
+   std::string GetTypeName(std::string_view colName) const;
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges();
+   void SetEntry(unsigned int slot, ULong64_t entry);
+   void SetNSlots(unsigned int nSlots);
+   void Initialise();
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a TDataFrame reading a column store.
+/// \param[in] fileName Path of the column store, written by ROOT::Experimental::TColumnStoreWriter.
+TDataFrame MakeColumnStoreDataFrame(std::string_view fileName);
+
+} // ns TDF
+} // ns Experimental
+} // ns ROOT
+
+#endif
@@ -0,0 +1,93 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TCOMPRESSEDCACHEDS
+#define ROOT_TCOMPRESSEDCACHEDS
+
+#include "ROOT/TCacheOptions.hxx"
+#include "ROOT/TDataSource.hxx"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+namespace TDF {
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief A TDataSource serving columns cached in compressed chunks
+///
+/// The columns are stored in chunks of TCacheOptions::fChunkSize entries, each column of each chunk compressed
+/// separately. The chunks are added concurrently by the tasks of the event loop filling the cache, which also
+/// compress them. When the chunks kept in memory exceed TCacheOptions::fMaxMemory bytes, the oldest ones are moved
+/// to a scratch file, removed together with the data source.
+///
+/// Each chunk is an entry range of its own: the tasks reading the cache uncompress the chunks they process into
+/// per-slot buffers, the column readers point directly into them.
+/// Only columns of trivially copyable types can be cached, their values are stored as raw bytes.
+class TCompressedCacheDS final : public ROOT::Experimental::TDF::TDataSource {
+   /// The content of a column in a chunk
+   struct TColumnChunk {
+      std::vector<char> fBuffer; ///< Compressed content, empty once moved to the scratch file
+      Long64_t fOffset = -1;     ///< Position of the content in the scratch file, -1 if in memory
+      std::size_t fSize = 0;     ///< Size of the compressed content
+   };
+   struct TChunk {
+      ULong64_t fFirstEntry = 0;
+      ULong64_t fNEntries = 0;
+      std::vector<TColumnChunk> fColumns;
+   };
+
+   const TCacheOptions fOptions;
+   const std::vector<std::string> fColNames;
+   const std::vector<std::string> fColTypeNames;
+   const std::vector<std::size_t> fColTypeSizes;
+   unsigned int fNSlots = 0U;
+   std::vector<TChunk> fChunks;
+   ULong64_t fNEntries = 0ULL;
+   std::size_t fMemorySize = 0;     ///< Bytes of compressed content in memory
+   std::size_t fFirstInMemory = 0;  ///< Index of the oldest chunk that has not been moved to the scratch file
+   std::string fScratchFileName;    ///< Empty until the first chunk is moved to the scratch file
+   std::fstream fScratchFile;
+   Long64_t fScratchFileSize = 0;
+   std::mutex fMutex;               ///< Protects fChunks while the cache is filled, and the scratch file
+   std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
+   std::vector<Long64_t> fSlotChunks;                     ///< Chunk uncompressed in each slot, -1 if none
+   std::vector<std::vector<std::vector<char>>> fSlotBuffers; ///< [slot][column] uncompressed content of the chunk
+   std::vector<std::vector<char>> fSlotReadBuffers;        ///< [slot] content read back from the scratch file
+   std::vector<std::vector<void *>> fColumnValues;         ///< [column][slot] addresses of the current values
+
+   void SpillChunk(TChunk &chunk);
+   void LoadChunk(unsigned int slot, std::size_t chunkIndex);
+   std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &);
+
+public:
+   TCompressedCacheDS(const std::vector<std::string> &colNames, const std::vector<std::string> &colTypeNames,
+                      const std::vector<std::size_t> &colTypeSizes, const TCacheOptions &options);
+   ~TCompressedCacheDS();
+   void AddChunk(ULong64_t nEntries, const std::vector<const char *> &columns);
+   ULong64_t GetNEntries() const { return fNEntries; }
+   std::size_t GetMemorySize() const { return fMemorySize; }
+   Long64_t GetScratchFileSize() const { return fScratchFileSize; }
+   const std::vector<std::string> &GetColumnNames() const;
+   bool HasColumn(std::string_view colName) const;
+   std::string GetTypeName(std::string_view colName) const;
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges();
+   void SetEntry(unsigned int slot, ULong64_t entry);
+   void SetNSlots(unsigned int nSlots);
+   void Initialise();
+};
+
+} // ns TDF
+} // ns Experimental
+} // ns ROOT
+
+#endif
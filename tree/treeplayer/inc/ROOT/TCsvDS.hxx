@@ -32,15 +32,39 @@ private:
    using ColType_t = char;
    static const std::map<ColType_t, std::string> fgColTypeMap;
 
+   /// A range of lines of the file, processed as one entry range
+   struct TChunk {
+      std::size_t fBegin = 0;    ///< Offset of the first line in the file
+      std::size_t fEnd = 0;      ///< Offset of the end of the last line
+      ULong64_t fFirstEntry = 0; ///< Entry number of the first record
+      ULong64_t fNEntries = 0;
+   };
+
+   /// The values of the records of the chunk parsed by a slot, per column. Only the vectors of the type of the
+   /// column read are filled.
+   struct TSlotChunk {
+      Long64_t fIndex = -1; ///< Index of the chunk parsed, -1 if none
+      std::vector<std::vector<double>> fDoubles;
+      std::vector<std::vector<Long64_t>> fLong64s;
+      std::vector<std::vector<std::string>> fStrings;
+      std::vector<std::vector<char>> fBools;
+   };
+
    unsigned int fNSlots = 0U;
    std::string fFileName;
    char fDelimiter;
+   const char *fData = nullptr;   ///< Content of the file, memory-mapped if possible
+   std::size_t fDataSize = 0;     ///< Size of the content of the file
+   std::string fDataCopy;         ///< Content of the file, if it cannot be memory-mapped
+   bool fIsMapped = false;        ///< Whether fData is a mapping of the file
+   std::size_t fFirstRecord = 0;  ///< Offset of the first record, after the headers
    std::vector<std::string> fHeaders;
    std::map<std::string, ColType_t> fColTypes;
    std::list<ColType_t> fColTypesList;
    std::vector<std::vector<void *>> fColAddresses; // fColAddresses[column][slot]
    std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
-   std::vector<Record_t> fRecords;                         // fRecords[entry][column]
+   std::vector<TChunk> fChunks;
+   std::vector<TSlotChunk> fSlotChunks;                    // one per slot
    std::vector<std::vector<double>> fDoubleEvtValues;      // one per column per slot
    std::vector<std::vector<Long64_t>> fLong64EvtValues;    // one per column per slot
    std::vector<std::vector<std::string>> fStringEvtValues; // one per column per slot
@@ -50,15 +74,21 @@ private:
 
    static TRegexp intRegex, doubleRegex1, doubleRegex2, trueRegex, falseRegex;
 
+   void MapFile();
    void FillHeaders(const std::string &);
-   void FillRecord(const std::string &, Record_t &);
    void GenerateHeaders(size_t);
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &);
-   void InferColTypes(std::vector<std::string> &);
-   void InferType(const std::string &, unsigned int);
-   std::vector<std::string> ParseColumns(const std::string &);
-   size_t ParseValue(const std::string &, std::vector<std::string> &, size_t);
+   void InferColTypes(const std::vector<std::vector<std::string>> &);
+   ColType_t InferType(const std::string &) const;
+   std::vector<std::string> ParseColumns(const std::string &) const;
+   size_t ParseValue(const std::string &, std::vector<std::string> &, size_t) const;
    ColType_t GetType(std::string_view colName) const;
+   bool NextLine(std::size_t &pos, std::size_t end, std::string &line) const;
+   std::size_t AlignToLine(std::size_t pos) const;
+   ULong64_t CountRecords(std::size_t begin, std::size_t end) const;
+   std::size_t SkipRecords(std::size_t pos, ULong64_t n) const;
+   void BuildChunks();
+   void ParseChunk(unsigned int slot, std::size_t chunkIndex);
 
 public:
    TCsvDS(std::string_view fileName, bool readHeaders = true, char delimiter = ',');
@@ -13,7 +13,9 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -22,6 +24,7 @@
 #include "Compression.h"
 #include "ROOT/TArrayBranch.hxx"
 #include "ROOT/TBufferMerger.hxx" // for SnapshotHelper
+#include "ROOT/TCompressedCacheDS.hxx"
 #include "ROOT/TDFUtils.hxx"
 #include "ROOT/TSnapshotOptions.hxx"
 #include "ROOT/TThreadedObject.hxx"
@@ -600,6 +603,10 @@ void SetBranchesHelper(TTree &inputTree, TTree &outputTree, const std::string &v
    outputBranch->SetTitle(inputBranch->GetTitle());
 }
 
+/// Helper function for SnapshotHelperMT. It returns the number of the first input entry read by the task that uses
+/// the reader, which is used to sort the outputs of the tasks. The reader must not have been advanced yet.
+Long64_t GetTaskFirstEntry(const TTreeReader &r);
+
 /// Helper object for a single-thread Snapshot action
 template <typename... BranchTypes>
 class SnapshotHelper {
@@ -679,6 +686,17 @@ class SnapshotHelperMT {
    const ColumnNames_t fValidBranchNames; // This contains the resolved aliases
    const ColumnNames_t fBranchNames;
    std::vector<TTree *> fInputTrees; // Current input trees. Set at initialization time (`InitSlot`)
+   // The members below are only used if the input order must be preserved
+   std::vector<Long64_t> fTaskFirstEntries; // First input entry of the task currently run by each slot
+   std::multimap<Long64_t, std::shared_ptr<ROOT::Experimental::TBufferMergerFile>> fDoneFiles; // Outputs of done tasks
+   std::unique_ptr<std::mutex> fDoneFilesMutex; // must use a ptr because std::mutex is not movable
+
+   /// Set aside the output of the task that the slot has just completed: it is merged in the input order in Finalize
+   void StoreTaskOutput(unsigned int slot)
+   {
+      std::lock_guard<std::mutex> lock(*fDoneFilesMutex);
+      fDoneFiles.emplace(fTaskFirstEntries[slot], std::move(fOutputFiles[slot]));
+   }
 
 public:
    using BranchTypes_t = TypeList<BranchTypes...>;
@@ -689,7 +707,8 @@ public:
                             std::string(filename).c_str(), options.fMode.c_str(),
                             ROOT::CompressionSettings(options.fCompressionAlgorithm, options.fCompressionLevel))),
         fOutputFiles(fNSlots), fOutputTrees(fNSlots, nullptr), fIsFirstEvent(fNSlots, 1), fDirName(dirname),
-        fTreeName(treename), fOptions(options), fValidBranchNames(vbnames), fBranchNames(bnames), fInputTrees(fNSlots)
+        fTreeName(treename), fOptions(options), fValidBranchNames(vbnames), fBranchNames(bnames), fInputTrees(fNSlots),
+        fTaskFirstEntries(fNSlots, -1), fDoneFilesMutex(new std::mutex)
    {
    }
    SnapshotHelperMT(const SnapshotHelperMT &) = delete;
@@ -701,6 +720,10 @@ public:
       if (!fOutputTrees[slot]) {
          // first time this thread executes something, let's create a TBufferMerger output directory
          fOutputFiles[slot] = fMerger->GetFile();
+      } else if (fOptions.fPreserveClusterOrder) {
+         // the outputs of the tasks can only be merged once they are all known: every task writes to its own file
+         StoreTaskOutput(slot);
+         fOutputFiles[slot] = fMerger->GetFile();
       } else {
          // this thread is now re-executing the task, let's flush the current contents of the TBufferMergerFile
          fOutputFiles[slot]->Write();
@@ -722,6 +745,8 @@ public:
          // addresses of the branch values
          fInputTrees[slot]->AddClone(fOutputTrees[slot]);
       }
+      // without a reader (empty source or data source) there is no input order to preserve
+      fTaskFirstEntries[slot] = r ? GetTaskFirstEntry(*r) : -1;
       fIsFirstEvent[slot] = 1; // reset first event flag for this slot
    }
 
@@ -735,7 +760,8 @@ public:
       fOutputTrees[slot]->Fill();
       auto entries = fOutputTrees[slot]->GetEntries();
       auto autoFlush = fOutputTrees[slot]->GetAutoFlush();
-      if ((autoFlush > 0) && (entries % autoFlush == 0))
+      // if the input order must be preserved, the contents of the file are only sent to the merger in Finalize
+      if ((autoFlush > 0) && (entries % autoFlush == 0) && !fOptions.fPreserveClusterOrder)
          fOutputFiles[slot]->Write();
    }
 
@@ -752,6 +778,17 @@ public:
 
    void Finalize()
    {
+      if (fOptions.fPreserveClusterOrder) {
+         // the merger processes the files in the order in which they are written
+         for (auto slot = 0u; slot < fNSlots; ++slot) {
+            if (fOutputFiles[slot])
+               StoreTaskOutput(slot);
+         }
+         for (auto &file : fDoneFiles)
+            file.second->Write();
+         fDoneFiles.clear();
+         return;
+      }
       for (auto &file : fOutputFiles) {
          if (file)
             file->Write();
@@ -759,6 +796,67 @@ public:
    }
 };
 
+/// Helper object for a Cache action storing the columns in compressed chunks. Each slot fills its own chunk, which
+/// is compressed and handed to the cache as soon as it is full.
+template <typename... ColTypes>
+class CompressedCacheHelper {
+   TCompressedCacheDS &fCache;
+   const ULong64_t fChunkSize;
+   std::vector<std::vector<std::vector<char>>> fBuffers; // [slot][column] raw content of the chunk being filled
+   std::vector<ULong64_t> fNEntries;                     // number of entries in the chunk being filled, per slot
+
+   template <typename T>
+   void AppendValue(std::vector<char> &buffer, const T &value)
+   {
+      if (buffer.empty())
+         buffer.reserve(fChunkSize * sizeof(T));
+      const auto bytes = reinterpret_cast<const char *>(&value);
+      buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+   }
+
+   void FlushSlot(unsigned int slot)
+   {
+      if (fNEntries[slot] == 0)
+         return;
+      std::vector<const char *> columns;
+      for (auto &buffer : fBuffers[slot])
+         columns.emplace_back(buffer.data());
+      fCache.AddChunk(fNEntries[slot], columns);
+      for (auto &buffer : fBuffers[slot])
+         buffer.clear();
+      fNEntries[slot] = 0;
+   }
+
+public:
+   using BranchTypes_t = TypeList<ColTypes...>;
+   CompressedCacheHelper(TCompressedCacheDS &cache, const unsigned int nSlots, ULong64_t chunkSize)
+      : fCache(cache), fChunkSize(chunkSize), fBuffers(nSlots, std::vector<std::vector<char>>(sizeof...(ColTypes))),
+        fNEntries(nSlots, 0)
+   {
+   }
+   CompressedCacheHelper(CompressedCacheHelper &&) = default;
+   CompressedCacheHelper(const CompressedCacheHelper &) = delete;
+
+   void InitSlot(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, const ColTypes &... values)
+   {
+      auto &buffers = fBuffers[slot];
+      auto column = 0u;
+      // the elements of a braced-init-list are evaluated in order
+      int expander[] = {(AppendValue(buffers[column++], values), 0)..., 0};
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+      if (++fNEntries[slot] == fChunkSize)
+         FlushSlot(slot);
+   }
+
+   void Finalize()
+   {
+      for (auto slot = 0u; slot < fNEntries.size(); ++slot)
+         FlushSlot(slot);
+   }
+};
+
 template <typename Acc, typename Merge, typename R, typename T, typename U,
           bool MustCopyAssign = std::is_same<R, U>::value>
 class AggregateHelper {
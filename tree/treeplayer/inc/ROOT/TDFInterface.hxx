@@ -12,6 +12,8 @@
 #define ROOT_TDF_TINTERFACE
 
 #include "ROOT/TResultProxy.hxx"
+#include "ROOT/TCacheOptions.hxx"
+#include "ROOT/TCompressedCacheDS.hxx"
 #include "ROOT/TDataSource.hxx"
 #include "ROOT/TDFNodes.hxx"
 #include "ROOT/TDFActionHelpers.hxx"
@@ -176,6 +178,32 @@ public:
       return Filter(f, ColumnNames_t{columns});
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Append a filter evaluated for batches of consecutive entries at a time to the call graph.
+   /// \param[in] kernel Callable of signature `M(const std::vector<T1>&, const std::vector<T2>&, ...)`, where `M` is
+   /// a container (e.g. `std::vector<char>`) of values convertible to `bool`: the mask of the entries passing the
+   /// selection.
+   /// \param[in] columns Names of the branches in input to the kernel.
+   /// \param[in] name Optional name of this filter. See `Report`.
+   ///
+   /// The batches and the input columns are the same as for DefineBatch. The kernel is evaluated for a batch as
+   /// soon as the first entry of the batch passes the filters upstream.
+   template <typename F>
+   TInterface<TDFDetail::TBatchFilter<F, Proxied>>
+   FilterBatch(F kernel, const ColumnNames_t &columns, std::string_view name = "")
+   {
+      auto loopManager = GetDataFrameChecked();
+      constexpr auto nColumns = TTraits::CallableTraits<F>::arg_types::list_size;
+      const auto validColumnNames =
+         TDFInternal::GetValidatedColumnNames(*loopManager, nColumns, columns, fValidCustomColumns, fDataSource);
+      TDFInternal::CheckBatchColumns(validColumnNames, loopManager->GetTree(), loopManager->GetCustomColumnNames());
+
+      using F_t = TDFDetail::TBatchFilter<F, Proxied>;
+      auto FilterPtr = std::make_shared<F_t>(std::move(kernel), validColumnNames, *fProxiedPtr, name);
+      loopManager->Book(FilterPtr);
+      return TInterface<F_t>(FilterPtr, fImplWeakPtr, fValidCustomColumns, fDataSource);
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Append a filter to the call graph.
    /// \param[in] expression The filter expression in C++
@@ -276,6 +304,48 @@ public:
    }
    // clang-format on
 
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Creates a custom column computed for batches of consecutive entries at a time.
+   /// \param[in] name The name of the custom column.
+   /// \param[in] kernel Callable of signature `std::vector<R>(const std::vector<T1>&, const std::vector<T2>&, ...)`.
+   /// \param[in] columns Names of the branches in input to the kernel.
+   ///
+   /// The kernel receives the values of its input columns for a batch of consecutive entries and returns the values
+   /// of the new column for the same entries, which lets the compiler vectorize the computation across entries.
+   /// A batch spans from the first entry the column is needed for to the end of its cluster (at most 65536 entries):
+   /// the kernel is evaluated for all these entries, even those that do not pass the filters upstream.
+   ///
+   /// The input columns must be branches of the input TTree holding a single value of a basic type, read in bulk;
+   /// `Bool_t` branches are read as `std::vector<char>`. Custom columns and data sources are not supported.
+   /// ~~~{.cpp}
+   /// auto pt = [](const std::vector<float> &px, const std::vector<float> &py) {
+   ///    std::vector<float> v(px.size());
+   ///    for (auto i = 0u; i < v.size(); ++i)
+   ///       v[i] = std::sqrt(px[i] * px[i] + py[i] * py[i]);
+   ///    return v;
+   /// };
+   /// tdf.DefineBatch("pt", pt, {"px", "py"});
+   /// ~~~
+   template <typename F>
+   TInterface<Proxied> DefineBatch(std::string_view name, F kernel, const ColumnNames_t &columns)
+   {
+      auto loopManager = GetDataFrameChecked();
+      TDFInternal::CheckCustomColumn(name, loopManager->GetTree(), loopManager->GetCustomColumnNames(),
+                                     fDataSource ? fDataSource->GetColumnNames() : ColumnNames_t{});
+      constexpr auto nColumns = TTraits::CallableTraits<F>::arg_types::list_size;
+      const auto validColumnNames =
+         TDFInternal::GetValidatedColumnNames(*loopManager, nColumns, columns, fValidCustomColumns, fDataSource);
+      TDFInternal::CheckBatchColumns(validColumnNames, loopManager->GetTree(), loopManager->GetCustomColumnNames());
+
+      using NewCol_t = TDFDetail::TBatchCustomColumn<F>;
+      loopManager->Book(std::make_shared<NewCol_t>(name, std::move(kernel), validColumnNames, loopManager.get()));
+      TInterface<Proxied> newInterface(fProxiedPtr, fImplWeakPtr, fValidCustomColumns, fDataSource);
+      newInterface.fValidCustomColumns.emplace_back(name);
+      return newInterface;
+   }
+   // clang-format on
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates a custom column
    /// \param[in] name The name of the custom column.
@@ -488,6 +558,78 @@ public:
       return Cache(selectedColumns);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in compressed chunks, in memory or in a scratch file
+   /// \param[in] columnList columns to be cached
+   /// \param[in] options TCacheOptions struct steering the compression and the memory usage of the cache
+   ///
+   /// Contrary to the other overloads, the values are not kept in `std::vector`s: the entries are grouped in chunks
+   /// of `options.fChunkSize` entries and each column of each chunk is compressed, by the worker thread that filled
+   /// it, with the algorithm and level in `options` (LZ4 by default). If the compressed chunks exceed
+   /// `options.fMaxMemory` bytes, the oldest ones are moved to a scratch file in `options.fScratchDir`. The returned
+   /// data-frame reads the cache through a TCompressedCacheDS, which uncompresses one chunk per task.
+   /// Only columns of trivially copyable types, e.g. fundamental types, can be cached this way.
+   template <typename... BranchTypes>
+   TInterface<TLoopManager> Cache(const ColumnNames_t &columnList, const TCacheOptions &options)
+   {
+      return CompressedCacheImpl<BranchTypes...>(columnList, options);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in compressed chunks, in memory or in a scratch file
+   /// \param[in] columnList columns to be cached
+   /// \param[in] options TCacheOptions struct steering the compression and the memory usage of the cache
+   ///
+   /// The types of the columns are automatically inferred and do not need to be specified.
+   /// See the templated overload for more details.
+   TInterface<TLoopManager> Cache(const ColumnNames_t &columnList, const TCacheOptions &options)
+   {
+      if (columnList.empty()) {
+         auto nEntries = *this->Count();
+         TInterface<TLoopManager> emptyTDF(std::make_shared<TLoopManager>(nEntries));
+         return emptyTDF;
+      }
+
+      auto df = GetDataFrameChecked();
+      auto tree = df->GetTree();
+      std::stringstream cacheCall;
+      auto upcastNode = TDFInternal::UpcastNode(fProxiedPtr);
+      TInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, fImplWeakPtr,
+                                                                                      fValidCustomColumns, fDataSource);
+      // build a string equivalent to
+      // "(TInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList), options)"
+      cacheCall << "reinterpret_cast<ROOT::Experimental::TDF::TInterface<" << upcastInterface.GetNodeTypeName()
+                << ">*>(" << std::hex << std::showbase << (size_t)&upcastInterface << ")->Cache<";
+      bool first = true;
+      for (auto &b : columnList) {
+         if (!first)
+            cacheCall << ", ";
+         cacheCall << TDFInternal::ColumnName2ColumnTypeName(b, tree, df->GetBookedBranch(b), fDataSource);
+         first = false;
+      };
+      cacheCall << ">(*reinterpret_cast<std::vector<std::string>*>(" // vector<string> should be ColumnNames_t
+                << std::hex << std::showbase << (size_t)&columnList << "),"
+                << "*reinterpret_cast<ROOT::Experimental::TDF::TCacheOptions*>(" << std::hex << std::showbase
+                << (size_t)&options << "));";
+      TInterpreter::EErrorCode errorCode;
+      auto newTDFPtr = gInterpreter->Calc(cacheCall.str().c_str(), &errorCode);
+      if (TInterpreter::EErrorCode::kNoError != errorCode) {
+         std::string msg = "Cannot jit Cache call. Interpreter error code is " + std::to_string(errorCode) + ".";
+         throw std::runtime_error(msg);
+      }
+      return *reinterpret_cast<TInterface<TLoopManager> *>(newTDFPtr);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in compressed chunks, in memory or in a scratch file
+   /// \param[in] columnNameRegexp a regular expression to select the columns
+   /// \param[in] options TCacheOptions struct steering the compression and the memory usage of the cache
+   TInterface<TLoopManager> Cache(std::string_view columnNameRegexp, const TCacheOptions &options)
+   {
+      auto selectedColumns = ConvertRegexToColumns(columnNameRegexp, "Cache");
+      return Cache(selectedColumns, options);
+   }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates a node that filters entries based on range: [begin, end)
@@ -1270,6 +1412,21 @@ public:
       return rep;
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Profile the next event loops of the computation graph
+   /// \param[in] enable Start profiling, discarding the previous profile, if true; stop profiling if false.
+   ///
+   /// The number of calls and the time spent in each `Filter`, `Define` and action of the graph are recorded per
+   /// processing slot, as well as the time spent reading the entries and decompressing the baskets.
+   /// Profiling adds a few tens of nanoseconds to each call of a node. The report is returned by GetProfileReport.
+   void EnableProfiling(bool enable = true) { GetDataFrameChecked()->EnableProfiling(enable); }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Return the profile of the event loops run since profiling was enabled
+   ///
+   /// Contrary to `Report`, this method never runs the event loop. The report is empty if profiling was never enabled.
+   TProfileReport GetProfileReport() { return GetDataFrameChecked()->GetProfileReport(); }
+
    /////////////////////////////////////////////////////////////////////////////
    /// \brief Returns the names of the available columns
    ///
@@ -1687,6 +1844,41 @@ private:
       return cachedTDF;
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Implementation of the cache in compressed chunks
+   template <typename... BranchTypes>
+   TInterface<TLoopManager> CompressedCacheImpl(const ColumnNames_t &columnList, const TCacheOptions &options)
+   {
+      // The values are copied as raw bytes into the chunks
+      constexpr bool areTriviallyCopyable =
+         TDFInternal::TEvalAnd<std::is_trivially_copyable<BranchTypes>::value...>::value;
+      static_assert(areTriviallyCopyable,
+                    "Only columns of trivially copyable types can be cached in compressed chunks.");
+
+      TDFInternal::CheckSnapshot(sizeof...(BranchTypes), columnList.size());
+      auto df = GetDataFrameChecked();
+      auto validCols =
+         TDFInternal::GetValidatedColumnNames(*df, columnList.size(), columnList, fValidCustomColumns, fDataSource);
+      if (fDataSource)
+         TDFInternal::DefineDataSourceColumns(validCols, *df, TDFInternal::GenStaticSeq_t<sizeof...(BranchTypes)>(),
+                                              TTraits::TypeList<BranchTypes...>(), *fDataSource);
+
+      std::unique_ptr<TCompressedCacheDS> cache(
+         new TCompressedCacheDS(columnList, {TDFInternal::TypeID2TypeName(typeid(BranchTypes))...},
+                                {sizeof(BranchTypes)...}, options));
+
+      // fill the cache right away, as Snapshot does
+      using Helper_t = TDFInternal::CompressedCacheHelper<BranchTypes...>;
+      using Action_t = TDFInternal::TAction<Helper_t, Proxied>;
+      std::shared_ptr<TDFInternal::TActionBase> actionPtr(
+         new Action_t(Helper_t(*cache, fProxiedPtr->GetNSlots(), options.fChunkSize), validCols, *fProxiedPtr));
+      df->Book(std::move(actionPtr));
+      df->Run();
+
+      TInterface<TLoopManager> cachedTDF(std::make_shared<TLoopManager>(std::move(cache), ColumnNames_t{}));
+      return cachedTDF;
+   }
+
 protected:
    /// Get the TLoopManager if reachable. If not, throw.
    std::shared_ptr<TLoopManager> GetDataFrameChecked()
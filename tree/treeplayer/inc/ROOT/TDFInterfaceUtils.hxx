@@ -349,6 +349,8 @@ ColumnNames_t GetBranchNames(TTree &t);
 void CheckCustomColumn(std::string_view definedCol, TTree *treePtr, const ColumnNames_t &customCols,
                        const ColumnNames_t &dataSourceColumns);
 
+void CheckBatchColumns(const ColumnNames_t &columns, TTree *treePtr, const ColumnNames_t &customCols);
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Check preconditions for TInterface::Aggregate:
 /// - the aggregator callable must have signature `U(U,T)` or `void(U&,T)`.
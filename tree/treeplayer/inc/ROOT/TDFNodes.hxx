@@ -13,6 +13,7 @@
 
 #include "ROOT/TypeTraits.hxx"
 #include "ROOT/TCutFlowReport.hxx"
+#include "ROOT/TProfileReport.hxx"
 #include "ROOT/TDataSource.hxx"
 #include "ROOT/TDFNodesUtils.hxx"
 #include "ROOT/TDFUtils.hxx"
@@ -22,7 +23,9 @@
 #include "TTreeReaderValue.h"
 #include "TError.h"
 
+#include <chrono>
 #include <map>
+#include <memory>
 #include <numeric> // std::accumulate (FillReport), std::iota (TSlotStack)
 #include <string>
 #include <tuple>
@@ -30,6 +33,12 @@
 #include <climits>
 #include <deque> // std::vector substitute in case of vector<bool>
 #include <functional>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
+class TTree;
+class TTreeReader;
 
 namespace ROOT {
 namespace Internal {
@@ -62,6 +71,164 @@ public:
    void ReturnSlot(unsigned int slotNumber);
    unsigned int GetSlot();
 };
+
+/// Profiling counters of a processing slot, see TLoopManager::EnableProfiling
+struct TSlotProfile : public ROOT::Experimental::TDF::TSlotProfileInfo {
+   double fNested = 0.; ///< Time of the scopes timed by a TProfileTimer nested in the current one
+};
+
+/// Number of calls and time spent in a node, for one slot. Padded to limit the false sharing between slots.
+struct TNodeSlotProfile {
+   double fTime = 0.;
+   ULong64_t fCalls = 0ULL;
+   char fPadding[48];
+};
+
+/// Profiling counters of a node of the computation graph
+struct TNodeProfile {
+   const std::string fKind;
+   const std::string fName;
+   std::vector<TSlotProfile> &fSlots; ///< The counters of the slots of the loop manager
+   std::vector<TNodeSlotProfile> fNodeSlots;
+   TNodeProfile(const std::string &kind, const std::string &name, std::vector<TSlotProfile> &slots)
+      : fKind(kind), fName(name), fSlots(slots), fNodeSlots(slots.size())
+   {
+   }
+};
+
+/// The profile of the event loops of a TLoopManager
+struct TLoopProfile {
+   std::vector<TSlotProfile> fSlots;
+   std::vector<std::unique_ptr<TNodeProfile>> fNodes;      ///< In the order the nodes were first profiled
+   std::map<const void *, TNodeProfile *> fNodeProfiles; ///< Counters of the filters and custom columns
+   double fLoopTime = 0.;
+   unsigned int fNLoops = 0;
+   TLoopProfile(unsigned int nSlots) : fSlots(nSlots) {}
+};
+
+/// Add the wall-clock time elapsed during its lifetime to a counter, minus the time of the timers nested in it.
+/// A timer built with a null node profile does nothing.
+class TProfileTimer {
+   TSlotProfile *fSlot = nullptr;
+   double *fCounter = nullptr;
+   double fOuterNested = 0.;
+   std::chrono::steady_clock::time_point fStart;
+
+public:
+   TProfileTimer(TSlotProfile &slot, double &counter) : fSlot(&slot), fCounter(&counter), fOuterNested(slot.fNested)
+   {
+      fSlot->fNested = 0.;
+      fStart = std::chrono::steady_clock::now();
+   }
+   TProfileTimer(TNodeProfile *node, unsigned int slot)
+   {
+      if (!node)
+         return;
+      fSlot = &node->fSlots[slot];
+      fCounter = &node->fNodeSlots[slot].fTime;
+      ++node->fNodeSlots[slot].fCalls;
+      fOuterNested = fSlot->fNested;
+      fSlot->fNested = 0.;
+      fStart = std::chrono::steady_clock::now();
+   }
+   TProfileTimer(const TProfileTimer &) = delete;
+   TProfileTimer &operator=(const TProfileTimer &) = delete;
+   ~TProfileTimer()
+   {
+      if (!fSlot)
+         return;
+      const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - fStart).count();
+      *fCounter += elapsed - fSlot->fNested;
+      fSlot->fNested = fOuterNested + elapsed;
+   }
+};
+
+/// The name of an action in the profile of the event loops: the name of its helper without the `Helper` suffix,
+/// followed by its columns.
+std::string GetActionProfileName(const std::type_info &helperType, const ColumnNames_t &columns);
+/// The name of a filter in the profile of the event loops: its name or, for unnamed filters, its columns.
+std::string GetFilterProfileName(const std::string &name, const ColumnNames_t &columns);
+
+/// Return the tree currently loaded by the reader and its current entry, local to that tree.
+TTree *GetBatchTree(TTreeReader &r, Long64_t &entry);
+/// Return the entry ending the batch starting at entry: the end of its cluster, at most kMaxBatchSize entries later.
+Long64_t GetBatchEnd(TTree &tree, Long64_t entry);
+/// Read the values of n entries of a column from first into buffer, checking that the column is a top-level branch
+/// holding a single value of the basic type `type`.
+void ReadBatchColumn(TTree &tree, const std::string &column, const std::type_info &type, unsigned int typeSize,
+                     Long64_t first, Long64_t n, void *buffer);
+/// Throw if the result of a batch kernel does not have one value per entry of the batch.
+void CheckBatchResultSize(const std::string &nodeName, std::size_t size, Long64_t expected);
+
+template <typename T>
+void ReadBatchColumn(TTree &tree, const std::string &column, Long64_t first, Long64_t n, std::vector<T> &values)
+{
+   static_assert(!std::is_same<T, bool>::value, "batches of Bool_t columns must be read as std::vector<char>");
+   values.resize(n);
+   ReadBatchColumn(tree, column, typeid(T), sizeof(T), first, n, values.data());
+}
+
+/// Values of the input columns of a batch transformation (DefineBatch, FilterBatch) for a batch of consecutive entries
+/// of the current tree, per slot. The values of each column are stored in a `std::vector`: ColTypeList is the list of
+/// these vector types. A batch spans from the first entry requested to the end of its cluster.
+template <typename ColTypeList>
+class TColumnBatches;
+
+template <typename... ColTypes>
+class TColumnBatches<ROOT::TypeTraits::TypeList<ColTypes...>> {
+   struct TSlotBatch {
+      TTreeReader *fReader = nullptr;
+      TTree *fTree = nullptr; ///< Tree the batch was read from
+      Long64_t fFirst = 0;    ///< First entry of the batch, local to fTree
+      Long64_t fSize = 0;     ///< Number of entries in the batch
+      std::tuple<ColTypes...> fValues;
+   };
+
+   const ColumnNames_t fColumns;
+   std::vector<TSlotBatch> fBatches;
+
+   template <int... S>
+   void Read(TSlotBatch &batch, StaticSeq<S...>)
+   {
+      std::initializer_list<int> expander{
+         (ReadBatchColumn(*batch.fTree, fColumns[S], batch.fFirst, batch.fSize, std::get<S>(batch.fValues)), 0)...};
+      (void)expander; // avoid "unused variable" warnings for expander on gcc4.9
+   }
+
+public:
+   TColumnBatches(const ColumnNames_t &columns, unsigned int nSlots) : fColumns(columns), fBatches(nSlots) {}
+
+   void InitSlot(TTreeReader *r, unsigned int slot)
+   {
+      if (!r)
+         throw std::runtime_error("Batch transformations can only read the columns of a TTree or TChain");
+      fBatches[slot] = TSlotBatch();
+      fBatches[slot].fReader = r;
+   }
+
+   void ClearSlot(unsigned int slot) { fBatches[slot] = TSlotBatch(); }
+
+   /// Return the position of the current entry of the slot in its batch. If the entry is not part of the current
+   /// batch, the batch starting at the entry is read and isNew is set to true.
+   Long64_t GetPosition(unsigned int slot, bool &isNew)
+   {
+      auto &batch = fBatches[slot];
+      Long64_t entry = 0;
+      TTree *tree = GetBatchTree(*batch.fReader, entry);
+      isNew = tree != batch.fTree || entry < batch.fFirst || entry >= batch.fFirst + batch.fSize;
+      if (isNew) {
+         batch.fTree = tree;
+         batch.fFirst = entry;
+         batch.fSize = GetBatchEnd(*tree, entry) - entry;
+         Read(batch, GenStaticSeq_t<sizeof...(ColTypes)>());
+      }
+      return entry - batch.fFirst;
+   }
+
+   Long64_t GetSize(unsigned int slot) const { return fBatches[slot].fSize; }
+   const ColumnNames_t &GetColumns() const { return fColumns; }
+   const std::tuple<ColTypes...> &GetValues(unsigned int slot) const { return fBatches[slot].fValues; }
+};
 }
 }
 
@@ -149,6 +316,10 @@ class TLoopManager : public std::enable_shared_from_this<TLoopManager> {
    std::map<std::string, std::string> fAliasColumnNameMap; ///< ColumnNameAlias-columnName pairs
    std::vector<TCallback> fCallbacks;                      ///< Registered callbacks
    std::vector<TOneTimeCallback> fCallbacksOnce; ///< Registered callbacks to invoke just once before running the loop
+   std::vector<TLoopManager *> fJoinedLoops; ///< Other graphs run in the same event loop as this one, see RunJointly
+   std::pair<Long64_t, Long64_t> fEntriesRange{0, -1}; ///< Entries of fTree read by the loop, see SetEntriesRange
+   std::unique_ptr<TDFInternal::TLoopProfile> fProfile; ///< Profile of the event loops, see EnableProfiling
+   bool fIsProfiling{false};                            ///< Whether the event loops are profiled
 
    void RunEmptySourceMT();
    void RunEmptySource();
@@ -157,12 +328,19 @@ class TLoopManager : public std::enable_shared_from_this<TLoopManager> {
    void RunDataSourceMT();
    void RunDataSource();
    void RunAndCheckFilters(unsigned int slot, Long64_t entry);
+   bool ReadNextEntry(TTreeReader &r, unsigned int slot);
+   void SetDataSourceEntry(unsigned int slot, ULong64_t entry);
    void InitNodeSlots(TTreeReader *r, unsigned int slot);
    void InitNodes();
+   void InitNodeProfiles();
+   /// The profile to fill during the event loop, null if the event loop is not profiled
+   TDFInternal::TLoopProfile *GetActiveProfile() const { return fIsProfiling ? fProfile.get() : nullptr; }
    void CleanUpNodes();
    void CleanUpTask(unsigned int slot);
    void JitActions();
    void EvalChildrenCounts();
+   bool HasEntriesToProcess() const;
+   bool HasSameSource(const TLoopManager &other) const;
 
 public:
    TLoopManager(TTree *tree, const ColumnNames_t &defaultBranches);
@@ -172,6 +350,8 @@ public:
    TLoopManager &operator=(const TLoopManager &) = delete;
 
    void Run();
+   void RunJointly(const std::vector<TLoopManager *> &others);
+   void SetEntriesRange(Long64_t begin, Long64_t end);
    TLoopManager *GetImplPtr();
    std::shared_ptr<TLoopManager> GetSharedPtr() { return shared_from_this(); }
    const ColumnNames_t &GetDefaultColumnNames() const;
@@ -202,6 +382,9 @@ public:
    void AddColumnAlias(const std::string &alias, const std::string &colName) { fAliasColumnNameMap[alias] = colName; }
    const std::map<std::string, std::string> &GetAliasMap() const { return fAliasColumnNameMap; }
    void RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f);
+   void EnableProfiling(bool enable);
+   bool IsProfiling() const { return fIsProfiling; }
+   ROOT::Experimental::TDF::TProfileReport GetProfileReport() const;
 };
 } // end ns TDF
 } // end ns Detail
@@ -210,6 +393,9 @@ namespace Internal {
 namespace TDF {
 using namespace ROOT::Detail::TDF;
 
+/// Run the event loops of the loop managers, which must read the same data, in a single pass. Null pointers are ignored.
+void RunLoopsJointly(const std::vector<std::shared_ptr<TLoopManager>> &loops);
+
 /**
 \class ROOT::Internal::TDF::TColumnValue
 \ingroup dataframe
@@ -357,6 +543,7 @@ protected:
                                /// graph. It is only guaranteed to contain a valid address during an
                                /// event loop.
    const unsigned int fNSlots; ///< Number of thread slots used by this node.
+   TNodeProfile *fProfile = nullptr; ///< Profiling counters, null if the event loop is not profiled
 
 public:
    TActionBase(TLoopManager *implPtr, const unsigned int nSlots);
@@ -372,6 +559,8 @@ public:
    /// This method is invoked to update a partial result during the event loop, right before passing the result to a
    /// user-defined callback registered via TResultProxy::RegisterCallback
    virtual void *PartialUpdate(unsigned int slot) = 0;
+   virtual std::string GetProfileName() const = 0;
+   void SetProfile(TNodeProfile *profile) { fProfile = profile; }
 };
 
 template <typename Helper, typename PrevDataFrame, typename BranchTypes_t = typename Helper::BranchTypes_t>
@@ -404,8 +593,10 @@ public:
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevData.CheckFilters(slot, entry))
+      if (fPrevData.CheckFilters(slot, entry)) {
+         TProfileTimer timer(fProfile, slot);
          Exec(slot, entry, TypeInd_t());
+      }
    }
 
    template <int... S>
@@ -424,6 +615,8 @@ public:
    /// TODO the PartialUpdateImpl trick can go away once all action helpers will implement PartialUpdate
    void *PartialUpdate(unsigned int slot) final { return PartialUpdateImpl(slot); }
 
+   std::string GetProfileName() const final { return GetActionProfileName(typeid(Helper), fBranches); }
+
 private:
    // this overload is SFINAE'd out if Helper does not implement `PartialUpdate`
    // the template parameter is required to defer instantiation of the method to SFINAE time
@@ -452,6 +645,7 @@ protected:
    const unsigned int fNSlots;      ///< number of thread slots used by this node, inherited from parent node.
    const bool fIsDataSourceColumn; ///< does the custom column refer to a data-source column? (or a user-define column?)
    std::vector<Long64_t> fLastCheckedEntry;
+   TDFInternal::TNodeProfile *fProfile = nullptr; ///< Profiling counters, null if the event loop is not profiled
 
 public:
    TCustomColumnBase(TLoopManager *df, std::string_view name, const unsigned int nSlots, const bool isDSColumn);
@@ -468,6 +662,7 @@ public:
    unsigned int GetNSlots() const { return fNSlots; }
    bool IsDataSourceColumn() const { return fIsDataSourceColumn; }
    void InitNode();
+   void SetProfile(TDFInternal::TNodeProfile *profile) { fProfile = profile; }
 };
 
 namespace TCCHelperTypes {
@@ -527,6 +722,7 @@ public:
    {
       if (entry != fLastCheckedEntry[slot]) {
          // evaluate this filter, cache the result
+         TDFInternal::TProfileTimer timer(fProfile, slot);
          UpdateHelper(slot, entry, TypeInd_t(), BranchTypes_t(), (UPDATE_HELPER_TYPE *)nullptr);
          fLastCheckedEntry[slot] = entry;
       }
@@ -582,6 +778,7 @@ protected:
    unsigned int fNChildren{0};      ///< Number of nodes of the functional graph hanging from this object
    unsigned int fNStopsReceived{0}; ///< Number of times that a children node signaled to stop processing entries.
    const unsigned int fNSlots;      ///< Number of thread slots used by this node, inherited from parent node.
+   TDFInternal::TNodeProfile *fProfile = nullptr; ///< Profiling counters, null if the event loop is not profiled
 
 public:
    TFilterBase(TLoopManager *df, std::string_view name, const unsigned int nSlots);
@@ -613,6 +810,8 @@ public:
    }
    virtual void ClearValueReaders(unsigned int slot) = 0;
    void InitNode();
+   virtual std::string GetProfileName() const = 0;
+   void SetProfile(TDFInternal::TNodeProfile *profile) { fProfile = profile; }
 };
 
 template <typename FilterF, typename PrevDataFrame>
@@ -643,6 +842,7 @@ public:
             fLastResult[slot] = false;
          } else {
             // evaluate this filter, cache the result
+            TDFInternal::TProfileTimer timer(fProfile, slot);
             auto passed = CheckFilterHelper(slot, entry, TypeInd_t());
             passed ? ++fAccepted[slot] : ++fRejected[slot];
             fLastResult[slot] = passed;
@@ -698,6 +898,169 @@ public:
    }
 
    virtual void ClearValueReaders(unsigned int slot) final { ResetTDFValueTuple(fValues[slot], TypeInd_t()); }
+
+   std::string GetProfileName() const final { return TDFInternal::GetFilterProfileName(fName, fBranches); }
+};
+
+/// Custom column computed by a kernel for a whole batch of consecutive entries, see TInterface::DefineBatch.
+template <typename F>
+class TBatchCustomColumn final : public TCustomColumnBase {
+   using ColTypes_t = typename CallableTraits<F>::arg_types;
+   using TypeInd_t = TDFInternal::GenStaticSeq_t<ColTypes_t::list_size>;
+   using Results_t = typename CallableTraits<F>::ret_type;
+   using ret_type = typename Results_t::value_type;
+   // Avoid instantiating vector<bool> as `operator[]` returns temporaries in that case. Use std::deque instead.
+   using ValuesPerSlot_t =
+      typename std::conditional<std::is_same<ret_type, bool>::value, std::deque<ret_type>, std::vector<ret_type>>::type;
+
+   F fKernel;
+   TDFInternal::TColumnBatches<ColTypes_t> fBatches;
+   std::vector<Results_t> fResults;
+   ValuesPerSlot_t fLastResults;
+
+   template <int... S>
+   Results_t CallKernel(unsigned int slot, TDFInternal::StaticSeq<S...>)
+   {
+      return fKernel(std::get<S>(fBatches.GetValues(slot))...);
+      // silence "unused parameter" warnings in gcc
+      (void)slot;
+   }
+
+public:
+   TBatchCustomColumn(std::string_view name, F &&kernel, const ColumnNames_t &bl, TLoopManager *lm)
+      : TCustomColumnBase(lm, name, lm->GetNSlots(), false), fKernel(std::move(kernel)), fBatches(bl, fNSlots),
+        fResults(fNSlots), fLastResults(fNSlots)
+   {
+   }
+
+   TBatchCustomColumn(const TBatchCustomColumn &) = delete;
+   TBatchCustomColumn &operator=(const TBatchCustomColumn &) = delete;
+
+   void InitSlot(TTreeReader *r, unsigned int slot) final { fBatches.InitSlot(r, slot); }
+
+   void *GetValuePtr(unsigned int slot) final { return static_cast<void *>(&fLastResults[slot]); }
+
+   void Update(unsigned int slot, Long64_t entry) final
+   {
+      if (entry != fLastCheckedEntry[slot]) {
+         TDFInternal::TProfileTimer timer(fProfile, slot);
+         bool isNew = false;
+         const auto pos = fBatches.GetPosition(slot, isNew);
+         if (isNew) {
+            // evaluate the kernel for the whole batch, cache the results
+            fResults[slot] = CallKernel(slot, TypeInd_t());
+            TDFInternal::CheckBatchResultSize(fName, fResults[slot].size(), fBatches.GetSize(slot));
+         }
+         fLastResults[slot] = fResults[slot][pos];
+         fLastCheckedEntry[slot] = entry;
+      }
+   }
+
+   const std::type_info &GetTypeId() const { return typeid(ret_type); }
+
+   void ClearValueReaders(unsigned int slot) final
+   {
+      fBatches.ClearSlot(slot);
+      fResults[slot] = Results_t();
+   }
+};
+
+/// Filter evaluated by a kernel for a whole batch of consecutive entries, see TInterface::FilterBatch.
+template <typename FilterF, typename PrevDataFrame>
+class TBatchFilter final : public TFilterBase {
+   using ColTypes_t = typename CallableTraits<FilterF>::arg_types;
+   using TypeInd_t = TDFInternal::GenStaticSeq_t<ColTypes_t::list_size>;
+   using Mask_t = typename CallableTraits<FilterF>::ret_type;
+
+   FilterF fFilter;
+   PrevDataFrame &fPrevData;
+   TDFInternal::TColumnBatches<ColTypes_t> fBatches;
+   std::vector<Mask_t> fMasks;
+
+   template <int... S>
+   Mask_t CallKernel(unsigned int slot, TDFInternal::StaticSeq<S...>)
+   {
+      return fFilter(std::get<S>(fBatches.GetValues(slot))...);
+      // silence "unused parameter" warnings in gcc
+      (void)slot;
+   }
+
+public:
+   TBatchFilter(FilterF &&f, const ColumnNames_t &bl, PrevDataFrame &pd, std::string_view name = "")
+      : TFilterBase(pd.GetImplPtr(), name, pd.GetNSlots()), fFilter(std::move(f)), fPrevData(pd),
+        fBatches(bl, fNSlots), fMasks(fNSlots)
+   {
+   }
+
+   TBatchFilter(const TBatchFilter &) = delete;
+   TBatchFilter &operator=(const TBatchFilter &) = delete;
+
+   bool CheckFilters(unsigned int slot, Long64_t entry) final
+   {
+      if (entry != fLastCheckedEntry[slot]) {
+         if (!fPrevData.CheckFilters(slot, entry)) {
+            // a filter upstream returned false, cache the result
+            fLastResult[slot] = false;
+         } else {
+            // evaluate this filter for the whole batch if needed, cache the result
+            TDFInternal::TProfileTimer timer(fProfile, slot);
+            bool isNew = false;
+            const auto pos = fBatches.GetPosition(slot, isNew);
+            if (isNew) {
+               fMasks[slot] = CallKernel(slot, TypeInd_t());
+               TDFInternal::CheckBatchResultSize(fName, fMasks[slot].size(), fBatches.GetSize(slot));
+            }
+            const bool passed = fMasks[slot][pos];
+            passed ? ++fAccepted[slot] : ++fRejected[slot];
+            fLastResult[slot] = passed;
+         }
+         fLastCheckedEntry[slot] = entry;
+      }
+      return fLastResult[slot];
+   }
+
+   void InitSlot(TTreeReader *r, unsigned int slot) final { fBatches.InitSlot(r, slot); }
+
+   // recursive chain of `Report`s
+   void Report(ROOT::Experimental::TDF::TCutFlowReport &rep) const final { PartialReport(rep); }
+
+   void PartialReport(ROOT::Experimental::TDF::TCutFlowReport &rep) const final
+   {
+      fPrevData.PartialReport(rep);
+      FillReport(rep);
+   }
+
+   void StopProcessing() final
+   {
+      ++fNStopsReceived;
+      if (fNStopsReceived == fNChildren)
+         fPrevData.StopProcessing();
+   }
+
+   void IncrChildrenCount() final
+   {
+      ++fNChildren;
+      // propagate "children activation" upstream. named filters do the propagation via `TriggerChildrenCount`.
+      if (fNChildren == 1 && fName.empty())
+         fPrevData.IncrChildrenCount();
+   }
+
+   void TriggerChildrenCount() final
+   {
+      assert(!fName.empty()); // this method is to only be called on named filters
+      fPrevData.IncrChildrenCount();
+   }
+
+   void ClearValueReaders(unsigned int slot) final
+   {
+      fBatches.ClearSlot(slot);
+      fMasks[slot] = Mask_t();
+   }
+
+   std::string GetProfileName() const final
+   {
+      return TDFInternal::GetFilterProfileName(fName, fBatches.GetColumns());
+   }
 };
 
 class TRangeBase {
@@ -20,6 +20,7 @@
 #include "TTreeReaderValue.h"
 
 #include <array>
+#include <chrono>
 #include <deque>
 #include <functional>
 #include <memory>
@@ -93,6 +94,31 @@ char TypeName2ROOTTypeName(const std::string &b);
 
 unsigned int GetNSlots();
 
+/// Wall-clock time spent in this process jitting the code of TDataFrame string expressions and
+/// actions, see TDataFrame::PrintJitReport.
+struct TJitTimes {
+   double fValidation = 0.;           ///< Declaring the string expressions to check they are valid C++
+   double fTransformations = 0.;      ///< Jitting the calls to Filter and Define for the string expressions
+   double fCacheBuild = 0.;           ///< Compiling new entries of the jit cache
+   double fCacheLoad = 0.;            ///< Loading existing entries of the jit cache
+   double fActions = 0.;              ///< Jitting the actions with inferred column types
+   unsigned int fNExpressions = 0;    ///< Number of string expressions
+   unsigned int fNCacheHits = 0;      ///< Number of string expressions taken from the jit cache
+   unsigned int fNCacheBuilds = 0;    ///< Number of string expressions compiled into the jit cache
+};
+
+TJitTimes &GetJitTimes();
+
+/// Add the wall-clock time elapsed during its lifetime to one of the TJitTimes counters
+class TJitTimer {
+   double &fCounter;
+   std::chrono::steady_clock::time_point fStart;
+
+public:
+   TJitTimer(double &counter) : fCounter(counter), fStart(std::chrono::steady_clock::now()) {}
+   ~TJitTimer();
+};
+
 /// `type` is TypeList if MustRemove is false, otherwise it is a TypeList with the first type removed
 template <bool MustRemove, typename TypeList>
 struct RemoveFirstParameterIf {
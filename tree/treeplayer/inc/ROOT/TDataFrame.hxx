@@ -39,10 +39,14 @@ namespace Experimental {
 namespace TDFDetail = ROOT::Detail::TDF;
 namespace TDFInternal = ROOT::Internal::TDF;
 namespace TTraits = ROOT::TypeTraits;
+namespace TDF {
+class TProcessRunner;
+}
 
 class TDataFrame : public TDF::TInterface<TDFDetail::TLoopManager> {
    using ColumnNames_t = TDFDetail::ColumnNames_t;
    using TDataSource = ROOT::Experimental::TDF::TDataSource;
+   friend class TDF::TProcessRunner; // restricts the event loops of the workers to their ranges of entries
 
 public:
    TDataFrame(std::string_view treeName, std::string_view filenameglob, const ColumnNames_t &defaultBranches = {});
@@ -52,6 +56,8 @@ public:
    TDataFrame(TTree &tree, const ColumnNames_t &defaultBranches = {});
    TDataFrame(ULong64_t numEntries);
    TDataFrame(std::unique_ptr<TDataSource>, const ColumnNames_t &defaultBranches = {});
+
+   static void PrintJitReport();
 };
 
 } // end NS Experimental
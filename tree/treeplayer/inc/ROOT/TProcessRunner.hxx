@@ -0,0 +1,152 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TPROCESSRUNNER
+#define ROOT_TPROCESSRUNNER
+
+#include "ROOT/TDataFrame.hxx"
+#include "ROOT/TResultProxy.hxx"
+#include "ROOT/TTreeProcessorMP.hxx"
+#include "TList.h"
+#include "TNamed.h"
+#include "TParameter.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace TDF {
+/// The type of the TParameter carrying an arithmetic result between processes
+template <typename T>
+using MergeableValue_t = typename std::conditional<
+   std::is_same<T, bool>::value, Bool_t,
+   typename std::conditional<std::is_floating_point<T>::value, Double_t, Long64_t>::type>::type;
+
+template <typename T>
+TObject *MakeMergeable(const std::string &name, T &result, char, std::true_type /*isTNamed*/)
+{
+   auto obj = static_cast<T *>(result.Clone());
+   obj->SetName(name.c_str());
+   return obj;
+}
+
+template <typename T>
+TObject *MakeMergeable(const std::string &name, T &result, char mergeMode, std::false_type /*isTNamed*/)
+{
+   return new TParameter<MergeableValue_t<T>>(name.c_str(), result, mergeMode);
+}
+} // ns TDF
+} // ns Internal
+
+namespace Experimental {
+namespace TDF {
+class TProcessRunner;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The results of a computation graph run by a TProcessRunner
+///
+/// In the worker processes, the results of the graph are booked with a name. The TProcessRunner merges the
+/// results of all the workers, which can then be retrieved by name.
+/// The supported results are the objects inheriting from TNamed, e.g. the histograms, merged with their `Merge`
+/// method, and the arithmetic values, e.g. the results of Count, Sum, Min, Max and Reduce, merged according to
+/// the merge mode of TParameter: '+' (sum, the default), '*' (product), 'm' (minimum) or 'M' (maximum).
+class TDistributedResults {
+   friend class TProcessRunner;
+   std::vector<std::string> fNames;                   ///< Names of the booked results
+   std::vector<std::function<TObject *()>> fMakers;   ///< Produce the booked results, in the workers
+   std::unique_ptr<TList> fResults;                   ///< The merged results, in the client
+
+   TList *MakeList();
+   void Merge(const TList &results);
+   TObject *FindResult(const std::string &name) const;
+
+public:
+   TDistributedResults() = default;
+   TDistributedResults(TDistributedResults &&) = default;
+   TDistributedResults &operator=(TDistributedResults &&) = default;
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Book a result of the computation graph, to be merged across the workers
+   /// \param[in] name The name used to retrieve the merged result.
+   /// \param[in] result The result proxy.
+   /// \param[in] mergeMode How arithmetic results are merged, ignored for objects.
+   template <typename T>
+   void Book(const std::string &name, TResultProxy<T> result, char mergeMode = '+')
+   {
+      using IsTNamed_t = std::is_base_of<TNamed, T>;
+      static_assert(IsTNamed_t::value || std::is_arithmetic<T>::value,
+                    "Only the results inheriting from TNamed or of arithmetic types can be merged.");
+      if (std::find(fNames.begin(), fNames.end(), name) != fNames.end())
+         throw std::runtime_error("A result named " + name + " was already booked.");
+      fNames.emplace_back(name);
+      fMakers.emplace_back([name, result, mergeMode]() mutable {
+         return ROOT::Internal::TDF::MakeMergeable(name, *result, mergeMode, IsTNamed_t());
+      });
+   }
+
+   /// Return a merged result inheriting from TNamed, owned by this object
+   template <typename T>
+   T *GetObject(const std::string &name) const
+   {
+      auto obj = dynamic_cast<T *>(FindResult(name));
+      if (!obj)
+         throw std::runtime_error("The result " + name + " is not of the requested type.");
+      return obj;
+   }
+
+   /// Return a merged arithmetic result
+   template <typename T>
+   T GetValue(const std::string &name) const
+   {
+      auto param = dynamic_cast<TParameter<ROOT::Internal::TDF::MergeableValue_t<T>> *>(FindResult(name));
+      if (!param)
+         throw std::runtime_error("The result " + name + " is not of the requested type.");
+      return param->GetVal();
+   }
+
+   /// Whether a result of this name was received from the workers
+   bool HasResult(const std::string &name) const { return fResults && fResults->FindObject(name.c_str()); }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Run a TDataFrame computation graph in several processes, each reading a part of the dataset
+///
+/// The dataset is partitioned by TTreeProcessorMP, in ranges of entries aligned to the clusters of the trees or
+/// in whole files. Each worker process builds the computation graph on a TDataFrame reading its ranges, runs it
+/// and sends back the booked results, merged by the client as they arrive.
+class TProcessRunner {
+public:
+   using Builder_t = std::function<void(TDataFrame &, TDistributedResults &)>;
+   using Monitor_t = std::function<void(const TDistributedResults &, unsigned int)>;
+
+private:
+   ROOT::TTreeProcessorMP fPool;
+   Monitor_t fMonitor;
+
+public:
+   explicit TProcessRunner(unsigned int nWorkers = 0);
+   TDistributedResults Run(const std::string &treeName, const std::vector<std::string> &fileNames,
+                           const Builder_t &builder);
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Set a function called with the results merged so far, each time a worker sends its results
+   /// The function also receives the number of workers whose results were merged.
+   void SetMonitor(const Monitor_t &monitor) { fMonitor = monitor; }
+   unsigned int GetNWorkers() const { return fPool.GetNWorkers(); }
+};
+
+} // ns TDF
+} // ns Experimental
+} // ns ROOT
+
+#endif
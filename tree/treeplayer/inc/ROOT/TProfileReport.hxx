@@ -0,0 +1,96 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TPROFILEREPORT
+#define ROOT_TPROFILEREPORT
+
+#include "RtypesCore.h"
+#include "ROOT/RStringView.hxx"
+
+#include <string>
+#include <vector>
+
+class TTree;
+
+namespace ROOT {
+
+namespace Detail {
+namespace TDF {
+class TLoopManager;
+} // End NS TDF
+} // End NS Detail
+
+namespace Experimental {
+namespace TDF {
+
+/// Time spent by a processing slot in the event loops, see TProfileReport
+struct TSlotProfileInfo {
+   double fTaskTime = 0.;     ///< Wall-clock time spent processing entries
+   double fReadTime = 0.;     ///< Time spent in TTreeReader::Next or TDataSource::SetEntry
+   ULong64_t fNReads = 0;     ///< Number of calls to TTreeReader::Next or TDataSource::SetEntry
+   double fUnzipTime = 0.;    ///< Time spent decompressing baskets
+   double fFileReadTime = 0.; ///< Time spent reading from the files
+   Long64_t fBytesRead = 0;   ///< Number of bytes read from the files
+   ULong64_t fNEntries = 0;   ///< Number of entries processed
+};
+
+class TProfileReport;
+
+/// Number of calls and time spent in a node of the computation graph, per slot
+class TNodeProfileInfo {
+   friend class TProfileReport;
+   friend class ROOT::Detail::TDF::TLoopManager;
+
+private:
+   std::string fKind;
+   std::string fName;
+   std::vector<ULong64_t> fCalls;
+   std::vector<double> fTimes;
+
+public:
+   /// `Filter`, `Define` or `Action`
+   const std::string &GetKind() const { return fKind; }
+   /// The name of the filter or column, or the kind and the columns of the action
+   const std::string &GetName() const { return fName; }
+   unsigned int GetNSlots() const { return fTimes.size(); }
+   ULong64_t GetCalls() const;
+   ULong64_t GetCalls(unsigned int slot) const { return fCalls.at(slot); }
+   /// Time spent in the node, in seconds, excluding the time spent in the nodes it calls and in reading the files
+   double GetTime() const;
+   double GetTime(unsigned int slot) const { return fTimes.at(slot); }
+};
+
+class TProfileReport {
+   friend class ROOT::Detail::TDF::TLoopManager;
+
+private:
+   std::vector<TNodeProfileInfo> fNodes;
+   std::vector<TSlotProfileInfo> fSlots;
+   double fLoopTime = 0.;
+   unsigned int fNLoops = 0;
+
+public:
+   void Print() const;
+   std::string AsJSON() const;
+   TTree *AsTree(std::string_view treeName = "profile") const;
+   const TNodeProfileInfo &operator[](std::string_view nodeName) const;
+   std::vector<TNodeProfileInfo>::const_iterator begin() const { return fNodes.begin(); }
+   std::vector<TNodeProfileInfo>::const_iterator end() const { return fNodes.end(); }
+   const std::vector<TSlotProfileInfo> &GetSlots() const { return fSlots; }
+   /// The sum of the counters of all the slots
+   TSlotProfileInfo GetTotals() const;
+   /// Wall-clock time of the profiled event loops, in seconds
+   double GetLoopTime() const { return fLoopTime; }
+   unsigned int GetNLoops() const { return fNLoops; }
+};
+
+} // End NS TDF
+} // End NS Experimental
+} // End NS ROOT
+
+#endif
@@ -17,6 +17,8 @@
 
 #include <memory>
 #include <functional>
+#include <stdexcept>
+#include <vector>
 
 namespace ROOT {
 
@@ -28,6 +30,15 @@ class TResultProxy;
 }
 }
 
+namespace Internal {
+namespace TDF {
+// Fwd decl for RunGraphs
+template <typename T>
+std::shared_ptr<ROOT::Detail::TDF::TLoopManager>
+GetLoopManagerToRun(const ROOT::Experimental::TDF::TResultProxy<T> &r);
+} // ns TDF
+} // ns Internal
+
 namespace Detail {
 namespace TDF {
 using ROOT::Experimental::TDF::TResultProxy;
@@ -81,6 +92,8 @@ class TResultProxy {
    template <typename W>
    friend std::pair<TResultProxy<W>, std::shared_ptr<TDFInternal::TActionBase *>>
    TDFDetail::MakeResultProxy(const std::shared_ptr<W> &, const SPTLM_t &);
+   template <typename W>
+   friend SPTLM_t TDFInternal::GetLoopManagerToRun(const TResultProxy<W> &);
 
    /// \cond HIDDEN_SYMBOLS
    template <typename V, bool isCont = TTraits::IsContainer<V>::value>
@@ -141,6 +154,9 @@ public:
    TResultProxy(const TResultProxy &) = default;
    TResultProxy(TResultProxy &&) = default;
 
+   /// Whether the event loop producing this result has already run.
+   bool IsReady() const { return *fReadiness; }
+
    /// Get a const reference to the encapsulated object.
    /// Triggers event loop and execution of all actions booked in the associated TLoopManager.
    const T &GetValue() { return *Get(); }
@@ -286,9 +302,62 @@ void TResultProxy<T>::TriggerRun()
    }
    df->Run();
 }
+
+// clang-format off
+/// \brief Run the event loops producing several results, possibly of different TDataFrames, in a single pass.
+/// \param[in] results the results to produce
+///
+/// The TDataFrames the results belong to must read the same data: the same TTree, or TChains with the same name and
+/// files, or the same number of entries without a source. Their computation graphs are all executed in one event
+/// loop: the entries are read and uncompressed only once, by one TTreeReader per processing slot, which serves the
+/// columns of all the graphs. This is useful e.g. when systematic variations are studied with independent TDataFrames.
+/// ~~~{.cpp}
+/// TDataFrame nominal("t", "f.root"), varied("t", "f.root");
+/// auto h1 = nominal.Filter("x > 0").Histo1D("y");
+/// auto h2 = varied.Filter("x > 0.1").Histo1D("y");
+/// RunGraphs(h1, h2); // a single event loop fills both histograms
+/// ~~~
+/// Results that are already available are ignored. TDataFrames built on a TDataSource are not supported.
+// clang-format on
+template <typename... Ts>
+void RunGraphs(TResultProxy<Ts> &... results)
+{
+   std::vector<std::shared_ptr<TDFDetail::TLoopManager>> loops{TDFInternal::GetLoopManagerToRun(results)...};
+   TDFInternal::RunLoopsJointly(loops);
+}
+
+/// \brief Run the event loops producing several results, possibly of different TDataFrames, in a single pass.
+/// \param[in] results the results to produce
+///
+/// See the variadic overload for the details.
+template <typename T>
+void RunGraphs(std::vector<TResultProxy<T>> &results)
+{
+   std::vector<std::shared_ptr<TDFDetail::TLoopManager>> loops;
+   for (auto &result : results)
+      loops.emplace_back(TDFInternal::GetLoopManagerToRun(result));
+   TDFInternal::RunLoopsJointly(loops);
+}
 } // end NS TDF
 } // end NS Experimental
 
+namespace Internal {
+namespace TDF {
+/// Return the TLoopManager that must run to produce the result, or a null pointer if the result is ready
+template <typename T>
+std::shared_ptr<ROOT::Detail::TDF::TLoopManager>
+GetLoopManagerToRun(const ROOT::Experimental::TDF::TResultProxy<T> &r)
+{
+   if (*r.fReadiness)
+      return nullptr;
+   auto lm = r.fImplWeakPtr.lock();
+   if (!lm)
+      throw std::runtime_error("The main TDataFrame is not reachable: did it go out of scope?");
+   return lm;
+}
+} // end NS TDF
+} // end NS Internal
+
 namespace Detail {
 namespace TDF {
 /// Create a TResultProxy and set its pointer to the corresponding TAction
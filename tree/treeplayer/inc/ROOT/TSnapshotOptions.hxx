@@ -34,6 +34,7 @@ struct TSnapshotOptions {
    int fCompressionLevel = 1;                  //< Compression level of output file
    int fAutoFlush = 0;                         //< AutoFlush value for output tree
    int fSplitLevel = 99;                       //< Split level of output tree
+   bool fPreserveClusterOrder = false;         //< In multi-thread runs, write the entries in the input order
 };
 }
 }
@@ -162,6 +162,11 @@ public:
    void SetNWorkers(unsigned n) { TMPClient::SetNWorkers(n); }
    unsigned GetNWorkers() const { return TMPClient::GetNWorkers(); }
 
+   /// \brief Set a function called with the result of each worker, as soon as it is received
+   /// The result is still owned by the TTreeProcessorMP, which merges it with the others
+   /// once all the workers are done: the function must not modify or delete it.
+   void SetResultCallback(std::function<void(const TObject &)> f) { fResultCallback = std::move(f); }
+
 private:
    template<class T> void Collect(std::vector<T> &reslist);
    template<class T> void HandlePoolCode(MPCodeBufPair &msg, TSocket *sender, std::vector<T> &reslist);
@@ -183,6 +188,7 @@ private:
    };
 
    ETask fTaskType = ETask::kNoTask; ///< the kind of task that is being executed, if any
+   std::function<void(const TObject &)> fResultCallback; ///< called with each worker result, see SetResultCallback
 };
 
 template<class F>
@@ -220,7 +226,7 @@ auto TTreeProcessorMP::Process(const std::vector<std::string>& fileNames, F proc
       //TTree entry granularity. For each file, we divide entries equally between workers
       fTaskType = ETask::kProcByRange;
       //Tell workers to start processing entries
-      fNToProcess = nWorkers*fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
+      fNToProcess = worker.GetNRanges() * fileNames.size(); // total number of ranges that will be processed by all workers cumulatively
       std::vector<unsigned> args(nWorkers);
       std::iota(args.begin(), args.end(), 0);
       fNProcessed = Broadcast(MPCode::kProcRange, args);
@@ -323,7 +329,7 @@ auto TTreeProcessorMP::Process(TTree& tree, F procFunc, TEntryList &entries,
    fTaskType = ETask::kProcByRange;
 
    //tell workers to start processing entries
-   fNToProcess = nWorkers; //this is the total number of ranges that will be processed by all workers cumulatively
+   fNToProcess = worker.GetNRanges(); //this is the total number of ranges that will be processed by all workers cumulatively
    std::vector<unsigned> args(nWorkers);
    std::iota(args.begin(), args.end(), 0);
    fNProcessed = Broadcast(MPCode::kProcTree, args);
@@ -407,8 +413,11 @@ void TTreeProcessorMP::HandlePoolCode(MPCodeBufPair &msg, TSocket *s, std::vecto
    if (code == MPCode::kIdling) {
       ReplyToIdle(s);
    } else if(code == MPCode::kProcResult) {
-      if(msg.second != nullptr)
+      if(msg.second != nullptr) {
          reslist.push_back(std::move(ReadBuffer<T>(msg.second.get())));
+         if (fResultCallback && reslist.back())
+            fResultCallback(*reslist.back());
+      }
       MPSend(s, MPCode::kShutdownOrder);
    } else if(code == MPCode::kProcError) {
       const char *str = ReadBuffer<const char*>(msg.second.get());
@@ -16,9 +16,11 @@
 #include "TTree.h"
 #include "TFile.h"
 #include "TChain.h"
+#include "TChainElement.h"
 #include "TTreeReader.h"
 #include "TError.h"
 #include "TEntryList.h"
+#include "TTreeCache.h"
 #include "TFriendElement.h"
 #include "ROOT/TThreadedObject.hxx"
 
@@ -61,6 +63,8 @@ namespace ROOT {
          std::vector<std::string> fFileNames;    ///< Names of the files
          std::string fTreeName;                  ///< Name of the tree
          TEntryList fEntryList;                  ///< Entry numbers to be processed
+         std::vector<Long64_t> fFileEntries;     ///< Entries of each file, if known from a manifest of the chain
+         std::vector<std::vector<Long64_t>> fFileClusterStarts; ///< Cluster starts of each file, if known from a manifest
          std::vector<Long64_t> fLoadedEntries;   ///<! Per-task loaded entries (for task interleaving)
          std::vector<NameAlias> fFriendNames;    ///< <name,alias> pairs of the friends of the tree/chain
          std::vector<std::vector<std::string>> fFriendFileNames; ///< Names of the files where friends are stored
@@ -148,6 +152,31 @@ namespace ROOT {
             }
          }
 
+         ////////////////////////////////////////////////////////////////////////////////
+         /// Tell the cache of the tree containing the entries of elist to prefetch only
+         /// the baskets that contain at least one of them.
+         void SetCacheEntrySelection(TEntryList &elist)
+         {
+            if (elist.GetN() == 0 || fChain->LoadTree(elist.GetEntry(0)) < 0)
+               return;
+            auto tree = fChain->GetTree();
+            auto file = tree->GetCurrentFile();
+            if (!file)
+               return;
+            // The cache is created by the first read of the tree, do it now
+            tree->GetClusterIterator(0);
+            auto cache = dynamic_cast<TTreeCache *>(file->GetCacheRead(tree));
+            if (!cache)
+               return;
+            // The cache numbers the entries as its tree, the entry list as the chain
+            const auto offset = cache->GetTree() == fChain.get() ? 0 : fChain->GetTreeOffset()[fChain->GetTreeNumber()];
+            TEntryList selection;
+            for (auto entry = elist.GetEntry(0); entry >= 0; entry = elist.Next()) {
+               selection.Enter(entry - offset);
+            }
+            cache->SetEntrySelection(&selection);
+         }
+
       public:
          //////////////////////////////////////////////////////////////////////////
          /// Constructor based on a file name.
@@ -189,8 +218,12 @@ namespace ROOT {
             if (clRefTChain == tree.IsA()) {
                TObjArray* filelist = dynamic_cast<TChain&>(tree).GetListOfFiles();
                if (filelist->GetEntries() > 0) { 
-                  for (auto f : *filelist)
+                  for (auto f : *filelist) {
                      fFileNames.emplace_back(f->GetTitle());
+                     auto element = static_cast<TChainElement *>(f);
+                     fFileEntries.emplace_back(element->GetEntries());
+                     fFileClusterStarts.emplace_back(element->GetClusterStarts());
+                  }
                   StoreFriends(tree, false);
                   Init();
                }
@@ -219,6 +252,21 @@ namespace ROOT {
          /// \param[in] entries List of entry numbers to process.
          TTreeView(TTree& tree, TEntryList& entries) : TTreeView(tree)
          {
+            if (entries.GetLists()) {
+               // One sub-list per tree of the chain, numbering the entries of its tree:
+               // turn them into entry numbers of the chain.
+               fChain->GetEntries();
+               for (auto i = 0u; i < fFileNames.size(); ++i) {
+                  auto sublist = entries.GetEntryList(fTreeName.c_str(), fFileNames[i].c_str());
+                  if (!sublist)
+                     continue;
+                  const auto offset = fChain->GetTreeOffset()[i];
+                  for (auto entry = sublist->GetEntry(0); entry >= 0; entry = sublist->Next()) {
+                     fEntryList.Enter(offset + entry);
+                  }
+               }
+               return;
+            }
             Long64_t numEntries = entries.GetN();
             for (Long64_t i = 0; i < numEntries; ++i) {
                fEntryList.Enter(entries.GetEntry(i));
@@ -228,7 +276,9 @@ namespace ROOT {
          //////////////////////////////////////////////////////////////////////////
          /// Copy constructor.
          /// \param[in] view Object to copy.
-         TTreeView(const TTreeView &view) : fTreeName(view.fTreeName), fEntryList(view.fEntryList)
+         TTreeView(const TTreeView &view)
+            : fTreeName(view.fTreeName), fEntryList(view.fEntryList), fFileEntries(view.fFileEntries),
+              fFileClusterStarts(view.fFileClusterStarts)
          {
             for (auto& fn : view.fFileNames)
                fFileNames.emplace_back(fn);
@@ -258,12 +308,21 @@ namespace ROOT {
                // TEntryList and SetEntriesRange do not work together (the former has precedence).
                // We need to construct a TEntryList that contains only those entry numbers
                // in our desired range.
+               // Jump directly to the first entry of the range, counting the entries before it.
+               // GetNInRange cannot count them in a list with sub-lists (it returns -1): scan
+               // the list from its first entry then.
                elist.reset(new TEntryList);
-               Long64_t entry = fEntryList.GetEntry(0);
-               do {
-                  if (entry >= start && entry < end) // TODO can quit this loop early when entry >= end
-                     elist->Enter(entry);
-               } while ((entry = fEntryList.Next()) >= 0);
+               const Long64_t nBefore = fEntryList.GetNInRange(0, start);
+               Long64_t entry = fEntryList.GetEntry(nBefore >= 0 ? nBefore : 0);
+               if (nBefore < 0) {
+                  while (entry >= 0 && entry < start)
+                     entry = fEntryList.Next();
+               }
+               while (entry >= 0 && entry < end) {
+                  elist->Enter(entry);
+                  entry = fEntryList.Next();
+               }
+               SetCacheEntrySelection(*elist);
 
                reader.reset(new TTreeReader(fChain.get(), elist.get()));
             } else {
@@ -276,6 +335,15 @@ namespace ROOT {
             return std::make_pair(std::move(reader), std::move(elist));
          }
 
+         //////////////////////////////////////////////////////////////////////////
+         /// Whether there is anything to process in the range of entries [start, end):
+         /// false only if an entry list is set and it has no entries in the range, true
+         /// if the entries in the range cannot be counted.
+         bool HasEntries(Long64_t start, Long64_t end) const
+         {
+            return fEntryList.GetN() == 0 || fEntryList.GetNInRange(start, end) != 0;
+         }
+
          //////////////////////////////////////////////////////////////////////////
          /// Get the filenames for this view.
          const std::vector<std::string> &GetFileNames() const
@@ -283,6 +351,20 @@ namespace ROOT {
             return fFileNames;
          }
 
+         //////////////////////////////////////////////////////////////////////////
+         /// Get the cluster starts of the i-th file and its number of entries, if they
+         /// are known without opening the file (from the manifest the chain was built
+         /// from, see TChain::MakeManifest). Returns false otherwise.
+         bool GetKnownClusters(unsigned i, std::vector<Long64_t> &starts, Long64_t &entries) const
+         {
+            if (i >= fFileClusterStarts.size() || fFileClusterStarts[i].empty() ||
+                fFileEntries[i] == TTree::kMaxEntries)
+               return false;
+            starts = fFileClusterStarts[i];
+            entries = fFileEntries[i];
+            return true;
+         }
+
          //////////////////////////////////////////////////////////////////////////
          /// Get the name of the tree of this view.
          std::string GetTreeName() const
@@ -310,6 +392,7 @@ namespace ROOT {
    class TTreeProcessorMT {
    private:
       ROOT::TThreadedObject<ROOT::Internal::TTreeView> treeView; ///<! Thread-local TreeViews
+      static unsigned int fgTasksPerWorkerHint; ///< Number of tasks per worker the clusters are split into
 
       std::vector<ROOT::Internal::TreeViewCluster> MakeClusters();
    public:
@@ -320,6 +403,9 @@ namespace ROOT {
  
       void Process(std::function<void(TTreeReader&)> func);
 
+      static void SetTasksPerWorkerHint(unsigned int m);
+      static unsigned int GetTasksPerWorkerHint();
+
    };
 
 } // End of namespace ROOT
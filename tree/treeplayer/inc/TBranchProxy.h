@@ -112,6 +112,8 @@ namespace Detail {
 
       TBranchProxy* GetProxy() { return this; }
       const char* GetBranchName() const { return fBranchName; }
+      TBranch *GetBranch() const { return fBranch; }
+      Long64_t GetReadEntry() const { return fDirector ? fDirector->GetReadEntry() : -1; }
 
       void Reset();
 
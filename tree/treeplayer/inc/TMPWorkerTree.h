@@ -44,6 +44,8 @@ public:
    TMPWorkerTree(const TMPWorkerTree &) = delete;
    TMPWorkerTree &operator=(const TMPWorkerTree &) = delete;
 
+   UInt_t GetNRanges() const { return fNWorkers * fNRangesPerWorker; } ///< Number of entry ranges per file or tree
+
 protected:
 
    void         CloseFile();
@@ -65,6 +67,7 @@ protected:
    TFile *fFile;                        ///< last open file
    TEntryList *fEntryList;              ///< entrylist
    ULong64_t fFirstEntry;               ///< first entry to br processed
+   UInt_t fNRangesPerWorker;            ///< number of entry ranges per worker in which each file or tree is split
 
 private:
 
@@ -197,6 +200,12 @@ void TMPWorkerTreeFunc<F>::Process(UInt_t code, MPCodeBufPair &msg)
       return;
    }
 
+   // the range can be empty, e.g. if all its entries belong to the cluster of the previous range
+   if (start == finish) {
+      MPSend(GetSocket(), MPCode::kIdling);
+      return;
+   }
+
    // create a TTreeReader that reads this range of entries
    TTreeReader reader(fTree, enl);
 
@@ -60,6 +60,7 @@ protected:
    Bool_t         fCleanElist;     //  true if original Tree elist must be saved
    Bool_t         fObjEval;        //  true if fVar1 returns an object (or pointer to).
    Long64_t       fCurrentSubEntry; // Current subentry when fSelectMultiple is true. Used to fill TEntryListArray
+   Bool_t         fSelectionApplied; //! true if the entry list of the tree holds the entries passing the selection
 
 protected:
    virtual void      ClearFormula();
@@ -110,7 +111,9 @@ public:
    virtual void      ProcessFill(Long64_t entry);
    virtual void      ProcessFillMultiple(Long64_t entry);
    virtual void      ProcessFillObject(Long64_t entry);
+   virtual Bool_t    ProcessMT(Long64_t firstentry, Long64_t nentries);
    virtual void      SetEstimate(Long64_t n);
+   void              SetSelectionApplied(Bool_t applied = kTRUE) {fSelectionApplied = applied;}
    virtual UInt_t    SplitNames(const TString &varexp, std::vector<TString> &names);
    virtual void      TakeAction();
    virtual void      TakeEstimate();
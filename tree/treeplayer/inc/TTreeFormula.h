@@ -131,6 +131,11 @@ protected:
 
    RealInstanceCache fRealInstanceCache; //! Cache accelerating the GetRealInstance function
 
+   typedef Double_t (*JitFunc_t)(const Double_t *);
+   JitFunc_t            fJitFunc;    //! Compiled version of the expression, called with the values of the leaves
+   Int_t                fJitCounter; //! Number of interpreted evaluations, -1 if the expression cannot be compiled
+   static Bool_t        fgJitEnabled; //! True if the hot formulas are compiled
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -162,6 +167,9 @@ protected:
 
    void              Convert(UInt_t fromVersion);
 
+   Double_t          EvalCompiled(Int_t instance);
+   Bool_t            JitCompile();
+
 private:
    // Not implemented yet
    TTreeFormula(const TTreeFormula&);
@@ -210,6 +218,9 @@ public:
    virtual TTree*      GetTree() const {return fTree;}
    virtual void        UpdateFormulaLeaves();
 
+   static Bool_t       IsJitEnabled() { return fgJitEnabled; }
+   static void         SetJitEnabled(Bool_t enable = kTRUE) { fgJitEnabled = enable; }
+
    ClassDef(TTreeFormula, 10);  //The Tree formula
 };
 
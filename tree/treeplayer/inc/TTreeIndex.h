@@ -25,6 +25,8 @@
 #include "TVirtualIndex.h"
 #include "TTreeFormula.h"
 
+class TDirectory;
+
 class TTreeIndex : public TVirtualIndex {
 
 protected:
@@ -38,6 +40,7 @@ protected:
    TTreeFormula  *fMinorFormula;        //! Pointer to minor TreeFormula
    TTreeFormula  *fMajorFormulaParent;  //! Pointer to major TreeFormula in Parent tree (if any)
    TTreeFormula  *fMinorFormulaParent;  //! Pointer to minor TreeFormula in Parent tree (if any)
+   Long64_t       fLastFriendPos;       //! Position in the index of the last entry found by GetEntryNumberFriend
 
 private:
    TTreeIndex(const TTreeIndex&);            // Not implemented.
@@ -63,9 +66,12 @@ public:
    virtual TTreeFormula  *GetMinorFormula();
    virtual TTreeFormula  *GetMajorFormulaParent(const TTree *parent);
    virtual TTreeFormula  *GetMinorFormulaParent(const TTree *parent);
+   static  TString        GetStandaloneName(const char *treename);
    virtual void           Print(Option_t *option="") const;
+   static  TTreeIndex    *ReadStandalone(const TTree *T, const char *majorname, const char *minorname);
    virtual void           UpdateFormulaLeaves(const TTree *parent);
    virtual void           SetTree(const TTree *T);
+   Int_t                  WriteStandalone(TDirectory *dir = 0) const;
 
    ClassDef(TTreeIndex,2);  //A Tree Index with majorname and minorname.
 };
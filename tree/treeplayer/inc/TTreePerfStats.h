@@ -24,6 +24,9 @@
 #include "TVirtualPerfStats.h"
 #include "TString.h"
 
+#include <map>
+#include <vector>
+
 
 class TBrowser;
 class TFile;
@@ -33,6 +36,7 @@ class TPaveText;
 class TGraphErrors;
 class TGaxis;
 class TText;
+class TH1F;
 class TTreePerfStats : public TVirtualPerfStats {
 
 protected:
@@ -58,6 +62,27 @@ protected:
    TStopwatch   *fWatch;         //TStopwatch pointer
    TGaxis       *fRealTimeAxis;  //pointer to TGaxis object showing real-time
    TText        *fHostInfoText;  //Graphics Text object with the fHostInfo data
+   TH1F         *fReadLatency;   //distribution of the durations of the read calls
+   std::vector<TString>  fBranchNames;      //names of the branches baskets were read from
+   std::vector<Int_t>    fBranchBaskets;    //number of baskets read, per branch
+   std::vector<Long64_t> fBranchZipBytes;   //number of compressed bytes read, per branch
+   std::vector<Long64_t> fBranchUnzipBytes; //number of uncompressed bytes read, per branch
+   std::vector<Double_t> fBranchUnzipTime;  //time spent uncompressing, per branch
+   std::vector<Long64_t> fBranchFillBytes;  //number of bytes serialized by the fills, per branch
+   std::vector<Double_t> fBranchFillTime;   //time spent serializing the entries, streamers included, per branch
+   std::vector<Int_t>    fBranchWriteBaskets;   //number of baskets written, per branch
+   std::vector<Long64_t> fBranchWriteUnzipBytes;//number of uncompressed bytes written, per branch
+   std::vector<Long64_t> fBranchWriteZipBytes;  //number of compressed bytes written, per branch
+   std::vector<Double_t> fBranchZipTime;    //time spent compressing, per branch
+   std::vector<Double_t> fBranchWriteTime;  //time spent writing the baskets to the file, per branch
+   Int_t         fFlushes;       //Number of flushes of the baskets of the tree
+   Double_t      fFlushTime;     //Time spent flushing the baskets
+   TH1F         *fFlushLatency;  //distribution of the durations of the flushes
+   std::map<const TObject*, Int_t> fBranchIndex; //!index of the branches in the vectors above
+
+   Int_t            GetBranchSlot(const char *branchname) const;
+   Int_t            GetBranchIndex(const TObject *branch);
+   void             PrintWrite(Bool_t branches) const;
 
 public:
    TTreePerfStats();
@@ -72,8 +97,26 @@ public:
    virtual Long64_t GetBytesReadExtra() const {return fBytesReadExtra;}
    virtual Double_t GetCpuTime()   const {return fCpuTime;}
    virtual Double_t GetDiskTime()  const {return fDiskTime;}
+   virtual Int_t    GetFlushes() const {return fFlushes;}
+   TH1F            *GetFlushLatency() {return fFlushLatency;}
+   virtual Double_t GetFlushTime() const {return fFlushTime;}
    TGraphErrors    *GetGraphIO()     {return fGraphIO;}
    TGraphErrors    *GetGraphTime()   {return fGraphTime;}
+   TH1F            *GetReadLatency() {return fReadLatency;}
+   const std::vector<TString> &GetBranchNames() const {return fBranchNames;}
+   Int_t            GetBranchBaskets(const char *branchname) const;
+   Long64_t         GetBranchZipBytes(const char *branchname) const;
+   Long64_t         GetBranchUnzipBytes(const char *branchname) const;
+   Double_t         GetBranchUnzipTime(const char *branchname) const;
+   Long64_t         GetBranchFillBytes(const char *branchname) const;
+   Double_t         GetBranchFillTime(const char *branchname) const;
+   Int_t            GetBranchWriteBaskets(const char *branchname) const;
+   Long64_t         GetBranchWriteUnzipBytes(const char *branchname) const;
+   Long64_t         GetBranchWriteZipBytes(const char *branchname) const;
+   Double_t         GetBranchZipTime(const char *branchname) const;
+   Double_t         GetBranchWriteTime(const char *branchname) const;
+   TString          GetBranchStatsJSON() const;
+   TTree           *GetBranchStatsTree(const char *treename = "branchstats") const;
    const char      *GetHostInfo() const{return fHostInfo.Data();}
    const char      *GetName()    const{return fName.Data();}
    virtual Int_t    GetNleaves() const {return fNleaves;}
@@ -95,6 +138,10 @@ public:
    virtual void     FileOpenEvent(TFile *, const char *, Double_t) {}
    virtual void     FileReadEvent(TFile *file, Int_t len, Double_t start);
    virtual void     UnzipEvent(TObject *tree, Long64_t pos, Double_t start, Int_t complen, Int_t objlen);
+   virtual void     BasketReadEvent(TObject *branch, Long64_t pos, Double_t start, Int_t complen, Int_t objlen);
+   virtual void     BranchFillEvent(TObject *branch, Double_t start, Int_t nbytes);
+   virtual void     BasketWriteEvent(TObject *branch, Double_t ziptime, Double_t start, Int_t objlen, Int_t complen);
+   virtual void     FlushEvent(TObject *tree, Double_t start, Int_t nbytes);
    virtual void     RateEvent(Double_t , Double_t , Long64_t , Long64_t) {}
 
    virtual void     SaveAs(const char *filename="",Option_t *option="") const;
@@ -117,7 +164,7 @@ public:
    virtual void     SetTreeCacheSize(Int_t nbytes) {fTreeCacheSize = nbytes;}
    virtual void     SetUnzipTime(Double_t uztime) {fUnzipTime = uztime;}
 
-   ClassDef(TTreePerfStats,6)  // TTree I/O performance measurement
+   ClassDef(TTreePerfStats,8)  // TTree I/O performance measurement
 };
 
 #endif
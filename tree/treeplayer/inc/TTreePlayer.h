@@ -53,17 +53,21 @@ protected:
    TList         *fInput;           //! input list to the selector
    TList         *fFormulaList;     //! Pointer to a list of coordinated list TTreeFormula (used by Scan and Query)
    TSelector     *fSelectorUpdate;  //! Set to the selector address when it's entry list needs to be updated by the UpdateFormulaLeaves function
+   Long64_t       fSelectionCacheSize; //! Maximum size in bytes of the entry lists of the selections kept by DrawSelect
+   TList         *fSelectionCache;  //! Entry lists of the selections evaluated by DrawSelect, most recently used first
 
 protected:
    const   char  *GetNameByIndex(TString &varexp, Int_t *index,Int_t colindex);
    void           TakeAction(Int_t nfill, Int_t &npoints, Int_t &action, TObject *obj, Option_t *option);
    void           TakeEstimate(Int_t nfill, Int_t &npoints, Int_t action, TObject *obj, Option_t *option);
    void           DeleteSelectorFromFile();
+   TEntryList    *GetCachedSelection(const char *selection, Long64_t firstentry, Long64_t nentries);
 
 public:
    TTreePlayer();
    virtual ~TTreePlayer();
    virtual TVirtualIndex *BuildIndex(const TTree *T, const char *majorname, const char *minorname);
+   void              ClearSelectionCache();
    virtual TTree    *CopyTree(const char *selection, Option_t *option
                               ,Long64_t nentries, Long64_t firstentry);
    virtual Long64_t  DrawScript(const char* wrapperPrefix,
@@ -81,6 +85,7 @@ public:
    const char       *GetScanFileName() const {return fScanFileName;}
    TTreeFormula     *GetSelect() const    {return fSelector->GetSelect();}
    virtual Long64_t  GetSelectedRows() const {return fSelectedRows;}
+   Long64_t          GetSelectionCacheSize() const {return fSelectionCacheSize;}
    TSelector        *GetSelector() const {return fSelector;}
    TSelector        *GetSelectorFromFile() const {return fSelectorFromFile;}
    // See TSelectorDraw::GetVar
@@ -123,7 +128,8 @@ public:
    virtual void      SetEstimate(Long64_t n);
    void              SetScanRedirect(Bool_t on=kFALSE) {fScanRedirect = on;}
    void              SetScanFileName(const char *name) {fScanFileName=name;}
-   virtual void      SetTree(TTree *t) {fTree = t;}
+   void              SetSelectionCacheSize(Long64_t maxbytes);
+   virtual void      SetTree(TTree *t) {if (t != fTree) ClearSelectionCache(); fTree = t;}
    virtual void      StartViewer(Int_t ww, Int_t wh);
    virtual Int_t     UnbinnedFit(const char *formula ,const char *varexp, const char *selection,Option_t *option
                                  ,Long64_t nentries, Long64_t firstentry);
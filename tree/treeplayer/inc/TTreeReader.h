@@ -28,6 +28,7 @@
 
 #include <deque>
 #include <iterator>
+#include <utility>
 
 class TDictionary;
 class TDirectory;
@@ -161,6 +162,10 @@ public:
    TTree* GetTree() const { return fTree; }
    TEntryList* GetEntryList() const { return fEntryList; }
 
+   void SetParallelUnzip(Bool_t enable = kTRUE);
+   /// Whether the baskets are unzipped by tasks of the implicit multi-threading pool, see SetParallelUnzip().
+   Bool_t IsParallelUnzip() const { return TestBit(kBitParallelUnzip); }
+
    ///\{ \name Entry setters
 
    /// Move to the next entry (or index of the TEntryList if that is set).
@@ -195,6 +200,10 @@ public:
    ///   load anymore).
    EEntryStatus SetEntriesRange(Long64_t beginEntry, Long64_t endEntry);
 
+   /// Return the range of entries set by SetEntriesRange(); the end is -1 if
+   /// `Next()` reads until the last entry.
+   std::pair<Long64_t, Long64_t> GetEntriesRange() const { return std::make_pair(fBeginEntry, fEndEntry); }
+
    /// Restart a Next() loop from entry 0 (of TEntryList index 0 of fEntryList is set).
    void Restart();
 
@@ -231,11 +240,14 @@ protected:
 
    EEntryStatus SetEntryBase(Long64_t entry, Bool_t local);
 
+   void SetupParallelUnzip(TTree *tree);
+
 private:
 
    enum EStatusBits {
       kBitIsChain = BIT(14), ///< our tree is a chain
-      kBitHaveWarnedAboutEntryListAttachedToTTree = BIT(15) ///< the tree had a TEntryList and we have warned about that
+      kBitHaveWarnedAboutEntryListAttachedToTTree = BIT(15), ///< the tree had a TEntryList and we have warned about that
+      kBitParallelUnzip = BIT(16) ///< the baskets are unzipped by tasks of the implicit multi-threading pool
    };
 
    TTree* fTree = nullptr; ///< tree that's read
@@ -248,6 +260,8 @@ private:
 
    Long64_t fEntry = -1; ///< Current (non-local) entry of fTree or of fEntryList if set.
 
+   Long64_t fBeginEntry = 0LL; ///< The first entry loaded by `Next()`, as set by SetEntriesRange()
+
    /// The end of the entry loop. When set (i.e. >= 0), it provides a way
    /// to stop looping over the TTree when we reach a certain entry: Next()
    /// returns kFALSE when GetCurrentEntry() reaches fEndEntry.
@@ -38,6 +38,13 @@ namespace Internal {
       std::size_t GetSize() const { return fImpl->GetSize(GetProxy()); }
       Bool_t IsEmpty() const { return !GetSize(); }
 
+      /// Read the data members of basic type of split collections column-wise:
+      /// the values are decoded from the baskets into a contiguous array,
+      /// without reading the collection. To be called before the first entry
+      /// is read; other branches are read as usual.
+      void SetColumnar(Bool_t columnar = kTRUE) { fColumnar = columnar; }
+      Bool_t IsColumnar() const { return fColumnar; }
+
       virtual EReadStatus GetReadStatus() const { return fImpl ? fImpl->fReadStatus : kReadError; }
 
    protected:
@@ -46,11 +53,13 @@ namespace Internal {
       bool GetBranchAndLeaf(TBranch* &branch, TLeaf* &myLeaf,
                             TDictionary* &branchActualType);
       void SetImpl(TBranch* branch, TLeaf* myLeaf);
+      bool ColumnarReadable(TBranchElement *branch) const;
       const char* GetBranchContentDataType(TBranch* branch,
                                            TString& contentTypeName,
                                            TDictionary* &dict);
 
       TVirtualCollectionReader* fImpl; // Common interface to collections
+      Bool_t fColumnar = kFALSE; // Read the members of split collections column-wise, if possible
 
       // FIXME: re-introduce once we have ClassDefInline!
       //ClassDef(TTreeReaderArrayBase, 0);//Accessor to member of an object stored in a collection
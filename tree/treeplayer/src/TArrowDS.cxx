@@ -0,0 +1,265 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// clang-format off
+/** \class ROOT::Experimental::TDF::TArrowDS
+    \ingroup dataframe
+    \brief TDataFrame data source class reading Apache Arrow tables.
+
+The TArrowDS class exposes the columns of an `arrow::Table` to TDataFrame. It is available if ROOT was built with
+the `arrow` option.
+
+A TDataFrame that reads an Arrow table can be constructed using the factory method
+ROOT::Experimental::TDF::MakeArrowDataFrame, which accepts the table and, optionally, the names of the columns to
+expose. Parquet files and Arrow IPC streams are read into tables by the Arrow libraries themselves, for instance
+with `parquet::arrow::FileReader::ReadTable`.
+
+The numeric columns are read in place: the values passed to the TDataFrame transformations and actions point
+directly into the Arrow buffers, which are never copied. The supported types are:
+- `uint8`, `int16`, `uint16`, `int32`, `uint32`, `int64`, `uint64`: exposed as `unsigned char`, `short`,
+`unsigned short`, `int`, `unsigned int`, `Long64_t` and `ULong64_t`.
+- `float`, `double`: exposed as `float` and `double`.
+- `bool`: exposed as `bool`. Arrow packs booleans in bits, their values are unpacked entry by entry.
+- `string`: exposed as `std::string`, also copied entry by entry.
+
+Columns containing null values are not supported.
+
+The record batches of the table are the entry ranges processed by the event loop: in multi-thread runs each batch
+is processed by a single task, so the parallelism is bounded by the number of batches of the table.
+*/
+// clang-format on
+
+#include <ROOT/TArrowDS.hxx>
+#include <ROOT/TDFUtils.hxx>
+#include <ROOT/TSeq.hxx>
+#include <ROOT/RMakeUnique.hxx>
+
+#include <arrow/api.h>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace {
+/// Get the type name and, for the columns read in place, the value size of a column. Return false for the
+/// unsupported types.
+bool GetColumnType(const arrow::DataType &type, std::string &typeName, std::size_t &byteWidth)
+{
+   byteWidth = 0;
+   switch (type.id()) {
+   case arrow::Type::UINT8: typeName = "unsigned char"; byteWidth = sizeof(unsigned char); break;
+   case arrow::Type::INT16: typeName = "short"; byteWidth = sizeof(short); break;
+   case arrow::Type::UINT16: typeName = "unsigned short"; byteWidth = sizeof(unsigned short); break;
+   case arrow::Type::INT32: typeName = "int"; byteWidth = sizeof(int); break;
+   case arrow::Type::UINT32: typeName = "unsigned int"; byteWidth = sizeof(unsigned int); break;
+   case arrow::Type::INT64: typeName = "Long64_t"; byteWidth = sizeof(Long64_t); break;
+   case arrow::Type::UINT64: typeName = "ULong64_t"; byteWidth = sizeof(ULong64_t); break;
+   case arrow::Type::FLOAT: typeName = "float"; byteWidth = sizeof(float); break;
+   case arrow::Type::DOUBLE: typeName = "double"; byteWidth = sizeof(double); break;
+   case arrow::Type::BOOL: typeName = "bool"; break;
+   case arrow::Type::STRING: typeName = "std::string"; break;
+   default: return false;
+   }
+   return true;
+}
+} // anonymous namespace
+
+namespace ROOT {
+namespace Experimental {
+namespace TDF {
+
+std::vector<void *> TArrowDS::GetColumnReadersImpl(std::string_view name, const std::type_info &ti)
+{
+   auto &column = fColumns[GetColumnIndex(name)];
+   const auto typeName = ROOT::Internal::TDF::TypeID2TypeName(ti);
+   if (typeName != column.fTypeName) {
+      std::string err = "Column " + std::string(name) + " has type " + column.fTypeName +
+                        " while the id specified is associated to type " + typeName;
+      throw std::runtime_error(err);
+   }
+   column.fRead = true;
+   std::vector<void *> ret;
+   for (auto slot : ROOT::TSeqU(fNSlots))
+      ret.emplace_back((void *)(&column.fValues[slot]));
+   return ret;
+}
+
+TArrowDS::TArrowDS(std::shared_ptr<arrow::Table> table, const std::vector<std::string> &columns)
+   : fTable(std::move(table))
+{
+   if (!fTable)
+      throw std::runtime_error("TArrowDS: the table is null.");
+
+   const auto &schema = *fTable->schema();
+   auto addColumn = [&](int index, bool mustBeSupported) {
+      const auto &field = *schema.field(index);
+      TColumn column;
+      column.fName = field.name();
+      column.fIndex = index;
+      column.fTypeId = field.type()->id();
+      if (!GetColumnType(*field.type(), column.fTypeName, column.fByteWidth)) {
+         if (mustBeSupported)
+            throw std::runtime_error("TArrowDS: column " + column.fName + " has type " + field.type()->ToString() +
+                                     ", which is not supported.");
+         return;
+      }
+      fColNames.emplace_back(column.fName);
+      fColumns.emplace_back(std::move(column));
+   };
+   if (columns.empty()) {
+      for (auto i : ROOT::TSeqI(schema.num_fields()))
+         addColumn(i, false);
+   } else {
+      for (const auto &name : columns) {
+         const auto index = schema.GetFieldIndex(name);
+         if (index < 0)
+            throw std::runtime_error("TArrowDS: the table has no column named " + name + ".");
+         addColumn(index, true);
+      }
+   }
+
+   // Slicing the table in record batches shares the buffers of the columns, nothing is copied
+   arrow::TableBatchReader reader(*fTable);
+   ULong64_t nEntries = 0ULL;
+   while (true) {
+      std::shared_ptr<arrow::RecordBatch> batch;
+      const auto status = reader.ReadNext(&batch);
+      if (!status.ok())
+         throw std::runtime_error("TArrowDS: cannot read the record batches of the table: " + status.ToString());
+      if (!batch)
+         break;
+      if (batch->num_rows() == 0)
+         continue;
+      for (const auto &column : fColumns) {
+         if (batch->column(column.fIndex)->null_count() > 0)
+            throw std::runtime_error("TArrowDS: column " + column.fName + " contains null values, not supported.");
+      }
+      fBatchFirstEntries.emplace_back(nEntries);
+      nEntries += batch->num_rows();
+      fBatches.emplace_back(std::move(batch));
+   }
+}
+
+TArrowDS::~TArrowDS()
+{
+}
+
+std::size_t TArrowDS::GetColumnIndex(std::string_view colName) const
+{
+   const auto it =
+      std::find_if(fColumns.begin(), fColumns.end(), [&colName](const TColumn &c) { return c.fName == colName; });
+   if (it == fColumns.end()) {
+      std::string err = "The specified column name, \"" + std::string(colName) + "\" is not known to the data source.";
+      throw std::runtime_error(err);
+   }
+   return std::distance(fColumns.begin(), it);
+}
+
+/// Make a slot read the arrays of a record batch
+void TArrowDS::SetBatch(unsigned int slot, std::size_t batchIndex)
+{
+   const auto &batch = *fBatches[batchIndex];
+   for (auto i : ROOT::TSeqU(fColumns.size())) {
+      const auto &column = fColumns[i];
+      if (!column.fRead)
+         continue;
+      auto array = batch.column(column.fIndex);
+      if (column.fByteWidth > 0) {
+         const auto &values = *static_cast<const arrow::PrimitiveArray &>(*array).values();
+         fSlotRawValues[slot][i] =
+            reinterpret_cast<const char *>(values.data()) + array->offset() * column.fByteWidth;
+      }
+      fSlotArrays[slot][i] = std::move(array);
+   }
+   fSlotBatches[slot] = batchIndex;
+}
+
+const std::vector<std::string> &TArrowDS::GetColumnNames() const
+{
+   return fColNames;
+}
+
+bool TArrowDS::HasColumn(std::string_view colName) const
+{
+   return fColNames.end() != std::find(fColNames.begin(), fColNames.end(), colName);
+}
+
+std::string TArrowDS::GetTypeName(std::string_view colName) const
+{
+   return fColumns[GetColumnIndex(colName)].fTypeName;
+}
+
+std::vector<std::pair<ULong64_t, ULong64_t>> TArrowDS::GetEntryRanges()
+{
+   auto ranges(std::move(fEntryRanges)); // empty fEntryRanges
+   return ranges;
+}
+
+void TArrowDS::SetEntry(unsigned int slot, ULong64_t entry)
+{
+   auto batchIndex = fSlotBatches[slot];
+   if (batchIndex < 0 || entry < fBatchFirstEntries[batchIndex] ||
+       entry >= fBatchFirstEntries[batchIndex] + fBatches[batchIndex]->num_rows()) {
+      const auto next = std::upper_bound(fBatchFirstEntries.begin(), fBatchFirstEntries.end(), entry);
+      batchIndex = std::distance(fBatchFirstEntries.begin(), next) - 1;
+      SetBatch(slot, batchIndex);
+   }
+   const auto offset = entry - fBatchFirstEntries[batchIndex];
+   for (auto i : ROOT::TSeqU(fColumns.size())) {
+      auto &column = fColumns[i];
+      if (!column.fRead)
+         continue;
+      if (column.fByteWidth > 0)
+         column.fValues[slot] = const_cast<char *>(fSlotRawValues[slot][i] + offset * column.fByteWidth);
+      else if (column.fTypeId == arrow::Type::BOOL)
+         column.fBoolValues[slot] = static_cast<const arrow::BooleanArray &>(*fSlotArrays[slot][i]).Value(offset);
+      else
+         column.fStringValues[slot] = static_cast<const arrow::StringArray &>(*fSlotArrays[slot][i]).GetString(offset);
+   }
+}
+
+void TArrowDS::SetNSlots(unsigned int nSlots)
+{
+   assert(0U == fNSlots && "Setting the number of slots even if the number of slots is different from zero.");
+
+   fNSlots = nSlots;
+   fSlotBatches.assign(fNSlots, -1);
+   fSlotArrays.assign(fNSlots, std::vector<std::shared_ptr<arrow::Array>>(fColumns.size()));
+   fSlotRawValues.assign(fNSlots, std::vector<const char *>(fColumns.size(), nullptr));
+   for (auto &column : fColumns) {
+      column.fValues.assign(fNSlots, nullptr);
+      if (column.fTypeId == arrow::Type::BOOL) {
+         column.fBoolValues.resize(fNSlots);
+         for (auto slot : ROOT::TSeqU(fNSlots))
+            column.fValues[slot] = &column.fBoolValues[slot];
+      } else if (column.fTypeId == arrow::Type::STRING) {
+         column.fStringValues.resize(fNSlots);
+         for (auto slot : ROOT::TSeqU(fNSlots))
+            column.fValues[slot] = &column.fStringValues[slot];
+      }
+   }
+}
+
+void TArrowDS::Initialise()
+{
+   // every record batch is processed by a single task
+   fEntryRanges.clear();
+   for (auto i : ROOT::TSeqU(fBatches.size()))
+      fEntryRanges.emplace_back(fBatchFirstEntries[i], fBatchFirstEntries[i] + fBatches[i]->num_rows());
+   fSlotBatches.assign(fNSlots, -1);
+}
+
+TDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::Table> table, const std::vector<std::string> &columns)
+{
+   ROOT::Experimental::TDataFrame tdf(std::make_unique<TArrowDS>(std::move(table), columns));
+   return tdf;
+}
+
+} // ns TDF
+} // ns Experimental
+} // ns ROOT
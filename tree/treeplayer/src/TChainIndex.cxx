@@ -96,6 +96,11 @@ TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *mino
             return;
          }
       }
+      if (!index) {
+         // An index saved on its own next to the tree saves rebuilding it.
+         index = TTreeIndex::ReadStandalone(chain->GetTree(), majorname, minorname);
+         entry.fTreeIndex = index;
+      }
       if (!index) {
          chain->GetTree()->BuildIndex(majorname, minorname);
          index = chain->GetTree()->GetTreeIndex();
@@ -0,0 +1,198 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/TColumnStore.hxx>
+#include <ROOT/TColumnStoreDS.hxx>
+#include <ROOT/TSeq.hxx>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace ROOT {
+namespace Experimental {
+namespace TDF {
+namespace Internal {
+
+/// The reader of a column for a slot, and the address of its current value.
+class TColumnStoreSlotColumn {
+protected:
+   void *fValue = nullptr;
+
+public:
+   virtual ~TColumnStoreSlotColumn() {}
+   virtual const std::type_info &GetTypeInfo() const = 0;
+   virtual void SetEntry(ULong64_t entry) = 0;
+   void *GetValueAddress() { return &fValue; }
+};
+
+template <typename T>
+class TColumnStoreSlotColumnImpl final : public TColumnStoreSlotColumn {
+   ROOT::Experimental::TColumnReader<T> fReader;
+
+public:
+   TColumnStoreSlotColumnImpl(ROOT::Experimental::TColumnStoreReader &reader, std::string_view name)
+      : fReader(reader.GetColumn<T>(name))
+   {
+   }
+   const std::type_info &GetTypeInfo() const { return typeid(T); }
+   void SetEntry(ULong64_t entry) { fValue = const_cast<T *>(&fReader(entry)); }
+};
+
+} // ns Internal
+
+namespace {
+
+using Internal::TColumnStoreSlotColumn;
+using Internal::TColumnStoreSlotColumnImpl;
+
+template <typename T>
+std::unique_ptr<TColumnStoreSlotColumn> MakeSlotColumn(ROOT::Experimental::TColumnStoreReader &reader,
+                                                       std::string_view name, bool isCollection)
+{
+   if (isCollection)
+      return std::unique_ptr<TColumnStoreSlotColumn>(new TColumnStoreSlotColumnImpl<std::vector<T>>(reader, name));
+   return std::unique_ptr<TColumnStoreSlotColumn>(new TColumnStoreSlotColumnImpl<T>(reader, name));
+}
+
+/// Create the reader of the column name, of any of the types that can be stored
+std::unique_ptr<TColumnStoreSlotColumn> MakeSlotColumn(ROOT::Experimental::TColumnStoreReader &reader,
+                                                       std::string_view name)
+{
+   const auto &column = reader.GetDescriptor(name);
+   const bool isCollection = column.fKind == ROOT::Experimental::Detail::TColumnDescriptor::kCollection;
+   // the type of the values of a collection is the one of the next column
+   const std::string &type = isCollection ? (&column + 1)->fTypeName : column.fTypeName;
+   if (type == "bool" && !isCollection)
+      return std::unique_ptr<TColumnStoreSlotColumn>(new TColumnStoreSlotColumnImpl<bool>(reader, name));
+   if (type == "char")
+      return MakeSlotColumn<char>(reader, name, isCollection);
+   if (type == "unsigned char")
+      return MakeSlotColumn<unsigned char>(reader, name, isCollection);
+   if (type == "short")
+      return MakeSlotColumn<short>(reader, name, isCollection);
+   if (type == "unsigned short")
+      return MakeSlotColumn<unsigned short>(reader, name, isCollection);
+   if (type == "int")
+      return MakeSlotColumn<int>(reader, name, isCollection);
+   if (type == "unsigned int")
+      return MakeSlotColumn<unsigned int>(reader, name, isCollection);
+   if (type == "Long64_t")
+      return MakeSlotColumn<Long64_t>(reader, name, isCollection);
+   if (type == "ULong64_t")
+      return MakeSlotColumn<ULong64_t>(reader, name, isCollection);
+   if (type == "float")
+      return MakeSlotColumn<float>(reader, name, isCollection);
+   if (type == "double")
+      return MakeSlotColumn<double>(reader, name, isCollection);
+   throw std::runtime_error("TColumnStoreDS: the column " + std::string(name) + " has the unsupported type " +
+                            column.fTypeName + ".");
+}
+
+} // anonymous namespace
+
+std::vector<void *> TColumnStoreDS::GetColumnReadersImpl(std::string_view name, const std::type_info &ti)
+{
+   if (!HasColumn(name)) {
+      std::string err = "The specified column name, \"" + std::string(name) + "\" is not known to the data source.";
+      throw std::runtime_error(err);
+   }
+   auto it = std::find(fSlotColumnNames.begin(), fSlotColumnNames.end(), name);
+   if (it == fSlotColumnNames.end()) {
+      std::vector<std::unique_ptr<TColumnStoreSlotColumn>> slotColumns;
+      for (auto slot : ROOT::TSeqU(fNSlots)) {
+         (void)slot;
+         slotColumns.emplace_back(MakeSlotColumn(*fReader, name));
+      }
+      fSlotColumns.emplace_back(std::move(slotColumns));
+      fSlotColumnNames.emplace_back(std::string(name));
+      it = fSlotColumnNames.end() - 1;
+   }
+   auto &slotColumns = fSlotColumns[std::distance(fSlotColumnNames.begin(), it)];
+   if (fNSlots > 0 && ti != slotColumns[0]->GetTypeInfo()) {
+      std::string err = "Column " + std::string(name) + " has type " + GetTypeName(name) +
+                        " while the id specified is associated to another type";
+      throw std::runtime_error(err);
+   }
+   std::vector<void *> ret;
+   for (auto &column : slotColumns)
+      ret.emplace_back(column->GetValueAddress());
+   return ret;
+}
+
+TColumnStoreDS::TColumnStoreDS(std::string_view fileName)
+   : fReader(ROOT::Experimental::TColumnStoreReader::Open(fileName))
+{
+}
+
+TColumnStoreDS::~TColumnStoreDS()
+{
+}
+
+const std::vector<std::string> &TColumnStoreDS::GetColumnNames() const
+{
+   return fReader->GetColumnNames();
+}
+
+bool TColumnStoreDS::HasColumn(std::string_view colName) const
+{
+   return fReader->HasColumn(colName);
+}
+
+std::string TColumnStoreDS::GetTypeName(std::string_view colName) const
+{
+   if (!HasColumn(colName))
+      throw std::runtime_error("The specified column name, \"" + std::string(colName) +
+                               "\" is not known to the data source.");
+   return fReader->GetTypeName(colName);
+}
+
+std::vector<std::pair<ULong64_t, ULong64_t>> TColumnStoreDS::GetEntryRanges()
+{
+   auto ranges(std::move(fEntryRanges)); // empty fEntryRanges
+   return ranges;
+}
+
+void TColumnStoreDS::SetEntry(unsigned int slot, ULong64_t entry)
+{
+   for (auto &slotColumns : fSlotColumns)
+      slotColumns[slot]->SetEntry(entry);
+}
+
+void TColumnStoreDS::SetNSlots(unsigned int nSlots)
+{
+   assert(0U == fNSlots && "Setting the number of slots even if the number of slots is different from zero.");
+
+   fNSlots = nSlots;
+}
+
+void TColumnStoreDS::Initialise()
+{
+   // a few ranges per slot balance the load, the readers of a slot read the pages of each range sequentially
+   fEntryRanges.clear();
+   const auto nEntries = fReader->GetNEntries();
+   const auto nRanges = std::max<ULong64_t>(1, std::min<ULong64_t>(nEntries, 4 * fNSlots));
+   const auto rangeSize = nEntries / nRanges;
+   ULong64_t first = 0;
+   for (auto i : ROOT::TSeq<ULong64_t>(nRanges)) {
+      const auto end = (i == nRanges - 1) ? nEntries : first + rangeSize;
+      if (end > first)
+         fEntryRanges.emplace_back(first, end);
+      first = end;
+   }
+}
+
+TDataFrame MakeColumnStoreDataFrame(std::string_view fileName)
+{
+   ROOT::Experimental::TDataFrame tdf(std::make_unique<TColumnStoreDS>(fileName));
+   return tdf;
+}
+
+} // ns TDF
+} // ns Experimental
+} // ns ROOT
@@ -0,0 +1,262 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/TCompressedCacheDS.hxx>
+#include <ROOT/TDFUtils.hxx>
+#include <ROOT/TSeq.hxx>
+#include <RZip.h>
+#include <TString.h>
+#include <TSystem.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+// The ROOT compression routines handle at most 16MB per call: columns are compressed in blocks, each preceded by
+// its stored and uncompressed sizes. Blocks that do not shrink are stored as they are.
+const std::size_t kMaxBlockSize = 0xffffff;
+const std::size_t kBlockHeaderSize = 2 * sizeof(std::uint32_t);
+
+void CompressColumn(const char *src, std::size_t size, const ROOT::Experimental::TDF::TCacheOptions &options,
+                    std::vector<char> &out)
+{
+   out.clear();
+   std::vector<char> block;
+   for (std::size_t done = 0; done < size;) {
+      const auto rawSize = std::min(size - done, kMaxBlockSize);
+      int srcSize = rawSize;
+      int tgtSize = rawSize; // blocks that would not shrink make the compression fail
+      int stored = 0;
+      block.resize(rawSize);
+      if (options.fCompressionLevel > 0)
+         R__zipMultipleAlgorithm(options.fCompressionLevel, &srcSize, const_cast<char *>(src + done), &tgtSize,
+                                 block.data(), &stored, options.fCompressionAlgorithm);
+      const bool compressed = stored > 0 && std::size_t(stored) < rawSize;
+      const std::uint32_t header[2] = {std::uint32_t(compressed ? stored : rawSize), std::uint32_t(rawSize)};
+      const auto headerBytes = reinterpret_cast<const char *>(header);
+      out.insert(out.end(), headerBytes, headerBytes + kBlockHeaderSize);
+      if (compressed)
+         out.insert(out.end(), block.data(), block.data() + stored);
+      else
+         out.insert(out.end(), src + done, src + done + rawSize);
+      done += rawSize;
+   }
+}
+
+void UncompressColumn(const char *src, std::size_t srcSize, std::vector<char> &out, std::size_t outSize)
+{
+   out.resize(outSize);
+   std::size_t outPos = 0;
+   for (std::size_t pos = 0; pos < srcSize;) {
+      std::uint32_t header[2];
+      std::memcpy(header, src + pos, kBlockHeaderSize);
+      pos += kBlockHeaderSize;
+      if (outPos + header[1] > outSize)
+         throw std::runtime_error("TCompressedCacheDS: corrupted chunk in the cache.");
+      if (header[0] == header[1]) {
+         std::memcpy(out.data() + outPos, src + pos, header[1]);
+      } else {
+         int stored = header[0];
+         int raw = header[1];
+         int irep = 0;
+         R__unzip(&stored, reinterpret_cast<unsigned char *>(const_cast<char *>(src + pos)), &raw,
+                  reinterpret_cast<unsigned char *>(out.data() + outPos), &irep);
+         if (irep != raw)
+            throw std::runtime_error("TCompressedCacheDS: cannot uncompress a chunk of the cache.");
+      }
+      pos += header[0];
+      outPos += header[1];
+   }
+}
+} // anonymous namespace
+
+namespace ROOT {
+namespace Experimental {
+namespace TDF {
+
+std::vector<void *> TCompressedCacheDS::GetColumnReadersImpl(std::string_view name, const std::type_info &ti)
+{
+   const auto it = std::find(fColNames.begin(), fColNames.end(), name);
+   if (it == fColNames.end()) {
+      std::string err = "The specified column name, \"" + std::string(name) + "\" is not known to the data source.";
+      throw std::runtime_error(err);
+   }
+   const auto index = std::distance(fColNames.begin(), it);
+   const auto typeName = ROOT::Internal::TDF::TypeID2TypeName(ti);
+   if (typeName != fColTypeNames[index]) {
+      std::string err = "Column " + std::string(name) + " has type " + fColTypeNames[index] +
+                        " while the id specified is associated to type " + typeName;
+      throw std::runtime_error(err);
+   }
+   std::vector<void *> ret;
+   for (auto slot : ROOT::TSeqU(fNSlots))
+      ret.emplace_back((void *)(&fColumnValues[index][slot]));
+   return ret;
+}
+
+TCompressedCacheDS::TCompressedCacheDS(const std::vector<std::string> &colNames,
+                                       const std::vector<std::string> &colTypeNames,
+                                       const std::vector<std::size_t> &colTypeSizes, const TCacheOptions &options)
+   : fOptions(options), fColNames(colNames), fColTypeNames(colTypeNames), fColTypeSizes(colTypeSizes)
+{
+   if (fOptions.fChunkSize == 0)
+      throw std::runtime_error("TCompressedCacheDS: the chunks must contain at least one entry.");
+}
+
+TCompressedCacheDS::~TCompressedCacheDS()
+{
+   if (!fScratchFileName.empty()) {
+      fScratchFile.close();
+      gSystem->Unlink(fScratchFileName.c_str());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Compress the columns of a chunk of nEntries entries and add it to the cache. Thread-safe: the columns are
+/// compressed by the calling thread, only the insertion in the cache is serialized.
+void TCompressedCacheDS::AddChunk(ULong64_t nEntries, const std::vector<const char *> &columns)
+{
+   TChunk chunk;
+   chunk.fNEntries = nEntries;
+   chunk.fColumns.resize(fColNames.size());
+   std::size_t chunkSize = 0;
+   for (auto i : ROOT::TSeqU(fColNames.size())) {
+      auto &column = chunk.fColumns[i];
+      CompressColumn(columns[i], nEntries * fColTypeSizes[i], fOptions, column.fBuffer);
+      column.fBuffer.shrink_to_fit();
+      column.fSize = column.fBuffer.size();
+      chunkSize += column.fSize;
+   }
+
+   std::lock_guard<std::mutex> lock(fMutex);
+   chunk.fFirstEntry = fNEntries;
+   fNEntries += nEntries;
+   fMemorySize += chunkSize;
+   fChunks.emplace_back(std::move(chunk));
+   // the oldest chunks are the coldest ones: they are the first to go to disk
+   while (fOptions.fMaxMemory > 0 && fMemorySize > fOptions.fMaxMemory && fFirstInMemory < fChunks.size())
+      SpillChunk(fChunks[fFirstInMemory++]);
+}
+
+/// Move the content of a chunk to the scratch file. Must be called with fMutex held.
+void TCompressedCacheDS::SpillChunk(TChunk &chunk)
+{
+   if (fScratchFileName.empty()) {
+      TString fileName("tdfcache_");
+      const char *dir = fOptions.fScratchDir.empty() ? gSystem->TempDirectory() : fOptions.fScratchDir.c_str();
+      FILE *fp = gSystem->TempFileName(fileName, dir);
+      if (!fp)
+         throw std::runtime_error("TCompressedCacheDS: cannot create a scratch file in " + std::string(dir) + ".");
+      fclose(fp);
+      fScratchFileName = fileName.Data();
+      fScratchFile.open(fScratchFileName, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+   }
+   for (auto &column : chunk.fColumns) {
+      fScratchFile.seekp(fScratchFileSize);
+      fScratchFile.write(column.fBuffer.data(), column.fSize);
+      if (!fScratchFile)
+         throw std::runtime_error("TCompressedCacheDS: cannot write to the scratch file " + fScratchFileName + ".");
+      column.fOffset = fScratchFileSize;
+      fScratchFileSize += column.fSize;
+      fMemorySize -= column.fSize;
+      std::vector<char>().swap(column.fBuffer);
+   }
+}
+
+/// Uncompress all the columns of a chunk in the buffers of a slot
+void TCompressedCacheDS::LoadChunk(unsigned int slot, std::size_t chunkIndex)
+{
+   const auto &chunk = fChunks[chunkIndex];
+   auto &readBuffer = fSlotReadBuffers[slot];
+   for (auto i : ROOT::TSeqU(fColNames.size())) {
+      const auto &column = chunk.fColumns[i];
+      const char *content = column.fBuffer.data();
+      if (column.fOffset >= 0) {
+         readBuffer.resize(column.fSize);
+         {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fScratchFile.seekg(column.fOffset);
+            fScratchFile.read(readBuffer.data(), column.fSize);
+            if (!fScratchFile)
+               throw std::runtime_error("TCompressedCacheDS: cannot read from the scratch file " + fScratchFileName +
+                                        ".");
+         }
+         content = readBuffer.data();
+      }
+      UncompressColumn(content, column.fSize, fSlotBuffers[slot][i], chunk.fNEntries * fColTypeSizes[i]);
+   }
+   fSlotChunks[slot] = chunkIndex;
+}
+
+const std::vector<std::string> &TCompressedCacheDS::GetColumnNames() const
+{
+   return fColNames;
+}
+
+bool TCompressedCacheDS::HasColumn(std::string_view colName) const
+{
+   return fColNames.end() != std::find(fColNames.begin(), fColNames.end(), colName);
+}
+
+std::string TCompressedCacheDS::GetTypeName(std::string_view colName) const
+{
+   const auto it = std::find(fColNames.begin(), fColNames.end(), colName);
+   if (it == fColNames.end())
+      throw std::runtime_error("The specified column name, \"" + std::string(colName) +
+                               "\" is not known to the data source.");
+   return fColTypeNames[std::distance(fColNames.begin(), it)];
+}
+
+std::vector<std::pair<ULong64_t, ULong64_t>> TCompressedCacheDS::GetEntryRanges()
+{
+   auto ranges(std::move(fEntryRanges)); // empty fEntryRanges
+   return ranges;
+}
+
+void TCompressedCacheDS::SetEntry(unsigned int slot, ULong64_t entry)
+{
+   auto chunkIndex = fSlotChunks[slot];
+   if (chunkIndex < 0 || entry < fChunks[chunkIndex].fFirstEntry ||
+       entry >= fChunks[chunkIndex].fFirstEntry + fChunks[chunkIndex].fNEntries) {
+      const auto next = std::upper_bound(fChunks.begin(), fChunks.end(), entry,
+                                         [](ULong64_t e, const TChunk &c) { return e < c.fFirstEntry; });
+      chunkIndex = std::distance(fChunks.begin(), next) - 1;
+      LoadChunk(slot, chunkIndex);
+   }
+   const auto offset = entry - fChunks[chunkIndex].fFirstEntry;
+   for (auto i : ROOT::TSeqU(fColNames.size()))
+      fColumnValues[i][slot] = fSlotBuffers[slot][i].data() + offset * fColTypeSizes[i];
+}
+
+void TCompressedCacheDS::SetNSlots(unsigned int nSlots)
+{
+   assert(0U == fNSlots && "Setting the number of slots even if the number of slots is different from zero.");
+
+   fNSlots = nSlots;
+   fSlotChunks.assign(fNSlots, -1);
+   fSlotBuffers.assign(fNSlots, std::vector<std::vector<char>>(fColNames.size()));
+   fSlotReadBuffers.resize(fNSlots);
+   fColumnValues.assign(fColNames.size(), std::vector<void *>(fNSlots, nullptr));
+}
+
+void TCompressedCacheDS::Initialise()
+{
+   // every chunk is processed by a single task, which uncompresses it only once
+   fEntryRanges.clear();
+   for (const auto &chunk : fChunks)
+      fEntryRanges.emplace_back(chunk.fFirstEntry, chunk.fFirstEntry + chunk.fNEntries);
+   fSlotChunks.assign(fNSlots, -1);
+}
+
+} // ns TDF
+} // ns Experimental
+} // ns ROOT
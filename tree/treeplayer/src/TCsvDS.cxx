@@ -65,22 +65,67 @@ double-quote characters must be represented by a pair of double-quote characters
     2000,Mercury,Cougar
 ~~~
 
-The current implementation of TCsvDS reads the entire CSV file content into memory before
-TDataFrame starts processing it. Therefore, before creating a CSV TDataFrame, it is
-important to check both how much memory is available and the size of the CSV file.
+The types of the columns are inferred from a sample of the first records: a column holding both
+integers and floating point numbers is a floating point column, a column holding values of other
+mixed types is a string column. Records further in the file which cannot be converted to the
+inferred type make the event loop fail.
+
+The file is memory-mapped, if possible, and split into chunks of about 16 MB of consecutive lines,
+each with the same number of records, at least one per slot. The records of a chunk are parsed
+when the event loop first reads them, by the slot processing the chunk, which keeps only the values
+of the columns read. Only the lines of the file are counted before the event loop starts, in
+parallel if implicit multi-threading is enabled.
 */
 // clang-format on
 
+
 #include <ROOT/TDFUtils.hxx>
 #include <ROOT/TSeq.hxx>
 #include <ROOT/TCsvDS.hxx>
 #include <ROOT/RMakeUnique.hxx>
+#include <RConfigure.h> // R__USE_IMT
+#include <TROOT.h>      // IsImplicitMTEnabled
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+
+#ifndef R__WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <numeric>
 #include <sstream>
 #include <string>
 
+namespace {
+// Approximate size of the chunks of the file parsed at once by a slot
+const std::size_t kChunkSize = 16 * 1024 * 1024;
+// Number of records used to infer the types of the columns
+const std::size_t kNSampleRecords = 100;
+
+/// Call f(i) for each i in [0, n), in parallel if implicit multi-threading is enabled
+template <typename F>
+void ForEachIndex(unsigned int n, F f)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && n > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(f, ROOT::TSeqU(n));
+      return;
+   }
+#endif
+   for (auto i : ROOT::TSeqU(n))
+      f(i);
+}
+} // anonymous namespace
+
 namespace ROOT {
 namespace Experimental {
 namespace TDF {
@@ -95,46 +140,42 @@ TRegexp TCsvDS::falseRegex("^false$");
 const std::map<TCsvDS::ColType_t, std::string>
    TCsvDS::fgColTypeMap({{'b', "bool"}, {'d', "double"}, {'l', "Long64_t"}, {'s', "std::string"}});
 
-void TCsvDS::FillHeaders(const std::string &line)
+/// Map the content of the file in memory, or read it if it cannot be mapped (e.g. a pipe).
+void TCsvDS::MapFile()
 {
-   auto columns = ParseColumns(line);
-   for (auto &col : columns) {
-      fHeaders.emplace_back(col);
+#ifndef R__WIN32
+   const int fd = open(fFileName.c_str(), O_RDONLY);
+   if (fd < 0)
+      throw std::runtime_error("Cannot open CSV file " + fFileName);
+   struct stat st;
+   const bool isRegular = 0 == fstat(fd, &st) && S_ISREG(st.st_mode);
+   if (isRegular && st.st_size > 0) {
+      void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+         fData = static_cast<const char *>(addr);
+         fDataSize = st.st_size;
+         fIsMapped = true;
+      }
    }
+   close(fd);
+   if (fIsMapped || (isRegular && st.st_size == 0))
+      return;
+#endif
+   std::ifstream stream(fFileName, std::ios::binary);
+   if (!stream)
+      throw std::runtime_error("Cannot open CSV file " + fFileName);
+   std::ostringstream content;
+   content << stream.rdbuf();
+   fDataCopy = content.str();
+   fData = fDataCopy.data();
+   fDataSize = fDataCopy.size();
 }
 
-void TCsvDS::FillRecord(const std::string &line, Record_t &record)
+void TCsvDS::FillHeaders(const std::string &line)
 {
-   std::istringstream lineStream(line);
-   auto i = 0U;
-
    auto columns = ParseColumns(line);
-
    for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
-
-      switch (colType) {
-      case 'd': {
-         record.emplace_back(new double(std::stod(col)));
-         break;
-      }
-      case 'l': {
-         record.emplace_back(new Long64_t(std::stoll(col)));
-         break;
-      }
-      case 'b': {
-         auto b = new bool();
-         record.emplace_back(b);
-         std::istringstream is(col);
-         is >> std::boolalpha >> *b;
-         break;
-      }
-      case 's': {
-         record.emplace_back(new std::string(col));
-         break;
-      }
-      }
-      ++i;
+      fHeaders.emplace_back(col);
    }
 }
 
@@ -177,16 +218,31 @@ std::vector<void *> TCsvDS::GetColumnReadersImpl(std::string_view colName, const
    return ret;
 }
 
-void TCsvDS::InferColTypes(std::vector<std::string> &columns)
+/// Infer the type of each column from a sample of records: integers and floating point numbers are floating point
+/// numbers, other mixed types are strings.
+void TCsvDS::InferColTypes(const std::vector<std::vector<std::string>> &records)
 {
-   auto i = 0U;
-   for (auto &col : columns) {
-      InferType(col, i);
-      ++i;
+   for (auto i : ROOT::TSeqU(fHeaders.size())) {
+      ColType_t type = 0;
+      for (const auto &record : records) {
+         if (i >= record.size())
+            continue;
+         const auto valueType = InferType(record[i]);
+         if (type == 0 || type == valueType)
+            type = valueType;
+         else if ((type == 'l' && valueType == 'd') || (type == 'd' && valueType == 'l'))
+            type = 'd';
+         else
+            type = 's';
+      }
+      if (type == 0)
+         type = 's';
+      fColTypes[fHeaders[i]] = type;
+      fColTypesList.push_back(type);
    }
 }
 
-void TCsvDS::InferType(const std::string &col, unsigned int idxCol)
+TCsvDS::ColType_t TCsvDS::InferType(const std::string &col) const
 {
    ColType_t type;
    int dummy;
@@ -202,11 +258,10 @@ void TCsvDS::InferType(const std::string &col, unsigned int idxCol)
    }
    // TODO: Date
 
-   fColTypes[fHeaders[idxCol]] = type;
-   fColTypesList.push_back(type);
+   return type;
 }
 
-std::vector<std::string> TCsvDS::ParseColumns(const std::string &line)
+std::vector<std::string> TCsvDS::ParseColumns(const std::string &line) const
 {
    std::vector<std::string> columns;
 
@@ -217,9 +272,9 @@ std::vector<std::string> TCsvDS::ParseColumns(const std::string &line)
    return columns;
 }
 
-size_t TCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i)
+size_t TCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i) const
 {
-   std::stringstream val;
+   std::string val;
    bool quoted = false;
 
    for (; i < line.size(); ++i) {
@@ -230,18 +285,156 @@ size_t TCsvDS::ParseValue(const std::string &line, std::vector<std::string> &col
          if (line[i + 1] != '"') {
             quoted = !quoted;
          } else {
-            val << line[++i];
+            val += line[++i];
          }
       } else {
-         val << line[i];
+         val += line[i];
       }
    }
 
-   columns.emplace_back(val.str());
+   columns.emplace_back(std::move(val));
 
    return i;
 }
 
+/// Read the next non-empty line starting at pos and before end, and move pos to the following line.
+/// Return false if there is none.
+bool TCsvDS::NextLine(std::size_t &pos, std::size_t end, std::string &line) const
+{
+   while (pos < end) {
+      const auto eol = static_cast<const char *>(std::memchr(fData + pos, '\n', end - pos));
+      const std::size_t lineBegin = pos;
+      const std::size_t lineEnd = eol ? eol - fData : end;
+      pos = eol ? lineEnd + 1 : end;
+      if (lineEnd > lineBegin) {
+         line.assign(fData + lineBegin, lineEnd - lineBegin);
+         return true;
+      }
+   }
+   return false;
+}
+
+/// Return the offset of the line starting at pos, or of the next one if pos is in the middle of a line.
+std::size_t TCsvDS::AlignToLine(std::size_t pos) const
+{
+   if (pos <= fFirstRecord)
+      return fFirstRecord;
+   if (pos >= fDataSize)
+      return fDataSize;
+   if (fData[pos - 1] == '\n')
+      return pos;
+   const auto eol = static_cast<const char *>(std::memchr(fData + pos, '\n', fDataSize - pos));
+   return eol ? eol - fData + 1 : fDataSize;
+}
+
+/// Count the records, i.e. the non-empty lines, of the lines between begin and end.
+ULong64_t TCsvDS::CountRecords(std::size_t begin, std::size_t end) const
+{
+   ULong64_t n = 0ULL;
+   for (auto pos = begin; pos < end;) {
+      const auto eol = static_cast<const char *>(std::memchr(fData + pos, '\n', end - pos));
+      const std::size_t lineEnd = eol ? eol - fData : end;
+      if (lineEnd > pos)
+         ++n;
+      pos = eol ? lineEnd + 1 : end;
+   }
+   return n;
+}
+
+/// Return the offset following the n records starting at pos.
+std::size_t TCsvDS::SkipRecords(std::size_t pos, ULong64_t n) const
+{
+   while (n > 0 && pos < fDataSize) {
+      const auto eol = static_cast<const char *>(std::memchr(fData + pos, '\n', fDataSize - pos));
+      const std::size_t lineEnd = eol ? eol - fData : fDataSize;
+      if (lineEnd > pos)
+         --n;
+      pos = eol ? lineEnd + 1 : fDataSize;
+   }
+   return pos;
+}
+
+/// Split the records in chunks with the same number of records, the last one taking the remainder. The records of
+/// line-aligned blocks of the file are counted in parallel, then the beginning of each chunk is searched in its block.
+void TCsvDS::BuildChunks()
+{
+   const auto size = fDataSize - fFirstRecord;
+   const unsigned int nChunks = std::max<std::size_t>(fNSlots, (size + kChunkSize - 1) / kChunkSize);
+
+   std::vector<std::size_t> blockBegins(nChunks + 1, fDataSize);
+   for (auto i : ROOT::TSeqU(nChunks))
+      blockBegins[i] = AlignToLine(fFirstRecord + size / nChunks * i);
+   std::vector<ULong64_t> blockFirstRecords(nChunks + 1, 0ULL);
+   ForEachIndex(nChunks,
+                [&](unsigned int i) { blockFirstRecords[i + 1] = CountRecords(blockBegins[i], blockBegins[i + 1]); });
+   std::partial_sum(blockFirstRecords.begin(), blockFirstRecords.end(), blockFirstRecords.begin());
+   const auto nRecords = blockFirstRecords.back();
+
+   const auto chunkEntries = nRecords / nChunks;
+   fChunks.assign(nChunks, TChunk());
+   for (auto i : ROOT::TSeqU(nChunks)) {
+      fChunks[i].fFirstEntry = i * chunkEntries;
+      fChunks[i].fNEntries = i + 1 < nChunks ? chunkEntries : nRecords - i * chunkEntries;
+   }
+   ForEachIndex(nChunks, [&](unsigned int i) {
+      const auto first = fChunks[i].fFirstEntry;
+      const auto block =
+         std::upper_bound(blockFirstRecords.begin(), blockFirstRecords.begin() + nChunks, first) - 1 -
+         blockFirstRecords.begin();
+      fChunks[i].fBegin = SkipRecords(blockBegins[block], first - blockFirstRecords[block]);
+   });
+   for (auto i : ROOT::TSeqU(nChunks))
+      fChunks[i].fEnd = i + 1 < nChunks ? fChunks[i + 1].fBegin : fDataSize;
+}
+
+/// Parse the records of a chunk, keeping the values of the columns read by the slot.
+void TCsvDS::ParseChunk(unsigned int slot, std::size_t chunkIndex)
+{
+   const auto &chunk = fChunks[chunkIndex];
+   auto &slotChunk = fSlotChunks[slot];
+   const auto nColumns = fHeaders.size();
+   std::vector<std::pair<std::size_t, ColType_t>> readColumns;
+   auto colType = fColTypesList.begin();
+   for (auto i : ROOT::TSeqU(nColumns)) {
+      const auto type = *colType++;
+      if (!fColAddresses[i][slot])
+         continue;
+      readColumns.emplace_back(i, type);
+      switch (type) {
+      case 'd': slotChunk.fDoubles[i].clear(); slotChunk.fDoubles[i].reserve(chunk.fNEntries); break;
+      case 'l': slotChunk.fLong64s[i].clear(); slotChunk.fLong64s[i].reserve(chunk.fNEntries); break;
+      case 'b': slotChunk.fBools[i].clear(); slotChunk.fBools[i].reserve(chunk.fNEntries); break;
+      case 's': slotChunk.fStrings[i].clear(); slotChunk.fStrings[i].reserve(chunk.fNEntries); break;
+      }
+   }
+
+   std::string line;
+   auto entry = chunk.fFirstEntry;
+   for (auto pos = chunk.fBegin; NextLine(pos, chunk.fEnd, line); ++entry) {
+      auto columns = ParseColumns(line);
+      if (columns.size() != nColumns)
+         throw std::runtime_error("Record " + std::to_string(entry) + " of CSV file " + fFileName + " has " +
+                                  std::to_string(columns.size()) + " fields, " + std::to_string(nColumns) +
+                                  " were expected.");
+      for (const auto &column : readColumns) {
+         auto &col = columns[column.first];
+         try {
+            switch (column.second) {
+            case 'd': slotChunk.fDoubles[column.first].emplace_back(std::stod(col)); break;
+            case 'l': slotChunk.fLong64s[column.first].emplace_back(std::stoll(col)); break;
+            case 'b': slotChunk.fBools[column.first].emplace_back(col == "true"); break;
+            case 's': slotChunk.fStrings[column.first].emplace_back(std::move(col)); break;
+            }
+         } catch (const std::logic_error &) { // std::invalid_argument and std::out_of_range
+            throw std::runtime_error("Cannot convert the value \"" + col + "\" of column " + fHeaders[column.first] +
+                                     " in record " + std::to_string(entry) + " of CSV file " + fFileName + " to " +
+                                     fgColTypeMap.at(column.second) + ".");
+         }
+      }
+   }
+   slotChunk.fIndex = chunkIndex;
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Constructor to create a CSV TDataSource for TDataFrame.
 /// \param[in] fileName Path of the CSV file.
@@ -252,12 +445,13 @@ TCsvDS::TCsvDS(std::string_view fileName, bool readHeaders, char delimiter) // T
    : fFileName(fileName),
      fDelimiter(delimiter)
 {
-   std::ifstream stream(fFileName);
+   MapFile();
+   std::size_t pos = 0;
    std::string line;
 
    // Read the headers if present
    if (readHeaders) {
-      if (std::getline(stream, line)) {
+      if (NextLine(pos, fDataSize, line)) {
          FillHeaders(line);
       } else {
          std::string msg = "Error reading headers of CSV file ";
@@ -265,23 +459,18 @@ TCsvDS::TCsvDS(std::string_view fileName, bool readHeaders, char delimiter) // T
          throw std::runtime_error(msg);
       }
    }
+   fFirstRecord = pos;
 
-   if (std::getline(stream, line)) {
-      auto columns = ParseColumns(line);
-
+   // Infer types of columns with a sample of the first records
+   std::vector<std::vector<std::string>> sample;
+   while (sample.size() < kNSampleRecords && NextLine(pos, fDataSize, line))
+      sample.emplace_back(ParseColumns(line));
+   if (!sample.empty()) {
       // Generate headers if not present
       if (!readHeaders) {
-         GenerateHeaders(columns.size());
+         GenerateHeaders(sample.front().size());
       }
-
-      // Infer types of columns with first record
-      InferColTypes(columns);
-
-      // Read all records and store them in memory
-      do {
-         fRecords.emplace_back();
-         FillRecord(line, fRecords.back());
-      } while (std::getline(stream, line));
+      InferColTypes(sample);
    }
 }
 
@@ -289,30 +478,10 @@ TCsvDS::TCsvDS(std::string_view fileName, bool readHeaders, char delimiter) // T
 /// Destructor.
 TCsvDS::~TCsvDS()
 {
-   for (auto &record : fRecords) {
-      for (size_t i = 0; i < record.size(); ++i) {
-         void *p = record[i];
-         const auto colType = fColTypes[fHeaders[i]];
-         switch (colType) {
-         case 'd': {
-            delete static_cast<double *>(p);
-            break;
-         }
-         case 'l': {
-            delete static_cast<Long64_t *>(p);
-            break;
-         }
-         case 'b': {
-            delete static_cast<bool *>(p);
-            break;
-         }
-         case 's': {
-            delete static_cast<std::string *>(p);
-            break;
-         }
-         }
-      }
-   }
+#ifndef R__WIN32
+   if (fIsMapped)
+      munmap(const_cast<char *>(fData), fDataSize);
+#endif
 }
 
 const std::vector<std::string> &TCsvDS::GetColumnNames() const
@@ -349,26 +518,36 @@ bool TCsvDS::HasColumn(std::string_view colName) const
 
 void TCsvDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
+   auto &slotChunk = fSlotChunks[slot];
+   if (slotChunk.fIndex < 0 || entry < fChunks[slotChunk.fIndex].fFirstEntry ||
+       entry >= fChunks[slotChunk.fIndex].fFirstEntry + fChunks[slotChunk.fIndex].fNEntries) {
+      const auto next = std::upper_bound(fChunks.begin(), fChunks.end(), entry,
+                                         [](ULong64_t e, const TChunk &c) { return e < c.fFirstEntry; });
+      ParseChunk(slot, std::distance(fChunks.begin(), next) - 1);
+   }
+   const auto offset = entry - fChunks[slotChunk.fIndex].fFirstEntry;
+
    int colIndex = 0;
    for (auto &colType : fColTypesList) {
-      auto dataPtr = fRecords[entry][colIndex];
-      switch (colType) {
-      case 'd': {
-         fDoubleEvtValues[colIndex][slot] = *static_cast<double *>(dataPtr);
-         break;
-      }
-      case 'l': {
-         fLong64EvtValues[colIndex][slot] = *static_cast<Long64_t *>(dataPtr);
-         break;
-      }
-      case 'b': {
-         fBoolEvtValues[colIndex][slot] = *static_cast<bool *>(dataPtr);
-         break;
-      }
-      case 's': {
-         fStringEvtValues[colIndex][slot] = *static_cast<std::string *>(dataPtr);
-         break;
-      }
+      if (fColAddresses[colIndex][slot]) {
+         switch (colType) {
+         case 'd': {
+            fDoubleEvtValues[colIndex][slot] = slotChunk.fDoubles[colIndex][offset];
+            break;
+         }
+         case 'l': {
+            fLong64EvtValues[colIndex][slot] = slotChunk.fLong64s[colIndex][offset];
+            break;
+         }
+         case 'b': {
+            fBoolEvtValues[colIndex][slot] = slotChunk.fBools[colIndex][offset];
+            break;
+         }
+         case 's': {
+            fStringEvtValues[colIndex][slot] = slotChunk.fStrings[colIndex][offset];
+            break;
+         }
+         }
       }
       colIndex++;
    }
@@ -389,23 +568,28 @@ void TCsvDS::SetNSlots(unsigned int nSlots)
    fLong64EvtValues.resize(nColumns, std::vector<Long64_t>(fNSlots));
    fStringEvtValues.resize(nColumns, std::vector<std::string>(fNSlots));
    fBoolEvtValues.resize(nColumns, std::deque<bool>(fNSlots));
+
+   // Initialize the values parsed by each slot
+   fSlotChunks.resize(fNSlots);
+   for (auto &slotChunk : fSlotChunks) {
+      slotChunk.fDoubles.resize(nColumns);
+      slotChunk.fLong64s.resize(nColumns);
+      slotChunk.fStrings.resize(nColumns);
+      slotChunk.fBools.resize(nColumns);
+   }
 }
 
 void TCsvDS::Initialise()
 {
-   const auto nRecords = fRecords.size();
-   const auto chunkSize = nRecords / fNSlots;
-   const auto remainder = 1U == fNSlots ? 0 : nRecords % fNSlots;
-   auto start = 0UL;
-   auto end = 0UL;
-
-   for (auto i : ROOT::TSeqU(fNSlots)) {
-      start = end;
-      end += chunkSize;
-      fEntryRanges.emplace_back(start, end);
-      (void)i;
-   }
-   fEntryRanges.back().second += remainder;
+   // the lines are counted once, the records are parsed during the event loop
+   if (fChunks.empty())
+      BuildChunks();
+   fEntryRanges.clear();
+   for (const auto &chunk : fChunks)
+      fEntryRanges.emplace_back(chunk.fFirstEntry, chunk.fFirstEntry + chunk.fNEntries);
+   // the columns read may differ from an event loop to the next
+   for (auto &slotChunk : fSlotChunks)
+      slotChunk.fIndex = -1;
 }
 
 TDataFrame MakeCsvDataFrame(std::string_view fileName, bool readHeaders, char delimiter)
@@ -9,11 +9,20 @@
  *************************************************************************/
 
 #include "ROOT/TDFActionHelpers.hxx"
+#include "TEntryList.h"
 
 namespace ROOT {
 namespace Internal {
 namespace TDF {
 
+Long64_t GetTaskFirstEntry(const TTreeReader &r)
+{
+   // The entry lists built for the tasks contain the global entry numbers of the tree/chain
+   if (auto elist = r.GetEntryList())
+      return elist->GetN() > 0 ? elist->GetEntry(0) : -1;
+   return r.GetCurrentEntry() + 1;
+}
+
 CountHelper::CountHelper(const std::shared_ptr<ULong64_t> &resultCount, const unsigned int nSlots)
    : fResultCount(resultCount), fCounts(nSlots, 0)
 {
@@ -10,9 +10,11 @@
 
 #include <stddef.h>
 #include <algorithm>
+#include <fstream>
 #include <map>
 #include <memory>
 #include <ostream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <typeinfo>
@@ -28,9 +30,13 @@
 #include "ROOT/RStringView.hxx"
 #include "RtypesCore.h"
 #include "TClass.h"
+#include "TEnv.h"
 #include "TInterpreter.h"
+#include "TMD5.h"
+#include "TROOT.h"
 #include "TRegexp.h"
 #include "TString.h"
+#include "TSystem.h"
 
 class TTree;
 
@@ -106,6 +112,89 @@ std::vector<std::string> FindUsedColumnNames(std::string_view expression, const
    return usedBranches;
 }
 
+namespace {
+// Code of the call to Filter or Define made by a jitted transformation.
+// thisExpr and nameExpr are the C++ expressions for the TInterface pointer and the name of the node.
+std::string BuildTransformationCall(std::string_view methodName, std::string_view interfaceTypeName,
+                                    const std::string &thisExpr, const std::string &nameExpr,
+                                    const std::string &lambda, const ColumnNames_t &columns)
+{
+   std::stringstream ss;
+   ss << "((" << interfaceTypeName << "*)" << thisExpr << ")->" << methodName << "(";
+   if (methodName == "Define")
+      ss << nameExpr << ", ";
+   ss << lambda << ", {";
+   for (auto i = 0u; i < columns.size(); ++i)
+      ss << (i ? ", \"" : "\"") << columns[i] << "\"";
+   ss << "}";
+   if (methodName == "Filter")
+      ss << ", " << nameExpr;
+   ss << ")";
+   return ss.str();
+}
+
+// Signature of the functions compiled into the jit cache: they take the TInterface on which to call the
+// transformation and the name of the new node, and return the new TInterface as JitTransformation does.
+using JitCacheFunc_t = Long_t (*)(void *, const char *);
+
+// Call a transformation through the jit cache in cacheDir, compiling and loading its entry if needed.
+// Return the address of the new TInterface, 0 if the code cannot be compiled outside of the interpreter.
+Long_t CallJitCache(const std::string &cacheDir, const std::string &targetTypeName, const std::string &call,
+                    void *thisPtr, std::string_view name)
+{
+   // The entries are identified by their code, which includes the expression and the column names and types
+   const std::string key = std::string(gROOT->GetVersion()) + "\n" + targetTypeName + "\n" + call;
+   TMD5 md5;
+   md5.Update((const UChar_t *)key.data(), key.size());
+   md5.Final();
+   const std::string funcName = std::string("tdfjit_") + md5.AsString();
+   const std::string basePath = cacheDir + "/" + funcName;
+   const std::string nameStr(name);
+   auto &times = GetJitTimes();
+
+   auto func = (JitCacheFunc_t)gSystem->DynFindSymbol("*", funcName.c_str());
+   if (!func) {
+      const std::string failedPath = basePath + ".failed";
+      if (!gSystem->AccessPathName(failedPath.c_str()))
+         return 0; // a previous process could not compile it
+
+      const std::string sourcePath = basePath + ".cxx";
+      const bool isNew = gSystem->AccessPathName(sourcePath.c_str());
+      TJitTimer timer(isNew ? times.fCacheBuild : times.fCacheLoad);
+      if (isNew) {
+         gSystem->mkdir(cacheDir.c_str(), kTRUE);
+         // Write to a temporary file first: several processes might share the cache
+         const std::string tmpPath = sourcePath + "." + std::to_string(gSystem->GetPid());
+         {
+            std::ofstream source(tmpPath);
+            source << "// TDataFrame jit cache entry generated by ROOT " << gROOT->GetVersion() << "\n"
+                   << "#include \"ROOT/TDataFrame.hxx\"\n#include <memory>\n\n"
+                   << "extern \"C\" Long_t " << funcName << "(void *thisPtr, const char *name)\n{\n"
+                   << "   thread_local std::unique_ptr<" << targetTypeName << "> result;\n"
+                   << "   result.reset(new " << targetTypeName << "(" << call << "));\n"
+                   << "   return (Long_t)result.get();\n}\n";
+            if (!source)
+               return 0;
+         }
+         gSystem->Rename(tmpPath.c_str(), sourcePath.c_str());
+      }
+      if (gSystem->CompileMacro(sourcePath.c_str(), "kOs"))
+         func = (JitCacheFunc_t)gSystem->DynFindSymbol("*", funcName.c_str());
+      if (!func) {
+         std::ofstream failed(failedPath);
+         return 0;
+      }
+      if (isNew)
+         ++times.fNCacheBuilds;
+      else
+         ++times.fNCacheHits;
+   } else {
+      ++times.fNCacheHits;
+   }
+   return func(thisPtr, nameStr.c_str());
+}
+} // anonymous namespace
+
 // Jit a string filter or a string temporary column, call this->Define or this->Filter as needed
 // Return pointer to the new functional chain node returned by the call, cast to Long_t
 Long_t JitTransformation(void *thisPtr, std::string_view methodName, std::string_view interfaceTypeName,
@@ -155,13 +244,6 @@ Long_t JitTransformation(void *thisPtr, std::string_view methodName, std::string
    else
       dummyDecl << "return " << expression << "\n;};}";
 
-   // Try to declare the dummy lambda, error out if it does not compile
-   if (!gInterpreter->Declare(dummyDecl.str().c_str())) {
-      auto msg =
-         "Cannot interpret the following expression:\n" + std::string(expression) + "\n\nMake sure it is valid C++.";
-      throw std::runtime_error(msg);
-   }
-
    // Now we build the lambda and we invoke the method with it in the jitted world
    std::stringstream ss;
    ss << "[](";
@@ -186,42 +268,56 @@ Long_t JitTransformation(void *thisPtr, std::string_view methodName, std::string
 
    auto filterLambda = ss.str();
 
+   // Here we selectively replace the column names with the real ones where they are aliases.
+   ColumnNames_t realBranches;
+   for (auto &brName : usedBranches) {
+      auto aliasMapIt = aliasMap.find(brName);
+      realBranches.emplace_back(aliasMapEnd == aliasMapIt ? brName : aliasMapIt->second);
+   }
+
    // The TInterface type to convert the result to. For example, Filter returns a TInterface<TFilter<F,P>> but when
    // returning it from a jitted call we need to convert it to TInterface<TFilterBase> as we are missing information
    // on types F and P at compile time.
    const auto targetTypeName = "ROOT::Experimental::TDF::TInterface<" + std::string(returnTypeName) + ">";
 
-   // Here we have two cases: filter and column
-   ss.str("");
-   // on Windows, to prefix the hexadecimal value of a pointer with '0x',
-   // one need to write: std::hex << std::showbase << (size_t)pointer
-   ss << targetTypeName << "(((" << interfaceTypeName << "*)" << std::hex << std::showbase << (size_t)thisPtr << ")->"
-      << methodName << "(";
-   if (methodName == "Define") {
-      ss << "\"" << name << "\", ";
-   }
-   ss << filterLambda << ", {";
-   for (auto brName : usedBranches) {
-      // Here we selectively replace the brName with the real column name if it's necessary.
-      auto aliasMapIt = aliasMap.find(brName);
-      auto &realBrName = aliasMapEnd == aliasMapIt ? brName : aliasMapIt->second;
-      ss << "\"" << realBrName << "\", ";
-   }
-   if (exprNeedsVariables)
-      ss.seekp(-2, ss.cur); // remove the last ",
-   ss << "}";
+   auto &times = GetJitTimes();
+   ++times.fNExpressions;
 
-   if (methodName == "Filter") {
-      ss << ", \"" << name << "\"";
+   // With the jit cache the call is compiled once and for all into a library, taking the node as a parameter
+   const std::string cacheDir = gEnv->GetValue("TDataFrame.JitCacheDir", "");
+   if (!cacheDir.empty()) {
+      const auto cachedCall =
+         BuildTransformationCall(methodName, interfaceTypeName, "thisPtr", "name", filterLambda, realBranches);
+      if (auto retVal = CallJitCache(cacheDir, targetTypeName, cachedCall, thisPtr, name))
+         return retVal;
    }
 
-   ss << "));";
+   // Try to declare the dummy lambda, error out if it does not compile
+   {
+      TJitTimer timer(times.fValidation);
+      if (!gInterpreter->Declare(dummyDecl.str().c_str())) {
+         auto msg = "Cannot interpret the following expression:\n" + std::string(expression) +
+                    "\n\nMake sure it is valid C++.";
+         throw std::runtime_error(msg);
+      }
+   }
 
+   // on Windows, to prefix the hexadecimal value of a pointer with '0x',
+   // one need to write: std::hex << std::showbase << (size_t)pointer
+   ss.str("");
+   ss << std::hex << std::showbase << (size_t)thisPtr;
+   const auto thisExpr = ss.str();
+   const auto call = targetTypeName + "(" +
+                     BuildTransformationCall(methodName, interfaceTypeName, thisExpr,
+                                             "\"" + std::string(name) + "\"", filterLambda, realBranches) +
+                     ");";
+
+   TJitTimer timer(times.fTransformations);
    TInterpreter::EErrorCode interpErrCode;
-   auto retVal = gInterpreter->Calc(ss.str().c_str(), &interpErrCode);
+   auto retVal = gInterpreter->Calc(call.c_str(), &interpErrCode);
    if (TInterpreter::EErrorCode::kNoError != interpErrCode || !retVal) {
       std::string msg = "Cannot interpret the invocation to " + std::string(methodName) + ":  ";
-      msg += ss.str();
+      msg += call;
       if (TInterpreter::EErrorCode::kNoError != interpErrCode) {
          msg += "\nInterpreter error code is " + std::to_string(interpErrCode) + ".";
       }
@@ -91,6 +91,19 @@ void CheckCustomColumn(std::string_view definedCol, TTree *treePtr, const Column
    }
 }
 
+void CheckBatchColumns(const ColumnNames_t &columns, TTree *treePtr, const ColumnNames_t &customCols)
+{
+   if (!treePtr)
+      throw std::runtime_error("Batch transformations can only read the columns of a TTree or TChain");
+   for (auto &col : columns) {
+      if (std::find(customCols.begin(), customCols.end(), col) != customCols.end()) {
+         const auto msg = "Column \"" + col + "\" is a custom column: batch transformations can only read the "
+                                              "branches of a TTree";
+         throw std::runtime_error(msg);
+      }
+   }
+}
+
 void CheckSnapshot(unsigned int nTemplateParams, unsigned int nColumnNames)
 {
    if (nTemplateParams != nColumnNames) {
@@ -15,12 +15,22 @@
 #include "ROOT/TDataSource.hxx"
 #include "ROOT/TTreeProcessorMT.hxx"
 #include "ROOT/RStringView.hxx"
+#include "TBranch.h"
+#include "TChain.h"
+#include "TDataType.h"
+#include "TFile.h"
+#include "TLeaf.h"
+#include "TTimeStamp.h"
 #include "TTree.h"
+#include "TVirtualPerfStats.h"
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
 #endif
 #include <limits.h>
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdlib>
 #include <functional>
 #include <map>
 #include <memory>
@@ -32,6 +42,7 @@
 #include <vector>
 
 #include "RtypesCore.h" // Long64_t
+#include "TClassEdit.h"
 #include "TInterpreter.h"
 #include "TROOT.h" // IsImplicitMTEnabled
 #include "TTreeReader.h"
@@ -44,14 +55,175 @@ class TSpinMutex;
 using namespace ROOT::Detail::TDF;
 using namespace ROOT::Internal::TDF;
 
+namespace {
+/// Collect the time spent reading and decompressing baskets in a slot. ROOT reports these operations to the
+/// TVirtualPerfStats object of the thread, gPerfStats, unless the tree has its own, see TTree::SetPerfStats.
+class TSlotPerfStats final : public TVirtualPerfStats {
+   TSlotProfile &fSlot;
+
+public:
+   TSlotPerfStats(TSlotProfile &slot) : fSlot(slot) {}
+   void SimpleEvent(EEventType) final {}
+   void PacketEvent(const char *, const char *, const char *, Long64_t, Double_t, Double_t, Double_t, Long64_t) final
+   {
+   }
+   void FileEvent(const char *, const char *, const char *, const char *, Bool_t) final {}
+   void FileOpenEvent(TFile *, const char *, Double_t) final {}
+   void FileReadEvent(TFile *, Int_t len, Double_t start) final
+   {
+      const Double_t dtime = Double_t(TTimeStamp()) - start;
+      fSlot.fFileReadTime += dtime;
+      fSlot.fBytesRead += len;
+      fSlot.fNested += dtime; // not part of the time of the node reading the entry
+   }
+   void UnzipEvent(TObject *, Long64_t, Double_t start, Int_t, Int_t) final
+   {
+      const Double_t dtime = Double_t(TTimeStamp()) - start;
+      fSlot.fUnzipTime += dtime;
+      fSlot.fNested += dtime;
+   }
+   void RateEvent(Double_t, Double_t, Long64_t, Long64_t) final {}
+   void SetBytesRead(Long64_t num) final { fSlot.fBytesRead = num; }
+   Long64_t GetBytesRead() const final { return fSlot.fBytesRead; }
+   void SetNumEvents(Long64_t) final {}
+   Long64_t GetNumEvents() const final { return fSlot.fNEntries; }
+};
+
+/// Profile a task processing entries in a slot, if the event loop is profiled: collect the time spent reading and
+/// decompressing baskets in the thread running the task and the duration of the task.
+class TTaskProfileScope {
+   TSlotProfile *fSlot = nullptr;
+   std::unique_ptr<TSlotPerfStats> fPerfStats;
+   TVirtualPerfStats *fPrevPerfStats = nullptr;
+   std::chrono::steady_clock::time_point fStart;
+
+public:
+   TTaskProfileScope(TLoopProfile *profile, unsigned int slot)
+   {
+      if (!profile)
+         return;
+      fSlot = &profile->fSlots[slot];
+      fPerfStats.reset(new TSlotPerfStats(*fSlot));
+      fPrevPerfStats = gPerfStats;
+      gPerfStats = fPerfStats.get();
+      fStart = std::chrono::steady_clock::now();
+   }
+   TTaskProfileScope(const TTaskProfileScope &) = delete;
+   TTaskProfileScope &operator=(const TTaskProfileScope &) = delete;
+   ~TTaskProfileScope()
+   {
+      if (!fSlot)
+         return;
+      fSlot->fTaskTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - fStart).count();
+      gPerfStats = fPrevPerfStats;
+   }
+};
+} // anonymous namespace
+
 namespace ROOT {
 namespace Internal {
 namespace TDF {
 
+std::string GetActionProfileName(const std::type_info &helperType, const ColumnNames_t &columns)
+{
+   int err = 0;
+   char *demangled = TClassEdit::DemangleTypeIdName(helperType, err);
+   std::string name = demangled && !err ? demangled : helperType.name();
+   free(demangled);
+   // keep the unqualified name of the helper class, without template arguments
+   name = name.substr(0, name.find('<'));
+   const auto lastColons = name.rfind("::");
+   if (lastColons != std::string::npos)
+      name = name.substr(lastColons + 2);
+   const std::string suffix = "Helper";
+   if (name.size() > suffix.size() && 0 == name.compare(name.size() - suffix.size(), suffix.size(), suffix))
+      name.resize(name.size() - suffix.size());
+   name += "(";
+   for (auto i = 0u; i < columns.size(); ++i)
+      name += (i ? ", " : "") + columns[i];
+   return name + ")";
+}
+
+std::string GetFilterProfileName(const std::string &name, const ColumnNames_t &columns)
+{
+   if (!name.empty())
+      return name;
+   std::string profileName = "unnamed(";
+   for (auto i = 0u; i < columns.size(); ++i)
+      profileName += (i ? ", " : "") + columns[i];
+   return profileName + ")";
+}
+
 TActionBase::TActionBase(TLoopManager *implPtr, const unsigned int nSlots) : fImplPtr(implPtr), fNSlots(nSlots)
 {
 }
 
+TTree *GetBatchTree(TTreeReader &r, Long64_t &entry)
+{
+   // For a TChain, the current tree knows the local entry number
+   TTree *tree = r.GetTree()->GetTree();
+   entry = tree->GetReadEntry();
+   return tree;
+}
+
+Long64_t GetBatchEnd(TTree &tree, Long64_t entry)
+{
+   // Enough to keep the input and output columns of a kernel in the CPU caches for typical trees, while
+   // amortizing the per-batch overhead.
+   const Long64_t kMaxBatchSize = 65536;
+   auto clusterIter = tree.GetClusterIterator(entry);
+   clusterIter();
+   return std::min(std::min(clusterIter.GetNextEntry(), tree.GetEntries()), entry + kMaxBatchSize);
+}
+
+void ReadBatchColumn(TTree &tree, const std::string &column, const std::type_info &type, unsigned int typeSize,
+                     Long64_t first, Long64_t n, void *buffer)
+{
+   auto branch = tree.GetBranch(column.c_str());
+   if (!branch) {
+      const auto msg = "Column \"" + column + "\" is not a branch of tree \"" + tree.GetName() +
+                       "\": batch transformations can only read the branches of a TTree";
+      throw std::runtime_error(msg);
+   }
+   if (branch->GetBulkEntrySize() != (Int_t)typeSize) {
+      const auto msg = "Column \"" + column +
+                       "\" cannot be read in batches: only branches holding a single value of a basic type are supported";
+      throw std::runtime_error(msg);
+   }
+   const std::string leafType = static_cast<TLeaf *>(branch->GetListOfLeaves()->At(0))->GetTypeName();
+   const std::string requestedType = TDataType::GetTypeName(TDataType::GetType(type));
+   if (leafType != requestedType && !(leafType == "Bool_t" && typeSize == 1)) {
+      const auto msg = "Column \"" + column + "\" holds values of type " + leafType + ", not " + requestedType;
+      throw std::runtime_error(msg);
+   }
+   if (branch->GetBulkEntries(first, n, buffer) != n) {
+      const auto msg = "Cannot read the entries " + std::to_string(first) + " to " + std::to_string(first + n - 1) +
+                       " of column \"" + column + "\"";
+      throw std::runtime_error(msg);
+   }
+}
+
+void CheckBatchResultSize(const std::string &nodeName, std::size_t size, Long64_t expected)
+{
+   if ((Long64_t)size != expected) {
+      const auto msg = "The kernel of batch transformation \"" + nodeName + "\" returned " + std::to_string(size) +
+                       " values for a batch of " + std::to_string(expected) + " entries";
+      throw std::runtime_error(msg);
+   }
+}
+
+void RunLoopsJointly(const std::vector<std::shared_ptr<TLoopManager>> &loops)
+{
+   std::vector<TLoopManager *> toRun;
+   for (auto &loop : loops) {
+      if (loop)
+         toRun.emplace_back(loop.get());
+   }
+   if (toRun.empty())
+      return;
+   toRun.front()->RunJointly(std::vector<TLoopManager *>(toRun.begin() + 1, toRun.end()));
+}
+
 } // end NS TDF
 } // end NS Internal
 } // end NS ROOT
@@ -183,6 +355,7 @@ void TLoopManager::RunEmptySourceMT()
    // Each task will generate a subrange of entries
    auto genFunction = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
       auto slot = slotStack.GetSlot();
+      TTaskProfileScope profileScope(GetActiveProfile(), slot);
       InitNodeSlots(nullptr, slot);
       for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
          RunAndCheckFilters(slot, currEntry);
@@ -200,8 +373,9 @@ void TLoopManager::RunEmptySourceMT()
 /// Run event loop with no source files, in sequence.
 void TLoopManager::RunEmptySource()
 {
+   TTaskProfileScope profileScope(GetActiveProfile(), 0);
    InitNodeSlots(nullptr, 0);
-   for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
+   for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && HasEntriesToProcess(); ++currEntry) {
       RunAndCheckFilters(0, currEntry);
    }
 }
@@ -217,9 +391,10 @@ void TLoopManager::RunTreeProcessorMT()
 
    tp->Process([this, &slotStack](TTreeReader &r) -> void {
       auto slot = slotStack.GetSlot();
+      TTaskProfileScope profileScope(GetActiveProfile(), slot);
       InitNodeSlots(&r, slot);
       // recursive call to check filters and conditionally execute actions
-      while (r.Next()) {
+      while (ReadNextEntry(r, slot)) {
          RunAndCheckFilters(slot, r.GetCurrentEntry());
       }
       CleanUpTask(slot);
@@ -232,14 +407,21 @@ void TLoopManager::RunTreeProcessorMT()
 void TLoopManager::RunTreeReader()
 {
    TTreeReader r(fTree.get());
-   if (0 == fTree->GetEntriesFast())
+   if (0 == fTree->GetEntriesFast() || (fEntriesRange.second >= 0 && fEntriesRange.first >= fEntriesRange.second))
       return;
-   InitNodeSlots(&r, 0);
+   if ((fEntriesRange.first > 0 || fEntriesRange.second >= 0) &&
+       r.SetEntriesRange(fEntriesRange.first, fEntriesRange.second) != TTreeReader::kEntryValid)
+      throw std::runtime_error("Cannot read the entries [" + std::to_string(fEntriesRange.first) + ", " +
+                               std::to_string(fEntriesRange.second) + ") of the tree.");
+   {
+      TTaskProfileScope profileScope(GetActiveProfile(), 0);
+      InitNodeSlots(&r, 0);
 
-   // recursive call to check filters and conditionally execute actions
-   // in the non-MT case processing can be stopped early by ranges, hence the check on fNStopsReceived
-   while (r.Next() && fNStopsReceived < fNChildren) {
-      RunAndCheckFilters(0, r.GetCurrentEntry());
+      // recursive call to check filters and conditionally execute actions
+      // in the non-MT case processing can be stopped early by ranges, hence the check on fNStopsReceived
+      while (ReadNextEntry(r, 0) && HasEntriesToProcess()) {
+         RunAndCheckFilters(0, r.GetCurrentEntry());
+      }
    }
    fTree->GetEntry(0);
 }
@@ -251,12 +433,13 @@ void TLoopManager::RunDataSource()
    fDataSource->Initialise();
    auto ranges = fDataSource->GetEntryRanges();
    while (!ranges.empty()) {
+      TTaskProfileScope profileScope(GetActiveProfile(), 0u);
       InitNodeSlots(nullptr, 0u);
       fDataSource->InitSlot(0u, 0ull);
       for (const auto &range : ranges) {
          auto end = range.second;
          for (auto entry = range.first; entry < end; ++entry) {
-            fDataSource->SetEntry(0u, entry);
+            SetDataSourceEntry(0u, entry);
             RunAndCheckFilters(0u, entry);
          }
       }
@@ -277,11 +460,12 @@ void TLoopManager::RunDataSourceMT()
    // Each task works on a subrange of entries
    auto runOnRange = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
       const auto slot = slotStack.GetSlot();
+      TTaskProfileScope profileScope(GetActiveProfile(), slot);
       InitNodeSlots(nullptr, slot);
       fDataSource->InitSlot(slot, range.first);
       const auto end = range.second;
       for (auto entry = range.first; entry < end; ++entry) {
-         fDataSource->SetEntry(slot, entry);
+         SetDataSourceEntry(slot, entry);
          RunAndCheckFilters(slot, entry);
       }
       CleanUpTask(slot);
@@ -303,12 +487,40 @@ void TLoopManager::RunDataSourceMT()
 /// Named filters must be called even if the analysis logic would not require it, lest they report confusing results.
 void TLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 {
+   if (fIsProfiling)
+      ++fProfile->fSlots[slot].fNEntries;
    for (auto &actionPtr : fBookedActions)
       actionPtr->Run(slot, entry);
    for (auto &namedFilterPtr : fBookedNamedFilters)
       namedFilterPtr->CheckFilters(slot, entry);
    for (auto &callback : fCallbacks)
       callback(slot);
+   for (auto loop : fJoinedLoops)
+      loop->RunAndCheckFilters(slot, entry);
+}
+
+/// Move the reader to the next entry, timing the read if the event loop is profiled.
+bool TLoopManager::ReadNextEntry(TTreeReader &r, unsigned int slot)
+{
+   if (!fIsProfiling)
+      return r.Next();
+   auto &slotProfile = fProfile->fSlots[slot];
+   ++slotProfile.fNReads;
+   TProfileTimer timer(slotProfile, slotProfile.fReadTime);
+   return r.Next();
+}
+
+/// Move the data source to an entry, timing the read if the event loop is profiled.
+void TLoopManager::SetDataSourceEntry(unsigned int slot, ULong64_t entry)
+{
+   if (!fIsProfiling) {
+      fDataSource->SetEntry(slot, entry);
+      return;
+   }
+   auto &slotProfile = fProfile->fSlots[slot];
+   ++slotProfile.fNReads;
+   TProfileTimer timer(slotProfile, slotProfile.fReadTime);
+   fDataSource->SetEntry(slot, entry);
 }
 
 /// Build TTreeReaderValues for all nodes
@@ -327,6 +539,9 @@ void TLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
       ptr->InitSlot(r, slot);
    for (auto &callback : fCallbacksOnce)
       callback(slot);
+   // the graphs run in the same event loop share the TTreeReader of the slot
+   for (auto loop : fJoinedLoops)
+      loop->InitNodeSlots(r, slot);
 }
 
 /// Initialize all nodes of the functional graph before running the event loop.
@@ -342,6 +557,37 @@ void TLoopManager::InitNodes()
       customColumn.second->InitNode();
    for (auto &range : fBookedRanges)
       range->InitNode();
+   InitNodeProfiles();
+}
+
+/// Give the nodes their profiling counters, if the event loop is profiled, or detach them from the counters.
+void TLoopManager::InitNodeProfiles()
+{
+   auto profile = GetActiveProfile();
+   // filters and custom columns keep their counters across the event loops, actions run a single event loop
+   auto getProfile = [profile](const void *node, const std::string &kind, const std::string &name) {
+      auto &nodeProfile = profile->fNodeProfiles[node];
+      if (!nodeProfile) {
+         profile->fNodes.emplace_back(new TNodeProfile(kind, name, profile->fSlots));
+         nodeProfile = profile->fNodes.back().get();
+      }
+      return nodeProfile;
+   };
+   for (auto &filter : fBookedFilters)
+      filter->SetProfile(profile ? getProfile(filter.get(), "Filter", filter->GetProfileName()) : nullptr);
+   for (auto &column : fBookedCustomColumns) {
+      // the columns of a data source are read as a whole, see SetDataSourceEntry
+      const bool isProfiled = profile && !column.second->IsDataSourceColumn();
+      column.second->SetProfile(isProfiled ? getProfile(column.second.get(), "Define", column.first) : nullptr);
+   }
+   for (auto &action : fBookedActions) {
+      TNodeProfile *actionProfile = nullptr;
+      if (profile) {
+         profile->fNodes.emplace_back(new TNodeProfile("Action", action->GetProfileName(), profile->fSlots));
+         actionProfile = profile->fNodes.back().get();
+      }
+      action->SetProfile(actionProfile);
+   }
 }
 
 /// Perform clean-up operations. To be called at the end of each event loop.
@@ -379,11 +625,14 @@ void TLoopManager::CleanUpTask(unsigned int slot)
       ptr->ClearValueReaders(slot);
    for (auto &pair : fBookedCustomColumns)
       pair.second->ClearValueReaders(slot);
+   for (auto loop : fJoinedLoops)
+      loop->CleanUpTask(slot);
 }
 
 /// Jit all actions that required runtime column type inference, and clean the `fToJit` member variable.
 void TLoopManager::JitActions()
 {
+   TJitTimer timer(GetJitTimes().fActions);
    auto error = TInterpreter::EErrorCode::kNoError;
    gInterpreter->Calc(fToJit.c_str(), &error);
    if (TInterpreter::EErrorCode::kNoError != error) {
@@ -414,9 +663,16 @@ void TLoopManager::Run()
 {
    if (!fToJit.empty())
       JitActions();
+   for (auto loop : fJoinedLoops) {
+      if (!loop->fToJit.empty())
+         loop->JitActions();
+   }
 
    InitNodes();
+   for (auto loop : fJoinedLoops)
+      loop->InitNodes();
 
+   const auto loopStart = std::chrono::steady_clock::now();
    switch (fLoopType) {
    case ELoopType::kNoFilesMT: RunEmptySourceMT(); break;
    case ELoopType::kROOTFilesMT: RunTreeProcessorMT(); break;
@@ -425,8 +681,86 @@ void TLoopManager::Run()
    case ELoopType::kROOTFiles: RunTreeReader(); break;
    case ELoopType::kDataSource: RunDataSource(); break;
    }
+   if (fIsProfiling) {
+      fProfile->fLoopTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - loopStart).count();
+      ++fProfile->fNLoops;
+   }
 
    CleanUpNodes();
+   for (auto loop : fJoinedLoops)
+      loop->CleanUpNodes();
+}
+
+/// Run the event loop of this TLoopManager together with the ones of `others`, in a single pass over the data.
+/// All the loop managers must read the same data (see HasSameSource): the nodes of all the graphs are initialized
+/// with the TTreeReader of this loop manager, so that each entry is read only once.
+void TLoopManager::RunJointly(const std::vector<TLoopManager *> &others)
+{
+   for (auto other : others) {
+      if (other == this || std::find(fJoinedLoops.begin(), fJoinedLoops.end(), other) != fJoinedLoops.end())
+         continue;
+      if (!HasSameSource(*other)) {
+         fJoinedLoops.clear();
+         throw std::runtime_error(
+            "The event loops of TDataFrames reading different data cannot be run jointly, or they read a data source.");
+      }
+      fJoinedLoops.emplace_back(other);
+   }
+
+   try {
+      Run();
+   } catch (...) {
+      fJoinedLoops.clear();
+      throw;
+   }
+   fJoinedLoops.clear();
+}
+
+/// Whether any node of the graphs run in this event loop can still accept entries: ranges can stop them early
+bool TLoopManager::HasEntriesToProcess() const
+{
+   if (fNStopsReceived < fNChildren)
+      return true;
+   return std::any_of(fJoinedLoops.begin(), fJoinedLoops.end(),
+                      [](const TLoopManager *loop) { return loop->fNStopsReceived < loop->fNChildren; });
+}
+
+/// Whether the event loop of another TLoopManager goes over the same entries in the same way as this one
+bool TLoopManager::HasSameSource(const TLoopManager &other) const
+{
+   // data sources cannot share their readers between TDataFrames
+   if (fLoopType != other.fLoopType || fNSlots != other.fNSlots || fDataSource || other.fDataSource ||
+       fEntriesRange != other.fEntriesRange)
+      return false;
+   if (!fTree || !other.fTree)
+      return !fTree && !other.fTree && fNEmptyEntries == other.fNEmptyEntries;
+   if (fTree == other.fTree)
+      return true;
+   if (std::string(fTree->GetName()) != other.fTree->GetName())
+      return false;
+
+   auto getFileNames = [](TTree &tree) {
+      std::vector<std::string> fileNames;
+      if (auto chain = dynamic_cast<TChain *>(&tree)) {
+         for (auto element : *chain->GetListOfFiles())
+            fileNames.emplace_back(element->GetTitle());
+      } else if (auto file = tree.GetCurrentFile()) {
+         fileNames.emplace_back(file->GetName());
+      }
+      return fileNames;
+   };
+   const auto fileNames = getFileNames(*fTree);
+   return !fileNames.empty() && fileNames == getFileNames(*other.fTree);
+}
+
+/// Restrict the event loop to the tree entries in [begin, end), all the entries from begin if end is negative.
+/// Only sequential event loops over a TTree or TChain can be restricted: this is how each worker process of a
+/// TProcessRunner reads its part of the dataset.
+void TLoopManager::SetEntriesRange(Long64_t begin, Long64_t end)
+{
+   if (fLoopType != ELoopType::kROOTFiles)
+      throw std::runtime_error("Only sequential event loops over a TTree can be restricted to a range of entries.");
+   fEntriesRange = std::make_pair(begin, end);
 }
 
 TLoopManager *TLoopManager::GetImplPtr()
@@ -508,6 +842,37 @@ void TLoopManager::RegisterCallback(ULong64_t everyNEvents, std::function<void(u
       fCallbacks.emplace_back(everyNEvents, std::move(f), fNSlots);
 }
 
+/// Start profiling the event loops, discarding the previous profile, or stop profiling them.
+void TLoopManager::EnableProfiling(bool enable)
+{
+   if (enable)
+      fProfile.reset(new TLoopProfile(fNSlots));
+   fIsProfiling = enable;
+}
+
+/// Return the profile of the event loops run since profiling was last enabled, empty if it never was.
+ROOT::Experimental::TDF::TProfileReport TLoopManager::GetProfileReport() const
+{
+   ROOT::Experimental::TDF::TProfileReport rep;
+   if (!fProfile)
+      return rep;
+   for (const auto &slot : fProfile->fSlots)
+      rep.fSlots.emplace_back(static_cast<const ROOT::Experimental::TDF::TSlotProfileInfo &>(slot));
+   for (const auto &node : fProfile->fNodes) {
+      ROOT::Experimental::TDF::TNodeProfileInfo info;
+      info.fKind = node->fKind;
+      info.fName = node->fName;
+      for (const auto &nodeSlot : node->fNodeSlots) {
+         info.fCalls.emplace_back(nodeSlot.fCalls);
+         info.fTimes.emplace_back(nodeSlot.fTime);
+      }
+      rep.fNodes.emplace_back(std::move(info));
+   }
+   rep.fLoopTime = fProfile->fLoopTime;
+   rep.fNLoops = fProfile->fNLoops;
+   return rep;
+}
+
 TRangeBase::TRangeBase(TLoopManager *implPtr, unsigned int start, unsigned int stop, unsigned int stride,
                        const unsigned int nSlots)
    : fImplPtr(implPtr), fStart(start), fStop(stop), fStride(stride), fNSlots(nSlots)
@@ -22,6 +22,7 @@
 #include "TClassRef.h"
 #include "TLeaf.h"
 #include "TObjArray.h"
+#include "TPerfCounters.h"
 #include "TROOT.h" // IsImplicitMTEnabled, GetImplicitMTPoolSize
 #include "TTree.h"
 
@@ -214,6 +215,22 @@ unsigned int GetNSlots()
    return nSlots;
 }
 
+TJitTimes &GetJitTimes()
+{
+   static TJitTimes times;
+   return times;
+}
+
+/// Also published as root_jit_seconds_total by ROOT::TPerfCounters
+TJitTimer::~TJitTimer()
+{
+   static const auto jitTime = ROOT::TPerfCounters::Register("root_jit_seconds_total", "Time spent jitting",
+                                                            ROOT::TPerfCounters::kCounter, 1e-9);
+   const auto elapsed = std::chrono::steady_clock::now() - fStart;
+   fCounter += std::chrono::duration<double>(elapsed).count();
+   jitTime.Add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
 } // end NS TDF
 } // end NS Internal
 } // end NS ROOT
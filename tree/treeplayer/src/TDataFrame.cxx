@@ -9,6 +9,7 @@
  *************************************************************************/
 
 #include <algorithm>
+#include <sstream>
 #include <stdexcept>
 
 #include "ROOT/TDataFrame.hxx"
@@ -316,6 +317,15 @@ simultaneously.
 It is therefore good practice to declare all your transformations and actions *before* accessing their results, allowing
 `TDataFrame` to run the loop once and produce all results in one go.
 
+Results of *different* `TDataFrame`s reading the same data, e.g. independent graphs for systematic variations, can
+also be produced in one event loop with `RunGraphs`: the entries are then read only once for all the graphs.
+~~~{.cpp}
+TDataFrame nominal("treeName", "file.root"), varied("treeName", "file.root");
+auto h1 = nominal.Filter("MET > 10").Histo1D("pt_v");
+auto h2 = varied.Filter("MET > 12").Histo1D("pt_v");
+RunGraphs(h1, h2); // a single event loop fills both histograms
+~~~
+
 ### Going parallel
 Let's say we would like to run the previous examples in parallel on several cores, dividing events fairly between cores.
 The only modification required to the snippets would be the addition of this line *before* constructing the main
@@ -469,6 +479,12 @@ auto filteredEvents =
 auto h = filteredEvents.Histo1D("m");
 h->Draw();
 ~~~
+If ROOT was built with the `arrow` option, the `TArrowDS` reads Apache Arrow tables without copying their numeric
+columns, for instance tables read from Parquet files by the Arrow libraries:
+~~~{.cpp}
+std::shared_ptr<arrow::Table> table = ReadMyTable(); // e.g. with parquet::arrow::FileReader::ReadTable
+auto tdf = ROOT::Experimental::TDF::MakeArrowDataFrame(table, {"pt", "eta"});
+~~~
 
 
 ### <a name="callgraphs"></a>Call graphs (storing and reusing sets of transformations)
@@ -512,6 +528,38 @@ Objects read from each column are **built once and never copied**, for maximum e
 When "upstream" filters are not passed, subsequent filters, temporary column expressions and actions are not evaluated,
 so it might be advisable to put the strictest filters first in the chain.
 
+### <a name="jit-cache"></a>Caching the jitted string expressions
+Just-in-time compilation of the string expressions passed to `Filter` and `Define` can take seconds per expression.
+When the same analysis runs many times, the compiled expressions can be kept on disk and reused by later processes:
+~~~{.cpp}
+gEnv->SetValue("TDataFrame.JitCacheDir", "/path/to/jitcache"); // or in .rootrc
+~~~
+Each expression, together with the names and types of the columns it uses, is then compiled with ACLiC into a
+library of that directory the first time it is met, and later runs only load the library. Expressions that cannot be
+compiled outside of the interpreter, e.g. because they call functions only declared at the prompt, are remembered as
+such and jitted as usual. `TDataFrame::PrintJitReport()` prints the time the process spent jitting so far.
+
+### <a name="profiling"></a>Profiling the event loop
+To find the nodes of a computation graph which take the most time, the event loops can be profiled:
+~~~{.cpp}
+TDataFrame d("events", "file.root");
+d.EnableProfiling();
+auto h = d.Filter("pt > 10", "ptCut").Define("e", "sqrt(pt * pt + m * m)").Histo1D("e");
+h->Draw(); // runs the event loop
+auto profile = d.GetProfileReport();
+profile.Print(); // the nodes sorted by time, one line each
+std::ofstream("profile.json") << profile.AsJSON();
+~~~
+The report holds, for each `Filter`, `Define` and action and for each processing slot, the number of calls and the
+time spent in the node, excluding the time of the nodes it evaluates on demand and the time spent reading the entries.
+The latter is split between the calls to `TTreeReader::Next` or `TDataSource::SetEntry`, the decompression of the
+baskets and the reads from the files; deserialising the values read is part of the time of the first node reading
+them. Named filters appear with their name, unnamed ones with their columns. The report can also be converted to a
+TTree, with one entry per node and slot, e.g. to be written to a file with the other results of a job.
+Profiling accumulates over the event loops run until it is disabled with `EnableProfiling(false)`; it adds a few
+tens of nanoseconds to each call of a node. The decompression of the baskets is not timed for trees with their own
+TTreePerfStats nor when decompressed in advance by TTreeCacheUnzip.
+
 ##  <a name="transformations"></a>Transformations
 ### <a name="Filters"></a> Filters
 A filter is defined through a call to `Filter(f, columnList)`. `f` can be a function, a lambda expression, a functor
@@ -627,7 +675,7 @@ note that all actions are only executed for events that pass all preceding filte
 | Foreach | Execute a user-defined function on each entry. Users are responsible for the thread-safety of this lambda when executing with implicit multi-threading enabled. |
 | ForeachSlot | Same as `Foreach`, but the user-defined function must take an extra `unsigned int slot` as its first parameter. `slot` will take a different value, `0` to `nThreads - 1`, for each thread of execution. This is meant as a helper in writing thread-safe `Foreach` actions when using `TDataFrame` after `ROOT::EnableImplicitMT()`. `ForeachSlot` works just as well with single-thread execution: in that case `slot` will always be `0`. |
 | Snapshot | Writes processed data-set to disk, in a new `TTree` and `TFile`. Custom columns can be saved as well, filtered entries are not saved. Users can specify which columns to save (default is all). Snapshot, by default, overwrites the output file if it already exists. |
-| Cache | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). |
+| Cache | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). With a `TCacheOptions` argument, the columns are instead stored in compressed chunks which can be moved to a scratch file when they exceed a given amount of memory. |
 
 
 | **Queries** | **Description** |
@@ -647,6 +695,29 @@ Most `Filter`/`Define` functions will in fact be pure in the functional programm
 All actions are built to be thread-safe with the exception of `Foreach`, in which case users are responsible of
 thread-safety, see [here](#generic-actions).
 
+### Snapshot in multi-thread runs
+In a multi-thread event loop `Snapshot` still writes a single output file: each worker thread fills and compresses
+the baskets of its own copy of the output tree, and a `ROOT::Experimental::TBufferMerger` appends them to the output
+file. The entries are therefore written in the order in which the tasks complete. When the input is a `TTree` and the
+original order matters, set the `fPreserveClusterOrder` member of the `TSnapshotOptions` passed to `Snapshot`: the
+output of each task is then kept in memory until the end of the event loop and merged in the order of the input
+entries.
+
+### Processing a dataset in several processes
+`ROOT::Experimental::TDF::TProcessRunner` spreads an analysis over worker processes instead of threads. The
+computation graph is written as a function that receives the `TDataFrame` of a part of the dataset and books the
+results to merge, histograms or arithmetic values, with a name:
+~~~{.cpp}
+ROOT::Experimental::TDF::TProcessRunner runner(8);
+auto results = runner.Run("events", fileNames, [](TDataFrame &d, TDistributedResults &r) {
+   r.Book("n", d.Filter("pt > 10").Count());
+   r.Book("pt", d.Histo1D({"pt", "pt", 100, 0, 100}, "pt"));
+});
+std::cout << results.GetValue<ULong64_t>("n") << std::endl;
+~~~
+The results of the workers are merged as they arrive; `TProcessRunner::SetMonitor` registers a function called with
+the results merged so far.
+
 <a name="reference"></a>
 */
 // clang-format on
@@ -752,3 +823,27 @@ TDataFrame::TDataFrame(std::unique_ptr<TDataSource> ds, const ColumnNames_t &def
    : TInterface<TDFDetail::TLoopManager>(std::make_shared<TDFDetail::TLoopManager>(std::move(ds), defaultBranches))
 {
 }
+
+//////////////////////////////////////////////////////////////////////////
+/// \brief Print the time spent so far in this process jitting string expressions and actions.
+///
+/// The time is split between the validation of the expressions, the jitting of the `Filter` and `Define` calls,
+/// the jit cache (see [here](#jit-cache)) and the jitting of the actions with inferred column types.
+void TDataFrame::PrintJitReport()
+{
+   const auto &times = TDFInternal::GetJitTimes();
+   const auto total =
+      times.fValidation + times.fTransformations + times.fCacheBuild + times.fCacheLoad + times.fActions;
+   // formatted apart, so that the state of std::cout is left untouched
+   std::ostringstream os;
+   os << "TDataFrame jitting: " << times.fNExpressions << " string expressions, " << times.fNCacheHits
+      << " taken from and " << times.fNCacheBuilds << " compiled into the jit cache\n"
+      << std::fixed << std::setprecision(3) << std::left << std::setw(32) << "  Expression validation"
+      << times.fValidation << " s\n"
+      << std::setw(32) << "  Filter/Define calls" << times.fTransformations << " s\n"
+      << std::setw(32) << "  Jit cache, compilation" << times.fCacheBuild << " s\n"
+      << std::setw(32) << "  Jit cache, loading" << times.fCacheLoad << " s\n"
+      << std::setw(32) << "  Actions" << times.fActions << " s\n"
+      << std::setw(32) << "  Total" << total << " s";
+   std::cout << os.str() << std::endl;
+}
@@ -14,8 +14,10 @@
 #include "MPSendRecv.h"
 #include "TError.h"
 #include "TMPWorkerTree.h"
+#include "TChain.h"
 #include "TSystem.h"
 #include "TEnv.h"
+#include <algorithm>
 #include <string>
 
 //////////////////////////////////////////////////////////////////////////
@@ -45,7 +47,7 @@
 /// members must be done _after_ forking by each of the children processes.
 TMPWorkerTree::TMPWorkerTree()
    : TMPWorker(), fFileNames(), fTreeName(), fTree(nullptr), fFile(nullptr), fEntryList(nullptr), fFirstEntry(0),
-     fTreeCache(0), fTreeCacheIsLearning(kFALSE), fUseTreeCache(kTRUE), fCacheSize(-1)
+     fNRangesPerWorker(1), fTreeCache(0), fTreeCacheIsLearning(kFALSE), fUseTreeCache(kTRUE), fCacheSize(-1)
 {
    Setup();
 }
@@ -53,8 +55,8 @@ TMPWorkerTree::TMPWorkerTree()
 TMPWorkerTree::TMPWorkerTree(const std::vector<std::string> &fileNames, TEntryList *entries,
                              const std::string &treeName, UInt_t nWorkers, ULong64_t maxEntries, ULong64_t firstEntry)
    : TMPWorker(nWorkers, maxEntries), fFileNames(fileNames), fTreeName(treeName), fTree(nullptr), fFile(nullptr),
-     fEntryList(entries), fFirstEntry(firstEntry), fTreeCache(0), fTreeCacheIsLearning(kFALSE), fUseTreeCache(kTRUE),
-     fCacheSize(-1)
+     fEntryList(entries), fFirstEntry(firstEntry), fNRangesPerWorker(1), fTreeCache(0), fTreeCacheIsLearning(kFALSE),
+     fUseTreeCache(kTRUE), fCacheSize(-1)
 {
    Setup();
 }
@@ -62,7 +64,7 @@ TMPWorkerTree::TMPWorkerTree(const std::vector<std::string> &fileNames, TEntryLi
 TMPWorkerTree::TMPWorkerTree(TTree *tree, TEntryList *entries, UInt_t nWorkers, ULong64_t maxEntries,
                              ULong64_t firstEntry)
    : TMPWorker(nWorkers, maxEntries), fTree(tree), fFile(nullptr), fEntryList(entries), fFirstEntry(firstEntry),
-     fTreeCache(0), fTreeCacheIsLearning(kFALSE), fUseTreeCache(kTRUE), fCacheSize(-1)
+     fNRangesPerWorker(1), fTreeCache(0), fTreeCacheIsLearning(kFALSE), fUseTreeCache(kTRUE), fCacheSize(-1)
 {
    Setup();
 }
@@ -80,6 +82,11 @@ void TMPWorkerTree::Setup()
    Int_t uc = gEnv->GetValue("MultiProc.UseTreeCache", 0);
    if (uc != 1) fUseTreeCache = kFALSE;
    fCacheSize = gEnv->GetValue("MultiProc.CacheSize", -1);
+   // Each file (or tree) is split in several ranges per worker: the ranges are handed out
+   // one at a time to the idle workers, so that the fast workers take over the work left
+   // by the slow ones. With a maximum number of entries per worker a single range is used.
+   Int_t nr = gEnv->GetValue("MultiProc.RangesPerWorker", 4);
+   fNRangesPerWorker = (nr > 1 && fMaxNEntries == 0) ? nr : 1;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -270,6 +277,27 @@ void TMPWorkerTreeSel::Process(UInt_t code, MPCodeBufPair &msg)
    return;
 }
 
+/// Move an entry number back to the first entry of its cluster, so that the
+/// ranges processed by different workers never share a cluster: its baskets
+/// are then read and uncompressed by one worker only.
+static Long64_t AlignToCluster(TTree *tree, Long64_t entry)
+{
+   if (entry <= 0 || entry >= tree->GetEntries() || dynamic_cast<TChain *>(tree))
+      return entry;
+   auto clusterIt = tree->GetClusterIterator(entry);
+   return clusterIt.GetStartEntry();
+}
+
+/// Evaluate the rangeN-th of nRanges ranges of nEntries entries. The last ranges
+/// are empty if there are fewer entries than ranges.
+static void EvalRange(Long64_t nEntries, UInt_t nRanges, UInt_t rangeN, Long64_t &start, Long64_t &finish)
+{
+   Long64_t nBunch = nEntries / nRanges;
+   if (nEntries % nRanges) nBunch++;
+   start = std::min(rangeN * nBunch, nEntries);
+   finish = (rangeN < nRanges - 1) ? std::min((rangeN + 1) * nBunch, nEntries) : nEntries;
+}
+
 /// Load the requierd tree and evaluate the processing range
 
 Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start, Long64_t &finish, TEntryList **enl,
@@ -303,36 +331,37 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
       nProcessed = ReadBuffer<UInt_t>(msg.second.get());
 
       //create entries range
-      //example: for 21 entries, 4 workers we want ranges 0-5, 5-10, 10-15, 15-21
+      //example: for 21 entries, 4 ranges we want ranges 0-6, 6-12, 12-18, 18-21
       //and this worker must take the rangeN-th range
-      Long64_t nEntries = fTree->GetEntries();
-      UInt_t nBunch = nEntries / fNWorkers;
-      UInt_t rangeN = nProcessed % fNWorkers;
-      start = rangeN * nBunch;
-      if (rangeN < (fNWorkers - 1)) {
-         finish = (rangeN+1)*nBunch;
-      } else {
-         finish = nEntries;
-      }
+      EvalRange(fTree->GetEntries(), GetNRanges(), nProcessed % GetNRanges(), start, finish);
+      start = AlignToCluster(fTree, start);
+      finish = AlignToCluster(fTree, finish);
 
       //process tree
       tree = fTree;
-      CloseFile(); // May not be needed
-      if (fTree->GetCurrentFile()) {
-         // We need to reopen the file locally (TODO: to understand and fix this)
-         if ((fFile = TFile::Open(fTree->GetCurrentFile()->GetName())) && !fFile->IsZombie()) {
-            if (!(tree = (TTree *) fFile->Get(fTree->GetName()))) {
-               errmsg = mgroot + std::string("unable to retrieve tree from open file ") +
-                        std::string(fTree->GetCurrentFile()->GetName());
-               delete fFile;
+      if (fFile && fTree->GetCurrentFile() == fFile) {
+         // the file was reopened for a previous range: keep it, together with its cache
+         setupcache = false;
+      } else {
+         // honor the cache size set by the user on the tree, unless MultiProc.CacheSize is given
+         if (fCacheSize < 0 && fTree->GetCacheSize() > 0) fCacheSize = fTree->GetCacheSize();
+         CloseFile(); // May not be needed
+         if (fTree->GetCurrentFile()) {
+            // We need to reopen the file locally (TODO: to understand and fix this)
+            if ((fFile = TFile::Open(fTree->GetCurrentFile()->GetName())) && !fFile->IsZombie()) {
+               if (!(tree = (TTree *) fFile->Get(fTree->GetName()))) {
+                  errmsg = mgroot + std::string("unable to retrieve tree from open file ") +
+                           std::string(fTree->GetCurrentFile()->GetName());
+                  delete fFile;
+                  return -1;
+               }
+               fTree = tree;
+            } else {
+               //errors are handled inside OpenFile
+               errmsg = mgroot + std::string("unable to open file ") + std::string(fTree->GetCurrentFile()->GetName());
+               if (fFile && fFile->IsZombie()) delete fFile;
                return -1;
             }
-            fTree = tree;
-         } else {
-            //errors are handled inside OpenFile
-            errmsg = mgroot + std::string("unable to open file ") + std::string(fTree->GetCurrentFile()->GetName());
-            if (fFile && fFile->IsZombie()) delete fFile;
-            return -1;
          }
       }
 
@@ -343,7 +372,7 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
          //retrieve the total number of entries ranges processed so far by TPool
          nProcessed = ReadBuffer<UInt_t>(msg.second.get());
          //evaluate the file and the entries range to process
-         fileN = nProcessed / fNWorkers;
+         fileN = nProcessed / GetNRanges();
       } else if (code == MPCode::kProcFile) {
          mgroot += "MPCode::kProcFile: ";
          //evaluate the file and the entries range to process
@@ -381,17 +410,11 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
 
       //create entries range
       if (code == MPCode::kProcRange) {
-         //example: for 21 entries, 4 workers we want ranges 0-5, 5-10, 10-15, 15-21
+         //example: for 21 entries, 4 ranges we want ranges 0-6, 6-12, 12-18, 18-21
          //and this worker must take the rangeN-th range
-         Long64_t nEntries = tree->GetEntries();
-         UInt_t nBunch = nEntries / fNWorkers;
-         if(nEntries % fNWorkers) nBunch++;
-         UInt_t rangeN = nProcessed % fNWorkers;
-         start = rangeN * nBunch;
-         if(rangeN < (fNWorkers-1))
-            finish = (rangeN+1)*nBunch;
-         else
-            finish = nEntries;
+         EvalRange(tree->GetEntries(), GetNRanges(), nProcessed % GetNRanges(), start, finish);
+         start = AlignToCluster(tree, start);
+         finish = AlignToCluster(tree, finish);
       } else {
          start = 0;
          finish = tree->GetEntries();
@@ -406,17 +429,9 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
       if ((*enl = fEntryList->GetEntryList(fTree->GetName(), TUrl(fFile->GetName()).GetFile()))) {
          // create entries range
          if (code == MPCode::kProcRange) {
-            // example: for 21 entries, 4 workers we want ranges 0-5, 5-10, 10-15, 15-21
+            // example: for 21 entries, 4 ranges we want ranges 0-6, 6-12, 12-18, 18-21
             // and this worker must take the rangeN-th range
-            ULong64_t nEntries = (*enl)->GetN();
-            UInt_t nBunch = nEntries / fNWorkers;
-            if (nEntries % fNWorkers) nBunch++;
-            UInt_t rangeN = nProcessed % fNWorkers;
-            start = rangeN * nBunch;
-            if (rangeN < (fNWorkers - 1))
-               finish = (rangeN + 1) * nBunch;
-            else
-               finish = nEntries;
+            EvalRange((*enl)->GetN(), GetNRanges(), nProcessed % GetNRanges(), start, finish);
          } else {
             start = 0;
             finish = (*enl)->GetN();
@@ -432,6 +447,10 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
       if (fProcessedEntries + finish - start > fMaxNEntries)
          finish = start + fMaxNEntries - fProcessedEntries;
 
+   // Restrict the prefetching of the cache to the range of this task, so that the baskets
+   // of the ranges processed by the other workers are not read
+   if (fTreeCache && !(enl && *enl)) fTree->SetCacheEntryRange(start, finish);
+
    if (gDebug > 0 && fFile)
       Info("LoadTree", "%s %d %d file: %s %lld %lld", mgroot.c_str(), nProcessed, fileN, fFile->GetName(), start,
            finish);
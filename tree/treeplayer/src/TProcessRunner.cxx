@@ -0,0 +1,123 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// clang-format off
+/** \class ROOT::Experimental::TDF::TProcessRunner
+    \ingroup dataframe
+    \brief Run a TDataFrame analysis in several worker processes.
+
+A TProcessRunner spreads the processing of a dataset over worker processes, forked by ROOT::TTreeProcessorMP.
+The analysis is written as a function building the computation graph on a TDataFrame and booking, with a name,
+the results to merge in a TDistributedResults object:
+~~~{.cpp}
+ROOT::Experimental::TDF::TProcessRunner runner(8);
+runner.SetMonitor([](const TDistributedResults &partial, unsigned int nWorkersDone) {
+   std::cout << nWorkersDone << " workers done, " << partial.GetValue<ULong64_t>("n") << " entries selected\n";
+});
+auto results = runner.Run("events", {"f1.root", "f2.root"}, [](TDataFrame &d, TDistributedResults &r) {
+   auto sel = d.Filter("pt > 10");
+   r.Book("n", sel.Count());
+   r.Book("ptSum", sel.Sum<double>("pt"));
+   r.Book("pt", sel.Histo1D({"pt", "pt", 100, 0, 100}, "pt"));
+});
+auto h = results.GetObject<TH1D>("pt");
+~~~
+The function runs in each worker process, once for each part of the dataset the worker processes: the ranges of
+entries read by the workers are aligned to the clusters of the trees, or, if the dataset has at least as many files
+as workers, whole files. The workers run sequential event loops. Each worker sends its results to the client as soon
+as it is done with all its parts; the client merges them as they arrive, and calls the monitor function, if any,
+with the results merged so far.
+*/
+// clang-format on
+
+#include "ROOT/TProcessRunner.hxx"
+#include "TROOT.h"
+#include "TTreeReader.h"
+
+namespace ROOT {
+namespace Experimental {
+namespace TDF {
+
+/// Run the event loop, in a worker, and return its booked results for the client
+TList *TDistributedResults::MakeList()
+{
+   auto list = new TList();
+   list->SetOwner(kTRUE);
+   for (auto &maker : fMakers)
+      list->Add(maker());
+   return list;
+}
+
+/// Merge the results of a worker into the results received so far, in the client
+void TDistributedResults::Merge(const TList &results)
+{
+   std::unique_ptr<TList> clone(static_cast<TList *>(results.Clone()));
+   clone->SetOwner(kTRUE);
+   if (!fResults) {
+      fResults = std::move(clone);
+      return;
+   }
+   TList inputs;
+   inputs.Add(clone.get());
+   fResults->Merge(&inputs);
+}
+
+TObject *TDistributedResults::FindResult(const std::string &name) const
+{
+   auto obj = fResults ? fResults->FindObject(name.c_str()) : nullptr;
+   if (!obj)
+      throw std::runtime_error("No result named " + name + " was received from the workers.");
+   return obj;
+}
+
+TProcessRunner::TProcessRunner(unsigned int nWorkers) : fPool(nWorkers)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// \brief Process a dataset with the computation graph built by a function, in the worker processes
+/// \param[in] treeName Name of the TTree in the files.
+/// \param[in] fileNames The files to process.
+/// \param[in] builder Function building the computation graph and booking its results.
+/// \return The results booked by the builder, merged across the workers.
+TDistributedResults TProcessRunner::Run(const std::string &treeName, const std::vector<std::string> &fileNames,
+                                        const Builder_t &builder)
+{
+   // executed in the worker processes, for each range of entries or file
+   auto processPart = [&builder](TTreeReader &reader) {
+      ROOT::DisableImplicitMT(); // the workers already run in parallel, each of them runs a sequential event loop
+      TDataFrame d(*reader.GetTree());
+      const auto range = reader.GetEntriesRange();
+      d.GetDataFrameChecked()->SetEntriesRange(range.first, range.second);
+      TDistributedResults results;
+      builder(d, results);
+      return results.MakeList();
+   };
+
+   TDistributedResults partialResults;
+   unsigned int nWorkersDone = 0;
+   if (fMonitor) {
+      fPool.SetResultCallback([this, &partialResults, &nWorkersDone](const TObject &workerResults) {
+         partialResults.Merge(static_cast<const TList &>(workerResults));
+         fMonitor(partialResults, ++nWorkersDone);
+      });
+   }
+   std::unique_ptr<TList> mergedResults(fPool.Process(fileNames, processPart, treeName));
+   fPool.SetResultCallback(nullptr);
+   if (!mergedResults)
+      throw std::runtime_error("TProcessRunner: no result was received from the workers.");
+   mergedResults->SetOwner(kTRUE);
+
+   TDistributedResults results;
+   results.fResults = std::move(mergedResults);
+   return results;
+}
+
+} // ns TDF
+} // ns Experimental
+} // ns ROOT
@@ -0,0 +1,213 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// clang-format off
+/** \class ROOT::Experimental::TDF::TProfileReport
+    \ingroup dataframe
+    \brief The time spent in the nodes of a TDataFrame computation graph, see TInterface::EnableProfiling.
+
+For each node, the report holds the number of calls and the time spent in the node, per processing slot. The time
+of a node excludes the time spent in the nodes it calls, e.g. the time of a `Define` evaluated on demand by a
+`Filter` is not part of the time of the `Filter`, and the time spent reading and decompressing the baskets of the
+input files, reported separately for each slot. The time spent deserialising the values read is part of the time of
+the node which reads them first.
+
+The report can be printed, with the nodes sorted by decreasing time, converted to JSON or to a TTree with one entry
+per node and slot.
+*/
+// clang-format on
+
+#include "ROOT/TProfileReport.hxx"
+#include "TTree.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+void WriteJSONString(std::ostream &os, const std::string &s)
+{
+   os << '"';
+   for (const char c : s) {
+      switch (c) {
+      case '"': os << "\\\""; break;
+      case '\\': os << "\\\\"; break;
+      case '\n': os << "\\n"; break;
+      case '\t': os << "\\t"; break;
+      default:
+         if (static_cast<unsigned char>(c) < 0x20)
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec << std::setfill(' ');
+         else
+            os << c;
+      }
+   }
+   os << '"';
+}
+
+template <typename T>
+void WriteJSONArray(std::ostream &os, const std::vector<T> &values)
+{
+   os << '[';
+   for (std::size_t i = 0; i < values.size(); ++i)
+      os << (i ? "," : "") << values[i];
+   os << ']';
+}
+} // anonymous namespace
+
+namespace ROOT {
+namespace Experimental {
+namespace TDF {
+
+ULong64_t TNodeProfileInfo::GetCalls() const
+{
+   return std::accumulate(fCalls.begin(), fCalls.end(), 0ULL);
+}
+
+double TNodeProfileInfo::GetTime() const
+{
+   return std::accumulate(fTimes.begin(), fTimes.end(), 0.);
+}
+
+TSlotProfileInfo TProfileReport::GetTotals() const
+{
+   TSlotProfileInfo totals;
+   for (const auto &slot : fSlots) {
+      totals.fTaskTime += slot.fTaskTime;
+      totals.fReadTime += slot.fReadTime;
+      totals.fNReads += slot.fNReads;
+      totals.fUnzipTime += slot.fUnzipTime;
+      totals.fFileReadTime += slot.fFileReadTime;
+      totals.fBytesRead += slot.fBytesRead;
+      totals.fNEntries += slot.fNEntries;
+   }
+   return totals;
+}
+
+void TProfileReport::Print() const
+{
+   const auto totals = GetTotals();
+   std::ostringstream os;
+   os << "TDataFrame profile: " << fNLoops << " event loop(s), " << fSlots.size() << " slot(s), "
+      << totals.fNEntries << " entries in " << std::fixed << std::setprecision(3) << fLoopTime << " s";
+   if (fLoopTime > 0.)
+      os << " (" << std::setprecision(0) << totals.fNEntries / fLoopTime << " entries/s)";
+   os << "\n";
+
+   const auto taskTime = totals.fTaskTime > 0. ? totals.fTaskTime : 1.;
+   auto printRow = [&os, taskTime](const std::string &kind, const std::string &name, ULong64_t calls, double time) {
+      os << "  " << std::left << std::setw(8) << kind << std::setw(40) << name << std::right << std::setw(14) << calls
+         << std::fixed << std::setprecision(3) << std::setw(12) << time << std::setprecision(1) << std::setw(12)
+         << (calls ? 1e9 * time / calls : 0.) << std::setw(9) << 100. * time / taskTime << "\n";
+   };
+   os << "  " << std::left << std::setw(48) << "Node" << std::right << std::setw(14) << "Calls" << std::setw(12)
+      << "Time [s]" << std::setw(12) << "ns/call" << std::setw(9) << "%" << "\n";
+   printRow("Read", "entries", totals.fNReads, totals.fReadTime);
+   printRow("Read", "decompression", 0ULL, totals.fUnzipTime);
+   printRow("Read", "files (" + std::to_string(totals.fBytesRead) + " bytes)", 0ULL, totals.fFileReadTime);
+
+   std::vector<const TNodeProfileInfo *> nodes;
+   for (const auto &node : fNodes)
+      nodes.emplace_back(&node);
+   std::stable_sort(nodes.begin(), nodes.end(),
+                    [](const TNodeProfileInfo *a, const TNodeProfileInfo *b) { return a->GetTime() > b->GetTime(); });
+   for (auto node : nodes)
+      printRow(node->GetKind(), node->GetName(), node->GetCalls(), node->GetTime());
+   std::cout << os.str() << std::flush;
+}
+
+/// Return the report as a JSON object, with the counters of each slot
+std::string TProfileReport::AsJSON() const
+{
+   std::ostringstream os;
+   os << std::setprecision(9);
+   os << "{\"loops\":" << fNLoops << ",\"loopTime\":" << fLoopTime << ",\"slots\":[";
+   for (std::size_t i = 0; i < fSlots.size(); ++i) {
+      const auto &slot = fSlots[i];
+      os << (i ? "," : "") << "{\"taskTime\":" << slot.fTaskTime << ",\"readTime\":" << slot.fReadTime
+         << ",\"reads\":" << slot.fNReads << ",\"unzipTime\":" << slot.fUnzipTime
+         << ",\"fileReadTime\":" << slot.fFileReadTime << ",\"bytesRead\":" << slot.fBytesRead
+         << ",\"entries\":" << slot.fNEntries << "}";
+   }
+   os << "],\"nodes\":[";
+   for (std::size_t i = 0; i < fNodes.size(); ++i) {
+      const auto &node = fNodes[i];
+      os << (i ? "," : "") << "{\"kind\":";
+      WriteJSONString(os, node.fKind);
+      os << ",\"name\":";
+      WriteJSONString(os, node.fName);
+      os << ",\"calls\":";
+      WriteJSONArray(os, node.fCalls);
+      os << ",\"times\":";
+      WriteJSONArray(os, node.fTimes);
+      os << "}";
+   }
+   os << "]}";
+   return os.str();
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// \brief Return the report as a TTree, with one entry per node and slot
+///
+/// The branches are `kind`, `name`, `slot`, `calls` and `time`. The reading of the slots is stored in the entries of
+/// kind `Read`, named `entries`, `decompression` and `files`. Like any new TTree, the tree is attached to the
+/// current directory, if any, and is owned by the caller otherwise.
+TTree *TProfileReport::AsTree(std::string_view treeName) const
+{
+   const std::string name(treeName);
+   auto tree = new TTree(name.c_str(), "TDataFrame profile");
+   std::string kind, nodeName;
+   UInt_t slot = 0;
+   ULong64_t calls = 0;
+   Double_t time = 0.;
+   tree->Branch("kind", &kind);
+   tree->Branch("name", &nodeName);
+   tree->Branch("slot", &slot);
+   tree->Branch("calls", &calls);
+   tree->Branch("time", &time);
+   auto fill = [&](const std::string &k, const std::string &n, UInt_t s, ULong64_t c, double t) {
+      kind = k;
+      nodeName = n;
+      slot = s;
+      calls = c;
+      time = t;
+      tree->Fill();
+   };
+   for (UInt_t s = 0; s < fSlots.size(); ++s) {
+      fill("Read", "entries", s, fSlots[s].fNReads, fSlots[s].fReadTime);
+      fill("Read", "decompression", s, 0ULL, fSlots[s].fUnzipTime);
+      fill("Read", "files", s, 0ULL, fSlots[s].fFileReadTime);
+   }
+   for (const auto &node : fNodes) {
+      for (UInt_t s = 0; s < node.GetNSlots(); ++s)
+         fill(node.fKind, node.fName, s, node.fCalls[s], node.fTimes[s]);
+   }
+   tree->ResetBranchAddresses();
+   return tree;
+}
+
+const TNodeProfileInfo &TProfileReport::operator[](std::string_view nodeName) const
+{
+   const auto it = std::find_if(fNodes.begin(), fNodes.end(),
+                                [&nodeName](const TNodeProfileInfo &node) { return node.GetName() == nodeName; });
+   if (it == fNodes.end()) {
+      std::string err = "Cannot find a node called \"";
+      err += nodeName;
+      err += "\". Available nodes are: \n";
+      for (const auto &node : fNodes)
+         err += " - " + node.GetName() + "\n";
+      throw std::runtime_error(err);
+   }
+   return *it;
+}
+
+} // End NS TDF
+} // End NS Experimental
+} // End NS ROOT
@@ -35,6 +35,17 @@ A specialized TSelector for TTree::Draw.
 #include "TStyle.h"
 #include "TClass.h"
 #include "TColor.h"
+#include "TChain.h"
+#include "TFile.h"
+#include "RConfigure.h" // R__USE_IMT
+
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TTreeReader.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+#endif
 
 ClassImp(TSelectorDraw);
 
@@ -68,6 +79,7 @@ TSelectorDraw::TSelectorDraw()
    fObjEval        = kFALSE;
    fSelectMultiple = kFALSE;
    fCleanElist     = kFALSE;
+   fSelectionApplied = kFALSE;
    fTreeElist      = 0;
    fAction         = 0;
    fNfill          = 0;
@@ -180,6 +192,10 @@ void TSelectorDraw::Begin(TTree *tree)
    if (inElist && inElist->GetReapplyCut()) {
       realSelection *= inElist->GetTitle();
    }
+   if (fSelectionApplied) {
+      // the entry list holds the entries passing the selection (see TTreePlayer::SetSelectionCacheSize)
+      realSelection = "";
+   }
 
    // what each variable should contain:
    //   varexp0   - original expression eg "a:b>>htest"
@@ -1337,6 +1353,109 @@ void TSelectorDraw::ProcessFillObject(Long64_t /*entry*/)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram with the implicit multi-threading tasks, if possible.
+///
+/// Each task processes a range of entries of the tree with its own formulas
+/// and its own copy of the histogram, which is added to the histogram when
+/// the task is done. This is only done for the 1-D and 2-D histograms and the
+/// profiles with fixed axes, filled from all the entries of a tree stored in a
+/// file with expressions of a single value per entry; the other cases depend
+/// on the order of the entries (estimation of the axes limits, graphs, event
+/// lists, ...) and are processed sequentially. Return kTRUE if the entries
+/// were processed.
+
+Bool_t TSelectorDraw::ProcessMT(Long64_t firstentry, Long64_t nentries)
+{
+#ifdef R__USE_IMT
+   static const Long64_t kMinEntriesMT = 100000; // for less entries the tasks do not pay off
+
+   if (!ROOT::IsImplicitMTEnabled() || !fTree || !fObject) return kFALSE;
+   if (fAction != 1 && fAction != 2 && fAction != 4) return kFALSE;
+   if (fMultiplicity || fObjEval || fForceRead || fTreeElist || fTree->GetUpdate()) return kFALSE;
+   if (fTree->GetEntryList() || fTree->GetEventList()) return kFALSE;
+   if (fTree->GetListOfAliases() && fTree->GetListOfAliases()->GetSize()) return kFALSE;
+   if (firstentry != 0 || nentries < fTree->GetEntries() || nentries < kMinEntriesMT) return kFALSE;
+   // the weights of the trees of a chain are read from the files
+   const Bool_t isChain = fTree->InheritsFrom(TChain::Class());
+   if (isChain) {
+      if (fTree->TestBit(TChain::kGlobalWeight)) return kFALSE;
+   } else if (!fTree->GetCurrentFile() || fTree->GetDirectory() != fTree->GetCurrentFile()) {
+      return kFALSE;
+   }
+
+   TH1 *hist = (TH1*)fObject;
+   TAxis *axes[] = {hist->GetXaxis(), hist->GetYaxis()};
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (!fVar[i] || fVar[i]->IsString() || axes[i]->CanExtend() || axes[i]->GetLabels()) return kFALSE;
+   }
+
+   std::vector<TString> expressions;
+   for (Int_t i = 0; i < fDimension; ++i) expressions.push_back(fVar[i]->GetTitle());
+   TString selection = fSelect ? fSelect->GetTitle() : "";
+
+   std::mutex mutex;
+   Long64_t selectedRows = 0;
+   auto fill = [&](TTreeReader &reader) {
+      TTree *tree = reader.GetTree();
+      std::vector<std::unique_ptr<TTreeFormula>> vars;
+      std::unique_ptr<TTreeFormula> select;
+      std::unique_ptr<TH1> local;
+      Int_t treeNumber = -1;
+      Long64_t selected = 0;
+      Double_t weight = 1;
+      while (reader.Next()) {
+         if (!local) {
+            // the formulas are created once the first tree of the range is loaded
+            std::lock_guard<std::mutex> lock(mutex);
+            TDirectory::TContext ctxt(nullptr);
+            for (auto &expression : expressions)
+               vars.emplace_back(new TTreeFormula("Var", expression, tree));
+            if (selection.Length()) select.reset(new TTreeFormula("Selection", selection, tree));
+            local.reset((TH1*)hist->Clone());
+            local->SetDirectory(nullptr);
+            local->Reset();
+         }
+         if (tree->GetTreeNumber() != treeNumber) {
+            treeNumber = tree->GetTreeNumber();
+            weight = isChain ? tree->GetWeight() : fWeight;
+            for (auto &var : vars) var->UpdateFormulaLeaves();
+            if (select) select->UpdateFormulaLeaves();
+         }
+         Double_t w = weight;
+         if (select) {
+            w *= select->EvalInstance(0);
+            if (!w) continue;
+         }
+         if (fAction == 1) local->Fill(vars[0]->EvalInstance(0), w);
+         else if (fAction == 2) ((TH2*)local.get())->Fill(vars[1]->EvalInstance(0), vars[0]->EvalInstance(0), w);
+         else ((TProfile*)local.get())->Fill(vars[1]->EvalInstance(0), vars[0]->EvalInstance(0), w);
+         ++selected;
+      }
+      if (local) {
+         std::lock_guard<std::mutex> lock(mutex);
+         hist->Add(local.get());
+         selectedRows += selected;
+      }
+   };
+
+   std::unique_ptr<ROOT::TTreeProcessorMT> processor;
+   try {
+      processor.reset(new ROOT::TTreeProcessorMT(*fTree));
+   } catch (const std::exception &e) {
+      Error("ProcessMT", "%s", e.what());
+      return kFALSE;
+   }
+   processor->Process(fill);
+   fSelectedRows += selectedRows;
+   return kTRUE;
+#else
+   (void)firstentry;
+   (void)nentries;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set number of entries to estimate variable limits.
 
@@ -33,6 +33,7 @@
 #include "TAxis.h"
 #include "TError.h"
 #include "TVirtualCollectionProxy.h"
+#include "TPerfCounters.h"
 #include "TString.h"
 #include "TTimeStamp.h"
 #include "TMath.h"
@@ -52,8 +53,11 @@
 #include <stdlib.h>
 #include <typeinfo>
 #include <algorithm>
+#include <map>
+#include <type_traits>
 
 const Int_t kMaxLen     = 1024;
+const Int_t kJitThreshold = 100000; // Number of interpreted evaluations before compiling the expression
 
 /** \class TTreeFormula
 Used to pass a selection expression to the Tree drawing routine. See TTree::Draw
@@ -91,10 +95,19 @@ The following method are available from the TFormLeafInfo interface:
  -  IsString()
  -  ReadValue(char *where, Int_t instance = 0) : Internal function to interpret the location 'where'
  -  Update() : react to the possible loading of a shared library.
+
+Once a formula made only of numerical operations and functions of scalar
+leaves was evaluated kJitThreshold times, its expression is compiled by the
+interpreter into a function of the leaf values, which replaces the
+evaluation of the operations one by one. The other expressions are always
+interpreted. The compilation can be switched off with
+TTreeFormula::SetJitEnabled(kFALSE).
 */
 
 ClassImp(TTreeFormula);
 
+Bool_t TTreeFormula::fgJitEnabled = kTRUE;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 inline static void R__LoadBranch(TBranch* br, Long64_t entry, Bool_t quickLoad)
@@ -123,7 +136,7 @@ public:
 ////////////////////////////////////////////////////////////////////////////////
 
 TTreeFormula::TTreeFormula(): ROOT::v5::TFormula(), fQuickLoad(kFALSE), fNeedLoading(kTRUE),
-   fDidBooleanOptimization(kFALSE), fDimensionSetup(0)
+   fDidBooleanOptimization(kFALSE), fDimensionSetup(0), fJitFunc(0), fJitCounter(0)
 
 {
    // Tree Formula default constructor
@@ -157,7 +170,7 @@ TTreeFormula::TTreeFormula(): ROOT::v5::TFormula(), fQuickLoad(kFALSE), fNeedLoa
 
 TTreeFormula::TTreeFormula(const char *name,const char *expression, TTree *tree)
    :ROOT::v5::TFormula(), fTree(tree), fQuickLoad(kFALSE), fNeedLoading(kTRUE),
-    fDidBooleanOptimization(kFALSE), fDimensionSetup(0)
+    fDidBooleanOptimization(kFALSE), fDimensionSetup(0), fJitFunc(0), fJitCounter(0)
 {
    Init(name,expression);
 }
@@ -168,7 +181,7 @@ TTreeFormula::TTreeFormula(const char *name,const char *expression, TTree *tree)
 TTreeFormula::TTreeFormula(const char *name,const char *expression, TTree *tree,
                            const std::vector<std::string>& aliases)
    :ROOT::v5::TFormula(), fTree(tree), fQuickLoad(kFALSE), fNeedLoading(kTRUE),
-    fDidBooleanOptimization(kFALSE), fDimensionSetup(0), fAliasesUsed(aliases)
+    fDidBooleanOptimization(kFALSE), fDimensionSetup(0), fAliasesUsed(aliases), fJitFunc(0), fJitCounter(0)
 {
    Init(name,expression);
 }
@@ -3991,6 +4004,18 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
       }
    }
 
+   if (std::is_same<T, Double_t>::value && !fAxis && fJitCounter >= 0) {
+      if (!fJitFunc) {
+         // Saturated at the threshold, so that it does not overflow while the compilation is disabled
+         if (fJitCounter < kJitThreshold)
+            ++fJitCounter;
+         if (fJitCounter >= kJitThreshold && fgJitEnabled)
+            JitCompile();
+      }
+      if (fJitFunc)
+         return EvalCompiled(instance);
+   }
+
    T tab[kMAXFOUND];
    const Int_t kMAXSTRINGFOUND = 10;
    const char *stringStackLocal[kMAXSTRINGFOUND];
@@ -4390,6 +4415,189 @@ template double TTreeFormula::EvalInstance<double> (int, char const**);
 template long double TTreeFormula::EvalInstance<long double> (int, char const**);
 template long long TTreeFormula::EvalInstance<long long> (int, char const**);
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the compiled expression with the values of the leaves.
+///
+/// Only used for expressions of scalar leaves read directly, see JitCompile.
+
+Double_t TTreeFormula::EvalCompiled(Int_t instance)
+{
+   const Bool_t willLoad = (instance==0 || fNeedLoading); fNeedLoading = kFALSE;
+   if (willLoad) fDidBooleanOptimization = kFALSE;
+
+   Double_t values[kMAXCODES];
+   for (Int_t code = 0; code < fNcodes; ++code) {
+      TLeaf *leaf = (TLeaf*)fLeaves.UncheckedAt(code);
+      if (willLoad) {
+         TBranch *branch = (TBranch*)fBranches.UncheckedAt(code);
+         if (branch) R__LoadBranch(branch,branch->GetTree()->GetReadEntry(),fQuickLoad);
+      }
+      if (fNdata[code] < 1) return 0;
+      values[code] = leaf->GetValue(0);
+   }
+   return fJitFunc(values);
+}
+
+namespace {
+
+// Helpers reproducing the protections of the interpreted operations in the compiled expressions.
+const char *gJitHelpers =
+   "#include \"TMath.h\"\n"
+   "namespace R__TTreeFormulaJit {\n"
+   "inline double Div(double a, double b) { return (b == 0) ? 0 : a / b; }\n"
+   "inline double Tan(double a) { return (TMath::Cos(a) == 0) ? 0 : TMath::Tan(a); }\n"
+   "inline double ACos(double a) { return (TMath::Abs(a) > 1) ? 0 : TMath::ACos(a); }\n"
+   "inline double ASin(double a) { return (TMath::Abs(a) > 1) ? 0 : TMath::ASin(a); }\n"
+   "inline double TanH(double a) { return (TMath::CosH(a) == 0) ? 0 : TMath::TanH(a); }\n"
+   "inline double ACosH(double a) { return (a < 1) ? 0 : TMath::ACosH(a); }\n"
+   "inline double ATanH(double a) { return (TMath::Abs(a) > 1) ? 0 : TMath::ATanH(a); }\n"
+   "inline double Log(double a) { return (a > 0) ? TMath::Log(a) : 0; }\n"
+   "inline double Log10(double a) { return (a > 0) ? TMath::Log10(a) : 0; }\n"
+   "inline double Exp(double a) { return (a < -700) ? 0 : TMath::Exp((a > 700) ? 700 : a); }\n"
+   "inline double Min(double a, double b) { return (b < a) ? b : a; }\n"
+   "inline double Max(double a, double b) { return (a < b) ? b : a; }\n"
+   "}\n";
+
+std::map<std::string, Long_t> gJitFunctions; // compiled functions, indexed by expression
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the expression with the interpreter into a function of the leaf values.
+///
+/// Only expressions of constants, scalar leaves looked up directly and the
+/// numerical operators and functions are compiled; the result of the compiled
+/// function is the same as the one of the interpreted operations. Return
+/// kFALSE (and never try again) if the expression cannot be compiled.
+
+Bool_t TTreeFormula::JitCompile()
+{
+   fJitFunc = 0;
+   fJitCounter = -1;
+   if (TestBit(kMissingLeaf) || fNoper < 2 || fMultiplicity || !fNcodes) return kFALSE;
+
+   for (Int_t code = 0; code < fNcodes; ++code) {
+      TLeaf *leaf = (TLeaf*)fLeaves.UncheckedAt(code);
+      if (fLookupType[code] != kDirect || fCodes[code] < 0 || !leaf) return kFALSE;
+      if (leaf->IsA() == TLeafObject::Class() || leaf->IsA() == TLeafElement::Class()) return kFALSE;
+      if (leaf->GetLeafCount() || leaf->GetLenStatic() != 1 || fNdimensions[code] || IsLeafString(code)) return kFALSE;
+   }
+
+   std::vector<std::string> stack;
+   for (Int_t i = 0; i < fNoper; ++i) {
+      const Int_t oper = GetOper()[i];
+      const Int_t action = oper >> kTFOperShift;
+      const Int_t param = oper & kTFOperMask;
+
+      if (action == kEnd) break;
+      if (action == kBoolOptimize) continue; // short-circuit of && and || is done by the compiler
+      if (action == kConstant) {
+         if (!TMath::Finite(fConst[param])) return kFALSE;
+         stack.push_back(Form("%.17g", fConst[param]));
+         continue;
+      }
+      if (action == kDefinedVariable) {
+         if (param >= fNcodes) return kFALSE;
+         stack.push_back(Form("x[%d]", param));
+         continue;
+      }
+      if (action == kpi) {
+         stack.push_back("TMath::ACos(-1.)");
+         continue;
+      }
+
+      const char *unary = 0;
+      switch (action) {
+         case kcos:     unary = "TMath::Cos(%s)"; break;
+         case ksin:     unary = "TMath::Sin(%s)"; break;
+         case ktan:     unary = "R__TTreeFormulaJit::Tan(%s)"; break;
+         case kacos:    unary = "R__TTreeFormulaJit::ACos(%s)"; break;
+         case kasin:    unary = "R__TTreeFormulaJit::ASin(%s)"; break;
+         case katan:    unary = "TMath::ATan(%s)"; break;
+         case kcosh:    unary = "TMath::CosH(%s)"; break;
+         case ksinh:    unary = "TMath::SinH(%s)"; break;
+         case ktanh:    unary = "R__TTreeFormulaJit::TanH(%s)"; break;
+         case kacosh:   unary = "R__TTreeFormulaJit::ACosH(%s)"; break;
+         case kasinh:   unary = "TMath::ASinH(%s)"; break;
+         case katanh:   unary = "R__TTreeFormulaJit::ATanH(%s)"; break;
+         case ksq:      unary = "TMath::Sq(%s)"; break;
+         case ksqrt:    unary = "TMath::Sqrt(TMath::Abs(%s))"; break;
+         case klog:     unary = "R__TTreeFormulaJit::Log(%s)"; break;
+         case kexp:     unary = "R__TTreeFormulaJit::Exp(%s)"; break;
+         case klog10:   unary = "R__TTreeFormulaJit::Log10(%s)"; break;
+         case kabs:     unary = "TMath::Abs(%s)"; break;
+         case ksign:    unary = "((%s<0)?-1.:1.)"; break;
+         case kint:     unary = "double(Long64_t(%s))"; break;
+         case kSignInv: unary = "(-1*%s)"; break;
+         case kNot:     unary = "((%s!=0)?0.:1.)"; break;
+      }
+      if (unary) {
+         if (stack.empty()) return kFALSE;
+         stack.back() = Form(unary, stack.back().c_str());
+         continue;
+      }
+
+      const char *binary = 0;
+      switch (action) {
+         case kAdd:         binary = "(%s+%s)"; break;
+         case kSubstract:   binary = "(%s-%s)"; break;
+         case kMultiply:    binary = "(%s*%s)"; break;
+         case kDivide:      binary = "R__TTreeFormulaJit::Div(%s,%s)"; break;
+         case kModulo:      binary = "double(Long64_t(%s)%%Long64_t(%s))"; break;
+         case katan2:       binary = "TMath::ATan2(%s,%s)"; break;
+         case kfmod:        binary = "fmod(%s,%s)"; break;
+         case kpow:         binary = "TMath::Power(%s,%s)"; break;
+         case kmin:         binary = "R__TTreeFormulaJit::Min(%s,%s)"; break;
+         case kmax:         binary = "R__TTreeFormulaJit::Max(%s,%s)"; break;
+         case kAnd:         binary = "((%s!=0&&%s!=0)?1.:0.)"; break;
+         case kOr:          binary = "((%s!=0||%s!=0)?1.:0.)"; break;
+         case kEqual:       binary = "((%s==%s)?1.:0.)"; break;
+         case kNotEqual:    binary = "((%s!=%s)?1.:0.)"; break;
+         case kLess:        binary = "((%s<%s)?1.:0.)"; break;
+         case kGreater:     binary = "((%s>%s)?1.:0.)"; break;
+         case kLessThan:    binary = "((%s<=%s)?1.:0.)"; break;
+         case kGreaterThan: binary = "((%s>=%s)?1.:0.)"; break;
+         case kBitAnd:      binary = "double(ULong64_t(%s)&ULong64_t(%s))"; break;
+         case kBitOr:       binary = "double(ULong64_t(%s)|ULong64_t(%s))"; break;
+         case kLeftShift:   binary = "double(ULong64_t(%s)<<ULong64_t(%s))"; break;
+         case kRightShift:  binary = "double(ULong64_t(%s)>>ULong64_t(%s))"; break;
+      }
+      if (!binary || stack.size() < 2) return kFALSE; // operation only supported by the interpreted evaluation
+      std::string right = stack.back();
+      stack.pop_back();
+      stack.back() = Form(binary, stack.back().c_str(), right.c_str());
+   }
+   if (stack.size() != 1) return kFALSE;
+
+   R__LOCKGUARD(gInterpreterMutex);
+
+   Long_t &address = gJitFunctions[stack.back()];
+   if (!address) {
+      static const auto jitTime = ROOT::TPerfCounters::Register("root_jit_seconds_total", "Time spent jitting",
+                                                               ROOT::TPerfCounters::kCounter, 1e-9);
+      ROOT::TPerfCounters::TScopedTimer timer(jitTime);
+      static Bool_t helpersDeclared = kFALSE;
+      if (!helpersDeclared) helpersDeclared = gInterpreter->Declare(gJitHelpers);
+      if (!helpersDeclared) return kFALSE;
+
+      TString name = TString::Format("f%d", (Int_t)gJitFunctions.size());
+      TString code = TString::Format("namespace R__TTreeFormulaJit {\n"
+                                     "double %s(const double *x) { return %s; }\n}\n",
+                                     name.Data(), stack.back().c_str());
+      TInterpreter::EErrorCode error = TInterpreter::kNoError;
+      if (gInterpreter->Declare(code))
+         address = gInterpreter->Calc(TString::Format("(long)&R__TTreeFormulaJit::%s", name.Data()), &error);
+      if (!address || error != TInterpreter::kNoError) {
+         Warning("JitCompile", "cannot compile %s, it will be interpreted", GetTitle());
+         address = 0;
+         return kFALSE;
+      }
+   }
+
+   fJitFunc = (JitFunc_t)address;
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return DataMember corresponding to code.
 ///
@@ -5041,6 +5249,10 @@ void TTreeFormula::UpdateFormulaLeaves()
 {
    Int_t nleaves = fLeafNames.GetEntriesFast();
    ResetBit( kMissingLeaf );
+   // the leaves of the new tree may not be all compatible with the compiled
+   // expression, check them again at the first evaluation
+   if (fJitFunc || fJitCounter < 0) fJitCounter = kJitThreshold;
+   fJitFunc = 0;
    for (Int_t i=0;i<nleaves;i++) {
       if (!fTree) break;
       if (!fLeafNames[i]) continue;
@@ -14,8 +14,22 @@ A Tree Index with majorname and minorname.
 */
 
 #include "TTreeIndex.h"
+#include "TChain.h"
+#include "TDirectory.h"
+#include "TLeaf.h"
+#include "TLeafD.h"
+#include "TLeafF.h"
+#include "TLeafO.h"
 #include "TTree.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TTaskGroup.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
 
 ClassImp(TTreeIndex);
 
@@ -27,7 +41,7 @@ struct IndexSortComparator {
   {}
 
    template<typename Index>
-   bool operator()(Index i1, Index i2) {
+   bool operator()(Index i1, Index i2) const {
       if( *(fValMajor + i1) == *(fValMajor + i2) )
          return *(fValMinor + i1) < *(fValMinor + i2);
       else
@@ -39,6 +53,155 @@ struct IndexSortComparator {
   Long64_t *fValMajor, *fValMinor;
 };
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the n entry numbers of index with cmp.  With implicit multi-threading
+/// enabled, large indices are sorted in chunks by parallel tasks and the
+/// chunks are then merged pairwise, also in parallel.
+
+void SortIndex(Long64_t *index, Long64_t n, const IndexSortComparator &cmp)
+{
+#ifdef R__USE_IMT
+   const Long64_t kMinChunk = 1 << 16;
+   if (ROOT::IsImplicitMTEnabled() && n >= 2 * kMinChunk) {
+      Long64_t nchunks = TMath::Min((Long64_t)(4 * ROOT::GetImplicitMTPoolSize()), n / kMinChunk);
+      std::vector<Long64_t> bounds;
+      for (Long64_t i = 0; i <= nchunks; ++i)
+         bounds.push_back(n * i / nchunks);
+      {
+         ROOT::Experimental::TTaskGroup tg;
+         for (Long64_t i = 0; i < nchunks; ++i) {
+            Long64_t b = bounds[i], e = bounds[i + 1];
+            tg.Run([=]() { std::sort(index + b, index + e, cmp); });
+         }
+         tg.Wait();
+      }
+      while (bounds.size() > 2) {
+         std::vector<Long64_t> next;
+         ROOT::Experimental::TTaskGroup tg;
+         size_t i = 0;
+         for (; i + 2 < bounds.size(); i += 2) {
+            Long64_t b = bounds[i], m = bounds[i + 1], e = bounds[i + 2];
+            tg.Run([=]() { std::inplace_merge(index + b, index + m, index + e, cmp); });
+            next.push_back(b);
+         }
+         if (i + 1 < bounds.size())
+            next.push_back(bounds[i]); // odd chunk, merged at the next pass
+         next.push_back(n);
+         tg.Wait();
+         bounds.swap(next);
+      }
+      return;
+   }
+#endif
+   std::sort(index, index + n, cmp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the branch of tree to read the index values named name with the
+/// bulk interface (see TBranch::GetBulkEntries), or 0 if name is not the name
+/// of such a branch holding one number per entry.
+
+TBranch *GetBulkIndexBranch(TTree *tree, const TString &name)
+{
+   TBranch *branch = tree->GetBranch(name);
+   if (!branch || branch->GetTree() != tree || branch->GetEntries() != tree->GetEntries())
+      return 0;
+   if (branch->GetBulkEntrySize() == 0)
+      return 0;
+   TLeaf *leaf = (TLeaf*)branch->GetListOfLeaves()->UncheckedAt(0);
+   if (leaf->GetLenStatic() != 1)
+      return 0;
+   return branch;
+}
+
+template <typename T>
+void ConvertIndexValues(const char *raw, Long64_t n, Long64_t *values)
+{
+   const T *v = reinterpret_cast<const T *>(raw);
+   for (Long64_t i = 0; i < n; ++i)
+      values[i] = (Long64_t)v[i];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the n values of branch into values, converted to Long64_t as
+/// TTreeFormula::EvalInstance would (truncating the floating point numbers).
+
+Bool_t ReadIndexValues(TBranch *branch, Long64_t n, Long64_t *values)
+{
+   TLeaf *leaf = (TLeaf*)branch->GetListOfLeaves()->UncheckedAt(0);
+   const Int_t size = branch->GetBulkEntrySize();
+   const Bool_t isUnsigned = leaf->IsUnsigned();
+   const Long64_t kChunk = 1 << 20;
+   std::vector<char> raw(kChunk * size);
+   for (Long64_t first = 0; first < n; first += kChunk) {
+      Long64_t nread = branch->GetBulkEntries(first, TMath::Min(kChunk, n - first), raw.data());
+      if (nread != TMath::Min(kChunk, n - first))
+         return kFALSE;
+      Long64_t *out = values + first;
+      if (leaf->IsA() == TLeafF::Class())
+         ConvertIndexValues<Float_t>(raw.data(), nread, out);
+      else if (leaf->IsA() == TLeafD::Class())
+         ConvertIndexValues<Double_t>(raw.data(), nread, out);
+      else if (leaf->IsA() == TLeafO::Class())
+         ConvertIndexValues<Bool_t>(raw.data(), nread, out);
+      else if (size == 1)
+         isUnsigned ? ConvertIndexValues<UChar_t>(raw.data(), nread, out) : ConvertIndexValues<Char_t>(raw.data(), nread, out);
+      else if (size == 2)
+         isUnsigned ? ConvertIndexValues<UShort_t>(raw.data(), nread, out) : ConvertIndexValues<Short_t>(raw.data(), nread, out);
+      else if (size == 4)
+         isUnsigned ? ConvertIndexValues<UInt_t>(raw.data(), nread, out) : ConvertIndexValues<Int_t>(raw.data(), nread, out);
+      else if (size == 8)
+         isUnsigned ? ConvertIndexValues<ULong64_t>(raw.data(), nread, out) : ConvertIndexValues<Long64_t>(raw.data(), nread, out);
+      else
+         return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill major and minor with the index values of the n entries of tree when
+/// majorname and minorname are plain branch names (minorname may also be "0")
+/// of branches readable with the bulk interface.  The two branches are read by
+/// parallel tasks when implicit multi-threading is enabled.
+/// Return false if the index values must be computed entry by entry.
+
+Bool_t ReadBulkIndexValues(TTree *tree, const TString &majorname, const TString &minorname, Long64_t n,
+                           Long64_t *major, Long64_t *minor)
+{
+   if (tree->InheritsFrom(TChain::Class()))
+      return kFALSE;
+   TBranch *majorBranch = GetBulkIndexBranch(tree, majorname);
+   if (!majorBranch)
+      return kFALSE;
+   TBranch *minorBranch = 0;
+   if (minorname != "0") {
+      minorBranch = GetBulkIndexBranch(tree, minorname);
+      if (!minorBranch || minorBranch == majorBranch)
+         return kFALSE;
+   }
+
+   Bool_t majorOk = kTRUE, minorOk = kTRUE;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && minorBranch) {
+      ROOT::Experimental::TTaskGroup tg;
+      tg.Run([&]() { majorOk = ReadIndexValues(majorBranch, n, major); });
+      tg.Run([&]() { minorOk = ReadIndexValues(minorBranch, n, minor); });
+      tg.Wait();
+      return majorOk && minorOk;
+   }
+#endif
+   majorOk = ReadIndexValues(majorBranch, n, major);
+   if (minorBranch)
+      minorOk = ReadIndexValues(minorBranch, n, minor);
+   else
+      std::fill(minor, minor + n, 0);
+   return majorOk && minorOk;
+}
+
+} // namespace
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor for TTreeIndex
@@ -54,6 +217,7 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
    fMinorFormula       = 0;
    fMajorFormulaParent = 0;
    fMinorFormulaParent = 0;
+   fLastFriendPos      = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -113,6 +277,18 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
 /// the filling process just before saving the Tree header.
 /// If a previous index was computed, it is redefined by this new call.
 ///
+/// The index can also be saved on its own, next to the tree, with
+/// WriteStandalone().  TTree::BuildIndex and TChainIndex then load it instead
+/// of recomputing it, which saves reading the tree again in every job.
+///
+/// ## Building large indices
+///
+/// When majorname and minorname are the names of branches holding one number
+/// per entry (or minorname is "0"), their values are read with the bulk
+/// interface of TBranch (see TBranch::GetBulkEntries) rather than through
+/// TTreeFormula.  With implicit multi-threading enabled the two branches are
+/// read by parallel tasks and the index is sorted in parallel.
+///
 /// Note that this function can also be applied to a TChain.
 ///
 /// The return value is the number of entries in the Index (< 0 indicates failure)
@@ -132,6 +308,7 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    fMinorFormula       = 0;
    fMajorFormulaParent = 0;
    fMinorFormulaParent = 0;
+   fLastFriendPos      = -1;
    fMajorName          = majorname;
    fMinorName          = minorname;
    if (!T) return;
@@ -165,21 +342,24 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    Long64_t *tmp_minor = new Long64_t[fN];
    Long64_t i;
    Long64_t oldEntry = fTree->GetReadEntry();
-   Int_t current = -1;
-   for (i=0;i<fN;i++) {
-      Long64_t centry = fTree->LoadTree(i);
-      if (centry < 0) break;
-      if (fTree->GetTreeNumber() != current) {
-         current = fTree->GetTreeNumber();
-         fMajorFormula->UpdateFormulaLeaves();
-         fMinorFormula->UpdateFormulaLeaves();
+   // When the index is made of plain branches of numbers, read them in bulk.
+   if (!ReadBulkIndexValues(fTree, fMajorName, fMinorName, fN, tmp_major, tmp_minor)) {
+      Int_t current = -1;
+      for (i=0;i<fN;i++) {
+         Long64_t centry = fTree->LoadTree(i);
+         if (centry < 0) break;
+         if (fTree->GetTreeNumber() != current) {
+            current = fTree->GetTreeNumber();
+            fMajorFormula->UpdateFormulaLeaves();
+            fMinorFormula->UpdateFormulaLeaves();
+         }
+         tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+         tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
       }
-      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
-      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
    }
    fIndex = new Long64_t[fN];
    for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
+   SortIndex(fIndex, fN, IndexSortComparator(tmp_major, tmp_minor));
    //TMath::Sort(fN,w,fIndex,0);
    fIndexValues = new Long64_t[fN];
    fIndexValuesMinor = new Long64_t[fN];
@@ -268,7 +448,7 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
       Long64_t *conv = new Long64_t[fN];
 
       for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
-      std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
+      SortIndex(conv, fN, IndexSortComparator(addValues, addValues2));
       //Long64_t *w = fIndexValues;
       //TMath::Sort(fN,w,conv,0);
 
@@ -342,7 +522,26 @@ Long64_t TTreeIndex::GetEntryNumberFriend(const TTree *parent)
    // we check if this pair exist in the index.
    // if yes, we return the corresponding entry number
    // if not the function returns -1
-   return fTree->GetEntryNumberWithIndex(majorv,minorv);
+   if (fTree->GetTreeIndex() != this || fN == 0 || !fIndexValuesMinor)
+      return fTree->GetEntryNumberWithIndex(majorv,minorv);
+
+   // The parent is usually read in the order of the keys: try the position of
+   // the previous match and the following one before bisecting the index; the
+   // following one is then the first position with the key, as the previous
+   // position has a different key.
+   auto matches = [&](Long64_t pos) {
+      return pos >= 0 && pos < fN && fIndexValues[pos] == majorv && fIndexValuesMinor[pos] == minorv;
+   };
+   Long64_t pos = fLastFriendPos;
+   if (!matches(pos)) {
+      pos = fLastFriendPos + 1;
+      if (fLastFriendPos < 0 || !matches(pos)) {
+         pos = FindValues(majorv, minorv);
+         if (!matches(pos)) return -1;
+      }
+   }
+   fLastFriendPos = pos;
+   return fIndex[pos];
 }
 
 
@@ -536,6 +735,60 @@ void TTreeIndex::Print(Option_t * option) const
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of the key under which the standalone index of the tree
+/// named treename is stored (see WriteStandalone).
+
+TString TTreeIndex::GetStandaloneName(const char *treename)
+{
+   return TString::Format("%s_TTreeIndex", treename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the standalone index of tree T stored with WriteStandalone in the
+/// directory of T.  Return 0 if there is none or if it was not built with
+/// majorname and minorname or for the number of entries of T.  The caller
+/// owns the returned index.
+
+TTreeIndex *TTreeIndex::ReadStandalone(const TTree *T, const char *majorname, const char *minorname)
+{
+   if (!T || !T->GetDirectory() || dynamic_cast<const TChain*>(T))
+      return 0;
+   TTreeIndex *index = 0;
+   T->GetDirectory()->GetObject(GetStandaloneName(T->GetName()), index);
+   if (!index)
+      return 0;
+   if (index->fMajorName != majorname || index->fMinorName != minorname || index->fN != T->GetEntries()) {
+      delete index;
+      return 0;
+   }
+   index->SetTree(T);
+   return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write this index on its own in directory dir (by default the directory of
+/// the tree), under the name returned by GetStandaloneName.  A previous
+/// standalone index of the same tree is overwritten.  Compared to saving the
+/// index with the tree header, the index is only read when it is needed, by
+/// TTree::BuildIndex or a TChainIndex.
+/// Return the number of bytes written, 0 in case of error.
+
+Int_t TTreeIndex::WriteStandalone(TDirectory *dir) const
+{
+   if (!fTree) {
+      Error("WriteStandalone", "The index is not attached to a tree");
+      return 0;
+   }
+   if (!dir)
+      dir = fTree->GetDirectory();
+   if (!dir || !dir->IsWritable()) {
+      Error("WriteStandalone", "No writable directory to save the index of %s", fTree->GetName());
+      return 0;
+   }
+   return dir->WriteTObject(this, GetStandaloneName(fTree->GetName()), "WriteDelete");
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Stream an object of class TTreeIndex.
 /// Note that this Streamer should be changed to an automatic Streamer
@@ -67,6 +67,39 @@ The Draw or Print functions print the following information:
  -  ReadRT    = Zipped MBytes per RT second
  -  ReadCP    = Zipped MBytes per CP second
 
+For each basket read, the number of baskets, of compressed and
+uncompressed bytes and the time spent uncompressing are accumulated per
+branch, also when the baskets are read in parallel by the implicit multi
+threading tasks; Print("branches") prints them, sorted by decreasing
+unzip time, and they can be exported with GetBranchStatsTree or
+GetBranchStatsJSON. The durations of the read calls, e.g. of each
+TFile::ReadBuffers issued by the TTreeCache, are histogrammed in
+GetReadLatency, from 1 microsecond to 100 seconds.
+
+Attached to a tree being written, the object also measures the writing:
+per branch, the bytes serialized by TBranch::Fill and the time it took,
+including the streamers, and for each basket written its uncompressed
+and compressed sizes, the time spent compressing it and the time spent
+writing it to the file. The flushes of the baskets, e.g. at each
+auto-flush, are counted and their durations histogrammed in
+GetFlushLatency. Print("write") prints the totals, Print("write branches")
+adds the per branch statistics, sorted by decreasing serialization and
+compression time:
+~~~{.cpp}
+   TFile f("out.root", "RECREATE");
+   TTree T("T", "output");
+   ... // create the branches
+   TTreePerfStats ps("ioperf", &T);
+   for (Int_t i = 0; i < n; ++i) {
+      ... // set the values
+      T.Fill();
+   }
+   T.FlushBaskets();
+   ps.Print("write branches");
+~~~
+When no TTreePerfStats is attached, the cost in TBranch::Fill and in the
+writing of the baskets is one test of a pointer.
+
  ### NOTE 1 :
 The ReadTotal value indicates the effective number of zipped bytes
 returned to the application. The physical number of bytes read
@@ -95,9 +128,67 @@ The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
 #include "TTimeStamp.h"
 #include "TDatime.h"
 #include "TMath.h"
+#include "TH1.h"
+#include "TBranch.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <string>
 
 ClassImp(TTreePerfStats);
 
+namespace {
+
+// Serialises the events of the baskets read by the implicit multi threading tasks.
+std::mutex gTreePerfStatsMutex;
+
+// Histogram of durations, with 10 logarithmic bins per decade from 1 us to 100 s.
+TH1F *MakeLatencyHist(const char *name, const char *title)
+{
+   const Int_t nbins = 80;
+   Double_t edges[nbins + 1];
+   for (Int_t i = 0; i <= nbins; ++i)
+      edges[i] = TMath::Power(10., -6. + 0.1 * i);
+   TH1F *h = new TH1F(name, title, nbins, edges);
+   h->SetDirectory(nullptr);
+   return h;
+}
+
+void WriteJSONHist(std::ostream &os, const char *name, const TH1F *h)
+{
+   const Int_t nbins = h->GetNbinsX();
+   os << ",\"" << name << "\":{\"edges\":[";
+   for (Int_t bin = 1; bin <= nbins + 1; ++bin)
+      os << (bin > 1 ? "," : "") << h->GetXaxis()->GetBinLowEdge(bin);
+   os << "],\"counts\":[";
+   for (Int_t bin = 1; bin <= nbins; ++bin)
+      os << (bin > 1 ? "," : "") << h->GetBinContent(bin);
+   os << "]}";
+}
+
+// The per branch vectors of the writing are missing in the objects written by older versions.
+template <typename T>
+T GetSlotValue(const std::vector<T> &values, Int_t slot)
+{
+   return (slot < 0 || slot >= Int_t(values.size())) ? T() : values[slot];
+}
+
+void WriteJSONString(std::ostream &os, const char *s)
+{
+   os << '"';
+   for (; *s; ++s) {
+      if (*s == '"' || *s == '\\')
+         os << '\\';
+      os << *s;
+   }
+   os << '"';
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// default constructor (used when reading an object only)
 
@@ -125,6 +216,10 @@ TTreePerfStats::TTreePerfStats() : TVirtualPerfStats()
    fCompress      = 0;
    fRealTimeAxis  = 0;
    fHostInfoText  = 0;
+   fReadLatency   = 0;
+   fFlushes       = 0;
+   fFlushTime     = 0;
+   fFlushLatency  = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -159,7 +254,7 @@ TTreePerfStats::TTreePerfStats(const char *name, TTree *T) : TVirtualPerfStats()
    fDiskTime      = 0;
    fUnzipTime     = 0;
    fRealTimeAxis  = 0;
-   fCompress      = (T->GetTotBytes()+0.00001)/T->GetZipBytes();
+   fCompress      = T->GetZipBytes() ? (T->GetTotBytes()+0.00001)/T->GetZipBytes() : 1;
 
    Bool_t isUNIX = strcmp(gSystem->GetName(), "Unix") == 0;
    if (isUNIX)
@@ -171,6 +266,10 @@ TTreePerfStats::TTreePerfStats(const char *name, TTree *T) : TVirtualPerfStats()
    TDatime dt;
    fHostInfo += TString::Format(" %s",dt.AsString());
    fHostInfoText   = 0;
+   fReadLatency    = MakeLatencyHist("iolatency", "Duration of the read calls;time [s];read calls");
+   fFlushes        = 0;
+   fFlushTime      = 0;
+   fFlushLatency   = MakeLatencyHist("flushlatency", "Duration of the flushes;time [s];flushes");
 
    gPerfStats = this;
 }
@@ -188,6 +287,8 @@ TTreePerfStats::~TTreePerfStats()
    delete fWatch;
    delete fRealTimeAxis;
    delete fHostInfoText;
+   delete fReadLatency;
+   delete fFlushLatency;
 
    if (gPerfStats == this) {
       gPerfStats = 0;
@@ -279,6 +380,7 @@ void TTreePerfStats::ExecuteEvent(Int_t /*event*/, Int_t /*px*/, Int_t /*py*/)
 void TTreePerfStats::FileReadEvent(TFile *file, Int_t len, Double_t start)
 {
    if (file == this->fFile){
+      std::lock_guard<std::mutex> lock(gTreePerfStatsMutex);
       Long64_t offset = file->GetRelOffset();
       Int_t np = fGraphIO->GetN();
       Int_t entry = fTree->GetReadEntry();
@@ -289,6 +391,7 @@ void TTreePerfStats::FileReadEvent(TFile *file, Int_t len, Double_t start)
       fDiskTime += dtime;
       fGraphTime->SetPoint(np,entry,tnow);
       fGraphTime->SetPointError(np,0.001,dtime);
+      if (fReadLatency) fReadLatency->Fill(dtime);
       fReadCalls++;
       fBytesRead += len;
    }
@@ -307,10 +410,311 @@ void TTreePerfStats::UnzipEvent(TObject * tree, Long64_t /* pos */, Double_t sta
    if (tree == this->fTree){
       Double_t tnow = TTimeStamp();
       Double_t dtime = tnow-start;
+      std::lock_guard<std::mutex> lock(gTreePerfStatsMutex);
       fUnzipTime += dtime;
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Record a basket read by a branch of the tree.
+/// -  start is the TimeStamp before unzip, 0 if the basket was not
+///    uncompressed by the branch, e.g. by the TTreeCacheUnzip
+/// -  pos is where in the file the basket came from
+/// -  complen is the length of the compressed buffer
+/// -  objlen is the length of the de-compressed buffer
+
+void TTreePerfStats::BasketReadEvent(TObject *branch, Long64_t /* pos */, Double_t start, Int_t complen, Int_t objlen)
+{
+   TTree *tree = static_cast<TBranch*>(branch)->GetTree();
+   if (!fTree || (tree != fTree && tree != fTree->GetTree())) return;
+   Double_t dtime = start ? Double_t(TTimeStamp()) - start : 0;
+
+   std::lock_guard<std::mutex> lock(gTreePerfStatsMutex);
+   Int_t slot = GetBranchIndex(branch);
+   fBranchBaskets[slot]++;
+   fBranchZipBytes[slot] += complen;
+   fBranchUnzipBytes[slot] += objlen;
+   fBranchUnzipTime[slot] += dtime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record an entry serialized by a branch of the tree into its basket.
+/// -  start is the TimeStamp before the serialization
+/// -  nbytes is the number of bytes added to the basket
+
+void TTreePerfStats::BranchFillEvent(TObject *branch, Double_t start, Int_t nbytes)
+{
+   if (!fTree || static_cast<TBranch*>(branch)->GetTree() != fTree) return;
+   Double_t dtime = Double_t(TTimeStamp()) - start;
+
+   std::lock_guard<std::mutex> lock(gTreePerfStatsMutex);
+   Int_t slot = GetBranchIndex(branch);
+   if (nbytes > 0) fBranchFillBytes[slot] += nbytes;
+   fBranchFillTime[slot] += dtime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record a basket written by a branch of the tree.
+/// -  ziptime is the time spent compressing the basket
+/// -  start is the TimeStamp before the write to the file
+/// -  objlen is the length of the uncompressed buffer
+/// -  complen is the length of the compressed buffer, objlen if the
+///    basket is not compressed
+
+void TTreePerfStats::BasketWriteEvent(TObject *branch, Double_t ziptime, Double_t start, Int_t objlen, Int_t complen)
+{
+   if (!fTree || static_cast<TBranch*>(branch)->GetTree() != fTree) return;
+   Double_t dtime = Double_t(TTimeStamp()) - start;
+
+   std::lock_guard<std::mutex> lock(gTreePerfStatsMutex);
+   Int_t slot = GetBranchIndex(branch);
+   fBranchWriteBaskets[slot]++;
+   fBranchWriteUnzipBytes[slot] += objlen;
+   fBranchWriteZipBytes[slot] += complen;
+   fBranchZipTime[slot] += ziptime;
+   fBranchWriteTime[slot] += dtime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record a flush of the baskets of the tree.
+/// -  start is the TimeStamp before the flush
+/// -  nbytes is the number of bytes written, -1 in case of error
+
+void TTreePerfStats::FlushEvent(TObject *tree, Double_t start, Int_t /* nbytes */)
+{
+   if (tree != fTree) return;
+   Double_t dtime = Double_t(TTimeStamp()) - start;
+
+   std::lock_guard<std::mutex> lock(gTreePerfStatsMutex);
+   fFlushes++;
+   fFlushTime += dtime;
+   if (fFlushLatency) fFlushLatency->Fill(dtime);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the branch in the per branch statistics, adding it
+/// if needed. Must be called with gTreePerfStatsMutex held.
+
+Int_t TTreePerfStats::GetBranchIndex(const TObject *branch)
+{
+   auto it = fBranchIndex.find(branch);
+   if (it != fBranchIndex.end())
+      return it->second;
+   // The trees of a chain have their own branches, with the same names.
+   Int_t slot = GetBranchSlot(branch->GetName());
+   if (slot < 0) {
+      slot = fBranchNames.size();
+      fBranchNames.push_back(branch->GetName());
+   }
+   // The vectors of a TTreePerfStats read from a file by an older version may be shorter.
+   const size_t size = fBranchNames.size();
+   fBranchBaskets.resize(size);
+   fBranchZipBytes.resize(size);
+   fBranchUnzipBytes.resize(size);
+   fBranchUnzipTime.resize(size);
+   fBranchFillBytes.resize(size);
+   fBranchFillTime.resize(size);
+   fBranchWriteBaskets.resize(size);
+   fBranchWriteUnzipBytes.resize(size);
+   fBranchWriteZipBytes.resize(size);
+   fBranchZipTime.resize(size);
+   fBranchWriteTime.resize(size);
+   fBranchIndex[branch] = slot;
+   return slot;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the branch in the per branch statistics, -1 if this
+/// branch was neither read nor written.
+
+Int_t TTreePerfStats::GetBranchSlot(const char *branchname) const
+{
+   for (UInt_t i = 0; i < fBranchNames.size(); ++i) {
+      if (fBranchNames[i] == branchname) return i;
+   }
+   return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of baskets read by this branch.
+
+Int_t TTreePerfStats::GetBranchBaskets(const char *branchname) const
+{
+   Int_t slot = GetBranchSlot(branchname);
+   return slot < 0 ? 0 : fBranchBaskets[slot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of compressed bytes read by this branch.
+
+Long64_t TTreePerfStats::GetBranchZipBytes(const char *branchname) const
+{
+   Int_t slot = GetBranchSlot(branchname);
+   return slot < 0 ? 0 : fBranchZipBytes[slot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of uncompressed bytes read by this branch.
+
+Long64_t TTreePerfStats::GetBranchUnzipBytes(const char *branchname) const
+{
+   Int_t slot = GetBranchSlot(branchname);
+   return slot < 0 ? 0 : fBranchUnzipBytes[slot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the time, in seconds, spent uncompressing the baskets of this branch.
+
+Double_t TTreePerfStats::GetBranchUnzipTime(const char *branchname) const
+{
+   Int_t slot = GetBranchSlot(branchname);
+   return slot < 0 ? 0 : fBranchUnzipTime[slot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes serialized by the fills of this branch.
+
+Long64_t TTreePerfStats::GetBranchFillBytes(const char *branchname) const
+{
+   return GetSlotValue(fBranchFillBytes, GetBranchSlot(branchname));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the time, in seconds, spent by the fills of this branch to
+/// serialize the entries into the basket, including the streamers.
+
+Double_t TTreePerfStats::GetBranchFillTime(const char *branchname) const
+{
+   return GetSlotValue(fBranchFillTime, GetBranchSlot(branchname));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of baskets written by this branch.
+
+Int_t TTreePerfStats::GetBranchWriteBaskets(const char *branchname) const
+{
+   return GetSlotValue(fBranchWriteBaskets, GetBranchSlot(branchname));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of uncompressed bytes of the baskets written by this branch.
+
+Long64_t TTreePerfStats::GetBranchWriteUnzipBytes(const char *branchname) const
+{
+   return GetSlotValue(fBranchWriteUnzipBytes, GetBranchSlot(branchname));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of compressed bytes of the baskets written by this branch.
+
+Long64_t TTreePerfStats::GetBranchWriteZipBytes(const char *branchname) const
+{
+   return GetSlotValue(fBranchWriteZipBytes, GetBranchSlot(branchname));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the time, in seconds, spent compressing the baskets of this branch.
+
+Double_t TTreePerfStats::GetBranchZipTime(const char *branchname) const
+{
+   return GetSlotValue(fBranchZipTime, GetBranchSlot(branchname));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the time, in seconds, spent writing the baskets of this branch to
+/// the file.
+
+Double_t TTreePerfStats::GetBranchWriteTime(const char *branchname) const
+{
+   return GetSlotValue(fBranchWriteTime, GetBranchSlot(branchname));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the per branch statistics and the read and flush latency
+/// histograms as a JSON object:
+/// ~~~ {.json}
+/// {"branches":[{"name":"px","baskets":12,"zipBytes":..,"unzipBytes":..,"unzipTime":..,
+///               "fillBytes":..,"fillTime":..,"writeBaskets":..,"writeUnzipBytes":..,
+///               "writeZipBytes":..,"zipTime":..,"writeTime":..},..],
+///  "readLatency":{"edges":[1e-06,..,100],"counts":[..]},
+///  "flushLatency":{"edges":[1e-06,..,100],"counts":[..]}}
+/// ~~~
+
+TString TTreePerfStats::GetBranchStatsJSON() const
+{
+   std::ostringstream os;
+   os << std::setprecision(9) << "{\"branches\":[";
+   for (UInt_t i = 0; i < fBranchNames.size(); ++i) {
+      os << (i ? "," : "") << "{\"name\":";
+      WriteJSONString(os, fBranchNames[i].Data());
+      os << ",\"baskets\":" << fBranchBaskets[i] << ",\"zipBytes\":" << fBranchZipBytes[i]
+         << ",\"unzipBytes\":" << fBranchUnzipBytes[i] << ",\"unzipTime\":" << fBranchUnzipTime[i]
+         << ",\"fillBytes\":" << GetSlotValue(fBranchFillBytes, i)
+         << ",\"fillTime\":" << GetSlotValue(fBranchFillTime, i)
+         << ",\"writeBaskets\":" << GetSlotValue(fBranchWriteBaskets, i)
+         << ",\"writeUnzipBytes\":" << GetSlotValue(fBranchWriteUnzipBytes, i)
+         << ",\"writeZipBytes\":" << GetSlotValue(fBranchWriteZipBytes, i)
+         << ",\"zipTime\":" << GetSlotValue(fBranchZipTime, i)
+         << ",\"writeTime\":" << GetSlotValue(fBranchWriteTime, i) << "}";
+   }
+   os << "]";
+   if (fReadLatency)
+      WriteJSONHist(os, "readLatency", fReadLatency);
+   if (fFlushLatency)
+      WriteJSONHist(os, "flushLatency", fFlushLatency);
+   os << "}";
+   return TString(os.str().c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the per branch statistics as a TTree with one entry per branch,
+/// with the branches `name`, `baskets`, `zipBytes`, `unzipBytes` and
+/// `unzipTime` for the reading, and `fillBytes`, `fillTime`,
+/// `writeBaskets`, `writeUnzipBytes`, `writeZipBytes`, `zipTime` and
+/// `writeTime` for the writing. Like any new TTree, the tree is attached to the current
+/// directory, if any, and is owned by the caller otherwise.
+
+TTree *TTreePerfStats::GetBranchStatsTree(const char *treename) const
+{
+   TTree *tree = new TTree(treename, "TTreePerfStats per branch statistics");
+   std::string name;
+   Int_t baskets = 0;
+   Long64_t zipBytes = 0, unzipBytes = 0;
+   Double_t unzipTime = 0;
+   Int_t writeBaskets = 0;
+   Long64_t fillBytes = 0, writeUnzipBytes = 0, writeZipBytes = 0;
+   Double_t fillTime = 0, zipTime = 0, writeTime = 0;
+   tree->Branch("name", &name);
+   tree->Branch("baskets", &baskets);
+   tree->Branch("zipBytes", &zipBytes);
+   tree->Branch("unzipBytes", &unzipBytes);
+   tree->Branch("unzipTime", &unzipTime);
+   tree->Branch("fillBytes", &fillBytes);
+   tree->Branch("fillTime", &fillTime);
+   tree->Branch("writeBaskets", &writeBaskets);
+   tree->Branch("writeUnzipBytes", &writeUnzipBytes);
+   tree->Branch("writeZipBytes", &writeZipBytes);
+   tree->Branch("zipTime", &zipTime);
+   tree->Branch("writeTime", &writeTime);
+   for (UInt_t i = 0; i < fBranchNames.size(); ++i) {
+      name = fBranchNames[i].Data();
+      baskets = fBranchBaskets[i];
+      zipBytes = fBranchZipBytes[i];
+      unzipBytes = fBranchUnzipBytes[i];
+      unzipTime = fBranchUnzipTime[i];
+      fillBytes = GetSlotValue(fBranchFillBytes, i);
+      fillTime = GetSlotValue(fBranchFillTime, i);
+      writeBaskets = GetSlotValue(fBranchWriteBaskets, i);
+      writeUnzipBytes = GetSlotValue(fBranchWriteUnzipBytes, i);
+      writeZipBytes = GetSlotValue(fBranchWriteZipBytes, i);
+      zipTime = GetSlotValue(fBranchZipTime, i);
+      writeTime = GetSlotValue(fBranchWriteTime, i);
+      tree->Fill();
+   }
+   tree->ResetBranchAddresses();
+   return tree;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// When the run is finished this function must be called
 /// to save the current parameters in the file and Tree in this object
@@ -423,12 +827,21 @@ void TTreePerfStats::Paint(Option_t *option)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Print the TTree I/O perf stats.
+/// -  option "unzip" adds the unzipping times
+/// -  option "branches" adds the per branch statistics
+/// -  option "write" prints the statistics of the writing instead of the
+///    reading
 
 void TTreePerfStats::Print(Option_t * option) const
 {
    TString opts(option);
    opts.ToLower();
    Bool_t unzip = opts.Contains("unzip");
+   Bool_t branches = opts.Contains("branches");
+   if (opts.Contains("write")) {
+      PrintWrite(branches);
+      return;
+   }
    TTreePerfStats *ps = (TTreePerfStats*)this;
    ps->Finish();
 
@@ -457,6 +870,66 @@ void TTreePerfStats::Print(Option_t * option) const
       printf("ReadStrCP = %7.3f MBytes/s\n",1e-6*fCompress*fBytesRead/(fCpuTime-fUnzipTime));
       printf("ReadZipCP = %7.3f MBytes/s\n",1e-6*fCompress*fBytesRead/fUnzipTime);
    }
+   if (branches && !fBranchNames.empty()) {
+      std::vector<UInt_t> order(fBranchNames.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(),
+                       [this](UInt_t a, UInt_t b) { return fBranchUnzipTime[a] > fBranchUnzipTime[b]; });
+      printf("%-32s %8s %12s %12s %7s %10s\n", "Branch", "Baskets", "Zip bytes", "Unzip bytes", "Factor", "UnzipTime");
+      for (UInt_t i : order) {
+         printf("%-32s %8d %12lld %12lld %7.2f %10.6f\n", fBranchNames[i].Data(), fBranchBaskets[i],
+                fBranchZipBytes[i], fBranchUnzipBytes[i],
+                fBranchZipBytes[i] ? Double_t(fBranchUnzipBytes[i]) / fBranchZipBytes[i] : 0., fBranchUnzipTime[i]);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the statistics of the writing, and per branch if branches is true.
+
+void TTreePerfStats::PrintWrite(Bool_t branches) const
+{
+   const size_t nbranches = fBranchNames.size();
+   Long64_t fillBytes = 0, unzipBytes = 0, zipBytes = 0;
+   Int_t baskets = 0;
+   Double_t fillTime = 0, zipTime = 0, writeTime = 0;
+   for (size_t i = 0; i < nbranches; ++i) {
+      fillBytes += GetSlotValue(fBranchFillBytes, i);
+      fillTime += GetSlotValue(fBranchFillTime, i);
+      baskets += GetSlotValue(fBranchWriteBaskets, i);
+      unzipBytes += GetSlotValue(fBranchWriteUnzipBytes, i);
+      zipBytes += GetSlotValue(fBranchWriteZipBytes, i);
+      zipTime += GetSlotValue(fBranchZipTime, i);
+      writeTime += GetSlotValue(fBranchWriteTime, i);
+   }
+   printf("FillTotal = %g MBytes\n", 1e-6 * fillBytes);
+   printf("Fill Time = %7.3f seconds\n", fillTime);
+   printf("Baskets   = %d\n", baskets);
+   printf("WriteUnZip= %g MBytes\n", 1e-6 * unzipBytes);
+   printf("WriteZip  = %g MBytes\n", 1e-6 * zipBytes);
+   printf("Factor    = %7.3f\n", zipBytes ? Double_t(unzipBytes) / zipBytes : 0.);
+   printf("Zip Time  = %7.3f seconds\n", zipTime);
+   printf("WriteTime = %7.3f seconds\n", writeTime);
+   printf("Flushes   = %d\n", fFlushes);
+   printf("FlushTime = %7.3f seconds\n", fFlushTime);
+   if (fFlushes)
+      printf("FlushMean = %7.3f ms\n", 1e3 * fFlushTime / fFlushes);
+   if (branches && nbranches) {
+      std::vector<UInt_t> order(nbranches);
+      std::iota(order.begin(), order.end(), 0);
+      auto cost = [this](UInt_t i) { return GetSlotValue(fBranchFillTime, i) + GetSlotValue(fBranchZipTime, i); };
+      std::stable_sort(order.begin(), order.end(), [&cost](UInt_t a, UInt_t b) { return cost(a) > cost(b); });
+      printf("%-32s %12s %10s %8s %12s %7s %10s %10s\n", "Branch", "Fill bytes", "FillTime", "Baskets",
+             "Unzip bytes", "Factor", "ZipTime", "WriteTime");
+      for (UInt_t i : order) {
+         const Long64_t zip = GetSlotValue(fBranchWriteZipBytes, i);
+         const Long64_t unzip = GetSlotValue(fBranchWriteUnzipBytes, i);
+         printf("%-32s %12lld %10.6f %8d %12lld %7.2f %10.6f %10.6f\n", fBranchNames[i].Data(),
+                GetSlotValue(fBranchFillBytes, i), GetSlotValue(fBranchFillTime, i),
+                GetSlotValue(fBranchWriteBaskets, i), unzip, zip ? Double_t(unzip) / zip : 0.,
+                GetSlotValue(fBranchZipTime, i), GetSlotValue(fBranchWriteTime, i));
+      }
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -109,6 +109,9 @@ TTreePlayer::TTreePlayer()
    fSelectorFromFile = 0;
    fSelectorClass    = 0;
    fSelectorUpdate   = 0;
+   fSelectionCacheSize = gEnv->GetValue("TreePlayer.SelectionCacheSize", 0);
+   fSelectionCache   = new TList();
+   fSelectionCache->SetOwner(kTRUE);
    fInput            = new TList();
    fInput->Add(new TNamed("varexp",""));
    fInput->Add(new TNamed("selection",""));
@@ -127,6 +130,7 @@ TTreePlayer::TTreePlayer()
 TTreePlayer::~TTreePlayer()
 {
    delete fFormulaList;
+   delete fSelectionCache;
    delete fSelector;
    DeleteSelectorFromFile();
    fInput->Delete();
@@ -137,6 +141,8 @@ TTreePlayer::~TTreePlayer()
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Build the index for the tree (see TTree::BuildIndex)
+/// For a TTree, an index saved with TTreeIndex::WriteStandalone is used if
+/// it matches majorname, minorname and the number of entries.
 
 TVirtualIndex *TTreePlayer::BuildIndex(const TTree *T, const char *majorname, const char *minorname)
 {
@@ -150,9 +156,20 @@ TVirtualIndex *TTreePlayer::BuildIndex(const TTree *T, const char *majorname, co
       else
          return index;
    }
+   if (TTreeIndex *saved = TTreeIndex::ReadStandalone(T, majorname, minorname))
+      return saved;
    return new TTreeIndex(T,majorname,minorname);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the entry lists of the selections kept by DrawSelect, e.g. after
+/// modifying the aliases or the friends used by the selections.
+
+void TTreePlayer::ClearSelectionCache()
+{
+   fSelectionCache->Delete();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy a Tree with selection, make a clone of this Tree header, then copy the
 /// selected entries.
@@ -415,11 +432,32 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
    // Do not process more than fMaxEntryLoop entries
    if (nentries > fTree->GetMaxEntryLoop()) nentries = fTree->GetMaxEntryLoop();
 
+   // Loop only on the entries passing the selection, if they are known
+   TEntryList *selected = 0;
+   TString varexpStripped = TString(varexp0).Strip(TString::kLeading);
+   if (fSelectionCacheSize > 0 && selection && strlen(selection) && !elist && !evlist
+       && !varexpStripped.BeginsWith(">>")) {
+      selected = GetCachedSelection(selection, firstentry, nentries);
+   }
+   Long64_t processEntries = nentries, processFirst = firstentry;
+   if (selected) {
+      fTree->SetEntryList(selected);
+      fSelector->SetSelectionApplied(kTRUE);
+      processEntries = selected->GetN();
+      processFirst = 0;
+   }
+
    // invoke the selector
-   Long64_t nrows = Process(fSelector,option,nentries,firstentry);
+   Long64_t nrows = Process(fSelector,option,processEntries,processFirst);
    fSelectedRows = nrows;
    fDimension = fSelector->GetDimension();
 
+   if (selected) {
+      fSelector->SetSelectionApplied(kFALSE);
+      fTree->SetEntryList(0);
+      if (!fSelectionCache->FindObject(selected)) delete selected;
+   }
+
    //*-* an Event List
    if (fDimension <= 0) {
       fTree->SetEstimate(oldEstimate);
@@ -614,6 +652,82 @@ Long64_t TTreePlayer::GetEntriesToProcess(Long64_t firstentry, Long64_t nentries
    return nentries;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the entry list of the entries in [firstentry, firstentry+nentries)
+/// passing the selection, as kept by a previous call, or evaluated now by
+/// reading only the branches of the selection and kept within the budget given
+/// to SetSelectionCacheSize. The entry list remains owned by the TTreePlayer if
+/// it is in the cache, else it belongs to the caller.
+/// Return 0 if the selection cannot be replaced by an entry list: it depends
+/// on the instances of arrays, or is used as a weight (its value is not 0 or 1).
+
+TEntryList *TTreePlayer::GetCachedSelection(const char *selection, Long64_t firstentry, Long64_t nentries)
+{
+   nentries = GetEntriesToProcess(firstentry, nentries);
+   if (nentries <= 0) return 0;
+   TString key = TString::Format("%lld %lld %lld", firstentry, nentries, fTree->GetEntries());
+
+   TIter next(fSelectionCache);
+   TObject *obj;
+   while ((obj = next())) {
+      if (key == obj->GetTitle() && !strcmp(selection, obj->GetName())) {
+         // move it at the front of the cache
+         fSelectionCache->Remove(obj);
+         fSelectionCache->AddFirst(obj);
+         return dynamic_cast<TEntryList*>(obj);
+      }
+   }
+
+   TTreeFormula select("Selection", selection, fTree);
+   if (!select.GetNdim()) return 0;
+   TEntryList *list = 0;
+   if (!select.GetMultiplicity() && !select.IsString()) {
+      list = new TEntryList(selection, key);
+      Int_t treenumber = -1;
+      for (Long64_t entry = firstentry; entry < firstentry + nentries; ++entry) {
+         Long64_t localEntry = fTree->LoadTree(entry);
+         if (localEntry < 0) break;
+         if (fTree->GetTreeNumber() != treenumber) {
+            treenumber = fTree->GetTreeNumber();
+            select.UpdateFormulaLeaves();
+            list->SetTree(fTree->GetTree());
+         }
+         if (select.GetNdata() <= 0) continue;
+         Double_t value = select.EvalInstance(0);
+         if (value == 0) continue;
+         if (value != 1) {
+            delete list;
+            list = 0;
+            break;
+         }
+         list->Enter(localEntry);
+      }
+   }
+
+   // the selections which are not cached are remembered, to not evaluate them again
+   TObject *entry = list ? (TObject*)list : (TObject*)new TNamed(selection, key.Data());
+   Long64_t size = list ? TMath::Min(2 * list->GetN(), (nentries + 7) / 8) + 100 : 100;
+   if (size > fSelectionCacheSize) return list;
+   entry->SetUniqueID((UInt_t)size);
+   fSelectionCache->AddFirst(entry);
+
+   // evict the least recently used selections beyond the budget
+   Long64_t total = 0;
+   TObjLink *lnk = fSelectionCache->FirstLink();
+   while (lnk) {
+      TObjLink *nextlnk = lnk->Next();
+      TObject *cached = lnk->GetObject();
+      if (total + cached->GetUniqueID() > fSelectionCacheSize) {
+         fSelectionCache->Remove(lnk);
+         delete cached;
+      } else {
+         total += cached->GetUniqueID();
+      }
+      lnk = nextlnk;
+   }
+   return list;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return name corresponding to colindex in varexp.
 ///
@@ -2244,6 +2358,11 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
 
    Bool_t process = (selector->GetAbort() != TSelector::kAbortProcess &&
                     (selector->Version() != 0 || selector->GetStatus() != -1)) ? kTRUE : kFALSE;
+
+   // TTree::Draw of histograms can be processed by the implicit multi-threading tasks
+   if (process && selector == fSelector && fSelector->ProcessMT(firstentry, nentries))
+      process = kFALSE;
+
    if (process) {
 
       Long64_t readbytesatstart = 0;
@@ -2925,6 +3044,22 @@ TSQLResult *TTreePlayer::Query(const char *varexp, const char *selection,
    return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the maximum size in bytes of the entry lists of the selections kept by
+/// DrawSelect (0 by default, or the value of TreePlayer.SelectionCacheSize in
+/// the rootrc). When it is not zero, the entries passing the selection of a
+/// draw are kept in a TEntryList, and the following draws with the same
+/// selection loop only on these entries, without reading the branches of the
+/// selection again. The least recently used selections are evicted first.
+/// A selection is evaluated again if the number of entries of the tree
+/// changes; call ClearSelectionCache if its aliases or friends change.
+
+void TTreePlayer::SetSelectionCacheSize(Long64_t maxbytes)
+{
+   fSelectionCacheSize = maxbytes;
+   if (fSelectionCacheSize <= 0) ClearSelectionCache();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set number of entries to estimate variable limits.
 
@@ -41,6 +41,10 @@
 /// For either set of signatures, the processing function is executed as many times as
 /// needed by a pool of fNWorkers workers; the number of workers can be passed to the constructor
 /// or set via SetNWorkers. It defaults to the number of cores.\n
+/// The entries of each file (or tree) are split in MultiProc.RangesPerWorker (default 4)
+/// cluster-aligned ranges per worker, handed out one at a time to the idle workers, so that
+/// faster workers process more ranges. The tree cache of the workers is enabled by
+/// MultiProc.UseTreeCache and its size set by MultiProc.CacheSize.\n
 /// A collection containing the result of each execution is returned.\n
 /// **Note:** the user is responsible for the deletion of any object that might
 /// be created upon execution of func, returned objects included: ROOT::TTreeProcessorMP never
@@ -122,7 +126,7 @@ TList *TTreeProcessorMP::Process(TTree &tree, TSelector &selector, TEntryList &e
    fTaskType = ETask::kProcByRange;
 
    //tell workers to start processing entries
-   fNToProcess = nWorkers; //this is the total number of ranges that will be processed by all workers cumulatively
+   fNToProcess = worker.GetNRanges(); //this is the total number of ranges that will be processed by all workers cumulatively
    std::vector<UInt_t> args(nWorkers);
    std::iota(args.begin(), args.end(), 0);
    fNProcessed = Broadcast(MPCode::kProcTree, args);
@@ -188,7 +192,7 @@ TList *TTreeProcessorMP::Process(const std::vector<std::string> &fileNames, TSel
          // TTree entry granularity: for each file, we divide entries equally between workers
          fTaskType = ETask::kProcByRange;
          // Tell workers to start processing entries
-         fNToProcess = nWorkers*fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
+         fNToProcess = worker.GetNRanges() * fileNames.size(); // total number of ranges that will be processed by all workers cumulatively
          std::vector<UInt_t> args(nWorkers);
          std::iota(args.begin(), args.end(), 0);
          fNProcessed = Broadcast(MPCode::kProcRange, args);
@@ -210,7 +214,7 @@ TList *TTreeProcessorMP::Process(const std::vector<std::string> &fileNames, TSel
       // TTree entry granularity: for each file, we divide entries equally between workers
       fTaskType = ETask::kProcByRange;
       // Tell workers to start processing entries
-      fNToProcess = nWorkers*fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
+      fNToProcess = worker.GetNRanges() * fileNames.size(); // total number of ranges that will be processed by all workers cumulatively
       std::vector<UInt_t> args(nWorkers);
       std::iota(args.begin(), args.end(), 0);
       fNProcessed = Broadcast(MPCode::kProcRange, args);
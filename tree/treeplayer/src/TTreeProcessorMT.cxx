@@ -22,14 +22,85 @@ The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the
 each corresponding to a cluster in the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
 objects.
+
+Clusters much larger than the average workload of a task are split in smaller subranges,
+so that the threads do not wait for a single task processing a huge cluster at the end of
+the processing. The number of tasks per thread aimed at can be tuned with
+SetTasksPerWorkerHint. The subranges start at the beginning of a basket of the branch with
+the largest baskets, so that few baskets are read and decompressed by two tasks; a cluster
+is not split if a basket of one of the branches spans all of it. The tasks are scheduled by
+TBB, whose idle threads steal the tasks not started yet from the busy ones.
+
+When a TEntryList is given, only the subranges containing some of its entries are scheduled,
+and the TTreeCache of each task prefetches only the baskets holding some of them.
 */
 
 #include "TROOT.h"
+#include "TLeaf.h"
 #include "ROOT/TTreeProcessorMT.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 
+#include <algorithm>
+
 using namespace ROOT;
 
+namespace {
+/// The entries of a file at which the baskets of each branch start, excluding the first basket
+using BasketStarts_t = std::vector<std::vector<Long64_t>>;
+
+BasketStarts_t GetBasketStarts(TTree &t)
+{
+   BasketStarts_t basketStarts;
+   for (auto leaf : *t.GetListOfLeaves()) {
+      auto branch = static_cast<TLeaf *>(leaf)->GetBranch();
+      const auto basketEntry = branch->GetBasketEntry();
+      basketStarts.emplace_back();
+      if (basketEntry && branch->GetWriteBasket() > 0)
+         basketStarts.back().assign(basketEntry + 1, basketEntry + branch->GetWriteBasket() + 1);
+   }
+   return basketStarts;
+}
+
+/// Split the cluster [start, end) of a file in ranges of about taskSize entries, starting at the beginning of a
+/// basket of the branch with the fewest baskets in the cluster.
+void SplitCluster(Long64_t start, Long64_t end, Long64_t offset, Long64_t taskSize, const BasketStarts_t &basketStarts,
+                  std::vector<ROOT::Internal::TreeViewCluster> &clusters)
+{
+   using Iter_t = std::vector<Long64_t>::const_iterator;
+   const auto nTasks = (end - start + taskSize - 1) / taskSize;
+   bool canSplit = nTasks > 1 && !basketStarts.empty();
+   Iter_t refFirst, refLast;
+   for (auto &starts : basketStarts) {
+      if (!canSplit)
+         break;
+      const auto first = std::upper_bound(starts.begin(), starts.end(), start);
+      const auto last = std::lower_bound(first, starts.end(), end);
+      // a basket spanning the cluster would be read by all of its tasks
+      canSplit = first != last;
+      if (canSplit && (&starts == &basketStarts.front() || last - first < refLast - refFirst)) {
+         refFirst = first;
+         refLast = last;
+      }
+   }
+
+   auto taskStart = start;
+   for (Long64_t i = 1; canSplit && i < nTasks; ++i) {
+      // the basket start closest to the ideal boundary
+      const auto target = start + (end - start) * i / nTasks;
+      auto next = std::lower_bound(refFirst, refLast, target);
+      if (next == refLast || (next != refFirst && target - *(next - 1) < *next - target))
+         --next;
+      if (*next > taskStart) {
+         clusters.emplace_back(ROOT::Internal::TreeViewCluster{taskStart + offset, *next + offset});
+         taskStart = *next;
+      }
+   }
+   clusters.emplace_back(ROOT::Internal::TreeViewCluster{taskStart + offset, end + offset});
+}
+} // anonymous namespace
+
+unsigned int TTreeProcessorMT::fgTasksPerWorkerHint = 4U;
+
 ////////////////////////////////////////////////////////////////////////
 /// Constructor based on a file name.
 /// \param[in] filename Name of the file containing the tree to process.
@@ -58,16 +129,31 @@ TTreeProcessorMT::TTreeProcessorMT(TTree &tree) : treeView(tree) {}
 TTreeProcessorMT::TTreeProcessorMT(TTree &tree, TEntryList &entries) : treeView(tree, entries) {}
 
 ////////////////////////////////////////////////////////////////////////
-/// Divide input data in clusters, i.e. the workloads to distribute to tasks
+/// Divide input data in clusters, i.e. the workloads to distribute to tasks.
+/// Clusters larger than the average workload of fgTasksPerWorkerHint tasks per
+/// worker are split, see SplitCluster.
+/// The files are opened and their cluster boundaries read in parallel, so that
+/// the latency of opening many (remote) files is not paid once per file.
+/// The files whose cluster boundaries are known from the manifest of the chain
+/// (see TChain::MakeManifest) are not opened; their clusters are not split.
 std::vector<ROOT::Internal::TreeViewCluster> TTreeProcessorMT::MakeClusters()
 {
-   TDirectory::TContext c;
-   std::vector<ROOT::Internal::TreeViewCluster> clusters;
    const auto &fileNames = treeView->GetFileNames();
    const auto nFileNames = fileNames.size();
    const auto &treeName = treeView->GetTreeName();
-   Long64_t offset = 0;
-   for (auto i = 0u; i < nFileNames; ++i) { // TTreeViewCluster requires the index of the file the cluster belongs to
+   std::vector<std::vector<ROOT::Internal::TreeViewCluster>> fileClusters(nFileNames);
+   std::vector<BasketStarts_t> fileBasketStarts(nFileNames);
+   std::vector<Long64_t> fileEntries(nFileNames);
+   const auto mainView = treeView.Get(); // do not make per-slot copies of the view in the tasks
+   auto getFileClusters = [&](unsigned i) { // TTreeViewCluster requires the index of the file the cluster belongs to
+      std::vector<Long64_t> starts;
+      if (mainView->GetKnownClusters(i, starts, fileEntries[i])) {
+         for (auto c = 0u; c < starts.size(); ++c)
+            fileClusters[i].emplace_back(ROOT::Internal::TreeViewCluster{
+               starts[c], c + 1 < starts.size() ? starts[c + 1] : fileEntries[i]});
+         return;
+      }
+      TDirectory::TContext c;
       std::unique_ptr<TFile> f(TFile::Open(fileNames[i].c_str())); // need TFile::Open to load plugins if need be
       TTree *t = nullptr;                                          // not a leak, t will be deleted by f
       f->GetObject(treeName.c_str(), t);
@@ -77,11 +163,41 @@ std::vector<ROOT::Internal::TreeViewCluster> TTreeProcessorMT::MakeClusters()
       // Iterate over the clusters in the current file and generate a task for each of them
       while ((start = clusterIter()) < entries) {
          end = clusterIter.GetNextEntry();
+         fileClusters[i].emplace_back(ROOT::Internal::TreeViewCluster{start, end});
+      }
+      if (fgTasksPerWorkerHint > 0)
+         fileBasketStarts[i] = GetBasketStarts(*t);
+      fileEntries[i] = entries;
+   };
+   if (nFileNames > 1) {
+      TThreadExecutor pool;
+      pool.Foreach(getFileClusters, ROOT::TSeqU(nFileNames));
+   } else if (nFileNames == 1) {
+      getFileClusters(0);
+   }
+   Long64_t nEntries = 0;
+   for (auto entries : fileEntries)
+      nEntries += entries;
+
+   const Long64_t nTasks = std::max(1U, ROOT::GetImplicitMTPoolSize()) * std::max(1U, fgTasksPerWorkerHint);
+   const auto taskSize = std::max(1LL, (nEntries + nTasks - 1) / nTasks);
+   std::vector<ROOT::Internal::TreeViewCluster> clusters;
+   Long64_t offset = 0;
+   for (auto i = 0u; i < nFileNames; ++i) {
+      for (const auto &cluster : fileClusters[i]) {
          // Add the current file's offset to start and end to make them (chain) global
-         clusters.emplace_back(ROOT::Internal::TreeViewCluster{start + offset, end + offset});
+         SplitCluster(cluster.startEntry, cluster.endEntry, offset, taskSize, fileBasketStarts[i], clusters);
       }
-      offset += entries;
+      offset += fileEntries[i];
    }
+
+   // Only schedule the clusters containing entries of the entry list, if any
+   const auto view = treeView.Get();
+   clusters.erase(std::remove_if(clusters.begin(), clusters.end(),
+                                 [&view](const ROOT::Internal::TreeViewCluster &c) {
+                                    return !view->HasEntries(c.startEntry, c.endEntry);
+                                 }),
+                  clusters.end());
    return clusters;
 }
 
@@ -125,3 +241,23 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    TThreadExecutor pool;
    pool.Foreach(mapFunction, clusters);
 }
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Set the number of tasks per worker thread the work is split into.
+/// \param[in] m The number of tasks per worker, 0 to process each cluster in a single task.
+///
+/// Clusters larger than the number of entries to process divided by the number of tasks
+/// of all the workers are split, which balances the load of the threads when the clusters
+/// or the files are few and large: the threads running out of tasks pick the remaining ones
+/// instead of waiting for a thread processing a large cluster.
+void TTreeProcessorMT::SetTasksPerWorkerHint(unsigned int m)
+{
+   fgTasksPerWorkerHint = m;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Return the number of tasks per worker thread the work is split into.
+unsigned int TTreeProcessorMT::GetTasksPerWorkerHint()
+{
+   return fgTasksPerWorkerHint;
+}
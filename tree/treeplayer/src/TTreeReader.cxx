@@ -14,6 +14,9 @@
 #include "TChain.h"
 #include "TDirectory.h"
 #include "TEntryList.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TTreeCacheUnzip.h"
 #include "TTreeReaderValue.h"
 
 /** \class TTreeReader
@@ -229,6 +232,60 @@ void TTreeReader::Initialize()
    fDirector = new ROOT::Internal::TBranchProxyDirector(fTree, -1);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Unzip the baskets of the trees read by this reader in tasks of the
+/// implicit multi-threading pool (see ROOT::EnableImplicitMT()).
+///
+/// The TTreeCache of each tree that is read is replaced by a TTreeCacheUnzip:
+/// when the cache is filled with the baskets of a cluster, these are unzipped
+/// in the background while the entries are read, so that a serial event loop
+/// only streams the already uncompressed baskets into the values. This does
+/// not change the global TTreeCacheUnzip::SetParallelUnzip() mode nor the
+/// caches of other trees. Without implicit multi-threading, the call has no
+/// effect until it is enabled and the next tree is loaded.
+///
+/// Disabling it keeps the cache of the current tree, it only applies to the
+/// trees loaded next.
+
+void TTreeReader::SetParallelUnzip(Bool_t enable /*= kTRUE*/)
+{
+   SetBit(kBitParallelUnzip, enable);
+   if (enable && fTree && fDirector && fDirector->GetTree())
+      SetupParallelUnzip(fTree->GetTree());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the TTreeCache of `tree` by a TTreeCacheUnzip of the same size,
+/// if parallel unzipping was requested and implicit multi-threading is
+/// enabled. A TChain hands the cache over to its next trees.
+
+void TTreeReader::SetupParallelUnzip(TTree *tree)
+{
+#ifdef R__USE_IMT
+   if (!tree || !TestBit(kBitParallelUnzip) || !ROOT::IsImplicitMTEnabled())
+      return;
+   TFile *file = tree->GetCurrentFile();
+   if (!file || file->GetCompressionLevel() <= 0)
+      return;
+   TTreeCache *cache = dynamic_cast<TTreeCache *>(file->GetCacheRead(tree));
+   if (dynamic_cast<TTreeCacheUnzip *>(cache))
+      return;
+
+   // A negative size gives the default size of the tree's cache.
+   Long64_t cacheSize = -1;
+   if (cache) {
+      cacheSize = cache->GetBufferSize();
+      tree->SetCacheSize(0);
+   }
+   TTreeCacheUnzip::EParUnzipMode mode = TTreeCacheUnzip::GetParallelUnzip();
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   tree->SetCacheSize(cacheSize);
+   TTreeCacheUnzip::SetParallelUnzip(mode);
+#else
+   (void)tree;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the range of entries to be loaded by `Next()`; end will not be loaded.
 ///
@@ -257,6 +314,7 @@ TTreeReader::EEntryStatus TTreeReader::SetEntriesRange(Long64_t beginEntry, Long
       return kEntryNotFound;
    }
 
+   fBeginEntry = beginEntry;
    if (endEntry > beginEntry)
       fEndEntry = endEntry;
    else
@@ -382,6 +440,7 @@ TTreeReader::EEntryStatus TTreeReader::SetEntryBase(Long64_t entry, Bool_t local
    if (fDirector->GetTree() != fTree->GetTree()
        || fMostRecentTreeNumber != fTree->GetTreeNumber()) {
       fDirector->SetTree(fTree->GetTree());
+      SetupParallelUnzip(fTree->GetTree());
       if (fProxiesSet) {
          for (auto value: fValues) {
             value->NotifyNewTree(fTree->GetTree());
@@ -16,6 +16,7 @@
 #include "TBranchRef.h"
 #include "TBranchSTL.h"
 #include "TBranchProxyDirector.h"
+#include "TBufferFile.h"
 #include "TClassEdit.h"
 #include "TLeaf.h"
 #include "TROOT.h"
@@ -278,6 +279,52 @@ namespace {
       }
    };
 
+   // Reader interface for the data members of basic type of split collections,
+   // read column-wise: see TBranchElement::GetEntryColumn.
+   class TColumnReader : public TVirtualCollectionReader {
+   private:
+      TBufferFile fBuffer;      // Values of the current entry
+      Int_t fValueSize;
+      TBranch *fBranch;         // Branch and entry of the values in fBuffer
+      Long64_t fEntry;
+      Int_t fSize;
+   public:
+      TColumnReader(Int_t valueSize) : fBuffer(TBuffer::kRead), fValueSize(valueSize), fBranch(0), fEntry(-1), fSize(0) {}
+
+      bool ReadColumn(ROOT::Detail::TBranchProxy* proxy) {
+         if (!proxy->IsInitialized() && !proxy->Setup()) {
+            fReadStatus = TTreeReaderValueBase::kReadError;
+            Error("TColumnReader::ReadColumn()", "Cannot set up the proxy of %s.", proxy->GetBranchName());
+            return false;
+         }
+         TBranchElement *branch = (TBranchElement*)proxy->GetBranch();
+         const Long64_t entry = proxy->GetReadEntry();
+         if (branch == fBranch && entry == fEntry)
+            return true;
+         fSize = branch->GetEntryColumn(entry, fBuffer);
+         if (fSize < 0) {
+            fReadStatus = TTreeReaderValueBase::kReadError;
+            Error("TColumnReader::ReadColumn()", "Read error in branch %s.", branch->GetName());
+            fBranch = 0;
+            fSize = 0;
+            return false;
+         }
+         fBranch = branch;
+         fEntry = entry;
+         fReadStatus = TTreeReaderValueBase::kReadSuccess;
+         return true;
+      }
+
+      virtual size_t GetSize(ROOT::Detail::TBranchProxy* proxy) {
+         return ReadColumn(proxy) ? fSize : 0;
+      }
+
+      virtual void* At(ROOT::Detail::TBranchProxy* proxy, size_t idx) {
+         if (!ReadColumn(proxy)) return 0;
+         return fBuffer.Buffer() + fValueSize * idx;
+      }
+   };
+
    class TLeafReader : public TVirtualCollectionReader {
    private:
       TTreeReaderValueBase *fValueReader;
@@ -327,6 +374,17 @@ Extracts array data from a TTree.
 
 ClassImp(TTreeReaderArrayBase);
 
+////////////////////////////////////////////////////////////////////////////////
+/// Whether the data read through branch can be read by a TColumnReader.
+
+bool ROOT::Internal::TTreeReaderArrayBase::ColumnarReadable(TBranchElement *branch) const
+{
+   if (!branch || !branch->GetColumnValueSize() || !fDict || fDict->IsA() != TDataType::Class())
+      return false;
+   TStreamerElement *element = (TStreamerElement*)branch->GetInfo()->GetElements()->At(branch->GetID());
+   return ((TDataType*)fDict)->GetType() == element->GetType();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create the proxy object for our branch.
 
@@ -537,6 +595,11 @@ void ROOT::Internal::TTreeReaderArrayBase::SetImpl(TBranch* branch, TLeaf* myLea
    // A proxy for branch must not have been created before (i.e. check
    // fProxies before calling this function!)
 
+   if (fColumnar && (myLeaf || !ColumnarReadable(dynamic_cast<TBranchElement*>(branch)))) {
+      Warning("TTreeReaderArrayBase::SetImpl()", "The branch %s is not a data member of basic type of a split collection: it is not read column-wise.",
+              fBranchName.Data());
+   }
+
    if (myLeaf){
       if (!myLeaf->GetLeafCount()){
          fImpl = new TLeafReader(this);
@@ -580,7 +643,10 @@ void ROOT::Internal::TTreeReaderArrayBase::SetImpl(TBranch* branch, TLeaf* myLea
             fImpl = new TArrayParameterSizeReader(fTreeReader, branchElement->GetBranchCount()->GetName());
          }
          else if (element->IsA() == TStreamerBasicType::Class()){
-            if (branchElement->GetType() == TBranchElement::kSTLMemberNode){
+            if (fColumnar && ColumnarReadable(branchElement)) {
+               fImpl = new TColumnReader(branchElement->GetColumnValueSize());
+            }
+            else if (branchElement->GetType() == TBranchElement::kSTLMemberNode){
                fImpl = new TBasicTypeArrayReader();
             }
             else if (branchElement->GetType() == TBranchElement::kClonesMemberNode){
@@ -1,4 +1,6 @@
+#include "TClonesArray.h"
 #include "TFile.h"
+#include "TParameter.h"
 #include "TTree.h"
 #include "TTreeReader.h"
 #include "TTreeReaderArray.h"
@@ -66,3 +68,42 @@ TEST(TTreeReaderArray, MultiReaders) {
       EXPECT_DOUBLE_EQ(Double[i], trDouble5[i]);
    }
 }
+
+TEST(TTreeReaderArray, ColumnarClones) {
+   TTree* tree = new TTree("TTreeReaderArrayTree", "In-memory test tree");
+   TClonesArray* params = new TClonesArray(TParameter<Double_t>::Class());
+   tree->Branch("params", &params, 32000, 99);
+
+   for (int entry = 0; entry < 100; ++entry) {
+      params->Clear();
+      for (int i = 0; i < entry % 7; ++i)
+         new ((*params)[i]) TParameter<Double_t>("p", 10. * entry + i);
+      tree->Fill();
+   }
+
+   tree->ResetBranchAddresses();
+
+   TTreeReader tr(tree);
+   TTreeReaderArray<Double_t> columns(tr, "params.fVal");
+   TTreeReaderArray<Double_t> objects(tr, "params.fVal");
+   columns.SetColumnar();
+   EXPECT_TRUE(columns.IsColumnar());
+
+   int entry = 0;
+   while (tr.Next()) {
+      ASSERT_EQ(std::size_t(entry % 7), columns.GetSize());
+      ASSERT_EQ(objects.GetSize(), columns.GetSize());
+      for (std::size_t i = 0; i < columns.GetSize(); ++i) {
+         EXPECT_DOUBLE_EQ(10. * entry + i, columns[i]);
+         EXPECT_DOUBLE_EQ(objects[i], columns[i]);
+         // The values are contiguous.
+         EXPECT_EQ(&columns[0] + i, &columns[i]);
+      }
+      ++entry;
+   }
+   EXPECT_EQ(100, entry);
+   EXPECT_EQ(ROOT::Internal::TTreeReaderValueBase::kReadSuccess, columns.GetReadStatus());
+
+   delete params;
+   delete tree;
+}
@@ -257,4 +257,32 @@ TEST(Cache, Carrays)
    gSystem->Unlink(fileName);
 }
 
+TEST(Cache, Compressed)
+{
+   const ULong64_t nEntries = 1000;
+   TDataFrame tdf(nEntries);
+   auto d = tdf.Define("i", [](ULong64_t e) { return int(e); }, {"tdfentry_"})
+               .Define("x", [](ULong64_t e) { return e * 0.5; }, {"tdfentry_"});
+
+   TCacheOptions opts;
+   opts.fChunkSize = 64;
+   auto cached = d.Cache<int, double>({"i", "x"}, opts);
+   EXPECT_EQ(nEntries, *cached.Count());
+   auto is = cached.Take<int>("i");
+   auto xs = cached.Take<double>("x");
+   for (auto j : ROOT::TSeqU(nEntries)) {
+      EXPECT_EQ(int(j), (*is)[j]);
+      EXPECT_DOUBLE_EQ(j * 0.5, (*xs)[j]);
+   }
+   // the cache can be read more than once, also with jitted expressions
+   EXPECT_EQ(500ULL, *cached.Filter("i % 2 == 0").Count());
+
+   // spill all but the last chunks to a scratch file, store them uncompressed
+   opts.fCompressionLevel = 0;
+   opts.fMaxMemory = 1024;
+   auto spilled = d.Cache("x", opts);
+   EXPECT_DOUBLE_EQ(*d.Sum<double>("x"), *spilled.Sum<double>("x"));
+   EXPECT_EQ(nEntries, *spilled.Count());
+}
+
 #endif // R__B64
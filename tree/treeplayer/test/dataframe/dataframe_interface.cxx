@@ -1,5 +1,6 @@
 #include "ROOT/TDataFrame.hxx"
 #include "ROOT/TTrivialDS.hxx"
+#include "TEnv.h"
 #include "TMemFile.h"
 #include "TTree.h"
 
@@ -181,3 +182,25 @@ TEST(TDataFrameInterface, JitDefaultColumns)
    auto minEntry = f.Min("tdfentry_");
    EXPECT_EQ(*maxEntry, *minEntry);
 }
+
+TEST(TDataFrameInterface, JitCache)
+{
+   gEnv->SetValue("TDataFrame.JitCacheDir", "dataframe_interface_jitcache");
+   const auto &times = ROOT::Internal::TDF::GetJitTimes();
+   for (auto i : {0, 1}) {
+      const auto builds = times.fNCacheBuilds;
+      const auto hits = times.fNCacheHits;
+      TDataFrame tdf(10);
+      auto count = tdf.Define("x", "tdfentry_ * 2").Filter("x > 9", "big").Count();
+      EXPECT_EQ(5U, *count) << "iteration " << i;
+      if (i == 0) {
+         // Both expressions go through the cache, whether they are compiled or found there from a previous run
+         EXPECT_EQ(builds + hits + 2, times.fNCacheBuilds + times.fNCacheHits);
+      } else {
+         // The entries of the first data frame are reused by the second one
+         EXPECT_EQ(builds, times.fNCacheBuilds);
+         EXPECT_EQ(hits + 2, times.fNCacheHits);
+      }
+   }
+   gEnv->SetValue("TDataFrame.JitCacheDir", "");
+}
@@ -0,0 +1,81 @@
+#include "ROOT/TDataFrame.hxx"
+#include "ROOT/TProcessRunner.hxx"
+#include "TFile.h"
+#include "TH1D.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+using namespace ROOT::Experimental;
+using namespace ROOT::Experimental::TDF;
+
+// write the entries x in [first, first + n) in clusters of 100 entries
+void WriteFile(const char *fileName, int first, int n)
+{
+   TFile f(fileName, "RECREATE");
+   TTree t("t", "t");
+   int x;
+   t.Branch("x", &x);
+   t.SetAutoFlush(100);
+   for (x = first; x < first + n; ++x)
+      t.Fill();
+   t.Write();
+}
+
+void BookResults(TDataFrame &d, TDistributedResults &r)
+{
+   auto even = d.Filter([](int x) { return x % 2 == 0; }, {"x"});
+   r.Book("n", even.Count());
+   r.Book("sum", even.Sum<int>("x"));
+   r.Book("min", d.Min<int>("x"), 'm');
+   r.Book("max", d.Max<int>("x"), 'M');
+   r.Book("h", even.Histo1D<int>({"hx", "x", 10, 0, 1000}, "x"));
+}
+
+TEST(TProcessRunner, Ranges)
+{
+   const auto fileName = "dataframe_processrunner_ranges.root";
+   WriteFile(fileName, 0, 1000);
+
+   TProcessRunner runner(3);
+   unsigned int nCalls = 0;
+   runner.SetMonitor([&nCalls](const TDistributedResults &partial, unsigned int nWorkersDone) {
+      ++nCalls;
+      EXPECT_EQ(nCalls, nWorkersDone);
+      EXPECT_LE(partial.GetValue<ULong64_t>("n"), 500U);
+   });
+   auto results = runner.Run("t", {fileName}, BookResults);
+
+   // every worker reads a range of entries: each of them is processed exactly once
+   EXPECT_EQ(3U, nCalls);
+   EXPECT_EQ(500U, results.GetValue<ULong64_t>("n"));
+   EXPECT_EQ(249500, results.GetValue<int>("sum"));
+   EXPECT_EQ(0, results.GetValue<int>("min"));
+   EXPECT_EQ(999, results.GetValue<int>("max"));
+   auto h = results.GetObject<TH1D>("h");
+   EXPECT_EQ(500, h->GetEntries());
+   EXPECT_THROW(results.GetObject<TH1D>("n"), std::runtime_error);
+   EXPECT_THROW(results.GetValue<int>("y"), std::runtime_error);
+
+   gSystem->Unlink(fileName);
+}
+
+TEST(TProcessRunner, Files)
+{
+   const std::vector<std::string> fileNames{"dataframe_processrunner_file0.root", "dataframe_processrunner_file1.root"};
+   WriteFile(fileNames[0].c_str(), 0, 600);
+   WriteFile(fileNames[1].c_str(), 600, 400);
+
+   TProcessRunner runner(2);
+   auto results = runner.Run("t", fileNames, BookResults);
+
+   EXPECT_EQ(500U, results.GetValue<ULong64_t>("n"));
+   EXPECT_EQ(249500, results.GetValue<int>("sum"));
+   EXPECT_EQ(0, results.GetValue<int>("min"));
+   EXPECT_EQ(999, results.GetValue<int>("max"));
+   EXPECT_EQ(500, results.GetObject<TH1D>("h")->GetEntries());
+
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
+}
@@ -1,8 +1,12 @@
 #include "TRandom.h"
+#include "TSystem.h"
+#include "TTree.h"
 #include "ROOT/TDataFrame.hxx"
 #include "ROOT/TSeq.hxx"
 #include "gtest/gtest.h"
 
+#include <memory>
+
 using namespace ROOT::Experimental;
 
 TEST(TDataFrameReport, AnalyseCuts)
@@ -94,3 +98,62 @@ TEST(TDataFrameReport, Printing)
    output1 = testing::internal::GetCapturedStdout();
    EXPECT_STREQ(output1.c_str(), output0.c_str());
 }
+
+TEST(TDataFrameReport, Profile)
+{
+   TDataFrame d(100);
+   d.EnableProfiling();
+   auto dd = d.Define("x", [](ULong64_t e) { return double(e); }, {"tdfentry_"});
+   auto even = dd.Filter([](double x) { return int(x) % 2 == 0; }, {"x"});
+   auto c = even.Filter([](double x) { return x > 49; }, {"x"}, "big").Count();
+   EXPECT_EQ(*c, 25ULL);
+
+   auto prof = d.GetProfileReport();
+   EXPECT_EQ(prof.GetNLoops(), 1u);
+   EXPECT_EQ(prof.GetTotals().fNEntries, 100ULL);
+   EXPECT_EQ(prof["x"].GetKind(), "Define");
+   EXPECT_EQ(prof["x"].GetCalls(), 100ULL);
+   EXPECT_EQ(prof["unnamed(x)"].GetKind(), "Filter");
+   EXPECT_EQ(prof["unnamed(x)"].GetCalls(), 100ULL);
+   EXPECT_EQ(prof["big"].GetCalls(), 50ULL);
+   EXPECT_EQ(prof["Count()"].GetKind(), "Action");
+   EXPECT_EQ(prof["Count()"].GetCalls(), 25ULL);
+   for (auto &&node : prof)
+      EXPECT_GE(node.GetTime(), 0.);
+   EXPECT_THROW(prof["NonExisting"], std::runtime_error);
+
+   const auto json = prof.AsJSON();
+   EXPECT_NE(json.find("\"name\":\"big\""), std::string::npos);
+   std::unique_ptr<TTree> t(prof.AsTree());
+   t->SetDirectory(nullptr);
+   // the reads of the entries, the decompression and the file reads, then the nodes, for each slot
+   const auto nNodes = std::distance(prof.begin(), prof.end());
+   EXPECT_EQ(t->GetEntries(), Long64_t(prof.GetSlots().size() * (3 + nNodes)));
+
+   // the counters accumulate until profiling is disabled. Named filters run in every event loop.
+   *dd.Count();
+   EXPECT_EQ(d.GetProfileReport().GetNLoops(), 2u);
+   EXPECT_EQ(d.GetProfileReport()["x"].GetCalls(), 200ULL);
+   EXPECT_EQ(d.GetProfileReport()["big"].GetCalls(), 100ULL);
+   d.EnableProfiling(false);
+   *dd.Count();
+   EXPECT_EQ(d.GetProfileReport().GetNLoops(), 2u);
+   EXPECT_EQ(d.GetProfileReport()["x"].GetCalls(), 200ULL);
+}
+
+TEST(TDataFrameReport, ProfileTreeReads)
+{
+   const auto fileName = "dataframe_report_profile.root";
+   {
+      TDataFrame d(1000);
+      d.Define("x", [](ULong64_t e) { return double(e); }, {"tdfentry_"}).Snapshot<double>("t", fileName, {"x"});
+   }
+   TDataFrame d("t", fileName);
+   d.EnableProfiling();
+   EXPECT_DOUBLE_EQ(*d.Sum<double>("x"), 499500.);
+   const auto totals = d.GetProfileReport().GetTotals();
+   EXPECT_EQ(totals.fNEntries, 1000ULL);
+   EXPECT_GE(totals.fNReads, 1000ULL);
+   EXPECT_GT(totals.fBytesRead, 0LL);
+   gSystem->Unlink(fileName);
+}
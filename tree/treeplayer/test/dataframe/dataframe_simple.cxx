@@ -11,6 +11,7 @@
 #include <TTree.h>
 
 #include <algorithm> // std::sort
+#include <cmath>
 #include <chrono>
 #include <thread>
 #include <set>
@@ -480,6 +481,83 @@ TEST_P(TDFSimpleTests, AggregateGraph)
    }
 }
 
+TEST_P(TDFSimpleTests, BatchDefineFilter)
+{
+   auto filename = "dataframe_simple_batch.root";
+   auto treename = "t";
+   {
+      TFile f(filename, "RECREATE");
+      TTree t(treename, treename);
+      t.SetAutoFlush(100);
+      float px, py;
+      t.Branch("px", &px);
+      t.Branch("py", &py);
+      for (int i = 0; i < 1000; ++i) {
+         px = i % 17 - 8.f;
+         py = i % 23 - 11.f;
+         t.Fill();
+      }
+      t.Write();
+   }
+   TDataFrame d(treename, filename);
+   using Floats_t = std::vector<float>;
+   auto pt = [](const Floats_t &x, const Floats_t &y) {
+      Floats_t res(x.size());
+      for (std::size_t i = 0; i < x.size(); ++i)
+         res[i] = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+      return res;
+   };
+   auto positive = [](const Floats_t &x) {
+      std::vector<char> mask(x.size());
+      for (std::size_t i = 0; i < x.size(); ++i)
+         mask[i] = x[i] > 0;
+      return mask;
+   };
+   auto batchSum = d.DefineBatch("pt", pt, {"px", "py"}).FilterBatch(positive, {"px"}).Sum<float>("pt");
+   auto scalarSum = d.Define("pt", [](float x, float y) { return std::sqrt(x * x + y * y); }, {"px", "py"})
+                       .Filter([](float x) { return x > 0; }, {"px"})
+                       .Sum<float>("pt");
+   auto batchCount = d.FilterBatch(positive, {"py"}).Count();
+   auto scalarCount = d.Filter([](float y) { return y > 0; }, {"py"}).Count();
+   EXPECT_FLOAT_EQ(*batchSum, *scalarSum);
+   EXPECT_EQ(*batchCount, *scalarCount);
+   gSystem->Unlink(filename);
+}
+
+TEST_P(TDFSimpleTests, RunGraphs)
+{
+   auto filename = "dataframe_simple_rungraphs.root";
+   auto treename = "t";
+   FillTree(filename, treename, 100);
+
+   // two independent computation graphs reading the same file, run in one event loop
+   TDataFrame d1(treename, filename), d2(treename, filename);
+   auto sum1 = d1.Filter([](double b1) { return b1 > 10; }, {"b1"}).Sum<double>("b1");
+   auto count2 = d2.Filter("b2 % 2 == 0").Count();
+   auto max2 = d2.Define("z", [](double b1) { return -b1; }, {"b1"}).Max<double>("z");
+   RunGraphs(sum1, count2, max2);
+   EXPECT_TRUE(sum1.IsReady());
+   EXPECT_TRUE(count2.IsReady());
+   EXPECT_TRUE(max2.IsReady());
+   EXPECT_DOUBLE_EQ(4895., *sum1); // 11 + ... + 99
+   EXPECT_EQ(50U, *count2);
+   EXPECT_DOUBLE_EQ(0., *max2);
+
+   // results that are already available are skipped, the graphs can be run again
+   std::vector<TResultProxy<ULong64_t>> counts{d1.Count(), d2.Filter([](int b2) { return b2 > 100; }, {"b2"}).Count()};
+   RunGraphs(counts);
+   EXPECT_EQ(100U, *counts[0]);
+   EXPECT_EQ(89U, *counts[1]); // b2 = i * i > 100 for i > 10
+
+   // different sources cannot be processed jointly
+   TDataFrame empty(100);
+   auto emptyCount = empty.Count();
+   auto c1 = d1.Count();
+   EXPECT_ANY_THROW(RunGraphs(c1, emptyCount));
+
+   gSystem->Unlink(filename);
+}
+
 // run single-thread tests
 INSTANTIATE_TEST_CASE_P(Seq, TDFSimpleTests, ::testing::Values(false));
 
@@ -183,7 +183,7 @@ void test_snapshot_options(TInterface<TLoopManager> &tdf)
    opts.fCompressionLevel = 6;
 
    const auto outfile = "snapshot_test_opts.root";
-   for (auto algorithm : {ROOT::kZLIB, ROOT::kLZMA, ROOT::kLZ4}) {
+   for (auto algorithm : {ROOT::kZLIB, ROOT::kLZMA, ROOT::kLZ4, ROOT::kZSTD}) {
       opts.fCompressionAlgorithm = algorithm;
 
       auto s = tdf.Snapshot<int>("t", outfile, {"ans"}, opts);
@@ -381,6 +381,44 @@ TEST(TDFSnapshotMore, ManyTasksPerThread)
    ROOT::DisableImplicitMT();
 }
 
+TEST(TDFSnapshotMore, PreserveClusterOrderMT)
+{
+   const auto inputFile = "snapshot_preserveorder_in.root";
+   const auto outputFile = "snapshot_preserveorder_out.root";
+   const auto nEntries = 10000;
+   {
+      TFile f(inputFile, "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(100); // many small clusters, i.e. many tasks
+      int x;
+      t.Branch("x", &x);
+      for (x = 0; x < nEntries; ++x)
+         t.Fill();
+      t.Write();
+   }
+
+   ROOT::EnableImplicitMT(4);
+   TSnapshotOptions opts;
+   opts.fPreserveClusterOrder = true;
+   TDataFrame d("t", inputFile);
+   d.Filter([](int x) { return x % 3 != 0; }, {"x"}).Snapshot<int>("t", outputFile, {"x"}, opts);
+   ROOT::DisableImplicitMT();
+
+   TDataFrame check("t", outputFile);
+   auto xs = check.Take<int>("x");
+   auto expected = 0;
+   for (auto x : xs) {
+      if (expected % 3 == 0)
+         ++expected;
+      EXPECT_EQ(x, expected);
+      ++expected;
+   }
+   EXPECT_EQ(xs->size(), 6666u);
+
+   gSystem->Unlink(inputFile);
+   gSystem->Unlink(outputFile);
+}
+
 void checkSnapshotArrayFileMT(TInterface<TLoopManager> &df, unsigned int kNEvents)
 {
    // fixedSizeArr and varSizeArr are TResultProxy<vector<vector<T>>>
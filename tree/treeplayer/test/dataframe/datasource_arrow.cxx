@@ -0,0 +1,127 @@
+#include <ROOT/TDataFrame.hxx>
+#include <ROOT/TArrowDS.hxx>
+#include <ROOT/TSeq.hxx>
+
+#include <arrow/api.h>
+
+#include "gtest/gtest.h"
+
+using namespace ROOT::Experimental;
+using namespace ROOT::Experimental::TDF;
+
+// A table of two record batches with entries {0, 1, 2} and {3, 4}
+std::shared_ptr<arrow::Table> MakeTable()
+{
+   auto schema = arrow::schema({arrow::field("x", arrow::int64()), arrow::field("d", arrow::float64()),
+                                arrow::field("b", arrow::boolean()), arrow::field("s", arrow::utf8()),
+                                arrow::field("h", arrow::float16())});
+   std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+   for (auto range : {std::make_pair(0, 3), std::make_pair(3, 5)}) {
+      arrow::Int64Builder xBuilder;
+      arrow::DoubleBuilder dBuilder;
+      arrow::BooleanBuilder bBuilder;
+      arrow::StringBuilder sBuilder;
+      arrow::HalfFloatBuilder hBuilder;
+      for (auto i : ROOT::TSeqI(range.first, range.second)) {
+         EXPECT_TRUE(xBuilder.Append(i).ok());
+         EXPECT_TRUE(dBuilder.Append(i * 0.5).ok());
+         EXPECT_TRUE(bBuilder.Append(i % 2 == 0).ok());
+         EXPECT_TRUE(sBuilder.Append("entry" + std::to_string(i)).ok());
+         EXPECT_TRUE(hBuilder.Append(0).ok());
+      }
+      std::vector<std::shared_ptr<arrow::Array>> arrays(5);
+      EXPECT_TRUE(xBuilder.Finish(&arrays[0]).ok());
+      EXPECT_TRUE(dBuilder.Finish(&arrays[1]).ok());
+      EXPECT_TRUE(bBuilder.Finish(&arrays[2]).ok());
+      EXPECT_TRUE(sBuilder.Finish(&arrays[3]).ok());
+      EXPECT_TRUE(hBuilder.Finish(&arrays[4]).ok());
+      batches.emplace_back(arrow::RecordBatch::Make(schema, range.second - range.first, arrays));
+   }
+   std::shared_ptr<arrow::Table> table;
+   EXPECT_TRUE(arrow::Table::FromRecordBatches(batches, &table).ok());
+   return table;
+}
+
+TEST(TArrowDS, ColTypeNames)
+{
+   TArrowDS tds(MakeTable());
+   tds.SetNSlots(1);
+
+   // the half-float column is not supported, it is skipped
+   const std::vector<std::string> expected{"x", "d", "b", "s"};
+   EXPECT_EQ(expected, tds.GetColumnNames());
+   EXPECT_STREQ("Long64_t", tds.GetTypeName("x").c_str());
+   EXPECT_STREQ("double", tds.GetTypeName("d").c_str());
+   EXPECT_STREQ("bool", tds.GetTypeName("b").c_str());
+   EXPECT_STREQ("std::string", tds.GetTypeName("s").c_str());
+
+   EXPECT_TRUE(tds.HasColumn("x"));
+   EXPECT_FALSE(tds.HasColumn("h"));
+   EXPECT_THROW(TArrowDS(MakeTable(), {"x", "h"}), std::runtime_error);
+   EXPECT_THROW(TArrowDS(MakeTable(), {"y"}), std::runtime_error);
+}
+
+TEST(TArrowDS, EntryRanges)
+{
+   TArrowDS tds(MakeTable());
+   tds.SetNSlots(2);
+   tds.Initialise();
+   auto ranges = tds.GetEntryRanges();
+
+   ASSERT_EQ(2U, ranges.size());
+   EXPECT_EQ(0U, ranges[0].first);
+   EXPECT_EQ(3U, ranges[0].second);
+   EXPECT_EQ(3U, ranges[1].first);
+   EXPECT_EQ(5U, ranges[1].second);
+}
+
+TEST(TArrowDS, ColumnReaders)
+{
+   auto table = MakeTable();
+   TArrowDS tds(table);
+   const auto nSlots = 2U;
+   tds.SetNSlots(nSlots);
+   auto xs = tds.GetColumnReaders<Long64_t>("x");
+   auto ss = tds.GetColumnReaders<std::string>("s");
+   EXPECT_THROW(tds.GetColumnReaders<int>("x"), std::runtime_error);
+   tds.Initialise();
+   auto ranges = tds.GetEntryRanges();
+   auto slot = 0U;
+   for (auto &&range : ranges) {
+      for (auto i : ROOT::TSeq<ULong64_t>(range.first, range.second)) {
+         tds.SetEntry(slot, i);
+         EXPECT_EQ(Long64_t(i), **xs[slot]);
+         EXPECT_EQ("entry" + std::to_string(i), **ss[slot]);
+      }
+      slot++;
+   }
+
+   // the values are read in place from the arrow buffers
+   tds.SetEntry(0, 0);
+   const auto &firstBatchValues = *static_cast<const arrow::Int64Array &>(*table->column(0)->data()->chunk(0)).values();
+   EXPECT_EQ(reinterpret_cast<const void *>(firstBatchValues.data()), reinterpret_cast<const void *>(*xs[0]));
+}
+
+TEST(TArrowDS, DataFrame)
+{
+   auto tdf = MakeArrowDataFrame(MakeTable());
+   auto sum = tdf.Sum<Long64_t>("x");
+   auto n = tdf.Filter([](bool b) { return b; }, {"b"}).Count();
+   auto d = tdf.Max<double>("d");
+   EXPECT_EQ(10, *sum);
+   EXPECT_EQ(3U, *n);
+   EXPECT_DOUBLE_EQ(2., *d);
+}
+
+#ifdef R__USE_IMT
+TEST(TArrowDS, DataFrameMT)
+{
+   ROOT::EnableImplicitMT(2);
+   auto tdf = MakeArrowDataFrame(MakeTable(), {"x", "s"});
+   auto sum = tdf.Sum<Long64_t>("x");
+   auto n = tdf.Filter([](const std::string &s) { return s != "entry3"; }, {"s"}).Count();
+   EXPECT_EQ(10, *sum);
+   EXPECT_EQ(4U, *n);
+   ROOT::DisableImplicitMT();
+}
+#endif
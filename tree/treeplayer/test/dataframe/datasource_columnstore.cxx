@@ -0,0 +1,147 @@
+#include <ROOT/TColumnStore.hxx>
+#include <ROOT/TColumnStoreDS.hxx>
+#include <ROOT/TDataFrame.hxx>
+#include <ROOT/TSeq.hxx>
+#include <TSystem.h>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+using namespace ROOT::Experimental;
+using namespace ROOT::Experimental::TDF;
+
+namespace {
+const char *fileName = "datasource_columnstore.rcs";
+const ULong64_t nEntries = 100000;
+
+// small pages, so that the entries span many of them
+void WriteStore(const TColumnStoreOptions &options)
+{
+   auto writer = TColumnStoreWriter::Recreate(fileName, options);
+   auto x = writer->MakeColumn<double>("x");
+   auto n = writer->MakeColumn<int>("n");
+   auto hits = writer->MakeColumn<std::vector<float>>("hits");
+   std::vector<float> value;
+   for (auto i : ROOT::TSeq<ULong64_t>(nEntries)) {
+      x.Fill(i * 0.5);
+      n.Fill(i % 7);
+      value.assign(i % 7, float(i));
+      hits.Fill(value);
+   }
+   writer->Close();
+}
+
+TColumnStoreOptions SmallPages()
+{
+   TColumnStoreOptions options;
+   options.fPageSize = 4000;
+   return options;
+}
+} // anonymous namespace
+
+TEST(TColumnStore, WriteRead)
+{
+   for (int level : {0, 1}) {
+      auto options = SmallPages();
+      options.fCompressionLevel = level;
+      WriteStore(options);
+
+      auto reader = TColumnStoreReader::Open(fileName);
+      EXPECT_EQ(nEntries, reader->GetNEntries());
+      EXPECT_EQ(std::vector<std::string>({"x", "n", "hits"}), reader->GetColumnNames());
+      EXPECT_EQ("std::vector<float>", reader->GetTypeName("hits"));
+      for (const auto &column : reader->GetDescriptors()) {
+         for (const auto &page : column.fPages)
+            EXPECT_EQ(0u, page.fOffset % options.fAlignment);
+      }
+
+      auto x = reader->GetColumn<double>("x");
+      auto hits = reader->GetColumn<std::vector<float>>("hits");
+      for (auto i : ROOT::TSeq<ULong64_t>(nEntries)) {
+         ASSERT_EQ(i * 0.5, x(i));
+         const auto &value = hits(i);
+         ASSERT_EQ(i % 7, value.size());
+         for (auto v : value)
+            ASSERT_EQ(float(i), v);
+      }
+      // the values of a page are contiguous
+      ULong64_t n = 0;
+      const double *values = x.GetValues(10, n);
+      EXPECT_EQ(5., values[0]);
+      EXPECT_EQ(500u - 10, n);
+      std::vector<double> range(1000);
+      x.ReadRange(400, range.size(), range.data());
+      EXPECT_EQ(999 * 0.5 + 200, range.back());
+
+      EXPECT_THROW(reader->GetColumn<float>("x"), std::runtime_error);
+      EXPECT_THROW(reader->GetColumn<double>("y"), std::runtime_error);
+      EXPECT_THROW(x(nEntries), std::out_of_range);
+   }
+   gSystem->Unlink(fileName);
+}
+
+TEST(TColumnStore, Errors)
+{
+   auto writer = TColumnStoreWriter::Recreate(fileName);
+   auto x = writer->MakeColumn<double>("x");
+   writer->MakeColumn<double>("y");
+   EXPECT_THROW(writer->MakeColumn<int>("x"), std::runtime_error);
+   x.Fill(1.);
+   EXPECT_THROW(writer->MakeColumn<int>("z"), std::runtime_error);
+   EXPECT_THROW(writer->Close(), std::runtime_error);
+   EXPECT_THROW(TColumnStoreReader::Open(fileName), std::runtime_error);
+   gSystem->Unlink(fileName);
+}
+
+TEST(TColumnStoreDS, ColTypeNames)
+{
+   WriteStore(SmallPages());
+   TColumnStoreDS tds(fileName);
+   tds.SetNSlots(1);
+   EXPECT_TRUE(tds.HasColumn("x"));
+   EXPECT_FALSE(tds.HasColumn("hits._0"));
+   EXPECT_EQ("double", tds.GetTypeName("x"));
+   EXPECT_EQ("int", tds.GetTypeName("n"));
+   EXPECT_EQ("std::vector<float>", tds.GetTypeName("hits"));
+   EXPECT_THROW(tds.GetColumnReaders<float>("x"), std::runtime_error);
+   gSystem->Unlink(fileName);
+}
+
+TEST(TColumnStoreDS, FromATDF)
+{
+   WriteStore(SmallPages());
+   auto tdf = MakeColumnStoreDataFrame(fileName);
+   auto sumx = tdf.Sum<double>("x");
+   auto nhits = tdf.Define("nhits", [](const std::vector<float> &hits) { return hits.size(); }, {"hits"})
+                   .Sum<std::size_t>("nhits");
+   auto sumn = tdf.Sum<int>("n");
+   EXPECT_DOUBLE_EQ(0.5 * nEntries * (nEntries - 1) / 2, *sumx);
+   EXPECT_EQ(ULong64_t(*sumn), *nhits);
+   gSystem->Unlink(fileName);
+}
+
+TEST(TColumnStoreDS, FromATDFWithJitting)
+{
+   WriteStore(SmallPages());
+   auto tdf = MakeColumnStoreDataFrame(fileName);
+   auto count = tdf.Filter("n == 3 && hits.size() == 3").Count();
+   EXPECT_EQ(nEntries / 7 + (nEntries % 7 > 3), *count);
+   gSystem->Unlink(fileName);
+}
+
+#ifdef R__USE_IMT
+TEST(TColumnStoreDS, FromATDFMT)
+{
+   WriteStore(SmallPages());
+   ROOT::EnableImplicitMT(4);
+   auto tdf = MakeColumnStoreDataFrame(fileName);
+   auto sumx = tdf.Sum<double>("x");
+   auto maxhits = tdf.Define("nhits", [](const std::vector<float> &hits) { return hits.size(); }, {"hits"})
+                     .Max<std::size_t>("nhits");
+   EXPECT_DOUBLE_EQ(0.5 * nEntries * (nEntries - 1) / 2, *sumx);
+   EXPECT_EQ(6u, *maxhits);
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(fileName);
+}
+#endif // R__USE_IMT
@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <iostream>
 
 using namespace ROOT::Experimental;
@@ -132,6 +133,45 @@ TEST(TCsvDS, ColumnReadersString)
    }
 }
 
+TEST(TCsvDS, ChunksAndTypeWidening)
+{
+   const auto fileName = "TCsvDS_test_chunks.csv";
+   const auto nRecords = 1001;
+   {
+      std::ofstream f(fileName);
+      f << "Index,Value,Label\n";
+      for (auto i : ROOT::TSeqI(nRecords)) {
+         // integers and floating point numbers in the same column, and some empty lines
+         f << i << "," << (i % 2 ? std::to_string(i) : std::to_string(i) + ".5") << ",l" << i << "\n";
+         if (i % 100 == 0)
+            f << "\n";
+      }
+   }
+
+   TCsvDS tds(fileName);
+   EXPECT_STREQ("Long64_t", tds.GetTypeName("Index").c_str());
+   EXPECT_STREQ("double", tds.GetTypeName("Value").c_str());
+   const auto nSlots = 4U;
+   tds.SetNSlots(nSlots);
+   auto indices = tds.GetColumnReaders<Long64_t>("Index");
+   auto values = tds.GetColumnReaders<double>("Value");
+   tds.Initialise();
+   auto ranges = tds.GetEntryRanges();
+   EXPECT_EQ(nSlots, ranges.size());
+   EXPECT_EQ(0U, ranges.front().first);
+   EXPECT_EQ(ULong64_t(nRecords), ranges.back().second);
+   auto slot = 0U;
+   for (auto &&range : ranges) {
+      tds.InitSlot(slot, range.first);
+      for (auto i : ROOT::TSeq<ULong64_t>(range.first, range.second)) {
+         tds.SetEntry(slot, i);
+         EXPECT_EQ(Long64_t(i), **indices[slot]);
+         EXPECT_DOUBLE_EQ(i % 2 ? i : i + .5, **values[slot]);
+      }
+      slot++;
+   }
+}
+
 #ifndef NDEBUG
 
 TEST(TCsvDS, SetNSlotsTwice)
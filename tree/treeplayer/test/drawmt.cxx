@@ -0,0 +1,67 @@
+#include "TFile.h"
+#include "TH2.h"
+#include "TProfile.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#ifdef R__USE_IMT
+
+static void MakeDrawFile(const char *filename, Int_t nEntries)
+{
+   TFile file(filename, "RECREATE");
+   TTree tree("T", "tree with several clusters");
+   tree.SetAutoFlush(10000);
+   Float_t x, y;
+   tree.Branch("x", &x, "x/F");
+   tree.Branch("y", &y, "y/F");
+   for (Int_t e = 0; e < nEntries; ++e) {
+      x = (e % 1000) * 0.01;
+      y = ((e * 7) % 113) * 0.1;
+      tree.Fill();
+   }
+   tree.Write();
+}
+
+static void ExpectSameHistograms(TDirectory &dir, const char *seqname, const char *mtname)
+{
+   TH1 *a = nullptr, *b = nullptr;
+   dir.GetObject(seqname, a);
+   dir.GetObject(mtname, b);
+   ASSERT_NE(a, nullptr);
+   ASSERT_NE(b, nullptr);
+   EXPECT_EQ(a->GetEntries(), b->GetEntries());
+   EXPECT_NEAR(a->GetMean(), b->GetMean(), 1e-9);
+   // the sums are done in a different order
+   for (Int_t bin = 0; bin < a->GetNcells(); ++bin)
+      EXPECT_NEAR(a->GetBinContent(bin), b->GetBinContent(bin), 1e-9) << mtname << " bin " << bin;
+}
+
+// The histograms with fixed axes filled by the implicit multi-threading tasks are the same as the sequential ones.
+TEST(TTreeDraw, ImplicitMTHistograms)
+{
+   const char *filename = "treedraw_mt.root";
+   MakeDrawFile(filename, 200000);
+   TFile file(filename);
+   TTree *tree = nullptr;
+   file.GetObject("T", tree);
+   ASSERT_NE(tree, nullptr);
+
+   tree->Draw("x>>h1seq(50,0,10)", "y>2", "goff");
+   tree->Draw("y:x>>h2seq(20,0,10,20,0,12)", "", "goff");
+   tree->Draw("y:x>>pseq(20,0,10)", "x<8", "prof goff");
+
+   ROOT::EnableImplicitMT(4);
+   tree->Draw("x>>h1mt(50,0,10)", "y>2", "goff");
+   tree->Draw("y:x>>h2mt(20,0,10,20,0,12)", "", "goff");
+   Long64_t nSelected = tree->Draw("y:x>>pmt(20,0,10)", "x<8", "prof goff");
+   ROOT::DisableImplicitMT();
+
+   EXPECT_EQ(nSelected, 160000);
+   ExpectSameHistograms(file, "h1seq", "h1mt");
+   ExpectSameHistograms(file, "h2seq", "h2mt");
+   ExpectSameHistograms(file, "pseq", "pmt");
+}
+
+#endif // R__USE_IMT
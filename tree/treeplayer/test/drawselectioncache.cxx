@@ -0,0 +1,78 @@
+#include "TH1.h"
+#include "TROOT.h"
+#include "TTree.h"
+#include "TTreePlayer.h"
+
+#include "gtest/gtest.h"
+
+static void FillTree(TTree &tree)
+{
+   Float_t pt, eta;
+   Int_t nJets, n;
+   Float_t x[4];
+   tree.Branch("pt", &pt, "pt/F");
+   tree.Branch("eta", &eta, "eta/F");
+   tree.Branch("nJets", &nJets, "nJets/I");
+   tree.Branch("n", &n, "n/I");
+   tree.Branch("x", x, "x[n]/F");
+   for (Int_t e = 0; e < 10000; ++e) {
+      pt = (e % 97) * 0.5;
+      eta = ((e * 13) % 50) * 0.1 - 2.5;
+      nJets = e % 6;
+      n = e % 4 + 1;
+      for (Int_t i = 0; i < n; ++i)
+         x[i] = (e + i) % 7;
+      tree.Fill();
+   }
+}
+
+static void ExpectSameDraw(TTree &tree, const char *varexp, const char *selection, Long64_t nentries = TTree::kMaxEntries,
+                           Long64_t firstentry = 0)
+{
+   TTreePlayer *player = (TTreePlayer *)tree.GetPlayer();
+   player->SetSelectionCacheSize(0);
+   Long64_t nref = tree.Draw(TString::Format("%s>>href", varexp), selection, "goff", nentries, firstentry);
+   player->SetSelectionCacheSize(1 << 20);
+   for (Int_t i = 0; i < 2; ++i) {
+      Long64_t n = tree.Draw(TString::Format("%s>>hcache", varexp), selection, "goff", nentries, firstentry);
+      EXPECT_EQ(nref, n) << varexp << " " << selection;
+      TH1 *href = (TH1 *)gROOT->FindObject("href");
+      TH1 *hcache = (TH1 *)gROOT->FindObject("hcache");
+      ASSERT_NE(nullptr, href);
+      ASSERT_NE(nullptr, hcache);
+      EXPECT_STREQ(href->GetTitle(), hcache->GetTitle());
+      EXPECT_EQ(href->GetSumOfWeights(), hcache->GetSumOfWeights()) << varexp << " " << selection;
+      for (Int_t bin = 0; bin < href->GetNcells(); ++bin)
+         EXPECT_EQ(href->GetBinContent(bin), hcache->GetBinContent(bin)) << varexp << " " << selection << " bin " << bin;
+   }
+   EXPECT_EQ(nullptr, tree.GetEntryList());
+}
+
+TEST(TTreeDraw, SelectionCache)
+{
+   TTree tree("t", "t");
+   FillTree(tree);
+
+   ExpectSameDraw(tree, "pt", "nJets>2");
+   ExpectSameDraw(tree, "eta", "nJets>2");
+   ExpectSameDraw(tree, "eta:pt", "nJets>2 && pt<20");
+   ExpectSameDraw(tree, "pt", "nJets>2", 5000, 1000);
+   // selections used as weights and selections of array instances are not replaced by entry lists
+   ExpectSameDraw(tree, "pt", "nJets*(pt>3)");
+   ExpectSameDraw(tree, "x", "x>3");
+   ExpectSameDraw(tree, "x", "nJets==1");
+}
+
+TEST(TTreeDraw, SelectionCacheNewEntries)
+{
+   TTree tree("t", "t");
+   Int_t i;
+   tree.Branch("i", &i, "i/I");
+   for (i = 0; i < 100; ++i)
+      tree.Fill();
+   ((TTreePlayer *)tree.GetPlayer())->SetSelectionCacheSize(1 << 20);
+   EXPECT_EQ(50, tree.Draw("i", "i%2==0", "goff"));
+   for (i = 100; i < 200; ++i)
+      tree.Fill();
+   EXPECT_EQ(100, tree.Draw("i", "i%2==0", "goff"));
+}
@@ -0,0 +1,129 @@
+#include "TFile.h"
+#include "TH1.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreePerfStats.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+// Small baskets, so that each branch reads many of them; "x" compresses well, "y" does not.
+static void MakePerfStatsFile(const char *filename, Int_t nEntries)
+{
+   TFile file(filename, "RECREATE");
+   TTree tree("T", "tree with a compressible and an incompressible branch");
+   Int_t x;
+   Double_t y;
+   tree.Branch("x", &x, "x/I", 1000);
+   tree.Branch("y", &y, "y/D", 1000);
+   for (Int_t i = 0; i < nEntries; ++i) {
+      x = i / 100;
+      y = (i * 2654435761u) % 1000003 / 1000003.;
+      tree.Fill();
+   }
+   tree.Write();
+}
+
+static void CheckBranchStats(TTreePerfStats &ps)
+{
+   ASSERT_EQ(ps.GetBranchNames().size(), 2u);
+   for (const char *name : {"x", "y"}) {
+      EXPECT_GT(ps.GetBranchBaskets(name), 1);
+      EXPECT_GT(ps.GetBranchZipBytes(name), 0);
+      EXPECT_GT(ps.GetBranchUnzipBytes(name), 0);
+   }
+   EXPECT_GT(ps.GetBranchUnzipBytes("x"), ps.GetBranchZipBytes("x"));
+   EXPECT_EQ(ps.GetBranchBaskets("z"), 0);
+   ASSERT_NE(ps.GetReadLatency(), nullptr);
+   EXPECT_EQ(ps.GetReadLatency()->GetEntries(), ps.GetReadCalls());
+}
+
+TEST(TTreePerfStats, BranchStats)
+{
+   const char *filename = "perfstats_branches.root";
+   MakePerfStatsFile(filename, 20000);
+
+   TFile file(filename);
+   auto tree = static_cast<TTree *>(file.Get("T"));
+   TTreePerfStats ps("ioperf", tree);
+   for (Long64_t i = 0; i < tree->GetEntries(); ++i)
+      tree->GetEntry(i);
+   CheckBranchStats(ps);
+
+   const TString json = ps.GetBranchStatsJSON();
+   EXPECT_TRUE(json.BeginsWith("{\"branches\":[{\"name\":\"x\",\"baskets\":"));
+   EXPECT_TRUE(json.Contains("\"readLatency\":{\"edges\":[1e-06,"));
+
+   std::unique_ptr<TTree> stats(ps.GetBranchStatsTree());
+   stats->SetDirectory(nullptr);
+   EXPECT_EQ(stats->GetEntries(), 2);
+   Int_t baskets = 0;
+   stats->SetBranchAddress("baskets", &baskets);
+   stats->GetEntry(1);
+   EXPECT_EQ(baskets, ps.GetBranchBaskets("y"));
+   stats->ResetBranchAddresses();
+
+   gSystem->Unlink(filename);
+}
+
+TEST(TTreePerfStats, WriteStats)
+{
+   const char *filename = "perfstats_write.root";
+   {
+      TFile file(filename, "RECREATE");
+      TTree tree("T", "tree being written");
+      Int_t x;
+      Double_t y;
+      tree.Branch("x", &x, "x/I", 1000);
+      tree.Branch("y", &y, "y/D", 1000);
+      tree.SetAutoFlush(5000);
+      TTreePerfStats ps("ioperf", &tree);
+      for (Int_t i = 0; i < 20000; ++i) {
+         x = i / 100;
+         y = (i * 2654435761u) % 1000003 / 1000003.;
+         tree.Fill();
+      }
+      tree.FlushBaskets();
+
+      EXPECT_EQ(ps.GetBranchFillBytes("x"), 20000 * Long64_t(sizeof(Int_t)));
+      EXPECT_EQ(ps.GetBranchFillBytes("y"), 20000 * Long64_t(sizeof(Double_t)));
+      for (const char *name : {"x", "y"}) {
+         EXPECT_GT(ps.GetBranchFillTime(name), 0);
+         EXPECT_GT(ps.GetBranchWriteBaskets(name), 1);
+         EXPECT_GE(ps.GetBranchWriteUnzipBytes(name), ps.GetBranchFillBytes(name));
+         EXPECT_GT(ps.GetBranchWriteZipBytes(name), 0);
+         // Nothing was read.
+         EXPECT_EQ(ps.GetBranchBaskets(name), 0);
+      }
+      EXPECT_GT(ps.GetBranchWriteUnzipBytes("x"), 2 * ps.GetBranchWriteZipBytes("x"));
+      // The auto-flushes at 5000, 10000, 15000 and 20000 entries, and the final one.
+      EXPECT_EQ(ps.GetFlushes(), 5);
+      EXPECT_EQ(ps.GetFlushLatency()->GetEntries(), 5);
+      EXPECT_TRUE(ps.GetBranchStatsJSON().Contains("\"flushLatency\":{\"edges\":[1e-06,"));
+      tree.SetPerfStats(nullptr);
+   }
+   gSystem->Unlink(filename);
+}
+
+#ifdef R__USE_IMT
+TEST(TTreePerfStats, BranchStatsIMT)
+{
+   const char *filename = "perfstats_branches_imt.root";
+   MakePerfStatsFile(filename, 20000);
+
+   ROOT::EnableImplicitMT(4);
+   {
+      TFile file(filename);
+      auto tree = static_cast<TTree *>(file.Get("T"));
+      TTreePerfStats ps("ioperf", tree);
+      for (Long64_t i = 0; i < tree->GetEntries(); ++i)
+         tree->GetEntry(i);
+      CheckBranchStats(ps);
+   }
+   ROOT::DisableImplicitMT();
+
+   gSystem->Unlink(filename);
+}
+#endif // R__USE_IMT
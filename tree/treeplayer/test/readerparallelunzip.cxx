@@ -0,0 +1,74 @@
+#include "TChain.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TTree.h"
+#include "TTreeCacheUnzip.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#ifdef R__USE_IMT
+
+static void MakeUnzipFile(const char *filename, Int_t offset)
+{
+   TFile file(filename, "RECREATE");
+   TTree tree("T", "tree with several clusters");
+   tree.SetAutoFlush(5000);
+   Int_t i;
+   Double_t x;
+   tree.Branch("i", &i, "i/I");
+   tree.Branch("x", &x, "x/D");
+   for (Int_t e = 0; e < 50000; ++e) {
+      i = offset + e;
+      x = 0.5 * i;
+      tree.Fill();
+   }
+   tree.Write();
+}
+
+static std::vector<Int_t> ReadValues(TTree *tree, Bool_t parallelUnzip, Bool_t &usedUnzipCache)
+{
+   TTreeReader reader(tree);
+   reader.SetParallelUnzip(parallelUnzip);
+   TTreeReaderValue<Int_t> i(reader, "i");
+   TTreeReaderValue<Double_t> x(reader, "x");
+   std::vector<Int_t> values;
+   usedUnzipCache = kFALSE;
+   while (reader.Next()) {
+      EXPECT_DOUBLE_EQ(*x, 0.5 * *i);
+      values.push_back(*i);
+      TFile *file = tree->GetCurrentFile();
+      if (file && dynamic_cast<TTreeCacheUnzip *>(file->GetCacheRead(tree->GetTree())))
+         usedUnzipCache = kTRUE;
+   }
+   return values;
+}
+
+// The values read with the baskets unzipped in the background are the ones read serially.
+TEST(TTreeReader, ParallelUnzip)
+{
+   MakeUnzipFile("readerunzip_0.root", 0);
+   MakeUnzipFile("readerunzip_1.root", 50000);
+
+   TChain chain("T");
+   chain.Add("readerunzip_0.root");
+   chain.Add("readerunzip_1.root");
+
+   Bool_t usedUnzipCache;
+   auto serial = ReadValues(&chain, kFALSE, usedUnzipCache);
+   EXPECT_FALSE(usedUnzipCache);
+
+   ROOT::EnableImplicitMT(2);
+   auto parallel = ReadValues(&chain, kTRUE, usedUnzipCache);
+   ROOT::DisableImplicitMT();
+   EXPECT_TRUE(usedUnzipCache);
+   EXPECT_EQ(TTreeCacheUnzip::GetParallelUnzip(), TTreeCacheUnzip::kDisable);
+
+   ASSERT_EQ(serial.size(), 100000u);
+   EXPECT_EQ(serial, parallel);
+}
+
+#endif // R__USE_IMT
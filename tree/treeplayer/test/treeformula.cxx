@@ -0,0 +1,54 @@
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+static const Long64_t kNEntries = 150000; // more than the number of evaluations before the compilation
+
+static void FillTree(TTree &tree)
+{
+   Float_t x, y;
+   Int_t i;
+   tree.Branch("x", &x, "x/F");
+   tree.Branch("y", &y, "y/F");
+   tree.Branch("i", &i, "i/I");
+   for (Long64_t e = 0; e < kNEntries; ++e) {
+      x = 0.001 * e - 20;
+      y = (e % 17) - 8;
+      i = e % 23;
+      tree.Fill();
+   }
+}
+
+static std::vector<Double_t> Evaluate(TTree &tree, const char *expression, Bool_t jit)
+{
+   Bool_t enabled = TTreeFormula::IsJitEnabled();
+   TTreeFormula::SetJitEnabled(jit);
+   TTreeFormula formula("formula", expression, &tree);
+   std::vector<Double_t> values;
+   for (Long64_t e = 0; e < kNEntries; ++e) {
+      tree.LoadTree(e);
+      formula.GetNdata();
+      values.push_back(formula.EvalInstance());
+   }
+   TTreeFormula::SetJitEnabled(enabled);
+   return values;
+}
+
+TEST(TTreeFormula, CompiledSameAsInterpreted)
+{
+   TTree tree("t", "t");
+   FillTree(tree);
+
+   const char *expressions[] = {"x*y+3", "x/y", "sqrt(x)+log(y)", "x>0 && y<2", "x<-10 || i==3", "i%5+(i&6)",
+                                "atan2(x,y)*sin(x)", "max(x,y)-min(x,i)", "!(x>y)", "exp(x)/pow(y,2)", "-x+abs(y)"};
+   for (auto expression : expressions) {
+      auto interpreted = Evaluate(tree, expression, kFALSE);
+      auto compiled = Evaluate(tree, expression, kTRUE);
+      ASSERT_EQ(interpreted.size(), compiled.size());
+      for (std::size_t e = 0; e < interpreted.size(); ++e)
+         ASSERT_DOUBLE_EQ(interpreted[e], compiled[e]) << expression << " at entry " << e;
+   }
+}
@@ -0,0 +1,116 @@
+#include "TChain.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TTree.h"
+#include "TTreeIndex.h"
+
+#include "gtest/gtest.h"
+
+// Runs are written in descending order and events in a scrambled order, so that the index must really be sorted.
+static void MakeIndexFile(const char *filename, Int_t firstrun, Int_t nruns, Int_t nevents)
+{
+   TFile file(filename, "RECREATE");
+   TTree tree("T", "tree with run and event numbers");
+   Int_t run;
+   Long64_t event;
+   Float_t x;
+   tree.Branch("run", &run, "run/I");
+   tree.Branch("event", &event, "event/L");
+   tree.Branch("x", &x, "x/F");
+   for (Int_t r = nruns - 1; r >= 0; --r) {
+      for (Int_t e = 0; e < nevents; ++e) {
+         run = firstrun + r;
+         event = (e * 7919) % nevents;
+         x = run + 0.001 * event;
+         tree.Fill();
+      }
+   }
+   tree.Write();
+}
+
+static void CheckSameIndex(TTreeIndex *a, TTreeIndex *b)
+{
+   ASSERT_EQ(a->GetN(), b->GetN());
+   for (Long64_t i = 0; i < a->GetN(); ++i) {
+      ASSERT_EQ(a->GetIndexValues()[i], b->GetIndexValues()[i]);
+      ASSERT_EQ(a->GetIndexValuesMinor()[i], b->GetIndexValuesMinor()[i]);
+      ASSERT_EQ(a->GetIndex()[i], b->GetIndex()[i]);
+   }
+}
+
+TEST(TTreeIndex, BulkMatchesFormula)
+{
+   MakeIndexFile("treeindex_bulk.root", 100, 10, 1000);
+   TFile file("treeindex_bulk.root");
+   TTree *tree = nullptr;
+   file.GetObject("T", tree);
+   ASSERT_NE(nullptr, tree);
+
+   // "run" and "event" are read in bulk, the expressions through TTreeFormula.
+   TTreeIndex bulk(tree, "run", "event");
+   TTreeIndex formula(tree, "run+0", "event+0");
+   CheckSameIndex(&bulk, &formula);
+
+   Float_t x;
+   tree->SetBranchAddress("x", &x);
+   tree->SetTreeIndex(&bulk);
+   ASSERT_GT(tree->GetEntryWithIndex(105, 123), 0);
+   EXPECT_FLOAT_EQ(105 + 0.123, x);
+   tree->SetTreeIndex(nullptr);
+}
+
+#ifdef R__USE_IMT
+TEST(TTreeIndex, ParallelBuild)
+{
+   MakeIndexFile("treeindex_mt.root", 1, 4, 100000);
+   TFile file("treeindex_mt.root");
+   TTree *tree = nullptr;
+   file.GetObject("T", tree);
+   ASSERT_NE(nullptr, tree);
+
+   TTreeIndex sequential(tree, "run", "event");
+   ROOT::EnableImplicitMT(4);
+   TTreeIndex parallel(tree, "run", "event");
+   ROOT::DisableImplicitMT();
+   CheckSameIndex(&sequential, &parallel);
+}
+#endif
+
+TEST(TTreeIndex, Standalone)
+{
+   MakeIndexFile("treeindex_part1.root", 1, 5, 100);
+   MakeIndexFile("treeindex_part2.root", 6, 5, 100);
+   for (auto name : {"treeindex_part1.root", "treeindex_part2.root"}) {
+      TFile file(name, "UPDATE");
+      TTree *tree = nullptr;
+      file.GetObject("T", tree);
+      ASSERT_NE(nullptr, tree);
+      TTreeIndex index(tree, "run", "event");
+      EXPECT_GT(index.WriteStandalone(), 0);
+   }
+
+   {
+      TFile file("treeindex_part1.root");
+      TTree *tree = nullptr;
+      file.GetObject("T", tree);
+      ASSERT_NE(nullptr, tree);
+      EXPECT_EQ(nullptr, TTreeIndex::ReadStandalone(tree, "run", "x"));
+      TTreeIndex *saved = TTreeIndex::ReadStandalone(tree, "run", "event");
+      ASSERT_NE(nullptr, saved);
+      TTreeIndex built(tree, "run", "event");
+      CheckSameIndex(saved, &built);
+      delete saved;
+   }
+
+   TChain chain("T");
+   chain.Add("treeindex_part1.root");
+   chain.Add("treeindex_part2.root");
+   // One sub-index per file.
+   ASSERT_EQ(2, chain.BuildIndex("run", "event"));
+   Float_t x;
+   chain.SetBranchAddress("x", &x);
+   ASSERT_GT(chain.GetEntryWithIndex(8, 42), 0);
+   EXPECT_FLOAT_EQ(8 + 0.042, x);
+   ASSERT_GT(chain.GetEntryWithIndex(2, 99), 0);
+   EXPECT_FLOAT_EQ(2 + 0.099, x);
+}
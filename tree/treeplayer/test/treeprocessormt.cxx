@@ -0,0 +1,179 @@
+#include "TChain.h"
+#include "TEntryList.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+#include "ROOT/TTreeProcessorMT.hxx"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#ifdef R__USE_IMT
+
+// A single cluster made of many small baskets
+static void MakeSingleClusterFile(const char *filename, Int_t nEntries)
+{
+   TFile file(filename, "RECREATE");
+   TTree tree("T", "tree with one large cluster");
+   tree.SetAutoFlush(nEntries + 1);
+   Int_t x;
+   tree.Branch("x", &x, "x/I", 1000);
+   for (x = 0; x < nEntries; ++x)
+      tree.Fill();
+   tree.Write();
+}
+
+static std::vector<int> ProcessEntries(const char *filename, unsigned int &nTasks)
+{
+   std::mutex m;
+   std::vector<int> counts;
+   nTasks = 0;
+   ROOT::TTreeProcessorMT tp(filename, "T");
+   tp.Process([&](TTreeReader &r) {
+      TTreeReaderValue<Int_t> x(r, "x");
+      std::vector<Int_t> values;
+      while (r.Next())
+         values.emplace_back(*x);
+      std::lock_guard<std::mutex> lock(m);
+      ++nTasks;
+      for (auto v : values) {
+         if (counts.size() <= std::size_t(v))
+            counts.resize(v + 1);
+         ++counts[v];
+      }
+   });
+   return counts;
+}
+
+TEST(TTreeProcessorMT, SplitLargeClusters)
+{
+   const auto filename = "treeprocessormt_split.root";
+   const Int_t nEntries = 50000;
+   MakeSingleClusterFile(filename, nEntries);
+   ROOT::EnableImplicitMT(4);
+
+   unsigned int nTasks = 0;
+   auto counts = ProcessEntries(filename, nTasks);
+   EXPECT_GT(nTasks, 1U);
+   ASSERT_EQ(std::size_t(nEntries), counts.size());
+   for (auto c : counts)
+      EXPECT_EQ(1, c);
+
+   const auto hint = ROOT::TTreeProcessorMT::GetTasksPerWorkerHint();
+   ROOT::TTreeProcessorMT::SetTasksPerWorkerHint(0);
+   counts = ProcessEntries(filename, nTasks);
+   EXPECT_EQ(1U, nTasks);
+   ASSERT_EQ(std::size_t(nEntries), counts.size());
+   ROOT::TTreeProcessorMT::SetTasksPerWorkerHint(hint);
+
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(filename);
+}
+
+TEST(TTreeProcessorMT, SkipClustersWithoutSelectedEntries)
+{
+   const auto filename = "treeprocessormt_entrylist.root";
+   const Int_t nEntries = 20000;
+   {
+      TFile file(filename, "RECREATE");
+      TTree tree("T", "tree with many clusters");
+      tree.SetAutoFlush(1000);
+      Int_t x;
+      tree.Branch("x", &x, "x/I");
+      for (x = 0; x < nEntries; ++x)
+         tree.Fill();
+      tree.Write();
+   }
+   ROOT::EnableImplicitMT(4);
+
+   // Entries of two clusters only
+   TEntryList elist;
+   const std::vector<Long64_t> selected = {3010, 3500, 3999, 17000};
+   for (auto e : selected)
+      elist.Enter(e);
+
+   TFile file(filename);
+   TTree *tree = nullptr;
+   file.GetObject("T", tree);
+   ASSERT_NE(nullptr, tree);
+
+   std::mutex m;
+   unsigned int nTasks = 0;
+   std::vector<Long64_t> entries;
+   ROOT::TTreeProcessorMT tp(*tree, elist);
+   tp.Process([&](TTreeReader &r) {
+      TTreeReaderValue<Int_t> x(r, "x");
+      std::vector<Long64_t> values;
+      while (r.Next())
+         values.emplace_back(*x);
+      std::lock_guard<std::mutex> lock(m);
+      ++nTasks;
+      entries.insert(entries.end(), values.begin(), values.end());
+   });
+   EXPECT_EQ(2U, nTasks);
+   std::sort(entries.begin(), entries.end());
+   EXPECT_EQ(selected, entries);
+
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(filename);
+}
+
+TEST(TTreeProcessorMT, ChainWithPerTreeEntryLists)
+{
+   const char *filenames[] = {"treeprocessormt_chainelist0.root", "treeprocessormt_chainelist1.root"};
+   const Int_t nEntries = 5000;
+   for (auto i : {0, 1}) {
+      TFile file(filenames[i], "RECREATE");
+      TTree tree("T", "tree with many clusters");
+      tree.SetAutoFlush(1000);
+      Int_t x;
+      tree.Branch("x", &x, "x/I");
+      for (x = i * nEntries; x < (i + 1) * nEntries; ++x)
+         tree.Fill();
+      tree.Write();
+   }
+   ROOT::EnableImplicitMT(4);
+
+   // The entry numbers of each sub-list are those of its own tree
+   TEntryList sublist0("sublist0", "", "T", filenames[0]);
+   TEntryList sublist1("sublist1", "", "T", filenames[1]);
+   for (auto e : {10, 2500, 4999})
+      sublist0.Enter(e);
+   for (auto e : {0, 3001})
+      sublist1.Enter(e);
+   TEntryList elist;
+   elist.Add(&sublist0);
+   elist.Add(&sublist1);
+   ASSERT_NE(nullptr, elist.GetLists());
+
+   TChain chain("T");
+   for (auto filename : filenames)
+      chain.Add(filename);
+
+   std::mutex m;
+   std::vector<Long64_t> entries;
+   ROOT::TTreeProcessorMT tp(chain, elist);
+   tp.Process([&](TTreeReader &r) {
+      TTreeReaderValue<Int_t> x(r, "x");
+      std::vector<Long64_t> values;
+      while (r.Next())
+         values.emplace_back(*x);
+      std::lock_guard<std::mutex> lock(m);
+      entries.insert(entries.end(), values.begin(), values.end());
+   });
+   std::sort(entries.begin(), entries.end());
+   const std::vector<Long64_t> expected = {10, 2500, 4999, nEntries, nEntries + 3001};
+   EXPECT_EQ(expected, entries);
+
+   ROOT::DisableImplicitMT();
+   for (auto filename : filenames)
+      gSystem->Unlink(filename);
+}
+
+#endif // R__USE_IMT
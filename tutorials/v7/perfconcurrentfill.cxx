@@ -0,0 +1,115 @@
+/// \file
+/// \ingroup tutorial_v7
+///
+/// \macro_code
+///
+/// \date 2018-06-12
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/THist.hxx"
+#include "ROOT/THistConcurrentFill.hxx"
+#include "ROOT/TThreadedObject.hxx"
+
+#include "TH2.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace ROOT;
+
+/// Run task(ithread) in nThreads threads; return the wall time in seconds.
+template <class TASK>
+double timeThreads(int nThreads, TASK task)
+{
+   using namespace std::chrono;
+   auto start = high_resolution_clock::now();
+   std::vector<std::thread> threads;
+   for (int i = 0; i < nThreads; ++i)
+      threads.emplace_back(task, i);
+   for (auto &thr : threads)
+      thr.join();
+   return duration_cast<duration<double>>(high_resolution_clock::now() - start).count();
+}
+
+/// Fill count entries through filler, a THistConcurrentFiller or a THistPartialFiller.
+template <class FILLER>
+void fillV7(FILLER &filler, int seed, int count)
+{
+   std::mt19937 gen(seed);
+   std::uniform_real_distribution<double> uniform;
+   for (int i = 0; i < count; ++i)
+      filler.Fill({uniform(gen), uniform(gen)});
+}
+
+/// Entries filled through the THistConcurrentFillManager: buffered, each full buffer is
+/// filled into the histogram under a mutex.
+double timeLocked(int nThreads, int count)
+{
+   Experimental::TH2D hist{{100, 0., 1.}, {100, 0., 1.}};
+   Experimental::THistConcurrentFillManager<Experimental::TH2D> manager(hist);
+   std::vector<Experimental::THistConcurrentFiller<Experimental::TH2D, 1024>> fillers;
+   for (int i = 0; i < nThreads; ++i)
+      fillers.emplace_back(manager.MakeFiller());
+   return timeThreads(nThreads, [&fillers, count](int i) { fillV7(fillers[i], i, count); });
+}
+
+/// Entries filled through the THistPartialFillManager: one partial histogram per thread,
+/// merged when the filler is destroyed - within the thread.
+double timePartial(int nThreads, int count)
+{
+   Experimental::TH2D hist{{100, 0., 1.}, {100, 0., 1.}};
+   Experimental::THistPartialFillManager<Experimental::TH2D> manager(hist);
+   std::vector<Experimental::THistPartialFiller<Experimental::TH2D>> fillers;
+   for (int i = 0; i < nThreads; ++i)
+      fillers.emplace_back(manager.MakeFiller());
+   return timeThreads(nThreads, [&fillers, count](int i) {
+      fillV7(fillers[i], i, count);
+      fillers[i].Merge();
+   });
+}
+
+/// Entries filled into ROOT 6 histograms through TThreadedObject, merged at the end.
+double timeThreadedObject(int nThreads, int count)
+{
+   TThreadedObject<TH2D> hist("h", "h", 100, 0., 1., 100, 0., 1.);
+   double time = timeThreads(nThreads, [&hist, count](int i) {
+      auto h = hist.Get();
+      std::mt19937 gen(i);
+      std::uniform_real_distribution<double> uniform;
+      for (int j = 0; j < count; ++j)
+         h->Fill(uniform(gen), uniform(gen));
+   });
+   using namespace std::chrono;
+   auto start = high_resolution_clock::now();
+   hist.Merge();
+   return time + duration_cast<duration<double>>(high_resolution_clock::now() - start).count();
+}
+
+void perfconcurrentfill()
+{
+   ROOT::EnableThreadSafety();
+   TH1::AddDirectory(false);
+
+   const int count = 2000000; // entries per thread
+   const int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+   std::cout << count << " 2D fills per thread, wall time in seconds\n";
+   std::cout << "threads     locked    partial  TThreadedObject\n";
+   for (int nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+      std::cout << nThreads << "\t" << timeLocked(nThreads, count) << "\t" << timePartial(nThreads, count) << "\t"
+                << timeThreadedObject(nThreads, count) << '\n';
+   }
+}